@@ -0,0 +1,296 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/decoded_clip_cache.h"
+#include "audio/mixer.h"
+
+#include "common/hash-str.h"
+#include "common/textconsole.h"
+
+namespace Audio {
+
+namespace {
+
+enum {
+	/** Number of samples decoded at once */
+	kChunkSize = 2048
+};
+
+/** Plays the decoded samples of a clip while it is resampled */
+class SampleArrayStream : public AudioStream {
+public:
+	SampleArrayStream(const Common::Array<int16> &data, int rate, bool stereo) : _data(data), _rate(rate), _stereo(stereo), _pos(0) {}
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const int samples = MIN<uint32>(numSamples, _data.size() - _pos);
+		if (samples > 0)
+			memcpy(buffer, &_data[_pos], samples * sizeof(int16));
+		_pos += samples;
+		return samples;
+	}
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+	bool endOfData() const override { return _pos >= _data.size(); }
+
+private:
+	const Common::Array<int16> &_data;
+	int _rate;
+	bool _stereo;
+	uint32 _pos;
+};
+
+} // End of anonymous namespace
+
+class DecodedClipCache::ClipStream : public SeekableAudioStream {
+public:
+	ClipStream(DecodedClipCache *cache, Clip *clip) : _cache(cache), _clip(clip), _pos(0) {}
+	~ClipStream() { _cache->release(_clip); }
+
+	int readBuffer(int16 *buffer, const int numSamples) override {
+		const int samples = MIN<uint32>(numSamples, _clip->numSamples - _pos);
+		memcpy(buffer, _clip->samples + _pos, samples * sizeof(int16));
+		_pos += samples;
+		return samples;
+	}
+
+	bool isStereo() const override { return _clip->stereo; }
+	int getRate() const override { return _clip->rate; }
+	bool endOfData() const override { return _pos >= _clip->numSamples; }
+
+	bool seek(const Timestamp &where) override {
+		const uint32 channels = _clip->stereo ? 2 : 1;
+		const uint32 pos = where.convertToFramerate(_clip->rate).totalNumberOfFrames() * channels;
+		_pos = MIN(pos, _clip->numSamples);
+		return pos <= _clip->numSamples;
+	}
+
+	Timestamp getLength() const override {
+		return Timestamp(0, _clip->numSamples / (_clip->stereo ? 2 : 1), _clip->rate);
+	}
+
+private:
+	DecodedClipCache *_cache;
+	Clip *_clip;
+	uint32 _pos;
+};
+
+uint DecodedClipCache::KeyHash::operator()(const Key &key) const {
+	return Common::hashit(key.archive.c_str()) ^ (key.offset * 2654435761U) ^ (key.params * 40503U);
+}
+
+DecodedClipCache::DecodedClipCache(uint32 budget, uint32 maxClipSize)
+	: _budget(budget), _maxClipSize(maxClipSize), _outputRate(0), _quality(kRateConverterPolyphase), _size(0), _accessCounter(0) {
+}
+
+DecodedClipCache::~DecodedClipCache() {
+	clear();
+}
+
+SeekableAudioStream *DecodedClipCache::find(const Key &key) {
+	Common::StackLock lock(_mutex);
+
+	ClipMap::iterator it = _clips.find(key);
+	if (it == _clips.end())
+		return nullptr;
+
+	it->_value->lastAccess = _accessCounter++;
+	return createStream(it->_value);
+}
+
+RewindableAudioStream *DecodedClipCache::store(const Key &key, RewindableAudioStream *stream) {
+	// Decode outside of the lock, so that the mixer is not blocked from
+	// releasing other clips
+	Common::Array<int16> data;
+	bool tooLong = false;
+	while (!stream->endOfData()) {
+		const uint32 pos = data.size();
+		if (pos * sizeof(int16) >= _maxClipSize) {
+			tooLong = true;
+			break;
+		}
+
+		data.resize(pos + kChunkSize);
+		const int samples = stream->readBuffer(&data[pos], kChunkSize);
+		data.resize(pos + MAX(samples, 0));
+		if (samples <= 0)
+			break;
+	}
+
+	if (tooLong) {
+		if (!stream->rewind())
+			warning("DecodedClipCache: Could not rewind the stream for '%s' at %u", key.archive.c_str(), key.offset);
+		return stream;
+	}
+
+	int rate = stream->getRate();
+	uint outputRate;
+	RateConverterQuality quality;
+	{
+		Common::StackLock lock(_mutex);
+		outputRate = _outputRate;
+		quality = _quality;
+	}
+
+	if (outputRate && (uint)rate != outputRate) {
+		resample(data, rate, stream->isStereo(), outputRate, quality);
+		rate = outputRate;
+	}
+
+	Clip *clip = new Clip();
+	clip->numSamples = data.size();
+	clip->samples = new int16[clip->numSamples];
+	if (clip->numSamples)
+		memcpy(clip->samples, &data[0], clip->numSamples * sizeof(int16));
+	clip->rate = rate;
+	clip->stereo = stream->isStereo();
+	clip->refs = 0;
+	clip->cached = false;
+	delete stream;
+
+	Common::StackLock lock(_mutex);
+
+	ClipMap::iterator it = _clips.find(key);
+	if (it != _clips.end()) {
+		Clip *oldClip = it->_value;
+		_clips.erase(it);
+		_size -= oldClip->numSamples * sizeof(int16);
+		oldClip->cached = false;
+		if (!oldClip->refs)
+			freeClip(oldClip);
+	}
+
+	// A clip which does not fit into the budget is still played, and
+	// freed as soon as its stream is deleted
+	const uint32 size = clip->numSamples * sizeof(int16);
+	while (_size + size > _budget && evictOldest())
+		;
+	if (_size + size <= _budget) {
+		clip->cached = true;
+		clip->lastAccess = _accessCounter++;
+		_clips[key] = clip;
+		_size += size;
+	}
+
+	return createStream(clip);
+}
+
+void DecodedClipCache::setOutputRate(uint rate, RateConverterQuality quality) {
+	{
+		Common::StackLock lock(_mutex);
+		if (rate == _outputRate && quality == _quality)
+			return;
+
+		_outputRate = rate;
+		_quality = quality;
+	}
+
+	clear();
+}
+
+void DecodedClipCache::resample(Common::Array<int16> &data, int rate, bool stereo, uint outputRate, RateConverterQuality quality) {
+	SampleArrayStream input(data, rate, stereo);
+	RateConverter *converter = makeRateConverter(rate, outputRate, stereo, false, quality);
+
+	// The converter always produces stereo frames. Mono clips stay mono,
+	// both channels are the same for them.
+	Common::Array<int16> output;
+	int16 buffer[kChunkSize * 2];
+	while (true) {
+		memset(buffer, 0, sizeof(buffer));
+		const int frames = converter->flow(input, buffer, kChunkSize, Mixer::kMaxMixerVolume, Mixer::kMaxMixerVolume);
+		if (frames <= 0)
+			break;
+
+		const uint32 pos = output.size();
+		if (stereo) {
+			output.resize(pos + frames * 2);
+			memcpy(&output[pos], buffer, frames * 2 * sizeof(int16));
+		} else {
+			output.resize(pos + frames);
+			for (int i = 0; i < frames; i++)
+				output[pos + i] = buffer[i * 2];
+		}
+
+		if (frames < kChunkSize)
+			break;
+	}
+
+	delete converter;
+	data = output;
+}
+
+void DecodedClipCache::clear() {
+	Common::StackLock lock(_mutex);
+
+	for (ClipMap::iterator it = _clips.begin(); it != _clips.end(); ++it) {
+		it->_value->cached = false;
+		if (!it->_value->refs)
+			freeClip(it->_value);
+	}
+
+	_clips.clear();
+	_size = 0;
+}
+
+uint32 DecodedClipCache::getSize() const {
+	Common::StackLock lock(_mutex);
+	return _size;
+}
+
+SeekableAudioStream *DecodedClipCache::createStream(Clip *clip) {
+	// The caller holds the lock
+	clip->refs++;
+	return new ClipStream(this, clip);
+}
+
+void DecodedClipCache::release(Clip *clip) {
+	Common::StackLock lock(_mutex);
+
+	assert(clip->refs > 0);
+	clip->refs--;
+	if (!clip->refs && !clip->cached)
+		freeClip(clip);
+}
+
+void DecodedClipCache::freeClip(Clip *clip) {
+	delete[] clip->samples;
+	delete clip;
+}
+
+bool DecodedClipCache::evictOldest() {
+	ClipMap::iterator oldest = _clips.end();
+	for (ClipMap::iterator it = _clips.begin(); it != _clips.end(); ++it) {
+		if (!it->_value->refs && (oldest == _clips.end() || it->_value->lastAccess < oldest->_value->lastAccess))
+			oldest = it;
+	}
+
+	if (oldest == _clips.end())
+		return false;
+
+	Clip *clip = oldest->_value;
+	_clips.erase(oldest);
+	_size -= clip->numSamples * sizeof(int16);
+	freeClip(clip);
+	return true;
+}
+
+} // End of namespace Audio
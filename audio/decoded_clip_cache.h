@@ -0,0 +1,157 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_DECODED_CLIP_CACHE_H
+#define AUDIO_DECODED_CLIP_CACHE_H
+
+#include "audio/audiostream.h"
+#include "audio/rate.h"
+
+#include "common/array.h"
+#include "common/hashmap.h"
+#include "common/mutex.h"
+#include "common/str.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_decoded_clip_cache Decoded clip cache
+ * @ingroup audio
+ *
+ * @brief Cache for the decoded samples of short, frequently played sounds.
+ * @{
+ */
+
+/**
+ * A cache which keeps the decoded PCM data of short clips, like speech
+ * and sound effects, within a memory budget. Playing a cached clip again
+ * only copies samples, instead of running the ADPCM, MP3, Vorbis or FLAC
+ * decoder once more.
+ *
+ * The cache can also resample the clips once to the output rate of the
+ * mixer, so that playing them does not need any rate conversion.
+ *
+ * The streams returned by the cache reference its data, so the cache must
+ * outlive them. Clips which are still being played are never evicted.
+ * Streams may be deleted from any thread, for instance by the mixer.
+ */
+class DecodedClipCache {
+public:
+	/** Identifies a clip by the file it comes from, its offset and any decoder parameters. */
+	struct Key {
+		Common::String archive;
+		uint32 offset;
+		uint32 params;
+
+		Key(const Common::String &a, uint32 o, uint32 p = 0) : archive(a), offset(o), params(p) {}
+
+		bool operator==(const Key &key) const {
+			return offset == key.offset && params == key.params && archive == key.archive;
+		}
+	};
+
+	/**
+	 * @param budget      The maximum number of bytes of decoded samples to keep.
+	 * @param maxClipSize Clips which decode to more bytes than this are not cached.
+	 */
+	DecodedClipCache(uint32 budget = 4 * 1024 * 1024, uint32 maxClipSize = 512 * 1024);
+	~DecodedClipCache();
+
+	/**
+	 * Create a stream playing a cached clip.
+	 *
+	 * @return The new stream, or nullptr if the clip is not cached.
+	 */
+	SeekableAudioStream *find(const Key &key);
+
+	/**
+	 * Decode a clip and add it to the cache.
+	 *
+	 * @param key    The key to store the clip under.
+	 * @param stream The decoder of the clip. It is always taken over.
+	 * @return A stream playing the decoded clip. If the clip is too long to
+	 *         be cached, this is @p stream itself, rewound to the start.
+	 */
+	RewindableAudioStream *store(const Key &key, RewindableAudioStream *stream);
+
+	/**
+	 * Resample the clips to the given rate when they are stored, so that the
+	 * mixer plays them without converting their rate. This drops all clips
+	 * stored at another rate before.
+	 *
+	 * @param rate    The output rate of the mixer, or 0 to keep the original rate of the clips.
+	 * @param quality The resampling algorithm. As every clip is resampled
+	 *                only once, the best one is used by default.
+	 */
+	void setOutputRate(uint rate, RateConverterQuality quality = kRateConverterPolyphase);
+
+	/** Drop all clips. Clips which are still being played are freed afterwards. */
+	void clear();
+
+	/** Return the number of bytes of decoded samples in the cache. */
+	uint32 getSize() const;
+
+private:
+	struct Clip {
+		int16 *samples;
+		uint32 numSamples;
+		int rate;
+		bool stereo;
+
+		uint refs;
+		uint32 lastAccess;
+		bool cached;
+	};
+
+	struct KeyHash {
+		uint operator()(const Key &key) const;
+	};
+
+	class ClipStream;
+	friend class ClipStream;
+
+	typedef Common::HashMap<Key, Clip *, KeyHash> ClipMap;
+
+	SeekableAudioStream *createStream(Clip *clip);
+	void release(Clip *clip);
+	void freeClip(Clip *clip);
+	bool evictOldest();
+
+	static void resample(Common::Array<int16> &data, int rate, bool stereo, uint outputRate, RateConverterQuality quality);
+
+	const uint32 _budget;
+	const uint32 _maxClipSize;
+	uint _outputRate;
+	RateConverterQuality _quality;
+
+	mutable Common::Mutex _mutex;
+
+	// The following members are protected by _mutex
+	ClipMap _clips;
+	uint32 _size;
+	uint32 _accessCounter;
+};
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
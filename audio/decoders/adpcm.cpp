@@ -55,6 +55,8 @@ ADPCMStream::ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Fl
 void ADPCMStream::reset() {
 	memset(&_status, 0, sizeof(_status));
 	_blockPos[0] = _blockPos[1] = _blockAlign; // To make sure first header is read
+	_blockSamples.clear();
+	_blockSampleIndex = 0;
 }
 
 bool ADPCMStream::rewind() {
@@ -64,6 +66,22 @@ bool ADPCMStream::rewind() {
 	return true;
 }
 
+int ADPCMStream::readBlocks(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		if (!hasBlockSamples() && (ADPCMStream::endOfData() || !decodeBlock()))
+			break;
+
+		const int count = MIN<int>(numSamples - samples, _blockSamples.size() - _blockSampleIndex);
+		memcpy(buffer + samples, _blockSamples.data() + _blockSampleIndex, count * sizeof(int16));
+		_blockSampleIndex += count;
+		samples += count;
+	}
+
+	return samples;
+}
+
 
 #pragma mark -
 
@@ -221,22 +239,42 @@ void XA_ADPCMStream::decodeXA(const byte *src) {
 
 
 int DVI_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
-
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			data = _stream->readByte();
-			_decodedSamples[0] = decodeIMA((data >> 4) & 0x0f, 0);
-			_decodedSamples[1] = decodeIMA((data >> 0) & 0x0f, _channels == 2 ? 1 : 0);
-			_decodedSampleCount = 2;
-		}
+	int samples = 0;
 
-		// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
+	// Return the sample left over by the previous call first.
+	// (1 - (count - 1)) ensures that _decodedSamples acts as a FIFO of depth 2
+	for (; samples < numSamples && _decodedSampleCount != 0; samples++) {
 		buffer[samples] = _decodedSamples[1 - (_decodedSampleCount - 1)];
 		_decodedSampleCount--;
 	}
 
+	const int32 *fusedTable = getFusedIMATable();
+	ADPCMStatus::ImaChannel &left = _status.ima_ch[0];
+	ADPCMStatus::ImaChannel &right = _status.ima_ch[_channels == 2 ? 1 : 0];
+
+	// Decode whole bytes straight into the output buffer
+	byte data[512];
+	while (numSamples - samples >= 2 && !endOfData()) {
+		const uint32 bytes = MIN<uint32>((numSamples - samples) / 2, MIN<uint32>(sizeof(data), _endpos - _stream->pos()));
+		const uint32 bytesRead = _stream->read(data, bytes);
+
+		for (uint32 i = 0; i < bytesRead; i++) {
+			buffer[samples++] = decodeIMAFused(fusedTable, left.last, left.stepIndex, data[i] >> 4);
+			buffer[samples++] = decodeIMAFused(fusedTable, right.last, right.stepIndex, data[i] & 0x0f);
+		}
+
+		if (bytesRead < bytes)
+			break;
+	}
+
+	// An odd number of samples was requested, keep the second one for later
+	if (samples < numSamples && !endOfData()) {
+		const byte code = _stream->readByte();
+		buffer[samples++] = decodeIMAFused(fusedTable, left.last, left.stepIndex, code >> 4);
+		_decodedSamples[1] = decodeIMAFused(fusedTable, right.last, right.stepIndex, code & 0x0f);
+		_decodedSampleCount = 1;
+	}
+
 	return samples;
 }
 
@@ -314,42 +352,43 @@ int MSIma_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
 	// Need to write at least one sample per channel
 	assert((numSamples % _channels) == 0);
 
-	int samples = 0;
+	return readBlocks(buffer, numSamples);
+}
 
-	while (samples < numSamples && !_stream->eos() && _stream->pos() < _endpos) {
-		if (_blockPos[0] == _blockAlign) {
-			for (int i = 0; i < _channels; i++) {
-				// read block header
-				_status.ima_ch[i].last = _stream->readSint16LE();
-				_status.ima_ch[i].stepIndex = _stream->readSint16LE();
-			}
+bool MSIma_ADPCMStream::decodeBlock() {
+	const uint32 headerSize = _channels * 4;
+	const uint32 blockSize = _stream->read(_blockData.data(), MIN<uint32>(_blockAlign, _endpos - _stream->pos()));
+	if (blockSize < headerSize)
+		return false;
 
-			_blockPos[0] = _channels * 4;
-		}
+	// After the header, the stream encodes four bytes per channel at a time
+	const uint32 groups = (blockSize - headerSize) / headerSize;
+	_blockSamples.resize(groups * 8 * _channels);
+	_blockSampleIndex = 0;
+
+	const int32 *fusedTable = getFusedIMATable();
+
+	for (int i = 0; i < _channels; i++) {
+		const byte *header = _blockData.data() + i * 4;
+		int32 last = (int16)READ_LE_UINT16(header);
+		int32 stepIndex = CLIP<int32>((int16)READ_LE_UINT16(header + 2), 0, ARRAYSIZE(_imaTable) - 1);
 
-		// Decode a set of samples
-		for (int i = 0; i < _channels; i++) {
-			// The stream encodes four bytes per channel at a time
+		int16 *dst = _blockSamples.data() + i;
+		for (uint32 group = 1; group <= groups; group++) {
+			const byte *src = _blockData.data() + group * headerSize + i * 4;
 			for (int j = 0; j < 4; j++) {
-				byte data = _stream->readByte();
-				_blockPos[0]++;
-				_buffer[i][j * 2] = decodeIMA(data & 0x0f, i);
-				_buffer[i][j * 2 + 1] = decodeIMA((data >> 4) & 0x0f, i);
-				_samplesLeft[i] += 2;
+				*dst = decodeIMAFused(fusedTable, last, stepIndex, src[j] & 0x0f);
+				dst += _channels;
+				*dst = decodeIMAFused(fusedTable, last, stepIndex, src[j] >> 4);
+				dst += _channels;
 			}
 		}
 
-		while (samples < numSamples && _samplesLeft[0] != 0) {
-			for (int i = 0; i < _channels; i++) {
-				buffer[samples + i] = _buffer[i][8 - _samplesLeft[i]];
-				_samplesLeft[i]--;
-			}
-
-			samples += _channels;
-		}
+		_status.ima_ch[i].last = last;
+		_status.ima_ch[i].stepIndex = stepIndex;
 	}
 
-	return samples;
+	return true;
 }
 
 
@@ -388,136 +427,109 @@ int16 MS_ADPCMStream::decodeMS(ADPCMChannelStatus *c, byte code) {
 }
 
 int MS_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	int samples;
-	byte data;
-	int i;
-
-	for (samples = 0; samples < numSamples && !endOfData(); samples++) {
-		if (_decodedSampleCount == 0) {
-			if (_blockPos[0] == _blockAlign) {
-				// read block header
-				for (i = 0; i < _channels; i++) {
-					_status.ch[i].predictor = CLIP(_stream->readByte(), (byte)0, (byte)6);
-					_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
-					_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
-				}
-
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].delta = _stream->readSint16LE();
-
-				for (i = 0; i < _channels; i++)
-					_status.ch[i].sample1 = _stream->readSint16LE();
-
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample2 = _stream->readSint16LE();
+	return readBlocks(buffer, numSamples);
+}
 
-				for (i = 0; i < _channels; i++)
-					_decodedSamples[_decodedSampleCount++] = _status.ch[i].sample1;
+bool MS_ADPCMStream::decodeBlock() {
+	const uint32 headerSize = _channels * 7;
+	const uint32 blockSize = _stream->read(_blockData.data(), MIN<uint32>(_blockAlign, _endpos - _stream->pos()));
+	if (blockSize < headerSize)
+		return false;
 
-				_blockPos[0] = _channels * 7;
-			} else {
-				data = _stream->readByte();
-				_blockPos[0]++;
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[0], (data >> 4) & 0x0f);
-				_decodedSamples[_decodedSampleCount++] = decodeMS(&_status.ch[_channels - 1], data & 0x0f);
-			}
-			_decodedSampleIndex = 0;
-		}
+	const byte *header = _blockData.data();
+	for (int i = 0; i < _channels; i++) {
+		_status.ch[i].predictor = CLIP(header[i], (byte)0, (byte)6);
+		_status.ch[i].coeff1 = MSADPCMAdaptCoeff1[_status.ch[i].predictor];
+		_status.ch[i].coeff2 = MSADPCMAdaptCoeff2[_status.ch[i].predictor];
+		_status.ch[i].delta = (int16)READ_LE_UINT16(header + _channels + i * 2);
+		_status.ch[i].sample1 = (int16)READ_LE_UINT16(header + _channels * 3 + i * 2);
+		_status.ch[i].sample2 = (int16)READ_LE_UINT16(header + _channels * 5 + i * 2);
+	}
 
-		// _decodedSamples acts as a FIFO of depth 2 or 4;
-		buffer[samples] = _decodedSamples[_decodedSampleIndex++];
-		_decodedSampleCount--;
+	// The header holds the first two samples of each channel, and each
+	// following byte two more samples
+	_blockSamples.resize(_channels * 2 + (blockSize - headerSize) * 2);
+	_blockSampleIndex = 0;
+
+	int16 *dst = _blockSamples.data();
+	for (int i = 0; i < _channels; i++)
+		*dst++ = _status.ch[i].sample2;
+	for (int i = 0; i < _channels; i++)
+		*dst++ = _status.ch[i].sample1;
+
+	ADPCMChannelStatus *left = &_status.ch[0];
+	ADPCMChannelStatus *right = &_status.ch[_channels - 1];
+	for (uint32 pos = headerSize; pos < blockSize; pos++) {
+		const byte data = _blockData[pos];
+		*dst++ = decodeMS(left, (data >> 4) & 0x0f);
+		*dst++ = decodeMS(right, data & 0x0f);
 	}
 
-	return samples;
+	return true;
 }
 
 
 #pragma mark -
 
-#define DK3_READ_NIBBLE(channelNo) \
-do { \
-	if (_topNibble) { \
-		_nibble = _lastByte >> 4; \
-		_topNibble = false; \
-	} else { \
-		_lastByte = _stream->readByte(); \
-		_nibble = _lastByte & 0xf; \
-		_topNibble = true; \
-		--blockBytesLeft; \
-		--audioBytesLeft; \
-	} \
-	decodeIMA(_nibble, channelNo); \
-} while(0)
-
 int DK3_ADPCMStream::readBuffer(int16 *buffer, const int numSamples) {
-	assert((numSamples % 4) == 0);
-
-	const uint32 startOffset = _stream->pos() % _blockAlign;
-	uint32 audioBytesLeft = _endpos - _stream->pos();
-	uint32 blockBytesLeft;
-	if (startOffset != 0) {
-		blockBytesLeft = _blockAlign - startOffset;
-	} else {
-		blockBytesLeft = 0;
-	}
-
-	int samples = 0;
-	while (samples < numSamples && audioBytesLeft) {
-		if (blockBytesLeft == 0) {
-			blockBytesLeft = MIN(_blockAlign, audioBytesLeft);
-			_topNibble = false;
-
-			if (blockBytesLeft < 16) {
-				warning("Truncated DK3 ADPCM block header");
-				break;
-			}
+	return readBlocks(buffer, numSamples);
+}
 
-			_stream->skip(2);
-			const uint16 rate = _stream->readUint16LE();
-			assert(rate == getRate());
-			_stream->skip(6);
+static inline byte getNibble(const byte *data, uint32 index) {
+	// Low nibble first
+	return (data[index >> 1] >> ((index & 1) << 2)) & 0x0f;
+}
 
-			// Get predictor for both sum/diff channels
-			_status.ima_ch[0].last = _stream->readSint16LE();
-			_status.ima_ch[1].last = _stream->readSint16LE();
+bool DK3_ADPCMStream::decodeBlock() {
+	const uint32 blockSize = _stream->read(_blockData.data(), MIN<uint32>(_blockAlign, _endpos - _stream->pos()));
+	if (blockSize < 16) {
+		if (blockSize != 0)
+			warning("Truncated DK3 ADPCM block header");
+		return false;
+	}
 
-			// Get index for both sum/diff channels
-			_status.ima_ch[0].stepIndex = _stream->readByte();
-			_status.ima_ch[1].stepIndex = _stream->readByte();
-			assert(_status.ima_ch[0].stepIndex < ARRAYSIZE(_imaTable));
-			assert(_status.ima_ch[1].stepIndex < ARRAYSIZE(_imaTable));
+	const byte *header = _blockData.data();
+	const uint16 rate = READ_LE_UINT16(header + 2);
+	assert(rate == getRate());
 
-			blockBytesLeft -= 16;
-			audioBytesLeft -= 16;
-		}
+	// Get predictor and index for both sum/diff channels
+	int32 sumLast = (int16)READ_LE_UINT16(header + 10);
+	int32 diffLast = (int16)READ_LE_UINT16(header + 12);
+	int32 sumStepIndex = header[14];
+	int32 diffStepIndex = header[15];
+	assert(sumStepIndex < ARRAYSIZE(_imaTable));
+	assert(diffStepIndex < ARRAYSIZE(_imaTable));
 
-		DK3_READ_NIBBLE(0);
-		DK3_READ_NIBBLE(1);
+	// Every three nibbles make up four samples. If the last ones of a block
+	// do not make up a full set, they are alignment padding.
+	const uint32 sets = (blockSize - 16) * 2 / 3;
+	_blockSamples.resize(sets * 4);
+	_blockSampleIndex = 0;
 
-		*buffer++ = _status.ima_ch[0].last + _status.ima_ch[1].last;
-		*buffer++ = _status.ima_ch[0].last - _status.ima_ch[1].last;
+	const int32 *fusedTable = getFusedIMATable();
+	const byte *src = header + 16;
+	int16 *dst = _blockSamples.data();
 
-		DK3_READ_NIBBLE(0);
+	for (uint32 nibble = 0; nibble < sets * 3; nibble += 3) {
+		decodeIMAFused(fusedTable, sumLast, sumStepIndex, getNibble(src, nibble));
+		decodeIMAFused(fusedTable, diffLast, diffStepIndex, getNibble(src, nibble + 1));
 
-		*buffer++ = _status.ima_ch[0].last + _status.ima_ch[1].last;
-		*buffer++ = _status.ima_ch[0].last - _status.ima_ch[1].last;
+		*dst++ = sumLast + diffLast;
+		*dst++ = sumLast - diffLast;
 
-		samples += 4;
+		decodeIMAFused(fusedTable, sumLast, sumStepIndex, getNibble(src, nibble + 2));
 
-		// if the last sample of a block ends on an odd byte, the encoder adds
-		// an extra alignment byte
-		if (!_topNibble && blockBytesLeft == 1) {
-			_stream->skip(1);
-			--blockBytesLeft;
-			--audioBytesLeft;
-		}
+		*dst++ = sumLast + diffLast;
+		*dst++ = sumLast - diffLast;
 	}
 
-	return samples;
-}
+	_status.ima_ch[0].last = sumLast;
+	_status.ima_ch[0].stepIndex = sumStepIndex;
+	_status.ima_ch[1].last = diffLast;
+	_status.ima_ch[1].stepIndex = diffStepIndex;
 
-#undef DK3_READ_NIBBLE
+	return true;
+}
 
 #pragma mark -
 
@@ -545,16 +557,35 @@ const int16 Ima_ADPCMStream::_imaTable[89] = {
 	32767
 };
 
-int16 Ima_ADPCMStream::decodeIMA(byte code, int channel) {
-	int32 E = (2 * (code & 0x7) + 1) * _imaTable[_status.ima_ch[channel].stepIndex] / 8;
-	int32 diff = (code & 0x08) ? -E : E;
-	int32 samp = CLIP<int32>(_status.ima_ch[channel].last + diff, -32768, 32767);
+namespace {
+
+struct FusedIMATable {
+	int32 entries[ARRAYSIZE(Ima_ADPCMStream::_imaTable) * 16];
 
-	_status.ima_ch[channel].last = samp;
-	_status.ima_ch[channel].stepIndex += _stepAdjustTable[code];
-	_status.ima_ch[channel].stepIndex = CLIP<int32>(_status.ima_ch[channel].stepIndex, 0, ARRAYSIZE(_imaTable) - 1);
+	FusedIMATable() {
+		const int32 maxStepIndex = ARRAYSIZE(Ima_ADPCMStream::_imaTable) - 1;
 
-	return samp;
+		for (int32 stepIndex = 0; stepIndex <= maxStepIndex; stepIndex++) {
+			for (int32 code = 0; code < 16; code++) {
+				int32 E = (2 * (code & 0x7) + 1) * Ima_ADPCMStream::_imaTable[stepIndex] / 8;
+				int32 diff = (code & 0x08) ? -E : E;
+				int32 nextStepIndex = CLIP<int32>(stepIndex + ADPCMStream::_stepAdjustTable[code], 0, maxStepIndex);
+
+				entries[(stepIndex << 4) | code] = (int32)((uint32)diff << 8) | nextStepIndex;
+			}
+		}
+	}
+};
+
+} // End of anonymous namespace
+
+const int32 *Ima_ADPCMStream::getFusedIMATable() {
+	static const FusedIMATable table;
+	return table.entries;
+}
+
+int16 Ima_ADPCMStream::decodeIMA(byte code, int channel) {
+	return decodeIMAFused(getFusedIMATable(), _status.ima_ch[channel].last, _status.ima_ch[channel].stepIndex, code);
 }
 
 SeekableAudioStream *makeADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, ADPCMType type, int rate, int channels, uint32 blockAlign) {
@@ -31,6 +31,7 @@
 #define AUDIO_ADPCM_INTERN_H
 
 #include "audio/audiostream.h"
+#include "common/array.h"
 #include "common/endian.h"
 #include "common/ptr.h"
 #include "common/stream.h"
@@ -50,15 +51,38 @@ protected:
 
 	struct ADPCMStatus {
 		// OKI/IMA
-		struct {
+		struct ImaChannel {
 			int32 last;
 			int32 stepIndex;
 			int16 sample[2];
 		} ima_ch[2];
 	} _status;
 
+	/**
+	 * Decoded samples of the current block, for the decoders which decode
+	 * a whole block at once through decodeBlock().
+	 */
+	Common::Array<int16> _blockSamples;
+	uint32 _blockSampleIndex;
+
 	virtual void reset();
 
+	/**
+	 * Decode the next block of the stream into _blockSamples.
+	 *
+	 * @return false if there is no complete block header left.
+	 */
+	virtual bool decodeBlock() { return false; }
+
+	/**
+	 * Implementation of readBuffer() for the decoders which override
+	 * decodeBlock().
+	 */
+	int readBlocks(int16 *buffer, const int numSamples);
+
+	/** Return whether the current block has samples which were not read yet. */
+	bool hasBlockSamples() const { return _blockSampleIndex < _blockSamples.size(); }
+
 public:
 	ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign);
 
@@ -119,6 +143,16 @@ class Ima_ADPCMStream : public ADPCMStream {
 protected:
 	int16 decodeIMA(byte code, int channel = 0); // Default to using the left channel/using one channel
 
+	/**
+	 * Decode one nibble with the fused table from getFusedIMATable().
+	 */
+	static inline int16 decodeIMAFused(const int32 *fusedTable, int32 &last, int32 &stepIndex, byte code) {
+		const int32 entry = fusedTable[(stepIndex << 4) | code];
+		last = CLIP<int32>(last + (entry >> 8), -32768, 32767);
+		stepIndex = entry & 0xff;
+		return last;
+	}
+
 public:
 	Ima_ADPCMStream(Common::SeekableReadStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 size, int rate, int channels, uint32 blockAlign)
 		: ADPCMStream(stream, disposeAfterUse, size, rate, channels, blockAlign) {}
@@ -127,6 +161,15 @@ public:
 	 * This table is used by decodeIMA.
 	 */
 	static const int16 _imaTable[89];
+
+	/**
+	 * Return _imaTable and _stepAdjustTable fused into a single table.
+	 *
+	 * It has 16 entries for each step index, one per nibble. Each holds the
+	 * difference to add to the predictor in its upper 24 bits and the
+	 * clipped step index for the next nibble in its lower 8 bits.
+	 */
+	static const int32 *getFusedIMATable();
 };
 
 class DVI_ADPCMStream : public Ima_ADPCMStream {
@@ -182,21 +225,18 @@ public:
 		if (blockAlign % (_channels * 4))
 			error("MSIma_ADPCMStream(): invalid blockAlign");
 
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
+		_blockData.resize(blockAlign);
 	}
 
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && !hasBlockSamples(); }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
-	void reset() {
-		Ima_ADPCMStream::reset();
-		_samplesLeft[0] = 0;
-		_samplesLeft[1] = 0;
-	}
+protected:
+	virtual bool decodeBlock();
 
 private:
-	int16 _buffer[2][8];
-	int _samplesLeft[2];
+	Common::Array<byte> _blockData;
 };
 
 class MS_ADPCMStream : public ADPCMStream {
@@ -226,21 +266,20 @@ public:
 		if (blockAlign == 0)
 			error("MS_ADPCMStream(): blockAlign isn't specified for MS ADPCM");
 		memset(&_status, 0, sizeof(_status));
-		_decodedSampleCount = 0;
-		_decodedSampleIndex = 0;
+		_blockData.resize(blockAlign);
 	}
 
-	virtual bool endOfData() const { return (_stream->eos() || _stream->pos() >= _endpos) && (_decodedSampleCount == 0); }
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && !hasBlockSamples(); }
 
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
 protected:
 	int16 decodeMS(ADPCMChannelStatus *c, byte);
 
+	virtual bool decodeBlock();
+
 private:
-	uint8 _decodedSampleCount;
-	uint8 _decodedSampleIndex;
-	int16 _decodedSamples[4];
+	Common::Array<byte> _blockData;
 };
 
 // Duck DK3 IMA ADPCM Decoder
@@ -253,13 +292,19 @@ public:
 
 		// DK3 only works as a stereo stream
 		assert(channels == 2);
+
+		_blockData.resize(blockAlign);
 	}
 
+	virtual bool endOfData() const { return ADPCMStream::endOfData() && !hasBlockSamples(); }
+
 	virtual int readBuffer(int16 *buffer, const int numSamples);
 
+protected:
+	virtual bool decodeBlock();
+
 private:
-	byte _nibble, _lastByte;
-	bool _topNibble;
+	Common::Array<byte> _blockData;
 };
 
 } // End of namespace Audio
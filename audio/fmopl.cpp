@@ -327,7 +327,17 @@ EmulatedOPL::EmulatedOPL() :
 	_nextTick(0),
 	_samplesPerTick(0),
 	_baseFreq(0),
-	_handle(new Audio::SoundHandle()) {
+	_handle(new Audio::SoundHandle()),
+	_writesRead(0),
+	_ringRead(0),
+	_ringFill(0),
+	_callbackPos(0),
+	_renderPos(0),
+	_playPos(0),
+	_aheadFrames(0),
+	_quit(false),
+	_synthesisWaiting(false),
+	_readerWaiting(false) {
 }
 
 EmulatedOPL::~EmulatedOPL() {
@@ -340,7 +350,59 @@ EmulatedOPL::~EmulatedOPL() {
 	delete _handle;
 }
 
+void EmulatedOPL::reset() {
+	if (!queueWrite(kWriteReset, 0, 0))
+		resetChip();
+}
+
+void EmulatedOPL::write(int a, int v) {
+	if (!queueWrite(kWritePort, a, v))
+		writeChip(a, v);
+}
+
+void EmulatedOPL::writeReg(int r, int v) {
+	if (!queueWrite(kWriteRegister, r, v))
+		writeChipReg(r, v);
+}
+
+bool EmulatedOPL::queueWrite(WriteType type, int a, int v) {
+	if (!_thread.isStarted())
+		return false;
+
+	Common::StackLock lock(_mutex);
+
+	// Writes made by the callbacks belong to the current callback
+	// position. Writes made by the engine are heard after everything
+	// that was rendered ahead already.
+	QueuedWrite write;
+	write.time = _callbackPos;
+	write.type = type;
+	write.a = a;
+	write.v = v;
+	_writes.push_back(write);
+	return true;
+}
+
+void EmulatedOPL::applyWrite(const QueuedWrite &write) {
+	switch (write.type) {
+	case kWritePort:
+		writeChip(write.a, write.v);
+		break;
+	case kWriteRegister:
+		writeChipReg(write.a, write.v);
+		break;
+	case kWriteReset:
+		resetChip();
+		break;
+	default:
+		break;
+	}
+}
+
 int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
+	if (_thread.isStarted())
+		return readRenderedSamples(buffer, numSamples);
+
 	const int stereoFactor = isStereo() ? 2 : 1;
 	int len = numSamples / stereoFactor;
 	int step;
@@ -367,17 +429,229 @@ int EmulatedOPL::readBuffer(int16 *buffer, const int numSamples) {
 	return numSamples;
 }
 
+void EmulatedOPL::runCallbacks(int length) {
+	int step;
+
+	do {
+		step = length;
+		if (step > (_nextTick >> FIXP_SHIFT))
+			step = (_nextTick >> FIXP_SHIFT);
+
+		_nextTick -= step << FIXP_SHIFT;
+
+		{
+			Common::StackLock lock(_mutex);
+			_callbackPos += step;
+		}
+
+		if (!(_nextTick >> FIXP_SHIFT)) {
+			if (_callback && _callback->isValid())
+				(*_callback)();
+
+			_nextTick += _samplesPerTick;
+		}
+
+		length -= step;
+	} while (length);
+}
+
+int EmulatedOPL::readRenderedSamples(int16 *buffer, const int numSamples) {
+	const int stereoFactor = isStereo() ? 2 : 1;
+	const uint32 length = numSamples / stereoFactor;
+
+	// Only this thread changes _callbackPos, so it can be read without
+	// the lock here.
+	runCallbacks(_playPos + length + _aheadFrames - _callbackPos);
+
+	uint32 remaining = length;
+	while (remaining) {
+		{
+			Common::StackLock lock(_mutex);
+
+			const uint ringFrames = _ring.size() / stereoFactor;
+			while (remaining && _ringFill) {
+				const uint frames = MIN<uint>(MIN<uint>(remaining, _ringFill), ringFrames - _ringRead);
+				memcpy(buffer, &_ring[_ringRead * stereoFactor], frames * stereoFactor * sizeof(int16));
+
+				buffer += frames * stereoFactor;
+				remaining -= frames;
+				_ringRead = (_ringRead + frames) % ringFrames;
+				_ringFill -= frames;
+			}
+
+			// There are new callback writes or free space in the ring
+			if (_synthesisWaiting) {
+				_synthesisWaiting = false;
+				_wake.post();
+			}
+
+			if (!remaining)
+				break;
+
+			// The synthesis thread fell behind, so the mixer has to wait
+			// for it just like it would wait for generateSamples().
+			_readerWaiting = true;
+		}
+
+		_samplesReady.wait();
+	}
+
+	_playPos += length;
+	return numSamples;
+}
+
+void EmulatedOPL::synthesisProc(void *data) {
+	((EmulatedOPL *)data)->synthesize();
+}
+
+void EmulatedOPL::synthesize() {
+	enum {
+		kBlockFrames = 512
+	};
+
+	const int stereoFactor = isStereo() ? 2 : 1;
+	int16 buffer[kBlockFrames * 2];
+	Common::Array<QueuedWrite> writes;
+
+	while (true) {
+		uint32 length;
+		bool wait = false;
+
+		writes.clear();
+
+		{
+			Common::StackLock lock(_mutex);
+			if (_quit)
+				return;
+
+			while (_writesRead < _writes.size() && (int32)(_writes[_writesRead].time - _renderPos) <= 0)
+				writes.push_back(_writes[_writesRead++]);
+
+			if (_writesRead == _writes.size()) {
+				_writes.clear();
+				_writesRead = 0;
+			}
+
+			// Render up to the next write, but not past the callbacks,
+			// which may still write something there.
+			length = _callbackPos - _renderPos;
+			if (_writesRead < _writes.size())
+				length = MIN<uint32>(length, _writes[_writesRead].time - _renderPos);
+			length = MIN<uint32>(length, kBlockFrames);
+			length = MIN<uint32>(length, _ring.size() / stereoFactor - _ringFill);
+
+			if (!length && writes.empty()) {
+				_synthesisWaiting = true;
+				wait = true;
+			}
+		}
+
+		if (wait) {
+			_wake.wait();
+			continue;
+		}
+
+		for (uint i = 0; i < writes.size(); i++)
+			applyWrite(writes[i]);
+
+		if (!length)
+			continue;
+
+		generateSamples(buffer, length * stereoFactor);
+
+		Common::StackLock lock(_mutex);
+
+		const uint ringFrames = _ring.size() / stereoFactor;
+		const int16 *src = buffer;
+		uint32 left = length;
+		while (left) {
+			const uint writePos = (_ringRead + _ringFill) % ringFrames;
+			const uint frames = MIN<uint>(left, ringFrames - writePos);
+			memcpy(&_ring[writePos * stereoFactor], src, frames * stereoFactor * sizeof(int16));
+
+			src += frames * stereoFactor;
+			left -= frames;
+			_ringFill += frames;
+		}
+
+		_renderPos += length;
+
+		if (_readerWaiting) {
+			_readerWaiting = false;
+			_samplesReady.post();
+		}
+	}
+}
+
+bool EmulatedOPL::startSynthesis() {
+	if (!ConfMan.hasKey("opl_render_ahead") || ConfMan.getInt("opl_render_ahead") <= 0)
+		return false;
+
+	if (!g_system->hasFeature(OSystem::kFeatureThreads) || !_wake.isValid() || !_samplesReady.isValid())
+		return false;
+
+	const int stereoFactor = isStereo() ? 2 : 1;
+	const int aheadMillis = MIN(ConfMan.getInt("opl_render_ahead"), 1000);
+
+	_aheadFrames = getRate() * aheadMillis / 1000;
+	_ring.resize((_aheadFrames + 512) * stereoFactor);
+	_ringRead = 0;
+	_ringFill = 0;
+	_callbackPos = 0;
+	_renderPos = 0;
+	_playPos = 0;
+	_quit = false;
+	_synthesisWaiting = false;
+	_readerWaiting = false;
+
+	if (!_thread.start(synthesisProc, this)) {
+		warning("EmulatedOPL: Could not start synthesis thread, rendering on demand");
+		return false;
+	}
+
+	return true;
+}
+
+void EmulatedOPL::stopSynthesis() {
+	if (!_thread.isStarted())
+		return;
+
+	{
+		Common::StackLock lock(_mutex);
+		_quit = true;
+	}
+	_wake.post();
+	_thread.join();
+
+	// Discard wake-ups nobody consumed
+	while (_wake.tryWait())
+		;
+	while (_samplesReady.tryWait())
+		;
+
+	// The emulator has to be in the state the writes left it in, even
+	// though their samples are not played anymore.
+	for (uint i = _writesRead; i < _writes.size(); i++)
+		applyWrite(_writes[i]);
+
+	_writes.clear();
+	_writesRead = 0;
+	_ringFill = 0;
+}
+
 int EmulatedOPL::getRate() const {
 	return g_system->getMixer()->getOutputRate();
 }
 
 void EmulatedOPL::startCallbacks(int timerFrequency) {
 	setCallbackFrequency(timerFrequency);
+	startSynthesis();
 	g_system->getMixer()->playStream(Audio::Mixer::kPlainSoundType, _handle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 }
 
 void EmulatedOPL::stopCallbacks() {
 	g_system->getMixer()->stopHandle(*_handle);
+	stopSynthesis();
 }
 
 void EmulatedOPL::setCallbackFrequency(int timerFrequency) {
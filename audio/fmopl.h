@@ -24,9 +24,12 @@
 
 #include "audio/audiostream.h"
 
+#include "common/array.h"
 #include "common/func.h"
+#include "common/mutex.h"
 #include "common/ptr.h"
 #include "common/scummsys.h"
+#include "common/thread.h"
 
 namespace Audio {
 class SoundHandle;
@@ -243,6 +246,13 @@ private:
  *
  * This will send callbacks based on the number of samples
  * decoded in readBuffer().
+ *
+ * When the "opl_render_ahead" setting is positive and the backend supports
+ * threads, the samples are rendered that many milliseconds ahead of
+ * playback on a synthesis thread. The callbacks still run in readBuffer(),
+ * ahead of playback by the same amount, and all writes are queued with
+ * their position in the output, so that only the synthesis thread uses
+ * the emulator while it runs.
  */
 class EmulatedOPL : public OPL, protected Audio::AudioStream {
 public:
@@ -250,6 +260,9 @@ public:
 	virtual ~EmulatedOPL();
 
 	// OPL API
+	void reset();
+	void write(int a, int v);
+	void writeReg(int r, int v);
 	void setCallbackFrequency(int timerFrequency);
 
 	// AudioStream API
@@ -262,6 +275,23 @@ protected:
 	void startCallbacks(int timerFrequency);
 	void stopCallbacks();
 
+	/**
+	 * Reinitialize the emulator. This implements reset().
+	 */
+	virtual void resetChip() = 0;
+
+	/**
+	 * Write a byte to the given I/O port of the emulator. This
+	 * implements write().
+	 */
+	virtual void writeChip(int a, int v) = 0;
+
+	/**
+	 * Write a byte to an OPL register of the emulator. This implements
+	 * writeReg().
+	 */
+	virtual void writeChipReg(int r, int v) = 0;
+
 	/**
 	 * Read up to 'length' samples.
 	 *
@@ -275,6 +305,38 @@ protected:
 	virtual void generateSamples(int16 *buffer, int numSamples) = 0;
 
 private:
+	enum WriteType {
+		kWritePort,
+		kWriteRegister,
+		kWriteReset
+	};
+
+	struct QueuedWrite {
+		uint32 time;
+		WriteType type;
+		int a;
+		int v;
+	};
+
+	/**
+	 * Queue a write while the synthesis thread runs.
+	 *
+	 * @return false if the write has to be done right away
+	 */
+	bool queueWrite(WriteType type, int a, int v);
+	void applyWrite(const QueuedWrite &write);
+
+	/** Run the callbacks for the next 'length' sample frames. */
+	void runCallbacks(int length);
+
+	int readRenderedSamples(int16 *buffer, const int numSamples);
+
+	static void synthesisProc(void *data);
+	void synthesize();
+
+	bool startSynthesis();
+	void stopSynthesis();
+
 	int _baseFreq;
 
 	enum {
@@ -285,6 +347,26 @@ private:
 	int _samplesPerTick;
 
 	Audio::SoundHandle *_handle;
+
+	Common::Mutex _mutex;
+	Common::Thread _thread;
+	Common::Semaphore _wake;
+	Common::Semaphore _samplesReady;
+
+	// The following members are protected by _mutex while the synthesis
+	// thread runs. Positions are counted in sample frames.
+	Common::Array<QueuedWrite> _writes;
+	uint _writesRead;
+	Common::Array<int16> _ring;
+	uint _ringRead;
+	uint _ringFill;
+	uint32 _callbackPos;
+	uint32 _renderPos;
+	uint32 _playPos;
+	uint32 _aheadFrames;
+	bool _quit;
+	bool _synthesisWaiting;
+	bool _readerWaiting;
 };
 /** @} */
 } // End of namespace OPL
@@ -212,6 +212,15 @@ public:
 	 */
 	virtual uint16 sysExNoDelay(const byte *msg, uint16 length) { sysEx(msg, length); return 0; }
 
+	/**
+	 * Set the time in microseconds, counted from the start of the current
+	 * timer callback, at which the following events are due. The MIDI
+	 * parser calls this before sending each event, so drivers which render
+	 * their output themselves can play events at the correct sample
+	 * instead of at the start of the callback. Other drivers ignore it.
+	 */
+	virtual void setEventDelay(uint32 delay) { }
+
 	// TODO: Document this.
 	virtual void metaEvent(byte type, byte *data, uint16 length) { }
 
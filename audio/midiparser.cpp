@@ -200,6 +200,7 @@ void MidiParser::onTimer() {
 		for (i = ARRAYSIZE(_hangingNotes); i; --i, ++ptr) {
 			if (ptr->timeLeft) {
 				if (ptr->timeLeft <= _timerRate) {
+					_driver->setEventDelay(ptr->timeLeft);
 					sendToDriver(0x80 | ptr->channel, ptr->note, 0);
 					ptr->timeLeft = 0;
 					--_hangingNotesCount;
@@ -222,6 +223,7 @@ void MidiParser::onTimer() {
 		if (info.event < 0x80) {
 			warning("Bad command or running status %02X", info.event);
 			_position._playPos = nullptr;
+			_driver->setEventDelay(0);
 			return;
 		}
 
@@ -234,6 +236,10 @@ void MidiParser::onTimer() {
 				activeNote(info.channel(), info.basic.param1, true);
 		}
 
+		// Let the driver play the event at its exact time within the
+		// timer period, if it can.
+		_driver->setEventDelay(eventTime > _position._playTime ? eventTime - _position._playTime : 0);
+
 		// Player::metaEvent() in SCUMM will delete the parser object,
 		// so return immediately if that might have happened.
 		bool ret = processEvent(info);
@@ -249,6 +255,8 @@ void MidiParser::onTimer() {
 		}
 	}
 
+	_driver->setEventDelay(0);
+
 	if (!_abortParse) {
 		_position._playTime = endTime;
 		_position._playTick = (_position._playTime - _position._lastEventTime) / _psecPerTick + _position._lastEventTick;
@@ -122,6 +122,11 @@ void MidiPlayer::sendToChannel(byte ch, uint32 b) {
 	}
 }
 
+void MidiPlayer::setEventDelay(uint32 delay) {
+	if (_driver)
+		_driver->setEventDelay(delay);
+}
+
 void MidiPlayer::metaEvent(byte type, byte *data, uint16 length) {
 	switch (type) {
 	case 0x2F:	// End of Track
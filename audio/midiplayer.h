@@ -123,6 +123,7 @@ public:
 
 	// MidiDriver_BASE implementation
 	void send(uint32 b) override;
+	void setEventDelay(uint32 delay) override;
 	void metaEvent(byte type, byte *data, uint16 length) override;
 
 protected:
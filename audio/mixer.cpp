@@ -21,10 +21,13 @@
 
 #include "gui/EventRecorder.h"
 
+#include "common/config-manager.h"
+#include "common/profiler.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
 #include "audio/mixer_intern.h"
+#include "audio/mixkernels.h"
 #include "audio/rate.h"
 #include "audio/audiostream.h"
 #include "audio/timestamp.h"
@@ -42,7 +45,7 @@ namespace Audio {
  */
 class Channel {
 public:
-	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent);
+	Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream, DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality);
 	~Channel();
 
 	/**
@@ -177,17 +180,24 @@ private:
 #pragma mark -
 
 MixerImpl::MixerImpl(uint sampleRate, uint outBufSize)
-	: _mutex(), _sampleRate(sampleRate), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings() {
+	: _mutex(), _sampleRate(sampleRate), _outBufSize(outBufSize), _mixerReady(false), _handleSeed(0), _soundTypeSettings(),
+	  _headroomMixing(false), _channelBuf(nullptr), _mixBus(nullptr), _mixBufSize(0) {
 
 	assert(sampleRate > 0);
 
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		_channels[i] = nullptr;
+
+	if (ConfMan.hasKey("audio_mix_headroom"))
+		setHeadroomMixing(ConfMan.getBool("audio_mix_headroom"));
 }
 
 MixerImpl::~MixerImpl() {
 	for (int i = 0; i != NUM_CHANNELS; i++)
 		delete _channels[i];
+
+	delete[] _channelBuf;
+	delete[] _mixBus;
 }
 
 void MixerImpl::setReady(bool ready) {
@@ -204,6 +214,16 @@ uint MixerImpl::getOutputBufSize() const {
 	return _outBufSize;
 }
 
+void MixerImpl::setHeadroomMixing(bool enable) {
+	Common::StackLock lock(_mutex);
+
+#ifdef OUTPUT_UNSIGNED_AUDIO
+	// The bus holds signed samples
+	enable = false;
+#endif
+	_headroomMixing = enable;
+}
+
 void MixerImpl::insertChannel(SoundHandle *handle, Channel *chan) {
 	int index = -1;
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -268,7 +288,8 @@ void MixerImpl::playStream(
 #endif
 
 	// Create the channel
-	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent);
+	const RateConverterQuality quality = parseRateConverterQuality(ConfMan.get("resampler_quality"));
+	Channel *chan = new Channel(this, type, stream, autofreeStream, reverseStereo, id, permanent, quality);
 	chan->setVolume(volume);
 	chan->setBalance(balance);
 	insertChannel(handle, chan);
@@ -277,6 +298,8 @@ void MixerImpl::playStream(
 int MixerImpl::mixCallback(byte *samples, uint len) {
 	assert(samples);
 
+	PROFILE_SCOPE_TRACK("mixCallback", Common::kProfilerTrackAudio);
+
 	Common::StackLock lock(_mutex);
 
 	int16 *buf = (int16 *)samples;
@@ -287,6 +310,9 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	// Since the mixer callback has been called, the mixer must be ready...
 	_mixerReady = true;
 
+	if (_headroomMixing)
+		return mixWithHeadroom(buf, len);
+
 	//  zero the buf
 	memset(buf, 0, 2 * len * sizeof(int16));
 
@@ -308,6 +334,43 @@ int MixerImpl::mixCallback(byte *samples, uint len) {
 	return res;
 }
 
+int MixerImpl::mixWithHeadroom(int16 *buf, uint len) {
+	const MixKernels &kernels = getMixKernels();
+	const uint count = 2 * len;
+
+	// Only grows, so that the callback does not allocate all the time
+	if (count > _mixBufSize) {
+		delete[] _channelBuf;
+		delete[] _mixBus;
+		_channelBuf = new int16[count];
+		_mixBus = new int32[count];
+		_mixBufSize = count;
+	}
+
+	memset(_mixBus, 0, count * sizeof(int32));
+
+	int res = 0, tmp;
+	for (int i = 0; i != NUM_CHANNELS; i++)
+		if (_channels[i]) {
+			if (_channels[i]->isFinished()) {
+				delete _channels[i];
+				_channels[i] = nullptr;
+			} else if (!_channels[i]->isPaused()) {
+				// Each channel is still saturated on its own, but
+				// overlapping channels no longer clip each other
+				memset(_channelBuf, 0, count * sizeof(int16));
+				tmp = _channels[i]->mix(_channelBuf, len);
+				kernels.accumulate(_mixBus, _channelBuf, count);
+
+				if (tmp > res)
+					res = tmp;
+			}
+		}
+
+	kernels.pack(buf, _mixBus, count);
+	return res;
+}
+
 void MixerImpl::stopAll() {
 	Common::StackLock lock(_mutex);
 	for (int i = 0; i != NUM_CHANNELS; i++) {
@@ -515,7 +578,7 @@ int MixerImpl::getVolumeForSoundType(SoundType type) const {
 #pragma mark -
 
 Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
-				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent)
+				 DisposeAfterUse::Flag autofreeStream, bool reverseStereo, int id, bool permanent, RateConverterQuality quality)
 	: _type(type), _mixer(mixer), _id(id), _permanent(permanent), _volume(Mixer::kMaxChannelVolume),
 	  _balance(0), _pauseLevel(0), _samplesConsumed(0), _samplesDecoded(0), _mixerTimeStamp(0),
 	  _pauseStartTime(0), _pauseTime(0), _converter(nullptr), _volL(0), _volR(0),
@@ -524,7 +587,7 @@ Channel::Channel(Mixer *mixer, Mixer::SoundType type, AudioStream *stream,
 	assert(stream);
 
 	// Get a rate converter instance
-	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo);
+	_converter = makeRateConverter(_stream->getRate(), mixer->getOutputRate(), _stream->isStereo(), reverseStereo, quality);
 }
 
 Channel::~Channel() {
@@ -78,6 +78,15 @@ private:
 	SoundTypeSettings _soundTypeSettings[4];
 	Channel *_channels[NUM_CHANNELS];
 
+	/**
+	 * With headroom mixing, every channel is mixed on its own and summed
+	 * on a 32-bit bus, which is only saturated to 16 bits at the end.
+	 */
+	bool _headroomMixing;
+	int16 *_channelBuf;
+	int32 *_mixBus;
+	uint _mixBufSize;
+
 
 public:
 
@@ -134,6 +143,11 @@ public:
 protected:
 	void insertChannel(SoundHandle *handle, Channel *chan);
 
+	/**
+	 * Mix all channels on the 32-bit bus. Must be called with _mutex held.
+	 */
+	int mixWithHeadroom(int16 *buf, uint len);
+
 public:
 	/**
 	 * The mixer callback function, to be called at regular intervals by
@@ -152,6 +166,13 @@ public:
 	 * their audio system has been completed.
 	 */
 	void setReady(bool ready);
+
+	/**
+	 * Select whether overlapping channels are summed with headroom and
+	 * saturated once, instead of saturating after each channel. This is
+	 * initialized from the "audio_mix_headroom" setting.
+	 */
+	void setHeadroomMixing(bool enable);
 };
 
 /** @} */
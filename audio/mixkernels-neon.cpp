@@ -0,0 +1,156 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/mixkernels.h"
+#include "audio/mixer.h"
+
+#include <arm_neon.h>
+
+namespace Audio {
+
+STATIC_ASSERT(Mixer::kMaxMixerVolume == (1 << 8), mixer_volume_must_match_shift);
+
+/**
+ * Scale eight samples by eight volumes, dividing by Mixer::kMaxMixerVolume
+ * with rounding towards zero to match the scalar code.
+ */
+static inline int16x8_t scaleSamples(int16x8_t samples, int16x8_t vol) {
+	const int32x4_t bias = vdupq_n_s32(Mixer::kMaxMixerVolume - 1);
+
+	int32x4_t p0 = vmull_s16(vget_low_s16(samples), vget_low_s16(vol));
+	int32x4_t p1 = vmull_s16(vget_high_s16(samples), vget_high_s16(vol));
+
+	p0 = vaddq_s32(p0, vandq_s32(vshrq_n_s32(p0, 31), bias));
+	p1 = vaddq_s32(p1, vandq_s32(vshrq_n_s32(p1, 31), bias));
+
+	return vcombine_s16(vqmovn_s32(vshrq_n_s32(p0, 8)), vqmovn_s32(vshrq_n_s32(p1, 8)));
+}
+
+static inline void addSamples(st_sample_t *dst, int16x8_t samples) {
+	vst1q_s16(dst, vqaddq_s16(vld1q_s16(dst), samples));
+}
+
+static inline int16x8_t makeVolume(st_volume_t vol_l, st_volume_t vol_r) {
+	const int16 v[8] = { (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r, (int16)vol_l, (int16)vol_r };
+	return vld1q_s16(v);
+}
+
+static void mixMonoNEON(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const int16x8_t vol = makeVolume(vol_l, vol_r);
+
+	for (; frames >= 8; frames -= 8) {
+		const int16x8_t s = vld1q_s16(src);
+		const int16x8x2_t dup = vzipq_s16(s, s);
+
+		addSamples(dst,     scaleSamples(dup.val[0], vol));
+		addSamples(dst + 8, scaleSamples(dup.val[1], vol));
+		src += 8;
+		dst += 16;
+	}
+
+	getScalarMixKernels().mixMono(dst, src, frames, vol_l, vol_r);
+}
+
+static void mixStereoNEON(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const int16x8_t vol = makeVolume(vol_l, vol_r);
+
+	for (; frames >= 4; frames -= 4) {
+		addSamples(dst, scaleSamples(vld1q_s16(src), vol));
+		src += 8;
+		dst += 8;
+	}
+
+	getScalarMixKernels().mixStereo(dst, src, frames, vol_l, vol_r);
+}
+
+static void mixStereoReverseNEON(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	// After swapping each pair of samples, the right input channel ends up
+	// in the left output channel, so the volumes have to be swapped as well.
+	const int16x8_t vol = makeVolume(vol_r, vol_l);
+
+	for (; frames >= 4; frames -= 4) {
+		addSamples(dst, scaleSamples(vrev32q_s16(vld1q_s16(src)), vol));
+		src += 8;
+		dst += 8;
+	}
+
+	getScalarMixKernels().mixStereoReverse(dst, src, frames, vol_l, vol_r);
+}
+
+static int32 firNEON(const st_sample_t *samples, const int16 *coefs, st_size_t taps) {
+	int32x4_t acc = vdupq_n_s32(0);
+	st_size_t i = 0;
+
+	for (; i + 8 <= taps; i += 8) {
+		const int16x8_t s = vld1q_s16(samples + i);
+		const int16x8_t c = vld1q_s16(coefs + i);
+		acc = vmlal_s16(acc, vget_low_s16(s), vget_low_s16(c));
+		acc = vmlal_s16(acc, vget_high_s16(s), vget_high_s16(c));
+	}
+
+	int32x2_t pair = vadd_s32(vget_low_s32(acc), vget_high_s32(acc));
+	pair = vpadd_s32(pair, pair);
+
+	int32 sum = vget_lane_s32(pair, 0);
+	for (; i < taps; i++)
+		sum += samples[i] * coefs[i];
+	return sum;
+}
+
+static void accumulateNEON(int32 *acc, const st_sample_t *src, st_size_t count) {
+	for (; count >= 8; count -= 8) {
+		const int16x8_t s = vld1q_s16(src);
+
+		vst1q_s32(acc, vaddw_s16(vld1q_s32(acc), vget_low_s16(s)));
+		vst1q_s32(acc + 4, vaddw_s16(vld1q_s32(acc + 4), vget_high_s16(s)));
+		src += 8;
+		acc += 8;
+	}
+
+	getScalarMixKernels().accumulate(acc, src, count);
+}
+
+static void packNEON(st_sample_t *dst, const int32 *acc, st_size_t count) {
+	for (; count >= 8; count -= 8) {
+		const int16x4_t lo = vqmovn_s32(vld1q_s32(acc));
+		const int16x4_t hi = vqmovn_s32(vld1q_s32(acc + 4));
+
+		vst1q_s16(dst, vcombine_s16(lo, hi));
+		acc += 8;
+		dst += 8;
+	}
+
+	getScalarMixKernels().pack(dst, acc, count);
+}
+
+const MixKernels &getNEONMixKernels() {
+	static const MixKernels kernels = {
+		mixMonoNEON,
+		mixStereoNEON,
+		mixStereoReverseNEON,
+		firNEON,
+		accumulateNEON,
+		packNEON
+	};
+	return kernels;
+}
+
+} // End of namespace Audio
@@ -0,0 +1,163 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/mixkernels.h"
+#include "audio/mixer.h"
+
+#include <emmintrin.h>
+
+namespace Audio {
+
+STATIC_ASSERT(Mixer::kMaxMixerVolume == (1 << 8), mixer_volume_must_match_shift);
+
+/**
+ * Scale eight samples by eight volumes, dividing by Mixer::kMaxMixerVolume
+ * with rounding towards zero to match the scalar code.
+ */
+static inline __m128i scaleSamples(__m128i samples, __m128i vol) {
+	const __m128i lo = _mm_mullo_epi16(samples, vol);
+	const __m128i hi = _mm_mulhi_epi16(samples, vol);
+	const __m128i bias = _mm_set1_epi32(Mixer::kMaxMixerVolume - 1);
+
+	__m128i p0 = _mm_unpacklo_epi16(lo, hi);
+	__m128i p1 = _mm_unpackhi_epi16(lo, hi);
+
+	p0 = _mm_add_epi32(p0, _mm_and_si128(_mm_srai_epi32(p0, 31), bias));
+	p1 = _mm_add_epi32(p1, _mm_and_si128(_mm_srai_epi32(p1, 31), bias));
+	p0 = _mm_srai_epi32(p0, 8);
+	p1 = _mm_srai_epi32(p1, 8);
+
+	return _mm_packs_epi32(p0, p1);
+}
+
+static inline void addSamples(st_sample_t *dst, __m128i samples) {
+	const __m128i d = _mm_loadu_si128((const __m128i *)dst);
+	_mm_storeu_si128((__m128i *)dst, _mm_adds_epi16(d, samples));
+}
+
+static void mixMonoSSE2(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m128i vol = _mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+
+	for (; frames >= 8; frames -= 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+
+		addSamples(dst,     scaleSamples(_mm_unpacklo_epi16(s, s), vol));
+		addSamples(dst + 8, scaleSamples(_mm_unpackhi_epi16(s, s), vol));
+		src += 8;
+		dst += 16;
+	}
+
+	getScalarMixKernels().mixMono(dst, src, frames, vol_l, vol_r);
+}
+
+static void mixStereoSSE2(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const __m128i vol = _mm_set_epi16(vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l);
+
+	for (; frames >= 4; frames -= 4) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+
+		addSamples(dst, scaleSamples(s, vol));
+		src += 8;
+		dst += 8;
+	}
+
+	getScalarMixKernels().mixStereo(dst, src, frames, vol_l, vol_r);
+}
+
+static void mixStereoReverseSSE2(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	// After swapping each pair of samples, the right input channel ends up
+	// in the left output channel, so the volumes have to be swapped as well.
+	const __m128i vol = _mm_set_epi16(vol_l, vol_r, vol_l, vol_r, vol_l, vol_r, vol_l, vol_r);
+
+	for (; frames >= 4; frames -= 4) {
+		__m128i s = _mm_loadu_si128((const __m128i *)src);
+		s = _mm_shufflelo_epi16(s, _MM_SHUFFLE(2, 3, 0, 1));
+		s = _mm_shufflehi_epi16(s, _MM_SHUFFLE(2, 3, 0, 1));
+
+		addSamples(dst, scaleSamples(s, vol));
+		src += 8;
+		dst += 8;
+	}
+
+	getScalarMixKernels().mixStereoReverse(dst, src, frames, vol_l, vol_r);
+}
+
+static int32 firSSE2(const st_sample_t *samples, const int16 *coefs, st_size_t taps) {
+	__m128i acc = _mm_setzero_si128();
+	st_size_t i = 0;
+
+	for (; i + 8 <= taps; i += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(samples + i));
+		const __m128i c = _mm_loadu_si128((const __m128i *)(coefs + i));
+		acc = _mm_add_epi32(acc, _mm_madd_epi16(s, c));
+	}
+
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(1, 0, 3, 2)));
+	acc = _mm_add_epi32(acc, _mm_shuffle_epi32(acc, _MM_SHUFFLE(2, 3, 0, 1)));
+
+	int32 sum = _mm_cvtsi128_si32(acc);
+	for (; i < taps; i++)
+		sum += samples[i] * coefs[i];
+	return sum;
+}
+
+static void accumulateSSE2(int32 *acc, const st_sample_t *src, st_size_t count) {
+	for (; count >= 8; count -= 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+		// Sign extend by moving each sample to the upper half first
+		const __m128i lo = _mm_srai_epi32(_mm_unpacklo_epi16(s, s), 16);
+		const __m128i hi = _mm_srai_epi32(_mm_unpackhi_epi16(s, s), 16);
+
+		_mm_storeu_si128((__m128i *)acc, _mm_add_epi32(_mm_loadu_si128((const __m128i *)acc), lo));
+		_mm_storeu_si128((__m128i *)(acc + 4), _mm_add_epi32(_mm_loadu_si128((const __m128i *)(acc + 4)), hi));
+		src += 8;
+		acc += 8;
+	}
+
+	getScalarMixKernels().accumulate(acc, src, count);
+}
+
+static void packSSE2(st_sample_t *dst, const int32 *acc, st_size_t count) {
+	for (; count >= 8; count -= 8) {
+		const __m128i lo = _mm_loadu_si128((const __m128i *)acc);
+		const __m128i hi = _mm_loadu_si128((const __m128i *)(acc + 4));
+
+		_mm_storeu_si128((__m128i *)dst, _mm_packs_epi32(lo, hi));
+		acc += 8;
+		dst += 8;
+	}
+
+	getScalarMixKernels().pack(dst, acc, count);
+}
+
+const MixKernels &getSSE2MixKernels() {
+	static const MixKernels kernels = {
+		mixMonoSSE2,
+		mixStereoSSE2,
+		mixStereoReverseSSE2,
+		firSSE2,
+		accumulateSSE2,
+		packSSE2
+	};
+	return kernels;
+}
+
+} // End of namespace Audio
@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/mixkernels.h"
+#include "audio/mixer.h"
+#include "common/cpu.h"
+
+namespace Audio {
+
+static void mixMonoScalar(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	for (; frames > 0; frames--) {
+		const st_sample_t sample = *src++;
+
+		clampedAdd(dst[0], (sample * (int)vol_l) / Mixer::kMaxMixerVolume);
+		clampedAdd(dst[1], (sample * (int)vol_r) / Mixer::kMaxMixerVolume);
+		dst += 2;
+	}
+}
+
+static void mixStereoScalar(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	for (; frames > 0; frames--) {
+		clampedAdd(dst[0], (src[0] * (int)vol_l) / Mixer::kMaxMixerVolume);
+		clampedAdd(dst[1], (src[1] * (int)vol_r) / Mixer::kMaxMixerVolume);
+		src += 2;
+		dst += 2;
+	}
+}
+
+static void mixStereoReverseScalar(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	for (; frames > 0; frames--) {
+		clampedAdd(dst[1], (src[0] * (int)vol_l) / Mixer::kMaxMixerVolume);
+		clampedAdd(dst[0], (src[1] * (int)vol_r) / Mixer::kMaxMixerVolume);
+		src += 2;
+		dst += 2;
+	}
+}
+
+static int32 firScalar(const st_sample_t *samples, const int16 *coefs, st_size_t taps) {
+	int32 sum = 0;
+	for (st_size_t i = 0; i < taps; i++)
+		sum += samples[i] * coefs[i];
+	return sum;
+}
+
+static void accumulateScalar(int32 *acc, const st_sample_t *src, st_size_t count) {
+	for (st_size_t i = 0; i < count; i++)
+		acc[i] += src[i];
+}
+
+static void packScalar(st_sample_t *dst, const int32 *acc, st_size_t count) {
+	for (st_size_t i = 0; i < count; i++)
+		dst[i] = (st_sample_t)CLIP<int32>(acc[i], ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+}
+
+const MixKernels &getScalarMixKernels() {
+	static const MixKernels kernels = {
+		mixMonoScalar,
+		mixStereoScalar,
+		mixStereoReverseScalar,
+		firScalar,
+		accumulateScalar,
+		packScalar
+	};
+	return kernels;
+}
+
+const MixKernels &getMixKernels() {
+	// The SIMD kernels use saturating signed arithmetic, which does not
+	// match the behaviour of clampedAdd() for unsigned output.
+#ifndef OUTPUT_UNSIGNED_AUDIO
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return getSSE2MixKernels();
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return getNEONMixKernels();
+#endif
+#endif
+
+	return getScalarMixKernels();
+}
+
+} // End of namespace Audio
@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_MIXKERNELS_H
+#define AUDIO_MIXKERNELS_H
+
+#include "audio/rate.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_mixkernels Mixing kernels
+ * @ingroup audio
+ *
+ * @brief Low-level routines which scale samples and add them to the output buffer.
+ * @{
+ */
+
+/**
+ * Scale a block of input samples by the given volumes and add them,
+ * saturated to 16 bits, to an interleaved stereo output buffer.
+ *
+ * @param dst    Interleaved stereo output buffer.
+ * @param src    Input samples (one per frame for mono, two for stereo).
+ * @param frames Number of sample frames to process.
+ * @param vol_l  Volume of the left output channel (0 - Mixer::kMaxMixerVolume).
+ * @param vol_r  Volume of the right output channel (0 - Mixer::kMaxMixerVolume).
+ */
+typedef void (*MixFunc)(st_sample_t *dst, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r);
+
+/**
+ * Compute the dot product of a block of samples and FIR filter coefficients.
+ *
+ * @param samples Input samples of a single channel.
+ * @param coefs   Filter coefficients.
+ * @param taps    Number of samples and coefficients.
+ * @return The unscaled sum of the products.
+ */
+typedef int32 (*FirFunc)(const st_sample_t *samples, const int16 *coefs, st_size_t taps);
+
+/**
+ * Add a block of samples to a 32-bit mixing bus, without saturation.
+ *
+ * @param acc   Mixing bus.
+ * @param src   Samples to add.
+ * @param count Number of samples (not frames).
+ */
+typedef void (*AccumulateFunc)(int32 *acc, const st_sample_t *src, st_size_t count);
+
+/**
+ * Saturate a block of a 32-bit mixing bus to 16-bit output samples.
+ *
+ * @param dst   Output samples.
+ * @param acc   Mixing bus.
+ * @param count Number of samples (not frames).
+ */
+typedef void (*PackFunc)(st_sample_t *dst, const int32 *acc, st_size_t count);
+
+/**
+ * Set of mixing routines for a specific instruction set.
+ *
+ * All implementations produce bit-identical output to the scalar ones.
+ */
+struct MixKernels {
+	/** Mixes mono input into both output channels. */
+	MixFunc mixMono;
+	/** Mixes stereo input. */
+	MixFunc mixStereo;
+	/** Mixes stereo input, with the left and right input channels swapped. */
+	MixFunc mixStereoReverse;
+	/** Applies a FIR filter to one channel. */
+	FirFunc fir;
+	/** Adds a mixed channel to the headroom mixing bus. */
+	AccumulateFunc accumulate;
+	/** Converts the headroom mixing bus to output samples. */
+	PackFunc pack;
+};
+
+/**
+ * Return the fastest mixing routines supported by the host CPU.
+ */
+const MixKernels &getMixKernels();
+
+/**
+ * Return the portable C++ mixing routines.
+ */
+const MixKernels &getScalarMixKernels();
+
+#ifdef SCUMMVM_SSE2
+const MixKernels &getSSE2MixKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const MixKernels &getNEONMixKernels();
+#endif
+
+/** @} */
+} // End of namespace Audio
+
+#endif
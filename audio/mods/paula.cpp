@@ -36,7 +36,6 @@
 
 #include "audio/mixer.h"
 #include "audio/mods/paula.h"
-#include "audio/null.h"
 
 namespace Audio {
 
@@ -158,23 +157,65 @@ inline int32 filter(int32 input, Paula::FilterState &state, int voice) {
 
 template<bool stereo>
 inline int mixBuffer(int16 *&buf, const int8 *data, Paula::Offset &offset, frac_t rate, int neededSamples, uint bufSize, byte volume, byte panning, Paula::FilterState &filterState, int voice) {
-	int samples;
-	for (samples = 0; samples < neededSamples && offset.int_off < bufSize; ++samples) {
-		const int32 tmp = filter(((int32) data[offset.int_off]) * volume, filterState, voice);
+	// Work out up front how many samples can be generated before the end of
+	// the sample data is reached, so that the loops below need no checks.
+	const uint64 pos = ((uint64)offset.int_off << FRAC_BITS) | offset.rem_off;
+	const uint64 end = (uint64)bufSize << FRAC_BITS;
+	if (pos >= end)
+		return 0;
+
+	int samples = neededSamples;
+	if (rate > 0) {
+		const uint64 available = (end - pos + rate - 1) / rate;
+		if (available < (uint64)samples)
+			samples = (int)available;
+	}
+
+	uint intOff = offset.int_off;
+	frac_t remOff = offset.rem_off;
+
+	if (filterState.mode == Paula::kFilterModeNone) {
+		// Without filtering, the volume and the panning can be applied with
+		// a single multiplication
 		if (stereo) {
-			*buf++ += (tmp * (255 - panning)) >> 7;
-			*buf++ += (tmp * (panning)) >> 7;
-		} else
-			*buf++ += tmp;
-
-		// Step to next source sample
-		offset.rem_off += rate;
-		if (offset.rem_off >= (frac_t)FRAC_ONE) {
-			offset.int_off += fracToInt(offset.rem_off);
-			offset.rem_off &= FRAC_LO_MASK;
+			const int32 volLeft = volume * (255 - panning);
+			const int32 volRight = volume * panning;
+			for (int i = 0; i < samples; ++i) {
+				const int32 tmp = data[intOff];
+				*buf++ += (tmp * volLeft) >> 7;
+				*buf++ += (tmp * volRight) >> 7;
+
+				// Step to next source sample
+				remOff += rate;
+				intOff += remOff >> FRAC_BITS;
+				remOff &= FRAC_LO_MASK;
+			}
+		} else {
+			for (int i = 0; i < samples; ++i) {
+				*buf++ += data[intOff] * volume;
+
+				remOff += rate;
+				intOff += remOff >> FRAC_BITS;
+				remOff &= FRAC_LO_MASK;
+			}
+		}
+	} else {
+		for (int i = 0; i < samples; ++i) {
+			const int32 tmp = filter(((int32) data[intOff]) * volume, filterState, voice);
+			if (stereo) {
+				*buf++ += (tmp * (255 - panning)) >> 7;
+				*buf++ += (tmp * (panning)) >> 7;
+			} else
+				*buf++ += tmp;
+
+			remOff += rate;
+			intOff += remOff >> FRAC_BITS;
+			remOff &= FRAC_LO_MASK;
 		}
 	}
 
+	offset.int_off = intOff;
+	offset.rem_off = remOff;
 	return samples;
 }
 
@@ -300,34 +341,3 @@ float Paula::filterCalculateA0(int rate, int cutoff) {
 }
 
 } // End of namespace Audio
-
-
-//	Plugin interface
-//	(This can only create a null driver since apple II gs support seeems not to be implemented
-//  and also is not part of the midi driver architecture. But we need the plugin for the options
-//  menu in the launcher and for MidiDriver::detectDevice() which is more or less used by all engines.)
-
-class AmigaMusicPlugin : public NullMusicPlugin {
-public:
-	const char *getName() const override {
-		return _s("Amiga Audio emulator");
-	}
-
-	const char *getId() const override {
-		return "amiga";
-	}
-
-	MusicDevices getDevices() const override;
-};
-
-MusicDevices AmigaMusicPlugin::getDevices() const {
-	MusicDevices devices;
-	devices.push_back(MusicDevice(this, "", MT_AMIGA));
-	return devices;
-}
-
-//#if PLUGIN_ENABLED_DYNAMIC(AMIGA)
-	//REGISTER_PLUGIN_DYNAMIC(AMIGA, PLUGIN_TYPE_MUSIC, AmigaMusicPlugin);
-//#else
-	REGISTER_PLUGIN_STATIC(AMIGA, PLUGIN_TYPE_MUSIC, AmigaMusicPlugin);
-//#endif
@@ -4,6 +4,7 @@ MODULE_OBJS := \
 	adlib.o \
 	adlib_ms.o \
 	audiostream.o \
+	decoded_clip_cache.o \
 	fmopl.o \
 	mididrv.o \
 	mididrv_ms.o \
@@ -15,10 +16,12 @@ MODULE_OBJS := \
 	miles_adlib.o \
 	miles_midi.o \
 	mixer.o \
+	mixkernels.o \
 	mpu401.o \
 	mt32gm.o \
 	musicplugin.o \
 	null.o \
+	prefetchingstream.o \
 	rate.o \
 	timestamp.o \
 	decoders/3do.o \
@@ -47,6 +50,7 @@ MODULE_OBJS := \
 	mods/module_mod_xm_s3m.o \
 	mods/protracker.o \
 	mods/paula.o \
+	mods/paula_plugin.o \
 	mods/rjp1.o \
 	mods/soundfx.o \
 	mods/tfmx.o \
@@ -68,6 +72,7 @@ MODULE_OBJS := \
 	softsynth/eas.o \
 	softsynth/pcspk.o \
 	softsynth/sid.o \
+	softsynth/sid_plugin.o \
 	softsynth/wave6581.o \
 	soundfont/rawfile.o \
 	soundfont/rifffile.o \
@@ -90,6 +95,18 @@ MODULE_OBJS += \
 	decoders/ac3.o
 endif
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	mixkernels-sse2.o
+
+$(MODULE)/mixkernels-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	mixkernels-neon.o
+endif
+
 ifdef USE_ALSA
 MODULE_OBJS += \
 	alsa_opl.o
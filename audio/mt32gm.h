@@ -270,6 +270,10 @@ public:
 	void send(int8 source, uint32 b) override;
 	void sysEx(const byte *msg, uint16 length) override;
 	uint16 sysExNoDelay(const byte *msg, uint16 length) override;
+	void setEventDelay(uint32 delay) override {
+		if (_driver)
+			_driver->setEventDelay(delay);
+	}
 	/**
 	 * Puts a SysEx message on the SysEx queue. The message will be sent when
 	 * the device is ready to receive it, without blocking the thread.
@@ -0,0 +1,214 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/prefetchingstream.h"
+
+#include "common/system.h"
+#include "common/textconsole.h"
+
+namespace Audio {
+
+PrefetchingAudioStream::PrefetchingAudioStream(AudioStream *parent, DisposeAfterUse::Flag disposeAfterUse, uint32 bufferMsecs)
+	: _parent(parent, disposeAfterUse), _stereo(parent->isStereo()), _rate(parent->getRate()),
+	  _readPos(0), _fill(0), _parentEnded(false), _quit(false), _workerWaiting(false), _readerWaiting(false) {
+
+	// Keep at least two chunks, so that the worker can decode one while
+	// the other is being played.
+	const uint samples = (uint)((uint64)_rate * bufferMsecs / 1000) * (_stereo ? 2 : 1);
+	_bufferSize = MAX<uint>(samples, 2 * kChunkSize);
+	_buffer = new int16[_bufferSize];
+
+	// Decode the start right away, so that playback does not begin with
+	// an underrun.
+	decodeChunk();
+	startWorker();
+}
+
+PrefetchingAudioStream::~PrefetchingAudioStream() {
+	stopWorker();
+	delete[] _buffer;
+}
+
+void PrefetchingAudioStream::workerProc(void *data) {
+	((PrefetchingAudioStream *)data)->work();
+}
+
+void PrefetchingAudioStream::work() {
+	while (true) {
+		bool wait = false;
+
+		{
+			Common::StackLock lock(_mutex);
+			if (_quit)
+				return;
+
+			if (_parentEnded || _bufferSize - _fill < kChunkSize) {
+				_workerWaiting = true;
+				wait = true;
+			}
+		}
+
+		if (wait)
+			_wake.wait();
+		else
+			decodeChunk();
+	}
+}
+
+void PrefetchingAudioStream::decodeChunk() {
+	// Decode without holding the lock, so that the reader does not wait for
+	// the decoder while there is data left in the buffer.
+	const int len = _parent->readBuffer(_decodeBuffer, kChunkSize);
+	const bool ended = (len < kChunkSize) || _parent->endOfData();
+
+	Common::StackLock lock(_mutex);
+
+	const int16 *src = _decodeBuffer;
+	int remaining = MAX(len, 0);
+	while (remaining > 0) {
+		const uint writePos = (_readPos + _fill) % _bufferSize;
+		const int count = MIN<int>(remaining, _bufferSize - writePos);
+
+		memcpy(_buffer + writePos, src, count * sizeof(int16));
+		_fill += count;
+		src += count;
+		remaining -= count;
+	}
+
+	_parentEnded = ended;
+
+	if (_readerWaiting) {
+		_readerWaiting = false;
+		_dataReady.post();
+	}
+}
+
+int PrefetchingAudioStream::readBuffer(int16 *buffer, const int numSamples) {
+	int samples = 0;
+
+	while (samples < numSamples) {
+		bool wait = false;
+
+		{
+			Common::StackLock lock(_mutex);
+
+			const int count = MIN<int>(MIN<int>(numSamples - samples, _fill), _bufferSize - _readPos);
+			if (count > 0) {
+				memcpy(buffer + samples, _buffer + _readPos, count * sizeof(int16));
+				_readPos = (_readPos + count) % _bufferSize;
+				_fill -= count;
+				samples += count;
+				continue;
+			}
+
+			if (_parentEnded)
+				break;
+
+			if (_thread.isStarted()) {
+				// The worker fell behind. Wait for its next chunk, which
+				// costs no more than decoding it here would.
+				_readerWaiting = true;
+				if (_workerWaiting) {
+					_workerWaiting = false;
+					_wake.post();
+				}
+				wait = true;
+			}
+		}
+
+		if (wait)
+			_dataReady.wait();
+		else
+			decodeChunk();
+	}
+
+	// Let the worker refill the buffer
+	Common::StackLock lock(_mutex);
+	if (_workerWaiting && !_parentEnded) {
+		_workerWaiting = false;
+		_wake.post();
+	}
+
+	return samples;
+}
+
+bool PrefetchingAudioStream::endOfData() const {
+	Common::StackLock lock(_mutex);
+	return _fill == 0 && _parentEnded;
+}
+
+bool PrefetchingAudioStream::rewind() {
+	RewindableAudioStream *rewindable = dynamic_cast<RewindableAudioStream *>(_parent.get());
+	if (!rewindable)
+		return false;
+
+	stopWorker();
+
+	const bool result = rewindable->rewind();
+
+	_readPos = 0;
+	_fill = 0;
+	_parentEnded = false;
+
+	decodeChunk();
+	startWorker();
+
+	return result;
+}
+
+void PrefetchingAudioStream::startWorker() {
+	if (!_wake.isValid() || !_dataReady.isValid())
+		return;
+
+	_quit = false;
+	_workerWaiting = false;
+	_readerWaiting = false;
+
+	if (!_thread.start(workerProc, this))
+		warning("PrefetchingAudioStream: Could not start worker thread, decoding synchronously");
+}
+
+void PrefetchingAudioStream::stopWorker() {
+	if (!_thread.isStarted())
+		return;
+
+	{
+		Common::StackLock lock(_mutex);
+		_quit = true;
+	}
+	_wake.post();
+	_thread.join();
+
+	// Discard wake-ups the worker did not consume
+	while (_wake.tryWait())
+		;
+	while (_dataReady.tryWait())
+		;
+}
+
+AudioStream *makePrefetchingAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse, uint32 bufferMsecs) {
+	if (!stream || !g_system->hasFeature(OSystem::kFeatureThreads))
+		return stream;
+
+	return new PrefetchingAudioStream(stream, disposeAfterUse, bufferMsecs);
+}
+
+} // End of namespace Audio
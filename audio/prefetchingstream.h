@@ -0,0 +1,135 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_PREFETCHINGSTREAM_H
+#define AUDIO_PREFETCHINGSTREAM_H
+
+#include "audio/audiostream.h"
+
+#include "common/mutex.h"
+#include "common/ptr.h"
+#include "common/thread.h"
+
+namespace Audio {
+
+/**
+ * @defgroup audio_prefetchingstream Prefetching audio stream
+ * @ingroup audio
+ *
+ * @brief Audio stream which decodes its source ahead of time.
+ * @{
+ */
+
+/**
+ * An audio stream which decodes another stream on a worker thread into a
+ * bounded ring buffer. readBuffer() then only copies already decoded
+ * samples, so an expensive decoder (MP3, Vorbis, FLAC...) cannot stall
+ * the mixer callback. If the worker falls behind, readBuffer() waits for
+ * its next chunk, so the stream never returns fewer samples than requested
+ * before it ends.
+ *
+ * The source stream is read from the worker thread without any locking,
+ * so only wrap streams nobody else keeps a pointer to. It is considered
+ * finished as soon as it reports endOfData(), so this is not suitable for
+ * streams which are fed while playing, like QueuingAudioStream.
+ *
+ * If the backend cannot create threads, the source is decoded
+ * synchronously from readBuffer().
+ */
+class PrefetchingAudioStream : public RewindableAudioStream {
+public:
+	/**
+	 * @param parent          The stream to decode.
+	 * @param disposeAfterUse Whether to delete the parent stream.
+	 * @param bufferMsecs     How much decoded audio to keep ahead of playback.
+	 */
+	PrefetchingAudioStream(AudioStream *parent, DisposeAfterUse::Flag disposeAfterUse, uint32 bufferMsecs);
+	~PrefetchingAudioStream();
+
+	int readBuffer(int16 *buffer, const int numSamples) override;
+
+	bool isStereo() const override { return _stereo; }
+	int getRate() const override { return _rate; }
+
+	bool endOfData() const override;
+
+	/**
+	 * Rewind the parent stream, if it is a RewindableAudioStream, and
+	 * discard everything which was already decoded.
+	 */
+	bool rewind() override;
+
+	/** Return whether a worker thread decodes the stream. */
+	bool isPrefetching() const { return _thread.isStarted(); }
+
+private:
+	enum {
+		/** Number of samples decoded at once */
+		kChunkSize = 2048
+	};
+
+	static void workerProc(void *data);
+	void work();
+
+	/** Decode one chunk into the ring buffer. Only the worker may call this, if there is one. */
+	void decodeChunk();
+
+	void startWorker();
+	void stopWorker();
+
+	Common::DisposablePtr<AudioStream> _parent;
+	const bool _stereo;
+	const int _rate;
+
+	mutable Common::Mutex _mutex;
+	Common::Thread _thread;
+	Common::Semaphore _wake;
+	Common::Semaphore _dataReady;
+
+	// The following members are protected by _mutex
+	int16 *_buffer;
+	uint _bufferSize;
+	uint _readPos;
+	uint _fill;
+	bool _parentEnded;
+	bool _quit;
+	bool _workerWaiting;
+	bool _readerWaiting;
+
+	int16 _decodeBuffer[kChunkSize];
+};
+
+/**
+ * Wrap a stream in a PrefetchingAudioStream, if the backend supports
+ * threads.
+ *
+ * @param stream          The stream to decode ahead of time.
+ * @param disposeAfterUse Whether to delete the stream.
+ * @param bufferMsecs     How much decoded audio to keep ahead of playback.
+ * @return The new stream, or @p stream itself if threads are not supported.
+ */
+AudioStream *makePrefetchingAudioStream(AudioStream *stream, DisposeAfterUse::Flag disposeAfterUse = DisposeAfterUse::YES, uint32 bufferMsecs = 500);
+
+/** @} */
+
+} // End of namespace Audio
+
+#endif
@@ -30,6 +30,9 @@
 #include "audio/audiostream.h"
 #include "audio/rate.h"
 #include "audio/mixer.h"
+#include "audio/mixkernels.h"
+#include "common/algorithm.h"
+#include "common/array.h"
 #include "common/frac.h"
 #include "common/textconsole.h"
 #include "common/util.h"
@@ -56,6 +59,22 @@ enum {
 	FRAC_HALF_LOW = (1L << (FRAC_BITS_LOW-1))
 };
 
+/**
+ * Scale the given resampled frames by the channel volumes and add them
+ * to the output buffer.
+ */
+template<bool stereo, bool reverseStereo>
+static inline void mixFrames(st_sample_t *obuf, const st_sample_t *src, st_size_t frames, st_volume_t vol_l, st_volume_t vol_r) {
+	const MixKernels &kernels = getMixKernels();
+
+	if (!stereo)
+		kernels.mixMono(obuf, src, frames, vol_l, vol_r);
+	else if (reverseStereo)
+		kernels.mixStereoReverse(obuf, src, frames, vol_l, vol_r);
+	else
+		kernels.mixStereo(obuf, src, frames, vol_l, vol_r);
+}
+
 /**
  * Audio rate converter based on simple resampling. Used when no
  * interpolation is required.
@@ -69,6 +88,9 @@ protected:
 	const st_sample_t *inPtr;
 	int inLen;
 
+	/** resampled frames, waiting to be mixed into the output buffer */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 	/** position of how far output is ahead of input */
 	/** Holds what would have been opos-ipos */
 	long opos;
@@ -118,37 +140,49 @@ int SimpleRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	oend = obuf + osamp * 2;
 
 	while (obuf < oend) {
+		// Resample a batch of frames into the intermediate output buffer,
+		// then mix them all at once.
+		const st_size_t frames = MIN<st_size_t>((oend - obuf) / 2, ARRAYSIZE(outBuf) / (stereo ? 2 : 1));
+		st_sample_t *optr = outBuf;
+		st_size_t len = 0;
+		bool eos = false;
+
+		while (len < frames) {
+			// read enough input samples so that opos >= 0
+			do {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						eos = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				opos--;
+				if (opos >= 0) {
+					inPtr += (stereo ? 2 : 1);
+				}
+			} while (opos >= 0);
+
+			if (eos)
+				break;
+
+			*optr++ = *inPtr++;
+			if (stereo)
+				*optr++ = *inPtr++;
 
-		// read enough input samples so that opos >= 0
-		do {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			opos--;
-			if (opos >= 0) {
-				inPtr += (stereo ? 2 : 1);
-			}
-		} while (opos >= 0);
-
-		st_sample_t out0, out1;
-		out0 = *inPtr++;
-		out1 = (stereo ? *inPtr++ : out0);
-
-		// Increment output position
-		opos += opos_inc;
-
-		// output left channel
-		clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			// Increment output position
+			opos += opos_inc;
+			len++;
+		}
 
-		// output right channel
-		clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+		mixFrames<stereo, reverseStereo>(obuf, outBuf, len, vol_l, vol_r);
+		obuf += len * 2;
 
-		obuf += 2;
+		if (eos)
+			break;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -182,6 +216,9 @@ protected:
 	/** current sample(s) in the input stream (left/right channel) */
 	st_sample_t icur0, icur1;
 
+	/** resampled frames, waiting to be mixed into the output buffer */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
 public:
 	LinearRateConverter(st_rate_t inrate, st_rate_t outrate);
 	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override;
@@ -227,47 +264,57 @@ int LinearRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_samp
 	oend = obuf + osamp * 2;
 
 	while (obuf < oend) {
-
-		// read enough input samples so that opos < 0
-		while ((frac_t)FRAC_ONE_LOW <= opos) {
-			// Check if we have to refill the buffer
-			if (inLen == 0) {
-				inPtr = inBuf;
-				inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
-				if (inLen <= 0)
-					return (obuf - ostart) / 2;
-			}
-			inLen -= (stereo ? 2 : 1);
-			ilast0 = icur0;
-			icur0 = *inPtr++;
-			if (stereo) {
-				ilast1 = icur1;
-				icur1 = *inPtr++;
+		// Resample a batch of frames into the intermediate output buffer,
+		// then mix them all at once.
+		const st_size_t frames = MIN<st_size_t>((oend - obuf) / 2, ARRAYSIZE(outBuf) / (stereo ? 2 : 1));
+		st_sample_t *optr = outBuf;
+		st_size_t len = 0;
+		bool eos = false;
+
+		while (len < frames) {
+			// read enough input samples so that opos < 0
+			while ((frac_t)FRAC_ONE_LOW <= opos) {
+				// Check if we have to refill the buffer
+				if (inLen == 0) {
+					inPtr = inBuf;
+					inLen = input.readBuffer(inBuf, ARRAYSIZE(inBuf));
+					if (inLen <= 0) {
+						eos = true;
+						break;
+					}
+				}
+				inLen -= (stereo ? 2 : 1);
+				ilast0 = icur0;
+				icur0 = *inPtr++;
+				if (stereo) {
+					ilast1 = icur1;
+					icur1 = *inPtr++;
+				}
+				opos -= FRAC_ONE_LOW;
 			}
-			opos -= FRAC_ONE_LOW;
-		}
 
-		// Loop as long as the outpos trails behind, and as long as there is
-		// still space in the output buffer.
-		while (opos < (frac_t)FRAC_ONE_LOW && obuf < oend) {
-			// interpolate
-			st_sample_t out0, out1;
-			out0 = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
-			out1 = (stereo ?
-						  (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW)) :
-						  out0);
+			if (eos)
+				break;
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
+			// Loop as long as the outpos trails behind, and as long as there is
+			// still space in the output buffer.
+			while (opos < (frac_t)FRAC_ONE_LOW && len < frames) {
+				// interpolate
+				*optr++ = (st_sample_t)(ilast0 + (((icur0 - ilast0) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
+				if (stereo)
+					*optr++ = (st_sample_t)(ilast1 + (((icur1 - ilast1) * opos + FRAC_HALF_LOW) >> FRAC_BITS_LOW));
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+				// Increment output position
+				opos += opos_inc;
+				len++;
+			}
+		}
 
-			obuf += 2;
+		mixFrames<stereo, reverseStereo>(obuf, outBuf, len, vol_l, vol_r);
+		obuf += len * 2;
 
-			// Increment output position
-			opos += opos_inc;
-		}
+		if (eos)
+			break;
 	}
 	return (obuf - ostart) / 2;
 }
@@ -292,11 +339,8 @@ public:
 	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override {
 		assert(input.isStereo() == stereo);
 
-		st_sample_t *ptr;
 		st_size_t len;
 
-		st_sample_t *ostart = obuf;
-
 		if (stereo)
 			osamp *= 2;
 
@@ -313,36 +357,232 @@ public:
 		// Read up to 'osamp' samples into our temporary buffer
 		len = input.readBuffer(_buffer, osamp);
 
+		if ((int)len <= 0)
+			return 0;
+
 		// Mix the data into the output buffer
-		ptr = _buffer;
-		for (; len > 0; len -= (stereo ? 2 : 1)) {
-			st_sample_t out0, out1;
-			out0 = *ptr++;
-			out1 = (stereo ? *ptr++ : out0);
+		len /= (stereo ? 2 : 1);
+		mixFrames<stereo, reverseStereo>(obuf, _buffer, len, vol_l, vol_r);
+		return len;
+	}
+
+	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) override {
+		return ST_SUCCESS;
+	}
+};
 
-			// output left channel
-			clampedAdd(obuf[reverseStereo    ], (out0 * (int)vol_l) / Audio::Mixer::kMaxMixerVolume);
 
-			// output right channel
-			clampedAdd(obuf[reverseStereo ^ 1], (out1 * (int)vol_r) / Audio::Mixer::kMaxMixerVolume);
+#pragma mark -
 
-			obuf += 2;
-		}
-		return (obuf - ostart) / 2;
-	}
 
+/**
+ * Audio rate converter based on a polyphase windowed-sinc FIR filter.
+ *
+ * The filter coefficients for every fractional input position (phase) are
+ * computed once when the converter is created, so each output sample only
+ * costs one dot product per channel. When downsampling, the cutoff frequency
+ * is lowered to the output Nyquist frequency to avoid aliasing.
+ */
+template<bool stereo, bool reverseStereo>
+class PolyphaseRateConverter : public RateConverter {
+protected:
+	enum {
+		/** maximum number of precomputed filter phases */
+		kMaxPhases = 256,
+		/** number of filter taps when no extra low-pass filtering is needed */
+		kBaseTaps = 16,
+		kMaxTaps = 64,
+		/** fixed point precision of the filter coefficients */
+		kCoefBits = 14
+	};
+
+	st_sample_t inBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	/** deinterleaved input history, one buffer for each channel */
+	st_sample_t _hist[2][kMaxTaps + INTERMEDIATE_BUFFER_SIZE];
+	uint _histLen;
+	/** first input frame used for the next output frame */
+	uint _histPos;
+
+	/** resampled frames, waiting to be mixed into the output buffer */
+	st_sample_t outBuf[INTERMEDIATE_BUFFER_SIZE];
+
+	Common::Array<int16> _coefs;
+	uint _taps;
+	uint _phases;
+
+	/**
+	 * The input position advances by _inc + _fracInc / _fracDen frames per
+	 * output frame, where _fracDen is the reduced output rate.
+	 */
+	uint32 _inc, _fracInc, _fracDen;
+	uint32 _phase;
+	/** maps _phase to a row in the coefficient table, as a 32.32 fixed point factor */
+	uint64 _phaseMul;
+
+	bool refill(AudioStream &input);
+
+public:
+	PolyphaseRateConverter(st_rate_t inrate, st_rate_t outrate);
+	int flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) override;
 	int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) override {
 		return ST_SUCCESS;
 	}
 };
 
+/*
+ * Prepare processing.
+ */
+template<bool stereo, bool reverseStereo>
+PolyphaseRateConverter<stereo, reverseStereo>::PolyphaseRateConverter(st_rate_t inrate, st_rate_t outrate) {
+	const st_rate_t div = Common::gcd(inrate, outrate);
+	const uint32 inStep = inrate / div;
+	const uint32 outStep = outrate / div;
+
+	_inc = inStep / outStep;
+	_fracInc = inStep % outStep;
+	_fracDen = outStep;
+	_phase = 0;
+
+	_phases = MIN<uint32>(outStep, kMaxPhases);
+	_phaseMul = ((uint64)_phases << 32) / outStep;
+
+	// Lower the cutoff frequency when downsampling, which requires a
+	// correspondingly longer filter for the same transition width.
+	const double cutoff = (inStep > outStep) ? (double)outStep / inStep : 1.0;
+	_taps = MIN<uint>(((uint)ceil(kBaseTaps / cutoff) + 7) & ~7, kMaxTaps);
+
+	_coefs.resize(_phases * _taps);
+
+	const int center = _taps / 2 - 1;
+	for (uint p = 0; p < _phases; p++) {
+		const double frac = (double)p / _phases;
+		double row[kMaxTaps];
+		double sum = 0.0;
+
+		for (uint k = 0; k < _taps; k++) {
+			// Distance in input frames between this tap and the output position
+			const double t = (int)k - center - frac;
+			const double x = M_PI * t * cutoff;
+			const double sinc = (fabs(x) < 1e-9) ? 1.0 : sin(x) / x;
+
+			// Blackman window
+			const double w = t / (_taps / 2);
+			const double window = (fabs(w) >= 1.0) ? 0.0 : 0.42 + 0.5 * cos(M_PI * w) + 0.08 * cos(2.0 * M_PI * w);
+
+			row[k] = sinc * window;
+			sum += row[k];
+		}
+
+		// Normalize every phase to unity gain, so that there is no ripple
+		// at DC depending on the fractional position.
+		for (uint k = 0; k < _taps; k++)
+			_coefs[p * _taps + k] = (int16)floor(row[k] / sum * (1 << kCoefBits) + 0.5);
+	}
+
+	// Start with enough silence that the first output frame is centered on
+	// the first input frame.
+	memset(_hist, 0, sizeof(_hist));
+	_histLen = center;
+	_histPos = 0;
+}
+
+/*
+ * Discard input frames which are no longer needed and read new ones.
+ * Return false if the input stream has no more data.
+ */
+template<bool stereo, bool reverseStereo>
+bool PolyphaseRateConverter<stereo, reverseStereo>::refill(AudioStream &input) {
+	const uint discard = MIN(_histPos, _histLen);
+	_histLen -= discard;
+	_histPos -= discard;
+
+	memmove(_hist[0], _hist[0] + discard, _histLen * sizeof(st_sample_t));
+	if (stereo)
+		memmove(_hist[1], _hist[1] + discard, _histLen * sizeof(st_sample_t));
+
+	const int maxSamples = MIN<int>(ARRAYSIZE(inBuf), (ARRAYSIZE(_hist[0]) - _histLen) * (stereo ? 2 : 1));
+	const int len = input.readBuffer(inBuf, maxSamples);
+	if (len <= 0)
+		return false;
+
+	const st_sample_t *inPtr = inBuf;
+	for (int i = 0; i < len; i += (stereo ? 2 : 1)) {
+		_hist[0][_histLen] = *inPtr++;
+		if (stereo)
+			_hist[1][_histLen] = *inPtr++;
+		_histLen++;
+	}
+
+	return true;
+}
+
+/*
+ * Processed signed long samples from ibuf to obuf.
+ * Return number of sample pairs processed.
+ */
+template<bool stereo, bool reverseStereo>
+int PolyphaseRateConverter<stereo, reverseStereo>::flow(AudioStream &input, st_sample_t *obuf, st_size_t osamp, st_volume_t vol_l, st_volume_t vol_r) {
+	const FirFunc fir = getMixKernels().fir;
+	st_sample_t *ostart, *oend;
+
+	ostart = obuf;
+	oend = obuf + osamp * 2;
+
+	while (obuf < oend) {
+		// Resample a batch of frames into the intermediate output buffer,
+		// then mix them all at once.
+		const st_size_t frames = MIN<st_size_t>((oend - obuf) / 2, ARRAYSIZE(outBuf) / (stereo ? 2 : 1));
+		st_sample_t *optr = outBuf;
+		st_size_t len = 0;
+		bool eos = false;
+
+		while (len < frames) {
+			// Make sure the whole filter window is available
+			while (_histPos + _taps > _histLen) {
+				if (!refill(input)) {
+					eos = true;
+					break;
+				}
+			}
+
+			if (eos)
+				break;
+
+			const int16 *coefs = &_coefs[(uint32)((_phase * _phaseMul) >> 32) * _taps];
+
+			*optr++ = (st_sample_t)CLIP<int32>((fir(_hist[0] + _histPos, coefs, _taps) + (1 << (kCoefBits - 1))) >> kCoefBits, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+			if (stereo)
+				*optr++ = (st_sample_t)CLIP<int32>((fir(_hist[1] + _histPos, coefs, _taps) + (1 << (kCoefBits - 1))) >> kCoefBits, ST_SAMPLE_MIN, ST_SAMPLE_MAX);
+
+			// Increment input position
+			_histPos += _inc;
+			_phase += _fracInc;
+			if (_phase >= _fracDen) {
+				_phase -= _fracDen;
+				_histPos++;
+			}
+			len++;
+		}
+
+		mixFrames<stereo, reverseStereo>(obuf, outBuf, len, vol_l, vol_r);
+		obuf += len * 2;
+
+		if (eos)
+			break;
+	}
+	return (obuf - ostart) / 2;
+}
+
 
 #pragma mark -
 
 template<bool stereo, bool reverseStereo>
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, RateConverterQuality quality) {
 	if (inrate != outrate) {
-		if ((inrate % outrate) == 0 && (inrate < 65536)) {
+		if (quality == kRateConverterPolyphase) {
+			return new PolyphaseRateConverter<stereo, reverseStereo>(inrate, outrate);
+		} else if (quality == kRateConverterFast && (inrate % outrate) == 0 && (inrate < 65536)) {
 			return new SimpleRateConverter<stereo, reverseStereo>(inrate, outrate);
 		} else {
 			return new LinearRateConverter<stereo, reverseStereo>(inrate, outrate);
@@ -355,14 +595,23 @@ RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate) {
 /**
  * Create and return a RateConverter object for the specified input and output rates.
  */
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo) {
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo, RateConverterQuality quality) {
 	if (stereo) {
 		if (reverseStereo)
-			return makeRateConverter<true, true>(inrate, outrate);
+			return makeRateConverter<true, true>(inrate, outrate, quality);
 		else
-			return makeRateConverter<true, false>(inrate, outrate);
+			return makeRateConverter<true, false>(inrate, outrate, quality);
 	} else
-		return makeRateConverter<false, false>(inrate, outrate);
+		return makeRateConverter<false, false>(inrate, outrate, quality);
+}
+
+RateConverterQuality parseRateConverterQuality(const Common::String &name) {
+	if (name.equalsIgnoreCase("polyphase"))
+		return kRateConverterPolyphase;
+	else if (name.equalsIgnoreCase("linear"))
+		return kRateConverterLinear;
+	else
+		return kRateConverterFast;
 }
 
 } // End of namespace Audio
@@ -23,6 +23,7 @@
 #define AUDIO_RATE_H
 
 #include "common/scummsys.h"
+#include "common/str.h"
 
 namespace Audio {
 /**
@@ -71,6 +72,25 @@ static inline void clampedAdd(int16& a, int b) {
 #endif
 }
 
+/**
+ * Resampling algorithm used by a rate converter.
+ */
+enum RateConverterQuality {
+	/** Drop samples for integer rate ratios, otherwise use linear interpolation. */
+	kRateConverterFast,
+	/** Always use linear interpolation. */
+	kRateConverterLinear,
+	/** Use a polyphase windowed-sinc filter. Slowest, but avoids aliasing. */
+	kRateConverterPolyphase
+};
+
+/**
+ * Convert a resampler quality name ("fast", "linear" or "polyphase") from
+ * the configuration to the matching quality. Unknown names map to
+ * kRateConverterFast.
+ */
+RateConverterQuality parseRateConverterQuality(const Common::String &name);
+
 class RateConverter {
 public:
 	RateConverter() {}
@@ -84,7 +104,7 @@ public:
 	virtual int drain(st_sample_t *obuf, st_size_t osamp, st_volume_t vol) = 0;
 };
 
-RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false);
+RateConverter *makeRateConverter(st_rate_t inrate, st_rate_t outrate, bool stereo, bool reverseStereo = false, RateConverterQuality quality = kRateConverterFast);
 /** @} */
 } // End of namespace Audio
 
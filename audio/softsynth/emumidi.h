@@ -42,10 +42,18 @@ private:
 
 	int _nextTick;
 	int _samplesPerTick;
+	uint32 _eventDelay;
 
 protected:
 	int _baseFreq;
 
+	/**
+	 * Return the delay set by setEventDelay() in output samples, i.e. the
+	 * offset into the current timer period at which the event being sent
+	 * is due.
+	 */
+	uint32 getEventDelaySamples() const { return (uint64)_eventDelay * getRate() / 1000000; }
+
 	virtual void generateSamples(int16 *buf, int len) = 0;
 	virtual void onTimer() {}
 
@@ -57,6 +65,7 @@ public:
 		_timerParam(0),
 		_nextTick(0),
 		_samplesPerTick(0),
+		_eventDelay(0),
 		_baseFreq(250) {
 	}
 
@@ -86,6 +95,10 @@ public:
 		return 1000000 / _baseFreq;
 	}
 
+	virtual void setEventDelay(uint32 delay) {
+		_eventDelay = delay;
+	}
+
 	// AudioStream API
 	virtual int readBuffer(int16 *data, const int numSamples) {
 		const int stereoFactor = isStereo() ? 2 : 1;
@@ -105,6 +118,7 @@ public:
 					(*_timerProc)(_timerParam);
 
 				onTimer();
+				_eventDelay = 0;
 
 				_nextTick += _samplesPerTick;
 			}
@@ -40,7 +40,9 @@
 #include "common/stream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/thread.h"
 #include "common/translation.h"
+#include "common/util.h"
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
 #include "audio/softsynth/emumidi.h"
@@ -94,6 +96,43 @@ private:
 	int _outputRate;
 	Common::SeekableReadStream *_engineSoundFontData;
 
+	struct QueuedEvent {
+		uint32 time;
+		uint32 msg;
+	};
+
+	// Rendering ahead on a thread, like the MT-32 emulator does. The timer
+	// callbacks run ahead of playback in readBuffer(), and the MIDI events
+	// are queued with their position in the output, so that only the
+	// rendering thread uses _synth while it runs.
+	Common::Mutex _queueMutex;
+	Common::Thread _thread;
+	Common::Semaphore _wake;
+	Common::Semaphore _samplesReady;
+
+	// The following members are protected by _queueMutex while the
+	// rendering thread runs. Positions are counted in sample frames.
+	Common::Array<QueuedEvent> _events;
+	uint _eventsRead;
+	Common::Array<int16> _ring;
+	uint _ringRead;
+	uint _ringFill;
+	uint32 _callbackPos;
+	uint32 _renderPos;
+	uint32 _playPos;
+	uint32 _aheadFrames;
+	bool _quit;
+	bool _renderWaiting;
+	bool _readerWaiting;
+
+	void playMessage(uint32 b);
+
+	static void renderProc(void *data);
+	void renderAhead();
+
+	bool startRendering();
+	void stopRendering();
+
 protected:
 	// Because GCC complains about casting from const to non-const...
 	void setInt(const char *name, int val);
@@ -122,6 +161,7 @@ public:
 	}
 
 	// AudioStream API
+	int readBuffer(int16 *data, const int numSamples) override;
 	bool isStereo() const override { return true; }
 	int getRate() const override { return _outputRate; }
 };
@@ -129,7 +169,8 @@ public:
 // MidiDriver method implementations
 
 MidiDriver_FluidSynth::MidiDriver_FluidSynth(Audio::Mixer *mixer)
-	: MidiDriver_Emulated(mixer), _engineSoundFontData(nullptr) {
+	: MidiDriver_Emulated(mixer), _engineSoundFontData(nullptr), _eventsRead(0), _ringRead(0), _ringFill(0),
+	  _callbackPos(0), _renderPos(0), _playPos(0), _aheadFrames(0), _quit(false), _renderWaiting(false), _readerWaiting(false) {
 
 	for (int i = 0; i < ARRAYSIZE(_midiChannels); i++) {
 		_midiChannels[i].init(this, i);
@@ -249,6 +290,13 @@ int MidiDriver_FluidSynth::open() {
 	setNum("synth.gain", gain);
 	setNum("synth.sample-rate", _outputRate);
 
+	// Fewer voices and more cores both help when the SoundFont is too
+	// heavy for the device.
+	setInt("synth.polyphony", CLIP(ConfMan.getInt("fluidsynth_misc_polyphony"), 16, 4096));
+#if !defined(USE_FLUIDLITE) && FS_API_VERSION >= 0x0101
+	setInt("synth.cpu-cores", CLIP(ConfMan.getInt("fluidsynth_misc_cpu_cores"), 1, 256));
+#endif
+
 	_synth = new_fluid_synth(_settings);
 
 	if (ConfMan.getBool("fluidsynth_chorus_activate")) {
@@ -370,6 +418,7 @@ int MidiDriver_FluidSynth::open() {
 	}
 
 	MidiDriver_Emulated::open();
+	startRendering();
 
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
@@ -382,6 +431,7 @@ void MidiDriver_FluidSynth::close() {
 	_isOpen = false;
 
 	_mixer->stopHandle(_mixerSoundHandle);
+	stopRendering();
 
 	if (_soundFont != -1)
 		fluid_synth_sfunload(_synth, _soundFont, 1);
@@ -396,6 +446,35 @@ void MidiDriver_FluidSynth::send(uint32 b) {
 
 	midiDriverCommonSend(b);
 
+	if (_thread.isStarted()) {
+		// Events sent by the timer callbacks belong to the current
+		// callback position, plus the delay the MIDI parser set for them.
+		// Events sent by the engine are heard after everything that was
+		// rendered ahead already.
+		Common::StackLock lock(_queueMutex);
+
+		QueuedEvent event;
+		event.time = _callbackPos + getEventDelaySamples();
+		event.msg = b;
+
+		// Keep the queue sorted, as the delays of different callbacks can
+		// overlap. Events due at the same time stay in order.
+		uint pos = _events.size();
+		while (pos > _eventsRead && (int32)(_events[pos - 1].time - event.time) > 0)
+			pos--;
+		_events.insert_at(pos, event);
+
+		if (_renderWaiting) {
+			_renderWaiting = false;
+			_wake.post();
+		}
+		return;
+	}
+
+	playMessage(b);
+}
+
+void MidiDriver_FluidSynth::playMessage(uint32 b) {
 	//byte param3 = (byte) ((b >> 24) & 0xFF);
 	uint param2 = (byte) ((b >> 16) & 0xFF);
 	uint param1 = (byte) ((b >>  8) & 0xFF);
@@ -446,9 +525,198 @@ MidiChannel *MidiDriver_FluidSynth::getPercussionChannel() {
 }
 
 void MidiDriver_FluidSynth::generateSamples(int16 *data, int len) {
+	if (_thread.isStarted()) {
+		// The rendering thread makes the samples, readBuffer() only runs
+		// the timer callbacks through here.
+		Common::StackLock lock(_queueMutex);
+		_callbackPos += len;
+		return;
+	}
+
 	fluid_synth_write_s16(_synth, len, data, 0, 2, data, 1, 2);
 }
 
+int MidiDriver_FluidSynth::readBuffer(int16 *data, const int numSamples) {
+	if (!_thread.isStarted())
+		return MidiDriver_Emulated::readBuffer(data, numSamples);
+
+	const uint32 length = numSamples / 2;
+	if (!length)
+		return numSamples;
+
+	// Keep the timer callbacks ahead of playback. Only this thread
+	// changes _callbackPos, so it can be read without the lock here, and
+	// generateSamples() does not touch the buffer.
+	const uint32 target = _playPos + length + _aheadFrames;
+	while (_callbackPos != target)
+		MidiDriver_Emulated::readBuffer(data, MIN<uint32>(target - _callbackPos, length) * 2);
+
+	uint32 remaining = length;
+	while (remaining) {
+		{
+			Common::StackLock lock(_queueMutex);
+
+			const uint ringFrames = _ring.size() / 2;
+			while (remaining && _ringFill) {
+				const uint frames = MIN<uint>(MIN<uint>(remaining, _ringFill), ringFrames - _ringRead);
+				memcpy(data, &_ring[_ringRead * 2], frames * 2 * sizeof(int16));
+
+				data += frames * 2;
+				remaining -= frames;
+				_ringRead = (_ringRead + frames) % ringFrames;
+				_ringFill -= frames;
+			}
+
+			// There are new callback positions or free space in the ring
+			if (_renderWaiting) {
+				_renderWaiting = false;
+				_wake.post();
+			}
+
+			if (!remaining)
+				break;
+
+			// The rendering thread fell behind, so the mixer has to wait
+			// for it just like it would wait for FluidSynth.
+			_readerWaiting = true;
+		}
+
+		_samplesReady.wait();
+	}
+
+	_playPos += length;
+	return numSamples;
+}
+
+void MidiDriver_FluidSynth::renderProc(void *data) {
+	((MidiDriver_FluidSynth *)data)->renderAhead();
+}
+
+void MidiDriver_FluidSynth::renderAhead() {
+	enum {
+		kBlockFrames = 512
+	};
+
+	int16 buffer[kBlockFrames * 2];
+	Common::Array<uint32> messages;
+
+	while (true) {
+		uint32 length;
+
+		messages.clear();
+
+		{
+			Common::StackLock lock(_queueMutex);
+			if (_quit)
+				return;
+
+			while (_eventsRead < _events.size() && (int32)(_events[_eventsRead].time - _renderPos) <= 0)
+				messages.push_back(_events[_eventsRead++].msg);
+
+			if (_eventsRead == _events.size()) {
+				_events.clear();
+				_eventsRead = 0;
+			}
+
+			// Render up to the next event, but not past the callbacks,
+			// which may still send something there.
+			length = _callbackPos - _renderPos;
+			if (_eventsRead < _events.size())
+				length = MIN<uint32>(length, _events[_eventsRead].time - _renderPos);
+			length = MIN<uint32>(length, kBlockFrames);
+			length = MIN<uint32>(length, _ring.size() / 2 - _ringFill);
+
+			if (!length && messages.empty())
+				_renderWaiting = true;
+		}
+
+		if (!length && messages.empty()) {
+			_wake.wait();
+			continue;
+		}
+
+		for (uint i = 0; i < messages.size(); i++)
+			playMessage(messages[i]);
+
+		if (!length)
+			continue;
+
+		fluid_synth_write_s16(_synth, length, buffer, 0, 2, buffer, 1, 2);
+
+		Common::StackLock lock(_queueMutex);
+
+		const uint ringFrames = _ring.size() / 2;
+		const int16 *src = buffer;
+		uint32 left = length;
+		while (left) {
+			const uint writePos = (_ringRead + _ringFill) % ringFrames;
+			const uint frames = MIN<uint>(left, ringFrames - writePos);
+			memcpy(&_ring[writePos * 2], src, frames * 2 * sizeof(int16));
+
+			src += frames * 2;
+			left -= frames;
+			_ringFill += frames;
+		}
+
+		_renderPos += length;
+
+		if (_readerWaiting) {
+			_readerWaiting = false;
+			_samplesReady.post();
+		}
+	}
+}
+
+bool MidiDriver_FluidSynth::startRendering() {
+	if (ConfMan.getInt("fluidsynth_misc_render_ahead") <= 0)
+		return false;
+
+	if (!g_system->hasFeature(OSystem::kFeatureThreads) || !_wake.isValid() || !_samplesReady.isValid())
+		return false;
+
+	const int aheadMillis = MIN(ConfMan.getInt("fluidsynth_misc_render_ahead"), 1000);
+
+	_aheadFrames = _outputRate * aheadMillis / 1000;
+	_ring.resize((_aheadFrames + 512) * 2);
+	_ringRead = 0;
+	_ringFill = 0;
+	_callbackPos = 0;
+	_renderPos = 0;
+	_playPos = 0;
+	_quit = false;
+	_renderWaiting = false;
+	_readerWaiting = false;
+
+	if (!_thread.start(renderProc, this)) {
+		warning("FluidSynth: Could not start rendering thread, rendering on demand");
+		return false;
+	}
+
+	return true;
+}
+
+void MidiDriver_FluidSynth::stopRendering() {
+	if (!_thread.isStarted())
+		return;
+
+	{
+		Common::StackLock lock(_queueMutex);
+		_quit = true;
+	}
+	_wake.post();
+	_thread.join();
+
+	// Discard wake-ups nobody consumed
+	while (_wake.tryWait())
+		;
+	while (_samplesReady.tryWait())
+		;
+
+	_events.clear();
+	_eventsRead = 0;
+	_ringFill = 0;
+}
+
 void MidiDriver_FluidSynth::setEngineSoundFont(Common::SeekableReadStream *soundFontData) {
 	_engineSoundFontData = soundFontData;
 }
@@ -129,6 +129,17 @@ void PCMDevice_Base::setSfxChanMask(int mask) {
 }
 
 void PCMDevice_Base::readBuffer(int32 *buffer, uint32 bufferSize) {
+	// Most of the time no channel is playing. Then the only thing left to do
+	// is to keep the update timer in step.
+	bool idle = true;
+	for (int ii = 0; ii < _numChannels && idle; ii++)
+		idle = !_channels[ii]->isActive() && !_channels[ii]->isPlaying();
+
+	if (idle) {
+		_timer = (uint32)(((uint64)_timer + (uint64)_extRate * bufferSize) % _intRate);
+		return;
+	}
+
 	for (uint32 i = 0; i < bufferSize; i++) {
 		_timer += _extRate;
 		while (_timer >= _intRate) {
@@ -37,6 +37,7 @@ public:
 	void updatePhaseIncrement();
 	void recalculateRates();
 	void generateOutput(int32 phasebuf, int32 *feedbuf, int32 &out);
+	bool isIdle() const { return _state == kEnvReady; }
 
 	void feedbackLevel(int32 level);
 	void detune(int value);
@@ -1577,102 +1578,161 @@ void TownsPC98_FmSynth::writeRegInternal(uint8 part, uint8 regAddress, uint8 val
 	}
 }
 
+// Runs the operators of a channel for a whole block. Since the algorithm is a
+// template parameter, the operator connections are resolved once per block
+// instead of once per sample.
+template<int algorithm>
+static void generateChannelOutput(TownsPC98_FmSynthOperator **o, int32 *feed, int32 *out, uint32 count) {
+	int32 *del = &feed[2];
+
+	for (uint32 ii = 0; ii < count; ii++) {
+		int32 phbuf1, phbuf2, output;
+		phbuf1 = phbuf2 = output = 0;
+
+		switch (algorithm) {
+		case 0:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(*del, nullptr, phbuf2);
+			*del = 0;
+			o[1]->generateOutput(phbuf1, nullptr, *del);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			break;
+		case 1:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(*del, nullptr, phbuf2);
+			o[1]->generateOutput(0, nullptr, phbuf1);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 2:
+			o[0]->generateOutput(0, feed, phbuf2);
+			o[2]->generateOutput(*del, nullptr, phbuf2);
+			o[1]->generateOutput(0, nullptr, phbuf1);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 3:
+			o[0]->generateOutput(0, feed, phbuf2);
+			o[2]->generateOutput(0, nullptr, *del);
+			o[1]->generateOutput(phbuf2, nullptr, phbuf1);
+			o[3]->generateOutput(*del, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 4:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(0, nullptr, phbuf2);
+			o[1]->generateOutput(phbuf1, nullptr, output);
+			o[3]->generateOutput(phbuf2, nullptr, output);
+			*del = 0;
+			break;
+		case 5:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(*del, nullptr, output);
+			o[1]->generateOutput(phbuf1, nullptr, output);
+			o[3]->generateOutput(phbuf1, nullptr, output);
+			*del = phbuf1;
+			break;
+		case 6:
+			o[0]->generateOutput(0, feed, phbuf1);
+			o[2]->generateOutput(0, nullptr, output);
+			o[1]->generateOutput(phbuf1, nullptr, output);
+			o[3]->generateOutput(0, nullptr, output);
+			*del = 0;
+			break;
+		case 7:
+			o[0]->generateOutput(0, feed, output);
+			o[2]->generateOutput(0, nullptr, output);
+			o[1]->generateOutput(0, nullptr, output);
+			o[3]->generateOutput(0, nullptr, output);
+			*del = 0;
+			break;
+		default:
+			break;
+		}
+
+		out[ii] = output;
+	}
+}
+
 void TownsPC98_FmSynth::nextTick(int32 *buffer, uint32 bufferSize) {
 	if (!_ready)
 		return;
 
+	const int32 outputDivisor = (_numChan + _numSSG - 3) / 3;
+	int32 chanOut[256];
+
 	for (int i = 0; i < _numChan; i++) {
-		TownsPC98_FmSynthOperator **o = _chanInternal[i].opr;
+		ChanInternal &chan = _chanInternal[i];
+		TownsPC98_FmSynthOperator **o = chan.opr;
 
-		if (_chanInternal[i].updateEnvelopeParameters) {
-			_chanInternal[i].updateEnvelopeParameters = false;
+		if (chan.updateEnvelopeParameters) {
+			chan.updateEnvelopeParameters = false;
 			for (int ii = 0; ii < 4 ; ii++)
 				o[ii]->updatePhaseIncrement();
 		}
 
-		for (uint32 ii = 0; ii < bufferSize ; ii++) {
-			int32 phbuf1, phbuf2, output;
-			phbuf1 = phbuf2 = output = 0;
+		// Operators only leave the idle state on a key on, so a channel that
+		// is silent now remains silent for the whole block. All algorithms
+		// leave 0 in the delay buffer then.
+		if (o[0]->isIdle() && o[1]->isIdle() && o[2]->isIdle() && o[3]->isIdle()) {
+			chan.feedbuf[2] = 0;
+			continue;
+		}
+
+		const bool applyVolumeA = ((1 << i) & _volMaskA) != 0;
+		const bool applyVolumeB = ((1 << i) & _volMaskB) != 0;
 
-			int32 *leftSample = &buffer[ii * 2];
-			int32 *rightSample = &buffer[ii * 2 + 1];
-			int32 *del = &_chanInternal[i].feedbuf[2];
-			int32 *feed = _chanInternal[i].feedbuf;
+		for (uint32 pos = 0; pos < bufferSize; ) {
+			const uint32 count = MIN<uint32>(bufferSize - pos, ARRAYSIZE(chanOut));
 
-			switch (_chanInternal[i].algorithm) {
+			switch (chan.algorithm) {
 			case 0:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, nullptr, phbuf2);
-				*del = 0;
-				o[1]->generateOutput(phbuf1, nullptr, *del);
-				o[3]->generateOutput(phbuf2, nullptr, output);
+				generateChannelOutput<0>(o, chan.feedbuf, chanOut, count);
 				break;
 			case 1:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, nullptr, phbuf2);
-				o[1]->generateOutput(0, nullptr, phbuf1);
-				o[3]->generateOutput(phbuf2, nullptr, output);
-				*del = phbuf1;
+				generateChannelOutput<1>(o, chan.feedbuf, chanOut, count);
 				break;
 			case 2:
-				o[0]->generateOutput(0, feed, phbuf2);
-				o[2]->generateOutput(*del, nullptr, phbuf2);
-				o[1]->generateOutput(0, nullptr, phbuf1);
-				o[3]->generateOutput(phbuf2, nullptr, output);
-				*del = phbuf1;
+				generateChannelOutput<2>(o, chan.feedbuf, chanOut, count);
 				break;
 			case 3:
-				o[0]->generateOutput(0, feed, phbuf2);
-				o[2]->generateOutput(0, nullptr, *del);
-				o[1]->generateOutput(phbuf2, nullptr, phbuf1);
-				o[3]->generateOutput(*del, nullptr, output);
-				*del = phbuf1;
+				generateChannelOutput<3>(o, chan.feedbuf, chanOut, count);
 				break;
 			case 4:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(0, nullptr, phbuf2);
-				o[1]->generateOutput(phbuf1, nullptr, output);
-				o[3]->generateOutput(phbuf2, nullptr, output);
-				*del = 0;
+				generateChannelOutput<4>(o, chan.feedbuf, chanOut, count);
 				break;
 			case 5:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(*del, nullptr, output);
-				o[1]->generateOutput(phbuf1, nullptr, output);
-				o[3]->generateOutput(phbuf1, nullptr, output);
-				*del = phbuf1;
+				generateChannelOutput<5>(o, chan.feedbuf, chanOut, count);
 				break;
 			case 6:
-				o[0]->generateOutput(0, feed, phbuf1);
-				o[2]->generateOutput(0, nullptr, output);
-				o[1]->generateOutput(phbuf1, nullptr, output);
-				o[3]->generateOutput(0, nullptr, output);
-				*del = 0;
+				generateChannelOutput<6>(o, chan.feedbuf, chanOut, count);
 				break;
 			case 7:
-				o[0]->generateOutput(0, feed, output);
-				o[2]->generateOutput(0, nullptr, output);
-				o[1]->generateOutput(0, nullptr, output);
-				o[3]->generateOutput(0, nullptr, output);
-				*del = 0;
+				generateChannelOutput<7>(o, chan.feedbuf, chanOut, count);
 				break;
 			default:
+				memset(chanOut, 0, sizeof(int32) * count);
 				break;
-			};
+			}
 
-			int32 finOut = (output << 2) / ((_numChan + _numSSG - 3) / 3);
+			int32 *dst = &buffer[pos << 1];
+			for (uint32 ii = 0; ii < count; ii++) {
+				int32 finOut = (chanOut[ii] << 2) / outputDivisor;
 
-			if ((1 << i) & _volMaskA)
-				finOut = (finOut * _volumeA) / Audio::Mixer::kMaxMixerVolume;
+				if (applyVolumeA)
+					finOut = (finOut * _volumeA) / Audio::Mixer::kMaxMixerVolume;
 
-			if ((1 << i) & _volMaskB)
-				finOut = (finOut * _volumeB) / Audio::Mixer::kMaxMixerVolume;
+				if (applyVolumeB)
+					finOut = (finOut * _volumeB) / Audio::Mixer::kMaxMixerVolume;
 
-			if (_chanInternal[i].enableLeft)
-				*leftSample += finOut;
+				if (chan.enableLeft)
+					dst[ii << 1] += finOut;
+
+				if (chan.enableRight)
+					dst[(ii << 1) + 1] += finOut;
+			}
 
-			if (_chanInternal[i].enableRight)
-				*rightSample += finOut;
+			pos += count;
 		}
 	}
 }
@@ -25,6 +25,7 @@
 #ifdef USE_MT32EMU
 
 #include "audio/softsynth/emumidi.h"
+#include "audio/softsynth/mt32.h"
 #include "audio/musicplugin.h"
 #include "audio/mpu401.h"
 
@@ -101,6 +102,12 @@ public:
 	virtual ~ScummVMReportHandler() {}
 };
 
+static int emulatorLoad = -1;
+
+int getEmulatorLoad() {
+	return emulatorLoad;
+}
+
 }	// end of namespace MT32Emu
 
 class MidiChannel_MT32 : public MidiChannel_MPU401 {
@@ -119,6 +126,12 @@ private:
 
 	int _outputRate;
 
+	// Time spent rendering, for MT32Emu::getEmulatorLoad()
+	uint64 _renderMicros;
+	uint32 _renderFrames;
+
+	void render(int16 *buf, int len);
+
 protected:
 	void generateSamples(int16 *buf, int len) override;
 
@@ -156,6 +169,8 @@ MidiDriver_MT32::MidiDriver_MT32(Audio::Mixer *mixer) : MidiDriver_Emulated(mixe
 	_outputRate = 0;
 	_controlData = nullptr;
 	_pcmData = nullptr;
+	_renderMicros = 0;
+	_renderFrames = 0;
 }
 
 MidiDriver_MT32::~MidiDriver_MT32() {
@@ -195,6 +210,38 @@ int MidiDriver_MT32::open() {
 
 	pcmFile.close();
 
+	// Fewer partials and a lower output rate make the emulation cheaper.
+	// It always synthesizes at 32 kHz, only the analog output stage
+	// works at a higher rate. With a resampler set, the emulator
+	// resamples its output to the mixer rate itself, with better quality
+	// than the mixer.
+	if (ConfMan.hasKey("mt32_partials"))
+		_service.setPartialCount(CLIP(ConfMan.getInt("mt32_partials"), 8, 256));
+
+	const Common::String analogOutput = ConfMan.get("mt32_analog_output");
+	if (analogOutput == "digital")
+		_service.setAnalogOutputMode(MT32Emu::AnalogOutputMode_DIGITAL_ONLY);
+	else if (analogOutput == "accurate")
+		_service.setAnalogOutputMode(MT32Emu::AnalogOutputMode_ACCURATE);
+	else if (analogOutput == "oversampled")
+		_service.setAnalogOutputMode(MT32Emu::AnalogOutputMode_OVERSAMPLED);
+	else
+		_service.setAnalogOutputMode(MT32Emu::AnalogOutputMode_COARSE);
+
+	const Common::String resampler = ConfMan.get("mt32_resampler");
+	if (resampler == "fastest" || resampler == "fast" || resampler == "good" || resampler == "best") {
+		if (resampler == "fastest")
+			_service.setSamplerateConversionQuality(MT32Emu::SamplerateConversionQuality_FASTEST);
+		else if (resampler == "fast")
+			_service.setSamplerateConversionQuality(MT32Emu::SamplerateConversionQuality_FAST);
+		else if (resampler == "good")
+			_service.setSamplerateConversionQuality(MT32Emu::SamplerateConversionQuality_GOOD);
+		else
+			_service.setSamplerateConversionQuality(MT32Emu::SamplerateConversionQuality_BEST);
+
+		_service.setStereoOutputSampleRate(_mixer->getOutputRate());
+	}
+
 	if (_service.openSynth() != MT32EMU_RC_OK)
 		return MERR_DEVICE_NOT_AVAILABLE;
 
@@ -215,6 +262,9 @@ int MidiDriver_MT32::open() {
 
 	MidiDriver_Emulated::open();
 
+	_renderMicros = 0;
+	_renderFrames = 0;
+
 	_mixer->playStream(Audio::Mixer::kPlainSoundType, &_mixerSoundHandle, this, -1, Audio::Mixer::kMaxChannelVolume, 0, DisposeAfterUse::NO, true);
 
 	return 0;
@@ -224,7 +274,11 @@ void MidiDriver_MT32::send(uint32 b) {
 	midiDriverCommonSend(b);
 
 	Common::StackLock lock(_mutex);
-	_service.playMsg(b);
+	const uint32 delay = getEventDelaySamples();
+	if (delay)
+		_service.playMsgAt(b, _service.getInternalRenderedSampleCount() + _service.convertOutputToSynthTimestamp(delay));
+	else
+		_service.playMsg(b);
 }
 
 // Indiana Jones and the Fate of Atlantis (including the demo) uses
@@ -242,7 +296,11 @@ void MidiDriver_MT32::sysEx(const byte *msg, uint16 length) {
 	midiDriverCommonSysEx(msg, length);
 	if (msg[0] == 0xf0) {
 		Common::StackLock lock(_mutex);
-		_service.playSysex(msg, length);
+		const uint32 delay = getEventDelaySamples();
+		if (delay)
+			_service.playSysexAt(msg, length, _service.getInternalRenderedSampleCount() + _service.convertOutputToSynthTimestamp(delay));
+		else
+			_service.playSysex(msg, length);
 	} else {
 		enum {
 			SYSEX_CMD_DT1 = 0x12,
@@ -279,7 +337,21 @@ void MidiDriver_MT32::close() {
 
 void MidiDriver_MT32::generateSamples(int16 *data, int len) {
 	Common::StackLock lock(_mutex);
+	render(data, len);
+}
+
+void MidiDriver_MT32::render(int16 *data, int len) {
+	const uint64 start = g_system->getMicros();
 	_service.renderBit16s(data, len);
+	_renderMicros += g_system->getMicros() - start;
+	_renderFrames += len;
+
+	// Publish the time spent per second of output
+	if (_renderFrames >= (uint32)_outputRate) {
+		MT32Emu::emulatorLoad = (int)(_renderMicros * _outputRate / _renderFrames / 1000);
+		_renderMicros = 0;
+		_renderFrames = 0;
+	}
 }
 
 uint32 MidiDriver_MT32::property(int prop, uint32 param) {
@@ -0,0 +1,45 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AUDIO_SOFTSYNTH_MT32_H
+#define AUDIO_SOFTSYNTH_MT32_H
+
+#include "common/scummsys.h"
+
+#ifdef USE_MT32EMU
+
+namespace MT32Emu {
+
+/**
+ * Return the processor time the MT-32 emulator needed for one second of
+ * output the last time it played. Values above 1000 mean that it cannot
+ * keep up with its settings.
+ *
+ * @return the time in milliseconds, or -1 if the emulator did not play
+ *         for a second yet
+ */
+int getEmulatorLoad();
+
+} // End of namespace MT32Emu
+
+#endif // USE_MT32EMU
+
+#endif
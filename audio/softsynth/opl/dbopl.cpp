@@ -429,16 +429,19 @@ Bits Operator::TemplateVolume(  ) {
 	return vol;
 }
 
-static const VolumeHandler VolumeHandlerTable[5] = {
-	&Operator::TemplateVolume< Operator::OFF >,
-	&Operator::TemplateVolume< Operator::RELEASE >,
-	&Operator::TemplateVolume< Operator::SUSTAIN >,
-	&Operator::TemplateVolume< Operator::DECAY >,
-	&Operator::TemplateVolume< Operator::ATTACK >
-};
-
 INLINE Bitu Operator::ForwardVolume() {
-	return currentLevel + (this->*volHandler)();
+	switch ( state ) {
+	case OFF:
+		return currentLevel + ENV_MAX;
+	case RELEASE:
+		return currentLevel + TemplateVolume< RELEASE >();
+	case SUSTAIN:
+		return currentLevel + TemplateVolume< SUSTAIN >();
+	case DECAY:
+		return currentLevel + TemplateVolume< DECAY >();
+	default:
+		return currentLevel + TemplateVolume< ATTACK >();
+	}
 }
 
 
@@ -521,7 +524,6 @@ void Operator::WriteE0( const Chip* chip, Bit8u val ) {
 
 INLINE void Operator::SetState( Bit8u s ) {
 	state = s;
-	volHandler = VolumeHandlerTable[ s ];
 }
 
 INLINE bool Operator::Silent() const {
@@ -1298,51 +1300,60 @@ void Chip::Setup( Bit32u rate ) {
 		linearRates[i] = (Bit32u)( scale * (EnvelopeIncreaseTable[ index ] << ( RATE_SH + ENV_EXTRA - shift - 3 )));
 	}
 	//Generate the best matching attack rate
-	for ( Bit8u i = 0; i < 62; i++ ) {
-		Bit8u index, shift;
-		EnvelopeSelect( i, index, shift );
-		//Original amount of samples the attack would take
-		Bit32s original = (Bit32u)( (AttackSamplesTable[ index ] << shift) / scale);
-
-		Bit32s guessAdd = (Bit32u)( scale * (EnvelopeIncreaseTable[ index ] << ( RATE_SH - shift - 3 )));
-		Bit32s bestAdd = guessAdd;
-		Bit32u bestDiff = 1 << 30;
-		for( Bit32u passes = 0; passes < 16; passes ++ ) {
-			Bit32s volume = ENV_MAX;
-			Bit32s samples = 0;
-			Bit32u count = 0;
-			while ( volume > 0 && samples < original * 2 ) {
-				count += guessAdd;
-				Bit32s change = count >> RATE_SH;
-				count &= RATE_MASK;
-				if ( GCC_UNLIKELY(change) ) { // less than 1 %
-					volume += ( ~volume * change ) >> 3;
-				}
-				samples++;
+	//Searching for them takes a while, so they are kept for the last rate
+	static Bit32u cachedRate = 0;
+	static Bit32u cachedAttackRates[62];
+	if ( cachedRate != rate ) {
+		for ( Bit8u i = 0; i < 62; i++ ) {
+			Bit8u index, shift;
+			EnvelopeSelect( i, index, shift );
+			//Original amount of samples the attack would take
+			Bit32s original = (Bit32u)( (AttackSamplesTable[ index ] << shift) / scale);
+
+			Bit32s guessAdd = (Bit32u)( scale * (EnvelopeIncreaseTable[ index ] << ( RATE_SH - shift - 3 )));
+			Bit32s bestAdd = guessAdd;
+			Bit32u bestDiff = 1 << 30;
+			for( Bit32u passes = 0; passes < 16; passes ++ ) {
+				Bit32s volume = ENV_MAX;
+				Bit32s samples = 0;
+				Bit32u count = 0;
+				while ( volume > 0 && samples < original * 2 ) {
+					count += guessAdd;
+					Bit32s change = count >> RATE_SH;
+					count &= RATE_MASK;
+					if ( GCC_UNLIKELY(change) ) { // less than 1 %
+						volume += ( ~volume * change ) >> 3;
+					}
+					samples++;
 
+				}
+				Bit32s diff = original - samples;
+				Bit32u lDiff = labs( diff );
+				//Init last on first pass
+				if ( lDiff < bestDiff ) {
+					bestDiff = lDiff;
+					bestAdd = guessAdd;
+					if ( !bestDiff )
+						break;
+				}
+				//Below our target
+				if ( diff < 0 ) {
+					//Better than the last time
+					Bit32s mul = ((original - diff) << 12) / original;
+					guessAdd = ((guessAdd * mul) >> 12);
+					guessAdd++;
+				} else if ( diff > 0 ) {
+					Bit32s mul = ((original - diff) << 12) / original;
+					guessAdd = (guessAdd * mul) >> 12;
+					guessAdd--;
+				}
 			}
-			Bit32s diff = original - samples;
-			Bit32u lDiff = labs( diff );
-			//Init last on first pass
-			if ( lDiff < bestDiff ) {
-				bestDiff = lDiff;
-				bestAdd = guessAdd;
-				if ( !bestDiff )
-					break;
-			}
-			//Below our target
-			if ( diff < 0 ) {
-				//Better than the last time
-				Bit32s mul = ((original - diff) << 12) / original;
-				guessAdd = ((guessAdd * mul) >> 12);
-				guessAdd++;
-			} else if ( diff > 0 ) {
-				Bit32s mul = ((original - diff) << 12) / original;
-				guessAdd = (guessAdd * mul) >> 12;
-				guessAdd--;
-			}
+			attackRates[i] = bestAdd;
 		}
-		attackRates[i] = bestAdd;
+		memcpy( cachedAttackRates, attackRates, sizeof( cachedAttackRates ) );
+		cachedRate = rate;
+	} else {
+		memcpy( attackRates, cachedAttackRates, sizeof( cachedAttackRates ) );
 	}
 	for ( Bit8u i = 62; i < 76; i++ ) {
 		//This should provide instant volume maximizing
@@ -63,11 +63,11 @@ bool OPL::init() {
 	return (_opl != nullptr);
 }
 
-void OPL::reset() {
+void OPL::resetChip() {
 	MAME::OPLResetChip(_opl);
 }
 
-void OPL::write(int a, int v) {
+void OPL::writeChip(int a, int v) {
 	MAME::OPLWrite(_opl, a, v);
 }
 
@@ -75,7 +75,7 @@ byte OPL::read(int a) {
 	return MAME::OPLRead(_opl, a);
 }
 
-void OPL::writeReg(int r, int v) {
+void OPL::writeChipReg(int r, int v) {
 	MAME::OPLWriteReg(_opl, r, v);
 }
 
@@ -181,16 +181,15 @@ public:
 	~OPL();
 
 	bool init();
-	void reset();
 
-	void write(int a, int v);
 	byte read(int a);
 
-	void writeReg(int r, int v);
-
 	bool isStereo() const { return false; }
 
 protected:
+	void resetChip();
+	void writeChip(int a, int v);
+	void writeChipReg(int r, int v);
 	void generateSamples(int16 *buffer, int length);
 };
 
@@ -1417,11 +1417,11 @@ bool OPL::init() {
 	return true;
 }
 
-void OPL::reset() {
+void OPL::resetChip() {
 	OPL3_Reset(&chip, _rate);
 }
 
-void OPL::write(int port, int val) {
+void OPL::writeChip(int port, int val) {
 	if (port & 1) {
 		switch (_type) {
 		case Config::kOpl2:
@@ -1469,7 +1469,7 @@ void OPL::write(int port, int val) {
 }
 
 
-void OPL::writeReg(int r, int v) {
+void OPL::writeChipReg(int r, int v) {
 	OPL3_WriteRegBuffered(&chip, (Bit16u)r, (Bit8u)v);
 }
 
@@ -27,7 +27,6 @@
 #ifndef DISABLE_SID
 
 #include "audio/softsynth/sid.h"
-#include "audio/null.h"
 
 namespace Resid {
 
@@ -1100,7 +1099,7 @@ SID::SID() {
 	voice[1].set_sync_source(&voice[0]);
 	voice[2].set_sync_source(&voice[1]);
 
-	set_sampling_parameters(985248, 44100);
+	set_sampling_parameters(985248, SAMPLE_FAST, 44100);
 
 	bus_value = 0;
 	bus_value_ttl = 0;
@@ -1280,7 +1279,7 @@ void SID::enable_external_filter(bool enable) {
  * to slightly below 20kHz. This constraint ensures that the FIR table is
  * not overfilled.
  */
-bool SID::set_sampling_parameters(double clock_freq,
+bool SID::set_sampling_parameters(double clock_freq, sampling_method method,
 								  double sample_freq, double pass_freq,
 								  double filter_scale)
 {
@@ -1306,6 +1305,7 @@ bool SID::set_sampling_parameters(double clock_freq,
 	// Set the external filter to the pass freq
 	extfilt.set_sampling_parameter (pass_freq);
 	clock_frequency = clock_freq;
+	sampling = method;
 
 	cycles_per_sample =
 		cycle_count(clock_freq/sample_freq*(1 << FIXP_SHIFT) + 0.5);
@@ -1397,6 +1397,19 @@ void SID::updateClock(cycle_count delta_t) {
  * Fixpoint arithmetics is used.
  */
 int SID::updateClock(cycle_count& delta_t, short* buf, int n, int interleave) {
+	switch (sampling) {
+	default:
+	case SAMPLE_FAST:
+		return clock_fast(delta_t, buf, n, interleave);
+	case SAMPLE_INTERPOLATE:
+		return clock_interpolate(delta_t, buf, n, interleave);
+	}
+}
+
+/**
+ * SID clocking with audio sampling - delta clocking picking nearest sample.
+ */
+int SID::clock_fast(cycle_count& delta_t, short* buf, int n, int interleave) {
 	int s = 0;
 
 	for (;;) {
@@ -1420,36 +1433,49 @@ int SID::updateClock(cycle_count& delta_t, short* buf, int n, int interleave) {
 	return s;
 }
 
-}
+/**
+ * SID clocking with audio sampling - delta clocking with linear sample
+ * interpolation. The chip is delta clocked up to the cycle before each
+ * sample, and then clocked for one more cycle to interpolate between the
+ * two outputs.
+ */
+int SID::clock_interpolate(cycle_count& delta_t, short* buf, int n, int interleave) {
+	int s = 0;
 
-//	Plugin interface
-//	(This can only create a null driver since C64 audio support is not part of the
-//	midi driver architecture. But we need the plugin for the options menu in the launcher
-//	and for MidiDriver::detectDevice() which is more or less used by all engines.)
+	for (;;) {
+		cycle_count next_sample_offset = sample_offset + cycles_per_sample;
+		cycle_count delta_t_sample = next_sample_offset >> FIXP_SHIFT;
+		if (delta_t_sample > delta_t) {
+			break;
+		}
+		if (s >= n) {
+			return s;
+		}
+		if (delta_t_sample > 0) {
+			updateClock(delta_t_sample - 1);
+			sample_prev = output();
+			updateClock(1);
+		}
 
-class C64MusicPlugin : public NullMusicPlugin {
-public:
-	const char *getName() const override {
-		return _s("C64 Audio emulator");
-	}
+		delta_t -= delta_t_sample;
+		sample_offset = next_sample_offset & FIXP_MASK;
 
-	const char *getId() const override {
-		return "C64";
+		short sample_now = output();
+		buf[s++*interleave] =
+			sample_prev + (sample_offset*(sample_now - sample_prev) >> FIXP_SHIFT);
+		sample_prev = sample_now;
 	}
 
-	MusicDevices getDevices() const override;
-};
-
-MusicDevices C64MusicPlugin::getDevices() const {
-	MusicDevices devices;
-	devices.push_back(MusicDevice(this, "", MT_C64));
-	return devices;
+	if (delta_t > 0) {
+		updateClock(delta_t - 1);
+		sample_prev = output();
+		updateClock(1);
+	}
+	sample_offset -= delta_t << FIXP_SHIFT;
+	delta_t = 0;
+	return s;
 }
 
-//#if PLUGIN_ENABLED_DYNAMIC(C64)
-	//REGISTER_PLUGIN_DYNAMIC(C64, PLUGIN_TYPE_MUSIC, C64MusicPlugin);
-//#else
-	REGISTER_PLUGIN_STATIC(C64, PLUGIN_TYPE_MUSIC, C64MusicPlugin);
-//#endif
+}
 
 #endif
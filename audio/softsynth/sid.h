@@ -51,6 +51,12 @@ typedef int cycle_count;
 typedef int sound_sample;
 typedef sound_sample fc_point[2];
 
+// How output samples are computed from the emulated chip output.
+// SAMPLE_FAST takes the chip output at the cycle closest to each sample.
+// SAMPLE_INTERPOLATE interpolates linearly between the chip output of the
+// two cycles around each sample, at a slightly higher cost.
+enum sampling_method { SAMPLE_FAST, SAMPLE_INTERPOLATE };
+
 
 class WaveformGenerator {
 public:
@@ -306,7 +312,7 @@ public:
 
 	void enable_filter(bool enable);
 	void enable_external_filter(bool enable);
-	bool set_sampling_parameters(double clock_freq,
+	bool set_sampling_parameters(double clock_freq, sampling_method method,
 		double sample_freq, double pass_freq = -1,
 		double filter_scale = 0.97);
 
@@ -336,9 +342,13 @@ protected:
 	static const int FIXP_MASK;
 
 	// Sampling variables.
+	sampling_method sampling;
 	cycle_count cycles_per_sample;
 	cycle_count sample_offset;
 	short sample_prev;
+
+	int clock_fast(cycle_count& delta_t, short* buf, int n, int interleave);
+	int clock_interpolate(cycle_count& delta_t, short* buf, int n, int interleave);
 };
 
 }
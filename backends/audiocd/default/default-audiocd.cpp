@@ -21,6 +21,7 @@
 
 #include "backends/audiocd/default/default-audiocd.h"
 #include "audio/audiostream.h"
+#include "audio/prefetchingstream.h"
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/system.h"
@@ -124,9 +125,15 @@ bool DefaultAudioCDManager::play(int track, int numLoops, int startFrame, int du
 			while all other positive numbers indicate precisely the number of desired
 			repetitions. Finally, -1 means infinitely many
 			*/
+			Audio::AudioStream *looping = Audio::makeLoopingAudioStream(stream, start, end, (numLoops < 1) ? numLoops + 1 : numLoops);
+
+			// Nothing but the mixer ever sees the track stream, so it can be
+			// decoded ahead of time on a worker thread
+			if (ConfMan.getBool("audio_prefetch"))
+				looping = Audio::makePrefetchingAudioStream(looping);
+
 			_emulating = true;
-			_mixer->playStream(soundType, &_handle,
-			                        Audio::makeLoopingAudioStream(stream, start, end, (numLoops < 1) ? numLoops + 1 : numLoops), -1, _cd.volume, _cd.balance);
+			_mixer->playStream(soundType, &_handle, looping, -1, _cd.volume, _cd.balance);
 			return true;
 		}
 	}
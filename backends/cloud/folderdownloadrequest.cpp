@@ -22,7 +22,9 @@
 #include "backends/cloud/folderdownloadrequest.h"
 #include "backends/cloud/downloadrequest.h"
 #include "backends/cloud/id/iddownloadrequest.h"
+#include "common/config-manager.h"
 #include "common/debug.h"
+#include "common/fs.h"
 #include "gui/downloaddialog.h"
 #include "backends/networking/curl/connectionmanager.h"
 #include "cloudmanager.h"
@@ -32,7 +34,11 @@ namespace Cloud {
 FolderDownloadRequest::FolderDownloadRequest(Storage *storage, Storage::FileArrayCallback callback, Networking::ErrorCallback ecb, Common::String remoteDirectoryPath, Common::String localDirectoryPath, bool recursive):
 	Request(nullptr, ecb), CommandSender(nullptr), _storage(storage), _fileArrayCallback(callback),
 	_remoteDirectoryPath(remoteDirectoryPath), _localDirectoryPath(localDirectoryPath), _recursive(recursive),
-	_workingRequest(nullptr), _ignoreCallback(false), _totalFiles(0) {
+	_workingRequest(nullptr), _ignoreCallback(false), _startingTransfers(false), _totalFiles(0) {
+	uint32 transfers = DEFAULT_TRANSFERS;
+	if (ConfMan.hasKey("cloud_download_transfers"))
+		transfers = CLIP<int>(ConfMan.getInt("cloud_download_transfers"), 1, MAX_TRANSFERS);
+	_transfers.resize(transfers);
 	start();
 }
 
@@ -41,6 +47,7 @@ FolderDownloadRequest::~FolderDownloadRequest() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
+	finishTransfers();
 	delete _fileArrayCallback;
 }
 
@@ -49,7 +56,7 @@ void FolderDownloadRequest::start() {
 	_ignoreCallback = true;
 	if (_workingRequest)
 		_workingRequest->finish();
-	_currentFile = StorageFile();
+	finishTransfers();
 	_pendingFiles.clear();
 	_failedFiles.clear();
 	_ignoreCallback = false;
@@ -65,6 +72,15 @@ void FolderDownloadRequest::start() {
 	);
 }
 
+void FolderDownloadRequest::finishTransfers() {
+	//callers set _ignoreCallback, so these won't start new transfers
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		if (_transfers[i].request)
+			_transfers[i].request->finish();
+		_transfers[i] = Transfer();
+	}
+}
+
 void FolderDownloadRequest::directoryListedCallback(Storage::ListDirectoryResponse response) {
 	_workingRequest = nullptr;
 	if (_ignoreCallback)
@@ -83,7 +99,7 @@ void FolderDownloadRequest::directoryListedCallback(Storage::ListDirectoryRespon
 		}
 
 	_totalFiles = _pendingFiles.size();
-	downloadNextFile();
+	startTransfers();
 }
 
 void FolderDownloadRequest::directoryListedErrorCallback(Networking::ErrorResponse error) {
@@ -93,37 +109,77 @@ void FolderDownloadRequest::directoryListedErrorCallback(Networking::ErrorRespon
 	finishError(error);
 }
 
-void FolderDownloadRequest::fileDownloadedCallback(Storage::BoolResponse response) {
-	_workingRequest = nullptr;
+void FolderDownloadRequest::fileDownloadedCallback(uint32 index, Storage::BoolResponse response) {
+	Transfer &transfer = _transfers[index];
+	transfer.request = nullptr;
 	if (_ignoreCallback)
 		return;
-	if (!response.value) _failedFiles.push_back(_currentFile);
-	_downloadedBytes += _currentFile.size();
-	downloadNextFile();
+	if (!response.value) _failedFiles.push_back(transfer.file);
+	_downloadedBytes += transfer.file.size();
+	transfer.file = StorageFile();
+	transfer.busy = false;
+	startTransfers();
 }
 
-void FolderDownloadRequest::fileDownloadedErrorCallback(Networking::ErrorResponse error) {
-	_workingRequest = nullptr;
+void FolderDownloadRequest::fileDownloadedErrorCallback(uint32 index, Networking::ErrorResponse error) {
+	_transfers[index].request = nullptr;
 	if (_ignoreCallback)
 		return;
-	fileDownloadedCallback(Storage::BoolResponse(error.request, false));
+	fileDownloadedCallback(index, Storage::BoolResponse(error.request, false));
 }
 
-void FolderDownloadRequest::downloadNextFile() {
-	do {
-		if (_pendingFiles.empty()) {
-			sendCommand(GUI::kDownloadEndedCmd, 0);
-			finishDownload(_failedFiles);
-			return;
-		}
+void FolderDownloadRequest::startTransfers() {
+	//a download which fails right away calls back from within downloadById(),
+	//its slot is then refilled by the loop below
+	if (_startingTransfers)
+		return;
+	_startingTransfers = true;
+
+	for (uint32 i = 0; i < _transfers.size() && !_pendingFiles.empty(); ++i) {
+		Transfer &transfer = _transfers[i];
+		if (transfer.busy)
+			continue;
 
-		_currentFile = _pendingFiles.back();
+		StorageFile file = _pendingFiles.back();
 		_pendingFiles.pop_back();
-	} while (_currentFile.isDirectory()); // directories are actually removed earlier, in the directoryListedCallback()
 
+		Common::String localPath = getLocalPath(file);
+		if (isDownloaded(file, localPath)) {
+			//left by an interrupted download of the same folder
+			debug(9, "FolderDownloadRequest: %s is already downloaded", localPath.c_str());
+			_downloadedBytes += file.size();
+			i = (uint32)-1; //look for a free slot again
+			continue;
+		}
+
+		debug(9, "FolderDownloadRequest: %s -> %s", file.path().c_str(), localPath.c_str());
+		transfer.file = file;
+		transfer.busy = true;
+		Request *request = _storage->downloadById(
+			file.id(), localPath,
+			new TransferCallback<Storage::BoolResponse>(this, &FolderDownloadRequest::fileDownloadedCallback, i),
+			new TransferCallback<Networking::ErrorResponse>(this, &FolderDownloadRequest::fileDownloadedErrorCallback, i)
+		);
+		if (transfer.busy)
+			transfer.request = request;
+		else
+			i = (uint32)-1; //the slot was freed already
+	}
+
+	_startingTransfers = false;
 	sendCommand(GUI::kDownloadProgressCmd, (int)(getProgress() * 100));
 
-	Common::String remotePath = _currentFile.path();
+	if (_pendingFiles.empty()) {
+		for (uint32 i = 0; i < _transfers.size(); ++i)
+			if (_transfers[i].busy)
+				return;
+		sendCommand(GUI::kDownloadEndedCmd, 0);
+		finishDownload(_failedFiles);
+	}
+}
+
+Common::String FolderDownloadRequest::getLocalPath(const StorageFile &file) const {
+	Common::String remotePath = file.path();
 	Common::String localPath = remotePath;
 	if (_remoteDirectoryPath == "" || remotePath.hasPrefix(_remoteDirectoryPath)) {
 		localPath.erase(0, _remoteDirectoryPath.size());
@@ -140,12 +196,15 @@ void FolderDownloadRequest::downloadNextFile() {
 		else
 			localPath = _localDirectoryPath + "/" + localPath;
 	}
-	debug(9, "FolderDownloadRequest: %s -> %s", remotePath.c_str(), localPath.c_str());
-	_workingRequest = _storage->downloadById(
-		_currentFile.id(), localPath,
-		new Common::Callback<FolderDownloadRequest, Storage::BoolResponse>(this, &FolderDownloadRequest::fileDownloadedCallback),
-		new Common::Callback<FolderDownloadRequest, Networking::ErrorResponse>(this, &FolderDownloadRequest::fileDownloadedErrorCallback)
-	);
+	return localPath;
+}
+
+bool FolderDownloadRequest::isDownloaded(const StorageFile &file, const Common::String &localPath) const {
+	//a complete local copy has the same size and was written after the remote file was last modified
+	int64 size, modificationTime;
+	if (!Common::FSNode(localPath).getFileStats(size, modificationTime))
+		return false;
+	return file.size() > 0 && (uint64)size == file.size() && modificationTime >= (int64)file.timestamp();
 }
 
 void FolderDownloadRequest::handle() {
@@ -174,17 +233,23 @@ uint64 FolderDownloadRequest::getDownloadedBytes() const {
 	if (_totalFiles == 0)
 		return 0;
 
-	double currentFileProgress = 0;
-	DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(_workingRequest);
-	if (downloadRequest != nullptr) {
-		currentFileProgress = downloadRequest->getProgress();
-	} else {
-		Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(_workingRequest);
-		if (idDownloadRequest != nullptr)
-			currentFileProgress = idDownloadRequest->getProgress();
+	//add up the progress of all the files being downloaded
+	uint64 downloadedBytes = _downloadedBytes;
+	for (uint32 i = 0; i < _transfers.size(); ++i) {
+		const Transfer &transfer = _transfers[i];
+		double currentFileProgress = 0;
+		DownloadRequest *downloadRequest = dynamic_cast<DownloadRequest *>(transfer.request);
+		if (downloadRequest != nullptr) {
+			currentFileProgress = downloadRequest->getProgress();
+		} else {
+			Id::IdDownloadRequest *idDownloadRequest = dynamic_cast<Id::IdDownloadRequest *>(transfer.request);
+			if (idDownloadRequest != nullptr)
+				currentFileProgress = idDownloadRequest->getProgress();
+		}
+		downloadedBytes += (uint64)(currentFileProgress * transfer.file.size());
 	}
 
-	return _downloadedBytes + (uint64)(currentFileProgress * _currentFile.size());
+	return downloadedBytes;
 }
 
 uint64 FolderDownloadRequest::getTotalBytesToDownload() const {
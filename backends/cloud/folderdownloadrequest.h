@@ -29,23 +29,49 @@
 namespace Cloud {
 
 class FolderDownloadRequest: public Networking::Request, public GUI::CommandSender {
+	static const uint32 DEFAULT_TRANSFERS = 4;
+	static const uint32 MAX_TRANSFERS = 8;
+
+	/** One of the files being downloaded at the same time. */
+	struct Transfer {
+		Request *request;
+		StorageFile file;
+		bool busy;
+
+		Transfer(): request(nullptr), busy(false) {}
+	};
+
+	/** Passes the index of the Transfer a callback belongs to. */
+	template<typename S> class TransferCallback: public Common::BaseCallback<S> {
+		typedef void(FolderDownloadRequest::*TMethod)(uint32, S);
+		FolderDownloadRequest *_object;
+		TMethod _method;
+		uint32 _index;
+	public:
+		TransferCallback(FolderDownloadRequest *object, TMethod method, uint32 index): _object(object), _method(method), _index(index) {}
+		void operator()(S data) { (_object->*_method)(_index, data); }
+	};
+
 	Storage *_storage;
 	Storage::FileArrayCallback _fileArrayCallback;
 	Common::String _remoteDirectoryPath, _localDirectoryPath;
 	bool _recursive;
 	Common::Array<StorageFile> _pendingFiles, _failedFiles;
-	StorageFile _currentFile;
+	Common::Array<Transfer> _transfers;
 	Request *_workingRequest;
-	bool _ignoreCallback;
+	bool _ignoreCallback, _startingTransfers;
 	uint32 _totalFiles;
 	uint64 _downloadedBytes, _totalBytes, _wasDownloadedBytes, _currentDownloadSpeed;
 
 	void start();
+	void finishTransfers();
 	void directoryListedCallback(Storage::ListDirectoryResponse response);
 	void directoryListedErrorCallback(Networking::ErrorResponse error);
-	void fileDownloadedCallback(Storage::BoolResponse response);
-	void fileDownloadedErrorCallback(Networking::ErrorResponse error);
-	void downloadNextFile();
+	void fileDownloadedCallback(uint32 index, Storage::BoolResponse response);
+	void fileDownloadedErrorCallback(uint32 index, Networking::ErrorResponse error);
+	void startTransfers();
+	Common::String getLocalPath(const StorageFile &file) const;
+	bool isDownloaded(const StorageFile &file, const Common::String &localPath) const;
 	void finishDownload(Common::Array<StorageFile> &files);
 public:
 	FolderDownloadRequest(Storage *storage, Storage::FileArrayCallback callback, Networking::ErrorCallback ecb, Common::String remoteDirectoryPath, Common::String localDirectoryPath, bool recursive);
@@ -33,6 +33,21 @@
 
 namespace Cloud {
 
+namespace {
+
+/** Remember the contents of a save which is now the same locally and in the cloud. */
+void rememberSyncedContent(const Common::String &name, uint32 timestamp) {
+	Common::String md5 = DefaultSaveFileManager::computeContentHash(name);
+	if (md5.empty())
+		return;
+
+	Common::HashMap<Common::String, DefaultSaveFileManager::SyncedContent> content = DefaultSaveFileManager::loadSyncedContent();
+	content[name] = DefaultSaveFileManager::SyncedContent(md5, timestamp);
+	DefaultSaveFileManager::saveSyncedContent(content);
+}
+
+} // End of anonymous namespace
+
 SavesSyncRequest::SavesSyncRequest(Storage *storage, Storage::BoolCallback callback, Networking::ErrorCallback ecb):
 	Request(nullptr, ecb), CommandSender(nullptr), _storage(storage), _boolCallback(callback),
 	_workingRequest(nullptr), _ignoreCallback(false) {
@@ -86,6 +101,10 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 		localFileNotAvailableInCloud[i->_key] = true;
 	}
 
+	//saves rewritten locally (with invalid timestamps) may still be identical to what's in the cloud
+	Common::HashMap<Common::String, DefaultSaveFileManager::SyncedContent> syncedContent = DefaultSaveFileManager::loadSyncedContent();
+	bool timestampsRestored = false;
+
 	//determine which files to download and which files to upload
 	Common::Array<StorageFile> &remoteFiles = response.value;
 	uint64 totalSize = 0;
@@ -108,6 +127,16 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 			if (_localFilesTimestamps[name] == file.timestamp())
 				continue;
 
+			if (_localFilesTimestamps[name] == DefaultSaveFileManager::INVALID_TIMESTAMP && syncedContent.contains(name)) {
+				const DefaultSaveFileManager::SyncedContent &synced = syncedContent[name];
+				if (synced.timestamp == file.timestamp() && synced.md5 == DefaultSaveFileManager::computeContentHash(name)) {
+					_localFilesTimestamps[name] = file.timestamp();
+					timestampsRestored = true;
+					debug(9, "- skipping file %s, because its contents are the same as remote", name.c_str());
+					continue;
+				}
+			}
+
 			//we actually can have some files not only with timestamp < remote
 			//but also with timestamp > remote (when we have been using ANOTHER CLOUD and then switched back)
 			if (_localFilesTimestamps[name] > file.timestamp() || _localFilesTimestamps[name] == DefaultSaveFileManager::INVALID_TIMESTAMP)
@@ -124,6 +153,9 @@ void SavesSyncRequest::directoryListedCallback(Storage::ListDirectoryResponse re
 		}
 	}
 
+	if (timestampsRestored)
+		DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+
 	CloudMan.setStorageUsedSpace(CloudMan.getStorageIndex(), totalSize);
 
 	//upload files which are unavailable in cloud
@@ -307,6 +339,7 @@ void SavesSyncRequest::fileDownloadedCallback(Storage::BoolResponse response) {
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
 	_localFilesTimestamps[_currentDownloadingFile.name()] = _currentDownloadingFile.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+	rememberSyncedContent(_currentDownloadingFile.name(), _currentDownloadingFile.timestamp());
 
 	//continue downloading files
 	downloadNextFile();
@@ -358,6 +391,7 @@ void SavesSyncRequest::fileUploadedCallback(Storage::UploadResponse response) {
 	_localFilesTimestamps = DefaultSaveFileManager::loadTimestamps();
 	_localFilesTimestamps[_currentUploadingFile] = response.value.timestamp();
 	DefaultSaveFileManager::saveTimestamps(_localFilesTimestamps);
+	rememberSyncedContent(_currentUploadingFile, response.value.timestamp());
 
 	//continue uploading files
 	uploadNextFile();
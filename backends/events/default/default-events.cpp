@@ -25,6 +25,7 @@
 
 #include "common/system.h"
 #include "common/config-manager.h"
+#include "common/savefile.h"
 #include "common/translation.h"
 #include "backends/events/default/default-events.h"
 #include "backends/keymapper/action.h"
@@ -83,6 +84,10 @@ void DefaultEventManager::init() {
 bool DefaultEventManager::pollEvent(Common::Event &event) {
 	_dispatcher.dispatch();
 
+	// Report the background saves which completed
+	if (g_system->getSavefileManager())
+		g_system->getSavefileManager()->processCompletedSaves();
+
 	if (g_engine)
 		// Handle autosaves if enabled
 		g_engine->handleAutoSave();
@@ -62,6 +62,18 @@ protected:
 	 */
 	virtual AbstractFSNode *getChild(const Common::String &name) const = 0;
 
+	/**
+	 * Returns a node for a child of this directory which is known to exist,
+	 * for instance from an earlier listing of the directory. Backends may
+	 * use the given type instead of querying the file system again.
+	 *
+	 * The default implementation simply calls getChild().
+	 *
+	 * @param name         String containing the name of the child.
+	 * @param isDirectory  Whether the child is a directory.
+	 */
+	virtual AbstractFSNode *getKnownChild(const Common::String &name, bool isDirectory) const { return getChild(name); }
+
 	/**
 	 * The parent node of this directory.
 	 * The parent of the root is the root itself.
@@ -172,6 +184,31 @@ public:
 	 */
 	virtual bool isWritable() const = 0;
 
+	/**
+	 * Retrieves the size and the last modification time of the file
+	 * referred by this node, without opening it.
+	 *
+	 * The default implementation reports that this information is not
+	 * available.
+	 *
+	 * @param size              the size of the file in bytes
+	 * @param modificationTime  the modification time, in seconds since the epoch
+	 * @return true if the information could be retrieved, false otherwise.
+	 */
+	virtual bool getFileStats(int64 &size, int64 &modificationTime) const { return false; }
+
+	/**
+	 * Retrieves the last modification time of the file or directory
+	 * referred by this node. The time of a directory changes when entries
+	 * are added to it, removed from it or renamed.
+	 *
+	 * The default implementation reports that this information is not
+	 * available.
+	 *
+	 * @param modificationTime  the modification time, in seconds since the epoch
+	 * @return true if the information could be retrieved, false otherwise.
+	 */
+	virtual bool getModificationTime(int64 &modificationTime) const { return false; }
 
 	/**
 	 * Creates a SeekableReadStream instance corresponding to the file
@@ -182,6 +219,17 @@ public:
 	 */
 	virtual Common::SeekableReadStream *createReadStream() = 0;
 
+	/**
+	 * Creates a SeekableReadStream instance for a file which is not
+	 * modified while the stream exists, like game data. Backends may map
+	 * such a file into memory instead of reading it.
+	 *
+	 * The default implementation calls createReadStream().
+	 *
+	 * @return pointer to the stream object, 0 in case of a failure
+	 */
+	virtual Common::SeekableReadStream *createReadOnlyDataStream() { return createReadStream(); }
+
 	/**
 	 * Creates a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -69,10 +69,22 @@ bool ChRootFilesystemNode::isWritable() const {
 	return _realNode->isWritable();
 }
 
+bool ChRootFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	return _realNode->getFileStats(size, modificationTime);
+}
+
+bool ChRootFilesystemNode::getModificationTime(int64 &modificationTime) const {
+	return _realNode->getModificationTime(modificationTime);
+}
+
 AbstractFSNode *ChRootFilesystemNode::getChild(const Common::String &n) const {
 	return new ChRootFilesystemNode(_root, (POSIXFilesystemNode *)_realNode->getChild(n));
 }
 
+AbstractFSNode *ChRootFilesystemNode::getKnownChild(const Common::String &n, bool isDirectory) const {
+	return new ChRootFilesystemNode(_root, (POSIXFilesystemNode *)_realNode->getKnownChild(n, isDirectory));
+}
+
 bool ChRootFilesystemNode::getChildren(AbstractFSList &list, ListMode mode, bool hidden) const {
 	AbstractFSList tmp;
 	if (!_realNode->getChildren(tmp, mode, hidden)) {
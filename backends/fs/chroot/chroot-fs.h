@@ -41,8 +41,11 @@ public:
 	bool isDirectory() const override;
 	bool isReadable() const override;
 	bool isWritable() const override;
+	bool getFileStats(int64 &size, int64 &modificationTime) const override;
+	bool getModificationTime(int64 &modificationTime) const override;
 
 	AbstractFSNode *getChild(const Common::String &n) const override;
+	AbstractFSNode *getKnownChild(const Common::String &n, bool isDirectory) const override;
 	bool getChildren(AbstractFSList &list, ListMode mode, bool hidden) const override;
 	AbstractFSNode *getParent() const override;
 
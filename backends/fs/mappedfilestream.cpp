@@ -0,0 +1,62 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// Disable symbol overrides so that we can use the system file functions
+#define FORBIDDEN_SYMBOL_ALLOW_ALL
+
+#include "backends/fs/mappedfilestream.h"
+
+#ifdef USE_MAPPED_FILE_STREAM
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+MappedFileReadStream::MappedFileReadStream(const byte *data, uint32 size)
+	: Common::MemoryReadStream(data, size), _mapping(data), _mappingSize(size) {
+}
+
+MappedFileReadStream *MappedFileReadStream::makeFromPath(const Common::String &path) {
+	int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0)
+		return nullptr;
+
+	struct stat st;
+	if (fstat(fd, &st) != 0 || !S_ISREG(st.st_mode) || st.st_size < kMinMappedSize || st.st_size > kMaxMappedSize) {
+		close(fd);
+		return nullptr;
+	}
+
+	// The mapping stays valid after closing the descriptor
+	void *data = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (data == MAP_FAILED)
+		return nullptr;
+
+	return new MappedFileReadStream((const byte *)data, (uint32)st.st_size);
+}
+
+MappedFileReadStream::~MappedFileReadStream() {
+	munmap(const_cast<byte *>(_mapping), _mappingSize);
+}
+
+#endif
@@ -0,0 +1,73 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef BACKENDS_FS_MAPPEDFILESTREAM_H
+#define BACKENDS_FS_MAPPEDFILESTREAM_H
+
+#include "common/scummsys.h"
+#include "common/memstream.h"
+#include "common/noncopyable.h"
+#include "common/str.h"
+
+#if defined(POSIX) && defined(HAS_MMAP)
+#define USE_MAPPED_FILE_STREAM
+#endif
+
+#ifdef USE_MAPPED_FILE_STREAM
+
+/**
+ * A read-only file stream backed by a memory mapping of the whole file.
+ *
+ * Seeking and reading are plain memory operations, which helps engines doing
+ * many small random reads from big resource files. Since this is a
+ * MemoryReadStream, callers can also access the file contents directly
+ * through getData().
+ */
+class MappedFileReadStream final : public Common::MemoryReadStream, public Common::NonCopyable {
+public:
+	enum {
+		/** Smaller files are cheaper to read through stdio. */
+		kMinMappedSize = 1024 * 1024,
+		/** Keep the address space usage reasonable on 32-bit systems. */
+		kMaxMappedSize = sizeof(void *) > 4 ? 0x7FFFFFFF : 256 * 1024 * 1024
+	};
+
+	/**
+	 * Map the file at the given path.
+	 *
+	 * @return The new stream, or nullptr if the file is not a regular file
+	 *         of a suitable size, or could not be mapped. The caller should
+	 *         fall back to a regular file stream in that case.
+	 */
+	static MappedFileReadStream *makeFromPath(const Common::String &path);
+
+	~MappedFileReadStream() override;
+
+private:
+	MappedFileReadStream(const byte *data, uint32 size);
+
+	const byte *_mapping;
+	uint32 _mappingSize;
+};
+
+#endif
+
+#endif
@@ -127,6 +127,13 @@ AbstractFSNode *DrivePOSIXFilesystemNode::getChild(const Common::String &n) cons
 	return child;
 }
 
+AbstractFSNode *DrivePOSIXFilesystemNode::getKnownChild(const Common::String &n, bool isDirectory) const {
+	if (_isPseudoRoot)
+		return getChild(n);
+
+	return getChildWithKnownType(n, isDirectory);
+}
+
 bool DrivePOSIXFilesystemNode::getChildren(AbstractFSList &list, AbstractFSNode::ListMode mode, bool hidden) const {
 	assert(_isDirectory);
 
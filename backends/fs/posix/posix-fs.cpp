@@ -31,6 +31,7 @@
 #define FORBIDDEN_SYMBOL_EXCEPTION_random
 #define FORBIDDEN_SYMBOL_EXCEPTION_srandom
 
+#include "backends/fs/mappedfilestream.h"
 #include "backends/fs/posix/posix-fs.h"
 #include "backends/fs/posix/posix-iostream.h"
 #include "common/algorithm.h"
@@ -77,6 +78,27 @@ bool POSIXFilesystemNode::isWritable() const {
 	return retVal;
 }
 
+bool POSIXFilesystemNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0 || !S_ISREG(st.st_mode))
+		return false;
+
+	size = st.st_size;
+	modificationTime = st.st_mtime;
+	return true;
+}
+
+bool POSIXFilesystemNode::getModificationTime(int64 &modificationTime) const {
+	struct stat st;
+
+	if (stat(_path.c_str(), &st) != 0)
+		return false;
+
+	modificationTime = st.st_mtime;
+	return true;
+}
+
 void POSIXFilesystemNode::setFlags() {
 	struct stat st;
 
@@ -147,6 +169,23 @@ AbstractFSNode *POSIXFilesystemNode::getChild(const Common::String &n) const {
 	return makeNode(newPath);
 }
 
+AbstractFSNode *POSIXFilesystemNode::getKnownChild(const Common::String &n, bool isDirectory) const {
+	assert(!_path.empty());
+	assert(_isDirectory);
+	assert(!n.contains('/'));
+
+	// Like in getChildren(), the type is set directly, without calling stat()
+	POSIXFilesystemNode *entry = new POSIXFilesystemNode(*this);
+	entry->_displayName = n;
+	if (_path.lastChar() != '/')
+		entry->_path += '/';
+	entry->_path += n;
+	entry->_isDirectory = isDirectory;
+	entry->_isValid = true;
+
+	return entry;
+}
+
 bool POSIXFilesystemNode::getChildren(AbstractFSList &myList, ListMode mode, bool hidden) const {
 	assert(_isDirectory);
 
@@ -302,6 +341,16 @@ Common::SeekableReadStream *POSIXFilesystemNode::createReadStream() {
 	return PosixIoStream::makeFromPath(getPath(), false);
 }
 
+Common::SeekableReadStream *POSIXFilesystemNode::createReadOnlyDataStream() {
+#ifdef USE_MAPPED_FILE_STREAM
+	// Big files are mapped, so random access does not go through stdio
+	Common::SeekableReadStream *mapped = MappedFileReadStream::makeFromPath(getPath());
+	if (mapped)
+		return mapped;
+#endif
+	return createReadStream();
+}
+
 Common::SeekableWriteStream *POSIXFilesystemNode::createWriteStream() {
 	return PosixIoStream::makeFromPath(getPath(), true);
 }
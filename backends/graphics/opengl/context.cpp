@@ -44,6 +44,8 @@ void Context::reset() {
 	framebufferObjectSupported = false;
 	packedPixelsSupported = false;
 	textureEdgeClampSupported = false;
+	unpackSubImageSupported = false;
+	pixelBufferObjectSupported = false;
 
 	isInitialized = false;
 
@@ -136,6 +138,8 @@ void OpenGLGraphicsManager::initializeGLContext() {
 	bool ARBShadingLanguage100 = false;
 	bool ARBVertexShader = false;
 	bool ARBFragmentShader = false;
+	bool ARBPixelBufferObject = false;
+	bool ARBMapBufferRange = false;
 
 	Common::StringTokenizer tokenizer(extString, " ");
 	while (!tokenizer.empty()) {
@@ -159,6 +163,12 @@ void OpenGLGraphicsManager::initializeGLContext() {
 			g_context.packedPixelsSupported = true;
 		} else if (token == "GL_SGIS_texture_edge_clamp") {
 			g_context.textureEdgeClampSupported = true;
+		} else if (token == "GL_EXT_unpack_subimage") {
+			g_context.unpackSubImageSupported = true;
+		} else if (token == "GL_ARB_pixel_buffer_object") {
+			ARBPixelBufferObject = true;
+		} else if (token == "GL_ARB_map_buffer_range") {
+			ARBMapBufferRange = true;
 		}
 	}
 
@@ -184,6 +194,22 @@ void OpenGLGraphicsManager::initializeGLContext() {
 		g_context.textureEdgeClampSupported = true;
 	}
 
+	// Desktop OpenGL and OpenGL ES 3.0 and later always support setting the
+	// row length of uploaded data
+	if (g_context.type == kContextGL || (g_context.type == kContextGLES2 && g_context.isGLVersionOrHigher(3, 0))) {
+		g_context.unpackSubImageSupported = true;
+	}
+
+	// OpenGL 3.0 and OpenGL ES 3.0 and later always support mapping pixel
+	// unpack buffers. We only use them through GLAD, since the system GLES
+	// headers do not necessarily declare the functions.
+	if ((g_context.type == kContextGL && (g_context.isGLVersionOrHigher(3, 0) || (ARBPixelBufferObject && ARBMapBufferRange)))
+	    || (g_context.type == kContextGLES2 && g_context.isGLVersionOrHigher(3, 0))) {
+#ifdef USE_GLAD
+		g_context.pixelBufferObjectSupported = glMapBufferRange && glUnmapBuffer && glBufferData;
+#endif
+	}
+
 	// Log context type.
 	switch (g_context.type) {
 	case kContextGL:
@@ -216,6 +242,8 @@ void OpenGLGraphicsManager::initializeGLContext() {
 	debug(5, "OpenGL: FBO support: %d", g_context.framebufferObjectSupported);
 	debug(5, "OpenGL: Packed pixels support: %d", g_context.packedPixelsSupported);
 	debug(5, "OpenGL: Texture edge clamping support: %d", g_context.textureEdgeClampSupported);
+	debug(5, "OpenGL: Unpack subimage support: %d", g_context.unpackSubImageSupported);
+	debug(5, "OpenGL: Pixel buffer object support: %d", g_context.pixelBufferObjectSupported);
 }
 
 } // End of namespace OpenGL
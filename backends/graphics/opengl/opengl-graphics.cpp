@@ -25,6 +25,7 @@
 #include "backends/graphics/opengl/pipelines/pipeline.h"
 #include "backends/graphics/opengl/pipelines/fixed.h"
 #include "backends/graphics/opengl/pipelines/shader.h"
+#include "backends/graphics/opengl/pipelines/scaler.h"
 #include "backends/graphics/opengl/shader.h"
 
 #include "common/array.h"
@@ -589,12 +590,18 @@ void OpenGLGraphicsManager::updateScreen() {
 	// First step: Draw the (virtual) game screen.
 	g_context.getActivePipeline()->drawTexture(_gameScreen->getGLTexture(), _gameDrawRect.left, _gameDrawRect.top, _gameDrawRect.width(), _gameDrawRect.height());
 
-	// Second step: Draw the overlay if visible.
-	if (_overlayVisible) {
+	// Second step: Draw the overlay if visible. Only the part which was drawn
+	// to is blended, the rest of it is transparent.
+	if (_overlayVisible && !_overlayContentArea.isEmpty()) {
+		const Common::Rect &area = _overlayContentArea;
+		const float scaleX = (float)_overlayDrawRect.width() / _overlay->getWidth();
+		const float scaleY = (float)_overlayDrawRect.height() / _overlay->getHeight();
 		int dstX = (_windowWidth - _overlayDrawRect.width()) / 2;
 		int dstY = (_windowHeight - _overlayDrawRect.height()) / 2;
 		_backBuffer.enableBlend(Framebuffer::kBlendModeTraditionalTransparency);
-		g_context.getActivePipeline()->drawTexture(_overlay->getGLTexture(), dstX, dstY, _overlayDrawRect.width(), _overlayDrawRect.height());
+		g_context.getActivePipeline()->drawTexture(_overlay->getGLTexture(),
+		                         dstX + area.left * scaleX, dstY + area.top * scaleY,
+		                         area.width() * scaleX, area.height() * scaleY, area);
 	}
 
 	// Third step: Draw the cursor if visible.
@@ -704,10 +711,23 @@ Graphics::PixelFormat OpenGLGraphicsManager::getOverlayFormat() const {
 
 void OpenGLGraphicsManager::copyRectToOverlay(const void *buf, int pitch, int x, int y, int w, int h) {
 	_overlay->copyRectToTexture(x, y, w, h, buf, pitch);
+
+	Common::Rect area(x, y, x + w, y + h);
+	area.clip(_overlay->getWidth(), _overlay->getHeight());
+	if (_overlayContentArea.isEmpty())
+		_overlayContentArea = area;
+	else
+		_overlayContentArea.extend(area);
 }
 
 void OpenGLGraphicsManager::clearOverlay() {
-	_overlay->fill(0);
+	// Dialogs shown over a running game usually only cover a part of the
+	// overlay, so only that part needs to be cleared and uploaded again.
+	if (_overlayContentArea.isEmpty())
+		return;
+
+	_overlay->fillRect(_overlayContentArea, 0);
+	_overlayContentArea = Common::Rect();
 }
 
 void OpenGLGraphicsManager::grabOverlay(Graphics::Surface &surface) const {
@@ -1056,6 +1076,7 @@ void OpenGLGraphicsManager::handleResizeImpl(const int width, const int height)
 	}
 	_overlay->allocate(overlayWidth, overlayHeight);
 	_overlay->fill(0);
+	_overlayContentArea = Common::Rect();
 
 	// Re-setup the scaling for the screen and cursor
 	recalculateDisplayAreas();
@@ -1184,6 +1205,17 @@ Surface *OpenGLGraphicsManager::createSurface(const Graphics::PixelFormat &forma
 
 #ifdef USE_SCALERS
 	if (wantScaler) {
+#if !USE_FORCED_GLES
+		// Palette look up and scaling can both happen on the GPU for some
+		// scalers, which saves uploading the much bigger scaled surface.
+		if (format.bytesPerPixel == 1 && TextureCLUT8GPU::isSupportedByContext()) {
+			const char *scalerName = _scalerPlugins[_currentState.scalerIndex]->get<ScalerPluginObject>().getName();
+			if (ScalerPipeline::queryShader(scalerName, _currentState.scaleFactor)) {
+				return new TextureCLUT8GPU();
+			}
+		}
+#endif
+
 		// TODO: Ensure that the requested pixel format is supported by the scaler
 		if (getGLPixelFormat(format, glIntFormat, glFormat, glType)) {
 			return new ScaledTexture(glIntFormat, glFormat, glType, format, format);
@@ -361,6 +361,14 @@ protected:
 	 */
 	Surface *_overlay;
 
+	/**
+	 * The part of the overlay which was drawn to since it was last cleared.
+	 *
+	 * The rest of the overlay is fully transparent, so it is neither cleared
+	 * nor drawn.
+	 */
+	Common::Rect _overlayContentArea;
+
 	//
 	// Cursor
 	//
@@ -91,6 +91,15 @@ struct Context {
 	/** Whether texture coordinate edge clamping is available or not. */
 	bool textureEdgeClampSupported;
 
+	/** Whether GL_UNPACK_ROW_LENGTH is available or not. */
+	bool unpackSubImageSupported;
+
+	/**
+	 * Whether texture uploads can go through mapped pixel unpack buffers
+	 * (GL_PIXEL_UNPACK_BUFFER together with glMapBufferRange) or not.
+	 */
+	bool pixelBufferObjectSupported;
+
 	//
 	// Wrapper functionality to handle fixed-function pipelines and
 	// programmable pipelines in the same fashion.
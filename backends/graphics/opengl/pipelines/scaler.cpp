@@ -0,0 +1,57 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "backends/graphics/opengl/pipelines/scaler.h"
+#include "backends/graphics/opengl/shader.h"
+
+#include "common/str.h"
+
+namespace OpenGL {
+
+#if !USE_FORCED_GLES
+ScalerPipeline::ScalerPipeline(Shader *shader)
+	: ShaderPipeline(shader) {
+}
+
+void ScalerPipeline::drawTexture(const GLTexture &texture, const GLfloat *coordinates, const GLfloat *texcoords) {
+	_activeShader->setUniform("textureSize", new ShaderUniformVec2(texture.getWidth(), texture.getHeight()));
+	_activeShader->setUniform("inputSize", new ShaderUniformVec2(texture.getLogicalWidth(), texture.getLogicalHeight()));
+
+	ShaderPipeline::drawTexture(texture, coordinates, texcoords);
+}
+
+Shader *ScalerPipeline::queryShader(const char *scalerName, uint factor) {
+	if (!scumm_stricmp(scalerName, "advmame")) {
+		if (factor == 2)
+			return ShaderMan.query(ShaderManager::kScale2x);
+		if (factor == 3)
+			return ShaderMan.query(ShaderManager::kScale3x);
+	} else if (!scumm_stricmp(scalerName, "sai")) {
+		if (factor == 2)
+			return ShaderMan.query(ShaderManager::k2xSaI);
+	}
+
+	return nullptr;
+}
+#endif // !USE_FORCED_GLES
+
+} // End of namespace OpenGL
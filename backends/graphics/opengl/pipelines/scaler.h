@@ -0,0 +1,58 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef BACKENDS_GRAPHICS_OPENGL_PIPELINES_SCALER_H
+#define BACKENDS_GRAPHICS_OPENGL_PIPELINES_SCALER_H
+
+#include "backends/graphics/opengl/pipelines/shader.h"
+
+namespace OpenGL {
+
+#if !USE_FORCED_GLES
+/**
+ * Pipeline running one of the software scalers as a shader.
+ *
+ * The input texture is drawn into a target which is a multiple of its size.
+ * The shader gets the size of the input and the texture, so it can look up
+ * the pixels around the one being scaled.
+ */
+class ScalerPipeline : public ShaderPipeline {
+public:
+	ScalerPipeline(Shader *shader);
+
+	virtual void drawTexture(const GLTexture &texture, const GLfloat *coordinates, const GLfloat *texcoords);
+
+	/**
+	 * Query the shader implementing a scaler.
+	 *
+	 * @param scalerName The name of the scaler plugin.
+	 * @param factor     The scale factor.
+	 * @return The shader, or nullptr when the scaler has no shader for the
+	 *         factor, and needs to run on the CPU.
+	 */
+	static Shader *queryShader(const char *scalerName, uint factor);
+};
+#endif // !USE_FORCED_GLES
+
+} // End of namespace OpenGL
+
+#endif
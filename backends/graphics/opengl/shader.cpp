@@ -76,6 +76,190 @@ const char *const g_lookUpFragmentShader =
 	"\tgl_FragColor = blendColor * texture2D(palette, vec2(index.a * adjustFactor, 0.0));\n"
 	"}\n";
 
+// Common part of the scaler shaders. The scalers draw into a target which is
+// a multiple of the input size. sourcePixel is set to the input pixel the
+// current fragment belongs to, and pixelAt() returns the input pixels around
+// it. Pixels outside of the input repeat the nearest border pixel.
+const char *const g_scalerFragmentShaderHeader =
+	"varying vec2 texCoord;\n"
+	"varying vec4 blendColor;\n"
+	"\n"
+	"uniform sampler2D shaderTexture;\n"
+	"uniform vec2 textureSize;\n"
+	"uniform vec2 inputSize;\n"
+	"\n"
+	"vec2 sourcePixel;\n"
+	"\n"
+	"vec4 pixelAt(float x, float y) {\n"
+	"\tvec2 pos = clamp(sourcePixel + vec2(x, y), vec2(0.0), inputSize - 1.0);\n"
+	"\treturn texture2D(shaderTexture, (pos + 0.5) / textureSize);\n"
+	"}\n"
+	"\n";
+
+// Port of scale2x() in graphics/scaler/scalebit.cpp
+const char *const g_scale2xFragmentShader =
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tsourcePixel = floor(pos);\n"
+	"\tvec2 part = floor((pos - sourcePixel) * 2.0);\n"
+	"\n"
+	"\tvec4 B = pixelAt( 0.0, -1.0);\n"
+	"\tvec4 D = pixelAt(-1.0,  0.0);\n"
+	"\tvec4 E = pixelAt( 0.0,  0.0);\n"
+	"\tvec4 F = pixelAt( 1.0,  0.0);\n"
+	"\tvec4 H = pixelAt( 0.0,  1.0);\n"
+	"\n"
+	"\tvec4 result = E;\n"
+	"\tif (B != H && D != F) {\n"
+	"\t\tif (part.y == 0.0) {\n"
+	"\t\t\tif (part.x == 0.0)\n"
+	"\t\t\t\tresult = D == B ? D : E;\n"
+	"\t\t\telse\n"
+	"\t\t\t\tresult = B == F ? F : E;\n"
+	"\t\t} else {\n"
+	"\t\t\tif (part.x == 0.0)\n"
+	"\t\t\t\tresult = D == H ? D : E;\n"
+	"\t\t\telse\n"
+	"\t\t\t\tresult = H == F ? F : E;\n"
+	"\t\t}\n"
+	"\t}\n"
+	"\n"
+	"\tgl_FragColor = blendColor * result;\n"
+	"}\n";
+
+// Port of scale3x() in graphics/scaler/scalebit.cpp
+const char *const g_scale3xFragmentShader =
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tsourcePixel = floor(pos);\n"
+	"\tvec2 part = floor((pos - sourcePixel) * 3.0);\n"
+	"\n"
+	"\tvec4 A = pixelAt(-1.0, -1.0);\n"
+	"\tvec4 B = pixelAt( 0.0, -1.0);\n"
+	"\tvec4 C = pixelAt( 1.0, -1.0);\n"
+	"\tvec4 D = pixelAt(-1.0,  0.0);\n"
+	"\tvec4 E = pixelAt( 0.0,  0.0);\n"
+	"\tvec4 F = pixelAt( 1.0,  0.0);\n"
+	"\tvec4 G = pixelAt(-1.0,  1.0);\n"
+	"\tvec4 H = pixelAt( 0.0,  1.0);\n"
+	"\tvec4 I = pixelAt( 1.0,  1.0);\n"
+	"\n"
+	"\tvec4 result = E;\n"
+	"\tif (B != H && D != F) {\n"
+	"\t\tif (part.y == 0.0) {\n"
+	"\t\t\tif (part.x == 0.0)\n"
+	"\t\t\t\tresult = D == B ? D : E;\n"
+	"\t\t\telse if (part.x == 1.0)\n"
+	"\t\t\t\tresult = (D == B && E != C) || (B == F && E != A) ? B : E;\n"
+	"\t\t\telse\n"
+	"\t\t\t\tresult = B == F ? F : E;\n"
+	"\t\t} else if (part.y == 1.0) {\n"
+	"\t\t\tif (part.x == 0.0)\n"
+	"\t\t\t\tresult = (D == B && E != G) || (D == H && E != A) ? D : E;\n"
+	"\t\t\telse if (part.x == 2.0)\n"
+	"\t\t\t\tresult = (B == F && E != I) || (H == F && E != C) ? F : E;\n"
+	"\t\t} else {\n"
+	"\t\t\tif (part.x == 0.0)\n"
+	"\t\t\t\tresult = D == H ? D : E;\n"
+	"\t\t\telse if (part.x == 1.0)\n"
+	"\t\t\t\tresult = (D == H && E != I) || (H == F && E != G) ? H : E;\n"
+	"\t\t\telse\n"
+	"\t\t\t\tresult = H == F ? F : E;\n"
+	"\t\t}\n"
+	"\t}\n"
+	"\n"
+	"\tgl_FragColor = blendColor * result;\n"
+	"}\n";
+
+// Port of _2xSaITemplate() in graphics/scaler/sai.cpp, using the same names
+// for the pixels:
+//   I|E F|J
+//   G|A B|K
+//   H|C D|L
+//   M|N O|P
+const char *const g_2xSaIFragmentShader =
+	"float getResult(vec4 a, vec4 b, vec4 c, vec4 d) {\n"
+	"\tfloat x = 0.0;\n"
+	"\tfloat y = 0.0;\n"
+	"\tif (a == c)\n"
+	"\t\tx += 1.0;\n"
+	"\telse if (b == c)\n"
+	"\t\ty += 1.0;\n"
+	"\tif (a == d)\n"
+	"\t\tx += 1.0;\n"
+	"\telse if (b == d)\n"
+	"\t\ty += 1.0;\n"
+	"\treturn (y == 2.0 ? 1.0 : 0.0) - (x == 2.0 ? 1.0 : 0.0);\n"
+	"}\n"
+	"\n"
+	"void main(void) {\n"
+	"\tvec2 pos = texCoord * textureSize;\n"
+	"\tsourcePixel = floor(pos);\n"
+	"\tvec2 part = floor((pos - sourcePixel) * 2.0);\n"
+	"\n"
+	"\tvec4 I = pixelAt(-1.0, -1.0);\n"
+	"\tvec4 E = pixelAt( 0.0, -1.0);\n"
+	"\tvec4 F = pixelAt( 1.0, -1.0);\n"
+	"\tvec4 J = pixelAt( 2.0, -1.0);\n"
+	"\tvec4 G = pixelAt(-1.0,  0.0);\n"
+	"\tvec4 A = pixelAt( 0.0,  0.0);\n"
+	"\tvec4 B = pixelAt( 1.0,  0.0);\n"
+	"\tvec4 K = pixelAt( 2.0,  0.0);\n"
+	"\tvec4 H = pixelAt(-1.0,  1.0);\n"
+	"\tvec4 C = pixelAt( 0.0,  1.0);\n"
+	"\tvec4 D = pixelAt( 1.0,  1.0);\n"
+	"\tvec4 L = pixelAt( 2.0,  1.0);\n"
+	"\tvec4 M = pixelAt(-1.0,  2.0);\n"
+	"\tvec4 N = pixelAt( 0.0,  2.0);\n"
+	"\tvec4 O = pixelAt( 1.0,  2.0);\n"
+	"\n"
+	"\tvec4 product = (A + B) * 0.5;\n"
+	"\tvec4 product1 = (A + C) * 0.5;\n"
+	"\tvec4 product2 = (A + B + C + D) * 0.25;\n"
+	"\n"
+	"\tif (A == D && B != C) {\n"
+	"\t\tif ((A == E && B == L) || (A == C && A == F && B != E && B == J))\n"
+	"\t\t\tproduct = A;\n"
+	"\t\tif ((A == G && C == O) || (A == B && A == H && G != C && C == M))\n"
+	"\t\t\tproduct1 = A;\n"
+	"\t\tproduct2 = A;\n"
+	"\t} else if (B == C && A != D) {\n"
+	"\t\tif ((B == F && A == H) || (B == E && B == D && A != F && A == I))\n"
+	"\t\t\tproduct = B;\n"
+	"\t\tif ((C == H && A == F) || (C == G && C == D && A != H && A == I))\n"
+	"\t\t\tproduct1 = C;\n"
+	"\t\tproduct2 = B;\n"
+	"\t} else if (A == D && B == C) {\n"
+	"\t\tif (A == B) {\n"
+	"\t\t\tproduct = A;\n"
+	"\t\t\tproduct1 = A;\n"
+	"\t\t\tproduct2 = A;\n"
+	"\t\t} else {\n"
+	"\t\t\tfloat r = getResult(A, B, G, E) - getResult(B, A, K, F) - getResult(B, A, H, N) + getResult(A, B, L, O);\n"
+	"\t\t\tif (r > 0.0)\n"
+	"\t\t\t\tproduct2 = A;\n"
+	"\t\t\telse if (r < 0.0)\n"
+	"\t\t\t\tproduct2 = B;\n"
+	"\t\t}\n"
+	"\t} else {\n"
+	"\t\tif (A == C && A == F && B != E && B == J)\n"
+	"\t\t\tproduct = A;\n"
+	"\t\telse if (B == E && B == D && A != F && A == I)\n"
+	"\t\t\tproduct = B;\n"
+	"\t\tif (A == B && A == H && G != C && C == M)\n"
+	"\t\t\tproduct1 = A;\n"
+	"\t\telse if (C == G && C == D && A != H && A == I)\n"
+	"\t\t\tproduct1 = C;\n"
+	"\t}\n"
+	"\n"
+	"\tvec4 result;\n"
+	"\tif (part.y == 0.0)\n"
+	"\t\tresult = part.x == 0.0 ? A : product;\n"
+	"\telse\n"
+	"\t\tresult = part.x == 0.0 ? product1 : product2;\n"
+	"\n"
+	"\tgl_FragColor = blendColor * result;\n"
+	"}\n";
 
 // Taken from: https://en.wikibooks.org/wiki/OpenGL_Programming/Modern_OpenGL_Tutorial_03#OpenGL_ES_2_portability
 const char *const g_precisionDefines =
@@ -103,6 +287,10 @@ void ShaderUniformFloat::set(GLint location) const {
 	GL_CALL(glUniform1f(location, _value));
 }
 
+void ShaderUniformVec2::set(GLint location) const {
+	GL_CALL(glUniform2f(location, _x, _y));
+}
+
 void ShaderUniformMatrix44::set(GLint location) const {
 	GL_CALL(glUniformMatrix4fv(location, 1, GL_FALSE, _matrix));
 }
@@ -313,6 +501,9 @@ void ShaderManager::notifyCreate() {
 		_builtIn[kDefault] = new Shader(g_defaultVertexShader, g_defaultFragmentShader);
 		_builtIn[kCLUT8LookUp] = new Shader(g_defaultVertexShader, g_lookUpFragmentShader);
 		_builtIn[kCLUT8LookUp]->setUniform1I("palette", 1);
+		_builtIn[kScale2x] = new Shader(g_defaultVertexShader, Common::String(g_scalerFragmentShaderHeader) + g_scale2xFragmentShader);
+		_builtIn[kScale3x] = new Shader(g_defaultVertexShader, Common::String(g_scalerFragmentShaderHeader) + g_scale3xFragmentShader);
+		_builtIn[k2xSaI] = new Shader(g_defaultVertexShader, Common::String(g_scalerFragmentShaderHeader) + g_2xSaIFragmentShader);
 
 		for (uint i = 0; i < kMaxUsages; ++i) {
 			_builtIn[i]->setUniform1I("shaderTexture", 0);
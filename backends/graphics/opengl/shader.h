@@ -73,6 +73,19 @@ private:
 	const GLfloat _value;
 };
 
+/**
+ * 2D vector value for a shader uniform.
+ */
+class ShaderUniformVec2 : public ShaderUniformValue {
+public:
+	ShaderUniformVec2(GLfloat x, GLfloat y) : _x(x), _y(y) {}
+
+	void set(GLint location) const override;
+
+private:
+	const GLfloat _x, _y;
+};
+
 /**
  * 4x4 Matrix value for a shader uniform.
  */
@@ -248,6 +261,15 @@ public:
 		/** CLUT8 look up shader. */
 		kCLUT8LookUp,
 
+		/** AdvMAME2x scaler shader. */
+		kScale2x,
+
+		/** AdvMAME3x scaler shader. */
+		kScale3x,
+
+		/** 2xSaI scaler shader. */
+		k2xSaI,
+
 		/** Number of built-in shaders. Should not be used for query. */
 		kMaxUsages
 	};
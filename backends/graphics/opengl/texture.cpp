@@ -23,6 +23,7 @@
 #include "backends/graphics/opengl/shader.h"
 #include "backends/graphics/opengl/pipelines/pipeline.h"
 #include "backends/graphics/opengl/pipelines/clut8.h"
+#include "backends/graphics/opengl/pipelines/scaler.h"
 #include "backends/graphics/opengl/framebuffer.h"
 
 #include "common/algorithm.h"
@@ -42,12 +43,17 @@ GLTexture::GLTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType)
 	: _glIntFormat(glIntFormat), _glFormat(glFormat), _glType(glType),
 	  _width(0), _height(0), _logicalWidth(0), _logicalHeight(0),
 	  _texCoords(), _glFilter(GL_NEAREST),
-	  _glTexture(0) {
+	  _glTexture(0), _glPixelBuffer(0) {
 	create();
 }
 
 GLTexture::~GLTexture() {
 	GL_CALL_SAFE(glDeleteTextures, (1, &_glTexture));
+#ifdef USE_GLAD
+	if (_glPixelBuffer) {
+		GL_CALL_SAFE(glDeleteBuffers, (1, &_glPixelBuffer));
+	}
+#endif
 }
 
 void GLTexture::enableLinearFiltering(bool enable) {
@@ -66,6 +72,13 @@ void GLTexture::enableLinearFiltering(bool enable) {
 void GLTexture::destroy() {
 	GL_CALL(glDeleteTextures(1, &_glTexture));
 	_glTexture = 0;
+
+#ifdef USE_GLAD
+	if (_glPixelBuffer) {
+		GL_CALL(glDeleteBuffers(1, &_glPixelBuffer));
+		_glPixelBuffer = 0;
+	}
+#endif
 }
 
 void GLTexture::create() {
@@ -147,13 +160,27 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	// Set the texture on the active texture unit.
 	bind();
 
+	// Prefer going through a pixel unpack buffer. Otherwise glTexSubImage2D
+	// has to finish copying the client memory before it returns.
+	if (g_context.pixelBufferObjectSupported && updateAreaFromPixelBuffer(area, src)) {
+		return;
+	}
+
 	// Update the actual texture.
-	// Although we have the area of the texture buffer we want to update we
-	// cannot take advantage of the left/right boundaries here because it is
-	// not possible to specify a pitch to glTexSubImage2D. To be precise, with
-	// plain OpenGL we could set GL_UNPACK_ROW_LENGTH to achieve this. However,
-	// OpenGL ES 1.0 does not support GL_UNPACK_ROW_LENGTH. Thus, we are left
-	// with the following options:
+	// When GL_UNPACK_ROW_LENGTH is available we can tell OpenGL the pitch of
+	// the source data and only upload the area itself.
+	if (g_context.unpackSubImageSupported) {
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, src.pitch / src.format.bytesPerPixel));
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+		                        _glFormat, _glType, src.getBasePtr(area.left, area.top)));
+		GL_CALL(glPixelStorei(GL_UNPACK_ROW_LENGTH, 0));
+		return;
+	}
+
+	// Otherwise we cannot take advantage of the left/right boundaries here
+	// because it is not possible to specify a pitch to glTexSubImage2D.
+	// OpenGL ES 1.0 and 2.0 do not support GL_UNPACK_ROW_LENGTH. Thus, we
+	// are left with the following options:
 	//
 	// 1) (As we do right now) Simply always update the whole texture lines of
 	//    rect changed. This is simplest to implement. In case performance is
@@ -169,12 +196,58 @@ void GLTexture::updateArea(const Common::Rect &area, const Graphics::Surface &sr
 	                       _glFormat, _glType, src.getBasePtr(0, area.top)));
 }
 
+bool GLTexture::updateAreaFromPixelBuffer(const Common::Rect &area, const Graphics::Surface &src) {
+#ifdef USE_GLAD
+	const uint rowSize = area.width() * src.format.bytesPerPixel;
+	const uint size = rowSize * area.height();
+	if (!size) {
+		return true;
+	}
+
+	if (!_glPixelBuffer) {
+		GL_CALL(glGenBuffers(1, &_glPixelBuffer));
+	}
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, _glPixelBuffer));
+
+	// Orphan the old storage, so that mapping does not need to wait for the
+	// last upload from this buffer to complete.
+	GL_CALL(glBufferData(GL_PIXEL_UNPACK_BUFFER, size, nullptr, GL_STREAM_DRAW));
+
+	byte *dst;
+	GL_ASSIGN(dst, (byte *)glMapBufferRange(GL_PIXEL_UNPACK_BUFFER, 0, size, GL_MAP_WRITE_BIT | GL_MAP_INVALIDATE_BUFFER_BIT));
+	if (!dst) {
+		GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+		return false;
+	}
+
+	// Pack the rows tightly, so GL_UNPACK_ROW_LENGTH is not needed.
+	const byte *srcRow = (const byte *)src.getBasePtr(area.left, area.top);
+	for (int y = 0; y < area.height(); ++y) {
+		memcpy(dst, srcRow, rowSize);
+		dst += rowSize;
+		srcRow += src.pitch;
+	}
+
+	GLboolean unmapped;
+	GL_ASSIGN(unmapped, glUnmapBuffer(GL_PIXEL_UNPACK_BUFFER));
+	if (unmapped) {
+		GL_CALL(glTexSubImage2D(GL_TEXTURE_2D, 0, area.left, area.top, area.width(), area.height(),
+		                        _glFormat, _glType, nullptr));
+	}
+
+	GL_CALL(glBindBuffer(GL_PIXEL_UNPACK_BUFFER, 0));
+	return unmapped;
+#else
+	return false;
+#endif
+}
+
 //
 // Surface
 //
 
 Surface::Surface()
-	: _allDirty(false), _dirtyArea() {
+	: _allDirty(false), _dirtyAreas() {
 }
 
 void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcPtr, uint srcPitch) {
@@ -182,15 +255,7 @@ void Surface::copyRectToTexture(uint x, uint y, uint w, uint h, const void *srcP
 	assert(x + w <= (uint)dstSurf->w);
 	assert(y + h <= (uint)dstSurf->h);
 
-	// *sigh* Common::Rect::extend behaves unexpected whenever one of the two
-	// parameters is an empty rect. Thus, we check whether the current dirty
-	// area is valid. In case it is not we simply use the parameters as new
-	// dirty area. Otherwise, we simply call extend.
-	if (_dirtyArea.isEmpty()) {
-		_dirtyArea = Common::Rect(x, y, x + w, y + h);
-	} else {
-		_dirtyArea.extend(Common::Rect(x, y, x + w, y + h));
-	}
+	addDirtyArea(Common::Rect(x, y, x + w, y + h));
 
 	const byte *src = (const byte *)srcPtr;
 	byte *dst = (byte *)dstSurf->getBasePtr(x, y);
@@ -215,12 +280,78 @@ void Surface::fill(uint32 color) {
 	flagDirty();
 }
 
-Common::Rect Surface::getDirtyArea() const {
+void Surface::fillRect(const Common::Rect &area, uint32 color) {
+	Graphics::Surface *dst = getSurface();
+	Common::Rect r(area);
+	r.clip(dst->w, dst->h);
+	dst->fillRect(r, color);
+
+	addDirtyArea(r);
+}
+
+Common::Array<Common::Rect> Surface::getDirtyAreas() const {
+	Common::Array<Common::Rect> dirtyAreas;
 	if (_allDirty) {
-		return Common::Rect(getWidth(), getHeight());
+		dirtyAreas.push_back(Common::Rect(getWidth(), getHeight()));
 	} else {
-		return _dirtyArea;
+		dirtyAreas = _dirtyAreas;
 	}
+	return dirtyAreas;
+}
+
+namespace {
+uint32 rectArea(const Common::Rect &r) {
+	return r.width() * r.height();
+}
+} // End of anonymous namespace
+
+void Surface::addDirtyArea(const Common::Rect &area) {
+	if (_allDirty || area.isEmpty()) {
+		return;
+	}
+
+	// Merge the new area with all areas it overlaps, or which are so close
+	// that uploading the union costs little more than uploading both. This
+	// keeps the areas disjoint and avoids many tiny uploads.
+	Common::Rect newArea = area;
+	for (uint i = 0; i < _dirtyAreas.size();) {
+		Common::Rect merged = newArea;
+		merged.extend(_dirtyAreas[i]);
+
+		if (newArea.intersects(_dirtyAreas[i])
+		    || rectArea(merged) * 3 <= (rectArea(newArea) + rectArea(_dirtyAreas[i])) * 4) {
+			newArea = merged;
+			_dirtyAreas.remove_at(i);
+			// The grown area might now overlap areas we already checked.
+			i = 0;
+		} else {
+			++i;
+		}
+	}
+
+	if (_dirtyAreas.size() < kMaxDirtyAreas) {
+		_dirtyAreas.push_back(newArea);
+		return;
+	}
+
+	// Too many areas: Merge with the one adding the least to the upload.
+	uint best = 0;
+	uint32 bestCost = 0xFFFFFFFF;
+	for (uint i = 0; i < _dirtyAreas.size(); ++i) {
+		Common::Rect merged = newArea;
+		merged.extend(_dirtyAreas[i]);
+
+		const uint32 cost = rectArea(merged) - rectArea(_dirtyAreas[i]);
+		if (cost < bestCost) {
+			best = i;
+			bestCost = cost;
+		}
+	}
+
+	newArea.extend(_dirtyAreas[best]);
+	_dirtyAreas.remove_at(best);
+	// Re-add so that the merged area also absorbs areas it now overlaps.
+	addDirtyArea(newArea);
 }
 
 //
@@ -280,9 +411,13 @@ void Texture::updateGLTexture() {
 		return;
 	}
 
-	Common::Rect dirtyArea = getDirtyArea();
+	Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (Common::Array<Common::Rect>::iterator i = dirtyAreas.begin(); i != dirtyAreas.end(); ++i) {
+		updateGLTexture(*i);
+	}
 
-	updateGLTexture(dirtyArea);
+	// We should have handled everything, thus not dirty anymore.
+	clearDirty();
 }
 
 void Texture::updateGLTexture(Common::Rect &dirtyArea) {
@@ -316,9 +451,6 @@ void Texture::updateGLTexture(Common::Rect &dirtyArea) {
 	}
 
 	_glTexture.updateArea(dirtyArea, _textureData);
-
-	// We should have handled everything, thus not dirty anymore.
-	clearDirty();
 }
 
 FakeTexture::FakeTexture(GLenum glIntFormat, GLenum glFormat, GLenum glType, const Graphics::PixelFormat &format, const Graphics::PixelFormat &fakeFormat)
@@ -369,10 +501,50 @@ void FakeTexture::setPalette(uint start, uint colors, const byte *palData) {
 	if (!_palette)
 		return;
 
-	Graphics::convertPaletteToMap(_palette + start, palData, colors, _format);
+	uint32 newColors[256];
+	Graphics::convertPaletteToMap(newColors, palData, colors, _format);
+
+	// Only pixels using a changed color need to be converted again.
+	uint32 changed[256 / 32] = { 0 };
+	bool anyChanged = false;
+	for (uint i = 0; i < colors; ++i) {
+		if (_palette[start + i] != newColors[i]) {
+			_palette[start + i] = newColors[i];
+			changed[(start + i) >> 5] |= 1u << ((start + i) & 31);
+			anyChanged = true;
+		}
+	}
 
-	// A palette changes means we need to refresh the whole surface.
-	flagDirty();
+	if (anyChanged) {
+		flagPaletteIndicesDirty(changed);
+	}
+}
+
+void FakeTexture::flagPaletteIndicesDirty(const uint32 *changed) {
+	int firstRow = -1;
+	for (int y = 0; y < _rgbData.h; ++y) {
+		const byte *src = (const byte *)_rgbData.getBasePtr(0, y);
+		bool rowChanged = false;
+		for (int x = 0; x < _rgbData.w; ++x) {
+			if (changed[src[x] >> 5] & (1u << (src[x] & 31))) {
+				rowChanged = true;
+				break;
+			}
+		}
+
+		if (rowChanged) {
+			if (firstRow < 0) {
+				firstRow = y;
+			}
+		} else if (firstRow >= 0) {
+			addDirtyArea(Common::Rect(0, firstRow, _rgbData.w, y));
+			firstRow = -1;
+		}
+	}
+
+	if (firstRow >= 0) {
+		addDirtyArea(Common::Rect(0, firstRow, _rgbData.w, _rgbData.h));
+	}
 }
 
 void FakeTexture::updateGLTexture() {
@@ -383,15 +555,18 @@ void FakeTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (Common::Array<Common::Rect>::const_iterator i = dirtyAreas.begin(); i != dirtyAreas.end(); ++i) {
+		const Common::Rect &dirtyArea = *i;
 
-	byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
 
-	if (_palette) {
-		Graphics::crossBlitMap(dst, src, outSurf->pitch, _rgbData.pitch, dirtyArea.width(), dirtyArea.height(), outSurf->format.bytesPerPixel, _palette);
-	} else {
-		Graphics::crossBlit(dst, src, outSurf->pitch, _rgbData.pitch, dirtyArea.width(), dirtyArea.height(), outSurf->format, _rgbData.format);
+		if (_palette) {
+			Graphics::crossBlitMap(dst, src, outSurf->pitch, _rgbData.pitch, dirtyArea.width(), dirtyArea.height(), outSurf->format.bytesPerPixel, _palette);
+		} else {
+			Graphics::crossBlit(dst, src, outSurf->pitch, _rgbData.pitch, dirtyArea.width(), dirtyArea.height(), outSurf->format, _rgbData.format);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -410,25 +585,28 @@ void TextureRGB555::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (Common::Array<Common::Rect>::const_iterator i = dirtyAreas.begin(); i != dirtyAreas.end(); ++i) {
+		const Common::Rect &dirtyArea = *i;
 
-	uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
+		uint16 *dst = (uint16 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 2 * dirtyArea.width();
 
-	const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
+		const uint16 *src = (const uint16 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 2 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint16 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint16 color = *src++;
 
-			*dst++ =   ((color & 0x7C00) << 1)                             // R
-			         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
-			         | (color & 0x001F);                                   // B
-		}
+				*dst++ =   ((color & 0x7C00) << 1)                             // R
+				         | (((color & 0x03E0) << 1) | ((color & 0x0200) >> 4)) // G
+				         | (color & 0x001F);                                   // B
+			}
 
-		src = (const uint16 *)((const byte *)src + srcAdd);
-		dst = (uint16 *)((byte *)dst + dstAdd);
+			src = (const uint16 *)((const byte *)src + srcAdd);
+			dst = (uint16 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -452,23 +630,26 @@ void TextureRGBA8888Swap::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	const Common::Rect dirtyArea = getDirtyArea();
+	const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+	for (Common::Array<Common::Rect>::const_iterator i = dirtyAreas.begin(); i != dirtyAreas.end(); ++i) {
+		const Common::Rect &dirtyArea = *i;
 
-	uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
+		uint32 *dst = (uint32 *)outSurf->getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint dstAdd = outSurf->pitch - 4 * dirtyArea.width();
 
-	const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
+		const uint32 *src = (const uint32 *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+		const uint srcAdd = _rgbData.pitch - 4 * dirtyArea.width();
 
-	for (int height = dirtyArea.height(); height > 0; --height) {
-		for (int width = dirtyArea.width(); width > 0; --width) {
-			const uint32 color = *src++;
+		for (int height = dirtyArea.height(); height > 0; --height) {
+			for (int width = dirtyArea.width(); width > 0; --width) {
+				const uint32 color = *src++;
 
-			*dst++ = SWAP_BYTES_32(color);
-		}
+				*dst++ = SWAP_BYTES_32(color);
+			}
 
-		src = (const uint32 *)((const byte *)src + srcAdd);
-		dst = (uint32 *)((byte *)dst + dstAdd);
+			src = (const uint32 *)((const byte *)src + srcAdd);
+			dst = (uint32 *)((byte *)dst + dstAdd);
+		}
 	}
 
 	// Do generic handling of updating the texture.
@@ -519,45 +700,58 @@ void ScaledTexture::updateGLTexture() {
 	// Convert color space.
 	Graphics::Surface *outSurf = Texture::getSurface();
 
-	Common::Rect dirtyArea = getDirtyArea();
-
-	const byte *src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
-	uint srcPitch = _rgbData.pitch;
-	byte *dst;
-	uint dstPitch;
+	Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
 
+	// Convert all areas before scaling any of them, since scalers look at
+	// the pixels around the area they scale.
 	if (_convData) {
-		dst = (byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
-		dstPitch = _convData->pitch;
+		for (Common::Array<Common::Rect>::const_iterator i = dirtyAreas.begin(); i != dirtyAreas.end(); ++i) {
+			const byte *src = (const byte *)_rgbData.getBasePtr(i->left, i->top);
+			byte *dst = (byte *)_convData->getBasePtr(i->left + _extraPixels, i->top + _extraPixels);
+
+			if (_palette) {
+				Graphics::crossBlitMap(dst, src, _convData->pitch, _rgbData.pitch, i->width(), i->height(), _convData->format.bytesPerPixel, _palette);
+			} else {
+				Graphics::crossBlit(dst, src, _convData->pitch, _rgbData.pitch, i->width(), i->height(), _convData->format, _rgbData.format);
+			}
+		}
+	}
 
-		if (_palette) {
-			Graphics::crossBlitMap(dst, src, dstPitch, srcPitch, dirtyArea.width(), dirtyArea.height(), _convData->format.bytesPerPixel, _palette);
+	for (Common::Array<Common::Rect>::iterator i = dirtyAreas.begin(); i != dirtyAreas.end(); ++i) {
+		Common::Rect &dirtyArea = *i;
+
+		const byte *src;
+		uint srcPitch;
+		if (_convData) {
+			src = (const byte *)_convData->getBasePtr(dirtyArea.left + _extraPixels, dirtyArea.top + _extraPixels);
+			srcPitch = _convData->pitch;
 		} else {
-			Graphics::crossBlit(dst, src, dstPitch, srcPitch, dirtyArea.width(), dirtyArea.height(), _convData->format, _rgbData.format);
+			src = (const byte *)_rgbData.getBasePtr(dirtyArea.left, dirtyArea.top);
+			srcPitch = _rgbData.pitch;
 		}
 
-		src = dst;
-		srcPitch = dstPitch;
-	}
+		byte *dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
+		uint dstPitch = outSurf->pitch;
+
+		if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
+			_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
+		} else {
+			Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
+			                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
+			                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
+		}
 
-	dst = (byte *)outSurf->getBasePtr(dirtyArea.left * _scaleFactor, dirtyArea.top * _scaleFactor);
-	dstPitch = outSurf->pitch;
+		dirtyArea.left   *= _scaleFactor;
+		dirtyArea.right  *= _scaleFactor;
+		dirtyArea.top    *= _scaleFactor;
+		dirtyArea.bottom *= _scaleFactor;
 
-	if (_scaler && (uint)dirtyArea.height() >= _extraPixels) {
-		_scaler->scale(src, srcPitch, dst, dstPitch, dirtyArea.width(), dirtyArea.height(), dirtyArea.left, dirtyArea.top);
-	} else {
-		Graphics::scaleBlit(dst, src, dstPitch, srcPitch,
-		                    dirtyArea.width() * _scaleFactor, dirtyArea.height() * _scaleFactor,
-		                    dirtyArea.width(), dirtyArea.height(), outSurf->format);
+		// Do generic handling of updating the texture.
+		Texture::updateGLTexture(dirtyArea);
 	}
 
-	dirtyArea.left   *= _scaleFactor;
-	dirtyArea.right  *= _scaleFactor;
-	dirtyArea.top    *= _scaleFactor;
-	dirtyArea.bottom *= _scaleFactor;
-
-	// Do generic handling of updating the texture.
-	Texture::updateGLTexture(dirtyArea);
+	// We should have handled everything, thus not dirty anymore.
+	clearDirty();
 }
 
 void ScaledTexture::setScaler(uint scalerIndex, int scaleFactor) {
@@ -592,8 +786,9 @@ TextureCLUT8GPU::TextureCLUT8GPU()
 	: _clut8Texture(GL_ALPHA, GL_ALPHA, GL_UNSIGNED_BYTE),
 	  _paletteTexture(GL_RGBA, GL_RGBA, GL_UNSIGNED_BYTE),
 	  _target(new TextureTarget()), _clut8Pipeline(new CLUT8LookUpPipeline()),
-	  _clut8Vertices(), _clut8Data(), _userPixelData(), _palette(),
-	  _paletteDirty(false) {
+	  _clut8Vertices(), _scaledTarget(nullptr), _scalerPipeline(nullptr),
+	  _scaleFactor(1), _scaledVertices(), _clut8Data(), _userPixelData(),
+	  _palette(), _paletteDirtyStart(256), _paletteDirtyEnd(0) {
 	// Allocate space for 256 colors.
 	_paletteTexture.setSize(256, 1);
 
@@ -604,6 +799,8 @@ TextureCLUT8GPU::TextureCLUT8GPU()
 }
 
 TextureCLUT8GPU::~TextureCLUT8GPU() {
+	delete _scalerPipeline;
+	delete _scaledTarget;
 	delete _clut8Pipeline;
 	delete _target;
 	_clut8Data.free();
@@ -613,23 +810,34 @@ void TextureCLUT8GPU::destroy() {
 	_clut8Texture.destroy();
 	_paletteTexture.destroy();
 	_target->destroy();
+	if (_scaledTarget) {
+		_scaledTarget->destroy();
+	}
 }
 
 void TextureCLUT8GPU::recreate() {
 	_clut8Texture.create();
 	_paletteTexture.create();
 	_target->create();
+	if (_scaledTarget) {
+		_scaledTarget->create();
+	}
 
 	// In case image date exists assure it will be completely refreshed next
 	// time.
 	if (_clut8Data.getPixels()) {
 		flagDirty();
-		_paletteDirty = true;
+		flagPaletteDirty(0, 256);
 	}
 }
 
 void TextureCLUT8GPU::enableLinearFiltering(bool enable) {
-	_target->getTexture()->enableLinearFiltering(enable);
+	// The scaler needs the exact colors of the look up
+	if (_scalerPipeline) {
+		_scaledTarget->getTexture()->enableLinearFiltering(enable);
+	} else {
+		_target->getTexture()->enableLinearFiltering(enable);
+	}
 }
 
 void TextureCLUT8GPU::allocate(uint width, uint height) {
@@ -660,6 +868,14 @@ void TextureCLUT8GPU::allocate(uint width, uint height) {
 	_clut8Vertices[6] = width;
 	_clut8Vertices[7] = height;
 
+	if (_scalerPipeline) {
+		_scaledTarget->setSize(width * _scaleFactor, height * _scaleFactor);
+
+		for (uint i = 0; i < ARRAYSIZE(_scaledVertices); ++i) {
+			_scaledVertices[i] = _clut8Vertices[i] * _scaleFactor;
+		}
+	}
+
 	// The whole texture is dirty after we changed the size. This fixes
 	// multiple texture size changes without any actual update in between.
 	// Without this we might try to write a too big texture into the GL
@@ -681,38 +897,82 @@ void TextureCLUT8GPU::setColorKey(uint colorKey) {
 	_palette[colorKey * 4 + 2] = 0x00;
 	_palette[colorKey * 4 + 3] = 0x00;
 
-	_paletteDirty = true;
+	flagPaletteDirty(colorKey, colorKey + 1);
 }
 
 void TextureCLUT8GPU::setPalette(uint start, uint colors, const byte *palData) {
 	byte *dst = _palette + start * 4;
 
-	while (colors-- > 0) {
-		memcpy(dst, palData, 3);
-		dst[3] = 0xFF;
+	// Games often set the whole palette while changing only a few entries,
+	// or none at all. Only upload the entries which actually changed.
+	for (uint i = start; i < start + colors; ++i) {
+		if (memcmp(dst, palData, 3) != 0 || dst[3] != 0xFF) {
+			memcpy(dst, palData, 3);
+			dst[3] = 0xFF;
+			flagPaletteDirty(i, i + 1);
+		}
 
 		dst += 4;
 		palData += 3;
 	}
+}
+
+void TextureCLUT8GPU::flagPaletteDirty(uint start, uint end) {
+	_paletteDirtyStart = MIN(_paletteDirtyStart, start);
+	_paletteDirtyEnd = MAX(_paletteDirtyEnd, end);
+}
+
+#ifdef USE_SCALERS
+void TextureCLUT8GPU::setScaler(uint scalerIndex, int scaleFactor) {
+	const PluginList &scalerPlugins = ScalerMan.getPlugins();
+	const ScalerPluginObject &scalerPlugin = scalerPlugins[scalerIndex]->get<ScalerPluginObject>();
+
+	delete _scalerPipeline;
+	_scalerPipeline = nullptr;
+	_scaleFactor = 1;
+
+	Shader *shader = ScalerPipeline::queryShader(scalerPlugin.getName(), scaleFactor);
+	if (!shader) {
+		warning("TextureCLUT8GPU::setScaler: No shader for scaler %s at %dx", scalerPlugin.getName(), scaleFactor);
+		return;
+	}
+
+	if (!_scaledTarget) {
+		_scaledTarget = new TextureTarget();
+	}
+
+	_scalerPipeline = new ScalerPipeline(shader);
+	_scalerPipeline->setFramebuffer(_scaledTarget);
+	_scalerPipeline->setColor(1.0f, 1.0f, 1.0f, 1.0f);
+	_scaleFactor = scaleFactor;
 
-	_paletteDirty = true;
+	// The look up result is only an intermediate step now
+	_target->getTexture()->enableLinearFiltering(false);
 }
+#endif
 
 const GLTexture &TextureCLUT8GPU::getGLTexture() const {
+	if (_scalerPipeline) {
+		return *_scaledTarget->getTexture();
+	}
 	return *_target->getTexture();
 }
 
 void TextureCLUT8GPU::updateGLTexture() {
-	const bool needLookUp = Surface::isDirty() || _paletteDirty;
+	const bool paletteDirty = _paletteDirtyStart < _paletteDirtyEnd;
+	const bool needLookUp = Surface::isDirty() || paletteDirty;
 
 	// Update CLUT8 texture if necessary.
 	if (Surface::isDirty()) {
-		_clut8Texture.updateArea(getDirtyArea(), _clut8Data);
+		const Common::Array<Common::Rect> dirtyAreas = getDirtyAreas();
+		for (Common::Array<Common::Rect>::const_iterator i = dirtyAreas.begin(); i != dirtyAreas.end(); ++i) {
+			_clut8Texture.updateArea(*i, _clut8Data);
+		}
 		clearDirty();
 	}
 
 	// Update palette if necessary.
-	if (_paletteDirty) {
+	if (paletteDirty) {
 		Graphics::Surface palSurface;
 		palSurface.init(256, 1, 256, _palette,
 #ifdef SCUMM_LITTLE_ENDIAN
@@ -722,13 +982,18 @@ void TextureCLUT8GPU::updateGLTexture() {
 #endif
 		               );
 
-		_paletteTexture.updateArea(Common::Rect(256, 1), palSurface);
-		_paletteDirty = false;
+		_paletteTexture.updateArea(Common::Rect(_paletteDirtyStart, 0, _paletteDirtyEnd, 1), palSurface);
+		_paletteDirtyStart = 256;
+		_paletteDirtyEnd = 0;
 	}
 
 	// In case any data changed, do color look up and store result in _target.
 	if (needLookUp) {
 		lookUpColors();
+
+		if (_scalerPipeline) {
+			scaleColors();
+		}
 	}
 }
 
@@ -742,6 +1007,15 @@ void TextureCLUT8GPU::lookUpColors() {
 	// Restore old state.
 	g_context.setPipeline(oldPipeline);
 }
+
+void TextureCLUT8GPU::scaleColors() {
+	// Scale the look up result from _target into _scaledTarget.
+	Pipeline *oldPipeline = g_context.setPipeline(_scalerPipeline);
+
+	g_context.getActivePipeline()->drawTexture(*_target->getTexture(), _scaledVertices);
+
+	g_context.setPipeline(oldPipeline);
+}
 #endif // !USE_FORCED_GLES
 
 } // End of namespace OpenGL
@@ -27,6 +27,7 @@
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
+#include "common/array.h"
 #include "common/rect.h"
 
 class Scaler;
@@ -133,6 +134,17 @@ public:
 	 */
 	GLuint getGLTexture() const { return _glTexture; }
 private:
+	/**
+	 * Upload the area through the pixel unpack buffer.
+	 *
+	 * The data is copied into a freshly orphaned buffer, so the driver can
+	 * transfer it to the texture asynchronously instead of stalling until
+	 * the previous upload was consumed.
+	 *
+	 * @return Whether the upload succeeded.
+	 */
+	bool updateAreaFromPixelBuffer(const Common::Rect &area, const Graphics::Surface &src);
+
 	const GLenum _glIntFormat;
 	const GLenum _glFormat;
 	const GLenum _glType;
@@ -144,6 +156,7 @@ private:
 	GLint _glFilter;
 
 	GLuint _glTexture;
+	GLuint _glPixelBuffer;
 };
 
 /**
@@ -201,8 +214,16 @@ public:
 	 */
 	void fill(uint32 color);
 
+	/**
+	 * Fill an area of the surface with a fixed color.
+	 *
+	 * @param area  The area to fill, clipped to the surface.
+	 * @param color Color value in format returned by getFormat.
+	 */
+	void fillRect(const Common::Rect &area, uint32 color);
+
 	void flagDirty() { _allDirty = true; }
-	virtual bool isDirty() const { return _allDirty || !_dirtyArea.isEmpty(); }
+	virtual bool isDirty() const { return _allDirty || !_dirtyAreas.empty(); }
 
 	virtual uint getWidth() const = 0;
 	virtual uint getHeight() const = 0;
@@ -242,12 +263,23 @@ public:
 	 */
 	virtual const GLTexture &getGLTexture() const = 0;
 protected:
-	void clearDirty() { _allDirty = false; _dirtyArea = Common::Rect(); }
+	void clearDirty() { _allDirty = false; _dirtyAreas.clear(); }
 
-	Common::Rect getDirtyArea() const;
+	/**
+	 * @return The disjoint areas which need to be updated.
+	 */
+	Common::Array<Common::Rect> getDirtyAreas() const;
+
+	void addDirtyArea(const Common::Rect &area);
 private:
+	/**
+	 * The maximum number of separately tracked dirty areas. Any area added
+	 * beyond this is merged into the existing area it fits best.
+	 */
+	enum { kMaxDirtyAreas = 8 };
+
 	bool _allDirty;
-	Common::Rect _dirtyArea;
+	Common::Array<Common::Rect> _dirtyAreas;
 };
 
 /**
@@ -291,6 +323,11 @@ public:
 protected:
 	const Graphics::PixelFormat _format;
 
+	/**
+	 * Upload one dirty area to the GL texture.
+	 *
+	 * This does not clear the dirty state.
+	 */
 	void updateGLTexture(Common::Rect &dirtyArea);
 
 private:
@@ -319,6 +356,13 @@ public:
 
 	virtual void updateGLTexture();
 protected:
+	/**
+	 * Mark all rows which use one of the given palette indices as dirty.
+	 *
+	 * @param changed Bitmask of the changed palette indices.
+	 */
+	void flagPaletteIndicesDirty(const uint32 *changed);
+
 	Graphics::Surface _rgbData;
 	Graphics::PixelFormat _fakeFormat;
 	uint32 *_palette;
@@ -372,6 +416,7 @@ protected:
 #if !USE_FORCED_GLES
 class TextureTarget;
 class CLUT8LookUpPipeline;
+class ScalerPipeline;
 
 class TextureCLUT8GPU : public Surface {
 public:
@@ -386,7 +431,7 @@ public:
 
 	virtual void allocate(uint width, uint height);
 
-	virtual bool isDirty() const { return _paletteDirty || Surface::isDirty(); }
+	virtual bool isDirty() const { return _paletteDirtyStart < _paletteDirtyEnd || Surface::isDirty(); }
 
 	virtual uint getWidth() const { return _userPixelData.w; }
 	virtual uint getHeight() const { return _userPixelData.h; }
@@ -401,6 +446,16 @@ public:
 	virtual Graphics::Surface *getSurface() { return &_userPixelData; }
 	virtual const Graphics::Surface *getSurface() const { return &_userPixelData; }
 
+#ifdef USE_SCALERS
+	/**
+	 * Scale the looked up colors with a shader.
+	 *
+	 * Only scalers for which ScalerPipeline::queryShader() returns a shader
+	 * are supported.
+	 */
+	virtual void setScaler(uint scalerIndex, int scaleFactor);
+#endif
+
 	virtual void updateGLTexture();
 	virtual const GLTexture &getGLTexture() const;
 
@@ -411,6 +466,9 @@ public:
 	}
 private:
 	void lookUpColors();
+	void scaleColors();
+
+	void flagPaletteDirty(uint start, uint end);
 
 	GLTexture _clut8Texture;
 	GLTexture _paletteTexture;
@@ -420,11 +478,22 @@ private:
 
 	GLfloat _clut8Vertices[4*2];
 
+	TextureTarget *_scaledTarget;
+	ScalerPipeline *_scalerPipeline;
+	uint _scaleFactor;
+	GLfloat _scaledVertices[4*2];
+
 	Graphics::Surface _clut8Data;
 	Graphics::Surface _userPixelData;
 
 	byte _palette[4 * 256];
-	bool _paletteDirty;
+
+	/**
+	 * Range of palette entries which need to be uploaded. Palette changes
+	 * which do not modify any entry leave this empty, so that the color look
+	 * up is skipped as well.
+	 */
+	uint _paletteDirtyStart, _paletteDirtyEnd;
 };
 #endif // !USE_FORCED_GLES
 
@@ -1227,8 +1227,15 @@ void SurfaceSdlGraphicsManager::internUpdateScreen() {
 				if (_videoMode.aspectRatioCorrection && !_overlayVisible)
 					dst_y = real2Aspect(dst_y);
 
-				_scaler->scale((byte *)srcSurf->pixels + (r->x + _maxExtraPixels) * 2 + (r->y + _maxExtraPixels) * srcPitch, srcPitch,
-					(byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch, dstPitch, r->w, dst_h, r->x, r->y);
+				const byte *srcPtr = (byte *)srcSurf->pixels + (r->x + _maxExtraPixels) * 2 + (r->y + _maxExtraPixels) * srcPitch;
+				byte *dstPtr = (byte *)_hwScreen->pixels + dst_x * 2 + dst_y * dstPitch;
+
+				// Scalers using the old source keep track of it while
+				// scaling, so they cannot be split across threads
+				if (_useOldSrc)
+					_scaler->scale(srcPtr, srcPitch, dstPtr, dstPitch, r->w, dst_h, r->x, r->y);
+				else
+					ParallelScaler::scale(*_scaler, srcPtr, srcPitch, dstPtr, dstPitch, r->w, dst_h, r->x, r->y);
 			}
 
 			r->x = dst_x;
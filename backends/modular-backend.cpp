@@ -26,6 +26,7 @@
 #include "backends/mixer/mixer.h"
 #include "gui/EventRecorder.h"
 
+#include "common/profiler.h"
 #include "common/timer.h"
 #include "graphics/pixelformat.h"
 
@@ -186,13 +187,17 @@ void ModularGraphicsBackend::fillScreen(uint32 col) {
 }
 
 void ModularGraphicsBackend::updateScreen() {
+	PROFILE_SCOPE("updateScreen");
+
 #ifdef ENABLE_EVENTRECORDER
 	g_system->getMillis();		// force event recorder to update the tick count
 	g_eventRec.processScreenUpdate();
 	g_eventRec.preDrawOverlayGui();
-#endif
 
-	_graphicsManager->updateScreen();
+	// Nobody watches fast playbacks
+	if (!g_eventRec.isFastPlayback())
+#endif
+		_graphicsManager->updateScreen();
 
 #ifdef ENABLE_EVENTRECORDER
 	g_eventRec.postDrawOverlayGui();
@@ -7,6 +7,7 @@ MODULE_OBJS := \
 	audiocd/default/default-audiocd.o \
 	events/default/default-events.o \
 	fs/abstract-fs.o \
+	fs/mappedfilestream.o \
 	fs/stdiostream.o \
 	keymapper/action.o \
 	keymapper/hardware-input.o \
@@ -132,6 +133,7 @@ MODULE_OBJS += \
 	graphics/opengl/pipelines/clut8.o \
 	graphics/opengl/pipelines/fixed.o \
 	graphics/opengl/pipelines/pipeline.o \
+	graphics/opengl/pipelines/scaler.o \
 	graphics/opengl/pipelines/shader.o
 endif
 
@@ -147,6 +149,7 @@ MODULE_OBJS += \
 	mixer/sdl/sdl-mixer.o \
 	mutex/sdl/sdl-mutex.o \
 	plugins/sdl/sdl-provider.o \
+	threads/sdl/sdl-threads.o \
 	timer/sdl/sdl-timer.o
 
 # SDL 2 removed audio CD support
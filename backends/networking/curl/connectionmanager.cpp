@@ -35,15 +35,57 @@ DECLARE_SINGLETON(Networking::ConnectionManager);
 
 }
 
+// curl_multi_wakeup() is needed to interrupt curl_multi_poll() when a new
+// Request is added, so the polling thread requires libcurl 7.68.0
+#if LIBCURL_VERSION_NUM >= 0x074400
+#define CONNMAN_USE_POLL_THREAD
+#endif
+
 namespace Networking {
 
-ConnectionManager::ConnectionManager(): _multi(nullptr), _timerStarted(false), _frame(0) {
+static void curlShareLock(CURL *handle, curl_lock_data data, curl_lock_access access, void *userptr) {
+	((ConnectionManager *)userptr)->lockShared(data);
+}
+
+static void curlShareUnlock(CURL *handle, curl_lock_data data, void *userptr) {
+	((ConnectionManager *)userptr)->unlockShared(data);
+}
+
+ConnectionManager::ConnectionManager(): _multi(nullptr), _share(nullptr), _timerStarted(false), _frame(0), _pollThreadQuit(false), _lastIterationTime(0) {
 	curl_global_init(CURL_GLOBAL_ALL);
 	_multi = curl_multi_init();
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// let transfers to the same host share one HTTP/2 connection
+	curl_multi_setopt(_multi, CURLMOPT_PIPELINING, CURLPIPE_MULTIPLEX);
+#endif
+
+	// DNS results, TLS sessions and open connections are shared between
+	// all easy handles, so consecutive requests to the same cloud service
+	// don't have to resolve and handshake again
+	_share = curl_share_init();
+	if (_share) {
+		curl_share_setopt(_share, CURLSHOPT_LOCKFUNC, curlShareLock);
+		curl_share_setopt(_share, CURLSHOPT_UNLOCKFUNC, curlShareUnlock);
+		curl_share_setopt(_share, CURLSHOPT_USERDATA, this);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+#if LIBCURL_VERSION_NUM >= 0x073900
+		curl_share_setopt(_share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+#endif
+	}
 }
 
 ConnectionManager::~ConnectionManager() {
 	stopTimer();
+	if (_pollThread.isStarted()) {
+		_addedRequestsMutex.lock();
+		_pollThreadQuit = true;
+		_addedRequestsMutex.unlock();
+#ifdef CONNMAN_USE_POLL_THREAD
+		curl_multi_wakeup(_multi);
+#endif
+		_pollThread.join();
+	}
 
 	//terminate all requests
 	_handleMutex.lock();
@@ -59,22 +101,50 @@ ConnectionManager::~ConnectionManager() {
 	_requests.clear();
 
 	//cleanup
+	if (_share)
+		curl_share_cleanup(_share);
 	curl_multi_cleanup(_multi);
 	curl_global_cleanup();
+	_share = nullptr;
 	_multi = nullptr;
 	_handleMutex.unlock();
 }
 
 void ConnectionManager::registerEasyHandle(CURL *easy) const {
+	if (_share)
+		curl_easy_setopt(easy, CURLOPT_SHARE, _share);
+#if LIBCURL_VERSION_NUM >= 0x072F00
+	curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, CURL_HTTP_VERSION_2TLS);
+#endif
+#if LIBCURL_VERSION_NUM >= 0x072B00
+	// wait for an existing connection to become multiplexable instead of opening another one
+	curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+#endif
 	curl_multi_add_handle(_multi, easy);
 }
 
+void ConnectionManager::lockShared(int data) {
+	if (data >= 0 && data < (int)SHARE_LOCK_COUNT)
+		_shareMutexes[data].lock();
+}
+
+void ConnectionManager::unlockShared(int data) {
+	if (data >= 0 && data < (int)SHARE_LOCK_COUNT)
+		_shareMutexes[data].unlock();
+}
+
 Request *ConnectionManager::addRequest(Request *request, RequestCallback callback) {
 	_addedRequestsMutex.lock();
 	_addedRequests.push_back(RequestWithCallback(request, callback));
-	if (!_timerStarted)
-		startTimer();
+	if (!_timerStarted) {
+		if (!startPollThread())
+			startTimer();
+	}
 	_addedRequestsMutex.unlock();
+#ifdef CONNMAN_USE_POLL_THREAD
+	if (_pollThread.isStarted())
+		curl_multi_wakeup(_multi);
+#endif
 	return request;
 }
 
@@ -127,6 +197,61 @@ void connectionsThread(void *ignored) {
 	ConnMan.handle();
 }
 
+void connectionsPollThread(void *ignored) {
+	ConnMan.pollLoop();
+}
+
+bool ConnectionManager::startPollThread() {
+#ifdef CONNMAN_USE_POLL_THREAD
+	// the previous thread has already given up _addedRequestsMutex for good
+	// once it reset _timerStarted, so it is safe to join it while holding it
+	if (_pollThread.isStarted())
+		_pollThread.join();
+
+	_lastIterationTime = g_system->getMillis();
+	_timerStarted = true;
+	if (_pollThread.start(connectionsPollThread, nullptr))
+		return true;
+	_timerStarted = false;
+#endif
+	return false;
+}
+
+void ConnectionManager::pollLoop() {
+#ifdef CONNMAN_USE_POLL_THREAD
+	const uint32 interval = TIMER_INTERVAL / 1000;
+
+	while (true) {
+		_handleMutex.lock();
+		// Requests are still handled at the timer's pace, because they
+		// count their retry delays and download speeds in timer periods
+		uint32 now = g_system->getMillis();
+		if (now - _lastIterationTime >= interval) {
+			_lastIterationTime = now;
+			++_frame;
+			interateRequests();
+		}
+		processTransfers();
+		bool idle = _requests.empty();
+		uint32 timeout = interval - MIN<uint32>(g_system->getMillis() - _lastIterationTime, interval);
+		_handleMutex.unlock();
+
+		_addedRequestsMutex.lock();
+		if (_pollThreadQuit || (idle && _addedRequests.empty())) {
+			debug(9, "polling thread stopped");
+			_timerStarted = false;
+			_addedRequestsMutex.unlock();
+			return;
+		}
+		_addedRequestsMutex.unlock();
+
+		// returns early when a socket is ready or curl_multi_wakeup() is called
+		int numFds;
+		curl_multi_poll(_multi, nullptr, 0, timeout, &numFds);
+	}
+#endif
+}
+
 void ConnectionManager::startTimer(int interval) {
 	Common::TimerManager *manager = g_system->getTimerManager();
 	if (manager->installTimerProc(connectionsThread, interval, nullptr, "Networking::ConnectionManager's Timer")) {
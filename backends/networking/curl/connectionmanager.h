@@ -27,9 +27,11 @@
 #include "common/singleton.h"
 #include "common/hashmap.h"
 #include "common/mutex.h"
+#include "common/thread.h"
 
 typedef void CURL;
 typedef void CURLM;
+typedef void CURLSH;
 struct curl_slist;
 
 namespace Networking {
@@ -42,8 +44,10 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	static const uint32 CLOUD_PERIOD = 1; //every frame
 	static const uint32 CURL_PERIOD = 1; //every frame
 	static const uint32 DEBUG_PRINT_PERIOD = FRAMES_PER_SECOND; // once per second
+	static const uint32 SHARE_LOCK_COUNT = 8; // more than CURL_LOCK_DATA_LAST ever was
 
 	friend void connectionsThread(void *); //calls handle()
+	friend void connectionsPollThread(void *); //calls pollLoop()
 
 	typedef Common::BaseCallback<Request *> *RequestCallback;
 
@@ -75,13 +79,27 @@ class ConnectionManager : public Common::Singleton<ConnectionManager> {
 	};
 
 	CURLM *_multi;
+	CURLSH *_share;
 	bool _timerStarted;
 	Common::Array<RequestWithCallback> _requests, _addedRequests;
 	Common::Mutex _handleMutex, _addedRequestsMutex;
+	Common::Mutex _shareMutexes[SHARE_LOCK_COUNT];
 	uint32 _frame;
 
+	/**
+	 * When libcurl supports curl_multi_poll() and curl_multi_wakeup(),
+	 * transfers are driven by this thread instead of the timer. It sleeps
+	 * until a socket becomes ready or a Request is added, so responses are
+	 * processed as soon as they arrive rather than on the next timer tick.
+	 */
+	Common::Thread _pollThread;
+	bool _pollThreadQuit;
+	uint32 _lastIterationTime;
+
 	void startTimer(int interval = TIMER_INTERVAL);
 	void stopTimer();
+	bool startPollThread();
+	void pollLoop();
 	void handle();
 	void interateRequests();
 	void processTransfers();
@@ -98,6 +116,14 @@ public:
 	 */
 	void registerEasyHandle(CURL *easy) const;
 
+	/**
+	 * Lock and unlock one kind of data shared between the easy handles
+	 * (connection cache, DNS cache and TLS sessions). Used as the
+	 * callbacks of the share handle.
+	 */
+	void lockShared(int data);
+	void unlockShared(int data);
+
 	/**
 	 * Use this method to add new Request into manager's queue.
 	 * Manager will periodically call handle() method of these
@@ -107,7 +133,8 @@ public:
 	 *
 	 * The passed callback would be called after Request is deleted.
 	 *
-	 * @note This method starts the timer if it's not started yet.
+	 * @note This method starts the timer (or the polling thread) if it's
+	 *       not started yet.
 	 *
 	 * @return the same Request pointer, just as a shortcut
 	 */
@@ -55,10 +55,10 @@ typedef void (*sighandler_t)(int);
 #include "backends/saves/default/default-saves.h"
 #include "backends/timer/default/default-timer.h"
 #include "backends/events/default/default-events.h"
-#include "backends/mixer/null/null-mixer.h"
-#include "backends/graphics/null/null-graphics.h"
 #include "gui/debugger.h"
 #endif
+#include "backends/mixer/null/null-mixer.h"
+#include "backends/graphics/null/null-graphics.h"
 
 /*
  * Include header files needed for the getFilesystemFactory() method.
@@ -82,10 +82,19 @@ public:
 
 	virtual void initBackend();
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	virtual MixerManager *getMixerManager();
+
+	// Tests can provide a hardware MPEG decoder, see test/null_osystem.cpp
+	virtual bool hasFeature(Feature f);
+	virtual Image::MPEGPacketDecoder *createHardwareMPEGDecoder(uint16 width, uint16 height);
+#endif
+
 	virtual bool pollEvent(Common::Event &event);
 
 	virtual Common::MutexInternal *createMutex();
 	virtual uint32 getMillis(bool skipRecord = false);
+	virtual uint64 getMicros();
 	virtual void delayMillis(uint msecs);
 	virtual void getTimeAndDate(TimeDate &td, bool skipRecord = false) const;
 
@@ -117,6 +126,13 @@ OSystem_NULL::OSystem_NULL() {
 	#else
 		#error Unknown and unsupported FS backend
 	#endif
+
+#ifdef NULL_DRIVER_USE_FOR_TEST
+	// The code under test may query the screen, like the video decoders do
+	_graphicsManager = new NullGraphicsManager();
+	// Audio streams may lock the mixer, like Paula does
+	_mixerManager = new NullMixerManager();
+#endif
 }
 
 OSystem_NULL::~OSystem_NULL() {
@@ -157,6 +173,16 @@ void OSystem_NULL::initBackend() {
 	BaseBackend::initBackend();
 }
 
+#ifdef NULL_DRIVER_USE_FOR_TEST
+MixerManager *OSystem_NULL::getMixerManager() {
+	// The mixer creates a mutex through g_system, so it can only be set up once
+	// g_system is installed
+	if (!_mixerManager->getMixer())
+		_mixerManager->init();
+	return _mixerManager;
+}
+#endif
+
 bool OSystem_NULL::pollEvent(Common::Event &event) {
 #ifndef NULL_DRIVER_USE_FOR_TEST
 	((DefaultTimerManager *)getTimerManager())->checkTimers();
@@ -203,6 +229,18 @@ uint32 OSystem_NULL::getMillis(bool skipRecord) {
 #endif
 }
 
+uint64 OSystem_NULL::getMicros() {
+#ifdef POSIX
+	timeval curTime;
+
+	gettimeofday(&curTime, 0);
+
+	return (uint64)(curTime.tv_sec - _startTime.tv_sec) * 1000000 + curTime.tv_usec - _startTime.tv_usec;
+#else
+	return OSystem::getMicros();
+#endif
+}
+
 void OSystem_NULL::delayMillis(uint msecs) {
 #ifdef POSIX
 	usleep(msecs * 1000);
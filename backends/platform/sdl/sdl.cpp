@@ -44,6 +44,7 @@
 #include "backends/events/sdl/legacy-sdl-events.h"
 #include "backends/keymapper/hardware-input.h"
 #include "backends/mutex/sdl/sdl-mutex.h"
+#include "backends/threads/sdl/sdl-threads.h"
 #include "backends/timer/sdl/sdl-timer.h"
 #include "backends/graphics/surfacesdl/surfacesdl-graphics.h"
 #ifdef USE_OPENGL
@@ -177,6 +178,13 @@ bool OSystem_SDL::hasFeature(Feature f) {
 #if SDL_VERSION_ATLEAST(2, 0, 14)
 	if (f == kFeatureOpenUrl) return true;
 #endif
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	if (f == kFeatureCpuSSE2) return SDL_HasSSE2();
+#endif
+#if SDL_VERSION_ATLEAST(2, 0, 6)
+	if (f == kFeatureCpuNEON) return SDL_HasNEON();
+#endif
+	if (f == kFeatureThreads) return true;
 	if (f == kFeatureJoystickDeadzone || f == kFeatureKbdMouseSpeed) {
 		return _eventSource->isJoystickConnected();
 	}
@@ -528,6 +536,7 @@ Common::Array<uint> OSystem_SDL::getSupportedAntiAliasingLevels() const {
 #endif
 
 void OSystem_SDL::quit() {
+	ConfMan.waitForPendingFlush();
 	destroy();
 	exit(0);
 }
@@ -691,6 +700,14 @@ Common::MutexInternal *OSystem_SDL::createMutex() {
 	return createSdlMutexInternal();
 }
 
+Common::ThreadInternal *OSystem_SDL::createThread(Common::ThreadProc proc, void *data) {
+	return createSdlThreadInternal(proc, data);
+}
+
+Common::SemaphoreInternal *OSystem_SDL::createSemaphore(uint initialCount) {
+	return createSdlSemaphoreInternal(initialCount);
+}
+
 uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	uint32 millis = SDL_GetTicks();
 
@@ -701,6 +718,17 @@ uint32 OSystem_SDL::getMillis(bool skipRecord) {
 	return millis;
 }
 
+uint64 OSystem_SDL::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const Uint64 counter = SDL_GetPerformanceCounter();
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+	// Split the conversion so that it does not overflow
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+#else
+	return OSystem::getMicros();
+#endif
+}
+
 void OSystem_SDL::delayMillis(uint msecs) {
 #ifdef ENABLE_EVENTRECORDER
 	if (!g_eventRec.processDelayMillis())
@@ -26,10 +26,13 @@
 #include "backends/plugins/elf/elf-loader.h"
 #include "backends/plugins/elf/memory-manager.h"
 
+#include "common/config-manager.h"
 #include "common/debug.h"
+#include "common/endian.h"
 #include "common/file.h"
 #include "common/fs.h"
 #include "common/ptr.h"
+#include "common/system.h"
 
 #include <malloc.h>	// for memalign()
 
@@ -41,6 +44,8 @@ DLObject::DLObject() :
 	_segmentSize(0),
 	_segmentOffset(0),
 	_segmentVMA(0),
+	_segmentAlign(0),
+	_segmentFlags(0),
 	_symbol_cnt(0),
 	_symtab_sect(-1),
 	_dtors_start(0),
@@ -180,6 +185,8 @@ bool DLObject::loadSegment(Elf32_Phdr *phdr) {
 	// Get offset to load segment into
 	_segmentSize = phdr->p_memsz;
 	_segmentVMA = phdr->p_vaddr;
+	_segmentAlign = phdr->p_align;
+	_segmentFlags = phdr->p_flags;
 
 	// Set .bss segment to 0 if necessary
 	if (phdr->p_memsz > phdr->p_filesz) {
@@ -371,6 +378,8 @@ bool DLObject::load() {
 	Elf32_Ehdr ehdr;
 	Elf32_Phdr phdr;
 
+	const uint32 startTime = g_system->getMillis();
+
 	if (readElfHeader(&ehdr) == false)
 		return false;
 
@@ -385,6 +394,8 @@ bool DLObject::load() {
 			return false;
 	}
 
+	const uint32 segmentsTime = g_system->getMillis();
+
 	Elf32_Shdr *shdr = loadSectionHeaders(&ehdr);
 	if (!shdr)
 		return false;
@@ -400,6 +411,8 @@ bool DLObject::load() {
 		return false;
 	}
 
+	const uint32 symbolsTime = g_system->getMillis();
+
 	// Offset by our segment allocated address
 	// must use _segmentVMA here for multiple segments (MIPS)
 	_segmentOffset = ptrdiff_t(_segment) - _segmentVMA;
@@ -410,35 +423,214 @@ bool DLObject::load() {
 		return false;
 	}
 
+	free(shdr);
+
 	protectMemory(_segment, _segmentSize, phdr.p_flags);
 
+	const uint32 endTime = g_system->getMillis();
+	debug(1, "elfloader: Loaded in %u ms: segments %u ms, symbols %u ms, relocations %u ms",
+			endTime - startTime, segmentsTime - startTime, symbolsTime - segmentsTime, endTime - symbolsTime);
+
+	// Several segments are only loaded by MIPS, for the shorts
+	if (ehdr.e_phnum != 1)
+		_segmentAlign = 0;
+
 	return true;
 }
 
-bool DLObject::open(const char *path) {
-	void *ctors_start, *ctors_end;
+#define ELF_IMAGE_CACHE_VERSION 1
 
-	debug(2, "elfloader: open(\"%s\")", path);
+/**
+ * Return the file where the relocated image of the plugin at @p path is
+ * cached, in an elfcache directory next to the configuration file.
+ */
+static Common::FSNode getImageCacheFile(const char *path) {
+	Common::String configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return Common::FSNode();
+
+	Common::FSNode configNode(configFile);
+	Common::FSNode dir = configNode.getParent();
+	if (dir.getPath() == configNode.getPath() || !dir.isDirectory())
+		return Common::FSNode();
+
+	dir = dir.getChild("elfcache");
+	if (!dir.exists() && !dir.createDirectory())
+		return Common::FSNode();
+
+	return dir.getChild(Common::FSNode(path).getName() + ".img");
+}
 
-	_file = Common::FSNode(path).createReadStream();
+static bool isImageCacheEnabled() {
+	return ConfMan.hasKey("elf_plugin_cache") && ConfMan.getBool("elf_plugin_cache");
+}
 
-	if (!_file) {
-		warning("elfloader: File %s not found.", path);
+bool DLObject::loadCachedImage(const char *path) {
+	if (!isImageCacheEnabled() || !canCacheImage())
+		return false;
+
+	int64 fileSize, modificationTime;
+	if (!Common::FSNode(path).getFileStats(fileSize, modificationTime))
+		return false;
+
+	Common::FSNode cacheFile = getImageCacheFile(path);
+	if (!cacheFile.exists())
+		return false;
+
+	Common::ScopedPtr<Common::SeekableReadStream> cache(cacheFile.createReadStream());
+	if (!cache)
+		return false;
+
+	const uint32 startTime = g_system->getMillis();
+
+	if (cache->readUint32BE() != MKTAG('E', 'L', 'F', 'I') || cache->readUint32LE() != ELF_IMAGE_CACHE_VERSION ||
+			cache->readSint64LE() != fileSize || cache->readSint64LE() != modificationTime) {
+		debug(2, "elfloader: Ignoring outdated image cache for %s", path);
+		return false;
+	}
+
+	const uint32 address = cache->readUint32LE();
+	const uint32 size = cache->readUint32LE();
+	const uint32 vma = cache->readUint32LE();
+	const uint32 align = cache->readUint32LE();
+	const int flags = cache->readSint32LE();
+	if (cache->err() || size > cache->size() - cache->pos())
+		return false;
+
+	// The image is only valid at the address it was relocated for
+	_segment = (byte *)allocateMemory(align, size);
+	if (!_segment)
+		return false;
+
+	_segmentSize = size;
+	if (Elf32_Addr(_segment) != address) {
+		debug(2, "elfloader: Segment @ %p instead of 0x%08x, not using the image cache", _segment, address);
+		discardSegment();
 		return false;
 	}
 
-	debug(2, "elfloader: %s found!", path);
+	if (cache->read(_segment, size) != size) {
+		discardSegment();
+		return false;
+	}
+
+	_segmentVMA = vma;
+	_segmentAlign = align;
+	_segmentFlags = flags;
+	_segmentOffset = ptrdiff_t(_segment) - _segmentVMA;
 
-	/*Try to load and relocate*/
-	if (!load()) {
+	// Only the exported symbols are stored, already relocated
+	_symbol_cnt = cache->readUint32LE();
+	const uint32 strtabSize = cache->readUint32LE();
+	if (cache->err() || _symbol_cnt == 0 ||
+			_symbol_cnt * sizeof(Elf32_Sym) + strtabSize != cache->size() - cache->pos()) {
 		unload();
 		return false;
 	}
 
-	debug(2, "elfloader: Loaded!");
+	_symtab = (Elf32_Sym *)malloc(_symbol_cnt * sizeof(Elf32_Sym));
+	_strtab = (char *)malloc(strtabSize);
+	if (!_symtab || !_strtab ||
+			cache->read(_symtab, _symbol_cnt * sizeof(Elf32_Sym)) != _symbol_cnt * sizeof(Elf32_Sym) ||
+			cache->read(_strtab, strtabSize) != strtabSize) {
+		unload();
+		return false;
+	}
 
-	delete _file;
-	_file = 0;
+	protectMemory(_segment, _segmentSize, _segmentFlags);
+
+	debug(1, "elfloader: Loaded %s from the image cache in %u ms", path, g_system->getMillis() - startTime);
+	return true;
+}
+
+void DLObject::saveCachedImage(const char *path) {
+	if (!isImageCacheEnabled() || !canCacheImage() || !_segmentAlign)
+		return;
+
+	int64 fileSize, modificationTime;
+	if (!Common::FSNode(path).getFileStats(fileSize, modificationTime))
+		return;
+
+	// Keep the symbols which symbol() can return
+	uint32 exported = 0, strtabSize = 0;
+	for (uint32 i = 0; i < _symbol_cnt; i++) {
+		if (SYM_BIND(_symtab[i].st_info) == STB_GLOBAL || SYM_BIND(_symtab[i].st_info) == STB_WEAK) {
+			exported++;
+			strtabSize += strlen(_strtab + _symtab[i].st_name) + 1;
+		}
+	}
+
+	Common::ScopedPtr<Common::WriteStream> cache(getImageCacheFile(path).createWriteStream());
+	if (!cache)
+		return;
+
+	cache->writeUint32BE(MKTAG('E', 'L', 'F', 'I'));
+	cache->writeUint32LE(ELF_IMAGE_CACHE_VERSION);
+	cache->writeSint64LE(fileSize);
+	cache->writeSint64LE(modificationTime);
+	cache->writeUint32LE(Elf32_Addr(_segment));
+	cache->writeUint32LE(_segmentSize);
+	cache->writeUint32LE(_segmentVMA);
+	cache->writeUint32LE(_segmentAlign);
+	cache->writeSint32LE(_segmentFlags);
+	cache->write(_segment, _segmentSize);
+
+	cache->writeUint32LE(exported);
+	cache->writeUint32LE(strtabSize);
+	uint32 nameOffset = 0;
+	for (uint32 i = 0; i < _symbol_cnt; i++) {
+		if (SYM_BIND(_symtab[i].st_info) == STB_GLOBAL || SYM_BIND(_symtab[i].st_info) == STB_WEAK) {
+			Elf32_Sym sym = _symtab[i];
+			sym.st_name = nameOffset;
+			nameOffset += strlen(_strtab + _symtab[i].st_name) + 1;
+			cache->write(&sym, sizeof(sym));
+		}
+	}
+	for (uint32 i = 0; i < _symbol_cnt; i++) {
+		if (SYM_BIND(_symtab[i].st_info) == STB_GLOBAL || SYM_BIND(_symtab[i].st_info) == STB_WEAK) {
+			const char *name = _strtab + _symtab[i].st_name;
+			cache->write(name, strlen(name) + 1);
+		}
+	}
+
+	cache->finalize();
+	if (cache->err())
+		warning("elfloader: Could not write the image cache of %s", path);
+}
+
+bool DLObject::open(const char *path) {
+	void *ctors_start, *ctors_end;
+
+	debug(2, "elfloader: open(\"%s\")", path);
+
+	if (!loadCachedImage(path)) {
+		_file = Common::FSNode(path).createReadStream();
+
+		if (!_file) {
+			warning("elfloader: File %s not found.", path);
+			return false;
+		}
+
+		debug(2, "elfloader: %s found!", path);
+
+		/*Try to load and relocate*/
+		if (!load()) {
+			unload();
+			delete _file;
+			_file = 0;
+			return false;
+		}
+
+		debug(2, "elfloader: Loaded!");
+
+		delete _file;
+		_file = 0;
+
+		// The constructors below modify the data of the plugin
+		saveCachedImage(path);
+	}
 
 	flushDataCache(_segment, _segmentSize);
 
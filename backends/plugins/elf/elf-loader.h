@@ -51,6 +51,8 @@ protected:
 	uint32 _segmentSize;
 	ptrdiff_t _segmentOffset;
 	uint32 _segmentVMA;
+	uint32 _segmentAlign;
+	int _segmentFlags;
 
 	uint32 _symbol_cnt;
 	int32 _symtab_sect;
@@ -69,6 +71,26 @@ protected:
 	virtual void relocateSymbols(ptrdiff_t offset);
 	void discardSegment();
 
+	/**
+	 * Load the relocated image of the plugin at @p path stored by
+	 * saveCachedImage(), if the plugin did not change since and the
+	 * segment can be allocated at the same address again.
+	 */
+	bool loadCachedImage(const char *path);
+
+	/**
+	 * Store the relocated segment along with the exported symbols, so that
+	 * the next load is a single read. Must be called before the
+	 * constructors of the plugin run.
+	 */
+	void saveCachedImage(const char *path);
+
+	/**
+	 * Whether the loaded image only depends on the segment address, and
+	 * can thus be cached.
+	 */
+	virtual bool canCacheImage() const { return true; }
+
 	// architecture specific
 
 	/**
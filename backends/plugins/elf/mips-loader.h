@@ -41,6 +41,9 @@ protected:
 	virtual bool loadSegment(Elf32_Phdr *phdr);
 	virtual void unload();
 
+	// The shorts segment lives outside of the cached image
+	virtual bool canCacheImage() const { return false; }
+
 	void freeShortsSegment();
 
 public:
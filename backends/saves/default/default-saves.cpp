@@ -42,20 +42,258 @@
 #include "common/archive.h"
 #include "common/config-manager.h"
 #include "common/zlib.h"
+#include "common/list.h"
+#include "common/mutex.h"
+#include "common/thread.h"
+#include "common/md5.h"
 
-#include <errno.h>	// for removeSavefile()
+#include <errno.h>	// for removeSavefile() and renameFile()
 
 #if defined(USE_CLOUD) && defined(USE_LIBCURL)
 const char *DefaultSaveFileManager::TIMESTAMPS_FILENAME = "timestamps";
+// starts with a '.', so CloudManager never syncs it
+const char *DefaultSaveFileManager::SYNCED_CONTENT_FILENAME = ".synced";
 #endif
 
-DefaultSaveFileManager::DefaultSaveFileManager() {
+/** A save file written in the background. */
+struct AsyncSave {
+	Common::Array<byte *> chunks;           ///< The data, in chunks of kChunkSize bytes
+	uint32 size;                            ///< Size of the data
+	bool compress;
+	Common::SeekableWriteStream *stream;    ///< The temporary file
+	Common::String tempPath;
+	Common::String path;
+	Common::SaveCallback *callback;
+	Common::Error result;
+
+	enum {
+		kChunkSize = 256 * 1024
+	};
+
+	AsyncSave() : size(0), compress(true), stream(nullptr), callback(nullptr) {}
+
+	~AsyncSave() {
+		freeChunks();
+		delete stream;
+		delete callback;
+	}
+
+	void freeChunks() {
+		for (uint i = 0; i < chunks.size(); ++i)
+			free(chunks[i]);
+		chunks.clear();
+	}
+};
+
+/**
+ * Writes the saves opened with openForSavingAsync(), one after the other, on
+ * a worker thread if the backend supports threads, or else right away.
+ */
+class AsyncSaveWriter {
+public:
+	explicit AsyncSaveWriter(DefaultSaveFileManager *manager) : _manager(manager), _quit(false) {
+		if (_wake.isValid() && _done.isValid())
+			_thread.start(workerProc, this);
+	}
+
+	~AsyncSaveWriter() {
+		{
+			Common::StackLock lock(_mutex);
+			_quit = true;
+		}
+
+		// The worker writes the pending saves before quitting
+		if (_thread.isStarted()) {
+			_wake.post();
+			_thread.join();
+		}
+
+		for (Common::List<AsyncSave *>::iterator i = _completed.begin(); i != _completed.end(); ++i)
+			delete *i;
+	}
+
+	/** Write @p save, whose temporary file was opened already or failed to. */
+	void submit(AsyncSave *save) {
+		if (save->stream && _thread.isStarted()) {
+			Common::StackLock lock(_mutex);
+			_pending.push_back(save);
+			_wake.post();
+			return;
+		}
+
+		if (save->stream)
+			write(save);
+		Common::StackLock lock(_mutex);
+		_completed.push_back(save);
+	}
+
+	void waitForPendingSaves() {
+		for (;;) {
+			{
+				Common::StackLock lock(_mutex);
+				if (_pending.empty())
+					return;
+			}
+			_done.wait();
+		}
+	}
+
+	/** Return the completed saves, in the order they completed. */
+	Common::List<AsyncSave *> takeCompletedSaves() {
+		Common::StackLock lock(_mutex);
+		return Common::move(_completed);
+	}
+
+private:
+	static void workerProc(void *data) {
+		((AsyncSaveWriter *)data)->work();
+	}
+
+	void work() {
+		for (;;) {
+			AsyncSave *save = nullptr;
+			{
+				Common::StackLock lock(_mutex);
+				if (!_pending.empty())
+					save = _pending.front();
+				else if (_quit)
+					return;
+			}
+
+			if (!save) {
+				_wake.wait();
+				continue;
+			}
+
+			write(save);
+
+			{
+				Common::StackLock lock(_mutex);
+				_pending.pop_front();
+				_completed.push_back(save);
+			}
+			_done.post();
+		}
+	}
+
+	/** Write @p save to its temporary file, and move that over the save file. */
+	void write(AsyncSave *save) {
+		Common::WriteStream *stream = save->compress ? Common::wrapCompressedWriteStream(save->stream) : save->stream;
+		save->stream = nullptr;
+
+		uint32 left = save->size;
+		for (uint i = 0; i < save->chunks.size() && !stream->err(); ++i) {
+			const uint32 size = MIN<uint32>(left, AsyncSave::kChunkSize);
+			stream->write(save->chunks[i], size);
+			left -= size;
+		}
+		save->freeChunks();
+
+		stream->finalize();
+		const bool failed = stream->err();
+		delete stream;
+
+		Common::ErrorCode result = failed ? Common::kWritingFailed : _manager->renameFile(save->tempPath, save->path);
+		if (result != Common::kNoError)
+			_manager->removeFile(save->tempPath);
+		save->result = result;
+	}
+
+	DefaultSaveFileManager *_manager;
+
+	Common::Mutex _mutex;
+	Common::Semaphore _wake;
+	Common::Semaphore _done;
+	Common::Thread _thread;
+
+	// The following members are protected by _mutex
+	Common::List<AsyncSave *> _pending;    ///< Saves to write, the first one being written
+	Common::List<AsyncSave *> _completed;  ///< Saves whose callbacks were not called yet
+	bool _quit;
+};
+
+namespace {
+
+/**
+ * The stream returned by openForSavingAsync(), which keeps the data in
+ * memory until it is finalized. The data is stored in chunks, so that large
+ * saves are never moved around as they grow.
+ */
+class AsyncSaveStream : public Common::WriteStream {
+public:
+	AsyncSaveStream(AsyncSaveWriter *writer, AsyncSave *save, const Common::FSNode &tempNode)
+		: _writer(writer), _save(save), _tempNode(tempNode), _pos(0) {}
+	~AsyncSaveStream() override { delete _save; }
+
+	uint32 write(const void *dataPtr, uint32 dataSize) override {
+		if (!_save)
+			return 0;
+
+		const byte *data = (const byte *)dataPtr;
+		uint32 left = dataSize;
+		while (left > 0) {
+			const uint32 offset = _save->size % AsyncSave::kChunkSize;
+			if (offset == 0) {
+				byte *chunk = (byte *)malloc(AsyncSave::kChunkSize);
+				if (!chunk)
+					break;
+				_save->chunks.push_back(chunk);
+			}
+
+			const uint32 size = MIN<uint32>(left, AsyncSave::kChunkSize - offset);
+			memcpy(_save->chunks.back() + offset, data, size);
+			_save->size += size;
+			data += size;
+			left -= size;
+		}
+
+		_pos += dataSize - left;
+		return dataSize - left;
+	}
+
+	int64 pos() const override { return _pos; }
+
+	void finalize() override {
+		if (!_save)
+			return;
+
+		_save->stream = _tempNode.createWriteStream();
+		if (!_save->stream)
+			_save->result = Common::kCreatingFileFailed;
+		_writer->submit(_save);
+		_save = nullptr;
+	}
+
+private:
+	AsyncSaveWriter *_writer;
+	AsyncSave *_save;
+	Common::FSNode _tempNode;
+	uint32 _pos;
+};
+
+/**
+ * A save file whose cloud synchronisation waits for the background write.
+ */
+class AsyncOutSaveFile : public Common::OutSaveFile {
+public:
+	AsyncOutSaveFile(AsyncSaveStream *stream) : Common::OutSaveFile(stream) {}
+
+	void finalize() override { _wrapped->finalize(); }
+};
+
+} // End of anonymous namespace
+
+DefaultSaveFileManager::DefaultSaveFileManager() : _asyncSaveWriter(nullptr) {
 }
 
-DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) {
+DefaultSaveFileManager::DefaultSaveFileManager(const Common::String &defaultSavepath) : _asyncSaveWriter(nullptr) {
 	ConfMan.registerDefault("savepath", defaultSavepath);
 }
 
+DefaultSaveFileManager::~DefaultSaveFileManager() {
+	delete _asyncSaveWriter;
+}
+
 
 void DefaultSaveFileManager::checkPath(const Common::FSNode &dir) {
 	clearError();
@@ -77,6 +315,9 @@ void DefaultSaveFileManager::updateSavefilesList(Common::StringArray &lockedFile
 }
 
 Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &pattern) {
+	// Let the background saves complete first.
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -97,6 +338,9 @@ Common::StringArray DefaultSaveFileManager::listSavefiles(const Common::String &
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &filename) {
+	// Let the background saves complete first.
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -113,6 +357,9 @@ Common::InSaveFile *DefaultSaveFileManager::openRawFile(const Common::String &fi
 }
 
 Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String &filename) {
+	// Let the background saves complete first.
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -135,6 +382,9 @@ Common::InSaveFile *DefaultSaveFileManager::openForLoading(const Common::String
 }
 
 Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String &filename, bool compress) {
+	// Let the background saves complete first.
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	const Common::String savePathName = getSavePath();
 	assureCached(savePathName);
@@ -178,7 +428,86 @@ Common::OutSaveFile *DefaultSaveFileManager::openForSaving(const Common::String
 	return result;
 }
 
+Common::OutSaveFile *DefaultSaveFileManager::openForSavingAsync(const Common::String &filename, Common::SaveCallback *callback, bool compress) {
+	// Assure the savefile name cache is up-to-date.
+	const Common::String savePathName = getSavePath();
+	assureCached(savePathName);
+	if (getError().getCode() != Common::kNoError) {
+		delete callback;
+		return nullptr;
+	}
+
+	for (Common::StringArray::const_iterator i = _lockedFiles.begin(), end = _lockedFiles.end(); i != end; ++i) {
+		if (filename == *i) {
+			delete callback;
+			return nullptr; //file is locked, no saving available
+		}
+	}
+
+	// Saves of the same file share their temporary file
+	waitForPendingSaves();
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	// Update file's timestamp
+	Common::HashMap<Common::String, uint32> timestamps = loadTimestamps();
+	timestamps[filename] = INVALID_TIMESTAMP;
+	saveTimestamps(timestamps);
+#endif
+
+	// Obtain node.
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	const Common::FSNode savePath(savePathName);
+	Common::FSNode fileNode;
+
+	// If the file did not exist before, we add it to the cache.
+	if (file == _saveFileCache.end()) {
+		fileNode = savePath.getChild(filename);
+		_saveFileCache[filename] = Common::FSNode(fileNode.getPath());
+	} else {
+		fileNode = file->_value;
+	}
+
+	if (!_asyncSaveWriter)
+		_asyncSaveWriter = new AsyncSaveWriter(this);
+
+	const Common::FSNode tempNode = savePath.getChild(filename + ".tmp");
+	AsyncSave *save = new AsyncSave();
+	save->compress = compress;
+	save->tempPath = tempNode.getPath();
+	save->path = fileNode.getPath();
+	save->callback = callback;
+	return new AsyncOutSaveFile(new AsyncSaveStream(_asyncSaveWriter, save, tempNode));
+}
+
+void DefaultSaveFileManager::processCompletedSaves() {
+	if (!_asyncSaveWriter)
+		return;
+
+	Common::List<AsyncSave *> saves = _asyncSaveWriter->takeCompletedSaves();
+	if (saves.empty())
+		return;
+
+#if defined(USE_CLOUD) && defined(USE_LIBCURL)
+	CloudMan.syncSaves();
+#endif
+
+	for (Common::List<AsyncSave *>::iterator i = saves.begin(); i != saves.end(); ++i) {
+		AsyncSave *save = *i;
+		if (save->callback)
+			(*save->callback)(save->result);
+		delete save;
+	}
+}
+
+void DefaultSaveFileManager::waitForPendingSaves() {
+	if (_asyncSaveWriter)
+		_asyncSaveWriter->waitForPendingSaves();
+}
+
 bool DefaultSaveFileManager::removeSavefile(const Common::String &filename) {
+	// Let the background saves complete first.
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -223,7 +552,25 @@ Common::ErrorCode DefaultSaveFileManager::removeFile(const Common::String &filep
 	return Common::kUnknownError;
 }
 
+Common::ErrorCode DefaultSaveFileManager::renameFile(const Common::String &oldPath, const Common::String &newPath) {
+	if (rename(oldPath.c_str(), newPath.c_str()) == 0)
+		return Common::kNoError;
+
+	// Some systems, like Windows, do not replace existing files
+	if ((errno == EEXIST || errno == EACCES) && remove(newPath.c_str()) == 0 && rename(oldPath.c_str(), newPath.c_str()) == 0)
+		return Common::kNoError;
+
+	if (errno == EACCES)
+		return Common::kWritePermissionDenied;
+	if (errno == ENOENT)
+		return Common::kPathDoesNotExist;
+	return Common::kUnknownError;
+}
+
 bool DefaultSaveFileManager::exists(const Common::String &filename) {
+	// Let the background saves complete first.
+	waitForPendingSaves();
+
 	// Assure the savefile name cache is up-to-date.
 	assureCached(getSavePath());
 	if (getError().getCode() != Common::kNoError)
@@ -237,6 +584,22 @@ bool DefaultSaveFileManager::exists(const Common::String &filename) {
 	return _saveFileCache.contains(filename);
 }
 
+bool DefaultSaveFileManager::getSavefileStats(const Common::String &filename, int64 &size, int64 &modificationTime) {
+	// Let the background saves complete first.
+	waitForPendingSaves();
+
+	// Assure the savefile name cache is up-to-date.
+	assureCached(getSavePath());
+	if (getError().getCode() != Common::kNoError)
+		return false;
+
+	SaveFileCache::const_iterator file = _saveFileCache.find(filename);
+	if (file == _saveFileCache.end())
+		return false;
+
+	return file->_value.getFileStats(size, modificationTime);
+}
+
 Common::String DefaultSaveFileManager::getSavePath() const {
 
 	Common::String dir;
@@ -386,6 +749,65 @@ void DefaultSaveFileManager::saveTimestamps(Common::HashMap<Common::String, uint
 	f.close();
 }
 
+Common::HashMap<Common::String, DefaultSaveFileManager::SyncedContent> DefaultSaveFileManager::loadSyncedContent() {
+	Common::HashMap<Common::String, SyncedContent> content;
+
+	Common::InSaveFile *file = g_system->getSavefileManager()->openRawFile(SYNCED_CONTENT_FILENAME);
+	if (!file)
+		return content;
+
+	//each line is "<md5> <remote timestamp> <filename>"
+	while (!file->eos() && !file->err()) {
+		Common::String line = file->readLine();
+		uint32 firstSpace = line.find(' ');
+		if (firstSpace == Common::String::npos)
+			continue;
+		uint32 secondSpace = line.find(' ', firstSpace + 1);
+		if (secondSpace == Common::String::npos)
+			continue;
+
+		Common::String md5(line.c_str(), firstSpace);
+		uint32 timestamp = Common::String(line.c_str() + firstSpace + 1, secondSpace - firstSpace - 1).asUint64();
+		Common::String filename(line.c_str() + secondSpace + 1);
+		if (md5.size() == 32 && timestamp != 0 && !filename.empty())
+			content[filename] = SyncedContent(md5, timestamp);
+	}
+
+	delete file;
+	return content;
+}
+
+void DefaultSaveFileManager::saveSyncedContent(Common::HashMap<Common::String, SyncedContent> &content) {
+	Common::DumpFile f;
+	Common::String filename = concatWithSavesPath(SYNCED_CONTENT_FILENAME);
+	if (!f.open(filename, true)) {
+		warning("DefaultSaveFileManager: failed to open '%s' file to save content hashes", filename.c_str());
+		return;
+	}
+
+	for (Common::HashMap<Common::String, SyncedContent>::iterator i = content.begin(); i != content.end(); ++i) {
+		Common::String data = Common::String::format("%s %u ", i->_value.md5.c_str(), i->_value.timestamp) + i->_key + "\n";
+		if (f.write(data.c_str(), data.size()) != data.size()) {
+			warning("DefaultSaveFileManager: failed to write content hashes into '%s'", filename.c_str());
+			return;
+		}
+	}
+
+	f.flush();
+	f.finalize();
+	f.close();
+}
+
+Common::String DefaultSaveFileManager::computeContentHash(const Common::String &filename) {
+	Common::InSaveFile *file = g_system->getSavefileManager()->openRawFile(filename);
+	if (!file)
+		return "";
+
+	Common::String md5 = Common::computeStreamMD5AsString(*file);
+	delete file;
+	return md5;
+}
+
 #endif // ifdef USE_LIBCURL
 
 Common::String DefaultSaveFileManager::concatWithSavesPath(Common::String name) {
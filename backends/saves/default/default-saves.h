@@ -29,6 +29,8 @@
 #include "common/hash-str.h"
 #include <limits.h>
 
+class AsyncSaveWriter;
+
 /**
  * Provides a default savefile manager implementation for common platforms.
  */
@@ -36,14 +38,19 @@ class DefaultSaveFileManager : public Common::SaveFileManager {
 public:
 	DefaultSaveFileManager();
 	DefaultSaveFileManager(const Common::String &defaultSavepath);
+	~DefaultSaveFileManager();
 
 	void updateSavefilesList(Common::StringArray &lockedFiles) override;
 	Common::StringArray listSavefiles(const Common::String &pattern) override;
 	Common::InSaveFile *openRawFile(const Common::String &filename) override;
 	Common::InSaveFile *openForLoading(const Common::String &filename) override;
 	Common::OutSaveFile *openForSaving(const Common::String &filename, bool compress = true) override;
+	Common::OutSaveFile *openForSavingAsync(const Common::String &filename, Common::SaveCallback *callback, bool compress = true) override;
+	void processCompletedSaves() override;
+	void waitForPendingSaves() override;
 	bool removeSavefile(const Common::String &filename) override;
 	bool exists(const Common::String &filename) override;
+	bool getSavefileStats(const Common::String &filename, int64 &size, int64 &modificationTime) override;
 
 #ifdef USE_LIBCURL
 
@@ -52,6 +59,23 @@ public:
 
 	static Common::HashMap<Common::String, uint32> loadTimestamps();
 	static void saveTimestamps(Common::HashMap<Common::String, uint32> &timestamps);
+
+	/** Content of a save file as it was when it was last synced with the cloud. */
+	struct SyncedContent {
+		Common::String md5;     ///< MD5 of the file contents
+		uint32 timestamp;       ///< Timestamp of the remote file
+
+		SyncedContent(): timestamp(INVALID_TIMESTAMP) {}
+		SyncedContent(const Common::String &m, uint32 t): md5(m), timestamp(t) {}
+	};
+
+	static const char *SYNCED_CONTENT_FILENAME;
+
+	static Common::HashMap<Common::String, SyncedContent> loadSyncedContent();
+	static void saveSyncedContent(Common::HashMap<Common::String, SyncedContent> &content);
+
+	/** Return the MD5 of the given save file, or an empty string if it can't be read. */
+	static Common::String computeContentHash(const Common::String &filename);
 #endif
 
 	static Common::String concatWithSavesPath(Common::String name);
@@ -76,6 +100,13 @@ protected:
 	 */
 	virtual Common::ErrorCode removeFile(const Common::String &filepath);
 
+	/**
+	 * Replaces the file at @p newPath by the one at @p oldPath.
+	 * This is called from the thread writing background saves, if there is
+	 * one, with the full file paths.
+	 */
+	virtual Common::ErrorCode renameFile(const Common::String &oldPath, const Common::String &newPath);
+
 	/**
 	 * Assure that the given save path is cached.
 	 *
@@ -101,10 +132,18 @@ protected:
 	Common::StringArray _lockedFiles;
 
 private:
+	friend class AsyncSaveWriter;
+
 	/**
 	 * The currently cached directory.
 	 */
 	Common::String _cachedDirectory;
+
+	/**
+	 * Writes the saves opened with openForSavingAsync(). It is created along
+	 * with the first of them.
+	 */
+	AsyncSaveWriter *_asyncSaveWriter;
 };
 
 #endif
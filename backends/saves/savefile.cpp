@@ -79,6 +79,43 @@ int64 OutSaveFile::size() const {
 	}
 }
 
+namespace {
+
+/**
+ * A save file which calls a SaveCallback with its result once it has been
+ * finalized.
+ */
+class CallbackOutSaveFile : public OutSaveFile {
+public:
+	CallbackOutSaveFile(OutSaveFile *saveFile, SaveCallback *callback) : OutSaveFile(saveFile), _callback(callback) {}
+	~CallbackOutSaveFile() override { delete _callback; }
+
+	void finalize() override {
+		_wrapped->finalize();
+
+		if (_callback) {
+			(*_callback)(_wrapped->err() ? kWritingFailed : kNoError);
+			delete _callback;
+			_callback = nullptr;
+		}
+	}
+
+private:
+	SaveCallback *_callback;
+};
+
+} // End of anonymous namespace
+
+OutSaveFile *SaveFileManager::openForSavingAsync(const String &name, SaveCallback *callback, bool compress) {
+	OutSaveFile *saveFile = openForSaving(name, compress);
+	if (!saveFile) {
+		delete callback;
+		return nullptr;
+	}
+
+	return new CallbackOutSaveFile(saveFile, callback);
+}
+
 bool SaveFileManager::copySavefile(const String &oldFilename, const String &newFilename, bool compress) {
 	InSaveFile *inFile = nullptr;
 	OutSaveFile *outFile = nullptr;
@@ -0,0 +1,102 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(SDL_BACKEND)
+
+#include "backends/threads/sdl/sdl-threads.h"
+#include "backends/platform/sdl/sdl-sys.h"
+
+#include "common/textconsole.h"
+
+/**
+ * SDL thread implementation
+ */
+class SdlThreadInternal final : public Common::ThreadInternal {
+public:
+	SdlThreadInternal(Common::ThreadProc proc, void *data) : _proc(proc), _data(data), _thread(nullptr) {}
+	~SdlThreadInternal() override { join(); }
+
+	bool start() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+		_thread = SDL_CreateThread(threadFunc, "ScummVM worker", this);
+#else
+		_thread = SDL_CreateThread(threadFunc, this);
+#endif
+		return _thread != nullptr;
+	}
+
+	void join() override {
+		if (_thread) {
+			SDL_WaitThread(_thread, nullptr);
+			_thread = nullptr;
+		}
+	}
+
+private:
+	static int SDLCALL threadFunc(void *arg) {
+		SdlThreadInternal *thread = (SdlThreadInternal *)arg;
+		thread->_proc(thread->_data);
+		return 0;
+	}
+
+	Common::ThreadProc _proc;
+	void *_data;
+	SDL_Thread *_thread;
+};
+
+/**
+ * SDL semaphore implementation
+ */
+class SdlSemaphoreInternal final : public Common::SemaphoreInternal {
+public:
+	SdlSemaphoreInternal(SDL_sem *semaphore) : _semaphore(semaphore) {}
+	~SdlSemaphoreInternal() override { SDL_DestroySemaphore(_semaphore); }
+
+	void wait() override { SDL_SemWait(_semaphore); }
+	bool tryWait() override { return SDL_SemTryWait(_semaphore) == 0; }
+	void post() override { SDL_SemPost(_semaphore); }
+
+private:
+	SDL_sem *_semaphore;
+};
+
+Common::ThreadInternal *createSdlThreadInternal(Common::ThreadProc proc, void *data) {
+	SdlThreadInternal *thread = new SdlThreadInternal(proc, data);
+	if (!thread->start()) {
+		warning("SDL_CreateThread() failed: %s", SDL_GetError());
+		delete thread;
+		return nullptr;
+	}
+	return thread;
+}
+
+Common::SemaphoreInternal *createSdlSemaphoreInternal(uint initialCount) {
+	SDL_sem *semaphore = SDL_CreateSemaphore(initialCount);
+	if (!semaphore) {
+		warning("SDL_CreateSemaphore() failed: %s", SDL_GetError());
+		return nullptr;
+	}
+	return new SdlSemaphoreInternal(semaphore);
+}
+
+#endif
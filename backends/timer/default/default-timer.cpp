@@ -19,101 +19,158 @@
  *
  */
 
+
 #include "common/scummsys.h"
 #include "backends/timer/default/default-timer.h"
+#include "common/debug.h"
 #include "common/util.h"
 #include "common/system.h"
 
+enum {
+	/** Number of buckets of the lateness histograms */
+	kLatenessBuckets = 7,
+	/**
+	 * Timers running late by more than this many microseconds skip the
+	 * calls they missed, instead of catching up with a burst of calls.
+	 */
+	kMaxCatchUp = 100000
+};
+
+/** Upper bounds of the lateness histogram buckets, in microseconds. The last bucket has none. */
+static const uint32 latenessBucketLimits[kLatenessBuckets - 1] = { 1000, 2000, 5000, 10000, 20000, 50000 };
+
 struct TimerSlot {
 	Common::TimerManager::TimerProc callback;
 	void *refCon;
 	Common::String id;
 	uint32 interval;	// in microseconds
 
-	uint32 nextFireTime;	// in milliseconds
-	uint32 nextFireTimeMicro;	// microseconds part of nextFire
+	uint64 nextFireTime;	// in microseconds, see DefaultTimerManager::getMicros()
+	uint32 order;	// keeps the slots due at the same time in scheduling order
 
-	TimerSlot *next;
+	// Diagnostics
+	uint32 lateness[kLatenessBuckets];	// number of calls by how late they were
+	uint32 skipped;	// number of calls skipped because the timer was too late
 
-	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), nextFireTimeMicro(0), next(nullptr) {}
+	TimerSlot() : callback(nullptr), refCon(nullptr), interval(0), nextFireTime(0), order(0), skipped(0) {
+		memset(lateness, 0, sizeof(lateness));
+	}
+
+	bool firesBefore(const TimerSlot &other) const {
+		if (nextFireTime != other.nextFireTime)
+			return nextFireTime < other.nextFireTime;
+		// The order wraps around, but never between slots due at the same time
+		return (int32)(order - other.order) < 0;
+	}
 };
 
-void insertPrioQueue(TimerSlot *head, TimerSlot *newSlot) {
-	// The head points to a fake anchor TimerSlot; this common
-	// trick allows us to get rid of many special cases.
-
-	const uint32 nextFireTime = newSlot->nextFireTime;
-	TimerSlot *slot = head;
-	newSlot->next = nullptr;
-
-	// Insert the new slot into the sorted list of already scheduled
-	// timers in such a way that the list stays sorted...
-	while (true) {
-		assert(slot);
-		if (slot->next == nullptr || nextFireTime < slot->next->nextFireTime) {
-			newSlot->next = slot->next;
-			slot->next = newSlot;
-			return;
-		}
-		slot = slot->next;
+DefaultTimerManager::DefaultTimerManager() :
+	_nextSlotOrder(0),
+	_timerCallbackNext(0) {
+}
+
+DefaultTimerManager::~DefaultTimerManager() {
+	Common::StackLock lock(_mutex);
+
+	for (uint i = 0; i < _slots.size(); i++) {
+		dumpStatistics(_slots[i]);
+		delete _slots[i];
 	}
+	_slots.clear();
 }
 
+uint64 DefaultTimerManager::getMicros() {
+	return (uint64)g_system->getMillis(true) * 1000;
+}
 
-DefaultTimerManager::DefaultTimerManager() :
-	_timerCallbackNext(0),
-	_head(nullptr) {
+void DefaultTimerManager::siftUp(uint index) {
+	TimerSlot *slot = _slots[index];
+	while (index > 0) {
+		const uint parent = (index - 1) / 2;
+		if (!slot->firesBefore(*_slots[parent]))
+			break;
+		_slots[index] = _slots[parent];
+		index = parent;
+	}
+	_slots[index] = slot;
+}
 
-	_head = new TimerSlot();
+void DefaultTimerManager::siftDown(uint index) {
+	TimerSlot *slot = _slots[index];
+	const uint size = _slots.size();
+	for (;;) {
+		uint child = 2 * index + 1;
+		if (child >= size)
+			break;
+		if (child + 1 < size && _slots[child + 1]->firesBefore(*_slots[child]))
+			child++;
+		if (!_slots[child]->firesBefore(*slot))
+			break;
+		_slots[index] = _slots[child];
+		index = child;
+	}
+	_slots[index] = slot;
 }
 
-DefaultTimerManager::~DefaultTimerManager() {
-	Common::StackLock lock(_mutex);
+void DefaultTimerManager::dumpStatistics(const TimerSlot *slot) const {
+	if (gDebugLevel < 2)
+		return;
 
-	TimerSlot *slot = _head;
-	while (slot) {
-		TimerSlot *next = slot->next;
-		delete slot;
-		slot = next;
+	Common::String histogram;
+	for (uint i = 0; i < kLatenessBuckets; i++) {
+		if (i < kLatenessBuckets - 1)
+			histogram += Common::String::format(" <%ums: %u", latenessBucketLimits[i] / 1000, slot->lateness[i]);
+		else
+			histogram += Common::String::format(" more: %u", slot->lateness[i]);
 	}
-	_head = nullptr;
+	debug(2, "Timer '%s' (%u us) lateness:%s, skipped: %u", slot->id.c_str(), slot->interval, histogram.c_str(), slot->skipped);
 }
 
 void DefaultTimerManager::handler() {
 	Common::StackLock lock(_mutex);
 
-	uint32 curTime = g_system->getMillis(true);
-
-	// On slow systems this could still be run after destructor
-	if (!_head)
-		return;
+	const uint64 curTime = getMicros();
 
 	// Repeat as long as there is a TimerSlot that is scheduled to fire.
-	TimerSlot *slot = _head->next;
-	while (slot && slot->nextFireTime < curTime) {
-		// Remove the slot from the priority queue
-		_head->next = slot->next;
-
-		// Update the fire time and reinsert the TimerSlot into the priority
-		// queue.
+	while (!_slots.empty() && _slots[0]->nextFireTime <= curTime) {
+		TimerSlot *slot = _slots[0];
+
+		const uint64 lateness = curTime - slot->nextFireTime;
+		uint bucket = 0;
+		while (bucket < kLatenessBuckets - 1 && lateness >= latenessBucketLimits[bucket])
+			bucket++;
+		slot->lateness[bucket]++;
+
+		// Schedule the next call from the deadline of this one, so that
+		// the timer does not drift. If it fell too far behind, give up on
+		// the missed calls instead.
 		assert(slot->interval > 0);
-		slot->nextFireTime += (slot->interval / 1000);
-		slot->nextFireTimeMicro += (slot->interval % 1000);
-		if (slot->nextFireTimeMicro > 1000) {
-			slot->nextFireTime += slot->nextFireTimeMicro / 1000;
-			slot->nextFireTimeMicro %= 1000;
+		slot->nextFireTime += slot->interval;
+		if (lateness > kMaxCatchUp) {
+			slot->skipped += lateness / slot->interval;
+			slot->nextFireTime = curTime + slot->interval;
 		}
-		insertPrioQueue(_head, slot);
+		slot->order = _nextSlotOrder++;
+		siftDown(0);
 
-		// Invoke the timer callback
+		// Invoke the timer callback. It may remove the slot.
 		assert(slot->callback);
 		slot->callback(slot->refCon);
-
-		// Look at the next scheduled timer
-		slot = _head->next;
 	}
 }
 
+uint32 DefaultTimerManager::getNextFireDelay() {
+	Common::StackLock lock(_mutex);
+
+	if (_slots.empty())
+		return 0xFFFFFFFF;
+
+	const uint64 curTime = getMicros();
+	if (_slots[0]->nextFireTime <= curTime)
+		return 0;
+	return (uint32)MIN<uint64>(_slots[0]->nextFireTime - curTime, 0xFFFFFFFF);
+}
+
 void DefaultTimerManager::checkTimers(uint32 interval) {
 	uint32 curTime = g_system->getMillis();
 
@@ -147,11 +204,11 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 	slot->refCon = refCon;
 	slot->id = id;
 	slot->interval = interval;
-	slot->nextFireTime = g_system->getMillis() + interval / 1000;
-	slot->nextFireTimeMicro = interval % 1000;
-	slot->next = nullptr;
+	slot->nextFireTime = getMicros() + interval;
+	slot->order = _nextSlotOrder++;
 
-	insertPrioQueue(_head, slot);
+	_slots.push_back(slot);
+	siftUp(_slots.size() - 1);
 
 	return true;
 }
@@ -159,15 +216,20 @@ bool DefaultTimerManager::installTimerProc(TimerProc callback, int32 interval, v
 void DefaultTimerManager::removeTimerProc(TimerProc callback) {
 	Common::StackLock lock(_mutex);
 
-	TimerSlot *slot = _head;
-
-	while (slot->next) {
-		if (slot->next->callback == callback) {
-			TimerSlot *next = slot->next->next;
-			delete slot->next;
-			slot->next = next;
-		} else {
-			slot = slot->next;
+	// A callback is never installed twice, so there is at most one slot to remove
+	for (uint i = 0; i < _slots.size(); i++) {
+		if (_slots[i]->callback == callback) {
+			dumpStatistics(_slots[i]);
+			delete _slots[i];
+
+			// Move the last slot into the hole, and restore the heap order
+			_slots[i] = _slots.back();
+			_slots.pop_back();
+			if (i < _slots.size()) {
+				siftDown(i);
+				siftUp(i);
+			}
+			break;
 		}
 	}
 
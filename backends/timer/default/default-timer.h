@@ -19,9 +19,11 @@
  *
  */
 
+
 #ifndef BACKENDS_TIMER_DEFAULT_H
 #define BACKENDS_TIMER_DEFAULT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/hash-str.h"
 #include "common/timer.h"
@@ -34,11 +36,26 @@ private:
 	typedef Common::HashMap<Common::String, TimerProc, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> TimerSlotMap;
 
 	Common::Mutex _mutex;
-	TimerSlot *_head;
+	// Min-heap of the slots, ordered by their next fire time
+	Common::Array<TimerSlot *> _slots;
+	uint32 _nextSlotOrder;
 	TimerSlotMap _callbacks;
 
 	uint32 _timerCallbackNext;
 
+	void siftUp(uint index);
+	void siftDown(uint index);
+	void dumpStatistics(const TimerSlot *slot) const;
+
+protected:
+	/**
+	 * Return a monotonic time in microseconds, used for scheduling the timers.
+	 *
+	 * The default implementation is based on OSystem::getMillis(), backends
+	 * with a more precise clock should override it.
+	 */
+	virtual uint64 getMicros();
+
 public:
 	DefaultTimerManager();
 	virtual ~DefaultTimerManager();
@@ -50,6 +67,12 @@ public:
 	 */
 	void handler();
 
+	/**
+	 * Return the number of microseconds until the next timer is due, or 0 if
+	 * it is due already. Backends can use it to invoke handler() right on time.
+	 */
+	uint32 getNextFireDelay();
+
 	/*
 	 * Ensure that the callback is called at regular time intervals.
 	 * Should be called from pollEvents() on backends without threads.
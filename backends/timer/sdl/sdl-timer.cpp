@@ -27,10 +27,15 @@
 #include "backends/timer/sdl/sdl-timer.h"
 
 #include "common/textconsole.h"
+#include "common/util.h"
 
 static Uint32 timer_handler(Uint32 interval, void *param) {
-	((DefaultTimerManager *)param)->handler();
-	return interval;
+	DefaultTimerManager *manager = (DefaultTimerManager *)param;
+	manager->handler();
+
+	// Wake up again when the next timer is due, instead of polling every
+	// 10 ms, but still check regularly for timers installed in between
+	return CLIP<uint32>(manager->getNextFireDelay() / 1000, 1, 10);
 }
 
 SdlTimerManager::SdlTimerManager() {
@@ -50,4 +55,15 @@ SdlTimerManager::~SdlTimerManager() {
 	SDL_QuitSubSystem(SDL_INIT_TIMER);
 }
 
+uint64 SdlTimerManager::getMicros() {
+#if SDL_VERSION_ATLEAST(2, 0, 0)
+	const Uint64 counter = SDL_GetPerformanceCounter();
+	const Uint64 frequency = SDL_GetPerformanceFrequency();
+	// Split the conversion so that it does not overflow
+	return counter / frequency * 1000000 + counter % frequency * 1000000 / frequency;
+#else
+	return DefaultTimerManager::getMicros();
+#endif
+}
+
 #endif
@@ -37,6 +37,8 @@ public:
 
 protected:
 	SDL_TimerID _timerID;
+
+	virtual uint64 getMicros();
 };
 
 
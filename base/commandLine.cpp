@@ -32,7 +32,9 @@
 #include "base/plugins.h"
 #include "base/version.h"
 
+#include "common/algorithm.h"
 #include "common/config-manager.h"
+#include "common/debug.h"
 #include "common/fs.h"
 #include "common/md5.h"
 #include "common/rendermode.h"
@@ -47,6 +49,12 @@
 
 #include "graphics/renderer.h"
 
+#include "video/avi_decoder.h"
+#include "video/bink_decoder.h"
+#include "video/qt_decoder.h"
+#include "video/smk_decoder.h"
+#include "video/theora_decoder.h"
+
 #define DETECTOR_TESTING_HACK
 #define UPGRADE_ALL_TARGETS_HACK
 
@@ -93,6 +101,7 @@ static const char HELP_STRING[] =
 	"  --auto-detect            Display a list of games from current or specified directory\n"
 	"                           and start the first one. Use --path=PATH to specify a directory.\n"
 	"  --recursive              In combination with --add or --detect recurse down all subdirectories\n"
+	"  --detect-profile         In combination with --detect display the time spent by each engine\n"
 #if defined(WIN32) && !defined(__SYMBIAN32__)
 	"  --console                Enable the console window (default:enabled)\n"
 #endif
@@ -156,6 +165,8 @@ static const char HELP_STRING[] =
 	"                           (if file already exists, it will be overwritten)\n"
 	"  --enable-gs              Enable Roland GS mode for MIDI playback\n"
 	"  --output-rate=RATE       Select output sample rate in Hz (e.g. 22050)\n"
+	"  --resampler-quality=MODE Select sample rate conversion quality (fast, linear,\n"
+	"                           polyphase)\n"
 	"  --opl-driver=DRIVER      Select AdLib (OPL) emulator (db, mame"
 #ifndef DISABLE_NUKED_OPL
 																	 ", nuked"
@@ -184,6 +195,8 @@ static const char HELP_STRING[] =
 	"                           playback by Event Recorder\n"
 	"  --screenshot-period=NUM  When recording, trigger a screenshot every NUM milliseconds\n"
 	"                           (default: 60000)\n"
+	"  --fast-playback          Play the recording back as fast as possible, without\n"
+	"                           showing the frames, and report the time spent per frame\n"
 	"  --list-records           Display a list of recordings for the target specified\n"
 #endif
 	"\n"
@@ -221,6 +234,10 @@ static const char HELP_STRING[] =
     "  --md5-engine=ENGINE_ID   Used with --md5 to specify the engine for which number of bytes\n"
     "                           to be hashed must be calculated. This option overrides --md5-length\n"
     "                           if used along with it. Use --list-engines to find all engineIds\n"
+	"  --benchmark-video        Decodes the video file given by --benchmark-video-path=PATH\n"
+	"                           as fast as possible and shows the decoding speed\n"
+	"  --benchmark-video-path=PATH\n"
+	"                           Used with --benchmark-video to specify path of the video file\n"
 	"\n"
 	"The meaning of boolean long options can be inverted by prefixing them with\n"
 	"\"no-\", e.g. \"--no-aspect-ratio\".\n"
@@ -273,6 +290,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("show_fps", false);
 	ConfMan.registerDefault("dirtyrects", true);
 	ConfMan.registerDefault("vsync", true);
+	ConfMan.registerDefault("worker_threads", 0);
 
 	// Sound & Music
 	ConfMan.registerDefault("music_volume", 192);
@@ -289,6 +307,10 @@ void registerDefaults() {
 	ConfMan.registerDefault("dump_midi", false);
 	ConfMan.registerDefault("enable_gs", false);
 	ConfMan.registerDefault("midi_gain", 100);
+	ConfMan.registerDefault("resampler_quality", "fast");
+	ConfMan.registerDefault("audio_mix_headroom", false);
+	ConfMan.registerDefault("audio_prefetch", false);
+	ConfMan.registerDefault("audio_preresample", false);
 
 	ConfMan.registerDefault("music_driver", "auto");
 	ConfMan.registerDefault("mt32_device", "null");
@@ -299,6 +321,8 @@ void registerDefaults() {
 
 	ConfMan.registerDefault("enable_unsupported_game_warning", true);
 
+	ConfMan.registerDefault("memory_budget", 0);
+
 	// Game specific
 	ConfMan.registerDefault("path", "");
 	ConfMan.registerDefault("platform", Common::kPlatformDOS);
@@ -334,6 +358,7 @@ void registerDefaults() {
 	ConfMan.registerDefault("disable_display", false);
 	ConfMan.registerDefault("record_mode", "none");
 	ConfMan.registerDefault("record_file_name", "record.bin");
+	ConfMan.registerDefault("fast_playback", false);
 
 	ConfMan.registerDefault("gui_saveload_chooser", "grid");
 	ConfMan.registerDefault("gui_saveload_last_pos", "0");
@@ -347,6 +372,10 @@ void registerDefaults() {
 	// number, then skip scanning. -1 = scan always
 	ConfMan.registerDefault("gui_list_max_scan_entries", -1);
 	ConfMan.registerDefault("game", "");
+	ConfMan.registerDefault("dir_listing_cache", false);
+#ifdef USE_TRANSLATION
+	ConfMan.registerDefault("translations_mapped", false);
+#endif
 
 #ifdef USE_FLUIDSYNTH
 	// The settings are deliberately stored the same way as in Qsynth. The
@@ -366,6 +395,9 @@ void registerDefaults() {
 	ConfMan.registerDefault("fluidsynth_reverb_level", 90);
 
 	ConfMan.registerDefault("fluidsynth_misc_interpolation", "4th");
+	ConfMan.registerDefault("fluidsynth_misc_polyphony", 256);
+	ConfMan.registerDefault("fluidsynth_misc_cpu_cores", 1);
+	ConfMan.registerDefault("fluidsynth_misc_render_ahead", 0);
 #endif
 #ifdef USE_DISCORD
 	ConfMan.registerDefault("discord_rpc", true);
@@ -598,6 +630,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_COMMAND("md5")
 			END_COMMAND
 
+			DO_LONG_COMMAND("benchmark-video")
+			END_COMMAND
+
 #ifdef DETECTOR_TESTING_HACK
 			// HACK FIXME TODO: This command is intentionally *not* documented!
 			DO_LONG_COMMAND("test-detector")
@@ -651,6 +686,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_INT("output-rate")
 			END_OPTION
 
+			DO_LONG_OPTION("resampler-quality")
+			END_OPTION
+
 			DO_OPTION_BOOL('f', "fullscreen")
 			END_OPTION
 
@@ -691,6 +729,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 
 			DO_LONG_OPTION_INT("screenshot-period")
 			END_OPTION
+
+			DO_LONG_OPTION_BOOL("fast-playback")
+			END_OPTION
 #endif
 
 			DO_LONG_OPTION("opl-driver")
@@ -840,6 +881,17 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION("md5-engine")
 			END_OPTION
 
+			DO_LONG_OPTION("benchmark-video-path")
+				Common::FSNode path(option);
+				if (!path.exists()) {
+					usage("Non-existent file path '%s'", option);
+				} else if (path.isDirectory()) {
+					usage("'%s' is a directory, not a file path!", option);
+				} else if (!path.isReadable()) {
+					usage("Non-readable file path '%s'", option);
+				}
+			END_OPTION
+
 			DO_LONG_OPTION_INT("talkspeed")
 			END_OPTION
 
@@ -858,6 +910,9 @@ Common::String parseCommandLine(Common::StringMap &settings, int argc, const cha
 			DO_LONG_OPTION_BOOL("recursive")
 			END_OPTION
 
+			DO_LONG_OPTION_BOOL("detect-profile")
+			END_OPTION
+
 			DO_LONG_OPTION("themepath")
 				Common::FSNode path(option);
 				if (!path.exists()) {
@@ -1303,12 +1358,55 @@ static DetectedGames recListGames(const Common::FSNode &dir, const Common::Strin
 	return list;
 }
 
+struct DetectionTime {
+	Common::String engineId;
+	uint32 time;
+};
+
+struct DetectionTimeGreater {
+	bool operator()(const DetectionTime &x, const DetectionTime &y) const {
+		if (x.time != y.time)
+			return x.time > y.time;
+		return x.engineId < y.engineId;
+	}
+};
+
+/** Display the time each engine spent in detection, slowest first */
+static void printDetectionProfile() {
+	const EngineManager::DetectionProfile &profile = EngineMan.getDetectionProfile();
+
+	Common::Array<DetectionTime> entries;
+	uint32 total = 0;
+	for (EngineManager::DetectionProfile::const_iterator i = profile.begin(); i != profile.end(); ++i) {
+		DetectionTime entry;
+		entry.engineId = i->_key;
+		entry.time = i->_value;
+		entries.push_back(entry);
+		total += i->_value;
+	}
+	Common::sort(entries.begin(), entries.end(), DetectionTimeGreater());
+
+	printf("Engine               Detection time\n");
+	printf("-------------------- --------------\n");
+	for (uint i = 0; i < entries.size() && entries[i].time > 0; i++)
+		printf("%-20s %11u ms\n", entries[i].engineId.c_str(), entries[i].time);
+	printf("%-20s %11u ms\n", "Total", total);
+}
+
 /** Display all games in the given directory, return ID of first detected game */
-static Common::String detectGames(const Common::String &path, const Common::String &engineId, const Common::String &gameId, bool recursive) {
+static Common::String detectGames(const Common::String &path, const Common::String &engineId, const Common::String &gameId, bool recursive, bool profile = false) {
 	bool noPath = path.empty();
 	//Current directory
 	Common::FSNode dir(path);
+	MD5Man.resetStats();
+	if (profile)
+		EngineMan.setDetectionProfiling(true);
 	DetectedGames candidates = recListGames(dir, engineId, gameId, recursive);
+	debug(1, "MD5 cache: %u hits, %u misses", MD5Man.getHits(), MD5Man.getMisses());
+	if (profile) {
+		EngineMan.setDetectionProfiling(false);
+		printDetectionProfile();
+	}
 
 	if (candidates.empty()) {
 		printf("WARNING: ScummVM could not find any game in %s\n", dir.getPath().c_str());
@@ -1396,6 +1494,58 @@ static void calcMD5(Common::FSNode &path, int32 length) {
 	}
 }
 
+static Video::VideoDecoder *createBenchmarkDecoder(const Common::String &filename) {
+	Common::String name(filename);
+	name.toLowercase();
+
+#ifdef USE_BINK
+	if (name.hasSuffix(".bik"))
+		return new Video::BinkDecoder();
+#endif
+#ifdef USE_THEORADEC
+	if (name.hasSuffix(".ogv") || name.hasSuffix(".ogg"))
+		return new Video::TheoraDecoder();
+#endif
+	if (name.hasSuffix(".smk"))
+		return new Video::SmackerDecoder();
+	if (name.hasSuffix(".avi"))
+		return new Video::AVIDecoder();
+	if (name.hasSuffix(".mov"))
+		return new Video::QuickTimeDecoder();
+
+	return nullptr;
+}
+
+static void benchmarkVideo(Common::FSNode &path) {
+	// The decoders need the screen format and the timer
+	g_system->initBackend();
+
+	Video::VideoDecoder *decoder = createBenchmarkDecoder(path.getName());
+	if (!decoder) {
+		printf("Unsupported video format: %s\n", path.getName().c_str());
+		return;
+	}
+
+	if (!decoder->loadStream(path.createReadStream())) {
+		printf("Could not load video: %s\n", path.getName().c_str());
+		delete decoder;
+		return;
+	}
+
+	printf("Decoding %s (%dx%d, %d frames)\n", path.getName().c_str(),
+	       decoder->getWidth(), decoder->getHeight(), decoder->getFrameCount());
+
+	// The video is never started, so no time is spent on its audio tracks
+	uint32 frames = 0;
+	const uint32 startTime = g_system->getMillis();
+	while (!decoder->endOfVideo() && decoder->decodeNextFrame())
+		frames++;
+	const uint32 elapsed = MAX<uint32>(g_system->getMillis() - startTime, 1);
+
+	printf("Decoded %u frames in %u ms (%.2f fps)\n", frames, elapsed, frames * 1000.0 / elapsed);
+	delete decoder;
+}
+
 static bool addGames(const Common::String &path, const Common::String &engineId, const Common::String &gameId, bool recursive) {
 	//Current directory
 	Common::FSNode dir(path);
@@ -1687,7 +1837,7 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 			}
 		}
 	} else if (command == "detect") {
-		detectGames(settings["path"], gameOption.engineId, gameOption.gameId, settings["recursive"] == "true");
+		detectGames(settings["path"], gameOption.engineId, gameOption.gameId, settings["recursive"] == "true", settings["detect-profile"] == "true");
 		return true;
 	} else if (command == "add") {
 		addGames(settings["path"], gameOption.engineId, gameOption.gameId, settings["recursive"] == "true");
@@ -1724,6 +1874,16 @@ bool processSettings(Common::String &command, Common::StringMap &settings, Commo
 
 		calcMD5(path, md5Length);
 
+		return true;
+	} else if (command == "benchmark-video") {
+		if (!settings.contains("benchmark-video-path")) {
+			printf("Usage : --benchmark-video --benchmark-video-path=<PATH>\n");
+			return true;
+		}
+
+		Common::FSNode path(Common::Path(settings["benchmark-video-path"], '/'));
+		benchmarkVideo(path);
+
 		return true;
 #ifdef DETECTOR_TESTING_HACK
 	} else if (command == "test-detector") {
@@ -38,9 +38,11 @@
 
 #include "common/archive.h"
 #include "common/config-manager.h"
+#include "common/cpu.h"
 #include "common/debug.h"
 #include "common/debug-channels.h" /* for debug manager */
 #include "common/events.h"
+#include "common/memtracker.h"
 #include "gui/EventRecorder.h"
 #include "common/fs.h"
 #ifdef ENABLE_EVENTRECORDER
@@ -51,6 +53,7 @@
 #include "common/tokenizer.h"
 #include "common/translation.h"
 #include "common/text-to-speech.h"
+#include "common/threadpool.h"
 #include "common/osd_message_queue.h"
 
 #include "gui/gui-manager.h"
@@ -314,6 +317,9 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	system.getEventManager()->purgeKeyboardEvents();
 	system.getEventManager()->purgeMouseEvents();
 
+	// Limit the memory held by the caches of the engine and the GUI
+	MemTracker.setBudget((size_t)MAX(ConfMan.getInt("memory_budget"), 0) * 1024 * 1024);
+
 	// Run the engine
 	Common::Error result = engine->run();
 
@@ -335,6 +341,9 @@ static Common::Error runGame(const Plugin *plugin, const Plugin *enginePlugin, O
 	// Reset the file/directory mappings
 	SearchMan.clear();
 
+	// Store the listings of the game directories for the next launch
+	Common::FSListingCache::instance().flush();
+
 #ifdef USE_TRANSLATION
 	TransMan.setLanguage(previousLanguage);
 	Common::TextToSpeechManager *ttsMan;
@@ -503,6 +512,9 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	}
 #endif
 
+	// Select the optimized code paths before the backend starts any thread
+	Common::detectCpuFeatures();
+
 	// Init the backend. Must take place after all config data (including
 	// the command line params) was read.
 	system.initBackend();
@@ -622,6 +634,9 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 			if (ttsMan != nullptr) {
 				ttsMan->pushState();
 			}
+			// The worker threads are started again with the settings of the game
+			Common::SharedThreadPool::destroy();
+
 			// Try to run the game
 			Common::Error result = runGame(plugin, enginePlugin, system, specialDebug);
 			if (ttsMan != nullptr) {
@@ -720,6 +735,8 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 	PluginManager::instance().unloadAllPlugins();
 	PluginManager::destroy();
 	GUI::GuiManager::destroy();
+	Common::FSListingCache::instance().flush();
+	Common::FSListingCache::destroy();
 	Common::ConfigManager::destroy();
 	Common::DebugManager::destroy();
 	Common::OSDMessageQueue::destroy();
@@ -738,6 +755,7 @@ extern "C" int scummvm_main(int argc, const char * const argv[]) {
 #endif
 	EngineManager::destroy();
 	Graphics::YUVToRGBManager::destroy();
+	Common::SharedThreadPool::destroy();
 
 	return 0;
 }
@@ -25,12 +25,16 @@
 #include "common/debug.h"
 #include "common/debug-channels.h"
 #include "common/config-manager.h"
+#include "common/endian.h"
+#include "common/stream.h"
+#include "common/system.h"
 
 #ifdef DYNAMIC_MODULES
 #include "common/fs.h"
 #endif
 
 #include "base/detection/detection.h"
+#include "base/version.h"
 
 #include "engines/advancedDetector.h"
 
@@ -336,6 +340,152 @@ const Plugin *PluginManager::getMetaEngineFromEngine(const Plugin *plugin) {
 	return nullptr;
 }
 
+#define PLUGINMANIFEST_FILENAME "scummvm-plugins.dat"
+#define PLUGINMANIFEST_VERSION 1
+
+static bool readManifestString(Common::SeekableReadStream &stream, Common::String &str) {
+	uint32 len = stream.readUint32LE();
+	if (stream.err() || len > (uint32)(stream.size() - stream.pos()))
+		return false;
+
+	char *buf = new char[len];
+	stream.read(buf, len);
+	str = Common::String(buf, len);
+	delete[] buf;
+	return !stream.err();
+}
+
+static void writeManifestString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint32LE(str.size());
+	stream.write(str.c_str(), str.size());
+}
+
+Common::FSNode PluginManagerUncached::getManifestFile() const {
+	// The manifest is stored next to the configuration file
+	Common::String configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return Common::FSNode();
+
+	Common::FSNode configNode(configFile);
+	Common::FSNode dir = configNode.getParent();
+	if (dir.getPath() == configNode.getPath() || !dir.isDirectory()) {
+		// Relative configuration file name, use the current directory
+		return Common::FSNode(PLUGINMANIFEST_FILENAME);
+	}
+
+	return dir.getChild(PLUGINMANIFEST_FILENAME);
+}
+
+void PluginManagerUncached::loadManifest() {
+	_manifest.clear();
+	_manifestDirty = false;
+
+	Common::FSNode file = getManifestFile();
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	// Plugins are only compatible with the ScummVM version they were built
+	// for, so the manifest is dropped along with it
+	Common::String version;
+	if (stream->readUint32BE() != MKTAG('S', 'P', 'L', 'G') || stream->readUint32LE() != PLUGINMANIFEST_VERSION ||
+	    !readManifestString(*stream, version) || version != gScummVMFullVersion) {
+		debug(9, "Ignoring plugin manifest '%s' from another version", file.getPath().c_str());
+		delete stream;
+		return;
+	}
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		Common::String filename;
+		ManifestEntry entry;
+
+		if (!readManifestString(*stream, filename))
+			break;
+		entry.fileSize = stream->readSint64LE();
+		entry.modificationTime = stream->readSint64LE();
+		if (!readManifestString(*stream, entry.engineId))
+			break;
+
+		_manifest.setVal(filename, entry);
+	}
+
+	debug(9, "Loaded %u entries from plugin manifest '%s'", _manifest.size(), file.getPath().c_str());
+	delete stream;
+}
+
+void PluginManagerUncached::flushManifest() {
+	if (!_manifestDirty)
+		return;
+
+	Common::FSNode file = getManifestFile();
+	Common::WriteStream *stream = file.createWriteStream();
+	if (!stream) {
+		debug(9, "Could not write plugin manifest '%s'", PLUGINMANIFEST_FILENAME);
+		return;
+	}
+
+	stream->writeUint32BE(MKTAG('S', 'P', 'L', 'G'));
+	stream->writeUint32LE(PLUGINMANIFEST_VERSION);
+	writeManifestString(*stream, gScummVMFullVersion);
+	stream->writeUint32LE(_manifest.size());
+	for (ManifestMap::const_iterator i = _manifest.begin(); i != _manifest.end(); ++i) {
+		writeManifestString(*stream, i->_key);
+		stream->writeSint64LE(i->_value.fileSize);
+		stream->writeSint64LE(i->_value.modificationTime);
+		writeManifestString(*stream, i->_value.engineId);
+	}
+
+	stream->finalize();
+	if (!stream->err())
+		_manifestDirty = false;
+	delete stream;
+}
+
+void PluginManagerUncached::addToManifest() {
+	const char *filename = (*_currentPlugin)->getFileName();
+	if (!filename || (*_currentPlugin)->getType() != PLUGIN_TYPE_ENGINE)
+		return;
+
+	ManifestEntry entry;
+	if (!Common::FSNode(filename).getFileStats(entry.fileSize, entry.modificationTime))
+		return;
+
+	entry.engineId = (*_currentPlugin)->get<MetaEngine>().getName();
+
+	ManifestMap::const_iterator i = _manifest.find(filename);
+	if (i != _manifest.end() && i->_value.fileSize == entry.fileSize &&
+	    i->_value.modificationTime == entry.modificationTime && i->_value.engineId == entry.engineId)
+		return;
+
+	_manifest.setVal(filename, entry);
+	_manifestDirty = true;
+}
+
+Common::String PluginManagerUncached::findInManifest(const Common::String &engineId) {
+	for (ManifestMap::iterator i = _manifest.begin(); i != _manifest.end(); ++i) {
+		if (i->_value.engineId != engineId)
+			continue;
+
+		int64 fileSize, modificationTime;
+		if (Common::FSNode(i->_key).getFileStats(fileSize, modificationTime) &&
+		    fileSize == i->_value.fileSize && modificationTime == i->_value.modificationTime)
+			return i->_key;
+
+		// The plugin was replaced or removed since
+		_manifest.erase(i);
+		_manifestDirty = true;
+		break;
+	}
+
+	return Common::String();
+}
+
 /**
  * This should only be called once by main()
  **/
@@ -343,6 +493,7 @@ void PluginManagerUncached::init() {
 	unloadAllPlugins();
 	_allEnginePlugins.clear();
 	ConfMan.setBool("always_run_fallback_detection_extern", false);
+	loadManifest();
 
 	unloadPluginsExcept(PLUGIN_TYPE_ENGINE, nullptr, false); // empty the engine plugins
 
@@ -408,6 +559,11 @@ bool PluginManagerUncached::loadPluginFromEngineId(const Common::String &engineI
 			}
 		}
 	}
+	// Then for the plugin which provided the engine the last time all
+	// plugins were scanned
+	if (loadPluginByFileName(findInManifest(engineId)))
+		return true;
+
 	// Check for a plugin with the same name as the engine before starting
 	// to scan all plugins
 	Common::String tentativeEnginePluginFilename = engineId;
@@ -439,6 +595,7 @@ bool PluginManagerUncached::loadPluginByFileName(const Common::String &filename)
 		if (Common::String((*i)->getFileName()) == filename && (*i)->loadPlugin()) {
 			addToPluginsInMemList(*i);
 			_currentPlugin = i;
+			addToManifest();
 			return true;
 		}
 	}
@@ -461,6 +618,8 @@ void PluginManagerUncached::updateConfigWithFileName(const Common::String &engin
 
 		ConfMan.flushToDisk();
 	}
+
+	flushManifest();
 }
 
 #ifndef DETECTION_STATIC
@@ -514,6 +673,7 @@ void PluginManagerUncached::loadFirstPlugin() {
 	for (_currentPlugin = _allEnginePlugins.begin(); _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addToManifest();
 			break;
 		}
 	}
@@ -528,9 +688,13 @@ bool PluginManagerUncached::loadNextPlugin() {
 	for (++_currentPlugin; _currentPlugin != _allEnginePlugins.end(); ++_currentPlugin) {
 		if ((*_currentPlugin)->loadPlugin()) {
 			addToPluginsInMemList(*_currentPlugin);
+			addToManifest();
 			return true;
 		}
 	}
+
+	// All plugins were seen, so the manifest is complete
+	flushManifest();
 	return false; // no more in list
 }
 
@@ -735,7 +899,10 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist) {
 		MetaEngineDetection &metaEngine = (*iter)->get<MetaEngineDetection>();
 		// set the debug flags
 		DebugMan.addAllDebugChannels(metaEngine.getDebugChannels());
+		uint32 startTime = _profileDetection ? g_system->getMillis() : 0;
 		DetectedGames engineCandidates = metaEngine.detectGames(fslist);
+		if (_profileDetection)
+			_detectionProfile[metaEngine.getEngineId()] += g_system->getMillis() - startTime;
 
 		for (uint i = 0; i < engineCandidates.size(); i++) {
 			engineCandidates[i].path = fslist.begin()->getParent().getPath();
@@ -744,9 +911,18 @@ DetectionResults EngineManager::detectGames(const Common::FSList &fslist) {
 		}
 	}
 
+	// Keep the newly computed MD5s for the next detection run
+	MD5Man.flush();
+
 	return DetectionResults(candidates);
 }
 
+void EngineManager::setDetectionProfiling(bool enable) {
+	_profileDetection = enable;
+	if (enable)
+		_detectionProfile.clear();
+}
+
 const PluginList &EngineManager::getPlugins(const PluginType fetchPluginType) const {
 	return PluginManager::instance().getPlugins(fetchPluginType);
 }
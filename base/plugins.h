@@ -24,6 +24,8 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/str.h"
 #include "backends/plugins/elf/version.h"
 
@@ -374,9 +376,40 @@ protected:
 
 	bool _isDetectionLoaded;
 
-	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr) {}
+	/**
+	 * What the manifest remembers about an engine plugin file, so that the
+	 * plugin providing an engine is found without loading the others.
+	 */
+	struct ManifestEntry {
+		int64 fileSize;
+		int64 modificationTime;
+		Common::String engineId;
+	};
+
+	typedef Common::HashMap<Common::String, ManifestEntry> ManifestMap;
+
+	/** The manifest entries, by plugin file name. */
+	ManifestMap _manifest;
+	bool _manifestDirty;
+
+	PluginManagerUncached() : _isDetectionLoaded(false), _detectionPlugin(nullptr), _manifestDirty(false) {}
 	bool loadPluginByFileName(const Common::String &filename);
 
+	Common::FSNode getManifestFile() const;
+	void loadManifest();
+	void flushManifest();
+
+	/**
+	 * Remember which engine the currently loaded plugin provides.
+	 */
+	void addToManifest();
+
+	/**
+	 * Return the name of the plugin file which the manifest says provides
+	 * @p engineId, if that file did not change since.
+	 */
+	Common::String findInManifest(const Common::String &engineId);
+
 public:
 	void init() override;
 	void loadFirstPlugin() override;
@@ -25,6 +25,7 @@
 #include "common/scummsys.h"
 #include "common/func.h"
 #include "common/util.h"
+#include "common/type-traits.h"
 
 namespace Common {
 
@@ -70,6 +71,34 @@ Out copy_backward(In first, In last, Out dst) {
 	return dst;
 }
 
+/**
+ * Move data from the range [first, last) to [dst, dst + (last - first)).
+ *
+ * The function requires the range [dst, dst + (last - first)) to be valid.
+ * It also requires dst not to be in the range [first, last).
+ */
+template<class In, class Out>
+Out move(In first, In last, Out dst) {
+	while (first != last)
+		*dst++ = Common::move(*first++);
+	return dst;
+}
+
+/**
+ * Move data from the range [first, last) to [dst - (last - first), dst).
+ *
+ * The function requires the range [dst - (last - first), dst) to be valid.
+ * It also requires dst not to be in the range [first, last).
+ *
+ * Unlike move, move_backward moves the data from the end to the beginning.
+ */
+template<class In, class Out>
+Out move_backward(In first, In last, Out dst) {
+	while (first != last)
+		*--dst = Common::move(*--last);
+	return dst;
+}
+
 /**
  * Copy data from the range [first, last) to [dst, dst + (last - first)).
  *
@@ -92,6 +92,7 @@ void SearchSet::insert(const Node &node) {
 			break;
 	}
 	_list.insert(it, node);
+	_changeStamp = nextChangeStamp();
 }
 
 void SearchSet::add(const String &name, Archive *archive, int priority, bool autoFree) {
@@ -173,6 +174,7 @@ void SearchSet::remove(const String &name) {
 		if (it->_autoFree)
 			delete it->_arc;
 		_list.erase(it);
+		_changeStamp = nextChangeStamp();
 	}
 }
 
@@ -187,6 +189,7 @@ void SearchSet::clear() {
 	}
 
 	_list.clear();
+	_changeStamp = nextChangeStamp();
 }
 
 void SearchSet::setPriority(const String &name, int priority) {
@@ -205,16 +208,69 @@ void SearchSet::setPriority(const String &name, int priority) {
 	insert(node);
 }
 
+uint32 SearchSet::nextChangeStamp() {
+	// Shared by all sets, so that a change to any set is newer than
+	// everything an index may have been built with
+	static uint32 lastChangeStamp = 0;
+	return ++lastChangeStamp;
+}
+
+uint32 SearchSet::getChangeStamp() const {
+	uint32 changeStamp = _changeStamp;
+
+	ArchiveNodeList::const_iterator it = _list.begin();
+	for (; it != _list.end(); ++it) {
+		if (it->_set)
+			changeStamp = MAX(changeStamp, it->_set->getChangeStamp());
+	}
+
+	return changeStamp;
+}
+
+Archive *SearchSet::findIndexed(const Path &path) const {
+	StackLock lock(_indexMutex);
+
+	// Any change may give the path to an archive of higher priority
+	const uint32 changeStamp = getChangeStamp();
+	if (changeStamp != _indexChangeStamp) {
+		_index.clear();
+		_indexChangeStamp = changeStamp;
+		return nullptr;
+	}
+
+	MemberIndex::const_iterator it = _index.find(path.toString());
+	return it != _index.end() ? it->_value : nullptr;
+}
+
+void SearchSet::addToIndex(const Path &path, Archive *arc) const {
+	StackLock lock(_indexMutex);
+	_index[path.toString()] = arc;
+}
+
+void SearchSet::removeFromIndex(const Path &path) const {
+	StackLock lock(_indexMutex);
+	_index.erase(path.toString());
+}
+
 bool SearchSet::hasFile(const Path &path) const {
 	if (path.empty())
 		return false;
 
+	Archive *indexed = findIndexed(path);
+	if (indexed && indexed->hasFile(path))
+		return true;
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(path))
+		if (it->_arc->hasFile(path)) {
+			addToIndex(path, it->_arc);
 			return true;
+		}
 	}
 
+	// The file is gone from the archive which provided it before
+	if (indexed)
+		removeFromIndex(path);
 	return false;
 }
 
@@ -242,12 +298,20 @@ const ArchiveMemberPtr SearchSet::getMember(const Path &path) const {
 	if (path.empty())
 		return ArchiveMemberPtr();
 
+	Archive *indexed = findIndexed(path);
+	if (indexed && indexed->hasFile(path))
+		return indexed->getMember(path);
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
-		if (it->_arc->hasFile(path))
+		if (it->_arc->hasFile(path)) {
+			addToIndex(path, it->_arc);
 			return it->_arc->getMember(path);
+		}
 	}
 
+	if (indexed)
+		removeFromIndex(path);
 	return ArchiveMemberPtr();
 }
 
@@ -255,13 +319,24 @@ SeekableReadStream *SearchSet::createReadStreamForMember(const Path &path) const
 	if (path.empty())
 		return nullptr;
 
+	Archive *indexed = findIndexed(path);
+	if (indexed) {
+		SeekableReadStream *stream = indexed->createReadStreamForMember(path);
+		if (stream)
+			return stream;
+	}
+
 	ArchiveNodeList::const_iterator it = _list.begin();
 	for (; it != _list.end(); ++it) {
 		SeekableReadStream *stream = it->_arc->createReadStreamForMember(path);
-		if (stream)
+		if (stream) {
+			addToIndex(path, it->_arc);
 			return stream;
+		}
 	}
 
+	if (indexed)
+		removeFromIndex(path);
 	return nullptr;
 }
 
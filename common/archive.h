@@ -23,7 +23,10 @@
 #define COMMON_ARCHIVE_H
 
 #include "common/str.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
 #include "common/list.h"
+#include "common/mutex.h"
 #include "common/path.h"
 #include "common/ptr.h"
 #include "common/singleton.h"
@@ -154,8 +157,9 @@ class SearchSet : public Archive {
 		String	_name;
 		Archive	*_arc;
 		bool	_autoFree;
+		const SearchSet *_set;	//!< The archive, if it is a nested SearchSet
 		Node(int priority, const String &name, Archive *arc, bool autoFree)
-			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree) {
+			: _priority(priority), _name(name), _arc(arc), _autoFree(autoFree), _set(dynamic_cast<SearchSet *>(arc)) {
 		}
 	};
 	typedef List<Node> ArchiveNodeList;
@@ -168,8 +172,34 @@ class SearchSet : public Archive {
 
 	bool _ignoreClashes;
 
+	/** Stamp of the last time archives were added, removed or reordered. */
+	uint32 _changeStamp;
+
+	/**
+	 * Archive which provided each path found so far, keyed without regard
+	 * to case like the lookups themselves. It is filled on lookup and
+	 * dropped whenever this set or a nested set has changed since it was
+	 * built. The lookups may come from several threads, so it is guarded
+	 * by a mutex.
+	 */
+	typedef HashMap<String, Archive *, IgnoreCase_Hash, IgnoreCase_EqualTo> MemberIndex;
+	mutable MemberIndex _index;
+	mutable uint32 _indexChangeStamp;
+	mutable Mutex _indexMutex;
+
+	static uint32 nextChangeStamp();
+
+	/**
+	 * Return the stamp of the last change to this set or any nested set.
+	 */
+	uint32 getChangeStamp() const;
+
+	Archive *findIndexed(const Path &path) const;
+	void addToIndex(const Path &path, Archive *arc) const;
+	void removeFromIndex(const Path &path) const;
+
 public:
-	SearchSet() : _ignoreClashes(false) { }
+	SearchSet() : _ignoreClashes(false), _changeStamp(nextChangeStamp()), _indexChangeStamp(0) { }
 	virtual ~SearchSet() { clear(); }
 
 	/**
@@ -268,6 +298,7 @@ public:
 	 * in @ref FSDirectory documentation.
 	 */
 	void setIgnoreClashes(bool ignoreClashes) { _ignoreClashes = ignoreClashes; }
+
 };
 
 
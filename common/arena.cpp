@@ -0,0 +1,118 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/arena.h"
+#include "common/textconsole.h"
+
+namespace Common {
+
+Arena::Arena(size_t blockSize) : _blockSize(blockSize), _block(0), _data(nullptr), _size(0), _used(0), _finalizers(nullptr) {
+	assert(blockSize > 0);
+}
+
+Arena::~Arena() {
+	runFinalizers(nullptr);
+	for (uint i = 0; i < _blocks.size(); ++i)
+		free(_blocks[i].data);
+}
+
+Arena::Block Arena::allocBlock(size_t size) {
+	Block block;
+	block.data = (byte *)malloc(size);
+	block.size = size;
+	if (!block.data)
+		::error("Common::Arena: failure to allocate %u bytes", (uint)size);
+	return block;
+}
+
+void Arena::setBlock(uint block, size_t used) {
+	_block = block;
+	_used = used;
+	if (block < _blocks.size()) {
+		_data = _blocks[block].data;
+		_size = _blocks[block].size;
+	} else {
+		_data = nullptr;
+		_size = 0;
+	}
+}
+
+void *Arena::allocateFromNextBlock(size_t size) {
+	const uint next = _data ? _block + 1 : _block;
+	const size_t blockSize = MAX(_blockSize, size);
+
+	if (next == _blocks.size()) {
+		_blocks.push_back(allocBlock(blockSize));
+	} else if (_blocks[next].size < size) {
+		// The block is not in use, so it can be replaced by a larger one
+		free(_blocks[next].data);
+		_blocks[next] = allocBlock(blockSize);
+	}
+
+	setBlock(next, size);
+	return _data;
+}
+
+void Arena::runFinalizers(Finalizer *last) {
+	while (_finalizers != last) {
+		Finalizer *finalizer = _finalizers;
+		_finalizers = finalizer->next;
+		finalizer->destroy(finalizer->object);
+	}
+}
+
+void Arena::rewind(const Marker &marker) {
+	assert(marker.block < _block || (marker.block == _block && marker.used <= _used));
+
+	runFinalizers(marker.finalizers);
+	setBlock(marker.block, marker.used);
+}
+
+void Arena::reset() {
+	runFinalizers(nullptr);
+
+	if (_blocks.size() > 1) {
+		// Replace the blocks by one which can hold them all
+		const size_t size = getCapacity();
+		for (uint i = 0; i < _blocks.size(); ++i)
+			free(_blocks[i].data);
+		_blocks.clear();
+		_blocks.push_back(allocBlock(size));
+	}
+
+	setBlock(0, 0);
+}
+
+size_t Arena::getUsedSize() const {
+	size_t used = _used;
+	for (uint i = 0; i < _block && i < _blocks.size(); ++i)
+		used += _blocks[i].size;
+	return used;
+}
+
+size_t Arena::getCapacity() const {
+	size_t capacity = 0;
+	for (uint i = 0; i < _blocks.size(); ++i)
+		capacity += _blocks[i].size;
+	return capacity;
+}
+
+} // End of namespace Common
@@ -0,0 +1,231 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_ARENA_H
+#define COMMON_ARENA_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/noncopyable.h"
+#include "common/type-traits.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_arena Arenas
+ * @ingroup common
+ *
+ * @brief Bump allocator for short-lived allocations.
+ * @{
+ */
+
+/**
+ * A region of memory from which allocations are carved one after the
+ * other, and which is released all at once.
+ *
+ * Allocating from an arena only bumps a pointer, and successive allocations
+ * are adjacent in memory. Allocations cannot be freed one by one: instead,
+ * the arena is rewound to a marker obtained earlier, or reset, which
+ * releases everything allocated since. This suits data with a well-defined
+ * lifetime, such as the data built for one frame or for one room, see
+ * ArenaScope.
+ *
+ * The arena grows by blocks of memory as needed. Resetting it merges its
+ * blocks into a single one, so an arena which is reset every frame soon
+ * stops allocating from the heap.
+ */
+class Arena : NonCopyable {
+	struct Finalizer;
+
+public:
+	/** A position in the arena, to which it can be rewound. */
+	struct Marker {
+		uint block;
+		size_t used;
+		Finalizer *finalizers;
+	};
+
+	/** The alignment of all allocations. */
+	static const size_t kAlignment = 2 * sizeof(void *);
+
+	/**
+	 * Construct an empty arena. No memory is allocated until the first
+	 * allocation, which allocates a block of @p blockSize bytes or more.
+	 */
+	explicit Arena(size_t blockSize = 64 * 1024);
+	~Arena();
+
+	/**
+	 * Allocate @p size bytes, aligned to kAlignment. The memory is valid
+	 * until the arena is rewound to a marker obtained before this call.
+	 */
+	void *allocate(size_t size) {
+		size = (size + kAlignment - 1) & ~(kAlignment - 1);
+		if (_used + size > _size)
+			return allocateFromNextBlock(size);
+
+		void *ptr = _data + _used;
+		_used += size;
+		return ptr;
+	}
+
+	/**
+	 * Construct an object from the given arguments in the arena. Its
+	 * destructor is called when the arena is rewound to a marker obtained
+	 * before this call.
+	 */
+	template<class T, class... TArgs>
+	T *create(TArgs &&...args) {
+		T *object = new (allocate(sizeof(T))) T(Common::forward<TArgs>(args)...);
+
+		Finalizer *finalizer = (Finalizer *)allocate(sizeof(Finalizer));
+		finalizer->destroy = &destroyObject<T>;
+		finalizer->object = object;
+		finalizer->next = _finalizers;
+		_finalizers = finalizer;
+		return object;
+	}
+
+	/** Return the current position in the arena. */
+	Marker getMarker() const {
+		Marker marker = { _block, _used, _finalizers };
+		return marker;
+	}
+
+	/**
+	 * Release everything allocated since @p marker was obtained, calling the
+	 * destructors of the objects created in the meantime. The markers
+	 * obtained after @p marker become invalid.
+	 */
+	void rewind(const Marker &marker);
+
+	/**
+	 * Release everything allocated from the arena, calling the destructors of
+	 * the objects created from it. All markers become invalid.
+	 */
+	void reset();
+
+	/**
+	 * Return the number of bytes currently allocated from the arena, including
+	 * the unused ends of the blocks which were filled.
+	 */
+	size_t getUsedSize() const;
+
+	/** Return the number of bytes the arena holds, used or not. */
+	size_t getCapacity() const;
+
+private:
+	struct Block {
+		byte *data;
+		size_t size;
+	};
+
+	struct Finalizer {
+		void (*destroy)(void *object);
+		void *object;
+		Finalizer *next;
+	};
+
+	template<class T>
+	static void destroyObject(void *object) {
+		static_cast<T *>(object)->~T();
+	}
+
+	void *allocateFromNextBlock(size_t size);
+	void runFinalizers(Finalizer *last);
+	static Block allocBlock(size_t size);
+	void setBlock(uint block, size_t used);
+
+	const size_t _blockSize;
+	Array<Block> _blocks;
+
+	uint _block;        ///< Index of the block allocations are made from
+	byte *_data;        ///< Start of that block, nullptr if there are no blocks yet
+	size_t _size;       ///< Size of that block
+	size_t _used;       ///< Bytes used in that block
+
+	Finalizer *_finalizers; ///< Objects to destroy, the most recently created first
+};
+
+/**
+ * Rewinds an arena when it goes out of scope, releasing everything allocated
+ * from it during the lifetime of the scope.
+ *
+ * Scopes can be nested, for example a scope around the lifetime of a room
+ * with a scope around each frame drawn in it:
+ * @code
+ * Common::ArenaScope roomScope(arena);
+ * loadRoom(arena);
+ * while (inRoom) {
+ *     Common::ArenaScope frameScope(arena);
+ *     drawFrame(arena);
+ * }
+ * @endcode
+ */
+class ArenaScope : NonCopyable {
+public:
+	explicit ArenaScope(Arena &arena) : _arena(arena), _marker(arena.getMarker()) {}
+	~ArenaScope() { _arena.rewind(_marker); }
+
+	/** Release what was allocated in the scope so far, without leaving it. */
+	void reset() { _arena.rewind(_marker); }
+
+	Arena &getArena() const { return _arena; }
+
+private:
+	Arena &_arena;
+	const Arena::Marker _marker;
+};
+
+/**
+ * An allocator which makes containers get their storage from an arena, for
+ * example:
+ * @code
+ * Common::List<DrawCall *, Common::ArenaAllocator> drawCalls((Common::ArenaAllocator(arena)));
+ * @endcode
+ *
+ * The memory released by the container is only reclaimed when the arena is
+ * rewound. The container has to be destroyed or cleared before the arena is
+ * rewound past its allocations.
+ */
+class ArenaAllocator {
+public:
+	/** Construct an allocator without arena, which cannot allocate. */
+	ArenaAllocator() : _arena(nullptr) {}
+	explicit ArenaAllocator(Arena &arena) : _arena(&arena) {}
+
+	void *allocate(size_t size) {
+		assert(_arena);
+		return _arena->allocate(size);
+	}
+	void deallocate(void *) {}
+
+	Arena *getArena() const { return _arena; }
+
+private:
+	Arena *_arena;
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -48,9 +48,11 @@ namespace Common {
  *
  * The container class closest to this in the C++ standard library is
  * std::vector. However, there are some differences.
+ *
+ * The element storage is obtained from @p Alloc, see DefaultAllocator.
  */
-template<class T>
-class Array {
+template<class T, class Alloc = DefaultAllocator>
+class Array : private Alloc {
 public:
 	typedef T *iterator; /*!< Array iterator. */
 	typedef const T *const_iterator; /*!< Const-qualified array iterator. */
@@ -67,6 +69,11 @@ protected:
 public:
 	Array() : _capacity(0), _size(0), _storage(nullptr) {}
 
+	/**
+	 * Construct an empty array which gets its storage from @p alloc.
+	 */
+	explicit Array(const Alloc &alloc) : Alloc(alloc), _capacity(0), _size(0), _storage(nullptr) {}
+
 	/**
 	 * Construct an array with @p count default-inserted instances of @p T. No
 	 * copies are made.
@@ -88,7 +95,7 @@ public:
 	/**
 	 * Construct an array as a copy of the given @p array.
 	 */
-	Array(const Array<T> &array) : _capacity(array._size), _size(array._size), _storage(nullptr) {
+	Array(const Array &array) : Alloc(array), _capacity(array._size), _size(array._size), _storage(nullptr) {
 		if (array._storage) {
 			allocCapacity(_size);
 			uninitialized_copy(array._storage, array._storage + _size, _storage);
@@ -98,7 +105,7 @@ public:
 	/**
 	 * Construct an array as a copy of the given array using the C++11 move semantic.
 	 */
-	Array(Array<T> &&old) : _capacity(old._capacity), _size(old._size), _storage(old._storage) {
+	Array(Array &&old) : Alloc(old), _capacity(old._capacity), _size(old._size), _storage(old._storage) {
 		old._storage = nullptr;
 		old._capacity = 0;
 		old._size = 0;
@@ -138,14 +145,26 @@ public:
 
 	/** Append an element to the end of the array. */
 	void push_back(const T &element) {
-		if (_size + 1 <= _capacity)
-			new ((void *)&_storage[_size++]) T(element);
-		else
-			insert_aux(end(), &element, &element + 1);
+		emplace_back(element);
+	}
+
+	/** Append an element to the end of the array, moving it. */
+	void push_back(T &&element) {
+		emplace_back(Common::move(element));
+	}
+
+	/** Construct an element at the end of the array, from the given constructor arguments. */
+	template<class... TArgs>
+	T &emplace_back(TArgs &&...args) {
+		if (_size + 1 <= _capacity) {
+			new ((void *)&_storage[_size]) T(Common::forward<TArgs>(args)...);
+			return _storage[_size++];
+		}
+		return *emplace(end(), Common::forward<TArgs>(args)...);
 	}
 
 	/** Append an element to the end of the array. */
-	void push_back(const Array<T> &array) {
+	void push_back(const Array &array) {
 		if (_size + array.size() <= _capacity) {
 			uninitialized_copy(array.begin(), array.end(), end());
 			_size += array.size();
@@ -198,11 +217,17 @@ public:
 	/** Insert an element into the array at the given position. */
 	void insert_at(size_type idx, const T &element) {
 		assert(idx <= _size);
-		insert_aux(_storage + idx, &element, &element + 1);
+		emplace(_storage + idx, element);
+	}
+
+	/** Insert an element into the array at the given position, moving it. */
+	void insert_at(size_type idx, T &&element) {
+		assert(idx <= _size);
+		emplace(_storage + idx, Common::move(element));
 	}
 
 	/** Insert copies of all the elements from the given array into this array at the given position. */
-	void insert_at(size_type idx, const Array<T> &array) {
+	void insert_at(size_type idx, const Array &array) {
 		assert(idx <= _size);
 		insert_aux(_storage + idx, array.begin(), array.end());
 	}
@@ -211,14 +236,55 @@ public:
 	 * Insert an element before @p pos.
 	 */
 	void insert(iterator pos, const T &element) {
-		insert_aux(pos, &element, &element + 1);
+		emplace(pos, element);
+	}
+
+	/**
+	 * Insert an element before @p pos, moving it.
+	 */
+	void insert(iterator pos, T &&element) {
+		emplace(pos, Common::move(element));
+	}
+
+	/**
+	 * Construct an element before @p pos, from the given constructor
+	 * arguments, and return an iterator pointing to it.
+	 */
+	template<class... TArgs>
+	iterator emplace(const_iterator pos, TArgs &&...args) {
+		assert(_storage <= pos && pos <= _storage + _size);
+		const size_type idx = pos - _storage;
+		if (_size + 1 > _capacity) {
+			T *const oldStorage = _storage;
+			allocCapacity(roundUpCapacity(_size + 1));
+
+			// Construct the new element first, since the arguments may
+			// refer to elements of the old storage
+			new ((void *)(_storage + idx)) T(Common::forward<TArgs>(args)...);
+			uninitialized_move(oldStorage, oldStorage + idx, _storage);
+			uninitialized_move(oldStorage + idx, oldStorage + _size, _storage + idx + 1);
+
+			freeStorage(oldStorage, _size);
+		} else if (idx == _size) {
+			new ((void *)(_storage + idx)) T(Common::forward<TArgs>(args)...);
+		} else {
+			// The arguments may refer to elements which are about to be moved
+			T element(Common::forward<TArgs>(args)...);
+
+			// Make room for the new element by shifting back the existing ones
+			new ((void *)(_storage + _size)) T(Common::move(_storage[_size - 1]));
+			move_backward(_storage + idx, _storage + _size - 1, _storage + _size);
+			_storage[idx] = Common::move(element);
+		}
+		_size++;
+		return _storage + idx;
 	}
 
 	/** Remove an element at the given position from the array and return the value of that element. */
 	T remove_at(size_type idx) {
 		assert(idx < _size);
-		T tmp = _storage[idx];
-		copy(_storage + idx + 1, _storage + _size, _storage + idx);
+		T tmp = Common::move(_storage[idx]);
+		move(_storage + idx + 1, _storage + _size, _storage + idx);
 		_size--;
 		// We also need to destroy the last object properly here.
 		_storage[_size].~T();
@@ -240,7 +306,7 @@ public:
 	}
 
 	/** Assign the given @p array to this array. */
-	Array<T> &operator=(const Array<T> &array) {
+	Array &operator=(const Array &array) {
 		if (this == &array)
 			return *this;
 
@@ -253,11 +319,12 @@ public:
 	}
 
 	/** Assign the given array to this array using the C++11 move semantic. */
-	Array &operator=(Array<T> &&old) {
+	Array &operator=(Array &&old) {
 		if (this == &old)
 			return *this;
 
 		freeStorage(_storage, _size);
+		static_cast<Alloc &>(*this) = static_cast<const Alloc &>(old);
 		_capacity = old._capacity;
 		_size = old._size;
 		_storage = old._storage;
@@ -284,7 +351,7 @@ public:
 
 	/** Erase the element at @p pos position and return an iterator pointing to the next element in the array. */
 	iterator erase(iterator pos) {
-		copy(pos + 1, _storage + _size, pos);
+		move(pos + 1, _storage + _size, pos);
 		_size--;
 		// We also need to destroy the last object properly here.
 		_storage[_size].~T();
@@ -297,7 +364,7 @@ public:
 	}
 
 	/** Check whether two arrays are identical. */
-	bool operator==(const Array<T> &other) const {
+	bool operator==(const Array &other) const {
 		if (this == &other)
 			return true;
 		if (_size != other._size)
@@ -310,7 +377,7 @@ public:
 	}
 
 	/** Check if two arrays are different. */
-	bool operator!=(const Array<T> &other) const {
+	bool operator!=(const Array &other) const {
 		return !(*this == other);
 	}
 
@@ -345,8 +412,8 @@ public:
 		allocCapacity(newCapacity);
 
 		if (oldStorage) {
-			// Copy old data
-			uninitialized_copy(oldStorage, oldStorage + _size, _storage);
+			// Move old data
+			uninitialized_move(oldStorage, oldStorage + _size, _storage);
 			freeStorage(oldStorage, _size);
 		}
 	}
@@ -386,7 +453,7 @@ protected:
 	void allocCapacity(size_type capacity) {
 		_capacity = capacity;
 		if (capacity) {
-			_storage = (T *)malloc(sizeof(T) * capacity);
+			_storage = (T *)Alloc::allocate(sizeof(T) * capacity);
 			if (!_storage)
 				::error("Common::Array: failure to allocate %u bytes", capacity * (size_type)sizeof(T));
 		} else {
@@ -398,7 +465,8 @@ protected:
 	void freeStorage(T *storage, const size_type elements) {
 		for (size_type i = 0; i < elements; ++i)
 			storage[i].~T();
-		free(storage);
+		if (storage)
+			Alloc::deallocate(storage);
 	}
 
 	/**
@@ -428,30 +496,31 @@ protected:
 				// storage to avoid conflicts.
 				allocCapacity(roundUpCapacity(_size + n));
 
-				// Copy the data from the old storage till the position where
-				// we insert new data
-				uninitialized_copy(oldStorage, oldStorage + idx, _storage);
-				// Copy the data we insert
+				// Copy the data we insert, before the old data it may come
+				// from is moved
 				uninitialized_copy(first, last, _storage + idx);
-				// Afterwards, copy the old data from the position where we
+				// Move the data from the old storage till the position where
+				// we insert new data
+				uninitialized_move(oldStorage, oldStorage + idx, _storage);
+				// Afterwards, move the old data from the position where we
 				// insert.
-				uninitialized_copy(oldStorage + idx, oldStorage + _size, _storage + idx + n);
+				uninitialized_move(oldStorage + idx, oldStorage + _size, _storage + idx + n);
 
 				freeStorage(oldStorage, _size);
 			} else if (idx + n <= _size) {
 				// Make room for the new elements by shifting back
 				// existing ones.
 				// 1. Move a part of the data to the uninitialized area
-				uninitialized_copy(_storage + _size - n, _storage + _size, _storage + _size);
+				uninitialized_move(_storage + _size - n, _storage + _size, _storage + _size);
 				// 2. Move a part of the data to the initialized area
-				copy_backward(pos, _storage + _size - n, _storage + _size);
+				move_backward(pos, _storage + _size - n, _storage + _size);
 
 				// Insert the new elements.
 				copy(first, last, pos);
 			} else {
-				// Copy the old data from the position till the end to the new
+				// Move the old data from the position till the end to the new
 				// place.
-				uninitialized_copy(pos, _storage + _size, _storage + idx + n);
+				uninitialized_move(pos, _storage + _size, _storage + idx + n);
 
 				// Copy a part of the new data to the position inside the
 				// initialized space.
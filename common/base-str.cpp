@@ -22,45 +22,59 @@
 #include "common/base-str.h"
 #include "common/hash-str.h"
 #include "common/list.h"
-#include "common/memorypool.h"
+#include "common/math.h"
 #include "common/textconsole.h"
 #include "common/util.h"
-#include "common/mutex.h"
 
 namespace Common {
 
 #define TEMPLATE template<class T>
 #define BASESTRING BaseString<T>
 
-MemoryPool *g_refCountPool = nullptr; // FIXME: This is never freed right now
-#ifndef SCUMMVM_UTIL
-Mutex *g_refCountPoolMutex = nullptr;
-
-void lockMemoryPoolMutex() {
-	// The Mutex class can only be used once g_system is set and initialized,
-	// but we may use the String class earlier than that (it is for example
-	// used in the OSystem_POSIX constructor). However in those early stages
-	// we can hope we don't have multiple threads either.
-	if (!g_system || !g_system->backendInitialized())
-		return;
-	if (!g_refCountPoolMutex)
-		g_refCountPoolMutex = new Mutex();
-	g_refCountPoolMutex->lock();
+/**
+ * Allocate external storage for @p capacity characters. The reference count
+ * of the storage is placed right before it, where it is returned in
+ * @p refCount, set to 1. This way strings share their storage without any
+ * further allocation.
+ */
+template<class T>
+static T *allocStorage(uint32 capacity, int *&refCount) {
+	byte *block = new byte[sizeof(int) + capacity * sizeof(T)];
+	refCount = (int *)block;
+	*refCount = 1;
+	return (T *)(block + sizeof(int));
 }
 
-void unlockMemoryPoolMutex() {
-	if (g_refCountPoolMutex)
-		g_refCountPoolMutex->unlock();
+/** Free the storage allocated by allocStorage() with @p refCount. */
+static void freeStorage(int *refCount) {
+	delete[] (byte *)refCount;
 }
 
-TEMPLATE void BASESTRING::releaseMemoryPoolMutex() {
-	if (g_refCountPoolMutex){
-		delete g_refCountPoolMutex;
-		g_refCountPoolMutex = nullptr;
-	}
+/**
+ * Copies of a string share its storage, and may be made or destroyed on
+ * other threads, so the reference count is only changed atomically.
+ * Compilers without atomic intrinsics fall back to plain operations.
+ */
+static inline void incStorageRefCount(int *refCount) {
+#if defined(_MSC_VER)
+	_InterlockedIncrement((volatile long *)refCount);
+#elif defined(__GNUC__)
+	__sync_add_and_fetch(refCount, 1);
+#else
+	++(*refCount);
+#endif
 }
 
+/** Atomically decrement @p refCount, and return the new value. */
+static inline int decStorageRefCount(int *refCount) {
+#if defined(_MSC_VER)
+	return _InterlockedDecrement((volatile long *)refCount);
+#elif defined(__GNUC__)
+	return __sync_sub_and_fetch(refCount, 1);
+#else
+	return --(*refCount);
 #endif
+}
 
 static uint32 computeCapacity(uint32 len) {
 	// By default, for the capacity we use the next multiple of 32
@@ -84,6 +98,25 @@ BASESTRING::BaseString(const BASESTRING &str)
 	assert(_str != nullptr);
 }
 
+TEMPLATE
+BASESTRING::BaseString(BASESTRING &&str)
+	: _size(str._size) {
+	if (str.isStorageIntern()) {
+		// String in internal storage: there is nothing to take over
+		memcpy(_storage, str._storage, _builtinCapacity * sizeof(value_type));
+		_str = _storage;
+	} else {
+		// String in external storage: take over the buffer and its refcount
+		_extern._refCount = str._extern._refCount;
+		_extern._capacity = str._extern._capacity;
+		_str = str._str;
+
+		str._size = 0;
+		str._str = str._storage;
+		str._storage[0] = 0;
+	}
+}
+
 TEMPLATE BASESTRING::BaseString(const value_type *str) : _size(0), _str(_storage) {
 	if (str == nullptr) {
 		_storage[0] = 0;
@@ -120,12 +153,13 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 	uint32 curCapacity, newCapacity;
 	value_type *newStorage;
 	int *oldRefCount = _extern._refCount;
+	int *newRefCount = nullptr;
 
 	if (isStorageIntern()) {
 		isShared = false;
 		curCapacity = _builtinCapacity;
 	} else {
-		isShared = (oldRefCount && *oldRefCount > 1);
+		isShared = (*oldRefCount > 1);
 		curCapacity = _extern._capacity;
 	}
 
@@ -149,7 +183,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 			newCapacity = MAX(curCapacity * 2, computeCapacity(new_size + 1));
 
 		// Allocate new storage
-		newStorage = new value_type[newCapacity];
+		newStorage = allocStorage<value_type>(newCapacity, newRefCount);
 		assert(newStorage);
 	}
 
@@ -172,7 +206,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 		// Set the ref count & capacity if we use an external storage.
 		// It is important to do this *after* copying any old content,
 		// else we would override data that has not yet been copied!
-		_extern._refCount = nullptr;
+		_extern._refCount = newRefCount;
 		_extern._capacity = newCapacity;
 	}
 }
@@ -180,23 +214,7 @@ TEMPLATE void BASESTRING::ensureCapacity(uint32 new_size, bool keep_old) {
 TEMPLATE
 void BASESTRING::incRefCount() const {
 	assert(!isStorageIntern());
-	if (_extern._refCount == nullptr) {
-#ifndef SCUMMVM_UTIL
-		lockMemoryPoolMutex();
-#endif
-		if (g_refCountPool == nullptr) {
-			g_refCountPool = new MemoryPool(sizeof(int));
-			assert(g_refCountPool);
-		}
-
-		_extern._refCount = (int *)g_refCountPool->allocChunk();
-#ifndef SCUMMVM_UTIL
-		unlockMemoryPoolMutex();
-#endif
-		*_extern._refCount = 2;
-	} else {
-		++(*_extern._refCount);
-	}
+	incStorageRefCount(_extern._refCount);
 }
 
 TEMPLATE
@@ -204,28 +222,10 @@ void BASESTRING::decRefCount(int *oldRefCount) {
 	if (isStorageIntern())
 		return;
 
-	if (oldRefCount) {
-		--(*oldRefCount);
-	}
-	if (!oldRefCount || *oldRefCount <= 0) {
+	if (decStorageRefCount(oldRefCount) <= 0) {
 		// The ref count reached zero, so we free the string storage
-		// and the ref count storage.
-		if (oldRefCount) {
-#ifndef SCUMMVM_UTIL
-			lockMemoryPoolMutex();
-#endif
-			assert(g_refCountPool);
-			g_refCountPool->freeChunk(oldRefCount);
-#ifndef SCUMMVM_UTIL
-			unlockMemoryPoolMutex();
-#endif
-		}
-		// Coverity thinks that we always free memory, as it assumes
-		// (correctly) that there are cases when oldRefCount == 0
-		// Thus, DO NOT COMPILE, trick it and shut tons of false positives
-#ifndef __COVERITY__
-		delete[] _str;
-#endif
+		// along with the ref count.
+		freeStorage(oldRefCount);
 
 		// Even though _str points to a freed memory block now,
 		// we do not change its value, because any code that calls
@@ -243,8 +243,7 @@ TEMPLATE void BASESTRING::initWithValueTypeStr(const value_type *str, uint32 len
 	if (len >= _builtinCapacity) {
 		// Not enough internal storage, so allocate more
 		_extern._capacity = computeCapacity(len + 1);
-		_extern._refCount = nullptr;
-		_str = new value_type[_extern._capacity];
+		_str = allocStorage<value_type>(_extern._capacity, _extern._refCount);
 		assert(_str != nullptr);
 	}
 
@@ -517,6 +516,29 @@ TEMPLATE void BASESTRING::assign(const BaseString &str) {
 	}
 }
 
+TEMPLATE void BASESTRING::assign(BaseString &&str) {
+	if (&str == this)
+		return;
+
+	if (str.isStorageIntern()) {
+		assign(str);
+	} else {
+		// Strings which were moved from use the internal storage, so do not
+		// read the refcount pointer their first character was written over
+		if (!isStorageIntern())
+			decRefCount(_extern._refCount);
+
+		_extern._refCount = str._extern._refCount;
+		_extern._capacity = str._extern._capacity;
+		_size = str._size;
+		_str = str._str;
+
+		str._size = 0;
+		str._str = str._storage;
+		str._storage[0] = 0;
+	}
+}
+
 TEMPLATE void BASESTRING::assign(value_type c) {
 	decRefCount(_extern._refCount);
 	_str = _storage;
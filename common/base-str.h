@@ -24,6 +24,7 @@
 
 #include "common/scummsys.h"
 #include "common/str-enc.h"
+#include "common/type-traits.h"
 
 #include <stdarg.h>
 
@@ -31,8 +32,6 @@ namespace Common {
 template<class T>
 class BaseString {
 public:
-	static void releaseMemoryPoolMutex();
-
 	static const uint32 npos = 0xFFFFFFFF;
 	typedef T          value_type;
 	typedef T *        iterator;
@@ -66,8 +65,9 @@ protected:
 		 */
 		value_type _storage[_builtinCapacity];
 		/**
-		 * External string storage data -- the refcounter, and the
-		 * capacity of the string _str points to.
+		 * External string storage data -- the refcounter, which is
+		 * stored right before the string _str points to, and the
+		 * capacity of that string.
 		 */
 		struct {
 			mutable int *_refCount;
@@ -86,6 +86,9 @@ public:
 	/** Construct a copy of the given string. */
 	BaseString(const BaseString &str);
 
+	/** Construct a string by taking over the content of the given string, which is left empty. */
+	BaseString(BaseString &&str);
+
 	/** Construct a new string from the given NULL-terminated C string. */
 	explicit BaseString(const value_type *str);
 
@@ -247,6 +250,7 @@ protected:
 	void assignAppend(value_type c);
 	void assignAppend(const BaseString &str);
 	void assign(const BaseString &str);
+	void assign(BaseString &&str);
 	void assign(value_type c);
 	void assign(const value_type *str);
 
@@ -41,6 +41,23 @@ namespace Common {
  * @{
  */
 
+class BitStreamMemoryStream;
+
+/**
+ * Whether a bit stream may read ahead of the bits it hands out, which lets
+ * it refill its bit container 32 bits at a time. This is only done for
+ * BitStreamMemoryStream, whose position is not used by anyone else.
+ */
+template<class STREAM>
+struct BitStreamReadAhead {
+	static const bool value = false;
+};
+
+template<>
+struct BitStreamReadAhead<BitStreamMemoryStream> {
+	static const bool value = true;
+};
+
 /**
  * A template implementing a bit stream for different data memory layouts.
  *
@@ -84,9 +101,28 @@ private:
 		return 0;
 	}
 
+	/**
+	 * Whether 32 bits of the data stream can be read as one value, which
+	 * holds when the values are bytes, or when the byte order matches the
+	 * bit order.
+	 */
+	static const bool _canReadUint32 = BitStreamReadAhead<STREAM>::value && valueBits < 32 &&
+	                                   (valueBits == 8 || isLE != MSB2LSB);
+
 	/** Fill the container with at least @p min bits. */
 	inline void fillContainer(size_t min) {
 		while (_bitsLeft < min) {
+			if (_canReadUint32 && _bitsLeft <= 32 && _pos + _bitsLeft + 32 <= _size) {
+				const uint64 data = MSB2LSB ? _stream->readUint32BE() : _stream->readUint32LE();
+
+				if (MSB2LSB)
+					_bitContainer |= data << (32 - _bitsLeft);
+				else
+					_bitContainer |= data << _bitsLeft;
+
+				_bitsLeft += 32;
+				continue;
+			}
 
 			uint64 data;
 			if (_pos + _bitsLeft + valueBits <= _size) {
@@ -108,7 +144,7 @@ private:
 
 			_bitsLeft += valueBits;
 		}
-}
+	}
 
 	/** Get @p n bits from the bit container. */
 	inline static uint32 getNBits(uint64 value, size_t n) {
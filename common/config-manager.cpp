@@ -23,8 +23,11 @@
 #include "common/debug.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/thread.h"
 
 static bool isValidDomainName(const Common::String &domName) {
 	const char *p = domName.c_str();
@@ -49,7 +52,150 @@ char const *const ConfigManager::kCloudDomain = "cloud";
 #pragma mark -
 
 
-ConfigManager::ConfigManager() : _activeDomain(nullptr) {
+/**
+ * Writes the configuration file on a background thread. Only the most recent
+ * contents are kept, so several flushes in a row result in a single write.
+ */
+class ConfigFileWriter {
+public:
+	ConfigFileWriter() : _hasPending(false), _writing(false), _quit(false) {
+		if (_wake.isValid() && _done.isValid())
+			_thread.start(workerProc, this);
+	}
+
+	~ConfigFileWriter() {
+		{
+			StackLock lock(_mutex);
+			_quit = true;
+		}
+
+		// The worker writes the pending contents before quitting
+		if (_thread.isStarted()) {
+			_wake.post();
+			_thread.join();
+		}
+	}
+
+	/** Write @p contents into @p filename, or into the default config file if it is empty. */
+	void submit(const String &filename, const String &contents) {
+		if (!_thread.isStarted()) {
+			write(filename, contents);
+			return;
+		}
+
+		StackLock lock(_mutex);
+		_pendingFilename = filename;
+		_pendingContents = contents;
+		if (!_hasPending) {
+			_hasPending = true;
+			_wake.post();
+		}
+	}
+
+	void waitForPending() {
+		for (;;) {
+			{
+				StackLock lock(_mutex);
+				if (!_hasPending && !_writing)
+					return;
+			}
+			_done.wait();
+		}
+	}
+
+private:
+	/** How long to wait for further changes before writing the file. */
+	static const uint32 kFlushDelay = 100;
+
+	static void workerProc(void *data) {
+		((ConfigFileWriter *)data)->work();
+	}
+
+	void work() {
+		for (;;) {
+			bool quit;
+			{
+				StackLock lock(_mutex);
+				quit = _quit;
+				if (!_hasPending && quit)
+					return;
+				if (_hasPending)
+					_writing = true;
+			}
+
+			if (!_writing) {
+				_wake.wait();
+				continue;
+			}
+
+			if (!quit)
+				g_system->delayMillis(kFlushDelay);
+
+			String filename, contents;
+			{
+				StackLock lock(_mutex);
+				filename = _pendingFilename;
+				contents = _pendingContents;
+				_pendingContents.clear();
+				_hasPending = false;
+			}
+
+			write(filename, contents);
+
+			{
+				StackLock lock(_mutex);
+				_writing = false;
+			}
+			_done.post();
+		}
+	}
+
+	static void write(const String &filename, const String &contents) {
+		WriteStream *stream;
+
+		if (filename.empty()) {
+			// Write to the default config file
+			stream = g_system->createConfigWriteStream();
+			if (!stream)    // If writing to the config file is not possible, do nothing
+				return;
+		} else {
+			DumpFile *dump = new DumpFile();
+			assert(dump);
+
+			if (!dump->open(filename)) {
+				warning("Unable to write configuration file: %s", filename.c_str());
+				delete dump;
+				return;
+			}
+
+			stream = dump;
+		}
+
+		stream->write(contents.c_str(), contents.size());
+		stream->finalize();
+		if (stream->err())
+			warning("Unable to write configuration file: %s", filename.empty() ? "default" : filename.c_str());
+		delete stream;
+	}
+
+	Mutex _mutex;
+	Semaphore _wake;
+	Semaphore _done;
+	Thread _thread;
+
+	// The following members are protected by _mutex
+	String _pendingFilename;
+	String _pendingContents;
+	bool _hasPending;
+	bool _writing;
+	bool _quit;
+};
+
+ConfigManager::ConfigManager() : _activeDomain(nullptr), _writer(nullptr) {
+}
+
+ConfigManager::~ConfigManager() {
+	delete _writer;
 }
 
 void ConfigManager::defragment() {
@@ -73,14 +219,17 @@ void ConfigManager::copyFrom(ConfigManager &source) {
 	_activeDomainName = source._activeDomainName;
 	_activeDomain = &_gameDomains[_activeDomainName];
 	_filename = source._filename;
+	_flushedContents = source._flushedContents;
 }
 
 
 void ConfigManager::loadDefaultConfigFile() {
 	// Open the default config file
 	assert(g_system);
+	waitForPendingFlush();
 	SeekableReadStream *stream = g_system->createConfigReadStream();
 	_filename.clear(); // clear the filename to indicate that we are using the default config file
+	_flushedContents.clear();
 
 	// ... load it, if available ...
 	if (stream) {
@@ -98,7 +247,9 @@ void ConfigManager::loadDefaultConfigFile() {
 }
 
 void ConfigManager::loadConfigFile(const String &filename) {
+	waitForPendingFlush();
 	_filename = filename;
+	_flushedContents.clear();
 
 	FSNode node(filename);
 	File cfg_file;
@@ -249,42 +400,23 @@ void ConfigManager::loadFromStream(SeekableReadStream &stream) {
 
 void ConfigManager::flushToDisk() {
 #ifndef __DC__
-	WriteStream *stream;
-
-	if (_filename.empty()) {
-		// Write to the default config file
-		assert(g_system);
-		stream = g_system->createConfigWriteStream();
-		if (!stream)    // If writing to the config file is not possible, do nothing
-			return;
-	} else {
-		DumpFile *dump = new DumpFile();
-		assert(dump);
-
-		if (!dump->open(_filename)) {
-			warning("Unable to write configuration file: %s", _filename.c_str());
-			delete dump;
-			return;
-		}
-
-		stream = dump;
-	}
+	MemoryWriteStreamDynamic stream(DisposeAfterUse::YES);
 
 	// Write the application domain
-	writeDomain(*stream, kApplicationDomain, _appDomain);
+	writeDomain(stream, kApplicationDomain, _appDomain);
 
 	// Write the keymapper domain
-	writeDomain(*stream, kKeymapperDomain, _keymapperDomain);
+	writeDomain(stream, kKeymapperDomain, _keymapperDomain);
 #ifdef USE_CLOUD
 	// Write the cloud domain
-	writeDomain(*stream, kCloudDomain, _cloudDomain);
+	writeDomain(stream, kCloudDomain, _cloudDomain);
 #endif
 
 	DomainMap::const_iterator d;
 
 	// Write the miscellaneous domains next
 	for (d = _miscDomains.begin(); d != _miscDomains.end(); ++d) {
-		writeDomain(*stream, d->_key, d->_value);
+		writeDomain(stream, d->_key, d->_value);
 	}
 
 	// First write the domains in _domainSaveOrder, in that order.
@@ -293,21 +425,34 @@ void ConfigManager::flushToDisk() {
 	Array<String>::const_iterator i;
 	for (i = _domainSaveOrder.begin(); i != _domainSaveOrder.end(); ++i) {
 		if (_gameDomains.contains(*i)) {
-			writeDomain(*stream, *i, _gameDomains[*i]);
+			writeDomain(stream, *i, _gameDomains[*i]);
 		}
 	}
 
 	// Now write the domains which haven't been written yet
 	for (d = _gameDomains.begin(); d != _gameDomains.end(); ++d) {
 		if (find(_domainSaveOrder.begin(), _domainSaveOrder.end(), d->_key) == _domainSaveOrder.end())
-			writeDomain(*stream, d->_key, d->_value);
+			writeDomain(stream, d->_key, d->_value);
 	}
 
-	delete stream;
+	// Many settings dialogs flush without having changed anything
+	String contents((const char *)stream.getData(), stream.size());
+	if (!_flushedContents.empty() && contents == _flushedContents)
+		return;
+	_flushedContents = contents;
 
+	assert(g_system);
+	if (!_writer)
+		_writer = new ConfigFileWriter();
+	_writer->submit(_filename, contents);
 #endif // !__DC__
 }
 
+void ConfigManager::waitForPendingFlush() {
+	if (_writer)
+		_writer->waitForPending();
+}
+
 void ConfigManager::writeDomain(WriteStream &stream, const String &name, const Domain &domain) {
 	if (domain.empty())
 		return; // Don't bother writing empty domains.
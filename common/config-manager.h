@@ -42,6 +42,7 @@ namespace Common {
 
 class WriteStream;
 class SeekableReadStream;
+class ConfigFileWriter;
 
 /**
  * The (singleton) configuration manager, used to query & set configuration
@@ -184,7 +185,15 @@ public:
 	void                     registerDefault(const String &key, int value); /*!< @overload */
 	void                     registerDefault(const String &key, bool value); /*!< @overload */
 
-	void                     flushToDisk(); /*!< Flush configuration to disk. */
+	/**
+	 * Flush configuration to disk.
+	 *
+	 * Nothing is written if the configuration did not change since the last
+	 * flush. When the backend supports threads, the file is written in the
+	 * background, and flushes following each other closely are written once.
+	 */
+	void                     flushToDisk();
+	void                     waitForPendingFlush(); /*!< Wait until the configuration passed to flushToDisk() is written. */
 
 	void                     setActiveDomain(const String &domName); /*!< Set the given domain as active. */
 	Domain                  *getActiveDomain() { return _activeDomain; } /*!< Get the active domain. */
@@ -214,6 +223,7 @@ public:
 private:
 	friend class Singleton<SingletonBaseType>;
 	ConfigManager();
+	~ConfigManager();
 
 	void			loadFromStream(SeekableReadStream &stream);
 	void			addDomain(const String &domainName, const Domain &domain);
@@ -238,6 +248,9 @@ private:
 	Domain *		_activeDomain;
 
 	String			_filename;
+
+	String			_flushedContents; ///< What the last flushToDisk() wrote
+	ConfigFileWriter *_writer;
 };
 
 /** @} */
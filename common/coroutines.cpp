@@ -24,6 +24,7 @@
 #include "common/debug.h"
 #include "common/hashmap.h"
 #include "common/hash-str.h"
+#include "common/memorypool.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 
@@ -71,6 +72,58 @@ static void displayCoroStats() {
 } // End of anonymous namespace
 #endif
 
+namespace {
+enum {
+	kCoroPoolGranularity = 16,
+	kCoroPoolCount = 32
+};
+
+/** Pools for the contexts up to 512 bytes, by multiples of 16 bytes */
+static MemoryPool *s_coroPools[kCoroPoolCount];
+
+/** Count of contexts allocated from the pools */
+static int s_coroPooled = 0;
+
+/**
+ * Free the pools, if no context allocated from them is still alive
+ */
+static void freeCoroPools() {
+	if (s_coroPooled)
+		return;
+
+	for (int i = 0; i < kCoroPoolCount; i++) {
+		delete s_coroPools[i];
+		s_coroPools[i] = nullptr;
+	}
+}
+} // End of anonymous namespace
+
+void *CoroBaseContext::operator new(size_t size) {
+	size_t index = (size - 1) / kCoroPoolGranularity;
+	if (index >= kCoroPoolCount)
+		return ::operator new(size);
+
+	if (!s_coroPools[index])
+		s_coroPools[index] = new MemoryPool((index + 1) * kCoroPoolGranularity);
+
+	s_coroPooled++;
+	return s_coroPools[index]->allocChunk();
+}
+
+void CoroBaseContext::operator delete(void *ptr, size_t size) {
+	if (!ptr)
+		return;
+
+	size_t index = (size - 1) / kCoroPoolGranularity;
+	if (index >= kCoroPoolCount) {
+		::operator delete(ptr);
+		return;
+	}
+
+	s_coroPools[index]->freeChunk(ptr);
+	s_coroPooled--;
+}
+
 CoroBaseContext::CoroBaseContext(const char *func)
 	: _line(0), _sleep(0), _subctx(nullptr) {
 #ifdef COROUTINE_DEBUG
@@ -133,6 +186,8 @@ CoroutineScheduler::~CoroutineScheduler() {
 	Common::List<EVENT *>::iterator i;
 	for (i = _events.begin(); i != _events.end(); ++i)
 		delete *i;
+
+	freeCoroPools();
 }
 
 void CoroutineScheduler::reset() {
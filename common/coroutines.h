@@ -67,6 +67,13 @@ struct CoroBaseContext {
 	 * Destructor for coroutine context.
 	 */
 	virtual ~CoroBaseContext();
+
+	/**
+	 * Contexts are created and destroyed on nearly every coroutine call,
+	 * so they are taken from pools of recycled blocks, one pool per size.
+	 */
+	static void *operator new(size_t size);
+	static void operator delete(void *ptr, size_t size);
 };
 
 typedef CoroBaseContext *CoroContext;
@@ -0,0 +1,40 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/cpu.h"
+#include "common/system.h"
+
+namespace Common {
+
+uint32 g_cpuFeatures = 0;
+
+void detectCpuFeatures() {
+	g_cpuFeatures = 0;
+	if (!g_system)
+		return;
+
+	if (g_system->hasFeature(OSystem::kFeatureCpuSSE2))
+		g_cpuFeatures |= kCpuFeatureSSE2;
+	if (g_system->hasFeature(OSystem::kFeatureCpuNEON))
+		g_cpuFeatures |= kCpuFeatureNEON;
+}
+
+} // End of namespace Common
@@ -0,0 +1,78 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_CPU_H
+#define COMMON_CPU_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_cpu CPU features
+ * @ingroup common
+ *
+ * @brief  Selection of the optimized code paths the host CPU can run.
+ *
+ * @{
+ */
+
+/** Instruction set extensions for which optimized code paths exist. */
+enum CpuFeature {
+	kCpuFeatureSSE2 = 1 << 0,
+	kCpuFeatureNEON = 1 << 1
+};
+
+/**
+ * Ask the backend which instruction set extensions the CPU supports.
+ *
+ * This is called once on startup, before the backend is initialized and
+ * before any thread is started, so that hasCpuFeature() can be called from
+ * any thread afterwards.
+ */
+void detectCpuFeatures();
+
+/** Bitmask of the CpuFeature values found by detectCpuFeatures(). */
+extern uint32 g_cpuFeatures;
+
+/**
+ * Check whether the CPU supports an instruction set extension.
+ *
+ * Extensions which are part of the baseline instruction set of the build
+ * target are always reported as supported, without asking the backend.
+ */
+inline bool hasCpuFeature(CpuFeature feature) {
+#if defined(__x86_64__) || defined(_M_X64) || defined(__SSE2__)
+	if (feature == kCpuFeatureSSE2)
+		return true;
+#endif
+#if defined(__aarch64__) || defined(_M_ARM64) || defined(__ARM_NEON)
+	if (feature == kCpuFeatureNEON)
+		return true;
+#endif
+	return (g_cpuFeatures & feature) != 0;
+}
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,80 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/fft_intern.h"
+
+#include <arm_neon.h>
+
+namespace Common {
+
+/** Flip the sign of the lanes selected by the mask. */
+static inline float32x4_t negate(float32x4_t v, uint32x4_t mask) {
+	return vreinterpretq_f32_u32(veorq_u32(vreinterpretq_u32_f32(v), mask));
+}
+
+void fftPassNEON(Complex *z, const float *wre, unsigned int n) {
+	const int o1 = 2 * n;
+	const int o2 = 4 * n;
+	const int o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	// Sign masks for the imaginary and the real parts
+	static const uint32 negImBits[4] = { 0, 0x80000000, 0, 0x80000000 };
+	static const uint32 negReBits[4] = { 0x80000000, 0, 0x80000000, 0 };
+	const uint32x4_t negIm = vld1q_u32(negImBits);
+	const uint32x4_t negRe = vld1q_u32(negReBits);
+
+	// Two elements of each quarter at a time. All inputs are loaded before
+	// storing anything, like pass_big() does in the scalar code.
+	for (int k = 2; k < o1; k += 2) {
+		float *p0 = (float *)(z + k);
+		float *p1 = (float *)(z + o1 + k);
+		float *p2 = (float *)(z + o2 + k);
+		float *p3 = (float *)(z + o3 + k);
+
+		const float32x4_t a0 = vld1q_f32(p0);
+		const float32x4_t a1 = vld1q_f32(p1);
+		const float32x4_t a2 = vld1q_f32(p2);
+		const float32x4_t a3 = vld1q_f32(p3);
+
+		// (wre[k], wre[k], wre[k + 1], wre[k + 1])
+		const float32x2_t wrPair = vld1_f32(wre + k);
+		const float32x4_t wr = vcombine_f32(vdup_lane_f32(wrPair, 0), vdup_lane_f32(wrPair, 1));
+		// (wim[-k], wim[-k], wim[-k - 1], wim[-k - 1])
+		const float32x2_t wiPair = vld1_f32(wim - k - 1);
+		const float32x4_t wi = vcombine_f32(vdup_lane_f32(wiPair, 1), vdup_lane_f32(wiPair, 0));
+
+		// x = a2 * conj(w), y = a3 * w
+		const float32x4_t x = vaddq_f32(vmulq_f32(a2, wr), negate(vmulq_f32(vrev64q_f32(a2), wi), negIm));
+		const float32x4_t y = vaddq_f32(vmulq_f32(a3, wr), negate(vmulq_f32(vrev64q_f32(a3), wi), negRe));
+
+		// s = x + y, e = -i * (x - y)
+		const float32x4_t s = vaddq_f32(x, y);
+		const float32x4_t e = negate(vrev64q_f32(vsubq_f32(x, y)), negIm);
+
+		vst1q_f32(p0, vaddq_f32(a0, s));
+		vst1q_f32(p2, vsubq_f32(a0, s));
+		vst1q_f32(p1, vaddq_f32(a1, e));
+		vst1q_f32(p3, vsubq_f32(a1, e));
+	}
+}
+
+} // End of namespace Common
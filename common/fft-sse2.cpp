@@ -0,0 +1,78 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/fft_intern.h"
+
+#include <emmintrin.h>
+
+namespace Common {
+
+/** Swap the real and imaginary parts of two complex numbers. */
+static inline __m128 swapReIm(__m128 v) {
+	return _mm_shuffle_ps(v, v, _MM_SHUFFLE(2, 3, 0, 1));
+}
+
+void fftPassSSE2(Complex *z, const float *wre, unsigned int n) {
+	const int o1 = 2 * n;
+	const int o2 = 4 * n;
+	const int o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	// Sign masks for the imaginary and the real parts
+	const __m128 negIm = _mm_set_ps(-0.0f, 0.0f, -0.0f, 0.0f);
+	const __m128 negRe = _mm_set_ps(0.0f, -0.0f, 0.0f, -0.0f);
+
+	// Two elements of each quarter at a time. All inputs are loaded before
+	// storing anything, like pass_big() does in the scalar code.
+	for (int k = 2; k < o1; k += 2) {
+		float *p0 = (float *)(z + k);
+		float *p1 = (float *)(z + o1 + k);
+		float *p2 = (float *)(z + o2 + k);
+		float *p3 = (float *)(z + o3 + k);
+
+		const __m128 a0 = _mm_loadu_ps(p0);
+		const __m128 a1 = _mm_loadu_ps(p1);
+		const __m128 a2 = _mm_loadu_ps(p2);
+		const __m128 a3 = _mm_loadu_ps(p3);
+
+		// (wre[k], wre[k], wre[k + 1], wre[k + 1])
+		__m128 wr = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(wre + k));
+		wr = _mm_unpacklo_ps(wr, wr);
+		// (wim[-k], wim[-k], wim[-k - 1], wim[-k - 1])
+		__m128 wi = _mm_loadl_pi(_mm_setzero_ps(), (const __m64 *)(wim - k - 1));
+		wi = _mm_shuffle_ps(wi, wi, _MM_SHUFFLE(0, 0, 1, 1));
+
+		// x = a2 * conj(w), y = a3 * w
+		const __m128 x = _mm_add_ps(_mm_mul_ps(a2, wr), _mm_xor_ps(_mm_mul_ps(swapReIm(a2), wi), negIm));
+		const __m128 y = _mm_add_ps(_mm_mul_ps(a3, wr), _mm_xor_ps(_mm_mul_ps(swapReIm(a3), wi), negRe));
+
+		// s = x + y, e = -i * (x - y)
+		const __m128 s = _mm_add_ps(x, y);
+		const __m128 e = _mm_xor_ps(swapReIm(_mm_sub_ps(x, y)), negIm);
+
+		_mm_storeu_ps(p0, _mm_add_ps(a0, s));
+		_mm_storeu_ps(p2, _mm_sub_ps(a0, s));
+		_mm_storeu_ps(p1, _mm_add_ps(a1, e));
+		_mm_storeu_ps(p3, _mm_sub_ps(a1, e));
+	}
+}
+
+} // End of namespace Common
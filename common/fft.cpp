@@ -27,6 +27,8 @@
 
 #include "common/cosinetables.h"
 #include "common/fft.h"
+#include "common/fft_intern.h"
+#include "common/cpu.h"
 #include "common/util.h"
 #include "common/textconsole.h"
 
@@ -180,6 +182,31 @@ PASS(pass)
 #define BUTTERFLIES BUTTERFLIES_BIG
 PASS(pass_big)
 
+/* The first two elements of each quarter of a pass, see FFTPassFunc */
+static void passHead(Complex *z, const float *wre, unsigned int n) {
+	float t1, t2, t3, t4, t5, t6;
+	int o1 = 2 * n;
+	int o2 = 4 * n;
+	int o3 = 6 * n;
+	const float *wim = wre + o1;
+
+	TRANSFORM_ZERO(z[0], z[o1], z[o2], z[o3]);
+	TRANSFORM(z[1], z[o1 + 1], z[o2 + 1], z[o3 + 1], wre[1], wim[-1]);
+}
+
+static FFTPassFunc getSIMDPass() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return fftPassSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return fftPassNEON;
+#endif
+
+	return nullptr;
+}
+
 void FFT::fft4(Complex *z) {
 	float t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -244,10 +271,15 @@ void FFT::fft(int n, int logn, Complex *z) {
 		fft((n / 4), logn - 2, z + (n / 4) * 2);
 		fft((n / 4), logn - 2, z + (n / 4) * 3);
 		assert(_cosTables[logn - 4]);
-		if (n > 1024)
-			pass_big(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+		const float *cosTable = _cosTables[logn - 4]->getTable();
+		FFTPassFunc simdPass = getSIMDPass();
+		if (simdPass) {
+			passHead(z, cosTable, (n / 4) / 2);
+			simdPass(z, cosTable, (n / 4) / 2);
+		} else if (n > 1024)
+			pass_big(z, cosTable, (n / 4) / 2);
 		else
-			pass(z, _cosTables[logn - 4]->getTable(), (n / 4) / 2);
+			pass(z, cosTable, (n / 4) / 2);
 	}
 }
 
@@ -0,0 +1,53 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_FFT_INTERN_H
+#define COMMON_FFT_INTERN_H
+
+#include "common/scummsys.h"
+#include "common/math.h"
+
+namespace Common {
+
+/**
+ * Apply the twiddle factors and butterflies of one split-radix pass.
+ *
+ * This covers z[0...8n-1] except for the first two elements of each
+ * quarter. The caller handles those with the scalar code, as the first
+ * one uses the exact twiddle factor 1 rather than the table value.
+ *
+ * @param z   Data of the pass, made of four quarters of 2n elements.
+ * @param wre Cosine table of the pass size.
+ * @param n   An eighth of the pass size, at least 2.
+ */
+typedef void (*FFTPassFunc)(Complex *z, const float *wre, unsigned int n);
+
+#ifdef SCUMMVM_SSE2
+void fftPassSSE2(Complex *z, const float *wre, unsigned int n);
+#endif
+
+#ifdef SCUMMVM_NEON
+void fftPassNEON(Complex *z, const float *wre, unsigned int n);
+#endif
+
+} // End of namespace Common
+
+#endif // COMMON_FFT_INTERN_H
@@ -19,6 +19,10 @@
  *
  */
 
+#include "common/config-manager.h"
+#include "common/debug.h"
+#include "common/endian.h"
+#include "common/stream.h"
 #include "common/system.h"
 #include "common/punycode.h"
 #include "common/textconsole.h"
@@ -69,6 +73,10 @@ FSNode FSNode::getChild(const String &n) const {
 	return FSNode(node);
 }
 
+FSNode FSNode::getKnownChild(const String &n, bool isDirectory) const {
+	return FSNode(_realNode->getKnownChild(n, isDirectory));
+}
+
 bool FSNode::getChildren(FSList &fslist, ListMode mode, bool hidden) const {
 	if (!_realNode || !_realNode->isDirectory())
 		return false;
@@ -126,6 +134,14 @@ bool FSNode::isWritable() const {
 	return _realNode && _realNode->isWritable();
 }
 
+bool FSNode::getFileStats(int64 &size, int64 &modificationTime) const {
+	return _realNode && _realNode->getFileStats(size, modificationTime);
+}
+
+bool FSNode::getModificationTime(int64 &modificationTime) const {
+	return _realNode && _realNode->getModificationTime(modificationTime);
+}
+
 SeekableReadStream *FSNode::createReadStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -141,6 +157,21 @@ SeekableReadStream *FSNode::createReadStream() const {
 	return _realNode->createReadStream();
 }
 
+SeekableReadStream *FSNode::createReadOnlyDataStream() const {
+	if (_realNode == nullptr)
+		return nullptr;
+
+	if (!_realNode->exists()) {
+		warning("FSNode::createReadOnlyDataStream: '%s' does not exist", getName().c_str());
+		return nullptr;
+	} else if (_realNode->isDirectory()) {
+		warning("FSNode::createReadOnlyDataStream: '%s' is a directory", getName().c_str());
+		return nullptr;
+	}
+
+	return _realNode->createReadOnlyDataStream();
+}
+
 SeekableWriteStream *FSNode::createWriteStream() const {
 	if (_realNode == nullptr)
 		return nullptr;
@@ -256,7 +287,8 @@ SeekableReadStream *FSDirectory::createReadStreamForMember(const Path &path) con
 	FSNode *node = lookupCache(_fileCache, name);
 	if (!node)
 		return nullptr;
-	SeekableReadStream *stream = node->createReadStream();
+	// Directories searched for members hold game and engine data
+	SeekableReadStream *stream = node->createReadOnlyDataStream();
 	if (!stream)
 		warning("FSDirectory::createReadStreamForMember: Can't create stream for file '%s'", Common::toPrintable(name).c_str());
 
@@ -285,7 +317,7 @@ void FSDirectory::cacheDirectoryRecursive(FSNode node, int depth, const Path& pr
 		return;
 
 	FSList list;
-	node.getChildren(list, FSNode::kListAll);
+	FSListingCache::instance().listChildren(node, list);
 
 	FSList::iterator it = list.begin();
 	for ( ; it != list.end(); ++it) {
@@ -391,4 +423,169 @@ int FSDirectory::listMembers(ArchiveMemberList &list) const {
 }
 
 
+DECLARE_SINGLETON(FSListingCache);
+
+#define LISTINGCACHE_FILENAME "scummvm-dircache.dat"
+#define LISTINGCACHE_VERSION 1
+
+static void writeListingString(WriteStream &stream, const String &str) {
+	stream.writeUint32LE(str.size());
+	stream.writeString(str);
+}
+
+static bool readListingString(SeekableReadStream &stream, String &str) {
+	uint32 len = stream.readUint32LE();
+	if (stream.eos() || len > (uint32)(stream.size() - stream.pos()))
+		return false;
+
+	char *buf = new char[len];
+	stream.read(buf, len);
+	str = String(buf, len);
+	delete[] buf;
+	return !stream.err();
+}
+
+FSListingCache::FSListingCache() : _loaded(false), _dirty(false) {
+}
+
+FSNode FSListingCache::getCacheFile() const {
+	// The snapshot is stored next to the configuration file
+	String configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return FSNode();
+
+	FSNode configNode(configFile);
+	FSNode dir = configNode.getParent();
+	if (dir.getPath() == configNode.getPath() || !dir.isDirectory()) {
+		// Relative configuration file name, use the current directory
+		return FSNode(LISTINGCACHE_FILENAME);
+	}
+
+	return dir.getChild(LISTINGCACHE_FILENAME);
+}
+
+void FSListingCache::load() {
+	_loaded = true;
+
+	FSNode file = getCacheFile();
+	if (!file.exists())
+		return;
+
+	SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != MKTAG('S', 'D', 'I', 'R') || stream->readUint32LE() != LISTINGCACHE_VERSION) {
+		debug(3, "Ignoring directory listing cache '%s' with unknown format", file.getPath().c_str());
+		delete stream;
+		return;
+	}
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		String path;
+		Listing listing;
+
+		if (!readListingString(*stream, path))
+			break;
+		listing.modificationTime = stream->readSint64LE();
+
+		uint32 entryCount = stream->readUint32LE();
+		if (stream->eos() || entryCount > (uint32)(stream->size() - stream->pos()))
+			break;
+
+		listing.entries.resize(entryCount);
+		uint32 j;
+		for (j = 0; j < entryCount; j++) {
+			if (!readListingString(*stream, listing.entries[j].name))
+				break;
+			listing.entries[j].isDirectory = stream->readByte() != 0;
+		}
+		if (j < entryCount || stream->err())
+			break;
+
+		_listings.setVal(path, listing);
+	}
+
+	debug(3, "Loaded %u listings from directory listing cache '%s'", _listings.size(), file.getPath().c_str());
+	delete stream;
+}
+
+bool FSListingCache::listChildren(const FSNode &dir, FSList &list) {
+	int64 modificationTime;
+
+	// The time is taken before listing, so that a change made while listing
+	// makes the stored listing stale
+	if (!ConfMan.hasKey("dir_listing_cache") || !ConfMan.getBool("dir_listing_cache") ||
+	    !dir.isDirectory() || !dir.getModificationTime(modificationTime))
+		return dir.getChildren(list, FSNode::kListAll);
+
+	if (!_loaded)
+		load();
+
+	String path = dir.getPath();
+	ListingMap::iterator i = _listings.find(path);
+	if (i != _listings.end() && i->_value.modificationTime == modificationTime) {
+		const Array<Entry> &entries = i->_value.entries;
+
+		list.clear();
+		list.reserve(entries.size());
+		for (uint j = 0; j < entries.size(); j++)
+			list.push_back(dir.getKnownChild(entries[j].name, entries[j].isDirectory));
+		return true;
+	}
+
+	if (!dir.getChildren(list, FSNode::kListAll)) {
+		if (i != _listings.end()) {
+			_listings.erase(i);
+			_dirty = true;
+		}
+		return false;
+	}
+
+	Listing &listing = _listings[path];
+	listing.modificationTime = modificationTime;
+	listing.entries.resize(list.size());
+	for (uint j = 0; j < list.size(); j++) {
+		// Store the raw names, which are not punycode decoded
+		listing.entries[j].name = list[j]._realNode->getName();
+		listing.entries[j].isDirectory = list[j].isDirectory();
+	}
+	_dirty = true;
+
+	return true;
+}
+
+void FSListingCache::flush() {
+	if (!_dirty)
+		return;
+
+	FSNode file = getCacheFile();
+	SeekableWriteStream *stream = file.createWriteStream();
+	if (!stream) {
+		debug(3, "Could not write directory listing cache '%s'", LISTINGCACHE_FILENAME);
+		return;
+	}
+
+	stream->writeUint32BE(MKTAG('S', 'D', 'I', 'R'));
+	stream->writeUint32LE(LISTINGCACHE_VERSION);
+	stream->writeUint32LE(_listings.size());
+	for (ListingMap::const_iterator i = _listings.begin(); i != _listings.end(); ++i) {
+		writeListingString(*stream, i->_key);
+		stream->writeSint64LE(i->_value.modificationTime);
+		stream->writeUint32LE(i->_value.entries.size());
+		for (uint j = 0; j < i->_value.entries.size(); j++) {
+			writeListingString(*stream, i->_value.entries[j].name);
+			stream->writeByte(i->_value.entries[j].isDirectory ? 1 : 0);
+		}
+	}
+
+	stream->finalize();
+	if (!stream->err())
+		_dirty = false;
+	delete stream;
+}
+
 } // End of namespace Common
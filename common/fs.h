@@ -27,6 +27,7 @@
 #include "common/hash-str.h"
 #include "common/hashmap.h"
 #include "common/ptr.h"
+#include "common/singleton.h"
 #include "common/str.h"
 #include "common/ustr.h"
 
@@ -68,6 +69,7 @@ class FSList : public Array<FSNode> {};
 class FSNode : public ArchiveMember {
 private:
 	friend class ::AbstractFSNode;
+	friend class FSListingCache;
 	SharedPtr<AbstractFSNode>	_realNode;
 	/**
 	 * Construct an FSNode from a backend's AbstractFSNode implementation.
@@ -77,6 +79,13 @@ private:
 	 */
 	FSNode(AbstractFSNode *realNode);
 
+	/**
+	 * Create a node for a child of this directory whose existence and type
+	 * are already known, without querying the file system when the backend
+	 * supports it.
+	 */
+	FSNode getKnownChild(const String &name, bool isDirectory) const;
+
 public:
 	/**
 	 * Flag to tell listDir() which kind of files to list.
@@ -223,6 +232,32 @@ public:
 	 */
 	bool isWritable() const;
 
+	/**
+	 * Retrieve the size and the last modification time of the file referred
+	 * by this node, without opening it.
+	 *
+	 * Not all backends provide this information.
+	 *
+	 * @param size              The size of the file in bytes.
+	 * @param modificationTime  The modification time, in seconds since the epoch.
+	 *
+	 * @return True if the information could be retrieved, false otherwise.
+	 */
+	bool getFileStats(int64 &size, int64 &modificationTime) const;
+
+	/**
+	 * Retrieve the last modification time of the file or directory referred
+	 * by this node. The time of a directory changes when entries are added
+	 * to it, removed from it or renamed.
+	 *
+	 * Not all backends provide this information.
+	 *
+	 * @param modificationTime  The modification time, in seconds since the epoch.
+	 *
+	 * @return True if the information could be retrieved, false otherwise.
+	 */
+	bool getModificationTime(int64 &modificationTime) const;
+
 	/**
 	 * Create a SeekableReadStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -232,6 +267,16 @@ public:
 	 */
 	virtual SeekableReadStream *createReadStream() const;
 
+	/**
+	 * Create a SeekableReadStream instance for a file which is not modified
+	 * while the stream exists, like game data. Depending on the backend, the
+	 * file may be mapped into memory instead of being read, so it must not
+	 * be used for files which are written while being read, like saves.
+	 *
+	 * @return Pointer to the stream object, 0 in case of a failure.
+	 */
+	SeekableReadStream *createReadOnlyDataStream() const;
+
 	/**
 	 * Create a WriteStream instance corresponding to the file
 	 * referred by this node. This assumes that the node actually refers
@@ -395,6 +440,55 @@ public:
 	SeekableReadStream *createReadStreamForMember(const Path &path) const override;
 };
 
+/**
+ * Persistent snapshot of the directory listings made by FSDirectory.
+ *
+ * When the "dir_listing_cache" option is set, the names and types of the
+ * children of each listed directory are stored in scummvm-dircache.dat next
+ * to the configuration file, together with the modification time of the
+ * directory. A directory is only listed again once its modification time
+ * changed, so that caching deep game directories on slow network file
+ * systems only costs one stat per directory. Directories of backends which
+ * do not report modification times are always listed.
+ */
+class FSListingCache : public Singleton<FSListingCache> {
+public:
+	/**
+	 * List all children of a directory, including hidden ones. The listing
+	 * is taken from the snapshot if the directory did not change since.
+	 *
+	 * @return True if successful, false otherwise (e.g. when the directory does not exist).
+	 */
+	bool listChildren(const FSNode &dir, FSList &list);
+
+	/**
+	 * Write the snapshot back to disk, if any listing was added or changed.
+	 */
+	void flush();
+
+private:
+	friend class Singleton<FSListingCache>;
+	FSListingCache();
+
+	struct Entry {
+		String name;
+		bool isDirectory;
+	};
+
+	struct Listing {
+		int64 modificationTime;
+		Array<Entry> entries;
+	};
+
+	typedef HashMap<String, Listing> ListingMap;
+	ListingMap _listings;
+	bool _loaded;
+	bool _dirty;
+
+	FSNode getCacheFile() const;
+	void load();
+};
+
 /** @} */
 
 } // End of namespace Common
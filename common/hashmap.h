@@ -92,6 +92,7 @@ public:
 		Val _value;
 		const Key _key;
 		explicit Node(const Key &key) : _key(key), _value() {}
+		explicit Node(Key &&key) : _key(Common::move(key)), _value() {}
 		Node() : _key(), _value() {}
 	};
 
@@ -136,11 +137,12 @@ private:
 	mutable int _collisions, _lookups, _dummyHits;
 #endif
 
-	Node *allocNode(const Key &key) {
+	template<class K>
+	Node *allocNode(K &&key) {
 #ifdef USE_HASHMAP_MEMORY_POOL
-		return new (_nodePool) Node(key);
+		return new (_nodePool) Node(Common::forward<K>(key));
 #else
-		return new Node(key);
+		return new Node(Common::forward<K>(key));
 #endif
 	}
 
@@ -155,7 +157,8 @@ private:
 
 	void assign(const HM_t &map);
 	size_type lookup(const Key &key) const;
-	size_type lookupAndCreateIfMissing(const Key &key);
+	template<class K>
+	size_type lookupAndCreateIfMissing(K &&key);
 	void expandStorage(size_type newCapacity);
 
 #if !defined(__sgi) || defined(__GNUC__)
@@ -243,15 +246,20 @@ public:
 	bool contains(const Key &key) const;
 
 	Val &operator[](const Key &key);
+	Val &operator[](Key &&key);
 	const Val &operator[](const Key &key) const;
 
 	Val &getOrCreateVal(const Key &key);
+	Val &getOrCreateVal(Key &&key);
 	Val &getVal(const Key &key);
 	const Val &getVal(const Key &key) const;
 	const Val &getValOrDefault(const Key &key) const;
 	const Val &getValOrDefault(const Key &key, const Val &defaultVal) const;
 	bool tryGetVal(const Key &key, Val &out) const;
 	void setVal(const Key &key, const Val &val);
+	void setVal(const Key &key, Val &&val);
+	void setVal(Key &&key, const Val &val);
+	void setVal(Key &&key, Val &&val);
 
 	void clear(bool shrinkArray = 0);
 
@@ -529,7 +537,8 @@ typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, Has
 }
 
 template<class Key, class Val, class HashFunc, class EqualFunc>
-typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(const Key &key) {
+template<class K>
+typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, HashFunc, EqualFunc>::lookupAndCreateIfMissing(K &&key) {
 	const size_type hash = _hash(key);
 	size_type ctr = hash & _mask;
 	const size_type NONE_FOUND = _mask + 1;
@@ -569,8 +578,10 @@ typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, Has
 	if (!found) {
 		if (_storage[ctr])
 			_deleted--;
-		_storage[ctr] = allocNode(key);
-		assert(_storage[ctr] != nullptr);
+		// The key may be moved into the node
+		Node *node = allocNode(Common::forward<K>(key));
+		assert(node != nullptr);
+		_storage[ctr] = node;
 		_size++;
 
 		// Keep the load factor below a certain threshold.
@@ -580,7 +591,7 @@ typename HashMap<Key, Val, HashFunc, EqualFunc>::size_type HashMap<Key, Val, Has
 		        capacity * HASHMAP_LOADFACTOR_NUMERATOR) {
 			capacity = capacity < 500 ? (capacity * 4) : (capacity * 2);
 			expandStorage(capacity);
-			ctr = lookup(key);
+			ctr = lookup(node->_key);
 			assert(_storage[ctr] != nullptr);
 		}
 	}
@@ -607,6 +618,15 @@ Val &HashMap<Key, Val, HashFunc, EqualFunc>::operator[](const Key &key) {
 	return getOrCreateVal(key);
 }
 
+/**
+ * @overload
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &HashMap<Key, Val, HashFunc, EqualFunc>::operator[](Key &&key) {
+	return getOrCreateVal(Common::move(key));
+}
+
 /**
  * @overload
  */
@@ -627,6 +647,17 @@ Val &HashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(const Key &key) {
 	return _storage[ctr]->_value;
 }
 
+/**
+ * @overload
+ */
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+Val &HashMap<Key, Val, HashFunc, EqualFunc>::getOrCreateVal(Key &&key) {
+	size_type ctr = lookupAndCreateIfMissing(Common::move(key));
+	assert(_storage[ctr] != nullptr);
+	return _storage[ctr]->_value;
+}
+
 /**
  * @overload
  */
@@ -704,6 +735,27 @@ void HashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, const Val &v
 	_storage[ctr]->_value = val;
 }
 
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void HashMap<Key, Val, HashFunc, EqualFunc>::setVal(const Key &key, Val &&val) {
+	size_type ctr = lookupAndCreateIfMissing(key);
+	assert(_storage[ctr] != nullptr);
+	_storage[ctr]->_value = Common::move(val);
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void HashMap<Key, Val, HashFunc, EqualFunc>::setVal(Key &&key, const Val &val) {
+	size_type ctr = lookupAndCreateIfMissing(Common::move(key));
+	assert(_storage[ctr] != nullptr);
+	_storage[ctr]->_value = val;
+}
+
+template<class Key, class Val, class HashFunc, class EqualFunc>
+void HashMap<Key, Val, HashFunc, EqualFunc>::setVal(Key &&key, Val &&val) {
+	size_type ctr = lookupAndCreateIfMissing(Common::move(key));
+	assert(_storage[ctr] != nullptr);
+	_storage[ctr]->_value = Common::move(val);
+}
+
 /**
  * Erase an element referred to by an iterator.
  */
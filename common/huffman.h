@@ -54,6 +54,10 @@ inline uint32 REVERSEBITS(uint32 x) {
 /**
  * Huffman bit stream decoding.
  *
+ * Codes are decoded with lookup tables: a first one indexed by the next
+ * _prefixTableBits bits of the stream, and for codes longer than that,
+ * second level tables indexed by the bits following them. Only codes which
+ * are too long for the second level tables are searched for bit by bit.
  */
 template<class BITSTREAM>
 class Huffman {
@@ -82,19 +86,64 @@ private:
 	typedef List<Symbol> CodeList;
 	typedef Array<CodeList> CodeLists;
 
-	/** Lists of codes and their symbols, sorted by code length. */
+	/** Lists of the codes too long for the lookup tables and their symbols, sorted by code length. */
 	CodeLists _codes;
 
-	/** Prefix lookup table used to speed up the decoding of short codes. */
+	/**
+	 * Lookup table entry.
+	 *
+	 * In the first level table, a length of 0 marks a prefix of longer
+	 * codes. The symbol is then the offset of the second level table of
+	 * the prefix in _subTables, and subTableBits its size. In the second
+	 * level tables, the length does not include the prefix.
+	 */
 	struct PrefixEntry {
 		uint32 symbol;
 		uint8  length;
+		uint8  subTableBits;
 
-		PrefixEntry() : length(0xFF) {}
+		PrefixEntry() : symbol(0), length(0xFF), subTableBits(0) {}
 	};
 
 	static const uint8 _prefixTableBits = 8;
+	static const uint8 _maxSubTableBits = 8;
 	PrefixEntry _prefixTable[1 << _prefixTableBits];
+	Array<PrefixEntry> _subTables;
+
+	/** Return the first @p prefixLength bits of a code, as they are peeked from the stream. */
+	static uint32 getCodePrefix(uint32 code, uint8 length, uint8 prefixLength) {
+		if (BITSTREAM::isMSB2LSB())
+			return code >> (length - prefixLength);
+		else
+			return code & ((1 << prefixLength) - 1);
+	}
+
+	/** Return the bits of a code after its first @p prefixLength bits. */
+	static uint32 getCodeSuffix(uint32 code, uint8 length, uint8 prefixLength) {
+		if (BITSTREAM::isMSB2LSB())
+			return code & ((1 << (length - prefixLength)) - 1);
+		else
+			return code >> prefixLength;
+	}
+
+	/**
+	 * Set all the entries of a lookup table with @p tableBits index bits
+	 * that start with the given code.
+	 */
+	static void fillTable(PrefixEntry *table, uint8 tableBits, uint32 code, uint8 length, uint8 entryLength, uint32 symbol) {
+		const uint32 count = 1 << (tableBits - length);
+
+		for (uint32 j = 0; j < count; j++) {
+			uint32 index;
+			if (BITSTREAM::isMSB2LSB())
+				index = (code << (tableBits - length)) | j;
+			else
+				index = code | (j << length);
+
+			table[index].symbol = symbol;
+			table[index].length = entryLength;
+		}
+	}
 };
 
 template <class BITSTREAM>
@@ -110,8 +159,31 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 
 	assert(maxLength <= 32);
 
-	// Codes that do not fit in the prefix table are stored in the _codes array.
-	_codes.resize(MAX(maxLength - _prefixTableBits, 0));
+	// Find out how many bits follow the prefix in the longest code with
+	// each prefix, which determines the size of its second level table
+	uint8 subTableBits[1 << _prefixTableBits];
+	memset(subTableBits, 0, sizeof(subTableBits));
+
+	for (uint i = 0; i < codeCount; i++) {
+		if (lengths[i] > _prefixTableBits) {
+			const uint32 prefix = getCodePrefix(codes[i], lengths[i], _prefixTableBits);
+			subTableBits[prefix] = MAX<uint8>(subTableBits[prefix], MIN<uint8>(lengths[i] - _prefixTableBits, _maxSubTableBits));
+		}
+	}
+
+	uint32 subTablesSize = 0;
+	for (uint32 prefix = 0; prefix < (1 << _prefixTableBits); prefix++) {
+		if (subTableBits[prefix]) {
+			_prefixTable[prefix].symbol = subTablesSize;
+			_prefixTable[prefix].length = 0;
+			_prefixTable[prefix].subTableBits = subTableBits[prefix];
+			subTablesSize += 1 << subTableBits[prefix];
+		}
+	}
+	_subTables.resize(subTablesSize);
+
+	// Codes that do not fit in the lookup tables are stored in the _codes array.
+	_codes.resize(MAX(maxLength - _prefixTableBits - _maxSubTableBits, 0));
 
 	for (uint i = 0; i < codeCount; i++) {
 		uint8 length = lengths[i];
@@ -122,23 +194,18 @@ Huffman<BITSTREAM>::Huffman(uint8 maxLength, uint32 codeCount, const uint32 *cod
 		if (length <= _prefixTableBits) {
 			// Short codes go in the prefix lookup table. Set all the entries in the table
 			// with an index starting with the code to the symbol value.
-			uint32 startIndex;
-			if (BITSTREAM::isMSB2LSB()) {
-				startIndex = codes[i] << (_prefixTableBits - length);
-			} else {
-				startIndex = REVERSEBITS(codes[i]) >> (32 - _prefixTableBits);
-			}
-
-			uint32 endIndex = startIndex | ((1 << (_prefixTableBits - length)) - 1);
+			fillTable(_prefixTable, _prefixTableBits, codes[i], length, length, symbol);
+		} else {
+			const PrefixEntry &prefixEntry = _prefixTable[getCodePrefix(codes[i], length, _prefixTableBits)];
+			const uint8 suffixLength = length - _prefixTableBits;
 
-			for (uint32 j = startIndex; j <= endIndex; j++) {
-				uint32 index = BITSTREAM::isMSB2LSB() ? j : REVERSEBITS(j) >> (32 - _prefixTableBits);
-				_prefixTable[index].symbol = symbol;
-				_prefixTable[index].length = length;
+			if (suffixLength <= prefixEntry.subTableBits) {
+				fillTable(&_subTables[prefixEntry.symbol], prefixEntry.subTableBits,
+				          getCodeSuffix(codes[i], length, _prefixTableBits), suffixLength, suffixLength, symbol);
+			} else {
+				// Put the code and symbol into the correct list for the length.
+				_codes[length - 1 - _prefixTableBits - _maxSubTableBits].push_back(Symbol(codes[i], symbol));
 			}
-		} else {
-			// Put the code and symbol into the correct list for the length.
-			_codes[lengths[i] - 1 - _prefixTableBits].push_back(Symbol(codes[i], symbol));
 		}
 	}
 }
@@ -147,16 +214,37 @@ template <class BITSTREAM>
 uint32 Huffman<BITSTREAM>::getSymbol(BITSTREAM &bits) const {
 	uint32 code = bits.peekBits(_prefixTableBits);
 
-	uint8 length = _prefixTable[code].length;
+	const PrefixEntry &prefixEntry = _prefixTable[code];
+
+	if (prefixEntry.length != 0xFF && prefixEntry.length != 0) {
+		bits.skip(prefixEntry.length);
+		return prefixEntry.symbol;
+	}
+
+	bits.skip(_prefixTableBits);
+
+	if (prefixEntry.length == 0) {
+		const uint32 suffix = bits.peekBits(prefixEntry.subTableBits);
+		const PrefixEntry &subEntry = _subTables[prefixEntry.symbol + suffix];
+
+		if (subEntry.length != 0xFF) {
+			bits.skip(subEntry.length);
+			return subEntry.symbol;
+		}
+
+		// Only codes longer than the second level table can be left,
+		// which only exist if the table has the maximum size
+		if (prefixEntry.subTableBits != _maxSubTableBits)
+			error("Unknown Huffman code");
 
-	if (length != 0xFF) {
-		bits.skip(length);
-		return _prefixTable[code].symbol;
-	} else {
-		bits.skip(_prefixTableBits);
+		bits.skip(_maxSubTableBits);
+		if (BITSTREAM::isMSB2LSB())
+			code = (code << _maxSubTableBits) | suffix;
+		else
+			code |= suffix << _prefixTableBits;
 
 		for (uint32 i = 0; i < _codes.size(); i++) {
-			bits.addBit(code, i + _prefixTableBits);
+			bits.addBit(code, i + _prefixTableBits + _maxSubTableBits);
 
 			for (typename CodeList::const_iterator cCode = _codes[i].begin(); cCode != _codes[i].end(); ++cCode)
 				if (code == cCode->code)
@@ -248,8 +248,8 @@ SeekableReadStream *InstallShieldCabinet::createReadStreamForMember(const Path &
 
 	if (!(entry.flags & 0x04)) {
 		// Uncompressed
-		// Return a substream
-		return new SeekableSubReadStream(stream.release(), entry.offset, entry.offset + entry.uncompressedSize, DisposeAfterUse::YES);
+		// Return a substream, which is a plain view for memory mapped volumes
+		return createSharedSubReadStream(SharedPtr<SeekableReadStream>(stream.release()), entry.offset, entry.offset + entry.uncompressedSize);
 	}
 
 	stream->seek(entry.offset);
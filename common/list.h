@@ -23,6 +23,7 @@
 #define COMMON_LIST_H
 
 #include "common/list_intern.h"
+#include "common/memory.h"
 
 namespace Common {
 
@@ -38,10 +39,10 @@ namespace Common {
 
 /**
  * Simple doubly linked list, modeled after the list template of the standard
- * C++ library.
+ * C++ library. The nodes are obtained from @p t_Alloc, see DefaultAllocator.
  */
-template<typename t_T>
-class List {
+template<typename t_T, class t_Alloc = DefaultAllocator>
+class List : private t_Alloc {
 protected:
 	typedef ListInternal::NodeBase		NodeBase; /*!< @todo Doc required. */
 	typedef ListInternal::Node<t_T>		Node;     /*!< An element of the doubly linked list. */
@@ -63,12 +64,25 @@ public:
 		_anchor._prev = &_anchor;
 		_anchor._next = &_anchor;
 	}
-	List(const List<t_T> &list) {  /*!< Construct a new list as a copy of the given @p list. */
+	/**
+	 * Construct a new empty list which allocates its nodes from @p alloc.
+	 */
+	explicit List(const t_Alloc &alloc) : t_Alloc(alloc) {
+		_anchor._prev = &_anchor;
+		_anchor._next = &_anchor;
+	}
+	List(const List &list) : t_Alloc(list) {  /*!< Construct a new list as a copy of the given @p list. */
 		_anchor._prev = &_anchor;
 		_anchor._next = &_anchor;
 
 		insert(begin(), list.begin(), list.end());
 	}
+	List(List &&list) : t_Alloc(list) {  /*!< Construct a new list by taking over the elements of the given @p list, which is left empty. */
+		_anchor._prev = &_anchor;
+		_anchor._next = &_anchor;
+
+		takeNodes(list);
+	}
 
 	~List() {
 		clear();
@@ -81,6 +95,22 @@ public:
 		insert(pos._node, element);
 	}
 
+	/**
+	 * Insert an @p element before @p pos, moving it.
+	 */
+	void insert(iterator pos, t_T &&element) {
+		emplace(pos._node, Common::move(element));
+	}
+
+	/**
+	 * Construct an element before @p pos, from the given constructor
+	 * arguments, and return an iterator pointing to it.
+	 */
+	template<class... TArgs>
+	iterator emplace(iterator pos, TArgs &&...args) {
+		return iterator(emplace(pos._node, Common::forward<TArgs>(args)...));
+	}
+
 	/**
 	 * Insert elements from @p first to @p last before @p pos.
 	 */
@@ -138,11 +168,33 @@ public:
 		insert(_anchor._next, element);
 	}
 
+	/** Insert an @p element at the start of the list, moving it. */
+	void push_front(t_T &&element) {
+		emplace(_anchor._next, Common::move(element));
+	}
+
+	/** Construct an element at the start of the list, from the given constructor arguments. */
+	template<class... TArgs>
+	t_T &emplace_front(TArgs &&...args) {
+		return static_cast<Node *>(emplace(_anchor._next, Common::forward<TArgs>(args)...))->_data;
+	}
+
 	/** Append an @p element to the end of the list. */
 	void push_back(const t_T &element) {
 		insert(&_anchor, element);
 	}
 
+	/** Append an @p element to the end of the list, moving it. */
+	void push_back(t_T &&element) {
+		emplace(&_anchor, Common::move(element));
+	}
+
+	/** Construct an element at the end of the list, from the given constructor arguments. */
+	template<class... TArgs>
+	t_T &emplace_back(TArgs &&...args) {
+		return static_cast<Node *>(emplace(&_anchor, Common::forward<TArgs>(args)...))->_data;
+	}
+
 	/** Remove the first element of the list. */
 	void pop_front() {
 		assert(!empty());
@@ -176,7 +228,7 @@ public:
 	}
 
 	/** Assign a given @p list to this list. */
-	List<t_T> &operator=(const List<t_T> &list) {
+	List &operator=(const List &list) {
 		if (this != &list) {
 			iterator i;
 			const iterator e = end();
@@ -196,6 +248,17 @@ public:
 		return *this;
 	}
 
+	/** Assign a given @p list to this list, taking over its elements and leaving it empty. */
+	List &operator=(List &&list) {
+		if (this != &list) {
+			clear();
+			static_cast<t_Alloc &>(*this) = static_cast<const t_Alloc &>(list);
+			takeNodes(list);
+		}
+
+		return *this;
+	}
+
 	/** Return the size of the list. */
 	size_type size() const {
 		size_type n = 0;
@@ -210,7 +273,7 @@ public:
 		while (pos != &_anchor) {
 			Node *node = static_cast<Node *>(pos);
 			pos = pos->_next;
-			delete node;
+			destroyNode(node);
 		}
 
 		_anchor._prev = &_anchor;
@@ -273,7 +336,7 @@ protected:
 		Node *node = static_cast<Node *>(pos);
 		n._prev->_next = n._next;
 		n._next->_prev = n._prev;
-		delete node;
+		destroyNode(node);
 		return n;
 	}
 
@@ -281,13 +344,48 @@ protected:
 	 * Insert an @p element before @p pos.
 	 */
 	void insert(NodeBase *pos, const t_T &element) {
-		ListInternal::NodeBase *newNode = new Node(element);
-		assert(newNode);
+		emplace(pos, element);
+	}
+
+	/**
+	 * Construct an element before @p pos, from the given constructor arguments.
+	 */
+	template<class... TArgs>
+	NodeBase *emplace(NodeBase *pos, TArgs &&...args) {
+		void *mem = t_Alloc::allocate(sizeof(Node));
+		assert(mem);
+		ListInternal::NodeBase *newNode = new (mem) Node(Common::forward<TArgs>(args)...);
 
 		newNode->_next = pos;
 		newNode->_prev = pos->_prev;
 		newNode->_prev->_next = newNode;
 		newNode->_next->_prev = newNode;
+		return newNode;
+	}
+
+	/**
+	 * Destroy a @p node and release its memory.
+	 */
+	void destroyNode(Node *node) {
+		node->~Node();
+		t_Alloc::deallocate(node);
+	}
+
+	/**
+	 * Take over the nodes of @p list, which is left empty. This list must
+	 * be empty.
+	 */
+	void takeNodes(List &list) {
+		if (list.empty())
+			return;
+
+		_anchor._next = list._anchor._next;
+		_anchor._prev = list._anchor._prev;
+		_anchor._next->_prev = &_anchor;
+		_anchor._prev->_next = &_anchor;
+
+		list._anchor._prev = &list._anchor;
+		list._anchor._next = &list._anchor;
 	}
 };
 
@@ -23,12 +23,10 @@
 #define COMMON_LIST_INTERN_H
 
 #include "common/scummsys.h"
+#include "common/type-traits.h"
 
 namespace Common {
 
-template<typename T> class List;
-
-
 namespace ListInternal {
 	struct NodeBase {
 		NodeBase *_prev;
@@ -39,7 +37,8 @@ namespace ListInternal {
 	struct Node : public NodeBase {
 		T _data;
 
-		Node(const T &x) : _data(x) {}
+		template<class... TArgs>
+		explicit Node(TArgs &&...args) : _data(Common::forward<TArgs>(args)...) {}
 	};
 
 	template<typename T> struct ConstIterator;
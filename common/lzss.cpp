@@ -0,0 +1,103 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/lzss.h"
+#include "common/endian.h"
+#include "common/stream.h"
+#include "common/util.h"
+
+namespace Common {
+
+static uint32 decompressLZSSBuffer(const byte *in, const byte *inEnd, byte *dest, uint32 unpackedSize, uint lengthBits, uint minLength, uint distanceBias) {
+	const uint32 windowSize = 1 << (16 - lengthBits);
+	const uint lengthMask = (1 << lengthBits) - 1;
+	byte *out = dest;
+	byte *const outEnd = dest + unpackedSize;
+
+	while (out < outEnd && in < inEnd) {
+		uint flags = *in++;
+
+		for (uint i = 0; i < 8 && out < outEnd; i++, flags >>= 1) {
+			if (flags & 1) {
+				if (in == inEnd)
+					return out - dest;
+				*out++ = *in++;
+				continue;
+			}
+
+			if (inEnd - in < 2)
+				return out - dest;
+
+			const uint16 reference = READ_LE_UINT16(in);
+			in += 2;
+
+			uint32 length = (reference & lengthMask) + minLength;
+			uint32 distance = (reference >> lengthBits) + distanceBias;
+			if (!distance)
+				distance = windowSize;
+
+			if (length > (uint32)(outEnd - out))
+				return out - dest;
+
+			const uint32 pos = out - dest;
+			if (distance > pos) {
+				const uint32 zeros = MIN(distance - pos, length);
+				memset(out, 0, zeros);
+				out += zeros;
+				length -= zeros;
+			}
+
+			const byte *match = out - distance;
+			if (distance >= length) {
+				memcpy(out, match, length);
+			} else if (distance == 1) {
+				memset(out, *match, length);
+			} else {
+				// The match overlaps the bytes it writes, and repeats the
+				// last `distance` bytes
+				for (uint32 j = 0; j < length; j++)
+					out[j] = match[j];
+			}
+			out += length;
+		}
+	}
+
+	return out - dest;
+}
+
+uint32 decompressLZSS(ReadStream *src, uint32 packedSize, byte *dest, uint32 unpackedSize, uint lengthBits, uint minLength, uint distanceBias) {
+	assert(lengthBits > 0 && lengthBits < 16);
+
+	// The compressed data is read in one go, so that the inner loop does not
+	// go through the stream for every byte
+	byte *packed = (byte *)malloc(packedSize);
+	if (!packed)
+		return 0;
+
+	packedSize = src->read(packed, packedSize);
+	const uint32 size = decompressLZSSBuffer(packed, packed + packedSize, dest, unpackedSize, lengthBits, minLength, distanceBias);
+
+	free(packed);
+	return size;
+}
+
+} // End of namespace Common
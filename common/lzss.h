@@ -0,0 +1,69 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_LZSS_H
+#define COMMON_LZSS_H
+
+#include "common/scummsys.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_lzss LZSS decompression
+ * @ingroup common
+ *
+ * @brief  Decompressor for the common LZSS variant with relative offsets.
+ *
+ * @details Each group of eight items is preceded by a flag byte, read from the
+ *          lowest bit up. A set bit stands for a literal byte, a cleared bit for
+ *          a little-endian 16-bit reference to earlier output. Used in engines:
+ *          - Star Trek
+ *          - TwinE
+ * @{
+ */
+
+class ReadStream;
+
+/**
+ * Decompress LZSS data with references relative to the current position.
+ *
+ * The low @p lengthBits bits of a reference hold the length of the match,
+ * minus @p minLength, and the other bits its distance back into the output,
+ * minus @p distanceBias. A distance of 0 refers back a whole window of
+ * 1 << (16 - lengthBits) bytes, and bytes before the start of the output
+ * read as 0, as if the window had been cleared first.
+ *
+ * @param src           Stream to read the compressed data from.
+ * @param packedSize    Size of the compressed data.
+ * @param dest          Buffer for the decompressed data.
+ * @param unpackedSize  Size of the decompressed data.
+ *
+ * @return The number of bytes written to @p dest. This is less than
+ *         @p unpackedSize if the compressed data ends early or is invalid.
+ */
+uint32 decompressLZSS(ReadStream *src, uint32 packedSize, byte *dest, uint32 unpackedSize, uint lengthBits, uint minLength, uint distanceBias = 0);
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
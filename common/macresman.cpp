@@ -27,6 +27,7 @@
 #include "common/fs.h"
 #include "common/macresman.h"
 #include "common/md5.h"
+#include "common/memstream.h"
 #include "common/substream.h"
 #include "common/textconsole.h"
 #include "common/archive.h"
@@ -72,6 +73,9 @@ void MacResManager::close() {
 	_mode = kResForkNone;
 
 	for (int i = 0; i < _resMap.numTypes; i++) {
+		if (!_resLists[i])
+			continue;
+
 		for (int j = 0; j < _resTypes[i].items; j++)
 			if (_resLists[i][j].nameOffset != -1)
 				delete[] _resLists[i][j].name;
@@ -81,7 +85,7 @@ void MacResManager::close() {
 
 	delete[] _resLists; _resLists = nullptr;
 	delete[] _resTypes; _resTypes = nullptr;
-	delete _stream; _stream = nullptr;
+	_streamRef.reset(); _stream = nullptr;
 	_resMap.numTypes = 0;
 }
 
@@ -191,6 +195,7 @@ bool MacResManager::open(const Path &fileName, Archive &archive) {
 
 		stream->seek(0);
 		_stream = stream;
+		_streamRef.reset(stream);
 		return true;
 	}
 
@@ -424,6 +429,7 @@ bool MacResManager::load(SeekableReadStream &stream) {
 		_dataOffset, _dataLength, _mapOffset, _mapLength);
 
 	_stream = &stream;
+	_streamRef.reset(&stream);
 
 	readMap();
 	return true;
@@ -448,22 +454,17 @@ SeekableReadStream *MacResManager::getDataFork() {
 }
 
 MacResIDArray MacResManager::getResIDArray(uint32 typeID) {
-	int typeNum = -1;
+	int typeNum = findType(typeID);
 	MacResIDArray res;
 
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
-
 	if (typeNum == -1)
 		return res;
 
+	const ResPtr resList = getResList(typeNum);
 	res.resize(_resTypes[typeNum].items);
 
 	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		res[i] = _resLists[typeNum][i].id;
+		res[i] = resList[i].id;
 
 	return res;
 }
@@ -483,69 +484,39 @@ MacResTagArray MacResManager::getResTagArray() {
 }
 
 String MacResManager::getResName(uint32 typeID, uint16 resID) const {
-	int typeNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
+	int typeNum = findType(typeID);
 
 	if (typeNum == -1)
 		return "";
 
+	const ResPtr resList = getResList(typeNum);
 	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID)
-			return _resLists[typeNum][i].name;
+		if (resList[i].id == resID)
+			return resList[i].name;
 
 	return "";
 }
 
 SeekableReadStream *MacResManager::getResource(uint32 typeID, uint16 resID) {
-	int typeNum = -1;
-	int resNum = -1;
-
-	for (int i = 0; i < _resMap.numTypes; i++)
-		if (_resTypes[i].id == typeID) {
-			typeNum = i;
-			break;
-		}
+	int typeNum = findType(typeID);
 
 	if (typeNum == -1)
 		return nullptr;
 
+	const ResPtr resList = getResList(typeNum);
 	for (int i = 0; i < _resTypes[typeNum].items; i++)
-		if (_resLists[typeNum][i].id == resID) {
-			resNum = i;
-			break;
-		}
+		if (resList[i].id == resID)
+			return readResource(resList[i]);
 
-	if (resNum == -1)
-		return nullptr;
-
-	_stream->seek(_dataOffset + _resLists[typeNum][resNum].dataOffset);
-	uint32 len = _stream->readUint32BE();
-
-	// Ignore resources with 0 length
-	if (!len)
-		return nullptr;
-
-	return _stream->readStream(len);
+	return nullptr;
 }
 
 SeekableReadStream *MacResManager::getResource(const String &fileName) {
 	for (uint32 i = 0; i < _resMap.numTypes; i++) {
+		const ResPtr resList = getResList(i);
 		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
-
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
-
-				return _stream->readStream(len);
-			}
+			if (resList[j].nameOffset != -1 && fileName.equalsIgnoreCase(resList[j].name))
+				return readResource(resList[j]);
 		}
 	}
 
@@ -557,23 +528,49 @@ SeekableReadStream *MacResManager::getResource(uint32 typeID, const String &file
 		if (_resTypes[i].id != typeID)
 			continue;
 
+		const ResPtr resList = getResList(i);
 		for (uint32 j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1 && fileName.equalsIgnoreCase(_resLists[i][j].name)) {
-				_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
-				uint32 len = _stream->readUint32BE();
-
-				// Ignore resources with 0 length
-				if (!len)
-					return nullptr;
-
-				return _stream->readStream(len);
-			}
+			if (resList[j].nameOffset != -1 && fileName.equalsIgnoreCase(resList[j].name))
+				return readResource(resList[j]);
 		}
 	}
 
 	return nullptr;
 }
 
+namespace {
+
+/**
+ * Resource data inside a resource fork which is held in memory, for example
+ * because the file was memory mapped. It keeps the fork alive, so it stays
+ * valid after the MacResManager is closed.
+ */
+class MacResourceReadStream : public MemoryReadStream {
+public:
+	MacResourceReadStream(const SharedPtr<SeekableReadStream> &fork, const byte *data, uint32 size)
+		: MemoryReadStream(data, size), _fork(fork) {}
+
+private:
+	SharedPtr<SeekableReadStream> _fork;
+};
+
+} // End of anonymous namespace
+
+SeekableReadStream *MacResManager::readResource(const Resource &res) {
+	_stream->seek(_dataOffset + res.dataOffset);
+	uint32 len = _stream->readUint32BE();
+
+	// Ignore resources with 0 length
+	if (!len)
+		return nullptr;
+
+	MemoryReadStream *memStream = dynamic_cast<MemoryReadStream *>(_stream);
+	if (memStream && _stream->pos() + len <= _stream->size())
+		return new MacResourceReadStream(_streamRef, memStream->getData() + _stream->pos(), len);
+
+	return _stream->readStream(len);
+}
+
 void MacResManager::readMap() {
 	_stream->seek(_mapOffset + 22);
 
@@ -595,36 +592,53 @@ void MacResManager::readMap() {
 		debug(8, "resType: <%s> items: %d offset: %d (0x%x)", tag2str(_resTypes[i].id), _resTypes[i].items,  _resTypes[i].offset, _resTypes[i].offset);
 	}
 
+	// The resources of each type are only read once they are asked for
 	_resLists = new ResPtr[_resMap.numTypes];
+	for (int i = 0; i < _resMap.numTypes; i++)
+		_resLists[i] = nullptr;
+}
 
-	for (int i = 0; i < _resMap.numTypes; i++) {
-		_resLists[i] = new Resource[_resTypes[i].items];
-		_stream->seek(_resTypes[i].offset + _mapOffset + _resMap.typeOffset);
+int MacResManager::findType(uint32 typeID) const {
+	for (int i = 0; i < _resMap.numTypes; i++)
+		if (_resTypes[i].id == typeID)
+			return i;
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			ResPtr resPtr = _resLists[i] + j;
+	return -1;
+}
 
-			resPtr->id = _stream->readUint16BE();
-			resPtr->nameOffset = _stream->readUint16BE();
-			resPtr->dataOffset = _stream->readUint32BE();
-			_stream->readUint32BE();
-			resPtr->name = nullptr;
+MacResManager::ResPtr MacResManager::getResList(int typeNum) const {
+	if (_resLists[typeNum])
+		return _resLists[typeNum];
 
-			resPtr->attr = resPtr->dataOffset >> 24;
-			resPtr->dataOffset &= 0xFFFFFF;
-		}
+	ResPtr resList = new Resource[_resTypes[typeNum].items];
+	_stream->seek(_resTypes[typeNum].offset + _mapOffset + _resMap.typeOffset);
 
-		for (int j = 0; j < _resTypes[i].items; j++) {
-			if (_resLists[i][j].nameOffset != -1) {
-				_stream->seek(_resLists[i][j].nameOffset + _mapOffset + _resMap.nameOffset);
+	for (int j = 0; j < _resTypes[typeNum].items; j++) {
+		ResPtr resPtr = resList + j;
 
-				byte len = _stream->readByte();
-				_resLists[i][j].name = new char[len + 1];
-				_resLists[i][j].name[len] = 0;
-				_stream->read(_resLists[i][j].name, len);
-			}
+		resPtr->id = _stream->readUint16BE();
+		resPtr->nameOffset = _stream->readUint16BE();
+		resPtr->dataOffset = _stream->readUint32BE();
+		_stream->readUint32BE();
+		resPtr->name = nullptr;
+
+		resPtr->attr = resPtr->dataOffset >> 24;
+		resPtr->dataOffset &= 0xFFFFFF;
+	}
+
+	for (int j = 0; j < _resTypes[typeNum].items; j++) {
+		if (resList[j].nameOffset != -1) {
+			_stream->seek(resList[j].nameOffset + _mapOffset + _resMap.nameOffset);
+
+			byte len = _stream->readByte();
+			resList[j].name = new char[len + 1];
+			resList[j].name[len] = 0;
+			_stream->read(resList[j].name, len);
 		}
 	}
+
+	_resLists[typeNum] = resList;
+	return resList;
 }
 
 Path MacResManager::constructAppleDoubleName(Path name) {
@@ -679,8 +693,9 @@ void MacResManager::dumpRaw() {
 	Common::DumpFile out;
 
 	for (int i = 0; i < _resMap.numTypes; i++) {
+		const ResPtr resList = getResList(i);
 		for (int j = 0; j < _resTypes[i].items; j++) {
-			_stream->seek(_dataOffset + _resLists[i][j].dataOffset);
+			_stream->seek(_dataOffset + resList[j].dataOffset);
 			uint32 len = _stream->readUint32BE();
 
 			if (dataSize < len) {
@@ -26,6 +26,7 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/ptr.h"
 #include "common/str.h"
 #include "common/str-array.h"
 
@@ -222,6 +223,7 @@ public:
 
 private:
 	SeekableReadStream *_stream;
+	SharedPtr<SeekableReadStream> _streamRef; ///< Owns _stream, shared with the resource streams pointing into it
 	Path _baseFileName;
 
 	bool load(SeekableReadStream &stream);
@@ -280,6 +282,24 @@ private:
 
 	typedef Resource *ResPtr;
 
+	/**
+	 * Find the index of a resource type.
+	 * @return The index, or -1 if the resource fork has no such type
+	 */
+	int findType(uint32 typeID) const;
+
+	/**
+	 * Get the references of all resources of a type, parsing them from the
+	 * resource map on first use.
+	 */
+	ResPtr getResList(int typeNum) const;
+
+	/**
+	 * Create a stream for the data of a resource. When the resource fork is
+	 * held in memory, the stream points into it instead of copying the data.
+	 */
+	SeekableReadStream *readResource(const Resource &res);
+
 	int32 _resForkOffset;
 	uint32 _resForkSize;
 
@@ -289,7 +309,7 @@ private:
 	uint32 _mapLength;
 	ResMap _resMap;
 	ResType *_resTypes;
-	ResPtr  *_resLists;
+	ResPtr  *_resLists; ///< Entries are nullptr until the type is first used
 };
 
 /** @} */
@@ -23,6 +23,7 @@
 #define COMMON_MEMORY_H
 
 #include "common/scummsys.h"
+#include "common/type-traits.h"
 
 namespace Common {
 
@@ -46,6 +47,19 @@ Type *uninitialized_copy(In first, In last, Type *dst) {
 	return dst;
 }
 
+/**
+ * Moves data from the range [first, last) to [dst, dst + (last - first)).
+ * It requires the range [dst, dst + (last - first)) to be valid and
+ * uninitialized. The source elements are left in a moved-from state, and
+ * still need to be destroyed.
+ */
+template<class In, class Type>
+Type *uninitialized_move(In first, In last, Type *dst) {
+	while (first != last)
+		new ((void *)dst++) Type(Common::move(*first++));
+	return dst;
+}
+
 /**
  * Initializes the memory [first, first + (last - first)) with the value x.
  * It requires the range [first, first + (last - first)) to be valid and
@@ -68,6 +82,21 @@ void uninitialized_fill_n(Type *dst, size_t n, const Value &x) {
 		new ((void *)dst++) Type(x);
 }
 
+/**
+ * The allocator used by default by the containers, which gets its memory
+ * from malloc().
+ *
+ * An allocator provides allocate(), which returns a block of at least the
+ * given number of bytes suitably aligned for any type or nullptr on
+ * failure, and deallocate(), which releases a block returned by allocate().
+ * Containers hold a copy of their allocator, so allocators should be cheap
+ * to copy.
+ */
+struct DefaultAllocator {
+	void *allocate(size_t size) { return malloc(size); }
+	void deallocate(void *ptr) { free(ptr); }
+};
+
 /** @} */
 
 } // End of namespace Common
@@ -42,9 +42,9 @@ namespace Common {
  *
  * Using a memory pool may yield better performance and memory usage
  * when allocating and deallocating many memory blocks of equal size.
- * E.g. the Common::String class uses a memory pool for the refCount
- * variables (each the size of an int) it allocates for each string
- * instance.
+ * E.g. the Common::HashMap class uses a memory pool for its nodes.
+ *
+ * A memory pool is not thread-safe.
  */
 class MemoryPool {
 protected:
@@ -78,6 +78,12 @@ public:
 	int64 size() const { return _size; }
 
 	bool seek(int64 offs, int whence = SEEK_SET);
+
+	/**
+	 * Return a pointer to the whole memory block wrapped by this stream.
+	 * This lets callers access the data without copying it.
+	 */
+	const byte *getData() const { return _ptrOrig; }
 };
 
 
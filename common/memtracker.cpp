@@ -0,0 +1,75 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/memtracker.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(MemoryTracker);
+
+MemoryTracker::MemoryTracker() : _budget(0), _shrinking(false) {
+}
+
+void MemoryTracker::registerConsumer(MemoryConsumer *consumer, Priority priority) {
+	// Keep the caches sorted by priority, and in registration order within one
+	uint i = 0;
+	while (i < _consumers.size() && _consumers[i].priority <= priority)
+		i++;
+
+	Consumer entry = { consumer, priority };
+	_consumers.insert_at(i, entry);
+}
+
+void MemoryTracker::unregisterConsumer(MemoryConsumer *consumer) {
+	for (uint i = 0; i < _consumers.size(); i++) {
+		if (_consumers[i].consumer == consumer) {
+			_consumers.remove_at(i);
+			return;
+		}
+	}
+}
+
+size_t MemoryTracker::getTotalUsage() const {
+	size_t total = 0;
+	for (uint i = 0; i < _consumers.size(); i++)
+		total += _consumers[i].consumer->getMemoryUsage();
+	return total;
+}
+
+void MemoryTracker::checkBudget() {
+	// A cache may grow again while it is shrunk, so do not recurse
+	if (!_budget || _shrinking)
+		return;
+
+	size_t total = getTotalUsage();
+	if (total <= _budget)
+		return;
+
+	_shrinking = true;
+	for (uint i = 0; i < _consumers.size() && total > _budget; i++) {
+		if (_consumers[i].consumer->shrinkMemoryUsage(total - _budget))
+			total = getTotalUsage();
+	}
+	_shrinking = false;
+}
+
+} // End of namespace Common
@@ -0,0 +1,121 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_MEMTRACKER_H
+#define COMMON_MEMTRACKER_H
+
+#include "common/scummsys.h"
+#include "common/array.h"
+#include "common/singleton.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_memtracker Memory tracker
+ * @ingroup common
+ *
+ * @brief API for caches to report their memory usage and share a budget.
+ *
+ * Caches register themselves with the memory tracker, which can list how
+ * much memory each of them holds, and asks them to shrink when their total
+ * goes over the budget set by the "memory_budget" setting.
+ *
+ * The memory tracker is not thread safe, and must only be used from the
+ * main thread.
+ * @{
+ */
+
+/**
+ * A cache which reports its memory usage to the memory tracker.
+ */
+class MemoryConsumer {
+public:
+	virtual ~MemoryConsumer() {}
+
+	/** Return the name listed for the cache, such as the engine and the kind of data it holds. */
+	virtual const char *getMemoryConsumerName() const = 0;
+
+	/** Return the number of bytes held by the cache. */
+	virtual size_t getMemoryUsage() const = 0;
+
+	/**
+	 * Free up to the given number of bytes of data that can be recreated
+	 * when it is needed again.
+	 *
+	 * @return The number of bytes freed.
+	 */
+	virtual size_t shrinkMemoryUsage(size_t bytes) = 0;
+};
+
+class MemoryTracker : public Singleton<MemoryTracker> {
+public:
+	/** The priority of a cache. Caches of a lower priority are shrunk first. */
+	enum Priority {
+		kPriorityLow,
+		kPriorityNormal,
+		kPriorityHigh
+	};
+
+	struct Consumer {
+		MemoryConsumer *consumer;
+		Priority priority;
+	};
+
+	/** Start tracking a cache. It must be unregistered before it is destroyed. */
+	void registerConsumer(MemoryConsumer *consumer, Priority priority = kPriorityNormal);
+	void unregisterConsumer(MemoryConsumer *consumer);
+
+	/** Return the registered caches, in the order they are shrunk. */
+	const Array<Consumer> &getConsumers() const { return _consumers; }
+
+	/** Return the number of bytes held by all registered caches. */
+	size_t getTotalUsage() const;
+
+	/** Set the number of bytes the registered caches may hold together. 0 means no limit. */
+	void setBudget(size_t bytes) { _budget = bytes; }
+	size_t getBudget() const { return _budget; }
+
+	/**
+	 * Shrink the registered caches, the ones with the lowest priority first,
+	 * until their total is within the budget or none of them can free anything.
+	 * Caches call this after they grew.
+	 */
+	void checkBudget();
+
+private:
+	friend class Singleton<SingletonBaseType>;
+
+	MemoryTracker();
+
+	Array<Consumer> _consumers;
+	size_t _budget;
+	bool _shrinking;
+};
+
+/** Shortcut for accessing the memory tracker. */
+#define MemTracker		Common::MemoryTracker::instance()
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
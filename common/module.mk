@@ -3,9 +3,11 @@ MODULE := common
 MODULE_OBJS := \
 	achievements.o \
 	archive.o \
+	arena.o \
 	base-str.o \
 	config-manager.o \
 	coroutines.o \
+	cpu.o \
 	dcl.o \
 	debug.o \
 	error.o \
@@ -21,14 +23,17 @@ MODULE_OBJS := \
 	json.o \
 	language.o \
 	localization.o \
+	lzss.o \
 	macresman.o \
 	memorypool.o \
+	memtracker.o \
 	md5.o \
 	mdct.o \
 	mutex.o \
 	osd_message_queue.o \
 	path.o \
 	platform.o \
+	profiler.o \
 	punycode.o \
 	quicktime.o \
 	random.o \
@@ -44,6 +49,8 @@ MODULE_OBJS := \
 	system.o \
 	textconsole.o \
 	text-to-speech.o \
+	thread.o \
+	threadpool.o \
 	tokenizer.o \
 	translation.o \
 	unarj.o \
@@ -64,6 +71,18 @@ MODULE_OBJS += \
 	rdft.o \
 	sinetables.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	fft-sse2.o
+
+$(MODULE)/fft-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	fft-neon.o
+endif
+
 ifdef ENABLE_EVENTRECORDER
 MODULE_OBJS += \
 	recorderfile.o
@@ -0,0 +1,150 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/profiler.h"
+
+#ifdef USE_PROFILER
+
+#include "common/algorithm.h"
+#include "common/hashmap.h"
+#include "common/stream.h"
+#include "common/system.h"
+
+namespace Common {
+
+DECLARE_SINGLETON(Profiler);
+
+Profiler::Profiler() : _recording(false), _nextMarker(0) {
+}
+
+void Profiler::start() {
+	StackLock lock(_mutex);
+	_markers.clear();
+	_markers.reserve(kMaxMarkers);
+	_nextMarker = 0;
+	_recording = true;
+}
+
+void Profiler::stop() {
+	_recording = false;
+}
+
+void Profiler::addMarker(const char *name, uint64 start, uint32 duration, ProfilerTrack track) {
+	StackLock lock(_mutex);
+	if (!_recording)
+		return;
+
+	Marker marker;
+	marker.name = name;
+	marker.start = start;
+	marker.duration = duration;
+	marker.track = track;
+
+	// Once the history is full, overwrite the oldest markers
+	if (_markers.size() < kMaxMarkers)
+		_markers.push_back(marker);
+	else
+		_markers[_nextMarker] = marker;
+	_nextMarker = (_nextMarker + 1) % kMaxMarkers;
+}
+
+namespace {
+
+struct SummaryLess {
+	bool operator()(const Profiler::Summary &a, const Profiler::Summary &b) const {
+		return a.totalTime > b.totalTime;
+	}
+};
+
+} // End of anonymous namespace
+
+Array<Profiler::Summary> Profiler::getSummaries() {
+	StackLock lock(_mutex);
+
+	// The names are string literals, so they can be told apart by address
+	HashMap<const char *, uint> indices;
+	Array<Summary> summaries;
+	for (uint i = 0; i < _markers.size(); i++) {
+		const Marker &marker = _markers[i];
+		if (!indices.contains(marker.name)) {
+			indices[marker.name] = summaries.size();
+			Summary summary;
+			summary.name = marker.name;
+			summary.count = 0;
+			summary.totalTime = 0;
+			summary.maxTime = 0;
+			summaries.push_back(summary);
+		}
+
+		Summary &summary = summaries[indices[marker.name]];
+		summary.count++;
+		summary.totalTime += marker.duration;
+		summary.maxTime = MAX(summary.maxTime, marker.duration);
+	}
+
+	sort(summaries.begin(), summaries.end(), SummaryLess());
+	return summaries;
+}
+
+bool Profiler::writeChromeTrace(WriteStream &stream) {
+	StackLock lock(_mutex);
+
+	stream.writeString("{\"traceEvents\":[\n");
+
+	// Start with the oldest marker
+	const uint first = _markers.size() < kMaxMarkers ? 0 : _nextMarker;
+	for (uint i = 0; i < _markers.size(); i++) {
+		const Marker &marker = _markers[(first + i) % _markers.size()];
+
+		String name;
+		for (const char *c = marker.name; *c; c++) {
+			if (*c == '"' || *c == '\\')
+				name += '\\';
+			name += *c;
+		}
+
+		stream.writeString(String::format("%s{\"name\":\"%s\",\"ph\":\"X\",\"ts\":%llu,\"dur\":%u,\"pid\":1,\"tid\":%d}",
+		                                  i ? ",\n" : "", name.c_str(), (unsigned long long)marker.start, marker.duration, marker.track));
+	}
+
+	stream.writeString("\n]}\n");
+	return !stream.err();
+}
+
+
+#pragma mark -
+
+
+ProfilerScope::ProfilerScope(const char *name, ProfilerTrack track) : _name(name), _track(track), _start(0) {
+	// Avoid reading the clock unless the profiler is recording
+	_recording = Profiler::hasInstance() && Profiler::instance().isRecording();
+	if (_recording)
+		_start = g_system->getMicros();
+}
+
+ProfilerScope::~ProfilerScope() {
+	if (_recording)
+		Profiler::instance().addMarker(_name, _start, (uint32)(g_system->getMicros() - _start), _track);
+}
+
+} // End of namespace Common
+
+#endif
@@ -0,0 +1,147 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_PROFILER_H
+#define COMMON_PROFILER_H
+
+#include "common/scummsys.h"
+
+#ifdef USE_PROFILER
+
+#include "common/array.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/singleton.h"
+#include "common/str.h"
+
+#endif
+
+namespace Common {
+
+/**
+ * @defgroup common_profiler Profiler
+ * @ingroup common
+ *
+ * @brief API for recording named time spans, to see where a frame is spent.
+ *
+ * Code is instrumented with PROFILE_SCOPE(), which records how long the
+ * enclosing scope took while the profiler is recording. The markers are
+ * compiled out unless ScummVM is configured with --enable-profiler.
+ * @{
+ */
+
+/**
+ * Tracks of the recorded markers. The markers of each thread have to be
+ * recorded on their own track, so that they nest properly.
+ */
+enum ProfilerTrack {
+	kProfilerTrackMain = 0,
+	kProfilerTrackAudio = 1
+};
+
+#ifdef USE_PROFILER
+
+class WriteStream;
+
+/**
+ * Recorder of the markers, with a fixed size history of the most recent ones.
+ */
+class Profiler : public Singleton<Profiler> {
+public:
+	/** Summary of the recorded markers with the same name. */
+	struct Summary {
+		const char *name;
+		uint count;
+		uint64 totalTime; ///< in microseconds
+		uint32 maxTime;   ///< in microseconds
+	};
+
+	Profiler();
+
+	/** Drop the recorded markers and start recording new ones. */
+	void start();
+	void stop();
+	bool isRecording() const { return _recording; }
+
+	/** Record a marker which started at the given time, as returned by OSystem::getMicros(). */
+	void addMarker(const char *name, uint64 start, uint32 duration, ProfilerTrack track);
+
+	/** Return the summaries of the recorded markers, sorted by decreasing total time. */
+	Array<Summary> getSummaries();
+
+	/** Write the recorded markers in the Trace Event format of Chrome's trace viewer. */
+	bool writeChromeTrace(WriteStream &stream);
+
+private:
+	enum {
+		kMaxMarkers = 65536
+	};
+
+	struct Marker {
+		const char *name;
+		uint64 start;
+		uint32 duration;
+		ProfilerTrack track;
+	};
+
+	Mutex _mutex;
+	volatile bool _recording;
+
+	// Protected by _mutex
+	Array<Marker> _markers;
+	uint _nextMarker;
+};
+
+/**
+ * Records the time spent in the enclosing scope, see PROFILE_SCOPE().
+ */
+class ProfilerScope : NonCopyable {
+	const char *_name;
+	ProfilerTrack _track;
+	bool _recording;
+	uint64 _start;
+
+public:
+	ProfilerScope(const char *name, ProfilerTrack track);
+	~ProfilerScope();
+};
+
+#define PROFILER_SCOPE_VARIABLE2(line) profilerScope##line
+#define PROFILER_SCOPE_VARIABLE(line) PROFILER_SCOPE_VARIABLE2(line)
+
+/** Record the time spent in the enclosing scope under the given name, which must be a string literal. */
+#define PROFILE_SCOPE(name) Common::ProfilerScope PROFILER_SCOPE_VARIABLE(__LINE__)(name, Common::kProfilerTrackMain)
+
+/** Like PROFILE_SCOPE(), for code running on another thread than the main one. */
+#define PROFILE_SCOPE_TRACK(name, track) Common::ProfilerScope PROFILER_SCOPE_VARIABLE(__LINE__)(name, track)
+
+#else
+
+#define PROFILE_SCOPE(name) do {} while (0)
+#define PROFILE_SCOPE_TRACK(name, track) do {} while (0)
+
+#endif
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
@@ -22,6 +22,7 @@
 #ifndef COMMON_SAVEFILE_H
 #define COMMON_SAVEFILE_H
 
+#include "common/callback.h"
 #include "common/noncopyable.h"
 #include "common/scummsys.h"
 #include "common/stream.h"
@@ -46,6 +47,12 @@ namespace Common {
  */
 typedef SeekableReadStream InSaveFile;
 
+/**
+ * A callback called once a save file opened with
+ * SaveFileManager::openForSavingAsync() has been written, with the result.
+ */
+typedef BaseCallback<Error> SaveCallback;
+
 /**
  * A class which allows game engines to save game state data.
  * That typically means "save games", but also includes things like the
@@ -201,6 +208,43 @@ public:
 	 */
 	virtual OutSaveFile *openForSaving(const String &name, bool compress = true) = 0;
 
+	/**
+	 * Open the save file with the specified @p name for saving in the
+	 * background.
+	 *
+	 * What is written to the returned stream is kept in memory. Once the
+	 * stream is finalized, it is compressed, if requested, and written to a
+	 * temporary file which then replaces the save file, so that a failed save
+	 * does not damage an existing save file. This happens without blocking the
+	 * caller where possible: whether the save file was written is only known
+	 * when @p callback is called, from the main thread, in
+	 * processCompletedSaves(). If the stream is deleted without being
+	 * finalized, nothing is written and @p callback is not called.
+	 *
+	 * The default implementation writes the save file on finalize(), and
+	 * calls @p callback right away.
+	 *
+	 * @param name      Name of the save file.
+	 * @param callback  Callback called once the save file is written, or
+	 *                  nullptr. The save file manager takes ownership of it.
+	 * @param compress  Whether to compress the resulting save file (default) or not.
+	 *
+	 * @return Pointer to an OutSaveFile, or NULL if an error occurred.
+	 */
+	virtual OutSaveFile *openForSavingAsync(const String &name, SaveCallback *callback, bool compress = true);
+
+	/**
+	 * Call the callbacks of the background saves which completed. This is
+	 * called regularly by the event manager.
+	 */
+	virtual void processCompletedSaves() {}
+
+	/**
+	 * Wait until all background saves are written. Their callbacks are called
+	 * by the next processCompletedSaves().
+	 */
+	virtual void waitForPendingSaves() {}
+
 	/**
 	 * Open the file with the specified @p name in the given directory for loading.
 	 *
@@ -276,6 +320,20 @@ public:
 	 * @return true if the file exists. false otherwise.
 	 */
 	virtual bool exists(const String &name) = 0;
+
+	/**
+	 * Retrieve the size and the last modification time of a save file,
+	 * without opening it. Locked files are not reported.
+	 *
+	 * Not all save file managers provide this information.
+	 *
+	 * @param name              Name of the save file.
+	 * @param size              The size of the file in bytes.
+	 * @param modificationTime  The modification time, in seconds since the epoch.
+	 *
+	 * @return True if the information could be retrieved, false otherwise.
+	 */
+	virtual bool getSavefileStats(const String &name, int64 &size, int64 &modificationTime) { return false; }
 };
 
 /** @} */
@@ -22,8 +22,10 @@
 #ifndef COMMON_SERIALIZER_H
 #define COMMON_SERIALIZER_H
 
+#include "common/endian.h"
 #include "common/stream.h"
 #include "common/str.h"
+#include "common/util.h"
 
 namespace Common {
 
@@ -52,6 +54,34 @@ namespace Common {
 		_bytesSynced += SIZE; \
 	}
 
+#define SYNC_ARRAY_AS(SUFFIX,TYPE,SIZE,READ,WRITE) \
+	template<typename T> \
+	void syncArrayAs ## SUFFIX(T *arr, uint32 entries, Version minVersion = 0, Version maxVersion = kLastVersion) { \
+		if (_version < minVersion || _version > maxVersion) \
+			return; \
+		byte buffer[kArrayBufferSize]; \
+		while (entries) { \
+			const uint32 count = MIN<uint32>(entries, kArrayBufferSize / SIZE); \
+			if (_loadStream) { \
+				const uint32 bytesRead = _loadStream->read(buffer, count * SIZE); \
+				if (bytesRead < count * SIZE) \
+					memset(buffer + bytesRead, 0, count * SIZE - bytesRead); \
+				for (uint32 i = 0; i < count; i++) \
+					arr[i] = static_cast<T>((TYPE)READ(buffer + i * SIZE)); \
+			} else { \
+				for (uint32 i = 0; i < count; i++) \
+					WRITE(buffer + i * SIZE, (TYPE)arr[i]); \
+				_saveStream->write(buffer, count * SIZE); \
+			} \
+			arr += count; \
+			entries -= count; \
+			_bytesSynced += count * SIZE; \
+		} \
+	}
+
+#define SYNC_READ_BYTE(ptr) (*(const byte *)(ptr))
+#define SYNC_WRITE_BYTE(ptr, val) (*(byte *)(ptr) = (byte)(val))
+
 #define SYNC_PRIMITIVE(suffix) \
 	template <typename T> \
 	static inline void suffix(Serializer &s, T &value) { \
@@ -97,6 +127,9 @@ public:
 	SYNC_PRIMITIVE(SByte)
 
 protected:
+	/** Size of the buffer used to convert the values synced by syncArrayAs*(). */
+	enum { kArrayBufferSize = 1024 };
+
 	SeekableReadStream *_loadStream;
 	WriteStream *_saveStream;
 
@@ -139,6 +172,24 @@ public:
 	SYNC_AS(DoubleLE, double, 4)
 	SYNC_AS(DoubleBE, double, 4)
 
+	/**
+	 * Sync an array of integers, which are stored one after another.
+	 * This is the same as calling the matching syncAs*() on each of them,
+	 * but the data is read and written in blocks, and converted in one pass.
+	 */
+	SYNC_ARRAY_AS(Byte, byte, 1, SYNC_READ_BYTE, SYNC_WRITE_BYTE)
+	SYNC_ARRAY_AS(SByte, int8, 1, SYNC_READ_BYTE, SYNC_WRITE_BYTE)
+
+	SYNC_ARRAY_AS(Uint16LE, uint16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_ARRAY_AS(Uint16BE, uint16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
+	SYNC_ARRAY_AS(Sint16LE, int16, 2, READ_LE_UINT16, WRITE_LE_UINT16)
+	SYNC_ARRAY_AS(Sint16BE, int16, 2, READ_BE_UINT16, WRITE_BE_UINT16)
+
+	SYNC_ARRAY_AS(Uint32LE, uint32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_ARRAY_AS(Uint32BE, uint32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
+	SYNC_ARRAY_AS(Sint32LE, int32, 4, READ_LE_UINT32, WRITE_LE_UINT32)
+	SYNC_ARRAY_AS(Sint32BE, int32, 4, READ_BE_UINT32, WRITE_BE_UINT32)
+
 	/**
 	 * Returns true if an I/O failure occurred.
 	 * This flag is never cleared automatically. In order to clear it,
@@ -306,6 +357,9 @@ public:
 };
 
 #undef SYNC_PRIMITIVE
+#undef SYNC_ARRAY_AS
+#undef SYNC_READ_BYTE
+#undef SYNC_WRITE_BYTE
 #undef SYNC_AS
 
 
@@ -80,6 +80,9 @@ public:
 	/** Construct a copy of the given string. */
 	String(const String &str) : BaseString<char>(str) {};
 
+	/** Construct a string by taking over the content of the given string, which is left empty. */
+	String(String &&str) : BaseString<char>(Common::move(str)) {}
+
 	/** Construct a string consisting of the given character. */
 	explicit String(char c);
 
@@ -88,6 +91,7 @@ public:
 
 	String &operator=(const char *str);
 	String &operator=(const String &str);
+	String &operator=(String &&str);
 	String &operator=(char c);
 	String &operator+=(const char *str);
 	String &operator+=(const String &str);
@@ -277,6 +277,79 @@ uint32 SafeSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
 	return SeekableSubReadStream::read(dataPtr, dataSize);
 }
 
+SharedSeekableSubReadStream::SharedSeekableSubReadStream(const SharedPtr<SeekableReadStream> &parentStream, uint32 begin, uint32 end)
+	: _parentStream(parentStream),
+	_begin(begin),
+	_end(end),
+	_pos(0),
+	_eos(false) {
+	assert(_parentStream);
+	assert(_begin <= _end);
+}
+
+uint32 SharedSeekableSubReadStream::read(void *dataPtr, uint32 dataSize) {
+	if (dataSize > _end - _begin - _pos) {
+		dataSize = _end - _begin - _pos;
+		_eos = true;
+	}
+
+	// Other streams may have moved the parent stream
+	if (!_parentStream->seek(_begin + _pos))
+		return 0;
+
+	dataSize = _parentStream->read(dataPtr, dataSize);
+	_pos += dataSize;
+
+	return dataSize;
+}
+
+bool SharedSeekableSubReadStream::seek(int64 offset, int whence) {
+	switch (whence) {
+	case SEEK_END:
+		offset = size() + offset;
+		// fallthrough
+	case SEEK_SET:
+		// Fall through
+	default:
+		break;
+	case SEEK_CUR:
+		offset += _pos;
+	}
+
+	if (offset < 0 || offset > size())
+		return false;
+
+	_pos = offset;
+	_eos = false;
+	return true;
+}
+
+namespace {
+
+/**
+ * A view into part of a shared MemoryReadStream.
+ */
+class SharedMemorySubReadStream : public MemoryReadStream {
+	SharedPtr<SeekableReadStream> _parentStream;
+
+public:
+	SharedMemorySubReadStream(const SharedPtr<SeekableReadStream> &parentStream, const byte *data, uint32 size)
+		: MemoryReadStream(data, size), _parentStream(parentStream) {}
+};
+
+} // End of anonymous namespace
+
+SeekableReadStream *createSharedSubReadStream(const SharedPtr<SeekableReadStream> &parentStream, uint32 begin, uint32 end) {
+	assert(parentStream);
+	assert(begin <= end);
+
+	const MemoryReadStream *memoryStream = dynamic_cast<const MemoryReadStream *>(parentStream.get());
+	if (memoryStream && end <= memoryStream->size())
+		return new SharedMemorySubReadStream(parentStream, memoryStream->getData() + begin, end - begin);
+
+	return new SharedSeekableSubReadStream(parentStream, begin, end);
+}
+
 void SeekableReadStream::hexdump(int len, int bytesPerLine, int startOffset) {
 	uint pos_ = pos();
 	uint size_ = size();
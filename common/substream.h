@@ -132,6 +132,52 @@ public:
 	virtual uint32 read(void *dataPtr, uint32 dataSize);
 };
 
+/**
+ * A seekable substream of a parent stream that is shared by reference
+ * counting.
+ *
+ * Like SafeSeekableSubReadStream, it seek()s the parent stream before each
+ * read(), so any number of these streams can use the same parent at the
+ * same time. In addition, the parent stream stays alive until the last
+ * stream referring to it is destroyed, so these streams may outlive the
+ * archive they have been created from.
+ *
+ * Use createSharedSubReadStream() to create them.
+ */
+class SharedSeekableSubReadStream : public SeekableReadStream {
+protected:
+	SharedPtr<SeekableReadStream> _parentStream;
+	uint32 _begin;
+	uint32 _end;
+	uint32 _pos;
+	bool _eos;
+
+public:
+	SharedSeekableSubReadStream(const SharedPtr<SeekableReadStream> &parentStream, uint32 begin, uint32 end);
+
+	bool eos() const override { return _eos; }
+	bool err() const override { return _parentStream->err(); }
+	void clearErr() override { _eos = false; _parentStream->clearErr(); }
+	uint32 read(void *dataPtr, uint32 dataSize) override;
+
+	int64 pos() const override { return _pos; }
+	int64 size() const override { return _end - _begin; }
+
+	bool seek(int64 offset, int whence = SEEK_SET) override;
+};
+
+/**
+ * Create a stream for the range [begin, end) of a shared parent stream.
+ *
+ * If the parent stream is a MemoryReadStream, for example a memory mapped
+ * file, the result is a MemoryReadStream viewing the parent's data, so no
+ * data is copied and reads do not touch the parent at all. Otherwise the
+ * result is a SharedSeekableSubReadStream.
+ *
+ * In both cases, the new stream keeps a reference to the parent stream.
+ */
+SeekableReadStream *createSharedSubReadStream(const SharedPtr<SeekableReadStream> &parentStream, uint32 begin, uint32 end);
+
 /** @} */
 
 } // End of namespace Common
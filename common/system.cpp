@@ -32,6 +32,9 @@
 #include "common/textconsole.h"
 #include "common/text-to-speech.h"
 
+#include "graphics/conversion.h"
+#include "graphics/surface.h"
+
 #include "backends/audiocd/default/default-audiocd.h"
 #include "backends/fs/fs-factory.h"
 #include "backends/timer/default/default-timer.h"
@@ -114,7 +117,6 @@ void OSystem::initBackend() {
 
 void OSystem::destroy() {
 	_backendInitialized = false;
-	Common::String::releaseMemoryPoolMutex();
 	delete this;
 }
 
@@ -181,6 +183,33 @@ bool OSystem::setStretchMode(const char *name) {
 	return false;
 }
 
+bool OSystem::copyVideoFrameToScreen(const Graphics::Surface &frame, int x, int y) {
+	const Graphics::PixelFormat screenFormat = getScreenFormat();
+	if (frame.format == screenFormat) {
+		copyRectToScreen(frame.getPixels(), frame.pitch, x, y, frame.w, frame.h);
+		return true;
+	}
+
+	// Paletted frames need the palette to be converted
+	if (frame.format.bytesPerPixel == 1 || screenFormat.bytesPerPixel == 1)
+		return false;
+
+	Graphics::Surface *screen = lockScreen();
+	if (!screen)
+		return false;
+
+	// The same checks as copyRectToScreen() does
+	assert(x >= 0 && x < screen->w);
+	assert(y >= 0 && y < screen->h);
+	assert(frame.h > 0 && y + frame.h <= screen->h);
+	assert(frame.w > 0 && x + frame.w <= screen->w);
+
+	bool result = Graphics::crossBlit((byte *)screen->getBasePtr(x, y), (const byte *)frame.getPixels(),
+	                                  screen->pitch, frame.pitch, frame.w, frame.h, screen->format, frame.format);
+	unlockScreen();
+	return result;
+}
+
 void OSystem::fatalError() {
 	quit();
 	exit(1);
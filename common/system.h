@@ -26,6 +26,7 @@
 #include "common/noncopyable.h"
 #include "common/array.h" // For OSystem::getGlobalKeymaps()
 #include "common/list.h" // For OSystem::getSupportedFormats()
+#include "common/thread.h" // For OSystem::createThread()
 #include "common/ustr.h"
 #include "graphics/pixelformat.h"
 #include "graphics/mode.h"
@@ -39,6 +40,10 @@ namespace Graphics {
 struct Surface;
 }
 
+namespace Image {
+class MPEGPacketDecoder;
+}
+
 namespace GUI {
 class GuiObject;
 class OptionsContainerWidget;
@@ -494,7 +499,37 @@ public:
 		/**
 		* For platforms that should not have a Quit button.
 		*/
-		kFeatureNoQuit
+		kFeatureNoQuit,
+
+		/**
+		* The host CPU supports the SSE2 instruction set.
+		*
+		* This is a read-only feature used to select optimized code paths
+		* at runtime.
+		*/
+		kFeatureCpuSSE2,
+
+		/**
+		* The host CPU supports the ARM NEON instruction set.
+		*
+		* This is a read-only feature used to select optimized code paths
+		* at runtime.
+		*/
+		kFeatureCpuNEON,
+
+		/**
+		* The backend supports worker threads and semaphores, see
+		* createThread() and createSemaphore().
+		*/
+		kFeatureThreads,
+
+		/**
+		* The backend can decode MPEG-2 video on the platform's decoding
+		* hardware, see createHardwareMPEGDecoder().
+		*
+		* This is a read-only feature.
+		*/
+		kFeatureHardwareMPEG2
 	};
 
 	/**
@@ -1099,6 +1134,30 @@ public:
 	 */
 	virtual void copyRectToScreen(const void *buf, int pitch, int x, int y, int w, int h) = 0;
 
+	/**
+	 * Blit a video frame onto the screen, converting it to the screen's
+	 * pixel format on the way.
+	 *
+	 * This saves engines converting the frame into a buffer of their own
+	 * before passing it to copyRectToScreen(). The default implementation
+	 * converts the frame straight into the framebuffer returned by
+	 * lockScreen(). Backends can override this to upload the frame to
+	 * their textures directly.
+	 *
+	 * The same restrictions as for copyRectToScreen() apply to the
+	 * destination rectangle.
+	 *
+	 * @param frame  The video frame. Frames with one byte per pixel
+	 *               use the palette specified via setPalette.
+	 * @param x      x coordinate of the destination rectangle.
+	 * @param y      y coordinate of the destination rectangle.
+	 * @return true on success, false if the frame can't be converted to
+	 *         the screen format.
+	 *
+	 * @see copyRectToScreen
+	 */
+	virtual bool copyVideoFrameToScreen(const Graphics::Surface &frame, int x, int y);
+
 	/**
 	 * Lock the active screen framebuffer and return a Graphics::Surface
 	 * representing it.
@@ -1375,6 +1434,14 @@ public:
 	 */
 	virtual uint32 getMillis(bool skipRecord = false) = 0;
 
+	/**
+	 * Get a monotonic time in microseconds, for measuring durations.
+	 *
+	 * Unlike getMillis(), the value is never recorded by the event
+	 * recorder, and it does not need to start at 0.
+	 */
+	virtual uint64 getMicros() { return (uint64)getMillis(true) * 1000; }
+
 	/** Delay/sleep for the specified amount of milliseconds. */
 	virtual void delayMillis(uint msecs) = 0;
 
@@ -1462,6 +1529,37 @@ public:
 
 	/** @} */
 
+	/**
+	 * @defgroup common_system_threads Worker threads
+	 * @ingroup common_system
+	 * @{
+	 *
+	 * Some backends can run work on additional threads, which is used to
+	 * move expensive operations (like decoding) off the main and audio
+	 * threads. Support is optional: code using these methods must work
+	 * correctly when they return nullptr. Use Common::Thread and
+	 * Common::Semaphore instead of calling these directly.
+	 *
+	 * Backends implementing these must also provide real mutexes, and
+	 * should report kFeatureThreads.
+	 */
+
+	/**
+	 * Create a new thread running the given function.
+	 *
+	 * @return The newly created thread, or nullptr if threads are not supported.
+	 */
+	virtual Common::ThreadInternal *createThread(Common::ThreadProc proc, void *data) { return nullptr; }
+
+	/**
+	 * Create a new counting semaphore.
+	 *
+	 * @return The newly created semaphore, or nullptr if threads are not supported.
+	 */
+	virtual Common::SemaphoreInternal *createSemaphore(uint initialCount) { return nullptr; }
+
+	/** @} */
+
 
 
 	/** @defgroup common_system_sound Sound
@@ -1480,6 +1578,30 @@ public:
 
 
 
+	/** @defgroup common_system_video Video decoding
+	 *  @ingroup common_system
+	 *  @{
+	 */
+
+	/**
+	 * Create an MPEG-2 video decoder which uses the platform's decoding
+	 * hardware (e.g. VA-API, VideoToolbox or MediaCodec).
+	 *
+	 * The decoder converts the frames into the surface passed to
+	 * Image::MPEGPacketDecoder::decodePacket(). Backends which implement
+	 * this should report kFeatureHardwareMPEG2.
+	 *
+	 * @param width  The width of the video
+	 * @param height The height of the video
+	 * @return A new decoder, or nullptr if the video can't be decoded in
+	 *         hardware. The caller takes ownership of the decoder.
+	 */
+	virtual Image::MPEGPacketDecoder *createHardwareMPEGDecoder(uint16 width, uint16 height) { return nullptr; }
+
+	/** @} */
+
+
+
 	/** @defgroup common_system_audio Audio CD
 	 *  @ingroup common_system
 	 *  @{
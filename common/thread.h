@@ -0,0 +1,124 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef COMMON_THREAD_H
+#define COMMON_THREAD_H
+
+#include "common/scummsys.h"
+#include "common/noncopyable.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_thread Threads
+ * @ingroup common
+ *
+ * @brief API for running work on optional worker threads.
+ *
+ * Not every backend can provide threads. Code using them must check
+ * Thread::start() and Semaphore::isValid(), and fall back to doing the
+ * work synchronously when they fail.
+ * @{
+ */
+
+/**
+ * Function run by a thread. The thread ends when it returns.
+ */
+typedef void (*ThreadProc)(void *data);
+
+class ThreadInternal {
+public:
+	virtual ~ThreadInternal() {}
+
+	/** Wait until the thread function returned. */
+	virtual void join() = 0;
+};
+
+class SemaphoreInternal {
+public:
+	virtual ~SemaphoreInternal() {}
+
+	virtual void wait() = 0;
+	virtual bool tryWait() = 0;
+	virtual void post() = 0;
+};
+
+/**
+ * Wrapper class around the OSystem thread functions.
+ */
+class Thread : NonCopyable {
+	ThreadInternal *_thread;
+
+public:
+	Thread();
+	/** Joins the thread, if it is still running. */
+	~Thread();
+
+	/**
+	 * Start running the given function on a new thread.
+	 *
+	 * @return False if the backend does not support threads, or the thread
+	 *         could not be created.
+	 */
+	bool start(ThreadProc proc, void *data);
+
+	/**
+	 * Wait until the thread function returned. Does nothing if the thread
+	 * was not started.
+	 */
+	void join();
+
+	/** Return whether start() succeeded and join() was not called yet. */
+	bool isStarted() const { return _thread != nullptr; }
+};
+
+/**
+ * Wrapper class around the OSystem semaphore functions.
+ */
+class Semaphore : NonCopyable {
+	SemaphoreInternal *_semaphore;
+
+public:
+	explicit Semaphore(uint initialCount = 0);
+	~Semaphore();
+
+	/** Return whether the backend supports semaphores. */
+	bool isValid() const { return _semaphore != nullptr; }
+
+	/** Wait until the count is positive, then decrement it. */
+	void wait();
+
+	/**
+	 * Decrement the count if it is positive.
+	 *
+	 * @return True if the count was decremented.
+	 */
+	bool tryWait();
+
+	/** Increment the count, waking up one waiting thread. */
+	void post();
+};
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
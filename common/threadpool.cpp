@@ -0,0 +1,241 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "common/threadpool.h"
+#include "common/config-manager.h"
+#include "common/util.h"
+
+namespace Common {
+
+Future::Future() : _pool(nullptr), _proc(nullptr), _data(nullptr), _done(nullptr), _state(kStateIdle), _next(nullptr) {
+}
+
+Future::~Future() {
+	wait();
+	delete _done;
+}
+
+bool Future::isDone() const {
+	if (!_pool)
+		return _state == kStateDone;
+
+	StackLock lock(_pool->_mutex);
+	return _state == kStateDone;
+}
+
+void Future::wait() {
+	if (!_pool)
+		return;
+
+	if (_pool->takeTask(this)) {
+		// No worker thread started the task yet, so run it here
+		_pool->runTask(this, false);
+	} else {
+		// A worker thread is running the task, or has just finished it
+		_done->wait();
+	}
+
+	_pool = nullptr;
+}
+
+
+#pragma mark -
+
+
+ThreadPool::ThreadPool(uint threadCount) : _threadCount(0), _quit(false), _first(nullptr), _last(nullptr) {
+	if (!_workSemaphore.isValid())
+		return;
+
+	threadCount = MIN<uint>(threadCount, kMaxThreads);
+	while (_threadCount < threadCount && _threads[_threadCount].start(workerProc, this))
+		_threadCount++;
+}
+
+ThreadPool::~ThreadPool() {
+	{
+		StackLock lock(_mutex);
+		assert(!_first);
+		_quit = true;
+	}
+
+	for (uint i = 0; i < _threadCount; i++)
+		_workSemaphore.post();
+	for (uint i = 0; i < _threadCount; i++)
+		_threads[i].join();
+}
+
+void ThreadPool::submit(Future &future, TaskProc proc, void *data) {
+	// The future is reused, so it has to be done with its previous task
+	future.wait();
+
+	future._proc = proc;
+	future._data = data;
+
+	if (_threadCount == 0) {
+		proc(data);
+		future._state = Future::kStateDone;
+		return;
+	}
+
+	if (!future._done)
+		future._done = new Semaphore();
+
+	{
+		StackLock lock(_mutex);
+		future._pool = this;
+		future._state = Future::kStatePending;
+		future._next = nullptr;
+		if (_last)
+			_last->_next = &future;
+		else
+			_first = &future;
+		_last = &future;
+	}
+
+	_workSemaphore.post();
+}
+
+namespace {
+
+struct RangeChunk {
+	RangeProc proc;
+	void *data;
+	uint begin;
+	uint end;
+
+	static void run(void *data) {
+		RangeChunk *chunk = (RangeChunk *)data;
+		chunk->proc(chunk->data, chunk->begin, chunk->end);
+	}
+};
+
+} // End of anonymous namespace
+
+void ThreadPool::parallelFor(uint begin, uint end, uint minChunkSize, RangeProc proc, void *data) {
+	if (begin >= end)
+		return;
+
+	const uint size = end - begin;
+	const uint chunkCount = MIN<uint>(_threadCount + 1, MAX<uint>(size / MAX<uint>(minChunkSize, 1), 1));
+	if (chunkCount <= 1) {
+		proc(data, begin, end);
+		return;
+	}
+
+	// Split the range evenly, so that no chunk is smaller than requested
+	RangeChunk chunks[kMaxThreads + 1];
+	for (uint i = 0; i < chunkCount; i++) {
+		chunks[i].proc = proc;
+		chunks[i].data = data;
+		chunks[i].begin = begin + (uint)((uint64)size * i / chunkCount);
+		chunks[i].end = begin + (uint)((uint64)size * (i + 1) / chunkCount);
+	}
+
+	Future futures[kMaxThreads];
+	for (uint i = 1; i < chunkCount; i++)
+		submit(futures[i - 1], RangeChunk::run, &chunks[i]);
+
+	RangeChunk::run(&chunks[0]);
+
+	for (uint i = 1; i < chunkCount; i++)
+		futures[i - 1].wait();
+}
+
+void ThreadPool::workerProc(void *data) {
+	((ThreadPool *)data)->work();
+}
+
+void ThreadPool::work() {
+	for (;;) {
+		_workSemaphore.wait();
+
+		Future *task;
+		{
+			StackLock lock(_mutex);
+			if (_quit)
+				return;
+
+			// A waiting thread may have taken the task already
+			task = _first;
+			if (!task)
+				continue;
+
+			_first = task->_next;
+			if (!_first)
+				_last = nullptr;
+			task->_state = Future::kStateRunning;
+		}
+
+		runTask(task, true);
+	}
+}
+
+bool ThreadPool::takeTask(Future *future) {
+	StackLock lock(_mutex);
+	if (future->_state != Future::kStatePending)
+		return false;
+
+	Future *previous = nullptr;
+	for (Future *task = _first; task != future; task = task->_next)
+		previous = task;
+
+	if (previous)
+		previous->_next = future->_next;
+	else
+		_first = future->_next;
+	if (_last == future)
+		_last = previous;
+
+	future->_state = Future::kStateRunning;
+	return true;
+}
+
+void ThreadPool::runTask(Future *future, bool notify) {
+	future->_proc(future->_data);
+
+	{
+		StackLock lock(_mutex);
+		future->_state = Future::kStateDone;
+	}
+
+	// The waiting thread may destroy the future as soon as it is notified
+	if (notify)
+		future->_done->post();
+}
+
+
+#pragma mark -
+
+
+static uint getWorkerThreadCount() {
+	if (!ConfMan.hasKey("worker_threads"))
+		return 0;
+
+	return CLIP<int>(ConfMan.getInt("worker_threads"), 0, ThreadPool::kMaxThreads);
+}
+
+DECLARE_SINGLETON(SharedThreadPool);
+
+SharedThreadPool::SharedThreadPool() : ThreadPool(getWorkerThreadCount()) {
+}
+
+} // End of namespace Common
@@ -0,0 +1,175 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#ifndef COMMON_THREADPOOL_H
+#define COMMON_THREADPOOL_H
+
+#include "common/scummsys.h"
+#include "common/mutex.h"
+#include "common/noncopyable.h"
+#include "common/singleton.h"
+#include "common/thread.h"
+
+namespace Common {
+
+/**
+ * @defgroup common_threadpool Thread pool
+ * @ingroup common
+ *
+ * @brief API for running tasks on a pool of optional worker threads.
+ *
+ * When the backend does not support threads, the pool has no worker
+ * threads and runs all tasks on the calling thread. Code using it works
+ * the same either way, and does not need to check for thread support.
+ * @{
+ */
+
+/**
+ * Function run by a thread pool task.
+ */
+typedef void (*TaskProc)(void *data);
+
+/**
+ * Function run by ThreadPool::parallelFor() over the range [begin, end).
+ */
+typedef void (*RangeProc)(void *data, uint begin, uint end);
+
+class ThreadPool;
+
+/**
+ * The completion of a task submitted to a thread pool.
+ *
+ * A future must outlive its task, so wait() has to be called before it
+ * or the pool is destroyed. Waiting for a task which no thread started yet runs it
+ * on the waiting thread, so waiting never depends on a free worker.
+ */
+class Future : NonCopyable {
+	friend class ThreadPool;
+
+	enum State {
+		kStateIdle,
+		kStatePending,
+		kStateRunning,
+		kStateDone
+	};
+
+	ThreadPool *_pool;
+	TaskProc _proc;
+	void *_data;
+	Semaphore *_done;
+
+	// Protected by the mutex of the pool
+	State _state;
+	Future *_next;
+
+public:
+	Future();
+	/** Waits for the task, if it was not waited for yet. */
+	~Future();
+
+	/** Return whether the task finished running. */
+	bool isDone() const;
+
+	/** Wait until the task finished running. Does nothing if no task was submitted. */
+	void wait();
+};
+
+/**
+ * A pool of worker threads running submitted tasks in order.
+ */
+class ThreadPool : NonCopyable {
+	friend class Future;
+
+public:
+	enum {
+		/** The maximum number of worker threads of a pool */
+		kMaxThreads = 16
+	};
+
+	/**
+	 * Start up to the given number of worker threads. Fewer threads are
+	 * started if the backend runs out of them, and none if it does not
+	 * support threads.
+	 */
+	explicit ThreadPool(uint threadCount);
+	/** Joins the worker threads. All submitted tasks must have been waited for. */
+	~ThreadPool();
+
+	/** Return the number of worker threads, which is 0 if tasks run on the calling thread. */
+	uint getThreadCount() const { return _threadCount; }
+
+	/**
+	 * Run proc(data) on a worker thread, or right away on the calling
+	 * thread if the pool has no worker threads.
+	 *
+	 * @param future Completion of the task. It must be waited for before
+	 *               it is submitted again.
+	 */
+	void submit(Future &future, TaskProc proc, void *data);
+
+	/**
+	 * Split [begin, end) into chunks of at least minChunkSize elements,
+	 * call proc(data, chunkBegin, chunkEnd) for them on the worker threads
+	 * and the calling thread, and wait until all of them returned.
+	 */
+	void parallelFor(uint begin, uint end, uint minChunkSize, RangeProc proc, void *data);
+
+private:
+	static void workerProc(void *data);
+	void work();
+
+	/** Remove a pending task from the queue and mark it as running, or return false if it is not pending. */
+	bool takeTask(Future *future);
+	void runTask(Future *future, bool notify);
+
+	Thread _threads[kMaxThreads];
+	uint _threadCount;
+
+	Mutex _mutex;
+	Semaphore _workSemaphore;
+
+	// Protected by _mutex
+	bool _quit;
+	Future *_first;
+	Future *_last;
+};
+
+/**
+ * The thread pool shared by all code which runs tasks on worker threads.
+ *
+ * It starts as many worker threads as the "worker_threads" setting asks
+ * for when it is first used. By default it starts none, so that all tasks
+ * run on the calling thread.
+ */
+class SharedThreadPool : public ThreadPool, public Singleton<SharedThreadPool> {
+	friend class Singleton<SingletonBaseType>;
+	SharedThreadPool();
+};
+
+/** Shortcut for accessing the shared thread pool. */
+#define ThreadPoolMan (::Common::SharedThreadPool::instance())
+
+/** @} */
+
+} // End of namespace Common
+
+#endif
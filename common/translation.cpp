@@ -28,8 +28,10 @@
 
 #include "common/translation.h"
 #include "common/config-manager.h"
+#include "common/endian.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/memstream.h"
 #include "common/system.h"
 #include "common/textconsole.h"
 #include "common/unicode-bidi.h"
@@ -107,6 +109,13 @@ void TranslationManager::setLanguage(const String &lang) {
 	}
 }
 
+/** Return the message string of @p entry, which is decoded only once. */
+static const U32String &getMessageString(const PoMessageEntry &entry) {
+	if (entry.decoded.empty() && *entry.msgstr)
+		entry.decoded = U32String(entry.msgstr);
+	return entry.decoded;
+}
+
 U32String TranslationManager::getTranslation(const char *message) const {
 	return getTranslation(message, nullptr);
 }
@@ -116,51 +125,47 @@ U32String TranslationManager::getTranslation(const char *message, const char *co
 	if (_currentTranslationMessages.empty() || *message == '\0')
 		return U32String(message);
 
-	// Binary-search for the msgid
+	MessageIdMap::const_iterator id = _messageIds.find(message);
+	if (id == _messageIds.end())
+		return U32String(message);
+
+	// Binary-search for the first translation of the msgid
+	const int msgid = id->_value;
 	int leftIndex = 0;
-	int rightIndex = _currentTranslationMessages.size() - 1;
+	int rightIndex = _currentTranslationMessages.size();
 
-	while (rightIndex >= leftIndex) {
+	while (leftIndex < rightIndex) {
 		const int midIndex = (leftIndex + rightIndex) / 2;
-		const PoMessageEntry *const m = &_currentTranslationMessages[midIndex];
-
-		int compareResult = strcmp(message, _messageIds[m->msgid].c_str());
-
-		if (compareResult == 0) {
-			// Get the range of messages with the same ID (but different context)
-			leftIndex = rightIndex = midIndex;
-			while (
-			    leftIndex > 0 &&
-			    _currentTranslationMessages[leftIndex - 1].msgid == m->msgid
-			) {
-				--leftIndex;
-			}
-			while (
-			    rightIndex < (int)_currentTranslationMessages.size() - 1 &&
-			    _currentTranslationMessages[rightIndex + 1].msgid == m->msgid
-			) {
-				++rightIndex;
-			}
-			// Find the context we want
-			if (context == nullptr || *context == '\0' || leftIndex == rightIndex)
-				return _currentTranslationMessages[leftIndex].msgstr;
-			// We could use again binary search, but there should be only a small number of contexts.
-			while (rightIndex > leftIndex) {
-				compareResult = strcmp(context, _currentTranslationMessages[rightIndex].msgctxt.c_str());
-				if (compareResult == 0)
-					return _currentTranslationMessages[rightIndex].msgstr;
-				else if (compareResult > 0)
-					break;
-				--rightIndex;
-			}
-			return _currentTranslationMessages[leftIndex].msgstr;
-		} else if (compareResult < 0)
-			rightIndex = midIndex - 1;
-		else
+		if (_currentTranslationMessages[midIndex].msgid < msgid)
 			leftIndex = midIndex + 1;
+		else
+			rightIndex = midIndex;
 	}
 
-	return U32String(message);
+	if (leftIndex == (int)_currentTranslationMessages.size() || _currentTranslationMessages[leftIndex].msgid != msgid)
+		return U32String(message);
+
+	// Get the range of messages with the same ID (but different context)
+	rightIndex = leftIndex;
+	while (
+	    rightIndex < (int)_currentTranslationMessages.size() - 1 &&
+	    _currentTranslationMessages[rightIndex + 1].msgid == msgid
+	) {
+		++rightIndex;
+	}
+	// Find the context we want
+	if (context == nullptr || *context == '\0' || leftIndex == rightIndex)
+		return getMessageString(_currentTranslationMessages[leftIndex]);
+	// We could use again binary search, but there should be only a small number of contexts.
+	while (rightIndex > leftIndex) {
+		int compareResult = strcmp(context, _currentTranslationMessages[rightIndex].msgctxt);
+		if (compareResult == 0)
+			return getMessageString(_currentTranslationMessages[rightIndex]);
+		else if (compareResult > 0)
+			break;
+		--rightIndex;
+	}
+	return getMessageString(_currentTranslationMessages[leftIndex]);
 }
 
 String TranslationManager::getCurrentLanguage() const {
@@ -220,10 +225,13 @@ String TranslationManager::getLangById(int id) const {
 	return "";
 }
 
-bool TranslationManager::openTranslationsFile(File &inFile) {
+SeekableReadStream *TranslationManager::openTranslationsFile() {
 	// First look in the Themepath if we can find the file.
-	if (ConfMan.hasKey("themepath") && openTranslationsFile(FSNode(ConfMan.get("themepath")), inFile))
-		return true;
+	if (ConfMan.hasKey("themepath")) {
+		SeekableReadStream *stream = openTranslationsFile(FSNode(ConfMan.get("themepath")));
+		if (stream)
+			return stream;
+	}
 
 	// Then try to open it using the SearchMan.
 	ArchiveMemberList fileList;
@@ -231,54 +239,56 @@ bool TranslationManager::openTranslationsFile(File &inFile) {
 	for (ArchiveMemberList::iterator it = fileList.begin(); it != fileList.end(); ++it) {
 		ArchiveMember       const &m      = **it;
 		SeekableReadStream *const  stream = m.createReadStream();
-		if (stream && inFile.open(stream, m.getName())) {
-			if (checkHeader(inFile))
-				return true;
-			inFile.close();
+		if (stream) {
+			if (checkHeader(*stream, m.getName()))
+				return stream;
+			delete stream;
 		}
 	}
 
-	return false;
+	return nullptr;
 }
 
-bool TranslationManager::openTranslationsFile(const FSNode &node, File &inFile, int depth) {
+SeekableReadStream *TranslationManager::openTranslationsFile(const FSNode &node, int depth) {
 	if (!node.exists() || !node.isReadable() || !node.isDirectory())
-		return false;
+		return nullptr;
 
 	// Check if we can find the file in this directory
-	// Since File::open(FSNode) makes all the needed tests, it is not really
-	// necessary to make them here. But it avoid printing warnings.
+	// Since FSNode::createReadStream() makes all the needed tests, it is not
+	// really necessary to make them here. But it avoid printing warnings.
 	FSNode fileNode = node.getChild(_translationsFileName);
 	if (fileNode.exists() && fileNode.isReadable() && !fileNode.isDirectory()) {
-		if (inFile.open(fileNode)) {
-			if (checkHeader(inFile))
-				return true;
-			inFile.close();
+		SeekableReadStream *stream = fileNode.createReadStream();
+		if (stream) {
+			if (checkHeader(*stream, fileNode.getName()))
+				return stream;
+			delete stream;
 		}
 	}
 
 	// Check if we exceeded the given recursion depth
 	if (depth - 1 == -1)
-		return false;
+		return nullptr;
 
 	// Otherwise look for it in sub-directories
 	FSList fileList;
 	if (!node.getChildren(fileList, FSNode::kListDirectoriesOnly))
-		return false;
+		return nullptr;
 
 	for (FSList::iterator i = fileList.begin(); i != fileList.end(); ++i) {
-		if (openTranslationsFile(*i, inFile, depth == -1 ? - 1 : depth - 1))
-			return true;
+		SeekableReadStream *stream = openTranslationsFile(*i, depth == -1 ? - 1 : depth - 1);
+		if (stream)
+			return stream;
 	}
 
 	// Not found in this directory or its sub-directories
-	return false;
+	return nullptr;
 }
 
 void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
-	File in;
 	_translationsFileName = name;
-	if (!openTranslationsFile(in)) {
+	ScopedPtr<SeekableReadStream> in(openTranslationsFile());
+	if (!in) {
 		warning("You are missing a valid '%s' file. GUI translation will not be available", name.c_str());
 		return;
 	}
@@ -287,43 +297,49 @@ void TranslationManager::loadTranslationsInfoDat(const Common::String &name) {
 	int len;
 
 	// Get number of translations
-	int nbTranslations = in.readUint16BE();
+	int nbTranslations = in->readUint16BE();
 
 	// Skip translation description & size for the original language (english) block
 	// Also skip size of each translation block. Each block is written in Uint32BE.
 	for (int i = 0; i < nbTranslations + 2; i++) {
-		in.readUint32BE();
+		in->readUint32BE();
 	}
 
 	// Read list of languages
 	_langs.resize(nbTranslations);
 	_langNames.resize(nbTranslations);
 	for (int i = 0; i < nbTranslations; ++i) {
-		len = in.readUint16BE();
-		in.read(buf, len);
+		len = in->readUint16BE();
+		in->read(buf, len);
 		_langs[i] = String(buf, len - 1);
-		len = in.readUint16BE();
-		in.read(buf, len);
+		len = in->readUint16BE();
+		in->read(buf, len);
 		_langNames[i] = String(buf, len - 1).decode();
 	}
 
-	// Read messages
-	int numMessages = in.readUint16BE();
-	_messageIds.resize(numMessages);
+	// Read messages and index them by their text
+	int numMessages = in->readUint16BE();
+	_messageIds.clear();
 	for (int i = 0; i < numMessages; ++i) {
-		len = in.readUint16BE();
+		len = in->readUint16BE();
 		String msg;
 		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
+			in->read(buf, len > 256 ? 256 : len);
 			msg += String(buf, len > 256 ? 256 : len - 1);
 			len -= 256;
 		}
-		_messageIds[i] = msg;
+		_messageIds[msg] = i;
 	}
+
+	// Keep a memory mapped file around, so that switching languages neither
+	// opens the file again nor copies the messages of the language.
+	if (ConfMan.getBool("translations_mapped") && dynamic_cast<MemoryReadStream *>(in.get()))
+		_mappedFile.reset(in.release());
 }
 
 void TranslationManager::loadLanguageDat(int index) {
 	_currentTranslationMessages.clear();
+	_currentTranslationData.clear();
 	_currentCharset.clear();
 	// Sanity check
 	if (index < 0 || index >= (int)_langs.size()) {
@@ -332,15 +348,19 @@ void TranslationManager::loadLanguageDat(int index) {
 		return;
 	}
 
-	File in;
-	if (!openTranslationsFile(in))
-		return;
-
-	char buf[1024];
-	int len;
+	ScopedPtr<SeekableReadStream> file;
+	SeekableReadStream *in = _mappedFile.get();
+	if (in) {
+		in->seek(13);
+	} else {
+		file.reset(openTranslationsFile());
+		in = file.get();
+		if (!in)
+			return;
+	}
 
 	// Get number of translations
-	int nbTranslations = in.readUint16BE();
+	int nbTranslations = in->readUint16BE();
 	if (nbTranslations != (int)_langs.size()) {
 		warning("The 'translations.dat' file has changed since starting ScummVM. GUI translation will not be available");
 		return;
@@ -352,40 +372,68 @@ void TranslationManager::loadLanguageDat(int index) {
 	// Skip translation description & size for the original language (english) block
 	// Also skip size of each translation block. All block sizes are written in Uint32BE.
 	for (int i = 0; i < index + 2; ++i)
-		skipSize += in.readUint32BE();
+		skipSize += in->readUint32BE();
+
+	uint32 blockSize = in->readUint32BE();
 
 	// We also need to skip the remaining block sizes
-	skipSize += 4 * (nbTranslations - index);	// 4 because block sizes are written in Uint32BE in the .dat file.
+	skipSize += 4 * (nbTranslations - index - 1);	// 4 because block sizes are written in Uint32BE in the .dat file.
 
 	// Seek to start of block we want to read
-	in.seek(skipSize, SEEK_CUR);
+	in->seek(skipSize, SEEK_CUR);
+	if (blockSize < 2 || in->pos() + blockSize > in->size()) {
+		warning("Invalid translation block for language '%s'", _langs[index].c_str());
+		return;
+	}
+
+	// Point into the mapped file, or copy the whole block at once
+	const char *block;
+	if (_mappedFile) {
+		block = (const char *)dynamic_cast<MemoryReadStream *>(in)->getData() + in->pos();
+	} else {
+		_currentTranslationData.resize(blockSize);
+		if (in->read(_currentTranslationData.data(), blockSize) != blockSize) {
+			_currentTranslationData.clear();
+			return;
+		}
+		block = _currentTranslationData.data();
+	}
 
 	// Read number of translated messages
-	int nbMessages = in.readUint16BE();
+	int nbMessages = READ_BE_UINT16(block);
 	_currentTranslationMessages.resize(nbMessages);
 
 	_currentCharset = "UTF-32";
 
-	// Read messages
-	for (int i = 0; i < nbMessages; ++i) {
-		_currentTranslationMessages[i].msgid = in.readUint16BE();
-		len = in.readUint16BE();
-		String msg;
-		while (len > 0) {
-			in.read(buf, len > 256 ? 256 : len);
-			msg += String(buf, len > 256 ? 256 : len - 1);
-			len -= 256;
-		}
-		_currentTranslationMessages[i].msgstr = msg.decode();
-		len = in.readUint16BE();
-		if (len > 0) {
-			in.read(buf, len);
-			_currentTranslationMessages[i].msgctxt = String(buf, len - 1);
-		}
+	// Index messages. The strings are stored with their terminating null
+	// character, so they are used in place.
+	uint32 pos = 2;
+	int i;
+	for (i = 0; i < nbMessages; ++i) {
+		if (pos + 6 > blockSize)
+			break;
+		_currentTranslationMessages[i].msgid = READ_BE_UINT16(block + pos);
+		uint32 len = READ_BE_UINT16(block + pos + 2);
+		pos += 4;
+		_currentTranslationMessages[i].msgstr = len ? block + pos : "";
+		pos += len;
+		if (pos + 2 > blockSize)
+			break;
+		len = READ_BE_UINT16(block + pos);
+		pos += 2;
+		_currentTranslationMessages[i].msgctxt = len ? block + pos : "";
+		pos += len;
+	}
+
+	if (i != nbMessages || pos > blockSize) {
+		warning("Invalid translation block for language '%s'", _langs[index].c_str());
+		_currentTranslationMessages.clear();
+		_currentTranslationData.clear();
+		_currentCharset.clear();
 	}
 }
 
-bool TranslationManager::checkHeader(File &in) {
+bool TranslationManager::checkHeader(SeekableReadStream &in, const String &name) {
 	char buf[13];
 	int ver;
 
@@ -394,7 +442,7 @@ bool TranslationManager::checkHeader(File &in) {
 
 	// Check header
 	if (strcmp(buf, "TRANSLATIONS") != 0) {
-		warning("File '%s' is not a valid translations data file. Skipping this file", in.getName());
+		warning("File '%s' is not a valid translations data file. Skipping this file", name.c_str());
 		return false;
 	}
 
@@ -402,7 +450,7 @@ bool TranslationManager::checkHeader(File &in) {
 	ver = in.readByte();
 
 	if (ver != TRANSLATIONS_DAT_VER) {
-		warning("File '%s' has a mismatching version, expected was %d but you got %d. Skipping this file", in.getName(), TRANSLATIONS_DAT_VER, ver);
+		warning("File '%s' has a mismatching version, expected was %d but you got %d. Skipping this file", name.c_str(), TRANSLATIONS_DAT_VER, ver);
 		return false;
 	}
 
@@ -24,6 +24,9 @@
 
 #include "common/array.h"
 #include "common/fs.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/ptr.h"
 #include "common/str.h"
 #include "common/singleton.h"
 #include "common/str-array.h"
@@ -42,8 +45,6 @@ namespace Common {
  * @{
  */
 
-class File;
-
 /**
  * Translation IDs.
  */
@@ -75,10 +76,11 @@ typedef Array<TLanguage> TLangArray;
  * Structure describing a translated message.
  */
 struct PoMessageEntry {
-	int msgid;         /*!< ID of the message. */
-	String msgctxt;    /*!< Context of the message. It can be empty.
-							Can be used to solve ambiguities. */
-	U32String msgstr;  /*!< Message string. */
+	int msgid;           /*!< ID of the message. */
+	const char *msgctxt; /*!< Context of the message. It can be empty.
+							  Can be used to solve ambiguities. */
+	const char *msgstr;  /*!< UTF-8 message string, decoded when it is first requested. */
+	mutable U32String decoded; /*!< Decoded message string, empty until it is requested. */
 };
 
 /**
@@ -211,16 +213,19 @@ private:
 	 * Find the translations.dat file.
 	 *
 	 * First, search using the SearchMan and then, if needed, using the Themepath.
-	 * If found, open the given @p File to read the translations.dat file.
+	 *
+	 * @return A stream positioned after the header of the translations.dat
+	 *         file, or nullptr if no valid file could be found.
 	 */
-	bool openTranslationsFile(File &);
+	SeekableReadStream *openTranslationsFile();
 
 	/**
 	 * Find the translations.dat file in the given directory node.
 	 *
-	 * If found, open the given @p File to read the translations.dat file.
+	 * @return A stream positioned after the header of the translations.dat
+	 *         file, or nullptr if no valid file could be found.
 	 */
-	bool openTranslationsFile(const FSNode &node, File &, int depth = -1);
+	SeekableReadStream *openTranslationsFile(const FSNode &node, int depth = -1);
 
 	/**
 	 * Load the list of languages from the translations.dat file.
@@ -230,6 +235,10 @@ private:
 	/**
 	 * Load the translation for the given language from the translations.dat file.
 	 *
+	 * Only the message index of the language is built. The messages stay in
+	 * the language block, which is either copied from the file or points
+	 * into the mapped file, and are decoded when they are requested.
+	 *
 	 * @param index Index of the language in the list of languages.
 	 */
 	void loadLanguageDat(int index);
@@ -237,13 +246,17 @@ private:
 	/**
 	 * Check the header of the given file to make sure it is a valid translations data file.
 	 */
-	bool checkHeader(File &in);
+	bool checkHeader(SeekableReadStream &in, const String &name);
+
+	typedef HashMap<String, int> MessageIdMap;
 
 	StringArray _langs;
 	U32StringArray _langNames;
 
-	StringArray _messageIds;
+	MessageIdMap _messageIds;
 	Array<PoMessageEntry> _currentTranslationMessages;
+	Array<char> _currentTranslationData;
+	ScopedPtr<SeekableReadStream> _mappedFile;
 	String _currentCharset;
 	int _currentLang;
 	Common::String _translationsFileName;
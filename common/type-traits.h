@@ -28,6 +28,27 @@ namespace Common {
 	template <typename T> struct RemoveConst { typedef T type; };
 	template <typename T> struct RemoveConst<const T> { typedef T type; };
 	template <typename T> struct AddConst { typedef const T type; };
+	template <typename T> struct RemoveReference { typedef T type; };
+	template <typename T> struct RemoveReference<T &> { typedef T type; };
+	template <typename T> struct RemoveReference<T &&> { typedef T type; };
+
+	/** Replacement for std::move: allow the object to be moved from. */
+	template<typename T>
+	inline typename RemoveReference<T>::type &&move(T &&t) {
+		return static_cast<typename RemoveReference<T>::type &&>(t);
+	}
+
+	/** Replacement for std::forward, for perfect forwarding of arguments. */
+	template<typename T>
+	inline T &&forward(typename RemoveReference<T>::type &t) {
+		return static_cast<T &&>(t);
+	}
+
+	/** @overload */
+	template<typename T>
+	inline T &&forward(typename RemoveReference<T>::type &&t) {
+		return static_cast<T &&>(t);
+	}
 } // End of namespace Common
 
 #endif
@@ -105,6 +105,9 @@ typedef struct {
 #include "common/fs.h"
 #include "common/unzip.h"
 #include "common/memstream.h"
+#include "common/ptr.h"
+#include "common/substream.h"
+#include "common/zlib.h"
 
 #include "common/hashmap.h"
 #include "common/hash-str.h"
@@ -381,6 +384,7 @@ typedef Common::HashMap<Common::String, cached_file_in_zip, Common::IgnoreCase_H
 */
 typedef struct {
 	Common::SeekableReadStream *_stream;				/* io structore of the zipfile */
+	Common::SharedPtr<Common::SeekableReadStream> _sharedStream; /* owns _stream, shared with stored members */
 	unz_global_info gi;				/* public global information */
 	uLong byte_before_the_zipfile;	/* byte before the zipfile, (>0 for sfx)*/
 	uLong num_file;					/* number of the current file in the zipfile*/
@@ -543,6 +547,7 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 	int err=UNZ_OK;
 
 	us->_stream = stream;
+	us->_sharedStream = Common::SharedPtr<Common::SeekableReadStream>(stream);
 
 	central_pos = unzlocal_SearchCentralDir(*us->_stream);
 	if (central_pos==0)
@@ -594,7 +599,6 @@ unzFile unzOpen(Common::SeekableReadStream *stream) {
 		err=UNZ_BADZIPFILE;
 
 	if (err != UNZ_OK) {
-		delete us->_stream;
 		delete us;
 		return nullptr;
 	}
@@ -643,7 +647,6 @@ int unzClose(unzFile file) {
 	if (s->pfile_in_zip_read != nullptr)
 		unzCloseCurrentFile(file);
 
-	delete s->_stream;
 	delete s;
 	return UNZ_OK;
 }
@@ -1418,6 +1421,117 @@ int unzGetGlobalComment(unzFile file, char *szComment, uLong uSizeBuf) {
 
 namespace Common {
 
+enum {
+	/** Deflated members of at least this size are decompressed while read */
+	kStreamedMemberSize = 512 * 1024
+};
+
+#ifdef USE_ZLIB
+
+/**
+ * A big deflated member, decompressed while it is read. Reading it from
+ * start to end verifies its CRC. Every backward seek would restart the
+ * decompression, so the first one inflates the whole member into memory
+ * instead, like for small members.
+ */
+class ZipMemberReadStream : public SeekableReadStream {
+	SeekableReadStream *_stream;
+	bool _buffered;
+	uint32 _size;
+	uLong _expectedCrc;
+	uLong _crc;
+	uint32 _crcSize; ///< Number of bytes from the start covered by _crc
+	bool _err;
+
+	void updateCrc(const void *data, uint32 pos, uint32 dataSize) {
+		// Only sequential reads from the start can be checked
+		if (pos != _crcSize)
+			return;
+
+		_crc = crc32(_crc, (const Bytef *)data, dataSize);
+		_crcSize += dataSize;
+		if (_crcSize == _size)
+			checkCrc();
+	}
+
+	void checkCrc() {
+		if (_crc != _expectedCrc) {
+			warning("ZipMemberReadStream: CRC mismatch");
+			_err = true;
+		}
+	}
+
+	bool bufferMember() {
+		byte *data = (byte *)malloc(_size);
+		if (!data || !_stream->seek(0) || _stream->read(data, _size) != _size) {
+			free(data);
+			_err = true;
+			return false;
+		}
+
+		_crc = crc32(0, data, _size);
+		checkCrc();
+
+		delete _stream;
+		_stream = new MemoryReadStream(data, _size, DisposeAfterUse::YES);
+		_buffered = true;
+		return true;
+	}
+
+public:
+	ZipMemberReadStream(SeekableReadStream *stream, uint32 size, uLong crc)
+		: _stream(stream), _buffered(false), _size(size), _expectedCrc(crc), _crc(crc32(0, nullptr, 0)), _crcSize(0), _err(false) {
+	}
+
+	~ZipMemberReadStream() override {
+		delete _stream;
+	}
+
+	bool err() const override { return _err || _stream->err(); }
+	void clearErr() override { _err = false; _stream->clearErr(); }
+	bool eos() const override { return _stream->eos(); }
+	int64 pos() const override { return _stream->pos(); }
+	int64 size() const override { return _size; }
+
+	uint32 read(void *dataPtr, uint32 dataSize) override {
+		const uint32 pos = _stream->pos();
+		const uint32 actual = _stream->read(dataPtr, dataSize);
+		if (!_buffered)
+			updateCrc(dataPtr, pos, actual);
+		return actual;
+	}
+
+	bool seek(int64 offset, int whence = SEEK_SET) override {
+		if (_buffered)
+			return _stream->seek(offset, whence);
+
+		int64 newPos = offset;
+		if (whence == SEEK_CUR)
+			newPos += pos();
+		else if (whence == SEEK_END)
+			newPos += _size;
+
+		if (newPos < 0 || newPos > _size)
+			return false;
+
+		if (newPos < pos()) {
+			if (!bufferMember())
+				return false;
+			return _stream->seek(newPos);
+		}
+
+		// Skip forward through read(), so that the CRC covers the skipped data
+		byte buffer[4096];
+		while (pos() < newPos) {
+			const uint32 chunk = (uint32)MIN<int64>(sizeof(buffer), newPos - pos());
+			if (read(buffer, chunk) != chunk)
+				return false;
+		}
+		return true;
+	}
+};
+
+#endif
 
 class ZipArchive : public Archive {
 	unzFile _zipFile;
@@ -1498,6 +1612,45 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const Path &path) cons
 	if (unzGetCurrentFileInfo(_zipFile, &fileInfo, nullptr, 0, nullptr, 0, nullptr, 0) != UNZ_OK)
 		return nullptr;
 
+	// Stored members are accessed in place, without copying them
+	const unz_s *const archive = (const unz_s *)_zipFile;
+	if (fileInfo.compression_method == 0 && fileInfo.compressed_size == fileInfo.uncompressed_size) {
+		const file_in_zip_read_info_s *const info = archive->pfile_in_zip_read;
+		uint32 begin = info->pos_in_zipfile + info->byte_before_the_zipfile;
+
+		if (unzCloseCurrentFile(_zipFile) != UNZ_OK)
+			return nullptr;
+
+		if ((int64)(begin + fileInfo.uncompressed_size) > archive->_stream->size())
+			return nullptr;
+
+		return createSharedSubReadStream(archive->_sharedStream, begin, begin + fileInfo.uncompressed_size);
+	}
+
+#ifdef USE_ZLIB
+	// Big deflated members are decompressed on the fly while they are read,
+	// instead of being inflated into memory up front. Each of them reads its
+	// compressed data through its own shared substream, so several members
+	// can be used independently. Small members are still inflated at once,
+	// which is cheaper for random access.
+	if (fileInfo.compression_method == Z_DEFLATED && fileInfo.uncompressed_size >= kStreamedMemberSize) {
+		const file_in_zip_read_info_s *const info = archive->pfile_in_zip_read;
+		uint32 begin = info->pos_in_zipfile + info->byte_before_the_zipfile;
+
+		if (unzCloseCurrentFile(_zipFile) != UNZ_OK)
+			return nullptr;
+
+		if ((int64)(begin + fileInfo.compressed_size) > archive->_stream->size())
+			return nullptr;
+
+		SeekableReadStream *compressed = createSharedSubReadStream(archive->_sharedStream, begin, begin + fileInfo.compressed_size);
+		SeekableReadStream *inflated = wrapHeaderlessCompressedReadStream(compressed, fileInfo.uncompressed_size);
+		if (!inflated)
+			return nullptr;
+		return new ZipMemberReadStream(inflated, fileInfo.uncompressed_size, fileInfo.crc);
+	}
+#endif
+
 	byte *buffer = (byte *)malloc(fileInfo.uncompressed_size);
 	assert(buffer);
 
@@ -1512,11 +1665,6 @@ SeekableReadStream *ZipArchive::createReadStreamForMember(const Path &path) cons
 	}
 
 	return new MemoryReadStream(buffer, fileInfo.uncompressed_size, DisposeAfterUse::YES);
-
-	// FIXME: instead of reading all into a memory stream, we could
-	// instead create a new ZipStream class. But then we have to be
-	// careful to handle the case where the client code opens multiple
-	// files in the archive and tries to use them independently.
 }
 
 Archive *makeZipArchive(const String &name) {
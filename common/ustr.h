@@ -76,6 +76,9 @@ public:
 	/** Construct a copy of the given string. */
 	U32String(const U32String &str) : BaseString<u32char_type_t>(str) {}
 
+	/** Construct a string by taking over the content of the given string, which is left empty. */
+	U32String(U32String &&str) : BaseString<u32char_type_t>(Common::move(str)) {}
+
 	/** Construct a new string from the given null-terminated C string that uses the given @p page encoding. */
 	explicit U32String(const char *str, CodePage page = kUtf8);
 
@@ -94,6 +97,9 @@ public:
 	/** Assign a given string to this string. */
 	U32String &operator=(const U32String &str);
 
+	/** @overload */
+	U32String &operator=(U32String &&str);
+
 	/** @overload */
 	U32String &operator=(const String &str);
 
@@ -28,6 +28,8 @@ namespace Common {
 
 NEResources::NEResources() {
 	_exe = nullptr;
+	_resourceTableOffset = 0;
+	_resourceAlign = 1;
 }
 
 NEResources::~NEResources() {
@@ -41,6 +43,7 @@ void NEResources::clear() {
 		_exe = nullptr;
 	}
 
+	_typeTables.clear();
 	_resources.clear();
 }
 
@@ -118,27 +121,53 @@ bool NEResources::readResourceTable(uint32 offset) {
 	if (!_exe->seek(offset))
 		return false;
 
-	uint32 align = 1 << _exe->readUint16LE();
+	_resourceTableOffset = offset;
+	_resourceAlign = 1 << _exe->readUint16LE();
 	uint16 typeID = _exe->readUint16LE();
 
+	// Only the types are read here, their resources once they are asked for
 	while (typeID != 0) {
+		TypeTable table;
+
 		// High bit of the type means integer type
-		WinResourceID type;
 		if (typeID & 0x8000)
-			type = typeID & 0x7FFF;
+			table.type = typeID & 0x7FFF;
 		else
-			type = getResourceString(*_exe, offset + typeID);
-
-		uint16 resCount = _exe->readUint16LE();
+			table.type = getResourceString(*_exe, offset + typeID);
 
+		table.count = _exe->readUint16LE();
 		_exe->skip(4); // reserved
 
-		for (int i = 0; i < resCount; i++) {
+		table.offset = _exe->pos();
+		_typeTables.push_back(table);
+
+		_exe->skip(table.count * 12);
+		typeID = _exe->readUint16LE();
+	}
+
+	return !_exe->eos();
+}
+
+const Array<NEResources::Resource> &NEResources::getResources(const WinResourceID &type) const {
+	ResourceMap::const_iterator it = _resources.find(type);
+	if (it != _resources.end())
+		return it->_value;
+
+	Array<Resource> &resources = _resources[type];
+
+	for (uint i = 0; i < _typeTables.size(); i++) {
+		const TypeTable &table = _typeTables[i];
+		if (!(table.type == type))
+			continue;
+
+		_exe->seek(table.offset);
+
+		for (int j = 0; j < table.count; j++) {
 			Resource res;
 
 			// Resource properties
-			res.offset = _exe->readUint16LE() * align;
-			res.size   = _exe->readUint16LE() * align;
+			res.offset = _exe->readUint16LE() * _resourceAlign;
+			res.size   = _exe->readUint16LE() * _resourceAlign;
 			res.flags  = _exe->readUint16LE();
 			uint16 id  = _exe->readUint16LE();
 			res.handle = _exe->readUint16LE();
@@ -150,20 +179,18 @@ bool NEResources::readResourceTable(uint32 offset) {
 			if (id & 0x8000)
 				res.id = id & 0x7FFF;
 			else
-				res.id = getResourceString(*_exe, offset + id);
+				res.id = getResourceString(*_exe, _resourceTableOffset + id);
 
-			if (typeID & 0x8000 && ((typeID & 0x7FFF) < ARRAYSIZE(s_resTypeNames)) && s_resTypeNames[typeID & 0x7FFF][0] != 0)
-				debug(2, "Found resource %s %s", s_resTypeNames[typeID & 0x7FFF], res.id.toString().c_str());
+			if (type.getID() < ARRAYSIZE(s_resTypeNames) && s_resTypeNames[type.getID()][0] != 0)
+				debug(2, "Found resource %s %s", s_resTypeNames[type.getID()], res.id.toString().c_str());
 			else
 				debug(2, "Found resource %s %s", type.toString().c_str(), res.id.toString().c_str());
 
-			_resources.push_back(res);
+			resources.push_back(res);
 		}
-
-		typeID = _exe->readUint16LE();
 	}
 
-	return true;
+	return resources;
 }
 
 String NEResources::getResourceString(SeekableReadStream &exe, uint32 offset) {
@@ -185,9 +212,11 @@ String NEResources::getResourceString(SeekableReadStream &exe, uint32 offset) {
 }
 
 const NEResources::Resource *NEResources::findResource(const WinResourceID &type, const WinResourceID &id) const {
-	for (List<Resource>::const_iterator it = _resources.begin(); it != _resources.end(); ++it)
-		if (it->type == type && it->id == id)
-			return &*it;
+	const Array<Resource> &resources = getResources(type);
+
+	for (uint i = 0; i < resources.size(); i++)
+		if (resources[i].id == id)
+			return &resources[i];
 
 	return nullptr;
 }
@@ -204,10 +233,10 @@ SeekableReadStream *NEResources::getResource(const WinResourceID &type, const Wi
 
 const Array<WinResourceID> NEResources::getIDList(const WinResourceID &type) const {
 	Array<WinResourceID> idArray;
+	const Array<Resource> &resources = getResources(type);
 
-	for (List<Resource>::const_iterator it = _resources.begin(); it != _resources.end(); ++it)
-		if (it->type == type)
-			idArray.push_back(it->id);
+	for (uint i = 0; i < resources.size(); i++)
+		idArray.push_back(resources[i].id);
 
 	return idArray;
 }
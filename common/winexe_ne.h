@@ -22,7 +22,8 @@
 #ifndef COMMON_WINEXE_NE_H
 #define COMMON_WINEXE_NE_H
 
-#include "common/list.h"
+#include "common/array.h"
+#include "common/hashmap.h"
 #include "common/str.h"
 #include "common/winexe.h"
 
@@ -37,7 +38,6 @@ namespace Common {
  * @{
  */
 
-template<class T> class Array;
 class SeekableReadStream;
 
 /**
@@ -90,13 +90,30 @@ private:
 	SeekableReadStream *_exe;        ///< Current file.
 	DisposeAfterUse::Flag _disposeFileHandle;
 
-	/** All resources. */
-	List<Resource> _resources;
+	/** Where the resources of a type are listed in the resource table. */
+	struct TypeTable {
+		WinResourceID type;
+		uint32 offset; ///< Offset of the first resource entry within the EXE.
+		uint16 count;  ///< Number of resource entries.
+	};
+
+	typedef HashMap<WinResourceID, Array<Resource>, WinResourceID_Hash, WinResourceID_EqualTo> ResourceMap;
+
+	uint32 _resourceTableOffset;
+	uint32 _resourceAlign;
+
+	/** All resource types, in the order of the resource table. */
+	Array<TypeTable> _typeTables;
+
+	/** Resources of the types which were asked for so far. */
+	mutable ResourceMap _resources;
 
 	/** Read the offset to the resource table. */
 	uint32 getResourceTableOffset();
-	/** Read the resource table. */
+	/** Read the list of resource types from the resource table. */
 	bool readResourceTable(uint32 offset);
+	/** Get all resources of a type, reading them on first use. */
+	const Array<Resource> &getResources(const WinResourceID &type) const;
 
 	/** Find a specific resource. */
 	const Resource *findResource(const WinResourceID &type, const WinResourceID &id) const;
@@ -38,6 +38,7 @@ PEResources::~PEResources() {
 
 void PEResources::clear() {
 	_sections.clear();
+	_typeDirectories.clear();
 	_resources.clear();
 	if (_exe) {
 		if (_disposeFileHandle == DisposeAfterUse::YES)
@@ -98,48 +99,57 @@ bool PEResources::loadFromEXE(SeekableReadStream *stream, DisposeAfterUse::Flag
 	_exe = stream;
 	_disposeFileHandle = disposeFileHandle;
 
-	Section &resSection = _sections[".rsrc"];
-	parseResourceLevel(resSection, resSection.offset, 0);
+	parseResourceTypes(_sections[".rsrc"]);
 
 	return true;
 }
 
-void PEResources::parseResourceLevel(Section &section, uint32 offset, int level) {
-	_exe->seek(offset + 12);
+WinResourceID PEResources::readResourceID(const Section &section) const {
+	uint32 value = _exe->readUint32LE();
 
-	uint16 namedEntryCount = _exe->readUint16LE();
-	uint16 intEntryCount = _exe->readUint16LE();
+	if (!(value & 0x80000000))
+		return value;
 
-	for (uint32 i = 0; i < (uint32)(namedEntryCount + intEntryCount); i++) {
-		uint32 value = _exe->readUint32LE();
+	uint32 startPos = _exe->pos();
+	_exe->seek(section.offset + (value & 0x7fffffff));
 
-		WinResourceID id;
+	// Read in the name, truncating from unicode to ascii
+	String name;
+	uint16 nameLength = _exe->readUint16LE();
+	while (nameLength--)
+		name += (char)(_exe->readUint16LE() & 0xff);
 
-		if (value & 0x80000000) {
-			value &= 0x7fffffff;
+	_exe->seek(startPos);
 
-			uint32 startPos = _exe->pos();
-			_exe->seek(section.offset + (value & 0x7fffffff));
+	return name;
+}
 
-			// Read in the name, truncating from unicode to ascii
-			String name;
-			uint16 nameLength = _exe->readUint16LE();
-			while (nameLength--)
-				name += (char)(_exe->readUint16LE() & 0xff);
+void PEResources::parseResourceTypes(const Section &section) {
+	_exe->seek(section.offset + 12);
 
-			_exe->seek(startPos);
+	uint16 namedEntryCount = _exe->readUint16LE();
+	uint16 intEntryCount = _exe->readUint16LE();
 
-			id = name;
-		} else {
-			id = value;
-		}
+	// The IDs of a type are only read once it is asked for
+	for (uint32 i = 0; i < (uint32)(namedEntryCount + intEntryCount); i++) {
+		WinResourceID type = readResourceID(section);
+		_typeDirectories[type] = section.offset + (_exe->readUint32LE() & 0x7fffffff);
+	}
+}
+
+void PEResources::parseResourceLevel(const Section &section, uint32 offset, int level) const {
+	_exe->seek(offset + 12);
+
+	uint16 namedEntryCount = _exe->readUint16LE();
+	uint16 intEntryCount = _exe->readUint16LE();
+
+	for (uint32 i = 0; i < (uint32)(namedEntryCount + intEntryCount); i++) {
+		WinResourceID id = readResourceID(section);
 
 		uint32 nextOffset = _exe->readUint32LE();
 		uint32 lastOffset = _exe->pos();
 
-		if (level == 0)
-			_curType = id;
-		else if (level == 1)
+		if (level == 1)
 			_curID = id;
 		else if (level == 2)
 			_curLang = id;
@@ -164,13 +174,32 @@ void PEResources::parseResourceLevel(Section &section, uint32 offset, int level)
 	}
 }
 
+const PEResources::IDMap *PEResources::getIDMap(const WinResourceID &type) const {
+	if (!_exe)
+		return nullptr;
+
+	TypeMap::const_iterator it = _resources.find(type);
+	if (it != _resources.end())
+		return &it->_value;
+
+	DirectoryMap::const_iterator dir = _typeDirectories.find(type);
+	if (dir == _typeDirectories.end())
+		return nullptr;
+
+	_curType = type;
+	_resources[type] = IDMap();
+	parseResourceLevel(_sections[".rsrc"], dir->_value, 1);
+
+	return &_resources[type];
+}
+
 const Array<WinResourceID> PEResources::getTypeList() const {
 	Array<WinResourceID> array;
 
 	if (!_exe)
 		return array;
 
-	for (TypeMap::const_iterator it = _resources.begin(); it != _resources.end(); it++)
+	for (DirectoryMap::const_iterator it = _typeDirectories.begin(); it != _typeDirectories.end(); it++)
 		array.push_back(it->_key);
 
 	return array;
@@ -179,12 +208,11 @@ const Array<WinResourceID> PEResources::getTypeList() const {
 const Array<WinResourceID> PEResources::getIDList(const WinResourceID &type) const {
 	Array<WinResourceID> array;
 
-	if (!_exe || !_resources.contains(type))
+	const IDMap *idMap = getIDMap(type);
+	if (!idMap)
 		return array;
 
-	const IDMap &idMap = _resources[type];
-
-	for (IDMap::const_iterator it = idMap.begin(); it != idMap.end(); it++)
+	for (IDMap::const_iterator it = idMap->begin(); it != idMap->end(); it++)
 		array.push_back(it->_key);
 
 	return array;
@@ -193,15 +221,11 @@ const Array<WinResourceID> PEResources::getIDList(const WinResourceID &type) con
 const Array<WinResourceID> PEResources::getLangList(const WinResourceID &type, const WinResourceID &id) const {
 	Array<WinResourceID> array;
 
-	if (!_exe || !_resources.contains(type))
-		return array;
-
-	const IDMap &idMap = _resources[type];
-
-	if (!idMap.contains(id))
+	const IDMap *idMap = getIDMap(type);
+	if (!idMap || !idMap->contains(id))
 		return array;
 
-	const LangMap &langMap = idMap[id];
+	const LangMap &langMap = (*idMap)[id];
 
 	for (LangMap::const_iterator it = langMap.begin(); it != langMap.end(); it++)
 		array.push_back(it->_key);
@@ -215,21 +239,17 @@ SeekableReadStream *PEResources::getResource(const WinResourceID &type, const Wi
 	if (langList.empty())
 		return nullptr;
 
-	const Resource &resource = _resources[type][id][langList[0]];
+	const Resource &resource = (*getIDMap(type))[id][langList[0]];
 	_exe->seek(resource.offset);
 	return _exe->readStream(resource.size);
 }
 
 SeekableReadStream *PEResources::getResource(const WinResourceID &type, const WinResourceID &id, const WinResourceID &lang) {
-	if (!_exe || !_resources.contains(type))
-		return nullptr;
-
-	const IDMap &idMap = _resources[type];
-
-	if (!idMap.contains(id))
+	const IDMap *idMap = getIDMap(type);
+	if (!idMap || !idMap->contains(id))
 		return nullptr;
 
-	const LangMap &langMap = idMap[id];
+	const LangMap &langMap = (*idMap)[id];
 
 	if (!langMap.contains(lang))
 		return nullptr;
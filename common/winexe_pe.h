@@ -22,6 +22,7 @@
 #ifndef COMMON_WINEXE_PE_H
 #define COMMON_WINEXE_PE_H
 
+#include "common/array.h"
 #include "common/hash-str.h"
 #include "common/hashmap.h"
 #include "common/str.h"
@@ -38,7 +39,6 @@ namespace Common {
  * @{
  */
 
-template<class T> class Array;
 class SeekableReadStream;
 
 /**
@@ -92,8 +92,10 @@ private:
 	SeekableReadStream *_exe;
 	DisposeAfterUse::Flag _disposeFileHandle;
 
-	void parseResourceLevel(Section &section, uint32 offset, int level);
-	WinResourceID _curType, _curID, _curLang;
+	WinResourceID readResourceID(const Section &section) const;
+	void parseResourceTypes(const Section &section);
+	void parseResourceLevel(const Section &section, uint32 offset, int level) const;
+	mutable WinResourceID _curType, _curID, _curLang;
 
 	struct Resource {
 		uint32 offset;
@@ -103,8 +105,15 @@ private:
 	typedef HashMap<WinResourceID, Resource, WinResourceID_Hash, WinResourceID_EqualTo> LangMap;
 	typedef HashMap<WinResourceID,  LangMap, WinResourceID_Hash, WinResourceID_EqualTo> IDMap;
 	typedef HashMap<WinResourceID,    IDMap, WinResourceID_Hash, WinResourceID_EqualTo> TypeMap;
+	typedef HashMap<WinResourceID,   uint32, WinResourceID_Hash, WinResourceID_EqualTo> DirectoryMap;
 
-	TypeMap _resources;
+	/** Offset of the ID directory of each type. */
+	DirectoryMap _typeDirectories;
+	/** Resources of the types which were asked for so far. */
+	mutable TypeMap _resources;
+
+	/** Get the resources of a type, reading them on first use (or 0 if non-existent). */
+	const IDMap *getIDMap(const WinResourceID &type) const;
 };
 
 /** @} */
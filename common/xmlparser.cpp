@@ -79,6 +79,13 @@ void XMLParser::close() {
 bool XMLParser::parserError(const String &errStr) {
 	_state = kParserError;
 
+	if (_compiledIn || !_stream) {
+		// There is no text to point at
+		Common::String errorMessage = Common::String::format("\n  File <%s>, compiled:\n\nParser error: %s\n\n", _fileName.c_str(), errStr.c_str());
+		g_system->logMessage(LogMessageType::kError, errorMessage.c_str());
+		return false;
+	}
+
 	const int startPosition = _stream->pos();
 	int currentPosition = startPosition;
 	int lineCount = 1;
@@ -297,10 +304,12 @@ bool XMLParser::closeKey() {
 	return result;
 }
 
-bool XMLParser::parse() {
+bool XMLParser::parse(WriteStream *compiled) {
 	if (_stream == nullptr)
 		return false;
 
+	_compiledOut = compiled;
+
 	// Make sure we are at the start of the stream.
 	_stream->seek(0, SEEK_SET);
 
@@ -386,6 +395,9 @@ bool XMLParser::parse() {
 
 		case kParserNeedPropertyName:
 			if (activeClosure) {
+				if (_compiledOut)
+					_compiledOut->writeByte(kCompiledKeyClosure);
+
 				if (!closeKey()) {
 					parserError("Missing data when closing key '" + _activeKey.top()->name + "'.");
 					break;
@@ -412,7 +424,13 @@ bool XMLParser::parse() {
 			if (_char == '>') {
 				if (activeHeader && !selfClosure) {
 					parserError("XML Header must be self-closed.");
-				} else if (parseActiveKey(selfClosure)) {
+					break;
+				}
+
+				if (_compiledOut)
+					writeCompiledKey(_activeKey.top(), selfClosure);
+
+				if (parseActiveKey(selfClosure)) {
 					_char = _stream->readByte();
 					_state = kParserNeedKey;
 				}
@@ -452,12 +470,116 @@ bool XMLParser::parse() {
 		}
 	}
 
+	_compiledOut = nullptr;
+
 	if (_state == kParserError)
 		return false;
 
 	if (_state != kParserNeedKey || !_activeKey.empty())
 		return parserError("Unexpected end of file.");
 
+	if (compiled)
+		compiled->writeByte(kCompiledEnd);
+
+	return true;
+}
+
+void XMLParser::writeCompiledKey(const ParserNode *node, bool closed) {
+	_compiledOut->writeByte(closed ? kCompiledClosedKey : kCompiledKey);
+	_compiledOut->writeByte(node->header);
+
+	_compiledOut->writeUint32LE(node->name.size());
+	_compiledOut->writeString(node->name);
+
+	_compiledOut->writeUint16LE(node->values.size());
+	for (StringMap::const_iterator i = node->values.begin(); i != node->values.end(); ++i) {
+		_compiledOut->writeUint32LE(i->_key.size());
+		_compiledOut->writeString(i->_key);
+		_compiledOut->writeUint32LE(i->_value.size());
+		_compiledOut->writeString(i->_value);
+	}
+}
+
+bool XMLParser::readCompiledString(String &str) {
+	uint32 len = _compiledIn->readUint32LE();
+	if (_compiledIn->eos() || len > (uint32)(_compiledIn->size() - _compiledIn->pos()))
+		return false;
+
+	str.clear();
+	while (len--)
+		str += (char)_compiledIn->readByte();
+
+	return true;
+}
+
+bool XMLParser::parseCompiled(SeekableReadStream &compiled) {
+	if (_XMLkeys == nullptr)
+		buildLayout();
+
+	while (!_activeKey.empty())
+		freeNode(_activeKey.pop());
+
+	cleanup();
+
+	_state = kParserNeedKey;
+	_compiledIn = &compiled;
+
+	while (_state != kParserError) {
+		const byte entry = compiled.readByte();
+		if (compiled.eos()) {
+			parserError("Unexpected end of compiled data.");
+			break;
+		}
+
+		if (entry == kCompiledEnd)
+			break;
+
+		if (entry == kCompiledKeyClosure) {
+			if (_activeKey.empty())
+				parserError("Unexpected closure.");
+			else if (!closeKey())
+				parserError("Missing data when closing key.");
+			continue;
+		}
+
+		if (entry != kCompiledKey && entry != kCompiledClosedKey) {
+			parserError("Invalid compiled data.");
+			break;
+		}
+
+		ParserNode *node = allocNode();
+		node->ignore = false;
+		node->header = compiled.readByte() != 0;
+		node->depth = _activeKey.size();
+		node->layout = nullptr;
+		_activeKey.push(node);
+
+		if (!readCompiledString(node->name)) {
+			parserError("Invalid compiled key name.");
+			break;
+		}
+
+		bool valid = true;
+		for (uint16 count = compiled.readUint16LE(); count && valid; count--) {
+			String name, value;
+			valid = readCompiledString(name) && readCompiledString(value);
+			node->values[name] = value;
+		}
+
+		if (!valid)
+			parserError("Invalid compiled key value.");
+		else
+			parseActiveKey(entry == kCompiledClosedKey);
+	}
+
+	_compiledIn = nullptr;
+
+	if (_state == kParserError)
+		return false;
+
+	if (!_activeKey.empty())
+		return parserError("Unexpected end of compiled data.");
+
 	return true;
 }
 
@@ -45,6 +45,7 @@ namespace Common {
  */
 
 class SeekableReadStream;
+class WriteStream;
 
 #define MAX_XML_DEPTH 8
 
@@ -100,7 +101,7 @@ public:
 	/**
 	 * Parser constructor.
 	 */
-	XMLParser() : _XMLkeys(nullptr), _stream(nullptr) {}
+	XMLParser() : _XMLkeys(nullptr), _stream(nullptr), _compiledOut(nullptr), _compiledIn(nullptr) {}
 
 	virtual ~XMLParser();
 
@@ -192,8 +193,20 @@ public:
 	/**
 	 * The actual parsing function.
 	 * Parses the loaded data stream, returns true if successful.
+	 *
+	 * @param compiled If set, the parsed keys and their properties are also
+	 *                 written to this stream, so that parseCompiled() can
+	 *                 repeat the same callbacks without reading the file again.
+	 */
+	bool parse(WriteStream *compiled = nullptr);
+
+	/**
+	 * Run the callbacks for the keys stored by parse() in a compiled stream.
+	 * The keys are validated against the layout like when parsing the XML
+	 * file, but the file does not need to be loaded or tokenized.
+	 * Returns true if successful.
 	 */
-	bool parse();
+	bool parseCompiled(SeekableReadStream &compiled);
 
 	/**
 	 * Returns the active node being parsed (the one on top of
@@ -355,6 +368,20 @@ private:
 	String _token; /** Current text token */
 
 	Stack<ParserNode *> _activeKey; /** Node stack of the parsed keys */
+
+	/** Entries of the compiled format written by parse(). */
+	enum CompiledEntry {
+		kCompiledEnd = 0,
+		kCompiledKey = 1,       ///< A key with its properties
+		kCompiledClosedKey = 2, ///< A self-closed key with its properties
+		kCompiledKeyClosure = 3 ///< The closure of the last open key
+	};
+
+	WriteStream *_compiledOut; /** Stream receiving the compiled keys while parsing */
+	SeekableReadStream *_compiledIn; /** Compiled stream being parsed */
+
+	void writeCompiledKey(const ParserNode *node, bool closed);
+	bool readCompiledString(String &str);
 };
 
 /** @} */
@@ -243,23 +243,28 @@ protected:
 
 public:
 
-	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0) : _wrapped(w), _stream() {
+	GZipReadStream(SeekableReadStream *w, uint32 knownSize = 0, bool headerless = false) : _wrapped(w), _stream() {
 		assert(w != nullptr);
 
-		// Verify file header is correct
-		w->seek(0, SEEK_SET);
-		uint16 header = w->readUint16BE();
-		assert(header == 0x1F8B ||
-		       ((header & 0x0F00) == 0x0800 && header % 31 == 0));
-
-		if (header == 0x1F8B) {
-			// Retrieve the original file size
-			w->seek(-4, SEEK_END);
-			_origSize = w->readUint32LE();
-		} else {
-			// Original size not available in zlib format
-			// use an otherwise known size if supplied.
+		if (headerless) {
+			// Raw deflate data does not carry the original size
 			_origSize = knownSize;
+		} else {
+			// Verify file header is correct
+			w->seek(0, SEEK_SET);
+			uint16 header = w->readUint16BE();
+			assert(header == 0x1F8B ||
+			       ((header & 0x0F00) == 0x0800 && header % 31 == 0));
+
+			if (header == 0x1F8B) {
+				// Retrieve the original file size
+				w->seek(-4, SEEK_END);
+				_origSize = w->readUint32LE();
+			} else {
+				// Original size not available in zlib format
+				// use an otherwise known size if supplied.
+				_origSize = knownSize;
+			}
 		}
 		_pos = 0;
 		w->seek(0, SEEK_SET);
@@ -270,7 +275,8 @@ public:
 		// the compressed file. This feature was added in zlib 1.2.0.4,
 		// released 10 August 2003.
 		// Note: This is *crucial* for savegame compatibility, do *not* remove!
-		_zlibErr = inflateInit2(&_stream, MAX_WBITS + 32);
+		// Negative windowBits select raw deflate data instead.
+		_zlibErr = inflateInit2(&_stream, headerless ? -MAX_WBITS : MAX_WBITS + 32);
 		if (_zlibErr != Z_OK)
 			return;
 
@@ -514,6 +520,18 @@ SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, ui
 	return toBeWrapped;
 }
 
+SeekableReadStream *wrapHeaderlessCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 uncompressedSize) {
+	if (!toBeWrapped)
+		return nullptr;
+
+#if defined(USE_ZLIB)
+	return new GZipReadStream(toBeWrapped, uncompressedSize, true);
+#else
+	delete toBeWrapped;
+	return nullptr;
+#endif
+}
+
 WriteStream *wrapCompressedWriteStream(WriteStream *toBeWrapped) {
 #if defined(USE_ZLIB)
 	if (toBeWrapped)
@@ -141,6 +141,24 @@ bool inflateZlibHeaderless(Common::WriteStream *dst, Common::SeekableReadStream
  */
 SeekableReadStream *wrapCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 knownSize = 0);
 
+/**
+ * Take an arbitrary SeekableReadStream containing raw deflate data, without
+ * any zlib or gzip header, and wrap it in a custom stream which provides
+ * transparent on-the-fly decompression. This is the format used by ZIP
+ * archive members.
+ *
+ * Data is only decompressed as it is read. Seeking backwards restarts the
+ * decompression from the start, so this is best suited to data read mostly
+ * sequentially.
+ *
+ * The created stream becomes responsible for freeing the passed stream.
+ * If there is no ZLIB support, NULL is returned and the stream is destroyed.
+ *
+ * @param toBeWrapped       the stream to be wrapped
+ * @param uncompressedSize  the size of the decompressed data
+ */
+SeekableReadStream *wrapHeaderlessCompressedReadStream(SeekableReadStream *toBeWrapped, uint32 uncompressedSize);
+
 /**
  * Take an arbitrary WriteStream and wrap it in a custom stream which provides
  * transparent on-the-fly compression. The compressed data is written in the
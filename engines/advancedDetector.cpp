@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug.h"
 #include "common/util.h"
 #include "common/file.h"
@@ -385,6 +386,7 @@ Common::Error AdvancedMetaEngineDetection::createInstance(OSystem *syst, Engine
 
 	// Run the detector on this
 	ADDetectedGames matches = detectGame(files.begin()->getParent(), allFiles, language, platform, extra);
+	MD5Man.flush();
 
 	if (cleanupPirated(matches))
 		return Common::kNoGameDataFoundError;
@@ -501,6 +503,148 @@ namespace Common {
 	DECLARE_SINGLETON(MD5CacheManager);
 }
 
+#define MD5CACHE_FILENAME "scummvm-md5cache.dat"
+#define MD5CACHE_VERSION 1
+
+static void writeCacheString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint32LE(str.size());
+	stream.writeString(str);
+}
+
+static bool readCacheString(Common::SeekableReadStream &stream, Common::String &str) {
+	uint32 len = stream.readUint32LE();
+	if (stream.eos() || len > (uint32)(stream.size() - stream.pos()))
+		return false;
+
+	char *buf = new char[len];
+	stream.read(buf, len);
+	str = Common::String(buf, len);
+	delete[] buf;
+	return !stream.err();
+}
+
+Common::FSNode MD5CacheManager::getPersistentCacheFile() const {
+	// The cache is stored next to the configuration file
+	Common::String configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return Common::FSNode();
+
+	Common::FSNode configNode(configFile);
+	Common::FSNode dir = configNode.getParent();
+	if (dir.getPath() == configNode.getPath() || !dir.isDirectory()) {
+		// Relative configuration file name, use the current directory
+		return Common::FSNode(MD5CACHE_FILENAME);
+	}
+
+	return dir.getChild(MD5CACHE_FILENAME);
+}
+
+void MD5CacheManager::loadPersistent() {
+	_persistentLoaded = true;
+
+	Common::FSNode file = getPersistentCacheFile();
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != MKTAG('S', 'M', 'D', '5') || stream->readUint32LE() != MD5CACHE_VERSION) {
+		debugC(3, kDebugGlobalDetection, "Ignoring MD5 cache '%s' with unknown format", file.getPath().c_str());
+		delete stream;
+		return;
+	}
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		Common::String key;
+		PersistentEntry entry;
+
+		if (!readCacheString(*stream, key))
+			break;
+		entry.fileSize = stream->readSint64LE();
+		entry.modificationTime = stream->readSint64LE();
+		entry.size = stream->readSint64LE();
+		if (!readCacheString(*stream, entry.md5))
+			break;
+
+		_persistent.setVal(key, entry);
+	}
+
+	debugC(3, kDebugGlobalDetection, "Loaded %u entries from MD5 cache '%s'", _persistent.size(), file.getPath().c_str());
+	delete stream;
+}
+
+bool MD5CacheManager::getPersistent(const Common::String &key, const Common::FSNode &node, Common::String &md5, int64 &size) {
+	if (!_persistentLoaded)
+		loadPersistent();
+
+	Common::String fullKey = key + ":" + node.getPath();
+	PersistentHashMap::iterator i = _persistent.find(fullKey);
+	if (i != _persistent.end()) {
+		int64 fileSize, modificationTime;
+		if (node.getFileStats(fileSize, modificationTime) &&
+		    fileSize == i->_value.fileSize && modificationTime == i->_value.modificationTime) {
+			md5 = i->_value.md5;
+			size = i->_value.size;
+			_hits++;
+			return true;
+		}
+
+		// The file changed since it was hashed
+		_persistent.erase(i);
+		_persistentDirty = true;
+	}
+
+	_misses++;
+	return false;
+}
+
+void MD5CacheManager::setPersistent(const Common::String &key, const Common::FSNode &node, const Common::String &md5, int64 size) {
+	if (!_persistentLoaded)
+		loadPersistent();
+
+	PersistentEntry entry;
+	if (!node.getFileStats(entry.fileSize, entry.modificationTime))
+		return;
+
+	entry.size = size;
+	entry.md5 = md5;
+	_persistent.setVal(key + ":" + node.getPath(), entry);
+	_persistentDirty = true;
+}
+
+void MD5CacheManager::flush() {
+	if (!_persistentDirty)
+		return;
+
+	Common::FSNode file = getPersistentCacheFile();
+	Common::WriteStream *stream = file.createWriteStream();
+	if (!stream) {
+		debugC(3, kDebugGlobalDetection, "Could not write MD5 cache '%s'", MD5CACHE_FILENAME);
+		return;
+	}
+
+	stream->writeUint32BE(MKTAG('S', 'M', 'D', '5'));
+	stream->writeUint32LE(MD5CACHE_VERSION);
+	stream->writeUint32LE(_persistent.size());
+	for (PersistentHashMap::const_iterator i = _persistent.begin(); i != _persistent.end(); ++i) {
+		writeCacheString(*stream, i->_key);
+		stream->writeSint64LE(i->_value.fileSize);
+		stream->writeSint64LE(i->_value.modificationTime);
+		stream->writeSint64LE(i->_value.size);
+		writeCacheString(*stream, i->_value.md5);
+	}
+
+	stream->finalize();
+	if (!stream->err())
+		_persistentDirty = false;
+	delete stream;
+}
+
 // Sync with engines/game.cpp
 static char flagsToMD5Prefix(uint32 flags) {
 	if (flags & ADGF_MACRESFORK) {
@@ -525,7 +669,21 @@ bool AdvancedMetaEngineDetection::getFileProperties(const FileMap &allFiles, con
 		return true;
 	}
 
-	bool res = getFilePropertiesIntern(_md5Bytes, allFiles, game, fname, fileProps);
+	// Resource forks may live in a different file than the one listed, so
+	// only plain files go through the persistent cache.
+	bool persistent = !(game.flags & ADGF_MACRESFORK) && allFiles.contains(fname);
+	Common::String persistentKey = Common::String::format("%c:%d", flagsToMD5Prefix(game.flags), _md5Bytes);
+	bool res = false;
+
+	if (persistent)
+		res = MD5Man.getPersistent(persistentKey, allFiles[fname], fileProps.md5, fileProps.size);
+
+	if (!res) {
+		res = getFilePropertiesIntern(_md5Bytes, allFiles, game, fname, fileProps);
+
+		if (res && persistent)
+			MD5Man.setPersistent(persistentKey, allFiles[fname], fileProps.md5, fileProps.size);
+	}
 
 	if (res) {
 		MD5Man.setMD5(hashname, fileProps.md5);
@@ -579,16 +737,33 @@ ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &pa
 
 	const ADGameFileDescription *fileDesc;
 	const ADGameDescription *g;
-	const byte *descPtr;
 
 	debugC(3, kDebugGlobalDetection, "Starting detection for engine '%s' in dir '%s'", getEngineId(), parent.getPath().c_str());
 
 	preprocessDescriptions();
 
+	// Only entries with at least one of their files present can match,
+	// so collect those through the index and keep them in table order.
+	Common::Array<uint> found = _unindexedDescriptions;
+	for (FileMap::const_iterator file = allFiles.begin(); file != allFiles.end(); ++file) {
+		DescriptionIndex::const_iterator entries = _descriptionIndex.find(file->_key);
+		if (entries != _descriptionIndex.end())
+			found.push_back(entries->_value);
+	}
+	Common::sort(found.begin(), found.end());
+
+	Common::Array<uint> candidates;
+	for (uint c = 0; c < found.size(); c++) {
+		if (candidates.empty() || candidates.back() != found[c])
+			candidates.push_back(found[c]);
+	}
+
+	debugC(3, kDebugGlobalDetection, "Checking %d of the detection entries", candidates.size());
+
 	// Check which files are included in some ADGameDescription *and* whether
 	// they are present. Compute MD5s and file sizes for the available files.
-	for (descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
-		g = (const ADGameDescription *)descPtr;
+	for (uint c = 0; c < candidates.size(); c++) {
+		g = (const ADGameDescription *)(_gameDescriptors + candidates[c] * _descItemSize);
 
 		for (fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
 			Common::String fname = fileDesc->fileName;
@@ -612,9 +787,9 @@ ADDetectedGames AdvancedMetaEngineDetection::detectGame(const Common::FSNode &pa
 	bool gotAnyMatchesWithAllFiles = false;
 
 	// MD5 based matching
-	uint i;
-	for (i = 0, descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize, ++i) {
-		g = (const ADGameDescription *)descPtr;
+	for (uint c = 0; c < candidates.size(); c++) {
+		uint i = candidates[c];
+		g = (const ADGameDescription *)(_gameDescriptors + i * _descItemSize);
 
 		// Do not even bother to look at entries which do not have matching
 		// language and platform (if specified).
@@ -826,9 +1001,23 @@ void AdvancedMetaEngineDetection::preprocessDescriptions() {
 	}
 
 	// Now scan all detection entries
-	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize) {
+	uint index = 0;
+	for (const byte *descPtr = _gameDescriptors; ((const ADGameDescription *)descPtr)->gameId != nullptr; descPtr += _descItemSize, index++) {
 		const ADGameDescription *g = (const ADGameDescription *)descPtr;
 
+		// Index the entry by its file names. Resource forks may be stored
+		// under a different name, and entries without files match any
+		// directory, so these are always checked.
+		if ((g->flags & ADGF_MACRESFORK) || !g->filesDescriptions[0].fileName) {
+			_unindexedDescriptions.push_back(index);
+		} else {
+			for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
+				Common::Array<uint> &entries = _descriptionIndex[fileDesc->fileName];
+				if (entries.empty() || entries.back() != index)
+					entries.push_back(index);
+			}
+		}
+
 		// Scan for potential directory globs
 		for (const ADGameFileDescription *fileDesc = g->filesDescriptions; fileDesc->fileName; fileDesc++) {
 			if (strchr(fileDesc->fileName, '/')) {
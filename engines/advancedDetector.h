@@ -25,13 +25,13 @@
 #include "engines/metaengine.h"
 #include "engines/engine.h"
 
+#include "common/fs.h"
 #include "common/hash-str.h"
 
 #include "common/gui_options.h" // FIXME: Temporary hack?
 
 namespace Common {
 class Error;
-class FSList;
 }
 /**
  * @defgroup engines_advdetector Advanced Detector
@@ -412,6 +412,19 @@ private:
 	Common::HashMap<Common::String, bool, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _globsMap;
 	bool _hashMapsInited;
 
+	/**
+	 * For each file name, the indices of the detection entries which
+	 * require it. Lets detectGame() skip entries whose files are missing.
+	 */
+	typedef Common::HashMap<Common::String, Common::Array<uint>, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> DescriptionIndex;
+	DescriptionIndex _descriptionIndex;
+
+	/**
+	 * Indices of the detection entries which cannot be found through the
+	 * index and are always checked, e.g. ones matching resource forks.
+	 */
+	Common::Array<uint> _unindexedDescriptions;
+
 protected:
 	/**
 	 * Detect games in the specified directory.
@@ -530,6 +543,12 @@ public:
 
 /**
  * Singleton Cache Storage for Computed MD5s
+ *
+ * Besides the per-detection cache, which is cleared before each detection
+ * run, the manager keeps a persistent cache stored next to the configuration
+ * file. Its entries are keyed by the full path of a file, the MD5 prefix and
+ * the number of hashed bytes, and are only reused while the size and the
+ * modification time of the file stay the same.
  */
 class MD5CacheManager : public Common::Singleton<MD5CacheManager> {
 public:
@@ -553,15 +572,55 @@ public:
 		return (md5HashMap.contains(fname) && sizeHashMap.contains(fname));
 	}
 
-	MD5CacheManager() {
+	MD5CacheManager() : _persistentLoaded(false), _persistentDirty(false), _hits(0), _misses(0) {
 		clear();
 	}
 
+	/**
+	 * Clear the per-detection cache. The persistent cache is not affected.
+	 */
 	void clear() {
 		md5HashMap.clear(true);
 		sizeHashMap.clear(true);
 	}
 
+	/**
+	 * Look up the properties of a file in the persistent cache.
+	 *
+	 * Stale entries, for which the size or the modification time of the file
+	 * changed, are dropped.
+	 *
+	 * @param key   Cache key, identifying the MD5 prefix and the hashed byte count.
+	 * @param node  The file to look up.
+	 * @param md5   Receives the cached MD5.
+	 * @param size  Receives the cached size.
+	 *
+	 * @return True if a valid entry was found.
+	 */
+	bool getPersistent(const Common::String &key, const Common::FSNode &node, Common::String &md5, int64 &size);
+
+	/**
+	 * Store the properties of a file in the persistent cache.
+	 *
+	 * Nothing is stored if the backend cannot report the size and the
+	 * modification time of the file.
+	 */
+	void setPersistent(const Common::String &key, const Common::FSNode &node, const Common::String &md5, int64 size);
+
+	/**
+	 * Write the persistent cache back to disk if it was modified.
+	 */
+	void flush();
+
+	/** Reset the persistent cache hit and miss counters. */
+	void resetStats() { _hits = _misses = 0; }
+
+	/** Return the number of files whose MD5 was found in the persistent cache. */
+	uint getHits() const { return _hits; }
+
+	/** Return the number of files that had to be hashed. */
+	uint getMisses() const { return _misses; }
+
 private:
 	friend class Common::Singleton<MD5CacheManager>;
 
@@ -569,6 +628,25 @@ private:
 	typedef Common::HashMap<Common::String, int64, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> SizeHashMap;
 	FileHashMap md5HashMap;
 	SizeHashMap sizeHashMap;
+
+	struct PersistentEntry {
+		int64 fileSize;
+		int64 modificationTime;
+		int64 size;
+		Common::String md5;
+	};
+
+	// Paths are case-sensitive on most file systems, so the persistent
+	// cache uses a case-sensitive map.
+	typedef Common::HashMap<Common::String, PersistentEntry> PersistentHashMap;
+	PersistentHashMap _persistent;
+	bool _persistentLoaded;
+	bool _persistentDirty;
+	uint _hits;
+	uint _misses;
+
+	Common::FSNode getPersistentCacheFile() const;
+	void loadPersistent();
 };
 
 /** Convenience shortcut for accessing the MD5CacheManager. */
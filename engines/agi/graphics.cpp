@@ -394,6 +394,16 @@ void GfxMgr::clear(byte color, byte priority) {
 	memset(_priorityScreen, priority, _pixels);
 }
 
+void GfxMgr::saveGameScreens(byte *visual, byte *priority) const {
+	memcpy(visual, _gameScreen, _pixels);
+	memcpy(priority, _priorityScreen, _pixels);
+}
+
+void GfxMgr::restoreGameScreens(const byte *visual, const byte *priority) {
+	memcpy(_gameScreen, visual, _pixels);
+	memcpy(_priorityScreen, priority, _pixels);
+}
+
 void GfxMgr::clearDisplay(byte color, bool copyToScreen) {
 	memset(_displayScreen, color, _displayPixels);
 
@@ -161,6 +161,9 @@ public:
 	void debugShowMap(int mapNr);
 
 	void clear(byte color, byte priority);
+	uint getGameScreenSize() const { return _pixels; }
+	void saveGameScreens(byte *visual, byte *priority) const;
+	void restoreGameScreens(const byte *visual, const byte *priority);
 	void clearDisplay(byte color, bool copyToScreen = true);
 	void putPixel(int16 x, int16 y, byte drawMask, byte color, byte priority);
 	void putPixelOnDisplay(int16 x, int16 y, byte color);
@@ -38,6 +38,7 @@ PictureMgr::PictureMgr(AgiBase *agi, GfxMgr *gfx) {
 
 	_patCode = _patNum = _priOn = _scrOn = _scrColor = _priColor = 0;
 	_xOffset = _yOffset = 0;
+	_pictureCacheCounter = 0;
 
 	_pictureVersion = AGIPIC_V2;
 	_minCommand = 0xf0;
@@ -930,14 +931,48 @@ int PictureMgr::decodePicture(int16 resourceNr, bool clearScreen, bool agi256, i
 	_width = pic_width;
 	_height = pic_height;
 
-	if (clearScreen && !agi256) { // 256 color pictures should always fill the whole screen, so no clearing for them.
-		_gfx->clear(15, 4); // Clear 16 color AGI screen (Priority 4, color white).
-	}
+	// A picture drawn onto a cleared screen always results in the same
+	// screens, so those are taken from the cache when possible
+	CachedPicture *cached = nullptr;
+	if (isPictureCacheable(clearScreen, agi256)) {
+		const uint32 dataHash = hashPictureData();
+		CachedPicture *oldest = &_pictureCache[0];
+		for (uint i = 0; i < kPictureCacheSize; i++) {
+			CachedPicture &entry = _pictureCache[i];
+			if (entry.resourceNr == resourceNr && entry.dataSize == _dataSize && entry.dataHash == dataHash) {
+				cached = &entry;
+				break;
+			}
+			if (entry.lastUse < oldest->lastUse)
+				oldest = &entry;
+		}
 
-	if (!agi256) {
-		drawPicture(); // Draw 16 color picture.
+		if (!cached) {
+			_gfx->clear(15, 4);
+			drawPicture();
+
+			cached = oldest;
+			cached->resourceNr = resourceNr;
+			cached->dataSize = _dataSize;
+			cached->dataHash = dataHash;
+			cached->visual.resize(_gfx->getGameScreenSize());
+			cached->priority.resize(_gfx->getGameScreenSize());
+			_gfx->saveGameScreens(cached->visual.data(), cached->priority.data());
+		} else {
+			debugC(8, kDebugLevelResources, "Using cached picture %d", resourceNr);
+			_gfx->restoreGameScreens(cached->visual.data(), cached->priority.data());
+		}
+		cached->lastUse = ++_pictureCacheCounter;
 	} else {
-		drawPictureAGI256();
+		if (clearScreen && !agi256) { // 256 color pictures should always fill the whole screen, so no clearing for them.
+			_gfx->clear(15, 4); // Clear 16 color AGI screen (Priority 4, color white).
+		}
+
+		if (!agi256) {
+			drawPicture(); // Draw 16 color picture.
+		} else {
+			drawPictureAGI256();
+		}
 	}
 
 	if (clearScreen)
@@ -947,6 +982,23 @@ int PictureMgr::decodePicture(int16 resourceNr, bool clearScreen, bool agi256, i
 	return errOK;
 }
 
+bool PictureMgr::isPictureCacheable(bool clearScreen, bool agi256) const {
+	// Only full size 16 color pictures without any special drawing modes
+	return clearScreen && !agi256 && !_flags && !_xOffset && !_yOffset
+		&& _width == _DEFAULT_WIDTH && _height == _DEFAULT_HEIGHT
+		&& _gfx->getGameScreenSize() == _DEFAULT_WIDTH * _DEFAULT_HEIGHT;
+}
+
+uint32 PictureMgr::hashPictureData() const {
+	// FNV-1a, to notice when a resource number is reused for other data
+	uint32 hash = 2166136261u;
+	for (uint32 i = 0; i < _dataSize; i++) {
+		hash ^= _data[i];
+		hash *= 16777619u;
+	}
+	return hash;
+}
+
 /**
  * Decode an AGI picture resource.
  * This function decodes an AGI picture resource into the correct slot
@@ -157,6 +157,33 @@ private:
 
 	int _flags;
 	int _currentStep;
+
+	/**
+	 * Screens resulting from decoding a picture resource onto a cleared
+	 * screen. Rooms are drawn again each time they are entered, and the
+	 * flood fills make decoding expensive. Anything added on top of the
+	 * picture later, like add.to.pic, is not part of the cached screens.
+	 */
+	struct CachedPicture {
+		int16 resourceNr;
+		uint32 dataSize;
+		uint32 dataHash;
+		uint32 lastUse;
+		Common::Array<byte> visual;
+		Common::Array<byte> priority;
+
+		CachedPicture() : resourceNr(-1), dataSize(0), dataHash(0), lastUse(0) {}
+	};
+
+	enum {
+		kPictureCacheSize = 8
+	};
+
+	bool isPictureCacheable(bool clearScreen, bool agi256) const;
+	uint32 hashPictureData() const;
+
+	CachedPicture _pictureCache[kPictureCacheSize];
+	uint32 _pictureCacheCounter;
 };
 
 } // End of namespace Agi
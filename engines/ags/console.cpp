@@ -35,6 +35,7 @@ AGSConsole::AGSConsole(AGSEngine *vm) : GUI::Debugger(), _vm(vm), _logOutputTarg
 	registerCmd("ags_set_script_dump", WRAP_METHOD(AGSConsole, Cmd_SetScriptDump));
 	registerCmd("ags_sprite_info",   WRAP_METHOD(AGSConsole, Cmd_getSpriteInfo));
 	registerCmd("ags_sprite_dump",  WRAP_METHOD(AGSConsole, Cmd_dumpSprite));
+	registerCmd("ags_sprite_cache_stats",  WRAP_METHOD(AGSConsole, Cmd_spriteCacheStats));
 
 	_logOutputTarget = new LogOutputTarget();
 	_agsDebuggerOutput = _GP(DbgMgr).RegisterOutput("ScummVMLog", _logOutputTarget, AGS3::AGS::Shared::kDbgMsg_None);
@@ -244,6 +245,27 @@ bool AGSConsole::Cmd_dumpSprite(int argc, const char **argv) {
 	return true;
 }
 
+bool AGSConsole::Cmd_spriteCacheStats(int argc, const char **argv) {
+	if (argc > 2 || (argc == 2 && strcmp(argv[1], "reset") != 0)) {
+		debugPrintf("Usage: %s [reset]\n", argv[0]);
+		return true;
+	}
+
+	const AGS3::AGS::Shared::SpriteCache &spriteset = _GP(spriteset);
+	const AGS3::AGS::Shared::SpriteCache::Statistics &stats = spriteset.GetStatistics();
+	const AGS3::uint32_t lookups = stats.Hits + stats.Misses;
+	debugPrintf("Size: %u KB of %u KB, %u KB locked, %u slots\n",
+		(uint)(spriteset.GetCacheSize() / 1024), (uint)(spriteset.GetMaxCacheSize() / 1024),
+		(uint)(spriteset.GetLockedSize() / 1024), (uint)spriteset.GetSpriteSlotCount());
+	debugPrintf("Hits: %u, misses: %u (%.1f%% hit rate)\n", stats.Hits, stats.Misses,
+		lookups ? stats.Hits * 100.0 / lookups : 0.0);
+	debugPrintf("Evictions: %u, prefetched: %u\n", stats.Evictions, stats.Prefetched);
+
+	if (argc == 2)
+		_GP(spriteset).ResetStatistics();
+	return true;
+}
+
 LogOutputTarget::LogOutputTarget() {
 }
 
@@ -418,6 +418,29 @@ static void reset_temp_room() {
 	_GP(troom) = RoomStatus();
 }
 
+// Loads the sprites shown when the room starts, in one pass over the sprite
+// file, rather than one by one while the first frames are drawn
+static void prefetch_room_sprites(int newnum) {
+	std::vector<sprkey_t> sprites;
+	for (int i = 0; i < _G(croom)->numobj; ++i) {
+		const RoomObject &obj = _G(croom)->obj[i];
+		if (obj.on)
+			sprites.push_back(obj.num);
+	}
+	for (int i = 0; i < _GP(game).numcharacters; ++i) {
+		const CharacterInfo &chr = _GP(game).chars[i];
+		if ((chr.room != newnum) || !chr.on || (chr.view < 0) || (chr.view >= _GP(game).numviews))
+			continue;
+		const ViewStruct &view = _GP(views)[chr.view];
+		if (chr.loop >= view.numLoops)
+			continue;
+		const ViewLoopNew &loop = view.loops[chr.loop];
+		for (int f = 0; f < loop.numFrames; ++f)
+			sprites.push_back(loop.frames[f].pic);
+	}
+	_GP(spriteset).PrefetchSprites(sprites);
+}
+
 // forchar = playerchar on NewRoom, or NULL if restore saved game
 void load_new_room(int newnum, CharacterInfo *forchar) {
 
@@ -859,6 +882,7 @@ void load_new_room(int newnum, CharacterInfo *forchar) {
 	update_polled_stuff_if_runtime();
 	generate_light_table();
 	update_music_volume();
+	prefetch_room_sprites(newnum);
 
 	// If we are not restoring a save, update cameras to accomodate for this
 	// new room; otherwise this is done later when cameras are recreated.
@@ -0,0 +1,779 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/scummsys.h"
+
+#if defined(USE_OPENGL_SHADERS)
+
+#include "common/config-manager.h"
+#include "engines/util.h"
+#include "graphics/renderer.h"
+#include "graphics/opengl/context.h"
+#include "graphics/opengl/shader.h"
+#include "math/vector3d.h"
+#include "ags/engine/gfx/ali_3d_ogl.h"
+#include "ags/engine/gfx/ali_3d_scummvm.h"
+#include "ags/engine/gfx/gfxfilter_ogl.h"
+#include "ags/engine/ac/sys_events.h"
+#include "ags/engine/ac/timer.h"
+#include "ags/engine/platform/base/ags_platform_driver.h"
+#include "ags/engine/platform/base/sys_main.h"
+#include "ags/shared/gfx/bitmap.h"
+#include "ags/globals.h"
+
+namespace AGS3 {
+namespace AGS {
+namespace Engine {
+namespace OGL {
+
+using namespace Shared;
+
+// Unit quad, drawn as a triangle strip and transformed by the shaders
+static const GLfloat quadVertices[] = {
+	0.0f, 0.0f,
+	1.0f, 0.0f,
+	0.0f, 1.0f,
+	1.0f, 1.0f
+};
+
+static int nextPowerOfTwo(int value) {
+	int result = 1;
+	while (result < value)
+		result <<= 1;
+	return result;
+}
+
+
+// ----------------------------------------------------------------------------
+// Transform2D
+// ----------------------------------------------------------------------------
+
+Transform2D Transform2D::Translate(float x, float y) {
+	Transform2D m;
+	m.c = x;
+	m.f = y;
+	return m;
+}
+
+Transform2D Transform2D::Scale(float sx, float sy) {
+	Transform2D m;
+	m.a = sx;
+	m.e = sy;
+	return m;
+}
+
+Transform2D Transform2D::Rotate(float angle) {
+	Transform2D m;
+	m.a = cos(angle);
+	m.b = -sin(angle);
+	m.d = sin(angle);
+	m.e = cos(angle);
+	return m;
+}
+
+Transform2D Transform2D::operator*(const Transform2D &m) const {
+	Transform2D r;
+	r.a = a * m.a + b * m.d;
+	r.b = a * m.b + b * m.e;
+	r.c = a * m.c + b * m.f + c;
+	r.d = d * m.a + e * m.d;
+	r.e = d * m.b + e * m.e;
+	r.f = d * m.c + e * m.f + f;
+	return r;
+}
+
+void Transform2D::Apply(float &x, float &y) const {
+	const float tx = a * x + b * y + c;
+	y = d * x + e * y + f;
+	x = tx;
+}
+
+
+// ----------------------------------------------------------------------------
+// OGLBitmap
+// ----------------------------------------------------------------------------
+
+OGLBitmap::~OGLBitmap() {
+	for (auto &tile : _tiles) {
+		if (tile.texture)
+			glDeleteTextures(1, &tile.texture);
+	}
+}
+
+
+// ----------------------------------------------------------------------------
+// OGLGraphicsDriver
+// ----------------------------------------------------------------------------
+
+OGLGraphicsDriver::OGLGraphicsDriver() {
+	// The textures are uploaded as bytes in RGBA order
+#ifdef SCUMM_LITTLE_ENDIAN
+	_vmem_r_shift_32 = 0;
+	_vmem_g_shift_32 = 8;
+	_vmem_b_shift_32 = 16;
+	_vmem_a_shift_32 = 24;
+#else
+	_vmem_r_shift_32 = 24;
+	_vmem_g_shift_32 = 16;
+	_vmem_b_shift_32 = 8;
+	_vmem_a_shift_32 = 0;
+#endif
+
+	// Initialize default sprite batch, it will be used when no other batch was activated
+	OGLGraphicsDriver::InitSpriteBatch(0, _spriteBatchDesc[0]);
+}
+
+OGLGraphicsDriver::~OGLGraphicsDriver() {
+	OGLGraphicsDriver::UnInit();
+}
+
+bool OGLGraphicsDriver::IsModeSupported(const DisplayMode &mode) {
+	if (mode.Width <= 0 || mode.Height <= 0 || mode.ColorDepth <= 0) {
+		warning("Invalid resolution parameters: %d x %d x %d",
+			mode.Width, mode.Height, mode.ColorDepth);
+		return false;
+	}
+	return OGLGraphicsFactory::IsAvailable();
+}
+
+int OGLGraphicsDriver::GetDisplayDepthForNativeDepth(int native_color_depth) const {
+	// All the textures are 32-bit, whatever the game uses
+	return 32;
+}
+
+IGfxModeList *OGLGraphicsDriver::GetSupportedModeList(int color_depth) {
+	std::vector<DisplayMode> modes;
+	sys_get_desktop_modes(modes);
+	return new ALSW::ScummVMRendererGfxModeList(modes);
+}
+
+PGfxFilter OGLGraphicsDriver::GetGraphicsFilter() const {
+	return _filter;
+}
+
+void OGLGraphicsDriver::SetGraphicsFilter(POGLFilter filter) {
+	_filter = filter;
+	OnSetFilter();
+}
+
+bool OGLGraphicsDriver::SetDisplayMode(const DisplayMode &mode) {
+	ReleaseDisplayMode();
+
+	if (_initGfxCallback != nullptr)
+		_initGfxCallback(nullptr);
+
+	if (!IsModeSupported(mode))
+		return false;
+
+	initGraphics3d(mode.Width, mode.Height);
+	if (OpenGLContext.type == OpenGL::kOGLContextNone || !OpenGLContext.shadersSupported) {
+		warning("OpenGL renderer: no shader capable context available");
+		return false;
+	}
+	if (!CreateShaders())
+		return false;
+
+	OnInit();
+	OnModeSet(mode);
+	return true;
+}
+
+void OGLGraphicsDriver::UpdateDeviceScreen(const Size &screen_sz) {
+	_mode.Width = screen_sz.Width;
+	_mode.Height = screen_sz.Height;
+}
+
+bool OGLGraphicsDriver::CreateShaders() {
+	static const char *attributes[] = { "position", nullptr };
+	_spriteShader = OpenGL::ShaderGL::fromFiles("ags_sprite", attributes);
+	_tintShader = OpenGL::ShaderGL::fromFiles("ags_sprite", "ags_tint", attributes);
+	_lightShader = OpenGL::ShaderGL::fromFiles("ags_sprite", "ags_light", attributes);
+
+	_quadVBO = OpenGL::ShaderGL::createBuffer(GL_ARRAY_BUFFER, sizeof(quadVertices), quadVertices);
+	OpenGL::ShaderGL *shaders[] = { _spriteShader, _tintShader, _lightShader };
+	for (auto shader : shaders) {
+		shader->enableVertexAttribute("position", _quadVBO, 2, GL_FLOAT, GL_FALSE, 2 * sizeof(float), 0);
+		shader->use();
+		shader->setUniform("tex", 0u);
+	}
+	return true;
+}
+
+void OGLGraphicsDriver::DestroyShaders() {
+	if (_quadVBO)
+		OpenGL::ShaderGL::freeBuffer(_quadVBO);
+	_quadVBO = 0;
+	delete _spriteShader;
+	delete _tintShader;
+	delete _lightShader;
+	_spriteShader = _tintShader = _lightShader = nullptr;
+}
+
+void OGLGraphicsDriver::ReleaseDisplayMode() {
+	if (!IsModeSet())
+		return;
+
+	OnModeReleased();
+	ClearDrawLists();
+	_backupBatchDescs.clear();
+	_backupBatches.clear();
+	DestroyFxPool();
+	DestroyAllStageScreens();
+	DestroyShaders();
+}
+
+bool OGLGraphicsDriver::SetNativeResolution(const GraphicResolution &native_res) {
+	OnSetNativeRes(native_res);
+	// Stage screen for the plugins which draw upon the whole screen
+	_stageVirtualScreen = CreateStageScreen(0, _srcRect.GetSize());
+	return !_srcRect.IsEmpty();
+}
+
+bool OGLGraphicsDriver::SetRenderFrame(const Rect &dst_rect) {
+	OnSetRenderFrame(dst_rect);
+	return !_dstRect.IsEmpty();
+}
+
+void OGLGraphicsDriver::UnInit() {
+	OnUnInit();
+	ReleaseDisplayMode();
+}
+
+int OGLGraphicsDriver::GetCompatibleBitmapFormat(int color_depth) {
+	if (color_depth == 8)
+		return 8;
+	if (color_depth > 8 && color_depth <= 16)
+		return 16;
+	return 32;
+}
+
+IDriverDependantBitmap *OGLGraphicsDriver::CreateDDB(int width, int height, int color_depth, bool opaque) {
+	if (color_depth != GetCompatibleBitmapFormat(color_depth))
+		error("CreateDDB: color depth %d not supported", color_depth);
+
+	OGLBitmap *ddb = new OGLBitmap(width, height, color_depth, opaque);
+
+	// Split the bitmap into tiles only if it does not fit in a single texture
+	const int maxSize = OpenGLContext.maxTextureSize > 0 ? OpenGLContext.maxTextureSize : 1024;
+	const bool linear = _filter && _filter->UseLinearFiltering();
+	for (int y = 0; y < height; y += maxSize) {
+		for (int x = 0; x < width; x += maxSize) {
+			OGLTextureTile tile;
+			tile.x = x;
+			tile.y = y;
+			tile.width = MIN(width - x, maxSize);
+			tile.height = MIN(height - y, maxSize);
+			tile.texWidth = OpenGLContext.NPOTSupported ? tile.width : nextPowerOfTwo(tile.width);
+			tile.texHeight = OpenGLContext.NPOTSupported ? tile.height : nextPowerOfTwo(tile.height);
+
+			glGenTextures(1, &tile.texture);
+			glBindTexture(GL_TEXTURE_2D, tile.texture);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, linear ? GL_LINEAR : GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, linear ? GL_LINEAR : GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+			glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA, tile.texWidth, tile.texHeight, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+			ddb->_tiles.push_back(tile);
+		}
+	}
+	ddb->_linearFiltered = linear;
+	return ddb;
+}
+
+void OGLGraphicsDriver::UpdateTextureRegion(const OGLTextureTile &tile, const Bitmap *bitmap, bool opaque, bool hasAlpha) {
+	const int pitch = tile.width * 4;
+	_texPixels.resize(pitch * tile.height);
+	char *pixels = (char *)&_texPixels[0];
+	if (opaque)
+		BitmapToVideoMemOpaque(bitmap, hasAlpha, &tile, pixels, pitch);
+	else
+		BitmapToVideoMem(bitmap, hasAlpha, &tile, pixels, pitch, _filter && _filter->UseLinearFiltering());
+
+	glBindTexture(GL_TEXTURE_2D, tile.texture);
+	glPixelStorei(GL_UNPACK_ALIGNMENT, 4);
+	glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, tile.width, tile.height, GL_RGBA, GL_UNSIGNED_BYTE, pixels);
+}
+
+void OGLGraphicsDriver::UpdateDDBFromBitmap(IDriverDependantBitmap *bitmapToUpdate, Bitmap *bitmap, bool hasAlpha) {
+	OGLBitmap *target = (OGLBitmap *)bitmapToUpdate;
+	if (target->_width != bitmap->GetWidth() || target->_height != bitmap->GetHeight())
+		error("UpdateDDBFromBitmap: mismatched bitmap size");
+	const int color_depth = bitmap->GetColorDepth();
+	if (color_depth != target->_colDepth)
+		error("UpdateDDBFromBitmap: mismatched colour depths");
+
+	target->_hasAlpha = hasAlpha;
+	if (color_depth == 8)
+		select_palette(_G(palette));
+
+	for (const auto &tile : target->_tiles)
+		UpdateTextureRegion(tile, bitmap, target->_opaque, hasAlpha);
+
+	if (color_depth == 8)
+		unselect_palette();
+}
+
+void OGLGraphicsDriver::DestroyDDB(IDriverDependantBitmap *bitmap) {
+	// Remove deleted DDB from the backups of the last frame
+	for (auto &batch : _backupBatches) {
+		for (auto &entry : batch.List) {
+			if (entry.bitmap == bitmap)
+				entry.skip = true;
+		}
+	}
+	delete (OGLBitmap *)bitmap;
+}
+
+void OGLGraphicsDriver::InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) {
+	if (_spriteBatches.size() <= index)
+		_spriteBatches.resize(index + 1);
+	OGLSpriteBatch &batch = _spriteBatches[index];
+	batch.List.clear();
+
+	// Sprites are positioned relative to the viewport and scaled from its
+	// top-left corner, while the rotation and the flip are done around its centre
+	const Rect &viewport = desc.Viewport;
+	const SpriteTransform &transform = desc.Transform;
+	const float centre_x = viewport.Left + viewport.GetWidth() / 2.f;
+	const float centre_y = viewport.Top + viewport.GetHeight() / 2.f;
+	Transform2D matrix = Transform2D::Translate(viewport.Left, viewport.Top) *
+		Transform2D::Scale(transform.ScaleX, transform.ScaleY) *
+		Transform2D::Translate(transform.X, transform.Y);
+	if (transform.Rotate != 0.f)
+		matrix = Transform2D::Translate(centre_x, centre_y) * Transform2D::Rotate(transform.Rotate) *
+			Transform2D::Translate(-centre_x, -centre_y) * matrix;
+	// Horizontal flip mirrors over the horizontal middle line, and the vertical one over the vertical line
+	const float flip_x = (desc.Flip == kFlip_Vertical || desc.Flip == kFlip_Both) ? -1.f : 1.f;
+	const float flip_y = (desc.Flip == kFlip_Horizontal || desc.Flip == kFlip_Both) ? -1.f : 1.f;
+	if (desc.Flip != kFlip_None)
+		matrix = Transform2D::Translate(centre_x, centre_y) * Transform2D::Scale(flip_x, flip_y) *
+			Transform2D::Translate(-centre_x, -centre_y) * matrix;
+	batch.Matrix = Transform2D::Translate(desc.Offset.X, desc.Offset.Y) * matrix;
+	batch.Viewport = Rect::MoveBy(viewport, desc.Offset.X, desc.Offset.Y);
+
+	// Stage screen for the plugins drawing in this batch
+	if (!viewport.IsEmpty()) {
+		const Size src_size((int)(viewport.GetWidth() / transform.ScaleX), (int)(viewport.GetHeight() / transform.ScaleY));
+		_stageVirtualScreen = CreateStageScreen(index, src_size);
+	}
+}
+
+void OGLGraphicsDriver::ResetAllBatches() {
+	for (auto &batch : _spriteBatches)
+		batch.List.clear();
+}
+
+void OGLGraphicsDriver::DrawSprite(int x, int y, IDriverDependantBitmap *bitmap) {
+	_spriteBatches[_actSpriteBatch].List.push_back(OGLDrawListEntry((OGLBitmap *)bitmap, x, y));
+}
+
+void OGLGraphicsDriver::SetScreenFade(int red, int green, int blue) {
+	OGLBitmap *ddb = static_cast<OGLBitmap *>(MakeFx(red, green, blue));
+	const Rect &viewport = _spriteBatchDesc[_actSpriteBatch].Viewport;
+	ddb->SetStretch(viewport.GetWidth(), viewport.GetHeight(), false);
+	ddb->SetTransparency(0);
+	_spriteBatches[_actSpriteBatch].List.push_back(OGLDrawListEntry(ddb));
+}
+
+void OGLGraphicsDriver::SetScreenTint(int red, int green, int blue) {
+	if (red == 0 && green == 0 && blue == 0)
+		return;
+	OGLBitmap *ddb = static_cast<OGLBitmap *>(MakeFx(red, green, blue));
+	const Rect &viewport = _spriteBatchDesc[_actSpriteBatch].Viewport;
+	ddb->SetStretch(viewport.GetWidth(), viewport.GetHeight(), false);
+	ddb->SetTransparency(128);
+	_spriteBatches[_actSpriteBatch].List.push_back(OGLDrawListEntry(ddb));
+}
+
+Transform2D OGLGraphicsDriver::GetScreenMatrix() const {
+	// Native frame to the render destination, and then device pixels to
+	// the normalized coordinates, which go upwards
+	return Transform2D::Translate(-1.f, 1.f) * Transform2D::Scale(2.f / _mode.Width, -2.f / _mode.Height) *
+		Transform2D::Translate(_dstRect.Left, _dstRect.Top) *
+		Transform2D::Scale((float)_dstRect.GetWidth() / _srcRect.GetWidth(), (float)_dstRect.GetHeight() / _srcRect.GetHeight());
+}
+
+void OGLGraphicsDriver::RenderSprite(const OGLDrawListEntry &entry, const Transform2D &matrix) {
+	OGLBitmap *bmp = entry.bitmap;
+	if (bmp->_transparency >= 255)
+		return; // fully transparent, do nothing
+
+	// Here _transparency is used as alpha (between 1 and 254), but 0 means opaque
+	const float alpha = bmp->_transparency ? bmp->_transparency / 255.f : 1.f;
+	OpenGL::ShaderGL *shader = _spriteShader;
+	if (bmp->_tintSaturation > 0) {
+		float hue, saturation, value;
+		rgb_to_hsv(bmp->_red, bmp->_green, bmp->_blue, &hue, &saturation, &value);
+		shader = _tintShader;
+		shader->use();
+		// In HSV, hue is between 0 and 360
+		shader->setUniform("tintHSV", ::Math::Vector3d(hue / 360.f, saturation, value));
+		shader->setUniform1f("tintAmount", bmp->_tintSaturation / 256.f);
+		shader->setUniform1f("tintLuminance", bmp->_lightLevel > 0 ? bmp->_lightLevel / 255.f : 1.f);
+	} else if (bmp->_lightLevel > 0 && bmp->_lightLevel != 256) {
+		// Light levels below 256 darken the sprite, consistently with the software
+		// renderer which does a trans blend; levels above it brighten the sprite
+		float light;
+		if (bmp->_lightLevel < 256)
+			light = -((bmp->_lightLevel * 192) / 256 + 64) / 255.f;
+		else
+			light = ((bmp->_lightLevel - 256) / 2) / 255.f;
+		shader = _lightShader;
+		shader->use();
+		shader->setUniform1f("light", light);
+	} else {
+		shader->use();
+	}
+	shader->setUniform1f("alpha", alpha);
+
+	// Stretched sprites are only smoothed if the engine allows it
+	const bool linear = (_filter && _filter->UseLinearFiltering()) ||
+		(_smoothScaling && bmp->_useResampler && (bmp->_stretchToWidth > 0 || bmp->_stretchToHeight > 0));
+
+	const float scale_x = (float)bmp->GetWidthToRender() / bmp->_width;
+	const float scale_y = (float)bmp->GetHeightToRender() / bmp->_height;
+	for (const auto &tile : bmp->_tiles) {
+		// Place the tile, mirroring it within the sprite if needed
+		const int tile_x = bmp->_flipped ? bmp->_width - tile.x - tile.width : tile.x;
+		const Transform2D tile_matrix = matrix *
+			Transform2D::Translate(entry.x + tile_x * scale_x, entry.y + tile.y * scale_y) *
+			Transform2D::Scale(tile.width * scale_x, tile.height * scale_y);
+		shader->setUniform("transformX", ::Math::Vector3d(tile_matrix.a, tile_matrix.b, tile_matrix.c));
+		shader->setUniform("transformY", ::Math::Vector3d(tile_matrix.d, tile_matrix.e, tile_matrix.f));
+
+		const float u = (float)tile.width / tile.texWidth;
+		const float v = (float)tile.height / tile.texHeight;
+		shader->setUniform("texRect", bmp->_flipped ? ::Math::Vector4d(u, 0.f, -u, v) : ::Math::Vector4d(0.f, 0.f, u, v));
+
+		glBindTexture(GL_TEXTURE_2D, tile.texture);
+		if (linear != bmp->_linearFiltered) {
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, linear ? GL_LINEAR : GL_NEAREST);
+			glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, linear ? GL_LINEAR : GL_NEAREST);
+		}
+		glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	}
+	bmp->_linearFiltered = linear;
+}
+
+void OGLGraphicsDriver::RenderSpriteBatch(const OGLSpriteBatch &batch, const Transform2D &screen) {
+	const Transform2D matrix = screen * batch.Matrix;
+	for (const auto &entry : batch.List) {
+		if (entry.skip)
+			continue;
+		if (entry.bitmap == nullptr) {
+			if (DoNullSpriteCallback(entry.x, entry.y))
+				RenderSprite(OGLDrawListEntry((OGLBitmap *)_stageVirtualScreenDDB), matrix);
+		} else {
+			RenderSprite(entry, matrix);
+		}
+	}
+}
+
+void OGLGraphicsDriver::RenderImpl(bool present) {
+	glViewport(0, 0, _mode.Width, _mode.Height);
+	glDisable(GL_SCISSOR_TEST);
+	glClearColor(0.f, 0.f, 0.f, 1.f);
+	glClear(GL_COLOR_BUFFER_BIT);
+
+	glDisable(GL_DEPTH_TEST);
+	glDisable(GL_CULL_FACE);
+	glEnable(GL_BLEND);
+	glBlendFunc(GL_SRC_ALPHA, GL_ONE_MINUS_SRC_ALPHA);
+	glEnable(GL_SCISSOR_TEST);
+
+	const Transform2D screen = GetScreenMatrix();
+	const Transform2D to_device = Transform2D::Translate(_dstRect.Left, _dstRect.Top) *
+		Transform2D::Scale((float)_dstRect.GetWidth() / _srcRect.GetWidth(), (float)_dstRect.GetHeight() / _srcRect.GetHeight());
+	for (size_t i = 0; i <= _actSpriteBatch && i < _spriteBatches.size(); ++i) {
+		const OGLSpriteBatch &batch = _spriteBatches[i];
+		if (batch.List.empty())
+			continue;
+
+		// Clip to the viewport; the scissor box starts from the bottom of the screen
+		float left = batch.Viewport.Left, top = batch.Viewport.Top;
+		float right = batch.Viewport.Right + 1, bottom = batch.Viewport.Bottom + 1;
+		to_device.Apply(left, top);
+		to_device.Apply(right, bottom);
+		const int clip_l = (int)left, clip_t = (int)top;
+		glScissor(clip_l, _mode.Height - (int)bottom, (int)right - clip_l, (int)bottom - clip_t);
+
+		_stageVirtualScreen = GetStageScreen(i);
+		RenderSpriteBatch(batch, screen);
+	}
+	_stageVirtualScreen = GetStageScreen(0);
+
+	glDisable(GL_SCISSOR_TEST);
+	glDisable(GL_BLEND);
+	_spriteShader->unbind();
+
+	if (present)
+		g_system->updateScreen();
+}
+
+void OGLGraphicsDriver::BackupDrawLists() {
+	_backupBatchDescs = _spriteBatchDesc;
+	_backupBatches = _spriteBatches;
+}
+
+void OGLGraphicsDriver::RestoreDrawLists() {
+	if (_backupBatchDescs.empty())
+		return;
+	_spriteBatchDesc = _backupBatchDescs;
+	_spriteBatches = _backupBatches;
+	_actSpriteBatch = _backupBatchDescs.size() - 1;
+}
+
+void OGLGraphicsDriver::RenderToBackBuffer() {
+	error("OGL driver does not have a back buffer");
+}
+
+void OGLGraphicsDriver::Render() {
+	Render(0, 0, kFlip_None);
+}
+
+void OGLGraphicsDriver::Render(int /*xoff*/, int /*yoff*/, GlobalFlipType /*flip*/) {
+	// The offset and the flip are given with each sprite batch
+	RenderImpl(true);
+	BackupDrawLists();
+	ClearDrawLists();
+	ResetFxPool();
+}
+
+bool OGLGraphicsDriver::GetCopyOfScreenIntoBitmap(Bitmap *destination, bool at_native_res, GraphicResolution *want_fmt) {
+	// The pixels are read in 32-bit RGBA, regardless of the display mode
+	const int read_in_colordepth = 32;
+	const Size need_size = at_native_res ? _srcRect.GetSize() : _dstRect.GetSize();
+	if (destination->GetColorDepth() != read_in_colordepth || destination->GetSize() != need_size) {
+		if (want_fmt)
+			*want_fmt = GraphicResolution(need_size.Width, need_size.Height, read_in_colordepth);
+		return false;
+	}
+
+	// The back buffer is undefined once presented, so draw the last frame
+	// again, keeping aside the lists which may be in construction
+	const SpriteBatchDescs descs = _spriteBatchDesc;
+	const OGLSpriteBatches batches = _spriteBatches;
+	const size_t act_batch = _actSpriteBatch;
+	RestoreDrawLists();
+	RenderImpl(false);
+	_spriteBatchDesc = descs;
+	_spriteBatches = batches;
+	_actSpriteBatch = act_batch;
+
+	const int width = _dstRect.GetWidth();
+	const int height = _dstRect.GetHeight();
+	_texPixels.resize(width * height * 4);
+	glPixelStorei(GL_PACK_ALIGNMENT, 4);
+	glReadPixels(_dstRect.Left, _mode.Height - _dstRect.Bottom - 1, width, height, GL_RGBA, GL_UNSIGNED_BYTE, &_texPixels[0]);
+
+	// The frame is only drawn at the screen resolution, so it is scaled
+	// down afterwards when the native resolution is wanted
+	Bitmap *screen = destination;
+	if (need_size != _dstRect.GetSize())
+		screen = BitmapHelper::CreateBitmap(width, height, read_in_colordepth);
+
+	// The rows are read starting from the bottom
+	const uint8 *src = &_texPixels[0];
+	for (int y = height - 1; y >= 0; --y, src += width * 4) {
+		uint32 *dst = (uint32 *)screen->GetScanLineForWriting(y);
+		for (int x = 0; x < width; ++x)
+			dst[x] = makeacol32(src[x * 4], src[x * 4 + 1], src[x * 4 + 2], 0xFF);
+	}
+
+	if (screen != destination) {
+		destination->StretchBlt(screen, RectWH(0, 0, width, height),
+		                        RectWH(0, 0, destination->GetWidth(), destination->GetHeight()));
+		delete screen;
+	}
+
+	if (_pollingCallback)
+		_pollingCallback();
+	return true;
+}
+
+void OGLGraphicsDriver::DoFade(bool fadingOut, int speed, int targetColourRed, int targetColourGreen, int targetColourBlue) {
+	// Construct scene in order: game screen, fade fx, post game overlay.
+	// The last frame is redrawn when fading out, because games may change
+	// the room before the fade, and those changes should not be shown yet.
+	if (fadingOut)
+		RestoreDrawLists();
+	else if (_drawScreenCallback != nullptr)
+		_drawScreenCallback();
+
+	Bitmap *blackSquare = BitmapHelper::CreateBitmap(16, 16, 32);
+	blackSquare->Clear(makecol32(targetColourRed, targetColourGreen, targetColourBlue));
+	IDriverDependantBitmap *ddb = CreateDDBFromBitmap(blackSquare, false, true);
+	delete blackSquare;
+	BeginSpriteBatch(_srcRect, SpriteTransform());
+	ddb->SetStretch(_srcRect.GetWidth(), _srcRect.GetHeight(), false);
+	DrawSprite(0, 0, ddb);
+	if (_drawPostScreenCallback != nullptr)
+		_drawPostScreenCallback();
+
+	if (speed <= 0)
+		speed = 16;
+	speed *= 2; // harmonise speeds with software driver which is faster
+	for (int a = 1; a < 255; a += speed) {
+		ddb->SetTransparency(fadingOut ? a : (255 - a));
+		RenderImpl(true);
+
+		sys_evt_process_pending();
+		if (_pollingCallback)
+			_pollingCallback();
+		WaitForNextFrame();
+	}
+
+	if (fadingOut) {
+		ddb->SetTransparency(0);
+		RenderImpl(true);
+	}
+
+	DestroyDDB(ddb);
+	ClearDrawLists();
+	ResetFxPool();
+}
+
+void OGLGraphicsDriver::FadeOut(int speed, int targetColourRed, int targetColourGreen, int targetColourBlue) {
+	DoFade(true, speed, targetColourRed, targetColourGreen, targetColourBlue);
+}
+
+void OGLGraphicsDriver::FadeIn(int speed, PALETTE pal, int targetColourRed, int targetColourGreen, int targetColourBlue) {
+	DoFade(false, speed, targetColourRed, targetColourGreen, targetColourBlue);
+}
+
+void OGLGraphicsDriver::BoxOutEffect(bool blackingOut, int speed, int delay) {
+	// Construct scene in order: game screen, fade fx, post game overlay
+	if (blackingOut)
+		RestoreDrawLists();
+	else if (_drawScreenCallback != nullptr)
+		_drawScreenCallback();
+
+	Bitmap *blackSquare = BitmapHelper::CreateBitmap(16, 16, 32);
+	blackSquare->Clear();
+	IDriverDependantBitmap *ddb = CreateDDBFromBitmap(blackSquare, false, true);
+	delete blackSquare;
+	BeginSpriteBatch(_srcRect, SpriteTransform());
+	const size_t fx_batch = _actSpriteBatch;
+	ddb->SetStretch(_srcRect.GetWidth(), _srcRect.GetHeight(), false);
+	DrawSprite(0, 0, ddb);
+	if (!blackingOut) {
+		// when fading in, draw four black boxes, one
+		// across each side of the screen
+		DrawSprite(0, 0, ddb);
+		DrawSprite(0, 0, ddb);
+		DrawSprite(0, 0, ddb);
+	}
+	if (_drawPostScreenCallback != nullptr)
+		_drawPostScreenCallback();
+
+	const int yspeed = _srcRect.GetHeight() / (_srcRect.GetWidth() / speed);
+	int boxWidth = speed;
+	int boxHeight = yspeed;
+	while (boxWidth < _srcRect.GetWidth()) {
+		boxWidth += speed;
+		boxHeight += yspeed;
+		std::vector<OGLDrawListEntry> &drawList = _spriteBatches[fx_batch].List;
+		const size_t last = drawList.size() - 1;
+		if (blackingOut) {
+			drawList[last].x = _srcRect.GetWidth() / 2 - boxWidth / 2;
+			drawList[last].y = _srcRect.GetHeight() / 2 - boxHeight / 2;
+			ddb->SetStretch(boxWidth, boxHeight, false);
+		} else {
+			drawList[last - 3].x = _srcRect.GetWidth() / 2 - boxWidth / 2 - _srcRect.GetWidth();
+			drawList[last - 2].y = _srcRect.GetHeight() / 2 - boxHeight / 2 - _srcRect.GetHeight();
+			drawList[last - 1].x = _srcRect.GetWidth() / 2 + boxWidth / 2;
+			drawList[last].y = _srcRect.GetHeight() / 2 + boxHeight / 2;
+			ddb->SetStretch(_srcRect.GetWidth(), _srcRect.GetHeight(), false);
+		}
+
+		RenderImpl(true);
+
+		sys_evt_process_pending();
+		if (_pollingCallback)
+			_pollingCallback();
+		_G(platform)->Delay(delay);
+	}
+
+	DestroyDDB(ddb);
+	ClearDrawLists();
+	ResetFxPool();
+}
+
+
+OGLGraphicsFactory *OGLGraphicsFactory::_factory = nullptr;
+
+OGLGraphicsFactory::~OGLGraphicsFactory() {
+	_factory = nullptr;
+}
+
+size_t OGLGraphicsFactory::GetFilterCount() const {
+	return 2;
+}
+
+const GfxFilterInfo *OGLGraphicsFactory::GetFilterInfo(size_t index) const {
+	switch (index) {
+	case 0:
+		return &OGLGfxFilter::FilterInfo;
+	case 1:
+		return &OGLGfxFilter::LinearFilterInfo;
+	default:
+		return nullptr;
+	}
+}
+
+String OGLGraphicsFactory::GetDefaultFilterID() const {
+	return OGLGfxFilter::FilterInfo.Id;
+}
+
+/* static */ bool OGLGraphicsFactory::IsAvailable() {
+	// The software renderer stays the default one, this one is only used
+	// when the OpenGL shaders renderer was picked in the options
+	const Graphics::RendererType type = Graphics::Renderer::parseTypeCode(ConfMan.get("renderer"));
+	return type == Graphics::kRendererTypeOpenGLShaders &&
+		(Graphics::Renderer::getAvailableTypes() & Graphics::kRendererTypeOpenGLShaders) != 0;
+}
+
+/* static */ OGLGraphicsFactory *OGLGraphicsFactory::GetFactory() {
+	if (!_factory)
+		_factory = new OGLGraphicsFactory();
+	return _factory;
+}
+
+OGLGraphicsDriver *OGLGraphicsFactory::EnsureDriverCreated() {
+	if (!_driver)
+		_driver = new OGLGraphicsDriver();
+	return _driver;
+}
+
+OGLGfxFilter *OGLGraphicsFactory::CreateFilter(const String &id) {
+	if (OGLGfxFilter::FilterInfo.Id.CompareNoCase(id) == 0)
+		return new OGLGfxFilter();
+	if (OGLGfxFilter::LinearFilterInfo.Id.CompareNoCase(id) == 0)
+		return new OGLGfxFilter(true);
+	return nullptr;
+}
+
+} // namespace OGL
+} // namespace Engine
+} // namespace AGS
+} // namespace AGS3
+
+#endif
@@ -0,0 +1,285 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+//=============================================================================
+//
+// Hardware accelerated graphics driver; keeps the driver-dependant bitmaps
+// in OpenGL textures and draws the sprite batches with shaders, which apply
+// the transparency, tint and light level of each sprite.
+//
+//=============================================================================
+
+#ifndef AGS_ENGINE_GFX_ALI_3D_OGL_H
+#define AGS_ENGINE_GFX_ALI_3D_OGL_H
+
+#include "common/scummsys.h"
+
+#if defined(USE_OPENGL_SHADERS)
+
+#include "ags/lib/std/memory.h"
+#include "ags/lib/std/vector.h"
+#include "ags/engine/gfx/ddb.h"
+#include "ags/engine/gfx/gfx_driver_factory_base.h"
+#include "ags/engine/gfx/gfx_driver_base.h"
+#include "graphics/opengl/system_headers.h"
+
+namespace OpenGL {
+class ShaderGL;
+}
+
+namespace AGS3 {
+namespace AGS {
+namespace Engine {
+namespace OGL {
+
+class OGLGraphicsDriver;
+class OGLGfxFilter;
+using AGS::Shared::Bitmap;
+
+struct OGLTextureTile : public TextureTile {
+	GLuint texture = 0;
+	// Size of the texture, which may be larger than the tile
+	// if the context only supports power of two sizes
+	int texWidth = 0, texHeight = 0;
+};
+
+class OGLBitmap : public BaseDDB {
+public:
+	// Transparency is a bit counter-intuitive
+	// 0=not transparent, 255=invisible, 1..254 barely visible .. mostly visible
+	int  GetTransparency() const override {
+		return _transparency;
+	}
+	void SetTransparency(int transparency) override {
+		_transparency = transparency;
+	}
+	void SetFlippedLeftRight(bool isFlipped) override {
+		_flipped = isFlipped;
+	}
+	void SetStretch(int width, int height, bool useResampler = true) override {
+		_stretchToWidth = width;
+		_stretchToHeight = height;
+		_useResampler = useResampler;
+	}
+	void SetLightLevel(int lightLevel) override {
+		_lightLevel = lightLevel;
+	}
+	void SetTint(int red, int green, int blue, int tintSaturation) override {
+		_red = red;
+		_green = green;
+		_blue = blue;
+		_tintSaturation = tintSaturation;
+	}
+
+	bool _flipped = false;
+	int _stretchToWidth = 0, _stretchToHeight = 0;
+	bool _useResampler = false;
+	int _red = 0, _green = 0, _blue = 0;
+	int _tintSaturation = 0;
+	int _lightLevel = 0;
+	int _transparency = 0;
+	// Whether the textures currently use linear filtering
+	bool _linearFiltered = false;
+	std::vector<OGLTextureTile> _tiles;
+
+	OGLBitmap(int width, int height, int colDepth, bool opaque) {
+		_width = width;
+		_height = height;
+		_colDepth = colDepth;
+		_opaque = opaque;
+	}
+
+	int GetWidthToRender() const {
+		return (_stretchToWidth > 0) ? _stretchToWidth : _width;
+	}
+	int GetHeightToRender() const {
+		return (_stretchToHeight > 0) ? _stretchToHeight : _height;
+	}
+
+	~OGLBitmap() override;
+};
+
+
+// 2D affine transformation, mapping (x, y) to (a * x + b * y + c, d * x + e * y + f)
+struct Transform2D {
+	float a = 1.f, b = 0.f, c = 0.f;
+	float d = 0.f, e = 1.f, f = 0.f;
+
+	static Transform2D Translate(float x, float y);
+	static Transform2D Scale(float sx, float sy);
+	static Transform2D Rotate(float angle);
+	// Returns the transformation applying m first, and then this one
+	Transform2D operator*(const Transform2D &m) const;
+	void Apply(float &x, float &y) const;
+};
+
+
+typedef SpriteDrawListEntry<OGLBitmap> OGLDrawListEntry;
+// OpenGL renderer's sprite batch
+struct OGLSpriteBatch {
+	// List of sprites to render
+	std::vector<OGLDrawListEntry> List;
+	// Clipping rectangle, in native coordinates
+	Rect Viewport;
+	// Transformation from the batch coordinates to the native ones
+	Transform2D Matrix;
+};
+typedef std::vector<OGLSpriteBatch> OGLSpriteBatches;
+
+
+class OGLGraphicsDriver : public VideoMemoryGraphicsDriver {
+public:
+	OGLGraphicsDriver();
+	~OGLGraphicsDriver() override;
+
+	const char *GetDriverName() override {
+		return "OpenGL";
+	}
+	const char *GetDriverID() override {
+		return "OGL";
+	}
+	void SetTintMethod(TintMethod method) override {
+		// The engine only ever selects TintReColourise, which is what the
+		// tint shader does
+	}
+	bool SetDisplayMode(const DisplayMode &mode) override;
+	void UpdateDeviceScreen(const Size &screen_sz) override;
+	bool SetNativeResolution(const GraphicResolution &native_res) override;
+	bool SetRenderFrame(const Rect &dst_rect) override;
+	bool IsModeSupported(const DisplayMode &mode) override;
+	int  GetDisplayDepthForNativeDepth(int native_color_depth) const override;
+	IGfxModeList *GetSupportedModeList(int color_depth) override;
+	PGfxFilter GetGraphicsFilter() const override;
+	void UnInit();
+	// Clears the screen rectangle. The coordinates are expected in the **native game resolution**.
+	void ClearRectangle(int x1, int y1, int x2, int y2, RGB *colorToUse) override {
+	}
+	int  GetCompatibleBitmapFormat(int color_depth) override;
+	void UpdateDDBFromBitmap(IDriverDependantBitmap *bitmapToUpdate, Bitmap *bitmap, bool hasAlpha) override;
+	void DestroyDDB(IDriverDependantBitmap *bitmap) override;
+
+	void DrawSprite(int x, int y, IDriverDependantBitmap *bitmap) override;
+	void SetScreenFade(int red, int green, int blue) override;
+	void SetScreenTint(int red, int green, int blue) override;
+
+	void RenderToBackBuffer() override;
+	void Render() override;
+	void Render(int xoff, int yoff, GlobalFlipType flip) override;
+	bool GetCopyOfScreenIntoBitmap(Bitmap *destination, bool at_native_res, GraphicResolution *want_fmt) override;
+	void FadeOut(int speed, int targetColourRed, int targetColourGreen, int targetColourBlue) override;
+	void FadeIn(int speed, PALETTE pal, int targetColourRed, int targetColourGreen, int targetColourBlue) override;
+	void BoxOutEffect(bool blackingOut, int speed, int delay) override;
+	bool SupportsGammaControl() override {
+		// Same as the software driver, so games behave alike with both
+		return false;
+	}
+	void SetGamma(int newGamma) override {
+	}
+	void UseSmoothScaling(bool enabled) override {
+		_smoothScaling = enabled;
+	}
+	void EnableVsyncBeforeRender(bool enabled) override {
+	}
+	void Vsync() override {
+	}
+	void RenderSpritesAtScreenResolution(bool enabled, int supersampling) override {
+	}
+	bool RequiresFullRedrawEachFrame() override {
+		return true;
+	}
+	bool HasAcceleratedTransform() override {
+		return true;
+	}
+
+	typedef std::shared_ptr<OGLGfxFilter> POGLFilter;
+
+	void SetGraphicsFilter(POGLFilter filter);
+
+protected:
+	IDriverDependantBitmap *CreateDDB(int width, int height, int color_depth, bool opaque) override;
+
+private:
+	POGLFilter _filter;
+	bool _smoothScaling = false;
+
+	OpenGL::ShaderGL *_spriteShader = nullptr;
+	OpenGL::ShaderGL *_tintShader = nullptr;
+	OpenGL::ShaderGL *_lightShader = nullptr;
+	GLuint _quadVBO = 0;
+	// Scratch buffer for the pixels uploaded to the textures
+	std::vector<uint8> _texPixels;
+
+	OGLSpriteBatches _spriteBatches;
+	// Sprite batches of the last rendered frame, for the screen effects
+	SpriteBatchDescs _backupBatchDescs;
+	OGLSpriteBatches _backupBatches;
+
+	void InitSpriteBatch(size_t index, const SpriteBatchDesc &desc) override;
+	void ResetAllBatches() override;
+
+	// Create the shaders and the vertex buffer
+	bool CreateShaders();
+	void DestroyShaders();
+	// Unset parameters and release resources related to the display mode
+	void ReleaseDisplayMode();
+	// Transformation from the native coordinates to the normalized device ones
+	Transform2D GetScreenMatrix() const;
+	// Draws all the sprite batches, and presents them if requested
+	void RenderImpl(bool present);
+	void RenderSpriteBatch(const OGLSpriteBatch &batch, const Transform2D &screen);
+	void RenderSprite(const OGLDrawListEntry &entry, const Transform2D &matrix);
+	// Uploads a tile of the bitmap to its texture
+	void UpdateTextureRegion(const OGLTextureTile &tile, const Bitmap *bitmap, bool opaque, bool hasAlpha);
+	// Keeps the draw lists to redraw the last frame, then clears them
+	void BackupDrawLists();
+	void RestoreDrawLists();
+	// Fades the last frame with a solid color
+	void DoFade(bool fadingOut, int speed, int targetColourRed, int targetColourGreen, int targetColourBlue);
+};
+
+
+class OGLGraphicsFactory : public GfxDriverFactoryBase<OGLGraphicsDriver, OGLGfxFilter> {
+public:
+	~OGLGraphicsFactory() override;
+
+	size_t               GetFilterCount() const override;
+	const GfxFilterInfo *GetFilterInfo(size_t index) const override;
+	String               GetDefaultFilterID() const override;
+
+	// Tells whether the renderer was requested and the backend supports it
+	static bool IsAvailable();
+	static OGLGraphicsFactory *GetFactory();
+
+private:
+	OGLGraphicsDriver *EnsureDriverCreated() override;
+	OGLGfxFilter *CreateFilter(const String &id) override;
+
+	static OGLGraphicsFactory *_factory;
+};
+
+} // namespace OGL
+} // namespace Engine
+} // namespace AGS
+} // namespace AGS3
+
+#endif
+
+#endif
@@ -22,6 +22,7 @@
 #include "common/textconsole.h"
 #include "ags/engine/gfx/gfxfilter_scummvm_renderer.h"
 #include "ags/engine/gfx/gfx_driver_factory.h"
+#include "ags/engine/gfx/ali_3d_ogl.h"
 #include "ags/engine/gfx/ali_3d_scummvm.h"
 
 namespace AGS3 {
@@ -29,10 +30,18 @@ namespace AGS {
 namespace Engine {
 
 void GetGfxDriverFactoryNames(StringV &ids) {
+#if defined(USE_OPENGL_SHADERS)
+	if (OGL::OGLGraphicsFactory::IsAvailable())
+		ids.push_back("OGL");
+#endif
 	ids.push_back("ScummVM");
 }
 
 IGfxDriverFactory *GetGfxDriverFactory(const String id) {
+#if defined(USE_OPENGL_SHADERS)
+	if (id.CompareNoCase("OGL") == 0)
+		return OGL::OGLGraphicsFactory::GetFactory();
+#endif
 	if (id.CompareNoCase("ScummVM") == 0)
 		return ALSW::ScummVMRendererGraphicsFactory::GetFactory();
 
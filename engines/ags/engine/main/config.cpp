@@ -406,6 +406,9 @@ void apply_config(const ConfigTree &cfg) {
 		_GP(usetup).translation = INIreadstring(cfg, "language", "translation");
 
 		int cache_size_kb = INIreadint(cfg, "misc", "cachemax", DEFAULTCACHESIZE_KB);
+		// A sprite cache size set in ScummVM takes precedence over the game setup
+		if (ConfMan.hasKey("sprite_cache_size"))
+			cache_size_kb = ConfMan.getInt("sprite_cache_size");
 		if (cache_size_kb > 0)
 			_GP(spriteset).SetMaxCacheSize((size_t)cache_size_kb * 1024);
 
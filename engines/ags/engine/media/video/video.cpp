@@ -51,6 +51,43 @@
 namespace AGS3 {
 
 using AGS::Shared::AssetManager;
+using AGS::Shared::Bitmap;
+using AGS::Engine::IDriverDependantBitmap;
+using AGS::Engine::SpriteTransform;
+
+// Draws a video frame as a sprite, for the graphics drivers which do not
+// let the screen be drawn upon directly
+static void render_video_frame(const Graphics::Surface &frame, const byte *palette, bool stretch,
+		std::unique_ptr<Bitmap> &bmp, IDriverDependantBitmap *&ddb) {
+	if (!bmp || bmp->GetWidth() != frame.w || bmp->GetHeight() != frame.h) {
+		if (ddb)
+			_G(gfxDriver)->DestroyDDB(ddb);
+		ddb = nullptr;
+		bmp.reset(new Bitmap(frame.w, frame.h, 32));
+	}
+
+	Graphics::Surface *converted = frame.convertTo(bmp->GetAllegroBitmap()->format, palette);
+	for (int y = 0; y < frame.h; ++y)
+		memcpy(bmp->GetScanLineForWriting(y), converted->getBasePtr(0, y), frame.w * 4);
+	converted->free();
+	delete converted;
+
+	if (ddb)
+		_G(gfxDriver)->UpdateDDBFromBitmap(ddb, bmp.get(), false);
+	else
+		ddb = _G(gfxDriver)->CreateDDBFromBitmap(bmp.get(), false, true);
+
+	const Size screen = _G(gfxDriver)->GetNativeSize();
+	_G(gfxDriver)->BeginSpriteBatch(RectWH(screen), SpriteTransform());
+	if (stretch) {
+		ddb->SetStretch(screen.Width, screen.Height, false);
+		_G(gfxDriver)->DrawSprite(0, 0, ddb);
+	} else {
+		ddb->SetStretch(0, 0);
+		_G(gfxDriver)->DrawSprite((screen.Width - frame.w) / 2, (screen.Height - frame.h) / 2, ddb);
+	}
+	_G(gfxDriver)->Render();
+}
 
 static bool play_video(Video::VideoDecoder *decoder, const char *name, int skip, int flags, bool showError) {
 	std::unique_ptr<Stream> video_stream(_GP(AssetMgr)->OpenAsset(name));
@@ -70,6 +107,10 @@ static bool play_video(Video::VideoDecoder *decoder, const char *name, int skip,
 	update_polled_stuff_if_runtime();
 
 	Graphics::Screen scr;
+	// Hardware accelerated drivers get the frames as sprites instead
+	const bool renderWithDriver = !_G(gfxDriver)->UsesMemoryBackBuffer();
+	std::unique_ptr<Bitmap> frameBmp;
+	IDriverDependantBitmap *frameDDB = nullptr;
 	bool stretchVideo = (flags % 10) != 0;
 	int canAbort = skip;
 	bool ignoreAudio = (flags >= 10);
@@ -86,7 +127,9 @@ static bool play_video(Video::VideoDecoder *decoder, const char *name, int skip,
 			// Get the next video frame and draw onto the screen
 			const Graphics::Surface *frame = decoder->decodeNextFrame();
 
-			if (frame) {
+			if (frame && renderWithDriver) {
+				render_video_frame(*frame, decoder->getPalette(), stretchVideo, frameBmp, frameDDB);
+			} else if (frame) {
 
 				if (stretchVideo && frame->w == scr.w && frame->h == scr.h)
 					// Don't need to stretch video after all
@@ -101,7 +144,8 @@ static bool play_video(Video::VideoDecoder *decoder, const char *name, int skip,
 				}
 			}
 
-			scr.update();
+			if (!renderWithDriver)
+				scr.update();
 		}
 
 		g_system->delayMillis(10);
@@ -113,17 +157,19 @@ static bool play_video(Video::VideoDecoder *decoder, const char *name, int skip,
 			int mbut, mwheelz;
 			if (run_service_key_controls(key)) {
 				if (key.Key == 27 && canAbort)
-					return true;
+					break;
 				if (canAbort >= 2)
-					return true;  // skip on any key
+					break;  // skip on any key
 			}
 
 			if (run_service_mb_controls(mbut, mwheelz) && mbut >= 0 && canAbort == 3) {
-				return true; // skip on mouse click
+				break; // skip on mouse click
 			}
 		}
 	}
 
+	if (frameDDB)
+		_G(gfxDriver)->DestroyDDB(frameDDB);
 	invalidate_screen();
 
 	return true;
@@ -223,6 +223,7 @@ ccInstance::ccInstance() {
 	numimports = 0;
 	resolved_imports = nullptr;
 	code_fixups         = nullptr;
+	code_ops            = nullptr;
 
 	memset(callStackLineNumber, 0, sizeof(callStackLineNumber));
 	memset(callStackAddr, 0, sizeof(callStackAddr));
@@ -433,71 +434,78 @@ int ccInstance::Run(int32_t curpc) {
 		*/
 		/* ReadOperation */
 		//=====================================================================
-		codeOp.Instruction.Code         = codeInst->code[pc];
-		codeOp.Instruction.InstanceId   = (codeOp.Instruction.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
-		codeOp.Instruction.Code        &= INSTANCE_ID_REMOVEMASK; // now this is pure instruction code
-
-		if (codeOp.Instruction.Code < 0 || codeOp.Instruction.Code >= CC_NUM_SCCMDS) {
-			cc_error("invalid instruction %d found in code stream", codeOp.Instruction.Code);
+		// The instruction was validated when the code was decoded
+		const ScriptCodeOp &decodedOp = codeInst->code_ops[pc];
+		if (!decodedOp.Valid) {
+			const int32_t instruction = decodedOp.Code;
+			if (instruction < 0 || instruction >= CC_NUM_SCCMDS) {
+				cc_error("invalid instruction %d found in code stream", instruction);
+			} else {
+				cc_error("unexpected end of code data (%d; %d)", pc + sccmd_info[instruction].ArgCount, codeInst->codesize);
+			}
 			return -1;
 		}
 
-		codeOp.ArgCount = sccmd_info[codeOp.Instruction.Code].ArgCount;
-		if (pc + codeOp.ArgCount >= codeInst->codesize) {
-			cc_error("unexpected end of code data (%d; %d)", pc + codeOp.ArgCount, codeInst->codesize);
-			return -1;
-		}
+		codeOp.Instruction.Code         = decodedOp.Code;
+		codeOp.Instruction.InstanceId   = decodedOp.InstanceId;
+		codeOp.ArgCount                 = decodedOp.ArgCount;
 
 		int pc_at = pc + 1;
-		for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
-			char fixup = codeInst->code_fixups[pc_at];
-			if (fixup > 0) {
-				// could be relative pointer or import address
-				/*
-				if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
-				{
-				    return -1;
-				}
-				*/
-				/* FixupArgument */
-				//=====================================================================
-				switch (fixup) {
-				case FIXUP_GLOBALDATA: {
-					ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
-					codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
-				}
-				break;
-				case FIXUP_FUNCTION:
-					// originally commented -- CHECKME: could this be used in very old versions of AGS?
-					//      code[fixup] += (long)&code[0];
-					// This is a program counter value, presumably will be used as SCMD_CALL argument
-					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+		if (!decodedOp.HasFixups) {
+			// only numeric literals, which is the case for most instructions
+			for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at)
+				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+		} else {
+			for (int i = 0; i < codeOp.ArgCount; ++i, ++pc_at) {
+				char fixup = codeInst->code_fixups[pc_at];
+				if (fixup > 0) {
+					// could be relative pointer or import address
+					/*
+					if (!FixupArgument(code[pc], fixup, codeOp.Args[i]))
+					{
+					    return -1;
+					}
+					*/
+					/* FixupArgument */
+					//=====================================================================
+					switch (fixup) {
+					case FIXUP_GLOBALDATA: {
+						ScriptVariable *gl_var = (ScriptVariable *)codeInst->code[pc_at];
+						codeOp.Args[i].SetGlobalVar(&gl_var->RValue);
+					}
 					break;
-				case FIXUP_STRING:
-					codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
+					case FIXUP_FUNCTION:
+						// originally commented -- CHECKME: could this be used in very old versions of AGS?
+						//      code[fixup] += (long)&code[0];
+						// This is a program counter value, presumably will be used as SCMD_CALL argument
+						codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
+						break;
+					case FIXUP_STRING:
+						codeOp.Args[i].SetStringLiteral(&codeInst->strings[0] + codeInst->code[pc_at]);
+						break;
+					case FIXUP_IMPORT: {
+						const ScriptImport *import = _GP(simp).getByIndex((int32_t)codeInst->code[pc_at]);
+						if (import) {
+							codeOp.Args[i] = import->Value;
+						} else {
+							cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+							return -1;
+						}
+					}
 					break;
-				case FIXUP_IMPORT: {
-					const ScriptImport *import = _GP(simp).getByIndex((int32_t)codeInst->code[pc_at]);
-					if (import) {
-						codeOp.Args[i] = import->Value;
-					} else {
-						cc_error("cannot resolve import, key = %ld", codeInst->code[pc_at]);
+					case FIXUP_STACK:
+						codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
+						break;
+					default:
+						cc_error("internal fixup type error: %d", fixup);
 						return -1;
 					}
+					/* End FixupArgument */
+					//=====================================================================
+				} else {
+					// should be a numeric literal (int32 or float)
+					codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 				}
-				break;
-				case FIXUP_STACK:
-					codeOp.Args[i] = GetStackPtrOffsetFw((int32_t)codeInst->code[pc_at]);
-					break;
-				default:
-					cc_error("internal fixup type error: %d", fixup);
-					return -1;
-				}
-				/* End FixupArgument */
-				//=====================================================================
-			} else {
-				// should be a numeric literal (int32 or float)
-				codeOp.Args[i].SetInt32((int32_t)codeInst->code[pc_at]);
 			}
 		}
 		/* End ReadOperation */
@@ -1390,6 +1398,7 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 	if (joined) {
 		resolved_imports = joined->resolved_imports;
 		code_fixups = joined->code_fixups;
+		code_ops = joined->code_ops;
 	} else {
 		if (!CreateGlobalVars(scri.get())) {
 			return false;
@@ -1397,6 +1406,8 @@ bool ccInstance::_Create(PScript scri, ccInstance *joined) {
 		if (!CreateRuntimeCodeFixups(scri.get())) {
 			return false;
 		}
+		code_ops = new ScriptCodeOp[codesize];
+		DecodeCodeOps();
 	}
 
 	exports = new RuntimeScriptValue[scri->numexports];
@@ -1472,9 +1483,11 @@ void ccInstance::Free() {
 	if ((flags & INSTF_SHAREDATA) == 0) {
 		delete[] resolved_imports;
 		delete[] code_fixups;
+		delete[] code_ops;
 	}
 	resolved_imports = nullptr;
 	code_fixups = nullptr;
+	code_ops = nullptr;
 }
 
 bool ccInstance::ResolveScriptImports(const ccScript *scri) {
@@ -1680,9 +1693,34 @@ bool ccInstance::ResolveImportFixups(const ccScript *scri) {
 		if (import->InstancePtr != nullptr && (code[fixup + 1] & INSTANCE_ID_REMOVEMASK) == SCMD_CALLEXT)
 			code[fixup + 1] = SCMD_CALLAS | (import->InstancePtr->loadedInstanceId << INSTANCE_ID_SHIFT);
 	}
+	DecodeCodeOps();
 	return true;
 }
 
+void ccInstance::DecodeCodeOps() {
+	// Every position is decoded on its own, as a jump could land anywhere
+	for (int32_t at_pc = 0; at_pc < codesize; ++at_pc) {
+		ScriptCodeOp &op = code_ops[at_pc];
+		op.Code       = code[at_pc];
+		op.InstanceId = (op.Code >> INSTANCE_ID_SHIFT) & INSTANCE_ID_MASK;
+		op.Code      &= INSTANCE_ID_REMOVEMASK;
+		op.Valid      = false;
+		op.HasFixups  = false;
+		if (op.Code < 0 || op.Code >= CC_NUM_SCCMDS)
+			continue;
+
+		op.ArgCount = sccmd_info[op.Code].ArgCount;
+		if (at_pc + op.ArgCount >= codesize)
+			continue;
+
+		op.Valid = true;
+		for (int i = 1; i <= op.ArgCount; ++i) {
+			if (code_fixups[at_pc + i] > 0)
+				op.HasFixups = true;
+		}
+	}
+}
+
 /*
 bool ccInstance::ReadOperation(ScriptOperation &op, int32_t at_pc)
 {
@@ -71,6 +71,24 @@ struct ScriptOperation {
 	int                 ArgCount;
 };
 
+// Instruction found at a position of the byte-code, decoded once in advance
+// so that the interpreter does not have to validate it every time it runs
+struct ScriptCodeOp {
+	ScriptCodeOp() {
+		Code = 0;
+		InstanceId = 0;
+		ArgCount = 0;
+		Valid = false;
+		HasFixups = false;
+	}
+
+	int32_t Code;       // pure instruction code
+	int32_t InstanceId;
+	int32_t ArgCount;
+	bool    Valid;      // the instruction is known and its arguments are within the code
+	bool    HasFixups;  // some of the arguments have to be resolved when they are read
+};
+
 struct ScriptVariable {
 	ScriptVariable() {
 		ScAddress = -1; // address = 0 is valid one, -1 means undefined
@@ -142,6 +160,8 @@ public:
 	int  numimports;
 
 	char *code_fixups;
+	// decoded instruction for every position of the code
+	ScriptCodeOp *code_ops;
 
 	// returns the currently executing instance, or NULL if none
 	static ccInstance *GetCurrentInstance(void);
@@ -191,6 +211,9 @@ protected:
 	bool    AddGlobalVar(const ScriptVariable &glvar);
 	ScriptVariable *FindGlobalVar(int32_t var_addr);
 	bool    CreateRuntimeCodeFixups(const ccScript *scri);
+	// Decode the instruction at every position of the code; has to be
+	// repeated whenever the code is modified
+	void    DecodeCodeOps();
 	//bool    ReadOperation(ScriptOperation &op, int32_t at_pc);
 
 	// Runtime fixups
@@ -0,0 +1,159 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/lib/allegro/blend_kernels.h"
+
+#include <arm_neon.h>
+
+namespace AGS3 {
+
+/** Turn blending alphas into the factors used by BITMAP::rgbBlend(). */
+static inline uint32x4_t alphaFactor(uint32x4_t alpha) {
+	// 0 stays 0, and everything else is incremented
+	return vaddq_u32(vaddq_u32(alpha, vdupq_n_u32(1)), vceqq_u32(alpha, vdupq_n_u32(0)));
+}
+
+/** Blend four pixels with red, green and blue in the low three bytes the way BITMAP::rgbBlend() does. */
+static inline uint32x4_t rgbBlend(uint32x4_t x, uint32x4_t y, uint32x4_t factor) {
+	const uint32x4_t rbMask = vdupq_n_u32(0xFF00FF);
+	const uint32x4_t gMask = vdupq_n_u32(0xFF00);
+
+	// The products wrap around like the scalar code
+	const uint32x4_t rb = vaddq_u32(vshrq_n_u32(vmulq_u32(vsubq_u32(vandq_u32(x, rbMask), vandq_u32(y, rbMask)), factor), 8), y);
+	const uint32x4_t yG = vandq_u32(y, gMask);
+	const uint32x4_t g = vaddq_u32(vshrq_n_u32(vmulq_u32(vsubq_u32(vandq_u32(x, gMask), yG), factor), 8), yG);
+	return vorrq_u32(vandq_u32(rb, rbMask), vandq_u32(g, gMask));
+}
+
+static inline uint32x4_t reverse32(uint32x4_t v) {
+	v = vrev64q_u32(v);
+	return vcombine_u32(vget_high_u32(v), vget_low_u32(v));
+}
+
+static inline uint16x8_t reverse16(uint16x8_t v) {
+	v = vrev64q_u16(v);
+	return vcombine_u16(vget_high_u16(v), vget_low_u16(v));
+}
+
+static int blendRow32(const BlendRow &row) {
+	const uint32x4_t rgbMask = vdupq_n_u32(0xFFFFFF);
+	const uint32x4_t alphaMask = vdupq_n_u32(row.alphaMask);
+	const uint32x4_t transColor = vdupq_n_u32(row.transColor);
+	const uint32x4_t constAlpha = vdupq_n_u32(row.alpha);
+
+	int done = 0;
+	for (; done + 4 <= row.count; done += 4) {
+		uint32x4_t s;
+		if (row.flip)
+			s = reverse32(vld1q_u32((const uint32 *)(row.src - 4 * (done + 3))));
+		else
+			s = vld1q_u32((const uint32 *)(row.src + 4 * done));
+		uint32 *dst = (uint32 *)(row.dst + 4 * done);
+		const uint32x4_t d = vld1q_u32(dst);
+
+		uint32x4_t alpha;
+		switch (row.mode) {
+		case kSourceAlphaBlender:
+			alpha = vshrq_n_u32(s, 24);
+			break;
+		case kArgbToRgbBlender:
+			alpha = vshrq_n_u32(s, 24);
+			if (row.alpha != 0)
+				alpha = vshrq_n_u32(vmulq_n_u32(alpha, row.alpha + 1), 8);
+			break;
+		default:
+			alpha = constAlpha;
+			break;
+		}
+
+		uint32x4_t pixels = rgbBlend(vandq_u32(s, rgbMask), vandq_u32(d, rgbMask), alphaFactor(alpha));
+		if (row.mode == kAlphaPreservedBlenderMode)
+			pixels = vorrq_u32(pixels, vbicq_u32(d, rgbMask));
+
+		if (row.skipTrans)
+			pixels = vbslq_u32(vceqq_u32(vandq_u32(s, alphaMask), transColor), d, pixels);
+		vst1q_u32(dst, pixels);
+	}
+	return done;
+}
+
+/** Expand four RGB565 pixels to red, green and blue bytes the way PixelFormat::colorToARGB() does. */
+static inline uint32x4_t expand565(uint16x4_t v16) {
+	const uint32x4_t v = vmovl_u16(v16);
+	const uint32x4_t r = vandq_u32(vshrq_n_u32(v, 11), vdupq_n_u32(0x1F));
+	const uint32x4_t g = vandq_u32(vshrq_n_u32(v, 5), vdupq_n_u32(0x3F));
+	const uint32x4_t b = vandq_u32(v, vdupq_n_u32(0x1F));
+	return vorrq_u32(vorrq_u32(
+		vshlq_n_u32(vorrq_u32(vshlq_n_u32(r, 3), vshrq_n_u32(r, 2)), 16),
+		vshlq_n_u32(vorrq_u32(vshlq_n_u32(g, 2), vshrq_n_u32(g, 4)), 8)),
+		vorrq_u32(vshlq_n_u32(b, 3), vshrq_n_u32(b, 2)));
+}
+
+/** Pack four pixels to RGB565 the way PixelFormat::ARGBToColor() does. */
+static inline uint16x4_t pack565(uint32x4_t v) {
+	const uint32x4_t r = vandq_u32(vshrq_n_u32(v, 8), vdupq_n_u32(0xF800));
+	const uint32x4_t g = vandq_u32(vshrq_n_u32(v, 5), vdupq_n_u32(0x07E0));
+	const uint32x4_t b = vandq_u32(vshrq_n_u32(v, 3), vdupq_n_u32(0x001F));
+	return vmovn_u32(vorrq_u32(vorrq_u32(r, g), b));
+}
+
+static int blendRow16(const BlendRow &row) {
+	// There is no alpha channel, so the source alpha is always 255
+	uint32 alpha = row.alpha;
+	if (row.mode == kSourceAlphaBlender || (row.mode == kArgbToRgbBlender && row.alpha == 0))
+		alpha = 0xFF;
+	else if (row.mode == kArgbToRgbBlender)
+		alpha = 0xFF * (row.alpha + 1) / 256;
+	const uint32x4_t factor = alphaFactor(vdupq_n_u32(alpha));
+
+	const uint16x8_t alphaMask = vdupq_n_u16((uint16)row.alphaMask);
+	const uint16x8_t transColor = vdupq_n_u16((uint16)row.transColor);
+
+	int done = 0;
+	for (; done + 8 <= row.count; done += 8) {
+		uint16x8_t s;
+		if (row.flip)
+			s = reverse16(vld1q_u16((const uint16 *)(row.src - 2 * (done + 7))));
+		else
+			s = vld1q_u16((const uint16 *)(row.src + 2 * done));
+		uint16 *dst = (uint16 *)(row.dst + 2 * done);
+		const uint16x8_t d = vld1q_u16(dst);
+
+		const uint32x4_t lo = rgbBlend(expand565(vget_low_u16(s)), expand565(vget_low_u16(d)), factor);
+		const uint32x4_t hi = rgbBlend(expand565(vget_high_u16(s)), expand565(vget_high_u16(d)), factor);
+		uint16x8_t pixels = vcombine_u16(pack565(lo), pack565(hi));
+
+		if (row.skipTrans)
+			pixels = vbslq_u16(vceqq_u16(vandq_u16(s, alphaMask), transColor), d, pixels);
+		vst1q_u16(dst, pixels);
+	}
+	return done;
+}
+
+const BlendKernels &getNEONBlendKernels() {
+	static const BlendKernels kernels = {
+		blendRow32,
+		blendRow16
+	};
+	return kernels;
+}
+
+} // namespace AGS3
@@ -0,0 +1,175 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ags/lib/allegro/blend_kernels.h"
+
+#include <emmintrin.h>
+
+namespace AGS3 {
+
+static inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/**
+ * Multiply 32 bit values by alphas of at most 256, wrapping around like the
+ * scalar code. The alphas are expected in both halves of their lanes.
+ */
+static inline __m128i mulAlpha(__m128i v, __m128i alpha) {
+	const __m128i lo = _mm_mullo_epi16(v, alpha);
+	const __m128i hi = _mm_mulhi_epu16(v, alpha);
+	return _mm_add_epi32(lo, _mm_slli_epi32(hi, 16));
+}
+
+/** Turn blending alphas into the factors used by BITMAP::rgbBlend(). */
+static inline __m128i alphaFactor(__m128i alpha) {
+	// 0 stays 0, and everything else is incremented
+	const __m128i isZero = _mm_cmpeq_epi32(alpha, _mm_setzero_si128());
+	const __m128i factor = _mm_add_epi32(_mm_add_epi32(alpha, _mm_set1_epi32(1)), isZero);
+	return _mm_or_si128(factor, _mm_slli_epi32(factor, 16));
+}
+
+/** Blend four pixels with red, green and blue in the low three bytes the way BITMAP::rgbBlend() does. */
+static inline __m128i rgbBlend(__m128i x, __m128i y, __m128i factor) {
+	const __m128i rbMask = _mm_set1_epi32(0xFF00FF);
+	const __m128i gMask = _mm_set1_epi32(0xFF00);
+
+	const __m128i rb = _mm_add_epi32(_mm_srli_epi32(mulAlpha(_mm_sub_epi32(_mm_and_si128(x, rbMask), _mm_and_si128(y, rbMask)), factor), 8), y);
+	const __m128i yG = _mm_and_si128(y, gMask);
+	const __m128i g = _mm_add_epi32(_mm_srli_epi32(mulAlpha(_mm_sub_epi32(_mm_and_si128(x, gMask), yG), factor), 8), yG);
+	return _mm_or_si128(_mm_and_si128(rb, rbMask), _mm_and_si128(g, gMask));
+}
+
+static inline __m128i reverse32(__m128i v) {
+	return _mm_shuffle_epi32(v, _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+static inline __m128i reverse16(__m128i v) {
+	v = _mm_shufflehi_epi16(_mm_shufflelo_epi16(v, _MM_SHUFFLE(0, 1, 2, 3)), _MM_SHUFFLE(0, 1, 2, 3));
+	return _mm_shuffle_epi32(v, _MM_SHUFFLE(1, 0, 3, 2));
+}
+
+static int blendRow32(const BlendRow &row) {
+	const __m128i rgbMask = _mm_set1_epi32(0xFFFFFF);
+	const __m128i alphaMask = _mm_set1_epi32(row.alphaMask);
+	const __m128i transColor = _mm_set1_epi32(row.transColor);
+	const __m128i constAlpha = _mm_set1_epi32(row.alpha);
+	const __m128i alphaPlusOne = _mm_set1_epi32(row.alpha + 1);
+
+	int done = 0;
+	for (; done + 4 <= row.count; done += 4) {
+		__m128i s;
+		if (row.flip)
+			s = reverse32(_mm_loadu_si128((const __m128i *)(row.src - 4 * (done + 3))));
+		else
+			s = _mm_loadu_si128((const __m128i *)(row.src + 4 * done));
+		__m128i *dst = (__m128i *)(row.dst + 4 * done);
+		const __m128i d = _mm_loadu_si128(dst);
+
+		__m128i alpha;
+		switch (row.mode) {
+		case kSourceAlphaBlender:
+			alpha = _mm_srli_epi32(s, 24);
+			break;
+		case kArgbToRgbBlender:
+			alpha = _mm_srli_epi32(s, 24);
+			if (row.alpha != 0)
+				alpha = _mm_srli_epi32(_mm_mullo_epi16(alpha, alphaPlusOne), 8);
+			break;
+		default:
+			alpha = constAlpha;
+			break;
+		}
+
+		__m128i pixels = rgbBlend(_mm_and_si128(s, rgbMask), _mm_and_si128(d, rgbMask), alphaFactor(alpha));
+		if (row.mode == kAlphaPreservedBlenderMode)
+			pixels = _mm_or_si128(pixels, _mm_andnot_si128(rgbMask, d));
+
+		if (row.skipTrans)
+			pixels = select(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), transColor), d, pixels);
+		_mm_storeu_si128(dst, pixels);
+	}
+	return done;
+}
+
+/** Expand four RGB565 pixels to red, green and blue bytes the way PixelFormat::colorToARGB() does. */
+static inline __m128i expand565(__m128i v) {
+	const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 11), _mm_set1_epi32(0x1F));
+	const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x3F));
+	const __m128i b = _mm_and_si128(v, _mm_set1_epi32(0x1F));
+	return _mm_or_si128(_mm_or_si128(
+		_mm_slli_epi32(_mm_or_si128(_mm_slli_epi32(r, 3), _mm_srli_epi32(r, 2)), 16),
+		_mm_slli_epi32(_mm_or_si128(_mm_slli_epi32(g, 2), _mm_srli_epi32(g, 4)), 8)),
+		_mm_or_si128(_mm_slli_epi32(b, 3), _mm_srli_epi32(b, 2)));
+}
+
+/** Pack four pixels to RGB565 the way PixelFormat::ARGBToColor() does, sign extended. */
+static inline __m128i pack565(__m128i v) {
+	const __m128i r = _mm_and_si128(_mm_srli_epi32(v, 8), _mm_set1_epi32(0xF800));
+	const __m128i g = _mm_and_si128(_mm_srli_epi32(v, 5), _mm_set1_epi32(0x07E0));
+	const __m128i b = _mm_and_si128(_mm_srli_epi32(v, 3), _mm_set1_epi32(0x001F));
+	// Sign extend the pixels, so that the saturating pack keeps them as they are
+	return _mm_srai_epi32(_mm_slli_epi32(_mm_or_si128(_mm_or_si128(r, g), b), 16), 16);
+}
+
+static int blendRow16(const BlendRow &row) {
+	// There is no alpha channel, so the source alpha is always 255
+	uint32 alpha = row.alpha;
+	if (row.mode == kSourceAlphaBlender || (row.mode == kArgbToRgbBlender && row.alpha == 0))
+		alpha = 0xFF;
+	else if (row.mode == kArgbToRgbBlender)
+		alpha = 0xFF * (row.alpha + 1) / 256;
+	const __m128i factor = alphaFactor(_mm_set1_epi32(alpha));
+
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi16((int16)row.alphaMask);
+	const __m128i transColor = _mm_set1_epi16((int16)row.transColor);
+
+	int done = 0;
+	for (; done + 8 <= row.count; done += 8) {
+		__m128i s;
+		if (row.flip)
+			s = reverse16(_mm_loadu_si128((const __m128i *)(row.src - 2 * (done + 7))));
+		else
+			s = _mm_loadu_si128((const __m128i *)(row.src + 2 * done));
+		__m128i *dst = (__m128i *)(row.dst + 2 * done);
+		const __m128i d = _mm_loadu_si128(dst);
+
+		const __m128i lo = rgbBlend(expand565(_mm_unpacklo_epi16(s, zero)), expand565(_mm_unpacklo_epi16(d, zero)), factor);
+		const __m128i hi = rgbBlend(expand565(_mm_unpackhi_epi16(s, zero)), expand565(_mm_unpackhi_epi16(d, zero)), factor);
+		__m128i pixels = _mm_packs_epi32(pack565(lo), pack565(hi));
+
+		if (row.skipTrans)
+			pixels = select(_mm_cmpeq_epi16(_mm_and_si128(s, alphaMask), transColor), d, pixels);
+		_mm_storeu_si128(dst, pixels);
+	}
+	return done;
+}
+
+const BlendKernels &getSSE2BlendKernels() {
+	static const BlendKernels kernels = {
+		blendRow32,
+		blendRow16
+	};
+	return kernels;
+}
+
+} // namespace AGS3
@@ -0,0 +1,80 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef AGS_LIB_ALLEGRO_BLEND_KERNELS_H
+#define AGS_LIB_ALLEGRO_BLEND_KERNELS_H
+
+#include "ags/lib/allegro/color.h"
+
+namespace AGS3 {
+
+/**
+ * A row of pixels blended by BITMAP::draw() onto a bitmap of the same format.
+ */
+struct BlendRow {
+	byte *dst;          ///< Destination of the first pixel
+	const byte *src;    ///< Source of the first pixel
+	int count;          ///< Number of pixels
+	bool flip;          ///< If set, the source pixels are read from src to the left
+	BlenderMode mode;   ///< One of the modes supported by the kernels
+	uint32 alpha;       ///< Blending alpha, between 0 and 255
+	bool skipTrans;     ///< If set, source pixels which are transparent are not drawn
+	uint32 transColor;  ///< Transparent color, as compared by BITMAP::draw()
+	uint32 alphaMask;   ///< Mask applied to a source pixel before comparing it
+};
+
+/**
+ * Vectorized row blending routines used by BITMAP::draw().
+ *
+ * They produce the same output as the scalar blender functions of BITMAP,
+ * for the blender modes accepted by supportsMode(). Each routine handles as
+ * many pixels from the start of the row as it can in whole blocks, and
+ * returns their number.
+ */
+struct BlendKernels {
+	/** Blends 32 bit pixels with alpha in the highest byte and blue in the lowest. */
+	int (*blendRow32)(const BlendRow &row);
+	/** Blends 16 bit RGB565 pixels. */
+	int (*blendRow16)(const BlendRow &row);
+
+	static bool supportsMode(int mode) {
+		return mode == kRgbToRgbBlender || mode == kAlphaPreservedBlenderMode ||
+		       mode == kSourceAlphaBlender || mode == kArgbToRgbBlender;
+	}
+};
+
+/**
+ * Return the vectorized blending routines supported by the host CPU, or
+ * nullptr if there are none.
+ */
+const BlendKernels *getBlendKernels();
+
+#ifdef SCUMMVM_SSE2
+const BlendKernels &getSSE2BlendKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const BlendKernels &getNEONBlendKernels();
+#endif
+
+} // namespace AGS3
+
+#endif
@@ -20,6 +20,7 @@
  */
 
 #include "ags/lib/allegro/gfx.h"
+#include "ags/lib/allegro/blend_kernels.h"
 #include "ags/lib/allegro/color.h"
 #include "ags/lib/allegro/flood.h"
 #include "ags/ags.h"
@@ -107,6 +108,52 @@ void BITMAP::floodfill(int x, int y, int color) {
 const int SCALE_THRESHOLD = 0x100;
 #define VGA_COLOR_TRANS(x) ((x) * 255 / 63)
 
+struct BITMAP::DrawInnerArgs {
+	const Graphics::ManagedSurface *src;
+	Graphics::Surface destArea;
+	Common::Rect srcArea;
+	int width, height;
+	int xStart, yStart;
+	int scaleX, scaleY;
+	bool horizFlip, vertFlip;
+	bool skipTrans;
+	int srcAlpha;
+	int tintRed, tintGreen, tintBlue;
+	bool useTint;
+	bool sameFormat;
+	uint32 transColor, alphaMask;
+	PALETTE palette;
+	// Set if the rows can be blended by the vectorized kernels
+	const BlendKernels *kernels;
+
+	DrawInnerArgs(const BITMAP *dstBitmap, const BITMAP *srcBitmap, const Common::Rect &destRect,
+	              const Common::Rect &dstRect, bool skipTrans_, int srcAlpha_) :
+		src(&**srcBitmap), destArea((**dstBitmap).getSubArea(destRect)), width(dstRect.width()), height(dstRect.height()),
+		scaleX(0), scaleY(0), horizFlip(false), vertFlip(false), skipTrans(skipTrans_), srcAlpha(srcAlpha_),
+		tintRed(-1), tintGreen(-1), tintBlue(-1), useTint(false), kernels(nullptr) {
+		sameFormat = (src->format == dstBitmap->format);
+
+		xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
+		yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
+
+		if (src->format.bytesPerPixel == 1 && dstBitmap->format.bytesPerPixel != 1) {
+			for (int i = 0; i < PAL_SIZE; ++i) {
+				palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
+				palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
+				palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
+			}
+		}
+
+		transColor = 0;
+		alphaMask = 0xff;
+		if (skipTrans && src->format.bytesPerPixel != 1) {
+			transColor = src->format.ARGBToColor(0, 255, 0, 255);
+			alphaMask = src->format.ARGBToColor(255, 0, 0, 0);
+			alphaMask = ~alphaMask;
+		}
+	}
+};
+
 void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
                   int dstX, int dstY, bool horizFlip, bool vertFlip,
                   bool skipTrans, int srcAlpha, int tintRed, int tintGreen,
@@ -135,112 +182,23 @@ void BITMAP::draw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 
 	// Get source and dest surface. Note that for the destination we create
 	// a temporary sub-surface based on the allowed clipping area
-	const Graphics::ManagedSurface &src = **srcBitmap;
-	Graphics::ManagedSurface &dest = *_owner;
-	Graphics::Surface destArea = dest.getSubArea(destRect);
-
-	// Define scaling and other stuff used by the drawing loops
-	const int xDir = horizFlip ? -1 : 1;
-	bool useTint = (tintRed >= 0 && tintGreen >= 0 && tintBlue >= 0);
-	bool sameFormat = (src.format == format);
-
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
-
-	PALETTE palette;
-	if (src.format.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
-		for (int i = 0; i < PAL_SIZE; ++i) {
-			palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
-			palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
-			palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
-		}
-	}
-
-	uint32 transColor = 0, alphaMask = 0xff;
-	if (skipTrans && src.format.bytesPerPixel != 1) {
-		transColor = src.format.ARGBToColor(0, 255, 0, 255);
-		alphaMask = src.format.ARGBToColor(255, 0, 0, 0);
-		alphaMask = ~alphaMask;
-	}
-
-	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
-	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
-
-	for (int destY = yStart, yCtr = 0; yCtr < dstRect.height(); ++destY, ++yCtr) {
-		if (destY < 0 || destY >= destArea.h)
-			continue;
-		byte *destP = (byte *)destArea.getBasePtr(0, destY);
-		const byte *srcP = (const byte *)src.getBasePtr(
-		                       horizFlip ? srcArea.right - 1 : srcArea.left,
-		                       vertFlip ? srcArea.bottom - 1 - yCtr :
-		                       srcArea.top + yCtr);
-
-		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, xCtrBpp = 0; xCtr < dstRect.width(); ++destX, ++xCtr, xCtrBpp += src.format.bytesPerPixel) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
-
-			const byte *srcVal = srcP + xDir * xCtrBpp;
-			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
-
-			// Check if this is a transparent color we should skip
-			if (skipTrans && ((srcCol & alphaMask) == transColor))
-				continue;
-
-			byte *destVal = (byte *)&destP[destX * format.bytesPerPixel];
-
-			// When blitting to the same format we can just copy the color
-			if (format.bytesPerPixel == 1) {
-				*destVal = srcCol;
-				continue;
-			} else if (sameFormat && srcAlpha == -1) {
-				if (format.bytesPerPixel == 4)
-					*(uint32 *)destVal = srcCol;
-				else
-					*(uint16 *)destVal = srcCol;
-				continue;
-			}
-
-			// We need the rgb values to do blending and/or convert between formats
-			if (src.format.bytesPerPixel == 1) {
-				const RGB &rgb = palette[srcCol];
-				aSrc = 0xff;
-				rSrc = rgb.r;
-				gSrc = rgb.g;
-				bSrc = rgb.b;
-			} else
-				src.format.colorToARGB(srcCol, aSrc, rSrc, gSrc, bSrc);
-
-			if (srcAlpha == -1) {
-				// This means we don't use blending.
-				aDest = aSrc;
-				rDest = rSrc;
-				gDest = gSrc;
-				bDest = bSrc;
-			} else {
-				if (useTint) {
-					rDest = rSrc;
-					gDest = gSrc;
-					bDest = bSrc;
-					aDest = aSrc;
-					rSrc = tintRed;
-					gSrc = tintGreen;
-					bSrc = tintBlue;
-					aSrc = srcAlpha;
-				} else {
-					// TODO: move this to blendPixel to only do it when needed?
-					format.colorToARGB(getColor(destVal, format.bytesPerPixel), aDest, rDest, gDest, bDest);
-				}
-				blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, srcAlpha);
-			}
-
-			uint32 pixel = format.ARGBToColor(aDest, rDest, gDest, bDest);
-			if (format.bytesPerPixel == 4)
-				*(uint32 *)destVal = pixel;
-			else
-				*(uint16 *)destVal = pixel;
-		}
-	}
+	DrawInnerArgs args(this, srcBitmap, destRect, dstRect, skipTrans, srcAlpha);
+	args.srcArea = srcArea;
+	args.horizFlip = horizFlip;
+	args.vertFlip = vertFlip;
+	args.tintRed = tintRed;
+	args.tintGreen = tintGreen;
+	args.tintBlue = tintBlue;
+	args.useTint = (tintRed >= 0 && tintGreen >= 0 && tintBlue >= 0);
+
+	// Alpha blending of whole rows of the same format can be vectorized
+	if (args.sameFormat && !args.useTint && srcAlpha >= 0 && srcAlpha <= 255 &&
+	        BlendKernels::supportsMode(_G(_blender_mode)) &&
+	        (format == Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24) ||
+	         format == Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0)))
+		args.kernels = getBlendKernels();
+
+	drawWithBlender<false>(args);
 }
 
 void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
@@ -262,66 +220,125 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 
 	// Get source and dest surface. Note that for the destination we create
 	// a temporary sub-surface based on the allowed clipping area
-	const Graphics::ManagedSurface &src = **srcBitmap;
-	Graphics::ManagedSurface &dest = *_owner;
-	Graphics::Surface destArea = dest.getSubArea(destRect);
+	DrawInnerArgs args(this, srcBitmap, destRect, dstRect, skipTrans, srcAlpha);
+	args.srcArea = srcRect;
 
 	// Define scaling and other stuff used by the drawing loops
-	const int scaleX = SCALE_THRESHOLD * srcRect.width() / dstRect.width();
-	const int scaleY = SCALE_THRESHOLD * srcRect.height() / dstRect.height();
-	bool sameFormat = (src.format == format);
+	args.scaleX = SCALE_THRESHOLD * srcRect.width() / dstRect.width();
+	args.scaleY = SCALE_THRESHOLD * srcRect.height() / dstRect.height();
 
-	byte rSrc, gSrc, bSrc, aSrc;
-	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
+	drawWithBlender<true>(args);
+}
 
-	PALETTE palette;
-	if (src.format.bytesPerPixel == 1 && format.bytesPerPixel != 1) {
-		for (int i = 0; i < PAL_SIZE; ++i) {
-			palette[i].r = VGA_COLOR_TRANS(_G(current_palette)[i].r);
-			palette[i].g = VGA_COLOR_TRANS(_G(current_palette)[i].g);
-			palette[i].b = VGA_COLOR_TRANS(_G(current_palette)[i].b);
-		}
+template<bool Scale>
+void BITMAP::drawWithBlender(const DrawInnerArgs &args) {
+	switch (_G(_blender_mode)) {
+	case kSourceAlphaBlender:
+		drawInner<kSourceAlphaBlender, Scale>(args);
+		break;
+	case kArgbToArgbBlender:
+		drawInner<kArgbToArgbBlender, Scale>(args);
+		break;
+	case kArgbToRgbBlender:
+		drawInner<kArgbToRgbBlender, Scale>(args);
+		break;
+	case kRgbToArgbBlender:
+		drawInner<kRgbToArgbBlender, Scale>(args);
+		break;
+	case kRgbToRgbBlender:
+		drawInner<kRgbToRgbBlender, Scale>(args);
+		break;
+	case kAlphaPreservedBlenderMode:
+		drawInner<kAlphaPreservedBlenderMode, Scale>(args);
+		break;
+	case kOpaqueBlenderMode:
+		drawInner<kOpaqueBlenderMode, Scale>(args);
+		break;
+	case kAdditiveBlenderMode:
+		drawInner<kAdditiveBlenderMode, Scale>(args);
+		break;
+	case kTintBlenderMode:
+		drawInner<kTintBlenderMode, Scale>(args);
+		break;
+	case kTintLightBlenderMode:
+		drawInner<kTintLightBlenderMode, Scale>(args);
+		break;
+	default:
+		// Unknown modes draw like the opaque ones, but without blending
+		drawInner<-1, Scale>(args);
+		break;
 	}
+}
 
-	uint32 transColor = 0, alphaMask = 0xff;
-	if (skipTrans && src.format.bytesPerPixel != 1) {
-		transColor = src.format.ARGBToColor(0, 255, 0, 255);
-		alphaMask = src.format.ARGBToColor(255, 0, 0, 0);
-		alphaMask = ~alphaMask;
-	}
+template<int Mode, bool Scale>
+void BITMAP::drawInner(const DrawInnerArgs &args) {
+	const Graphics::ManagedSurface &src = *args.src;
+	Graphics::Surface destArea = args.destArea;
+	const Common::Rect &srcArea = args.srcArea;
+	const int srcBpp = src.format.bytesPerPixel;
+	const int destBpp = format.bytesPerPixel;
+	const int xDir = args.horizFlip ? -1 : 1;
+
+	// Only visit the pixels within the clipping area
+	const int xCtrStart = MAX(0, -args.xStart);
+	const int xCtrEnd = MIN(args.width, destArea.w - args.xStart);
+	const int yCtrStart = MAX(0, -args.yStart);
+	const int yCtrEnd = MIN(args.height, destArea.h - args.yStart);
 
-	int xStart = (dstRect.left < destRect.left) ? dstRect.left - destRect.left : 0;
-	int yStart = (dstRect.top < destRect.top) ? dstRect.top - destRect.top : 0;
+	byte rSrc, gSrc, bSrc, aSrc;
+	byte rDest = 0, gDest = 0, bDest = 0, aDest = 0;
 
-	for (int destY = yStart, yCtr = 0, scaleYCtr = 0; yCtr < dstRect.height();
-	        ++destY, ++yCtr, scaleYCtr += scaleY) {
-		if (destY < 0 || destY >= destArea.h)
+	for (int yCtr = yCtrStart; yCtr < yCtrEnd; ++yCtr) {
+		byte *destP = (byte *)destArea.getBasePtr(0, args.yStart + yCtr);
+		const byte *srcP;
+		if (Scale)
+			srcP = (const byte *)src.getBasePtr(srcArea.left, srcArea.top + yCtr * args.scaleY / SCALE_THRESHOLD);
+		else
+			srcP = (const byte *)src.getBasePtr(
+			           args.horizFlip ? srcArea.right - 1 : srcArea.left,
+			           args.vertFlip ? srcArea.bottom - 1 - yCtr : srcArea.top + yCtr);
+
+		int xCtr = xCtrStart;
+		if (!Scale && args.kernels) {
+			BlendRow row;
+			row.dst = destP + (args.xStart + xCtr) * destBpp;
+			row.src = srcP + xDir * xCtr * srcBpp;
+			row.count = xCtrEnd - xCtr;
+			row.flip = args.horizFlip;
+			row.mode = (BlenderMode)Mode;
+			row.alpha = args.srcAlpha;
+			row.skipTrans = args.skipTrans;
+			row.transColor = args.transColor;
+			row.alphaMask = args.alphaMask;
+			xCtr += (destBpp == 4) ? args.kernels->blendRow32(row) : args.kernels->blendRow16(row);
+		} else if (!Scale && !args.horizFlip && !args.skipTrans && args.sameFormat && args.srcAlpha == -1) {
+			// Plain copy of the whole row
+			memcpy(destP + (args.xStart + xCtr) * destBpp, srcP + xCtr * srcBpp, (xCtrEnd - xCtr) * destBpp);
 			continue;
-		byte *destP = (byte *)destArea.getBasePtr(0, destY);
-		const byte *srcP = (const byte *)src.getBasePtr(
-		                       srcRect.left, srcRect.top + scaleYCtr / SCALE_THRESHOLD);
+		}
 
 		// Loop through the pixels of the row
-		for (int destX = xStart, xCtr = 0, scaleXCtr = 0; xCtr < dstRect.width();
-		        ++destX, ++xCtr, scaleXCtr += scaleX) {
-			if (destX < 0 || destX >= destArea.w)
-				continue;
-
-			const byte *srcVal = srcP + scaleXCtr / SCALE_THRESHOLD * src.format.bytesPerPixel;
-			uint32 srcCol = getColor(srcVal, src.format.bytesPerPixel);
+		for (; xCtr < xCtrEnd; ++xCtr) {
+			const int destX = args.xStart + xCtr;
+			const byte *srcVal;
+			if (Scale)
+				srcVal = srcP + xCtr * args.scaleX / SCALE_THRESHOLD * srcBpp;
+			else
+				srcVal = srcP + xDir * xCtr * srcBpp;
+			uint32 srcCol = getColor(srcVal, srcBpp);
 
 			// Check if this is a transparent color we should skip
-			if (skipTrans && ((srcCol & alphaMask) == transColor))
+			if (args.skipTrans && ((srcCol & args.alphaMask) == args.transColor))
 				continue;
 
-			byte *destVal = (byte *)&destP[destX * format.bytesPerPixel];
+			byte *destVal = (byte *)&destP[destX * destBpp];
 
 			// When blitting to the same format we can just copy the color
-			if (format.bytesPerPixel == 1) {
+			if (destBpp == 1) {
 				*destVal = srcCol;
 				continue;
-			} else if (sameFormat && srcAlpha == -1) {
-				if (format.bytesPerPixel == 4)
+			} else if (args.sameFormat && args.srcAlpha == -1) {
+				if (destBpp == 4)
 					*(uint32 *)destVal = srcCol;
 				else
 					*(uint16 *)destVal = srcCol;
@@ -329,8 +346,8 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 			}
 
 			// We need the rgb values to do blending and/or convert between formats
-			if (src.format.bytesPerPixel == 1) {
-				const RGB &rgb = palette[srcCol];
+			if (srcBpp == 1) {
+				const RGB &rgb = args.palette[srcCol];
 				aSrc = 0xff;
 				rSrc = rgb.r;
 				gSrc = rgb.g;
@@ -338,20 +355,31 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 			} else
 				src.format.colorToARGB(srcCol, aSrc, rSrc, gSrc, bSrc);
 
-			if (srcAlpha == -1) {
+			if (args.srcAlpha == -1) {
 				// This means we don't use blending.
 				aDest = aSrc;
 				rDest = rSrc;
 				gDest = gSrc;
 				bDest = bSrc;
 			} else {
-				// TODO: move this to blendPixel to only do it when needed?
-				format.colorToARGB(getColor(destVal, format.bytesPerPixel), aDest, rDest, gDest, bDest);
-				blendPixel(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, srcAlpha);
+				if (args.useTint) {
+					rDest = rSrc;
+					gDest = gSrc;
+					bDest = bSrc;
+					aDest = aSrc;
+					rSrc = args.tintRed;
+					gSrc = args.tintGreen;
+					bSrc = args.tintBlue;
+					aSrc = args.srcAlpha;
+				} else {
+					// TODO: move this to blendPixel to only do it when needed?
+					format.colorToARGB(getColor(destVal, destBpp), aDest, rDest, gDest, bDest);
+				}
+				blendPixel<Mode>(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, args.srcAlpha);
 			}
 
 			uint32 pixel = format.ARGBToColor(aDest, rDest, gDest, bDest);
-			if (format.bytesPerPixel == 4)
+			if (destBpp == 4)
 				*(uint32 *)destVal = pixel;
 			else
 				*(uint16 *)destVal = pixel;
@@ -359,41 +387,6 @@ void BITMAP::stretchDraw(const BITMAP *srcBitmap, const Common::Rect &srcRect,
 	}
 }
 
-void BITMAP::blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
-	switch (_G(_blender_mode)) {
-	case kSourceAlphaBlender:
-		blendSourceAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kArgbToArgbBlender:
-		blendArgbToArgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kArgbToRgbBlender:
-		blendArgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kRgbToArgbBlender:
-		blendRgbToArgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kRgbToRgbBlender:
-		blendRgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kAlphaPreservedBlenderMode:
-		blendPreserveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kOpaqueBlenderMode:
-		blendOpaque(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kAdditiveBlenderMode:
-		blendAdditiveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
-		break;
-	case kTintBlenderMode:
-		blendTintSprite(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha, false);
-		break;
-	case kTintLightBlenderMode:
-		blendTintSprite(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha, true);
-		break;
-	}
-}
-
 void BITMAP::blendTintSprite(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha, bool light) const {
 	// Used from draw_lit_sprite after set_blender_mode(kTintBlenderMode or kTintLightBlenderMode)
 	// Original blender function: _myblender_color32 and _myblender_color32_light
@@ -24,6 +24,7 @@
 
 #include "graphics/managed_surface.h"
 #include "ags/lib/allegro/base.h"
+#include "ags/lib/allegro/color.h"
 #include "common/array.h"
 
 namespace AGS3 {
@@ -124,12 +125,55 @@ public:
 	}
 
 	private:
+	struct DrawInnerArgs;
+
+	// The drawing loops are instantiated for each blender mode, so that the
+	// mode does not have to be looked up for every pixel
+	template<bool Scale>
+	void drawWithBlender(const DrawInnerArgs &args);
+	template<int Mode, bool Scale>
+	void drawInner(const DrawInnerArgs &args);
+
 	// True color blender functions
 	// In Allegro all the blender functions are of the form
 	// unsigned int blender_func(unsigned long x, unsigned long y, unsigned long n)
 	// when x is the sprite color, y the destination color, and n an alpha value
 
-	void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const;
+	template<int Mode>
+	inline void blendPixel(uint8 aSrc, uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &aDest, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
+		switch (Mode) {
+		case kSourceAlphaBlender:
+			blendSourceAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kArgbToArgbBlender:
+			blendArgbToArgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kArgbToRgbBlender:
+			blendArgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kRgbToArgbBlender:
+			blendRgbToArgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kRgbToRgbBlender:
+			blendRgbToRgb(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kAlphaPreservedBlenderMode:
+			blendPreserveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kOpaqueBlenderMode:
+			blendOpaque(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kAdditiveBlenderMode:
+			blendAdditiveAlpha(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha);
+			break;
+		case kTintBlenderMode:
+			blendTintSprite(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha, false);
+			break;
+		case kTintLightBlenderMode:
+			blendTintSprite(aSrc, rSrc, gSrc, bSrc, aDest, rDest, gDest, bDest, alpha, true);
+			break;
+		}
+	}
 
 
 	inline void rgbBlend(uint8 rSrc, uint8 gSrc, uint8 bSrc, uint8 &rDest, uint8 &gDest, uint8 &bDest, uint32 alpha) const {
@@ -13,6 +13,7 @@ MODULE_OBJS = \
 	lib/aastr-0.1.1/aastr.o \
 	lib/aastr-0.1.1/aautil.o \
 	lib/alfont/alfont.o \
+	lib/allegro/blend_kernels.o \
 	lib/allegro/color.o \
 	lib/allegro/config.o \
 	lib/allegro/draw.o \
@@ -238,12 +239,14 @@ MODULE_OBJS = \
 	engine/game/savegame_components.o \
 	engine/game/savegame_v321.o \
 	engine/game/viewport.o \
+	engine/gfx/ali_3d_ogl.o \
 	engine/gfx/ali_3d_scummvm.o \
 	engine/gfx/blender.o \
 	engine/gfx/color_engine.o \
 	engine/gfx/gfx_driver_base.o \
 	engine/gfx/gfx_driver_factory.o \
 	engine/gfx/gfx_util.o \
+	engine/gfx/gfxfilter_ogl.o \
 	engine/gfx/gfxfilter_scaling.o \
 	engine/gfx/gfxfilter_scummvm_renderer.o \
 	engine/gui/animating_gui_button.o \
@@ -361,6 +364,18 @@ MODULE_OBJS = \
 	plugins/ags_waves/warper.o \
 	plugins/ags_waves/weather.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	lib/allegro/blend_kernels-sse2.o
+
+$(MODULE)/lib/allegro/blend_kernels-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	lib/allegro/blend_kernels-neon.o
+endif
+
 ifdef ENABLE_AGS_TESTS
 MODULE_OBJS += \
 	tests/test_all.o \
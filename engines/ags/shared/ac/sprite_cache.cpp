@@ -70,9 +70,11 @@ SpriteCache::SpriteData::~SpriteData() {
 SpriteCache::SpriteCache(std::vector<SpriteInfo> &sprInfos)
 	: _sprInfos(sprInfos) {
 	Init();
+	MemTracker.registerConsumer(this);
 }
 
 SpriteCache::~SpriteCache() {
+	MemTracker.unregisterConsumer(this);
 	Reset();
 }
 
@@ -96,12 +98,21 @@ void SpriteCache::SetMaxCacheSize(size_t size) {
 	_maxCacheSize = size;
 }
 
+size_t SpriteCache::shrinkMemoryUsage(size_t bytes) {
+	// Keep the most recently used sprite, as its user may still hold it
+	const size_t oldSize = _cacheSize;
+	while (_cacheSize + bytes > oldSize && _liststart >= 0 && _liststart != _listend)
+		DisposeOldest();
+	return oldSize - _cacheSize;
+}
+
 void SpriteCache::Init() {
 	_cacheSize = 0;
 	_lockedSize = 0;
 	_maxCacheSize = (size_t)DEFAULTCACHESIZE_KB * 1024;
 	_liststart = -1;
 	_listend = -1;
+	_stats = Statistics();
 }
 
 void SpriteCache::Reset() {
@@ -228,13 +239,22 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 		return _spriteData[index].Image;
 
 	// Sprite exists in file but is not in mem, load it
-	if ((_spriteData[index].Image == nullptr) && _spriteData[index].IsAssetSprite())
+	if ((_spriteData[index].Image == nullptr) && _spriteData[index].IsAssetSprite()) {
+		_stats.Misses++;
 		LoadSprite(index);
+	} else if (_spriteData[index].IsAssetSprite()) {
+		_stats.Hits++;
+	}
 
 	// Locked sprite that shouldn't be put into MRU list
 	if (_spriteData[index].IsLocked())
 		return _spriteData[index].Image;
 
+	MarkRecentlyUsed(index);
+	return _spriteData[index].Image;
+}
+
+void SpriteCache::MarkRecentlyUsed(sprkey_t index) {
 	if (_liststart < 0) {
 		_liststart = index;
 		_listend = index;
@@ -258,8 +278,6 @@ Bitmap *SpriteCache::operator [] (sprkey_t index) {
 		_mrubacklink[index] = _listend;
 		_listend = index;
 	}
-
-	return _spriteData[index].Image;
 }
 
 void SpriteCache::DisposeOldest() {
@@ -279,6 +297,7 @@ void SpriteCache::DisposeOldest() {
 
 		delete _spriteData[sprnum].Image;
 		_spriteData[sprnum].Image = nullptr;
+		_stats.Evictions++;
 	}
 
 	if (_liststart == _listend) {
@@ -349,6 +368,46 @@ void SpriteCache::Precache(sprkey_t index) {
 #endif
 }
 
+size_t SpriteCache::PrefetchSprites(std::vector<sprkey_t> indexes) {
+	// Sprites are stored in the order of their indexes,
+	// so this reads the sprite file front to back
+	std::sort(indexes.begin(), indexes.end());
+
+	size_t loaded = 0;
+	sprkey_t last = -1;
+	for (sprkey_t index : indexes) {
+		if (index == last || index < MIN_SPRITE_INDEX || (size_t)index >= _spriteData.size())
+			continue;
+		last = index;
+		if ((_spriteData[index].Image != nullptr) || !_spriteData[index].IsAssetSprite() ||
+			(_spriteData[index].Flags & SPRCACHEFLAG_REMAPPED) != 0)
+			continue;
+		// Don't dispose sprites in use to make room for ones that may never be drawn
+		if (_cacheSize >= _maxCacheSize)
+			break;
+
+		LoadSprite(index);
+		if (_spriteData[index].Image == nullptr)
+			continue;
+		MarkRecentlyUsed(index);
+		loaded++;
+	}
+
+	_stats.Prefetched += loaded;
+#ifdef DEBUG_SPRITECACHE
+	Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Debug, "Prefetched %zu sprites, size now %zu KB", loaded, _cacheSize / 1024);
+#endif
+	return loaded;
+}
+
+const SpriteCache::Statistics &SpriteCache::GetStatistics() const {
+	return _stats;
+}
+
+void SpriteCache::ResetStatistics() {
+	_stats = Statistics();
+}
+
 sprkey_t SpriteCache::GetDataIndex(sprkey_t index) {
 	return (_spriteData[index].Flags & SPRCACHEFLAG_REMAPPED) == 0 ? index : 0;
 }
@@ -408,6 +467,9 @@ size_t SpriteCache::LoadSprite(sprkey_t index) {
 	Debug::Printf(kDbgGroup_SprCache, kDbgMsg_Debug, "Loaded %d, size now %zu KB", index, _cacheSize / 1024);
 #endif
 
+	// The new sprite is not on the MRU list yet, so it is kept
+	MemTracker.checkBudget();
+
 	return size;
 }
 
@@ -41,6 +41,7 @@
 #ifndef AGS_SHARED_AC_SPRITE_CACHE_H
 #define AGS_SHARED_AC_SPRITE_CACHE_H
 
+#include "common/memtracker.h"
 #include "ags/lib/std/memory.h"
 #include "ags/lib/std/vector.h"
 #include "ags/shared/ac/sprite_file.h"
@@ -82,12 +83,20 @@ struct SpriteInfo;
 namespace AGS {
 namespace Shared {
 
-class SpriteCache {
+class SpriteCache : public Common::MemoryConsumer {
 public:
 	static const sprkey_t MIN_SPRITE_INDEX = 1; // 0 is reserved for "empty sprite"
 	static const sprkey_t MAX_SPRITE_INDEX = INT32_MAX - 1;
 	static const size_t   MAX_SPRITE_SLOTS = INT32_MAX;
 
+	// Cache usage counters, since the cache or the counters were last reset
+	struct Statistics {
+		uint32_t Hits = 0;       // asset sprite was already in memory
+		uint32_t Misses = 0;     // asset sprite had to be loaded from the file
+		uint32_t Evictions = 0;  // sprite was disposed to stay within the size limit
+		uint32_t Prefetched = 0; // sprite was loaded by PrefetchSprites
+	};
+
 	SpriteCache(std::vector<SpriteInfo> &sprInfos);
 	~SpriteCache();
 
@@ -123,6 +132,14 @@ public:
 	size_t      GetSpriteSlotCount() const;
 	// Loads sprite and and locks in memory (so it cannot get removed implicitly)
 	void        Precache(sprkey_t index);
+	// Loads the given sprites ahead of their first use, in the order they are
+	// stored in the file, as long as the cache is below its size limit;
+	// returns the number of sprites loaded
+	size_t      PrefetchSprites(std::vector<sprkey_t> indexes);
+	// Returns the cache usage counters
+	const Statistics &GetStatistics() const;
+	// Resets the cache usage counters
+	void        ResetStatistics();
 	// Remap the given index to the sprite 0
 	void        RemapSpriteToSprite0(sprkey_t index);
 	// Unregisters sprite from the bank and optionally deletes bitmap
@@ -142,6 +159,11 @@ public:
 	// Sets max cache size in bytes
 	void        SetMaxCacheSize(size_t size);
 
+	// Common::MemoryConsumer API
+	const char *getMemoryConsumerName() const override { return "AGS sprites"; }
+	size_t      getMemoryUsage() const override { return _cacheSize; }
+	size_t      shrinkMemoryUsage(size_t bytes) override;
+
 	// Loads (if it's not in cache yet) and returns bitmap by the sprite index
 	Shared::Bitmap *operator[] (sprkey_t index);
 
@@ -154,6 +176,8 @@ private:
 	sprkey_t    GetDataIndex(sprkey_t index);
 	// Delete the oldest image in cache
 	void        DisposeOldest();
+	// Puts the sprite at the end of the MRU list
+	void        MarkRecentlyUsed(sprkey_t index);
 
 	// Information required for the sprite streaming
 	struct SpriteData {
@@ -195,6 +219,8 @@ private:
 	int _liststart;
 	int _listend;
 
+	Statistics _stats;
+
 	// Initialize the empty sprite slot
 	void        InitNullSpriteParams(sprkey_t index);
 };
@@ -20,9 +20,13 @@
  */
 
 #include "common/scummsys.h"
+#include "common/random.h"
 #include "ags/shared/core/platform.h"
+#include "ags/shared/core/types.h"
 #include "ags/shared/gfx/gfx_def.h"
 #include "ags/shared/debugging/assert.h"
+#include "ags/lib/allegro/color.h"
+#include "ags/lib/allegro/surface.h"
 
 namespace AGS3 {
 
@@ -41,6 +45,52 @@ void Test_Gfx() {
 		trans100_back[i] = GfxDef::LegacyTrans255ToTrans100(trans255[i]);
 		assert(trans100[i] == trans100_back[i]);
 	}
+
+	// Test that blending whole rows, which may be vectorized, gives the same
+	// result as blending one pixel at a time
+	const int depths[] = { 16, 32 };
+	const BlenderMode modes[] = { kRgbToRgbBlender, kAlphaPreservedBlenderMode, kSourceAlphaBlender, kArgbToRgbBlender, kArgbToArgbBlender };
+	const int alphas[] = { 0, 1, 128, 255 };
+	const int w = 37, h = 3;
+	Common::RandomSource rnd("ags_test_gfx");
+	rnd.setSeed(1);
+	for (int depth : depths) {
+		BITMAP *src = create_bitmap_ex(depth, w, h);
+		BITMAP *dstRow = create_bitmap_ex(depth, w, h);
+		BITMAP *dstPixel = create_bitmap_ex(depth, w, h);
+		for (BlenderMode mode : modes) {
+			for (int alpha : alphas) {
+				for (int flip = 0; flip < 2; ++flip) {
+					for (int y = 0; y < h; ++y) {
+						for (int x = 0; x < w; ++x) {
+							uint32 color = rnd.getRandomNumber(UINT_MAX);
+							// Some transparent pixels, for the skipTrans test
+							if (rnd.getRandomNumber(7) == 0)
+								color = src->getTransparentColor();
+							src->getSurface().setPixel(x, y, color);
+							const uint32 dstColor = rnd.getRandomNumber(UINT_MAX);
+							dstRow->getSurface().setPixel(x, y, dstColor);
+							dstPixel->getSurface().setPixel(x, y, dstColor);
+						}
+					}
+
+					set_blender_mode(mode, 0, 0, 0, 0);
+					dstRow->draw(src, Common::Rect(0, 0, w, h), 0, 0, flip != 0, false, true, alpha);
+					for (int x = 0; x < w; ++x)
+						dstPixel->draw(src, Common::Rect(x, 0, x + 1, h), flip ? w - 1 - x : x, 0, false, false, true, alpha);
+
+					for (int y = 0; y < h; ++y) {
+						for (int x = 0; x < w; ++x)
+							assert(dstRow->getpixel(x, y) == dstPixel->getpixel(x, y));
+					}
+				}
+			}
+		}
+		destroy_bitmap(src);
+		destroy_bitmap(dstRow);
+		destroy_bitmap(dstPixel);
+	}
+	set_blender_mode(kRgbToRgbBlender, 0, 0, 0, 0);
 }
 
 } // namespace AGS3
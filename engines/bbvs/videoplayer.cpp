@@ -57,18 +57,8 @@ void BbvsEngine::playVideo(int videoNum) {
 
 	while (!shouldQuit() && !videoDecoder->endOfVideo() && !skipVideo) {
 		if (videoDecoder->needsUpdate()) {
-			const Graphics::Surface *frame = videoDecoder->decodeNextFrame();
-			if (frame) {
-				if (frame->format.bytesPerPixel > 1) {
-					Graphics::Surface *frame1 = frame->convertTo(_system->getScreenFormat());
-					_system->copyRectToScreen(frame1->getPixels(), frame1->pitch, 0, 0, frame1->w, frame1->h);
-					frame1->free();
-					delete frame1;
-				} else {
-					_system->copyRectToScreen(frame->getPixels(), frame->pitch, 0, 0, frame->w, frame->h);
-				}
+			if (videoDecoder->decodeNextFrameToScreen(0, 0))
 				_system->updateScreen();
-			}
 		}
 
 		Common::Event event;
@@ -33,7 +33,6 @@
 #include "bladerunner/crimes_database.h"
 #include "bladerunner/debugger.h"
 #include "bladerunner/dialogue_menu.h"
-#include "bladerunner/framelimiter.h"
 #include "bladerunner/font.h"
 #include "bladerunner/game_flags.h"
 #include "bladerunner/game_info.h"
@@ -93,6 +92,7 @@
 #include "engines/util.h"
 #include "engines/advancedDetector.h"
 
+#include "graphics/framelimiter.h"
 #include "graphics/thumbnail.h"
 #include "audio/mididrv.h"
 
@@ -555,7 +555,8 @@ bool BladeRunnerEngine::startup(bool hasSavegames) {
 	_time = new Time(this);
 
 //	debug("_framesPerSecondMax:: %s", _framesPerSecondMax? "true" : "false");
-	_framelimiter = new Framelimiter(this, _framesPerSecondMax? 120 : 60);
+	_framelimiter = new Graphics::FrameLimiter(_system, _framesPerSecondMax? 120 : 60);
+	_framelimiter->setBusyWait(_noDelayMillisFramelimiter);
 
 	// Try to load the SUBTITLES.MIX first, before Startup.MIX
 	// allows overriding any identically named resources (such as the original font files and as a bonus also the TRE files for the UI and dialogue menu)
@@ -2703,9 +2704,10 @@ void BladeRunnerEngine::ISez(const Common::String &str) {
 }
 
 void BladeRunnerEngine::blitToScreen(const Graphics::Surface &src) const {
-	_framelimiter->wait();
+	_framelimiter->delayBeforeSwap();
 	_system->copyRectToScreen(src.getPixels(), src.pitch, 0, 0, src.w, src.h);
 	_system->updateScreen();
+	_framelimiter->startFrame();
 }
 
 Graphics::Surface BladeRunnerEngine::generateThumbnail() const {
@@ -49,6 +49,10 @@ namespace GUI {
 class Debugger;
 }
 
+namespace Graphics {
+class FrameLimiter;
+}
+
 struct ADGameDescription;
 
 namespace BladeRunner {
@@ -74,7 +78,6 @@ class DialogueMenu;
 class Elevator;
 class EndCredits;
 class ESPER;
-class Framelimiter;
 class Font;
 class GameFlags;
 class GameInfo;
@@ -174,7 +177,7 @@ public:
 	SuspectsDatabase   *_suspectsDatabase;
 	Time               *_time;
 	View               *_view;
-	Framelimiter       *_framelimiter;
+	Graphics::FrameLimiter *_framelimiter;
 	VK                 *_vk;
 	Waypoints          *_waypoints;
 	int                *_gameVars;
@@ -24,7 +24,6 @@ MODULE_OBJS = \
 	decompress_lcw.o \
 	decompress_lzo.o \
 	dialogue_menu.o \
-	framelimiter.o \
 	fog.o \
 	font.o \
 	game_flags.o \
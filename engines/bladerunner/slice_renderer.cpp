@@ -542,14 +542,57 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 		return;
 	}
 
-	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
-
 	byte *p = (byte *)_sliceFramePtr + 0x20 + 4 * slice;
 
 	uint32 polyOffset = READ_LE_UINT32(p);
 
 	p = (byte *)_sliceFramePtr + polyOffset;
 
+	// The lighting and pixel format branches are resolved here once per
+	// slice, instead of for every polygon span
+	bool screenEffects = advanced && !_screenEffects->_entries.empty();
+
+	switch (surface.format.bytesPerPixel) {
+	case 1:
+		if (screenEffects) {
+			drawSlicePolygons<true, true, uint8>(p, y, surface, zbufferLine);
+		} else if (advanced) {
+			drawSlicePolygons<true, false, uint8>(p, y, surface, zbufferLine);
+		} else {
+			drawSlicePolygons<false, false, uint8>(p, y, surface, zbufferLine);
+		}
+		break;
+	case 2:
+		if (screenEffects) {
+			drawSlicePolygons<true, true, uint16>(p, y, surface, zbufferLine);
+		} else if (advanced) {
+			drawSlicePolygons<true, false, uint16>(p, y, surface, zbufferLine);
+		} else {
+			drawSlicePolygons<false, false, uint16>(p, y, surface, zbufferLine);
+		}
+		break;
+	case 4:
+		if (screenEffects) {
+			drawSlicePolygons<true, true, uint32>(p, y, surface, zbufferLine);
+		} else if (advanced) {
+			drawSlicePolygons<true, false, uint32>(p, y, surface, zbufferLine);
+		} else {
+			drawSlicePolygons<false, false, uint32>(p, y, surface, zbufferLine);
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+template <bool ADVANCED, bool SCREEN_EFFECTS, typename PixelType>
+void SliceRenderer::drawSlicePolygons(const byte *p, int y, Graphics::Surface &surface, uint16 *zbufferLine) {
+	SliceAnimations::Palette &palette = _vm->_sliceAnimations->getPalette(_framePaletteIndex);
+
+	// Pixels out of the surface are drawn on its edges
+	PixelType *dstLine = (PixelType *)surface.getBasePtr(0, CLIP(y, 0, surface.h - 1));
+	const int maxX = surface.w - 1;
+
 	uint32 polyCount = READ_LE_UINT32(p);
 	p += 4;
 
@@ -573,9 +616,11 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 
 				if (vertexZ >= 0 && vertexZ < 65536) {
 					uint32 outColor = palette.value[p[2]];
-					if (advanced) {
+					if (ADVANCED) {
 						Color256 aescColor = { 0, 0, 0 };
-						_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
+						if (SCREEN_EFFECTS) {
+							_screenEffects->getColor(&aescColor, vertexX, y, vertexZ);
+						}
 
 						Color256 color = palette.color[p[2]];
 						color.r = ((int)(_setEffectColor.r + _lightsColor.r * color.r) / 65536) + aescColor.r;
@@ -588,9 +633,7 @@ void SliceRenderer::drawSlice(int slice, bool advanced, int y, Graphics::Surface
 					for (int x = previousVertexX; x != vertexX; ++x) {
 						if (vertexZ < zbufferLine[x]) {
 							zbufferLine[x] = (uint16)vertexZ;
-
-							void *dstPtr = surface.getBasePtr(CLIP(x, 0, surface.w - 1), CLIP(y, 0, surface.h - 1));
-							drawPixel(surface, dstPtr, outColor);
+							dstLine[MIN(x, maxX)] = (PixelType)outColor;
 						}
 					}
 				}
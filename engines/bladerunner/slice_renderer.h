@@ -114,6 +114,8 @@ private:
 	void loadFrame(int animation, int frame);
 
 	void drawSlice(int slice, bool advanced, int y, Graphics::Surface &surface, uint16 *zbufferLine);
+	template <bool ADVANCED, bool SCREEN_EFFECTS, typename PixelType>
+	void drawSlicePolygons(const byte *p, int y, Graphics::Surface &surface, uint16 *zbufferLine);
 	void drawShadowInWorld(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 	void drawShadowPolygon(int transparency, Graphics::Surface &surface, uint16 *zbuffer);
 };
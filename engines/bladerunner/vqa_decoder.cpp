@@ -139,11 +139,12 @@ VQADecoder::VQADecoder() {
 }
 
 VQADecoder::~VQADecoder() {
+	// The video track may still be decompressing a codebook
+	delete _audioTrack;
+	delete _videoTrack;
 	for (uint i = _codebooks.size(); i != 0; --i) {
 		delete[] _codebooks[i - 1].data;
 	}
-	delete _audioTrack;
-	delete _videoTrack;
 	delete[] _frameInfo;
 }
 
@@ -198,6 +199,7 @@ bool VQADecoder::loadStream(Common::SeekableReadStream *s) {
 void VQADecoder::decodeVideoFrame(Graphics::Surface *surface, int frame, bool forceDraw) {
 	_decodingFrame = frame;
 	_videoTrack->decodeVideoFrame(surface, forceDraw);
+	_videoTrack->prefetchNextCodebook(frame);
 }
 
 void VQADecoder::decodeZBuffer(ZBuffer *zbuffer) {
@@ -617,17 +619,28 @@ VQADecoder::VQAVideoTrack::VQAVideoTrack(VQADecoder *vqaDecoder) {
 	_zbufChunkSize = 0;
 	_zbufChunk     = new uint8[roundup(_maxZBUFChunkSize)];
 
-	_viewDataSize = 0;
-	_viewData     = nullptr;
+	_viewDataSize     = 0;
+	_viewDataCapacity = 0;
+	_viewData         = nullptr;
 
-	_screenEffectsDataSize = 0;
-	_screenEffectsData     = nullptr;
+	_screenEffectsDataSize     = 0;
+	_screenEffectsDataCapacity = 0;
+	_screenEffectsData         = nullptr;
 
-	_lightsDataSize = 0;
-	_lightsData     = nullptr;
+	_lightsDataSize     = 0;
+	_lightsDataCapacity = 0;
+	_lightsData         = nullptr;
+
+	_prefetchedCodebook = nullptr;
+	_prefetchedCBFZ     = nullptr;
+	_prefetchedCBFZSize = 0;
+	_prefetching        = false;
 }
 
 VQADecoder::VQAVideoTrack::~VQAVideoTrack() {
+	_codebookFuture.wait();
+	delete[] _prefetchedCBFZ;
+
 	delete[] _cbfz;
 	delete[] _zbufChunk;
 	delete[] _vpointer;
@@ -661,6 +674,42 @@ void VQADecoder::VQAVideoTrack::decodeVideoFrame(Graphics::Surface *surface, boo
 	}
 }
 
+void VQADecoder::VQAVideoTrack::prefetchNextCodebook(int frame) {
+	// Without threads, decompressing ahead would only make the current frame later
+	if (ThreadPoolMan.getThreadCount() == 0) {
+		return;
+	}
+
+	if (_prefetchedCodebook) {
+		// A loop may have jumped back before the prefetched codebook was used
+		if (!_codebookFuture.isDone()) {
+			return;
+		}
+		_codebookFuture.wait();
+		_prefetchedCodebook = nullptr;
+	}
+
+	Common::Array<CodebookInfo> &codebooks = _vqaDecoder->_codebooks;
+	for (uint i = 0; i != codebooks.size(); ++i) {
+		if (codebooks[i].frame > frame) {
+			if (!codebooks[i].data) {
+				// Only the compressed chunk is read here; readCBFZ() hands it to the worker
+				_prefetching = true;
+				_vqaDecoder->readFrame(codebooks[i].frame, kVQAReadCodebook);
+				_prefetching = false;
+			}
+			return;
+		}
+	}
+}
+
+void VQADecoder::VQAVideoTrack::decompressCodebookProc(void *data) {
+	VQAVideoTrack *track = (VQAVideoTrack *)data;
+	uint32 codebookSize = 2 * track->_maxBlocks * track->_blockW * track->_blockH;
+
+	decompress_lcw(track->_prefetchedCBFZ, track->_prefetchedCBFZSize, track->_prefetchedCodebook->data, codebookSize);
+}
+
 bool VQADecoder::VQAVideoTrack::readVQFL(Common::SeekableReadStream *s, uint32 size, uint readFlags) {
 	IFFChunkHeader chd;
 
@@ -702,6 +751,19 @@ bool VQADecoder::VQAVideoTrack::readCBFZ(Common::SeekableReadStream *s, uint32 s
 	uint32 codebookSize = 2 * _maxBlocks * _blockW * _blockH;
 	codebookInfo.data = new uint8[codebookSize];
 
+	if (_prefetching) {
+		if (!_prefetchedCBFZ) {
+			_prefetchedCBFZ = new uint8[roundup(_maxCBFZSize)];
+		}
+
+		s->read(_prefetchedCBFZ, roundup(size));
+
+		_prefetchedCBFZSize = size;
+		_prefetchedCodebook = &codebookInfo;
+		ThreadPoolMan.submit(_codebookFuture, decompressCodebookProc, this);
+		return true;
+	}
+
 	if (!_cbfz) {
 		_cbfz = new uint8[roundup(_maxCBFZSize)];
 	}
@@ -739,60 +801,58 @@ bool VQADecoder::VQAVideoTrack::readVIEW(Common::SeekableReadStream *s, uint32 s
 		return false;
 	}
 
-	if (_viewData) {
+	_viewDataSize = roundup(size);
+	if (_viewDataSize > _viewDataCapacity) {
 		delete[] _viewData;
+		_viewDataCapacity = _viewDataSize;
+		_viewData = new uint8[_viewDataCapacity];
 	}
-
-	_viewDataSize = roundup(size);
-	_viewData = new uint8[_viewDataSize];
 	s->read(_viewData, _viewDataSize);
 
 	return true;
 }
 
 void VQADecoder::VQAVideoTrack::decodeView(View *view) {
-	if (!view || !_viewData) {
+	if (!view || !_viewDataSize) {
 		return;
 	}
 
 	Common::MemoryReadStream s(_viewData, _viewDataSize);
 	view->readVqa(&s);
 
-	delete[] _viewData;
-	_viewData = nullptr;
+	_viewDataSize = 0;
 }
 
 bool VQADecoder::VQAVideoTrack::readAESC(Common::SeekableReadStream *s, uint32 size) {
-	if (_screenEffectsData) {
+	_screenEffectsDataSize = roundup(size);
+	if (_screenEffectsDataSize > _screenEffectsDataCapacity) {
 		delete[] _screenEffectsData;
+		_screenEffectsDataCapacity = _screenEffectsDataSize;
+		_screenEffectsData = new uint8[_screenEffectsDataCapacity];
 	}
-
-	_screenEffectsDataSize = roundup(size);
-	_screenEffectsData = new uint8[_screenEffectsDataSize];
 	s->read(_screenEffectsData, _screenEffectsDataSize);
 
 	return true;
 }
 
 void VQADecoder::VQAVideoTrack::decodeScreenEffects(ScreenEffects *aesc) {
-	if (!aesc || !_screenEffectsData) {
+	if (!aesc || !_screenEffectsDataSize) {
 		return;
 	}
 
 	Common::MemoryReadStream s(_screenEffectsData, _screenEffectsDataSize);
 	aesc->readVqa(&s);
 
-	delete[] _screenEffectsData;
-	_screenEffectsData = nullptr;
+	_screenEffectsDataSize = 0;
 }
 
 bool VQADecoder::VQAVideoTrack::readLITE(Common::SeekableReadStream *s, uint32 size) {
-	if (_lightsData) {
+	_lightsDataSize = roundup(size);
+	if (_lightsDataSize > _lightsDataCapacity) {
 		delete[] _lightsData;
+		_lightsDataCapacity = _lightsDataSize;
+		_lightsData = new uint8[_lightsDataCapacity];
 	}
-
-	_lightsDataSize = roundup(size);
-	_lightsData = new uint8[_lightsDataSize];
 	s->read(_lightsData, _lightsDataSize);
 
 	return true;
@@ -800,15 +860,14 @@ bool VQADecoder::VQAVideoTrack::readLITE(Common::SeekableReadStream *s, uint32 s
 
 
 void VQADecoder::VQAVideoTrack::decodeLights(Lights *lights) {
-	if (!lights || !_lightsData) {
+	if (!lights || !_lightsDataSize) {
 		return;
 	}
 
 	Common::MemoryReadStream s(_lightsData, _lightsDataSize);
 	lights->readVqa(&s);
 
-	delete[] _lightsData;
-	_lightsData = nullptr;
+	_lightsDataSize = 0;
 }
 
 
@@ -868,6 +927,11 @@ void VQADecoder::VQAVideoTrack::VPTRWriteBlock(Graphics::Surface *surface, unsig
 bool VQADecoder::VQAVideoTrack::decodeFrame(Graphics::Surface *surface) {
 	CodebookInfo &codebookInfo = _vqaDecoder->codebookInfoForFrame(_vqaDecoder->_decodingFrame);
 
+	if (&codebookInfo == _prefetchedCodebook) {
+		_codebookFuture.wait();
+		_prefetchedCodebook = nullptr;
+	}
+
 	if (!codebookInfo.data) {
 		_vqaDecoder->readFrame(codebookInfo.frame, kVQAReadCodebook);
 	}
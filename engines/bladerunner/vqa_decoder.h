@@ -35,6 +35,7 @@
 
 #include "common/array.h"
 #include "common/rational.h"
+#include "common/threadpool.h"
 
 namespace BladeRunner {
 
@@ -180,6 +181,7 @@ public:
 		int getFrameCount() const;
 
 		void decodeVideoFrame(Graphics::Surface *surface, bool forceDraw);
+		void prefetchNextCodebook(int frame);
 		void decodeZBuffer(ZBuffer *zbuffer);
 		void decodeView(View *view);
 		void decodeScreenEffects(ScreenEffects *aesc);
@@ -225,12 +227,28 @@ public:
 
 		int      _curFrame;
 
+		// The chunk buffers are kept between frames; a size of zero means
+		// there is no chunk waiting to be decoded
 		uint8   *_viewData;
 		uint32   _viewDataSize;
+		uint32   _viewDataCapacity;
 		uint8   *_lightsData;
 		uint32   _lightsDataSize;
+		uint32   _lightsDataCapacity;
 		uint8   *_screenEffectsData;
 		uint32   _screenEffectsDataSize;
+		uint32   _screenEffectsDataCapacity;
+
+		// The next codebook is decompressed on a worker thread while the
+		// frames before it are shown. _prefetchedCodebook is set until
+		// decodeFrame() waited for it.
+		Common::Future      _codebookFuture;
+		CodebookInfo       *_prefetchedCodebook;
+		uint8              *_prefetchedCBFZ;
+		uint32              _prefetchedCBFZSize;
+		bool                _prefetching;
+
+		static void decompressCodebookProc(void *data);
 
 		void VPTRWriteBlock(Graphics::Surface *surface, unsigned int dstBlock, unsigned int srcBlock, int count, bool alpha = false);
 		bool decodeFrame(Graphics::Surface *surface);
@@ -93,11 +93,16 @@ void ZBuffer::init(int width, int height) {
 	_zbuf2 = new uint16[width * height];
 }
 
-static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint32 srcLen) {
+/**
+ * Apply a delta to both Z-buffers at once, so that it only needs to be
+ * parsed a single time
+ */
+static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF1, uint16 *curZBUF2, uint32 srcLen) {
 	uint32 dstSize = 640 * 480; // This is taken from global variables?
 	uint32 dstRemain = dstSize;
 
-	uint16 *curzp = curZBUF;
+	uint16 *curzp1 = curZBUF1;
+	uint16 *curzp2 = curZBUF2;
 	const uint16 *inp = (const uint16 *)src;
 
 	while (dstRemain && (inp - (const uint16 *)src) < (ptrdiff_t)srcLen) {
@@ -109,9 +114,12 @@ static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint32 srcLen
 
 			while (count--) {
 				uint16 value = FROM_LE_16(*inp++);
-				if (value)
-					*curzp = value;
-				++curzp;
+				if (value) {
+					*curzp1 = value;
+					*curzp2 = value;
+				}
+				++curzp1;
+				++curzp2;
 			}
 		} else {
 			count = MIN(count, dstRemain);
@@ -119,10 +127,13 @@ static int decodePartialZBuffer(const uint8 *src, uint16 *curZBUF, uint32 srcLen
 			uint16 value = FROM_LE_16(*inp++);
 
 			if (!value) {
-				curzp += count;
+				curzp1 += count;
+				curzp2 += count;
 			} else {
-				while (count--)
-					*curzp++ = value;
+				while (count--) {
+					*curzp1++ = value;
+					*curzp2++ = value;
+				}
 			}
 		}
 	}
@@ -163,8 +174,7 @@ bool ZBuffer::decodeData(const uint8 *data, int size) {
 		memcpy(_zbuf2, _zbuf1, 2 * _width * _height);
 	} else {
 		clean();
-		decodePartialZBuffer(data, _zbuf1, size);
-		decodePartialZBuffer(data, _zbuf2, size);
+		decodePartialZBuffer(data, _zbuf1, _zbuf2, size);
 	}
 
 	return true;
@@ -22,6 +22,7 @@
 #include "cryomni3d/omni3d.h"
 
 #include "common/rect.h"
+#include "common/threadpool.h"
 
 namespace CryOmni3D {
 
@@ -61,6 +62,8 @@ void Omni3DManager::init(double hfov) {
 		}
 	}
 
+	_warpValid = false;
+
 	_surface.create(640, 480, Graphics::PixelFormat::createFormatCLUT8());
 	clearConstraints();
 }
@@ -139,35 +142,31 @@ void Omni3DManager::updateImageCoords() {
 		_beta = -0.9 * _vfov;
 	}
 
+	updateWarp();
+
 	double tmp = (2048 * 65536) - 2048 * 65536 / (2. * M_PI) * _alpha;
 
 	uint k = 0;
 	for (uint i = 0; i < 31; i++) {
-		double v11 = _anglesH[i] + _beta;
-		double v26 = sin(v11);
-		double v25 = cos(v11) * _hypothenusesH[i];
-
 		uint offset = 80;
 		uint j;
 		for (j = 0; j < 20; j++) {
-			double v16 = atan2(_oppositeV[j], v25);
-			double v17 = v16 * _helperValue;
-			double v18 = (384 * 65536) - _squaresCoords[i][j] * v26;
+			double v17 = _warpAngles[i][j];
 
 			k += 2;
 			_imageCoords[k + 0] = (int)(tmp + v17);
 			_imageCoords[k + offset + 0] = (int)(tmp - v17);
-			_imageCoords[k + 1] = (int) v18;
-			_imageCoords[k + offset + 1] = (int) v18;
+			_imageCoords[k + 1] = _warpHeights[i][j];
+			_imageCoords[k + offset + 1] = _warpHeights[i][j];
 
 			offset -= 4;
 		}
 
-		double v19 = atan2(_oppositeV[j], v25);
+		double v19 = _warpAngles[i][j];
 
 		k += 2;
 		_imageCoords[k + 0] = (int)((2048.*65536.) - (_alpha - v19) * _helperValue);
-		_imageCoords[k + 1] = (int)((384.*65536.) - _squaresCoords[i][j] * v26);
+		_imageCoords[k + 1] = _warpHeights[i][j];
 
 		k += 40;
 	}
@@ -176,6 +175,89 @@ void Omni3DManager::updateImageCoords() {
 	_dirty = true;
 }
 
+void Omni3DManager::updateWarp() {
+	// Panning horizontally only changes _alpha, which just shifts the
+	// coordinates, so the trigonometry is only redone when _beta changes
+	if (_warpValid && _warpBeta == _beta) {
+		return;
+	}
+
+	for (uint i = 0; i < 31; i++) {
+		double v11 = _anglesH[i] + _beta;
+		double v26 = sin(v11);
+		double v25 = cos(v11) * _hypothenusesH[i];
+
+		uint j;
+		for (j = 0; j < 20; j++) {
+			double v16 = atan2(_oppositeV[j], v25);
+			double v18 = (384 * 65536) - _squaresCoords[i][j] * v26;
+
+			_warpAngles[i][j] = v16 * _helperValue;
+			_warpHeights[i][j] = (int) v18;
+		}
+
+		// The middle column is computed from the angle itself
+		_warpAngles[i][j] = atan2(_oppositeV[j], v25);
+		_warpHeights[i][j] = (int)((384.*65536.) - _squaresCoords[i][j] * v26);
+	}
+
+	_warpBeta = _beta;
+	_warpValid = true;
+}
+
+void Omni3DManager::remapBlockRowsProc(void *data, uint begin, uint end) {
+	((Omni3DManager *)data)->remapBlockRows(begin, end);
+}
+
+void Omni3DManager::remapBlockRows(uint begin, uint end) {
+	uint off = 2 + begin * 82;
+	byte *dst = (byte *)_surface.getBasePtr(0, begin * 16);
+	const byte *src = (const byte *)_sourceSurface->getBasePtr(0, 0);
+
+	for (uint i = begin; i < end; i++) {
+		for (uint j = 0; j < 40; j++) {
+			int x1  = (_imageCoords[off + 2] - _imageCoords[off + 0]) >> 4;
+			int y1  = (_imageCoords[off + 3] - _imageCoords[off + 1]) >> 4;
+			int x1_ = (_imageCoords[off + 82 + 2] - _imageCoords[off + 82 + 0]) >> 4;
+			int y1_ = (_imageCoords[off + 82 + 3] - _imageCoords[off + 82 + 1]) >> 4;
+
+			int dx1 = (x1_ - x1) >> 10;
+			int dy1 = (y1_ - y1) >> 15;
+
+			y1 >>= 5;
+
+			int dx2  = (_imageCoords[off + 82 + 0] - _imageCoords[off + 0]) >> 4;
+			int dy2  = (_imageCoords[off + 82 + 1] - _imageCoords[off + 1]) >> 9;
+			int x2 = (((_imageCoords[off + 0] >> 0) * 2) + dx2) >> 1;
+			int y2 = (((_imageCoords[off + 1] >> 5) * 2) + dy2) >> 1;
+
+			for (uint y = 0; y < 16; y++) {
+				uint px = (x2 * 2 + x1) * 16;
+				uint py = (y2 * 2 + y1) / 2;
+				uint deltaX = x1 * 32;
+				uint deltaY = y1;
+
+				for (uint x = 0; x < 16; x++) {
+					uint srcOff = (py & 0x1ff800) | (px >> 21);
+					dst[x] = src[srcOff];
+					px += deltaX;
+					py += deltaY;
+				}
+				dst += 640;
+
+				x1 += dx1;
+				y1 += dy1;
+				x2 += dx2;
+				y2 += dy2;
+			}
+			dst -= 16 * 640 - 16;
+			off += 2;
+		}
+		dst += 15 * 640;
+		off += 2;
+	}
+}
+
 const Graphics::Surface *Omni3DManager::getSurface() {
 	if (!_sourceSurface) {
 		return nullptr;
@@ -186,52 +268,8 @@ const Graphics::Surface *Omni3DManager::getSurface() {
 	}
 
 	if (_dirty) {
-		uint off = 2;
-		byte *dst = (byte *)_surface.getBasePtr(0, 0);
-		const byte *src = (const byte *)_sourceSurface->getBasePtr(0, 0);
-
-		for (uint i = 0; i < 30; i++) {
-			for (uint j = 0; j < 40; j++) {
-				int x1  = (_imageCoords[off + 2] - _imageCoords[off + 0]) >> 4;
-				int y1  = (_imageCoords[off + 3] - _imageCoords[off + 1]) >> 4;
-				int x1_ = (_imageCoords[off + 82 + 2] - _imageCoords[off + 82 + 0]) >> 4;
-				int y1_ = (_imageCoords[off + 82 + 3] - _imageCoords[off + 82 + 1]) >> 4;
-
-				int dx1 = (x1_ - x1) >> 10;
-				int dy1 = (y1_ - y1) >> 15;
-
-				y1 >>= 5;
-
-				int dx2  = (_imageCoords[off + 82 + 0] - _imageCoords[off + 0]) >> 4;
-				int dy2  = (_imageCoords[off + 82 + 1] - _imageCoords[off + 1]) >> 9;
-				int x2 = (((_imageCoords[off + 0] >> 0) * 2) + dx2) >> 1;
-				int y2 = (((_imageCoords[off + 1] >> 5) * 2) + dy2) >> 1;
-
-				for (uint y = 0; y < 16; y++) {
-					uint px = (x2 * 2 + x1) * 16;
-					uint py = (y2 * 2 + y1) / 2;
-					uint deltaX = x1 * 32;
-					uint deltaY = y1;
-
-					for (uint x = 0; x < 16; x++) {
-						uint srcOff = (py & 0x1ff800) | (px >> 21);
-						dst[x] = src[srcOff];
-						px += deltaX;
-						py += deltaY;
-					}
-					dst += 640;
-
-					x1 += dx1;
-					y1 += dy1;
-					x2 += dx2;
-					y2 += dy2;
-				}
-				dst -= 16 * 640 - 16;
-				off += 2;
-			}
-			dst += 15 * 640;
-			off += 2;
-		}
+		// Each row of blocks is independent from the others
+		ThreadPoolMan.parallelFor(0, kBlockRows, 1, remapBlockRowsProc, this);
 
 		_dirty = false;
 	}
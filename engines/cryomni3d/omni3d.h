@@ -29,8 +29,8 @@ namespace CryOmni3D {
 class Omni3DManager {
 public:
 	Omni3DManager() : _vfov(0), _alpha(0), _beta(0), _xSpeed(0), _ySpeed(0), _alphaMin(0), _alphaMax(0),
-		_betaMin(0), _betaMax(0), _helperValue(0), _dirty(true), _dirtyCoords(true),
-		_sourceSurface(nullptr) {}
+		_betaMin(0), _betaMax(0), _helperValue(0), _warpBeta(0), _warpValid(false), _dirty(true),
+		_dirtyCoords(true), _sourceSurface(nullptr) {}
 	virtual ~Omni3DManager();
 
 	void init(double hfov);
@@ -56,7 +56,15 @@ public:
 	const Graphics::Surface *getSurface();
 
 private:
+	enum {
+		// Rows of 16x16 blocks in the 640x480 view
+		kBlockRows = 30
+	};
+
 	void updateImageCoords();
+	void updateWarp();
+	void remapBlockRows(uint begin, uint end);
+	static void remapBlockRowsProc(void *data, uint begin, uint end);
 
 	double _vfov;
 
@@ -73,6 +81,12 @@ private:
 	double _oppositeV[21];
 	double _helperValue;
 
+	// The parts of _imageCoords which only depend on _beta, valid for _warpBeta
+	double _warpAngles[31][21];
+	int _warpHeights[31][21];
+	double _warpBeta;
+	bool _warpValid;
+
 	bool _dirty;
 	bool _dirtyCoords;
 	const Graphics::Surface *_sourceSurface;
@@ -525,27 +525,23 @@ void LC::c_proprefpush() {
 }
 
 void LC::c_varpush() {
-	LC::c_varrefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	Common::String name(g_lingo->readString());
+	g_lingo->push(g_lingo->varFetchByName(name, VARREF));
 }
 
 void LC::c_globalpush() {
-	LC::c_globalrefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	Common::String name(g_lingo->readString());
+	g_lingo->push(g_lingo->varFetchByName(name, GLOBALREF));
 }
 
 void LC::c_localpush() {
-	LC::c_localrefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	Common::String name(g_lingo->readString());
+	g_lingo->push(g_lingo->varFetchByName(name, LOCALREF));
 }
 
 void LC::c_proppush() {
-	LC::c_proprefpush();
-	Datum d = g_lingo->pop();
-	g_lingo->push(g_lingo->varFetch(d));
+	Common::String name(g_lingo->readString());
+	g_lingo->push(g_lingo->varFetchByName(name, PROPREF));
 }
 
 void LC::c_stackpeek() {
@@ -324,11 +324,9 @@ bool ScriptContext::hasProp(const Common::String &propName) {
 	if (_properties.contains(propName)) {
 		return true;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			return _properties["ancestor"].u.obj->hasProp(propName);
-		}
+	Datum *ancestor = getAncestor();
+	if (ancestor) {
+		return ancestor->u.obj->hasProp(propName);
 	}
 	return false;
 }
@@ -337,15 +335,14 @@ Datum ScriptContext::getProp(const Common::String &propName) {
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		return _properties[propName];
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		return it->_value;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->getProp(propName);
-		}
+	Datum *ancestor = getAncestor();
+	if (ancestor) {
+		debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), ancestor->asString(true).c_str());
+		return ancestor->u.obj->getProp(propName);
 	}
 	return _properties[propName]; // return new property
 }
@@ -354,20 +351,31 @@ bool ScriptContext::setProp(const Common::String &propName, const Datum &value)
 	if (_disposed) {
 		error("Property '%s' accessed on disposed object <%s>", propName.c_str(), Datum(this).asString(true).c_str());
 	}
-	if (_properties.contains(propName)) {
-		_properties[propName] = value;
+	DatumHash::iterator it = _properties.find(propName);
+	if (it != _properties.end()) {
+		it->_value = value;
 		return true;
 	}
-	if (_objType == kScriptObj) {
-		if (_properties.contains("ancestor") && _properties["ancestor"].type == OBJECT
-				&& (_properties["ancestor"].u.obj->getObjType() & (kScriptObj | kXtraObj))) {
-			debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), _properties["ancestor"].asString(true).c_str());
-			return _properties["ancestor"].u.obj->setProp(propName, value);
-		}
+	Datum *ancestor = getAncestor();
+	if (ancestor) {
+		debugC(3, kDebugLingoExec, "Getting prop '%s' from ancestor: <%s>", propName.c_str(), ancestor->asString(true).c_str());
+		return ancestor->u.obj->setProp(propName, value);
 	}
 	return false;
 }
 
+Datum *ScriptContext::getAncestor() {
+	if (_objType != kScriptObj)
+		return nullptr;
+
+	// Looked up on every property access that misses, so hash the name only once
+	static const Common::String ancestorName("ancestor");
+	DatumHash::iterator it = _properties.find(ancestorName);
+	if (it == _properties.end() || it->_value.type != OBJECT || !(it->_value.u.obj->getObjType() & (kScriptObj | kXtraObj)))
+		return nullptr;
+	return &it->_value;
+}
+
 // Object array
 
 void LM::m_get(int nargs) {
@@ -452,13 +460,15 @@ Common::String Window::asString() {
 
 bool Window::hasProp(const Common::String &propName) {
 	Common::String fieldName = Common::String::format("%d%s", kTheWindow, propName.c_str());
-	return g_lingo->_theEntityFields.contains(fieldName) && hasField(g_lingo->_theEntityFields[fieldName]->field);
+	TheEntityFieldHash::iterator it = g_lingo->_theEntityFields.find(fieldName);
+	return it != g_lingo->_theEntityFields.end() && hasField(it->_value->field);
 }
 
 Datum Window::getProp(const Common::String &propName) {
 	Common::String fieldName = Common::String::format("%d%s", kTheWindow, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return getField(g_lingo->_theEntityFields[fieldName]->field);
+	TheEntityFieldHash::iterator it = g_lingo->_theEntityFields.find(fieldName);
+	if (it != g_lingo->_theEntityFields.end()) {
+		return getField(it->_value->field);
 	}
 
 	warning("Window::getProp: unknown property '%s'", propName.c_str());
@@ -467,8 +477,9 @@ Datum Window::getProp(const Common::String &propName) {
 
 bool Window::setProp(const Common::String &propName, const Datum &value) {
 	Common::String fieldName = Common::String::format("%d%s", kTheWindow, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return setField(g_lingo->_theEntityFields[fieldName]->field, value);
+	TheEntityFieldHash::iterator it = g_lingo->_theEntityFields.find(fieldName);
+	if (it != g_lingo->_theEntityFields.end()) {
+		return setField(it->_value->field, value);
 	}
 
 	warning("Window::setProp: unknown property '%s'", propName.c_str());
@@ -584,13 +595,15 @@ void LM::m_moveToFront(int nargs) {
 
 bool CastMember::hasProp(const Common::String &propName) {
 	Common::String fieldName = Common::String::format("%d%s", kTheCast, propName.c_str());
-	return g_lingo->_theEntityFields.contains(fieldName) && hasField(g_lingo->_theEntityFields[fieldName]->field);
+	TheEntityFieldHash::iterator it = g_lingo->_theEntityFields.find(fieldName);
+	return it != g_lingo->_theEntityFields.end() && hasField(it->_value->field);
 }
 
 Datum CastMember::getProp(const Common::String &propName) {
 	Common::String fieldName = Common::String::format("%d%s", kTheCast, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return getField(g_lingo->_theEntityFields[fieldName]->field);
+	TheEntityFieldHash::iterator it = g_lingo->_theEntityFields.find(fieldName);
+	if (it != g_lingo->_theEntityFields.end()) {
+		return getField(it->_value->field);
 	}
 
 	warning("CastMember::getProp: unknown property '%s'", propName.c_str());
@@ -599,8 +612,9 @@ Datum CastMember::getProp(const Common::String &propName) {
 
 bool CastMember::setProp(const Common::String &propName, const Datum &value) {
 	Common::String fieldName = Common::String::format("%d%s", kTheCast, propName.c_str());
-	if (g_lingo->_theEntityFields.contains(fieldName)) {
-		return setField(g_lingo->_theEntityFields[fieldName]->field, value);
+	TheEntityFieldHash::iterator it = g_lingo->_theEntityFields.find(fieldName);
+	if (it != g_lingo->_theEntityFields.end()) {
+		return setField(it->_value->field, value);
 	}
 
 	warning("CastMember::setProp: unknown property '%s'", propName.c_str());
@@ -215,6 +215,10 @@ public:
 	bool setProp(const Common::String &propName, const Datum &value) override;
 
 	Symbol define(const Common::String &name, ScriptData *code, Common::Array<Common::String> *argNames, Common::Array<Common::String> *varNames);
+
+private:
+	/** Returns the ancestor property of a script object, if it holds an object with properties. */
+	Datum *getAncestor();
 };
 
 namespace LM {
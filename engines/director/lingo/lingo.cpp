@@ -1237,10 +1237,13 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 	switch (var.type) {
 	case VARREF:
 		{
-			Common::String name = *var.u.s;
-			if (_localvars && _localvars->contains(name)) {
-				(*_localvars)[name] = value;
-				return;
+			const Common::String &name = *var.u.s;
+			if (_localvars) {
+				DatumHash::iterator it = _localvars->find(name);
+				if (it != _localvars->end()) {
+					it->_value = value;
+					return;
+				}
 			}
 			if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
 				_currentMe.u.obj->setProp(name, value);
@@ -1258,9 +1261,10 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case LOCALREF:
 		{
-			Common::String name = *var.u.s;
-			if (_localvars && _localvars->contains(name)) {
-				(*_localvars)[name] = value;
+			const Common::String &name = *var.u.s;
+			DatumHash::iterator it;
+			if (_localvars && (it = _localvars->find(name)) != _localvars->end()) {
+				it->_value = value;
 			} else {
 				warning("varAssign: local variable %s not defined", name.c_str());
 			}
@@ -1268,7 +1272,7 @@ void Lingo::varAssign(const Datum &var, const Datum &value) {
 		break;
 	case PROPREF:
 		{
-			Common::String name = *var.u.s;
+			const Common::String &name = *var.u.s;
 			if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
 				_currentMe.u.obj->setProp(name, value);
 			} else {
@@ -1347,55 +1351,10 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 
 	switch (var.type) {
 	case VARREF:
-		{
-			Datum d;
-			Common::String name = *var.u.s;
-
-			if (_localvars && _localvars->contains(name)) {
-				return (*_localvars)[name];
-			}
-			if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
-				return _currentMe.u.obj->getProp(name);
-			}
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
-			}
-
-			if (!silent)
-				warning("varFetch: variable %s not found", name.c_str());
-			return result;
-		}
-		break;
 	case GLOBALREF:
-		{
-			Common::String name = *var.u.s;
-			if (_globalvars.contains(name)) {
-				return _globalvars[name];
-			}
-			warning("varFetch: global variable %s not defined", name.c_str());
-			return result;
-		}
-		break;
 	case LOCALREF:
-		{
-			Common::String name = *var.u.s;
-			if (_localvars && _localvars->contains(name)) {
-				return (*_localvars)[name];
-			}
-			warning("varFetch: local variable %s not defined", name.c_str());
-			return result;
-		}
-		break;
 	case PROPREF:
-		{
-			Common::String name = *var.u.s;
-			if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name)) {
-				return _currentMe.u.obj->getProp(name);
-			}
-			warning("varFetch: property %s not defined", name.c_str());
-			return result;
-		}
-		break;
+		return varFetchByName(*var.u.s, var.type, silent);
 	case FIELDREF:
 	case CASTREF:
 	case CHUNKREF:
@@ -1412,6 +1371,39 @@ Datum Lingo::varFetch(const Datum &var, bool silent) {
 	return result;
 }
 
+Datum Lingo::varFetchByName(const Common::String &name, DatumType type, bool silent) {
+	// Each table is only hashed once per lookup
+	if (type == VARREF || type == LOCALREF) {
+		if (_localvars) {
+			DatumHash::iterator it = _localvars->find(name);
+			if (it != _localvars->end())
+				return it->_value;
+		}
+		if (type == LOCALREF) {
+			warning("varFetch: local variable %s not defined", name.c_str());
+			return Datum();
+		}
+	}
+	if (type == VARREF || type == PROPREF) {
+		if (_currentMe.type == OBJECT && _currentMe.u.obj->hasProp(name))
+			return _currentMe.u.obj->getProp(name);
+		if (type == PROPREF) {
+			warning("varFetch: property %s not defined", name.c_str());
+			return Datum();
+		}
+	}
+
+	DatumHash::iterator it = _globalvars.find(name);
+	if (it != _globalvars.end())
+		return it->_value;
+
+	if (type == GLOBALREF)
+		warning("varFetch: global variable %s not defined", name.c_str());
+	else if (!silent)
+		warning("varFetch: variable %s not found", name.c_str());
+	return Datum();
+}
+
 Common::U32String Lingo::evalChunkRef(const Datum &var) {
 	Common::U32String result;
 
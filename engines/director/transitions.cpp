@@ -793,21 +793,28 @@ void Window::dissolvePatternsTrans(TransParams &t, Common::Rect &clipRect, Graph
 	t.steps = 64;
 	t.stepDuration = t.duration / t.steps;
 
+	const int bpp = _composeSurface->format.bytesPerPixel;
+
 	for (int i = 0; i < t.steps; i++) {
-		for (int y = clipRect.top; y < clipRect.bottom; y++) {
-			byte pat = dissolvePatterns[i][y % 8];
-			byte *dst = (byte *)_composeSurface->getBasePtr(clipRect.left, y);
-			byte *src = (byte *)nextFrame->getBasePtr(clipRect.left, y);
-
-			for (int x = clipRect.left; x < clipRect.right;) {
-				byte mask = 0x80;
-				for (int b = 0; b < 8 && x < clipRect.right; b++, x++) {
-					if (pat & mask)
-						*dst = *src;
-
-					dst++;
-					src++;
-					mask >>= 1;
+		// Each pattern only adds pixels to the previous one, so only the new
+		// pixels are copied. That is a single row out of every eight.
+		for (int row = 0; row < 8; row++) {
+			byte pat = dissolvePatterns[i][row];
+			if (i > 0)
+				pat &= ~dissolvePatterns[i - 1][row];
+			if (!pat)
+				continue;
+
+			for (int y = clipRect.top + (row - clipRect.top % 8 + 8) % 8; y < clipRect.bottom; y += 8) {
+				byte *dst = (byte *)_composeSurface->getBasePtr(clipRect.left, y);
+				const byte *src = (const byte *)nextFrame->getBasePtr(clipRect.left, y);
+
+				for (int b = 0; b < 8; b++) {
+					if (!(pat & (0x80 >> b)))
+						continue;
+
+					for (int x = b; x < clipRect.width(); x += 8)
+						memcpy(dst + x * bpp, src + x * bpp, bpp);
 				}
 			}
 		}
@@ -980,13 +987,14 @@ void Window::transMultiPass(TransParams &t, Common::Rect &clipRect, Graphics::Ma
 			rto.translate(clipRect.left, clipRect.top);
 			rto.clip(clipRect);
 
-			if (rto.height() > 0 && rto.width() > 0) {
+			if (rto.height() > 0 && rto.width() > 0)
 				_composeSurface->blitFrom(*nextFrame, rto, Common::Point(rto.left, rto.top));
-				stepTransition();
-			}
 		}
 		rects.clear();
 
+		// Present the whole step at once instead of after every rect
+		stepTransition();
+
 		g_lingo->executePerFrameHook(t.frame, i);
 
 		g_system->delayMillis(t.stepDuration);
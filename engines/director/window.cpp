@@ -20,8 +20,10 @@
  */
 
 #include "common/file.h"
+#include "common/mutex.h"
 #include "common/system.h"
 #include "common/macresman.h"
+#include "common/threadpool.h"
 
 #include "graphics/primitives.h"
 #include "graphics/macgui/macwindowmanager.h"
@@ -41,6 +43,102 @@
 
 namespace Director {
 
+enum {
+	kMinParallelRenderArea = 32 * 1024
+};
+
+/** A sprite to draw into one dirty rect, with everything the blit needs looked up. */
+struct InkBlit {
+	DirectorPlotData pd;
+	Common::Rect srcRect;
+	const Graphics::Surface *mask;
+	bool stretched;
+
+	InkBlit(const DirectorPlotData &plotData, const Common::Rect &src, const Graphics::Surface *msk, bool stretch) :
+		pd(plotData), srcRect(src), mask(msk), stretched(stretch) {}
+};
+
+/** One dirty rect, and the sprites to draw into it from bottom to top. */
+struct RenderJob {
+	Common::Rect rect;
+	bool clear;
+	Common::List<InkBlit> blits;
+};
+
+/**
+ * Dirty rects which do not overlap, as composed by
+ * Common::ThreadPool::parallelFor(). The rects differ a lot in size, so
+ * every thread takes the next rect when it is done with one.
+ */
+struct InkBlitJobs {
+	Common::Array<RenderJob> *jobs;
+	Graphics::ManagedSurface *blitTo;
+	uint32 stageColor;
+
+	Common::Mutex mutex;
+	// Protected by mutex
+	uint nextJob;
+
+	bool drawNextJob() {
+		RenderJob *job;
+		{
+			Common::StackLock lock(mutex);
+			if (nextJob >= jobs->size())
+				return false;
+
+			job = &(*jobs)[nextJob++];
+		}
+
+		// The dirty rect of the surface is added by the calling thread
+		if (job->clear)
+			blitTo->surfacePtr()->fillRect(job->rect, stageColor);
+
+		for (Common::List<InkBlit>::iterator i = job->blits.begin(); i != job->blits.end(); i++) {
+			if (i->stretched)
+				i->pd.inkBlitStretchSurface(i->srcRect, i->mask);
+			else
+				i->pd.inkBlitSurface(i->srcRect, i->mask);
+		}
+		return true;
+	}
+
+	/** Called once for each thread drawing. */
+	static void draw(void *data, uint begin, uint end) {
+		InkBlitJobs *inkBlitJobs = (InkBlitJobs *)data;
+		while (inkBlitJobs->drawNextJob())
+			;
+	}
+};
+
+/**
+ * Returns true if drawing the sprite may look up colors in the palette,
+ * which goes through a cache shared by all sprites.
+ */
+static bool needsColorLookup(const DirectorPlotData &pd) {
+	if (pd._wm->_pixelformat.bytesPerPixel != 1)
+		return false;
+
+	if (pd.alpha)
+		return true;
+
+	switch (pd.ink) {
+	case kInkTypeCopy:
+	case kInkTypeMatte:
+	case kInkTypeBackgndTrans:
+	case kInkTypeNotCopy:
+		return pd.applyColor;
+	case kInkTypeTransparent:
+	case kInkTypeNotTrans:
+	case kInkTypeReverse:
+	case kInkTypeNotReverse:
+	case kInkTypeGhost:
+	case kInkTypeNotGhost:
+		return false;
+	default:
+		return true;
+	}
+}
+
 Window::Window(int id, bool scrollable, bool resizable, bool editable, Graphics::MacWindowManager *wm, DirectorEngine *vm, bool isStage)
 	: MacWindow(id, scrollable, resizable, editable, wm), Object<Window>("Window") {
 	_vm = vm;
@@ -134,6 +232,12 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 		blitTo = _composeSurface;
 	Channel *hiliteChannel = _currentMovie->getScore()->getChannelById(_currentMovie->_currentHiliteChannelId);
 
+	if (ThreadPoolMan.getThreadCount() > 0 && _dirtyRects.size() > 1 && renderInParallel(hiliteChannel, blitTo)) {
+		_dirtyRects.clear();
+		_contentIsDirty = true;
+		return true;
+	}
+
 	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); i++) {
 		const Common::Rect &r = *i;
 		_dirtyChannels = _currentMovie->getScore()->getSpriteIntersections(r);
@@ -181,6 +285,92 @@ bool Window::render(bool forceRedraw, Graphics::ManagedSurface *blitTo) {
 	return true;
 }
 
+bool Window::renderInParallel(Channel *hiliteChannel, Graphics::ManagedSurface *blitTo) {
+	// Merging the dirty rects may still leave some of them overlapping
+	uint area = 0;
+	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); i++) {
+		Common::List<Common::Rect>::iterator j = i;
+		while (++j != _dirtyRects.end()) {
+			if (i->intersects(*j))
+				return false;
+		}
+		area += i->width() * i->height();
+	}
+	if (area < kMinParallelRenderArea)
+		return false;
+
+	// Everything with side effects is looked up here, on the calling thread
+	Common::Array<RenderJob> jobs;
+	jobs.resize(_dirtyRects.size());
+	uint jobIndex = 0;
+	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); i++, jobIndex++) {
+		RenderJob &job = jobs[jobIndex];
+		job.rect = *i;
+		job.clear = true;
+
+		Common::List<Channel *> channels = _currentMovie->getScore()->getSpriteIntersections(job.rect);
+		for (Common::List<Channel *>::iterator j = channels.begin(); j != channels.end(); j++) {
+			Channel *channel = *j;
+			if (!channel->_visible)
+				continue;
+			if (job.rect == channel->getBbox() && channel->isTrail())
+				job.clear = false;
+
+			// Videos, highlights and generated masks stay on the serial path
+			if (channel == hiliteChannel || channel->isActiveVideo())
+				return false;
+
+			Common::Array<Channel *> parts;
+			if (channel->hasSubChannels()) {
+				Common::Array<Channel> *list = channel->getSubChannels();
+				for (Common::Array<Channel>::iterator k = list->begin(); k != list->end(); k++)
+					parts.push_back(&(*k));
+			} else {
+				parts.push_back(channel);
+			}
+
+			for (uint k = 0; k < parts.size(); k++) {
+				Channel *part = parts[k];
+				if (part->_sprite->_ink == kInkTypeMask)
+					return false;
+
+				Common::Rect srcRect = part->getBbox();
+				Common::Rect destRect = job.rect;
+				destRect.clip(srcRect);
+
+				DirectorPlotData pd = part->getPlotData();
+				if (pd.ms)
+					return false;
+				if (!pd.srf)
+					continue;
+				if (needsColorLookup(pd))
+					return false;
+
+				pd.destRect = destRect;
+				pd.dst = blitTo;
+
+				bool stretched = part->isStretched();
+				if (stretched)
+					srcRect = part->getBbox(true);
+				job.blits.push_back(InkBlit(pd, srcRect, part->getMask(), stretched));
+			}
+		}
+	}
+
+	InkBlitJobs inkBlitJobs;
+	inkBlitJobs.jobs = &jobs;
+	inkBlitJobs.blitTo = blitTo;
+	inkBlitJobs.stageColor = _stageColor;
+	inkBlitJobs.nextJob = 0;
+	ThreadPoolMan.parallelFor(0, MIN<uint>(ThreadPoolMan.getThreadCount() + 1, jobs.size()), 1, InkBlitJobs::draw, &inkBlitJobs);
+
+	for (uint i = 0; i < jobs.size(); i++) {
+		if (jobs[i].clear)
+			blitTo->addDirtyRect(jobs[i].rect);
+	}
+	return true;
+}
+
 void Window::setStageColor(uint32 stageColor, bool forceReset) {
 	if (stageColor != _stageColor || forceReset) {
 		_stageColor = stageColor;
@@ -202,6 +202,13 @@ private:
 
 	void inkBlitFrom(Channel *channel, Common::Rect destRect, Graphics::ManagedSurface *blitTo = nullptr);
 
+	/**
+	 * Compose the dirty rects on several threads, if they do not overlap
+	 * and only contain sprites which can be drawn without touching any
+	 * shared state. Returns false, without drawing anything, otherwise.
+	 */
+	bool renderInParallel(Channel *hiliteChannel, Graphics::ManagedSurface *blitTo);
+
 };
 
 } // End of namespace Director
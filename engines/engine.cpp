@@ -188,6 +188,10 @@ Engine::Engine(OSystem *syst)
 Engine::~Engine() {
 	_mixer->stopAll();
 
+	// Autosaves still being written call back into the engine
+	_saveFileMan->waitForPendingSaves();
+	_saveFileMan->processCompletedSaves();
+
 	delete _debugger;
 	delete _mainMenuDialog;
 	g_engine = NULL;
@@ -595,6 +599,13 @@ bool Engine::warnBeforeOverwritingAutosave() {
 	}
 }
 
+void Engine::autosaveWritten(Common::Error result) {
+	if (result.getCode() != Common::kNoError) {
+		warning("Failed to write autosave: %s", result.getDesc().c_str());
+		g_system->displayMessageOnOSD(_("Error occurred making autosave"));
+	}
+}
+
 void Engine::saveAutosaveIfEnabled() {
 	// Prevents recursive calls if saving the game causes the engine to poll events
 	// (as is the case with the AGS engine for example, or when showing a prompt).
@@ -829,7 +840,11 @@ bool Engine::canLoadGameStateCurrently() {
 }
 
 Common::Error Engine::saveGameState(int slot, const Common::String &desc, bool isAutosave) {
-	Common::OutSaveFile *saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
+	Common::OutSaveFile *saveFile;
+	if (isAutosave)
+		saveFile = _saveFileMan->openForSavingAsync(getSaveStateName(slot), new Common::Callback<Engine, Common::Error>(this, &Engine::autosaveWritten));
+	else
+		saveFile = _saveFileMan->openForSaving(getSaveStateName(slot));
 
 	if (!saveFile)
 		return Common::kWritingFailed;
@@ -435,6 +435,10 @@ public:
 	 * @param desc        Description for the save state, entered by the user.
 	 * @param isAutosave  Expected to be true if an autosave is being created.
 	 *
+	 * The default implementation writes autosaves in the background, see
+	 * Common::SaveFileManager::openForSavingAsync(), so they do not interrupt
+	 * the game. A failure to write them is reported once they are done.
+	 *
 	 * @return kNoError on success, otherwise an error code.
 	 */
 	virtual Common::Error saveGameState(int slot, const Common::String &desc, bool isAutosave = false);
@@ -537,6 +541,11 @@ private:
 	 */
 	bool warnBeforeOverwritingAutosave();
 
+	/**
+	 * Called once an autosave written in the background is done.
+	 */
+	void autosaveWritten(Common::Error result);
+
 public:
 
 	/**
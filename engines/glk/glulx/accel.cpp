@@ -73,6 +73,14 @@ acceleration_func Glulx::accel_find_func(uint index) {
 	return nullptr;
 }
 
+const char *Glulx::accel_func_name(uint index) const {
+	static const char *const NAMES[] = {
+		"", "Z__Region", "CP__Tab", "RA__Pr", "RL__Pr", "OC__Cl", "RV__Pr", "OP__Pr",
+		"CP__Tab", "RA__Pr", "RL__Pr", "OC__Cl", "RV__Pr", "OP__Pr"
+	};
+	return index < ARRAYSIZE(NAMES) ? NAMES[index] : "";
+}
+
 acceleration_func Glulx::accel_get_func(uint addr) {
 	int bucknum;
 	accelentry_t *ptr;
@@ -82,8 +90,11 @@ acceleration_func Glulx::accel_get_func(uint addr) {
 
 	bucknum = (addr % ACCEL_HASH_SIZE);
 	for (ptr = accelentries[bucknum]; ptr; ptr = ptr->next) {
-		if (ptr->addr == addr)
+		if (ptr->addr == addr) {
+			if (ptr->func)
+				ptr->calls++;
 			return ptr->func;
+		}
 	}
 	return nullptr;
 }
@@ -143,10 +154,13 @@ void Glulx::accel_set_func(uint index, uint addr) {
 		ptr->addr = addr;
 		ptr->index = 0;
 		ptr->func = nullptr;
+		ptr->calls = 0;
 		ptr->next = accelentries[bucknum];
 		accelentries[bucknum] = ptr;
 	}
 
+	if (ptr->index != index)
+		ptr->calls = 0;
 	ptr->index = index;
 	ptr->func = new_func;
 }
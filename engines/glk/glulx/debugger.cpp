@@ -0,0 +1,52 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "glk/glulx/debugger.h"
+#include "glk/glulx/glulx.h"
+
+namespace Glk {
+namespace Glulx {
+
+Debugger::Debugger() : Glk::Debugger() {
+	registerCmd("accel", WRAP_METHOD(Debugger, cmdAccel));
+}
+
+bool Debugger::cmdAccel(int argc, const char **argv) {
+	if (!g_vm->accelentries) {
+		debugPrintf("No functions are accelerated\n");
+		return true;
+	}
+
+	for (int bucknum = 0; bucknum < ACCEL_HASH_SIZE; bucknum++) {
+		for (const accelentry_t *ptr = g_vm->accelentries[bucknum]; ptr; ptr = ptr->next) {
+			if (ptr->func) {
+				debugPrintf("%2d %-12s %08x: %u calls\n", ptr->index,
+					g_vm->accel_func_name(ptr->index), ptr->addr, ptr->calls);
+			}
+		}
+	}
+
+	return true;
+}
+
+} // End of namespace Glulx
+} // End of namespace Glk
@@ -19,36 +19,26 @@
  *
  */
 
-#ifndef BLADERUNNER_FRAMELIMITER_H
-#define BLADERUNNER_FRAMELIMITER_H
 
-#include "bladerunner/bladerunner.h"
+#ifndef GLK_GLULX_DEBUGGER_H
+#define GLK_GLULX_DEBUGGER_H
 
-namespace BladeRunner {
+#include "glk/debugger.h"
 
-class BladeRunnerEngine;
-
-class Framelimiter {
-	friend class Debugger;
+namespace Glk {
+namespace Glulx {
 
+class Debugger : public Glk::Debugger {
 private:
-	BladeRunnerEngine *_vm;
-
-	bool   _enabled;
-	uint32 _speedLimitMs;
-
-	uint32 _timeFrameStart;
-
+	/**
+	 * Lists the accelerated functions, and how many calls each of them handled
+	 */
+	bool cmdAccel(int argc, const char **argv);
 public:
-	Framelimiter(BladeRunnerEngine *vm, uint fps = 60);
-
-	void wait();
-
-private:
-	void reset();
-
+	Debugger();
 };
 
-} // End of namespace BladeRunner
+} // End of namespace Glulx
+} // End of namespace Glk
 
 #endif
@@ -40,6 +40,7 @@ typedef void (Glulx::*UnicharHandler)(uint32);
  * Glulx game interpreter
  */
 class Glulx : public GlkAPI {
+	friend class Debugger;
 private:
 	/**
 	 * \defgroup vm fields
@@ -145,6 +146,12 @@ private:
 	 */
 	const operandlist_t *fast_operandlist[0x80];
 
+	/**
+	 * The instructions in ROM which have already been decoded, indexed by their address modulo
+	 * PREDECODE_CACHE_SIZE.
+	 */
+	predecoded_inst_t *predecode_cache;
+
 	/**@}*/
 
 	/**
@@ -403,6 +410,11 @@ public:
 	 */
 	void runGame() override;
 
+	/**
+	 * Create the debugger
+	 */
+	void createDebugger() override;
+
 	/**
 	 * Returns the running interpreter type
 	 */
@@ -543,13 +555,29 @@ public:
 	const operandlist_t *lookup_operandlist(uint opcode);
 
 	/**
-	 * Read the list of operands of an instruction, and put the values in args. This assumes
-	 * that the PC is at the beginning of the operand mode list (right after an opcode number.)
-	 * Upon return, the PC will be at the beginning of the next instruction.
+	 * Free the predecoded instruction cache.
+	 */
+	void final_operands();
+
+	/**
+	 * Read the opcode and operand modes of the instruction at addr into inst, without loading any operand
+	 * values. This also sets inst->nextpc to the beginning of the next instruction.
+	 */
+	void decode_instruction(predecoded_inst_t *inst, uint addr);
+
+	/**
+	 * Return the decoded instruction at addr, which must be in ROM. ROM can't be written, so each
+	 * instruction only needs to be decoded the first time it's executed.
+	 */
+	const predecoded_inst_t *predecode_instruction(uint addr);
+
+	/**
+	 * Load the operands of a decoded instruction, and put the values in args. Operands popped off the
+	 * stack are popped in order.
 	 *
 	 * This also assumes that args points at an allocated array of MAX_OPERANDS oparg_t structures.
 	*/
-	void parse_operands(oparg_t *opargs, const operandlist_t *oplist);
+	void load_operands(oparg_t *args, const predecoded_inst_t *inst);
 
 	/**
 	 * Store a result value, according to the desttype and destaddress given. This is usually used to store
@@ -870,6 +898,15 @@ public:
 	 */
 
 	acceleration_func accel_find_func(uint index);
+
+	/**
+	 * Return the name of the Inform function an acceleration index stands for.
+	 */
+	const char *accel_func_name(uint index) const;
+
+	/**
+	 * Return the acceleration function for an address, if any, counting the call it's about to handle.
+	 */
 	acceleration_func accel_get_func(uint addr);
 	void accel_set_func(uint index, uint addr);
 	void accel_set_param(uint index, uint val);
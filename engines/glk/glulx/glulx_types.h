@@ -351,12 +351,49 @@ typedef oparg_struct oparg_t;
 
 #define MAX_OPERANDS (8)
 
+enum predecoded_mode {
+	predecoded_Const = 0,   ///< The value is the operand
+	predecoded_Pop = 1,     ///< The operand is popped off the stack
+	predecoded_Mem = 2,     ///< The value is the main memory address of the operand
+	predecoded_Local = 3,   ///< The value is the locals address of the operand
+	predecoded_Store = 4    ///< The desttype and value of the operand are already known
+};
+
+/**
+ * An operand as read from the instruction, before any memory or stack access
+ */
+struct predecoded_operand_struct {
+	byte mode;              ///< One of the predecoded_mode values
+	byte desttype;          ///< Destination type of store operands
+	uint value;
+};
+typedef predecoded_operand_struct predecoded_operand_t;
+
+/**
+ * An instruction whose opcode and operand modes have been read
+ */
+struct predecoded_inst_struct {
+	uint addr;              ///< Address of the instruction, or zero if this is unused
+	uint opcode;
+	uint nextpc;            ///< Address of the next instruction
+	const operandlist_t *oplist;
+	predecoded_operand_t operands[MAX_OPERANDS];
+};
+typedef predecoded_inst_struct predecoded_inst_t;
+
+/**
+ * Number of instructions held by the predecoded instruction cache. Only instructions in ROM are cached,
+ * since they can't change while the game runs.
+ */
+#define PREDECODE_CACHE_SIZE (8192)
+
 typedef uint(Glulx::*acceleration_func)(uint argc, uint *argv);
 
 struct accelentry_struct {
 	uint addr;
 	uint index;
 	acceleration_func func;
+	uint calls;             ///< Number of calls handled by func
 	accelentry_struct *next;
 };
 typedef accelentry_struct accelentry_t;
@@ -66,6 +66,21 @@ static const operandlist_t list_LLSS = { 4, 4, &array_LLSS[0] };
 void Glulx::init_operands() {
 	for (int ix = 0; ix < 0x80; ix++)
 		fast_operandlist[ix] = lookup_operandlist(ix);
+
+	if (!predecode_cache) {
+		predecode_cache = (predecoded_inst_t *)glulx_malloc(PREDECODE_CACHE_SIZE * sizeof(predecoded_inst_t));
+		if (!predecode_cache)
+			fatal_error("Unable to allocate instruction cache.");
+	}
+	for (int ix = 0; ix < PREDECODE_CACHE_SIZE; ix++)
+		predecode_cache[ix].addr = 0;
+}
+
+void Glulx::final_operands() {
+	if (predecode_cache) {
+		glulx_free(predecode_cache);
+		predecode_cache = nullptr;
+	}
 }
 
 const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
@@ -279,22 +294,60 @@ const operandlist_t *Glulx::lookup_operandlist(uint opcode) {
 	}
 }
 
-void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
+void Glulx::decode_instruction(predecoded_inst_t *inst, uint addr) {
 	int ix;
-	oparg_t *curarg;
+	predecoded_operand_t *curop;
+	const operandlist_t *oplist;
+	uint opcode;
+	uint instaddr = addr;
+
+	/* Fetch the opcode number. */
+	opcode = Mem1(addr);
+	addr++;
+	if (opcode & 0x80) {
+		/* More than one-byte opcode. */
+		if (opcode & 0x40) {
+			/* Four-byte opcode */
+			opcode &= 0x3F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		} else {
+			/* Two-byte opcode */
+			opcode &= 0x7F;
+			opcode = (opcode << 8) | Mem1(addr);
+			addr++;
+		}
+	}
+
+	/* Fetch the structure that describes how the operands for this
+	   opcode are arranged. This is a pointer to an immutable,
+	   static object. */
+	if (opcode < 0x80)
+		oplist = fast_operandlist[opcode];
+	else
+		oplist = lookup_operandlist(opcode);
+
+	if (!oplist)
+		fatal_error_i("Encountered unknown opcode.", opcode);
+
+	inst->opcode = opcode;
+	inst->oplist = oplist;
+
 	int numops = oplist->num_ops;
-	int argsize = oplist->arg_size;
-	uint modeaddr = pc;
+	uint modeaddr = addr;
 	int modeval = 0;
 
-	pc += (numops + 1) / 2;
+	addr += (numops + 1) / 2;
 
-	for (ix = 0, curarg = args; ix < numops; ix++, curarg++) {
+	for (ix = 0, curop = inst->operands; ix < numops; ix++, curop++) {
 		int mode;
 		uint value;
-		uint addr;
 
-		curarg->desttype = 0;
+		curop->desttype = 0;
 
 		if ((ix & 1) == 0) {
 			modeval = Mem1(modeaddr);
@@ -309,211 +362,259 @@ void Glulx::parse_operands(oparg_t *args, const operandlist_t *oplist) {
 			switch (mode) {
 
 			case 8: /* pop off stack */
-				if (stackptr < valstackbase + 4) {
-					fatal_error("Stack underflow in operand.");
-				}
-				stackptr -= 4;
-				value = Stk4(stackptr);
+				curop->mode = predecoded_Pop;
+				value = 0;
 				break;
 
 			case 0: /* constant zero */
+				curop->mode = predecoded_Const;
 				value = 0;
 				break;
 
 			case 1: /* one-byte constant */
 				/* Sign-extend from 8 bits to 32 */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
+				curop->mode = predecoded_Const;
+				value = (int)(signed char)(Mem1(addr));
+				addr++;
 				break;
 
 			case 2: /* two-byte constant */
 				/* Sign-extend the first byte from 8 bits to 32; the subsequent
 				   byte must not be sign-extended. */
-				value = (int)(signed char)(Mem1(pc));
-				pc++;
-				value = (value << 8) | (uint)(Mem1(pc));
-				pc++;
+				curop->mode = predecoded_Const;
+				value = (int)(signed char)(Mem1(addr));
+				addr++;
+				value = (value << 8) | (uint)(Mem1(addr));
+				addr++;
 				break;
 
 			case 3: /* four-byte constant */
 				/* Bytes must not be sign-extended. */
-				value = Mem4(pc);
-				pc += 4;
+				curop->mode = predecoded_Const;
+				value = Mem4(addr);
+				addr += 4;
 				break;
 
 			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto MainMemAddr;
+				curop->mode = predecoded_Mem;
+				value = Mem4(addr) + ramstart;
+				addr += 4;
+				break;
 
 			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto MainMemAddr;
+				curop->mode = predecoded_Mem;
+				value = (uint)Mem2(addr) + ramstart;
+				addr += 2;
+				break;
 
 			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto MainMemAddr;
+				curop->mode = predecoded_Mem;
+				value = (uint)(Mem1(addr)) + ramstart;
+				addr++;
+				break;
 
 			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto MainMemAddr;
+				curop->mode = predecoded_Mem;
+				value = Mem4(addr);
+				addr += 4;
+				break;
 
 			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto MainMemAddr;
+				curop->mode = predecoded_Mem;
+				value = (uint)Mem2(addr);
+				addr += 2;
+				break;
 
 			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-MainMemAddr:
-				/* cases 5, 6, 7, 13, 14, 15 all wind up here. */
-				if (argsize == 4) {
-					value = Mem4(addr);
-				} else if (argsize == 2) {
-					value = Mem2(addr);
-				} else {
-					value = Mem1(addr);
-				}
+				curop->mode = predecoded_Mem;
+				value = (uint)(Mem1(addr));
+				addr++;
 				break;
 
 			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto LocalsAddr;
+				curop->mode = predecoded_Local;
+				value = Mem4(addr);
+				addr += 4;
+				break;
 
 			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto LocalsAddr;
+				curop->mode = predecoded_Local;
+				value = (uint)Mem2(addr);
+				addr += 2;
+				break;
 
 			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-LocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				addr += localsbase;
-				if (argsize == 4) {
-					value = Stk4(addr);
-				} else if (argsize == 2) {
-					value = Stk2(addr);
-				} else {
-					value = Stk1(addr);
-				}
+				/* It's illegal for the address to not be four-byte aligned, but
+				   we don't check this explicitly. A "strict mode" interpreter
+				   probably should. It's also illegal for it to be less than zero
+				   or greater than the size of the locals segment. */
+				curop->mode = predecoded_Local;
+				value = (uint)(Mem1(addr));
+				addr++;
 				break;
 
 			default:
+				curop->mode = predecoded_Const;
 				value = 0;
 				fatal_error("Unknown addressing mode in load operand.");
 			}
 
-			curarg->value = value;
+			curop->value = value;
 
 		} else { /* modeform_Store */
+			curop->mode = predecoded_Store;
+
 			switch (mode) {
 
 			case 0: /* discard value */
-				curarg->desttype = 0;
-				curarg->value = 0;
+				curop->desttype = 0;
+				curop->value = 0;
 				break;
 
 			case 8: /* push on stack */
-				curarg->desttype = 3;
-				curarg->value = 0;
+				curop->desttype = 3;
+				curop->value = 0;
 				break;
 
 			case 15: /* main memory RAM, four-byte address */
-				addr = Mem4(pc);
-				addr += ramstart;
-				pc += 4;
-				goto WrMainMemAddr;
+				curop->desttype = 1;
+				curop->value = Mem4(addr) + ramstart;
+				addr += 4;
+				break;
 
 			case 14: /* main memory RAM, two-byte address */
-				addr = (uint)Mem2(pc);
-				addr += ramstart;
-				pc += 2;
-				goto WrMainMemAddr;
+				curop->desttype = 1;
+				curop->value = (uint)Mem2(addr) + ramstart;
+				addr += 2;
+				break;
 
 			case 13: /* main memory RAM, one-byte address */
-				addr = (uint)(Mem1(pc));
-				addr += ramstart;
-				pc++;
-				goto WrMainMemAddr;
+				curop->desttype = 1;
+				curop->value = (uint)(Mem1(addr)) + ramstart;
+				addr++;
+				break;
 
 			case 7: /* main memory, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrMainMemAddr;
+				curop->desttype = 1;
+				curop->value = Mem4(addr);
+				addr += 4;
+				break;
 
 			case 6: /* main memory, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrMainMemAddr;
+				curop->desttype = 1;
+				curop->value = (uint)Mem2(addr);
+				addr += 2;
+				break;
 
 			case 5: /* main memory, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrMainMemAddr:
-				/* cases 5, 6, 7 all wind up here. */
-				curarg->desttype = 1;
-				curarg->value = addr;
+				curop->desttype = 1;
+				curop->value = (uint)(Mem1(addr));
+				addr++;
 				break;
 
 			case 11: /* locals, four-byte address */
-				addr = Mem4(pc);
-				pc += 4;
-				goto WrLocalsAddr;
+				curop->desttype = 2;
+				curop->value = Mem4(addr);
+				addr += 4;
+				break;
 
 			case 10: /* locals, two-byte address */
-				addr = (uint)Mem2(pc);
-				pc += 2;
-				goto WrLocalsAddr;
+				curop->desttype = 2;
+				curop->value = (uint)Mem2(addr);
+				addr += 2;
+				break;
 
 			case 9: /* locals, one-byte address */
-				addr = (uint)(Mem1(pc));
-				pc++;
-				/* fall through */
-
-WrLocalsAddr:
-				/* cases 9, 10, 11 all wind up here. It's illegal for addr to not
-				   be four-byte aligned, but we don't check this explicitly.
-				   A "strict mode" interpreter probably should. It's also illegal
-				   for addr to be less than zero or greater than the size of
-				   the locals segment. */
-				curarg->desttype = 2;
 				/* We don't add localsbase here; the store address for desttype 2
 				   is relative to the current locals segment, not an absolute
 				   stack position. */
-				curarg->value = addr;
+				curop->desttype = 2;
+				curop->value = (uint)(Mem1(addr));
+				addr++;
 				break;
 
 			case 1:
 			case 2:
 			case 3:
+				curop->value = 0;
 				fatal_error("Constant addressing mode in store operand.");
 				break;
 
 			default:
+				curop->value = 0;
 				fatal_error("Unknown addressing mode in store operand.");
 			}
 		}
 	}
+
+	inst->nextpc = addr;
+	inst->addr = instaddr;
+}
+
+const predecoded_inst_t *Glulx::predecode_instruction(uint addr) {
+	predecoded_inst_t *inst = &predecode_cache[addr % PREDECODE_CACHE_SIZE];
+	if (inst->addr != addr) {
+		decode_instruction(inst, addr);
+
+		/* An instruction running over the end of ROM could still change. */
+		if (inst->nextpc > ramstart)
+			inst->addr = 0;
+	}
+	return inst;
+}
+
+void Glulx::load_operands(oparg_t *args, const predecoded_inst_t *inst) {
+	int ix;
+	oparg_t *curarg;
+	const predecoded_operand_t *curop;
+	int numops = inst->oplist->num_ops;
+	int argsize = inst->oplist->arg_size;
+
+	for (ix = 0, curarg = args, curop = inst->operands; ix < numops; ix++, curarg++, curop++) {
+		uint addr = curop->value;
+
+		curarg->desttype = curop->desttype;
+
+		switch (curop->mode) {
+
+		case predecoded_Const:
+		case predecoded_Store:
+			curarg->value = curop->value;
+			break;
+
+		case predecoded_Pop:
+			if (stackptr < valstackbase + 4) {
+				fatal_error("Stack underflow in operand.");
+			}
+			stackptr -= 4;
+			curarg->value = Stk4(stackptr);
+			break;
+
+		case predecoded_Mem:
+			if (argsize == 4) {
+				curarg->value = Mem4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Mem2(addr);
+			} else {
+				curarg->value = Mem1(addr);
+			}
+			break;
+
+		case predecoded_Local:
+			addr += localsbase;
+			if (argsize == 4) {
+				curarg->value = Stk4(addr);
+			} else if (argsize == 2) {
+				curarg->value = Stk2(addr);
+			} else {
+				curarg->value = Stk1(addr);
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
 }
 
 void Glulx::store_operand(uint desttype, uint destaddr, uint storeval) {
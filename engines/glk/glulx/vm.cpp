@@ -115,6 +115,7 @@ void Glulx::finalize_vm() {
 		stack = nullptr;
 	}
 
+	final_operands();
 	final_serial();
 }
 
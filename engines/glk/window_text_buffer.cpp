@@ -129,14 +129,22 @@ void TextBufferWindow::reflow() {
 		return;
 
 	_lines[0]._len = _numChars;
+	s = _scrollMax < SCROLLBACK ? _scrollMax : SCROLLBACK - 1;
+
+	// size the temp buffers for the text there is, rather than for full lines
+	int numChars = 0, numPics = 0;
+	for (k = s; k >= 0; k--) {
+		numChars += _lines[k]._len + (_lines[k]._newLine ? 1 : 0);
+		numPics += (_lines[k]._lPic ? 1 : 0) + (_lines[k]._rPic ? 1 : 0);
+	}
 
 	// allocate temp buffers
-	Attributes *attrbuf = new Attributes[SCROLLBACK * TBLINELEN];
-	uint32 *charbuf = new uint32[SCROLLBACK * TBLINELEN];
-	int *alignbuf = new int[SCROLLBACK];
-	Picture **pictbuf = new Picture *[SCROLLBACK];
-	uint *hyperbuf = new uint[SCROLLBACK];
-	int *offsetbuf = new int[SCROLLBACK];
+	Attributes *attrbuf = new Attributes[numChars + 1];
+	uint32 *charbuf = new uint32[numChars + 1];
+	int *alignbuf = new int[numPics + 1];
+	Picture **pictbuf = new Picture *[numPics + 1];
+	uint *hyperbuf = new uint[numPics + 1];
+	int *offsetbuf = new int[numPics + 1];
 
 	if (!attrbuf || !charbuf || !alignbuf || !pictbuf || !hyperbuf || !offsetbuf) {
 		delete[] attrbuf;
@@ -155,7 +163,6 @@ void TextBufferWindow::reflow() {
 
 	x = 0;
 	p = 0;
-	s = _scrollMax < SCROLLBACK ? _scrollMax : SCROLLBACK - 1;
 
 	for (k = s; k >= 0; k--) {
 		if (k == 0 && _lineRequest)
@@ -1087,7 +1094,7 @@ void TextBufferWindow::redraw() {
 	 * draw the images
 	 */
 	for (i = 0; i < _scrollBack; i++) {
-		TextBufferRow ln(_lines[i]);
+		const TextBufferRow &ln = _lines[i];
 
 		y = y0 + (_height - (i - _scrollPos) - 1) * _font._leading;
 
@@ -1534,6 +1541,12 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 			|| _lastSeen > _scrollBack - 1)
 		scrollResize();
 
+	// once the scrollback is full, the oldest line is dropped
+	if (_scrollMax > _scrollBack - 1)
+		_scrollMax = _scrollBack - 1;
+	if (_lastSeen > _scrollBack - 1)
+		_lastSeen = _scrollBack - 1;
+
 	if (_lastSeen >= _height)
 		_scrollPos++;
 
@@ -1549,11 +1562,17 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 	_lines[0]._len = _numChars;
 	_lines[0]._newLine = forced;
 
-	for (int i = _scrollBack - 1; i > 0; i--) {
-		memcpy(&_lines[i], &_lines[i - 1], sizeof(TextBufferRow));
-		if (i < _height)
-			touch(i);
-	}
+	// the oldest row is reused as the new input row
+	TextBufferRow &oldest = _lines.rotate();
+	if (oldest._lPic)
+		oldest._lPic->decrement();
+	if (oldest._rPic)
+		oldest._rPic->decrement();
+	_chars = _lines[0]._chars;
+	_attrs = _lines[0]._attrs;
+
+	for (int i = 1; i < _height && i < _scrollBack; i++)
+		touch(i);
 
 	if (_radjn)
 		_radjn--;
@@ -1588,11 +1607,11 @@ void TextBufferWindow::scrollOneLine(bool forced) {
 void TextBufferWindow::scrollResize() {
 	int i;
 
-	_lines.clear();
-	_lines.resize(_scrollBack + SCROLLBACK);
+	// cap the scrollback memory, older lines get dropped from then on
+	if (_scrollBack + SCROLLBACK > SCROLLBACK_MAX)
+		return;
 
-	_chars = _lines[0]._chars;
-	_attrs = _lines[0]._attrs;
+	_lines.resize(_scrollBack + SCROLLBACK);
 
 	for (i = _scrollBack; i < (_scrollBack + SCROLLBACK); i++) {
 		_lines[i]._dirty = false;
@@ -1651,4 +1670,25 @@ TextBufferWindow::TextBufferRow::TextBufferRow() : _len(0), _newLine(0), _dirty(
 	Common::fill(&_chars[0], &_chars[TBLINELEN], 0);
 }
 
+void TextBufferWindow::TextBufferRows::resize(uint newSize) {
+	for (uint i = newSize; i < _rows.size(); ++i)
+		delete _rows[i];
+
+	uint oldSize = _rows.size();
+	_rows.resize(newSize);
+	for (uint i = oldSize; i < newSize; ++i)
+		_rows[i] = new TextBufferRow();
+}
+
+void TextBufferWindow::TextBufferRows::clear() {
+	resize(0);
+}
+
+TextBufferWindow::TextBufferRow &TextBufferWindow::TextBufferRows::rotate() {
+	TextBufferRow *oldest = _rows.back();
+	_rows.pop_back();
+	_rows.insert_at(0, oldest);
+	return *oldest;
+}
+
 } // End of namespace Glk
@@ -27,6 +27,7 @@
 #include "glk/speech.h"
 #include "glk/conf.h"
 #include "common/array.h"
+#include "common/noncopyable.h"
 #include "common/ustr.h"
 
 namespace Glk {
@@ -52,7 +53,45 @@ class TextBufferWindow : public TextWindow, Speech {
 		 */
 		TextBufferRow();
 	};
-	typedef Common::Array<TextBufferRow> TextBufferRows;
+
+	/**
+	 * The rows of the window, newest first. Each row is allocated on its
+	 * own, so scrolling moves pointers rather than whole rows
+	 */
+	class TextBufferRows : Common::NonCopyable {
+	private:
+		Common::Array<TextBufferRow *> _rows;
+	public:
+		~TextBufferRows() {
+			clear();
+		}
+
+		TextBufferRow &operator[](uint idx) {
+			return *_rows[idx];
+		}
+		const TextBufferRow &operator[](uint idx) const {
+			return *_rows[idx];
+		}
+
+		uint size() const {
+			return _rows.size();
+		}
+
+		/**
+		 * Change the number of rows. Existing rows are kept
+		 */
+		void resize(uint newSize);
+
+		/**
+		 * Free all rows
+		 */
+		void clear();
+
+		/**
+		 * Move the oldest row to the front, and return it
+		 */
+		TextBufferRow &rotate();
+	};
 private:
 	PropFontInfo &_font;
 private:
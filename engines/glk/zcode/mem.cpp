@@ -189,8 +189,10 @@ void Mem::restart_header(void) {
 }
 
 void Mem::storeb(zword addr, zbyte value) {
-	if (addr >= h_dynamic_size)
+	if (addr >= h_dynamic_size) {
 		runtimeError(ERR_STORE_RANGE);
+		staticMemoryChanged();
+	}
 
 	if (addr == H_FLAGS + 1) {
 		// flags register is modified
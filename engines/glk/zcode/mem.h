@@ -127,6 +127,11 @@ protected:
 	 */
 	virtual void flagsChanged(zbyte value) = 0;
 
+	/**
+	 * Called when a store to static memory went ahead despite the error
+	 */
+	virtual void staticMemoryChanged() = 0;
+
 	/**
 	 * Close the story file and deallocate memory.
 	 */
@@ -138,7 +138,8 @@ Processor::Processor(OSystem *syst, const GlkGameDescription &gameDesc) :
 		_randomInterval(0), _randomCtr(0), first_restart(true), script_valid(false),
 		_bufPos(0), _locked(false), _prevC('\0'), script_width(0),
 		sfp(nullptr), rfp(nullptr), pfp(nullptr), ostream_screen(true), ostream_script(false),
-		ostream_memory(false), ostream_record(false), istream_replay(false), message(false) {
+		ostream_memory(false), ostream_record(false), istream_replay(false), message(false),
+		_walkthrough(false), _walkthroughStart(0), _walkthroughCommands(0) {
 	static const Opcode OP0_OPCODES[16] = {
 		&Processor::z_rtrue,
 		&Processor::z_rfalse,
@@ -197,6 +198,22 @@ void Processor::initialize() {
 		op0_opcodes[9] = &Processor::z_catch;
 		op1_opcodes[15] = &Processor::z_call_n;
 	}
+
+	// Flatten the opcode tables for this version, so the handler of an
+	// instruction is a single lookup on its first byte
+	for (uint opcode = 0; opcode < 256; opcode++) {
+		if (opcode < 0x80)
+			_opcodes[opcode] = var_opcodes[opcode & 0x1f];
+		else if (opcode < 0xb0)
+			_opcodes[opcode] = op1_opcodes[opcode & 0x0f];
+		else if (opcode < 0xc0)
+			_opcodes[opcode] = op0_opcodes[opcode - 0xb0];
+		else
+			_opcodes[opcode] = var_opcodes[opcode - 0xc0];
+	}
+
+	for (uint i = 0; i < INSTRUCTION_CACHE_SIZE; i++)
+		_instructionCache[i]._pc = 0;
 }
 
 void Processor::load_operand(zbyte type) {
@@ -207,15 +224,7 @@ void Processor::load_operand(zbyte type) {
 		zbyte variable;
 
 		CODE_BYTE(variable);
-
-		if (variable == 0)
-			value = *_sp++;
-		else if (variable < 16)
-			value = *(_fp - variable);
-		else {
-			zword addr = h_globals + 2 * (variable - 16);
-			LOW_WORD(addr, value);
-		}
+		value = loadVariable(variable);
 	} else if (type & 1) {
 		// small constant
 		zbyte bvalue;
@@ -242,46 +251,126 @@ void Processor::load_all_operands(zbyte specifier) {
 	}
 }
 
-void Processor::interpret() {
-	do {
-		zbyte opcode;
-		CODE_BYTE(opcode);
-		zargc = 0;
+zword Processor::loadVariable(zbyte variable) {
+	zword value;
+
+	if (variable == 0)
+		value = *_sp++;
+	else if (variable < 16)
+		value = *(_fp - variable);
+	else {
+		zword addr = h_globals + 2 * (variable - 16);
+		LOW_WORD(addr, value);
+	}
 
-		if (opcode < 0x80) {
-			// 2OP opcodes
-			load_operand((zbyte)(opcode & 0x40) ? 2 : 1);
-			load_operand((zbyte)(opcode & 0x20) ? 2 : 1);
+	return value;
+}
+
+static void decodeOperand(const zbyte *&p, DecodedInstruction &insn, zbyte type) {
+	zword value;
 
-			(*this.*var_opcodes[opcode & 0x1f])();
+	if (type & 2) {
+		// variable
+		insn._variables |= 1 << insn._operandCount;
+		value = *p++;
+	} else if (type & 1) {
+		// small constant
+		value = *p++;
+	} else {
+		// large constant
+		value = READ_BE_UINT16(p);
+		p += 2;
+	}
 
-		} else if (opcode < 0xb0) {
-			// 1OP opcodes
-			load_operand((zbyte)(opcode >> 4));
+	insn._operands[insn._operandCount++] = value;
+}
 
-			(*this.*op1_opcodes[opcode & 0x0f])();
+static void decodeAllOperands(const zbyte *&p, DecodedInstruction &insn, zbyte specifier) {
+	for (int i = 6; i >= 0; i -= 2) {
+		zbyte type = (specifier >> i) & 0x03;
 
-		} else if (opcode < 0xc0) {
-			// 0OP opcodes
-			(*this.*op0_opcodes[opcode - 0xb0])();
+		if (type == 3)
+			break;
 
+		decodeOperand(p, insn, type);
+	}
+}
 
+void Processor::decodeInstruction(uint pc, DecodedInstruction &insn) {
+	const zbyte *p = zmp + pc;
+	zbyte opcode = *p++;
+
+	insn._operandCount = 0;
+	insn._variables = 0;
+	insn._handler = _opcodes[opcode];
+
+	if (opcode < 0x80) {
+		// 2OP opcodes
+		decodeOperand(p, insn, (opcode & 0x40) ? 2 : 1);
+		decodeOperand(p, insn, (opcode & 0x20) ? 2 : 1);
+
+	} else if (opcode < 0xb0) {
+		// 1OP opcodes
+		decodeOperand(p, insn, opcode >> 4);
+
+	} else if (opcode == 0xbe) {
+		// Extended opcodes, from 0x1e on reserved for future spec's
+		zbyte extOpcode = *p++;
+		zbyte specifier = *p++;
+		decodeAllOperands(p, insn, specifier);
+
+		insn._handler = (extOpcode < 0x1e) ? ext_opcodes[extOpcode] : &Processor::z_nop;
+
+	} else if (opcode >= 0xc0) {
+		// VAR opcodes; 0xec and 0xfa are call opcodes with up to 8 arguments
+		if (opcode == 0xec || opcode == 0xfa) {
+			zbyte specifier1 = *p++;
+			zbyte specifier2 = *p++;
+			decodeAllOperands(p, insn, specifier1);
+			decodeAllOperands(p, insn, specifier2);
 		} else {
-			// VAR opcodes
-			zbyte specifier1;
-			zbyte specifier2;
-
-			if (opcode == 0xec || opcode == 0xfa) {	// opcodes 0xec
-				CODE_BYTE(specifier1);			// and 0xfa are
-				CODE_BYTE(specifier2);          // call opcodes
-				load_all_operands(specifier1);	// with up to 8
-				load_all_operands(specifier2);	// arguments
-			} else {
-				CODE_BYTE(specifier1);
-				load_all_operands(specifier1);
-			}
+			zbyte specifier = *p++;
+			decodeAllOperands(p, insn, specifier);
+		}
+	}
+
+	insn._length = p - (zmp + pc);
+	insn._pc = pc;
+}
+
+void Processor::executeInstruction(const DecodedInstruction &insn) {
+	// The handler may overwrite the instruction's cache entry, so take
+	// everything it needs first
+	Opcode handler = insn._handler;
+
+	zargc = insn._operandCount;
+	for (int i = 0; i < zargc; i++)
+		zargs[i] = (insn._variables & (1 << i)) ? loadVariable(insn._operands[i]) : insn._operands[i];
 
-			(*this.*var_opcodes[opcode - 0xc0])();
+	SET_PC(insn._pc + insn._length);
+	(*this.*handler)();
+}
+
+void Processor::interpret() {
+	do {
+		uint pc;
+		GET_PC(pc);
+
+		if (pc >= h_dynamic_size) {
+			// Static memory can't change, so its instructions are only
+			// decoded the first time they're run. The cache is only valid
+			// for static memory: games may rewrite their dynamic memory,
+			// and so does restoring a savegame, so code there is always
+			// decoded again
+			DecodedInstruction &insn = _instructionCache[pc & (INSTRUCTION_CACHE_SIZE - 1)];
+			if (insn._pc != pc)
+				decodeInstruction(pc, insn);
+
+			executeInstruction(insn);
+		} else {
+			DecodedInstruction insn;
+			decodeInstruction(pc, insn);
+			executeInstruction(insn);
 		}
 
 #if defined(DJGPP) && defined(SOUND_SUPPORT)
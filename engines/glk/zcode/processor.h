@@ -31,6 +31,7 @@ namespace Glk {
 namespace ZCode {
 
 #define TEXT_BUFFER_SIZE 200
+#define INSTRUCTION_CACHE_SIZE 4096
 
 #define CODE_BYTE(v)	   v = codeByte()
 #define CODE_WORD(v)       v = codeWord()
@@ -46,6 +47,20 @@ class Processor;
 class Quetzal;
 typedef void (Processor::*Opcode)();
 
+/**
+ * An instruction whose opcode and operand bytes have been decoded. Variable
+ * operands hold the variable number, since their value is only known when
+ * the instruction is executed.
+ */
+struct DecodedInstruction {
+	uint _pc;				///< Address of the instruction, or 0 for an unused entry
+	Opcode _handler;		///< Handler of the opcode, extended opcodes included
+	zbyte _length;			///< Number of opcode and operand bytes
+	zbyte _operandCount;
+	zbyte _variables;		///< Bit n is set when operand n is a variable
+	zword _operands[8];
+};
+
 /**
  * Zcode processor
  */
@@ -57,6 +72,8 @@ private:
 	static Opcode ext_opcodes[64];
 	Common::Array<Opcode> op0_opcodes;
 	Common::Array<Opcode> op1_opcodes;
+	Opcode _opcodes[256];
+	DecodedInstruction _instructionCache[INSTRUCTION_CACHE_SIZE];
 
 	int _finished;
 	zword zargs[8];
@@ -93,6 +110,9 @@ private:
 	bool ostream_record;
 	bool istream_replay;
 	bool message;
+	bool _walkthrough;
+	uint32 _walkthroughStart;
+	uint _walkthroughCommands;
 	Common::FixedStack<Redirect, MAX_NESTING> _redirect;
 protected:
 	/**
@@ -111,6 +131,23 @@ protected:
 	 */
 	void load_all_operands(zbyte specifier);
 
+	/**
+	 * Return the value of a variable, popping the stack for variable 0.
+	 */
+	zword loadVariable(zbyte variable);
+
+	/**
+	 * Decode the opcode and operands of the instruction at the given address,
+	 * without moving the PC.
+	 */
+	void decodeInstruction(uint pc, DecodedInstruction &insn);
+
+	/**
+	 * Load the operands of a decoded instruction, move the PC past it and
+	 * call its handler.
+	 */
+	void executeInstruction(const DecodedInstruction &insn);
+
 	/**
 	 * Call a subroutine. Save PC and FP then load new PC and initialise
 	 * new stack frame. Note that the caller may legally provide less or
@@ -249,6 +286,12 @@ protected:
 	 */
 	void flagsChanged(zbyte value) override;
 
+	/**
+	 * Called when a store to static memory went ahead because errors are
+	 * being ignored. Drops the decoded instructions, which may be stale.
+	 */
+	void staticMemoryChanged() override;
+
 	/**
 	 * This function does the dirty work for z_save_undo.
 	 */
@@ -524,6 +567,12 @@ protected:
 	 */
 	void replay_open();
 
+	/**
+	 * Play back a walkthrough file of commands, then report how long it took
+	 * and quit. This allows the interpreter to be timed without a player.
+	 */
+	void replay_walkthrough(const Common::FSNode &node);
+
 	/**
 	 * Stop playback of commands.
 	 */
@@ -34,6 +34,11 @@ void Processor::flagsChanged(zbyte value) {
 	}
 }
 
+void Processor::staticMemoryChanged() {
+	for (uint i = 0; i < INSTRUCTION_CACHE_SIZE; i++)
+		_instructionCache[i]._pc = 0;
+}
+
 int Processor::save_undo() {
 	long diff_size;
 	zword stack_size;
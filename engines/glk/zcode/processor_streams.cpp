@@ -392,9 +392,30 @@ void Processor::replay_open() {
 		print_string("Cannot open file\n");
 }
 
+void Processor::replay_walkthrough(const Common::FSNode &node) {
+	Common::SeekableReadStream *rs = node.createReadStream();
+	if (!rs) {
+		warning("Could not open walkthrough %s", node.getPath().c_str());
+		return;
+	}
+
+	pfp = _streams->openStream(rs);
+	istream_replay = true;
+	_walkthrough = true;
+	_walkthroughStart = g_system->getMillis();
+	_walkthroughCommands = 0;
+}
+
 void Processor::replay_close() {
 	glk_stream_close(pfp);
 	istream_replay = false;
+
+	if (_walkthrough) {
+		debug("Played %u walkthrough commands in %u ms", _walkthroughCommands,
+			g_system->getMillis() - _walkthroughStart);
+		_walkthrough = false;
+		quitGame();
+	}
 }
 
 int Processor::replay_code() {
@@ -434,7 +455,9 @@ zchar Processor::replay_char() {
 			}
 		}
 
-		pfp->unputBuffer("\n", 1);
+		// Leave the newline for the caller to check, as file streams
+		// can't unput it
+		pfp->setPosition(pfp->getPosition() - 1, seekmode_Start);
 		return ZC_RETURN;
 
 	} else {
@@ -449,6 +472,7 @@ zchar Processor::replay_read_key() {
 		replay_close();
 		return ZC_BAD;
 	} else {
+		_walkthroughCommands++;
 		return key;
 	}
 }
@@ -471,6 +495,7 @@ zchar Processor::replay_read_input(zchar *buf) {
 		replay_close();
 		return ZC_BAD;
 	} else {
+		_walkthroughCommands++;
 		return c;
 	}
 }
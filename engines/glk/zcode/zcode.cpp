@@ -73,6 +73,10 @@ void ZCode::runGame() {
 			store(loadResult);
 	}
 
+	// Replay a walkthrough in place of the player, for timing the interpreter
+	if (ConfMan.hasKey("walkthrough"))
+		replay_walkthrough(Common::FSNode(ConfMan.get("walkthrough")));
+
 	// Game loop
 	interpret();
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/archive.h"
 #include "common/file.h"
 #include "common/substream.h"
 #include "common/memstream.h"
@@ -38,11 +39,9 @@ Common::SeekableReadStream *LabEntry::createReadStream() const {
 }
 
 Lab::Lab() {
-	_stream = nullptr;
 }
 
 Lab::~Lab() {
-	delete _stream;
 }
 
 bool Lab::open(const Common::String &filename, bool keepStream) {
@@ -50,8 +49,8 @@ bool Lab::open(const Common::String &filename, bool keepStream) {
 
 	bool result = true;
 
-	Common::File *file = new Common::File();
-	if (!file->open(filename) || file->readUint32BE() != MKTAG('L','A','B','N')) {
+	Common::SeekableReadStream *file = SearchMan.createReadStreamForMember(filename);
+	if (!file || file->readUint32BE() != MKTAG('L','A','B','N')) {
 		result = false;
 	} else {
 		file->readUint32LE(); // version
@@ -61,18 +60,26 @@ bool Lab::open(const Common::String &filename, bool keepStream) {
 		else
 			parseMonkey4FileTable(file);
 	}
+
+	if (result && dynamic_cast<Common::MemoryReadStream *>(file)) {
+		// The backend memory mapped the lab, so keep it and give out
+		// views of it instead of opening the file again for each member
+		_stream = Common::SharedPtr<Common::SeekableReadStream>(file);
+		return result;
+	}
+
 	if (result && keepStream) {
 		file->seek(0, SEEK_SET);
 		byte *data = static_cast<byte*>(malloc(sizeof(byte) * file->size()));
 		file->read(data, file->size());
-		_stream = new Common::MemoryReadStream(data, file->size(), DisposeAfterUse::YES);
+		_stream = Common::SharedPtr<Common::SeekableReadStream>(new Common::MemoryReadStream(data, file->size(), DisposeAfterUse::YES));
 	}
 	delete file;
 
 	return result;
 }
 
-void Lab::parseGrimFileTable(Common::File *file) {
+void Lab::parseGrimFileTable(Common::SeekableReadStream *file) {
 	uint32 entryCount = file->readUint32LE();
 	uint32 stringTableSize = file->readUint32LE();
 
@@ -102,7 +109,7 @@ void Lab::parseGrimFileTable(Common::File *file) {
 	delete[] stringTable;
 }
 
-void Lab::parseMonkey4FileTable(Common::File *file) {
+void Lab::parseMonkey4FileTable(Common::SeekableReadStream *file) {
 	uint32 entryCount = file->readUint32LE();
 	uint32 stringTableSize = file->readUint32LE();
 	uint32 stringTableOffset = file->readUint32LE() - 0x13d0f;
@@ -186,10 +193,8 @@ Common::SeekableReadStream *Lab::createReadStreamForMember(const Common::Path &p
 		file->open(_labFileName);
 		return new Common::SeekableSubReadStream(file, i->_offset, i->_offset + i->_len, DisposeAfterUse::YES);
 	} else {
-		byte *data = static_cast<byte*>(malloc(sizeof(byte) * i->_len));
-		_stream->seek(i->_offset, SEEK_SET);
-		_stream->read(data, i->_len);
-		return new Common::MemoryReadStream(data, i->_len, DisposeAfterUse::YES);
+		// Members of the in-memory lab are views, sharing its data
+		return Common::createSharedSubReadStream(_stream, i->_offset, i->_offset + i->_len);
 	}
 }
 
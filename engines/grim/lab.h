@@ -25,7 +25,7 @@
 #include "common/archive.h"
 
 namespace Common {
-	class File;
+	class SeekableReadStream;
 }
 
 namespace Grim {
@@ -55,14 +55,16 @@ public:
 	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override;
 
 private:
-	void parseGrimFileTable(Common::File *_f);
-	void parseMonkey4FileTable(Common::File *_f);
+	void parseGrimFileTable(Common::SeekableReadStream *_f);
+	void parseMonkey4FileTable(Common::SeekableReadStream *_f);
 
 	Common::String _labFileName;
 	typedef Common::SharedPtr<LabEntry> LabEntryPtr;
 	typedef Common::HashMap<Common::String, LabEntryPtr, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> LabMap;
 	LabMap _entries;
-	Common::SeekableReadStream *_stream;
+	// Set when the whole lab is in memory, either because it was cached or
+	// because the backend mapped the file. Members are then views of it.
+	Common::SharedPtr<Common::SeekableReadStream> _stream;
 };
 
 } // end of namespace Grim
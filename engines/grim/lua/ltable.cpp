@@ -56,7 +56,34 @@ static intptr hashindex(TObject *ref) {
 	return (h >= 0 ? h : -(h + 1));
 }
 
+/*
+** Strings are interned, so string keys are found by comparing the string
+** pointers, without going through luaO_equalObj for each probed node.
+** This is the most common case, e.g. for every field access.
+*/
+static int32 presentString(Hash *t, TaggedString *ts) {
+	int32 tsize = nhash(t);
+	intptr h = (intptr)ts;
+	if (h < 0)
+		h = -(h + 1);
+	int32 h1 = int32(h % tsize);
+	TObject *rf = ref(node(t, h1));
+	if (ttype(rf) != LUA_T_NIL && (ttype(rf) != LUA_T_STRING || tsvalue(rf) != ts)) {
+		int32 h2 = int32(h % (tsize - 2) + 1);
+		do {
+			h1 += h2;
+			if (h1 >= tsize)
+				h1 -= tsize;
+			rf = ref(node(t, h1));
+		} while (ttype(rf) != LUA_T_NIL && (ttype(rf) != LUA_T_STRING || tsvalue(rf) != ts));
+	}
+	return h1;
+}
+
 int32 present(Hash *t, TObject *key) {
+	if (ttype(key) == LUA_T_STRING)
+		return presentString(t, tsvalue(key));
+
 	int32 tsize = nhash(t);
 	intptr h = hashindex(key);
 	int32 h1 = int32(h % tsize);
@@ -48,6 +48,7 @@
 #include "common/algorithm.h"
 #include "common/zlib.h"
 #include "common/memstream.h"
+#include "common/substream.h"
 #include "common/file.h"
 #include "common/config-manager.h"
 #include "common/translation.h"
@@ -72,8 +73,9 @@ public:
 };
 
 ResourceLoader::ResourceLoader() {
-	_cacheDirty = false;
 	_cacheMemorySize = 0;
+	_cacheUses = 0;
+	memset(&_cacheStats, 0, sizeof(_cacheStats));
 
 	Lab *l;
 	Common::ArchiveMemberList files, updFiles;
@@ -227,11 +229,7 @@ void clearList(Common::List<T> &list) {
 }
 
 ResourceLoader::~ResourceLoader() {
-	for (Common::Array<ResourceCache>::iterator i = _cache.begin(); i != _cache.end(); ++i) {
-		ResourceCache &r = *i;
-		delete[] r.fname;
-		delete[] r.resPtr;
-	}
+	_cache.clear();
 	clearList(_models);
 	clearList(_colormaps);
 	clearList(_keyframeAnims);
@@ -239,32 +237,25 @@ ResourceLoader::~ResourceLoader() {
 	MD5Check::clear();
 }
 
-static int sortCallback(const void *entry1, const void *entry2) {
-	return scumm_stricmp(((const ResourceLoader::ResourceCache *)entry1)->fname, ((const ResourceLoader::ResourceCache *)entry2)->fname);
-}
-
 Common::SeekableReadStream *ResourceLoader::getFileFromCache(const Common::String &filename) const {
-	ResourceLoader::ResourceCache *entry = getEntryFromCache(filename);
-	if (!entry)
+	ResourceCacheMap::iterator entry = _cache.find(filename);
+	if (entry == _cache.end()) {
+		_cacheStats.misses++;
 		return nullptr;
+	}
 
-	return new Common::MemoryReadStream(entry->resPtr, entry->len);
+	_cacheStats.hits++;
+	entry->_value.lastUse = ++_cacheUses;
 
+	// A view of the cached data, which stays valid even if it gets evicted
+	return Common::createSharedSubReadStream(entry->_value.stream, 0, entry->_value.len);
 }
 
-ResourceLoader::ResourceCache *ResourceLoader::getEntryFromCache(const Common::String &filename) const {
-	if (_cache.empty())
-		return nullptr;
-
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
-
-	ResourceCache key;
-	key.fname = const_cast<char *>(filename.c_str());
-
-	return (ResourceLoader::ResourceCache *)bsearch(&key, _cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
+ResourceLoader::CacheStats ResourceLoader::getCacheStats() const {
+	CacheStats stats = _cacheStats;
+	stats.entries = _cache.size();
+	stats.memorySize = _cacheMemorySize;
+	return stats;
 }
 
 Common::SeekableReadStream *ResourceLoader::loadFile(const Common::String &filename) const {
@@ -290,11 +281,11 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(Common::String fna
 				return nullptr;
 
 			uint32 size = s->size();
-			byte *buf = new byte[size];
+			byte *buf = (byte *)malloc(size);
 			s->read(buf, size);
-			putIntoCache(fname, buf, size);
 			delete s;
-			s = new Common::MemoryReadStream(buf, size);
+			putIntoCache(fname, buf, size);
+			s = getFileFromCache(fname);
 		}
 	} else {
 		s = loadFile(fname);
@@ -304,14 +295,24 @@ Common::SeekableReadStream *ResourceLoader::openNewStreamFile(Common::String fna
 }
 
 void ResourceLoader::putIntoCache(const Common::String &fname, byte *res, uint32 len) const {
+	// Make room for the new file, dropping the least recently used ones
+	while (!_cache.empty() && _cacheMemorySize + len > kCacheMemoryBudget) {
+		ResourceCacheMap::iterator oldest = _cache.begin();
+		for (ResourceCacheMap::iterator i = _cache.begin(); i != _cache.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+		_cacheMemorySize -= oldest->_value.len;
+		_cache.erase(oldest);
+		_cacheStats.evictions++;
+	}
+
 	ResourceCache entry;
-	entry.resPtr = res;
+	entry.stream = Common::SharedPtr<Common::SeekableReadStream>(new Common::MemoryReadStream(res, len, DisposeAfterUse::YES));
 	entry.len = len;
-	entry.fname = new char[fname.size() + 1];
-	strcpy(entry.fname, fname.c_str());
+	entry.lastUse = ++_cacheUses;
 	_cacheMemorySize += len;
-	_cache.push_back(entry);
-	_cacheDirty = true;
+	_cache[fname] = entry;
 }
 
 CMap *ResourceLoader::loadColormap(const Common::String &filename) {
@@ -564,19 +565,10 @@ void ResourceLoader::uncache(const char *filename) const {
 	Common::String fname = filename;
 	fname.toLowercase();
 
-	if (_cacheDirty) {
-		qsort(_cache.begin(), _cache.size(), sizeof(ResourceCache), sortCallback);
-		_cacheDirty = false;
-	}
-
-	for (unsigned int i = 0; i < _cache.size(); i++) {
-		if (fname.compareTo(_cache[i].fname) == 0) {
-			delete[] _cache[i].fname;
-			_cacheMemorySize -= _cache[i].len;
-			delete[] _cache[i].resPtr;
-			_cache.remove_at(i);
-			_cacheDirty = true;
-		}
+	ResourceCacheMap::iterator entry = _cache.find(fname);
+	if (entry != _cache.end()) {
+		_cacheMemorySize -= entry->_value.len;
+		_cache.erase(entry);
 	}
 }
 
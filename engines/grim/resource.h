@@ -24,6 +24,9 @@
 
 #include "common/archive.h"
 #include "common/array.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/ptr.h"
 
 #include "engines/grim/object.h"
 
@@ -86,23 +89,41 @@ public:
 	void uncacheAnimationEmi(AnimationEmi *a);
 
 	struct ResourceCache {
-		char *fname;
-		byte *resPtr;
+		Common::SharedPtr<Common::SeekableReadStream> stream;
 		uint32 len;
+		uint32 lastUse;
 	};
 
+	struct CacheStats {
+		uint32 entries;
+		uint32 memorySize;
+		uint32 hits;
+		uint32 misses;
+		uint32 evictions;
+	};
+
+	/**
+	 * Memory used by the files cached by openNewStreamFile(). When it is
+	 * exceeded, the least recently used files are dropped. Streams still
+	 * reading a dropped file keep it alive until they are deleted.
+	 */
+	static const uint32 kCacheMemoryBudget = 32 * 1024 * 1024;
+
+	CacheStats getCacheStats() const;
+
 	static Common::String fixFilename(const Common::String &filename, bool append = true);
 
 private:
 	Common::SeekableReadStream *loadFile(const Common::String &filename) const;
 	Common::SeekableReadStream *getFileFromCache(const Common::String &filename) const;
-	ResourceLoader::ResourceCache *getEntryFromCache(const Common::String &filename) const;
 	void putIntoCache(const Common::String &fname, byte *res, uint32 len) const;
 	void uncache(const char *fname) const;
 
-	mutable Common::Array<ResourceCache> _cache;
-	mutable bool _cacheDirty;
-	mutable int32 _cacheMemorySize;
+	typedef Common::HashMap<Common::String, ResourceCache> ResourceCacheMap;
+	mutable ResourceCacheMap _cache;
+	mutable uint32 _cacheMemorySize;
+	mutable uint32 _cacheUses;
+	mutable CacheStats _cacheStats;
 
 	Common::List<EMIModel *> _emiModels;
 	Common::List<Model *> _models;
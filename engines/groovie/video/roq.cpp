@@ -124,6 +124,15 @@ ROQPlayer::~ROQPlayer() {
 	delete _restoreArea;
 }
 
+void ROQPlayer::copyToBuffer(Graphics::Surface *dst, const Graphics::Surface &src) {
+	// Reuse the existing buffer when possible, instead of reallocating it
+	if (dst->w == src.w && dst->h == src.h && dst->format == src.format) {
+		dst->copyRectToSurface(src, 0, 0, Common::Rect(src.w, src.h));
+	} else {
+		dst->copyFrom(src);
+	}
+}
+
 void ROQPlayer::setOrigin(int16 x, int16 y) {
 	_origX = x;
 	_origY = y;
@@ -371,6 +380,11 @@ void ROQPlayer::buildShowBuf() {
 	assert(destBuf->format == _overBuf->format);
 	assert(destBuf->format.bytesPerPixel == 4);
 
+	// Plain videos neither need the mask, the overlay nor the restore area,
+	// so they get a loop without any per pixel checks of the flags
+	const bool plainCopy = !_flagMasked && destBuf != _overBuf && !_alpha;
+	const int startPhase = startX % _scaleX;
+
 	for (int line = startY; line < stopY; line++) {
 		byte *in = (byte *)srcBuf->getBasePtr(MAX(0, -_origX) / _scaleX, (line - _origY) / _scaleY);
 		byte *inOvr = (byte *)_overBuf->getBasePtr(startX, line);
@@ -380,6 +394,29 @@ void ROQPlayer::buildShowBuf() {
 			mask = (byte *)maskBuf->getBasePtr(MAX(0, -_origX) / _scaleX, (line - _origY) / _scaleY);
 		}
 
+		// The source advances after each pixel with x % _scaleX == 0. Track
+		// that with a counter instead of a division per pixel.
+		int phase = startPhase;
+
+		if (plainCopy) {
+			if (_scaleX == 1) {
+				for (int x = startX; x < stopX; x++) {
+					copyPixelWithA(out, in);
+					out += 4;
+					in += 4;
+				}
+			} else {
+				for (int x = startX; x < stopX; x++) {
+					copyPixelWithA(out, in);
+					out += 4;
+					if (!phase)
+						in += 4;
+					if (++phase == _scaleX)
+						phase = 0;
+				}
+			}
+			continue;
+		}
 
 		for (int x = startX; x < stopX; x++) {
 			if (_flagMasked) {
@@ -402,8 +439,10 @@ void ROQPlayer::buildShowBuf() {
 			// Skip to the next pixel
 			out += _screen->format.bytesPerPixel;
 			inOvr += _screen->format.bytesPerPixel;
-			if (!(x % _scaleX))
+			if (!phase)
 				in += _screen->format.bytesPerPixel;
+			if (++phase == _scaleX)
+				phase = 0;
 			if (mask)
 				mask += _screen->format.bytesPerPixel;
 		}
@@ -421,7 +460,7 @@ void ROQPlayer::buildShowBuf() {
 
 	// On the first frame, copy from the current buffer to the prev buffer
 	if (_firstFrame) {
-		_prevBuf->copyFrom(*_currBuf);
+		copyToBuffer(_prevBuf, *_currBuf);
 		_firstFrame = false;
 	}
 
@@ -769,12 +808,7 @@ bool ROQPlayer::processBlockStill(ROQBlockHeader &blockHeader) {
 	Common::SeekableSubReadStream subStream(_file, startPos, startPos + blockHeader.size, DisposeAfterUse::NO);
 	jpg.loadStream(subStream);
 
-	const Graphics::Surface *srcSurf = jpg.getSurface();
-	_currBuf->free();
-	delete _currBuf;
-
-	_currBuf = new Graphics::Surface();
-	_currBuf->copyFrom(*srcSurf);
+	copyToBuffer(_currBuf, *jpg.getSurface());
 
 	_file->seek(startPos + blockHeader.size);
 	return true;
@@ -935,18 +969,25 @@ void ROQPlayer::paint8(byte i, int destx, int desty) {
 	}
 
 	byte *block4 = &_codebook4[i * 4];
+	const uint32 pitch = _currBuf->pitch / 4;
+	uint32 *dst = (uint32 *)_currBuf->getBasePtr(destx, desty);
+
+	// Build each upsampled row of the 8x8 block once and store it twice
 	for (int y4 = 0; y4 < 2; y4++) {
-		for (int x4 = 0; x4 < 2; x4++) {
-			uint32 *block2 = &_codebook2[*block4++ * 4];
-
-			for (int y2 = 0; y2 < 2; y2++) {
-				for (int x2 = 0; x2 < 2; x2++) {
-					uint32 *ptr = (uint32 *)_currBuf->getBasePtr(destx + x4 * 4 + x2 * 2, desty + y4 * 4 + y2 * 2);
-					uint32 pitch = _currBuf->pitch / 4;
-					uint32 color = *block2++;
-					ptr[0] = ptr[1] = ptr[pitch] = ptr[pitch + 1] = color;
-				}
-			}
+		const uint32 *left = &_codebook2[block4[0] * 4];
+		const uint32 *right = &_codebook2[block4[1] * 4];
+		block4 += 2;
+
+		for (int y2 = 0; y2 < 2; y2++) {
+			uint32 row[8];
+			row[0] = row[1] = left[y2 * 2];
+			row[2] = row[3] = left[y2 * 2 + 1];
+			row[4] = row[5] = right[y2 * 2];
+			row[6] = row[7] = right[y2 * 2 + 1];
+
+			memcpy(dst, row, sizeof(row));
+			memcpy(dst + pitch, row, sizeof(row));
+			dst += pitch * 2;
 		}
 	}
 }
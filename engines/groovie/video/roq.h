@@ -79,6 +79,7 @@ private:
 	void paint4(byte i, int destx, int desty);
 	void paint8(byte i, int destx, int desty);
 	void copy(byte size, int destx, int desty, int dx, int dy);
+	void copyToBuffer(Graphics::Surface *dst, const Graphics::Surface &src);
 
 	// Origin
 	int16 _origX, _origY;
@@ -266,6 +266,7 @@ public:
 	uint32 _flags;
 
 	char *getName() { return _name; }
+	Graphics::ManagedSurface *getSurface() { return &_surface; }
 private:
 	char _name[64];
 
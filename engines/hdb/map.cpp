@@ -51,6 +51,10 @@ Map::Map() {
 	_mapExpBarrels = nullptr;
 	_mapLaserBeams = nullptr;
 
+	_animatedTiles = nullptr;
+	_animatedTilesValid = false;
+	_chunkUseCount = 0;
+
 	_background = nullptr;
 	_foreground = nullptr;
 	_iconList = nullptr;
@@ -79,6 +83,7 @@ Map::~Map() {
 	free(_mapExplosions);
 	free(_mapExpBarrels);
 	free(_mapLaserBeams);
+	free(_animatedTiles);
 }
 
 void Map::save(Common::OutSaveFile *out) {
@@ -284,6 +289,11 @@ void Map::restartSystem() {
 	_mapExpBarrels = nullptr;
 	_mapLaserBeams = nullptr;
 
+	free(_animatedTiles);
+	_animatedTiles = nullptr;
+	_animatedTilesValid = false;
+	invalidateChunks();
+
 	// mark all in-memory tiles as being in memory, but able to be freed
 	g_hdb->_gfx->markTileCacheFreeable();
 	g_hdb->_gfx->markGfxCacheFreeable();
@@ -893,54 +903,53 @@ void Map::draw() {
 
 	_numForegrounds = _numGratings = 0;
 
+	updateAnimatedTiles();
+
+	// Draw the chunks under the visible tiles, unless the view reaches
+	// beyond the map
+	const int chunkX = _mapTileX / kMapChunkTiles;
+	const int chunkY = _mapTileY / kMapChunkTiles;
+	const int chunksX = (_mapTileX + maxTileX - 1) / kMapChunkTiles - chunkX + 1;
+	const int chunksY = (_mapTileY + maxTileY - 1) / kMapChunkTiles - chunkY + 1;
+	const bool useChunks = _mapTileX + maxTileX <= _width && _mapTileY + maxTileY <= _height && chunksX * chunksY <= kMaxMapChunks;
+	bool chunkCached[kMaxMapChunks];
+	memset(chunkCached, 0, sizeof(chunkCached));
+
+	if (useChunks) {
+		Graphics::ManagedSurface &screen = g_hdb->_gfx->_globalSurface;
+		Common::Rect drawArea(_mapTileXOff, _mapTileYOff, _mapTileXOff + maxTileX * kTileWidth, _mapTileYOff + maxTileY * kTileHeight);
+		drawArea.clip(screen.getBounds());
+
+		_chunkUseCount++;
+		for (int cy = 0; cy < chunksY; cy++) {
+			for (int cx = 0; cx < chunksX; cx++) {
+				MapChunk *chunk = getChunk(chunkX + cx, chunkY + cy);
+				if (!chunk->cached)
+					continue;
+				chunkCached[cy * chunksX + cx] = true;
+
+				Common::Rect clip(chunk->surface.getBounds());
+				clip.moveTo(_mapTileXOff + (chunk->x * kMapChunkTiles - _mapTileX) * kTileWidth,
+							_mapTileYOff + (chunk->y * kMapChunkTiles - _mapTileY) * kTileHeight);
+				Common::Point origin(clip.left, clip.top);
+				clip.clip(drawArea);
+				if (clip.isEmpty())
+					continue;
+
+				screen.blitFrom(chunk->surface, Common::Rect(clip.left - origin.x, clip.top - origin.y, clip.right - origin.x, clip.bottom - origin.y), Common::Point(clip.left, clip.top));
+				g_system->copyRectToScreen(screen.getBasePtr(clip.left, clip.top), screen.pitch, clip.left, clip.top, clip.width(), clip.height());
+			}
+		}
+	}
+
 	for (int j = 0; j < maxTileY; j++) {
 		int screenX = _mapTileXOff;
+		const int chunkRow = ((_mapTileY + j) / kMapChunkTiles - chunkY) * chunksX;
 		for (int i = 0; i < maxTileX; i++) {
+			int index = matrixY + _mapTileX + i;
+			bool cached = useChunks && chunkCached[chunkRow + (_mapTileX + i) / kMapChunkTiles - chunkX] && !_animatedTiles[index];
 
-			// Draw Background Tile
-			int16 tileIndex = _background[matrixY + _mapTileX + i];
-			if (tileIndex < 0) {
-				tileIndex = 0;
-			}
-
-			// Draw if not a sky tile
-			if (!g_hdb->_gfx->isSky(tileIndex)) {
-				Tile *tile = g_hdb->_gfx->getTile(tileIndex);
-				if (tile)
-					tile->draw(screenX, screenY);
-				else
-					warning("Cannot find tile with index %d at %d,%d", tileIndex, _mapTileX + i, _mapTileY + j);
-			}
-
-			// Draw Foreground Tile
-			tileIndex = _foreground[matrixY + _mapTileX + i];
-			if (tileIndex >= 0) {
-				Tile *fTile = g_hdb->_gfx->getTile(tileIndex);
-				if (fTile && !(fTile->_flags & kFlagInvisible)) {
-
-					if ((fTile->_flags & kFlagGrating) && (_numGratings < kMaxGratings)) {
-						// Check for Gratings Flag
-						_gratings[_numGratings].x = screenX;
-						_gratings[_numGratings].y = screenY;
-						_gratings[_numGratings].tile = tileIndex;
-						if (_numGratings < kMaxGratings)
-							_numGratings++;
-					} else if ((fTile->_flags & kFlagForeground)) {
-						// Check for Foregrounds Flag
-						_foregrounds[_numForegrounds].x = screenX;
-						_foregrounds[_numForegrounds].y = screenY;
-						_foregrounds[_numForegrounds].tile = tileIndex;
-						if (_numForegrounds < kMaxForegrounds)
-							_numForegrounds++;
-					} else {
-						if (fTile->_flags & kFlagMasked) {
-							fTile->drawMasked(screenX, screenY);
-						} else {
-							fTile->draw(screenX, screenY);
-						}
-					}
-				}
-			}
+			drawTile(index, screenX, screenY, cached);
 
 			screenX += kTileWidth;
 		}
@@ -987,6 +996,159 @@ void Map::draw() {
 	_animCycle++;
 }
 
+void Map::drawTile(int index, int screenX, int screenY, bool cached) {
+	// The background and plain foreground of cached tiles are in the chunks
+	if (!cached) {
+		// Draw Background Tile
+		int16 tileIndex = _background[index];
+		if (tileIndex < 0) {
+			tileIndex = 0;
+		}
+
+		// Draw if not a sky tile
+		if (!g_hdb->_gfx->isSky(tileIndex)) {
+			Tile *tile = g_hdb->_gfx->getTile(tileIndex);
+			if (tile)
+				tile->draw(screenX, screenY);
+			else
+				warning("Cannot find tile with index %d at %d,%d", tileIndex, index % _width, index / _width);
+		}
+	}
+
+	// Draw Foreground Tile
+	int16 tileIndex = _foreground[index];
+	if (tileIndex >= 0) {
+		Tile *fTile = g_hdb->_gfx->getTile(tileIndex);
+		if (fTile && !(fTile->_flags & kFlagInvisible)) {
+
+			if ((fTile->_flags & kFlagGrating) && (_numGratings < kMaxGratings)) {
+				// Check for Gratings Flag
+				_gratings[_numGratings].x = screenX;
+				_gratings[_numGratings].y = screenY;
+				_gratings[_numGratings].tile = tileIndex;
+				if (_numGratings < kMaxGratings)
+					_numGratings++;
+			} else if ((fTile->_flags & kFlagForeground)) {
+				// Check for Foregrounds Flag
+				_foregrounds[_numForegrounds].x = screenX;
+				_foregrounds[_numForegrounds].y = screenY;
+				_foregrounds[_numForegrounds].tile = tileIndex;
+				if (_numForegrounds < kMaxForegrounds)
+					_numForegrounds++;
+			} else if (!cached || (fTile->_flags & kFlagGrating)) {
+				// Gratings are never in the chunks
+				if (fTile->_flags & kFlagMasked) {
+					fTile->drawMasked(screenX, screenY);
+				} else {
+					fTile->draw(screenX, screenY);
+				}
+			}
+		}
+	}
+}
+
+void Map::updateAnimatedTiles() {
+	if (_animatedTilesValid)
+		return;
+
+	uint size = _width * _height;
+	free(_animatedTiles);
+	_animatedTiles = (byte *)calloc(size, 1);
+
+	const Common::Array<uint32> *lists[] = {
+		&_listBGAnimSlow, &_listBGAnimMedium, &_listBGAnimFast,
+		&_listFGAnimSlow, &_listFGAnimMedium, &_listFGAnimFast
+	};
+	for (int i = 0; i < ARRAYSIZE(lists); i++) {
+		for (Common::Array<uint32>::const_iterator it = lists[i]->begin(); it != lists[i]->end(); ++it) {
+			if (*it < size)
+				_animatedTiles[*it] = 1;
+		}
+	}
+
+	invalidateChunks();
+	_animatedTilesValid = true;
+}
+
+MapChunk *Map::getChunk(int x, int y) {
+	MapChunk *oldest = &_chunks[0];
+	for (int i = 0; i < kMaxMapChunks; i++) {
+		if (_chunks[i].x == x && _chunks[i].y == y) {
+			_chunks[i].lastUsed = _chunkUseCount;
+			return &_chunks[i];
+		}
+		if (_chunks[i].lastUsed < oldest->lastUsed)
+			oldest = &_chunks[i];
+	}
+
+	oldest->x = x;
+	oldest->y = y;
+	oldest->lastUsed = _chunkUseCount;
+	composeChunk(*oldest);
+	return oldest;
+}
+
+void Map::composeChunk(MapChunk &chunk) {
+	const int size = kMapChunkTiles * kTileWidth;
+	if (chunk.surface.w != size)
+		chunk.surface.create(size, size, g_hdb->_format);
+	chunk.surface.fillRect(Common::Rect(size, size), 0);
+	chunk.cached = false;
+
+	const int left = chunk.x * kMapChunkTiles;
+	const int top = chunk.y * kMapChunkTiles;
+	for (int y = top; y < MIN<int>(top + kMapChunkTiles, _height); y++) {
+		for (int x = left; x < MIN<int>(left + kMapChunkTiles, _width); x++) {
+			const int index = y * _width + x;
+			const Common::Point pos((x - left) * kTileWidth, (y - top) * kTileHeight);
+
+			// Sky tiles show what is behind the map, and missing tiles
+			// have to be reported, so those chunks are drawn tile by tile
+			int16 tileIndex = MAX<int16>(_background[index], 0);
+			if (g_hdb->_gfx->isSky(tileIndex))
+				return;
+			Tile *tile = g_hdb->_gfx->getTile(tileIndex);
+			if (!tile)
+				return;
+
+			if (_animatedTiles[index])
+				continue;
+
+			chunk.surface.blitFrom(*tile->getSurface(), pos);
+
+			tileIndex = _foreground[index];
+			if (tileIndex < 0)
+				continue;
+			Tile *fTile = g_hdb->_gfx->getTile(tileIndex);
+			if (!fTile || (fTile->_flags & (kFlagInvisible | kFlagGrating | kFlagForeground)))
+				continue;
+
+			if (fTile->_flags & kFlagMasked)
+				chunk.surface.transBlitFrom(*fTile->getSurface(), pos, 0xf81f, false, 0, 0xff);
+			else
+				chunk.surface.blitFrom(*fTile->getSurface(), pos);
+		}
+	}
+
+	chunk.cached = true;
+}
+
+void Map::invalidateChunk(int tileX, int tileY) {
+	for (int i = 0; i < kMaxMapChunks; i++) {
+		if (_chunks[i].x == tileX / kMapChunkTiles && _chunks[i].y == tileY / kMapChunkTiles) {
+			_chunks[i].x = _chunks[i].y = -1;
+			_chunks[i].lastUsed = 0;
+		}
+	}
+}
+
+void Map::invalidateChunks() {
+	for (int i = 0; i < kMaxMapChunks; i++) {
+		_chunks[i].x = _chunks[i].y = -1;
+		_chunks[i].lastUsed = 0;
+	}
+}
+
 void Map::drawEnts() {
 	g_hdb->_ai->drawEnts(_mapX, _mapY, g_hdb->_map->_screenXTiles * kTileWidth, g_hdb->_map->_screenYTiles * kTileHeight);
 }
@@ -1052,6 +1214,7 @@ void Map::setMapBGTileIndex(int x, int y, int index) {
 		return;
 
 	_background[y * _width + x] = index;
+	invalidateChunk(x, y);
 }
 
 void Map::setMapFGTileIndex(int x, int y, int index) {
@@ -1059,11 +1222,14 @@ void Map::setMapFGTileIndex(int x, int y, int index) {
 		return;
 
 	_foreground[y * _width + x] = index;
+	invalidateChunk(x, y);
 }
 
 void Map::addBGTileAnimation(int x, int y) {
 	int i = y * _width + x;
 
+	_animatedTilesValid = false;
+
 	Tile *tile = g_hdb->_gfx->getTile(_background[i]);
 	if (!tile)
 		return;
@@ -1084,6 +1250,8 @@ void Map::addFGTileAnimation(int x, int y) {
 
 	int i = y * _width + x;
 
+	_animatedTilesValid = false;
+
 	Tile *tile = g_hdb->_gfx->getTile(_foreground[i]);
 	if (!tile)
 		return;
@@ -1101,6 +1269,8 @@ void Map::addFGTileAnimation(int x, int y) {
 void Map::removeBGTileAnimation(int x, int y) {
 	uint idx = y * _width + x;
 
+	_animatedTilesValid = false;
+
 	for (uint i = 0; i < _listBGAnimFast.size(); i++) {
 		if (_listBGAnimFast[i] == idx) {
 			_listBGAnimFast.remove_at(i);
@@ -1126,6 +1296,8 @@ void Map::removeBGTileAnimation(int x, int y) {
 void Map::removeFGTileAnimation(int x, int y) {
 	uint idx = y * _width + x;
 
+	_animatedTilesValid = false;
+
 	for (uint i = 0; i < _listFGAnimFast.size(); i++) {
 		if (_listFGAnimFast[i] == idx) {
 			_listFGAnimFast.remove_at(i);
@@ -22,11 +22,15 @@
 #ifndef HDB_MAP_H
 #define HDB_MAP_H
 
+#include "graphics/managed_surface.h"
+
 namespace HDB {
 
 enum {
 	kMaxGratings = 250,
-	kMaxForegrounds = 250
+	kMaxForegrounds = 250,
+	kMapChunkTiles = 8,		// Width and height of a cached map chunk in tiles
+	kMaxMapChunks = 16
 };
 
 struct MSMIcon {
@@ -64,6 +68,19 @@ struct SeeThroughTile {
 	SeeThroughTile() : x(0), y(0), tile(0) {}
 };
 
+// The background of kMapChunkTiles x kMapChunkTiles map tiles, with the
+// foreground tiles which are drawn along with it. Animated tiles are left
+// out and drawn on top of it every frame.
+struct MapChunk {
+	int x;
+	int y;				// Chunk coordinates, x is -1 for an unused chunk
+	bool cached;		// False if the tiles have to be drawn one by one
+	uint32 lastUsed;
+	Graphics::ManagedSurface surface;
+
+	MapChunk() : x(-1), y(-1), cached(false), lastUsed(0) {}
+};
+
 class Map {
 public:
 	Map();
@@ -161,6 +178,13 @@ public:
 	Common::Array<uint32> _listFGAnimFast;
 
 private:
+	void drawTile(int index, int screenX, int screenY, bool cached);
+	void updateAnimatedTiles();
+	MapChunk *getChunk(int x, int y);
+	void composeChunk(MapChunk &chunk);
+	void invalidateChunk(int tileX, int tileY);
+	void invalidateChunks();
+
 	char _name[32];
 	uint32 _backgroundOffset;
 	uint32 _foregroundOffset;
@@ -177,6 +201,13 @@ private:
 	byte *_mapExpBarrels;
 	byte *_mapLaserBeams;
 
+	// Tiles on an animation list, which are not drawn into the chunks
+	byte *_animatedTiles;
+	bool _animatedTilesValid;
+
+	MapChunk _chunks[kMaxMapChunks];
+	uint32 _chunkUseCount;
+
 	bool _mapLoaded;
 };
 }
@@ -225,6 +225,14 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 
 	debugC(1, kHypnoDebugArcade, "Using frame delay: %d", arc->frameDelay);
 
+	// The next transition is opened ahead of time, so that it starts right
+	// away once the background reaches it
+	MVideo nextTransition("", Common::Point(0, 0), false, true, false);
+	if (!arc->transitionVideos.empty()) {
+		nextTransition.path = *arc->transitionVideos.begin();
+		loadVideo(nextTransition);
+	}
+
 	Common::Event event;
 	while (!shouldQuit()) {
 		needsUpdate = _background->decoder->needsUpdate();
@@ -331,13 +339,13 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 			transition = true;
 			_background->decoder->pauseVideo(true);
 
-			Filename transitionVideo = *arc->transitionVideos.begin();
 			Filename transitionPalette = *arc->transitionPalettes.begin();
 
-			debugC(1, kHypnoDebugArcade, "Playing transition %s", transitionVideo.c_str());
-			MVideo video(transitionVideo, Common::Point(0, 0), false, true, false);
+			debugC(1, kHypnoDebugArcade, "Playing transition %s", nextTransition.path.c_str());
 			disableCursor();
-			runIntro(video);
+			runIntro(nextTransition);
+			// runIntro plays a copy, which releases the decoder
+			nextTransition.decoder = nullptr;
 
 			if (!transitionPalette.empty())
 				currentPalette = transitionPalette;
@@ -351,6 +359,10 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 			arc->transitionVideos.pop_front();
 			arc->transitionPalettes.pop_front();
 			arc->transitionTimes.pop_front();
+			if (!arc->transitionVideos.empty()) {
+				nextTransition.path = *arc->transitionVideos.begin();
+				loadVideo(nextTransition);
+			}
 			if (!_music.empty())
 				playSound(_music, 0, arc->musicRate); // restore music
 		}
@@ -534,6 +546,9 @@ void HypnoEngine::runArcade(ArcadeShooting *arc) {
 		delete it->video;
 	}
 
+	if (nextTransition.decoder)
+		skipVideo(nextTransition);
+
 	if (_background->decoder) {
 		skipVideo(*_background);
 	}
@@ -479,7 +479,7 @@ void HypnoEngine::drawScreen() {
 
 // Video handling
 
-void HypnoEngine::playVideo(MVideo &video) {
+void HypnoEngine::loadVideo(MVideo &video) {
 	debugC(1, kHypnoDebugMedia, "%s(%s)", __FUNCTION__, video.path.c_str());
 	Common::File *file = new Common::File();
 	Common::String path = convertPath(video.path);
@@ -501,6 +501,13 @@ void HypnoEngine::playVideo(MVideo &video) {
 
 	if (!video.decoder->loadStream(file))
 		error("unable to load video %s", path.c_str());
+}
+
+void HypnoEngine::playVideo(MVideo &video) {
+	debugC(1, kHypnoDebugMedia, "%s(%s)", __FUNCTION__, video.path.c_str());
+	// Videos opened ahead of time with loadVideo only need to be started
+	if (!video.decoder || video.decoder->isPlaying() || video.decoder->getCurFrame() >= 0)
+		loadVideo(video);
 
 	debugC(1, kHypnoDebugMedia, "audio track count: %d", video.decoder->getAudioTrackCount());
 	video.decoder->start();
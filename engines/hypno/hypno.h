@@ -134,6 +134,7 @@ public:
 
 	Common::String _prefixDir;
 	Common::String convertPath(const Common::String &);
+	void loadVideo(MVideo &video);
 	void playVideo(MVideo &video);
 	void skipVideo(MVideo &video);
 
@@ -67,16 +67,18 @@ bool LibFile::open(const Common::String &prefix, const Common::String &filename,
 			uint32 pos = libfile.pos();
 			libfile.seek(start);
 
-			for (uint32 i = 0; i < size; i++) {
-				b = libfile.readByte();
-				if (encrypted && b != '\n')
-					b = b ^ 0xfe;
-				f.data.push_back(b);
-				//debugN("%c", b);
+			f.data.resize(size + 1);
+			libfile.read(f.data.data(), size);
+			if (encrypted) {
+				for (uint32 i = 0; i < size; i++)
+					if (f.data[i] != '\n')
+						f.data[i] ^= 0xfe;
 			}
-			f.data.push_back(0x0);
+			f.data[size] = 0x0;
 			debugC(1, kHypnoDebugParser, "start: %d, size: %d", start, f.data.size());
 			libfile.seek(pos);
+			if (!_fileIndex.contains(f.name))
+				_fileIndex[f.name] = _fileEntries.size();
 			_fileEntries.push_back(f);
 
 		};
@@ -87,16 +89,25 @@ bool LibFile::open(const Common::String &prefix, const Common::String &filename,
 
 const FileEntry *LibFile::getEntry(const Common::Path &path) const {
 	Common::String name = path.toString();
-	for (Common::Array<FileEntry>::const_iterator it = _fileEntries.begin(); it != _fileEntries.end(); ++it) {
-		if (((_prefix + it->name).equalsIgnoreCase(name)) || it->name.equalsIgnoreCase(name))
-			return it;
+	// Entries can be found by their own name, or prefixed with the archive
+	// prefix. The first entry matching either of them wins.
+	uint found = _fileEntries.size();
+	Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo>::const_iterator it = _fileIndex.find(name);
+	if (it != _fileIndex.end())
+		found = it->_value;
+
+	if (name.size() >= _prefix.size() && name.substr(0, _prefix.size()).equalsIgnoreCase(_prefix)) {
+		it = _fileIndex.find(name.substr(_prefix.size()));
+		if (it != _fileIndex.end() && it->_value < found)
+			found = it->_value;
 	}
 
-	return nullptr;
+	return (found < _fileEntries.size()) ? &_fileEntries[found] : nullptr;
 }
 
 void LibFile::close() {
 	_fileEntries.clear();
+	_fileIndex.clear();
 }
 
 bool LibFile::hasFile(const Common::Path &path) const {
@@ -25,6 +25,7 @@
 #include "common/archive.h"
 #include "common/array.h"
 #include "common/file.h"
+#include "common/hashmap.h"
 #include "common/memstream.h"
 #include "common/stream.h"
 
@@ -53,6 +54,8 @@ public:
 private:
 	Common::String _prefix;
 	Common::Array<FileEntry> _fileEntries;
+	/** Index of the first entry for each file name */
+	Common::HashMap<Common::String, uint, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> _fileIndex;
 	const FileEntry *getEntry(const Common::Path &path) const;
 };
 
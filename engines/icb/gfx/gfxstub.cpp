@@ -61,6 +61,10 @@ int32 nearClip = 0;
 int32 minUsedZpos = 20000;
 int32 maxUsedZpos = 0;
 
+// Only this range of the OT list needs to be drawn and cleared again
+int32 minUsedOTpos = OT_SIZE;
+int32 maxUsedOTpos = -1;
+
 int32 g_otz_shift = 0; // 1cm accuracy
 int32 g_otz_offset;
 
@@ -82,6 +86,8 @@ void InitDrawing(void) {
 	drawot = otarray[drawBuf];
 
 	CLEAROTLIST(drawot, OT_SIZE);
+	minUsedOTpos = OT_SIZE;
+	maxUsedOTpos = -1;
 	minZOTpos = 5;
 	maxZOTpos = OT_SIZE - 5;
 	nearClip = 0;
@@ -92,16 +98,35 @@ void InitDrawing(void) {
 	g_otz_offset = ((nearClip >> g_otz_shift) - minZOTpos);
 }
 
+// Relink the used part of the OT list, the other entries are still linked
+static void clearUsedOTList(void) {
+#ifdef REVERSE_OT
+	if (minUsedOTpos <= maxUsedOTpos)
+		ClearOTagRRange(drawot, minUsedOTpos, maxUsedOTpos);
+#else
+	CLEAROTLIST(drawot, OT_SIZE);
+#endif
+
+	minUsedOTpos = OT_SIZE;
+	maxUsedOTpos = -1;
+}
+
 void drawOTList(void) {
 	startDrawing();
+#ifdef REVERSE_OT
+	// The entries above the last used one just link down to it, so start
+	// there instead of walking the whole list
+	DrawOTag(drawot + MAX<int32>(maxUsedOTpos, 0));
+#else
 	DrawOTag(drawot + OT_FIRST);
+#endif
 	endDrawing();
-	CLEAROTLIST(drawot, OT_SIZE);
+	clearUsedOTList();
 }
 
 void recoverFromOTcrash(void) {
 	endDrawing();
-	CLEAROTLIST(drawot, OT_SIZE);
+	clearUsedOTList();
 }
 
 void ResetZRange(void) {
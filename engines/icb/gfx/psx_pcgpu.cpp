@@ -119,12 +119,22 @@ OT_tag *ClearOTagR(OT_tag *ot, uint32 size) {
 	return ot;
 }
 
+// Relink the OT tags first..last of a reverse OT, whose other tags are
+// still linked from the last clear
+void ClearOTagRRange(OT_tag *ot, uint32 first, uint32 last) {
+	for (uint32 i = first; i <= last; i++) {
+		ot[i].addr = i ? (void *)&ot[i - 1] : UNLINKED_ADDR;
+		ot[i].len = UNLINKED_LEN;
+	}
+}
+
 // Setup the linked list for the OT tags from front to back
 OT_tag *ClearOTag(OT_tag *ot, uint32 size) {
 	uint32 i = 0;
 	while (i < (size - 1)) {
 		ot[i].addr = (void *)&ot[i + 1];
 		ot[i].len = UNLINKED_LEN;
+		i++;
 	}
 	ot[size - 1].addr = UNLINKED_ADDR;
 	ot[size - 1].len = UNLINKED_LEN;
@@ -620,6 +620,7 @@ typedef struct {
 extern int32 LoadImage(RECT16 *rect, uint32 *p);
 extern OT_tag *ClearOTag(OT_tag *ot, uint32 n);
 extern OT_tag *ClearOTagR(OT_tag *ot, uint32 n);
+extern void ClearOTagRRange(OT_tag *ot, uint32 first, uint32 last);
 extern void DrawOTag(OT_tag *p);
 extern void DrawPrim(void *p);
 
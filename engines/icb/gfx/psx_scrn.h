@@ -113,6 +113,10 @@ extern int32 minUsedZpos;
 extern int32 maxUsedZpos;
 extern int32 nearClip;
 
+// The range of OT positions primitives were added to since the OT was cleared
+extern int32 minUsedOTpos;
+extern int32 maxUsedOTpos;
+
 #if (_PSX_ON_PC == 0) && (_PSX == 1)
 
 // Number of GPU packets to reserve
@@ -222,6 +226,9 @@ static inline int32 myAddPrimClip(int32 z0, void *primitive) {
 	if (otpos == -1)
 		return -1; // ignore out of clipping range
 
+	minUsedOTpos = MIN(otpos, minUsedOTpos);
+	maxUsedOTpos = MAX(otpos, maxUsedOTpos);
+
 #if (_PSX_ON_PC == 1) || (_PSX == 0)
 	z0 = z0 >> 2; // Divide z by 4 so it matches background units
 	addPrimZUsr(drawot + otpos, primitive, z0, OTusrData);
@@ -2047,6 +2047,22 @@ int Screen::drawShapeSkipScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt)
 }
 
 void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
+	// Plain shapes are the most common case, so plot them directly
+	if (_dsPlot == &Screen::drawShapePlotType0) {
+		do {
+			uint8 c = *src++;
+			if (c) {
+				*dst++ = c;
+				cnt--;
+			} else {
+				c = *src++;
+				dst += c;
+				cnt -= c;
+			}
+		} while (cnt > 0);
+		return;
+	}
+
 	do {
 		uint8 c = *src++;
 		if (c) {
@@ -2062,6 +2078,22 @@ void Screen::drawShapeProcessLineNoScaleUpwind(uint8 *&dst, const uint8 *&src, i
 }
 
 void Screen::drawShapeProcessLineNoScaleDownwind(uint8 *&dst, const uint8 *&src, int &cnt, int16) {
+	// Plain shapes are the most common case, so plot them directly
+	if (_dsPlot == &Screen::drawShapePlotType0) {
+		do {
+			uint8 c = *src++;
+			if (c) {
+				*dst-- = c;
+				cnt--;
+			} else {
+				c = *src++;
+				dst -= c;
+				cnt -= c;
+			}
+		} while (cnt > 0);
+		return;
+	}
+
 	do {
 		uint8 c = *src++;
 		if (c) {
@@ -3474,11 +3506,21 @@ void Screen::addDirtyRect(int x, int y, int w, int h) {
 			return;
 
 		// Conversely, if we find rectangles which are contained in
-		// the new one, we can remove them
-		if (r.contains(*it))
+		// the new one, we can remove them. The same goes for rectangles
+		// overlapping the new one, or close enough that copying their
+		// union costs no more than copying both. Since the grown
+		// rectangle might now reach others, the search starts again.
+		Common::Rect merged(r);
+		merged.extend(*it);
+		if (r.contains(*it)) {
 			it = _dirtyRects.erase(it);
-		else
+		} else if (r.intersects(*it) || merged.width() * merged.height() <= r.width() * r.height() + it->width() * it->height() + kDirtyRectMergeCost) {
+			r = merged;
+			_dirtyRects.erase(it);
+			it = _dirtyRects.begin();
+		} else {
 			++it;
+		}
 	}
 
 	// If we got here, we can safely add r to the list of dirty rects.
@@ -817,7 +817,9 @@ protected:
 	virtual void postProcessCursor(uint8 *data, int w, int h, int pitch) {}
 
 	enum {
-		kMaxDirtyRects = 50
+		kMaxDirtyRects = 50,
+		// Extra pixels a merged dirty rect may cover compared to two separate ones
+		kDirtyRectMergeCost = 16 * 16
 	};
 
 	bool _forceFullUpdate;
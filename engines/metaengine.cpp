@@ -25,6 +25,8 @@
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/standard-actions.h"
 
+#include "common/hashmap.h"
+#include "common/hash-str.h"
 #include "common/savefile.h"
 #include "common/system.h"
 #include "common/translation.h"
@@ -258,6 +260,14 @@ WARN_UNUSED_RESULT bool MetaEngine::readSavegameHeader(Common::InSaveFile *in, E
 		return false;
 	}
 
+	in->seek(oldPos, SEEK_SET);
+
+	return readSavegameHeaderAt(in, headerOffset, header, skipThumbnail);
+}
+
+WARN_UNUSED_RESULT bool MetaEngine::readSavegameHeaderAt(Common::InSaveFile *in, uint32 headerOffset, ExtendedSavegameHeader *header, bool skipThumbnail) {
+	uint oldPos = in->pos();
+
 	in->seek(headerOffset, SEEK_SET);
 
 	in->read(header->id, 6);
@@ -302,6 +312,113 @@ WARN_UNUSED_RESULT bool MetaEngine::readSavegameHeader(Common::InSaveFile *in, E
 }
 
 
+//////////////////////////////////////////////
+// Save index
+//////////////////////////////////////////////
+
+#define SAVEINDEX_VERSION 1
+
+namespace {
+
+/**
+ * Where the extended header of a save file starts, as long as its size and
+ * modification time match. Finding the header otherwise means reading the
+ * end of the file first, which for a compressed save means decompressing
+ * all of it before going back to the header.
+ */
+struct SaveIndexEntry {
+	int64 fileSize;
+	int64 modificationTime;
+	uint32 headerOffset;
+
+	SaveIndexEntry() : fileSize(0), modificationTime(0), headerOffset(0) {}
+};
+
+/** The save index of a target, by save file name. */
+typedef Common::HashMap<Common::String, SaveIndexEntry> SaveIndex;
+
+/**
+ * Return the name of the save file which stores the save index of
+ * @p target. It does not match the save file patterns of the engines.
+ */
+Common::String getSaveIndexFileName(const char *target) {
+	return Common::String(target) + ".saveindex";
+}
+
+Common::String readIndexString(Common::SeekableReadStream &stream) {
+	uint32 len = stream.readUint32LE();
+	if (stream.err() || len > (uint32)(stream.size() - stream.pos()))
+		return Common::String();
+
+	char *buf = new char[len];
+	stream.read(buf, len);
+	Common::String str(buf, len);
+	delete[] buf;
+	return str;
+}
+
+void writeIndexString(Common::WriteStream &stream, const Common::String &str) {
+	stream.writeUint32LE(str.size());
+	stream.write(str.c_str(), str.size());
+}
+
+void loadSaveIndex(const char *target, SaveIndex &index) {
+	Common::ScopedPtr<Common::InSaveFile> stream(g_system->getSavefileManager()->openForLoading(getSaveIndexFileName(target)));
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != MKTAG('S', 'I', 'D', 'X') || stream->readUint32LE() != SAVEINDEX_VERSION)
+		return;
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count && !stream->err(); i++) {
+		Common::String filename = readIndexString(*stream);
+		SaveIndexEntry entry;
+		entry.fileSize = stream->readSint64LE();
+		entry.modificationTime = stream->readSint64LE();
+		entry.headerOffset = stream->readUint32LE();
+
+		if (!stream->err() && !stream->eos())
+			index.setVal(filename, entry);
+	}
+}
+
+void writeSaveIndex(const char *target, const SaveIndex &index) {
+	Common::ScopedPtr<Common::OutSaveFile> stream(g_system->getSavefileManager()->openForSaving(getSaveIndexFileName(target), false));
+	if (!stream)
+		return;
+
+	stream->writeUint32BE(MKTAG('S', 'I', 'D', 'X'));
+	stream->writeUint32LE(SAVEINDEX_VERSION);
+	stream->writeUint32LE(index.size());
+	for (SaveIndex::const_iterator i = index.begin(); i != index.end(); ++i) {
+		writeIndexString(*stream, i->_key);
+		stream->writeSint64LE(i->_value.fileSize);
+		stream->writeSint64LE(i->_value.modificationTime);
+		stream->writeUint32LE(i->_value.headerOffset);
+	}
+
+	stream->finalize();
+}
+
+/**
+ * Find where the extended header of a save file starts, the same way
+ * readSavegameHeader() does.
+ *
+ * @return The offset of the header, or 0 if there is none.
+ */
+uint32 findSavegameHeader(Common::InSaveFile *in) {
+	in->seek(-4, SEEK_END);
+	uint32 headerOffset = in->readUint32LE();
+	if (in->err() || headerOffset >= (uint32)in->pos())
+		headerOffset = 0;
+
+	in->seek(0, SEEK_SET);
+	return headerOffset;
+}
+
+} // End of anonymous namespace
+
 //////////////////////////////////////////////
 // MetaEngine default implementations
 //////////////////////////////////////////////
@@ -405,13 +522,37 @@ SaveStateDescriptor MetaEngine::querySaveMetaInfos(const char *target, int slot)
 	if (!hasFeature(kSavesUseExtendedFormat))
 		return SaveStateDescriptor();
 
-	Common::ScopedPtr<Common::InSaveFile> f(g_system->getSavefileManager()->openForLoading(
-		getSavegameFile(slot, target)));
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+	const Common::String filename = getSavegameFile(slot, target);
+
+	Common::ScopedPtr<Common::InSaveFile> f(saveFileMan->openForLoading(filename));
 
 	if (f) {
+		// Take the header offset from the save index, if the save did not
+		// change since it was indexed. Save file managers which cannot
+		// report file information do without the index.
+		SaveIndexEntry stats;
+		const bool haveStats = saveFileMan->getSavefileStats(filename, stats.fileSize, stats.modificationTime);
+		SaveIndex index;
+		uint32 headerOffset = 0;
+		if (haveStats) {
+			loadSaveIndex(target, index);
+			SaveIndex::const_iterator indexed = index.find(filename);
+			if (indexed != index.end() && indexed->_value.fileSize == stats.fileSize && indexed->_value.modificationTime == stats.modificationTime)
+				headerOffset = indexed->_value.headerOffset;
+		}
+
 		ExtendedSavegameHeader header;
-		if (!readSavegameHeader(f.get(), &header, false)) {
-			return SaveStateDescriptor();
+		if (!headerOffset || !readSavegameHeaderAt(f.get(), headerOffset, &header, false)) {
+			headerOffset = findSavegameHeader(f.get());
+			if (!headerOffset || !readSavegameHeaderAt(f.get(), headerOffset, &header, false))
+				return SaveStateDescriptor();
+
+			if (haveStats) {
+				stats.headerOffset = headerOffset;
+				index.setVal(filename, stats);
+				writeSaveIndex(target, index);
+			}
 		}
 
 		// Create the return descriptor
@@ -26,6 +26,7 @@
 #include "common/scummsys.h"
 #include "common/error.h"
 #include "common/array.h"
+#include "common/hash-str.h"
 
 #include "engines/game.h"
 #include "engines/savestate.h"
@@ -563,6 +564,11 @@ public:
 	 * Read the extended savegame header from the given savegame file.
 	 */
 	WARN_UNUSED_RESULT static bool readSavegameHeader(Common::InSaveFile *in, ExtendedSavegameHeader *header, bool skipThumbnail = true);
+	/**
+	 * Read the extended savegame header starting at @p headerOffset in the
+	 * given savegame file.
+	 */
+	WARN_UNUSED_RESULT static bool readSavegameHeaderAt(Common::InSaveFile *in, uint32 headerOffset, ExtendedSavegameHeader *header, bool skipThumbnail = true);
 };
 
 /**
@@ -570,6 +576,11 @@ public:
  */
 class EngineManager : public Common::Singleton<EngineManager> {
 public:
+	/** Milliseconds spent in detection, per engine ID. */
+	typedef Common::HashMap<Common::String, uint32> DetectionProfile;
+
+	EngineManager() : _profileDetection(false) {}
+
 	/**
 	 * Given a list of FSNodes in a given directory, detect a set of games contained within.
 	 *
@@ -577,6 +588,15 @@ public:
 	 */
 	DetectionResults detectGames(const Common::FSList &fslist);
 
+	/**
+	 * Start or stop measuring the time each engine spends in detectGames().
+	 * Starting clears the previous measurements.
+	 */
+	void setDetectionProfiling(bool enable);
+
+	/** Get the measurements collected since profiling was started. */
+	const DetectionProfile &getDetectionProfile() const { return _detectionProfile; }
+
 	/** Find a plugin by its engine ID. */
 	const Plugin *findPlugin(const Common::String &engineId) const;
 
@@ -617,6 +637,9 @@ private:
 
 	/** Use heuristics to complete a target lacking an engine ID. */
 	void upgradeTargetForEngineId(const Common::String &target) const;
+
+	bool _profileDetection;
+	DetectionProfile _detectionProfile;
 };
 
 /** Convenience shortcut for accessing the engine manager. */
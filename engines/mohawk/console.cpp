@@ -414,6 +414,7 @@ bool RivenConsole::Cmd_ChangeCard(int argc, const char **argv) {
 
 bool RivenConsole::Cmd_CurCard(int argc, const char **argv) {
 	debugPrintf("Current Card: %d\n", _vm->getCard()->getId());
+	debugPrintf("Entered in %d ms\n", _vm->getCardChangeTime());
 
 	return true;
 }
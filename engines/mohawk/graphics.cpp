@@ -67,7 +67,7 @@ void MohawkSurface::convertToTrueColor() {
 	_surface = surface;
 }
 
-GraphicsManager::GraphicsManager() {
+GraphicsManager::GraphicsManager() : _cacheUses(0) {
 }
 
 GraphicsManager::~GraphicsManager() {
@@ -84,17 +84,42 @@ void GraphicsManager::clearCache() {
 	}
 
 	_cache.clear();
+	_cacheLastUse.clear();
 	_subImageCache.clear();
 }
 
+void GraphicsManager::trimCache(uint32 maxSize) {
+	uint32 size = 0;
+	for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+		Graphics::Surface *surface = it->_value->getSurface();
+		if (surface)
+			size += surface->pitch * surface->h;
+	}
+
+	while (size > maxSize && !_cache.empty()) {
+		uint16 oldest = _cache.begin()->_key;
+		for (Common::HashMap<uint16, MohawkSurface *>::iterator it = _cache.begin(); it != _cache.end(); it++) {
+			if (_cacheLastUse[it->_key] < _cacheLastUse[oldest])
+				oldest = it->_key;
+		}
+
+		Graphics::Surface *surface = _cache[oldest]->getSurface();
+		if (surface)
+			size -= surface->pitch * surface->h;
+
+		delete _cache[oldest];
+		_cache.erase(oldest);
+		_cacheLastUse.erase(oldest);
+	}
+}
+
 MohawkSurface *GraphicsManager::findImage(uint16 id) {
 	if (!_cache.contains(id))
 		_cache[id] = decodeImage(id);
 
-	// TODO: Probably would be nice to limit the size of the cache
-	// Currently, this can't get large because it is freed on every
-	// card/stack change in Myst/Riven so I'm not worried about it.
-	// Doesn't mean this shouldn't be done in the future.
+	// The cache is freed on every stack change, and on every card change
+	// in Myst. Riven trims it to a fixed size on card changes instead.
+	_cacheLastUse[id] = ++_cacheUses;
 
 	return _cache[id];
 }
@@ -227,6 +252,7 @@ void GraphicsManager::addImageToCache(uint16 id, MohawkSurface *surface) {
 		error("Image %d already in cache", id);
 
 	_cache[id] = surface;
+	_cacheLastUse[id] = ++_cacheUses;
 }
 
 } // End of namespace Mohawk
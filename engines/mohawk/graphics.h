@@ -73,6 +73,10 @@ public:
 	// Free all surfaces in the cache
 	void clearCache();
 
+	// Free the least recently used surfaces, until the ones left
+	// in the cache use at most maxSize bytes
+	void trimCache(uint32 maxSize);
+
 	// findImage will search the cache to find the image.
 	// If not found, it will call decodeImage to get a new one.
 	MohawkSurface *findImage(uint16 id);
@@ -98,6 +102,8 @@ protected:
 private:
 	// An image cache that stores images until clearCache() is called
 	Common::HashMap<uint16, MohawkSurface *> _cache;
+	Common::HashMap<uint16, uint32> _cacheLastUse;
+	uint32 _cacheUses;
 	Common::HashMap<uint16, Common::Array<MohawkSurface *> > _subImageCache;
 };
 
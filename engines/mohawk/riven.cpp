@@ -78,6 +78,7 @@ MohawkEngine_Riven::MohawkEngine_Riven(OSystem *syst, const MohawkGameDescriptio
 	_card = nullptr;
 	_inventory = nullptr;
 	_lastSaveTime = 0;
+	_cardChangeTime = 0;
 	_currentLanguage = getLanguage();
 
 	_menuSavedCard = -1;
@@ -579,6 +580,10 @@ RivenStack *MohawkEngine_Riven::constructStackById(uint16 id) {
 	}
 }
 
+// Size of the decoded images kept across card changes, about 30 full
+// screen backgrounds
+static const uint32 kImageCacheSize = 32 * 1024 * 1024;
+
 // Riven uses some hacks to change stacks for linking books
 // Otherwise, script command 27 changes stacks
 struct RivenSpecialChange {
@@ -607,9 +612,12 @@ static const RivenSpecialChange rivenSpecialChange[] = {
 void MohawkEngine_Riven::changeToCard(uint16 dest) {
 	debug (1, "Changing to card %d", dest);
 
-	// Clear the graphics cache (images typically aren't used
-	// on different cards).
-	_gfx->clearCache();
+	uint32 startTime = _system->getMillis();
+
+	// Keep the most recently used images when changing cards. The player
+	// often goes back to the card they just left, for example when turning
+	// around, and decoding the card images again makes it stutter.
+	_gfx->trimCache(kImageCacheSize);
 
 	if (!isGameVariant(GF_DEMO)) {
 		for (byte i = 0; i < ARRAYSIZE(rivenSpecialChange); i++)
@@ -635,6 +643,9 @@ void MohawkEngine_Riven::changeToCard(uint16 dest) {
 
 	// Finally, install any hardcoded timer
 	_stack->installCardTimer();
+
+	_cardChangeTime = _system->getMillis() - startTime;
+	debug(1, "Entered card %d in %d ms", dest, _cardChangeTime);
 }
 
 Common::SeekableReadStream *MohawkEngine_Riven::getExtrasResource(uint32 tag, uint16 id) {
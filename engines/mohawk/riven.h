@@ -146,6 +146,7 @@ private:
 
 	bool _gameEnded;
 	uint32 _lastSaveTime;
+	uint32 _cardChangeTime;
 	Common::Language _currentLanguage;
 
 	// Variables
@@ -160,6 +161,7 @@ public:
 	void changeToStack(uint16 stackId);
 	void reloadCurrentCard();
 	RivenCard *getCard() const { return _card; }
+	uint32 getCardChangeTime() const { return _cardChangeTime; }
 	RivenStack *getStack() const { return _stack; }
 
 	// Hotspot functions/variables
@@ -279,6 +279,12 @@ public:
 		} else {
 			Graphics::Surface *screen = _system->lockScreen();
 
+			if (screen->format == _mainScreen->format && screen->format == _effectScreen->format) {
+				blendFrame(screen, elapsed * 256 / _duration);
+				_system->unlockScreen();
+				return false;
+			}
+
 			uint alpha = elapsed * 255 / _duration;
 			for (int y = 0; y < _mainScreen->h; y++) {
 				uint16 *src1 = (uint16 *) _mainScreen->getBasePtr(0, y);
@@ -305,6 +311,37 @@ public:
 			return false;
 		}
 	}
+
+private:
+	/**
+	 * Blend the two screens when they have the same pixel format as the
+	 * system screen. Each channel is blended in place using its mask, so
+	 * no color has to be converted to and from RGB.
+	 */
+	void blendFrame(Graphics::Surface *screen, uint alpha) {
+		const Graphics::PixelFormat &format = screen->format;
+		const uint32 rMask = (0xFF >> format.rLoss) << format.rShift;
+		const uint32 gMask = (0xFF >> format.gLoss) << format.gShift;
+		const uint32 bMask = (0xFF >> format.bLoss) << format.bShift;
+		const uint32 aMask = format.ARGBToColor(0xFF, 0, 0, 0);
+		const uint invAlpha = 256 - alpha;
+
+		for (int y = 0; y < _mainScreen->h; y++) {
+			const uint16 *src1 = (const uint16 *) _mainScreen->getBasePtr(0, y);
+			const uint16 *src2 = (const uint16 *) _effectScreen->getBasePtr(0, y);
+			uint16 *dst = (uint16 *) screen->getBasePtr(0, y);
+			for (int x = 0; x < _mainScreen->w; x++) {
+				const uint32 c1 = *src1++;
+				const uint32 c2 = *src2++;
+
+				uint32 r = (((c1 & rMask) * alpha + (c2 & rMask) * invAlpha) >> 8) & rMask;
+				uint32 g = (((c1 & gMask) * alpha + (c2 & gMask) * invAlpha) >> 8) & gMask;
+				uint32 b = (((c1 & bMask) * alpha + (c2 & bMask) * invAlpha) >> 8) & bMask;
+
+				*dst++ = (uint16) (r | g | b | aMask);
+			}
+		}
+	}
 };
 
 RivenGraphics::RivenGraphics(MohawkEngine_Riven* vm) :
@@ -370,11 +407,13 @@ void RivenGraphics::copyImageToScreen(uint16 image, uint32 left, uint32 top, uin
 	beginScreenUpdate();
 
 	// Clip the width to fit on the screen. Fixes some images.
-	if (left + surface->w > 608)
-		surface->w = 608 - left;
+	// The cached surface is left untouched, as it may be drawn elsewhere later.
+	uint16 width = surface->w;
+	if (left + width > 608)
+		width = 608 - left;
 
 	for (uint16 i = 0; i < surface->h; i++)
-		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), surface->w * surface->format.bytesPerPixel);
+		memcpy(_mainScreen->getBasePtr(left, i + top), surface->getBasePtr(0, i), width * surface->format.bytesPerPixel);
 
 	_dirtyScreen = true;
 	applyScreenUpdate();
@@ -130,6 +130,7 @@ public:
 									const Math::Vector3d &topRight, const Math::Vector3d &bottomRight,
 									Texture *texture) = 0;
 
+	/** Draw the faces of a cube node, skipping those without a texture */
 	virtual void drawCube(Texture **textures) = 0;
 	virtual void draw2DText(const Common::String &text, const Common::Point &position) = 0;
 
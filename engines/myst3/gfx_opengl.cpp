@@ -265,7 +265,8 @@ void OpenGLRenderer::drawCube(Texture **textures) {
 	glDepthMask(GL_FALSE);
 
 	for (uint i = 0; i < 6; i++) {
-		drawFace(i, textures[i]);
+		if (textures[i])
+			drawFace(i, textures[i]);
 	}
 
 	glDepthMask(GL_TRUE);
@@ -308,31 +308,28 @@ void ShaderRenderer::draw2DText(const Common::String &text, const Common::Point
 }
 
 void ShaderRenderer::drawCube(Texture **textures) {
-	OpenGLTexture *texture0 = static_cast<OpenGLTexture *>(textures[0]);
+	// All the faces have the same size
+	OpenGLTexture *sizeTexture = nullptr;
+	for (uint i = 0; i < 6 && !sizeTexture; i++) {
+		sizeTexture = static_cast<OpenGLTexture *>(textures[i]);
+	}
+
+	if (!sizeTexture)
+		return;
 
 	glDepthMask(GL_FALSE);
 
 	_cubeShader->use();
-	_cubeShader->setUniform1f("texScale", texture0->width / (float) texture0->internalWidth);
+	_cubeShader->setUniform1f("texScale", sizeTexture->width / (float) sizeTexture->internalWidth);
 	_cubeShader->setUniform("mvpMatrix", _mvpMatrix);
 
-	glBindTexture(GL_TEXTURE_2D, static_cast<OpenGLTexture *>(textures[0])->id);
-	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
-
-	glBindTexture(GL_TEXTURE_2D, static_cast<OpenGLTexture *>(textures[1])->id);
-	glDrawArrays(GL_TRIANGLE_STRIP, 4, 4);
+	for (uint i = 0; i < 6; i++) {
+		if (!textures[i])
+			continue;
 
-	glBindTexture(GL_TEXTURE_2D, static_cast<OpenGLTexture *>(textures[2])->id);
-	glDrawArrays(GL_TRIANGLE_STRIP, 8, 4);
-
-	glBindTexture(GL_TEXTURE_2D, static_cast<OpenGLTexture *>(textures[3])->id);
-	glDrawArrays(GL_TRIANGLE_STRIP, 12, 4);
-
-	glBindTexture(GL_TEXTURE_2D, static_cast<OpenGLTexture *>(textures[4])->id);
-	glDrawArrays(GL_TRIANGLE_STRIP, 16, 4);
-
-	glBindTexture(GL_TEXTURE_2D, static_cast<OpenGLTexture *>(textures[5])->id);
-	glDrawArrays(GL_TRIANGLE_STRIP, 20, 4);
+		glBindTexture(GL_TEXTURE_2D, static_cast<OpenGLTexture *>(textures[i])->id);
+		glDrawArrays(GL_TRIANGLE_STRIP, 4 * i, 4);
+	}
 
 	glDepthMask(GL_TRUE);
 }
@@ -232,7 +232,8 @@ void TinyGLRenderer::drawCube(Texture **textures) {
 	tglDepthMask(TGL_FALSE);
 
 	for (uint i = 0; i < 6; i++) {
-		drawFace(i, textures[i]);
+		if (textures[i])
+			drawFace(i, textures[i]);
 	}
 
 	tglDepthMask(TGL_TRUE);
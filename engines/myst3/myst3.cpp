@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/algorithm.h"
 #include "common/debug-channels.h"
 #include "common/events.h"
 #include "common/error.h"
@@ -26,6 +27,7 @@
 #include "common/file.h"
 #include "common/util.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/translation.h"
 
 #include "gui/debugger.h"
@@ -221,6 +223,7 @@ Common::Error Myst3Engine::run() {
 
 	unloadNode();
 
+	clearFaceCaches();
 	_archiveNode->close();
 	_gfx->freeFont();
 
@@ -352,6 +355,8 @@ bool Myst3Engine::isTextLanguageEnglish() const {
 }
 
 void Myst3Engine::closeArchives() {
+	clearFaceCaches();
+
 	for (uint i = 0; i < _archivesCommon.size(); i++)
 		delete _archivesCommon[i];
 
@@ -856,6 +861,8 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 
 		Common::String nodeFile = Common::String::format("%snodes.m3a", newRoomName.c_str());
 
+		// The decoded faces refer to the resources of the archive
+		clearFaceCaches();
 		_archiveNode->close();
 		if (!_archiveNode->open(nodeFile.c_str(), newRoomName.c_str())) {
 			error("Unable to open archive %s", nodeFile.c_str());
@@ -877,6 +884,8 @@ void Myst3Engine::loadNode(uint16 nodeID, uint32 roomID, uint32 ageID) {
 	// Releeshan to the player when he is trapped between both shields.
 	if (nodeID == 9 && roomID == kRoomNarayan)
 		_state->setVar(39, 0);
+
+	decodeNextNodeFaces();
 }
 
 void Myst3Engine::unloadNode() {
@@ -1395,13 +1404,21 @@ Graphics::Surface *Myst3Engine::loadTexture(uint16 id) {
 
 Graphics::Surface *Myst3Engine::decodeJpeg(const ResourceDescription *jpegDesc) {
 	Common::SeekableReadStream *jpegStream = jpegDesc->getData();
+	Graphics::Surface *rgbaSurface = decodeJpegStream(*jpegStream);
+	delete jpegStream;
+
+	if (!rgbaSurface)
+		error("Could not decode Myst III JPEG");
+
+	return rgbaSurface;
+}
 
+Graphics::Surface *Myst3Engine::decodeJpegStream(Common::SeekableReadStream &jpegStream) {
 	Image::JPEGDecoder jpeg;
 	jpeg.setOutputPixelFormat(Texture::getRGBAPixelFormat());
 
-	if (!jpeg.loadStream(*jpegStream))
-		error("Could not decode Myst III JPEG");
-	delete jpegStream;
+	if (!jpeg.loadStream(jpegStream))
+		return nullptr;
 
 	const Graphics::Surface *bitmap = jpeg.getSurface();
 	assert(bitmap->format == Texture::getRGBAPixelFormat());
@@ -1412,6 +1429,240 @@ Graphics::Surface *Myst3Engine::decodeJpeg(const ResourceDescription *jpegDesc)
 	return rgbaSurface;
 }
 
+/** A node face decoded on a worker thread, from data read by the main thread */
+struct Myst3Engine::FaceDecodeTask {
+	ResourceDescription desc;
+	Common::SeekableReadStream *jpegStream;
+	Graphics::Surface *bitmap;
+	Common::Future future;
+
+	static void decode(void *data) {
+		FaceDecodeTask *task = (FaceDecodeTask *)data;
+
+		// Errors are reported when the face is decoded again on the main thread
+		task->bitmap = decodeJpegStream(*task->jpegStream);
+	}
+};
+
+Graphics::Surface *Myst3Engine::decodeFaceJpeg(const ResourceDescription *jpegDesc) {
+	collectDecodedFaces(false);
+
+	for (Common::List<FaceDecodeTask *>::iterator it = _faceDecodeTasks.begin(); it != _faceDecodeTasks.end(); ++it) {
+		if ((*it)->desc == *jpegDesc) {
+			// The face is still being decoded ahead, wait for it
+			FaceDecodeTask *task = *it;
+			_faceDecodeTasks.erase(it);
+
+			task->future.wait();
+			if (task->bitmap)
+				addDecodedFace(task->desc, task->bitmap);
+
+			delete task->jpegStream;
+			delete task;
+			break;
+		}
+	}
+
+	for (Common::List<DecodedFace>::iterator it = _decodedFaces.begin(); it != _decodedFaces.end(); ++it) {
+		if (it->desc == *jpegDesc) {
+			// Move the face to the front of the list
+			DecodedFace face = *it;
+			_decodedFaces.erase(it);
+			_decodedFaces.push_front(face);
+
+			Graphics::Surface *bitmap = new Graphics::Surface();
+			bitmap->copyFrom(*face.bitmap);
+			return bitmap;
+		}
+	}
+
+	Graphics::Surface *bitmap = decodeJpeg(jpegDesc);
+
+	// The faces are drawn onto by the spot items, so the cache keeps its own copy
+	Graphics::Surface *cachedBitmap = new Graphics::Surface();
+	cachedBitmap->copyFrom(*bitmap);
+	addDecodedFace(*jpegDesc, cachedBitmap);
+
+	return bitmap;
+}
+
+void Myst3Engine::addDecodedFace(const ResourceDescription &desc, Graphics::Surface *bitmap) {
+	// Enough for the current cube node and three nodes it leads to
+	static const uint kMaxDecodedFaces = 24;
+
+	if (_decodedFaces.size() >= kMaxDecodedFaces) {
+		_decodedFaces.back().bitmap->free();
+		delete _decodedFaces.back().bitmap;
+		_decodedFaces.pop_back();
+	}
+
+	DecodedFace face;
+	face.desc = desc;
+	face.bitmap = bitmap;
+	_decodedFaces.push_front(face);
+}
+
+bool Myst3Engine::isFaceDecoded(const ResourceDescription &desc) {
+	for (Common::List<DecodedFace>::iterator it = _decodedFaces.begin(); it != _decodedFaces.end(); ++it) {
+		if (it->desc == desc)
+			return true;
+	}
+
+	for (Common::List<FaceDecodeTask *>::iterator it = _faceDecodeTasks.begin(); it != _faceDecodeTasks.end(); ++it) {
+		if ((*it)->desc == desc)
+			return true;
+	}
+
+	return false;
+}
+
+void Myst3Engine::decodeNextNodeFaces() {
+	// Opcodes moving to another node of the current room, see Script
+	enum {
+		kOpGoToNodeTransition = 136,
+		kOpGoToNodeTrans2     = 137,
+		kOpGoToNodeTrans1     = 138,
+		kOpZipToNode          = 140
+	};
+
+	static const uint kMaxNextNodes = 3;
+
+	// Without threads, decoding ahead would only make entering a node slower
+	if (ThreadPoolMan.getThreadCount() == 0)
+		return;
+
+	collectDecodedFaces(false);
+
+	uint16 currentNode = _state->getLocationNode();
+	NodePtr nodeData = _db->getNodeData(currentNode, _state->getLocationRoom(), _state->getLocationAge());
+	if (!nodeData)
+		return;
+
+	// The hotspots of the node tell where the player can go from here
+	Common::Array<uint16> nextNodes;
+	for (uint i = 0; i < nodeData->hotspots.size() && nextNodes.size() < kMaxNextNodes; i++) {
+		const Common::Array<Opcode> &script = nodeData->hotspots[i].script;
+
+		for (uint j = 0; j < script.size() && nextNodes.size() < kMaxNextNodes; j++) {
+			const Opcode &opcode = script[j];
+			if (opcode.op != kOpGoToNodeTransition && opcode.op != kOpGoToNodeTrans2
+					&& opcode.op != kOpGoToNodeTrans1 && opcode.op != kOpZipToNode)
+				continue;
+
+			uint16 node = opcode.args[0];
+			if (node != currentNode && Common::find(nextNodes.begin(), nextNodes.end(), node) == nextNodes.end())
+				nextNodes.push_back(node);
+		}
+	}
+
+	for (uint i = 0; i < nextNodes.size(); i++) {
+		for (uint face = 1; face <= 6; face++) {
+			ResourceDescription desc = getFileDescription("", nextNodes[i], face, Archive::kCubeFace);
+			if (!desc.isValid())
+				break; // Not a cube node
+
+			if (isFaceDecoded(desc))
+				continue;
+
+			// The archive is only read on the main thread
+			FaceDecodeTask *task = new FaceDecodeTask();
+			task->desc = desc;
+			task->jpegStream = desc.getData();
+			task->bitmap = nullptr;
+			_faceDecodeTasks.push_back(task);
+
+			ThreadPoolMan.submit(task->future, FaceDecodeTask::decode, task);
+		}
+	}
+}
+
+void Myst3Engine::collectDecodedFaces(bool wait) {
+	Common::List<FaceDecodeTask *>::iterator it = _faceDecodeTasks.begin();
+	while (it != _faceDecodeTasks.end()) {
+		FaceDecodeTask *task = *it;
+		if (!wait && !task->future.isDone()) {
+			++it;
+			continue;
+		}
+
+		task->future.wait();
+		if (task->bitmap)
+			addDecodedFace(task->desc, task->bitmap);
+
+		delete task->jpegStream;
+		delete task;
+		it = _faceDecodeTasks.erase(it);
+	}
+}
+
+Texture *Myst3Engine::takeFaceTexture(const ResourceDescription &desc, bool is3D, const Graphics::Surface &bitmap, Common::Rect &dirtyRect) {
+	for (Common::List<KeptFaceTexture>::iterator it = _faceTextures.begin(); it != _faceTextures.end(); ++it) {
+		if (!(it->desc == desc) || it->is3D != is3D)
+			continue;
+
+		KeptFaceTexture kept = *it;
+		_faceTextures.erase(it);
+
+		if (kept.contents->w != bitmap.w || kept.contents->h != bitmap.h || kept.contents->format != bitmap.format) {
+			dirtyRect = Common::Rect(bitmap.w, bitmap.h);
+		} else {
+			// The spot items drawn when the face was unloaded may differ from
+			// those about to be drawn, so only the rows differing are uploaded again
+			int top = bitmap.h, bottom = 0;
+			for (int y = 0; y < bitmap.h; y++) {
+				if (memcmp(kept.contents->getBasePtr(0, y), bitmap.getBasePtr(0, y), bitmap.w * bitmap.format.bytesPerPixel) != 0) {
+					top = MIN(top, y);
+					bottom = y + 1;
+				}
+			}
+
+			dirtyRect = top < bottom ? Common::Rect(0, top, bitmap.w, bottom) : Common::Rect();
+		}
+
+		kept.contents->free();
+		delete kept.contents;
+		return kept.texture;
+	}
+
+	return nullptr;
+}
+
+void Myst3Engine::keepFaceTexture(const ResourceDescription &desc, bool is3D, Texture *texture, Graphics::Surface *contents) {
+	// Enough to go back two cube nodes without creating any texture
+	static const uint kMaxFaceTextures = 12;
+
+	if (_faceTextures.size() >= kMaxFaceTextures) {
+		delete _faceTextures.back().texture;
+		_faceTextures.back().contents->free();
+		delete _faceTextures.back().contents;
+		_faceTextures.pop_back();
+	}
+
+	KeptFaceTexture kept;
+	kept.desc = desc;
+	kept.is3D = is3D;
+	kept.texture = texture;
+	kept.contents = contents;
+	_faceTextures.push_front(kept);
+}
+
+void Myst3Engine::clearFaceCaches() {
+	collectDecodedFaces(true);
+
+	for (Common::List<DecodedFace>::iterator it = _decodedFaces.begin(); it != _decodedFaces.end(); ++it) {
+		it->bitmap->free();
+		delete it->bitmap;
+	}
+	_decodedFaces.clear();
+
+	for (Common::List<KeptFaceTexture>::iterator it = _faceTextures.begin(); it != _faceTextures.end(); ++it) {
+		delete it->texture;
+		it->contents->free();
+		delete it->contents;
+	}
+	_faceTextures.clear();
+}
+
 int16 Myst3Engine::openDialog(uint16 id) {
 	Dialog *dialog;
 
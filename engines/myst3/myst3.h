@@ -25,7 +25,9 @@
 #include "engines/engine.h"
 
 #include "common/array.h"
+#include "common/list.h"
 #include "common/ptr.h"
+#include "common/rect.h"
 #include "common/system.h"
 #include "common/random.h"
 
@@ -71,6 +73,7 @@ class Script;
 class SpotItemFace;
 class SunSpot;
 class Renderer;
+class Texture;
 class Menu;
 class Node;
 class Sound;
@@ -132,6 +135,30 @@ public:
 
 	Graphics::Surface *loadTexture(uint16 id);
 	static Graphics::Surface *decodeJpeg(const ResourceDescription *jpegDesc);
+	static Graphics::Surface *decodeJpegStream(Common::SeekableReadStream &jpegStream);
+
+	/**
+	 * Decode the JPEG image of a node face, reusing the result of a recent
+	 * decoding of the same resource if possible.
+	 *
+	 * The returned surface is a copy owned by the caller.
+	 */
+	Graphics::Surface *decodeFaceJpeg(const ResourceDescription *jpegDesc);
+
+	/**
+	 * Take the texture kept for a face showing the given image, if any.
+	 *
+	 * @param dirtyRect Set to the area of the texture differing from the bitmap
+	 * @return The texture, now owned by the caller, or nullptr
+	 */
+	Texture *takeFaceTexture(const ResourceDescription &desc, bool is3D, const Graphics::Surface &bitmap, Common::Rect &dirtyRect);
+
+	/**
+	 * Keep the texture of an unloaded face, so that coming back to the node
+	 * does not have to upload it again. Takes ownership of both the texture
+	 * and the surface holding its contents.
+	 */
+	void keepFaceTexture(const ResourceDescription &desc, bool is3D, Texture *texture, Graphics::Surface *contents);
 
 	void goToNode(uint16 nodeID, TransitionType transition);
 	void loadNode(uint16 nodeID, uint32 roomID = 0, uint32 ageID = 0);
@@ -198,6 +225,43 @@ private:
 	Common::Array<Archive *> _archivesCommon;
 	Archive *_archiveNode;
 
+	struct DecodedFace {
+		ResourceDescription desc;
+		Graphics::Surface *bitmap;
+	};
+
+	/**
+	 * The most recently decoded node faces, with the most recent first.
+	 *
+	 * Going back and forth between nodes is common, and decoding the
+	 * faces is the slowest part of entering a node.
+	 */
+	Common::List<DecodedFace> _decodedFaces;
+	void addDecodedFace(const ResourceDescription &desc, Graphics::Surface *bitmap);
+	bool isFaceDecoded(const ResourceDescription &desc);
+
+	/**
+	 * The faces of the nodes the current node leads to, being decoded on
+	 * worker threads. They are moved to _decodedFaces once done.
+	 */
+	struct FaceDecodeTask;
+	Common::List<FaceDecodeTask *> _faceDecodeTasks;
+	void decodeNextNodeFaces();
+	void collectDecodedFaces(bool wait);
+
+	struct KeptFaceTexture {
+		ResourceDescription desc;
+		bool is3D;
+		Texture *texture;
+		Graphics::Surface *contents;
+	};
+
+	/** The textures of the most recently unloaded faces, with the most recent first */
+	Common::List<KeptFaceTexture> _faceTextures;
+
+	/** Forget the decoded faces and face textures, which refer to the resources of the archives */
+	void clearFaceCaches();
+
 	Script *_scriptEngine;
 
 	Common::Array<ScriptedMovie *> _movies;
@@ -33,15 +33,18 @@
 namespace Myst3 {
 
 void Face::setTextureFromJPEG(const ResourceDescription *jpegDesc) {
-	_bitmap = Myst3Engine::decodeJpeg(jpegDesc);
-	if (_is3D) {
-		_texture = _vm->_gfx->createTexture3D(_bitmap);
-	} else {
-		_texture = _vm->_gfx->createTexture2D(_bitmap);
-	}
-
-	// Set the whole texture as dirty
-	addTextureDirtyRect(Common::Rect(_bitmap->w, _bitmap->h));
+	_jpegDesc = *jpegDesc;
+	_bitmap = _vm->decodeFaceJpeg(jpegDesc);
+
+	// The texture is created on the first upload, unless the face was shown recently
+	Common::Rect dirtyRect;
+	_texture = _vm->takeFaceTexture(_jpegDesc, _is3D, *_bitmap, dirtyRect);
+	if (!_texture)
+		dirtyRect = Common::Rect(_bitmap->w, _bitmap->h);
+
+	_textureDirty = false;
+	if (!dirtyRect.isEmpty())
+		addTextureDirtyRect(dirtyRect);
 }
 
 Face::Face(Myst3Engine *vm, bool is3D) :
@@ -65,16 +68,35 @@ void Face::addTextureDirtyRect(const Common::Rect &rect) {
 
 void Face::uploadTexture() {
 	if (_textureDirty) {
-		if (_finalBitmap)
-			_texture->updatePartial(_finalBitmap, _textureDirtyRect);
-		else
-			_texture->updatePartial(_bitmap, _textureDirtyRect);
+		const Graphics::Surface *bitmap = _finalBitmap ? _finalBitmap : _bitmap;
+
+		if (!_texture) {
+			if (_is3D) {
+				_texture = _vm->_gfx->createTexture3D(bitmap);
+			} else {
+				_texture = _vm->_gfx->createTexture2D(bitmap);
+			}
+		} else {
+			_texture->updatePartial(bitmap, _textureDirtyRect);
+		}
 
 		_textureDirty = false;
 	}
 }
 
 Face::~Face() {
+	if (_texture && !_textureDirty && _jpegDesc.isValid()) {
+		// The texture is up to date, so it holds the final bitmap if there is one
+		if (_finalBitmap) {
+			_bitmap->free();
+			delete _bitmap;
+			_vm->keepFaceTexture(_jpegDesc, _is3D, _texture, _finalBitmap);
+		} else {
+			_vm->keepFaceTexture(_jpegDesc, _is3D, _texture, _bitmap);
+		}
+		return;
+	}
+
 	_bitmap->free();
 	delete _bitmap;
 	_bitmap = nullptr;
@@ -59,6 +59,7 @@ private:
 
 	Myst3Engine *_vm;
 	bool _is3D;
+	ResourceDescription _jpegDesc;
 };
 
 class SpotItemFace {
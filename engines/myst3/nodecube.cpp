@@ -46,13 +46,26 @@ NodeCube::~NodeCube() {
 }
 
 void NodeCube::draw() {
-	// Update the OpenGL textures if needed
+	// Textures of hidden faces uploaded per frame, so that entering a node
+	// or turning around does not upload all of them at once
+	static const uint kMaxHiddenFaceUploads = 1;
+
+	// Update the OpenGL textures if needed. The visible faces are always
+	// up to date, and the hidden ones catch up over the next frames.
+	uint hiddenFaceUploads = 0;
 	for (uint i = 0; i < 6; i++) {
-		if (_faces[i]->isTextureDirty() && isFaceVisible(i)) {
+		if (!_faces[i]->isTextureDirty())
+			continue;
+
+		if (isFaceVisible(i)) {
+			_faces[i]->uploadTexture();
+		} else if (hiddenFaceUploads < kMaxHiddenFaceUploads) {
 			_faces[i]->uploadTexture();
+			hiddenFaceUploads++;
 		}
 	}
 
+	// Hidden faces may not have a texture yet, they are not drawn then
 	Texture *textures[6];
 	for (uint i = 0; i < 6; i++) {
 		textures[i] = _faces[i]->_texture;
@@ -134,6 +134,9 @@ AVFDecoder::AVFVideoTrack::AVFVideoTrack(Common::SeekableReadStream *stream, uin
 
 		_chunkInfo.push_back(info);
 	}
+
+	_frameCache.resize(_frameCount);
+	_frameCacheSize = 0;
 }
 
 AVFDecoder::AVFVideoTrack::~AVFVideoTrack() {
@@ -141,6 +144,9 @@ AVFDecoder::AVFVideoTrack::~AVFVideoTrack() {
 	_surface->free();
 	delete _surface;
 	delete _dec;
+
+	for (uint i = 0; i < _frameCache.size(); i++)
+		delete[] _frameCache[i];
 }
 
 bool AVFDecoder::AVFVideoTrack::seek(const Audio::Timestamp &time) {
@@ -214,6 +220,12 @@ const Graphics::Surface *AVFDecoder::AVFVideoTrack::decodeFrame(uint frameNr) {
 		return nullptr;
 	}
 
+	if (_frameCache[frameNr]) {
+		memcpy(_surface->getPixels(), _frameCache[frameNr], _frameSize);
+		_refFrame = frameNr;
+		return _surface;
+	}
+
 	const ChunkInfo &info = _chunkInfo[frameNr];
 
 	if (info.type == 2 && (_refFrame == -1 || _refFrame != (int)frameNr - 1)) {
@@ -259,9 +271,21 @@ const Graphics::Surface *AVFDecoder::AVFVideoTrack::decodeFrame(uint frameNr) {
 
 	_refFrame = frameNr;
 	delete[] decompBuf;
+	cacheFrame(frameNr);
 	return _surface;
 }
 
+void AVFDecoder::AVFVideoTrack::cacheFrame(uint frameNr) {
+	// Frames are kept until the budget runs out; evicting them instead would
+	// make clips longer than the budget miss on every frame when looping
+	if (_frameCacheSize + _frameSize > kFrameCacheSize)
+		return;
+
+	_frameCache[frameNr] = new byte[_frameSize];
+	memcpy(_frameCache[frameNr], _surface->getPixels(), _frameSize);
+	_frameCacheSize += _frameSize;
+}
+
 const Graphics::Surface *AVFDecoder::AVFVideoTrack::decodeNextFrame() {
 	return decodeFrame(_reversed ? _curFrame-- : ++_curFrame);
 }
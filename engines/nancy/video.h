@@ -78,7 +78,13 @@ private:
 			byte type;
 		};
 
+		enum {
+			// Budget for the decoded frames kept by each track
+			kFrameCacheSize = 8 * 1024 * 1024
+		};
+
 		bool decode(byte *outBuf, uint32 frameSize, Common::ReadStream &inBuf) const;
+		void cacheFrame(uint frameNr);
 
 		Common::SeekableReadStream *_fileStream;
 		Graphics::PixelFormat _pixelFormat;
@@ -89,6 +95,10 @@ private:
 		Graphics::Surface *_surface;
 		int _refFrame;
 		Common::Array<ChunkInfo> _chunkInfo;
+		// Decoded frames, so that looping and scrubbing (e.g. while turning in
+		// the viewport) do not decompress the same frames over and over
+		Common::Array<byte *> _frameCache;
+		uint32 _frameCacheSize;
 		Decompressor *_dec;
 		bool _reversed;
 	};
@@ -19,6 +19,7 @@
  *
  */
 
+#include "graphics/conversion.h"
 #include "graphics/palette.h"
 #include "video/smk_decoder.h"
 #include "neverhood/screen.h"
@@ -392,14 +393,7 @@ void Screen::blitRenderItem(const RenderItem &renderItem, const Common::Rect &cl
 
 	if (shadowSurface) {
 		const byte *shadowSource = (const byte*)shadowSurface->getBasePtr(x0, y0);
-		while (height--) {
-			for (int xc = 0; xc < width; xc++)
-				if (source[xc] != 0)
-					dest[xc] = shadowSource[xc];
-			source += surface->pitch;
-			shadowSource += shadowSurface->pitch;
-			dest += _backScreen->pitch;
-		}
+		Graphics::maskBlit(dest, shadowSource, source, _backScreen->pitch, shadowSurface->pitch, surface->pitch, width, height, 0);
 	} else if (!renderItem._transparent) {
 		while (height--) {
 			memcpy(dest, source, width);
@@ -407,13 +401,7 @@ void Screen::blitRenderItem(const RenderItem &renderItem, const Common::Rect &cl
 			dest += _backScreen->pitch;
 		}
 	} else {
-		while (height--) {
-			for (int xc = 0; xc < width; xc++)
-				if (source[xc] != 0)
-					dest[xc] = source[xc];
-			source += surface->pitch;
-			dest += _backScreen->pitch;
-		}
+		Graphics::keyBlit(dest, source, _backScreen->pitch, surface->pitch, width, height, 1, 0);
 	}
 
 }
@@ -623,28 +623,54 @@ int MessageQueue::activateExCommandsByKind(int kind) {
 }
 
 MessageQueue *GlobalMessageQueueList::getMessageQueueById(int id) {
-	for (Common::Array<MessageQueue *>::iterator s = begin(); s != end(); ++s) {
-		if ((*s)->_id == id)
-			return *s;
+	Common::HashMap<int, MessageQueue *>::const_iterator it = _idIndex.find(id);
+
+	return (it != _idIndex.end()) ? it->_value : nullptr;
+}
+
+MessageQueue *GlobalMessageQueueList::removeQueueAt(uint pos) {
+	MessageQueue *mq = remove_at(pos);
+
+	Common::HashMap<int, MessageQueue *>::iterator it = _idIndex.find(mq->_id);
+	if (it != _idIndex.end() && it->_value == mq) {
+		// Queues created before the previous one was added share its id, so
+		// the next one in the list takes over
+		for (uint i = pos; i < size(); i++)
+			if (_storage[i]->_id == mq->_id) {
+				it->_value = _storage[i];
+				return mq;
+			}
+
+		_idIndex.erase(it);
 	}
 
-	return nullptr;
+	return mq;
 }
 
 void GlobalMessageQueueList::deleteQueueById(int id) {
+	MessageQueue *mq = getMessageQueueById(id);
+
+	if (!mq)
+		return;
+
 	for (uint i = 0; i < size(); i++)
-		if (_storage[i]->_id == id) {
-			delete remove_at(i);
+		if (_storage[i] == mq) {
+			delete removeQueueAt(i);
 			disableQueueById(id);
 			return;
 		}
 }
 
 void GlobalMessageQueueList::removeQueueById(int id) {
+	MessageQueue *mq = getMessageQueueById(id);
+
+	if (!mq)
+		return;
+
 	for (uint i = 0; i < size(); i++)
-		if (_storage[i]->_id == id) {
-			_storage[i]->_flags &= ~kInGlobalQueue;
-			remove_at(i);
+		if (_storage[i] == mq) {
+			mq->_flags &= ~kInGlobalQueue;
+			removeQueueAt(i);
 
 			disableQueueById(id);
 			return;
@@ -664,7 +690,7 @@ int GlobalMessageQueueList::compact() {
 	for (uint i = 0; i < size();) {
 		if (_storage[i]->_isFinished) {
 			disableQueueById(_storage[i]->_id);
-			delete remove_at(i);
+			delete removeQueueAt(i);
 		} else {
 			if ((uint)_storage[i]->_id < size() + 2)
 				useList[_storage[i]->_id] = true;
@@ -686,6 +712,9 @@ void GlobalMessageQueueList::addMessageQueue(MessageQueue *msg) {
 	if ((msg->getFlags() & kInGlobalQueue) == 0) {
 		msg->setFlags(msg->getFlags() | kInGlobalQueue);
 		push_back(msg);
+
+		if (!_idIndex.contains(msg->_id))
+			_idIndex[msg->_id] = msg;
 	} else {
 		warning("Trying to add a MessageQueue already in the queue");
 	}
@@ -700,6 +729,7 @@ void GlobalMessageQueueList::clear() {
 		delete *it;
 	}
 	Common::Array<MessageQueue *>::clear();
+	_idIndex.clear();
 }
 
 void clearGlobalMessageQueueList() {
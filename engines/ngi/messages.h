@@ -22,6 +22,8 @@
 #ifndef NGI_MESSAGEQUEUE_H
 #define NGI_MESSAGEQUEUE_H
 
+#include "common/hashmap.h"
+
 #include "ngi/utils.h"
 #include "ngi/inventory.h"
 #include "ngi/gfx.h"
@@ -172,6 +174,13 @@ public:
 	void clear();
 
 	int compact();
+
+private:
+	/** Removes the queue at `pos` from the list and the id index */
+	MessageQueue *removeQueueAt(uint pos);
+
+	/** The first queue in the list for each queue id */
+	Common::HashMap<int, MessageQueue *> _idIndex;
 };
 
 struct MessageHandler {
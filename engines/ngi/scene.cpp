@@ -490,9 +490,11 @@ void Scene::objectList_sortByPriority(Common::Array<T *> &list, uint startIndex)
 			for (int i = startIndex; i < lastIndex; i++) {
 				T *curElement = list[i + 1];
 				if (curElement->_priority > refElement->_priority) {
-					// Push refElement down the list
-					list.remove_at(i);
-					list.insert_at(i + 1, refElement);
+					// Push refElement down the list. The list stays sorted
+					// between frames, so this only runs for objects whose
+					// priority changed
+					list[i] = curElement;
+					list[i + 1] = refElement;
 					changed = true;
 				} else
 					refElement = curElement;
@@ -48,6 +48,14 @@ public:
 	 */
 	virtual void flipBuffer() { }
 
+	/**
+	 *  Wait until the previously issued commands have been executed
+	 */
+	virtual void finish() { }
+
+	/** The name of the renderer, for the benchmark reports */
+	virtual const char *getName() const = 0;
+
 	Common::Rect viewport() const;
 
 	void setupCameraPerspective(float pitch, float heading, float fov);
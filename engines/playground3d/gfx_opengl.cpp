@@ -110,6 +110,10 @@ void OpenGLRenderer::deinit() {
 	glDeleteTextures(2, _textureRgba4444Id);
 }
 
+void OpenGLRenderer::finish() {
+	glFinish();
+}
+
 void OpenGLRenderer::clear(const Math::Vector4d &clearColor) {
 	glClearColor(clearColor.x(), clearColor.y(), clearColor.z(), clearColor.w());
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
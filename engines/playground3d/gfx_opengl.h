@@ -41,6 +41,9 @@ public:
 	void init() override;
 	void deinit() override;
 
+	const char *getName() const override { return "OpenGL"; }
+	void finish() override;
+
 	void clear(const Math::Vector4d &clearColor) override;
 	void loadTextureRGBA(Graphics::Surface *texture) override;
 	void loadTextureRGB(Graphics::Surface *texture) override;
@@ -120,6 +120,10 @@ void ShaderRenderer::deinit() {
 	glDeleteTextures(2, _textureRgba4444Id);
 }
 
+void ShaderRenderer::finish() {
+	glFinish();
+}
+
 void ShaderRenderer::clear(const Math::Vector4d &clearColor) {
 	glClearColor(clearColor.x(), clearColor.y(), clearColor.z(), clearColor.w());
 	glClear(GL_COLOR_BUFFER_BIT | GL_DEPTH_BUFFER_BIT);
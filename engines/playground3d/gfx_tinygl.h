@@ -41,6 +41,8 @@ public:
 	void init() override;
 	void deinit() override;
 
+	const char *getName() const override { return "TinyGL"; }
+
 	void clear(const Math::Vector4d &clearColor) override;
 	void loadTextureRGB(Graphics::Surface *texture) override;
 	void loadTextureRGBA(Graphics::Surface *texture) override;
@@ -22,6 +22,7 @@
 #include "common/scummsys.h"
 #include "common/config-manager.h"
 #include "common/events.h"
+#include "common/savefile.h"
 
 #include "graphics/renderer.h"
 
@@ -67,6 +68,16 @@ Playground3dEngine::~Playground3dEngine() {
 }
 
 Common::Error Playground3dEngine::run() {
+	// In benchmark mode, every test is rendered for a fixed number of frames
+	// as fast as possible, and the timings are written to a report
+	ConfMan.registerDefault("benchmark", false);
+	ConfMan.registerDefault("benchmark_frames", 300);
+	const bool benchmark = ConfMan.getBool("benchmark");
+	if (benchmark) {
+		// Measure the rendering, not the refresh rate of the display
+		ConfMan.setBool("vsync", false, Common::ConfigManager::kTransientDomain);
+	}
+
 	_gfx = createRenderer(_system);
 	_gfx->init();
 
@@ -79,8 +90,31 @@ Common::Error Playground3dEngine::run() {
 	// 3 - fade in/out
 	// 4 - moving filled rectangle in viewport
 	// 5 - drawing RGBA pattern texture to check endian correctness
+	// 6 - grid of rotated cubes, with thousands of triangles
 	int testId = 1;
 
+	if (benchmark) {
+		runBenchmark();
+	} else {
+		setupTest(testId);
+		while (!shouldQuit()) {
+			processInput();
+			drawFrame(testId);
+		}
+	}
+
+	delete _rgbaTexture;
+	delete _rgbTexture;
+	delete _rgb565Texture;
+	delete _rgba5551Texture;
+	delete _rgba4444Texture;
+	_gfx->deinit();
+	_system->showMouse(false);
+
+	return Common::kNoError;
+}
+
+void Playground3dEngine::setupTest(int testId) {
 	switch (testId) {
 		case 1:
 			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
@@ -97,6 +131,8 @@ Common::Error Playground3dEngine::run() {
 			break;
 		case 5: {
 			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
+			if (_rgbaTexture)
+				break;
 #if defined(SCUMM_LITTLE_ENDIAN)
 			Graphics::PixelFormat pixelFormatRGBA(4, 8, 8, 8, 8, 0, 8, 16, 24);
 			Graphics::PixelFormat pixelFormatRGB(3, 8, 8, 8, 0, 0, 8, 16, 0);
@@ -114,24 +150,74 @@ Common::Error Playground3dEngine::run() {
 			_rgba4444Texture = generateRgbaTexture(120, 120, pixelFormatRGB4444);
 			break;
 		}
+		case 6:
+			_clearColor = Math::Vector4d(0.5f, 0.5f, 0.5f, 1.0f);
+			_rotateAngleX = 45, _rotateAngleY = 45, _rotateAngleZ = 10;
+			break;
 		default:
 			assert(false);
 	}
+}
+
+void Playground3dEngine::runBenchmark() {
+	const int frames = MAX(ConfMan.getInt("benchmark_frames"), 1);
+
+	Common::String report = Common::String::format("Playground3D benchmark: %s renderer, %dx%d, %d frames per test\n",
+	                                               _gfx->getName(), _system->getWidth(), _system->getHeight(), frames);
+	report += "test    submit ms   render ms  present ms         fps\n";
 
-	while (!shouldQuit()) {
+	for (int testId = 1; testId <= kTestCount && !shouldQuit(); testId++) {
+		setupTest(testId);
+
+		// Draw one frame first, so that the textures are uploaded and the
+		// renderer has settled
 		processInput();
-		drawFrame(testId);
+		drawTest(testId);
+		_gfx->flipBuffer();
+		_gfx->finish();
+		_system->updateScreen();
+
+		// Submitting is the time spent issuing the draw calls. Rendering
+		// is the time until they are done, which is the time to rasterize
+		// the frame for TinyGL, and the time waiting for the GPU otherwise.
+		uint64 submitTime = 0, renderTime = 0, presentTime = 0;
+		const uint64 start = _system->getMicros();
+		int frame = 0;
+		for (; frame < frames && !shouldQuit(); frame++) {
+			processInput();
+
+			const uint64 frameStart = _system->getMicros();
+			drawTest(testId);
+			const uint64 submitted = _system->getMicros();
+			_gfx->flipBuffer();
+			_gfx->finish();
+			const uint64 rendered = _system->getMicros();
+			_system->updateScreen();
+			const uint64 presented = _system->getMicros();
+
+			submitTime += submitted - frameStart;
+			renderTime += rendered - submitted;
+			presentTime += presented - rendered;
+		}
+		if (frame == 0)
+			break;
+		const uint64 elapsed = MAX<uint64>(_system->getMicros() - start, 1);
+
+		report += Common::String::format("%4d  %10.3f  %10.3f  %10.3f  %10.1f\n", testId,
+		                                 submitTime / 1000.0 / frame, renderTime / 1000.0 / frame,
+		                                 presentTime / 1000.0 / frame, frame * 1000000.0 / elapsed);
 	}
 
-	delete _rgbaTexture;
-	delete _rgbTexture;
-	delete _rgb565Texture;
-	delete _rgba5551Texture;
-	delete _rgba4444Texture;
-	_gfx->deinit();
-	_system->showMouse(false);
+	debug("%s", report.c_str());
 
-	return Common::kNoError;
+	Common::OutSaveFile *file = _saveFileMan->openForSaving("playground3d-benchmark.txt", false);
+	if (file) {
+		file->writeString(report);
+		file->finalize();
+		delete file;
+	} else {
+		warning("Could not write the benchmark report");
+	}
 }
 
 void Playground3dEngine::processInput() {
@@ -169,6 +255,24 @@ Graphics::Surface *Playground3dEngine::generateRgbaTexture(int width, int height
 void Playground3dEngine::drawAndRotateCube() {
 	Math::Vector3d pos = Math::Vector3d(0.0f, 0.0f, 6.0f);
 	_gfx->drawCube(pos, Math::Vector3d(_rotateAngleX, _rotateAngleY, _rotateAngleZ));
+	rotateCube();
+}
+
+void Playground3dEngine::drawCubeGrid() {
+	const Math::Vector3d roll(_rotateAngleX, _rotateAngleY, _rotateAngleZ);
+	const float center = (kGridSize - 1) / 2.0f;
+
+	for (int y = 0; y < kGridSize; y++) {
+		for (int x = 0; x < kGridSize; x++) {
+			Math::Vector3d pos = Math::Vector3d((x - center) * 2.0f, (y - center) * 1.5f, 60.0f);
+			_gfx->drawCube(pos, roll);
+		}
+	}
+
+	rotateCube();
+}
+
+void Playground3dEngine::rotateCube() {
 	_rotateAngleX += 0.25;
 	_rotateAngleY += 0.50;
 	_rotateAngleZ += 0.10;
@@ -212,6 +316,16 @@ void Playground3dEngine::drawRgbaTexture() {
 }
 
 void Playground3dEngine::drawFrame(int testId) {
+	drawTest(testId);
+
+	_gfx->flipBuffer();
+
+	_frameLimiter->delayBeforeSwap();
+	_system->updateScreen();
+	_frameLimiter->startFrame();
+}
+
+void Playground3dEngine::drawTest(int testId) {
 	_gfx->clear(_clearColor);
 
 	float pitch = 0.0f;
@@ -244,15 +358,12 @@ void Playground3dEngine::drawFrame(int testId) {
 			_gfx->loadTextureRGBA4444(_rgba4444Texture);
 			drawRgbaTexture();
 			break;
+		case 6:
+			drawCubeGrid();
+			break;
 		default:
 			assert(false);
 	}
-
-	_gfx->flipBuffer();
-
-	_frameLimiter->delayBeforeSwap();
-	_system->updateScreen();
-	_frameLimiter->startFrame();
 }
 
 } // End of namespace Playground3d
@@ -46,6 +46,11 @@ public:
 	void drawFrame(int testId);
 
 private:
+	enum {
+		kTestCount = 6,
+		kGridSize = 24 // Cubes per side in the grid test
+	};
+
 	OSystem *_system;
 	Renderer *_gfx;
 	Graphics::FrameLimiter *_frameLimiter;
@@ -61,7 +66,12 @@ private:
 	float _rotateAngleX, _rotateAngleY, _rotateAngleZ;
 
 	Graphics::Surface *generateRgbaTexture(int width, int height, Graphics::PixelFormat format);
+	void setupTest(int testId);
+	void runBenchmark();
+	void drawTest(int testId);
 	void drawAndRotateCube();
+	void drawCubeGrid();
+	void rotateCube();
 	void drawPolyOffsetTest();
 	void dimRegionInOut();
 	void drawInViewport();
@@ -27,6 +27,8 @@
 #include "common/memstream.h"
 #include "graphics/surface.h"
 
+#include "graphics/conversion.h"
+
 #include "saga2/saga2.h"
 #include "saga2/gdraw.h"
 
@@ -43,18 +45,7 @@ void _BltPixels(uint8 *srcPtr, uint32 srcMod, uint8 *dstPtr, uint32 dstMod, uint
 }
 
 void _BltPixelsT(uint8 *srcPtr, uint32 srcMod, uint8 *dstPtr, uint32 dstMod, uint32 width, uint32 height) {
-	for (uint y = 0; y < height; y++) {
-		uint8 *src = srcPtr + srcMod * y;
-		uint8 *dst = dstPtr + dstMod * y;
-		for (uint x = 0; x < width; x++) {
-			byte c = *src++;
-
-			if (c == 0)
-				dst++;
-			else
-				*dst++ = c;
-		}
-	}
+	Graphics::keyBlit(dstPtr, srcPtr, dstMod, srcMod, width, height, 1, 0);
 }
 
 void _FillRect(uint8 *dstPtr, uint32 dstMod, uint32 width, uint32 height, uint32 color) {
@@ -324,24 +315,10 @@ void TBlit(gPixelMap *dstMap, gPixelMap *srcMap, int32 xpos, int32 ypos) {
 	if (w < 0 || h < 0)
 		return;
 
-	int16 dstMod = dstMap->size.x - w;
-	int16 srcMod = srcMap->size.x - w;
-
 	byte *srcPtr = srcMap->data + offset;
 	byte *dstPtr = dstMap->data + xpos + ypos * dstMap->size.x;
 
-	for (int16 y = 0; y < h; y++) {
-		for (int16 x = 0; x < w; x++) {
-			byte c = *srcPtr++;
-
-			if (c == 0)
-				dstPtr++;
-			else
-				*dstPtr++ = c;
-		}
-		dstPtr += dstMod;
-		srcPtr += srcMod;
-	}
+	Graphics::keyBlit(dstPtr, srcPtr, dstMap->size.x, srcMap->size.x, w, h, 1, 0);
 }
 
 void TBlit4(gPixelMap *d, gPixelMap *s, int32 x, int32 y) {
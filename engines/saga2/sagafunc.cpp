@@ -3497,6 +3497,9 @@ int16 scriptSetTileCycleState(int16 *args) {
 	tcd.currentState = args[1];
 	tcd.counter = 0;
 
+	if (tcd.inTileLayer)
+		invalidateTileLayer();
+
 	return 0;
 }
 
@@ -194,6 +194,19 @@ StaticPoint16 fineScroll = {0, 0};
 
 StaticTilePoint viewCenter = {0, 0, 0};             // coordinates of view on map
 
+//  The tiles drawn by drawMetaTiles() only change when the view scrolls by
+//  a whole tile column or a row, or when a tile in view changes its state
+//  or cycles. A copy of the last tile layer is kept, so that it need not be
+//  drawn from the platforms again on every frame.
+
+static uint8        *tileLayerData = nullptr;   // copy of the tile layer
+static int32        tileLayerSize = 0;
+static StaticPoint32 tileLayerViewPos = {0, 0}; // view position of the copy
+static int16        tileLayerMapNum = -1;
+static uint16       tileLayerRoofID = 0;
+static bool         tileLayerValid = false,     // copy is up to date
+                    tileLayerDrawing = false;   // copy is being drawn
+
 //  These two variables define which sectors overlap the view rect.
 
 int16               lastMapNum;
@@ -259,6 +272,10 @@ TileInfo *TileInfo::tileAddress(TileID id, uint8 **imageData) {
 	if (ti->attrs.cycleRange > 0) {
 		TileCycleData   &tcd = cycleList[ti->attrs.cycleRange - 1];
 
+		//  The tile layer has to be redrawn when this range cycles
+		if (tileLayerDrawing)
+			tcd.inTileLayer = true;
+
 		TileID2Bank(tcd.cycleList[tcd.currentState],
 		            tileBank,
 		            tileNum);
@@ -756,6 +773,8 @@ void initActiveItemStates() {
 		if (stateArray[i] == nullptr)
 			error("Unable to load active item state array");
 	}
+
+	invalidateTileLayer();
 }
 
 void saveActiveItemStates(Common::OutSaveFile *outS) {
@@ -856,6 +875,8 @@ void loadActiveItemStates(Common::InSaveFile *in) {
 		} else
 			stateArray[i] = nullptr;
 	}
+
+	invalidateTileLayer();
 }
 
 //-----------------------------------------------------------------------
@@ -1498,6 +1519,12 @@ void cleanupMaps() {
 	//  Dump the map data list
 	delete[] mapList;
 
+	//  Dump the copy of the tile layer
+	delete[] tileLayerData;
+	tileLayerData = nullptr;
+	tileLayerSize = 0;
+	tileLayerValid = false;
+
 	//  Dump all of the tile terrain banks
 	for (i = 0; i < maxBanks; i++) {
 		if (tileBanks[i] != nullptr) {
@@ -2798,6 +2825,26 @@ void drawMetaTiles(gPixelMap &drawMap) {
 	setAreaSound(baseCoords);
 
 	updateHandleRefs(baseCoords);  // viewPoint, &sti );
+
+	//  Only the main view's tile layer is kept
+	bool        keepLayer = (&drawMap == &g_vm->_tileDrawMap);
+
+	if (keepLayer
+	        &&  tileLayerValid
+	        &&  tileLayerSize == drawMap.bytes()
+	        &&  viewPos == tileLayerViewPos
+	        &&  tileLayerMapNum == g_vm->_currentMapNum
+	        &&  tileLayerRoofID == rippedRoofID) {
+		memcpy(drawMap.data, tileLayerData, tileLayerSize);
+		return;
+	}
+
+	if (keepLayer) {
+		for (int i = 0; i < cycleCount; i++)
+			cycleList[i].inTileLayer = false;
+		tileLayerDrawing = true;
+	}
+
 	//  coordinates of current metatile (in X,Y), relative to screen
 
 	metaPos.x   = (baseCoords.u - baseCoords.v) * kMetaDX
@@ -2827,6 +2874,26 @@ void drawMetaTiles(gPixelMap &drawMap) {
 		metaPos.y += kMetaDY;
 		metaPos.x += kMetaDX;
 	}
+
+	if (keepLayer) {
+		if (tileLayerSize != drawMap.bytes()) {
+			delete[] tileLayerData;
+			tileLayerSize = drawMap.bytes();
+			tileLayerData = new uint8[tileLayerSize];
+		}
+
+		memcpy(tileLayerData, drawMap.data, tileLayerSize);
+		tileLayerViewPos.x = viewPos.x;
+		tileLayerViewPos.y = viewPos.y;
+		tileLayerMapNum = g_vm->_currentMapNum;
+		tileLayerRoofID = rippedRoofID;
+		tileLayerValid = true;
+		tileLayerDrawing = false;
+	}
+}
+
+void invalidateTileLayer() {
+	tileLayerValid = false;
 }
 
 /* ===================================================================== *
@@ -4091,6 +4158,9 @@ void cycleTiles(int32 delta) {
 			tcd.currentState++;
 			if (tcd.currentState >= tcd.numStates)
 				tcd.currentState = 0;
+
+			if (tcd.inTileLayer)
+				invalidateTileLayer();
 		}
 	}
 }
@@ -4120,6 +4190,8 @@ void initTileCyclingStates() {
 		debugC(2, kDebugLoading, "Loaded Cycles: cycleCount = %d", cycleCount);
 		delete stream;
 	}
+
+	invalidateTileLayer();
 }
 
 void saveTileCyclingStates(Common::OutSaveFile *outS) {
@@ -312,6 +312,8 @@ public:
 
 	TileID          cycleList[16];        // array of tiles
 
+	bool            inTileLayer;            // drawn in the cached tile layer
+
 	void load(Common::SeekableReadStream *stream) {
 		counter = stream->readSint32LE();
 		pad = stream->readByte();
@@ -321,6 +323,8 @@ public:
 
 		for (int i = 0; i < 16; ++i)
 			cycleList[i] = stream->readUint16LE();
+
+		inTileLayer = false;
 	}
 };
 
@@ -343,6 +347,9 @@ enum ActiveItemTypes {
 //  A pointer to the array of active item state arrays
 extern byte **stateArray;
 
+//  Discard the cached tile layer, after a change in the look of the tiles
+void invalidateTileLayer();
+
 class ActiveItemList;
 
 class ActiveItem;
@@ -434,6 +441,7 @@ public:
 	//  Set the state number of this active item instance
 	void setInstanceState(int16 mapNum, uint8 state) {
 		stateArray[mapNum][_data.instance.stateIndex] = state;
+		invalidateTileLayer();
 	}
 
 	uint8 builtInBehavior() {
@@ -53,6 +53,7 @@
 #include "sci/video/seq_decoder.h"
 #ifdef ENABLE_SCI32
 #include "common/memstream.h"
+#include "sci/graphics/celobj32.h"
 #include "sci/graphics/frameout.h"
 #include "sci/graphics/paint32.h"
 #include "sci/graphics/palette32.h"
@@ -83,6 +84,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	// Variables
 	registerVar("sleeptime_factor",	&g_debug_sleeptime_factor);
 	registerVar("gc_interval",		&engine->_gamestate->scriptGCInterval);
+	registerVar("gc_incremental",	&engine->_gamestate->gcIncremental);
 	registerVar("simulated_key",		&g_debug_simulated_key);
 	registerVar("track_mouse_clicks",	&g_debug_track_mouse_clicks);
 	// FIXME: This actually passes an enum type instead of an integer but no
@@ -147,6 +149,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("pi",                 WRAP_METHOD(Console, cmdPlaneItemList));	// alias
 	registerCmd("visible_plane_items", WRAP_METHOD(Console, cmdVisiblePlaneItemList));
 	registerCmd("vpi",                WRAP_METHOD(Console, cmdVisiblePlaneItemList));	// alias
+	registerCmd("cel_cache",          WRAP_METHOD(Console, cmdCelCache));
 	registerCmd("saved_bits",         WRAP_METHOD(Console, cmdSavedBits));
 	registerCmd("show_saved_bits",    WRAP_METHOD(Console, cmdShowSavedBits));
 	// Segments
@@ -162,6 +165,7 @@ Console::Console(SciEngine *engine) : GUI::Debugger(),
 	registerCmd("gc_reachable",		WRAP_METHOD(Console, cmdGCShowReachable));
 	registerCmd("gc_freeable",		WRAP_METHOD(Console, cmdGCShowFreeable));
 	registerCmd("gc_normalize",		WRAP_METHOD(Console, cmdGCNormalize));
+	registerCmd("gc_stats",			WRAP_METHOD(Console, cmdGCStats));
 	// Music/SFX
 	registerCmd("songlib",			WRAP_METHOD(Console, cmdSongLib));
 	registerCmd("songinfo",			WRAP_METHOD(Console, cmdSongInfo));
@@ -309,6 +313,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf("---------\n");
 	debugPrintf("sleeptime_factor: Factor to multiply with wait times in kWait()\n");
 	debugPrintf("gc_interval: Number of kernel calls in between garbage collections\n");
+	debugPrintf("gc_incremental: Toggles freeing garbage a few entries at a time after each collection\n");
 	debugPrintf("simulated_key: Add a key with the specified scan code to the event list\n");
 	debugPrintf("track_mouse_clicks: Toggles mouse click tracking to the console\n");
 	debugPrintf("script_abort_flag: Set to 1 to abort script execution. Set to 2 to force a replay afterwards\n");
@@ -374,6 +379,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" visible_plane_list / vpl - Shows a list of all the planes in the visible draw list (SCI2+)\n");
 	debugPrintf(" plane_items / pi - Shows a list of all items for a plane (SCI2+)\n");
 	debugPrintf(" visible_plane_items / vpi - Shows a list of all items for a plane in the visible draw list (SCI2+)\n");
+	debugPrintf(" cel_cache - Shows the contents and hit rate of the cel cache (SCI2+)\n");
 	debugPrintf(" saved_bits - List saved bits on the hunk\n");
 	debugPrintf(" show_saved_bits - Display saved bits\n");
 	debugPrintf("\n");
@@ -388,6 +394,7 @@ bool Console::cmdHelp(int argc, const char **argv) {
 	debugPrintf(" gc_reachable - Lists all addresses directly reachable from a given memory object\n");
 	debugPrintf(" gc_freeable - Lists all addresses freeable in a given segment\n");
 	debugPrintf(" gc_normalize - Prints the \"normal\" address of a given address\n");
+	debugPrintf(" gc_stats - Shows how long the garbage collector paused the game\n");
 	debugPrintf("\n");
 	debugPrintf("Music/SFX:\n");
 	debugPrintf(" songlib - Shows the song library\n");
@@ -2094,6 +2101,30 @@ bool Console::cmdVisiblePlaneList(int argc, const char **argv) {
 }
 
 
+bool Console::cmdCelCache(int argc, const char **argv) {
+#ifdef ENABLE_SCI32
+	const CelCache *cache = CelObj::getCache();
+	if (_engine->_gfxFrameout && cache) {
+		uint used = 0;
+		for (uint i = 0; i < cache->size(); ++i) {
+			if (cache->entries[i].celObj) {
+				debugPrintf("%3u: %s\n", i, cache->entries[i].celObj->_info.toString().c_str());
+				++used;
+			}
+		}
+
+		const uint32 lookups = cache->hits + cache->misses;
+		debugPrintf("%u of %u entries used\n", used, cache->size());
+		debugPrintf("%u hits, %u misses (%u%% hit rate)\n", cache->hits, cache->misses, lookups ? cache->hits * 100 / lookups : 0);
+	} else {
+		debugPrintf("This SCI version does not have a cel cache\n");
+	}
+#else
+	debugPrintf("SCI32 isn't included in this compiled executable\n");
+#endif
+	return true;
+}
+
 bool Console::cmdPlaneItemList(int argc, const char **argv) {
 	if (argc != 2) {
 		debugPrintf("Shows the list of items for a plane\n");
@@ -2843,6 +2874,24 @@ bool Console::cmdGCNormalize(int argc, const char **argv) {
 	return true;
 }
 
+static void printGCPauseStats(Console *con, const char *name, const GCPauseStats &stats) {
+	con->debugPrintf("%-12s %6u pauses, average %u ms, longest %u ms, last %u ms\n", name, stats.count,
+		stats.count ? stats.total / stats.count : 0, stats.max, stats.last);
+}
+
+bool Console::cmdGCStats(int argc, const char **argv) {
+	const EngineState *s = _engine->_gamestate;
+	const GCStats &stats = s->gcStats;
+
+	debugPrintf("Garbage collector pauses (%s collections):\n", s->gcIncremental ? "incremental" : "full");
+	printGCPauseStats(this, "Full:", stats.full);
+	printGCPauseStats(this, "Marking:", stats.mark);
+	printGCPauseStats(this, "Sweeping:", stats.sweep);
+	debugPrintf("%u entries freed, %u waiting to be freed\n", stats.freed, s->gcPendingGarbage.size());
+
+	return true;
+}
+
 bool Console::cmdVMVarlist(int argc, const char **argv) {
 	EngineState *s = _engine->_gamestate;
 	const char *varnames[] = {"global", "local", "temp", "param"};
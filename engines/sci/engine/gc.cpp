@@ -21,6 +21,7 @@
 
 #include "sci/engine/gc.h"
 #include "common/array.h"
+#include "common/system.h"
 #include "sci/graphics/ports.h"
 
 #ifdef ENABLE_SCI32
@@ -178,11 +179,18 @@ AddrSet *findAllActiveReferences(EngineState *s) {
 	return normalizeAddresses(s->_segMan, wm._map);
 }
 
-void run_gc(EngineState *s) {
+enum {
+	kGCSweepBudget = 64 ///< Number of entries freed by each sweep_gc() call
+};
+
+/**
+ * Lists the deallocatable entries of all segments which are not referenced
+ * from anywhere.
+ */
+static Common::Array<reg_t> findGarbage(EngineState *s) {
 	SegManager *segMan = s->_segMan;
 
 	// Some debug stuff
-	debugC(kDebugLevelGC, "[GC] Running...");
 #ifdef GC_DEBUG_CODE
 	const char *segnames[SEG_TYPE_MAX + 1];
 	int segcount[SEG_TYPE_MAX + 1];
@@ -195,6 +203,7 @@ void run_gc(EngineState *s) {
 
 	// Iterate over all segments, and check for each whether it
 	// contains stuff that can be collected.
+	Common::Array<reg_t> garbage;
 	const Common::Array<SegmentObj *> &heap = segMan->getSegments();
 	for (uint seg = 1; seg < heap.size(); seg++) {
 		SegmentObj *mobj = heap[seg];
@@ -206,14 +215,12 @@ void run_gc(EngineState *s) {
 #endif
 
 			// Get a list of all deallocatable objects in this segment,
-			// then free any which are not referenced from somewhere.
+			// then keep any which are not referenced from somewhere.
 			const Common::Array<reg_t> tmp = mobj->listAllDeallocatable(seg);
 			for (Common::Array<reg_t>::const_iterator it = tmp.begin(); it != tmp.end(); ++it) {
 				const reg_t addr = *it;
 				if (!activeRefs->contains(addr)) {
-					// Not found -> we can free it
-					mobj->freeAtAddress(segMan, addr);
-					debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+					garbage.push_back(addr);
 #ifdef GC_DEBUG_CODE
 					segcount[type]++;
 #endif
@@ -232,6 +239,66 @@ void run_gc(EngineState *s) {
 		if (segcount[i])
 			debugC(kDebugLevelGC, "\t%d\t* %s", segcount[i], segnames[i]);
 #endif
+
+	return garbage;
+}
+
+static void freeGarbage(EngineState *s, reg_t addr) {
+	SegmentObj *mobj = s->_segMan->getSegmentObj(addr.getSegment());
+	mobj->freeAtAddress(s->_segMan, addr);
+	s->gcStats.freed++;
+	debugC(kDebugLevelGC, "[GC] Deallocating %04x:%04x", PRINT_REG(addr));
+}
+
+void run_gc(EngineState *s) {
+	const uint32 startTime = g_system->getMillis();
+
+	debugC(kDebugLevelGC, "[GC] Running...");
+
+	// Anything left over by an incremental collection is found again
+	s->gcPendingGarbage.clear();
+
+	const Common::Array<reg_t> garbage = findGarbage(s);
+	for (Common::Array<reg_t>::const_iterator it = garbage.begin(); it != garbage.end(); ++it)
+		freeGarbage(s, *it);
+
+	s->gcStats.full.add(g_system->getMillis() - startTime);
+}
+
+void run_gc_incremental(EngineState *s) {
+	const uint32 startTime = g_system->getMillis();
+
+	debugC(kDebugLevelGC, "[GC] Running incrementally...");
+
+	s->gcPendingGarbage.clear();
+
+	const Common::Array<reg_t> garbage = findGarbage(s);
+	for (Common::Array<reg_t>::const_iterator it = garbage.begin(); it != garbage.end(); ++it) {
+		// Scripts are loaded again in place when they are needed again, so
+		// they can't wait
+		if (s->_segMan->getSegmentType(it->getSegment()) == SEG_TYPE_SCRIPT)
+			freeGarbage(s, *it);
+		else
+			s->gcPendingGarbage.push_back(*it);
+	}
+
+	s->gcStats.mark.add(g_system->getMillis() - startTime);
+}
+
+void sweep_gc(EngineState *s) {
+	const uint32 startTime = g_system->getMillis();
+
+	for (int i = 0; i < kGCSweepBudget && !s->gcPendingGarbage.empty(); i++) {
+		const reg_t addr = s->gcPendingGarbage.back();
+		s->gcPendingGarbage.pop_back();
+
+		// The entry may have gone along with its segment in the meantime
+		SegmentObj *mobj = s->_segMan->getSegmentObj(addr.getSegment());
+		if (mobj && mobj->isValidOffset(addr.getOffset()))
+			freeGarbage(s, addr);
+	}
+
+	s->gcStats.sweep.add(g_system->getMillis() - startTime);
 }
 
 } // End of namespace Sci
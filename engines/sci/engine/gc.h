@@ -54,6 +54,23 @@ AddrSet *findAllActiveReferences(EngineState *s);
  */
 void run_gc(EngineState *s);
 
+/**
+ * Starts an incremental garbage collection. All unreachable scripts are
+ * deallocated right away, and the other unreachable entries are queued in
+ * EngineState::gcPendingGarbage, to be freed by sweep_gc().
+ *
+ * Unreachable entries can't be reached again by scripts, so they may be
+ * freed later on.
+ * @param s The state in which we should gc
+ */
+void run_gc_incremental(EngineState *s);
+
+/**
+ * Frees some of the entries queued by the last incremental collection
+ * @param s The state in which we should gc
+ */
+void sweep_gc(EngineState *s);
+
 struct WorklistManager {
 	Common::Array<reg_t> _worklist;
 	AddrSet _map;	// used for 2 contains() calls, inside push() and run_gc()
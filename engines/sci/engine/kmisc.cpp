@@ -203,6 +203,11 @@ reg_t kMemorySegment(EngineState *s, int argc, reg_t *argv) {
 reg_t kFlushResources(EngineState *s, int argc, reg_t *argv) {
 	run_gc(s);
 	debugC(kDebugLevelRoom, "Entering room number %d", argv[0].toUint16());
+
+	// The room's resources are going to be loaded right after this. The
+	// parameter of kPurge is an amount of memory rather than the room.
+	const uint16 roomNumber = getSciVersion() >= SCI_VERSION_2 ? s->currentRoomNumber() : argv[0].toUint16();
+	g_sci->getResMan()->prefetchRoom(roomNumber);
 	return s->r_acc;
 }
 
@@ -116,10 +116,15 @@ struct Vertex {
 	// Previous vertex in shortest path
 	Vertex *path_prev;
 
+	// Index in the cached visibility graph, or -1 for the vertices added
+	// for the start and end points
+	int graphIndex;
+
 public:
 	Vertex(const Common::Point &p) : v(p) {
 		costG = HUGE_DISTANCE;
 		path_prev = nullptr;
+		graphIndex = -1;
 	}
 };
 
@@ -241,6 +246,169 @@ public:
 
 typedef Common::List<Polygon *> PolygonList;
 
+/**
+ * Grid of the polygon edges, so that line of sight tests only need to look at
+ * the edges near the line. Every edge is listed in each cell that its
+ * bounding box overlaps.
+ */
+class EdgeIndex {
+public:
+	EdgeIndex() : _left(0), _top(0), _columns(0), _rows(0), _stamp(0) {}
+
+	/**
+	 * Indexes the edges starting at the given vertices, skipping single-vertex
+	 * polygons.
+	 */
+	void build(Vertex *const *vertices, int count);
+
+	/**
+	 * Returns each edge which may touch the line segment (a, b) once, by the
+	 * vertex it starts at. Any edge not returned neither intersects the
+	 * segment nor has its start vertex on it.
+	 */
+	const Common::Array<Vertex *> &query(const Common::Point &a, const Common::Point &b);
+
+private:
+	enum {
+		kCellSize = 16
+	};
+
+	static int floorDiv(int a, int b) {
+		return a >= 0 ? a / b : -((b - 1 - a) / b);
+	}
+
+	int getColumn(int x) const { return floorDiv(x - _left, kCellSize); }
+	int getRow(int y) const { return floorDiv(y - _top, kCellSize); }
+
+	int _left, _top;
+	int _columns, _rows;
+
+	// The edges of cell i are _cellEdges[_cellStart[i]] up to, but not
+	// including, _cellEdges[_cellStart[i + 1]]
+	Common::Array<uint> _cellStart;
+	Common::Array<uint> _cellEdges;
+	Common::Array<Vertex *> _edges;
+
+	// An edge already returned by the current query has its stamp set to
+	// _stamp
+	Common::Array<uint32> _edgeStamps;
+	uint32 _stamp;
+
+	Common::Array<Vertex *> _result;
+};
+
+void EdgeIndex::build(Vertex *const *vertices, int count) {
+	_edges.clear();
+	for (int i = 0; i < count; i++) {
+		if (VERTEX_HAS_EDGES(vertices[i]))
+			_edges.push_back(vertices[i]);
+	}
+
+	_columns = _rows = 0;
+	if (_edges.empty())
+		return;
+
+	int right = _left = _edges[0]->v.x;
+	int bottom = _top = _edges[0]->v.y;
+	for (uint i = 0; i < _edges.size(); i++) {
+		const Common::Point &p = _edges[i]->v;
+		_left = MIN<int>(_left, p.x);
+		_top = MIN<int>(_top, p.y);
+		right = MAX<int>(right, p.x);
+		bottom = MAX<int>(bottom, p.y);
+	}
+
+	_columns = getColumn(right) + 1;
+	_rows = getRow(bottom) + 1;
+
+	// Count the edges of every cell first, then fill them in
+	_cellStart.clear();
+	_cellStart.resize(_columns * _rows + 1);
+	for (int pass = 0; pass < 2; pass++) {
+		for (uint i = 0; i < _edges.size(); i++) {
+			const Common::Point &p = _edges[i]->v;
+			const Common::Point &q = CLIST_NEXT(_edges[i])->v;
+			const int column0 = getColumn(MIN(p.x, q.x)), column1 = getColumn(MAX(p.x, q.x));
+			const int row0 = getRow(MIN(p.y, q.y)), row1 = getRow(MAX(p.y, q.y));
+
+			for (int row = row0; row <= row1; row++) {
+				for (int column = column0; column <= column1; column++) {
+					const int cell = row * _columns + column;
+					if (pass == 0)
+						_cellStart[cell + 1]++;
+					else
+						_cellEdges[--_cellStart[cell + 1]] = i;
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (uint i = 1; i < _cellStart.size(); i++)
+				_cellStart[i] += _cellStart[i - 1];
+			_cellEdges.resize(_cellStart.back());
+		}
+	}
+
+	// Filling in counted the end of every cell down to its start, which
+	// leaves the start of cell i in _cellStart[i + 1]
+	for (int i = 0; i < _columns * _rows; i++)
+		_cellStart[i] = _cellStart[i + 1];
+	_cellStart[_columns * _rows] = _cellEdges.size();
+
+	_edgeStamps.clear();
+	_edgeStamps.resize(_edges.size());
+	_stamp = 0;
+}
+
+const Common::Array<Vertex *> &EdgeIndex::query(const Common::Point &a, const Common::Point &b) {
+	_result.clear();
+	if (_edges.empty())
+		return _result;
+
+	if (++_stamp == 0) {
+		for (uint i = 0; i < _edgeStamps.size(); i++)
+			_edgeStamps[i] = 0;
+		_stamp = 1;
+	}
+
+	const int minY = MIN(a.y, b.y), maxY = MAX(a.y, b.y);
+	const int row0 = MAX(getRow(minY), 0), row1 = MIN(getRow(maxY), _rows - 1);
+
+	for (int row = row0; row <= row1; row++) {
+		// The extent of the segment within this row of cells, widened by a
+		// pixel to make up for rounding
+		float x0, x1;
+		if (a.y == b.y) {
+			x0 = MIN(a.x, b.x);
+			x1 = MAX(a.x, b.x);
+		} else {
+			const float y0 = MAX(minY, _top + row * kCellSize);
+			const float y1 = MIN(maxY, _top + (row + 1) * kCellSize);
+			const float slope = (float)(b.x - a.x) / (b.y - a.y);
+			x0 = a.x + (y0 - a.y) * slope;
+			x1 = a.x + (y1 - a.y) * slope;
+			if (x0 > x1)
+				SWAP(x0, x1);
+		}
+
+		const int column0 = MAX(getColumn((int)floor(x0) - 1), 0);
+		const int column1 = MIN(getColumn((int)ceil(x1) + 1), _columns - 1);
+
+		for (int column = column0; column <= column1; column++) {
+			const int cell = row * _columns + column;
+			for (uint i = _cellStart[cell]; i < _cellStart[cell + 1]; i++) {
+				const uint edge = _cellEdges[i];
+				if (_edgeStamps[edge] != _stamp) {
+					_edgeStamps[edge] = _stamp;
+					_result.push_back(_edges[edge]);
+				}
+			}
+		}
+	}
+
+	return _result;
+}
+
 // Pathfinding state
 struct PathfindingState {
 	// List of all polygons
@@ -262,6 +430,13 @@ struct PathfindingState {
 	// Screen size
 	int _width, _height;
 
+	// Grid of the edges of all polygons
+	EdgeIndex edgeIndex;
+
+	// Visibility between the vertices of the polygons, or NULL if it
+	// cannot be reused for this polygon set
+	AvoidPathCache *cache;
+
 	PathfindingState(int width, int height) : _width(width), _height(height) {
 		vertex_start = nullptr;
 		vertex_end = nullptr;
@@ -269,6 +444,7 @@ struct PathfindingState {
 		_prependPoint = nullptr;
 		_appendPoint = nullptr;
 		vertices = 0;
+		cache = nullptr;
 	}
 
 	~PathfindingState() {
@@ -698,6 +874,39 @@ static int inside(const Common::Point &p, Vertex *vertex) {
 	return 0;
 }
 
+/**
+ * Determines whether or not two vertices can see each other
+ * @param s				the pathfinding state
+ * @param vertex_cur	the first vertex
+ * @param vertex		the second vertex
+ * @return true if the line between the vertices does not pass through any
+ * polygon, false otherwise
+ */
+static bool is_visible(PathfindingState *s, Vertex *vertex_cur, Vertex *vertex) {
+	// Make sure we don't intersect a polygon locally at the vertices
+	if ((inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		return false;
+
+	// Check for intersecting edges
+	const Common::Array<Vertex *> &edges = s->edgeIndex.query(vertex_cur->v, vertex->v);
+	for (uint j = 0; j < edges.size(); j++) {
+		Vertex *edge = edges[j];
+		if (between(vertex_cur->v, vertex->v, edge->v)) {
+			// If we hit a vertex, make sure we can pass through it without intersecting its polygon
+			if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
+				return false;
+
+			// This edge won't properly intersect, so we continue
+			continue;
+		}
+
+		if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
+			return false;
+	}
+
+	return true;
+}
+
 /**
  * Returns a list of all vertices that are visible from a particular vertex.
  * @param s				the pathfinding state
@@ -710,30 +919,20 @@ static VertexList *visible_vertices(PathfindingState *s, Vertex *vertex_cur) {
 	for (int i = 0; i < s->vertices; i++) {
 		Vertex *vertex = s->vertex_index[i];
 
-		// Make sure we don't intersect a polygon locally at the vertices
-		if ((vertex == vertex_cur) || (inside(vertex->v, vertex_cur)) || (inside(vertex_cur->v, vertex)))
+		if (vertex == vertex_cur)
 			continue;
 
-		// Check for intersecting edges
-		int j;
-		for (j = 0; j < s->vertices; j++) {
-			Vertex *edge = s->vertex_index[j];
-			if (VERTEX_HAS_EDGES(edge)) {
-				if (between(vertex_cur->v, vertex->v, edge->v)) {
-					// If we hit a vertex, make sure we can pass through it without intersecting its polygon
-					if ((inside(vertex_cur->v, edge)) || (inside(vertex->v, edge)))
-						break;
-
-					// This edge won't properly intersect, so we continue
-					continue;
-				}
-
-				if (intersect_proper(vertex_cur->v, vertex->v, edge->v, CLIST_NEXT(edge)->v))
-					break;
-			}
+		bool visible;
+		if (s->cache && vertex_cur->graphIndex != -1 && vertex->graphIndex != -1) {
+			byte &entry = s->cache->visibility[vertex_cur->graphIndex * s->cache->vertexCount + vertex->graphIndex];
+			if (entry == kAvoidPathUnknown)
+				entry = is_visible(s, vertex_cur, vertex) ? kAvoidPathVisible : kAvoidPathHidden;
+			visible = (entry == kAvoidPathVisible);
+		} else {
+			visible = is_visible(s, vertex_cur, vertex);
 		}
 
-		if (j == s->vertices)
+		if (visible)
 			visVerts->push_front(vertex);
 	}
 
@@ -1248,6 +1447,46 @@ static void change_polygons_opt_0(PathfindingState *s) {
 	}
 }
 
+/**
+ * Numbers the vertices of the polygons for the visibility cache, which is
+ * emptied first if the polygons differ from those of the previous call
+ * Parameters: (AvoidPathCache &) cache: The visibility cache
+ *             (PathfindingState *) s: The pathfinding state
+ * Returns   : (AvoidPathCache *) The cache, or NULL if the polygon set is
+ *                                too large to be cached
+ */
+static AvoidPathCache *prepare_visibility_cache(AvoidPathCache &cache, PathfindingState *s) {
+	// Keeps the visibility table below 1 MB
+	const uint kMaxCachedVertices = 1024;
+
+	Common::Array<int16> signature;
+	uint count = 0;
+
+	for (PolygonList::iterator it = s->polygons.begin(); it != s->polygons.end(); ++it) {
+		Polygon *polygon = *it;
+		Vertex *vertex;
+
+		signature.push_back(polygon->vertices.size());
+		CLIST_FOREACH(vertex, &polygon->vertices) {
+			vertex->graphIndex = count++;
+			signature.push_back(vertex->v.x);
+			signature.push_back(vertex->v.y);
+		}
+	}
+
+	if (count > kMaxCachedVertices)
+		return nullptr;
+
+	if (signature != cache.signature) {
+		cache.signature = signature;
+		cache.vertexCount = count;
+		cache.visibility.clear();
+		cache.visibility.resize(count * count);
+	}
+
+	return &cache;
+}
+
 /**
  * Converts the SCI input data for pathfinding
  * Parameters: (EngineState *) s: The game state
@@ -1339,10 +1578,20 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 		}
 	}
 
+	// The fixups above may have removed polygons, so the cache is looked up
+	// with the polygons as they are now
+	pf_s->cache = prepare_visibility_cache(s->avoidPathCache, pf_s);
+
 	// Merge start and end points into polygon set
 	pf_s->vertex_start = merge_point(pf_s, *new_start);
 	pf_s->vertex_end = merge_point(pf_s, *new_end);
 
+	// A point splitting an edge changes the edges the other vertices are
+	// tested against, so the cached visibility cannot be used then
+	if ((pf_s->vertex_start->graphIndex == -1 && VERTEX_HAS_EDGES(pf_s->vertex_start)) ||
+		(pf_s->vertex_end->graphIndex == -1 && VERTEX_HAS_EDGES(pf_s->vertex_end)))
+		pf_s->cache = nullptr;
+
 	delete new_start;
 	delete new_end;
 
@@ -1361,6 +1610,7 @@ static PathfindingState *convert_polygon_set(EngineState *s, reg_t poly_list, Co
 	}
 
 	pf_s->vertices = count;
+	pf_s->edgeIndex.build(pf_s->vertex_index, count);
 
 	return pf_s;
 }
@@ -279,6 +279,12 @@ public:
 	uint16 getMethodCount() const { return _methodCount; }
 	reg_t getPos() const { return _pos; }
 
+	/**
+	 * Returns the raw object data within the object's owner script. Clones
+	 * share the data of the object they were cloned from.
+	 */
+	const byte *getBaseObjectData() const { return _baseObj.data(); }
+
 	void saveLoadWithSerializer(Common::Serializer &ser) override;
 
 	void cloneFromObject(const Object *obj) {
@@ -942,12 +942,8 @@ void GfxPalette32::saveLoadWithSerializer(Common::Serializer &s) {
 	s.syncAsSint32LE(_varyTime);
 	s.syncAsUint32LE(_varyLastTick);
 
-	for (int i = 0; i < ARRAYSIZE(_fadeTable); ++i) {
-		s.syncAsByte(_fadeTable[i]);
-	}
-	for (int i = 0; i < ARRAYSIZE(_cycleMap); ++i) {
-		s.syncAsByte(_cycleMap[i]);
-	}
+	s.syncArrayAsByte(_fadeTable, ARRAYSIZE(_fadeTable));
+	s.syncArrayAsByte(_cycleMap, ARRAYSIZE(_cycleMap));
 
 	if (g_sci->_features->hasLatePaletteCode() && s.getVersion() >= 41) {
 		s.syncAsSint16LE(_gammaLevel);
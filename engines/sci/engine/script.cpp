@@ -37,6 +37,8 @@ const char *sciObjectTypeNames[] = {
 	"exports", "pointers", "preload text", "local vars"
 };
 
+uint32 Script::_generation = 0;
+
 Script::Script()
 	: SegmentObj(SEG_TYPE_SCRIPT), _buf() {
 	freeScript();
@@ -49,6 +51,9 @@ Script::~Script() {
 void Script::freeScript(const bool keepLocalsSegment) {
 	_nr = 0;
 
+	freeInstructions();
+	++_generation;
+
 	_buf.clear();
 	_script.clear();
 	_heap.clear();
@@ -74,6 +79,49 @@ void Script::freeScript(const bool keepLocalsSegment) {
 	_offsetLookupSaidCount = 0;
 }
 
+void Script::freeInstructions() {
+	for (uint i = 0; i < _instructionPages.size(); i++) {
+		PMachineInstruction *page = _instructionPages[i];
+		if (!page)
+			continue;
+		for (uint j = 0; j < kInstructionPageSize; j++)
+			delete page[j].sendCache;
+		delete[] page;
+	}
+	_instructionPages.clear();
+}
+
+const PMachineInstruction &Script::getInstruction(uint32 offset) {
+	const uint32 pageNr = offset / kInstructionPageSize;
+	if (pageNr >= _instructionPages.size())
+		_instructionPages.resize(pageNr + 1);
+
+	PMachineInstruction *&page = _instructionPages[pageNr];
+	if (!page)
+		page = new PMachineInstruction[kInstructionPageSize]();
+
+	PMachineInstruction &instruction = page[offset % kInstructionPageSize];
+	if (instruction.size)
+		return instruction;
+
+	instruction.size = readPMachineInstruction(getBuf(offset), instruction.extOpcode, instruction.opparams);
+
+	const byte opcode = instruction.extOpcode >> 1;
+	if (opcode == op_send || opcode == op_self || opcode == op_super)
+		instruction.sendCache = new SendCache();
+
+	// Pairs of instructions which usually come together when preparing a
+	// send, as in "lofsa name; push; send 6"
+	const uint32 nextOffset = offset + instruction.size;
+	if (nextOffset < getBufSize()) {
+		const byte nextOpcode = *getBuf(nextOffset) >> 1;
+		instruction.fusedWithNext = (opcode == op_lofsa && nextOpcode == op_push) ||
+		                            (opcode == op_push && nextOpcode == op_send);
+	}
+
+	return instruction;
+}
+
 enum {
 	kSci11NumExportsOffset = 6,
 	kSci11ExportTableOffset = 8
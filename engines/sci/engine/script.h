@@ -59,6 +59,10 @@ enum {
 	kNoRelocation = 0xFFFFFFFF
 };
 
+enum {
+	kInstructionPageSize = 256
+};
+
 struct offsetLookupArrayEntry {
 	uint16    type;       // type of entry
 	uint16    id;         // id of this type, first item inside script data is 1, second item is 2, etc.
@@ -101,6 +105,15 @@ private:
 	uint16 _offsetLookupStringCount;
 	uint16 _offsetLookupSaidCount;
 
+	/**
+	 * Decoded instructions, in pages of kInstructionPageSize entries indexed
+	 * by offset within the buffer. Pages are allocated when an instruction
+	 * within them is first run.
+	 */
+	Common::Array<PMachineInstruction *> _instructionPages;
+
+	static uint32 _generation; /**< Number of scripts freed so far */
+
 public:
 	int getLocalsOffset() const { return _localsOffset; }
 	uint16 getLocalsCount() const { return _localsCount; }
@@ -127,6 +140,18 @@ public:
 	const ObjMap &getObjectMap() const { return _objects; }
 	bool offsetIsObject(uint32 offset) const;
 
+	/**
+	 * Returns the instruction at the given offset, decoding it on first use.
+	 * The returned reference stays valid until the script is freed.
+	 */
+	const PMachineInstruction &getInstruction(uint32 offset);
+
+	/**
+	 * Returns a number which changes whenever any script is freed, so that
+	 * data referring to scripts can tell when it might have become stale.
+	 */
+	static uint32 getGeneration() { return _generation; }
+
 public:
 	Script();
 	~Script() override;
@@ -294,6 +319,8 @@ public:
 	uint32 getRelocationOffset(const uint32 offset) const;
 
 private:
+	void freeInstructions();
+
 	/**
 	 * Returns a Span containing the relocation table for a SCI0-SCI2.1 script.
 	 * (The SCI0-SCI2.1 relocation table is simply a list of all of the
@@ -372,4 +372,51 @@ SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector sel
 //	return _lookupSelector_function(segMan, obj, selectorId, fptr);
 }
 
+SelectorType lookupSelector(SegManager *segMan, reg_t obj_location, Selector selectorId, ObjVarRef *varp, reg_t *fptr, SendCache &cache) {
+	const Object *obj = segMan->getObject(obj_location);
+
+	// Variables are found through the species, and methods through the
+	// superclass chain, so objects agreeing on both and on their own data
+	// give the same result. The cached object data may have been freed
+	// along with its script, which the script generation tells.
+	if (obj && cache.type != kSelectorNone && cache.selector == selectorId &&
+	    cache.generation == Script::getGeneration() &&
+	    cache.objectData == obj->getBaseObjectData() &&
+	    cache.species == obj->getSpeciesSelector() &&
+	    cache.superClass == obj->getSuperClassSelector()) {
+		if (cache.type == kSelectorVariable) {
+			if (varp) {
+				varp->obj = obj_location;
+				varp->varindex = cache.varindex;
+			}
+		} else if (fptr) {
+			*fptr = cache.funcp;
+		}
+		return cache.type;
+	}
+
+	ObjVarRef cachedVarp;
+	reg_t cachedFuncp;
+	const SelectorType type = lookupSelector(segMan, obj_location, selectorId, &cachedVarp, &cachedFuncp);
+	if (type == kSelectorNone)
+		return type;
+
+	cache.objectData = obj->getBaseObjectData();
+	cache.species = obj->getSpeciesSelector();
+	cache.superClass = obj->getSuperClassSelector();
+	cache.selector = selectorId;
+	cache.type = type;
+	cache.generation = Script::getGeneration();
+	if (type == kSelectorVariable) {
+		cache.varindex = cachedVarp.varindex;
+		if (varp)
+			*varp = cachedVarp;
+	} else {
+		cache.funcp = cachedFuncp;
+		if (fptr)
+			*fptr = cachedFuncp;
+	}
+	return type;
+}
+
 } // End of namespace Sci
@@ -82,6 +82,7 @@ void EngineState::reset(bool isRestoring) {
 		_memorySegmentSize = 0;
 		_fileHandles.resize(5);
 		abortScriptProcessing = kAbortNone;
+		gcStats = GCStats();
 	} else {
 		g_sci->_guestAdditions->reset();
 	}
@@ -103,6 +104,8 @@ void EngineState::reset(bool isRestoring) {
 	lastWaitTime = 0;
 
 	gcCountDown = 0;
+	gcPendingGarbage.clear();
+	avoidPathCache.clear();
 
 #ifdef ENABLE_SCI32
 	_eventCounter = 0;
@@ -121,6 +124,7 @@ void EngineState::reset(bool isRestoring) {
 
 	scriptStepCounter = 0;
 	scriptGCInterval = GC_INTERVAL;
+	gcIncremental = true;
 }
 
 void EngineState::speedThrottler(uint32 neededSleep) {
@@ -97,6 +97,68 @@ struct SciCallOrigin {
 	}
 };
 
+/**
+ * Durations of one kind of garbage collector pause, in milliseconds.
+ */
+struct GCPauseStats {
+	uint32 count;
+	uint32 total;
+	uint32 max;
+	uint32 last;
+
+	GCPauseStats() : count(0), total(0), max(0), last(0) {}
+
+	void add(uint32 duration) {
+		count++;
+		total += duration;
+		max = MAX(max, duration);
+		last = duration;
+	}
+};
+
+/**
+ * Garbage collector statistics, shown by the "gc_stats" console command.
+ */
+struct GCStats {
+	GCPauseStats full;  //< Collections marking and freeing at once
+	GCPauseStats mark;  //< Marking done by incremental collections
+	GCPauseStats sweep; //< Freeing done by incremental collections
+	uint32 freed;       //< Number of deallocated entries
+
+	GCStats() : freed(0) {}
+};
+
+/**
+ * Visibility between the vertices of the last polygon set searched by
+ * kAvoidPath. Scripts usually pass the same polygons for every step of an
+ * actor's walk, so the visibility tests are only redone when they change.
+ */
+struct AvoidPathCache {
+	/** The vertex count of every polygon, each followed by its points. */
+	Common::Array<int16> signature;
+	/** Total number of vertices in the polygon set. */
+	uint vertexCount;
+	/**
+	 * For every ordered pair of vertices, kAvoidPathUnknown if it has not been
+	 * tested yet, otherwise whether the vertices see each other.
+	 */
+	Common::Array<byte> visibility;
+
+	AvoidPathCache() : vertexCount(0) {}
+
+	void clear() {
+		signature.clear();
+		visibility.clear();
+		vertexCount = 0;
+	}
+};
+
+enum {
+	kAvoidPathUnknown = 0,
+	kAvoidPathVisible = 1,
+	kAvoidPathHidden = 2
+};
+
 struct EngineState : public Common::Serializable {
 public:
 	EngineState(SegManager *segMan);
@@ -195,6 +257,18 @@ public:
 
 	int gcCountDown; /**< Number of kernel calls until next gc */
 
+	/**
+	 * Whether the collections run every scriptGCInterval kernel calls are
+	 * incremental. Incremental collections only mark at once, and leave
+	 * the unreachable entries in gcPendingGarbage, to be freed a few at a
+	 * time during the next kernel calls.
+	 */
+	bool gcIncremental;
+	Common::Array<reg_t> gcPendingGarbage;
+	GCStats gcStats;
+
+	AvoidPathCache avoidPathCache;
+
 	MessageState *_msgState;
 
 	// MemorySegment provides access to a 256-byte block of memory that remains
@@ -261,7 +261,7 @@ static void _exec_varselectors(EngineState *s) {
 }
 
 
-ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPtr sp, int framesize, StackPtr argp) {
+ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPtr sp, int framesize, StackPtr argp, SendCache *cache) {
 	// send_obj and work_obj are equal for anything but 'super'
 	// Returns a pointer to the TOS exec_stack element
 	assert(s);
@@ -287,7 +287,15 @@ ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj, StackPt
 		g_sci->_guestAdditions->sendSelectorHook(send_obj, selector, argp);
 #endif
 
-		SelectorType selectorType = lookupSelector(s->_segMan, send_obj, selector, &varp, &funcp);
+		SelectorType selectorType;
+		if (cache) {
+			selectorType = lookupSelector(s->_segMan, send_obj, selector, &varp, &funcp, *cache);
+			// The cache belongs to the send instruction, which only
+			// names the first selector of the frame
+			cache = nullptr;
+		} else {
+			selectorType = lookupSelector(s->_segMan, send_obj, selector, &varp, &funcp);
+		}
 		if (selectorType == kSelectorNone)
 			error("Send to invalid selector 0x%x (%s) of object at %04x:%04x", 0xffff & selector, g_sci->getKernel()->getSelectorName(0xffff & selector).c_str(), PRINT_REG(send_obj));
 
@@ -574,7 +582,8 @@ void run_vm(EngineState *s) {
 	int temp;
 	reg_t r_temp; // Temporary register
 	StackPtr s_temp; // Temporary stack pointer
-	int16 opparams[4]; // opcode parameters
+	// The current instruction; copied, as running it may free its script
+	PMachineInstruction instruction;
 
 	s->r_rest = 0;	// &rest adjusts the parameter count by this value
 	// Current execution data:
@@ -657,8 +666,12 @@ void run_vm(EngineState *s) {
 			s->xs->addr.pc.getOffset(), scr->getBufSize());
 
 		// Get opcode
-		byte extOpcode;
-		s->xs->addr.pc.incOffset(readPMachineInstruction(scr->getBuf(s->xs->addr.pc.getOffset()), extOpcode, opparams));
+		instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+
+runInstruction:
+		const int16 *opparams = instruction.opparams;
+		const byte extOpcode = instruction.extOpcode;
+		s->xs->addr.pc.incOffset(instruction.size);
 		const byte opcode = extOpcode >> 1;
 		//debug("%s: %d, %d, %d, %d, acc = %04x:%04x, script %d, local script %d", opcodeNames[opcode], opparams[0], opparams[1], opparams[2], opparams[3], PRINT_REG(s->r_acc), scr->getScriptNumber(), local_script->getScriptNumber());
 
@@ -884,7 +897,12 @@ void run_vm(EngineState *s) {
 			// Run the garbage collector, if needed
 			if (s->gcCountDown-- <= 0) {
 				s->gcCountDown = s->scriptGCInterval;
-				run_gc(s);
+				if (s->gcIncremental)
+					run_gc_incremental(s);
+				else
+					run_gc(s);
+			} else if (!s->gcPendingGarbage.empty()) {
+				sweep_gc(s);
 			}
 
 			// Call kernel function
@@ -999,7 +1017,8 @@ void run_vm(EngineState *s) {
 
 			s->xs->sp[1].incOffset(s->r_rest);
 			xs_new = send_selector(s, s->r_acc, s->r_acc, s_temp,
-									(int)(opparams[0] >> 1) + (uint16)s->r_rest, s->xs->sp);
+									(int)(opparams[0] >> 1) + (uint16)s->r_rest, s->xs->sp,
+									instruction.sendCache);
 
 			if (xs_new && xs_new != s->xs)
 				s->_executionStackPosChanged = true;
@@ -1046,7 +1065,7 @@ void run_vm(EngineState *s) {
 			s->xs->sp[1].incOffset(s->r_rest);
 			xs_new = send_selector(s, s->xs->objp, s->xs->objp,
 									s_temp, (int)(opparams[0] >> 1) + (uint16)s->r_rest,
-									s->xs->sp);
+									s->xs->sp, instruction.sendCache);
 
 			if (xs_new && xs_new != s->xs)
 				s->_executionStackPosChanged = true;
@@ -1075,7 +1094,7 @@ void run_vm(EngineState *s) {
 				s->xs->sp[1].incOffset(s->r_rest);
 				xs_new = send_selector(s, r_temp, s->xs->objp, s_temp,
 										(int)(opparams[1] >> 1) + (uint16)s->r_rest,
-										s->xs->sp);
+										s->xs->sp, instruction.sendCache);
 
 				if (xs_new && xs_new != s->xs)
 					s->_executionStackPosChanged = true;
@@ -1427,6 +1446,19 @@ void run_vm(EngineState *s) {
 					opcode);
 		}
 		++s->scriptStepCounter;
+
+		// Run fused instructions right away. They stay within the current
+		// frame, so only the checks which could stop before the next one
+		// are needed.
+		if (instruction.fusedWithNext && s->abortScriptProcessing == kAbortNone &&
+		    !s->_executionStackPosChanged && !g_sci->_debugState.debugging &&
+		    !(g_sci->_debugState._activeBreakpointTypes & BREAK_ADDRESS)) {
+			g_sci->_debugState.old_pc_offset = s->xs->addr.pc.getOffset();
+			g_sci->_debugState.old_sp = s->xs->sp;
+			s->variablesMax[VAR_TEMP] = s->xs->sp - s->xs->fp;
+			instruction = scr->getInstruction(s->xs->addr.pc.getOffset());
+			goto runInstruction;
+		}
 	}
 }
 
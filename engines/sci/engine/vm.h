@@ -70,6 +70,45 @@ struct ObjVarRef {
 	reg_t* getPointer(SegManager *segMan) const;
 };
 
+/**
+ * The result of the last selector lookup done by a send instruction.
+ *
+ * Objects with the same object data, species and superclass, like an object
+ * and its clones, have the same properties and methods, so the result can be
+ * reused for the next object sent to from the same place. The results are
+ * dropped whenever a script is freed, as they may refer to its data.
+ */
+struct SendCache {
+	const byte *objectData;
+	reg_t species;
+	reg_t superClass;
+	Selector selector;
+	SelectorType type;
+	int varindex;
+	reg_t funcp;
+	uint32 generation; ///< Value of Script::getGeneration() when the lookup was done
+
+	SendCache() : objectData(nullptr), species(NULL_REG), superClass(NULL_REG), selector(0), type(kSelectorNone),
+		varindex(0), funcp(NULL_REG), generation(0) {}
+};
+
+/**
+ * A PMachine instruction decoded by readPMachineInstruction(), as returned
+ * by Script::getInstruction().
+ */
+struct PMachineInstruction {
+	int16 opparams[4];
+	uint16 size; ///< Length in bytes, 0 if the instruction has not been decoded yet
+	byte extOpcode;
+	/**
+	 * Whether the next instruction can be run right after this one, without
+	 * the checks done between instructions. This is the case for lofsa
+	 * followed by push, and for push followed by send.
+	 */
+	bool fusedWithNext;
+	SendCache *sendCache; ///< Lookup cache of send instructions, nullptr for other instructions
+};
+
 enum ExecStackType {
 	EXEC_STACK_TYPE_CALL = 0,
 	EXEC_STACK_TYPE_KERNEL = 1,
@@ -356,10 +395,12 @@ ExecStack *execute_method(EngineState *s, uint16 script, uint16 pubfunct,
  * 						[selector_number][argument_counter] and then
  * 						"argument_counter" word entries with the
  * 						parameter values.
+ * @param[in] cache		Cache for the lookup of the first selector, or
+ * 						nullptr
  * @return				A pointer to the new execution stack TOS entry
  */
 ExecStack *send_selector(EngineState *s, reg_t send_obj, reg_t work_obj,
-	StackPtr sp, int framesize, StackPtr argp);
+	StackPtr sp, int framesize, StackPtr argp, SendCache *cache = nullptr);
 
 
 /**
@@ -399,6 +440,13 @@ void script_debug(EngineState *s);
 SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
 		ObjVarRef *varp, reg_t *fptr);
 
+/**
+ * Looks up a selector like above, reusing the previous result stored in
+ * the cache if it applies to the object, and storing the result otherwise.
+ */
+SelectorType lookupSelector(SegManager *segMan, reg_t obj, Selector selectorid,
+		ObjVarRef *varp, reg_t *fptr, SendCache &cache);
+
 /**
  * Read a PMachine instruction from a memory buffer and return its length.
  *
@@ -90,7 +90,7 @@ void CelObj::init() {
 	_drawBlackLines = false;
 	_nextCacheId = 1;
 	_scaler = new CelScaler();
-	_cache = new CelCache(100);
+	_cache = new CelCache(kCelCacheSize);
 }
 
 void CelObj::deinit() {
@@ -516,6 +516,12 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 	const Common::Point &scaledPosition = screenItem._scaledPosition;
 	const Ratio &scaleX = screenItem._ratioX;
 	const Ratio &scaleY = screenItem._ratioY;
+
+	if (scaleX.isOne() && scaleY.isOne()) {
+		drawNoScale(target, targetRect, scaledPosition, _drawMirrored);
+		return;
+	}
+
 	_drawBlackLines = screenItem._drawBlackLines;
 
 	if (_remap) {
@@ -523,83 +529,89 @@ void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Re
 		// since we are already in a `_remap` branch, there is no reason to
 		// check that again
 		if (g_sci->_gfxRemap32->getRemapCount()) {
-			if (scaleX.isOne() && scaleY.isOne()) {
-				if (_compressionType == kCelCompressionNone) {
-					if (_drawMirrored) {
-						drawUncompHzFlipMap(target, targetRect, scaledPosition);
-					} else {
-						drawUncompNoFlipMap(target, targetRect, scaledPosition);
-					}
+			if (_compressionType == kCelCompressionNone) {
+				scaleDrawUncompMap(target, scaleX, scaleY, targetRect, scaledPosition);
+			} else {
+				scaleDrawMap(target, scaleX, scaleY, targetRect, scaledPosition);
+			}
+		} else {
+			if (_compressionType == kCelCompressionNone) {
+				scaleDrawUncomp(target, scaleX, scaleY, targetRect, scaledPosition);
+			} else {
+				scaleDraw(target, scaleX, scaleY, targetRect, scaledPosition);
+			}
+		}
+	} else {
+		if (_compressionType == kCelCompressionNone) {
+			scaleDrawUncompNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
+		} else {
+			scaleDrawNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
+		}
+	}
+
+	_drawBlackLines = false;
+}
+
+void CelObj::drawUnscaled(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX) const {
+	drawNoScale(target, targetRect, screenItem._scaledPosition, mirrorX);
+}
+
+void CelObj::drawNoScale(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX) const {
+	// The unscaled renderers never draw black lines, so unlike the scaling
+	// path this does not need to touch `_drawBlackLines`
+	if (_remap) {
+		if (g_sci->_gfxRemap32->getRemapCount()) {
+			if (_compressionType == kCelCompressionNone) {
+				if (mirrorX) {
+					drawUncompHzFlipMap(target, targetRect, scaledPosition);
 				} else {
-					if (_drawMirrored) {
-						drawHzFlipMap(target, targetRect, scaledPosition);
-					} else {
-						drawNoFlipMap(target, targetRect, scaledPosition);
-					}
+					drawUncompNoFlipMap(target, targetRect, scaledPosition);
 				}
 			} else {
-				if (_compressionType == kCelCompressionNone) {
-					scaleDrawUncompMap(target, scaleX, scaleY, targetRect, scaledPosition);
+				if (mirrorX) {
+					drawHzFlipMap(target, targetRect, scaledPosition);
 				} else {
-					scaleDrawMap(target, scaleX, scaleY, targetRect, scaledPosition);
+					drawNoFlipMap(target, targetRect, scaledPosition);
 				}
 			}
 		} else {
-			if (scaleX.isOne() && scaleY.isOne()) {
-				if (_compressionType == kCelCompressionNone) {
-					if (_drawMirrored) {
-						drawUncompHzFlip(target, targetRect, scaledPosition);
-					} else {
-						drawUncompNoFlip(target, targetRect, scaledPosition);
-					}
+			if (_compressionType == kCelCompressionNone) {
+				if (mirrorX) {
+					drawUncompHzFlip(target, targetRect, scaledPosition);
 				} else {
-					if (_drawMirrored) {
-						drawHzFlip(target, targetRect, scaledPosition);
-					} else {
-						drawNoFlip(target, targetRect, scaledPosition);
-					}
+					drawUncompNoFlip(target, targetRect, scaledPosition);
 				}
 			} else {
-				if (_compressionType == kCelCompressionNone) {
-					scaleDrawUncomp(target, scaleX, scaleY, targetRect, scaledPosition);
+				if (mirrorX) {
+					drawHzFlip(target, targetRect, scaledPosition);
 				} else {
-					scaleDraw(target, scaleX, scaleY, targetRect, scaledPosition);
+					drawNoFlip(target, targetRect, scaledPosition);
 				}
 			}
 		}
 	} else {
-		if (scaleX.isOne() && scaleY.isOne()) {
-			if (_compressionType == kCelCompressionNone) {
-				if (_transparent) {
-					if (_drawMirrored) {
-						drawUncompHzFlipNoMD(target, targetRect, scaledPosition);
-					} else {
-						drawUncompNoFlipNoMD(target, targetRect, scaledPosition);
-					}
+		if (_compressionType == kCelCompressionNone) {
+			if (_transparent) {
+				if (mirrorX) {
+					drawUncompHzFlipNoMD(target, targetRect, scaledPosition);
 				} else {
-					if (_drawMirrored) {
-						drawUncompHzFlipNoMDNoSkip(target, targetRect, scaledPosition);
-					} else {
-						drawUncompNoFlipNoMDNoSkip(target, targetRect, scaledPosition);
-					}
+					drawUncompNoFlipNoMD(target, targetRect, scaledPosition);
 				}
 			} else {
-				if (_drawMirrored) {
-					drawHzFlipNoMD(target, targetRect, scaledPosition);
+				if (mirrorX) {
+					drawUncompHzFlipNoMDNoSkip(target, targetRect, scaledPosition);
 				} else {
-					drawNoFlipNoMD(target, targetRect, scaledPosition);
+					drawUncompNoFlipNoMDNoSkip(target, targetRect, scaledPosition);
 				}
 			}
 		} else {
-			if (_compressionType == kCelCompressionNone) {
-				scaleDrawUncompNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
+			if (mirrorX) {
+				drawHzFlipNoMD(target, targetRect, scaledPosition);
 			} else {
-				scaleDrawNoMD(target, scaleX, scaleY, targetRect, scaledPosition);
+				drawNoFlipNoMD(target, targetRect, scaledPosition);
 			}
 		}
 	}
-
-	_drawBlackLines = false;
 }
 
 void CelObj::draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, bool mirrorX) {
@@ -691,6 +703,17 @@ CelCache *CelObj::_cache = nullptr;
 
 int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) const {
 	*nextInsertIndex = -1;
+
+	const CelCache::IndexMap::const_iterator it = _cache->index.find(celInfo);
+	if (it != _cache->index.end()) {
+		++_cache->hits;
+		(*_cache)[it->_value].id = ++_nextCacheId;
+		return it->_value;
+	}
+
+	++_cache->misses;
+
+	// Only a miss needs to look at every slot, to find the one to replace
 	int oldestId = _nextCacheId + 1;
 	int oldestIndex = 0;
 
@@ -701,9 +724,6 @@ int CelObj::searchCache(const CelInfo32 &celInfo, int *const nextInsertIndex) co
 			if (*nextInsertIndex == -1) {
 				*nextInsertIndex = i;
 			}
-		} else if (entry.celObj->_info == celInfo) {
-			entry.id = ++_nextCacheId;
-			return i;
 		} else if (oldestId > entry.id) {
 			oldestId = entry.id;
 			oldestIndex = i;
@@ -723,8 +743,12 @@ void CelObj::putCopyInCache(const int cacheIndex) const {
 	}
 
 	CelCacheEntry &entry = (*_cache)[cacheIndex];
+	if (entry.celObj) {
+		_cache->index.erase(entry.celObj->_info);
+	}
 	entry.celObj.reset(duplicate());
 	entry.id = ++_nextCacheId;
+	_cache->index[_info] = cacheIndex;
 }
 
 #pragma mark -
@@ -1362,6 +1386,9 @@ void CelObjColor::draw(Buffer &target, const Common::Rect &targetRect, const Com
 void CelObjColor::draw(Buffer &target, const Common::Rect &targetRect) const {
 	target.fillRect(targetRect, translateMacColor(_isMacSource, _info.color));
 }
+void CelObjColor::drawUnscaled(Buffer &target, const ScreenItem &, const Common::Rect &targetRect, const bool) const {
+	draw(target, targetRect);
+}
 
 CelObjColor *CelObjColor::duplicate() const {
 	return new CelObjColor(*this);
@@ -22,6 +22,7 @@
 #ifndef SCI_GRAPHICS_CELOBJ32_H
 #define SCI_GRAPHICS_CELOBJ32_H
 
+#include "common/hashmap.h"
 #include "common/rational.h"
 #include "common/rect.h"
 #include "sci/resource/resource.h"
@@ -105,7 +106,7 @@ struct CelInfo32 {
 
 	// This is the equivalence criteria used by CelObj::searchCache in at least
 	// SSCI SQ6. Notably, it does not check the color field.
-	inline bool operator==(const CelInfo32 &other) {
+	inline bool operator==(const CelInfo32 &other) const {
 		return (
 			type == other.type &&
 			resourceId == other.resourceId &&
@@ -115,7 +116,7 @@ struct CelInfo32 {
 		);
 	}
 
-	inline bool operator!=(const CelInfo32 &other) {
+	inline bool operator!=(const CelInfo32 &other) const {
 		return !(*this == other);
 	}
 
@@ -149,7 +150,57 @@ struct CelCacheEntry {
 	CelCacheEntry() : id(0) {}
 };
 
-typedef Common::Array<CelCacheEntry> CelCache;
+/**
+ * Hashes the same fields of a CelInfo32 that its equality operator compares.
+ */
+struct CelInfo32_Hash {
+	uint operator()(const CelInfo32 &info) const {
+		uint hash = info.type;
+		hash = hash * 31 + info.resourceId;
+		hash = hash * 31 + (uint16)info.loopNo;
+		hash = hash * 31 + (uint16)info.celNo;
+		hash = hash * 31 + info.bitmap.getSegment();
+		return hash * 31 + info.bitmap.getOffset();
+	}
+};
+
+struct CelInfo32_EqualTo {
+	bool operator()(const CelInfo32 &x, const CelInfo32 &y) const {
+		return x == y;
+	}
+};
+
+enum {
+	/**
+	 * The number of cel objects kept in the cel cache. SSCI kept 100, but
+	 * high resolution games with many animated screen items cycle through
+	 * more cels than that in a single room.
+	 */
+	kCelCacheSize = 256
+};
+
+/**
+ * A fixed number of cached cel objects, with an index from CelInfo32 to the
+ * slot holding the matching cel so that lookups do not need to scan every
+ * slot.
+ */
+struct CelCache {
+	typedef Common::HashMap<CelInfo32, uint, CelInfo32_Hash, CelInfo32_EqualTo> IndexMap;
+
+	Common::Array<CelCacheEntry> entries;
+	IndexMap index;
+
+	/**
+	 * The number of lookups which found or missed a cached cel since the cache
+	 * was created.
+	 */
+	uint32 hits, misses;
+
+	CelCache(const uint size) : entries(size), hits(0), misses(0) {}
+
+	CelCacheEntry &operator[](const uint i) { return entries[i]; }
+	uint size() const { return entries.size(); }
+};
 
 #pragma mark -
 #pragma mark CelScaler
@@ -389,6 +440,15 @@ public:
 	 */
 	void drawTo(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const Ratio &scaleX, const Ratio &scaleY) const;
 
+	/**
+	 * Draws the cel unscaled to the target buffer using the position from the
+	 * given screen item and the given mirror flag. Unlike the other draw
+	 * methods, this does not change any state of the cel or any static
+	 * member, so several threads may draw different parts of the target
+	 * buffer at once.
+	 */
+	virtual void drawUnscaled(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX) const;
+
 	/**
 	 * Creates a copy of this cel on the free store and returns a pointer to the
 	 * new object. The new cel will point to a shared copy of bitmap/resource
@@ -439,6 +499,12 @@ private:
 	// SSCI includes versions of the above functions with priority parameters
 	// which are not actually used in SCI32
 
+	/**
+	 * Picks the unscaled renderer for this cel, the same way draw does for
+	 * unscaled screen items.
+	 */
+	void drawNoScale(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX) const;
+
 	void drawHzFlipNoMD(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
 	void drawNoFlipNoMD(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
 	void drawUncompNoFlipNoMD(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition) const;
@@ -477,6 +543,12 @@ protected:
 	 * Puts a copy of this CelObj into the cache at the given cache index.
 	 */
 	void putCopyInCache(int index) const;
+
+public:
+	/**
+	 * Returns the cel cache, for statistics display in the debugger.
+	 */
+	static const CelCache *getCache() { return _cache; }
 };
 
 #pragma mark -
@@ -599,6 +671,7 @@ public:
 	void draw(Buffer &target, const Common::Rect &targetRect) const;
 	void draw(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX) override;
 	void draw(Buffer &target, const Common::Rect &targetRect, const Common::Point &scaledPosition, const bool mirrorX) override;
+	void drawUnscaled(Buffer &target, const ScreenItem &screenItem, const Common::Rect &targetRect, const bool mirrorX) const override;
 
 	CelObjColor *duplicate() const override;
 	const SciSpan<const byte> getResPointer() const override;
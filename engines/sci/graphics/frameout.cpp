@@ -27,6 +27,7 @@
 #include "common/str.h"
 #include "common/system.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "engines/engine.h"
 #include "engines/util.h"
 #include "graphics/palette.h"
@@ -59,6 +60,55 @@
 
 namespace Sci {
 
+enum {
+	/**
+	 * The height of the bands of the screen buffer that are drawn by the
+	 * render threads.
+	 */
+	kRenderBandHeight = 32,
+
+	/**
+	 * The smallest number of pixels in a draw list that is split between the
+	 * render threads. Waking the threads costs more than drawing fewer pixels
+	 * on the calling thread.
+	 */
+	kMinParallelDrawArea = 32 * 1024
+};
+
+/**
+ * The horizontal bands of the screen buffer that unscaled screen items are
+ * drawn into, as drawn by Common::ThreadPool::parallelFor().
+ *
+ * Every band is drawn by one thread, which draws all screen items of the draw
+ * list in order, clipped to the band. The bands do not overlap, so the result
+ * is the same as drawing the whole list on a single thread, including
+ * remapped pixels which depend on what is already in the buffer.
+ */
+struct DrawListBands {
+	Buffer *target;
+	const DrawList *drawList;
+	const Common::Array<Common::Rect> *bands;
+
+	static void draw(void *data, uint begin, uint end) {
+		const DrawListBands *job = (const DrawListBands *)data;
+		const DrawList::size_type drawListSize = job->drawList->size();
+
+		for (uint b = begin; b < end; ++b) {
+			const Common::Rect &band = (*job->bands)[b];
+			for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+				const DrawItem &drawItem = *(*job->drawList)[i];
+				if (!drawItem.rect.intersects(band)) {
+					continue;
+				}
+
+				const ScreenItem &screenItem = *drawItem.screenItem;
+				const CelObj &celObj = *screenItem._celObj;
+				celObj.drawUnscaled(*job->target, screenItem, drawItem.rect.findIntersectingRect(band), screenItem._mirrorX ^ celObj._mirrorX);
+			}
+		}
+	}
+};
+
 GfxFrameout::GfxFrameout(SegManager *segMan, GfxPalette32 *palette, GfxTransitions32 *transitions, GfxCursor32 *cursor) :
 	_isHiRes(detectHiRes()),
 	_palette(palette),
@@ -1000,15 +1050,87 @@ void GfxFrameout::drawEraseList(const RectList &eraseList, const Plane &plane) {
 
 void GfxFrameout::drawScreenItemList(const DrawList &screenItemList) {
 	const DrawList::size_type drawListSize = screenItemList.size();
+	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+		mergeToShowList(screenItemList[i]->rect, _showList, _overdrawThreshold);
+	}
+
+	if (drawScreenItemListInBands(screenItemList)) {
+		return;
+	}
+
 	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
 		const DrawItem &drawItem = *screenItemList[i];
-		mergeToShowList(drawItem.rect, _showList, _overdrawThreshold);
 		const ScreenItem &screenItem = *drawItem.screenItem;
 		CelObj &celObj = *screenItem._celObj;
 		celObj.draw(_currentBuffer, screenItem, drawItem.rect, screenItem._mirrorX ^ celObj._mirrorX);
 	}
 }
 
+bool GfxFrameout::drawScreenItemListInBands(const DrawList &screenItemList) {
+	if (ThreadPoolMan.getThreadCount() == 0) {
+		return false;
+	}
+
+	// Scaled cels share the scale tables of CelObj and set its static black
+	// lines flag while drawing, so only lists of unscaled cels are split
+	Common::Rect bounds;
+	int area = 0;
+	const DrawList::size_type drawListSize = screenItemList.size();
+	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+		const DrawItem &drawItem = *screenItemList[i];
+		const ScreenItem &screenItem = *drawItem.screenItem;
+		if (!screenItem._ratioX.isOne() || !screenItem._ratioY.isOne()) {
+			return false;
+		}
+
+		if (i == 0) {
+			bounds = drawItem.rect;
+		} else {
+			bounds.extend(drawItem.rect);
+		}
+		area += drawItem.rect.width() * drawItem.rect.height();
+	}
+
+	if (area < kMinParallelDrawArea) {
+		return false;
+	}
+
+	// View and pic cels look up their resource data every time they are
+	// drawn. Locking the resources here first means these lookups only read
+	// the resource manager, and the lookups here already freed any resources
+	// over the cache budget, so the render threads never change it.
+	ResourceManager *resMan = g_sci->getResMan();
+	Common::Array<Resource *> lockedResources;
+	lockedResources.reserve(drawListSize);
+	for (DrawList::size_type i = 0; i < drawListSize; ++i) {
+		const CelInfo32 &celInfo = screenItemList[i]->screenItem->_celObj->_info;
+		Resource *resource = nullptr;
+		if (celInfo.type == kCelTypeView) {
+			resource = resMan->findResource(ResourceId(kResourceTypeView, celInfo.resourceId), true);
+		} else if (celInfo.type == kCelTypePic) {
+			resource = resMan->findResource(ResourceId(kResourceTypePic, celInfo.resourceId), true);
+		}
+
+		if (resource) {
+			lockedResources.push_back(resource);
+		}
+	}
+
+	Common::Array<Common::Rect> bands;
+	for (int16 top = bounds.top; top < bounds.bottom; top += kRenderBandHeight) {
+		bands.push_back(Common::Rect(bounds.left, top, bounds.right, MIN<int16>(top + kRenderBandHeight, bounds.bottom)));
+	}
+
+	DrawListBands job = { &_currentBuffer, &screenItemList, &bands };
+	ThreadPoolMan.parallelFor(0, bands.size(), 1, DrawListBands::draw, &job);
+
+	for (uint i = 0; i < lockedResources.size(); ++i) {
+		resMan->unlockResource(lockedResources[i]);
+	}
+
+	return true;
+}
+
 void GfxFrameout::mergeToShowList(const Common::Rect &drawRect, RectList &showList, const int overdrawThreshold) {
 	RectList mergeList;
 	Common::Rect merged;
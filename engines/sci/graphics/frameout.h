@@ -368,6 +368,13 @@ private:
 	 */
 	void drawScreenItemList(const DrawList &screenItemList);
 
+	/**
+	 * Draws the given draw list on several threads, if it is worth it and
+	 * all of its screen items can be drawn concurrently. Returns false, with
+	 * nothing drawn, otherwise.
+	 */
+	bool drawScreenItemListInBands(const DrawList &screenItemList);
+
 	/**
 	 * Adds a new rectangle to the list of regions to write out to the hardware.
 	 * The provided rect may be merged into an existing rectangle to reduce the
@@ -423,7 +423,8 @@ void ResourceManager::disposeVolumeFileStream(Common::SeekableReadStream *fileSt
 }
 
 void ResourceManager::loadResource(Resource *res) {
-	res->_source->loadResource(this, res);
+	if (!takePrefetchedResource(res))
+		res->_source->loadResource(this, res);
 	if (_patcher) {
 		_patcher->applyPatch(*res);
 	};
@@ -1084,6 +1085,12 @@ void ResourceManager::init() {
 		_maxMemoryLRU = 4096 * 1024; // 4MiB
 	}
 
+	if (ConfMan.hasKey("resource_cache_size"))
+		_maxMemoryLRU = MAX(ConfMan.getInt("resource_cache_size"), 0) * 1024;
+
+	if (!_detectionMode)
+		MemTracker.registerConsumer(this);
+
 	switch (_viewType) {
 	case kViewEga:
 		debugC(1, kDebugLevelResMan, "resMan: Detected EGA graphic resources");
@@ -1110,6 +1117,9 @@ void ResourceManager::init() {
 }
 
 ResourceManager::~ResourceManager() {
+	MemTracker.unregisterConsumer(this);
+	cancelPrefetch();
+
 	// freeing resources
 	ResourceMap::iterator itr = _resMap.begin();
 	while (itr != _resMap.end()) {
@@ -1167,18 +1177,60 @@ void ResourceManager::printLRU() {
 	debug("Total: %d entries, %d bytes (mgr says %d)", entries, mem, _memoryLRU);
 }
 
+enum ResourceCachePriority {
+	kCachePriorityLow,    ///< Freed first
+	kCachePriorityNormal,
+	kCachePriorityHigh    ///< Only freed when nothing else is left
+};
+
+static ResourceCachePriority getCachePriority(ResourceType type) {
+	switch (type) {
+	// Audio is played as it is loaded, and rarely needed again soon
+	case kResourceTypeAudio:
+	case kResourceTypeAudio36:
+	case kResourceTypeSync:
+	case kResourceTypeSync36:
+	case kResourceTypeRave:
+		return kCachePriorityLow;
+	// Small, and needed again by every room using them
+	case kResourceTypeScript:
+	case kResourceTypeHeap:
+	case kResourceTypeVocab:
+		return kCachePriorityHigh;
+	default:
+		return kCachePriorityNormal;
+	}
+}
+
 void ResourceManager::freeOldResources() {
-	while (_maxMemoryLRU < _memoryLRU) {
-		assert(!_LRU.empty());
-		Resource *goner = _LRU.back();
-		removeFromLRU(goner);
-		goner->unalloc();
+	// Free the least recently used resources of the lowest priority first
+	for (int priority = kCachePriorityLow; priority <= kCachePriorityHigh && _maxMemoryLRU < _memoryLRU; priority++) {
+		Common::List<Resource *>::iterator it = _LRU.reverse_begin();
+		while (_maxMemoryLRU < _memoryLRU && it != _LRU.end()) {
+			Resource *goner = *it;
+			--it;
+			if (getCachePriority(goner->getType()) != priority)
+				continue;
+
+			removeFromLRU(goner);
+			goner->unalloc();
 #ifdef SCI_VERBOSE_RESMAN
-		debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
+			debug("resMan-debug: LRU: Freeing %s (%d bytes)", goner->_id.toString().c_str(), goner->size);
 #endif
+		}
 	}
 }
 
+size_t ResourceManager::shrinkMemoryUsage(size_t bytes) {
+	// Only the resources under LRU control can be freed
+	const int oldMemory = _memoryLRU;
+	const int maxMemory = _maxMemoryLRU;
+	_maxMemoryLRU = oldMemory - (int)MIN<size_t>(bytes, oldMemory);
+	freeOldResources();
+	_maxMemoryLRU = maxMemory;
+	return oldMemory - _memoryLRU;
+}
+
 Common::List<ResourceId> ResourceManager::listResources(ResourceType type, int mapNumber) {
 	Common::List<ResourceId> resources;
 
@@ -1229,6 +1281,7 @@ Resource *ResourceManager::findResource(ResourceId id, bool lock) {
 	// locked or allocated, but never queued or freed.
 
 	freeOldResources();
+	MemTracker.checkBudget();
 
 	if (lock) {
 		if (retval->_status == kResStatusAllocated) {
@@ -1267,6 +1320,111 @@ void ResourceManager::unlockResource(Resource *res) {
 	freeOldResources();
 }
 
+void ResourceManager::prefetchRoom(uint16 roomNumber) {
+	cancelPrefetch();
+
+	addPrefetchJob(ResourceId(kResourceTypeScript, roomNumber));
+	addPrefetchJob(ResourceId(kResourceTypeHeap, roomNumber));
+	addPrefetchJob(ResourceId(kResourceTypePic, roomNumber));
+
+	if (!_prefetchJobs.empty() && !_prefetchThread.start(prefetchThreadProc, this))
+		cancelPrefetch();
+}
+
+void ResourceManager::addPrefetchJob(ResourceId id) {
+	Resource *res = testResource(id);
+	if (!res || res->_status != kResStatusNoMalloc)
+		return;
+
+	// Other sources need the resource manager, or are already in memory
+	ResourceSource *source = res->_source;
+	if (source->getSourceType() != kSourceVolume)
+		return;
+
+	// The cached volume files are used by the main thread, so the prefetch
+	// thread reads from a stream of its own
+	Common::SeekableReadStream *file;
+	if (source->_resourceFile) {
+		file = source->_resourceFile->createReadStream();
+	} else {
+		Common::File *volumeFile = new Common::File;
+		if (!volumeFile->open(source->getLocationName())) {
+			delete volumeFile;
+			volumeFile = nullptr;
+		}
+		file = volumeFile;
+	}
+
+	if (!file)
+		return;
+
+	PrefetchJob job;
+	job.id = id;
+	job.source = source;
+	job.fileOffset = res->_fileOffset;
+	job.file = file;
+	job.result = nullptr;
+	_prefetchJobs.push_back(job);
+}
+
+void ResourceManager::prefetchThreadProc(void *data) {
+	ResourceManager *resMan = (ResourceManager *)data;
+
+	for (uint i = 0; i < resMan->_prefetchJobs.size(); i++) {
+		PrefetchJob &job = resMan->_prefetchJobs[i];
+
+		// This only touches the copy, the stream of the job, and parts of
+		// the resource manager which don't change after init()
+		Resource *res = new Resource(resMan, job.id);
+		job.file->seek(job.fileOffset, SEEK_SET);
+		if (res->decompress(resMan->_volVersion, job.file) || res->_id != job.id) {
+			delete res;
+			res = nullptr;
+		}
+		job.result = res;
+	}
+}
+
+void ResourceManager::cancelPrefetch() {
+	_prefetchThread.join();
+
+	for (uint i = 0; i < _prefetchJobs.size(); i++) {
+		delete _prefetchJobs[i].file;
+		delete _prefetchJobs[i].result;
+	}
+	_prefetchJobs.clear();
+}
+
+bool ResourceManager::takePrefetchedResource(Resource *res) {
+	for (uint i = 0; i < _prefetchJobs.size(); i++) {
+		if (_prefetchJobs[i].id != res->_id)
+			continue;
+
+		_prefetchThread.join();
+
+		PrefetchJob &job = _prefetchJobs[i];
+		Resource *copy = job.result;
+		job.result = nullptr;
+
+		// The resource may have been replaced by a patch since
+		if (!copy || res->_source != job.source || res->_fileOffset != job.fileOffset) {
+			delete copy;
+			return false;
+		}
+
+		res->_data = copy->_data;
+		res->_size = copy->_size;
+		res->_status = kResStatusAllocated;
+		copy->_data = nullptr;
+		delete copy;
+
+		debugC(kDebugLevelResMan, 2, "[resMan] Using prefetched %s", res->_id.toString().c_str());
+		return true;
+	}
+
+	return false;
+}
+
 const char *ResourceManager::versionDescription(ResVersion version) const {
 	switch (version) {
 	case kResVersionUnknown:
@@ -23,8 +23,11 @@
 #define SCI_RESOURCE_RESOURCE_H
 
 #include "common/str.h"
+#include "common/array.h"
 #include "common/list.h"
 #include "common/hashmap.h"
+#include "common/memtracker.h"
+#include "common/thread.h"
 
 #include "sci/graphics/helpers.h"		// for ViewType
 #include "sci/resource/decompressor.h"
@@ -312,7 +315,7 @@ protected:
 typedef Common::HashMap<ResourceId, Resource *, ResourceIdHash> ResourceMap;
 
 class IntMapResourceSource;
-class ResourceManager {
+class ResourceManager : public Common::MemoryConsumer {
 	// FIXME: These 'friend' declarations are meant to be a temporary hack to
 	// ease transition to the ResourceSource class system.
 	friend class ResourceSource;
@@ -342,6 +345,11 @@ public:
 	 */
 	void init();
 
+	// Common::MemoryConsumer API
+	const char *getMemoryConsumerName() const override { return "SCI resources"; }
+	size_t getMemoryUsage() const override { return _memoryLRU + _memoryLocked; }
+	size_t shrinkMemoryUsage(size_t bytes) override;
+
 	/**
 	 * Adds all of the resource files for a game
 	 */
@@ -368,6 +376,14 @@ public:
 	 */
 	void unlockResource(Resource *res);
 
+	/**
+	 * Starts loading the script, heap and pic of a room on a background
+	 * thread, so that they are already in memory when the room asks for
+	 * them. Does nothing if the backend doesn't support threads.
+	 * @param roomNumber	The number of the room being entered
+	 */
+	void prefetchRoom(uint16 roomNumber);
+
 	/**
 	 * Tests whether a resource exists.
 	 *
@@ -481,6 +497,7 @@ protected:
 	// Note: maxMemory will not be interpreted as a hard limit, only as a restriction
 	// for resources which are not explicitly locked. However, a warning will be
 	// issued whenever this limit is exceeded.
+	// Can be set in KiB with the "resource_cache_size" config key.
 	int _maxMemoryLRU;
 
 	ViewType _viewType; // Used to determine if the game has EGA or VGA graphics
@@ -491,6 +508,21 @@ protected:
 	Common::List<Resource *> _LRU; ///< Last Resource Used list
 	ResourceMap _resMap;
 	Common::List<Common::File *> _volumeFiles; ///< list of opened volume files
+
+	/**
+	 * A resource loaded by the prefetch thread. The main thread sets up
+	 * everything but the result before starting the thread, and only looks
+	 * at the result once the thread has been joined.
+	 */
+	struct PrefetchJob {
+		ResourceId id;
+		ResourceSource *source;
+		int32 fileOffset;
+		Common::SeekableReadStream *file; ///< A stream of the volume file, for use by the prefetch thread only
+		Resource *result; ///< A loaded copy of the resource, or nullptr if loading failed
+	};
+	Common::Array<PrefetchJob> _prefetchJobs;
+	Common::Thread _prefetchThread;
 	ResourceSource *_audioMapSCI1; ///< Currently loaded audio map for SCI1
 	ResVersion _volVersion; ///< resource.0xx version
 	ResVersion _mapVersion; ///< resource.map version
@@ -550,6 +582,20 @@ protected:
 	void disposeVolumeFileStream(Common::SeekableReadStream *fileStream, ResourceSource *source);
 	void loadResource(Resource *res);
 	void freeOldResources();
+
+	static void prefetchThreadProc(void *data);
+	void addPrefetchJob(ResourceId id);
+	/**
+	 * Waits for the prefetch thread, then drops the resources which weren't
+	 * asked for.
+	 */
+	void cancelPrefetch();
+	/**
+	 * Takes over the data of a prefetched copy of the resource, waiting for
+	 * the prefetch thread if needed.
+	 * @return	True if there was a usable copy
+	 */
+	bool takePrefetchedResource(Resource *res);
 	bool validateResource(const ResourceId &resourceId, const Common::String &sourceMapLocation, const Common::String &sourceName, const uint32 offset, const uint32 size, const uint32 sourceSize) const;
 	Resource *addResource(ResourceId resId, ResourceSource *src, uint32 offset, uint32 size = 0, const Common::String &sourceMapLocation = Common::String("(no map location)"));
 	Resource *updateResource(ResourceId resId, ResourceSource *src, uint32 size, const Common::String &sourceMapLocation = Common::String("(no map location)"));
@@ -618,6 +618,11 @@ void RobotDecoder::close() {
 	_recordPositions.clear();
 	_celDecompressionBuffer.clear();
 	_doVersion5Scratch.clear();
+	for (int i = 0; i < kLookaheadFrames; ++i) {
+		dropLookaheadFrame(_lookaheadFrames[i]);
+		_lookaheadFrames[i].videoData.clear();
+		_lookaheadFrames[i].pixels.clear();
+	}
 	delete _stream;
 	_stream = nullptr;
 }
@@ -1247,6 +1252,7 @@ void RobotDecoder::doRobot() {
 	if (_hasAudio) {
 		_audioList.submitDriverMax();
 	}
+	readAhead();
 }
 
 void RobotDecoder::frameAlmostVisible() {
@@ -1363,13 +1369,21 @@ void RobotDecoder::setPriority(const int16 newPriority) {
 
 void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 	const RobotScreenItemList::size_type oldScreenItemCount = _screenItemList.size();
-	const int videoSize = _videoSizes[_currentFrameNo];
-	_doVersion5Scratch.resize(videoSize);
+	LookaheadFrame *lookahead = findLookaheadFrame(_currentFrameNo);
+
+	byte *videoFrameData;
+	if (lookahead != nullptr) {
+		lookahead->done.wait();
+		videoFrameData = lookahead->videoData.begin();
+	} else {
+		const int videoSize = _videoSizes[_currentFrameNo];
+		_doVersion5Scratch.resize(videoSize);
 
-	byte *videoFrameData = _doVersion5Scratch.begin();
+		videoFrameData = _doVersion5Scratch.begin();
 
-	if (!_stream->read(videoFrameData, videoSize)) {
-		error("RobotDecoder::doVersion5: Read error");
+		if (!_stream->read(videoFrameData, videoSize)) {
+			error("RobotDecoder::doVersion5: Read error");
+		}
 	}
 
 	const RobotScreenItemList::size_type screenItemCount = READ_SCI11ENDIAN_UINT16(videoFrameData);
@@ -1394,7 +1408,12 @@ void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 		_originalScreenItemY.resize(screenItemCount);
 	}
 
-	createCels5(videoFrameData + 2, screenItemCount, true);
+	const byte *decompressedPixels = nullptr;
+	if (lookahead != nullptr && lookahead->decompressed) {
+		decompressedPixels = lookahead->pixels.begin();
+	}
+
+	createCels5(videoFrameData + 2, screenItemCount, true, decompressedPixels);
 	for (RobotScreenItemList::size_type i = 0; i < screenItemCount; ++i) {
 		Common::Point position(_screenItemX[i], _screenItemY[i]);
 
@@ -1447,14 +1466,14 @@ void RobotDecoder::doVersion5(const bool shouldSubmitAudio) {
 	}
 }
 
-void RobotDecoder::createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette) {
+void RobotDecoder::createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette, const byte *decompressedPixels) {
 	preallocateCelMemory(rawVideoData, numCels);
 	for (int16 i = 0; i < numCels; ++i) {
-		rawVideoData += createCel5(rawVideoData, i, usePalette);
+		rawVideoData += createCel5(rawVideoData, i, usePalette, decompressedPixels);
 	}
 }
 
-uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette) {
+uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette, const byte *&decompressedPixels) {
 	_verticalScaleFactor = rawVideoData[1];
 	const int16 celWidth = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 2);
 	const int16 celHeight = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 4);
@@ -1513,6 +1532,28 @@ uint32 RobotDecoder::createCel5(const byte *rawVideoData, const int16 screenItem
 	assert(bitmap.getHunkPaletteOffset() == (uint32)bitmap.getWidth() * bitmap.getHeight() + SciBitmap::getBitmapHeaderSize());
 	bitmap.setOrigin(origin);
 
+	if (decompressedPixels != nullptr) {
+		// the lookahead worker already decompressed the cel
+		uint celSize = 0;
+		for (int i = 0; i < numDataChunks; ++i) {
+			celSize += READ_SCI11ENDIAN_UINT32(rawVideoData + 4);
+			rawVideoData += 10 + READ_SCI11ENDIAN_UINT32(rawVideoData);
+		}
+
+		if (_verticalScaleFactor == 100) {
+			Common::copy(decompressedPixels, decompressedPixels + celSize, bitmap.getPixels());
+		} else {
+			expandCel(bitmap.getPixels(), decompressedPixels, celWidth, celHeight);
+		}
+		decompressedPixels += celSize;
+
+		if (usePalette) {
+			Common::copy(_rawPalette, _rawPalette + kRawPaletteSize, bitmap.getHunkPalette());
+		}
+
+		return kCelHeaderSize + dataSize;
+	}
+
 	byte *targetBuffer;
 	if (_verticalScaleFactor == 100) {
 		// direct copy to bitmap
@@ -1624,4 +1665,131 @@ void RobotDecoder::preallocateCelMemory(const byte *rawVideoData, const int16 nu
 	}
 }
 
+#pragma mark -
+#pragma mark RobotDecoder - Lookahead
+
+void RobotDecoder::readAhead() {
+	// Without threads, decompressing ahead would only make the frames later
+	if (ThreadPoolMan.getThreadCount() == 0) {
+		return;
+	}
+
+	// Frames which were passed or skipped are never shown anymore
+	for (int i = 0; i < kLookaheadFrames; ++i) {
+		if (_lookaheadFrames[i].frameNo != -1 && _lookaheadFrames[i].frameNo <= _currentFrameNo) {
+			dropLookaheadFrame(_lookaheadFrames[i]);
+		}
+	}
+
+	const int lastFrameNo = MIN<int>(_currentFrameNo + kLookaheadFrames, _numFramesTotal - 1);
+	for (int frameNo = _currentFrameNo + 1; frameNo <= lastFrameNo; ++frameNo) {
+		if (findLookaheadFrame(frameNo) != nullptr) {
+			continue;
+		}
+
+		LookaheadFrame *frame = findLookaheadFrame(-1);
+		if (frame == nullptr) {
+			break;
+		}
+
+		// The stream is only ever read on the main thread
+		const int videoSize = _videoSizes[frameNo];
+		frame->videoData.resize(videoSize);
+		if (!seekToFrame(frameNo) || _stream->read(frame->videoData.begin(), videoSize) != (uint32)videoSize) {
+			break;
+		}
+
+		frame->frameNo = frameNo;
+		frame->decompressed = false;
+		ThreadPoolMan.submit(frame->done, decompressLookaheadFrame, frame);
+	}
+}
+
+RobotDecoder::LookaheadFrame *RobotDecoder::findLookaheadFrame(const int frameNo) {
+	for (int i = 0; i < kLookaheadFrames; ++i) {
+		if (_lookaheadFrames[i].frameNo == frameNo) {
+			return &_lookaheadFrames[i];
+		}
+	}
+
+	return nullptr;
+}
+
+void RobotDecoder::dropLookaheadFrame(LookaheadFrame &frame) {
+	frame.done.wait();
+	frame.frameNo = -1;
+	frame.decompressed = false;
+}
+
+void RobotDecoder::decompressLookaheadFrame(void *data) {
+	LookaheadFrame &frame = *(LookaheadFrame *)data;
+	const byte *videoData = frame.videoData.begin();
+	const byte *videoDataEnd = frame.videoData.end();
+
+	// Frames which doVersion5 rejects, or which do not parse, are left to
+	// the main thread
+	const int16 numCels = (int16)READ_SCI11ENDIAN_UINT16(videoData);
+	if (numCels > kScreenItemListSize) {
+		return;
+	}
+
+	uint totalSize = 0;
+	const byte *rawVideoData = videoData + 2;
+	for (int16 cel = 0; cel < numCels; ++cel) {
+		if (rawVideoData + kCelHeaderSize > videoDataEnd) {
+			return;
+		}
+
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(rawVideoData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 16);
+		const byte *chunk = rawVideoData + kCelHeaderSize;
+		for (int i = 0; i < numDataChunks; ++i) {
+			if (chunk + 10 > videoDataEnd) {
+				return;
+			}
+
+			const uint compressedSize = READ_SCI11ENDIAN_UINT32(chunk);
+			const uint16 compressionType = READ_SCI11ENDIAN_UINT16(chunk + 8);
+			if (compressionType != kCompressionLZS && compressionType != kCompressionNone) {
+				return;
+			}
+
+			totalSize += READ_SCI11ENDIAN_UINT32(chunk + 4);
+			chunk += 10 + compressedSize;
+		}
+
+		rawVideoData += kCelHeaderSize + dataSize;
+	}
+
+	frame.pixels.resize(totalSize);
+	byte *targetBuffer = frame.pixels.begin();
+
+	rawVideoData = videoData + 2;
+	for (int16 cel = 0; cel < numCels; ++cel) {
+		const uint16 dataSize = READ_SCI11ENDIAN_UINT16(rawVideoData + 14);
+		const int16 numDataChunks = (int16)READ_SCI11ENDIAN_UINT16(rawVideoData + 16);
+		const byte *chunk = rawVideoData + kCelHeaderSize;
+		for (int i = 0; i < numDataChunks; ++i) {
+			const uint compressedSize = READ_SCI11ENDIAN_UINT32(chunk);
+			const uint decompressedSize = READ_SCI11ENDIAN_UINT32(chunk + 4);
+			const uint16 compressionType = READ_SCI11ENDIAN_UINT16(chunk + 8);
+			chunk += 10;
+
+			if (compressionType == kCompressionLZS) {
+				Common::MemoryReadStream videoDataStream(chunk, compressedSize, DisposeAfterUse::NO);
+				frame.decompressor.unpack(&videoDataStream, targetBuffer, compressedSize, decompressedSize);
+			} else {
+				Common::copy(chunk, chunk + decompressedSize, targetBuffer);
+			}
+
+			chunk += compressedSize;
+			targetBuffer += decompressedSize;
+		}
+
+		rawVideoData += kCelHeaderSize + dataSize;
+	}
+
+	frame.decompressed = true;
+}
+
 } // End of namespace Sci
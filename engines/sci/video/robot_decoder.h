@@ -28,6 +28,7 @@
 #include "common/mutex.h"                // for StackLock, Mutex
 #include "common/rect.h"                 // for Point, Rect (ptr only)
 #include "common/scummsys.h"             // for int16, int32, byte, uint16
+#include "common/threadpool.h"           // for Future
 #include "sci/engine/vm_types.h"         // for NULL_REG, reg_t
 #include "sci/graphics/helpers.h"        // for GuiResourceId
 #include "sci/graphics/screen_item32.h"  // for ScaleInfo, ScreenItem (ptr o...
@@ -1216,15 +1217,21 @@ private:
 
 	/**
 	 * Creates screen items for a version 5/6 robot.
+	 *
+	 * If `decompressedPixels` is not null, it holds the already decompressed
+	 * pixels of all cels, one after the other.
 	 */
-	void createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette);
+	void createCels5(const byte *rawVideoData, const int16 numCels, const bool usePalette, const byte *decompressedPixels = nullptr);
 
 	/**
 	 * Creates a single screen item for a cel in a version 5/6 robot.
 	 *
+	 * If `decompressedPixels` is not null, the cel is taken from there and
+	 * the pointer is moved past it.
+	 *
 	 * Returns the size, in bytes, of the raw cel data.
 	 */
-	uint32 createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette);
+	uint32 createCel5(const byte *rawVideoData, const int16 screenItemIndex, const bool usePalette, const byte *&decompressedPixels);
 
 	/**
 	 * Preallocates memory for the next `numCels` cels in the robot data stream.
@@ -1366,6 +1373,83 @@ private:
 	 * dimensions.
 	 */
 	uint8 _verticalScaleFactor;
+
+#pragma mark -
+#pragma mark Rendering - Lookahead
+private:
+	enum {
+		/**
+		 * The number of upcoming frames which are read and decompressed
+		 * ahead of time.
+		 */
+		kLookaheadFrames = 2
+	};
+
+	/**
+	 * An upcoming frame which is read ahead of time and whose cels are
+	 * decompressed on the lookahead worker thread.
+	 */
+	struct LookaheadFrame {
+		/**
+		 * The number of the frame, or -1 if the slot is free.
+		 */
+		int frameNo;
+
+		/**
+		 * The raw video data of the frame.
+		 */
+		ScratchMemory videoData;
+
+		/**
+		 * The decompressed pixels of all cels of the frame, in the order of
+		 * the video data. The buffer is kept between frames.
+		 */
+		ScratchMemory pixels;
+
+		/**
+		 * Whether `pixels` holds the cels. If not, the frame is decompressed
+		 * on the main thread like any other one.
+		 */
+		bool decompressed;
+
+		/**
+		 * The decompressor for LZS-compressed cels of this frame.
+		 */
+		DecompressorLZS decompressor;
+
+		/**
+		 * The completion of the decompression task.
+		 */
+		Common::Future done;
+
+		LookaheadFrame() : frameNo(-1), decompressed(false) {}
+	};
+
+	/**
+	 * Reads the frames following the current one and submits them to the
+	 * lookahead worker thread, dropping the frames which were passed.
+	 */
+	void readAhead();
+
+	/**
+	 * Returns the lookahead slot which holds the given frame, or null.
+	 */
+	LookaheadFrame *findLookaheadFrame(const int frameNo);
+
+	/**
+	 * Waits for the decompression of a lookahead frame and frees its slot.
+	 */
+	void dropLookaheadFrame(LookaheadFrame &frame);
+
+	/**
+	 * Decompresses the cels of a lookahead frame. Runs on a worker thread.
+	 */
+	static void decompressLookaheadFrame(void *data);
+
+	/**
+	 * The slots for the upcoming frames.
+	 */
+	LookaheadFrame _lookaheadFrames[kLookaheadFrames];
 };
 } // end of namespace Sci
 #endif
@@ -337,6 +337,7 @@ void AkosRenderer::setCostume(int costume, int shadow) {
 	const byte *akos = _vm->getResourceAddress(rtCostume, costume);
 	assert(akos);
 
+	_costume = costume;
 	akhd = (const AkosHeader *) _vm->findResourceData(MKTAG('A','K','H','D'), akos);
 	akof = (const AkosOffset *) _vm->findResourceData(MKTAG('A','K','O','F'), akos);
 	akci = _vm->findResourceData(MKTAG('A','K','C','I'), akos);
@@ -654,6 +655,116 @@ void AkosRenderer::codec1_genericDecode(Codec1 &v1) {
 	} while (1);
 }
 
+const AkosRenderer::DecodedCel &AkosRenderer::codec1_getDecodedCel(const Codec1 &v1) {
+	DecodedCelKey key;
+	key.costume = _costume;
+	key.offset = _srcptr - akcd;
+
+	DecodedCelCache::iterator it = _decodedCels.find(key);
+	if (it != _decodedCels.end()) {
+		const DecodedCel &cel = it->_value;
+		// The costume may have been reloaded somewhere else in memory
+		if (cel.src == _srcptr && cel.width == _width && cel.height == _height && cel.shr == v1.shr)
+			return cel;
+		_decodedCelPixels -= cel.colors.size();
+		_decodedCels.erase(it);
+	}
+
+	if (_decodedCelPixels >= kDecodedCelCacheSize) {
+		_decodedCels.clear();
+		_decodedCelPixels = 0;
+	}
+
+	DecodedCel &cel = _decodedCels[key];
+	cel.src = _srcptr;
+	cel.width = _width;
+	cel.height = _height;
+	cel.shr = v1.shr;
+	cel.columns.resize(_width + 1);
+
+	// The runs of the compressed data carry on from one column to the next
+	const byte *src = _srcptr;
+	byte color = 0;
+	int len = 0;
+	for (int x = 0; x < _width; x++) {
+		cel.columns[x] = cel.runs.size();
+		CelRun *run = nullptr;
+		for (int y = 0; y < _height; y++) {
+			if (!len) {
+				len = *src++;
+				color = len >> v1.shr;
+				len &= v1.mask;
+				if (!len)
+					len = *src++;
+				// A zero length byte stands for 256 pixels
+				if (!len)
+					len = 256;
+				run = nullptr;
+			}
+			len--;
+
+			if (!color) {
+				run = nullptr;
+				continue;
+			}
+			if (!run) {
+				CelRun newRun;
+				newRun.y = y;
+				newRun.length = 0;
+				newRun.colors = cel.colors.size();
+				cel.runs.push_back(newRun);
+				run = &cel.runs.back();
+			}
+			run->length++;
+			cel.colors.push_back(color);
+		}
+	}
+	cel.columns[_width] = cel.runs.size();
+
+	_decodedCelPixels += cel.colors.size();
+	return cel;
+}
+
+void AkosRenderer::codec1_drawDecodedCel(Codec1 &v1, const DecodedCel &cel, int column) {
+	const int xstart = _vm->_virtscr[kMainVirtScreen].xstart & 7;
+
+	for (int i = 0; i < v1.skip_width; i++, column++) {
+		if (i) {
+			v1.x += v1.scaleXstep;
+			if (v1.x < 0 || v1.x >= v1.boundsRect.right)
+				return;
+		} else if (v1.x < 0 || v1.x >= v1.boundsRect.right) {
+			continue;
+		}
+
+		const byte maskbit = revBitMask(v1.x & 7);
+		const byte *mask = _vm->getMaskBuffer(v1.x - xstart, v1.y, _zbuf);
+
+		for (uint r = cel.columns[column]; r < cel.columns[column + 1]; r++) {
+			const CelRun &run = cel.runs[r];
+			int y = v1.y + run.y;
+			int end = y + run.length;
+			const byte *colors = &cel.colors[run.colors];
+			if (y < v1.boundsRect.top) {
+				colors += v1.boundsRect.top - y;
+				y = v1.boundsRect.top;
+			}
+			if (end > v1.boundsRect.bottom)
+				end = v1.boundsRect.bottom;
+
+			for (; y < end; y++, colors++) {
+				if (mask[(y - v1.y) * _numStrips] & maskbit)
+					continue;
+				byte *dst = (byte *)_out.getBasePtr(v1.x, y);
+				if (_vm->_bytesPerPixel == 2)
+					WRITE_UINT16(dst, _palette[*colors]);
+				else
+					*dst = _palette[*colors];
+			}
+		}
+	}
+}
+
 // This is exact duplicate of smallCostumeScaleTable[] in costume.cpp
 // See FIXME below for explanation
 const byte smallCostumeScaleTableAKOS[256] = {
@@ -796,6 +907,7 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 	bool use_scaling;
 	int i, j;
 	int skip = 0, startScaleIndexX, startScaleIndexY;
+	int skipColumns = 0;
 	Common::Rect rect;
 	int step;
 	byte drawFlag = 1;
@@ -964,7 +1076,7 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 
 		if (skip > 0) {
 			v1.skip_width -= skip;
-			codec1_ignorePakCols(v1, skip);
+			skipColumns = skip;
 			v1.x = v1.boundsRect.left;
 		} else {
 			skip = rect.right - v1.boundsRect.right;
@@ -979,7 +1091,7 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 			skip = rect.right - v1.boundsRect.right + 1;
 		if (skip > 0) {
 			v1.skip_width -= skip;
-			codec1_ignorePakCols(v1, skip)	;
+			skipColumns = skip;
 			v1.x = v1.boundsRect.right - 1;
 		} else {
 			skip = (v1.boundsRect.left -1) - rect.left;
@@ -1015,7 +1127,15 @@ byte AkosRenderer::codec1(int xmoveCur, int ymoveCur) {
 	v1.height = _out.h;
 	v1.destptr = (byte *)_out.getBasePtr(v1.x, v1.y);
 
-	codec1_genericDecode(v1);
+	// Plain unscaled cels are drawn from their decoded runs. Everything
+	// else reads the compressed data pixel by pixel.
+	if (!use_scaling && !_actorHitMode && _shadow_mode == 0) {
+		codec1_drawDecodedCel(v1, codec1_getDecodedCel(v1), skipColumns);
+	} else {
+		if (skipColumns > 0)
+			codec1_ignorePakCols(v1, skipColumns);
+		codec1_genericDecode(v1);
+	}
 
 	return drawFlag;
 }
@@ -22,6 +22,9 @@
 #ifndef SCUMM_AKOS_H
 #define SCUMM_AKOS_H
 
+#include "common/array.h"
+#include "common/hashmap.h"
+
 #include "scumm/base-costume.h"
 
 namespace Scumm {
@@ -84,6 +87,53 @@ protected:
 		byte buffer[336];
 	} _akos16;
 
+	/** A run of non-transparent pixels in one column of a decoded cel. */
+	struct CelRun {
+		uint16 y;
+		uint16 length;
+		uint32 colors;		// index of the first pixel in DecodedCel::colors
+	};
+
+	/**
+	 * A codec 1 cel, decoded once into the non-transparent runs of each of
+	 * its columns. The colors are kept unmapped, so that the same cel can
+	 * be drawn with any actor palette.
+	 */
+	struct DecodedCel {
+		const byte *src;
+		uint16 width, height;
+		byte shr;
+		Common::Array<uint32> columns;	// first run of each column, plus one past the last
+		Common::Array<CelRun> runs;
+		Common::Array<byte> colors;
+	};
+
+	struct DecodedCelKey {
+		int costume;
+		uint32 offset;
+
+		bool operator==(const DecodedCelKey &other) const {
+			return costume == other.costume && offset == other.offset;
+		}
+	};
+
+	struct DecodedCelKey_Hash {
+		uint operator()(const DecodedCelKey &key) const {
+			return key.offset * 31 + key.costume;
+		}
+	};
+
+	typedef Common::HashMap<DecodedCelKey, DecodedCel, DecodedCelKey_Hash> DecodedCelCache;
+
+	enum {
+		/** Number of decoded pixels kept before the cache is flushed. */
+		kDecodedCelCacheSize = 1024 * 1024
+	};
+
+	int _costume;
+	DecodedCelCache _decodedCels;
+	uint32 _decodedCelPixels;
+
 public:
 	AkosRenderer(ScummEngine *scumm) : BaseCostumeRenderer(scumm) {
 		_useBompPalette = false;
@@ -96,6 +146,8 @@ public:
 		akct = 0;
 		rgbs = 0;
 		xmap = 0;
+		_costume = 0;
+		_decodedCelPixels = 0;
 		_actorHitMode = false;
 	}
 
@@ -112,6 +164,8 @@ protected:
 
 	byte codec1(int xmoveCur, int ymoveCur);
 	void codec1_genericDecode(Codec1 &v1);
+	const DecodedCel &codec1_getDecodedCel(const Codec1 &v1);
+	void codec1_drawDecodedCel(Codec1 &v1, const DecodedCel &cel, int column);
 	byte codec5(int xmoveCur, int ymoveCur);
 	byte codec16(int xmoveCur, int ymoveCur);
 	byte codec32(int xmoveCur, int ymoveCur);
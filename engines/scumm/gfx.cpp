@@ -214,6 +214,9 @@ Gdi::Gdi(ScummEngine *vm) : _vm(vm) {
 	_zbufferDisabled = false;
 	_objectMode = false;
 	_distaff = false;
+	_stripCacheImage = nullptr;
+	memset(_stripCachePalette, 0, sizeof(_stripCachePalette));
+	_stripCacheTransparentColor = 0;
 }
 
 Gdi::~Gdi() {
@@ -271,9 +274,12 @@ void Gdi::init() {
 		// the backbuf (thus we have to treat the right border separately).
 		_numStrips += 1;
 	}
+
+	clearStripCache();
 }
 
 void Gdi::roomChanged(byte *roomptr) {
+	clearStripCache();
 }
 
 void GdiNES::roomChanged(byte *roomptr) {
@@ -1021,7 +1027,7 @@ void ScummEngine::redrawBGStrip(int start, int num) {
 	else
 		room = getResourceAddress(rtRoom, _roomResource);
 
-	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, 0);
+	_gdi->drawBitmap(room + _IM00_offs, &_virtscr[kMainVirtScreen], s, 0, _roomWidth, _virtscr[kMainVirtScreen].h, s, num, Gdi::dbRoomImage);
 }
 
 void ScummEngine::restoreBackground(Common::Rect rect, byte backColor) {
@@ -1844,6 +1850,16 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 	_objectMode = (flag & dbObjectMode) == dbObjectMode;
 	prepareDrawBitmap(ptr, vs, x, y, width, height, stripnr, numstrip);
 
+	// Scrolling redraws the room background strip by strip, so its decoded
+	// strips are kept for as long as the room image and palette stay the same
+	const bool useStripCache = (flag & dbRoomImage) && canCacheStrips() && vs->format.bytesPerPixel == 1;
+	if (useStripCache && !isStripCacheValid(ptr)) {
+		clearStripCache();
+		_stripCacheImage = ptr;
+		memcpy(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette));
+		_stripCacheTransparentColor = _transparentColor;
+	}
+
 	sx = x - vs->xstart / 8;
 	if (sx < 0) {
 		numstrip -= -sx;
@@ -1876,7 +1892,18 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 		else
 			dstPtr = (byte *)vs->getBasePtr(x * 8, y);
 
-		transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		CachedStrip *cachedStrip = nullptr;
+		if (useStripCache) {
+			if (stripnr >= (int)_stripCache.size())
+				_stripCache.resize(stripnr + 1);
+			cachedStrip = &_stripCache[stripnr];
+			if (cachedStrip->y != y || cachedStrip->height != height || cachedStrip->numZBuffer != numzbuf)
+				fillStripCache(*cachedStrip, vs, x, y, width, height, stripnr, smap_ptr, numzbuf, zplane_list);
+			drawCachedStrip(*cachedStrip, dstPtr, vs, x, y);
+			transpStrip = cachedStrip->transpStrip;
+		} else {
+			transpStrip = drawStrip(dstPtr, vs, x, y, width, height, stripnr, smap_ptr);
+		}
 
 		// COMI and HE games only uses flag value
 		if (_vm->_game.version == 8 || _vm->_game.heversion >= 60)
@@ -1890,7 +1917,9 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 				clear8Col(frontBuf, vs->pitch, height, vs->format.bytesPerPixel);
 		}
 
-		decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
+		// The masks of cached strips were already restored
+		if (!cachedStrip)
+			decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, transpStrip, flag);
 
 #if 0
 		// HACK: blit mask(s) onto normal screen. Useful to debug masking
@@ -1920,6 +1949,10 @@ void Gdi::drawBitmap(const byte *ptr, VirtScreen *vs, int x, const int y, const
 
 bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr) {
+	return decodeStrip(dstPtr, vs->pitch, vs, stripnr, smap_ptr, height);
+}
+
+bool Gdi::decodeStrip(byte *dstPtr, int dstPitch, VirtScreen *vs, int stripnr, const byte *smap_ptr, const int height) {
 	// Do some input verification and make sure the strip/strip offset
 	// are actually valid. Normally, this should never be a problem,
 	// but if e.g. a savegame gets corrupted, we can easily get into
@@ -1957,7 +1990,93 @@ bool Gdi::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width,
 			_roomPalette = _vm->_roomPalette;
 	}
 
-	return decompressBitmap(dstPtr, vs->pitch, smap_ptr + offset, height);
+	return decompressBitmap(dstPtr, dstPitch, smap_ptr + offset, height);
+}
+
+void Gdi::clearStripCache() {
+	_stripCache.clear();
+	_stripCacheImage = nullptr;
+}
+
+bool Gdi::isStripCacheValid(const byte *ptr) const {
+	return _stripCacheImage == ptr && _stripCacheTransparentColor == _transparentColor &&
+		!memcmp(_stripCachePalette, _vm->_roomPalette, sizeof(_stripCachePalette));
+}
+
+void Gdi::fillStripCache(CachedStrip &strip, VirtScreen *vs, int x, int y, const int width, const int height,
+					int stripnr, const byte *smap_ptr, int numzbuf, const byte *zplane_list[9]) {
+	const int size = 8 * height;
+
+	strip.y = y;
+	strip.height = height;
+	strip.numZBuffer = numzbuf;
+
+	// The decoders leave transparent pixels alone, so they are found by
+	// decoding transparent strips twice, over two different backgrounds.
+	// Only the pixels written by the decoder are the same in both.
+	strip.pixels.resize(2 * size);
+	byte *pixels = strip.pixels.data();
+	memset(pixels, 0, size);
+	strip.transpStrip = decodeStrip(pixels, 8, vs, stripnr, smap_ptr, height);
+
+	if (strip.transpStrip) {
+		byte *opacity = pixels + size;
+		memset(opacity, 0xFF, size);
+		decodeStrip(opacity, 8, vs, stripnr, smap_ptr, height);
+		for (int i = 0; i < size; i++)
+			opacity[i] = (opacity[i] == pixels[i]) ? 0xFF : 0;
+	} else {
+		strip.pixels.resize(size);
+	}
+
+	// Room backgrounds are drawn without dbAllowMaskOr, so the masks do not
+	// depend on the transparency of the strip
+	decodeMask(x, y, width, height, stripnr, numzbuf, zplane_list, strip.transpStrip, dbRoomImage);
+
+	strip.zPlanes = 0;
+	strip.masks.clear();
+	for (int i = 1; i < numzbuf; i++) {
+		if (!zplane_list[i])
+			continue;
+
+		strip.zPlanes |= 1 << i;
+		const byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < height; h++)
+			strip.masks.push_back(mask_ptr[h * _numStrips]);
+	}
+}
+
+void Gdi::drawCachedStrip(const CachedStrip &strip, byte *dstPtr, VirtScreen *vs, int x, int y) {
+	const byte *src = strip.pixels.data();
+
+	if (strip.transpStrip) {
+		// A line of the strip is 8 pixels, so it can be merged with the
+		// screen as a single 64-bit word
+		const byte *opacity = src + 8 * strip.height;
+		for (int h = 0; h < strip.height; h++) {
+			const uint64 mask = READ_UINT64(opacity);
+			WRITE_UINT64(dstPtr, (READ_UINT64(src) & mask) | (READ_UINT64(dstPtr) & ~mask));
+			src += 8;
+			opacity += 8;
+			dstPtr += vs->pitch;
+		}
+	} else {
+		for (int h = 0; h < strip.height; h++) {
+			memcpy(dstPtr, src, 8);
+			src += 8;
+			dstPtr += vs->pitch;
+		}
+	}
+
+	const byte *masks = strip.masks.data();
+	for (int i = 1; i < strip.numZBuffer; i++) {
+		if (!(strip.zPlanes & (1 << i)))
+			continue;
+
+		byte *mask_ptr = getMaskBuffer(x, y, i);
+		for (int h = 0; h < strip.height; h++)
+			mask_ptr[h * _numStrips] = *masks++;
+	}
 }
 
 bool GdiNES::drawStrip(byte *dstPtr, VirtScreen *vs, int x, int y, const int width, const int height,
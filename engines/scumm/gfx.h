@@ -23,6 +23,7 @@
 #define SCUMM_GFX_H
 
 #include "common/system.h"
+#include "common/array.h"
 #include "common/list.h"
 
 #include "graphics/surface.h"
@@ -219,6 +220,46 @@ protected:
 	/** Flag which is true when an object is being rendered, false otherwise. */
 	bool _objectMode;
 
+	/**
+	 * A room background strip as decoded by drawStrip() and decodeMask(), kept
+	 * so that scrolling and redrawing the room do not decompress it again.
+	 */
+	struct CachedStrip {
+		int y, height;
+		/** Whether the decoder skipped transparent pixels. */
+		bool transpStrip;
+		int numZBuffer;
+		/** Bit i is set if Z-plane i was written by decodeMask(). */
+		uint32 zPlanes;
+		/** The 8 pixels of every line, then the opacity of each pixel if transpStrip is set. */
+		Common::Array<byte> pixels;
+		/** The mask bytes of every written Z-plane above 0, one after the other. */
+		Common::Array<byte> masks;
+
+		CachedStrip() : y(0), height(0), transpStrip(false), numZBuffer(0), zPlanes(0) {}
+	};
+
+	/** The decoded strips of the room background, indexed by strip number. */
+	Common::Array<CachedStrip> _stripCache;
+	/** The room image the cached strips were decoded from. */
+	const byte *_stripCacheImage;
+	/** The room palette and transparent color the cached strips were decoded with. */
+	byte _stripCachePalette[256];
+	byte _stripCacheTransparentColor;
+
+	void clearStripCache();
+	bool isStripCacheValid(const byte *ptr) const;
+	void fillStripCache(CachedStrip &strip, VirtScreen *vs, int x, int y, const int width, const int height,
+					int stripnr, const byte *smap_ptr, int numzbuf, const byte *zplane_list[9]);
+	void drawCachedStrip(const CachedStrip &strip, byte *dstPtr, VirtScreen *vs, int x, int y);
+
+	/**
+	 * Whether the room background strips drawn by this Gdi can be kept in the
+	 * strip cache. Subclasses with their own strip decoding or masks do not
+	 * support it.
+	 */
+	virtual bool canCacheStrips() const { return true; }
+
 public:
 	/** Flag which is true when loading objects or titles for distaff, in PCEngine version of Loom. */
 	bool _distaff;
@@ -258,6 +299,9 @@ protected:
 					int x, int y, const int width, const int height,
 					int stripnr, const byte *smap_ptr);
 
+	/** Decompresses a strip of the given image, as drawStrip() does for the base Gdi. */
+	bool decodeStrip(byte *dstPtr, int dstPitch, VirtScreen *vs, int stripnr, const byte *smap_ptr, const int height);
+
 	virtual void decodeMask(int x, int y, const int width, const int height,
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag);
@@ -292,7 +336,8 @@ public:
 	enum DrawBitmapFlags {
 		dbAllowMaskOr   = 1 << 0,
 		dbDrawMaskOnAll = 1 << 1,
-		dbObjectMode    = 2 << 2
+		dbObjectMode    = 2 << 2,
+		dbRoomImage     = 1 << 4  ///< The room background, which may be drawn from the strip cache
 	};
 };
 
@@ -307,6 +352,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -339,6 +386,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -382,6 +431,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -419,6 +470,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
@@ -445,6 +498,8 @@ protected:
 	                int stripnr, int numzbuf, const byte *zplane_list[9],
 	                bool transpStrip, byte flag) override;
 
+	bool canCacheStrips() const override { return false; }
+
 	void prepareDrawBitmap(const byte *ptr, VirtScreen *vs,
 					const int x, const int y, const int width, const int height,
 	                int stripnr, int numstrip) override;
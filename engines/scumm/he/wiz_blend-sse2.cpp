@@ -0,0 +1,42 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "scumm/he/wiz_blend.h"
+
+#include <emmintrin.h>
+
+namespace Scumm {
+
+int32 blendWizSpanSSE2(uint8 *dst, const uint8 *src, int32 count) {
+	// Halving every channel first keeps the sums from carrying into the next one
+	const __m128i mask = _mm_set1_epi16(0x7DEF);
+
+	int32 done = 0;
+	for (; done + 8 <= count; done += 8) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)(src + done * 2));
+		const __m128i d = _mm_loadu_si128((const __m128i *)(dst + done * 2));
+		const __m128i sum = _mm_add_epi16(_mm_and_si128(_mm_srli_epi16(s, 1), mask), _mm_and_si128(_mm_srli_epi16(d, 1), mask));
+		_mm_storeu_si128((__m128i *)(dst + done * 2), sum);
+	}
+	return done;
+}
+
+} // End of namespace Scumm
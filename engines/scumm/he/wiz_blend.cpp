@@ -0,0 +1,62 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/endian.h"
+#include "common/cpu.h"
+#include "scumm/he/wiz_blend.h"
+
+namespace Scumm {
+
+typedef int32 (*WizSpanBlender)(uint8 *dst, const uint8 *src, int32 count);
+
+static WizSpanBlender selectWizSpanBlender() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return blendWizSpanSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return blendWizSpanNEON;
+#endif
+
+	return nullptr;
+}
+
+void blendWizSpan(uint8 *dst, const uint8 *src, int32 count) {
+	const WizSpanBlender blender = selectWizSpanBlender();
+
+	if (blender && count >= 8) {
+		const int32 done = blender(dst, src, count);
+		dst += done * 2;
+		src += done * 2;
+		count -= done;
+	}
+
+	for (; count > 0; --count) {
+		const uint16 srcColor = (READ_LE_UINT16(src) >> 1) & 0x7DEF;
+		const uint16 dstColor = (READ_LE_UINT16(dst) >> 1) & 0x7DEF;
+		WRITE_LE_UINT16(dst, srcColor + dstColor);
+		src += 2;
+		dst += 2;
+	}
+}
+
+} // End of namespace Scumm
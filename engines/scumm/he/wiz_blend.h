@@ -0,0 +1,49 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SCUMM_HE_WIZ_BLEND_H
+#define SCUMM_HE_WIZ_BLEND_H
+
+#include "common/scummsys.h"
+
+namespace Scumm {
+
+/**
+ * Blend a span of 16 bit RGB555 pixels 50/50 into the destination, like
+ * the kWizXMap mode does for single pixels.
+ *
+ * Both spans hold little endian pixels; the destination may be unaligned.
+ */
+void blendWizSpan(uint8 *dst, const uint8 *src, int32 count);
+
+#ifdef SCUMMVM_SSE2
+/** Blend as many whole blocks of 8 pixels as fit in the span, and return their number of pixels. */
+int32 blendWizSpanSSE2(uint8 *dst, const uint8 *src, int32 count);
+#endif
+
+#ifdef SCUMMVM_NEON
+/** Blend as many whole blocks of 8 pixels as fit in the span, and return their number of pixels. */
+int32 blendWizSpanNEON(uint8 *dst, const uint8 *src, int32 count);
+#endif
+
+} // End of namespace Scumm
+
+#endif
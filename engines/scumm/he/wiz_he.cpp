@@ -30,6 +30,7 @@
 #include "scumm/scumm.h"
 #include "scumm/util.h"
 #include "scumm/he/wiz_he.h"
+#include "scumm/he/wiz_blend.h"
 #include "scumm/he/moonbase/moonbase.h"
 
 namespace Scumm {
@@ -737,6 +738,14 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 		dstInc = -2;
 	}
 
+	// Unflipped runs are written as a whole, as long as the destination
+	// has the same byte order as the image data
+#ifdef SCUMM_LITTLE_ENDIAN
+	const bool spanWrites = (dstInc == 2);
+#else
+	const bool spanWrites = false;
+#endif
+
 	while (h--) {
 		xoff = srcRect.left;
 		w = srcRect.width();
@@ -792,6 +801,15 @@ void Wiz::decompress16BitWizImage(uint8 *dst, int dstPitch, int dstType, const u
 					if (w < 0) {
 						code += w;
 					}
+					if (spanWrites) {
+						if (type == kWizXMap)
+							blendWizSpan(dstPtr, dataPtr, code);
+						else
+							memcpy(dstPtr, dataPtr, code * 2);
+						dataPtr += code * 2;
+						dstPtr += code * 2;
+						continue;
+					}
 					while (code--) {
 						write16BitColor<type>(dstPtr, dataPtr, dstType, xmapPtr);
 						dataPtr += 2;
@@ -906,6 +924,16 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
+					if (bitDepth == 1 && type != kWizXMap) {
+						// A run of a single palette index
+						const uint8 color = (type == kWizRMap) ? palPtr[*dataPtr] : *dataPtr;
+						if (dstInc < 0)
+							dstPtr -= code - 1;
+						memset(dstPtr, color, code);
+						dstPtr += (dstInc < 0) ? -1 : code;
+						dataPtr++;
+						continue;
+					}
 					while (code--) {
 						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
 						dstPtr += dstInc;
@@ -926,6 +954,12 @@ void Wiz::decompressWizImage(uint8 *dst, int dstPitch, int dstType, const uint8
 					if (w < 0) {
 						code += w;
 					}
+					if (type == kWizCopy && dstInc == 1) {
+						memcpy(dstPtr, dataPtr, code);
+						dataPtr += code;
+						dstPtr += code;
+						continue;
+					}
 					while (code--) {
 						write8BitColor<type>(dstPtr, dataPtr, dstType, palPtr, xmapPtr, bitDepth);
 						dataPtr++;
@@ -146,6 +146,7 @@ MODULE_OBJS += \
 	he/script_v90he.o \
 	he/script_v100he.o \
 	he/sprite_he.o \
+	he/wiz_blend.o \
 	he/wiz_he.o \
 	he/localizer.o \
 	he/logic/baseball2001.o \
@@ -171,6 +172,18 @@ ifdef USE_LIBCURL
 MODULE_OBJS += \
 	he/moonbase/net_main.o
 endif
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	he/wiz_blend-sse2.o
+
+$(MODULE)/he/wiz_blend-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	he/wiz_blend-neon.o
+endif
 endif
 
 # This module can be built as a plugin
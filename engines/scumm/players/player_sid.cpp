@@ -1308,6 +1308,7 @@ void Player_SID::initSID() {
 	_sid = new Resid::SID();
 	_sid->set_sampling_parameters(
 		timingProps[_videoSystem].clockFreq,
+		Resid::SAMPLE_FAST,
 		_sampleRate);
 	_sid->enable_filter(true);
 
@@ -43,6 +43,8 @@ private:
 public:
 	Codec37Decoder(int width, int height);
 	~Codec37Decoder();
+	int getWidth() const { return _width; }
+	int getHeight() const { return _height; }
 protected:
 	void maketable(int, int);
 	void proc1(byte *dst, const byte *src, int32, int, int, int, int16 *);
@@ -54,6 +54,8 @@ private:
 public:
 	Codec47Decoder(int width, int height);
 	~Codec47Decoder();
+	int getWidth() const { return _width; }
+	int getHeight() const { return _height; }
 	bool decode(byte *dst, const byte *src);
 };
 
@@ -21,7 +21,9 @@
 
 #include "common/config-manager.h"
 #include "common/file.h"
+#include "common/memstream.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 #include "common/rect.h"
 
@@ -231,6 +233,14 @@ SmushPlayer::SmushPlayer(ScummEngine_v7 *scumm, IMuseDigital *imuseDigital) {
 	_base = NULL;
 	_frameBuffer = NULL;
 	_specialBuffer = NULL;
+	_decodeFuture = NULL;
+	_decodeBuffer = NULL;
+	_nextFrame = NULL;
+	_nextFrameOffset = -1;
+	_nextObjectOffset = -1;
+	_nextObjectData = NULL;
+	_nextObjectCodec = 0;
+	_handlingNextFrame = false;
 
 	_seekPos = -1;
 
@@ -291,11 +301,21 @@ void SmushPlayer::init(int32 speed) {
 	_vm->_mixer->stopHandle(*_IACTchannel);
 	_IACTpos = 0;
 	_vm->_smixer->stop();
+
+	// Without threads, decoding ahead would only make the frames later
+	if (ThreadPoolMan.getThreadCount() > 0)
+		_decodeFuture = new Common::Future();
 }
 
 void SmushPlayer::release() {
 	_vm->_smushVideoShouldFinish = true;
 
+	dropNextFrame();
+	delete _decodeFuture;
+	_decodeFuture = NULL;
+	free(_decodeBuffer);
+	_decodeBuffer = NULL;
+
 	for (int i = 0; i < 5; i++) {
 		delete _sf[i];
 		_sf[i] = NULL;
@@ -800,12 +820,22 @@ void SmushPlayer::decodeFrameObject(int codec, const uint8 *src, int left, int t
 		smush_decode_codec1(_dst, src, left, top, width, height, _vm->_screenWidth);
 		break;
 	case 37:
+		if (!src) {
+			// Decoded ahead
+			memcpy(_dst, _decodeBuffer, width * height);
+			break;
+		}
 		if (!_codec37)
 			_codec37 = new Codec37Decoder(width, height);
 		if (_codec37)
 			_codec37->decode(_dst, src);
 		break;
 	case 47:
+		if (!src) {
+			// Decoded ahead
+			memcpy(_dst, _decodeBuffer, width * height);
+			break;
+		}
 		if (!_codec47)
 			_codec47 = new Codec47Decoder(width, height);
 		if (_codec47)
@@ -875,6 +905,12 @@ void SmushPlayer::handleFrameObject(int32 subSize, Common::SeekableReadStream &b
 	b.readUint16LE();
 	b.readUint16LE();
 
+	if (_handlingNextFrame && b.pos() == _nextObjectOffset) {
+		_decodeFuture->wait();
+		decodeFrameObject(codec, NULL, left, top, width, height);
+		return;
+	}
+
 	int32 chunk_size = subSize - 14;
 	byte *chunk_buffer = (byte *)malloc(chunk_size);
 	assert(chunk_buffer);
@@ -1014,6 +1050,8 @@ SmushFont *SmushPlayer::getFont(int font) {
 void SmushPlayer::parseNextFrame() {
 
 	if (_seekPos >= 0) {
+		dropNextFrame();
+
 		if (_smixer)
 			_smixer->stop();
 
@@ -1076,13 +1114,22 @@ void SmushPlayer::parseNextFrame() {
 		handleAnimHeader(subSize, *_base);
 		break;
 	case MKTAG('F','R','M','E'):
-		handleFrame(subSize, *_base);
+		if (subOffset == _nextFrameOffset) {
+			Common::MemoryReadStream frame(_nextFrame, subSize);
+			_handlingNextFrame = true;
+			handleFrame(subSize, frame);
+			_handlingNextFrame = false;
+		} else {
+			handleFrame(subSize, *_base);
+		}
+		dropNextFrame();
 		break;
 	default:
 		error("Unknown Chunk found at %x: %s, %d", subOffset, tag2str(subType), subSize);
 	}
 
 	_base->seek(subOffset + subSize, SEEK_SET);
+	readAhead();
 
 	if (_insanity)
 		_vm->_sound->processSound();
@@ -1090,6 +1137,102 @@ void SmushPlayer::parseNextFrame() {
 	_vm->_imuseDigital->flushTracks();
 }
 
+void SmushPlayer::readAhead() {
+	// Insane decides which frame objects to skip while playing
+	if (!_decodeFuture || _insanity || _nextFrame)
+		return;
+
+	const int32 pos = _base->pos();
+	if (pos + 8 > (int32)_baseSize)
+		return;
+
+	const uint32 subType = _base->readUint32BE();
+	const int32 subSize = _base->readUint32BE();
+	if (subType != MKTAG('F','R','M','E') || subSize <= 0 || pos + 8 + subSize > (int32)_baseSize) {
+		_base->seek(pos, SEEK_SET);
+		return;
+	}
+
+	_nextFrame = (byte *)malloc(subSize);
+	assert(_nextFrame);
+	const bool isRead = _base->read(_nextFrame, subSize) == (uint32)subSize;
+	_base->seek(pos, SEEK_SET);
+	if (!isRead) {
+		dropNextFrame();
+		return;
+	}
+	_nextFrameOffset = pos + 8;
+
+	// Look for the frame object to decode ahead. Only frame objects which
+	// are shown are decoded, see decodeFrameObject(), and none of them may
+	// come first, as the decoders need the frames in order.
+	int32 offset = 0;
+	while (offset + 8 <= subSize) {
+		const uint32 objType = READ_BE_UINT32(_nextFrame + offset);
+		const int32 objSize = READ_BE_UINT32(_nextFrame + offset + 4);
+		offset += 8;
+		if (objSize < 0 || offset + objSize > subSize || objType == MKTAG('Z','F','O','B'))
+			return;
+
+		if (objType == MKTAG('F','O','B','J') && objSize >= 14) {
+			const byte *obj = _nextFrame + offset;
+			const int codec = READ_LE_UINT16(obj);
+			const int width = READ_LE_UINT16(obj + 6);
+			const int height = READ_LE_UINT16(obj + 8);
+			const bool isShown = (width == 384 && height == 242) ||
+			                     (width == _vm->_screenWidth && height == _vm->_screenHeight);
+
+			if (isShown && (codec == 37 || codec == 47)) {
+				// Decoding type 1 of codec 47 is an error, which must
+				// not happen on the worker
+				if (codec == 47 && (objSize < 14 + 26 || obj[14 + 2] == 1))
+					return;
+
+				if (codec == 37 && !_codec37)
+					_codec37 = new Codec37Decoder(width, height);
+				if (codec == 47 && !_codec47)
+					_codec47 = new Codec47Decoder(width, height);
+				if (codec == 37 ? (_codec37->getWidth() != width || _codec37->getHeight() != height) :
+				                  (_codec47->getWidth() != width || _codec47->getHeight() != height))
+					return;
+
+				if (!_decodeBuffer)
+					_decodeBuffer = (byte *)malloc(MAX(_vm->_screenWidth * _vm->_screenHeight, 384 * 242));
+
+				_nextObjectOffset = offset + 14;
+				_nextObjectData = obj + 14;
+				_nextObjectCodec = codec;
+				ThreadPoolMan.submit(*_decodeFuture, decodeAheadProc, this);
+				return;
+			}
+			if (isShown && codec != 1 && codec != 3 && codec != 20)
+				return;
+		}
+
+		offset += objSize + (objSize & 1);
+	}
+}
+
+void SmushPlayer::dropNextFrame() {
+	if (_decodeFuture)
+		_decodeFuture->wait();
+
+	free(_nextFrame);
+	_nextFrame = NULL;
+	_nextFrameOffset = -1;
+	_nextObjectOffset = -1;
+	_nextObjectData = NULL;
+}
+
+void SmushPlayer::decodeAheadProc(void *data) {
+	SmushPlayer *player = (SmushPlayer *)data;
+
+	if (player->_nextObjectCodec == 37)
+		player->_codec37->decode(player->_decodeBuffer, player->_nextObjectData);
+	else
+		player->_codec47->decode(player->_decodeBuffer, player->_nextObjectData);
+}
+
 void SmushPlayer::setPalette(const byte *palette) {
 	memcpy(_pal, palette, 0x300);
 	setDirtyColors(0, 255);
@@ -29,6 +29,10 @@ class SoundHandle;
 class QueuingAudioStream;
 }
 
+namespace Common {
+class Future;
+}
+
 namespace Scumm {
 
 class ScummEngine_v7;
@@ -57,6 +61,17 @@ private:
 	byte *_frameBuffer;
 	byte *_specialBuffer;
 
+	// The next frame is read ahead, and its frame object decoded by a
+	// worker thread while the current one is shown
+	Common::Future *_decodeFuture;
+	byte *_decodeBuffer;
+	byte *_nextFrame;
+	int32 _nextFrameOffset;
+	int32 _nextObjectOffset;
+	const byte *_nextObjectData;
+	int _nextObjectCodec;
+	bool _handlingNextFrame;
+
 	Common::String _seekFile;
 	uint32 _startFrame;
 	uint32 _startTime;
@@ -116,6 +131,9 @@ protected:
 private:
 	SmushFont *getFont(int font);
 	void parseNextFrame();
+	void readAhead();
+	void dropNextFrame();
+	static void decodeAheadProc(void *data);
 	void init(int32 spped);
 	void setupAnim(const char *file);
 	void updateScreen();
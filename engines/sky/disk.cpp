@@ -59,6 +59,8 @@ Disk::Disk() {
 
 	memset(_buildList, 0, 60 * 2);
 	memset(_loadedFilesList, 0, 60 * 4);
+	_unpackCacheSize = 0;
+	_unpackCacheCounter = 0;
 
 	dnrHandle->close();
 	delete dnrHandle;
@@ -68,6 +70,7 @@ Disk::~Disk() {
 	if (_dataDiskHandle->isOpen())
 		_dataDiskHandle->close();
 	fnFlushBuffers();
+	clearUnpackCache();
 	free(_dinnerTableArea);
 	delete _dataDiskHandle;
 }
@@ -88,6 +91,10 @@ uint8 *Disk::loadFile(uint16 fileNr) {
 		return NULL;
 	}
 
+	uint8 *unpacked = loadUnpackedFile(fileNr);
+	if (unpacked)
+		return unpacked;
+
 	uint32 fileFlags = READ_LE_UINT24(fileInfoPtr + 5);
 	uint32 fileSize = fileFlags & 0x03fffff;
 	uint32 fileOffset = READ_LE_UINT32(fileInfoPtr + 2) & 0x0ffffff;
@@ -157,6 +164,7 @@ uint8 *Disk::loadFile(uint16 fileNr) {
 			if (unpackLen != (int32)decompSize)
 				debug(1, "ERROR: File %d: invalid decomp size! (was: %d, should be: %d)", fileNr, unpackLen, decompSize);
 			_lastLoadedFileSize = decompSize;
+			cacheUnpackedFile(fileNr, uncompDest, decompSize);
 
 			free(fileDest);
 			return uncompDest;
@@ -173,6 +181,56 @@ uint8 *Disk::loadFile(uint16 fileNr) {
 	}
 }
 
+uint8 *Disk::loadUnpackedFile(uint16 fileNr) {
+	for (uint i = 0; i < _unpackCache.size(); i++) {
+		UnpackedFile &file = _unpackCache[i];
+		if (file.fileNr != fileNr)
+			continue;
+
+		// Callers own and may change what they get, so they get a copy
+		uint8 *data = (uint8 *)malloc(file.size);
+		memcpy(data, file.data, file.size);
+		file.lastUse = ++_unpackCacheCounter;
+		_lastLoadedFileSize = file.size;
+		return data;
+	}
+
+	return NULL;
+}
+
+void Disk::cacheUnpackedFile(uint16 fileNr, const uint8 *data, uint32 size) {
+	if (size > kUnpackCacheSize)
+		return;
+
+	while (_unpackCacheSize + size > kUnpackCacheSize) {
+		uint oldest = 0;
+		for (uint i = 1; i < _unpackCache.size(); i++) {
+			if (_unpackCache[i].lastUse < _unpackCache[oldest].lastUse)
+				oldest = i;
+		}
+
+		_unpackCacheSize -= _unpackCache[oldest].size;
+		free(_unpackCache[oldest].data);
+		_unpackCache.remove_at(oldest);
+	}
+
+	UnpackedFile file;
+	file.fileNr = fileNr;
+	file.size = size;
+	file.lastUse = ++_unpackCacheCounter;
+	file.data = (uint8 *)malloc(size);
+	memcpy(file.data, data, size);
+	_unpackCache.push_back(file);
+	_unpackCacheSize += size;
+}
+
+void Disk::clearUnpackCache() {
+	for (uint i = 0; i < _unpackCache.size(); i++)
+		free(_unpackCache[i].data);
+	_unpackCache.clear();
+	_unpackCacheSize = 0;
+}
+
 uint16 *Disk::loadScriptFile(uint16 fileNr) {
 	uint16 *buf = (uint16 *)loadFile(fileNr);
 #ifdef SCUMM_BIG_ENDIAN
@@ -23,6 +23,7 @@
 #define SKY_DISK_H
 
 
+#include "common/array.h"
 #include "common/scummsys.h"
 #include "sky/rnc_deco.h"
 
@@ -59,6 +60,28 @@ protected:
 	uint8 *getFileInfo(uint16 fileNr);
 	void dumpFile(uint16 fileNr);
 
+	uint8 *loadUnpackedFile(uint16 fileNr);
+	void cacheUnpackedFile(uint16 fileNr, const uint8 *data, uint32 size);
+	void clearUnpackCache();
+
+	enum {
+		// Room backgrounds are about 60KB unpacked, so this covers several rooms
+		kUnpackCacheSize = 1024 * 1024
+	};
+
+	struct UnpackedFile {
+		uint16 fileNr;
+		uint32 size;
+		uint32 lastUse;
+		uint8 *data;
+	};
+
+	// Recently unpacked RNC files, so that returning to a room does not
+	// unpack its background and sprites again
+	Common::Array<UnpackedFile> _unpackCache;
+	uint32 _unpackCacheSize;
+	uint32 _unpackCacheCounter;
+
 	uint32 _dinnerTableEntries;
 	uint8 *_dinnerTableArea;
 	Common::File *_dataDiskHandle;
@@ -22,6 +22,7 @@
 #include "engines/stark/console.h"
 
 #include "engines/stark/formats/xarc.h"
+#include "engines/stark/gfx/driver.h"
 #include "engines/stark/resources/object.h"
 #include "engines/stark/resources/anim.h"
 #include "engines/stark/resources/level.h"
@@ -71,6 +72,7 @@ Console::Console() :
 	registerCmd("changeKnowledge",      WRAP_METHOD(Console, Cmd_ChangeKnowledge));
 	registerCmd("enableInventoryItem",  WRAP_METHOD(Console, Cmd_EnableInventoryItem));
 	registerCmd("extractAllTextures",   WRAP_METHOD(Console, Cmd_ExtractAllTextures));
+	registerCmd("drawCalls",            WRAP_METHOD(Console, Cmd_DrawCalls));
 }
 
 Console::~Console() {
@@ -772,4 +774,17 @@ bool Console::Cmd_Chapter(int argc, const char **argv) {
 	return true;
 }
 
+bool Console::Cmd_DrawCalls(int argc, const char **argv) {
+	if (argc != 1) {
+		debugPrintf("Display the number of draw calls made to render the last frame\n");
+		debugPrintf("Usage :\n");
+		debugPrintf("drawCalls\n");
+		return true;
+	}
+
+	debugPrintf("draw calls: %d\n", StarkGfx->getLastFrameDrawCalls());
+
+	return true;
+}
+
 } // End of namespace Stark
@@ -63,6 +63,7 @@ private:
 	bool Cmd_ChangeChapter(int argc, const char **argv);
 	bool Cmd_ChangeKnowledge(int argc, const char **argv);
 	bool Cmd_ExtractAllTextures(int argc, const char **argv);
+	bool Cmd_DrawCalls(int argc, const char **argv);
 
 	Common::Array<Resources::Anim *> listAllLocationAnimations() const;
 	Common::Array<Resources::Script *> listAllLocationScripts() const;
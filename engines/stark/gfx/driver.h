@@ -44,6 +44,7 @@ class Driver {
 public:
 	static Driver *create();
 
+	Driver() : _drawCalls(0), _lastFrameDrawCalls(0) {}
 	virtual ~Driver() {}
 
 	virtual void init() = 0;
@@ -142,6 +143,12 @@ public:
 
 	virtual bool supportsModdedAssets() const { return true; }
 
+	/** Count a draw call made to render the current frame */
+	void countDrawCall() { _drawCalls++; }
+
+	/** Get the number of draw calls made to render the last frame */
+	uint getLastFrameDrawCalls() const { return _lastFrameDrawCalls; }
+
 	static const int32 kOriginalWidth = 640;
 	static const int32 kOriginalHeight = 480;
 
@@ -154,8 +161,14 @@ public:
 protected:
 	static void flipVertical(Graphics::Surface *s);
 
+	/** Start counting the draw calls of a new frame */
+	void resetDrawCalls() { _lastFrameDrawCalls = _drawCalls; _drawCalls = 0; }
+
 	Common::Rect _screenViewport;
 	bool         _computeLights;
+
+	uint         _drawCalls;
+	uint         _lastFrameDrawCalls;
 };
 
 } // End of namespace Gfx
@@ -91,6 +91,7 @@ void OpenGLDriver::clearScreen() {
 
 void OpenGLDriver::flipBuffer() {
 	g_system->updateScreen();
+	resetDrawCalls();
 }
 
 void OpenGLDriver::setupLights(const LightEntryArray &lights) {
@@ -272,6 +272,7 @@ void OpenGLActorRenderer::render(const Math::Vector3d &position, float direction
 			glColorPointer(3, GL_FLOAT, sizeof(ActorVertex), &_faceVBO[0].r);
 
 		glDrawElements(GL_TRIANGLES, numVertexIndices, GL_UNSIGNED_INT, vertexIndices);
+		_gfx->countDrawCall();
 
 		glDisableClientState(GL_VERTEX_ARRAY);
 		if (_gfx->computeLightsEnabled())
@@ -298,6 +299,7 @@ void OpenGLActorRenderer::render(const Math::Vector3d &position, float direction
 			glVertexPointer(3, GL_FLOAT, sizeof(ActorVertex), &_faceVBO[0].sx);
 
 			glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, _faceEBO[*face]);
+			_gfx->countDrawCall();
 
 			glDisableClientState(GL_VERTEX_ARRAY);
 		}
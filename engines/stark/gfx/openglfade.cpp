@@ -63,6 +63,7 @@ void OpenGLFadeRenderer::render(float fadeLevel) {
 	glVertexPointer(2, GL_FLOAT, 2 * sizeof(GLfloat), &fadeVertices[0]);
 
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	_gfx->countDrawCall();
 
 	glDisableClientState(GL_VERTEX_ARRAY);
 
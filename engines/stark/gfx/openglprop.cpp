@@ -202,6 +202,7 @@ void OpenGLPropRenderer::render(const Math::Vector3d &position, float direction,
 			glColorPointer(3, GL_FLOAT, sizeof(PropVertex), &_faceVBO[0].r);
 
 		glDrawElements(GL_TRIANGLES, face->vertexIndices.size(), GL_UNSIGNED_INT, vertexIndices);
+		_gfx->countDrawCall();
 
 		glDisableClientState(GL_VERTEX_ARRAY);
 		if (_gfx->computeLightsEnabled())
@@ -128,6 +128,7 @@ void OpenGLSDriver::clearScreen() {
 
 void OpenGLSDriver::flipBuffer() {
 	g_system->updateScreen();
+	resetDrawCalls();
 }
 
 Texture *OpenGLSDriver::createTexture(const Graphics::Surface *surface, const byte *palette) {
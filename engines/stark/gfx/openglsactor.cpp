@@ -97,22 +97,30 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 	Common::Array<Face *> faces = _model->getFaces();
 	Common::Array<Material *> mats = _model->getMaterials();
 
+	int32 prevMaterialId = -1;
 	for (Common::Array<Face *>::const_iterator face = faces.begin(); face != faces.end(); ++face) {
-		// For each face draw its vertices from the VBO, indexed by the EBO
-		const Material *material = mats[(*face)->materialId];
-		const Gfx::Texture *tex = resolveTexture(material);
-		if (tex) {
-			tex->bind();
-		} else {
-			glBindTexture(GL_TEXTURE_2D, 0);
+		// Faces using the same material as the previous one don't need their state set again
+		if ((int32)(*face)->materialId != prevMaterialId) {
+			const Material *material = mats[(*face)->materialId];
+			prevMaterialId = (*face)->materialId;
+
+			const Gfx::Texture *tex = resolveTexture(material);
+			if (tex) {
+				tex->bind();
+			} else {
+				glBindTexture(GL_TEXTURE_2D, 0);
+			}
+
+			_shader->setUniform("textured", tex != nullptr);
+			_shader->setUniform("color", Math::Vector3d(material->r, material->g, material->b));
 		}
 
-		_shader->setUniform("textured", tex != nullptr);
-		_shader->setUniform("color", Math::Vector3d(material->r, material->g, material->b));
+		// For each face draw its vertices from the VBO, indexed by the EBO
 
 		GLuint ebo = _faceEBO[*face];
 		glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 		glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+		_gfx->countDrawCall();
 	}
 
 	_shader->unbind();
@@ -145,6 +153,7 @@ void OpenGLSActorRenderer::render(const Math::Vector3d &position, float directio
 			GLuint ebo = _faceEBO[*face];
 			glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, ebo);
 			glDrawElements(GL_TRIANGLES, (*face)->vertexIndices.size(), GL_UNSIGNED_INT, 0);
+			_gfx->countDrawCall();
 		}
 
 		glDisable(GL_BLEND);
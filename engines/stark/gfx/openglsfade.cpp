@@ -46,6 +46,7 @@ void OpenGLSFadeRenderer::render(float fadeLevel) {
 	_shader->use();
 	_shader->setUniform1f("alphaLevel", 1.0 - fadeLevel);
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	_gfx->countDrawCall();
 	_shader->unbind();
 
 	_gfx->end2DMode();
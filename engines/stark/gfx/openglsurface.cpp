@@ -106,6 +106,7 @@ void OpenGLSurfaceRenderer::render(const Texture *texture, const Common::Point &
 
 	texture->bind();
 	glDrawArrays(GL_TRIANGLE_STRIP, 0, 4);
+	_gfx->countDrawCall();
 
 	glDisableClientState(GL_VERTEX_ARRAY);
 	glDisableClientState(GL_TEXTURE_COORD_ARRAY);
@@ -101,6 +101,7 @@ void TinyGLDriver::flipBuffer() {
 	}
 
 	g_system->updateScreen();
+	resetDrawCalls();
 }
 
 Texture *TinyGLDriver::createTexture(const Graphics::Surface *surface, const byte *palette) {
@@ -27,6 +27,7 @@
 #include "engines/stark/services/settings.h"
 #include "engines/stark/gfx/texture.h"
 
+#include "math/frustum.h"
 #include "math/vector2d.h"
 
 namespace Stark {
@@ -68,6 +69,16 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 	Math::Matrix4 view = StarkScene->getViewMatrix();
 	Math::Matrix4 projection = StarkScene->getProjectionMatrix();
 
+	// Skip the vertex processing for actors which are entirely off-screen.
+	// The shadow may still be visible though.
+	if (!drawShadow) {
+		Math::AABB bounds = _model->getBoundingBox();
+		Math::Frustum frustum;
+		frustum.setup(projection * view * model);
+		if (bounds.isValid() && !frustum.isInside(bounds))
+			return;
+	}
+
 	Math::Matrix4 modelViewMatrix = view * model;
 	modelViewMatrix.transpose(); // TinyGL expects matrices transposed
 	tglMatrixMode(TGL_MODELVIEW);
@@ -246,6 +257,7 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 		tglColorPointer(3, TGL_FLOAT, sizeof(ActorVertex), &_faceVBO[0].r);
 
 		tglDrawElements(TGL_TRIANGLES, numVertexIndices, TGL_UNSIGNED_INT, vertexIndices);
+		_gfx->countDrawCall();
 
 		tglDisableClientState(TGL_VERTEX_ARRAY);
 		tglDisableClientState(TGL_COLOR_ARRAY);
@@ -266,6 +278,7 @@ void TinyGLActorRenderer::render(const Math::Vector3d &position, float direction
 			tglVertexPointer(3, TGL_FLOAT, sizeof(ActorVertex), &_faceVBO[0].sx);
 
 			tglDrawElements(TGL_TRIANGLES, (*face)->vertexIndices.size(), TGL_UNSIGNED_INT, _faceEBO[*face]);
+			_gfx->countDrawCall();
 
 			tglDisableClientState(TGL_VERTEX_ARRAY);
 		}
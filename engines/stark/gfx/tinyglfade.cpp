@@ -61,6 +61,7 @@ void TinyGLFadeRenderer::render(float fadeLevel) {
 	tglVertexPointer(2, TGL_FLOAT, 2 * sizeof(TGLfloat), &fadeVertices[0]);
 
 	tglDrawArrays(TGL_TRIANGLE_STRIP, 0, 4);
+	_gfx->countDrawCall();
 
 	tglDisableClientState(TGL_VERTEX_ARRAY);
 
@@ -25,6 +25,8 @@
 #include "engines/stark/scene.h"
 #include "engines/stark/services/services.h"
 
+#include "math/frustum.h"
+
 namespace Stark {
 namespace Gfx {
 
@@ -52,6 +54,12 @@ void TinyGLPropRenderer::render(const Math::Vector3d &position, float direction,
 	Math::Matrix4 view = StarkScene->getViewMatrix();
 	Math::Matrix4 projection = StarkScene->getProjectionMatrix();
 
+	// Skip the vertex processing for props which are entirely off-screen
+	Math::Frustum frustum;
+	frustum.setup(projection * view * model);
+	if (_boundingBox.isValid() && !frustum.isInside(_boundingBox))
+		return;
+
 	Math::Matrix4 modelViewMatrix = view * model;
 	modelViewMatrix.transpose(); // TinyGL expects matrices transposed
 	tglMatrixMode(TGL_MODELVIEW);
@@ -177,6 +185,7 @@ void TinyGLPropRenderer::render(const Math::Vector3d &position, float direction,
 		tglColorPointer(3, TGL_FLOAT, sizeof(PropVertex), &_faceVBO[0].r);
 
 		tglDrawElements(TGL_TRIANGLES, face->vertexIndices.size(), TGL_UNSIGNED_INT, vertexIndices);
+		_gfx->countDrawCall();
 
 		tglDisableClientState(TGL_VERTEX_ARRAY);
 		tglDisableClientState(TGL_COLOR_ARRAY);
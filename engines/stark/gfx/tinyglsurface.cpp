@@ -82,6 +82,7 @@ void TinyGLSurfaceRenderer::render(const Texture *texture, const Common::Point &
 
 	transform.tint(1.0, 1.0 - _fadeLevel, 1.0 - _fadeLevel, 1.0 - _fadeLevel);
 	tglBlit(blitImage, transform);
+	_gfx->countDrawCall();
 
 	_gfx->end2DMode();
 }
@@ -22,6 +22,7 @@
  *
  */
 
+#include "common/lzss.h"
 #include "common/textconsole.h"
 #include "common/memstream.h"
 #include "common/util.h"
@@ -31,47 +32,8 @@
 namespace StarTrek {
 
 Common::SeekableReadStream *decodeLZSS(Common::SeekableReadStream *indata, uint32 uncompressedSize) {
-	uint32 N = 0x1000; /* History buffer size */
-	byte *histbuff = new byte[N](); /* History buffer */
-	uint32 outstreampos = 0;
-	uint32 bufpos = 0;
 	byte *outLzssBufData = (byte *)malloc(uncompressedSize);
-
-	for (;;) {
-		byte flagbyte = indata->readByte();
-
-		if (indata->eos())
-			break;
-
-		for (byte i = 0; i < 8; i++) {
-			if ((flagbyte & (1 << i)) == 0) {
-				uint32 offsetlen = indata->readUint16LE();
-
-				if (indata->eos())
-					break;
-
-				uint32 length = (offsetlen & 0xF) + 3;
-				uint32 offset = (bufpos - (offsetlen >> 4)) & (N - 1);
-				for (uint32 j = 0; j < length; j++) {
-					byte tempa = histbuff[(offset + j) & (N - 1)];
-					outLzssBufData[outstreampos++] = tempa;
-					histbuff[bufpos] = tempa;
-					bufpos = (bufpos + 1) & (N - 1);
-				}
-			} else {
-				byte tempa = indata->readByte();
-
-				if (indata->eos())
-					break;
-
-				outLzssBufData[outstreampos++] = tempa;
-				histbuff[bufpos] = tempa;
-				bufpos = (bufpos + 1) & (N - 1);
-			}
-		}
-	}
-
-	delete[] histbuff;
+	uint32 outstreampos = Common::decompressLZSS(indata, indata->size() - indata->pos(), outLzssBufData, uncompressedSize, 4, 3);
 
 	if (outstreampos != uncompressedSize)
 		error("Size mismatch in LZSS decompression; expected %d bytes, got %d bytes", uncompressedSize, outstreampos);
@@ -108,16 +108,41 @@ void Screen::scaleImageFast(byte *dst, uint16 dstPitch, uint16 dstWidth, uint16
 }
 
 void Screen::scaleImageGood(byte *dst, uint16 dstPitch, uint16 dstWidth, uint16 dstHeight, byte *src, uint16 srcPitch, uint16 srcWidth, uint16 srcHeight, byte *backBuf, int16 bbXPos, int16 bbYPos) {
-	for (int y = 0; y < dstHeight; y++) {
-		for (int x = 0; x < dstWidth; x++) {
+	int x, y;
+
+	// The source positions and weights only depend on the column or the
+	// row, so compute them once instead of for every pixel.
+
+	for (x = 0; x < dstWidth; x++) {
+		_xScale[x] = (x * srcWidth) / dstWidth;
+		_xFrac[x] = dstWidth - (x * srcWidth) % dstWidth;
+	}
+
+	for (y = 0; y < dstHeight; y++) {
+		_yScale[y] = (y * srcHeight) / dstHeight;
+		_yFrac[y] = dstHeight - (y * srcHeight) % dstHeight;
+	}
+
+	for (y = 0; y < dstHeight; y++) {
+		uint32 yFrac = _yFrac[y];
+		byte *srcRow = src + _yScale[y] * srcPitch;
+
+		bool lastRow = (y == dstHeight - 1);
+		bool bbRow1 = (bbYPos + y >= MENUDEEP && bbYPos + y < MENUDEEP + RENDERDEEP);
+		bool bbRow2 = (bbYPos + y >= MENUDEEP && bbYPos + y + 1 < MENUDEEP + RENDERDEEP);
+		bool bbRow3 = (bbYPos + y + 1 >= MENUDEEP && bbYPos + y + 1 < MENUDEEP + RENDERDEEP);
+		byte *bbPtr1 = backBuf + _screenWide * (bbYPos + y) + bbXPos;
+		byte *bbPtr3 = bbPtr1 + _screenWide;
+
+		for (x = 0; x < dstWidth; x++) {
 			uint8 c1, c2, c3, c4;
 
-			uint32 xPos = (x * srcWidth) / dstWidth;
-			uint32 yPos = (y * srcHeight) / dstHeight;
-			uint32 xFrac = dstWidth - (x * srcWidth) % dstWidth;
-			uint32 yFrac = dstHeight - (y * srcHeight) % dstHeight;
+			uint32 xFrac = _xFrac[x];
+			bool lastColumn = (x == dstWidth - 1);
+			bool bbColumn1 = (bbXPos + x >= 0 && bbXPos + x < RENDERWIDE);
+			bool bbColumn2 = (bbXPos + x + 1 >= 0 && bbXPos + x + 1 < RENDERWIDE);
 
-			byte *srcPtr = src + yPos * srcPitch + xPos;
+			byte *srcPtr = srcRow + _xScale[x];
 
 			bool transparent = true;
 
@@ -125,26 +150,20 @@ void Screen::scaleImageGood(byte *dst, uint16 dstPitch, uint16 dstWidth, uint16
 				c1 = *srcPtr;
 				transparent = false;
 			} else {
-				if (bbXPos + x >= 0 &&
-				    bbXPos + x < RENDERWIDE &&
-				    bbYPos + y >= MENUDEEP &&
-				    bbYPos + y < MENUDEEP + RENDERDEEP) {
-					c1 = *(backBuf + _screenWide * (bbYPos + y) + bbXPos + x);
+				if (bbColumn1 && bbRow1) {
+					c1 = bbPtr1[x];
 				} else {
 					c1 = 0;
 				}
 			}
 
-			if (x < dstWidth - 1) {
+			if (!lastColumn) {
 				if (*(srcPtr + 1)) {
 					c2 = *(srcPtr + 1);
 					transparent = false;
 				} else {
-					if (bbXPos + x + 1 >= 0 &&
-					    bbXPos + x + 1 < RENDERWIDE &&
-					    bbYPos + y >= MENUDEEP &&
-					    bbYPos + y + 1 < MENUDEEP + RENDERDEEP) {
-						c2 = *(backBuf + _screenWide * (bbYPos + y) + bbXPos + x + 1);
+					if (bbColumn2 && bbRow2) {
+						c2 = bbPtr1[x + 1];
 					} else {
 						c2 = c1;
 					}
@@ -153,16 +172,15 @@ void Screen::scaleImageGood(byte *dst, uint16 dstPitch, uint16 dstWidth, uint16
 				c2 = c1;
 			}
 
-			if (y < dstHeight - 1) {
+			if (!lastRow) {
 				if (*(srcPtr + srcPitch)) {
 					c3 = *(srcPtr + srcPitch);
 					transparent = false;
 				} else {
-					if (bbXPos + x >= 0 &&
-					    bbXPos + x < RENDERWIDE &&
-					    bbYPos + y + 1 >= MENUDEEP &&
-					    bbYPos + y + 1 < MENUDEEP + RENDERDEEP) {
-						c3 = *(backBuf + _screenWide * (bbYPos + y + 1) + bbXPos);
+					// The original code reads the background at
+					// the left edge of the sprite here.
+					if (bbColumn1 && bbRow3) {
+						c3 = *bbPtr3;
 					} else {
 						c3 = c1;
 					}
@@ -171,16 +189,13 @@ void Screen::scaleImageGood(byte *dst, uint16 dstPitch, uint16 dstWidth, uint16
 				c3 = c1;
 			}
 
-			if (x < dstWidth - 1 && y < dstHeight - 1) {
+			if (!lastColumn && !lastRow) {
 				if (*(srcPtr + srcPitch + 1)) {
 					c4 = *(srcPtr + srcPitch + 1);
 					transparent = false;
 				} else {
-					if (bbXPos + x + 1 >= 0 &&
-					    bbXPos + x + 1 < RENDERWIDE &&
-					    bbYPos + y + 1 >= MENUDEEP &&
-					    bbYPos + y + 1 < MENUDEEP + RENDERDEEP) {
-						c4 = *(backBuf + _screenWide * (bbYPos + y + 1) + bbXPos + x + 1);
+					if (bbColumn2 && bbRow3) {
+						c4 = bbPtr3[x + 1];
 					} else {
 						c4 = c3;
 					}
@@ -190,38 +205,28 @@ void Screen::scaleImageGood(byte *dst, uint16 dstPitch, uint16 dstWidth, uint16
 			}
 
 			if (!transparent) {
-				uint32 r1 = _palette[c1 * 3 + 0];
-				uint32 g1 = _palette[c1 * 3 + 1];
-				uint32 b1 = _palette[c1 * 3 + 2];
+				const byte *p1 = _palette + c1 * 3;
+				const byte *p2 = _palette + c2 * 3;
+				const byte *p3 = _palette + c3 * 3;
+				const byte *p4 = _palette + c4 * 3;
 
-				uint32 r2 = _palette[c2 * 3 + 0];
-				uint32 g2 = _palette[c2 * 3 + 1];
-				uint32 b2 = _palette[c2 * 3 + 2];
+				uint32 r5 = (p1[0] * xFrac + p2[0] * (dstWidth - xFrac)) / dstWidth;
+				uint32 g5 = (p1[1] * xFrac + p2[1] * (dstWidth - xFrac)) / dstWidth;
+				uint32 b5 = (p1[2] * xFrac + p2[2] * (dstWidth - xFrac)) / dstWidth;
 
-				uint32 r3 = _palette[c3 * 3 + 0];
-				uint32 g3 = _palette[c3 * 3 + 1];
-				uint32 b3 = _palette[c3 * 3 + 2];
-
-				uint32 r4 = _palette[c4 * 3 + 0];
-				uint32 g4 = _palette[c4 * 3 + 1];
-				uint32 b4 = _palette[c4 * 3 + 2];
-
-				uint32 r5 = (r1 * xFrac + r2 * (dstWidth - xFrac)) / dstWidth;
-				uint32 g5 = (g1 * xFrac + g2 * (dstWidth - xFrac)) / dstWidth;
-				uint32 b5 = (b1 * xFrac + b2 * (dstWidth - xFrac)) / dstWidth;
-
-				uint32 r6 = (r3 * xFrac + r4 * (dstWidth - xFrac)) / dstWidth;
-				uint32 g6 = (g3 * xFrac + g4 * (dstWidth - xFrac)) / dstWidth;
-				uint32 b6 = (b3 * xFrac + b4 * (dstWidth - xFrac)) / dstWidth;
+				uint32 r6 = (p3[0] * xFrac + p4[0] * (dstWidth - xFrac)) / dstWidth;
+				uint32 g6 = (p3[1] * xFrac + p4[1] * (dstWidth - xFrac)) / dstWidth;
+				uint32 b6 = (p3[2] * xFrac + p4[2] * (dstWidth - xFrac)) / dstWidth;
 
 				uint32 r = (r5 * yFrac + r6 * (dstHeight - yFrac)) / dstHeight;
 				uint32 g = (g5 * yFrac + g6 * (dstHeight - yFrac)) / dstHeight;
 				uint32 b = (b5 * yFrac + b6 * (dstHeight - yFrac)) / dstHeight;
 
-				dst[y * dstWidth + x] = quickMatch(r, g, b);
+				dst[x] = quickMatch(r, g, b);
 			} else
-				dst[y * dstWidth + x] = 0;
+				dst[x] = 0;
 		}
+		dst += dstPitch;
 	}
 }
 
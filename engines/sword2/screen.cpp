@@ -98,6 +98,9 @@ Screen::Screen(Sword2Engine *vm, int16 width, int16 height) {
 	_pauseTicks = 0;
 	_pauseStartTick = 0;
 
+	_spriteCacheSize = 0;
+	_spriteCacheCounter = 0;
+
 	// Clean the cache for PSX version SCREENS.CLU
 	_psxScrCache[0] = NULL;
 	_psxScrCache[1] = NULL;
@@ -109,6 +112,7 @@ Screen::Screen(Sword2Engine *vm, int16 width, int16 height) {
 
 Screen::~Screen() {
 	flushPsxScrCache();
+	clearSpriteCache();
 	free(_buffer);
 	free(_dirtyGrid);
 	closeBackgroundLayer();
@@ -636,6 +640,7 @@ void Screen::processImage(BuildUnit *build_unit) {
 	spriteInfo.data = frame + FrameHeader::size();
 	spriteInfo.colorTable = colTablePtr;
 	spriteInfo.isText = false;
+	spriteInfo.cacheId = ((build_unit->anim_resource + 1) << 16) | build_unit->anim_pc;
 
 	// check for largest layer for debug info
 	uint32 current_sprite_area = frame_head.width * frame_head.height;
@@ -24,6 +24,7 @@
 #ifndef	SWORD2_SCREEN_H
 #define	SWORD2_SCREEN_H
 
+#include "common/array.h"
 #include "common/rect.h"
 #include "common/stream.h"
 
@@ -49,6 +50,9 @@
 #define SCALE_MAXWIDTH   512
 #define SCALE_MAXHEIGHT  512
 
+// Memory used for keeping decompressed animation frames
+#define SPRITE_CACHE_SIZE (2 * 1024 * 1024)
+
 // Dirty grid cell size
 #define CELLWIDE         10
 #define CELLDEEP         20
@@ -170,6 +174,7 @@ struct SpriteInfo {
 	byte *data;		// pointer to the sprite data
 	byte *colorTable;	// pointer to 16-byte color table, only applicable to 16-col compression type
 	bool isText;		// It is a engine-generated sprite containing text
+	uint32 cacheId = 0;	// identifies the animation frame, so that it needs to be decompressed only once. 0 if it should not be cached
 };
 
 struct BlockSurface {
@@ -339,6 +344,29 @@ private:
 
 	uint16 _xScale[SCALE_MAXWIDTH];
 	uint16 _yScale[SCALE_MAXHEIGHT];
+	uint16 _xFrac[SCALE_MAXWIDTH];
+	uint16 _yFrac[SCALE_MAXHEIGHT];
+
+	// Recently drawn animation frames, after decompression, mirroring
+	// and (fast) scaling. Actors are drawn every cycle, usually with the
+	// same few frames, so this saves decoding them over and over again.
+
+	struct CachedSprite {
+		uint32 cacheId;
+		uint16 flip;
+		uint16 scale;
+		uint32 size;
+		uint32 lastUse;
+		byte *data;
+	};
+
+	Common::Array<CachedSprite> _spriteCache;
+	uint32 _spriteCacheSize;
+	uint32 _spriteCacheCounter;
+
+	byte *findCachedSprite(SpriteInfo *s, uint16 scale);
+	bool cacheSprite(SpriteInfo *s, uint16 scale, byte *sprite, uint32 size);
+	void clearSpriteCache();
 
 	void blitBlockSurface(BlockSurface *s, Common::Rect *r, Common::Rect *clipRect);
 
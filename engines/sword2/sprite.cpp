@@ -490,10 +490,24 @@ int32 Screen::drawSprite(SpriteInfo *s) {
 	bool freeSprite = false;
 	Common::Rect rd, rs;
 
+	// A scale factor 0 or 256 means don't scale. Why do they use two
+	// different values to mean the same thing? Normalize it here for
+	// convenience.
+
+	scale = (s->scale == 0) ? 256 : s->scale;
+
+	// Animation frames of the PC version are decompressed only once, and
+	// kept in the sprite cache. Note that cached sprites must not be
+	// changed, and are never freed here.
+
+	bool useCache = s->cacheId && !Sword2Engine::isPsx() && !(s->type & RDSPR_NOCOMPRESSION);
+
 	// -----------------------------------------------------------------
 	// Decompression and mirroring
 	// -----------------------------------------------------------------
-	if (s->type & RDSPR_NOCOMPRESSION) {
+	if (useCache && (sprite = findCachedSprite(s, 256)) != NULL) {
+		// Already decompressed and mirrored
+	} else if (s->type & RDSPR_NOCOMPRESSION) {
 		if (Sword2Engine::isPsx()) { // PSX Uncompressed sprites
 			if (s->w > 254 && !s->isText) { // We need to recompose these frames
 				recomposePsxSprite(s);
@@ -626,6 +640,9 @@ int32 Screen::drawSprite(SpriteInfo *s) {
 		freeSprite = true;
 	}
 
+	if (useCache && freeSprite && cacheSprite(s, 256, sprite, s->w * s->h))
+		freeSprite = false;
+
 	// -----------------------------------------------------------------
 	// Positioning and clipping.
 	// -----------------------------------------------------------------
@@ -640,12 +657,6 @@ int32 Screen::drawSprite(SpriteInfo *s) {
 
 	spriteY += MENUDEEP;
 
-	// A scale factor 0 or 256 means don't scale. Why do they use two
-	// different values to mean the same thing? Normalize it here for
-	// convenience.
-
-	scale = (s->scale == 0) ? 256 : s->scale;
-
 	rs.top = 0;
 	rs.left = 0;
 
@@ -706,24 +717,37 @@ int32 Screen::drawSprite(SpriteInfo *s) {
 			return RDERR_NOTIMPLEMENTED;
 		}
 
-		newSprite = (byte *)malloc(s->scaledWidth * s->scaledHeight);
-		if (newSprite == NULL) {
+		// We cannot use good scaling for PSX version, as we are missing
+		// some required data. Good scaling also blends the edges with
+		// the background, so only fast scaled sprites can be cached.
+		bool goodScaling = (_renderCaps & RDBLTFX_EDGEBLEND) && !Sword2Engine::isPsx();
+
+		if (useCache && !goodScaling && (newSprite = findCachedSprite(s, scale)) != NULL) {
 			if (freeSprite)
 				free(sprite);
-			return RDERR_OUTOFMEMORY;
-		}
+			sprite = newSprite;
+			freeSprite = false;
+		} else {
+			newSprite = (byte *)malloc(s->scaledWidth * s->scaledHeight);
+			if (newSprite == NULL) {
+				if (freeSprite)
+					free(sprite);
+				return RDERR_OUTOFMEMORY;
+			}
 
-		// We cannot use good scaling for PSX version, as we are missing
-		// some required data.
-		if (_renderCaps & RDBLTFX_EDGEBLEND && !Sword2Engine::isPsx())
-			scaleImageGood(newSprite, s->scaledWidth, s->scaledWidth, s->scaledHeight, sprite, s->w, s->w, s->h, _buffer, rd.left, rd.top);
-		else
-			scaleImageFast(newSprite, s->scaledWidth, s->scaledWidth, s->scaledHeight, sprite, s->w, s->w, s->h);
+			if (goodScaling)
+				scaleImageGood(newSprite, s->scaledWidth, s->scaledWidth, s->scaledHeight, sprite, s->w, s->w, s->h, _buffer, rd.left, rd.top);
+			else
+				scaleImageFast(newSprite, s->scaledWidth, s->scaledWidth, s->scaledHeight, sprite, s->w, s->w, s->h);
 
-		if (freeSprite)
-			free(sprite);
-		sprite = newSprite;
-		freeSprite = true;
+			if (freeSprite)
+				free(sprite);
+			sprite = newSprite;
+			freeSprite = true;
+
+			if (useCache && !goodScaling && cacheSprite(s, scale, sprite, s->scaledWidth * s->scaledHeight))
+				freeSprite = false;
+		}
 	}
 
 	// -----------------------------------------------------------------
@@ -740,12 +764,12 @@ int32 Screen::drawSprite(SpriteInfo *s) {
 		byte *lightMap;
 
 		// Make sure that we never apply the shadow to the original
-		// resource data. This could only ever happen in the
-		// RDSPR_NOCOMPRESSION case.
+		// resource data, or to a cached sprite.
 
 		if (!freeSprite) {
-			newSprite = (byte *)malloc(s->w * s->h);
-			memcpy(newSprite, sprite, s->w * s->h);
+			uint32 size = (scale != 256) ? s->scaledWidth * s->scaledHeight : s->w * s->h;
+			newSprite = (byte *)malloc(size);
+			memcpy(newSprite, sprite, size);
 			sprite = newSprite;
 			freeSprite = true;
 		}
@@ -843,6 +867,72 @@ int32 Screen::drawSprite(SpriteInfo *s) {
 	return RD_OK;
 }
 
+/**
+ * Looks up a decompressed animation frame in the sprite cache.
+ * @param s the sprite to draw
+ * @param scale the scale factor of the frame, or 256 for the unscaled frame
+ * @return the frame data, or NULL if it is not cached
+ */
+
+byte *Screen::findCachedSprite(SpriteInfo *s, uint16 scale) {
+	uint16 flip = s->type & RDSPR_FLIP;
+
+	for (uint i = 0; i < _spriteCache.size(); i++) {
+		CachedSprite &sprite = _spriteCache[i];
+		if (sprite.cacheId == s->cacheId && sprite.flip == flip && sprite.scale == scale) {
+			sprite.lastUse = ++_spriteCacheCounter;
+			return sprite.data;
+		}
+	}
+
+	return NULL;
+}
+
+/**
+ * Adds a decompressed animation frame to the sprite cache, which then owns
+ * the data. The least recently used frames are freed to make room for it.
+ * @param s the sprite to draw
+ * @param scale the scale factor of the frame, or 256 for the unscaled frame
+ * @param sprite the frame data, allocated with malloc()
+ * @param size the size of the frame data
+ * @return true if the frame was cached
+ */
+
+bool Screen::cacheSprite(SpriteInfo *s, uint16 scale, byte *sprite, uint32 size) {
+	if (size > SPRITE_CACHE_SIZE / 4)
+		return false;
+
+	while (_spriteCacheSize + size > SPRITE_CACHE_SIZE) {
+		uint oldest = 0;
+		for (uint i = 1; i < _spriteCache.size(); i++) {
+			if (_spriteCache[i].lastUse < _spriteCache[oldest].lastUse)
+				oldest = i;
+		}
+
+		_spriteCacheSize -= _spriteCache[oldest].size;
+		free(_spriteCache[oldest].data);
+		_spriteCache.remove_at(oldest);
+	}
+
+	CachedSprite cached;
+	cached.cacheId = s->cacheId;
+	cached.flip = s->type & RDSPR_FLIP;
+	cached.scale = scale;
+	cached.size = size;
+	cached.lastUse = ++_spriteCacheCounter;
+	cached.data = sprite;
+	_spriteCache.push_back(cached);
+	_spriteCacheSize += size;
+	return true;
+}
+
+void Screen::clearSpriteCache() {
+	for (uint i = 0; i < _spriteCache.size(); i++)
+		free(_spriteCache[i].data);
+	_spriteCache.clear();
+	_spriteCacheSize = 0;
+}
+
 /**
  * Opens the light masking sprite for a room.
  */
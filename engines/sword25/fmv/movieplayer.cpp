@@ -64,6 +64,8 @@ bool MoviePlayer::loadMovie(const Common::String &filename, uint z) {
 	// Get the file and load it into the decoder
 	Common::SeekableReadStream *in = Kernel::getInstance()->getPackage()->getStream(filename);
 	_decoder.loadStream(in);
+	// Decode on a worker thread, so that expensive frames don't stall the game
+	_decoder.setDecodeAhead(3);
 	_decoder.start();
 
 	GraphicEngine *pGfx = Kernel::getInstance()->getGfx();
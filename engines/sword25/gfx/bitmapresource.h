@@ -43,6 +43,10 @@ public:
 					_pImage(pImage), Resource(filename, Resource::TYPE_BITMAP) {}
 	~BitmapResource() override { delete _pImage; }
 
+	uint getMemorySize() const override {
+		return _pImage ? _pImage->getMemorySize() : 0;
+	}
+
 	/**
 	    @brief Gibt zurück, ob das Objekt einen gültigen Zustand hat.
 	*/
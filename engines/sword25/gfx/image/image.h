@@ -65,6 +65,13 @@ public:
 	*/
 	virtual int getHeight() const = 0;
 
+	/**
+	    @brief Returns the number of bytes used by the decoded image data
+	*/
+	virtual uint getMemorySize() const {
+		return 0;
+	}
+
 	//@}
 
 	//@{
@@ -68,6 +68,9 @@ public:
 	int getHeight() const override {
 		return _surface.h;
 	}
+	uint getMemorySize() const override {
+		return _surface.pitch * _surface.h;
+	}
 
 	void copyDirectly(int posX, int posY);
 
@@ -49,6 +49,9 @@ public:
 	int getHeight() const override {
 		return _image.h;
 	}
+	uint getMemorySize() const override {
+		return _image.pitch * _image.h;
+	}
 
 	bool blit(int posX = 0, int posY = 0,
 	                  int flipping = Graphics::FLIP_NONE,
@@ -45,6 +45,11 @@ namespace Sword25 {
 // are loaded, the resource manager will start purging resources till it
 // hits the minimum limit above
 #define SWORD25_RESOURCECACHE_MAX 500
+// The amount of memory that the decoded resources may use. Scenes with many
+// large images are purged by size instead of by the number of resources,
+// down to three quarters of this budget, so that the images of the previous
+// scene are not dropped one at a time on every load
+#define SWORD25_RESOURCECACHE_MEMORY (96 * 1024 * 1024)
 
 ResourceManager::~ResourceManager() {
 	// Clear all unlocked resources
@@ -85,6 +90,20 @@ bool ResourceManager::registerResourceService(ResourceService *pService) {
  * Deletes resources as necessary until the specified memory limit is not being exceeded.
  */
 void ResourceManager::deleteResourcesIfNecessary() {
+	// Release the least recently used resources that exceed the memory budget.
+	// Locked resources are pinned and never released here
+	if (_usedMemory > SWORD25_RESOURCECACHE_MEMORY) {
+		Common::List<Resource *>::iterator iter = _resources.end();
+		while (iter != _resources.begin() && _usedMemory > SWORD25_RESOURCECACHE_MEMORY / 4 * 3) {
+			--iter;
+
+			if ((*iter)->getLockCount() == 0)
+				iter = deleteResource(*iter);
+		}
+
+		debugC(kDebugResource, "Resource cache uses %d KB in %d resources", _usedMemory / 1024, _resources.size());
+	}
+
 	// If enough memory is available, or no resources are loaded, then the function can immediately end
 	if (_resources.size() < SWORD25_RESOURCECACHE_MAX)
 		return;
@@ -253,6 +272,7 @@ Resource *ResourceManager::loadResource(const Common::String &fileName) {
 			}
 
 			// Add the resource to the front of the list
+			_usedMemory += pResource->getMemorySize();
 			_resources.push_front(pResource);
 			pResource->_iterator = _resources.begin();
 
@@ -297,6 +317,7 @@ Common::List<Resource *>::iterator ResourceManager::deleteResource(Resource *pRe
 
 	// Delete the resource from the resource list
 	Common::List<Resource *>::iterator result = _resources.erase(pResource->_iterator);
+	_usedMemory -= pResource->getMemorySize();
 
 	// Delete the resource
 	delete pResource;
@@ -93,7 +93,8 @@ private:
 	 * Only the BS_Kernel class can generate copies this class. Thus, the constructor is private
 	 */
 	ResourceManager(Kernel *pKernel) :
-		_kernelPtr(pKernel)
+		_kernelPtr(pKernel),
+		_usedMemory(0)
 	{}
 	virtual ~ResourceManager();
 
@@ -138,6 +139,7 @@ private:
 	Common::List<Resource *> _resources;
 	typedef Common::HashMap<Common::String, Resource *> ResMap;
 	ResMap _resourceHashMap;
+	uint _usedMemory;           ///< The memory used by all loaded resources, in bytes
 };
 
 } // End of namespace Sword25
@@ -91,6 +91,14 @@ public:
 		return _type;
 	}
 
+	/**
+	 * Returns the number of bytes the resource keeps in memory, used for
+	 * the memory budget of the resource cache
+	 */
+	virtual uint getMemorySize() const {
+		return 0;
+	}
+
 protected:
 	virtual ~Resource() {}
 
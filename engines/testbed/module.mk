@@ -9,6 +9,7 @@ MODULE_OBJS := \
 	metaengine.o \
 	midi.o \
 	misc.o \
+	performance.o \
 	networking.o \
 	savegame.o \
 	sound.o \
@@ -0,0 +1,422 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "audio/audiostream.h"
+#include "audio/mixer_intern.h"
+#include "audio/decoders/raw.h"
+
+#include "common/archive.h"
+#include "common/config-manager.h"
+#include "common/events.h"
+#include "common/fs.h"
+#include "common/math.h"
+#include "common/savefile.h"
+
+#include "engines/engine.h"
+
+#include "graphics/palette.h"
+#include "graphics/scalerplugin.h"
+
+#include "testbed/graphics.h"
+#include "testbed/performance.h"
+
+namespace Testbed {
+
+enum {
+	kScreenWidth = 320,
+	kScreenHeight = 200,
+	kScreenFrames = 100,
+	kMixerChannels = 32,	///< The number of channels of the mixer
+	kMixerBuffers = 200,
+	kFileSize = 8 * 1024 * 1024,
+	kFileLookups = 1000,
+	kSavefileIterations = 10,
+	kEventIterations = 200,
+	kEventTimeout = 100000	///< In microseconds
+};
+
+bool PerformanceTests::measureScreenUpdates(int scaler, uint factor, const Graphics::PixelFormat &format) {
+	const char *scalerName = "default";
+	if (scaler >= 0)
+		scalerName = ScalerMan.getPlugins()[scaler]->get<ScalerPluginObject>().getPrettyName();
+
+	g_system->beginGFXTransaction();
+		bool isScalerSet = scaler < 0 || g_system->setScaler(scaler, factor);
+		g_system->initSize(kScreenWidth, kScreenHeight, &format);
+	OSystem::TransactionError gfxError = g_system->endGFXTransaction();
+
+	if (gfxError != OSystem::kTransactionSuccess || !isScalerSet) {
+		Testsuite::logDetailedPrintf("Switching to scaler %s %ux with pixel format %s failed\n", scalerName, factor, format.toString().c_str());
+		return false;
+	}
+
+	if (format.bytesPerPixel == 1) {
+		byte palette[256 * 3];
+		for (int i = 0; i < 256; i++)
+			palette[i * 3] = palette[i * 3 + 1] = palette[i * 3 + 2] = i;
+		g_system->getPaletteManager()->setPalette(palette, 0, 256);
+	}
+
+	// The picture moves down a row every frame, so that every frame really
+	// is a new one, also for scalers which only update changed pixels
+	const uint pitch = kScreenWidth * format.bytesPerPixel;
+	byte *pixels = new byte[pitch * (kScreenHeight + 8)];
+	for (uint i = 0; i < pitch * (kScreenHeight + 8); i++)
+		pixels[i] = (byte)(i * 7 + i / pitch);
+
+	uint64 copyTime = 0, updateTime = 0;
+	for (int frame = 0; frame < kScreenFrames; frame++) {
+		const uint64 start = g_system->getMicros();
+		g_system->copyRectToScreen(pixels + (frame & 7) * pitch, pitch, 0, 0, kScreenWidth, kScreenHeight);
+		const uint64 copied = g_system->getMicros();
+		g_system->updateScreen();
+		const uint64 updated = g_system->getMicros();
+
+		copyTime += copied - start;
+		updateTime += updated - copied;
+	}
+
+	delete[] pixels;
+
+	Testsuite::logPrintf("Info! Screen updates with scaler %s %ux, pixel format %s: copyRectToScreen %.3f ms, updateScreen %.3f ms, %.1f fps\n",
+	                     scalerName, factor, format.toString().c_str(), copyTime / 1000.0 / kScreenFrames, updateTime / 1000.0 / kScreenFrames,
+	                     kScreenFrames * 1000000.0 / MAX<uint64>(copyTime + updateTime, 1));
+	return true;
+}
+
+/**
+ * Measures how fast a full 320x200 screen can be copied and shown, for every
+ * scaler and scale factor with every supported pixel format.
+ */
+TestExitStatus PerformanceTests::screenUpdates() {
+	Testsuite::clearScreen();
+
+	// Measure the backend, not the refresh rate of the display
+	bool isVSync = g_system->hasFeature(OSystem::kFeatureVSync) && g_system->getFeatureState(OSystem::kFeatureVSync);
+	if (isVSync) {
+		g_system->beginGFXTransaction();
+			g_system->setFeatureState(OSystem::kFeatureVSync, false);
+		g_system->endGFXTransaction();
+	}
+
+	const uint currScaler = g_system->getScaler();
+	const uint currFactor = g_system->getScaleFactor();
+	Common::List<Graphics::PixelFormat> formats = g_system->getSupportedFormats();
+	const PluginList &scalerPlugins = ScalerMan.getPlugins();
+	int numMeasured = 0;
+
+	for (uint i = 0; i < scalerPlugins.size() && !Engine::shouldQuit(); i++) {
+		const Common::Array<uint> &factors = scalerPlugins[i]->get<ScalerPluginObject>().getFactors();
+		for (Common::Array<uint>::const_iterator factor = factors.begin(); factor != factors.end(); ++factor) {
+			for (Common::List<Graphics::PixelFormat>::const_iterator format = formats.begin(); format != formats.end(); ++format) {
+				if (measureScreenUpdates(i, *factor, *format))
+					numMeasured++;
+			}
+		}
+	}
+
+	// Backends without scalers only have the mode they are in
+	if (!numMeasured) {
+		for (Common::List<Graphics::PixelFormat>::const_iterator format = formats.begin(); format != formats.end(); ++format) {
+			if (measureScreenUpdates(-1, currFactor, *format))
+				numMeasured++;
+		}
+	}
+
+	// Restore Original State
+	g_system->beginGFXTransaction();
+		g_system->setScaler(currScaler, currFactor);
+		g_system->initSize(320, 200);
+		if (isVSync) {
+			g_system->setFeatureState(OSystem::kFeatureVSync, true);
+		}
+	g_system->endGFXTransaction();
+	GFXTestSuite::setCustomColor(255, 0, 0);
+	GFXtests::initMousePalette();
+	Testsuite::clearScreen();
+
+	return numMeasured ? kTestPassed : kTestFailed;
+}
+
+/**
+ * Plays more and more streams at once, until the mixer can't mix them in real
+ * time anymore or it runs out of channels. The mixing is done in a mixer of
+ * its own, so that the audio output neither disturbs the measurement nor
+ * plays the result.
+ */
+TestExitStatus PerformanceTests::mixerChannels() {
+	const uint outputRate = g_system->getMixer()->getOutputRate();
+	uint bufferSize = g_system->getMixer()->getOutputBufSize();
+	if (!bufferSize)
+		bufferSize = 1024;
+
+	Audio::MixerImpl *mixer = new Audio::MixerImpl(outputRate, bufferSize);
+	Audio::Mixer &base = *mixer;
+	mixer->setReady(true);
+
+	// One second of a sine wave, which is looped by every channel
+	const uint waveRate = 22050;
+	int16 *wave = new int16[waveRate];
+	for (uint i = 0; i < waveRate; i++)
+		wave[i] = (int16)(sin(2 * M_PI * 441 * i / waveRate) * 8000);
+
+	byte flags = Audio::FLAG_16BITS;
+#ifdef SCUMM_LITTLE_ENDIAN
+	flags |= Audio::FLAG_LITTLE_ENDIAN;
+#endif
+
+	int16 *buffer = new int16[bufferSize * 2];
+	const double bufferTime = bufferSize * 1000000.0 / outputRate;
+	bool keepsUp = true;
+
+	for (int channels = 1; channels <= kMixerChannels && keepsUp && !Engine::shouldQuit(); channels++) {
+		// Every other channel needs to be resampled, like in most games
+		const uint rate = (channels & 1) ? waveRate : outputRate;
+		Audio::SeekableAudioStream *stream = Audio::makeRawStream((const byte *)wave, waveRate * 2, rate, flags, DisposeAfterUse::NO);
+		Audio::SoundHandle handle;
+		base.playStream(Audio::Mixer::kPlainSoundType, &handle, Audio::makeLoopingAudioStream(stream, 0), -1,
+		                Audio::Mixer::kMaxChannelVolume, (int8)((channels * 37) % 255 - 127));
+
+		// The first buffer sets the new channel up
+		mixer->mixCallback((byte *)buffer, bufferSize * 4);
+
+		const uint64 start = g_system->getMicros();
+		for (int i = 0; i < kMixerBuffers; i++)
+			mixer->mixCallback((byte *)buffer, bufferSize * 4);
+		const double mixTime = (g_system->getMicros() - start) / (double)kMixerBuffers;
+
+		Testsuite::logPrintf("Info! Mixing %d channels: %.3f ms per %u samples, %.1f%% of real time\n",
+		                     channels, mixTime / 1000.0, bufferSize, mixTime * 100.0 / bufferTime);
+		keepsUp = mixTime < bufferTime;
+	}
+
+	if (!keepsUp) {
+		Testsuite::logPrintf("Info! The mixer can't keep up with this many channels\n");
+	}
+
+	delete mixer;
+	delete[] buffer;
+	delete[] wave;
+
+	return kTestPassed;
+}
+
+/**
+ * Writes a big file to the game data directory, then measures how fast
+ * SearchMan looks it up and reads it with different chunk sizes. As the
+ * file was just written, this is mostly the speed of the file cache.
+ */
+TestExitStatus PerformanceTests::fileReading() {
+	if (!ConfParams.isGameDataFound()) {
+		Testsuite::logPrintf("Info! Couldn't find the game data, so skipping test : File reading\n");
+		return kTestSkipped;
+	}
+
+	const Common::String &path = ConfMan.get("path");
+	Common::FSNode gameRoot(path);
+	Common::FSNode fileToWrite = gameRoot.getChild("testbed.perf");
+
+	Common::WriteStream *ws = fileToWrite.createWriteStream();
+	if (!ws) {
+		Testsuite::logDetailedPrintf("Can't open writable file testbed.perf in game data dir\n");
+		return kTestFailed;
+	}
+
+	const uint kMaxChunkSize = 65536;
+	byte *chunk = new byte[kMaxChunkSize];
+	for (uint i = 0; i < kMaxChunkSize; i++)
+		chunk[i] = (byte)i;
+	for (uint i = 0; i < kFileSize / kMaxChunkSize; i++)
+		ws->write(chunk, kMaxChunkSize);
+	ws->finalize();
+	bool writeError = ws->err();
+	delete ws;
+
+	if (writeError) {
+		Testsuite::logDetailedPrintf("Can't write file testbed.perf in game data dir\n");
+		delete[] chunk;
+		return kTestFailed;
+	}
+
+	// The game data directory already in SearchMan has cached its listing,
+	// which doesn't contain the new file yet
+	SearchMan.addDirectory("testbedPerformance", gameRoot, 1);
+
+	uint64 start = g_system->getMicros();
+	for (int i = 0; i < kFileLookups; i++)
+		SearchMan.hasFile("testbed.perf");
+	const uint64 foundTime = g_system->getMicros() - start;
+
+	start = g_system->getMicros();
+	for (int i = 0; i < kFileLookups; i++)
+		SearchMan.hasFile("testbed.missing");
+	const uint64 missingTime = g_system->getMicros() - start;
+
+	Testsuite::logPrintf("Info! SearchMan lookups: %.3f us for an existing file, %.3f us for a missing file\n",
+	                     foundTime / (double)kFileLookups, missingTime / (double)kFileLookups);
+
+	static const uint chunkSizes[] = { 512, 4096, kMaxChunkSize };
+	bool readError = false;
+
+	for (uint i = 0; i < ARRAYSIZE(chunkSizes) && !readError; i++) {
+		start = g_system->getMicros();
+		Common::SeekableReadStream *rs = SearchMan.createReadStreamForMember("testbed.perf");
+		if (!rs) {
+			Testsuite::logDetailedPrintf("Can't open file testbed.perf through SearchMan\n");
+			readError = true;
+			break;
+		}
+
+		uint64 size = 0;
+		uint32 read;
+		while ((read = rs->read(chunk, chunkSizes[i])) > 0)
+			size += read;
+		readError = rs->err() || size != kFileSize;
+		delete rs;
+		const uint64 readTime = MAX<uint64>(g_system->getMicros() - start, 1);
+
+		Testsuite::logPrintf("Info! Reading %d bytes in chunks of %u bytes: %.3f ms, %.1f MB/s\n",
+		                     kFileSize, chunkSizes[i], readTime / 1000.0, size / (double)readTime);
+	}
+
+	SearchMan.remove("testbedPerformance");
+	delete[] chunk;
+
+	return readError ? kTestFailed : kTestPassed;
+}
+
+/**
+ * Measures how long it takes to write savefiles of typical sizes, from
+ * opening them until they are finalized.
+ */
+TestExitStatus PerformanceTests::savefileWriting() {
+	Common::SaveFileManager *saveFileMan = g_system->getSavefileManager();
+
+	static const uint sizes[] = { 1024, 64 * 1024, 1024 * 1024 };
+	byte *data = new byte[sizes[ARRAYSIZE(sizes) - 1]];
+	for (uint i = 0; i < sizes[ARRAYSIZE(sizes) - 1]; i++)
+		data[i] = (byte)((i * i) >> 5);
+
+	bool writeError = false;
+
+	for (uint i = 0; i < ARRAYSIZE(sizes) && !writeError; i++) {
+		uint64 totalTime = 0, maxTime = 0;
+
+		for (int j = 0; j < kSavefileIterations; j++) {
+			const uint64 start = g_system->getMicros();
+			Common::OutSaveFile *saveFile = saveFileMan->openForSaving("tBedPerformance.0");
+			if (!saveFile) {
+				Testsuite::logDetailedPrintf("Can't open saveFile tBedPerformance.0\n");
+				writeError = true;
+				break;
+			}
+			saveFile->write(data, sizes[i]);
+			saveFile->finalize();
+			writeError = saveFile->err();
+			delete saveFile;
+			const uint64 writeTime = g_system->getMicros() - start;
+
+			if (writeError) {
+				Testsuite::logDetailedPrintf("Can't write saveFile tBedPerformance.0\n");
+				break;
+			}
+			totalTime += writeTime;
+			maxTime = MAX(maxTime, writeTime);
+		}
+
+		if (!writeError) {
+			Testsuite::logPrintf("Info! Writing a savefile of %u bytes: %.3f ms average, %.3f ms max\n",
+			                     sizes[i], totalTime / 1000.0 / kSavefileIterations, maxTime / 1000.0);
+		}
+	}
+
+	saveFileMan->removeSavefile("tBedPerformance.0");
+	delete[] data;
+
+	return writeError ? kTestFailed : kTestPassed;
+}
+
+/**
+ * Measures how long it takes for an event pushed to the event manager to be
+ * returned by pollEvent(). Backends don't timestamp their input, so this is
+ * the latency of the event handling itself, not of the input devices.
+ */
+TestExitStatus PerformanceTests::eventLatency() {
+	Common::EventManager *eventMan = g_system->getEventManager();
+	Common::Event event;
+
+	while (eventMan->pollEvent(event))
+		;
+
+	// Polling without pending events is what engines do every frame
+	uint64 start = g_system->getMicros();
+	for (int i = 0; i < kEventIterations; i++)
+		eventMan->pollEvent(event);
+	const uint64 pollTime = g_system->getMicros() - start;
+
+	uint64 totalTime = 0, maxTime = 0;
+	int numReceived = 0;
+
+	for (int i = 0; i < kEventIterations && !Engine::shouldQuit(); i++) {
+		Common::Event pushed;
+		pushed.type = Common::EVENT_MOUSEMOVE;
+		pushed.mouse = eventMan->getMousePos();
+
+		start = g_system->getMicros();
+		eventMan->pushEvent(pushed);
+
+		bool isReceived = false;
+		while (!isReceived && g_system->getMicros() - start < kEventTimeout) {
+			while (eventMan->pollEvent(event)) {
+				if (event.type == Common::EVENT_MOUSEMOVE) {
+					isReceived = true;
+					break;
+				}
+			}
+		}
+
+		if (isReceived) {
+			const uint64 latency = g_system->getMicros() - start;
+			totalTime += latency;
+			maxTime = MAX(maxTime, latency);
+			numReceived++;
+		}
+	}
+
+	if (!numReceived) {
+		Testsuite::logDetailedPrintf("None of the pushed events were received\n");
+		return kTestFailed;
+	}
+
+	Testsuite::logPrintf("Info! Event latency: pollEvent %.3f us, pushEvent until pollEvent %.3f us average, %.3f us max, %d of %d received\n",
+	                     pollTime / (double)kEventIterations, totalTime / (double)numReceived, (double)maxTime, numReceived, kEventIterations);
+	return kTestPassed;
+}
+
+PerformanceTestSuite::PerformanceTestSuite() {
+	addTest("ScreenUpdates", &PerformanceTests::screenUpdates, false);
+	addTest("MixerChannels", &PerformanceTests::mixerChannels, false);
+	addTest("FileReading", &PerformanceTests::fileReading, false);
+	addTest("SavefileWriting", &PerformanceTests::savefileWriting, false);
+	addTest("EventLatency", &PerformanceTests::eventLatency, false);
+}
+
+} // End of namespace Testbed
@@ -0,0 +1,73 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TESTBED_PERFORMANCE_H
+#define TESTBED_PERFORMANCE_H
+
+#include "testbed/testsuite.h"
+
+namespace Graphics {
+struct PixelFormat;
+}
+
+namespace Testbed {
+
+namespace PerformanceTests {
+
+// Performance tests measure how fast the backend is, they only fail
+// if the measurement itself could not be done
+
+// Helper functions for Performance tests
+bool measureScreenUpdates(int scaler, uint factor, const Graphics::PixelFormat &format);
+
+// will contain function declarations for Performance tests
+TestExitStatus screenUpdates();
+TestExitStatus mixerChannels();
+TestExitStatus fileReading();
+TestExitStatus savefileWriting();
+TestExitStatus eventLatency();
+// add more here
+
+} // End of namespace PerformanceTests
+
+class PerformanceTestSuite : public Testsuite {
+public:
+	/**
+	 * The constructor for the PerformanceTestSuite
+	 * For every test to be executed one must:
+	 * 1) Create a function that would invoke the test
+	 * 2) Add that test to list by executing addTest()
+	 *
+	 * @see addTest()
+	 */
+	PerformanceTestSuite();
+	~PerformanceTestSuite() override {}
+	const char *getName() const override {
+		return "Performance";
+	}
+	const char *getDescription() const override {
+		return "Performance: Screen updates/Mixer/File reading/Savefiles/Events";
+	}
+};
+
+} // End of namespace Testbed
+
+#endif // TESTBED_PERFORMANCE_H
@@ -37,6 +37,7 @@
 #include "testbed/midi.h"
 #include "testbed/misc.h"
 #include "testbed/networking.h"
+#include "testbed/performance.h"
 #include "testbed/savegame.h"
 #include "testbed/sound.h"
 #include "testbed/testbed.h"
@@ -150,6 +151,9 @@ void TestbedEngine::pushTestsuites(Common::Array<Testsuite *> &testsuiteList) {
 	// Networking
 	ts = new NetworkingTestSuite();
 	testsuiteList.push_back(ts);
+	// Performance
+	ts = new PerformanceTestSuite();
+	testsuiteList.push_back(ts);
 #ifdef USE_TTS
 	 // TextToSpeech
 	 ts = new SpeechTestSuite();
@@ -39,10 +39,37 @@ namespace Tinsel {
 #define CHAR_WIDTH 4
 #define CHAR_HEIGHT 4
 
+// Number of decompressed PSX/Saturn block index lists kept
+#define NUM_PSX_INDEX_CACHE 64
+
 extern uint8 g_transPalette[MAX_COLORS];
 
+//----------------- LOCAL GLOBAL DATA --------------------
+
+/** decompressed block indexes of a PSX/Saturn image */
+struct PSX_INDEX_CACHE {
+	SCNHANDLE hBits;	// image bitmap handle
+	int width;		// width of image
+	int height;		// height of image
+	uint8 *indexes;		// decompressed block indexes
+};
+
+// Images are drawn again every frame, and once for each clipping rectangle
+// they intersect, so their block indexes are only decompressed once
+static PSX_INDEX_CACHE g_psxIndexCache[NUM_PSX_INDEX_CACHE];
+
 //----------------- SUPPORT FUNCTIONS ---------------------
 
+/**
+ * Frees the cached PSX/Saturn block indexes.
+ */
+void ResetVarsGraphics() {
+	for (int i = 0; i < NUM_PSX_INDEX_CACHE; i++) {
+		free(g_psxIndexCache[i].indexes);
+		g_psxIndexCache[i].indexes = nullptr;
+	}
+}
+
 // using ScummVM pixel format functions is too slow on some ports because of runtime overhead, let the compiler do the optimizations instead
 static inline void t3getRGB(uint16 color, uint8 &r, uint8 &g, uint8 &b) {
 	r = (color >> 11) & 0x1F;
@@ -154,6 +181,24 @@ uint8* psxSaturnPJCRLEUnwinder(uint16 imageWidth, uint16 imageHeight, uint8 *src
 	return destinationBuffer;
 }
 
+/**
+ * Returns the decompressed block indexes of a PSX/Saturn image, decompressing
+ * them only if they are not in the cache yet.
+ */
+static uint8 *psxSaturnGetIndexes(SCNHANDLE hBits, int width, int height, uint8 *srcIdx) {
+	PSX_INDEX_CACHE *pEntry = &g_psxIndexCache[(hBits ^ (hBits >> 23)) % NUM_PSX_INDEX_CACHE];
+
+	if (pEntry->indexes == nullptr || pEntry->hBits != hBits || pEntry->width != width || pEntry->height != height) {
+		free(pEntry->indexes);
+		pEntry->hBits = hBits;
+		pEntry->width = width;
+		pEntry->height = height;
+		pEntry->indexes = psxSaturnPJCRLEUnwinder(width, height, srcIdx);
+	}
+
+	return pEntry->indexes;
+}
+
 /**
  * Straight rendering of uncompressed data
  */
@@ -1065,7 +1110,6 @@ void DrawObject(DRAWOBJECT *pObj) {
 	byte psxMapperTable[16];
 
 	bool psxFourBitClut = false; // Used by Tinsel PSX, true if an image using a 4bit CLUT is rendered
-	bool psxSaturnRLEindex = false; // Used by Tinsel PSX/Saturn, true if an image is using PJCRLE compressed indexes
 	uint32 psxSkipBytes = 0; // Used by Tinsel PSX, number of bytes to skip before counting indexes for image tiles
 
 	if ((pObj->width <= 0) || (pObj->height <= 0))
@@ -1097,12 +1141,10 @@ void DrawObject(DRAWOBJECT *pObj) {
 						psxSkipBytes = 0;
 						switch (indexType) {
 							case 0xDD: // Normal uncompressed indexes
-								psxSaturnRLEindex = false;
 								srcPtr += sizeof(uint16); // Get to the beginning of index data
 								break;
 							case 0xCC: // PJCRLE compressed indexes
-								psxSaturnRLEindex = true;
-								srcPtr = psxSaturnPJCRLEUnwinder(pObj->width, pObj->height, srcPtr + sizeof(uint16));
+								srcPtr = psxSaturnGetIndexes(pObj->hBits, pObj->width, pObj->height, srcPtr + sizeof(uint16));
 								break;
 							default:
 								error("Unknown PSX/Saturn index type 0x%.2X", indexType);
@@ -1116,12 +1158,10 @@ void DrawObject(DRAWOBJECT *pObj) {
 						psxSkipBytes = READ_32(p + sizeof(uint32) * 5) << 4; // Fetch number of bytes we have to skip
 						switch (indexType) {
 							case 0xDD: // Normal uncompressed indexes
-								psxSaturnRLEindex = false;
 								srcPtr += sizeof(uint16) * 17; // Skip image type and clut, and get to beginning of index data
 								break;
 							case 0xCC: // PJCRLE compressed indexes
-								psxSaturnRLEindex = true;
-								srcPtr = psxSaturnPJCRLEUnwinder(pObj->width, pObj->height, srcPtr + sizeof(uint16) * 17);
+								srcPtr = psxSaturnGetIndexes(pObj->hBits, pObj->width, pObj->height, srcPtr + sizeof(uint16) * 17);
 								break;
 							default:
 								error("Unknown PSX index type 0x%.2X", indexType);
@@ -1213,11 +1253,6 @@ void DrawObject(DRAWOBJECT *pObj) {
 			error("Unknown drawing type %d", typeId);
 		}
 	}
-
-	// If we were using Discworld PSX/Saturn, free the memory allocated
-	// for decompressed block indexes.
-	if ((TinselV1PSX || TinselV1Saturn) && psxSaturnRLEindex)
-		free(srcPtr);
 }
 
 } // End of namespace Tinsel
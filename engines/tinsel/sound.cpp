@@ -30,11 +30,13 @@
 #include "tinsel/sysvar.h"
 #include "tinsel/background.h"
 
+#include "common/config-manager.h"
 #include "common/endian.h"
 #include "common/memstream.h"
 #include "common/system.h"
 
 #include "audio/mixer.h"
+#include "audio/decoded_clip_cache.h"
 #include "audio/decoders/flac.h"
 #include "audio/decoders/mp3.h"
 #include "audio/decoders/raw.h"
@@ -57,6 +59,11 @@ SoundManager::SoundManager(TinselEngine *vm) :
 
 	for (int i = 0; i < kNumChannels; i++)
 		_channels[i].sampleNum = _channels[i].subSample = -1;
+
+	// Keep the cached sound effects at the output rate, so that they are
+	// not resampled every time they are played
+	if (ConfMan.getBool("audio_preresample"))
+		_clipCache.setOutputRate(g_system->getMixer()->getOutputRate());
 }
 
 SoundManager::~SoundManager() {
@@ -272,6 +279,57 @@ bool SoundManager::playSample(int id, int sub, bool bLooped, int x, int y, int p
 		return false;
 	}
 
+	Audio::AudioStream *sampleStream = 0;
+	if (type == Audio::Mixer::kSFXSoundType) {
+		// Sound effects are played over and over, so keep them decoded
+		const Audio::DecodedClipCache::Key clipKey(_vm->getSampleFile(g_sampleLanguage), dwSampleIndex, sub);
+		sampleStream = _clipCache.find(clipKey);
+		if (!sampleStream) {
+			Audio::RewindableAudioStream *decoder = readSample(id, dwSampleIndex, sub);
+			if (decoder)
+				sampleStream = _clipCache.store(clipKey, decoder);
+		}
+	} else {
+		sampleStream = readSample(id, dwSampleIndex, sub);
+	}
+
+	debugC(DEBUG_DETAILED, kTinselDebugSound, "Playing sound %d.%d (pan %d)", id, sub, getPan(x));
+
+	// FIXME: Should set this in a different place ;)
+	_vm->_mixer->setVolumeForSoundType(Audio::Mixer::kSFXSoundType, _vm->_config->_soundVolume);
+	//_vm->_mixer->setVolumeForSoundType(Audio::Mixer::kMusicSoundType, soundVolumeMusic);
+	_vm->_mixer->setVolumeForSoundType(Audio::Mixer::kSpeechSoundType, _vm->_config->_voiceVolume);
+
+	curChan->sampleNum = id;
+	curChan->subSample = sub;
+	curChan->looped = bLooped;
+	curChan->x = x;
+	curChan->y = y;
+	curChan->priority = priority;
+	curChan->lastStart = g_system->getMillis();
+	//                         /---Compression----\    Milis   BytesPerSecond
+	// not needed and won't work when using MP3/OGG/FLAC anyway
+	//curChan->timeDuration = (((sampleLen * 64) / 25) * 1000) / (22050 * 2);
+
+	// Play it
+	_vm->_mixer->playStream(type, &curChan->handle, sampleStream);
+
+	_vm->_mixer->setChannelVolume(curChan->handle, sndVol);
+	_vm->_mixer->setChannelBalance(curChan->handle, getPan(x));
+
+	if (handle)
+		*handle = curChan->handle;
+
+	return true;
+}
+
+/**
+ * Reads a sample of DiscWorld 2 and creates its decoder.
+ * @param id			Identifier of sample, for debugging output
+ * @param dwSampleIndex	File offset of the sample
+ * @param sub			Sub sample to read
+ */
+Audio::RewindableAudioStream *SoundManager::readSample(int id, uint32 dwSampleIndex, int sub) {
 	// move to correct position in the sample file
 	_sampleStream.seek(dwSampleIndex);
 	if (_sampleStream.eos() || _sampleStream.err() || (uint32)_sampleStream.pos() != dwSampleIndex)
@@ -301,8 +359,8 @@ bool SoundManager::playSample(int id, int sub, bool bLooped, int x, int y, int p
 			error(FILE_IS_CORRUPT, _vm->getSampleFile(g_sampleLanguage));
 	}
 
-	debugC(DEBUG_DETAILED, kTinselDebugSound, "Playing sound %d.%d, %d bytes at %d (pan %d)", id, sub, sampleLen,
-			(int)_sampleStream.pos(), getPan(x));
+	debugC(DEBUG_DETAILED, kTinselDebugSound, "Reading sound %d.%d, %d bytes at %d", id, sub, sampleLen,
+			(int)_sampleStream.pos());
 
 	// allocate a buffer
 	byte *sampleBuf = (byte *) malloc(sampleLen);
@@ -314,7 +372,7 @@ bool SoundManager::playSample(int id, int sub, bool bLooped, int x, int y, int p
 
 	Common::MemoryReadStream *compressedStream =
 		new Common::MemoryReadStream(sampleBuf, sampleLen, DisposeAfterUse::YES);
-	Audio::AudioStream *sampleStream = 0;
+	Audio::RewindableAudioStream *sampleStream = 0;
 
 	switch (_soundMode) {
 	case kMP3Mode:
@@ -337,32 +395,7 @@ bool SoundManager::playSample(int id, int sub, bool bLooped, int x, int y, int p
 		break;
 	}
 
-	// FIXME: Should set this in a different place ;)
-	_vm->_mixer->setVolumeForSoundType(Audio::Mixer::kSFXSoundType, _vm->_config->_soundVolume);
-	//_vm->_mixer->setVolumeForSoundType(Audio::Mixer::kMusicSoundType, soundVolumeMusic);
-	_vm->_mixer->setVolumeForSoundType(Audio::Mixer::kSpeechSoundType, _vm->_config->_voiceVolume);
-
-	curChan->sampleNum = id;
-	curChan->subSample = sub;
-	curChan->looped = bLooped;
-	curChan->x = x;
-	curChan->y = y;
-	curChan->priority = priority;
-	curChan->lastStart = g_system->getMillis();
-	//                         /---Compression----\    Milis   BytesPerSecond
-	// not needed and won't work when using MP3/OGG/FLAC anyway
-	//curChan->timeDuration = (((sampleLen * 64) / 25) * 1000) / (22050 * 2);
-
-	// Play it
-	_vm->_mixer->playStream(type, &curChan->handle, sampleStream);
-
-	_vm->_mixer->setChannelVolume(curChan->handle, sndVol);
-	_vm->_mixer->setChannelBalance(curChan->handle, getPan(x));
-
-	if (handle)
-		*handle = curChan->handle;
-
-	return true;
+	return sampleStream;
 }
 
 /**
@@ -566,6 +599,7 @@ void SoundManager::openSampleFiles() {
 
 void SoundManager::closeSampleStream() {
 	_sampleStream.close();
+	_clipCache.clear();
 	free(_sampleIndex);
 	_sampleIndex = 0;
 	_sampleIndexLen = 0;
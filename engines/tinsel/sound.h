@@ -26,6 +26,7 @@
 #include "common/file.h"
 #include "common/file.h"
 
+#include "audio/decoded_clip_cache.h"
 #include "audio/mixer.h"
 
 #include "tinsel/dw.h"
@@ -97,6 +98,10 @@ protected:
 	/** file stream for sample file */
 	TinselFile _sampleStream;
 
+	/** Decoded sound effects */
+	Audio::DecodedClipCache _clipCache;
+
+	Audio::RewindableAudioStream *readSample(int id, uint32 dwSampleIndex, int sub);
 	bool offscreenChecks(int x, int &y);
 	int8 getPan(int x);
 
@@ -75,6 +75,7 @@ extern SCNHANDLE GetSceneHandle();
 
 extern void ResetVarsDrives();
 extern void ResetVarsEvents();
+extern void ResetVarsGraphics();
 extern void ResetVarsMove();
 extern void ResetVarsPalette();
 extern void ResetVarsPCode();
@@ -956,6 +957,7 @@ TinselEngine::~TinselEngine() {
 	// Reset global vars
 	ResetVarsDrives();	// drives.cpp
 	ResetVarsEvents();	// events.cpp
+	ResetVarsGraphics();	// graphics.cpp
 	RebootScalingReels(); // mareels.cpp
 	ResetVarsMove();	// move.cpp
 	ResetVarsPalette();	// palette.cpp
@@ -39,10 +39,16 @@ namespace Titanic {
 
 EMPTY_MESSAGE_MAP(CTreeItem, CMessageTarget);
 
+uint32 CTreeItem::_treeChangeCount;
+
 CTreeItem::CTreeItem() : _parent(nullptr), _firstChild(nullptr),
 	_nextSibling(nullptr), _priorSibling(nullptr), _field14(0) {
 }
 
+CTreeItem::~CTreeItem() {
+	++_treeChangeCount;
+}
+
 void CTreeItem::dump(int indent) {
 	CString line = dumpItem(indent);
 	debug("%s", line.c_str());
@@ -185,6 +191,7 @@ void CTreeItem::addUnder(CTreeItem *newParent) {
 }
 
 void CTreeItem::setParent(CTreeItem *newParent) {
+	++_treeChangeCount;
 	_parent = newParent;
 	_priorSibling = nullptr;
 	_nextSibling = newParent->_firstChild;
@@ -195,6 +202,7 @@ void CTreeItem::setParent(CTreeItem *newParent) {
 }
 
 void CTreeItem::addSibling(CTreeItem *item) {
+	++_treeChangeCount;
 	_priorSibling = item;
 	_nextSibling = item->_nextSibling;
 	_parent = item->_parent;
@@ -239,6 +247,7 @@ int CTreeItem::destroyChildren() {
 }
 
 void CTreeItem::detach() {
+	++_treeChangeCount;
 	// Delink this item from any prior and/or next siblings
 	if (_priorSibling)
 		_priorSibling->_nextSibling = _nextSibling;
@@ -252,6 +261,7 @@ void CTreeItem::detach() {
 }
 
 void CTreeItem::attach(CTreeItem *item) {
+	++_treeChangeCount;
 	_nextSibling = item;
 	_priorSibling = item->_priorSibling;
 	_parent = item->_parent;
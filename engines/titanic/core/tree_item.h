@@ -43,9 +43,18 @@ private:
 	CTreeItem *_priorSibling;
 	CTreeItem *_firstChild;
 	int _field14;
+
+	static uint32 _treeChangeCount;
 public:
 	CLASSDEF;
 	CTreeItem();
+	~CTreeItem() override;
+
+	/**
+	 * Returns a counter that changes whenever any tree item is added,
+	 * moved, removed or destroyed. Allows caching lists of tree items.
+	 */
+	static uint32 getTreeChangeCount() { return _treeChangeCount; }
 
 
 	/**
@@ -37,7 +37,8 @@ CGameManager::CGameManager(CProjectItem *project, CGameView *gameView, Audio::Mi
 		_inputHandler(this), _inputTranslator(&_inputHandler),
 		_gameState(this), _sound(this, mixer), _musicRoom(this),
 		_treeItem(nullptr), _soundMaker(nullptr), _movieRoom(nullptr),
-		_dragItem(nullptr), _transitionCtr(0), _lastDiskTicksCount(0), _tickCount2(0) {
+		_dragItem(nullptr), _transitionCtr(0), _lastDiskTicksCount(0), _tickCount2(0),
+		_viewItemsView(nullptr), _viewItemsTreeChangeCount(0) {
 
 	CTimeEventInfo::_nextId = 0;
 	_movie = nullptr;
@@ -177,8 +178,9 @@ void CGameManager::update() {
 	if (view) {
 		// Expand the game manager's bounds to encompass any modified
 		// areas of any of the view's items
-		for (CTreeItem *item = view; item; item = item->scan(view)) {
-			Rect r = item->getBounds();
+		const Common::Array<CTreeItem *> &items = getViewItems(view);
+		for (uint idx = 0; idx < items.size(); ++idx) {
+			Rect r = items[idx]->getBounds();
 			if (!r.isEmpty())
 				_bounds.combine(r);
 		}
@@ -300,6 +302,19 @@ void CGameManager::frameMessage(CRoomItem *room) {
 	}
 }
 
+const Common::Array<CTreeItem *> &CGameManager::getViewItems(CViewItem *view) {
+	if (view != _viewItemsView || CTreeItem::getTreeChangeCount() != _viewItemsTreeChangeCount) {
+		_viewItems.clear();
+		for (CTreeItem *item = view; item; item = item->scan(view))
+			_viewItems.push_back(item);
+
+		_viewItemsView = view;
+		_viewItemsTreeChangeCount = CTreeItem::getTreeChangeCount();
+	}
+
+	return _viewItems;
+}
+
 void CGameManager::addDirtyRect(const Rect &r) {
 	if (_bounds.isEmpty())
 		_bounds = r;
@@ -57,6 +57,9 @@ private:
 	CVideoSurface *_movieSurface;
 	uint _lastDiskTicksCount;
 	uint _tickCount2;
+	Common::Array<CTreeItem *> _viewItems;
+	CViewItem *_viewItemsView;
+	uint32 _viewItemsTreeChangeCount;
 private:
 	/**
 	 * Generates a message for the next game frame
@@ -131,6 +134,14 @@ public:
 	 */
 	CViewItem *getView() { return _gameState._gameLocation.getView(); }
 
+	/**
+	 * Returns the view and all the items within it, in the order
+	 * CTreeItem::scan visits them. The list is only rebuilt when the
+	 * item tree changed, since big views contain thousands of items
+	 * and are walked every frame.
+	 */
+	const Common::Array<CTreeItem *> &getViewItems(CViewItem *view);
+
 	/**
 	 * Gets the current room node
 	 */
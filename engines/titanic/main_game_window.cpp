@@ -233,9 +233,10 @@ void CMainGameWindow::drawViewContents(CScreenManager *screenManager) {
 
 	// Iterate through drawing all the items in the scene except any item
 	// that's currently being dragged
-	for (CTreeItem *treeItem = view; treeItem; treeItem = treeItem->scan(view)) {
-		if (treeItem != _gameManager->_dragItem)
-			treeItem->draw(screenManager);
+	const Common::Array<CTreeItem *> &items = _gameManager->getViewItems(view);
+	for (uint idx = 0; idx < items.size(); ++idx) {
+		if (items[idx] != _gameManager->_dragItem)
+			items[idx]->draw(screenManager);
 	}
 
 	// Finally draw the drag item if there is one
@@ -64,6 +64,8 @@ CBaseStars::CBaseStars() : _minVal(0.0), _maxVal(1.0), _range(0.0),
 
 void CBaseStars::clear() {
 	_data.clear();
+	_regions.clear();
+	_starRegions.clear();
 }
 
 void CBaseStars::initialize() {
@@ -101,6 +103,62 @@ void CBaseStars::loadData(Common::SeekableReadStream &s) {
 	// Iterate through reading the data for each entry
 	for (uint idx = 0; idx < count; ++idx)
 		_data[idx].load(s);
+
+	buildRegions();
+}
+
+void CBaseStars::buildRegions() {
+	_regions.resize(kRegionLatitudes * kRegionLongitudes);
+	_starRegions.resize(_data.size());
+	_regionVisible.resize(_regions.size());
+
+	Common::Array<bool> used;
+	used.resize(_regions.size());
+	for (uint idx = 0; idx < used.size(); ++idx)
+		used[idx] = false;
+
+	for (uint idx = 0; idx < _data.size(); ++idx) {
+		const FVector &pos = _data[idx]._position;
+		double len = sqrt((double)pos._x * pos._x + (double)pos._y * pos._y + (double)pos._z * pos._z);
+		double lat = (len > 0.0) ? asin(CLIP(pos._z / len, -1.0, 1.0)) : 0.0;
+		double lon = atan2((double)pos._y, (double)pos._x);
+
+		int latIdx = CLIP((int)((lat / M_PI + 0.5) * kRegionLatitudes), 0, kRegionLatitudes - 1);
+		int lonIdx = CLIP((int)((lon / (2 * M_PI) + 0.5) * kRegionLongitudes), 0, kRegionLongitudes - 1);
+		uint regionIdx = latIdx * kRegionLongitudes + lonIdx;
+		_starRegions[idx] = regionIdx;
+
+		StarRegion &region = _regions[regionIdx];
+		if (!used[regionIdx]) {
+			region._min = region._max = pos;
+			used[regionIdx] = true;
+		} else {
+			region._min._x = MIN(region._min._x, pos._x);
+			region._min._y = MIN(region._min._y, pos._y);
+			region._min._z = MIN(region._min._z, pos._z);
+			region._max._x = MAX(region._max._x, pos._x);
+			region._max._y = MAX(region._max._y, pos._y);
+			region._max._z = MAX(region._max._z, pos._z);
+		}
+	}
+}
+
+void CBaseStars::cullRegions(const FPose &pose, double minVal) {
+	const double zx = pose._row1._z, zy = pose._row2._z, zz = pose._row3._z;
+
+	for (uint idx = 0; idx < _regions.size(); ++idx) {
+		// The depth is linear in the position, so its maximum within the
+		// bounding box is reached in one of the corners
+		const StarRegion &region = _regions[idx];
+		double x = MAX(region._min._x * zx, region._max._x * zx);
+		double y = MAX(region._min._y * zy, region._max._y * zy);
+		double z = MAX(region._min._z * zz, region._max._z * zz);
+		double maxZ = x + y + z + pose._vector._z;
+
+		// Leave a margin for the single precision math used when drawing
+		double margin = (fabs(x) + fabs(y) + fabs(z) + fabs(pose._vector._z)) * 1.0e-4 + 1.0;
+		_regionVisible[idx] = maxZ + margin > minVal;
+	}
 }
 
 void CBaseStars::loadData(const CString &resName) {
@@ -168,12 +226,16 @@ void CBaseStars::draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
+	cullRegions(pose, minVal);
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double tempX, tempY, tempZ, total2;
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
+		if (!isRegionVisible(idx))
+			continue;
+
 		CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
 		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
@@ -199,8 +261,7 @@ void CBaseStars::draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		double sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		double sVal = (total2 < 1.0e10) ? 1.0 : 1.0 - ((sqrt(total2) - 100000.0) / 1.0e9);
 		double red = MIN((double)entry._red * sVal, (double)255.0);
 		double green = MIN((double)entry._green * sVal, (double)255.0);
 		double blue = MIN((double)entry._green * sVal, (double)255.0);
@@ -253,12 +314,16 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
+	cullRegions(pose, minVal);
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
 	double tempX, tempY, tempZ, total2;
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
+		if (!isRegionVisible(idx))
+			continue;
+
 		CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
 		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
@@ -284,8 +349,7 @@ void CBaseStars::draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		double sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		double sVal = (total2 < 1.0e10) ? 1.0 : 1.0 - ((sqrt(total2) - 100000.0) / 1.0e9);
 		double red = MIN((double)entry._red * sVal, (double)255.0);
 		double green = MIN((double)entry._green * sVal, (double)255.0);
 		double blue = MIN((double)entry._green * sVal, (double)255.0);
@@ -339,6 +403,7 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
+	cullRegions(pose, minVal);
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2;
@@ -348,6 +413,9 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	uint16 *pixelP;
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
+		if (!isRegionVisible(idx))
+			continue;
+
 		CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
 		tempZ = vector._x * pose._row1._z + vector._y * pose._row2._z
@@ -374,8 +442,7 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		sVal = (total2 < 1.0e10) ? 1.0 : 1.0 - ((sqrt(total2) - 100000.0) / 1.0e9);
 		sVal *= 255.0;
 
 		if (sVal > 255.0)
@@ -408,8 +475,7 @@ void CBaseStars::draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		sVal = (total2 < 1.0e10) ? 1.0 : 1.0 - ((sqrt(total2) - 100000.0) / 1.0e9);
 		sVal *= 255.0;
 
 		if (sVal > 255.0)
@@ -446,6 +512,7 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	FPoint centroid = surfaceArea->_centroid + FPoint(0.5, 0.5);
 	double threshold = camera->getFrontClip();
 	double minVal = threshold - 9216.0;
+	cullRegions(pose, minVal);
 	int width1 = surfaceArea->_width - 1;
 	int height1 = surfaceArea->_height - 1;
 	double *v1Ptr = &_value1, *v2Ptr = &_value2, *v3Ptr = &_value3, *v4Ptr = &_value4;
@@ -454,6 +521,9 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 	uint16 *pixelP;
 
 	for (uint idx = 0; idx < _data.size(); ++idx) {
+		if (!isRegionVisible(idx))
+			continue;
+
 		const CBaseStarEntry &entry = _data[idx];
 		const FVector &vector = entry._position;
 
@@ -482,8 +552,7 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		sVal = (total2 < 1.0e10) ? 1.0 : 1.0 - ((sqrt(total2) - 100000.0) / 1.0e9);
 		sVal *= 255.0;
 
 		if (sVal > 255.0)
@@ -516,8 +585,7 @@ void CBaseStars::draw4(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup
 		if (xStart < 0 || xStart >= width1 || yStart < 0 || yStart >= height1)
 			continue;
 
-		sVal = sqrt(total2);
-		sVal = (sVal < 100000.0) ? 1.0 : 1.0 - ((sVal - 100000.0) / 1.0e9);
+		sVal = (total2 < 1.0e10) ? 1.0 : 1.0 - ((sqrt(total2) - 100000.0) / 1.0e9);
 		sVal *= 255.0;
 
 		if (sVal > 255.0)
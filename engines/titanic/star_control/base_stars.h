@@ -22,6 +22,7 @@
 #ifndef TITANIC_BASE_STARS_H
 #define TITANIC_BASE_STARS_H
 
+#include "titanic/star_control/fpose.h"
 #include "titanic/star_control/frange.h"
 #include "common/array.h"
 
@@ -73,6 +74,41 @@ struct CStarPosition : public Common::Point {
  */
 class CBaseStars {
 private:
+	/**
+	 * Bounding box of the stars in one direction from the origin. Whole
+	 * regions behind the camera can be skipped without transforming each
+	 * of their stars.
+	 */
+	struct StarRegion {
+		FVector _min, _max;
+	};
+
+	enum {
+		kRegionLatitudes = 16,
+		kRegionLongitudes = 32
+	};
+
+	Common::Array<StarRegion> _regions;
+	Common::Array<uint16> _starRegions;
+	Common::Array<byte> _regionVisible;
+
+	/**
+	 * Sorts the stars into regions by their direction
+	 */
+	void buildRegions();
+
+	/**
+	 * Flags which regions may contain stars in front of the given depth
+	 */
+	void cullRegions(const FPose &pose, double minVal);
+
+	/**
+	 * Returns false if the star is known to be behind the camera
+	 */
+	bool isRegionVisible(uint idx) const {
+		return _starRegions.size() != _data.size() || _regionVisible[_starRegions[idx]];
+	}
+
 	void draw1(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw2(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
 	void draw3(CSurfaceArea *surfaceArea, CCamera *camera, CStarCloseup *closeup);
@@ -25,6 +25,7 @@
 #include "titanic/events.h"
 #include "titanic/titanic.h"
 #include "common/system.h"
+#include "common/threadpool.h"
 #include "graphics/pixelformat.h"
 #include "graphics/screen.h"
 #include "video/avi_decoder.h"
@@ -34,6 +35,40 @@ namespace Titanic {
 
 #define DEFAULT_FPS 15.0
 
+// Fewer rows than this are not worth handing to another thread
+#define MIN_FRAME_BAND_HEIGHT 16
+
+/**
+ * The rows of a 32-bit movie frame, as converted to the 16-bit movie
+ * surface by Common::ThreadPool::parallelFor()
+ */
+struct MovieFrameRows {
+	const Graphics::Surface *_src;
+	Graphics::ManagedSurface *_dest;
+	uint _width;
+	uint16 _transPixel;
+	bool _hasTransparency;
+
+	static void convert(void *data, uint begin, uint end) {
+		const MovieFrameRows *rows = (const MovieFrameRows *)data;
+		const Graphics::PixelFormat &srcFormat = rows->_src->format;
+		const Graphics::PixelFormat &destFormat = rows->_dest->format;
+		byte a, r, g, b;
+
+		for (uint y = begin; y < end; ++y) {
+			const uint32 *pSrc = (const uint32 *)rows->_src->getBasePtr(0, y);
+			uint16 *pDest = (uint16 *)rows->_dest->getBasePtr(0, y);
+
+			for (uint x = 0; x < rows->_width; ++x, ++pSrc, ++pDest) {
+				srcFormat.colorToARGB(*pSrc, a, r, g, b);
+				assert(a == 0 || a == 0xff);
+
+				*pDest = (a == 0 && rows->_hasTransparency) ? rows->_transPixel : destFormat.RGBToColor(r, g, b);
+			}
+		}
+	}
+};
+
 Video::AVIDecoder::AVIVideoTrack &AVIDecoder::getVideoTrack(uint idx) {
 	assert(idx < _videoTracks.size());
 	AVIVideoTrack *track = static_cast<AVIVideoTrack *>(_videoTracks[idx].track);
@@ -323,21 +358,18 @@ void AVISurface::copyMovieFrame(const Graphics::Surface &src, Graphics::ManagedS
 	} else {
 		// Source is 32-bit which may have transparent pixels. Copy over each
 		// pixel, replacing transparent pixels with the special transparency color
-		byte a, r, g, b;
 		assert(src.format.bytesPerPixel == 4 && dest.format.bytesPerPixel == 2);
-		uint16 transPixel = _videoSurface->getTransparencyColor();
 
-		for (uint y = 0; y < (uint)MIN(src.h, dest.h); ++y) {
-			const uint32 *pSrc = (const uint32 *)src.getBasePtr(0, y);
-			uint16 *pDest = (uint16 *)dest.getBasePtr(0, y);
+		MovieFrameRows rows;
+		rows._src = &src;
+		rows._dest = &dest;
+		rows._width = MIN(src.w, dest.w);
+		rows._transPixel = _videoSurface->getTransparencyColor();
+		rows._hasTransparency = _streamCount == 1;
 
-			for (uint x = 0; x < (uint)MIN(src.w, dest.w); ++x, ++pSrc, ++pDest) {
-				src.format.colorToARGB(*pSrc, a, r, g, b);
-				assert(a == 0 || a == 0xff);
-
-				*pDest = (a == 0 && _streamCount == 1) ? transPixel : dest.format.RGBToColor(r, g, b);
-			}
-		}
+		// Each row is converted on its own, so they can be split across threads
+		uint height = MIN(src.h, dest.h);
+		ThreadPoolMan.parallelFor(0, height, MIN_FRAME_BAND_HEIGHT, MovieFrameRows::convert, &rows);
 	}
 }
 
@@ -22,6 +22,8 @@
 #include "common/debug.h"
 #include "common/rect.h"
 
+#include "graphics/conversion.h"
+
 #include "toon/anim.h"
 #include "toon/toon.h"
 #include "toon/tools.h"
@@ -195,19 +197,10 @@ void Animation::drawFrame(Graphics::Surface &surface, int32 frame, int16 xx, int
 		return;
 
 	int32 destPitch = surface.pitch;
-	uint8 *srcRow = _frames[dataFrame]._data + offsX + (_frames[frame]._x2 - _frames[frame]._x1) * offsY;
+	int32 srcPitch = _frames[frame]._x2 - _frames[frame]._x1;
+	uint8 *srcRow = _frames[dataFrame]._data + offsX + srcPitch * offsY;
 	uint8 *curRow = (uint8 *)surface.getBasePtr(xx + _x1 + _frames[frame]._x1 + offsX, yy + _frames[frame]._y1 + _y1 + offsY);
-	for (int16 y = 0; y < rectY; y++) {
-		uint8 *cur = curRow;
-		uint8 *c = srcRow + y * (_frames[frame]._x2 - _frames[frame]._x1);
-		for (int16 x = 0; x < rectX; x++) {
-			if (*c)
-				*cur = *c;
-			c++;
-			cur++;
-		}
-		curRow += destPitch;
-	}
+	Graphics::keyBlit(curRow, srcRow, destPitch, srcPitch, rectX, rectY, 1, 0);
 }
 
 void Animation::drawFrameWithMask(Graphics::Surface &surface, int32 frame, int16 xx, int16 yy, int32 zz, Picture *mask) {
@@ -245,24 +238,35 @@ void Animation::drawFrameWithMaskAndScale(Graphics::Surface &surface, int32 fram
 	uint8 *curRowMask = mask->getDataPtr();
 
 	bool shadowFlag = Common::String(_name).contains("SHADOW");
+	const uint8 *shadowLUT = _vm->getShadowLUT();
+
+	// Clip to the picture once, and find the source column of each column
+	// up front rather than dividing for every pixel
+	const int16 x0 = MAX<int16>(xx1, 0);
+	const int16 x1 = MIN<int16>(xx2, 1280);
+	const int16 y0 = MAX<int16>(yy1, 0);
+	const int16 y1 = MIN<int16>(yy2, 400);
+	if (x0 >= x1 || y0 >= y1)
+		return;
 
-	for (int16 y = yy1; y < yy2; y++) {
-		for (int16 x = xx1; x < xx2; x++) {
-			if (x < 0 || x >= 1280 || y < 0 || y >= 400)
-				continue;
+	int16 srcColumns[1280];
+	for (int16 x = x0; x < x1; x++)
+		srcColumns[x - x0] = (x - xx1) * 1024 / scale;
 
-			uint8 *cur = curRow + x + y * destPitch;
-			uint8 *curMask = curRowMask + x + y * destPitchMask;
+	for (int16 y = y0; y < y1; y++) {
+		uint8 *cur = curRow + y * destPitch;
+		const uint8 *curMask = curRowMask + y * destPitchMask;
 
-			// find the good c
-			int16 xs = (x - xx1) * 1024 / scale;
-			int16 ys = (y - yy1) * 1024 / scale;
-			uint8 *cc = &c[ys * w + xs];
-			if (*cc && ((*curMask) >= zz)) {
+		// find the good c
+		int16 ys = (y - yy1) * 1024 / scale;
+		const uint8 *srcRow = &c[ys * w];
+		for (int16 x = x0; x < x1; x++) {
+			const uint8 cc = srcRow[srcColumns[x - x0]];
+			if (cc && (curMask[x] >= zz)) {
 				if (shadowFlag)
-					*cur = _vm->getShadowLUT()[*cur];
+					cur[x] = shadowLUT[cur[x]];
 				else
-					*cur = *cc;
+					cur[x] = cc;
 			}
 		}
 	}
@@ -395,16 +399,8 @@ void Animation::drawFrameOnPicture(int32 frame, int16 xx, int16 yy) {
 	int32 destPitch = pic->getWidth();
 	uint8 *c = _frames[frame]._data;
 	uint8 *curRow = (uint8 *)pic->getDataPtr() + (yy + _frames[frame]._y1 + _y1) * destPitch + (xx + _x1 + _frames[frame]._x1);
-	for (int16 y = 0; y < rectY; y++) {
-		unsigned char *cur = curRow;
-		for (int16 x = 0; x < rectX; x++) {
-			if (*c)
-				*cur = *c;
-			c++;
-			cur++;
-		}
-		curRow += destPitch;
-	}
+	// The source rows are as wide as the clipped rectangle
+	Graphics::keyBlit(curRow, c, destPitch, rectX, rectX, rectY, 1, 0);
 }
 
 void AnimationInstance::update(int32 timeIncrement) {
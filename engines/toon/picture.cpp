@@ -26,6 +26,8 @@
 #include "common/rect.h"
 #include "common/stack.h"
 
+#include "graphics/conversion.h"
+
 namespace Toon {
 
 bool Picture::loadPicture(const Common::String &file) {
@@ -217,17 +219,8 @@ void Picture::drawWithRectList(Graphics::Surface& surface, int16 x, int16 y, int
 		uint8 *c = _data + _width * (dy + rect.top) + (dx + rect.left);
 		uint8 *curRow = (uint8 *)surface.getBasePtr(x + rect.left, y + rect.top);
 
-		for (int16 yy = 0; yy < fillRy; yy++) {
-			uint8 *curSrc = c;
-			uint8 *cur = curRow;
-			for (int16 xx = 0; xx < fillRx; xx++) {
-				*cur = *curSrc;
-				curSrc++;
-				cur++;
-			}
-			curRow += destPitch;
-			c += srcPitch;
-		}
+		if (fillRx > 0 && fillRy > 0)
+			Graphics::copyBlit(curRow, c, destPitch, srcPitch, fillRx, fillRy, 1);
 	}
 }
 
@@ -245,17 +238,7 @@ void Picture::draw(Graphics::Surface &surface, int16 x, int16 y, int16 dx, int16
 	uint8 *c = _data + _width * dy + dx;
 	uint8 *curRow = (uint8 *)surface.getBasePtr(x, y);
 
-	for (int16 yy = 0; yy < ry; yy++) {
-		uint8 *curSrc = c;
-		uint8 *cur = curRow;
-		for (int16 xx = 0; xx < rx; xx++) {
-			*cur = *curSrc;
-			curSrc++;
-			cur++;
-		}
-		curRow += destPitch;
-		c += srcPitch;
-	}
+	Graphics::copyBlit(curRow, c, destPitch, srcPitch, rx, ry, 1);
 }
 
 uint8 Picture::getData(int16 x, int16 y) {
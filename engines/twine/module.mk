@@ -25,6 +25,7 @@ MODULE_OBJS := \
 	renderer/redraw.o \
 	renderer/renderer.o \
 	renderer/screens.o \
+	renderer/spanfill.o \
 	\
 	scene/actor.o \
 	scene/animations.o \
@@ -51,6 +52,18 @@ MODULE_OBJS := \
 	text.o \
 	twine.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	renderer/spanfill-sse2.o
+
+$(MODULE)/renderer/spanfill-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	renderer/spanfill-neon.o
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_TWINE), DYNAMIC_PLUGIN)
 PLUGIN := 1
@@ -29,6 +29,7 @@
 #include "twine/parser/body.h"
 #include "twine/renderer/redraw.h"
 #include "twine/renderer/shadeangletab.h"
+#include "twine/renderer/spanfill.h"
 #include "twine/resources/resources.h"
 #include "twine/scene/actor.h"
 #include "twine/scene/grid.h"
@@ -490,32 +491,71 @@ bool Renderer::computePolygons(int16 polyRenderType, const Vertex *vertices, int
 	return true;
 }
 
-void Renderer::renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
+/**
+ * Walks the scanlines of a polygon whose edges were prepared in the polygon
+ * tab by computePolygons() or prepareCircle(), and only visits the lines that
+ * are on the screen. The left edges are followed by the right edges screen
+ * height entries later, and the colors are laid out in the same way.
+ */
+class PolygonSpans {
+public:
+	PolygonSpans(TwinEEngine *engine, const int16 *polyTab, const int16 *colorTab, int vtop, int32 vsize)
+		: _width(engine->width()), _height(engine->height()), _lines(vsize), _line(-1) {
+		if (vtop < 0) {
+			_lines += vtop;
+			vtop = 0;
+		}
+		if (vtop + _lines > _height) {
+			_lines = _height - vtop;
+		}
+		_out = (uint8 *)engine->_frontVideoBuffer.getBasePtr(0, vtop);
+		_edges = &polyTab[vtop];
+		_colors = &colorTab[vtop];
 	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
+
+	/** Advance to the next scanline, and return false if there are no more. */
+	bool next() {
+		return ++_line < _lines;
 	}
-	int32 sens = 1;
 
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = ptr1[0];
-		int16 xMax = ptr1[screenHeight];
+	uint8 *line() const { return _out + _line * _width; }
+	int16 left() const { return _edges[_line]; }
+	int16 right() const { return _edges[_line + _height]; }
+	uint16 leftColor() const { return _colors[_line]; }
+	uint16 rightColor() const { return _colors[_line + _height]; }
 
-		ptr1++;
-		uint8 *pDest = out + xMin;
+	/** Set a pixel of the current line, unless it is outside of the screen. */
+	void putPixel(int32 x, uint8 color) const {
+		if (x >= 0 && x < _width) {
+			line()[x] = color;
+		}
+	}
 
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (uint8)color;
+	/** Fill the pixels from start to stop of the current line which are on the screen. */
+	void fill(int32 start, int32 stop, uint8 color) const {
+		start = MAX<int32>(start, 0);
+		stop = MIN<int32>(stop, _width - 1);
+		if (start <= stop) {
+			memset(line() + start, color, stop - start + 1);
 		}
+	}
+
+private:
+	const int32 _width;
+	const int32 _height;
+	uint8 *_out;
+	const int16 *_edges;
+	const int16 *_colors;
+	int32 _lines;
+	int32 _line;
+};
+
+void Renderer::renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const {
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
+	int32 sens = 1;
+
+	while (spans.next()) {
+		spans.fill(spans.left(), spans.right(), (uint8)color);
 
 		color += sens;
 		if (!(color & 0xF)) {
@@ -524,35 +564,16 @@ void Renderer::renderPolygonsCopper(int vtop, int32 vsize, uint16 color) const {
 				color += sens;
 			}
 		}
-		out += screenWidth;
 	}
 }
 
 void Renderer::renderPolygonsBopper(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
 	int32 sens = 1;
 	int32 line = 2;
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = ptr1[0];
-		int16 xMax = ptr1[screenHeight];
-		ptr1++;
-
-		uint8 *pDest = out + xMin;
 
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = (uint8)color;
-		}
+	while (spans.next()) {
+		spans.fill(spans.left(), spans.right(), (uint8)color);
 
 		line--;
 		if (!line) {
@@ -565,63 +586,28 @@ void Renderer::renderPolygonsBopper(int vtop, int32 vsize, uint16 color) const {
 				}
 			}
 		}
-		out += screenWidth;
 	}
 }
 
 void Renderer::renderPolygonsFlat(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		const int16 start = ptr1[0];
-		const int16 stop = ptr1[screenHeight];
-		ptr1++;
-		const int32 hsize = stop - start;
-
-		for (int32 j = start; j <= hsize + start; j++) {
-			if (j >= 0 && j < screenWidth) {
-				out[j] = color;
-			}
-		}
-		out += screenWidth;
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
+	while (spans.next()) {
+		spans.fill(spans.left(), spans.right(), (uint8)color);
 	}
 }
 
 #define ROL16(x, b) (((x) << (b)) | ((x) >> (16 - (b))))
 
 void Renderer::renderPolygonsTele(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
 
 	uint16 acc = 17371;
 	color &= 0xFF;
 	uint16 col;
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = ptr1[0];
-		int16 xMax = ptr1[screenHeight];
-		++ptr1;
-		uint8 *pDest = out + xMin;
+	while (spans.next()) {
+		int16 xMin = spans.left();
+		const int16 xMax = spans.right();
+		uint8 *pDest = spans.line() + xMin;
 		col = xMin;
 
 		for (; xMin <= xMax; xMin++) {
@@ -630,54 +616,28 @@ void Renderer::renderPolygonsTele(int vtop, int32 vsize, uint16 color) const {
 
 			*pDest++ = (uint8)col;
 		}
-		out += screenWidth;
 	}
 }
 
 void Renderer::renderPolygonsTrans(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	do {
-		int16 start = ptr1[0];
-		int16 stop = ptr1[screenHeight];
-
-		ptr1++;
-		int32 hsize = stop - start;
-
-		if (hsize >= 0) {
-			hsize++;
-			uint8 *out2 = start + out;
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
+	while (spans.next()) {
+		const int16 start = spans.left();
+		if (spans.right() >= start) {
+			uint8 *out2 = spans.line() + start;
 			*out2 = (*(out2)&0x0F) | color;
-			out2++;
 		}
-		out += screenWidth;
-	} while (--vsize);
+	}
 }
 
 // Used e.g for the legs of the horse or the ears of most characters
 void Renderer::renderPolygonsTrame(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
 	int32 pair = 0;
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 start = ptr1[0];
-		int16 stop = ptr1[screenHeight];
-		ptr1++;
-		uint8 *out2 = start + out;
+	while (spans.next()) {
+		const int16 start = spans.left();
+		int16 stop = spans.right();
+		uint8 *out2 = spans.line() + start;
 		stop = ((stop - start) + 1) / 2;
 		if (stop > 0) {
 			pair ^= 1; // paire/impair
@@ -690,125 +650,71 @@ void Renderer::renderPolygonsTrame(int vtop, int32 vsize, uint16 color) const {
 				out2 += 2;
 			}
 		}
-
-		out += screenWidth;
 	}
 }
 
 void Renderer::renderPolygonsGouraud(int vtop, int32 vsize) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int16 *ptr2 = &_colorProgressionBuffer[vtop];
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
 	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		uint16 startColor = ptr2[0];
-		const uint16 stopColor = ptr2[screenHeight];
-
-		int16 colorDiff = stopColor - startColor;
-
-		const int16 stop = ptr1[screenHeight];
-		const int16 start = ptr1[0];
-
-		ptr1++;
-		uint8 *out2 = start + out;
-		int32 hsize = stop - start;
-
-		ptr2++;
 
-		if (hsize == 0) {
-			if (start >= 0 && start < screenWidth) {
-				*out2 = ((startColor + stopColor) / 2) / 256; // average of the 2 colors
-			}
-		} else if (hsize == 1) {
-			if (start >= 1 && start < screenWidth - 1) {
-				*(out2 + 1) = stopColor / 256;
-			}
-
-			if (start >= 0 && start < screenWidth) {
-				*out2 = startColor / 256;
-			}
-		} else if (hsize == 2) {
-			if (start >= 2 && start < screenWidth - 2) {
-				*(out2 + 2) = stopColor / 256;
-			}
-
-			if (start >= 1 && start < screenWidth - 1) {
-				*(out2 + 1) = ((startColor + stopColor) / 2) / 256; // average of the 2 colors
-			}
+	while (spans.next()) {
+		const int16 start = spans.left();
+		const int16 stop = spans.right();
+		const int32 hsize = stop - start;
+		if (hsize < 0) {
+			continue;
+		}
 
-			if (start >= 0 && start < screenWidth) {
-				*out2 = startColor / 256;
-			}
-		} else if (hsize > 0) {
-			int32 currentXPos = start;
-			colorDiff /= hsize;
-			hsize++;
+		uint16 startColor = spans.leftColor();
+		const uint16 stopColor = spans.rightColor();
 
-			if (hsize % 2) {
-				if (currentXPos >= 0 && currentXPos < screenWidth) {
-					*out2 = startColor / 256;
+		if (hsize <= 2) {
+			// the short spans only use the colors at both ends and their average
+			const uint8 averageColor = ((startColor + stopColor) / 2) / 256;
+			if (hsize == 0) {
+				spans.putPixel(start, averageColor);
+			} else {
+				spans.putPixel(start, startColor / 256);
+				if (hsize == 2) {
+					spans.putPixel(start + 1, averageColor);
 				}
-				++out2;
-				++currentXPos;
-				startColor += colorDiff;
+				spans.putPixel(stop, stopColor / 256);
 			}
-			hsize /= 2;
+			continue;
+		}
 
-			do {
-				for (int i = 0; i < 2; ++i) {
-					if (currentXPos >= 0 && currentXPos < screenWidth) {
-						*out2 = startColor / 256;
-					}
-					++out2;
-					++currentXPos;
-					startColor += colorDiff;
-				}
-			} while (--hsize);
+		const int16 colorDiff = (int16)(stopColor - startColor) / hsize;
+
+		// skip the part of the span left of the screen
+		int32 currentXPos = start;
+		if (currentXPos < 0) {
+			startColor += -currentXPos * colorDiff;
+			currentXPos = 0;
+		}
+		const int32 lastXPos = MIN<int32>(stop, screenWidth - 1);
+		if (currentXPos <= lastXPos) {
+			fillGouraudSpan(spans.line() + currentXPos, lastXPos - currentXPos + 1, startColor, colorDiff);
 		}
-		out += screenWidth;
 	}
 }
 
 // used for the most of the heads of the characters and the horse body
 void Renderer::renderPolygonsDither(int vtop, int32 vsize) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int16 *ptr2 = &_colorProgressionBuffer[vtop];
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
 	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
 
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 stop = ptr1[screenHeight];
-		int16 start = ptr1[0];
-		ptr1++;
+	while (spans.next()) {
+		const int16 stop = spans.right();
+		const int16 start = spans.left();
 		int32 hsize = stop - start;
 		if (hsize < 0) {
-			out += screenWidth;
 			continue;
 		}
-		uint16 startColor = ptr2[0];
-		uint16 stopColor = ptr2[screenHeight];
+		uint16 startColor = spans.leftColor();
+		uint16 stopColor = spans.rightColor();
 		int32 currentXPos = start;
 
-		uint8 *out2 = start + out;
-		ptr2++;
+		uint8 *out2 = spans.line() + start;
 
 		if (hsize == 0) {
 			if (currentXPos >= 0 && currentXPos < screenWidth) {
@@ -908,7 +814,6 @@ void Renderer::renderPolygonsDither(int vtop, int32 vsize) const {
 				} while (--hsize);
 			}
 		}
-		out += screenWidth;
 	}
 }
 
@@ -955,32 +860,9 @@ void Renderer::renderPolygonsMarble(int vtop, int32 vsize, uint16 color) const {
 }
 
 void Renderer::renderPolygonsSimplified(int vtop, int32 vsize, uint16 color) const {
-	uint8 *out = (uint8 *)_engine->_frontVideoBuffer.getBasePtr(0, vtop);
-	const int16 *ptr1 = &_polyTab[vtop];
-	const int16 *ptr2 = &_colorProgressionBuffer[vtop];
-	const int screenWidth = _engine->width();
-	const int screenHeight = _engine->height();
-
-	int32 renderLoop = vsize;
-	if (vtop < 0) {
-		out += screenWidth * ABS(vtop);
-		renderLoop -= ABS(vtop);
-	}
-	if (renderLoop > screenHeight) {
-		renderLoop = screenHeight;
-	}
-	for (int32 currentLine = 0; currentLine < renderLoop; ++currentLine) {
-		int16 xMin = MAX<int16>(0, ptr1[0]);
-		const int16 xMax = MIN<int16>((int16)(screenWidth - 1), ptr1[screenHeight]);
-		uint8 *pDest = out + xMin;
-
-		color = (*ptr2++) >> 8;
-		for (; xMin <= xMax; xMin++) {
-			*pDest++ = color;
-		}
-		++ptr1;
-
-		out += screenWidth;
+	PolygonSpans spans(_engine, _polyTab, _colorProgressionBuffer, vtop, vsize);
+	while (spans.next()) {
+		spans.fill(spans.left(), spans.right(), spans.leftColor() >> 8);
 	}
 }
 
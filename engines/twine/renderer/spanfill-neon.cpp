@@ -0,0 +1,46 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "twine/renderer/spanfill.h"
+
+#include <arm_neon.h>
+
+namespace TwinE {
+
+int32 fillGouraudSpanNEON(uint8 *out, int32 count, uint16 color, int16 step) {
+	static const uint16 indices[8] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+
+	// The 16 bit lanes wrap around just like the scalar color does
+	const uint16x8_t offsets = vmulq_n_u16(vld1q_u16(indices), (uint16)step);
+	const uint16x8_t step8 = vdupq_n_u16((uint16)(step * 8));
+	const uint16x8_t step16 = vdupq_n_u16((uint16)(step * 16));
+	uint16x8_t lo = vaddq_u16(vdupq_n_u16(color), offsets);
+
+	int32 done = 0;
+	for (; done + 16 <= count; done += 16) {
+		const uint16x8_t hi = vaddq_u16(lo, step8);
+		vst1q_u8(out + done, vcombine_u8(vshrn_n_u16(lo, 8), vshrn_n_u16(hi, 8)));
+		lo = vaddq_u16(lo, step16);
+	}
+	return done;
+}
+
+} // namespace TwinE
@@ -0,0 +1,44 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "twine/renderer/spanfill.h"
+
+#include <emmintrin.h>
+
+namespace TwinE {
+
+int32 fillGouraudSpanSSE2(uint8 *out, int32 count, uint16 color, int16 step) {
+	// The 16 bit lanes wrap around just like the scalar color does
+	const __m128i offsets = _mm_mullo_epi16(_mm_set1_epi16(step), _mm_setr_epi16(0, 1, 2, 3, 4, 5, 6, 7));
+	const __m128i step8 = _mm_set1_epi16((int16)(step * 8));
+	const __m128i step16 = _mm_set1_epi16((int16)(step * 16));
+	__m128i lo = _mm_add_epi16(_mm_set1_epi16((int16)color), offsets);
+
+	int32 done = 0;
+	for (; done + 16 <= count; done += 16) {
+		const __m128i hi = _mm_add_epi16(lo, step8);
+		_mm_storeu_si128((__m128i *)(out + done), _mm_packus_epi16(_mm_srli_epi16(lo, 8), _mm_srli_epi16(hi, 8)));
+		lo = _mm_add_epi16(lo, step16);
+	}
+	return done;
+}
+
+} // namespace TwinE
@@ -0,0 +1,59 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/cpu.h"
+#include "twine/renderer/spanfill.h"
+
+namespace TwinE {
+
+typedef int32 (*GouraudSpanFiller)(uint8 *out, int32 count, uint16 color, int16 step);
+
+static GouraudSpanFiller selectGouraudSpanFiller() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return fillGouraudSpanSSE2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return fillGouraudSpanNEON;
+#endif
+
+	return nullptr;
+}
+
+void fillGouraudSpan(uint8 *out, int32 count, uint16 color, int16 step) {
+	const GouraudSpanFiller filler = selectGouraudSpanFiller();
+
+	// Short spans are the most common ones, and not worth the setup
+	if (filler && count >= 16) {
+		const int32 done = filler(out, count, color, step);
+		out += done;
+		color += done * step;
+		count -= done;
+	}
+
+	for (; count > 0; --count) {
+		*out++ = color >> 8;
+		color += step;
+	}
+}
+
+} // namespace TwinE
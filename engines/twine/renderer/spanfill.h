@@ -0,0 +1,50 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TWINE_RENDERER_SPANFILL_H
+#define TWINE_RENDERER_SPANFILL_H
+
+#include "common/scummsys.h"
+
+namespace TwinE {
+
+/**
+ * Fill a horizontal span of a Gouraud shaded polygon.
+ *
+ * The color is an 8.8 fixed point palette index which wraps around at 16 bit
+ * like in the original renderer: pixel i gets the high byte of
+ * color + i * step.
+ */
+void fillGouraudSpan(uint8 *out, int32 count, uint16 color, int16 step);
+
+#ifdef SCUMMVM_SSE2
+/** Fill as many whole blocks of 16 pixels as fit in the span, and return their number of pixels. */
+int32 fillGouraudSpanSSE2(uint8 *out, int32 count, uint16 color, int16 step);
+#endif
+
+#ifdef SCUMMVM_NEON
+/** Fill as many whole blocks of 16 pixels as fit in the span, and return their number of pixels. */
+int32 fillGouraudSpanNEON(uint8 *out, int32 count, uint16 color, int16 step);
+#endif
+
+} // namespace TwinE
+
+#endif
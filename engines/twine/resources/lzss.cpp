@@ -20,11 +20,12 @@
  */
 
 #include "twine/resources/lzss.h"
+#include "common/lzss.h"
 #include "common/textconsole.h"
 
 namespace TwinE {
 
-LzssReadStream::LzssReadStream(Common::ReadStream *indata, uint32 mode, uint32 realsize) {
+LzssReadStream::LzssReadStream(Common::SeekableReadStream *indata, uint32 mode, uint32 realsize) {
 	_outLzssBufData = new uint8[realsize]();
 	decodeLZSS(indata, mode, realsize);
 	_size = realsize;
@@ -36,50 +37,10 @@ LzssReadStream::~LzssReadStream() {
 	delete[] _outLzssBufData;
 }
 
-void LzssReadStream::decodeLZSS(Common::ReadStream *in, uint32 mode, uint32 dataSize) {
-	if (in->eos() || in->err() || dataSize == 0) {
-		_err = dataSize > 0;
-		return;
-	}
-
-	uint8 *dst = _outLzssBufData;
-	int32 remainingBytes = (int32)dataSize;
-
-	do {
-		uint8 b = in->readByte();
-		for (int32 d = 0; d < 8; d++) {
-			if (in->eos() || in->err()) {
-				_err = dataSize > 0;
-				return;
-			}
-			int32 length;
-			if (!(b & (1 << d))) {
-				const uint16 offset = in->readUint16LE();
-				length = (offset & 0x0F) + (mode + 1);
-				const uint8 *ptr = dst - (offset >> 4) - 1;
-				if (remainingBytes < length) {
-					_err = true;
-					return;
-				}
-				remainingBytes -= length;
-				for (int32 i = 0; i < length; i++) {
-					*dst++ = *ptr++;
-				}
-			} else {
-				length = 1;
-				if (remainingBytes < length) {
-					_err = true;
-					return;
-				}
-				remainingBytes -= length;
-				*dst++ = in->readByte();
-			}
-			dataSize -= length;
-			if (dataSize <= 0) {
-				return;
-			}
-		}
-	} while (dataSize);
+void LzssReadStream::decodeLZSS(Common::SeekableReadStream *in, uint32 mode, uint32 dataSize) {
+	// References hold the distance minus one, and the length minus mode + 1
+	const uint32 size = Common::decompressLZSS(in, in->size() - in->pos(), _outLzssBufData, dataSize, 4, mode + 1, 1);
+	_err = size != dataSize;
 }
 
 bool LzssReadStream::eos() const {
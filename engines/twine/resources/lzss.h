@@ -33,10 +33,10 @@ private:
 	uint32 _pos;
 	bool _err = false;
 
-	void decodeLZSS(Common::ReadStream *indata, uint32 mode, uint32 length);
+	void decodeLZSS(Common::SeekableReadStream *indata, uint32 mode, uint32 length);
 
 public:
-	LzssReadStream(Common::ReadStream *indata, uint32 mode, uint32 realsize);
+	LzssReadStream(Common::SeekableReadStream *indata, uint32 mode, uint32 realsize);
 	virtual ~LzssReadStream();
 
 	void clearErr() override { _err = false; }
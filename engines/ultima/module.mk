@@ -328,6 +328,7 @@ MODULE_OBJS := \
 	nuvie/screen/game_palette.o \
 	nuvie/screen/scale.o \
 	nuvie/screen/screen.o \
+	nuvie/screen/shading.o \
 	nuvie/screen/surface.o \
 	nuvie/script/script.o \
 	nuvie/script/script_actor.o \
@@ -581,6 +582,18 @@ MODULE_OBJS := \
 	ultima8/world/actors/teleport_to_egg_process.o \
 	ultima8/world/actors/u8_avatar_mover_process.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	nuvie/screen/shading-sse2.o
+
+$(MODULE)/nuvie/screen/shading-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	nuvie/screen/shading-neon.o
+endif
+
 # This module can be built as a plugin
 ifeq ($(ENABLE_ULTIMA), DYNAMIC_PLUGIN)
 PLUGIN := 1
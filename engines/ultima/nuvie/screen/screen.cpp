@@ -25,6 +25,7 @@
 #include "ultima/nuvie/screen/surface.h"
 #include "ultima/nuvie/screen/scale.h"
 #include "ultima/nuvie/screen/screen.h"
+#include "ultima/nuvie/screen/shading.h"
 #include "ultima/nuvie/gui/widgets/map_window.h"
 #include "ultima/nuvie/gui/widgets/background.h"
 #include "common/system.h"
@@ -1073,11 +1074,7 @@ void Screen::blitalphamap8(sint16 x, sint16 y, Common::Rect *clip_rect) {
 		pixels16 += y * _renderSurface->w + x;
 
 		for (i = 0; i < src_h; i++) {
-			for (j = 0; j < src_w; j++) {
-				pixels16[j] = (((unsigned char)(((float)((pixels16[j] & _renderSurface->Rmask) >> _renderSurface->Rshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Rshift) |      //R
-				              (((unsigned char)(((float)((pixels16[j] & _renderSurface->Gmask) >> _renderSurface->Gshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Gshift) |      //G
-				              (((unsigned char)(((float)((pixels16[j] & _renderSurface->Bmask) >> _renderSurface->Bshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Bshift);       //B
-			}
+			shade_span16(pixels16, src_buf, src_w);
 			pixels16 += _renderSurface->w;
 			src_buf += shading_rect.width();
 		}
@@ -1092,9 +1089,9 @@ void Screen::blitalphamap8(sint16 x, sint16 y, Common::Rect *clip_rect) {
 
 		for (i = 0; i < src_h; i++) {
 			for (j = 0; j < src_w; j++) {
-				pixels[j] = (((unsigned char)(((float)((pixels[j] & _renderSurface->Rmask) >> _renderSurface->Rshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Rshift) |      //R
-				            (((unsigned char)(((float)((pixels[j] & _renderSurface->Gmask) >> _renderSurface->Gshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Gshift) |      //G
-				            (((unsigned char)(((float)((pixels[j] & _renderSurface->Bmask) >> _renderSurface->Bshift)) * (float)(src_buf[j]) / 255.0f)) << _renderSurface->Bshift);       //B
+				pixels[j] = ((((pixels[j] & _renderSurface->Rmask) >> _renderSurface->Rshift) * src_buf[j] / 255) << _renderSurface->Rshift) |      //R
+				            ((((pixels[j] & _renderSurface->Gmask) >> _renderSurface->Gshift) * src_buf[j] / 255) << _renderSurface->Gshift) |      //G
+				            ((((pixels[j] & _renderSurface->Bmask) >> _renderSurface->Bshift) * src_buf[j] / 255) << _renderSurface->Bshift);       //B
 			}
 			pixels += _renderSurface->w;
 			src_buf += shading_rect.width();
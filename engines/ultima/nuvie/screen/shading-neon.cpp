@@ -0,0 +1,57 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ultima/nuvie/core/nuvie_defs.h"
+#include "ultima/nuvie/screen/shading.h"
+#include "ultima/nuvie/screen/surface.h"
+
+#include <arm_neon.h>
+
+namespace Ultima {
+namespace Nuvie {
+
+static inline uint16x8_t shade_channel(uint16x8_t p, uint16x8_t mask, int shift, uint16x8_t a) {
+	const uint16x8_t one = vdupq_n_u16(1);
+	// c * a fits in 16 bits, and (x + 1 + (x >> 8)) >> 8 is x / 255 for all of them
+	uint16x8_t c = vmulq_u16(vshlq_u16(vandq_u16(p, mask), vdupq_n_s16(-shift)), a);
+	c = vshrq_n_u16(vaddq_u16(vaddq_u16(c, one), vshrq_n_u16(c, 8)), 8);
+	return vshlq_u16(c, vdupq_n_s16(shift));
+}
+
+int shade_span16_neon(uint16 *pixels, const uint8 *shading, int count) {
+	const uint16x8_t rMask = vdupq_n_u16((uint16)RenderSurface::Rmask);
+	const uint16x8_t gMask = vdupq_n_u16((uint16)RenderSurface::Gmask);
+	const uint16x8_t bMask = vdupq_n_u16((uint16)RenderSurface::Bmask);
+
+	int done = 0;
+	for (; done + 8 <= count; done += 8) {
+		const uint16x8_t p = vld1q_u16(pixels + done);
+		const uint16x8_t a = vmovl_u8(vld1_u8(shading + done));
+		const uint16x8_t r = shade_channel(p, rMask, RenderSurface::Rshift, a);
+		const uint16x8_t g = shade_channel(p, gMask, RenderSurface::Gshift, a);
+		const uint16x8_t b = shade_channel(p, bMask, RenderSurface::Bshift, a);
+		vst1q_u16(pixels + done, vorrq_u16(vorrq_u16(r, g), b));
+	}
+	return done;
+}
+
+} // End of namespace Nuvie
+} // End of namespace Ultima
@@ -0,0 +1,61 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "ultima/nuvie/core/nuvie_defs.h"
+#include "ultima/nuvie/screen/shading.h"
+#include "ultima/nuvie/screen/surface.h"
+
+#include <emmintrin.h>
+
+namespace Ultima {
+namespace Nuvie {
+
+static inline __m128i shade_channel(__m128i p, __m128i mask, __m128i shift, __m128i a) {
+	const __m128i one = _mm_set1_epi16(1);
+	// c * a fits in 16 bits, and (x + 1 + (x >> 8)) >> 8 is x / 255 for all of them
+	__m128i c = _mm_mullo_epi16(_mm_srl_epi16(_mm_and_si128(p, mask), shift), a);
+	c = _mm_srli_epi16(_mm_add_epi16(_mm_add_epi16(c, one), _mm_srli_epi16(c, 8)), 8);
+	return _mm_sll_epi16(c, shift);
+}
+
+int shade_span16_sse2(uint16 *pixels, const uint8 *shading, int count) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i rMask = _mm_set1_epi16((int16)RenderSurface::Rmask);
+	const __m128i gMask = _mm_set1_epi16((int16)RenderSurface::Gmask);
+	const __m128i bMask = _mm_set1_epi16((int16)RenderSurface::Bmask);
+	const __m128i rShift = _mm_cvtsi32_si128(RenderSurface::Rshift);
+	const __m128i gShift = _mm_cvtsi32_si128(RenderSurface::Gshift);
+	const __m128i bShift = _mm_cvtsi32_si128(RenderSurface::Bshift);
+
+	int done = 0;
+	for (; done + 8 <= count; done += 8) {
+		const __m128i p = _mm_loadu_si128((const __m128i *)(pixels + done));
+		const __m128i a = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(shading + done)), zero);
+		const __m128i r = shade_channel(p, rMask, rShift, a);
+		const __m128i g = shade_channel(p, gMask, gShift, a);
+		const __m128i b = shade_channel(p, bMask, bShift, a);
+		_mm_storeu_si128((__m128i *)(pixels + done), _mm_or_si128(_mm_or_si128(r, g), b));
+	}
+	return done;
+}
+
+} // End of namespace Nuvie
+} // End of namespace Ultima
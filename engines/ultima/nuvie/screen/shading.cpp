@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "common/cpu.h"
+#include "ultima/nuvie/core/nuvie_defs.h"
+#include "ultima/nuvie/screen/shading.h"
+#include "ultima/nuvie/screen/surface.h"
+
+namespace Ultima {
+namespace Nuvie {
+
+typedef int (*SpanShader)(uint16 *pixels, const uint8 *shading, int count);
+
+static SpanShader select_span_shader() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return shade_span16_sse2;
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return shade_span16_neon;
+#endif
+
+	return nullptr;
+}
+
+void shade_span16(uint16 *pixels, const uint8 *shading, int count) {
+	const SpanShader shader = select_span_shader();
+
+	if (shader && count >= 8) {
+		const int done = shader(pixels, shading, count);
+		pixels += done;
+		shading += done;
+		count -= done;
+	}
+
+	// (c * a) / 255 per channel, the same as scaling by a / 255.0f and truncating
+	for (; count > 0; --count, ++pixels, ++shading) {
+		const uint32 a = *shading;
+		const uint32 p = *pixels;
+		const uint32 r = ((p & RenderSurface::Rmask) >> RenderSurface::Rshift) * a / 255;
+		const uint32 g = ((p & RenderSurface::Gmask) >> RenderSurface::Gshift) * a / 255;
+		const uint32 b = ((p & RenderSurface::Bmask) >> RenderSurface::Bshift) * a / 255;
+		*pixels = (uint16)((r << RenderSurface::Rshift) | (g << RenderSurface::Gshift) | (b << RenderSurface::Bshift));
+	}
+}
+
+} // End of namespace Nuvie
+} // End of namespace Ultima
@@ -0,0 +1,49 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef NUVIE_SCREEN_SHADING_H
+#define NUVIE_SCREEN_SHADING_H
+
+#include "common/scummsys.h"
+
+namespace Ultima {
+namespace Nuvie {
+
+/**
+ * Darken a span of 16 bit pixels in the RenderSurface format by the matching
+ * smooth lighting opacities, where 255 leaves a pixel as is and 0 blacks it out.
+ */
+void shade_span16(uint16 *pixels, const uint8 *shading, int count);
+
+#ifdef SCUMMVM_SSE2
+/** Shade as many whole blocks of 8 pixels as fit in the span, and return their number of pixels. */
+int shade_span16_sse2(uint16 *pixels, const uint8 *shading, int count);
+#endif
+
+#ifdef SCUMMVM_NEON
+/** Shade as many whole blocks of 8 pixels as fit in the span, and return their number of pixels. */
+int shade_span16_neon(uint16 *pixels, const uint8 *shading, int count);
+#endif
+
+} // End of namespace Nuvie
+} // End of namespace Ultima
+
+#endif
@@ -33,8 +33,11 @@ ShapeFrame::ShapeFrame(const RawShapeFrame *rawframe) :
 
 	_pixels = new uint8[_width * _height];
 	_mask = new uint8[_width * _height]();
+	_lineSpans.resize(_height + 1);
 
 	for (int y = 0; y < _height; y++) {
+		_lineSpans[y] = _spans.size();
+
 		int32 xpos = 0;
 		const uint8 *linedata = rawframe->_rle_data + rawframe->_line_offsets[y];
 
@@ -52,6 +55,8 @@ ShapeFrame::ShapeFrame(const RawShapeFrame *rawframe) :
 				dlen >>= 1;
 			}
 
+			addSpan(y, xpos, dlen);
+
 			for (int doff = 0; doff < dlen; doff++) {
 				_pixels[y * _width + xpos + doff] = *linedata;
 				_mask[y * _width + xpos + doff] = 1;
@@ -69,6 +74,7 @@ ShapeFrame::ShapeFrame(const RawShapeFrame *rawframe) :
 
 	}
 
+	_lineSpans[_height] = _spans.size();
 }
 
 ShapeFrame::~ShapeFrame() {
@@ -76,6 +82,28 @@ ShapeFrame::~ShapeFrame() {
 	delete [] _mask;
 }
 
+void ShapeFrame::addSpan(int32 y, int32 x, int32 length) {
+	// Keep the span inside the frame
+	if (x + length > _width)
+		length = _width - x;
+	if (length <= 0)
+		return;
+
+	// Join it to the previous span of the line, if they touch
+	if (_spans.size() > _lineSpans[y]) {
+		Span &last = _spans.back();
+		if (last._x + last._length == x) {
+			last._length += length;
+			return;
+		}
+	}
+
+	Span span;
+	span._x = x;
+	span._length = length;
+	_spans.push_back(span);
+}
+
 // Checks to see if the frame has a pixel at the point
 bool ShapeFrame::hasPoint(int32 x, int32 y) const {
 	// Add the offset
@@ -22,6 +22,8 @@
 #ifndef ULTIMA8_GRAPHICS_SHAPEFRAME_H
 #define ULTIMA8_GRAPHICS_SHAPEFRAME_H
 
+#include "ultima/shared/std/containers.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -40,9 +42,23 @@ public:
 	uint8 *_pixels;
 	uint8 *_mask;
 
+	//! A run of opaque pixels on a line
+	struct Span {
+		int32 _x;       // x coord of the first pixel
+		int32 _length;  // Number of pixels
+	};
+
+	//! Spans of all the lines, left to right. Those of line y are
+	//! _spans[_lineSpans[y]] up to _spans[_lineSpans[y + 1]].
+	Std::vector<Span> _spans;
+	Std::vector<uint32> _lineSpans;
+
 	bool hasPoint(int32 x, int32 y) const;  // Check to see if a point is in the frame
 
 	uint8 getPixelAtPoint(int32 x, int32 y) const;  // Get the pixel at the point
+
+private:
+	void addSpan(int32 y, int32 x, int32 length);
 };
 
 } // End of namespace Ultima8
@@ -47,12 +47,6 @@
 //
 // Macros defined by this file:
 //
-// NOT_CLIPPED_Y - Does Y Clipping check per line
-//
-// NOT_CLIPPED_X - Does X Clipping check per Pixel
-//
-// LINE_END_ASSIGN - Calcuates the line_end pointer required for X clipping
-//
 // XNEG - Negates X values if doing shape flipping
 //
 // USE_XFORM_FUNC - Checks to see if we want to use XForm Blending for this pixel
@@ -102,9 +96,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 //
 #ifdef NO_CLIPPING
 
-#define LINE_END_ASSIGN //
-#define NOT_CLIPPED_X (1)
-#define NOT_CLIPPED_Y (1)
 #define OFFSET_PIXELS (_pixels)
 
 //
@@ -115,9 +106,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	const int		scrn_width = _clipWindow.width();
 	const int		scrn_height = _clipWindow.height();
 
-#define LINE_END_ASSIGN const uintX *dst_line_end = dst_line_start + scrn_width
-#define NOT_CLIPPED_X (dstpix >= dst_line_start && dstpix < dst_line_end)
-#define NOT_CLIPPED_Y (line >= 0 && line < scrn_height)
 #define OFFSET_PIXELS (off_pixels)
 
 	uint8			*off_pixels  = _pixels + _clipWindow.left * sizeof(uintX) + _clipWindow.top * _pitch;
@@ -174,7 +162,6 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	if (!frame)
 		return;
 	const uint8		*srcpixels		= frame->_pixels;
-	const uint8		*srcmask		= frame->_mask;
 	const uint32	*pal			= untformed_pal ?
 										s->getPalette()->_native_untransformed:
 										s->getPalette()->_native;
@@ -190,25 +177,47 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 	x -= XNEG(frame->_xoff);
 	y -= frame->_yoff;
 
-	assert(_pixels00 && _pixels && srcpixels && srcmask);
+	assert(_pixels00 && _pixels && srcpixels);
+
+	// Distance between two pixels of a span on the destination
+	const int32 dst_step = XNEG(1);
+
+	// Range of the lines, and of the x coords in a line, of the frame
+	// which are inside the clipping window. The clipping is done per
+	// span, so the pixel loops don't need to check for it.
+#ifdef NO_CLIPPING
+	const int32 line_min = 0;
+	const int32 line_max = height_;
+	const int32 xpos_min = 0;
+	const int32 xpos_max = width_;
+#else
+	const int32 line_min = MAX<int32>(0, -y);
+	const int32 line_max = MIN<int32>(height_, scrn_height - y);
+	const int32 xpos_min = dst_step > 0 ? -x : x - scrn_width + 1;
+	const int32 xpos_max = dst_step > 0 ? scrn_width - x : x + 1;
+#endif
+
+	const ShapeFrame::Span *spans = frame->_spans.empty() ? nullptr : &frame->_spans[0];
 
-	for (int i = 0; i < height_; i++)  {
-		const int line = y + i;
+	for (int i = line_min; i < line_max; i++)  {
+		const uint8	*srcline = srcpixels + i * width_;
+		uintX *dst_line_start = reinterpret_cast<uintX *>(OFFSET_PIXELS + _pitch * (y + i));
 
-		if (NOT_CLIPPED_Y) {
-			const uint8	*srcline = srcpixels + i * width_;
-			const uint8	*srcmaskline = srcmask + i * width_;
-			uintX *dst_line_start = reinterpret_cast<uintX *>(OFFSET_PIXELS + _pitch * line);
-			LINE_END_ASSIGN;
+		const ShapeFrame::Span *span = spans + frame->_lineSpans[i];
+		const ShapeFrame::Span *span_end = spans + frame->_lineSpans[i + 1];
 
-			for (int xpos = 0; xpos < width_; xpos++) {
-				if (srcmaskline[xpos] == 0)
-					continue;
+		for (; span != span_end; ++span) {
+			const int32 xstart = MAX<int32>(span->_x, xpos_min);
+			const int32 xend = MIN<int32>(span->_x + span->_length, xpos_max);
+			if (xstart >= xend)
+				continue;
 
-				uintX *dstpix = dst_line_start + x + XNEG(xpos);
+			const uint8 *srcpix = srcline + xstart;
+			const uint8 *srcpix_end = srcline + xend;
+			uintX *dstpix = dst_line_start + x + XNEG(xstart);
 
-				if (NOT_CLIPPED_X && NOT_DESTINATION_MASKED) {
-					const uint8 *srcpix = srcline + xpos;
+			for (; srcpix != srcpix_end; ++srcpix, dstpix += dst_step) {
+				if (NOT_DESTINATION_MASKED) {
 					#ifdef XFORM_SHAPES
 					if (USE_XFORM_FUNC) {
 						*dstpix = CUSTOM_BLEND(BlendPreModulated(xform_pal[*srcpix], *dstpix));
@@ -226,8 +235,5 @@ const int32 neg = (FLIP_CONDITIONAL)?-1:0;
 #undef NOT_DESTINATION_MASKED
 #undef OFFSET_PIXELS
 #undef CUSTOM_BLEND
-#undef LINE_END_ASSIGN
-#undef NOT_CLIPPED_X
-#undef NOT_CLIPPED_Y
 #undef XNEG
 #undef USE_XFORM_FUNC
@@ -43,17 +43,15 @@ namespace Ultima8 {
 
 ItemSorter::ItemSorter() :
 	_shapes(nullptr), _surf(nullptr), _items(nullptr), _itemsTail(nullptr),
-	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0) {
+	_itemsUnused(nullptr), _sortLimit(0), _camSx(0), _camSy(0), _orderCounter(0),
+	_sortPending(false), _cellCols(0), _cellRows(0) {
 	int i = 2048;
 	while (i--) _itemsUnused = new SortItem(_itemsUnused);
 }
 
 ItemSorter::~ItemSorter() {
-	//
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
+	RecycleItems(_added);
+	RecycleItems(_sorted);
 	_items = nullptr;
 	_itemsTail = nullptr;
 
@@ -62,8 +60,6 @@ ItemSorter::~ItemSorter() {
 		delete _itemsUnused;
 		_itemsUnused = _next;
 	}
-
-	delete [] _items;
 }
 
 void ItemSorter::BeginDisplayList(RenderSurface *rs,
@@ -71,13 +67,10 @@ void ItemSorter::BeginDisplayList(RenderSurface *rs,
 	// Get the _shapes, if required
 	if (!_shapes) _shapes = GameData::get_instance()->getMainShapes();
 
-	//
-	if (_itemsTail) {
-		_itemsTail->_next = _itemsUnused;
-		_itemsUnused = _items;
-	}
-	_items = nullptr;
-	_itemsTail = nullptr;
+	// Drop any items which were added but never sorted. The last sorted
+	// list is kept until the new one is sorted, so that it can be reused.
+	RecycleItems(_added);
+	_sortPending = true;
 
 	// Set the RenderSurface, and reset the item list
 	_surf = rs;
@@ -185,14 +178,139 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 	// are never deleted
 	si->_depends.clear();
 
-	// Iterate the list and compare _shapes
+	// Take it from the unused items. Sorting is left to SortDisplayList,
+	// which can reuse the last list if nothing moved.
+	_itemsUnused = _itemsUnused->_next;
+	si->_addIndex = _added.size();
+	_added.push_back(si);
+}
+
+void ItemSorter::AddItem(const Item *add) {
+	int32 x, y, z;
+	add->getLerped(x, y, z);
+	AddItem(x, y, z, add->getShape(), add->getFrame(),
+			add->getFlags(), add->getExtFlags(), add->getObjId());
+}
+
+void ItemSorter::RecycleItems(Std::vector<SortItem *> &items) {
+	for (uint i = 0; i < items.size(); i++) {
+		SortItem *si = items[i];
+		si->_depends.clear();
+		si->_next = _itemsUnused;
+		_itemsUnused = si;
+	}
+	items.resize(0);
+}
 
-	// Ok,
-	SortItem *addpoint = nullptr;
-	for (SortItem *si2 = _items; si2 != nullptr; si2 = si2->_next) {
-		// Get the insert point... which is before the first item that has higher z than us
-		if (!addpoint && si->ListLessThan(si2))
-			addpoint = si2;
+/**
+ * Order of the sorted list, which keeps items that compare equal in the
+ * order they were added.
+ */
+static bool ListOrderLess(const SortItem *si1, const SortItem *si2) {
+	if (si1->ListLessThan(si2))
+		return true;
+	if (si2->ListLessThan(si1))
+		return false;
+	return si1->_addIndex < si2->_addIndex;
+}
+
+void ItemSorter::SortDisplayList() {
+	_sortPending = false;
+
+	if (ReuseSortedList())
+		return;
+
+	RecycleItems(_sorted);
+	_sorted.swap(_added);
+	_items = nullptr;
+	_itemsTail = nullptr;
+
+	// Set up the cells, so that each covers a square of the clipping
+	// rect. Items outside of it go into the cells on the edges.
+	_surf->GetClippingRect(_cellArea);
+	_cellCols = MAX<int32>(1, (_cellArea.width() + (1 << CELL_SHIFT) - 1) >> CELL_SHIFT);
+	_cellRows = MAX<int32>(1, (_cellArea.height() + (1 << CELL_SHIFT) - 1) >> CELL_SHIFT);
+	if (_cells.size() < (uint)(_cellCols * _cellRows))
+		_cells.resize(_cellCols * _cellRows);
+	for (uint i = 0; i < _cells.size(); i++)
+		_cells[i].resize(0);
+
+	for (uint i = 0; i < _sorted.size(); i++)
+		InsertSortItem(_sorted[i]);
+}
+
+/**
+ * If the items added since BeginDisplayList all sort like the ones of the
+ * last list, their dependencies are taken from it instead of being checked
+ * again.
+ */
+bool ItemSorter::ReuseSortedList() {
+	if (_added.size() != _sorted.size())
+		return false;
+
+	for (uint i = 0; i < _added.size(); i++) {
+		if (!_added[i]->sortsLike(*_sorted[i]))
+			return false;
+	}
+
+	for (uint i = 0; i < _added.size(); i++) {
+		SortItem *si = _added[i];
+		const SortItem *old = _sorted[i];
+		si->_occluded = old->_occluded;
+
+		SortItem::DependsList::iterator it = old->_depends.begin();
+		SortItem::DependsList::iterator end = old->_depends.end();
+		for (; it != end; ++it)
+			si->_depends.push_back(_added[(*it)->_addIndex]);
+	}
+
+	SortItem *tail = nullptr;
+	for (const SortItem *old = _items; old != nullptr; old = old->_next) {
+		SortItem *si = _added[old->_addIndex];
+		si->_prev = tail;
+		si->_next = nullptr;
+		if (tail)
+			tail->_next = si;
+		else
+			_items = si;
+		tail = si;
+	}
+	_itemsTail = tail;
+
+	RecycleItems(_sorted);
+	_sorted.swap(_added);
+	return true;
+}
+
+void ItemSorter::InsertSortItem(SortItem *si) {
+	const int32 maxX = (_cellCols << CELL_SHIFT) - 1;
+	const int32 maxY = (_cellRows << CELL_SHIFT) - 1;
+	const int32 cx1 = CLIP<int32>(si->_sxLeft - _cellArea.left, 0, maxX) >> CELL_SHIFT;
+	const int32 cx2 = CLIP<int32>(si->_sxRight - _cellArea.left, 0, maxX) >> CELL_SHIFT;
+	const int32 cy1 = CLIP<int32>(si->_syTop - _cellArea.top, 0, maxY) >> CELL_SHIFT;
+	const int32 cy2 = CLIP<int32>(si->_syBot - _cellArea.top, 0, maxY) >> CELL_SHIFT;
+
+	// Items can only overlap if their screenspace bounding boxes share a
+	// cell. Check them in the order of the list, as the checks below
+	// depend on it.
+	_candidates.resize(0);
+	for (int32 cy = cy1; cy <= cy2; cy++) {
+		for (int32 cx = cx1; cx <= cx2; cx++) {
+			const Std::vector<SortItem *> &cell = _cells[cy * _cellCols + cx];
+			for (uint i = 0; i < cell.size(); i++)
+				_candidates.push_back(cell[i]);
+		}
+	}
+	Common::sort(_candidates.begin(), _candidates.end(), ListOrderLess);
+
+	SortItem *last = nullptr;
+	for (uint i = 0; i < _candidates.size(); i++) {
+		SortItem *si2 = _candidates[i];
+
+		// Items spanning several cells are found more than once
+		if (si2 == last)
+			continue;
+		last = si2;
 
 		// Doesn't overlap
 		if (si2->_occluded || !si->overlap(*si2))
@@ -219,42 +337,38 @@ void ItemSorter::AddItem(int32 x, int32 y, int32 z, uint32 shapeNum, uint32 fram
 		}
 	}
 
-	// Add it to the list
-	_itemsUnused = _itemsUnused->_next;
+	for (int32 cy = cy1; cy <= cy2; cy++) {
+		for (int32 cx = cx1; cx <= cx2; cx++)
+			_cells[cy * _cellCols + cx].push_back(si);
+	}
+
+	// Get the insert point... which is after the last item that doesn't
+	// have higher z than us. Items tend to be added bottom up, so search
+	// from the end.
+	SortItem *addpoint = _itemsTail;
+	while (addpoint && si->ListLessThan(addpoint))
+		addpoint = addpoint->_prev;
 
-	// have a position
-	//addpoint = 0;
+	si->_prev = addpoint;
 	if (addpoint) {
-		si->_next = addpoint;
-		si->_prev = addpoint->_prev;
-		addpoint->_prev = si;
-		if (si->_prev)
-			si->_prev->_next = si;
-		else
-			_items = si;
+		si->_next = addpoint->_next;
+		addpoint->_next = si;
+	} else {
+		si->_next = _items;
+		_items = si;
 	}
-	// Add it to the end of the list
-	else {
-		if (_itemsTail)
-			_itemsTail->_next = si;
-		if (!_items)
-			_items = si;
-		si->_next = nullptr;
-		si->_prev = _itemsTail;
+	if (si->_next)
+		si->_next->_prev = si;
+	else
 		_itemsTail = si;
-	}
-}
-
-void ItemSorter::AddItem(const Item *add) {
-	int32 x, y, z;
-	add->getLerped(x, y, z);
-	AddItem(x, y, z, add->getShape(), add->getFrame(),
-			add->getFlags(), add->getExtFlags(), add->getObjId());
 }
 
 SortItem *_prev = 0;
 
 void ItemSorter::PaintDisplayList(bool item_highlight) {
+	if (_sortPending)
+		SortDisplayList();
+
 	_prev = nullptr;
 	SortItem *it = _items;
 	SortItem *end = nullptr;
@@ -400,6 +514,9 @@ uint16 ItemSorter::Trace(int32 x, int32 y, HitFace *face, bool item_highlight) {
 	SortItem *it;
 	SortItem *selected;
 
+	if (_sortPending)
+		SortDisplayList();
+
 	if (!_orderCounter) { // If no _orderCounter we need to sort the _items
 		it = _items;
 		_orderCounter = 0;  // Reset the _orderCounter
@@ -22,6 +22,9 @@
 #ifndef ULTIMA8_WORLD_ITEMSORTER_H
 #define ULTIMA8_WORLD_ITEMSORTER_H
 
+#include "ultima/shared/std/containers.h"
+#include "ultima/ultima8/misc/rect.h"
+
 namespace Ultima {
 namespace Ultima8 {
 
@@ -43,6 +46,21 @@ class ItemSorter {
 
 	int32       _camSx, _camSy;
 
+	// Items added since BeginDisplayList, in the order they were added
+	Std::vector<SortItem *> _added;
+	// Items of the last sorted display list, in the order they were added
+	Std::vector<SortItem *> _sorted;
+	bool        _sortPending;
+
+	// Screenspace cells of the sorted items, to limit the overlap checks
+	enum {
+		CELL_SHIFT = 6
+	};
+	Rect        _cellArea;
+	int32       _cellCols, _cellRows;
+	Std::vector<Std::vector<SortItem *> > _cells;
+	Std::vector<SortItem *> _candidates;
+
 public:
 	ItemSorter();
 	~ItemSorter();
@@ -67,6 +85,11 @@ public:
 	void IncSortLimit(int count);
 
 private:
+	void SortDisplayList();
+	bool ReuseSortedList();
+	void InsertSortItem(SortItem *);
+	void RecycleItems(Std::vector<SortItem *> &);
+
 	bool PaintSortItem(SortItem *);
 	bool NullPaintSortItem(SortItem *);
 };
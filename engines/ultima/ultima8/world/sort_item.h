@@ -46,7 +46,7 @@ struct SortItem {
 			_occl(false), _solid(false), _draw(false), _roof(false),
 			_noisy(false), _anim(false), _trans(false), _fixed(false),
 			_land(false), _occluded(false), _clipped(false), _sprite(false),
-			_invitem(false) { }
+			_invitem(false), _addIndex(0) { }
 
 	SortItem                *_next;
 	SortItem                *_prev;
@@ -112,6 +112,8 @@ struct SortItem {
 
 	int32   _order;      // Rendering _order. -1 is not yet drawn
 
+	int32   _addIndex;   // Position of this in the order items were added to the display list
+
 	// Note that Std::priority_queue could be used here, BUT there is no guarentee that it's implementation
 	// will be friendly to insertions
 	// Alternatively i could use Std::list, BUT there is no guarentee that it will keep wont delete
@@ -227,6 +229,9 @@ struct SortItem {
 	// Screenspace check to see if this is below si2. Assumes this overlaps si2
 	inline bool below(const SortItem &si2) const;
 
+	// Check if this sorts against any other item exactly like si2 does
+	inline bool sortsLike(const SortItem &si2) const;
+
 	// Comparison for the sorted lists
 	inline bool ListLessThan(const SortItem *other) const {
 		return _z < other->_z || (_z == other->_z && _flat && !other->_flat);
@@ -401,6 +406,17 @@ inline bool SortItem::below(const SortItem &si2) const {
 	return si1._frame < si2._frame;
 }
 
+inline bool SortItem::sortsLike(const SortItem &si2) const {
+	// Screenspace coords only differ by the camera position when the
+	// worldspace bounding boxes match, so they are not compared here
+	return _x == si2._x && _y == si2._y && _z == si2._z &&
+		_xLeft == si2._xLeft && _yFar == si2._yFar && _zTop == si2._zTop &&
+		_shapeNum == si2._shapeNum && _frame == si2._frame &&
+		_fbigsq == si2._fbigsq && _flat == si2._flat && _occl == si2._occl &&
+		_solid == si2._solid && _draw == si2._draw && _anim == si2._anim &&
+		_trans == si2._trans && _sprite == si2._sprite && _invitem == si2._invitem;
+}
+
 ConsoleStream &operator<<(ConsoleStream &cs, const SortItem &si) {
 	cs << si._shapeNum << ":" << si._frame <<
 		" (" << si._xLeft << "," << si._yFar << "," << si._z << ")" <<
@@ -166,6 +166,9 @@ void AdScene::cleanup() {
 
 	_mainLayer = nullptr; // reference only
 
+	_sortedObjects.clear();
+	_sortedObjectsSource.clear();
+
 	delete _shieldWindow;
 	_shieldWindow = nullptr;
 
@@ -1123,6 +1126,10 @@ bool AdScene::traverseNodes(bool doUpdate) {
 	// *** display/update everything
 	_gameRef->_renderer->setup2D();
 
+	if (!doUpdate) {
+		sortObjects();
+	}
+
 	// for each layer
 	/* int mainOffsetX = 0; */
 	/* int mainOffsetY = 0; */
@@ -1323,33 +1330,67 @@ bool AdScene::updateFreeObjects() {
 
 
 //////////////////////////////////////////////////////////////////////////
-bool AdScene::displayRegionContent(AdRegion *region, bool display3DOnly) {
+void AdScene::sortObjects() {
 	AdGame *adGame = (AdGame *)_gameRef;
-	Common::Array<AdObject *> objects;
-	AdObject *obj;
 
-	// global objects
-	for (uint32 i = 0; i < adGame->_objects.size(); i++) {
-		obj = adGame->_objects[i];
-		if (obj->_active && !obj->_drawn && (obj->_stickRegion == region || region == nullptr || (obj->_stickRegion == nullptr && region->pointInRegion(obj->_posX, obj->_posY)))) {
-			objects.push_back(obj);
+	// Keep the order of the previous frame as long as the same objects
+	// exist, so that only the objects which moved need to be sorted again
+	bool sameObjects = _sortedObjectsSource.size() == adGame->_objects.size() + _objects.size();
+	for (uint32 i = 0; sameObjects && i < adGame->_objects.size(); i++) {
+		sameObjects = _sortedObjectsSource[i] == adGame->_objects[i];
+	}
+	for (uint32 i = 0; sameObjects && i < _objects.size(); i++) {
+		sameObjects = _sortedObjectsSource[adGame->_objects.size() + i] == _objects[i];
+	}
+
+	if (!sameObjects) {
+		_sortedObjectsSource.clear();
+		_sortedObjects.clear();
+
+		SortedObject sorted;
+		sorted._sceneObject = false;
+		for (uint32 i = 0; i < adGame->_objects.size(); i++) {
+			sorted._object = adGame->_objects[i];
+			_sortedObjectsSource.push_back(sorted._object);
+			_sortedObjects.push_back(sorted);
+		}
+
+		sorted._sceneObject = true;
+		for (uint32 i = 0; i < _objects.size(); i++) {
+			sorted._object = _objects[i];
+			_sortedObjectsSource.push_back(sorted._object);
+			_sortedObjects.push_back(sorted);
 		}
 	}
 
-	// scene objects
-	for (uint32 i = 0; i < _objects.size(); i++) {
-		obj = _objects[i];
-		if (obj->_active && !obj->_editorOnly && !obj->_drawn && (obj->_stickRegion == region || region == nullptr || (obj->_stickRegion == nullptr && region->pointInRegion(obj->_posX, obj->_posY)))) {
-			objects.push_back(obj);
+	// sort by _posY, with an insertion sort, which is fast for the mostly
+	// sorted order of the previous frame
+	for (uint32 i = 1; i < _sortedObjects.size(); i++) {
+		SortedObject sorted = _sortedObjects[i];
+		uint32 j = i;
+		while (j > 0 && compareObjs(sorted._object, _sortedObjects[j - 1]._object)) {
+			_sortedObjects[j] = _sortedObjects[j - 1];
+			j--;
 		}
+		_sortedObjects[j] = sorted;
 	}
+}
 
-	// sort by _posY
-	Common::sort(objects.begin(), objects.end(), AdScene::compareObjs);
+//////////////////////////////////////////////////////////////////////////
+bool AdScene::displayRegionContent(AdRegion *region, bool display3DOnly) {
+	AdObject *obj;
 
-	// display them
-	for (uint32 i = 0; i < objects.size(); i++) {
-		obj = objects[i];
+	// display the objects in the region, in the order set up by sortObjects()
+	for (uint32 i = 0; i < _sortedObjects.size(); i++) {
+		obj = _sortedObjects[i]._object;
+
+		if (!obj->_active || obj->_drawn || (_sortedObjects[i]._sceneObject && obj->_editorOnly)) {
+			continue;
+		}
+
+		if (!(obj->_stickRegion == region || region == nullptr || (obj->_stickRegion == nullptr && region->pointInRegion(obj->_posX, obj->_posY)))) {
+			continue;
+		}
 
 		if (display3DOnly && !obj->_is3D) {
 			continue;
@@ -1358,7 +1399,7 @@ bool AdScene::displayRegionContent(AdRegion *region, bool display3DOnly) {
 #ifndef ENABLE_WME3D
 		_gameRef->_renderer->setup2D();
 #else
-		if (objects[i]->_is3D && _sceneGeometry) {
+		if (obj->_is3D && _sceneGeometry) {
 			Camera3D* activeCamera = _sceneGeometry->getActiveCamera();
 
 			if (activeCamera != nullptr) {
@@ -1374,7 +1415,7 @@ bool AdScene::displayRegionContent(AdRegion *region, bool display3DOnly) {
 			obj->display();
 		}
 #else
-		if ((_gameRef->_editorMode || !obj->_editorOnly) && (!objects[i]->_is3D || _sceneGeometry)) {
+		if ((_gameRef->_editorMode || !obj->_editorOnly) && (!obj->_is3D || _sceneGeometry)) {
 			obj->display();
 		}
 #endif
@@ -2872,24 +2913,25 @@ bool AdScene::sortRotLevels() {
 
 //////////////////////////////////////////////////////////////////////////
 float AdScene::getScaleAt(int Y) {
-	AdScaleLevel *prev = nullptr;
-	AdScaleLevel *next = nullptr;
-
-	for (uint32 i = 0; i < _scaleLevels.size(); i++) {
-		/* AdScaleLevel *xxx = _scaleLevels[i];*/
-		/* int j = _scaleLevels.size(); */
-		if (_scaleLevels[i]->_posY < Y) {
-			prev = _scaleLevels[i];
+	// The levels are sorted by sortScaleLevels(), find the first one at
+	// or below Y
+	uint32 first = 0, last = _scaleLevels.size();
+	while (first < last) {
+		uint32 mid = (first + last) / 2;
+		if (_scaleLevels[mid]->_posY < Y) {
+			first = mid + 1;
 		} else {
-			next = _scaleLevels[i];
-			break;
+			last = mid;
 		}
 	}
 
-	if (prev == nullptr || next == nullptr) {
+	if (first == 0 || first == _scaleLevels.size()) {
 		return 100;
 	}
 
+	AdScaleLevel *prev = _scaleLevels[first - 1];
+	AdScaleLevel *next = _scaleLevels[first];
+
 	int delta_y = next->_posY - prev->_posY;
 	float delta_scale = next->getScale() - prev->getScale();
 	Y -= prev->_posY;
@@ -3394,24 +3436,25 @@ bool AdScene::persistState(bool saving) {
 
 //////////////////////////////////////////////////////////////////////////
 float AdScene::getRotationAt(int x, int y) {
-	AdRotLevel *prev = nullptr;
-	AdRotLevel *next = nullptr;
-
-	for (uint32 i = 0; i < _rotLevels.size(); i++) {
-		/*  AdRotLevel *xxx = _rotLevels[i];
-		    int j = _rotLevels.size();*/
-		if (_rotLevels[i]->_posX < x) {
-			prev = _rotLevels[i];
+	// The levels are sorted by sortRotLevels(), find the first one at or
+	// right of x
+	uint32 first = 0, last = _rotLevels.size();
+	while (first < last) {
+		uint32 mid = (first + last) / 2;
+		if (_rotLevels[mid]->_posX < x) {
+			first = mid + 1;
 		} else {
-			next = _rotLevels[i];
-			break;
+			last = mid;
 		}
 	}
 
-	if (prev == nullptr || next == nullptr) {
+	if (first == 0 || first == _rotLevels.size()) {
 		return 0;
 	}
 
+	AdRotLevel *prev = _rotLevels[first - 1];
+	AdRotLevel *next = _rotLevels[first];
+
 	int delta_x = next->_posX - prev->_posX;
 	float delta_rot = next->getRotation() - prev->getRotation();
 	x -= prev->_posX;
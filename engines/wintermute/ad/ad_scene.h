@@ -195,6 +195,15 @@ private:
 	int32 _offsetTop;
 	int32 _offsetLeft;
 
+	// The objects of the game and the scene, sorted by _posY for display
+	struct SortedObject {
+		AdObject *_object;
+		bool _sceneObject;
+	};
+	Common::Array<SortedObject> _sortedObjects;
+	Common::Array<AdObject *> _sortedObjectsSource;
+	void sortObjects();
+
 };
 
 } // End of namespace Wintermute
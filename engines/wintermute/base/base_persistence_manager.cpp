@@ -42,6 +42,7 @@
 #include "common/str.h"
 #include "common/system.h"
 #include "common/savefile.h"
+#include "common/translation.h"
 
 #ifdef ENABLE_WME3D
 #include "math/angle.h"
@@ -417,6 +418,16 @@ bool BasePersistenceManager::initLoad(const Common::String &filename) {
 }
 
 
+//////////////////////////////////////////////////////////////////////////
+static void savegameWritten(Common::Error result) {
+	// The game already went on believing the save worked, so at least tell
+	// the player that it did not
+	if (result.getCode() != Common::kNoError) {
+		warning("Failed to write savegame: %s", result.getDesc().c_str());
+		g_system->displayMessageOnOSD(_("Failed to save game"));
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool BasePersistenceManager::saveFile(const Common::String &filename) {
 	byte *prefixBuffer = _richBuffer;
@@ -424,8 +435,13 @@ bool BasePersistenceManager::saveFile(const Common::String &filename) {
 	byte *buffer = ((Common::MemoryWriteStreamDynamic *)_saveStream)->getData();
 	uint32 bufferSize = ((Common::MemoryWriteStreamDynamic *)_saveStream)->size();
 
+	// Savegames can take megabytes, so they are compressed and written in
+	// the background, not to freeze the game
 	Common::SaveFileManager *saveMan = ((WintermuteEngine *)g_engine)->getSaveFileMan();
-	Common::OutSaveFile *file = saveMan->openForSaving(filename);
+	Common::OutSaveFile *file = saveMan->openForSavingAsync(filename, new Common::GlobalFunctionCallback<Common::Error>(savegameWritten));
+	if (!file) {
+		return false;
+	}
 	file->write(prefixBuffer, prefixSize);
 	file->write(buffer, bufferSize);
 	bool retVal = !file->err();
@@ -58,6 +58,11 @@ public:
 	int _drawOffsetY;
 
 	virtual void dumpData(const char *filename) {}
+	/**
+	 * Outline the regions of the screen which are redrawn, for renderers
+	 * which only redraw what changed.
+	 */
+	virtual void showDirtyRects(bool show) {}
 	/**
 	 * Take a screenshot of the current screenstate
 	 *
@@ -127,7 +127,14 @@ bool MeshXOpenGLShader::renderFlatShadowModel() {
 bool MeshXOpenGLShader::update(FrameNode *parentFrame) {
 	MeshX::update(parentFrame);
 
+	if (!_vertexDataChanged) {
+		return true;
+	}
+
+	// orphan the old storage first, so that the driver does not have to
+	// wait for draw calls of the previous frame still using it
 	glBindBuffer(GL_ARRAY_BUFFER, _vertexBuffer);
+	glBufferData(GL_ARRAY_BUFFER, 4 * kVertexComponentCount * _vertexCount, nullptr, GL_DYNAMIC_DRAW);
 	glBufferSubData(GL_ARRAY_BUFFER, 0, 4 * kVertexComponentCount * _vertexCount, _vertexData);
 
 	return true;
@@ -39,7 +39,9 @@
 #include "common/queue.h"
 #include "common/config-manager.h"
 
-#define DIRTY_RECT_LIMIT 800
+// Beyond this many separate regions, redrawing their bounding box is cheaper
+// than walking the render queue once per region.
+#define DIRTY_RECT_LIMIT 32
 
 namespace Wintermute {
 
@@ -57,11 +59,11 @@ BaseRenderOSystem::BaseRenderOSystem(BaseGame *inGame) : BaseRenderer(inGame) {
 
 	_borderLeft = _borderRight = _borderTop = _borderBottom = 0;
 	_ratioX = _ratioY = 1.0f;
-	_dirtyRect = nullptr;
 	_disableDirtyRects = false;
 	if (ConfMan.hasKey("dirty_rects")) {
 		_disableDirtyRects = !ConfMan.getBool("dirty_rects");
 	}
+	_showDirtyRects = false;
 
 	_lastScreenChangeID = g_system->getScreenChangeID();
 }
@@ -75,8 +77,6 @@ BaseRenderOSystem::~BaseRenderOSystem() {
 		delete ticket;
 	}
 
-	delete _dirtyRect;
-
 	_renderSurface->free();
 	delete _renderSurface;
 	_blankSurface->free();
@@ -158,8 +158,7 @@ bool BaseRenderOSystem::forcedFlip() {
 bool BaseRenderOSystem::flip() {
 	if (_skipThisFrame) {
 		_skipThisFrame = false;
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		g_system->updateScreen();
 		_needsFlip = false;
 
@@ -174,6 +173,7 @@ bool BaseRenderOSystem::flip() {
 		return true;
 	}
 	if (!_disableDirtyRects) {
+		eraseDirtyRectOutlines();
 		drawTickets();
 	} else {
 		// Clear the scale-buffered tickets that wasn't reused.
@@ -198,9 +198,7 @@ bool BaseRenderOSystem::flip() {
 		if (_disableDirtyRects || screenChanged) {
 			g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, 0, 0, _renderSurface->w, _renderSurface->h);
 		}
-		//  g_system->copyRectToScreen((byte *)_renderSurface->getPixels(), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
-		delete _dirtyRect;
-		_dirtyRect = nullptr;
+		_dirtyRects.clear();
 		_needsFlip = false;
 	}
 	_lastFrameIter = _renderQueue.end();
@@ -382,12 +380,34 @@ void BaseRenderOSystem::drawFromQueuedTicket(const RenderQueueIterator &ticket)
 }
 
 void BaseRenderOSystem::addDirtyRect(const Common::Rect &rect) {
-	if (!_dirtyRect) {
-		_dirtyRect = new Common::Rect(rect);
-	} else {
-		_dirtyRect->extend(rect);
+	Common::Rect dirty(rect);
+	dirty.clip(_renderRect);
+	if (dirty.isEmpty()) {
+		return;
+	}
+
+	// Absorb every rect the new one overlaps; growing it may make it
+	// overlap rects which were checked already, so start over each time.
+	Common::List<Common::Rect>::iterator it = _dirtyRects.begin();
+	while (it != _dirtyRects.end()) {
+		if (it->intersects(dirty)) {
+			dirty.extend(*it);
+			_dirtyRects.erase(it);
+			it = _dirtyRects.begin();
+		} else {
+			++it;
+		}
+	}
+	_dirtyRects.push_back(dirty);
+
+	if (_dirtyRects.size() > DIRTY_RECT_LIMIT) {
+		Common::Rect bounds = _dirtyRects.front();
+		for (it = _dirtyRects.begin(); it != _dirtyRects.end(); ++it) {
+			bounds.extend(*it);
+		}
+		_dirtyRects.clear();
+		_dirtyRects.push_back(bounds);
 	}
-	_dirtyRect->clip(_renderRect);
 }
 
 void BaseRenderOSystem::drawTickets() {
@@ -406,7 +426,7 @@ void BaseRenderOSystem::drawTickets() {
 			++it;
 		}
 	}
-	if (!_dirtyRect || _dirtyRect->width() == 0 || _dirtyRect->height() == 0) {
+	if (_dirtyRects.empty()) {
 		it = _renderQueue.begin();
 		while (it != _renderQueue.end()) {
 			RenderTicket *ticket = *it;
@@ -416,43 +436,65 @@ void BaseRenderOSystem::drawTickets() {
 		return;
 	}
 
-	it = _renderQueue.begin();
 	_lastFrameIter = _renderQueue.end();
 	// A special case: If the screen has one giant OPAQUE rect to be drawn, then we skip filling
 	// the background color. Typical use-case: Fullscreen FMVs.
 	// Caveat: The FPS-counter will invalidate this.
-	if (it != _lastFrameIter && _renderQueue.front() == _renderQueue.back() && (*it)->_transform._alphaDisable == true) {
+	RenderTicket *opaqueTicket = nullptr;
+	if (!_renderQueue.empty() && _renderQueue.front() == _renderQueue.back() && _renderQueue.front()->_transform._alphaDisable == true) {
+		opaqueTicket = _renderQueue.front();
+	}
+
+	Common::List<Common::Rect>::const_iterator rectIt;
+	for (rectIt = _dirtyRects.begin(); rectIt != _dirtyRects.end(); ++rectIt) {
+		const Common::Rect &dirty = *rectIt;
+
 		// If our single opaque rect fills the dirty rect, we can skip filling.
-		if (*_dirtyRect != (*it)->_dstRect) {
+		if (!opaqueTicket || !opaqueTicket->_dstRect.contains(dirty)) {
 			// Apply the clear-color to the dirty rect.
-			_renderSurface->fillRect(*_dirtyRect, _clearColor);
+			_renderSurface->fillRect(dirty, _clearColor);
+		}
+
+		for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+			RenderTicket *ticket = *it;
+			if (ticket->_dstRect.intersects(dirty)) {
+				// dstClip is the area we want redrawn.
+				Common::Rect dstClip(ticket->_dstRect);
+				// reduce it to the dirty rect
+				dstClip.clip(dirty);
+				// we need to keep track of the position to redraw the dirty rect
+				Common::Rect pos(dstClip);
+				int16 offsetX = ticket->_dstRect.left;
+				int16 offsetY = ticket->_dstRect.top;
+				// convert from screen-coords to surface-coords.
+				dstClip.translate(-offsetX, -offsetY);
+
+				drawFromSurface(ticket, &pos, &dstClip);
+				_needsFlip = true;
+			}
 		}
-		// Otherwise Do NOT fill.
-	} else {
-		// Apply the clear-color to the dirty rect.
-		_renderSurface->fillRect(*_dirtyRect, _clearColor);
 	}
-	for (; it != _renderQueue.end(); ++it) {
-		RenderTicket *ticket = *it;
-		if (ticket->_dstRect.intersects(*_dirtyRect)) {
-			// dstClip is the area we want redrawn.
-			Common::Rect dstClip(ticket->_dstRect);
-			// reduce it to the dirty rect
-			dstClip.clip(*_dirtyRect);
-			// we need to keep track of the position to redraw the dirty rect
-			Common::Rect pos(dstClip);
-			int16 offsetX = ticket->_dstRect.left;
-			int16 offsetY = ticket->_dstRect.top;
-			// convert from screen-coords to surface-coords.
-			dstClip.translate(-offsetX, -offsetY);
-
-			drawFromSurface(ticket, &pos, &dstClip);
-			_needsFlip = true;
+
+	// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
+	for (it = _renderQueue.begin(); it != _renderQueue.end(); ++it) {
+		(*it)->_wantsDraw = false;
+	}
+
+	for (rectIt = _dirtyRects.begin(); rectIt != _dirtyRects.end(); ++rectIt) {
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(rectIt->left, rectIt->top), _renderSurface->pitch, rectIt->left, rectIt->top, rectIt->width(), rectIt->height());
+	}
+
+	if (_showDirtyRects) {
+		Graphics::Surface *screen = g_system->lockScreen();
+		if (screen) {
+			const uint32 color = screen->format.ARGBToColor(255, 255, 0, 255);
+			for (rectIt = _dirtyRects.begin(); rectIt != _dirtyRects.end(); ++rectIt) {
+				screen->frameRect(*rectIt, color);
+				_dirtyRectOutlines.push_back(*rectIt);
+			}
+			g_system->unlockScreen();
 		}
-		// Some tickets want redraw but don't actually clip the dirty area (typically the ones that shouldnt become clear-color)
-		ticket->_wantsDraw = false;
 	}
-	g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(_dirtyRect->left, _dirtyRect->top), _renderSurface->pitch, _dirtyRect->left, _dirtyRect->top, _dirtyRect->width(), _dirtyRect->height());
 
 	it = _renderQueue.begin();
 	// Clean out the old tickets
@@ -469,6 +511,19 @@ void BaseRenderOSystem::drawTickets() {
 
 }
 
+void BaseRenderOSystem::eraseDirtyRectOutlines() {
+	// The render surface still holds what is under the outlines
+	Common::List<Common::Rect>::const_iterator it;
+	for (it = _dirtyRectOutlines.begin(); it != _dirtyRectOutlines.end(); ++it) {
+		g_system->copyRectToScreen((byte *)_renderSurface->getBasePtr(it->left, it->top), _renderSurface->pitch, it->left, it->top, it->width(), it->height());
+	}
+	_dirtyRectOutlines.clear();
+}
+
+void BaseRenderOSystem::showDirtyRects(bool show) {
+	_showDirtyRects = show;
+}
+
 // Replacement for SDL2's SDL_RenderCopy
 void BaseRenderOSystem::drawFromSurface(RenderTicket *ticket) {
 	ticket->drawToSurface(_renderSurface);
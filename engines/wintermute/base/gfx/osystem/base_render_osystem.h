@@ -104,6 +104,7 @@ public:
 	void pointToScreen(Point32 *point);
 
 	void dumpData(const char *filename) override;
+	void showDirtyRects(bool show) override;
 
 	float getScaleRatioX() const override {
 		return _ratioX;
@@ -118,10 +119,16 @@ public:
 	BaseSurface *createSurface() override;
 private:
 	/**
-	 * Mark a specified rect of the screen as dirty.
+	 * Mark a specified rect of the screen as dirty. Rects overlapping it are
+	 * merged with it, so that no pixel is drawn twice.
 	 * @param rect the region to be marked as dirty
 	 */
 	void addDirtyRect(const Common::Rect &rect);
+	/**
+	 * Restore the parts of the screen covered by the dirty rect outlines of
+	 * the previous frame.
+	 */
+	void eraseDirtyRectOutlines();
 	/**
 	 * Traverse the tickets that are dirty, and draw them
 	 */
@@ -130,7 +137,7 @@ private:
 	void drawFromSurface(RenderTicket *ticket);
 	// Dirty-rects:
 	void drawFromSurface(RenderTicket *ticket, Common::Rect *dstRect, Common::Rect *clipRect);
-	Common::Rect *_dirtyRect;
+	Common::List<Common::Rect> _dirtyRects;
 	Common::List<RenderTicket *> _renderQueue;
 
 	bool _needsFlip;
@@ -145,6 +152,8 @@ private:
 	int _borderBottom;
 
 	bool _disableDirtyRects;
+	bool _showDirtyRects;
+	Common::List<Common::Rect> _dirtyRectOutlines;
 	float _ratioX;
 	float _ratioY;
 	uint32 _clearColor;
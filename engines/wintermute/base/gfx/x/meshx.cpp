@@ -41,7 +41,8 @@ const uint32 MeshX::kNullIndex;
 MeshX::MeshX(Wintermute::BaseGame *inGame) : BaseNamedObject(inGame),
 	_BBoxStart(0.0f, 0.0f, 0.0f), _BBoxEnd(0.0f, 0.0f, 0.0f),
 	_vertexData(nullptr), _vertexPositionData(nullptr), _vertexNormalData(nullptr),
-	_vertexCount(0), _numAttrs(0), _skinnedMesh(false) {
+	_vertexCount(0), _numAttrs(0), _skinnedMesh(false),
+	_poseValid(false), _vertexDataChanged(false) {
 }
 
 MeshX::~MeshX() {
@@ -139,10 +140,84 @@ bool MeshX::loadFromX(const Common::String &filename, XFileLexer &lexer, Common:
 	}
 
 	generateAdjacency();
+	buildInfluences();
 
 	return true;
 }
 
+//////////////////////////////////////////////////////////////////////////
+void MeshX::buildInfluences() {
+	_influenceStart.clear();
+	_influenceBones.clear();
+	_influenceWeights.clear();
+
+	if (!_skinnedMesh) {
+		return;
+	}
+
+	// count the influences of every vertex, then turn the counts into start offsets
+	_influenceStart.resize(_vertexCount + 1);
+	for (uint32 i = 0; i <= _vertexCount; ++i) {
+		_influenceStart[i] = 0;
+	}
+
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		const BaseArray<uint32> &vertexIndices = skinWeightsList[boneIndex]._vertexIndices;
+		for (uint i = 0; i < vertexIndices.size(); ++i) {
+			if (vertexIndices[i] < _vertexCount) {
+				_influenceStart[vertexIndices[i] + 1]++;
+			}
+		}
+	}
+
+	for (uint32 i = 0; i < _vertexCount; ++i) {
+		_influenceStart[i + 1] += _influenceStart[i];
+	}
+
+	_influenceBones.resize(_influenceStart[_vertexCount]);
+	_influenceWeights.resize(_influenceStart[_vertexCount]);
+
+	// the bones are stored in ascending order for each vertex, so the
+	// weighted sums are formed in the same order as bone by bone
+	Common::Array<uint32> fill(_influenceStart.begin(), _vertexCount);
+	for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
+		const SkinWeights &skinWeights = skinWeightsList[boneIndex];
+		for (uint i = 0; i < skinWeights._vertexIndices.size(); ++i) {
+			uint32 vertexIndex = skinWeights._vertexIndices[i];
+			if (vertexIndex < _vertexCount) {
+				_influenceBones[fill[vertexIndex]] = boneIndex;
+				_influenceWeights[fill[vertexIndex]] = skinWeights._vertexWeights[i];
+				fill[vertexIndex]++;
+			}
+		}
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////
+void MeshX::skinVertices(const float *src, int dstOffset, const float *matrices) {
+	for (uint32 vertexIndex = 0; vertexIndex < _vertexCount; ++vertexIndex) {
+		const float x = src[0];
+		const float y = src[1];
+		const float z = src[2];
+		float sumX = 0.0f, sumY = 0.0f, sumZ = 0.0f;
+
+		for (uint32 i = _influenceStart[vertexIndex]; i < _influenceStart[vertexIndex + 1]; ++i) {
+			const float *m = matrices + 12 * _influenceBones[i];
+			const float weight = _influenceWeights[i];
+
+			sumX += (m[0] * x + m[1] * y + m[2] * z + m[3]) * weight;
+			sumY += (m[4] * x + m[5] * y + m[6] * z + m[7]) * weight;
+			sumZ += (m[8] * x + m[9] * y + m[10] * z + m[11]) * weight;
+		}
+
+		float *dst = _vertexData + vertexIndex * kVertexComponentCount + dstOffset;
+		dst[0] = sumX;
+		dst[1] = sumY;
+		dst[2] = sumZ;
+		src += 3;
+	}
+}
+
 //////////////////////////////////////////////////////////////////////////
 bool MeshX::generateAdjacency() {
 	_adjacency = Common::Array<uint32>(_indexData.size(), kNullIndex);
@@ -218,72 +293,59 @@ bool MeshX::update(FrameNode *parentFrame) {
 
 	// update skinned mesh
 	if (_skinnedMesh) {
-		BaseArray<Math::Matrix4> finalBoneMatrices;
-		finalBoneMatrices.resize(_boneMatrices.size());
+		// most bones of a model stand still in most frames, so only skin
+		// again if any of the bone transformations did change
+		bool poseChanged = !_poseValid || _lastPose.size() != _boneMatrices.size();
+		_lastPose.resize(_boneMatrices.size());
+
+		for (uint i = 0; i < _boneMatrices.size(); ++i) {
+			if (poseChanged || _lastPose[i] != *_boneMatrices[i]) {
+				_lastPose[i] = *_boneMatrices[i];
+				poseChanged = true;
+			}
+		}
 
-		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i] = *_boneMatrices[i] * skinWeightsList[i]._offsetMatrix;
+		if (!poseChanged) {
+			_vertexDataChanged = false;
+			return true;
 		}
 
 		// the new vertex coordinates are the weighted sum of the product
 		// of the combined bone transformation matrices and the static pose coordinates
-		// to be able too add the weighted summands together, we reset everything to zero first
-		for (uint32 i = 0; i < _vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				_vertexData[i * kVertexComponentCount + kPositionOffset + j] = 0.0f;
-			}
-		}
-
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			// to every vertex which is affected by the bone, we add the product
-			// of the bone transformation with the coordinates of the static pose,
-			// weighted by the weight for the particular vertex
-			// repeating this procedure for all bones gives the new pose
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(_vertexPositionData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					_vertexData[vertexIndex * kVertexComponentCount + kPositionOffset + j] += pos.getData()[j];
-				}
-			}
-		}
+		// the upper three rows of each matrix are kept, which is all the
+		// transformation of a point needs
+		BaseArray<float> positionMatrices, normalMatrices;
+		positionMatrices.resize(12 * skinWeightsList.size());
+		normalMatrices.resize(12 * skinWeightsList.size());
 
-		// now we have to update the vertex normals as well, so prepare the bone transformations
 		for (uint i = 0; i < skinWeightsList.size(); ++i) {
-			finalBoneMatrices[i].transpose();
-			finalBoneMatrices[i].inverse();
-		}
+			Math::Matrix4 finalBoneMatrix = _lastPose[i] * skinWeightsList[i]._offsetMatrix;
+			memcpy(&positionMatrices[12 * i], finalBoneMatrix.getData(), 12 * sizeof(float));
 
-		// reset so we can form the weighted sums
-		for (uint32 i = 0; i < _vertexCount; ++i) {
-			for (int j = 0; j < 3; ++j) {
-				_vertexData[i * kVertexComponentCount + kNormalOffset + j] = 0.0f;
-			}
+			// the vertex normals need the inverse transpose of the bone transformation
+			finalBoneMatrix.transpose();
+			finalBoneMatrix.inverse();
+			memcpy(&normalMatrices[12 * i], finalBoneMatrix.getData(), 12 * sizeof(float));
 		}
 
-		for (uint boneIndex = 0; boneIndex < skinWeightsList.size(); ++boneIndex) {
-			for (uint i = 0; i < skinWeightsList[boneIndex]._vertexIndices.size(); ++i) {
-				uint32 vertexIndex = skinWeightsList[boneIndex]._vertexIndices[i];
-				Math::Vector3d pos;
-				pos.setData(_vertexNormalData + vertexIndex * 3);
-				finalBoneMatrices[boneIndex].transform(&pos, true);
-				pos *= skinWeightsList[boneIndex]._vertexWeights[i];
-
-				for (uint j = 0; j < 3; ++j) {
-					_vertexData[vertexIndex * kVertexComponentCount + kNormalOffset + j] += pos.getData()[j];
-				}
-			}
-		}
+		skinVertices(_vertexPositionData, kPositionOffset, positionMatrices.data());
+		skinVertices(_vertexNormalData, kNormalOffset, normalMatrices.data());
 
 	//updateNormals();
 	} else { // update static
+		const Math::Matrix4 &combinedMatrix = *parentFrame->getCombinedMatrix();
+
+		if (_poseValid && _lastPose.size() == 1 && _lastPose[0] == combinedMatrix) {
+			_vertexDataChanged = false;
+			return true;
+		}
+
+		_lastPose.resize(1);
+		_lastPose[0] = combinedMatrix;
+
 		for (uint32 i = 0; i < _vertexCount; ++i) {
 			Math::Vector3d pos(_vertexPositionData + 3 * i);
-			parentFrame->getCombinedMatrix()->transform(&pos, true);
+			combinedMatrix.transform(&pos, true);
 
 			for (uint j = 0; j < 3; ++j) {
 				_vertexData[i * kVertexComponentCount + kPositionOffset + j] = pos.getData()[j];
@@ -291,6 +353,9 @@ bool MeshX::update(FrameNode *parentFrame) {
 		}
 	}
 
+	_poseValid = true;
+	_vertexDataChanged = true;
+
 	updateBoundingBox();
 
 	return true;
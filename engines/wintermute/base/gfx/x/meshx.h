@@ -93,6 +93,8 @@ protected:
 	bool parseVertexDeclaration(XFileLexer &lexer);
 
 	void updateBoundingBox();
+	void buildInfluences();
+	void skinVertices(const float *src, int dstOffset, const float *matrices);
 
 	bool generateAdjacency();
 	bool adjacentEdge(uint16 index1, uint16 index2, uint16 index3, uint16 index4);
@@ -117,6 +119,19 @@ protected:
 	// we will only store, whether this mesh is skinned at all
 	// and factor out the necessary computations into some functions
 	bool _skinnedMesh;
+
+	// the bone influences of all vertices, stored vertex by vertex so that
+	// skinning writes every vertex once; the influences of vertex i start
+	// at _influenceStart[i] and end at _influenceStart[i + 1]
+	BaseArray<uint32> _influenceStart;
+	BaseArray<uint32> _influenceBones;
+	BaseArray<float> _influenceWeights;
+
+	// the bone matrices (or the frame matrix of static meshes) the vertex data
+	// was last computed from, and whether the last update changed the vertex data
+	BaseArray<Math::Matrix4> _lastPose;
+	bool _poseValid;
+	bool _vertexDataChanged;
 };
 
 } // namespace Wintermute
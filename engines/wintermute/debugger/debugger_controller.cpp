@@ -26,6 +26,7 @@
 #include "engines/wintermute/base/base_file_manager.h"
 #include "engines/wintermute/base/base_engine.h"
 #include "engines/wintermute/base/base_game.h"
+#include "engines/wintermute/base/gfx/base_renderer.h"
 #include "engines/wintermute/base/scriptables/script.h"
 #include "engines/wintermute/base/scriptables/script_value.h"
 #include "engines/wintermute/base/scriptables/script_stack.h"
@@ -259,6 +260,10 @@ void DebuggerController::showFps(bool show) {
 	_engine->_game->setShowFPS(show);
 }
 
+void DebuggerController::showDirtyRects(bool show) {
+	_engine->_game->_renderer->showDirtyRects(show);
+}
+
 Common::Array<BreakpointInfo> DebuggerController::getBreakpoints() const {
 	assert(SCENGINE);
 	Common::Array<BreakpointInfo> breakpoints;
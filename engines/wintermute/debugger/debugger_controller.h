@@ -105,6 +105,7 @@ public:
 	Common::String getSourcePath() const;
 	Listing *getListing(Error* &err);
 	void showFps(bool show);
+	void showDirtyRects(bool show);
 	/**
 	 * Inherited from ScriptMonitor
 	 */
@@ -138,6 +138,9 @@ bool VideoTheoraPlayer::initialize(const Common::String &filename, const Common:
 		return STATUS_FAILED;
 	}
 
+	// Decode on a worker thread, so that expensive frames don't stall the game
+	_theoraDecoder->setDecodeAhead(3);
+
 	_state = THEORA_STATE_PAUSED;
 
 	// Additional setup.
@@ -177,6 +180,9 @@ bool VideoTheoraPlayer::resetStream() {
 		return STATUS_FAILED;
 	}
 
+	// Decode on a worker thread, so that expensive frames don't stall the game
+	_theoraDecoder->setDecodeAhead(3);
+
 	return play(_playbackType, _posX, _posY, false, false, _looping, 0, _playZoom);
 	// End of hack.
 #if 0 // Stubbed for now, as theora isn't seekable
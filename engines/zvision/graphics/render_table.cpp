@@ -24,19 +24,48 @@
 #include "common/math.h"
 #include "common/rect.h"
 #include "common/scummsys.h"
+#include "common/threadpool.h"
 
 namespace ZVision {
 
+/** The rows of a warped image, as warped by Common::ThreadPool::parallelFor(). */
+struct RenderTable::WarpJob {
+	const uint32 *table;
+	uint32 tablePitch;
+	const uint16 *source;
+	uint16 *dest;
+	uint32 destPitch;
+	int16 width;
+
+	static void warp(void *data, uint begin, uint end) {
+		const WarpJob *job = (const WarpJob *)data;
+
+		for (uint row = begin; row < end; ++row) {
+			const uint32 *sourceIndex = job->table + row * job->tablePitch;
+			uint16 *dest = job->dest + row * job->destPitch;
+
+			for (int16 x = 0; x < job->width; ++x) {
+				*dest++ = job->source[*sourceIndex++];
+			}
+		}
+	}
+};
+
 RenderTable::RenderTable(uint numColumns, uint numRows)
 	: _numRows(numRows),
 	  _numColumns(numColumns),
 	  _renderState(FLAT) {
 	assert(numRows != 0 && numColumns != 0);
 
-	_internalBuffer = new Common::Point[numRows * numColumns];
+	_internalBuffer = new uint32[numRows * numColumns];
 
 	memset(&_panoramaOptions, 0, sizeof(_panoramaOptions));
 	memset(&_tiltOptions, 0, sizeof(_tiltOptions));
+
+	// Nothing has been generated yet
+	_generatedOptions.renderState = FLAT;
+	_generatedOptions.fieldOfView = 0.0f;
+	_generatedOptions.linearScale = 0.0f;
 }
 
 RenderTable::~RenderTable() {
@@ -74,59 +103,47 @@ const Common::Point RenderTable::convertWarpedCoordToFlatCoord(const Common::Poi
 		return Common::Point(x, y);
 	}
 
-	uint32 index = point.y * _numColumns + point.x;
+	uint32 sourceIndex = _internalBuffer[point.y * _numColumns + point.x];
 
-	Common::Point newPoint(point);
-	newPoint.x += _internalBuffer[index].x;
-	newPoint.y += _internalBuffer[index].y;
-
-	return newPoint;
+	return Common::Point(sourceIndex % _numColumns, sourceIndex / _numColumns);
 }
 
 void RenderTable::mutateImage(uint16 *sourceBuffer, uint16 *destBuffer, uint32 destWidth, const Common::Rect &subRect) {
-	uint32 destOffset = 0;
-
-	for (int16 y = subRect.top; y < subRect.bottom; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = subRect.left; x < subRect.right; ++x) {
-			uint32 normalizedX = x - subRect.left;
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
-
-			destBuffer[destOffset + normalizedX] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-		}
-
-		destOffset += destWidth;
-	}
+	WarpJob job;
+	job.table = &_internalBuffer[subRect.top * _numColumns + subRect.left];
+	job.tablePitch = _numColumns;
+	job.source = sourceBuffer;
+	job.dest = destBuffer;
+	job.destPitch = destWidth;
+	job.width = subRect.width();
+
+	warpRows(job, subRect.height());
 }
 
 void RenderTable::mutateImage(Graphics::Surface *dstBuf, Graphics::Surface *srcBuf) {
-	uint32 destOffset = 0;
-
-	uint16 *sourceBuffer = (uint16 *)srcBuf->getPixels();
-	uint16 *destBuffer = (uint16 *)dstBuf->getPixels();
-
-	for (int16 y = 0; y < srcBuf->h; ++y) {
-		uint32 sourceOffset = y * _numColumns;
-
-		for (int16 x = 0; x < srcBuf->w; ++x) {
-			uint32 index = sourceOffset + x;
-
-			// RenderTable only stores offsets from the original coordinates
-			uint32 sourceYIndex = y + _internalBuffer[index].y;
-			uint32 sourceXIndex = x + _internalBuffer[index].x;
+	WarpJob job;
+	job.table = _internalBuffer;
+	job.tablePitch = _numColumns;
+	job.source = (const uint16 *)srcBuf->getPixels();
+	job.dest = (uint16 *)dstBuf->getPixels();
+	job.destPitch = srcBuf->w;
+	job.width = srcBuf->w;
+
+	warpRows(job, srcBuf->h);
+}
 
-			destBuffer[destOffset] = sourceBuffer[sourceYIndex * _numColumns + sourceXIndex];
-			destOffset++;
-		}
-	}
+void RenderTable::warpRows(WarpJob &job, uint rowCount) {
+	// Each row only reads the table and the source image, so the bands are independent
+	ThreadPoolMan.parallelFor(0, rowCount, kMinBandHeight, WarpJob::warp, &job);
 }
 
 void RenderTable::generateRenderTable() {
+	// The scripts and effects regenerate the table a lot, often with unchanged parameters
+	const float fieldOfView = getAngle();
+	const float linearScale = getLinscale();
+	if (_renderState == _generatedOptions.renderState && fieldOfView == _generatedOptions.fieldOfView && linearScale == _generatedOptions.linearScale)
+		return;
+
 	switch (_renderState) {
 	case ZVision::RenderTable::PANORAMA:
 		generatePanoramaLookupTable();
@@ -140,17 +157,13 @@ void RenderTable::generateRenderTable() {
 	default:
 		break;
 	}
+
+	_generatedOptions.renderState = _renderState;
+	_generatedOptions.fieldOfView = fieldOfView;
+	_generatedOptions.linearScale = linearScale;
 }
 
 void RenderTable::generatePanoramaLookupTable() {
-	for (uint y = 0; y < _numRows; y++) {
-		for (uint x = 0; x < _numColumns; x++) {
-			uint32 index = y * _numColumns + x;
-			_internalBuffer[index].x = 0;
-			_internalBuffer[index].y = 0;
-		}
-	}
-
 	float halfWidth = (float)_numColumns / 2.0f;
 	float halfHeight = (float)_numRows / 2.0f;
 
@@ -173,11 +186,8 @@ void RenderTable::generatePanoramaLookupTable() {
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
 			int32 yInCylinderCoords = int32(floor(halfHeight + ((float)y - halfHeight) * cosAlpha));
 
-			uint32 index = y * _numColumns + x;
-
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			// Store the index of the source pixel, so that warping an image is a plain lookup
+			_internalBuffer[y * _numColumns + x] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
@@ -208,11 +218,8 @@ void RenderTable::generateTiltLookupTable() {
 			// comparing the triangle from the center to the screen and from the center to the edge of the cylinder
 			int32 xInCylinderCoords = int32(floor(halfWidth + ((float)x - halfWidth) * cosAlpha));
 
-			uint32 index = columnIndex + x;
-
-			// Only store the (x,y) offsets instead of the absolute positions
-			_internalBuffer[index].x = xInCylinderCoords - x;
-			_internalBuffer[index].y = yInCylinderCoords - y;
+			// Store the index of the source pixel, so that warping an image is a plain lookup
+			_internalBuffer[columnIndex + x] = yInCylinderCoords * _numColumns + xInCylinderCoords;
 		}
 	}
 }
@@ -40,10 +40,23 @@ public:
 	};
 
 private:
+	enum {
+		// Fewer rows than this are not worth handing to another thread
+		kMinBandHeight = 16
+	};
+
 	uint _numColumns, _numRows;
-	Common::Point *_internalBuffer;
+	// Index of the source pixel for each pixel of the warped image
+	uint32 *_internalBuffer;
 	RenderState _renderState;
 
+	// Parameters of the table in _internalBuffer, so that it is only regenerated when they change
+	struct {
+		RenderState renderState;
+		float fieldOfView;
+		float linearScale;
+	} _generatedOptions;
+
 	struct {
 		float fieldOfView;
 		float linearScale;
@@ -87,6 +100,9 @@ public:
 	float getLinscale();
 
 private:
+	struct WarpJob;
+	void warpRows(WarpJob &job, uint rowCount);
+
 	void generatePanoramaLookupTable();
 	void generateTiltLookupTable();
 };
@@ -32,7 +32,12 @@ namespace Graphics {
  * DRAWSTEP handling functions
  ********************************************************************/
 void VectorRenderer::drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra) {
+	setupStep(area, clip, step, extra);
 
+	(this->*(step.drawingCall))(area, step);
+}
+
+void VectorRenderer::setupStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra) {
 	if (step.bgColor.set)
 		setBgColor(step.bgColor.r, step.bgColor.g, step.bgColor.b);
 
@@ -54,8 +59,6 @@ void VectorRenderer::drawStep(const Common::Rect &area, const Common::Rect &clip
 	setClippingRect(applyStepClippingRect(area, clip, step));
 
 	_dynamicData = extra;
-
-	(this->*(step.drawingCall))(area, step);
 }
 
 Common::Rect VectorRenderer::applyStepClippingRect(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step) {
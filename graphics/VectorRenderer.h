@@ -477,6 +477,28 @@ public:
 	 */
 	virtual void drawStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
 
+	/**
+	 * Applies the colors and settings of the specified draw step without
+	 * drawing anything, leaving the renderer in the same state drawStep()
+	 * would.
+	 */
+	void setupStep(const Common::Rect &area, const Common::Rect &clip, const DrawStep &step, uint32 extra = 0);
+
+	/** Colors which draw steps may leave unset and inherit from earlier drawing. */
+	enum ColorState {
+		kColorStateFg = 1 << 0,
+		kColorStateBg = 1 << 1,
+		kColorStateBevel = 1 << 2,
+		kColorStateGradient = 1 << 3
+	};
+
+	/**
+	 * Returns a hash of the currently active colors.
+	 *
+	 * @param colors Combination of ColorState flags selecting the colors to hash.
+	 */
+	virtual uint32 getColorStateHash(uint32 colors) const = 0;
+
 	/**
 	 * Copies the part of the current frame to the system overlay.
 	 *
@@ -614,6 +614,23 @@ setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) {
 	}
 }
 
+template<typename PixelType>
+uint32 VectorRendererSpec<PixelType>::
+getColorStateHash(uint32 colors) const {
+	uint32 hash = 0;
+
+	if (colors & kColorStateFg)
+		hash = (hash ^ _fgColor) * 0x9E3779B1;
+	if (colors & kColorStateBg)
+		hash = (hash ^ _bgColor) * 0x9E3779B1;
+	if (colors & kColorStateBevel)
+		hash = (hash ^ _bevelColor) * 0x9E3779B1;
+	if (colors & kColorStateGradient)
+		hash = (((hash ^ _gradientStart) * 0x9E3779B1) ^ _gradientEnd) * 0x9E3779B1;
+
+	return hash;
+}
+
 template<typename PixelType>
 inline PixelType VectorRendererSpec<PixelType>::
 calcGradient(uint32 pos, uint32 max) {
@@ -82,6 +82,7 @@ public:
 	void setBevelColor(uint8 r, uint8 g, uint8 b) override { _bevelColor = _format.RGBToColor(r, g, b); }
 	void setGradientColors(uint8 r1, uint8 g1, uint8 b1, uint8 r2, uint8 g2, uint8 b2) override;
 	void setClippingRect(const Common::Rect &clippingArea) override { _clippingArea = clippingArea; }
+	uint32 getColorStateHash(uint32 colors) const override;
 
 	void copyFrame(OSystem *sys, const Common::Rect &r) override;
 	void copyWholeFrame(OSystem *sys) override { copyFrame(sys, Common::Rect(0, 0, _activeSurface->w, _activeSurface->h)); }
@@ -0,0 +1,131 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/conversion_intern.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+/** Expand eight 16-bit RGB565 pixels into their 8-bit red, green and blue components. */
+static inline void expand565(uint16x8_t color, uint16x8_t &r, uint16x8_t &g, uint16x8_t &b) {
+	const uint16x8_t r5 = vshrq_n_u16(color, 11);
+	const uint16x8_t g6 = vandq_u16(vshrq_n_u16(color, 5), vdupq_n_u16(0x3F));
+	const uint16x8_t b5 = vandq_u16(color, vdupq_n_u16(0x1F));
+
+	r = vorrq_u16(vshlq_n_u16(r5, 3), vshrq_n_u16(r5, 2));
+	g = vorrq_u16(vshlq_n_u16(g6, 2), vshrq_n_u16(g6, 4));
+	b = vorrq_u16(vshlq_n_u16(b5, 3), vshrq_n_u16(b5, 2));
+}
+
+/** Extract an 8-bit component from four 32-bit pixels. */
+static inline uint32x4_t extractComponent(uint32x4_t color, int shift, uint32x4_t mask) {
+	// Shifting left by a negative amount shifts right
+	return vandq_u32(vshlq_u32(color, vdupq_n_s32(-shift)), mask);
+}
+
+/** Move the low bytes of four 32-bit values to the given bit position. */
+static inline uint32x4_t placeComponent(uint32x4_t value, int shift) {
+	return vshlq_u32(value, vdupq_n_s32(shift));
+}
+
+static void convert565To32NEON(uint32 *dst, const uint16 *src, uint w, const PixelFormat &dstFmt) {
+	const uint blocks = w / 8;
+
+	// The row is converted from right to left, so start with the pixels
+	// which do not fill a whole block.
+	getScalarCrossBlitKernels().convert565To32(dst + blocks * 8, src + blocks * 8, w % 8, dstFmt);
+
+	const uint32x4_t alpha = vdupq_n_u32((dstFmt.aLoss == 0) ? (0xFFu << dstFmt.aShift) : 0);
+
+	for (uint i = blocks; i-- > 0; ) {
+		uint16x8_t r, g, b;
+		expand565(vld1q_u16(src + i * 8), r, g, b);
+
+		uint32x4_t lo = alpha;
+		lo = vorrq_u32(lo, placeComponent(vmovl_u16(vget_low_u16(r)), dstFmt.rShift));
+		lo = vorrq_u32(lo, placeComponent(vmovl_u16(vget_low_u16(g)), dstFmt.gShift));
+		lo = vorrq_u32(lo, placeComponent(vmovl_u16(vget_low_u16(b)), dstFmt.bShift));
+
+		uint32x4_t hi = alpha;
+		hi = vorrq_u32(hi, placeComponent(vmovl_u16(vget_high_u16(r)), dstFmt.rShift));
+		hi = vorrq_u32(hi, placeComponent(vmovl_u16(vget_high_u16(g)), dstFmt.gShift));
+		hi = vorrq_u32(hi, placeComponent(vmovl_u16(vget_high_u16(b)), dstFmt.bShift));
+
+		vst1q_u32(dst + i * 8, lo);
+		vst1q_u32(dst + i * 8 + 4, hi);
+	}
+}
+
+static inline uint16x4_t pack32To565(uint32x4_t color, const PixelFormat &srcFmt) {
+	const uint32x4_t mask5 = vdupq_n_u32(0xF8);
+	const uint32x4_t mask6 = vdupq_n_u32(0xFC);
+
+	uint32x4_t result = vshlq_n_u32(extractComponent(color, srcFmt.rShift, mask5), 8);
+	result = vorrq_u32(result, vshlq_n_u32(extractComponent(color, srcFmt.gShift, mask6), 3));
+	result = vorrq_u32(result, vshrq_n_u32(extractComponent(color, srcFmt.bShift, mask5), 3));
+
+	return vmovn_u32(result);
+}
+
+static void convert32To565NEON(uint16 *dst, const uint32 *src, uint w, const PixelFormat &srcFmt) {
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		const uint16x4_t lo = pack32To565(vld1q_u32(src + x), srcFmt);
+		const uint16x4_t hi = pack32To565(vld1q_u32(src + x + 4), srcFmt);
+		vst1q_u16(dst + x, vcombine_u16(lo, hi));
+	}
+
+	getScalarCrossBlitKernels().convert32To565(dst + x, src + x, w - x, srcFmt);
+}
+
+static void convert32To32NEON(uint32 *dst, const uint32 *src, uint w, const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	// See convert32To32Scalar() for the handling of alpha
+	const uint32x4_t alpha = vdupq_n_u32((dstFmt.aLoss == 0 && srcFmt.aLoss != 0) ? (0xFFu << dstFmt.aShift) : 0);
+	const uint32x4_t alphaMask = vdupq_n_u32((dstFmt.aLoss == 0 && srcFmt.aLoss == 0) ? 0xFF : 0);
+	const uint32x4_t mask = vdupq_n_u32(0xFF);
+
+	uint x = 0;
+	for (; x + 4 <= w; x += 4) {
+		const uint32x4_t color = vld1q_u32(src + x);
+
+		uint32x4_t result = alpha;
+		result = vorrq_u32(result, placeComponent(extractComponent(color, srcFmt.rShift, mask), dstFmt.rShift));
+		result = vorrq_u32(result, placeComponent(extractComponent(color, srcFmt.gShift, mask), dstFmt.gShift));
+		result = vorrq_u32(result, placeComponent(extractComponent(color, srcFmt.bShift, mask), dstFmt.bShift));
+		result = vorrq_u32(result, placeComponent(extractComponent(color, srcFmt.aShift, alphaMask), dstFmt.aShift));
+
+		vst1q_u32(dst + x, result);
+	}
+
+	getScalarCrossBlitKernels().convert32To32(dst + x, src + x, w - x, dstFmt, srcFmt);
+}
+
+const CrossBlitKernels &getNEONCrossBlitKernels() {
+	static const CrossBlitKernels kernels = {
+		convert565To32NEON,
+		convert32To565NEON,
+		convert32To32NEON
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/conversion_intern.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+/** Expand eight 16-bit RGB565 pixels into their 8-bit red, green and blue components. */
+static inline void expand565(__m128i color, __m128i &r, __m128i &g, __m128i &b) {
+	const __m128i r5 = _mm_srli_epi16(color, 11);
+	const __m128i g6 = _mm_and_si128(_mm_srli_epi16(color, 5), _mm_set1_epi16(0x3F));
+	const __m128i b5 = _mm_and_si128(color, _mm_set1_epi16(0x1F));
+
+	r = _mm_or_si128(_mm_slli_epi16(r5, 3), _mm_srli_epi16(r5, 2));
+	g = _mm_or_si128(_mm_slli_epi16(g6, 2), _mm_srli_epi16(g6, 4));
+	b = _mm_or_si128(_mm_slli_epi16(b5, 3), _mm_srli_epi16(b5, 2));
+}
+
+/** Move the low bytes of four 32-bit values to the given bit position. */
+static inline __m128i placeComponent(__m128i value, __m128i shift) {
+	return _mm_sll_epi32(value, shift);
+}
+
+/** Extract an 8-bit component from four 32-bit pixels. */
+static inline __m128i extractComponent(__m128i color, __m128i shift, __m128i mask) {
+	return _mm_and_si128(_mm_srl_epi32(color, shift), mask);
+}
+
+static void convert565To32SSE2(uint32 *dst, const uint16 *src, uint w, const PixelFormat &dstFmt) {
+	const uint blocks = w / 8;
+
+	// The row is converted from right to left, so start with the pixels
+	// which do not fill a whole block.
+	getScalarCrossBlitKernels().convert565To32(dst + blocks * 8, src + blocks * 8, w % 8, dstFmt);
+
+	const __m128i alpha = _mm_set1_epi32((dstFmt.aLoss == 0) ? (int)(0xFFu << dstFmt.aShift) : 0);
+	const __m128i rShift = _mm_cvtsi32_si128(dstFmt.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(dstFmt.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(dstFmt.bShift);
+	const __m128i zero = _mm_setzero_si128();
+
+	for (uint i = blocks; i-- > 0; ) {
+		__m128i r, g, b;
+		expand565(_mm_loadu_si128((const __m128i *)(src + i * 8)), r, g, b);
+
+		__m128i lo = alpha;
+		lo = _mm_or_si128(lo, placeComponent(_mm_unpacklo_epi16(r, zero), rShift));
+		lo = _mm_or_si128(lo, placeComponent(_mm_unpacklo_epi16(g, zero), gShift));
+		lo = _mm_or_si128(lo, placeComponent(_mm_unpacklo_epi16(b, zero), bShift));
+
+		__m128i hi = alpha;
+		hi = _mm_or_si128(hi, placeComponent(_mm_unpackhi_epi16(r, zero), rShift));
+		hi = _mm_or_si128(hi, placeComponent(_mm_unpackhi_epi16(g, zero), gShift));
+		hi = _mm_or_si128(hi, placeComponent(_mm_unpackhi_epi16(b, zero), bShift));
+
+		_mm_storeu_si128((__m128i *)(dst + i * 8), lo);
+		_mm_storeu_si128((__m128i *)(dst + i * 8 + 4), hi);
+	}
+}
+
+static inline __m128i pack32To565(__m128i color, __m128i rShift, __m128i gShift, __m128i bShift) {
+	const __m128i mask5 = _mm_set1_epi32(0xF8);
+	const __m128i mask6 = _mm_set1_epi32(0xFC);
+
+	__m128i result = _mm_slli_epi32(extractComponent(color, rShift, mask5), 8);
+	result = _mm_or_si128(result, _mm_slli_epi32(extractComponent(color, gShift, mask6), 3));
+	result = _mm_or_si128(result, _mm_srli_epi32(extractComponent(color, bShift, mask5), 3));
+
+	// Sign extend the 16-bit results, so that packing them does not saturate
+	return _mm_srai_epi32(_mm_slli_epi32(result, 16), 16);
+}
+
+static void convert32To565SSE2(uint16 *dst, const uint32 *src, uint w, const PixelFormat &srcFmt) {
+	const __m128i rShift = _mm_cvtsi32_si128(srcFmt.rShift);
+	const __m128i gShift = _mm_cvtsi32_si128(srcFmt.gShift);
+	const __m128i bShift = _mm_cvtsi32_si128(srcFmt.bShift);
+
+	uint x = 0;
+	for (; x + 8 <= w; x += 8) {
+		const __m128i lo = pack32To565(_mm_loadu_si128((const __m128i *)(src + x)), rShift, gShift, bShift);
+		const __m128i hi = pack32To565(_mm_loadu_si128((const __m128i *)(src + x + 4)), rShift, gShift, bShift);
+		_mm_storeu_si128((__m128i *)(dst + x), _mm_packs_epi32(lo, hi));
+	}
+
+	getScalarCrossBlitKernels().convert32To565(dst + x, src + x, w - x, srcFmt);
+}
+
+static void convert32To32SSE2(uint32 *dst, const uint32 *src, uint w, const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	// See convert32To32Scalar() for the handling of alpha
+	const __m128i alpha = _mm_set1_epi32((dstFmt.aLoss == 0 && srcFmt.aLoss != 0) ? (int)(0xFFu << dstFmt.aShift) : 0);
+	const __m128i alphaMask = _mm_set1_epi32((dstFmt.aLoss == 0 && srcFmt.aLoss == 0) ? 0xFF : 0);
+	const __m128i mask = _mm_set1_epi32(0xFF);
+
+	const __m128i srcR = _mm_cvtsi32_si128(srcFmt.rShift), dstR = _mm_cvtsi32_si128(dstFmt.rShift);
+	const __m128i srcG = _mm_cvtsi32_si128(srcFmt.gShift), dstG = _mm_cvtsi32_si128(dstFmt.gShift);
+	const __m128i srcB = _mm_cvtsi32_si128(srcFmt.bShift), dstB = _mm_cvtsi32_si128(dstFmt.bShift);
+	const __m128i srcA = _mm_cvtsi32_si128(srcFmt.aShift), dstA = _mm_cvtsi32_si128(dstFmt.aShift);
+
+	uint x = 0;
+	for (; x + 4 <= w; x += 4) {
+		const __m128i color = _mm_loadu_si128((const __m128i *)(src + x));
+
+		__m128i result = alpha;
+		result = _mm_or_si128(result, placeComponent(extractComponent(color, srcR, mask), dstR));
+		result = _mm_or_si128(result, placeComponent(extractComponent(color, srcG, mask), dstG));
+		result = _mm_or_si128(result, placeComponent(extractComponent(color, srcB, mask), dstB));
+		result = _mm_or_si128(result, placeComponent(extractComponent(color, srcA, alphaMask), dstA));
+
+		_mm_storeu_si128((__m128i *)(dst + x), result);
+	}
+
+	getScalarCrossBlitKernels().convert32To32(dst + x, src + x, w - x, dstFmt, srcFmt);
+}
+
+const CrossBlitKernels &getSSE2CrossBlitKernels() {
+	static const CrossBlitKernels kernels = {
+		convert565To32SSE2,
+		convert32To565SSE2,
+		convert32To32SSE2
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
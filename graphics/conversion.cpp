@@ -25,12 +25,15 @@
  */
 
 #include "graphics/conversion.h"
+#include "graphics/conversion_intern.h"
+#include "graphics/managed_surface_intern.h"
 #include "graphics/pixelformat.h"
 #include "graphics/transform_struct.h"
 
 #include "common/endian.h"
 #include "common/math.h"
 #include "common/rect.h"
+#include "common/cpu.h"
 
 namespace Graphics {
 
@@ -89,7 +92,20 @@ bool keyBlit(byte *dst, const byte *src,
 	const uint srcDelta = (srcPitch - w * bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * bytesPerPixel);
 
-	if (bytesPerPixel == 1) {
+	// Use the row routines of ManagedSurface::transBlitFrom() when the key
+	// fits in a pixel. Other keys never match, and go through the generic
+	// code below.
+	const TransBlitKernels &kernels = getTransBlitKernels();
+	if (bytesPerPixel == 1 && key <= 0xff) {
+		for (uint y = 0; y < h; ++y, dst += dstPitch, src += srcPitch)
+			kernels.transRow8(dst, src, w, key);
+	} else if (bytesPerPixel == 2 && key <= 0xffff) {
+		for (uint y = 0; y < h; ++y, dst += dstPitch, src += srcPitch)
+			kernels.transRow16((uint16 *)dst, (const uint16 *)src, w, key, 0xffff);
+	} else if (bytesPerPixel == 4) {
+		for (uint y = 0; y < h; ++y, dst += dstPitch, src += srcPitch)
+			kernels.transRow32((uint32 *)dst, (const uint32 *)src, w, key, 0xffffffff);
+	} else if (bytesPerPixel == 1) {
 		keyBlitLogic<uint8>(dst, src, w, h, srcDelta, dstDelta, key);
 	} else if (bytesPerPixel == 2) {
 		keyBlitLogic<uint16>(dst, src, w, h, srcDelta, dstDelta, key);
@@ -102,6 +118,18 @@ bool keyBlit(byte *dst, const byte *src,
 	return true;
 }
 
+void maskBlit(byte *dst, const byte *src, const byte *mask,
+			   const uint dstPitch, const uint srcPitch, const uint maskPitch,
+			   const uint w, const uint h, const byte maskKey) {
+	const TransBlitKernels &kernels = getTransBlitKernels();
+	for (uint y = 0; y < h; ++y) {
+		kernels.maskRow8(dst, src, mask, w, maskKey);
+		dst += dstPitch;
+		src += srcPitch;
+		mask += maskPitch;
+	}
+}
+
 namespace {
 
 template<typename SrcColor, typename DstColor, bool backward>
@@ -195,8 +223,107 @@ inline void crossBlitLogic3BppSource(byte *dst, const byte *src, const uint w, c
 	}
 }
 
+void convert565To32Scalar(uint32 *dst, const uint16 *src, uint w, const PixelFormat &dstFmt) {
+	const uint32 alpha = (dstFmt.aLoss == 0) ? (0xFFu << dstFmt.aShift) : 0;
+
+	while (w--) {
+		const uint32 color = src[w];
+		const uint32 r = (color >> 11) & 0x1F;
+		const uint32 g = (color >> 5) & 0x3F;
+		const uint32 b = color & 0x1F;
+
+		dst[w] = alpha |
+		         (((r << 3) | (r >> 2)) << dstFmt.rShift) |
+		         (((g << 2) | (g >> 4)) << dstFmt.gShift) |
+		         (((b << 3) | (b >> 2)) << dstFmt.bShift);
+	}
+}
+
+void convert32To565Scalar(uint16 *dst, const uint32 *src, uint w, const PixelFormat &srcFmt) {
+	for (uint x = 0; x < w; ++x) {
+		const uint32 color = src[x];
+
+		dst[x] = (((color >> srcFmt.rShift) & 0xF8) << 8) |
+		         (((color >> srcFmt.gShift) & 0xFC) << 3) |
+		         (((color >> srcFmt.bShift) & 0xF8) >> 3);
+	}
+}
+
+void convert32To32Scalar(uint32 *dst, const uint32 *src, uint w, const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	// Alpha is copied if both formats have it, set to opaque if only the
+	// destination has it, and dropped otherwise.
+	const uint32 alpha = (dstFmt.aLoss == 0 && srcFmt.aLoss != 0) ? (0xFFu << dstFmt.aShift) : 0;
+	const uint32 alphaMask = (dstFmt.aLoss == 0 && srcFmt.aLoss == 0) ? 0xFF : 0;
+
+	for (uint x = 0; x < w; ++x) {
+		const uint32 color = src[x];
+
+		dst[x] = alpha |
+		         (((color >> srcFmt.rShift) & 0xFF) << dstFmt.rShift) |
+		         (((color >> srcFmt.gShift) & 0xFF) << dstFmt.gShift) |
+		         (((color >> srcFmt.bShift) & 0xFF) << dstFmt.bShift) |
+		         (((color >> srcFmt.aShift) & alphaMask) << dstFmt.aShift);
+	}
+}
+
+/**
+ * Blit using the optimized conversion routines, if there are any for the
+ * given pixel formats.
+ */
+bool crossBlitKernels(byte *dst, const byte *src,
+					  const uint dstPitch, const uint srcPitch,
+					  const uint w, const uint h,
+					  const PixelFormat &dstFmt, const PixelFormat &srcFmt) {
+	const CrossBlitKernels &kernels = getCrossBlitKernels();
+	const PixelFormat format565 = createPixelFormat<565>();
+
+	if (srcFmt == format565 && isByteAligned32(dstFmt)) {
+		// Convert from bottom to top, so that the surface can be converted
+		// in place. The rows themselves are converted from right to left.
+		for (uint y = h; y-- > 0; )
+			kernels.convert565To32((uint32 *)(dst + y * dstPitch), (const uint16 *)(src + y * srcPitch), w, dstFmt);
+		return true;
+	}
+
+	if (dstFmt == format565 && isByteAligned32(srcFmt)) {
+		for (uint y = 0; y < h; ++y)
+			kernels.convert32To565((uint16 *)(dst + y * dstPitch), (const uint32 *)(src + y * srcPitch), w, srcFmt);
+		return true;
+	}
+
+	if (isByteAligned32(dstFmt) && isByteAligned32(srcFmt)) {
+		for (uint y = 0; y < h; ++y)
+			kernels.convert32To32((uint32 *)(dst + y * dstPitch), (const uint32 *)(src + y * srcPitch), w, dstFmt, srcFmt);
+		return true;
+	}
+
+	return false;
+}
+
 } // End of anonymous namespace
 
+const CrossBlitKernels &getScalarCrossBlitKernels() {
+	static const CrossBlitKernels kernels = {
+		convert565To32Scalar,
+		convert32To565Scalar,
+		convert32To32Scalar
+	};
+	return kernels;
+}
+
+const CrossBlitKernels &getCrossBlitKernels() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return getSSE2CrossBlitKernels();
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return getNEONCrossBlitKernels();
+#endif
+
+	return getScalarCrossBlitKernels();
+}
+
 // Function to blit a rect from one color format to another
 bool crossBlit(byte *dst, const byte *src,
 			   const uint dstPitch, const uint srcPitch,
@@ -214,6 +341,10 @@ bool crossBlit(byte *dst, const byte *src,
 		return true;
 	}
 
+	// Use the optimized routines for the most common conversions
+	if (crossBlitKernels(dst, src, dstPitch, srcPitch, w, h, dstFmt, srcFmt))
+		return true;
+
 	// Faster, but larger, to provide optimized handling for each case.
 	const uint srcDelta = (srcPitch - w * srcFmt.bytesPerPixel);
 	const uint dstDelta = (dstPitch - w * dstFmt.bytesPerPixel);
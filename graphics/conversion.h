@@ -99,6 +99,27 @@ bool keyBlit(byte *dst, const byte *src,
 			   const uint dstPitch, const uint srcPitch,
 			   const uint w, const uint h,
 			   const uint bytesPerPixel, const uint32 key);
+
+/**
+ * Blits a rectangle of 8-bit pixels, except where a mask matches a key.
+ *
+ * This is used for sprites which select which pixels of another image they
+ * show, for example shadows.
+ *
+ * @param dst			the buffer which will recieve the graphics data
+ * @param src			the buffer containing the graphics data
+ * @param mask			the buffer containing the mask
+ * @param dstPitch		width in bytes of one full line of the dest buffer
+ * @param srcPitch		width in bytes of one full line of the source buffer
+ * @param maskPitch		width in bytes of one full line of the mask buffer
+ * @param w				the width of the graphics data
+ * @param h				the height of the graphics data
+ * @param maskKey		the mask value for which pixels are not copied
+ */
+void maskBlit(byte *dst, const byte *src, const byte *mask,
+			   const uint dstPitch, const uint srcPitch, const uint maskPitch,
+			   const uint w, const uint h, const byte maskKey);
+
 /**
  * Blits a rectangle from one graphical format to another.
  *
@@ -0,0 +1,84 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_CONVERSION_INTERN_H
+#define GRAPHICS_CONVERSION_INTERN_H
+
+#include "graphics/pixelformat.h"
+
+namespace Graphics {
+
+/**
+ * Optimized row conversion routines used by crossBlit() for common pixel
+ * format pairs.
+ *
+ * The 32-bit formats handled by these routines must have 8-bit color
+ * components at byte boundaries, and either an 8-bit alpha component or
+ * none at all; see isByteAligned32(). All implementations produce the same
+ * output as PixelFormat::colorToARGB() followed by
+ * PixelFormat::ARGBToColor().
+ */
+struct CrossBlitKernels {
+	/**
+	 * Convert a row of RGB565 pixels to a 32-bit format.
+	 *
+	 * The row is processed from right to left, so that it can be converted
+	 * in place.
+	 */
+	void (*convert565To32)(uint32 *dst, const uint16 *src, uint w, const PixelFormat &dstFmt);
+	/** Convert a row of 32-bit pixels to RGB565. */
+	void (*convert32To565)(uint16 *dst, const uint32 *src, uint w, const PixelFormat &srcFmt);
+	/** Convert a row of 32-bit pixels to another 32-bit format. */
+	void (*convert32To32)(uint32 *dst, const uint32 *src, uint w, const PixelFormat &dstFmt, const PixelFormat &srcFmt);
+};
+
+/**
+ * Check whether the given format is a 32-bit format with 8-bit components
+ * at byte boundaries, which can be handled by CrossBlitKernels.
+ */
+inline bool isByteAligned32(const PixelFormat &fmt) {
+	return fmt.bytesPerPixel == 4 &&
+	       fmt.rLoss == 0 && fmt.gLoss == 0 && fmt.bLoss == 0 &&
+	       (fmt.rShift % 8) == 0 && (fmt.gShift % 8) == 0 && (fmt.bShift % 8) == 0 &&
+	       (fmt.aLoss == 8 || (fmt.aLoss == 0 && (fmt.aShift % 8) == 0));
+}
+
+/**
+ * Return the fastest conversion routines supported by the host CPU.
+ */
+const CrossBlitKernels &getCrossBlitKernels();
+
+/**
+ * Return the portable C++ conversion routines.
+ */
+const CrossBlitKernels &getScalarCrossBlitKernels();
+
+#ifdef SCUMMVM_SSE2
+const CrossBlitKernels &getSSE2CrossBlitKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const CrossBlitKernels &getNEONCrossBlitKernels();
+#endif
+
+} // End of namespace Graphics
+
+#endif
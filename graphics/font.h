@@ -22,14 +22,11 @@
 #ifndef GRAPHICS_FONT_H
 #define GRAPHICS_FONT_H
 
+#include "common/array.h"
 #include "common/str.h"
 #include "common/ustr.h"
 #include "common/rect.h"
 
-namespace Common {
-template<class T> class Array;
-}
-
 namespace Graphics {
 
 /**
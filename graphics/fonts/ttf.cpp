@@ -171,19 +171,53 @@ private:
 	int _width, _height;
 	int _ascent, _descent;
 
+	/**
+	 * Metrics of a glyph. Its bitmap is kept in the atlas, from which it
+	 * may be evicted and rasterized again later. Characters missing from
+	 * the font are cached as empty glyphs with a zero slot.
+	 */
 	struct Glyph {
-		Surface image;
 		int xOffset, yOffset;
+		int width, height;
 		int advance;
 		FT_UInt slot;
+		int page;   ///< Atlas page holding the bitmap, -1 when not rasterized
+		int x, y;   ///< Position of the bitmap in the atlas page
 	};
 
 	bool cacheGlyph(Glyph &glyph, uint32 chr) const;
+	bool rasterizeGlyph(Glyph &glyph) const;
 	typedef Common::HashMap<uint32, Glyph> GlyphCache;
 	mutable GlyphCache _glyphs;
 	bool _allowLateCaching;
+	uint32 _mapping[256];
 	void assureCached(uint32 chr) const;
 
+	enum {
+		/** Maximum number of atlas pages, the least recently used one is reused afterwards. */
+		kMaxAtlasPages = 4
+	};
+
+	/** A row of glyph bitmaps in an atlas page. */
+	struct AtlasShelf {
+		int y, height;
+		int usedWidth;
+	};
+
+	/** Glyph bitmaps packed into a single 8bpp surface. */
+	struct AtlasPage {
+		Surface surface;
+		Common::Array<AtlasShelf> shelves;
+		uint32 lastUse;
+	};
+
+	mutable Common::Array<AtlasPage *> _atlas;
+	mutable uint32 _atlasUseCounter;
+	int _atlasPageSize;
+	bool allocateGlyph(Glyph &glyph) const;
+	bool allocateGlyphInPage(Glyph &glyph, int page) const;
+	void evictAtlasPage(int page) const;
+
 	Common::SeekableReadStream *readTTFTable(FT_ULong tag) const;
 
 	int computePointSize(int size, TTFSizeMode sizeMode) const;
@@ -203,7 +237,8 @@ private:
 TTFFont::TTFFont()
 	: _initialized(false), _face(), _ttfFile(0), _size(0), _width(0), _height(0), _ascent(0),
 	  _descent(0), _glyphs(), _loadFlags(FT_LOAD_TARGET_NORMAL), _renderMode(FT_RENDER_MODE_NORMAL),
-	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false) {
+	  _hasKerning(false), _allowLateCaching(false), _fakeBold(false), _fakeItalic(false),
+	  _atlasUseCounter(0), _atlasPageSize(0) {
 }
 
 TTFFont::~TTFFont() {
@@ -213,8 +248,10 @@ TTFFont::~TTFFont() {
 		delete[] _ttfFile;
 		_ttfFile = 0;
 
-		for (GlyphCache::iterator i = _glyphs.begin(), end = _glyphs.end(); i != end; ++i)
-			i->_value.image.free();
+		for (uint i = 0; i < _atlas.size(); ++i) {
+			_atlas[i]->surface.free();
+			delete _atlas[i];
+		}
 
 		_initialized = false;
 	}
@@ -367,40 +404,50 @@ bool TTFFont::load(uint8 *ttfFile, uint32 sizeFile, int32 faceIndex, bool bold,
 		_loadFlags |= FT_LOAD_NO_BITMAP;
 	}
 
+	// Pages hold about 16 rows of 16 glyphs
+	_atlasPageSize = 64;
+	while (_atlasPageSize < 16 * _height && _atlasPageSize < 1024)
+		_atlasPageSize *= 2;
+
+	// Glyphs are rasterized when first used. Only check that the font
+	// provides some of the first 256 characters.
+	bool hasGlyphs = false;
+
 	if (!mapping) {
 		// Allow loading of all unicode characters.
 		_allowLateCaching = true;
 
-		// Load all ISO-8859-1 characters.
-		for (uint i = 0; i < 256; ++i) {
-			if (!cacheGlyph(_glyphs[i], i)) {
-				_glyphs.erase(i);
-			}
-		}
+		for (uint i = 0; i < 256 && !hasGlyphs; ++i)
+			hasGlyphs = FT_Get_Char_Index(_face, i) != 0;
 	} else {
 		// We have a fixed map of characters do not load more later.
 		_allowLateCaching = false;
+		memcpy(_mapping, mapping, sizeof(_mapping));
 
 		for (uint i = 0; i < 256; ++i) {
 			const uint32 unicode = mapping[i] & 0x7FFFFFFF;
 			const bool isRequired = (mapping[i] & 0x80000000) != 0;
+
+			if (!isRequired) {
+				hasGlyphs = hasGlyphs || FT_Get_Char_Index(_face, unicode) != 0;
+				continue;
+			}
+
 			// Check whether loading an important glyph fails and error out if
 			// that is the case.
 			if (!cacheGlyph(_glyphs[i], unicode)) {
-				_glyphs.erase(i);
-				if (isRequired) {
-					g_ttf.closeFont(_face);
+				g_ttf.closeFont(_face);
 
-					// Don't delete ttfFile as we return fail
-					_ttfFile = 0;
+				// Don't delete ttfFile as we return fail
+				_ttfFile = 0;
 
-					return false;
-				}
+				return false;
 			}
+			hasGlyphs = true;
 		}
 	}
 
-	if (_glyphs.size() == 0) {
+	if (!hasGlyphs) {
 		g_ttf.closeFont(_face);
 
 		// Don't delete ttfFile as we return fail
@@ -599,10 +646,8 @@ Common::Rect TTFFont::getBoundingBox(uint32 chr) const {
 	if (glyphEntry == _glyphs.end()) {
 		return Common::Rect();
 	} else {
-		const int xOffset = glyphEntry->_value.xOffset;
-		const int yOffset = glyphEntry->_value.yOffset;
-		const Graphics::Surface &image = glyphEntry->_value.image;
-		return Common::Rect(xOffset, yOffset, xOffset + image.w, yOffset + image.h);
+		const Glyph &glyph = glyphEntry->_value;
+		return Common::Rect(glyph.xOffset, glyph.yOffset, glyph.xOffset + glyph.width, glyph.yOffset + glyph.height);
 	}
 }
 
@@ -675,11 +720,11 @@ void TTFFont::drawChar(ManagedSurface *dst, uint32 chr, int x, int y, uint32 col
 void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		const uint32 *transparentColor) const {
 	assureCached(chr);
-	GlyphCache::const_iterator glyphEntry = _glyphs.find(chr);
+	GlyphCache::iterator glyphEntry = _glyphs.find(chr);
 	if (glyphEntry == _glyphs.end())
 		return;
 
-	const Glyph &glyph = glyphEntry->_value;
+	Glyph &glyph = glyphEntry->_value;
 
 	x += glyph.xOffset;
 	y += glyph.yOffset;
@@ -689,10 +734,21 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 	if (y > dst->h)
 		return;
 
-	int w = glyph.image.w;
-	int h = glyph.image.h;
+	int w = glyph.width;
+	int h = glyph.height;
 
-	const uint8 *srcPos = (const uint8 *)glyph.image.getPixels();
+	if (w <= 0 || h <= 0)
+		return;
+
+	// The bitmap may have been evicted from the atlas since
+	if (glyph.page < 0 && !rasterizeGlyph(glyph))
+		return;
+
+	AtlasPage *page = _atlas[glyph.page];
+	page->lastUse = ++_atlasUseCounter;
+
+	const Surface &image = page->surface;
+	const uint8 *srcPos = (const uint8 *)image.getBasePtr(glyph.x, glyph.y);
 
 	// Make sure we are not drawing outside the screen bounds
 	if (x < 0) {
@@ -708,7 +764,7 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 		return;
 
 	if (y < 0) {
-		srcPos -= y * glyph.image.pitch;
+		srcPos -= y * image.pitch;
 		h += y;
 		y = 0;
 	}
@@ -737,12 +793,12 @@ void TTFFont::drawChar(Surface * dst, uint32 chr, int x, int y, uint32 color,
 			}
 
 			dstPos += dst->pitch;
-			srcPos += glyph.image.pitch;
+			srcPos += image.pitch;
 		}
 	} else if (dst->format.bytesPerPixel == 2) {
-		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint16>(dstPos, dst->pitch, srcPos, image.pitch, w, h, color, dst->format, transparentColor);
 	} else if (dst->format.bytesPerPixel == 4) {
-		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, glyph.image.pitch, w, h, color, dst->format, transparentColor);
+		renderGlyph<uint32>(dstPos, dst->pitch, srcPos, image.pitch, w, h, color, dst->format, transparentColor);
 	}
 }
 
@@ -752,11 +808,16 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 		return false;
 
 	glyph.slot = slot;
+	glyph.page = -1;
 
+	return rasterizeGlyph(glyph);
+}
+
+bool TTFFont::rasterizeGlyph(Glyph &glyph) const {
 	// We use the light target and render mode to improve the looks of the
 	// glyphs. It is most noticeable in FreeSansBold.ttf, where otherwise the
 	// 't' glyph looks like it is cut off on the right side.
-	if (FT_Load_Glyph(_face, slot, _loadFlags))
+	if (FT_Load_Glyph(_face, glyph.slot, _loadFlags))
 		return false;
 
 	if (FT_Render_Glyph(_face->glyph, _renderMode))
@@ -811,50 +872,47 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 
 
-	glyph.image.create(bitmap->width, bitmap->rows, PixelFormat::createFormatCLUT8());
+	bool success = true;
 
-	const uint8 *src = bitmap->buffer;
-	int srcPitch = bitmap->pitch;
-	if (srcPitch < 0) {
-		src += (bitmap->rows - 1) * srcPitch;
-		srcPitch = -srcPitch;
+	if (bitmap->pixel_mode != FT_PIXEL_MODE_MONO && bitmap->pixel_mode != FT_PIXEL_MODE_GRAY) {
+		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
+		success = false;
+	} else {
+		glyph.width = bitmap->width;
+		glyph.height = bitmap->rows;
+		success = allocateGlyph(glyph);
 	}
 
-	uint8 *dst = (uint8 *)glyph.image.getPixels();
+	if (success && glyph.page >= 0) {
+		const uint8 *src = bitmap->buffer;
+		int srcPitch = bitmap->pitch;
+		if (srcPitch < 0) {
+			src += (bitmap->rows - 1) * srcPitch;
+			srcPitch = -srcPitch;
+		}
 
-	switch (bitmap->pixel_mode) {
-	case FT_PIXEL_MODE_MONO:
-		for (int y = 0; y < (int)bitmap->rows; ++y) {
-			const uint8 *curSrc = src;
-			uint8 mask = 0;
+		Surface &image = _atlas[glyph.page]->surface;
 
-			for (int x = 0; x < (int)bitmap->width; ++x) {
-				if ((x % 8) == 0)
-					mask = *curSrc++;
+		for (int y = 0; y < glyph.height; ++y) {
+			uint8 *dst = (uint8 *)image.getBasePtr(glyph.x, glyph.y + y);
 
-				if (mask & 0x80)
-					*dst = 255;
+			if (bitmap->pixel_mode == FT_PIXEL_MODE_MONO) {
+				const uint8 *curSrc = src;
+				uint8 mask = 0;
 
-				mask <<= 1;
-				++dst;
-			}
+				for (int x = 0; x < glyph.width; ++x) {
+					if ((x % 8) == 0)
+						mask = *curSrc++;
 
-			src += srcPitch;
-		}
-		break;
+					*dst++ = (mask & 0x80) ? 255 : 0;
+					mask <<= 1;
+				}
+			} else {
+				memcpy(dst, src, glyph.width);
+			}
 
-	case FT_PIXEL_MODE_GRAY:
-		for (int y = 0; y < (int)bitmap->rows; ++y) {
-			memcpy(dst, src, bitmap->width);
-			dst += glyph.image.pitch;
 			src += srcPitch;
 		}
-		break;
-
-	default:
-		warning("TTFFont::cacheGlyph: Unsupported pixel mode %d", bitmap->pixel_mode);
-		glyph.image.free();
-		return false;
 	}
 
 #if FAKE_BOLD == 1
@@ -863,18 +921,108 @@ bool TTFFont::cacheGlyph(Glyph &glyph, uint32 chr) const {
 	}
 #endif
 
+	return success;
+}
+
+bool TTFFont::allocateGlyph(Glyph &glyph) const {
+	glyph.page = -1;
+
+	// Nothing to store for blank glyphs such as spaces
+	if (glyph.width <= 0 || glyph.height <= 0)
+		return true;
+
+	for (uint i = 0; i < _atlas.size(); ++i) {
+		if (allocateGlyphInPage(glyph, i))
+			return true;
+	}
+
+	int page;
+	if (_atlas.size() < kMaxAtlasPages) {
+		page = _atlas.size();
+		_atlas.push_back(new AtlasPage());
+	} else {
+		page = 0;
+		for (uint i = 1; i < _atlas.size(); ++i) {
+			if (_atlas[i]->lastUse < _atlas[page]->lastUse)
+				page = i;
+		}
+		evictAtlasPage(page);
+	}
+
+	// Glyphs bigger than a page get a page of their own size
+	AtlasPage *atlasPage = _atlas[page];
+	const int w = MAX(_atlasPageSize, glyph.width);
+	const int h = MAX(_atlasPageSize, glyph.height);
+	if (atlasPage->surface.w != w || atlasPage->surface.h != h) {
+		atlasPage->surface.free();
+		atlasPage->surface.create(w, h, PixelFormat::createFormatCLUT8());
+	}
+	atlasPage->lastUse = ++_atlasUseCounter;
+
+	return allocateGlyphInPage(glyph, page);
+}
+
+bool TTFFont::allocateGlyphInPage(Glyph &glyph, int page) const {
+	AtlasPage *atlasPage = _atlas[page];
+	Common::Array<AtlasShelf> &shelves = atlasPage->shelves;
+
+	for (uint i = 0; i < shelves.size(); ++i) {
+		if (glyph.height <= shelves[i].height && shelves[i].usedWidth + glyph.width <= atlasPage->surface.w) {
+			glyph.page = page;
+			glyph.x = shelves[i].usedWidth;
+			glyph.y = shelves[i].y;
+			shelves[i].usedWidth += glyph.width;
+			return true;
+		}
+	}
+
+	const int top = shelves.empty() ? 0 : shelves.back().y + shelves.back().height;
+	if (top + glyph.height > atlasPage->surface.h || glyph.width > atlasPage->surface.w)
+		return false;
+
+	AtlasShelf shelf;
+	shelf.y = top;
+	shelf.height = glyph.height;
+	shelf.usedWidth = glyph.width;
+	shelves.push_back(shelf);
+
+	glyph.page = page;
+	glyph.x = 0;
+	glyph.y = top;
 	return true;
 }
 
+void TTFFont::evictAtlasPage(int page) const {
+	for (GlyphCache::iterator i = _glyphs.begin(); i != _glyphs.end(); ++i) {
+		if (i->_value.page == page)
+			i->_value.page = -1;
+	}
+
+	_atlas[page]->shelves.clear();
+}
+
 void TTFFont::assureCached(uint32 chr) const {
-	if (!chr || !_allowLateCaching || _glyphs.contains(chr)) {
+	if (_glyphs.contains(chr))
 		return;
+
+	uint32 unicode = chr;
+	if (!_allowLateCaching) {
+		// Only the characters of the fixed map are available
+		if (chr >= 256)
+			return;
+		unicode = _mapping[chr] & 0x7FFFFFFF;
 	}
 
+	// Remember missing characters as well, with an empty glyph
 	Glyph newGlyph;
-	if (cacheGlyph(newGlyph, chr)) {
-		_glyphs[chr] = newGlyph;
+	if (!cacheGlyph(newGlyph, unicode)) {
+		newGlyph.xOffset = newGlyph.yOffset = 0;
+		newGlyph.width = newGlyph.height = 0;
+		newGlyph.advance = 0;
+		newGlyph.slot = 0;
+		newGlyph.page = -1;
 	}
+	_glyphs[chr] = newGlyph;
 }
 
 Font *loadTTFFont(Common::SeekableReadStream &stream, int size, TTFSizeMode sizeMode, uint dpi, TTFRenderMode renderMode, const uint32 *mapping, bool stemDarkening) {
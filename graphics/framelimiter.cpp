@@ -21,46 +21,84 @@
 
 #include "graphics/framelimiter.h"
 
+#include "common/algorithm.h"
 #include "common/util.h"
 
 namespace Graphics {
 
 FrameLimiter::FrameLimiter(OSystem *system, const uint framerate) :
 		_system(system),
-		_speedLimitMs(0),
+		_busyWait(false),
+		_frameInterval(0),
+		_nextFrameDeadline(0),
 		_startFrameTime(0),
-		_lastFrameDurationMs(_speedLimitMs) {
+		_lastFrameDurationMs(0),
+		_frameHistorySize(0),
+		_frameHistoryNext(0),
+		_missedDeadlines(0) {
 	// The frame limiter is disabled when vsync is enabled.
 	_enabled = !_system->getFeatureState(OSystem::kFeatureVSync) && framerate != 0;
 
 	if (_enabled) {
-		_speedLimitMs = 1000 / CLIP<uint>(framerate, 0, 100);
+		_frameInterval = 1000000 / framerate;
+		_lastFrameDurationMs = _frameInterval / 1000;
 	}
 }
 
+uint64 FrameLimiter::getMicros() const {
+	return (uint64)_system->getMillis() * 1000;
+}
+
 void FrameLimiter::startFrame() {
 	uint currentTime = _system->getMillis();
 
 	if (_startFrameTime != 0) {
 		_lastFrameDurationMs = currentTime - _startFrameTime;
+
+		_frameHistory[_frameHistoryNext] = _lastFrameDurationMs * 1000;
+		_frameHistoryNext = (_frameHistoryNext + 1) % kFrameHistorySize;
+		_frameHistorySize = MIN<uint>(_frameHistorySize + 1, kFrameHistorySize);
 	}
 
 	_startFrameTime = currentTime;
 }
 
 void FrameLimiter::delayBeforeSwap() {
-	uint endFrameTime = _system->getMillis();
-	uint frameDuration = endFrameTime - _startFrameTime;
+	if (!_enabled)
+		return;
 
-	if (_enabled && frameDuration < _speedLimitMs) {
-		_system->delayMillis(_speedLimitMs - frameDuration);
+	uint64 currentTime = getMicros();
+	if (_nextFrameDeadline == 0) {
+		const uint64 frameStart = _startFrameTime != 0 ? (uint64)_startFrameTime * 1000 : currentTime;
+		_nextFrameDeadline = frameStart + _frameInterval;
 	}
+
+	if (currentTime < _nextFrameDeadline) {
+		if (_busyWait) {
+			while (getMicros() < _nextFrameDeadline) {
+			}
+		} else {
+			const uint delay = (_nextFrameDeadline - currentTime) / 1000;
+			if (delay > 0)
+				_system->delayMillis(delay);
+		}
+	} else if (currentTime > _nextFrameDeadline) {
+		_missedDeadlines++;
+
+		// Catching up would rush the following frames, so start over
+		// from this one if it is more than a frame late
+		if (currentTime - _nextFrameDeadline > _frameInterval)
+			_nextFrameDeadline = currentTime;
+	}
+
+	_nextFrameDeadline += _frameInterval;
 }
 
 void FrameLimiter::pause(bool pause) {
 	if (!pause) {
 		// Make sure the frame duration value is consistent when resuming
 		_startFrameTime = 0;
+		_nextFrameDeadline = 0;
 	}
 }
 
@@ -68,4 +106,27 @@ uint FrameLimiter::getLastFrameDuration() const {
 	return _lastFrameDurationMs;
 }
 
+FrameLimiter::Statistics FrameLimiter::getStatistics() const {
+	Statistics statistics;
+	statistics.frameCount = _frameHistorySize;
+	statistics.averageFrameTime = 0;
+	statistics.slowFrameTime = 0;
+	statistics.missedDeadlines = _missedDeadlines;
+
+	if (_frameHistorySize == 0)
+		return statistics;
+
+	uint sortedFrames[kFrameHistorySize];
+	uint64 totalTime = 0;
+	for (uint i = 0; i < _frameHistorySize; i++) {
+		sortedFrames[i] = _frameHistory[i];
+		totalTime += _frameHistory[i];
+	}
+	Common::sort(sortedFrames, sortedFrames + _frameHistorySize);
+
+	statistics.averageFrameTime = totalTime / _frameHistorySize;
+	statistics.slowFrameTime = sortedFrames[_frameHistorySize * 95 / 100];
+	return statistics;
+}
+
 } // End of namespace Graphics
@@ -33,9 +33,21 @@ namespace Graphics {
  * by delaying until all of the timeslot allocated to the frame
  * is consumed.
  * Allows to curb CPU usage and have a stable framerate.
+ *
+ * The frames are paced against absolute deadlines, so that a framerate
+ * which does not divide a second into whole milliseconds is still kept
+ * on average.
  */
 class FrameLimiter {
 public:
+	/** Frame pacing statistics */
+	struct Statistics {
+		uint frameCount;       ///< Number of recent frames the frame times are about
+		uint averageFrameTime; ///< Average duration of the recent frames, in microseconds
+		uint slowFrameTime;    ///< 95th percentile of the durations of the recent frames, in microseconds
+		uint missedDeadlines;  ///< Number of frames which ended after their deadline since the limiter was created
+	};
+
 	FrameLimiter(OSystem *system, const uint framerate);
 
 	void startFrame();
@@ -43,14 +55,38 @@ public:
 
 	void pause(bool pause);
 
+	/**
+	 * Poll the clock until the end of the frame instead of sleeping.
+	 *
+	 * This burns CPU time, but avoids oversleeping on systems with coarse
+	 * sleep timers.
+	 */
+	void setBusyWait(bool busyWait) { _busyWait = busyWait; }
+
 	uint getLastFrameDuration() const;
+	Statistics getStatistics() const;
+
 private:
+	enum {
+		/** Number of recent frames kept for the statistics */
+		kFrameHistorySize = 128
+	};
+
+	uint64 getMicros() const;
+
 	OSystem *_system;
 
 	bool _enabled;
-	uint _speedLimitMs;
+	bool _busyWait;
+	uint _frameInterval;       // in microseconds
+	uint64 _nextFrameDeadline; // in microseconds, 0 if not known yet
 	uint _startFrameTime;
 	uint _lastFrameDurationMs;
+
+	uint _frameHistory[kFrameHistorySize]; // in microseconds
+	uint _frameHistorySize;
+	uint _frameHistoryNext;
+	uint _missedDeadlines;
 };
 
 } // End of namespace Graphics
@@ -1043,7 +1043,7 @@ void MacText::setInterLinear(int interLinear) {
 	_contentIsDirty = true;
 }
 
-void MacText::recalcDims() {
+void MacText::recalcDims(bool enforce) {
 	if (_textLines.empty())
 		return;
 
@@ -1055,7 +1055,7 @@ void MacText::recalcDims() {
 
 		// We must calculate width first, because it enforces
 		// the computation. Calling Height() will return cached value!
-		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, true));
+		_textMaxWidth = MAX(_textMaxWidth, getLineWidth(i, enforce));
 		y += MAX(getLineHeight(i), _interLinear);
 	}
 
@@ -1211,7 +1211,7 @@ void MacText::appendText(const Common::U32String &str, const Font *font, uint16
 
 void MacText::appendText_(const Common::U32String &strWithFont, uint oldLen) {
 	splitString(strWithFont);
-	recalcDims();
+	recalcDims(false);
 
 	render(oldLen - 1, _textLines.size());
 
@@ -1237,7 +1237,7 @@ void MacText::appendTextDefault(const Common::U32String &str, bool skipAdd) {
 		_str += strWithFont;
 	}
 	splitString(strWithFont);
-	recalcDims();
+	recalcDims(false);
 
 	render(oldLen - 1, _textLines.size());
 }
@@ -2277,12 +2277,15 @@ void MacText::insertChar(byte c, int *row, int *col) {
 	(*col)++;
 
 	if (getLineWidth(*row) - oldw + chunkw > _maxWidth) { // Needs reshuffle
+		const int start = getParagraphStart(*row);
+		const int end = getParagraphEnd(*row);
+		const int oldBottom = getNextLineY(end);
+		const int oldSize = _textLines.size();
+
 		reshuffleParagraph(row, col);
-		_fullRefresh = true;
-		recalcDims();
-		render();
+		reflowLines(start, end + (int)_textLines.size() - oldSize, oldBottom);
 	} else {
-		recalcDims();
+		recalcDims(false);
 		render(*row, *row);
 	}
 	for (int i = 0; i < (int)_textLines.size(); i++) {
@@ -2311,6 +2314,11 @@ void MacText::deleteSelection() {
 
 	int row = s.endRow, col = s.endCol;
 
+	const int start = getParagraphStart(s.startRow);
+	const int end = getParagraphEnd(s.endRow);
+	const int oldBottom = getNextLineY(end);
+	const int oldSize = _textLines.size();
+
 	while (row != s.startRow || col != s.startCol) {
 		if (row == 0 && col == 0)
 			break;
@@ -2318,10 +2326,7 @@ void MacText::deleteSelection() {
 	}
 
 	reshuffleParagraph(&row, &col);
-
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	reflowLines(start, end + (int)_textLines.size() - oldSize, oldBottom);
 
 	// update cursor position
 	_cursorRow = row;
@@ -2367,6 +2372,13 @@ void MacText::deletePreviousCharInternal(int *row, int *col) {
 void MacText::deletePreviousChar(int *row, int *col) {
 	if (*col == 0 && *row == 0) // nothing to do
 		return;
+
+	// Deleting at the start of a line glues it to the previous one
+	const int start = getParagraphStart(*col == 0 ? *row - 1 : *row);
+	const int end = getParagraphEnd(*row);
+	const int oldBottom = getNextLineY(end);
+	const int oldSize = _textLines.size();
+
 	deletePreviousCharInternal(row, col);
 
 	for (int i = 0; i < (int)_textLines.size(); i++) {
@@ -2378,10 +2390,7 @@ void MacText::deletePreviousChar(int *row, int *col) {
 	D(9, "**deleteChar cursor row %d col %d", _cursorRow, _cursorCol);
 
 	reshuffleParagraph(row, col);
-
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	reflowLines(start, end + (int)_textLines.size() - oldSize, oldBottom);
 }
 
 void MacText::addNewLine(int *row, int *col) {
@@ -2392,6 +2401,11 @@ void MacText::addNewLine(int *row, int *col) {
 		return;
 	}
 
+	const int start = getParagraphStart(*row);
+	const int end = getParagraphEnd(*row);
+	const int oldBottom = getNextLineY(end);
+	const int oldSize = _textLines.size();
+
 	MacTextLine *line = &_textLines[*row];
 	int pos = *col;
 	uint ch = line->getChunkNum(&pos);
@@ -2431,20 +2445,13 @@ void MacText::addNewLine(int *row, int *col) {
 	}
 	D(9, "** addNewLine cursor row %d col %d", _cursorRow, _cursorCol);
 
-	_fullRefresh = true;
-	recalcDims();
-	render();
+	reflowLines(start, end + (int)_textLines.size() - oldSize, oldBottom);
 }
 
 void MacText::reshuffleParagraph(int *row, int *col) {
 	// First, we looking for the paragraph start and end
-	int start = *row, end = *row;
-
-	while (start && !_textLines[start - 1].paragraphEnd)
-		start--;
-
-	while (end < (int)_textLines.size() - 1 && !_textLines[end].paragraphEnd) // stop at last line
-		end++;
+	int start = getParagraphStart(*row);
+	int end = getParagraphEnd(*row);
 
 	// Get character pos within paragraph
 	int ppos = 0;
@@ -2476,6 +2483,78 @@ void MacText::reshuffleParagraph(int *row, int *col) {
 	*col = ppos;
 }
 
+int MacText::getParagraphStart(int row) {
+	while (row > 0 && !_textLines[row - 1].paragraphEnd)
+		row--;
+
+	return row;
+}
+
+int MacText::getParagraphEnd(int row) {
+	while (row < (int)_textLines.size() - 1 && !_textLines[row].paragraphEnd) // stop at last line
+		row++;
+
+	return row;
+}
+
+int MacText::getNextLineY(int line) {
+	if (line + 1 < (int)_textLines.size())
+		return _textLines[line + 1].y;
+
+	return _textMaxHeight;
+}
+
+static void moveLines(ManagedSurface *surface, int from, int to, int height) {
+	if (height <= 0 || from == to)
+		return;
+
+	// The areas may overlap, so go through a copy
+	ManagedSurface tmp(surface->w, height, surface->format);
+	tmp.blitFrom(*surface, Common::Rect(0, from, surface->w, from + height), Common::Point(0, 0));
+	surface->blitFrom(tmp, Common::Point(0, to));
+}
+
+void MacText::reflowLines(int start, int end, int oldBottom) {
+	const int oldHeight = _textMaxHeight;
+
+	recalcDims(false);
+
+	// Growing the widget requires rendering everything anyway
+	if (_fullRefresh) {
+		render();
+		return;
+	}
+
+	if (_textLines.empty())
+		return;
+
+	reallocSurface();
+
+	end = CLIP<int>(end, start, _textLines.size() - 1);
+	const int newBottom = getNextLineY(end);
+
+	// Only the edited lines are rendered again, the ones after them keep
+	// their rendering and move up or down by the change in height
+	if (newBottom != oldBottom) {
+		moveLines(_surface, oldBottom, newBottom, oldHeight - oldBottom);
+		if (_textShadow)
+			moveLines(_shadowSurface, oldBottom, newBottom, oldHeight - oldBottom);
+
+		if (_textMaxHeight < oldHeight) {
+			_surface->fillRect(Common::Rect(0, _textMaxHeight, _surface->w, oldHeight), _bgcolor);
+			if (_textShadow)
+				_shadowSurface->fillRect(Common::Rect(0, _textMaxHeight, _shadowSurface->w, oldHeight), _bgcolor);
+		}
+	}
+
+	const Common::Rect area(0, _textLines[start].y, _surface->w, newBottom);
+	_surface->fillRect(area, _bgcolor);
+	if (_textShadow)
+		_shadowSurface->fillRect(area, _bgcolor);
+
+	render(start, end);
+}
+
 //////////////////
 // Cursor stuff
 static void cursorTimerHandler(void *refCon) {
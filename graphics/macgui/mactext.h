@@ -298,11 +298,32 @@ private:
 	 */
 	void reshuffleParagraph(int *row, int *col);
 
+	int getParagraphStart(int row);
+	int getParagraphEnd(int row);
+
+	/** Returns the y position of the line after the given one, or the text height after the last line. */
+	int getNextLineY(int line);
+
+	/**
+	 * Updates the layout and the rendered text after lines from start
+	 * to end were edited. The lines after them, which were rendered at
+	 * oldBottom before, are moved on the surface instead of rendering
+	 * them again.
+	 */
+	void reflowLines(int start, int end, int oldBottom);
+
 	void chopChunk(const Common::U32String &str, int *curLine);
 	void splitString(const Common::U32String &str, int curLine = -1);
 	void render(int from, int to, int shadow);
 	void render(int from, int to);
-	void recalcDims();
+	/**
+	 * Recomputes the line positions and the text dimensions.
+	 *
+	 * @param enforce Measure all lines again. Otherwise only the lines whose
+	 *                cached width was flushed are measured, which is enough
+	 *                after editing the text.
+	 */
+	void recalcDims(bool enforce = true);
 	void reallocSurface();
 
 	void scroll(int delta);
@@ -40,6 +40,7 @@ public:
 	virtual bool draw(ManagedSurface *g, bool forceRedraw = false);
 	virtual bool draw(bool forceRedraw = false);
 	virtual void blit(ManagedSurface *g, Common::Rect &dest);
+	virtual bool isDirty() { return MacWindow::isDirty() || _cursorDirty || _inputIsDirty; }
 
 	void setTextWindowFont(const MacFont *macFont);
 	const MacFont *getTextWindowFont();
@@ -69,13 +69,21 @@ MacWindow::MacWindow(int id, bool scrollable, bool resizable, bool editable, Mac
 
 	_macBorder.setWindow(this);
 
+	for (int i = 0; i < kWindowBorderMaxFlag; i++)
+		_borderCache[i] = nullptr;
+
 	_hasScrollBar = false;
 
 	_mode = 0;
 }
 
+MacWindow::~MacWindow() {
+	clearBorderCache();
+}
+
 void MacWindow::disableBorder() {
 	_macBorder.disableBorder();
+	clearBorderCache();
 }
 
 const Font *MacWindow::getTitleFont() {
@@ -112,6 +120,7 @@ void MacWindow::resize(int w, int h, bool inner) {
 
 	_borderSurface.free();
 	_borderSurface.create(_dims.width(), _dims.height(), _wm->_pixelformat);
+	clearBorderCache();
 
 	_contentIsDirty = true;
 	_borderIsDirty = true;
@@ -260,17 +269,39 @@ void MacWindow::drawBorder() {
 }
 
 void MacWindow::drawBorderFromSurface(ManagedSurface *g, uint32 flags) {
+	// The scrollbar depends on the scroll position, so it is never cached
+	ManagedSurface *cached = (flags & kWindowBorderScrollbar) ? nullptr : _borderCache[flags];
+	if (cached && cached->w == g->w && cached->h == g->h) {
+		g->blitFrom(*cached);
+		return;
+	}
+
 	if (_wm->_pixelformat.bytesPerPixel == 1) {
 		g->clear(_wm->_colorGreen);
 	}
 
 	_macBorder.blitBorderInto(*g, flags, _wm);
+
+	if (flags & kWindowBorderScrollbar)
+		return;
+
+	if (!cached)
+		cached = _borderCache[flags] = new ManagedSurface();
+	cached->copyFrom(*g);
+}
+
+void MacWindow::clearBorderCache() {
+	for (int i = 0; i < kWindowBorderMaxFlag; i++) {
+		delete _borderCache[i];
+		_borderCache[i] = nullptr;
+	}
 }
 
 void MacWindow::setTitle(const Common::String &title) {
 	_title = title;
 	_borderIsDirty = true;
 	_macBorder.setTitle(title, _borderSurface.w, _wm);
+	clearBorderCache();
 }
 
 void MacWindow::drawPattern() {
@@ -309,20 +340,24 @@ void MacWindow::setScroll(float scrollPos, float scrollSize) {
 
 void MacWindow::loadBorder(Common::SeekableReadStream &file, uint32 flags, int lo, int ro, int to, int bo) {
 	_macBorder.loadBorder(file, flags, lo, ro, to, bo);
+	clearBorderCache();
 }
 
 void MacWindow::loadBorder(Common::SeekableReadStream &file, uint32 flags, BorderOffsets offsets) {
 	_macBorder.loadBorder(file, flags, offsets);
+	clearBorderCache();
 }
 
 void MacWindow::setBorder(Graphics::TransparentSurface *surface, uint32 flags, BorderOffsets offsets) {
 	_macBorder.setBorder(surface, flags, offsets);
+	clearBorderCache();
 }
 
 void MacWindow::resizeBorderSurface() {
 	updateOuterDims();
 	_borderSurface.free();
 	_borderSurface.create(_dims.width(), _dims.height(), _wm->_pixelformat);
+	clearBorderCache();
 }
 
 void MacWindow::setCloseable(bool closeable) {
@@ -526,6 +561,7 @@ void MacWindow::setBorderType(int borderType) {
 	} else {
 		_macBorder.setBorderType(borderType);
 	}
+	clearBorderCache();
 }
 
 void MacWindow::loadWin95Border(const Common::String &filename, uint32 flags) {
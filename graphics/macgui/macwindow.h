@@ -202,7 +202,7 @@ public:
 	 * @param wm See BaseMacWindow.
 	 */
 	MacWindow(int id, bool scrollable, bool resizable, bool editable, MacWindowManager *wm);
-	virtual ~MacWindow() {}
+	virtual ~MacWindow();
 
 	/**
 	 * Change the window's location to fixed coordinates (not delta).
@@ -345,13 +345,14 @@ public:
 
 	bool isDirty() override { return _borderIsDirty || _contentIsDirty; }
 
-	void setBorderDirty(bool dirty) { _borderIsDirty = true; }
+	void setBorderDirty(bool dirty) { _borderIsDirty = true; clearBorderCache(); }
 	void resizeBorderSurface();
 
 	void setMode(uint32 mode) { _mode = mode; }
 
 private:
 	void drawBorderFromSurface(ManagedSurface *g, uint32 flags);
+	void clearBorderCache();
 	void drawPattern();
 	void drawBox(ManagedSurface *g, int x, int y, int w, int h);
 	void fillRect(ManagedSurface *g, int x, int y, int w, int h, int color);
@@ -381,6 +382,11 @@ protected:
 private:
 	MacWindowBorder _macBorder;
 
+	// Borders already rendered at the current size, indexed by border flags.
+	// Windows toggling between active and inactive reuse them instead of
+	// scaling the nine-patch and drawing the title again.
+	ManagedSurface *_borderCache[kWindowBorderMaxFlag];
+
 	int _pattern;
 	bool _hasPattern;
 
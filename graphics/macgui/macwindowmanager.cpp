@@ -925,6 +925,20 @@ void MacWindowManager::draw() {
 			}
 		}
 
+		// A clean window which is only damaged by the windows below it does
+		// not need to be redrawn. Its surfaces are still valid, so composite
+		// them again over the damaged parts only.
+		if (_screen && forceRedraw && !_fullRefresh && !w->isDirty() && w->getBorderSurface()) {
+			uint count = dirtyRects.size();
+			for (uint i = 0; i < count; i++) {
+				Common::Rect damage = dirtyRects[i];
+				damage.clip(clip);
+				if (!damage.isEmpty())
+					compositeWindow(w, damage);
+			}
+			continue;
+		}
+
 		if (!_screen) {
 			if (w->isDirty() || forceRedraw) {
 				w->draw(forceRedraw);
@@ -967,13 +981,28 @@ void MacWindowManager::draw() {
 				delete _screenCopyPauseToken;
 				_screenCopyPauseToken = nullptr;
 			}
-		} else if (w->draw(_screen, forceRedraw)) {
+		} else if (w->draw(_screen, forceRedraw && w->isDirty())) {
 			w->setDirty(false);
-			g_system->copyRectToScreen(_screen->getBasePtr(clip.left, clip.top), _screen->pitch, clip.left, clip.top, clip.width(), clip.height());
 			dirtyRects.push_back(clip);
 		}
 	}
 
+	// Every damaged region is copied to the screen once, after all the
+	// windows on top of it have been composited
+	if (_screen) {
+		for (uint i = 0; i < dirtyRects.size(); i++) {
+			const Common::Rect &r = dirtyRects[i];
+
+			bool covered = false;
+			for (uint j = 0; j < dirtyRects.size() && !covered; j++)
+				covered = j != i && dirtyRects[j].contains(r) && (r != dirtyRects[j] || j < i);
+			if (covered)
+				continue;
+
+			g_system->copyRectToScreen(_screen->getBasePtr(r.left, r.top), _screen->pitch, r.left, r.top, r.width(), r.height());
+		}
+	}
+
 	// Menu is drawn on top of everything and always
 	if (_menu && !(_mode & kWMModeFullscreen)) {
 		if (_fullRefresh)
@@ -994,6 +1023,29 @@ void MacWindowManager::draw() {
 	_fullRefresh = false;
 }
 
+void MacWindowManager::compositeWindow(BaseMacWindow *w, const Common::Rect &damage) {
+	const Common::Rect &innerDims = w->getInnerDimensions();
+	Common::Rect r = damage;
+	r.clip(innerDims);
+
+	if (!r.isEmpty()) {
+		Common::Rect src(r);
+		src.translate(-innerDims.left, -innerDims.top);
+		_screen->blitFrom(*w->getWindowSurface(), src, Common::Point(r.left, r.top));
+	}
+
+	const Common::Rect &outerDims = w->getDimensions();
+	r = damage;
+	r.clip(outerDims);
+
+	if (!r.isEmpty()) {
+		Common::Rect src(r);
+		src.translate(-outerDims.left, -outerDims.top);
+		uint32 transcolor = (_pixelformat.bytesPerPixel == 1) ? _colorGreen : 0;
+		_screen->transBlitFrom(*w->getBorderSurface(), src, Common::Point(r.left, r.top), transcolor);
+	}
+}
+
 static void menuTimerHandler(void *refCon) {
 	MacWindowManager *wm = (MacWindowManager *)refCon;
 
@@ -403,6 +403,7 @@ private:
 	bool haveZoomBox() { return !_zoomBoxes.empty(); }
 
 	void adjustDimensions(const Common::Rect &clip, const Common::Rect &dims, int &adjWidth, int &adjHeight);
+	void compositeWindow(BaseMacWindow *w, const Common::Rect &damage);
 
 public:
 	TransparentSurface *_desktopBmp;
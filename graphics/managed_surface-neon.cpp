@@ -0,0 +1,106 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/managed_surface_intern.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+static void transRow8NEON(byte *dst, const byte *src, uint w, byte transColor) {
+	const uint8x16_t key = vdupq_n_u8(transColor);
+	const uint blocks = w / 16;
+
+	for (uint i = 0; i < blocks; i++) {
+		const uint8x16_t s = vld1q_u8(src);
+		const uint8x16_t d = vld1q_u8(dst);
+		vst1q_u8(dst, vbslq_u8(vceqq_u8(s, key), d, s));
+
+		src += 16;
+		dst += 16;
+	}
+
+	getScalarTransBlitKernels().transRow8(dst, src, w % 16, transColor);
+}
+
+static void transRow16NEON(uint16 *dst, const uint16 *src, uint w, uint16 transColor, uint16 colorMask) {
+	const uint16x8_t key = vdupq_n_u16(transColor);
+	const uint16x8_t mask = vdupq_n_u16(colorMask);
+	const uint blocks = w / 8;
+
+	for (uint i = 0; i < blocks; i++) {
+		const uint16x8_t s = vld1q_u16(src);
+		const uint16x8_t d = vld1q_u16(dst);
+		vst1q_u16(dst, vbslq_u16(vceqq_u16(s, key), d, vandq_u16(s, mask)));
+
+		src += 8;
+		dst += 8;
+	}
+
+	getScalarTransBlitKernels().transRow16(dst, src, w % 8, transColor, colorMask);
+}
+
+static void transRow32NEON(uint32 *dst, const uint32 *src, uint w, uint32 transColor, uint32 colorMask) {
+	const uint32x4_t key = vdupq_n_u32(transColor);
+	const uint32x4_t mask = vdupq_n_u32(colorMask);
+	const uint blocks = w / 4;
+
+	for (uint i = 0; i < blocks; i++) {
+		const uint32x4_t s = vld1q_u32(src);
+		const uint32x4_t d = vld1q_u32(dst);
+		vst1q_u32(dst, vbslq_u32(vceqq_u32(s, key), d, vandq_u32(s, mask)));
+
+		src += 4;
+		dst += 4;
+	}
+
+	getScalarTransBlitKernels().transRow32(dst, src, w % 4, transColor, colorMask);
+}
+
+static void maskRow8NEON(byte *dst, const byte *src, const byte *mask, uint w, byte maskColor) {
+	const uint8x16_t key = vdupq_n_u8(maskColor);
+	const uint blocks = w / 16;
+
+	for (uint i = 0; i < blocks; i++) {
+		const uint8x16_t m = vld1q_u8(mask);
+		const uint8x16_t s = vld1q_u8(src);
+		const uint8x16_t d = vld1q_u8(dst);
+		vst1q_u8(dst, vbslq_u8(vceqq_u8(m, key), d, s));
+
+		mask += 16;
+		src += 16;
+		dst += 16;
+	}
+
+	getScalarTransBlitKernels().maskRow8(dst, src, mask, w % 16, maskColor);
+}
+
+const TransBlitKernels &getNEONTransBlitKernels() {
+	static const TransBlitKernels kernels = {
+		transRow8NEON,
+		transRow16NEON,
+		transRow32NEON,
+		maskRow8NEON
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,111 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/managed_surface_intern.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+/** Keep the destination where the mask is set, and take the source elsewhere. */
+static inline __m128i select(__m128i mask, __m128i dst, __m128i src) {
+	return _mm_or_si128(_mm_and_si128(mask, dst), _mm_andnot_si128(mask, src));
+}
+
+static void transRow8SSE2(byte *dst, const byte *src, uint w, byte transColor) {
+	const __m128i key = _mm_set1_epi8((char)transColor);
+	const uint blocks = w / 16;
+
+	for (uint i = 0; i < blocks; i++) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+		const __m128i d = _mm_loadu_si128((const __m128i *)dst);
+		_mm_storeu_si128((__m128i *)dst, select(_mm_cmpeq_epi8(s, key), d, s));
+
+		src += 16;
+		dst += 16;
+	}
+
+	getScalarTransBlitKernels().transRow8(dst, src, w % 16, transColor);
+}
+
+static void transRow16SSE2(uint16 *dst, const uint16 *src, uint w, uint16 transColor, uint16 colorMask) {
+	const __m128i key = _mm_set1_epi16((short)transColor);
+	const __m128i mask = _mm_set1_epi16((short)colorMask);
+	const uint blocks = w / 8;
+
+	for (uint i = 0; i < blocks; i++) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+		const __m128i d = _mm_loadu_si128((const __m128i *)dst);
+		_mm_storeu_si128((__m128i *)dst, select(_mm_cmpeq_epi16(s, key), d, _mm_and_si128(s, mask)));
+
+		src += 8;
+		dst += 8;
+	}
+
+	getScalarTransBlitKernels().transRow16(dst, src, w % 8, transColor, colorMask);
+}
+
+static void transRow32SSE2(uint32 *dst, const uint32 *src, uint w, uint32 transColor, uint32 colorMask) {
+	const __m128i key = _mm_set1_epi32((int)transColor);
+	const __m128i mask = _mm_set1_epi32((int)colorMask);
+	const uint blocks = w / 4;
+
+	for (uint i = 0; i < blocks; i++) {
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+		const __m128i d = _mm_loadu_si128((const __m128i *)dst);
+		_mm_storeu_si128((__m128i *)dst, select(_mm_cmpeq_epi32(s, key), d, _mm_and_si128(s, mask)));
+
+		src += 4;
+		dst += 4;
+	}
+
+	getScalarTransBlitKernels().transRow32(dst, src, w % 4, transColor, colorMask);
+}
+
+static void maskRow8SSE2(byte *dst, const byte *src, const byte *mask, uint w, byte maskColor) {
+	const __m128i key = _mm_set1_epi8((char)maskColor);
+	const uint blocks = w / 16;
+
+	for (uint i = 0; i < blocks; i++) {
+		const __m128i m = _mm_loadu_si128((const __m128i *)mask);
+		const __m128i s = _mm_loadu_si128((const __m128i *)src);
+		const __m128i d = _mm_loadu_si128((const __m128i *)dst);
+		_mm_storeu_si128((__m128i *)dst, select(_mm_cmpeq_epi8(m, key), d, s));
+
+		mask += 16;
+		src += 16;
+		dst += 16;
+	}
+
+	getScalarTransBlitKernels().maskRow8(dst, src, mask, w % 16, maskColor);
+}
+
+const TransBlitKernels &getSSE2TransBlitKernels() {
+	static const TransBlitKernels kernels = {
+		transRow8SSE2,
+		transRow16SSE2,
+		transRow32SSE2,
+		maskRow8SSE2
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
@@ -20,7 +20,9 @@
  */
 
 #include "graphics/managed_surface.h"
+#include "graphics/managed_surface_intern.h"
 #include "common/algorithm.h"
+#include "common/cpu.h"
 #include "common/textconsole.h"
 #include "common/endian.h"
 
@@ -324,6 +326,37 @@ void ManagedSurface::blitFromInner(const Surface &src, const Common::Rect &srcRe
 	}
 
 	const bool noScale = scaleX == SCALE_THRESHOLD && scaleY == SCALE_THRESHOLD;
+
+	// Without alpha, pixels of the same format are copied unchanged, apart
+	// from the bits which are not part of the format
+	if (noScale && format == src.format && format.aBits() == 0 &&
+			(format.bytesPerPixel == 2 || format.bytesPerPixel == 4)) {
+		const uint32 colorMask = format.ARGBToColor(0xff, 0xff, 0xff, 0xff);
+		const bool allBits = format.bytesPerPixel == 2 ? colorMask == 0xffff : colorMask == 0xffffffff;
+		const int left = MAX<int>(destRect.left, 0);
+		const int right = MIN<int>(destRect.right, w);
+		const int top = MAX<int>(destRect.top, 0);
+		const int bottom = MIN<int>(destRect.bottom, h);
+
+		for (int destY = top; destY < bottom && left < right; ++destY) {
+			const byte *srcP = (const byte *)src.getBasePtr(srcRect.left + left - destRect.left, srcRect.top + destY - destRect.top);
+			byte *destP = (byte *)getBasePtr(left, destY);
+
+			if (allBits) {
+				memcpy(destP, srcP, (right - left) * format.bytesPerPixel);
+			} else if (format.bytesPerPixel == 2) {
+				for (int x = 0; x < right - left; ++x)
+					((uint16 *)destP)[x] = ((const uint16 *)srcP)[x] & colorMask;
+			} else {
+				for (int x = 0; x < right - left; ++x)
+					((uint32 *)destP)[x] = ((const uint32 *)srcP)[x] & colorMask;
+			}
+		}
+
+		addDirtyRect(Common::Rect(0, 0, this->w, this->h));
+		return;
+	}
+
 	for (int destY = destRect.top, scaleYCtr = 0; destY < destRect.bottom; ++destY, scaleYCtr += scaleY) {
 		if (destY < 0 || destY >= h)
 			continue;
@@ -531,6 +564,69 @@ static byte *createPaletteLookup(const uint32 *srcPalette, const uint32 *dstPale
 	return lookup;
 }
 
+static void transRow8Scalar(byte *dst, const byte *src, uint w, byte transColor) {
+	for (uint x = 0; x < w; ++x) {
+		if (src[x] != transColor)
+			dst[x] = src[x];
+	}
+}
+
+static void transRow16Scalar(uint16 *dst, const uint16 *src, uint w, uint16 transColor, uint16 colorMask) {
+	for (uint x = 0; x < w; ++x) {
+		if (src[x] != transColor)
+			dst[x] = src[x] & colorMask;
+	}
+}
+
+static void transRow32Scalar(uint32 *dst, const uint32 *src, uint w, uint32 transColor, uint32 colorMask) {
+	for (uint x = 0; x < w; ++x) {
+		if (src[x] != transColor)
+			dst[x] = src[x] & colorMask;
+	}
+}
+
+static void maskRow8Scalar(byte *dst, const byte *src, const byte *mask, uint w, byte maskColor) {
+	for (uint x = 0; x < w; ++x) {
+		if (mask[x] != maskColor)
+			dst[x] = src[x];
+	}
+}
+
+const TransBlitKernels &getScalarTransBlitKernels() {
+	static const TransBlitKernels kernels = {
+		transRow8Scalar,
+		transRow16Scalar,
+		transRow32Scalar,
+		maskRow8Scalar
+	};
+	return kernels;
+}
+
+const TransBlitKernels &getTransBlitKernels() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return getSSE2TransBlitKernels();
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return getNEONTransBlitKernels();
+#endif
+
+	return getScalarTransBlitKernels();
+}
+
+static inline void transBlitRow(byte *dst, const byte *src, uint w, byte transColor, uint32 colorMask) {
+	getTransBlitKernels().transRow8(dst, src, w, transColor);
+}
+
+static inline void transBlitRow(uint16 *dst, const uint16 *src, uint w, uint16 transColor, uint32 colorMask) {
+	getTransBlitKernels().transRow16(dst, src, w, transColor, colorMask);
+}
+
+static inline void transBlitRow(uint32 *dst, const uint32 *src, uint w, uint32 transColor, uint32 colorMask) {
+	getTransBlitKernels().transRow32(dst, src, w, transColor, colorMask);
+}
+
 template<typename TSRC, typename TDEST>
 void transBlitPixel(TSRC srcVal, TDEST &destVal, const Graphics::PixelFormat &srcFormat, const Graphics::PixelFormat &destFormat,
 		uint overrideColor, uint srcAlpha, const uint32 *srcPalette, const byte *lookup) {
@@ -601,6 +697,25 @@ void transBlit(const Surface &src, const Common::Rect &srcRect, ManagedSurface &
 	byte rst = 0, gst = 0, bst = 0, rdt = 0, gdt = 0, bdt = 0;
 	byte r = 0, g = 0, b = 0;
 
+	// Without scaling, alpha or any color changes, the pixels of the same
+	// format are copied unchanged, apart from the transparent ones
+	if (scaleX == SCALE_THRESHOLD && scaleY == SCALE_THRESHOLD && src.format == dest.format &&
+			src.format.aBits() == 0 && !flipped && !mask && !maskOnly && overrideColor == 0 &&
+			srcAlpha == 0xff && !(srcPalette && dstPalette)) {
+		const uint32 colorMask = dest.format.ARGBToColor(0xff, 0xff, 0xff, 0xff);
+		const int left = MAX<int>(destRect.left, 0);
+		const int right = MIN<int>(destRect.right, dest.w);
+		const int top = MAX<int>(destRect.top, 0);
+		const int bottom = MIN<int>(destRect.bottom, dest.h);
+
+		for (int destY = top; destY < bottom && left < right; ++destY) {
+			const TSRC *srcLine = (const TSRC *)src.getBasePtr(srcRect.left + left - destRect.left, srcRect.top + destY - destRect.top);
+			TSRC *destLine = (TSRC *)dest.getBasePtr(left, destY);
+			transBlitRow(destLine, srcLine, right - left, transColor, colorMask);
+		}
+		return;
+	}
+
 	byte *lookup = nullptr;
 	if (srcPalette && dstPalette)
 		lookup = createPaletteLookup(srcPalette, dstPalette);
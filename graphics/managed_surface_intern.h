@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_MANAGED_SURFACE_INTERN_H
+#define GRAPHICS_MANAGED_SURFACE_INTERN_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+
+/**
+ * Optimized row routines used by ManagedSurface::transBlitFrom() for
+ * unscaled blits between surfaces of the same pixel format.
+ *
+ * Each routine copies a row of pixels, except those equal to the
+ * transparent color. The copied pixels are ANDed with colorMask, which
+ * clears the bits that are not part of the pixel format. maskRow8 instead
+ * copies the pixels for which a separate mask row is not maskColor, as
+ * used by Graphics::maskBlit(). All implementations produce the same
+ * output.
+ */
+struct TransBlitKernels {
+	void (*transRow8)(byte *dst, const byte *src, uint w, byte transColor);
+	void (*transRow16)(uint16 *dst, const uint16 *src, uint w, uint16 transColor, uint16 colorMask);
+	void (*transRow32)(uint32 *dst, const uint32 *src, uint w, uint32 transColor, uint32 colorMask);
+	void (*maskRow8)(byte *dst, const byte *src, const byte *mask, uint w, byte maskColor);
+};
+
+/**
+ * Return the fastest row routines supported by the host CPU.
+ */
+const TransBlitKernels &getTransBlitKernels();
+
+/**
+ * Return the portable C++ row routines.
+ */
+const TransBlitKernels &getScalarTransBlitKernels();
+
+#ifdef SCUMMVM_SSE2
+const TransBlitKernels &getSSE2TransBlitKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const TransBlitKernels &getNEONTransBlitKernels();
+#endif
+
+} // End of namespace Graphics
+
+#endif
@@ -51,6 +51,27 @@ MODULE_OBJS := \
 	wincursor.o \
 	yuv_to_rgb.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	conversion-sse2.o \
+	managed_surface-sse2.o \
+	transparent_surface-sse2.o \
+	yuv_to_rgb-sse2.o
+
+$(MODULE)/conversion-sse2.o: CXXFLAGS += -msse2
+$(MODULE)/managed_surface-sse2.o: CXXFLAGS += -msse2
+$(MODULE)/transparent_surface-sse2.o: CXXFLAGS += -msse2
+$(MODULE)/yuv_to_rgb-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	conversion-neon.o \
+	managed_surface-neon.o \
+	transparent_surface-neon.o \
+	yuv_to_rgb-neon.o
+endif
+
 ifdef USE_TINYGL
 MODULE_OBJS += \
 	tinygl/api.o \
@@ -74,9 +95,22 @@ MODULE_OBJS += \
 	tinygl/zbuffer.o \
 	tinygl/zline.o \
 	tinygl/zmath.o \
+	tinygl/zspan.o \
 	tinygl/ztriangle.o \
 	tinygl/zblit.o \
 	tinygl/zdirtyrect.o
+
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	tinygl/zspan-sse2.o
+
+$(MODULE)/tinygl/zspan-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	tinygl/zspan-neon.o
+endif
 endif
 
 ifdef USE_ASPECT
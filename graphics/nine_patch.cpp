@@ -164,6 +164,17 @@ void NinePatchSide::calcOffsets(int len, int titleIndex, int titleWidth) {
 	}
 }
 
+bool NinePatchSide::isContiguous(int &len) const {
+	len = 0;
+	for (uint i = 0; i < _m.size(); ++i) {
+		if (_m[i]->dest_offset != len || _m[i]->dest_length < 0)
+			return false;
+		len += _m[i]->dest_length;
+	}
+
+	return true;
+}
+
 int NinePatchBitmap::getTitleOffset() {
 	if (_titleIndex == 0)
 		return 0;
@@ -185,6 +196,8 @@ NinePatchBitmap::NinePatchBitmap(Graphics::TransparentSurface *bmp, bool owns_bi
 	_titleIndex = 0;
 	_titleWidth = 0;
 	_titlePos = titlePos;
+	_composed = nullptr;
+	_composedValid = false;
 
 	if (_width <= 0 || _height <= 0)
 		goto bad_bitmap;
@@ -247,6 +260,59 @@ void NinePatchBitmap::modifyTitleWidth(int titleWidth) {
 	if (_titlePos == 0) return;
 	_titleWidth = titleWidth;
 	_h.calcOffsets(_cached_dw, _titleIndex, _titleWidth);
+	_composedValid = false;
+}
+
+void NinePatchBitmap::calcOffsets(int dw, int dh, bool withTitle) {
+	/* only recalculate the offsets if they have changed since the last draw */
+	if (_cached_dw == dw && _cached_dh == dh)
+		return;
+
+	if (withTitle)
+		_h.calcOffsets(dw, _titleIndex, _titleWidth);
+	else
+		_h.calcOffsets(dw);
+	_v.calcOffsets(dh);
+
+	_cached_dw = dw;
+	_cached_dh = dh;
+	_composedValid = false;
+}
+
+bool NinePatchBitmap::compose() {
+	if (_composedValid)
+		return true;
+
+	// The regions can only be drawn at once if each pixel of the
+	// destination belongs to exactly one of them
+	int w, h;
+	if (!_h.isContiguous(w) || !_v.isContiguous(h) || w == 0 || h == 0)
+		return false;
+
+	if (!_composed)
+		_composed = new TransparentSurface();
+	_composed->create(w, h, _bmp->format);
+	_composed->setAlphaMode(_bmp->getAlphaMode());
+
+	/* scale each region with the same mapping as TransparentSurface::blit() */
+	for (uint i = 0; i < _v._m.size(); ++i) {
+		const NinePatchMark *v = _v._m[i];
+
+		for (int y = 0; y < v->dest_length; ++y) {
+			const uint32 *src = (const uint32 *)_bmp->getBasePtr(0, v->offset + y * v->length / v->dest_length);
+			uint32 *dst = (uint32 *)_composed->getBasePtr(0, v->dest_offset + y);
+
+			for (uint j = 0; j < _h._m.size(); ++j) {
+				const NinePatchMark *m = _h._m[j];
+
+				for (int x = 0; x < m->dest_length; ++x)
+					dst[m->dest_offset + x] = src[m->offset + x * m->length / m->dest_length];
+			}
+		}
+	}
+
+	_composedValid = true;
+	return true;
 }
 
 void NinePatchBitmap::blit(Graphics::Surface &target, int dx, int dy, int dw, int dh, byte *palette, int numColors, MacWindowManager *wm, uint32 transColor) {
@@ -264,14 +330,7 @@ void NinePatchBitmap::blit(Graphics::Surface &target, int dx, int dy, int dw, in
 		return;
 	}
 
-	/* only recalculate the offsets if they have changed since the last draw */
-	if (_cached_dw != dw || _cached_dh != dh) {
-		_h.calcOffsets(dw, _titleIndex, _titleWidth);
-		_v.calcOffsets(dh);
-
-		_cached_dw = dw;
-		_cached_dh = dh;
-	}
+	calcOffsets(dw, dh, true);
 
 	/* Handle CLUT8 */
 	if (target.format.bytesPerPixel == 1) {
@@ -321,6 +380,11 @@ void NinePatchBitmap::blit(Graphics::Surface &target, int dx, int dy, int dw, in
 }
 
 NinePatchBitmap::~NinePatchBitmap() {
+	if (_composed) {
+		_composed->free();
+		delete _composed;
+	}
+
 	if (_destroy_bmp) {
 		_bmp->free();
 		delete _bmp;
@@ -328,6 +392,12 @@ NinePatchBitmap::~NinePatchBitmap() {
 }
 
 void NinePatchBitmap::drawRegions(Graphics::Surface &target, int dx, int dy, int dw, int dh) {
+	/* draw the scaled regions at once when possible */
+	if (compose()) {
+		_composed->blit(target, dx, dy, Graphics::FLIP_NONE, nullptr, TS_ARGB((uint)255, (uint)255, (uint)255, (uint)255));
+		return;
+	}
+
 	/* draw each region */
 	for (uint i = 0; i < _v._m.size(); ++i) {
 		for (uint j = 0; j < _h._m.size(); ++j) {
@@ -354,13 +424,16 @@ void NinePatchBitmap::blitClip(Graphics::Surface &target, Common::Rect clip, int
 		return;
 	}
 
-	/* only recalculate the offsets if they have changed since the last draw */
-	if (_cached_dw != dw || _cached_dh != dh) {
-		_h.calcOffsets(dw);
-		_v.calcOffsets(dh);
+	calcOffsets(dw, dh, false);
 
-		_cached_dw = dw;
-		_cached_dh = dh;
+	drawRegionsClip(target, clip, dx, dy);
+}
+
+void NinePatchBitmap::drawRegionsClip(Graphics::Surface &target, Common::Rect clip, int dx, int dy) {
+	/* draw the scaled regions at once when possible */
+	if (compose()) {
+		_composed->blitClip(target, clip, dx, dy, Graphics::FLIP_NONE, nullptr, TS_ARGB((uint)255, (uint)255, (uint)255, (uint)255));
+		return;
 	}
 
 	/* draw each region */
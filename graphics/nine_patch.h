@@ -74,6 +74,10 @@ public:
 	bool init(Graphics::TransparentSurface *bmp, bool vertical, int titlePos = 0, int *titleIndex = nullptr);
 
 	void calcOffsets(int len, int titleIndex = 0, int titleWidth = 0);
+
+	// Returns true if the destination segments follow each other without
+	// gaps or overlaps, and sets len to their total length
+	bool isContiguous(int &len) const;
 };
 
 class NinePatchBitmap {
@@ -86,6 +90,10 @@ class NinePatchBitmap {
 	int _titleIndex, _titleWidth, _titlePos;
 	Common::HashMap<uint32, int> _cached_colors;
 
+	// The regions scaled to the size of the last draw, see compose()
+	Graphics::TransparentSurface *_composed;
+	bool _composedValid;
+
 public:
 	NinePatchBitmap(Graphics::TransparentSurface *bmp, bool owns_bitmap, int titlePos = 0);
 	~NinePatchBitmap();
@@ -107,6 +115,9 @@ public:
 private:
 
 	void drawRegions(Graphics::Surface &target, int dx, int dy, int dw, int dh);
+	void drawRegionsClip(Graphics::Surface &target, Common::Rect clip, int dx, int dy);
+	void calcOffsets(int dw, int dh, bool withTitle);
+	bool compose();
 
 	// Assumes color is in the palette
 	byte getColorIndex(uint32 target, byte *palette);
@@ -30,6 +30,10 @@
 
 #if defined(USE_OPENGL_GAME) || defined(USE_OPENGL_SHADERS)
 
+#ifndef GL_NUM_PROGRAM_BINARY_FORMATS
+#define GL_NUM_PROGRAM_BINARY_FORMATS 0x87FE
+#endif
+
 #ifdef USE_GLAD
 
 #ifdef SDL_BACKEND
@@ -82,6 +86,9 @@ void ContextGL::reset() {
 	framebufferObjectMultisampleSupported = false;
 	OESDepth24 = false;
 	multisampleMaxSamples = -1;
+	programBinarySupported = false;
+	getProgramBinaryProc = nullptr;
+	programBinaryProc = nullptr;
 }
 
 void ContextGL::initialize(ContextOGLType contextType) {
@@ -120,6 +127,7 @@ void ContextGL::initialize(ContextOGLType contextType) {
 	bool ARBFragmentShader = false;
 	bool EXTFramebufferMultisample = false;
 	bool EXTFramebufferBlit = false;
+	bool getProgramBinary = false;
 
 	Common::StringTokenizer tokenizer(extString, " ");
 	while (!tokenizer.empty()) {
@@ -147,6 +155,9 @@ void ContextGL::initialize(ContextOGLType contextType) {
 			EXTFramebufferBlit = true;
 		} else if (token == "GL_OES_depth24") {
 			OESDepth24 = true;
+		} else if ((token == "GL_ARB_get_program_binary" && type == kOGLContextGL) ||
+		           (token == "GL_OES_get_program_binary" && type == kOGLContextGLES2)) {
+			getProgramBinary = true;
 		}
 
 	}
@@ -180,6 +191,19 @@ void ContextGL::initialize(ContextOGLType contextType) {
 		}
 	}
 
+#ifdef USE_GLAD
+	if (getProgramBinary) {
+		const bool oes = (type == kOGLContextGLES2);
+		getProgramBinaryProc = (ProcAddress)loadFunc(this, oes ? "glGetProgramBinaryOES" : "glGetProgramBinary");
+		programBinaryProc = (ProcAddress)loadFunc(this, oes ? "glProgramBinaryOES" : "glProgramBinary");
+
+		// Some drivers expose the extension without supporting any format
+		GLint numFormats = 0;
+		glGetIntegerv(GL_NUM_PROGRAM_BINARY_FORMATS, &numFormats);
+		programBinarySupported = getProgramBinaryProc && programBinaryProc && numFormats > 0;
+	}
+#endif
+
 	// Log context type.
 	switch (type) {
 		case kOGLContextNone:
@@ -200,6 +224,7 @@ void ContextGL::initialize(ContextOGLType contextType) {
 	debug(5, "OpenGL: FBO support: %d", framebufferObjectSupported);
 	debug(5, "OpenGL: Packed depth stencil support: %d", packedDepthStencilSupported);
 	debug(5, "OpenGL: Unpack subimage support: %d", unpackSubImageSupported);
+	debug(5, "OpenGL: Program binary support: %d", programBinarySupported);
 }
 
 int ContextGL::getGLSLVersion() const {
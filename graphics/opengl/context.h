@@ -89,6 +89,22 @@ public:
 	/** Whether depth component 24 is supported or not */
 	bool OESDepth24;
 
+	/**
+	 * Whether linked programs can be retrieved as binaries and loaded back,
+	 * through GL_ARB_get_program_binary or GL_OES_get_program_binary.
+	 */
+	bool programBinarySupported;
+
+	typedef void (*ProcAddress)();
+
+	/**
+	 * glGetProgramBinary and glProgramBinary, or their OES variants, when
+	 * programBinarySupported is set. They have to be cast back to their
+	 * actual type before being called.
+	 */
+	ProcAddress getProgramBinaryProc;
+	ProcAddress programBinaryProc;
+
 	int getGLSLVersion() const;
 };
 
@@ -28,8 +28,214 @@
 
 #include "graphics/opengl/context.h"
 
+#include "common/debug.h"
+#include "common/fs.h"
+#include "common/hash-str.h"
+#include "common/md5.h"
+#include "common/memstream.h"
+#include "common/system.h"
+
+#ifndef GL_PROGRAM_BINARY_LENGTH
+#define GL_PROGRAM_BINARY_LENGTH 0x8741
+#endif
+
+#ifdef USE_GLAD
+namespace OpenGL {
+class ProgramBinaryCache;
+}
+
+namespace Common {
+DECLARE_SINGLETON(OpenGL::ProgramBinaryCache);
+}
+#endif
+
 namespace OpenGL {
 
+#ifdef USE_GLAD
+
+#define PROGRAMCACHE_FILENAME "scummvm-shadercache.dat"
+#define PROGRAMCACHE_VERSION 1
+
+typedef void (GLAD_API_PTR *GetProgramBinaryProc)(GLuint program, GLsizei bufSize, GLsizei *length, GLenum *binaryFormat, void *binary);
+typedef void (GLAD_API_PTR *ProgramBinaryProc)(GLuint program, GLenum binaryFormat, const void *binary, GLsizei length);
+
+/**
+ * Linked programs from previous runs, which spares compiling and linking
+ * their shaders again.
+ *
+ * The binaries are stored in a file next to the configuration file. They
+ * are keyed by the MD5 of the shader sources and the driver description,
+ * so updating either invalidates them.
+ */
+class ProgramBinaryCache : public Common::Singleton<ProgramBinaryCache> {
+public:
+	ProgramBinaryCache() : _loaded(false) {}
+
+	/** Create a program from a cached binary, or return 0 if there is none. */
+	GLuint loadProgram(const Common::String &key);
+	/** Add the binary of a linked program to the cache. */
+	void storeProgram(const Common::String &key, GLuint program);
+
+private:
+	struct Entry {
+		GLenum format;
+		Common::Array<byte> data;
+	};
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	static Common::FSNode getFile();
+	void load();
+	void save();
+
+	bool _loaded;
+	EntryMap _entries;
+};
+
+Common::FSNode ProgramBinaryCache::getFile() {
+	Common::String configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return Common::FSNode();
+
+	Common::FSNode configNode(configFile);
+	Common::FSNode dir = configNode.getParent();
+	if (dir.getPath() == configNode.getPath() || !dir.isDirectory()) {
+		// Relative configuration file name, use the current directory
+		return Common::FSNode(PROGRAMCACHE_FILENAME);
+	}
+
+	return dir.getChild(PROGRAMCACHE_FILENAME);
+}
+
+void ProgramBinaryCache::load() {
+	_loaded = true;
+
+	Common::FSNode file = getFile();
+	if (!file.exists())
+		return;
+
+	Common::ScopedPtr<Common::SeekableReadStream> stream(file.createReadStream());
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != MKTAG('S', 'H', 'D', 'C') || stream->readUint32LE() != PROGRAMCACHE_VERSION) {
+		debug(3, "Ignoring shader cache '%s' with unknown format", file.getPath().c_str());
+		return;
+	}
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		char key[32];
+		stream->read(key, sizeof(key));
+
+		Entry entry;
+		entry.format = stream->readUint32LE();
+		uint32 size = stream->readUint32LE();
+		if (stream->eos() || stream->err() || size > (uint32)(stream->size() - stream->pos()))
+			break;
+
+		entry.data.resize(size);
+		stream->read(entry.data.data(), size);
+		_entries[Common::String(key, sizeof(key))] = entry;
+	}
+
+	debug(3, "Loaded %u shader programs from '%s'", _entries.size(), file.getPath().c_str());
+}
+
+void ProgramBinaryCache::save() {
+	Common::FSNode file = getFile();
+	Common::ScopedPtr<Common::WriteStream> stream(file.createWriteStream());
+	if (!stream) {
+		debug(3, "Could not write shader cache '%s'", PROGRAMCACHE_FILENAME);
+		return;
+	}
+
+	stream->writeUint32BE(MKTAG('S', 'H', 'D', 'C'));
+	stream->writeUint32LE(PROGRAMCACHE_VERSION);
+	stream->writeUint32LE(_entries.size());
+	for (EntryMap::const_iterator i = _entries.begin(); i != _entries.end(); ++i) {
+		stream->write(i->_key.c_str(), 32);
+		stream->writeUint32LE(i->_value.format);
+		stream->writeUint32LE(i->_value.data.size());
+		stream->write(i->_value.data.data(), i->_value.data.size());
+	}
+	stream->finalize();
+}
+
+GLuint ProgramBinaryCache::loadProgram(const Common::String &key) {
+	if (!_loaded)
+		load();
+
+	EntryMap::const_iterator entry = _entries.find(key);
+	if (entry == _entries.end())
+		return 0;
+
+	GLuint program = glCreateProgram();
+	ProgramBinaryProc programBinary = (ProgramBinaryProc)OpenGLContext.programBinaryProc;
+	programBinary(program, entry->_value.format, entry->_value.data.data(), entry->_value.data.size());
+
+	// Loading fails if the driver doesn't accept the binary anymore
+	GLint status;
+	glGetProgramiv(program, GL_LINK_STATUS, &status);
+	if (status != GL_TRUE) {
+		glDeleteProgram(program);
+		_entries.erase(key);
+		return 0;
+	}
+
+	return program;
+}
+
+void ProgramBinaryCache::storeProgram(const Common::String &key, GLuint program) {
+	GLint length = 0;
+	glGetProgramiv(program, GL_PROGRAM_BINARY_LENGTH, &length);
+	if (length <= 0)
+		return;
+
+	Entry entry;
+	entry.data.resize(length);
+
+	GLsizei written = 0;
+	GetProgramBinaryProc getProgramBinary = (GetProgramBinaryProc)OpenGLContext.getProgramBinaryProc;
+	getProgramBinary(program, length, &written, &entry.format, entry.data.data());
+	if (written <= 0)
+		return;
+
+	entry.data.resize(written);
+	_entries[key] = entry;
+	save();
+}
+
+/** Compute the cache key of a program. */
+static Common::String getProgramKey(const GLchar *const *vertexSources, int vertexCount,
+                                    const GLchar *const *fragmentSources, int fragmentCount,
+                                    const char **attributes) {
+	static const GLenum driverStrings[] = { GL_VENDOR, GL_RENDERER, GL_VERSION };
+
+	Common::String description;
+	for (int i = 0; i < ARRAYSIZE(driverStrings); ++i) {
+		const char *str = (const char *)glGetString(driverStrings[i]);
+		if (str)
+			description += str;
+		description += '\n';
+	}
+	for (int i = 0; i < vertexCount; ++i)
+		description += vertexSources[i];
+	description += '\n';
+	for (int i = 0; i < fragmentCount; ++i)
+		description += fragmentSources[i];
+	for (int i = 0; attributes[i]; ++i) {
+		description += '\n';
+		description += attributes[i];
+	}
+
+	Common::MemoryReadStream stream((const byte *)description.c_str(), description.size());
+	return Common::computeStreamMD5AsString(stream);
+}
+
+#endif
+
 static const char *compatVertex =
 	"#if defined(GL_ES)\n"
 		"#define ROUND(x) (sign(x) * floor(abs(x) + .5))\n"
@@ -72,6 +278,7 @@ static const GLchar *readFile(const Common::String &filename) {
 	// It's used for development purpose.
 	// Additionally allow load shaders outside distribution data path,
 	// 'extrapath' is used temporary in SearchMan.
+	SearchMan.addDirectory("AGS_SHADERS", "engines/ags", 0, 2);
 	SearchMan.addDirectory("GRIM_SHADERS", "engines/grim", 0, 2);
 	SearchMan.addDirectory("MYST3_SHADERS", "engines/myst3", 0, 2);
 	SearchMan.addDirectory("STARK_SHADERS", "engines/stark", 0, 2);
@@ -86,6 +293,7 @@ static const GLchar *readFile(const Common::String &filename) {
 	file.open(shaderDir + filename);
 	if (!file.isOpen())
 		error("Could not open shader %s!", filename.c_str());
+	SearchMan.remove("AGS_SHADERS");
 	SearchMan.remove("GRIM_SHADERS");
 	SearchMan.remove("MYST3_SHADERS");
 	SearchMan.remove("STARK_SHADERS");
@@ -102,9 +310,9 @@ static const GLchar *readFile(const Common::String &filename) {
 	return shaderSource;
 }
 
-static GLuint createDirectShader(const char *shaderSource, GLenum shaderType, const Common::String &name) {
+static GLuint compileShader(const GLchar *const *sources, int count, GLenum shaderType, const Common::String &name) {
 	GLuint shader = glCreateShader(shaderType);
-	glShaderSource(shader, 1, &shaderSource, NULL);
+	glShaderSource(shader, count, sources, NULL);
 	glCompileShader(shader);
 
 	GLint status;
@@ -120,42 +328,64 @@ static GLuint createDirectShader(const char *shaderSource, GLenum shaderType, co
 	return shader;
 }
 
-static GLuint createCompatShader(const char *shaderSource, GLenum shaderType, const Common::String &name) {
-	const GLchar *versionSource = OpenGLContext.type == kOGLContextGLES2 ? "#version 100\n" : "#version 120\n";
-	const GLchar *compatSource =
-			shaderType == GL_VERTEX_SHADER ? compatVertex : compatFragment;
-	const GLchar *shaderSources[] = {
-		versionSource,
-		compatSource,
-		shaderSource
-	};
+static void getCompatSources(const GLchar *shaderSource, GLenum shaderType, const GLchar *sources[3]) {
+	sources[0] = OpenGLContext.type == kOGLContextGLES2 ? "#version 100\n" : "#version 120\n";
+	sources[1] = shaderType == GL_VERTEX_SHADER ? compatVertex : compatFragment;
+	sources[2] = shaderSource;
+}
 
-	GLuint shader = glCreateShader(shaderType);
-	glShaderSource(shader, 3, shaderSources, NULL);
-	glCompileShader(shader);
+static GLuint linkProgram(const Common::String &name, GLuint vertexShader, GLuint fragmentShader, const char **attributes) {
+	GLuint shaderProgram = glCreateProgram();
+	glAttachShader(shaderProgram, vertexShader);
+	glAttachShader(shaderProgram, fragmentShader);
+
+	for (int idx = 0; attributes[idx]; ++idx)
+		glBindAttribLocation(shaderProgram, idx, attributes[idx]);
+	glLinkProgram(shaderProgram);
 
 	GLint status;
-	glGetShaderiv(shader, GL_COMPILE_STATUS, &status);
+	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &status);
 	if (status != GL_TRUE) {
 		GLint logSize;
-		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &logSize);
+		glGetProgramiv(shaderProgram, GL_INFO_LOG_LENGTH, &logSize);
 		GLchar *log = new GLchar[logSize];
-		glGetShaderInfoLog(shader, logSize, nullptr, log);
-		error("Could not compile shader %s: %s", name.c_str(), log);
+		glGetProgramInfoLog(shaderProgram, logSize, nullptr, log);
+		error("Could not link shader %s: %s", name.c_str(), log);
 	}
 
-	return shader;
+	glDetachShader(shaderProgram, vertexShader);
+	glDetachShader(shaderProgram, fragmentShader);
+
+	glDeleteShader(vertexShader);
+	glDeleteShader(fragmentShader);
+
+	return shaderProgram;
 }
 
-static GLuint loadShaderFromFile(const char *base, const char *extension, GLenum shaderType) {
-	const Common::String filename = Common::String(base) + "." + extension;
-	const GLchar *shaderSource = readFile(filename);
+static GLuint createProgram(const Common::String &name, const Common::String &vertexName, const GLchar *const *vertexSources, int vertexCount,
+                            const Common::String &fragmentName, const GLchar *const *fragmentSources, int fragmentCount, const char **attributes) {
+#ifdef USE_GLAD
+	Common::String key;
+	if (OpenGLContext.programBinarySupported) {
+		key = getProgramKey(vertexSources, vertexCount, fragmentSources, fragmentCount, attributes);
+		GLuint program = ProgramBinaryCache::instance().loadProgram(key);
+		if (program) {
+			debug(5, "Loaded shader %s from the cache", name.c_str());
+			return program;
+		}
+	}
+#endif
 
-	GLuint shader = createCompatShader(shaderSource, shaderType, filename);
+	GLuint vertexShader = compileShader(vertexSources, vertexCount, GL_VERTEX_SHADER, vertexName);
+	GLuint fragmentShader = compileShader(fragmentSources, fragmentCount, GL_FRAGMENT_SHADER, fragmentName);
+	GLuint program = linkProgram(name, vertexShader, fragmentShader, attributes);
 
-	delete[] shaderSource;
+#ifdef USE_GLAD
+	if (!key.empty())
+		ProgramBinaryCache::instance().storeProgram(key, program);
+#endif
 
-	return shader;
+	return program;
 }
 
 /**
@@ -172,51 +402,39 @@ struct SharedPtrProgramDeleter {
 
 ShaderGL *ShaderGL::_previousShader = nullptr;
 
-ShaderGL::ShaderGL(const Common::String &name, GLuint vertexShader, GLuint fragmentShader, const char **attributes)
+ShaderGL::ShaderGL(const Common::String &name, GLuint shaderProgram, const char **attributes)
 	: _name(name) {
-	assert(attributes);
-	GLuint shaderProgram = glCreateProgram();
-	glAttachShader(shaderProgram, vertexShader);
-	glAttachShader(shaderProgram, fragmentShader);
-
-	for (int idx = 0; attributes[idx]; ++idx) {
-		glBindAttribLocation(shaderProgram, idx, attributes[idx]);
+	for (int idx = 0; attributes[idx]; ++idx)
 		_attributes.push_back(VertexAttrib(idx, attributes[idx]));
-	}
-	glLinkProgram(shaderProgram);
-
-	GLint status;
-	glGetProgramiv(shaderProgram, GL_LINK_STATUS, &status);
-	if (status != GL_TRUE) {
-		GLint logSize;
-		glGetProgramiv(shaderProgram, GL_INFO_LOG_LENGTH, &logSize);
-		GLchar *log = new GLchar[logSize];
-		glGetProgramInfoLog(shaderProgram, logSize, nullptr, log);
-		error("Could not link shader %s: %s", name.c_str(), log);
-	}
-
-	glDetachShader(shaderProgram, vertexShader);
-	glDetachShader(shaderProgram, fragmentShader);
-
-	glDeleteShader(vertexShader);
-	glDeleteShader(fragmentShader);
 
 	_shaderNo = Common::SharedPtr<GLuint>(new GLuint(shaderProgram), SharedPtrProgramDeleter());
 	_uniforms = Common::SharedPtr<UniformsMap>(new UniformsMap());
 }
 
 ShaderGL *ShaderGL::fromStrings(const Common::String &name, const char *vertex, const char *fragment, const char **attributes) {
-	GLuint vertexShader = createDirectShader(vertex, GL_VERTEX_SHADER, name + ".vertex");
-	GLuint fragmentShader = createDirectShader(fragment, GL_FRAGMENT_SHADER, name + ".fragment");
-	return new ShaderGL(name, vertexShader, fragmentShader, attributes);
+	assert(attributes);
+	GLuint program = createProgram(name, name + ".vertex", &vertex, 1, name + ".fragment", &fragment, 1, attributes);
+	return new ShaderGL(name, program, attributes);
 }
 
 ShaderGL *ShaderGL::fromFiles(const char *vertex, const char *fragment, const char **attributes) {
-	GLuint vertexShader = loadShaderFromFile(vertex, "vertex", GL_VERTEX_SHADER);
-	GLuint fragmentShader = loadShaderFromFile(fragment, "fragment", GL_FRAGMENT_SHADER);
+	assert(attributes);
+	const Common::String vertexName = Common::String(vertex) + ".vertex";
+	const Common::String fragmentName = Common::String(fragment) + ".fragment";
+	const GLchar *vertexSource = readFile(vertexName);
+	const GLchar *fragmentSource = readFile(fragmentName);
+
+	const GLchar *vertexSources[3], *fragmentSources[3];
+	getCompatSources(vertexSource, GL_VERTEX_SHADER, vertexSources);
+	getCompatSources(fragmentSource, GL_FRAGMENT_SHADER, fragmentSources);
 
 	Common::String name = Common::String::format("%s/%s", vertex, fragment);
-	return new ShaderGL(name, vertexShader, fragmentShader, attributes);
+	GLuint program = createProgram(name, vertexName, vertexSources, 3, fragmentName, fragmentSources, 3, attributes);
+
+	delete[] vertexSource;
+	delete[] fragmentSource;
+
+	return new ShaderGL(name, program, attributes);
 }
 
 void ShaderGL::use(bool forceReload) {
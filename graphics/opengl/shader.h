@@ -139,7 +139,7 @@ public:
 	void unbind();
 
 private:
-	ShaderGL(const Common::String &name, GLuint vertexShader, GLuint fragmentShader, const char **attributes);
+	ShaderGL(const Common::String &name, GLuint shaderProgram, const char **attributes);
 
 	// Since this class is cloned using the implicit copy constructor,
 	// a reference counting pointer is used to ensure deletion of the OpenGL
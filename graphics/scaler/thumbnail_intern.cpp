@@ -24,6 +24,7 @@
 #include "common/system.h"
 
 #include "graphics/colormasks.h"
+#include "graphics/conversion.h"
 #include "graphics/scaler.h"
 #include "graphics/scaler/intern.h"
 #include "graphics/palette.h"
@@ -160,6 +161,14 @@ static void scaleThumbnail(Graphics::Surface &in, Graphics::Surface &out) {
 }
 
 
+/**
+ * Fill a table mapping palette indices to colors in the given format.
+ */
+static void paletteToMap(uint32 *map, const byte *palette, const Graphics::PixelFormat &format) {
+	for (int i = 0; i < 256; i++)
+		map[i] = format.RGBToColor(palette[i * 3], palette[i * 3 + 1], palette[i * 3 + 2]);
+}
+
 /**
  * Copies the current screen contents to a new surface, using RGB565 format.
  * WARNING: surf->free() must be called by the user to avoid leaking.
@@ -179,36 +188,22 @@ static bool grabScreen565(Graphics::Surface *surf) {
 
 	surf->create(screen->w, screen->h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	byte *palette = 0;
+	// Convert whole lines at a time, so that the screen stays locked for
+	// as short as possible
 	if (screenFormat.bytesPerPixel == 1) {
-		palette = new byte[256 * 3];
-		assert(palette);
+		byte palette[256 * 3];
 		g_system->getPaletteManager()->grabPalette(palette, 0, 256);
-	}
 
-	for (int y = 0; y < screen->h; ++y) {
-		for (int x = 0; x < screen->w; ++x) {
-			byte r = 0, g = 0, b = 0;
-
-			if (screenFormat.bytesPerPixel == 1) {
-				uint8 pixel = *(uint8 *)screen->getBasePtr(x, y);
-				r = palette[pixel * 3 + 0];
-				g = palette[pixel * 3 + 1];
-				b = palette[pixel * 3 + 2];
-			} else if (screenFormat.bytesPerPixel == 2) {
-				uint16 col = READ_UINT16(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			} else if (screenFormat.bytesPerPixel == 4) {
-				uint32 col = READ_UINT32(screen->getBasePtr(x, y));
-				screenFormat.colorToRGB(col, r, g, b);
-			}
+		uint32 map[256];
+		paletteToMap(map, palette, surf->format);
 
-			*((uint16 *)surf->getBasePtr(x, y)) = surf->format.RGBToColor(r, g, b);
-		}
+		Graphics::crossBlitMap((byte *)surf->getPixels(), (const byte *)screen->getPixels(),
+		                       surf->pitch, screen->pitch, screen->w, screen->h, 2, map);
+	} else {
+		Graphics::crossBlit((byte *)surf->getPixels(), (const byte *)screen->getPixels(),
+		                    surf->pitch, screen->pitch, screen->w, screen->h, surf->format, screenFormat);
 	}
 
-	delete[] palette;
-
 	g_system->unlockScreen();
 	return true;
 }
@@ -245,16 +240,9 @@ bool createThumbnail(Graphics::Surface *surf, const uint8 *pixels, int w, int h,
 	Graphics::Surface screen;
 	screen.create(w, h, Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
 
-	for (int y = 0; y < screen.h; ++y) {
-		for (int x = 0; x < screen.w; ++x) {
-			byte r, g, b;
-			r = palette[pixels[y * w + x] * 3];
-			g = palette[pixels[y * w + x] * 3 + 1];
-			b = palette[pixels[y * w + x] * 3 + 2];
-
-			*((uint16 *)screen.getBasePtr(x, y)) = screen.format.RGBToColor(r, g, b);
-		}
-	}
+	uint32 map[256];
+	paletteToMap(map, palette, screen.format);
+	Graphics::crossBlitMap((byte *)screen.getPixels(), pixels, screen.pitch, w, w, h, 2, map);
 
 	return createThumbnail(*surf, screen);
 }
@@ -273,14 +261,8 @@ bool createScreenShot(Graphics::Surface &surf) {
 			return false;
 		}
 		surf.create(screen->w, screen->h, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
-		for (int y = 0; y < screen->h; ++y) {
-			for (int x = 0; x < screen->w; ++x) {
-				byte r = 0, g = 0, b = 0, a = 0;
-				uint32 col = READ_UINT32(screen->getBasePtr(x, y));
-				screenFormat.colorToARGB(col, a, r, g, b);
-				*((uint32 *)surf.getBasePtr(x, y)) = surf.format.ARGBToColor(a, r, g, b);
-			}
-		}
+		Graphics::crossBlit((byte *)surf.getPixels(), (const byte *)screen->getPixels(),
+		                    surf.pitch, screen->pitch, screen->w, screen->h, surf.format, screenFormat);
 		g_system->unlockScreen();
 		return true;
 	}
@@ -20,6 +20,8 @@
 
 #include "graphics/scalerplugin.h"
 
+#include "common/threadpool.h"
+
 namespace {
 /**
  * Trivial 'scaler' - in fact it doesn't do any scaling but just copies the
@@ -127,3 +129,51 @@ void SourceScaler::scaleIntern(const uint8 *srcPtr, uint32 srcPitch, uint8 *dstP
 	}
 }
 
+
+namespace {
+
+enum {
+	/** Rects are not split into strips with fewer source rows than this */
+	kMinStripHeight = 16
+};
+
+/** The rows of a rect, as scaled in strips by Common::ThreadPool::parallelFor(). */
+struct ScalerJob {
+	Scaler *scaler;
+	const uint8 *srcPtr;
+	uint32 srcPitch;
+	uint8 *dstPtr;
+	uint32 dstPitch;
+	uint factor;
+	int width;
+	int x;
+	int y;
+
+	static void scale(void *data, uint begin, uint end) {
+		const ScalerJob *job = (const ScalerJob *)data;
+		job->scaler->scale(job->srcPtr + begin * job->srcPitch, job->srcPitch,
+		                   job->dstPtr + begin * job->factor * job->dstPitch, job->dstPitch,
+		                   job->width, end - begin, job->x, job->y + begin);
+	}
+};
+
+} // End of anonymous namespace
+
+void ParallelScaler::scale(Scaler &scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+                           uint32 dstPitch, int width, int height, int x, int y) {
+	if (height <= 0)
+		return;
+
+	ScalerJob job;
+	job.scaler = &scaler;
+	job.srcPtr = srcPtr;
+	job.srcPitch = srcPitch;
+	job.dstPtr = dstPtr;
+	job.dstPitch = dstPitch;
+	job.factor = scaler.getFactor();
+	job.width = width;
+	job.x = x;
+	job.y = y;
+
+	ThreadPoolMan.parallelFor(0, height, kMinStripHeight, ScalerJob::scale, &job);
+}
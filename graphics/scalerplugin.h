@@ -147,6 +147,32 @@ private:
 	Graphics::Surface _bufferedOutput;
 };
 
+/**
+ * Runs a scaler over horizontal strips of a rect on several threads.
+ *
+ * Each strip is scaled straight from the source buffer, so the scaler still
+ * sees the pixels above and below the strip, and the result is the same as
+ * when scaling the whole rect at once. The output of the strips does not
+ * overlap.
+ *
+ * The scaler is used by all threads at the same time. This is only safe for
+ * scalers which do not change their state while scaling, which does not hold
+ * for scalers using the old source.
+ *
+ * @see ScalerPluginObject::useOldSource
+ */
+class ParallelScaler {
+public:
+	/**
+	 * Scale a rect on the threads of the shared thread pool, splitting it
+	 * into strips if it is big enough. Returns when all strips are done.
+	 *
+	 * @see Scaler::scale
+	 */
+	static void scale(Scaler &scaler, const uint8 *srcPtr, uint32 srcPitch, uint8 *dstPtr,
+	                  uint32 dstPitch, int width, int height, int x, int y);
+};
+
 class ScalerPluginObject : public PluginObject {
 public:
 
@@ -21,26 +21,44 @@
 
 #include "common/system.h"
 #include "common/algorithm.h"
+#include "common/array.h"
 #include "graphics/screen.h"
 #include "graphics/palette.h"
 
 namespace Graphics {
 
-Screen::Screen(): ManagedSurface() {
+// The cost of each copy to the physical screen, as a number of pixels. Two
+// dirty areas are merged when copying the pixels between them is cheaper
+// than copying them separately.
+static const int kRectCopyCost = 32 * 32;
+
+// With more dirty areas than this, they are first snapped to a grid of tiles,
+// as merging them pair by pair would take too long
+static const uint kMaxMergedRects = 64;
+static const int kDirtyTileSize = 32;
+
+// The whole screen is copied at once when the dirty areas cover at least
+// this share of it, in percent
+static const int kFullCopyPercent = 75;
+
+Screen::Screen(): ManagedSurface(), _lastDirtyRectCount(0), _lastCopiedRectCount(0) {
 	create(g_system->getWidth(), g_system->getHeight(), g_system->getScreenFormat());
 }
 
-Screen::Screen(int width, int height): ManagedSurface() {
+Screen::Screen(int width, int height): ManagedSurface(), _lastDirtyRectCount(0), _lastCopiedRectCount(0) {
 	create(width, height);
 }
 
-Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface() {
+Screen::Screen(int width, int height, PixelFormat pixelFormat): ManagedSurface(), _lastDirtyRectCount(0), _lastCopiedRectCount(0) {
 	create(width, height, pixelFormat);
 }
 
 void Screen::update() {
+	_lastDirtyRectCount = _dirtyRects.size();
+
 	// Merge the dirty rects
 	mergeDirtyRects();
+	_lastCopiedRectCount = _dirtyRects.size();
 
 	// Loop through copying dirty areas to the physical screen
 	Common::List<Common::Rect>::iterator i;
@@ -75,17 +93,29 @@ void Screen::makeAllDirty() {
 	addDirtyRect(Common::Rect(0, 0, this->w, this->h));
 }
 
+static int rectArea(const Common::Rect &r) {
+	return r.width() * r.height();
+}
+
 void Screen::mergeDirtyRects() {
+	if (_dirtyRects.size() > kMaxMergedRects)
+		snapDirtyRectsToTiles();
+
 	Common::List<Common::Rect>::iterator rOuter, rInner;
 
-	// Process the dirty rect list to find any rects to merge
+	// Process the dirty rect list to find any rects to merge. Overlapping
+	// rects are always merged, and other rects when the merged rect costs
+	// less to copy than the two separate ones.
 	for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter) {
 		rInner = rOuter;
 		while (++rInner != _dirtyRects.end()) {
+			Common::Rect merged;
+			unionRectangle(merged, *rOuter, *rInner);
 
-			if ((*rOuter).intersects(*rInner)) {
-				// These two rectangles overlap, so merge them
-				unionRectangle(*rOuter, *rOuter, *rInner);
+			if ((*rOuter).intersects(*rInner) ||
+					rectArea(merged) <= rectArea(*rOuter) + rectArea(*rInner) + kRectCopyCost) {
+				// Merge the two rectangles
+				*rOuter = merged;
 
 				// remove the inner rect from the list
 				_dirtyRects.erase(rInner);
@@ -95,6 +125,58 @@ void Screen::mergeDirtyRects() {
 			}
 		}
 	}
+
+	// Copy the whole screen at once if most of it is dirty anyway
+	if (_dirtyRects.size() > 1) {
+		int dirtyArea = 0;
+		for (rOuter = _dirtyRects.begin(); rOuter != _dirtyRects.end(); ++rOuter)
+			dirtyArea += rectArea(*rOuter);
+
+		if (dirtyArea * 100 >= w * h * kFullCopyPercent) {
+			Common::Rect bounds = getBounds();
+			bounds.translate(getOffsetFromOwner().x, getOffsetFromOwner().y);
+
+			_dirtyRects.clear();
+			_dirtyRects.push_back(bounds);
+		}
+	}
+}
+
+void Screen::snapDirtyRectsToTiles() {
+	const Common::Point offset = getOffsetFromOwner();
+	const int columns = (w + kDirtyTileSize - 1) / kDirtyTileSize;
+	const int rows = (h + kDirtyTileSize - 1) / kDirtyTileSize;
+	Common::Array<bool> tiles(columns * rows, false);
+
+	// Mark the tiles touched by any of the dirty rects
+	for (Common::List<Common::Rect>::iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
+		Common::Rect r = *i;
+		r.translate(-offset.x, -offset.y);
+
+		for (int y = r.top / kDirtyTileSize; y <= (r.bottom - 1) / kDirtyTileSize; ++y) {
+			for (int x = r.left / kDirtyTileSize; x <= (r.right - 1) / kDirtyTileSize; ++x)
+				tiles[y * columns + x] = true;
+		}
+	}
+
+	// Add a rect for each horizontal run of dirty tiles. The runs are merged
+	// with each other afterwards.
+	_dirtyRects.clear();
+	for (int y = 0; y < rows; ++y) {
+		for (int x = 0; x < columns; ++x) {
+			if (!tiles[y * columns + x])
+				continue;
+
+			const int left = x;
+			while (x < columns && tiles[y * columns + x])
+				++x;
+
+			Common::Rect r(left * kDirtyTileSize, y * kDirtyTileSize, x * kDirtyTileSize, (y + 1) * kDirtyTileSize);
+			r.clip(getBounds());
+			r.translate(offset.x, offset.y);
+			_dirtyRects.push_back(r);
+		}
+	}
 }
 
 bool Screen::unionRectangle(Common::Rect &destRect, const Common::Rect &src1, const Common::Rect &src2) {
@@ -53,12 +53,24 @@ protected:
 	 * List of affected areas of the screen
 	 */
 	Common::List<Common::Rect> _dirtyRects;
+
+	/**
+	 * Number of dirty areas before and after merging them in the last update
+	 */
+	uint _lastDirtyRectCount;
+	uint _lastCopiedRectCount;
 protected:
 	/**
-	 * Merges together overlapping dirty areas of the screen
+	 * Merges together overlapping dirty areas of the screen, and nearby
+	 * ones when copying them together is cheaper than copying them apart
 	 */
 	void mergeDirtyRects();
 
+	/**
+	 * Replaces the dirty areas with the tiles of a coarse grid that they touch
+	 */
+	void snapDirtyRectsToTiles();
+
 	/**
 	 * Returns the union of two dirty area rectangles
 	 */
@@ -73,6 +85,13 @@ public:
 	 */
 	bool isDirty() const { return !_dirtyRects.empty(); }
 
+	/**
+	 * Returns the number of dirty areas which were added before the last
+	 * update, and the number of areas it copied to the physical screen
+	 */
+	uint getLastDirtyRectCount() const { return _lastDirtyRectCount; }
+	uint getLastCopiedRectCount() const { return _lastCopiedRectCount; }
+
 	/**
 	 * Marks the whole screen as dirty. This forces the next call to update
 	 * to copy the entire screen contents
@@ -50,7 +50,6 @@ SVGBitmap::SVGBitmap(Common::SeekableReadStream *in) {
 
 	_rasterizer = NULL;
 	_cachedW = _cachedH = -1;
-	_cache = NULL;
 	_render = NULL;
 
 #ifdef SCUMM_BIG_ENDIAN
@@ -78,17 +77,14 @@ void SVGBitmap::render(Graphics::ManagedSurface &target, int dw, int dh) {
 		_rasterizer = nsvgCreateRasterizer();
 
 	if (_cachedW != dw || _cachedH != dh) {
-		if (_cache)
-			free(_cache);
-
-		_cache = (byte *)malloc(dw * dh * 4);
+		byte *raster = (byte *)malloc(dw * dh * 4);
 
 		// Maintain aspect ratio
 		float xRatio = 1.0f * dw / _svg->width;
 		float yRatio = 1.0f * dh / _svg->height;
 		float ratio = xRatio < yRatio ? xRatio : yRatio;
 
-		nsvgRasterize(_rasterizer, _svg, 0, 0, ratio, _cache, dw, dh, dw * 4);
+		nsvgRasterize(_rasterizer, _svg, 0, 0, ratio, raster, dw, dh, dw * 4);
 
 		_cachedW = dw;
 		_cachedH = dh;
@@ -96,17 +92,96 @@ void SVGBitmap::render(Graphics::ManagedSurface &target, int dw, int dh) {
 		if (_render)
 			delete _render;
 
-		Graphics::Surface tmp;;
-		tmp.init(dw, dh, dw * 4, _cache, *_pixelformat);
+		Graphics::Surface tmp;
+		tmp.init(dw, dh, dw * 4, raster, *_pixelformat);
 
 		_render = new ManagedSurface(dw, dh, *_pixelformat);
 
 		_render->transBlitFrom(tmp);
 
+		// This frees the raster
 		tmp.free();
 	}
 
 	target.blitFrom(_render->rawSurface());
 }
 
+SVGRasterCache::SVGRasterCache(uint32 maxBytes) : _maxBytes(maxBytes), _bytes(0), _useCounter(0) {
+	// The images can be rasterized again
+	MemTracker.registerConsumer(this, Common::MemoryTracker::kPriorityLow);
+}
+
+SVGRasterCache::~SVGRasterCache() {
+	MemTracker.unregisterConsumer(this);
+	clear();
+}
+
+size_t SVGRasterCache::shrinkMemoryUsage(size_t bytes) {
+	const uint32 oldBytes = _bytes;
+	evict(oldBytes - MIN<size_t>(bytes, oldBytes));
+	return oldBytes - _bytes;
+}
+
+Common::String SVGRasterCache::makeKey(const Common::String &name, int w, int h) {
+	return Common::String::format("%s@%dx%d", name.c_str(), w, h);
+}
+
+Graphics::ManagedSurface *SVGRasterCache::get(const Common::String &name, int w, int h) {
+	EntryMap::iterator i = _entries.find(makeKey(name, w, h));
+	if (i == _entries.end())
+		return nullptr;
+
+	i->_value.lastUse = ++_useCounter;
+
+	Graphics::ManagedSurface *copy = new Graphics::ManagedSurface();
+	copy->copyFrom(*i->_value.surf);
+	return copy;
+}
+
+void SVGRasterCache::put(const Common::String &name, const Graphics::ManagedSurface &surf) {
+	const uint32 size = surf.h * surf.w * surf.format.bytesPerPixel;
+	if (size > _maxBytes)
+		return;
+
+	const Common::String key = makeKey(name, surf.w, surf.h);
+	EntryMap::iterator i = _entries.find(key);
+	if (i != _entries.end()) {
+		_bytes -= i->_value.surf->h * i->_value.surf->w * i->_value.surf->format.bytesPerPixel;
+		delete i->_value.surf;
+	}
+
+	Entry entry;
+	entry.surf = new Graphics::ManagedSurface();
+	entry.surf->copyFrom(surf);
+	entry.lastUse = ++_useCounter;
+	_entries[key] = entry;
+	_bytes += size;
+
+	evict(_maxBytes);
+	MemTracker.checkBudget();
+}
+
+void SVGRasterCache::clear() {
+	for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i)
+		delete i->_value.surf;
+
+	_entries.clear();
+	_bytes = 0;
+}
+
+void SVGRasterCache::evict(uint32 maxBytes) {
+	// Drop the rasters not used for the longest time
+	while (_bytes > maxBytes) {
+		EntryMap::iterator oldest = _entries.begin();
+		for (EntryMap::iterator i = _entries.begin(); i != _entries.end(); ++i) {
+			if (i->_value.lastUse < oldest->_value.lastUse)
+				oldest = i;
+		}
+
+		_bytes -= oldest->_value.surf->h * oldest->_value.surf->w * oldest->_value.surf->format.bytesPerPixel;
+		delete oldest->_value.surf;
+		_entries.erase(oldest);
+	}
+}
+
 } // end of namespace Graphics
@@ -21,6 +21,11 @@
 #ifndef GRAPHICS_SVG_H
 #define GRAPHICS_SVG_H
 
+#include "common/hashmap.h"
+#include "common/hash-str.h"
+#include "common/memtracker.h"
+#include "common/str.h"
+
 namespace Common {
 class SeekableReadStream;
 }
@@ -49,11 +54,63 @@ private:
 
 	Graphics::ManagedSurface *_render;
 	int _cachedW, _cachedH;
-	byte *_cache;
 
 	Graphics::PixelFormat *_pixelformat;
 };
 
+/**
+ * A cache of rasterized SVG images, keyed by name and size.
+ *
+ * Rasterizing an SVG image is slow, so this keeps the rasters for when
+ * the same image is needed at the same size again, e.g. when the GUI
+ * theme is reloaded. The least recently used rasters are dropped when
+ * the cache grows past its memory limit.
+ */
+class SVGRasterCache : public Common::MemoryConsumer {
+public:
+	SVGRasterCache(uint32 maxBytes);
+	~SVGRasterCache();
+
+	const char *getMemoryConsumerName() const override { return "SVG rasters"; }
+	size_t getMemoryUsage() const override { return _bytes; }
+	size_t shrinkMemoryUsage(size_t bytes) override;
+
+	/**
+	 * Return a copy of the named image rasterized at the given size.
+	 *
+	 * @return a new surface owned by the caller, or nullptr if the image
+	 *         is not cached at this size
+	 */
+	Graphics::ManagedSurface *get(const Common::String &name, int w, int h);
+
+	/**
+	 * Store a copy of the named image, rasterized at the size of the
+	 * surface.
+	 */
+	void put(const Common::String &name, const Graphics::ManagedSurface &surf);
+
+	/**
+	 * Drop all the rasters.
+	 */
+	void clear();
+
+private:
+	struct Entry {
+		Graphics::ManagedSurface *surf;
+		uint32 lastUse;
+	};
+
+	typedef Common::HashMap<Common::String, Entry> EntryMap;
+
+	EntryMap _entries;
+	uint32 _maxBytes;
+	uint32 _bytes;
+	uint32 _useCounter;
+
+	static Common::String makeKey(const Common::String &name, int w, int h);
+	void evict(uint32 maxBytes);
+};
+
 } // end of namespace Graphics
 
 #endif // GRAPHICS_SVG_H
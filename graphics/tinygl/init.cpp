@@ -253,13 +253,12 @@ void GLContext::init(int screenW, int screenH, Graphics::PixelFormat pixelFormat
 	// color mask
 	color_mask_red = color_mask_green = color_mask_blue = color_mask_alpha = true;
 
-	const int kDrawCallMemory = 5 * 1024 * 1024;
-
-	_currentAllocatorIndex = 0;
-	_drawCallAllocator[0].initialize(kDrawCallMemory);
-	_drawCallAllocator[1].initialize(kDrawCallMemory);
+	_currentArenaIndex = 0;
+	_drawCallsQueue = DrawCallList(Common::ArenaAllocator(_drawCallArena[0]));
 	_debugRectsEnabled = false;
 
+	_drawCallWorkers = nullptr;
+
 	TinyGL::Internal::tglBlitResetScissorRect();
 }
 
@@ -276,6 +275,7 @@ void destroyContext() {
 }
 
 void GLContext::deinit() {
+	disposeDrawCallWorkers();
 	disposeDrawCallLists();
 	disposeResources();
 
@@ -88,22 +88,38 @@ FrameBuffer::FrameBuffer(int width, int height, const Graphics::PixelFormat &for
 
 	_pbuf.set(_pbufFormat, new byte[_pbufHeight * _pbufPitch]);
 	_zbuf = (uint *)gl_zalloc(_pbufWidth * _pbufHeight * sizeof(uint));
+	_sbuf = nullptr;
 	if (enableStencilBuffer)
 		_sbuf = (byte *)gl_zalloc(_pbufWidth * _pbufHeight * sizeof(byte));
+	_ownsBuffers = true;
 
 	_offscreenBuffer.pbuf = _pbuf.getRawBuffer();
 	_offscreenBuffer.zbuf = _zbuf;
 
 	_currentTexture = nullptr;
+	enableSpanKernels(true);
+}
+
+FrameBuffer::FrameBuffer(const FrameBuffer *buffers) : FrameBuffer(*buffers) {
+	_ownsBuffers = false;
 }
 
 FrameBuffer::~FrameBuffer() {
+	if (!_ownsBuffers)
+		return;
+
 	_pbuf.free();
 	gl_free(_zbuf);
 	if (_sbuf)
 		gl_free(_sbuf);
 }
 
+void FrameBuffer::enableSpanKernels(bool enable) {
+	_spanKernels = nullptr;
+	if (enable && (_pbufBpp == 2 || _pbufBpp == 4))
+		_spanKernels = getSpanKernels();
+}
+
 Buffer *FrameBuffer::genOffscreenBuffer() {
 	Buffer *buf = (Buffer *)gl_malloc(sizeof(Buffer));
 	buf->pbuf = (byte *)gl_zalloc(_pbufHeight * _pbufPitch);
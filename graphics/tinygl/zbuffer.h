@@ -32,6 +32,7 @@
 #include "graphics/tinygl/pixelbuffer.h"
 #include "graphics/tinygl/texelbuffer.h"
 #include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zspan.h"
 
 #include "common/rect.h"
 
@@ -102,6 +103,12 @@ struct ZBufferPoint {
 
 struct FrameBuffer {
 	FrameBuffer(int width, int height, const Graphics::PixelFormat &format, bool enableStencilBuffer);
+	/**
+	 * Create a frame buffer drawing into the color, depth and stencil
+	 * buffers of another one, with a render state of its own. The buffers
+	 * stay owned by the other frame buffer.
+	 */
+	explicit FrameBuffer(const FrameBuffer *buffers);
 	~FrameBuffer();
 
 	Graphics::PixelFormat getPixelFormat() {
@@ -569,6 +576,13 @@ public:
 		_textureSizeMask = textureSizeMask;
 	}
 
+	/**
+	 * Select whether triangles are drawn with the vectorized scan line
+	 * routines, if the host CPU and the pixel format allow it. They are
+	 * enabled by default.
+	 */
+	void enableSpanKernels(bool enable);
+
 private:
 
 	/**
@@ -651,6 +665,7 @@ private:
 
 	uint *_zbuf;
 	byte *_sbuf;
+	bool _ownsBuffers;
 
 	bool _enableStencil;
 	int _textureSize;
@@ -661,6 +676,7 @@ private:
 
 	const TexelBuffer *_currentTexture;
 	uint _wrapS, _wrapT;
+	const SpanKernels *_spanKernels;
 	bool _blendingEnabled;
 	int _sourceBlendingFactor;
 	int _destinationBlendingFactor;
@@ -25,6 +25,8 @@
 
 #include "common/debug.h"
 #include "common/math.h"
+#include "common/mutex.h"
+#include "common/threadpool.h"
 
 namespace TinyGL {
 
@@ -96,7 +98,7 @@ void GLContext::disposeResources() {
 }
 
 void GLContext::disposeDrawCallLists() {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef DrawCallList::const_iterator DrawCallIterator;
 	for (DrawCallIterator it = _previousFrameDrawCallsQueue.begin(); it != _previousFrameDrawCallsQueue.end(); ++it) {
 		delete *it;
 	}
@@ -107,14 +109,180 @@ void GLContext::disposeDrawCallLists() {
 	_drawCallsQueue.clear();
 }
 
+/**
+ * Threads replaying draw calls into tiles of the frame buffer.
+ *
+ * Every thread, including the calling one, draws on a context of its own,
+ * whose frame buffer shares the color, depth and stencil buffers of the
+ * main context. The tiles do not overlap, and the draw calls of a tile are
+ * executed in order, so the result is the same as when drawing the tiles
+ * one after the other.
+ *
+ * Only rasterization and clear calls are replayed by the threads, since
+ * blits use the state of the main context.
+ */
+class DrawCallWorkers {
+public:
+	DrawCallWorkers(GLContext *c);
+	~DrawCallWorkers();
+
+	/** Draw the given calls into the tiles, and wait until all tiles are done. */
+	void run(const Common::Array<const DrawCall *> &drawCalls, const Common::Array<Common::Rect> &tiles);
+
+private:
+	static void drawTiles(void *data, uint begin, uint end);
+	bool drawNextTile(GLContext *c);
+
+	GLContext *_mainContext;
+	// One context for each thread drawing, including the calling one
+	GLContext *_contexts[Common::ThreadPool::kMaxThreads + 1];
+	int _contextCount;
+
+	Common::Mutex _mutex;
+
+	// Protected by _mutex
+	const Common::Array<const DrawCall *> *_drawCalls;
+	const Common::Array<Common::Rect> *_tiles;
+	uint _tileCount;
+	uint _nextTile;
+};
+
+DrawCallWorkers::DrawCallWorkers(GLContext *c) : _mainContext(c),
+	_drawCalls(nullptr), _tiles(nullptr), _tileCount(0), _nextTile(0) {
+	_contextCount = ThreadPoolMan.getThreadCount() + 1;
+	for (int i = 0; i < _contextCount; i++) {
+		_contexts[i] = new GLContext();
+		_contexts[i]->fb = new FrameBuffer(c->fb);
+	}
+}
+
+DrawCallWorkers::~DrawCallWorkers() {
+	for (int i = 0; i < _contextCount; i++) {
+		delete _contexts[i]->fb;
+		gl_free(_contexts[i]->vertex);
+		delete _contexts[i];
+	}
+}
+
+void DrawCallWorkers::drawTiles(void *data, uint begin, uint end) {
+	DrawCallWorkers *workers = (DrawCallWorkers *)data;
+
+	// The tiles are handed out one at a time, so threads which finish their
+	// tiles early take over more of them
+	for (uint i = begin; i < end; i++)
+		while (workers->drawNextTile(workers->_contexts[i]))
+			;
+}
+
+bool DrawCallWorkers::drawNextTile(GLContext *c) {
+	const Common::Array<const DrawCall *> *drawCalls;
+	const Common::Rect *tile;
+
+	{
+		Common::StackLock lock(_mutex);
+		if (_nextTile >= _tileCount)
+			return false;
+
+		drawCalls = _drawCalls;
+		tile = &(*_tiles)[_nextTile++];
+	}
+
+	for (Common::Array<const DrawCall *>::const_iterator it = drawCalls->begin(); it != drawCalls->end(); ++it) {
+		const DrawCall *drawCall = *it;
+		if (!drawCall->getDirtyRegion().intersects(*tile))
+			continue;
+
+		if (drawCall->getType() == DrawCall::DrawCall_Rasterization) {
+			((const RasterizationDrawCall *)drawCall)->executeOnContext(c, *tile);
+		} else if (drawCall->getType() == DrawCall::DrawCall_Clear) {
+			((const ClearBufferDrawCall *)drawCall)->executeOnContext(c, *tile);
+		}
+	}
+	return true;
+}
+
+void DrawCallWorkers::run(const Common::Array<const DrawCall *> &drawCalls, const Common::Array<Common::Rect> &tiles) {
+	// State which is not part of the draw calls is taken from the main context
+	for (int i = 0; i < _contextCount; i++) {
+		GLContext *c = _contexts[i];
+		c->renderRect = _mainContext->renderRect;
+		c->render_mode = _mainContext->render_mode;
+		c->current_cull_face = _mainContext->current_cull_face;
+		c->vertex_n = _mainContext->vertex_n;
+	}
+
+	{
+		Common::StackLock lock(_mutex);
+		_drawCalls = &drawCalls;
+		_tiles = &tiles;
+		_tileCount = tiles.size();
+		_nextTile = 0;
+	}
+
+	// Each chunk of the range is a set of contexts to draw with
+	ThreadPoolMan.parallelFor(0, MIN<uint>(_contextCount, tiles.size()), 1, drawTiles, this);
+}
+
+void GLContext::disposeDrawCallWorkers() {
+	delete _drawCallWorkers;
+	_drawCallWorkers = nullptr;
+}
+
 static inline void _appendDirtyRectangle(const DrawCall &call, Common::List<DirtyRectangle> &rectangles, int r, int g, int b) {
 	Common::Rect dirty_region = call.getDirtyRegion();
 	if (rectangles.empty() || dirty_region != rectangles.back().rectangle)
 		rectangles.push_back(DirtyRectangle(dirty_region, r, g, b));
 }
 
+void GLContext::executeDrawCallsInTiles(const Common::List<Common::Rect> &dirtyAreas) {
+	typedef DrawCallList::const_iterator DrawCallIterator;
+	typedef Common::List<Common::Rect>::const_iterator RectangleIterator;
+
+	// Split the dirty rectangles into horizontal bands. The rasterizer skips
+	// the scan lines outside of a band quickly, so each thread mostly works
+	// on the part of a triangle inside its band.
+	const int kTileHeight = 32;
+
+	Common::Array<Common::Rect> tiles;
+	for (RectangleIterator itRect = dirtyAreas.begin(); itRect != dirtyAreas.end(); ++itRect) {
+		if (itRect->isEmpty())
+			continue;
+
+		for (int top = itRect->top; top < itRect->bottom; top = (top / kTileHeight + 1) * kTileHeight) {
+			const int bottom = MIN<int>(itRect->bottom, (top / kTileHeight + 1) * kTileHeight);
+			tiles.push_back(Common::Rect(itRect->left, top, itRect->right, bottom));
+		}
+	}
+
+	// Blits use the state of this context, so they are executed here, after
+	// the draw calls preceding them are done in all tiles.
+	Common::Array<const DrawCall *> drawCalls;
+	for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+		if ((*it)->getType() != DrawCall::DrawCall_Blitting) {
+			drawCalls.push_back(*it);
+			continue;
+		}
+
+		if (!drawCalls.empty()) {
+			_drawCallWorkers->run(drawCalls, tiles);
+			drawCalls.clear();
+		}
+
+		Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+		for (RectangleIterator itRect = dirtyAreas.begin(); itRect != dirtyAreas.end(); ++itRect) {
+			if (itRect->intersects(drawCallRegion)) {
+				(*it)->execute(*itRect, true);
+			}
+		}
+	}
+
+	if (!drawCalls.empty()) {
+		_drawCallWorkers->run(drawCalls, tiles);
+	}
+}
+
 void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas) {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef DrawCallList::const_iterator DrawCallIterator;
 	typedef Common::List<DirtyRectangle>::iterator RectangleIterator;
 
 	Common::List<DirtyRectangle> rectangles;
@@ -192,13 +360,24 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 			dirtyAreas.push_back((*itRect).rectangle);
 		}
 
+		if (ThreadPoolMan.getThreadCount() > 0 && !_drawCallWorkers && render_mode == TGL_RENDER)
+			_drawCallWorkers = new DrawCallWorkers(this);
+
 		// Execute draw calls.
-		for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
-			Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+		if (_drawCallWorkers && render_mode == TGL_RENDER) {
+			Common::List<Common::Rect> areas;
 			for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
-				Common::Rect dirtyRegion = (*itRect).rectangle;
-				if (dirtyRegion.intersects(drawCallRegion)) {
-					(*it)->execute(dirtyRegion, true);
+				areas.push_back((*itRect).rectangle);
+			}
+			executeDrawCallsInTiles(areas);
+		} else {
+			for (DrawCallIterator it = _drawCallsQueue.begin(); it != _drawCallsQueue.end(); ++it) {
+				Common::Rect drawCallRegion = (*it)->getDirtyRegion();
+				for (RectangleIterator itRect = rectangles.begin(); itRect != rectangles.end(); ++itRect) {
+					Common::Rect dirtyRegion = (*itRect).rectangle;
+					if (dirtyRegion.intersects(drawCallRegion)) {
+						(*it)->execute(dirtyRegion, true);
+					}
 				}
 			}
 		}
@@ -226,17 +405,19 @@ void GLContext::presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas)
 		delete *it;
 	}
 
-	_previousFrameDrawCallsQueue = _drawCallsQueue;
-	_drawCallsQueue.clear();
+	// The draw calls of the previous frame are gone, so its arena can be
+	// reused for the next frame
+	_previousFrameDrawCallsQueue = Common::move(_drawCallsQueue);
 
 	disposeResources();
 
-	_currentAllocatorIndex = (_currentAllocatorIndex + 1) & 0x1;
-	_drawCallAllocator[_currentAllocatorIndex].reset();
+	_currentArenaIndex = (_currentArenaIndex + 1) & 0x1;
+	_drawCallArena[_currentArenaIndex].reset();
+	_drawCallsQueue = DrawCallList(Common::ArenaAllocator(_drawCallArena[_currentArenaIndex]));
 }
 
 void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
-	typedef Common::List<DrawCall *>::const_iterator DrawCallIterator;
+	typedef DrawCallList::const_iterator DrawCallIterator;
 
 	dirtyAreas.push_back(Common::Rect(fb->getPixelBufferWidth(), fb->getPixelBufferHeight()));
 
@@ -249,7 +430,7 @@ void GLContext::presentBufferSimple(Common::List<Common::Rect> &dirtyAreas) {
 
 	disposeResources();
 
-	_drawCallAllocator[_currentAllocatorIndex].reset();
+	_drawCallArena[_currentArenaIndex].reset();
 }
 
 void presentBuffer(Common::List<Common::Rect> &dirtyAreas) {
@@ -294,7 +475,7 @@ RasterizationDrawCall::RasterizationDrawCall() : DrawCall(DrawCall_Rasterization
 	_drawTriangleFront = c->draw_triangle_front;
 	_drawTriangleBack = c->draw_triangle_back;
 	memcpy(_vertex, c->vertex, sizeof(GLVertex) * _vertexCount);
-	_state = captureState();
+	_state = captureState(c);
 	if (c->_enableDirtyRectangles) {
 		computeDirtyRegion();
 	}
@@ -338,14 +519,37 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 
 	RasterizationDrawCall::RasterizationState backupState;
 	if (restoreState) {
-		backupState = captureState();
+		backupState = captureState(c);
+	}
+	applyState(c, _state);
+
+	draw(c, _vertex);
+
+	if (restoreState) {
+		applyState(c, backupState);
+	}
+}
+
+void RasterizationDrawCall::executeOnContext(GLContext *c, const Common::Rect &clippingRectangle) const {
+	if (c->vertex_max < _vertexCount) {
+		gl_free(c->vertex);
+		c->vertex = (GLVertex *)gl_malloc(_vertexCount * sizeof(GLVertex));
+		c->vertex_max = _vertexCount;
 	}
-	applyState(_state);
+	memcpy(c->vertex, _vertex, _vertexCount * sizeof(GLVertex));
+
+	applyState(c, _state);
+
+	c->fb->setScissorRectangle(clippingRectangle);
+	draw(c, c->vertex);
+	c->fb->resetScissorRectangle();
+}
 
+void RasterizationDrawCall::draw(GLContext *c, GLVertex *vertex) const {
 	GLVertex *prevVertex = c->vertex;
 	int prevVertexCount = c->vertex_cnt;
 
-	c->vertex = _vertex;
+	c->vertex = vertex;
 	c->vertex_cnt = _vertexCount;
 	c->draw_triangle_front = (gl_draw_triangle_func)_drawTriangleFront;
 	c->draw_triangle_back = (gl_draw_triangle_func)_drawTriangleBack;
@@ -427,15 +631,10 @@ void RasterizationDrawCall::execute(bool restoreState) const {
 
 	c->vertex = prevVertex;
 	c->vertex_cnt = prevVertexCount;
-
-	if (restoreState) {
-		applyState(backupState);
-	}
 }
 
-RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState() const {
+RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState(GLContext *c) const {
 	RasterizationState state;
-	GLContext *c = gl_get_context();
 	state.enableBlending = c->blending_enabled;
 	state.sfactor = c->source_blending_factor;
 	state.dfactor = c->destination_blending_factor;
@@ -480,8 +679,7 @@ RasterizationDrawCall::RasterizationState RasterizationDrawCall::captureState()
 	return state;
 }
 
-void RasterizationDrawCall::applyState(const RasterizationDrawCall::RasterizationState &state) const {
-	GLContext *c = gl_get_context();
+void RasterizationDrawCall::applyState(GLContext *c, const RasterizationDrawCall::RasterizationState &state) const {
 	c->fb->enableBlending(state.enableBlending);
 	c->fb->setBlendingFactors(state.sfactor, state.dfactor);
 	c->fb->enableAlphaTest(state.alphaTestEnabled);
@@ -696,7 +894,10 @@ void ClearBufferDrawCall::execute(bool restoreState) const {
 }
 
 void ClearBufferDrawCall::execute(const Common::Rect &clippingRectangle, bool restoreState) const {
-	TinyGL::GLContext *c = gl_get_context();
+	executeOnContext(gl_get_context(), clippingRectangle);
+}
+
+void ClearBufferDrawCall::executeOnContext(GLContext *c, const Common::Rect &clippingRectangle) const {
 	Common::Rect clearRect = clippingRectangle.findIntersectingRect(getDirtyRegion());
 	c->fb->clearRegion(clearRect.left, clearRect.top, clearRect.width(), clearRect.height(),
 	                   _clearZBuffer, _zValue, _clearColorBuffer, _rValue, _gValue, _bValue,
@@ -762,7 +963,7 @@ bool RasterizationDrawCall::RasterizationState::operator==(const RasterizationSt
 
 void *Internal::allocateFrame(int size) {
 	GLContext *c = gl_get_context();
-	return c->_drawCallAllocator[c->_currentAllocatorIndex].allocate(size);
+	return c->_drawCallArena[c->_currentArenaIndex].allocate(size);
 }
 
 } // end of namespace TinyGL
@@ -71,6 +71,12 @@ public:
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
 
+	/**
+	 * Execute the draw call inside a clipping rectangle on the given context,
+	 * which may be used by another thread than the main context.
+	 */
+	void executeOnContext(GLContext *c, const Common::Rect &clippingRectangle) const;
+
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
 	}
@@ -90,6 +96,15 @@ public:
 	virtual void execute(bool restoreState) const;
 	virtual void execute(const Common::Rect &clippingRectangle, bool restoreState) const;
 
+	/**
+	 * Execute the draw call inside a clipping rectangle on the given context,
+	 * which may be used by another thread than the main context.
+	 *
+	 * Rasterization changes the vertices, so they are copied to the vertex
+	 * array of the context first. The state of the context is not restored.
+	 */
+	void executeOnContext(GLContext *c, const Common::Rect &clippingRectangle) const;
+
 	void *operator new(size_t size) {
 		return Internal::allocateFrame(size);
 	}
@@ -97,6 +112,7 @@ public:
 	void operator delete(void *p) { }
 private:
 	void computeDirtyRegion();
+	void draw(GLContext *c, GLVertex *vertex) const;
 	typedef void (*gl_draw_triangle_func_ptr)(GLContext *c, TinyGL::GLVertex *p0, TinyGL::GLVertex *p1, TinyGL::GLVertex *p2);
 	int _vertexCount;
 	GLVertex *_vertex;
@@ -146,8 +162,8 @@ private:
 
 	RasterizationState _state;
 
-	RasterizationState captureState() const;
-	void applyState(const RasterizationState &state) const;
+	RasterizationState captureState(GLContext *c) const;
+	void applyState(GLContext *c, const RasterizationState &state) const;
 };
 
 // Encapsulate a blit call: it might execute either a color buffer or z buffer blit.
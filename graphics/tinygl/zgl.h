@@ -30,6 +30,7 @@
 
 #include "common/util.h"
 #include "common/textconsole.h"
+#include "common/arena.h"
 #include "common/array.h"
 #include "common/list.h"
 #include "common/scummsys.h"
@@ -204,58 +205,10 @@ struct GLSharedState {
 	GLTexture **texture_hash_table;
 };
 
-/**
- * A linear allocator implementation.
- * The allocator can be initialized to a specific buffer size only once.
- * The allocation scheme is pretty simple: pointers are returned relative to a current memory position,
- * the allocator starts with an offset of 0 and increases its offset by the allocated amount every time.
- * Memory is released through the method free(), care has to be taken to call the destructors of the deallocated objects either manually (for complex struct arrays) or
- * by overriding the delete operator (with an empty implementation).
- */
-class LinearAllocator {
-public:
-	LinearAllocator() {
-		_memoryBuffer = nullptr;
-		_memorySize = 0;
-		_memoryPosition = 0;
-	}
-
-	void initialize(size_t newSize) {
-		assert(_memoryBuffer == nullptr);
-		void *newBuffer = gl_malloc(newSize);
-		if (newBuffer == nullptr) {
-			error("Couldn't allocate memory for linear allocator.");
-		}
-		_memoryBuffer = newBuffer;
-		_memorySize = newSize;
-	}
-
-	~LinearAllocator() {
-		if (_memoryBuffer != nullptr) {
-			gl_free(_memoryBuffer);
-		}
-	}
-
-	void *allocate(size_t size) {
-		if (_memoryPosition + size >= _memorySize) {
-			error("Allocator out of memory: couldn't allocate more memory from linear allocator.");
-		}
-		size_t returnPos = _memoryPosition;
-		_memoryPosition += size;
-		return ((byte *)_memoryBuffer) + returnPos;
-	}
-
-	void reset() {
-		_memoryPosition = 0;
-	}
-private:
-	void *_memoryBuffer;
-	size_t _memorySize;
-	size_t _memoryPosition;
-};
-
 struct GLContext;
 
+class DrawCallWorkers;
+
 typedef void (*gl_draw_triangle_func)(GLContext *c, GLVertex *p0, GLVertex *p1, GLVertex *p2);
 
 // display context
@@ -427,13 +380,18 @@ struct GLContext {
 	// blit test
 	Common::List<BlitImage *> _blitImages;
 
-	// Draw call queue
-	Common::List<DrawCall *> _drawCallsQueue;
-	Common::List<DrawCall *> _previousFrameDrawCallsQueue;
-	int _currentAllocatorIndex;
-	LinearAllocator _drawCallAllocator[2];
+	// Draw call queue, allocated from the arena of its frame along with the
+	// draw calls. The arenas need to outlive the queues.
+	typedef Common::List<DrawCall *, Common::ArenaAllocator> DrawCallList;
+	Common::Arena _drawCallArena[2];
+	int _currentArenaIndex;
+	DrawCallList _drawCallsQueue;
+	DrawCallList _previousFrameDrawCallsQueue;
 	bool _debugRectsEnabled;
 
+	// Threads replaying the draw calls in tiles, see presentBufferDirtyRects
+	DrawCallWorkers *_drawCallWorkers;
+
 	void gl_vertex_transform(GLVertex *v);
 
 public:
@@ -479,8 +437,10 @@ public:
 	void issueDrawCall(DrawCall *drawCall);
 	void disposeResources();
 	void disposeDrawCallLists();
+	void disposeDrawCallWorkers();
 
 	void presentBufferDirtyRects(Common::List<Common::Rect> &dirtyAreas);
+	void executeDrawCallsInTiles(const Common::List<Common::Rect> &dirtyAreas);
 	void presentBufferSimple(Common::List<Common::Rect> &dirtyAreas);
 
 	void debugDrawRectangle(Common::Rect rect, int r, int g, int b);
@@ -0,0 +1,182 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zbuffer.h"
+#include "graphics/tinygl/zspan.h"
+
+#include <arm_neon.h>
+
+namespace TinyGL {
+
+/** Return the values of four consecutive pixels, starting at start. */
+static inline uint32x4_t interpolate(uint start, int step) {
+	static const uint32 kLanes[4] = { 0, 1, 2, 3 };
+	return vmlaq_n_u32(vdupq_n_u32(start), vld1q_u32(kLanes), (uint)step);
+}
+
+/** Compare four depth values with the depth buffer the way FrameBuffer::compareDepth() does. */
+static inline uint32x4_t depthMask(uint32x4_t z, uint32x4_t zDst, int depthFunc) {
+	switch (depthFunc) {
+	case TGL_LESS:
+		return vcltq_u32(zDst, z);
+	case TGL_EQUAL:
+		return vceqq_u32(zDst, z);
+	case TGL_LEQUAL:
+		return vcleq_u32(zDst, z);
+	case TGL_GREATER:
+		return vcgtq_u32(zDst, z);
+	case TGL_NOTEQUAL:
+		return vmvnq_u32(vceqq_u32(zDst, z));
+	case TGL_GEQUAL:
+		return vcgeq_u32(zDst, z);
+	case TGL_ALWAYS:
+		return vdupq_n_u32(0xFFFFFFFF);
+	default:
+		return vdupq_n_u32(0);
+	}
+}
+
+static const uint32 kLaneBits[4] = { 1, 2, 4, 8 };
+
+/** Expand four bits of a pixel mask to lane masks. */
+static inline uint32x4_t laneMask(uint bits) {
+	return vtstq_u32(vdupq_n_u32(bits), vld1q_u32(kLaneBits));
+}
+
+/** Collect the lane masks of four pixels into four bits. */
+static inline uint maskBits(uint32x4_t mask) {
+	const uint32x4_t bits = vandq_u32(mask, vld1q_u32(kLaneBits));
+	const uint32x2_t sum = vadd_u32(vget_low_u32(bits), vget_high_u32(bits));
+	return vget_lane_u32(vpadd_u32(sum, sum), 0);
+}
+
+/** Modulate four texel components by interpolated color components. */
+static inline uint32x4_t modulate(uint32x4_t texel, uint32x4_t color) {
+	const uint32x4_t light = vshrq_n_u32(color, ZB_POINT_RED_BITS - 8);
+	return vandq_u32(vshrq_n_u32(vmulq_u32(texel, light), ZB_POINT_RED_BITS - 8), vdupq_n_u32(0xFF));
+}
+
+static int fillDepth(uint *pz, uint z, int dzdx, int count, int depthFunc) {
+	const uint32x4_t zStep = vdupq_n_u32(4 * (uint)dzdx);
+	uint32x4_t zSrc = interpolate(z, dzdx);
+
+	int done = 0;
+	for (; done + 4 <= count; done += 4) {
+		uint32 *dst = (uint32 *)(pz + done);
+		const uint32x4_t zDst = vld1q_u32(dst);
+		vst1q_u32(dst, vbslq_u32(depthMask(zSrc, zDst, depthFunc), zSrc, zDst));
+		zSrc = vaddq_u32(zSrc, zStep);
+	}
+	return done;
+}
+
+static uint testDepth8(const uint *pz, uint z, int dzdx, int depthFunc) {
+	const uint32x4_t z0 = interpolate(z, dzdx);
+	const uint32x4_t z1 = vaddq_u32(z0, vdupq_n_u32(4 * (uint)dzdx));
+	const uint mask0 = maskBits(depthMask(z0, vld1q_u32((const uint32 *)pz), depthFunc));
+	const uint mask1 = maskBits(depthMask(z1, vld1q_u32((const uint32 *)(pz + 4)), depthFunc));
+	return mask0 | (mask1 << 4);
+}
+
+namespace {
+
+/** Pixel format dependent values, set up once per block. */
+struct Packer {
+	int32x4_t aLoss, rLoss, gLoss, bLoss;
+	int32x4_t aShift, rShift, gShift, bShift;
+
+	Packer(const Graphics::PixelFormat &format) {
+		// vshlq_u32() shifts right for negative counts
+		aLoss = vdupq_n_s32(-(int)format.aLoss);
+		rLoss = vdupq_n_s32(-(int)format.rLoss);
+		gLoss = vdupq_n_s32(-(int)format.gLoss);
+		bLoss = vdupq_n_s32(-(int)format.bLoss);
+		aShift = vdupq_n_s32(format.aShift);
+		rShift = vdupq_n_s32(format.rShift);
+		gShift = vdupq_n_s32(format.gShift);
+		bShift = vdupq_n_s32(format.bShift);
+	}
+
+	/** Compute four pixels the way PixelFormat::ARGBToColor() does. */
+	inline uint32x4_t pack(uint32x4_t a, uint32x4_t r, uint32x4_t g, uint32x4_t b) const {
+		return vorrq_u32(
+			vorrq_u32(vshlq_u32(vshlq_u32(a, aLoss), aShift), vshlq_u32(vshlq_u32(r, rLoss), rShift)),
+			vorrq_u32(vshlq_u32(vshlq_u32(g, gLoss), gShift), vshlq_u32(vshlq_u32(b, bLoss), bShift)));
+	}
+};
+
+} // End of anonymous namespace
+
+static void writeTextured8(const TexturedSpanBlock &block, const Graphics::PixelFormat &format) {
+	const Packer packer(format);
+	const uint32x4_t byteMask = vdupq_n_u32(0xFF);
+
+	uint32x4_t z = interpolate(block.z, block.dzdx);
+	uint32x4_t r = interpolate(block.r, block.drdx);
+	uint32x4_t g = interpolate(block.g, block.dgdx);
+	uint32x4_t b = interpolate(block.b, block.dbdx);
+	uint32x4_t a = interpolate(block.a, block.dadx);
+
+	uint32x4_t pixels[2], masks[2];
+	for (int i = 0; i < 2; i++) {
+		const uint32x4_t texel = vld1q_u32(block.texels + 4 * i);
+		pixels[i] = packer.pack(modulate(vshrq_n_u32(texel, 24), a),
+		                        modulate(vandq_u32(vshrq_n_u32(texel, 16), byteMask), r),
+		                        modulate(vandq_u32(vshrq_n_u32(texel, 8), byteMask), g),
+		                        modulate(vandq_u32(texel, byteMask), b));
+		masks[i] = laneMask(block.mask >> (4 * i));
+
+		if (block.depthWrite) {
+			uint32 *dst = (uint32 *)(block.pz + 4 * i);
+			vst1q_u32(dst, vbslq_u32(masks[i], z, vld1q_u32(dst)));
+		}
+
+		z = vaddq_u32(z, vdupq_n_u32(4 * (uint)block.dzdx));
+		r = vaddq_u32(r, vdupq_n_u32(4 * (uint)block.drdx));
+		g = vaddq_u32(g, vdupq_n_u32(4 * (uint)block.dgdx));
+		b = vaddq_u32(b, vdupq_n_u32(4 * (uint)block.dbdx));
+		a = vaddq_u32(a, vdupq_n_u32(4 * (uint)block.dadx));
+	}
+
+	if (format.bytesPerPixel == 4) {
+		for (int i = 0; i < 2; i++) {
+			uint32 *dst = (uint32 *)(block.pixels + 16 * i);
+			vst1q_u32(dst, vbslq_u32(masks[i], pixels[i], vld1q_u32(dst)));
+		}
+	} else {
+		const uint16x8_t pixels16 = vcombine_u16(vmovn_u32(pixels[0]), vmovn_u32(pixels[1]));
+		const uint16x8_t masks16 = vcombine_u16(vmovn_u32(masks[0]), vmovn_u32(masks[1]));
+		uint16 *dst = (uint16 *)block.pixels;
+		vst1q_u16(dst, vbslq_u16(masks16, pixels16, vld1q_u16(dst)));
+	}
+}
+
+const SpanKernels &getNEONSpanKernels() {
+	static const SpanKernels kernels = {
+		fillDepth,
+		testDepth8,
+		writeTextured8
+	};
+	return kernels;
+}
+
+} // end of namespace TinyGL
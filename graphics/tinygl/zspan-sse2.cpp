@@ -0,0 +1,188 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/tinygl/gl.h"
+#include "graphics/tinygl/zbuffer.h"
+#include "graphics/tinygl/zspan.h"
+
+#include <emmintrin.h>
+
+namespace TinyGL {
+
+/** Return the values of four consecutive pixels, starting at start. */
+static inline __m128i interpolate(uint start, int step) {
+	const uint s = step;
+	return _mm_add_epi32(_mm_set1_epi32(start), _mm_set_epi32(3 * s, 2 * s, s, 0));
+}
+
+static inline __m128i select(__m128i mask, __m128i a, __m128i b) {
+	return _mm_or_si128(_mm_and_si128(mask, a), _mm_andnot_si128(mask, b));
+}
+
+/** Compare four depth values with the depth buffer the way FrameBuffer::compareDepth() does. */
+static inline __m128i depthMask(__m128i z, __m128i zDst, int depthFunc) {
+	// SSE2 only compares signed values, so flip the sign bits first
+	const __m128i sign = _mm_set1_epi32((int)0x80000000);
+	const __m128i src = _mm_xor_si128(z, sign);
+	const __m128i dst = _mm_xor_si128(zDst, sign);
+	const __m128i all = _mm_set1_epi32(-1);
+
+	switch (depthFunc) {
+	case TGL_LESS:
+		return _mm_cmpgt_epi32(src, dst);
+	case TGL_EQUAL:
+		return _mm_cmpeq_epi32(src, dst);
+	case TGL_LEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(dst, src), all);
+	case TGL_GREATER:
+		return _mm_cmpgt_epi32(dst, src);
+	case TGL_NOTEQUAL:
+		return _mm_xor_si128(_mm_cmpeq_epi32(src, dst), all);
+	case TGL_GEQUAL:
+		return _mm_xor_si128(_mm_cmpgt_epi32(src, dst), all);
+	case TGL_ALWAYS:
+		return all;
+	default:
+		return _mm_setzero_si128();
+	}
+}
+
+/** Expand four bits of a pixel mask to lane masks. */
+static inline __m128i laneMask(uint bits) {
+	const __m128i lanes = _mm_set_epi32(8, 4, 2, 1);
+	return _mm_cmpeq_epi32(_mm_and_si128(_mm_set1_epi32(bits), lanes), lanes);
+}
+
+/** Modulate four texel components by interpolated color components. */
+static inline __m128i modulate(__m128i texel, __m128i color) {
+	// The result only depends on the low 16 bits of the product, and the
+	// upper halves of the lanes multiply to zero since texel < 256.
+	const __m128i light = _mm_srli_epi32(color, ZB_POINT_RED_BITS - 8);
+	return _mm_srli_epi32(_mm_mullo_epi16(texel, light), ZB_POINT_RED_BITS - 8);
+}
+
+static int fillDepth(uint *pz, uint z, int dzdx, int count, int depthFunc) {
+	const __m128i zStep = _mm_set1_epi32(4 * (uint)dzdx);
+	__m128i zSrc = interpolate(z, dzdx);
+
+	int done = 0;
+	for (; done + 4 <= count; done += 4) {
+		__m128i *dst = (__m128i *)(pz + done);
+		const __m128i zDst = _mm_loadu_si128(dst);
+		_mm_storeu_si128(dst, select(depthMask(zSrc, zDst, depthFunc), zSrc, zDst));
+		zSrc = _mm_add_epi32(zSrc, zStep);
+	}
+	return done;
+}
+
+static uint testDepth8(const uint *pz, uint z, int dzdx, int depthFunc) {
+	const __m128i z0 = interpolate(z, dzdx);
+	const __m128i z1 = _mm_add_epi32(z0, _mm_set1_epi32(4 * (uint)dzdx));
+	const uint mask0 = _mm_movemask_ps(_mm_castsi128_ps(depthMask(z0, _mm_loadu_si128((const __m128i *)pz), depthFunc)));
+	const uint mask1 = _mm_movemask_ps(_mm_castsi128_ps(depthMask(z1, _mm_loadu_si128((const __m128i *)(pz + 4)), depthFunc)));
+	return mask0 | (mask1 << 4);
+}
+
+namespace {
+
+/** Pixel format dependent values, set up once per block. */
+struct Packer {
+	__m128i aLoss, rLoss, gLoss, bLoss;
+	__m128i aShift, rShift, gShift, bShift;
+
+	Packer(const Graphics::PixelFormat &format) {
+		aLoss = _mm_cvtsi32_si128(format.aLoss);
+		rLoss = _mm_cvtsi32_si128(format.rLoss);
+		gLoss = _mm_cvtsi32_si128(format.gLoss);
+		bLoss = _mm_cvtsi32_si128(format.bLoss);
+		aShift = _mm_cvtsi32_si128(format.aShift);
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+	}
+
+	/** Compute four pixels the way PixelFormat::ARGBToColor() does. */
+	inline __m128i pack(__m128i a, __m128i r, __m128i g, __m128i b) const {
+		return _mm_or_si128(
+			_mm_or_si128(_mm_sll_epi32(_mm_srl_epi32(a, aLoss), aShift), _mm_sll_epi32(_mm_srl_epi32(r, rLoss), rShift)),
+			_mm_or_si128(_mm_sll_epi32(_mm_srl_epi32(g, gLoss), gShift), _mm_sll_epi32(_mm_srl_epi32(b, bLoss), bShift)));
+	}
+};
+
+} // End of anonymous namespace
+
+static void writeTextured8(const TexturedSpanBlock &block, const Graphics::PixelFormat &format) {
+	const Packer packer(format);
+	const __m128i byteMask = _mm_set1_epi32(0xFF);
+
+	__m128i z = interpolate(block.z, block.dzdx);
+	__m128i r = interpolate(block.r, block.drdx);
+	__m128i g = interpolate(block.g, block.dgdx);
+	__m128i b = interpolate(block.b, block.dbdx);
+	__m128i a = interpolate(block.a, block.dadx);
+
+	__m128i pixels[2], masks[2];
+	for (int i = 0; i < 2; i++) {
+		const __m128i texel = _mm_loadu_si128((const __m128i *)(block.texels + 4 * i));
+		pixels[i] = packer.pack(modulate(_mm_srli_epi32(texel, 24), a),
+		                        modulate(_mm_and_si128(_mm_srli_epi32(texel, 16), byteMask), r),
+		                        modulate(_mm_and_si128(_mm_srli_epi32(texel, 8), byteMask), g),
+		                        modulate(_mm_and_si128(texel, byteMask), b));
+		masks[i] = laneMask(block.mask >> (4 * i));
+
+		if (block.depthWrite) {
+			__m128i *dst = (__m128i *)(block.pz + 4 * i);
+			_mm_storeu_si128(dst, select(masks[i], z, _mm_loadu_si128(dst)));
+		}
+
+		z = _mm_add_epi32(z, _mm_set1_epi32(4 * (uint)block.dzdx));
+		r = _mm_add_epi32(r, _mm_set1_epi32(4 * (uint)block.drdx));
+		g = _mm_add_epi32(g, _mm_set1_epi32(4 * (uint)block.dgdx));
+		b = _mm_add_epi32(b, _mm_set1_epi32(4 * (uint)block.dbdx));
+		a = _mm_add_epi32(a, _mm_set1_epi32(4 * (uint)block.dadx));
+	}
+
+	if (format.bytesPerPixel == 4) {
+		for (int i = 0; i < 2; i++) {
+			__m128i *dst = (__m128i *)(block.pixels + 16 * i);
+			_mm_storeu_si128(dst, select(masks[i], pixels[i], _mm_loadu_si128(dst)));
+		}
+	} else {
+		// Sign extend the low halves of the pixels, so that the saturating
+		// pack keeps them as they are.
+		const __m128i pixels16 = _mm_packs_epi32(_mm_srai_epi32(_mm_slli_epi32(pixels[0], 16), 16),
+		                                         _mm_srai_epi32(_mm_slli_epi32(pixels[1], 16), 16));
+		const __m128i masks16 = _mm_packs_epi32(masks[0], masks[1]);
+		__m128i *dst = (__m128i *)block.pixels;
+		_mm_storeu_si128(dst, select(masks16, pixels16, _mm_loadu_si128(dst)));
+	}
+}
+
+const SpanKernels &getSSE2SpanKernels() {
+	static const SpanKernels kernels = {
+		fillDepth,
+		testDepth8,
+		writeTextured8
+	};
+	return kernels;
+}
+
+} // end of namespace TinyGL
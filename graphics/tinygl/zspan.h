@@ -0,0 +1,88 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_TINYGL_ZSPAN_H
+#define GRAPHICS_TINYGL_ZSPAN_H
+
+#include "graphics/pixelformat.h"
+
+namespace TinyGL {
+
+/**
+ * Eight consecutive pixels of a textured scan line.
+ *
+ * The interpolated values are those of the first pixel. They are stepped
+ * from one pixel to the next the same way the scalar rasterizer does.
+ */
+struct TexturedSpanBlock {
+	byte *pixels;         ///< Color buffer at the first pixel
+	uint *pz;             ///< Depth buffer at the first pixel
+	const uint32 *texels; ///< Texel color of each pixel, with alpha, red, green and blue from the highest byte down
+	uint mask;            ///< Bit i is set if pixel i is to be written
+	uint z, r, g, b, a;
+	int dzdx, drdx, dgdx, dbdx, dadx;
+	bool depthWrite;
+};
+
+/**
+ * Vectorized scan line routines used by the triangle rasterizer.
+ *
+ * They produce the same output as the scalar code in ztriangle.cpp, for
+ * color buffers using 2 or 4 bytes per pixel. Stencil test, alpha test,
+ * blending and the scissor rectangle are left to the caller.
+ */
+struct SpanKernels {
+	/**
+	 * Test the depth of count pixels against the depth buffer, and write
+	 * the depth of the pixels which pass. Handles as many pixels from the
+	 * start of the span as it can in whole blocks, and returns their number.
+	 */
+	int (*fillDepth)(uint *pz, uint z, int dzdx, int count, int depthFunc);
+	/**
+	 * Test the depth of eight pixels against the depth buffer, and return
+	 * a mask with bit i set if pixel i passes.
+	 */
+	uint (*testDepth8)(const uint *pz, uint z, int dzdx, int depthFunc);
+	/**
+	 * Modulate the texel colors of eight pixels by their interpolated
+	 * color and write the pixels selected by the block mask, along with
+	 * their depth if requested.
+	 */
+	void (*writeTextured8)(const TexturedSpanBlock &block, const Graphics::PixelFormat &format);
+};
+
+/**
+ * Return the vectorized scan line routines supported by the host CPU, or
+ * nullptr if there are none.
+ */
+const SpanKernels *getSpanKernels();
+
+#ifdef SCUMMVM_SSE2
+const SpanKernels &getSSE2SpanKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const SpanKernels &getNEONSpanKernels();
+#endif
+
+} // end of namespace TinyGL
+
+#endif
@@ -395,7 +395,9 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 		// we draw all the scan line of the part
 		while (nb_lines > 0) {
 			int x = x1;
-			if (!kInterpRGB) {
+			if (kEnableScissor && (y < _clipRectangle.top || y >= _clipRectangle.bottom)) {
+				// The whole scan line is outside of the scissor rectangle
+			} else if (!kInterpRGB) {
 				int n;
 				uint *pz;
 				byte *ps = nullptr;
@@ -408,6 +410,24 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 				if (kStencilEnabled) {
 					ps = ps1 + x1;
 				}
+				if (kInterpZ && kDepthWrite && !kStencilEnabled && _spanKernels) {
+					// The pixels outside of the scissor rectangle are left alone,
+					// so only hand the ones inside of it to the vectorized code
+					int first = x, last = x + n + 1;
+					if (kEnableScissor) {
+						first = MAX<int>(first, _clipRectangle.left);
+						last = MIN<int>(last, _clipRectangle.right);
+					}
+					if (last - first >= 4) {
+						const uint skipped = first - x;
+						const int done = skipped + _spanKernels->fillDepth(pz + skipped, z + skipped * dzdx, dzdx, last - first,
+						                                                   kDepthTestEnabled ? _depthFunc : TGL_ALWAYS);
+						pz += done;
+						z += (uint)done * dzdx;
+						n -= done;
+						x += done;
+					}
+				}
 				while (n >= 3) {
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 0, x, y, z, dzdx);
 					putPixelDepth<kDepthWrite, kEnableScissor, kStencilEnabled, kDepthTestEnabled>(pz, ps, 1, x, y, z, dzdx);
@@ -517,9 +537,54 @@ void FrameBuffer::fillTriangle(ZBufferPoint *p0, ZBufferPoint *p1, ZBufferPoint
 						fz += fndzdx;
 						zinv = (float)(1.0 / fz);
 					}
-					for (int _a = 0; _a < NB_INTERP; _a++) {
-						putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
-						               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+					if (kInterpZ && !kAlphaTestEnabled && !kBlendingEnabled && !kStencilEnabled && _spanKernels) {
+						// Only fetch the texels of the visible pixels, the vectorized
+						// code does the rest
+						TexturedSpanBlock block;
+						uint32 texels[NB_INTERP];
+						block.mask = kDepthTestEnabled ? _spanKernels->testDepth8(pz, z, dzdx, _depthFunc) : 0xFF;
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							if (kEnableScissor && scissorPixel(x + _a, y)) {
+								block.mask &= ~(1 << _a);
+							}
+							texels[_a] = 0;
+							if (block.mask & (1 << _a)) {
+								uint8 c_a, c_r, c_g, c_b;
+								texture->getARGBAt(_wrapS, _wrapT, s, t, c_a, c_r, c_g, c_b);
+								texels[_a] = ((uint32)c_a << 24) | (c_r << 16) | (c_g << 8) | c_b;
+							}
+							s += dsdx;
+							t += dtdx;
+						}
+						if (block.mask) {
+							block.pixels = _pbuf.getRawBuffer(pp);
+							block.pz = pz;
+							block.texels = texels;
+							block.z = z;
+							block.r = r;
+							block.g = g;
+							block.b = b;
+							block.a = a;
+							block.dzdx = dzdx;
+							block.drdx = drdx;
+							block.dgdx = dgdx;
+							block.dbdx = dbdx;
+							block.dadx = dadx;
+							block.depthWrite = kDepthWrite;
+							_spanKernels->writeTextured8(block, _pbufFormat);
+						}
+						z += (uint)NB_INTERP * dzdx;
+						if (kSmoothMode) {
+							a += (uint)NB_INTERP * dadx;
+							r += (uint)NB_INTERP * drdx;
+							g += (uint)NB_INTERP * dgdx;
+							b += (uint)NB_INTERP * dbdx;
+						}
+					} else {
+						for (int _a = 0; _a < NB_INTERP; _a++) {
+							putPixelTexture<kDepthWrite, kInterpRGB, kSmoothMode, kAlphaTestEnabled, kEnableScissor, kBlendingEnabled, kStencilEnabled, kDepthTestEnabled>
+							               (pp, texture, _wrapS, _wrapT, pz, ps, _a, x, y, z, t, s, r, g, b, a, dzdx, dsdx, dtdx, drdx, dgdx, dbdx, dadx);
+						}
 					}
 					pp += NB_INTERP;
 					if (kInterpZ) {
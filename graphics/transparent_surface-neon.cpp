@@ -0,0 +1,151 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/transparent_surface_intern.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+/** Load four source pixels, in blitting order. */
+static inline uint32x4_t loadPixels(const byte *in, int32 inStep) {
+	if (inStep > 0)
+		return vreinterpretq_u32_u8(vld1q_u8(in));
+
+	// The pixels are stored backwards for horizontally flipped blits
+	const uint32x4_t pixels = vrev64q_u32(vreinterpretq_u32_u8(vld1q_u8(in - 12)));
+	return vcombine_u32(vget_high_u32(pixels), vget_low_u32(pixels));
+}
+
+/** Extract the alpha value of four pixels. */
+static inline uint32x4_t extractAlpha(uint32x4_t color) {
+	const uint32x4_t mask = vdupq_n_u32(0xFF);
+	// Shifting left by a negative amount shifts right
+	return vandq_u32(vshlq_u32(color, vdupq_n_s32(-kAIndex * 8)), mask);
+}
+
+/**
+ * Finish four blended pixels: make them opaque, and keep the destination
+ * pixels where the blending weight was zero.
+ */
+static inline uint8x16_t finishPixels(uint16x8_t blendLo, uint16x8_t blendHi, uint32x4_t alpha, uint8x16_t dst) {
+	const uint8x16_t opaque = vreinterpretq_u8_u32(vdupq_n_u32(0xFFu << (kAIndex * 8)));
+
+	const uint8x16_t blended = vorrq_u8(vcombine_u8(vmovn_u16(blendLo), vmovn_u16(blendHi)), opaque);
+	const uint8x16_t keep = vreinterpretq_u8_u32(vceqq_u32(alpha, vdupq_n_u32(0)));
+
+	return vbslq_u8(keep, dst, blended);
+}
+
+static void blendRowNEON(byte *out, const byte *in, uint32 width, int32 inStep) {
+	const uint16x8_t full = vdupq_n_u16(255);
+	const uint32 blocks = width / 4;
+
+	for (uint32 i = 0; i < blocks; i++) {
+		const uint32x4_t src = loadPixels(in, inStep);
+		const uint8x16_t dst = vld1q_u8(out);
+
+		// Copy the alpha value of each pixel to all four of its bytes
+		const uint32x4_t alpha = extractAlpha(src);
+		const uint8x16_t alphaBytes = vreinterpretq_u8_u32(vmulq_n_u32(alpha, 0x01010101));
+
+		const uint8x16_t srcBytes = vreinterpretq_u8_u32(src);
+		const uint16x8_t srcLo = vmovl_u8(vget_low_u8(srcBytes));
+		const uint16x8_t srcHi = vmovl_u8(vget_high_u8(srcBytes));
+		const uint16x8_t dstLo = vmovl_u8(vget_low_u8(dst));
+		const uint16x8_t dstHi = vmovl_u8(vget_high_u8(dst));
+		const uint16x8_t alphaLo = vmovl_u8(vget_low_u8(alphaBytes));
+		const uint16x8_t alphaHi = vmovl_u8(vget_high_u8(alphaBytes));
+
+		// (in * a + out * (255 - a)) >> 8, which cannot exceed 16 bits
+		const uint16x8_t blendLo = vshrq_n_u16(vmlaq_u16(vmulq_u16(srcLo, alphaLo), dstLo, vsubq_u16(full, alphaLo)), 8);
+		const uint16x8_t blendHi = vshrq_n_u16(vmlaq_u16(vmulq_u16(srcHi, alphaHi), dstHi, vsubq_u16(full, alphaHi)), 8);
+
+		vst1q_u8(out, finishPixels(blendLo, blendHi, alpha, dst));
+
+		in += inStep * 4;
+		out += 16;
+	}
+
+	getScalarTransparentBlitKernels().blendRow(out, in, width % 4, inStep);
+}
+
+/** Return the upper 16 bits of the products of the given 16-bit values. */
+static inline uint16x8_t mulHigh(uint16x8_t a, uint16x8_t b) {
+	return vcombine_u16(vshrn_n_u32(vmull_u16(vget_low_u16(a), vget_low_u16(b)), 16),
+	                    vshrn_n_u32(vmull_u16(vget_high_u16(a), vget_high_u16(b)), 16));
+}
+
+static void blendRowTintedNEON(byte *out, const byte *in, uint32 width, int32 inStep, uint32 color) {
+	const uint16x8_t full = vdupq_n_u16(255);
+	const uint32 ca = (color >> kAModShift) & 0xFF;
+
+	// The color modulation for each component, the alpha value is replaced
+	uint16 mod[8];
+	mod[kAIndex] = 0;
+	mod[kRIndex] = (color >> kRModShift) & 0xFF;
+	mod[kGIndex] = (color >> kGModShift) & 0xFF;
+	mod[kBIndex] = (color >> kBModShift) & 0xFF;
+	for (int i = 4; i < 8; i++)
+		mod[i] = mod[i - 4];
+	const uint16x8_t cmod = vld1q_u16(mod);
+
+	const uint32 blocks = width / 4;
+
+	for (uint32 i = 0; i < blocks; i++) {
+		const uint32x4_t src = loadPixels(in, inStep);
+		const uint8x16_t dst = vld1q_u8(out);
+
+		const uint32x4_t alpha = vshrq_n_u32(vmulq_n_u32(extractAlpha(src), ca), 8);
+		const uint8x16_t alphaBytes = vreinterpretq_u8_u32(vmulq_n_u32(alpha, 0x01010101));
+
+		const uint8x16_t srcBytes = vreinterpretq_u8_u32(src);
+		const uint16x8_t srcLo = vmovl_u8(vget_low_u8(srcBytes));
+		const uint16x8_t srcHi = vmovl_u8(vget_high_u8(srcBytes));
+		const uint16x8_t dstLo = vmovl_u8(vget_low_u8(dst));
+		const uint16x8_t dstHi = vmovl_u8(vget_high_u8(dst));
+		const uint16x8_t alphaLo = vmovl_u8(vget_low_u8(alphaBytes));
+		const uint16x8_t alphaHi = vmovl_u8(vget_high_u8(alphaBytes));
+
+		// (out * (255 - a) >> 8) + (in * a * c >> 16)
+		const uint16x8_t blendLo = vaddq_u16(vshrq_n_u16(vmulq_u16(dstLo, vsubq_u16(full, alphaLo)), 8),
+		                                     mulHigh(vmulq_u16(srcLo, alphaLo), cmod));
+		const uint16x8_t blendHi = vaddq_u16(vshrq_n_u16(vmulq_u16(dstHi, vsubq_u16(full, alphaHi)), 8),
+		                                     mulHigh(vmulq_u16(srcHi, alphaHi), cmod));
+
+		vst1q_u8(out, finishPixels(blendLo, blendHi, alpha, dst));
+
+		in += inStep * 4;
+		out += 16;
+	}
+
+	getScalarTransparentBlitKernels().blendRowTinted(out, in, width % 4, inStep, color);
+}
+
+const TransparentBlitKernels &getNEONTransparentBlitKernels() {
+	static const TransparentBlitKernels kernels = {
+		blendRowNEON,
+		blendRowTintedNEON
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,138 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/transparent_surface_intern.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+static const int kAlphaShuffle = _MM_SHUFFLE(kAIndex, kAIndex, kAIndex, kAIndex);
+
+/** Load four source pixels, in blitting order. */
+static inline __m128i loadPixels(const byte *in, int32 inStep) {
+	if (inStep > 0)
+		return _mm_loadu_si128((const __m128i *)in);
+
+	// The pixels are stored backwards for horizontally flipped blits
+	return _mm_shuffle_epi32(_mm_loadu_si128((const __m128i *)(in - 12)), _MM_SHUFFLE(0, 1, 2, 3));
+}
+
+/** Copy the alpha value of each pixel to all four of its 16-bit components. */
+static inline __m128i broadcastAlpha(__m128i color) {
+	return _mm_shufflehi_epi16(_mm_shufflelo_epi16(color, kAlphaShuffle), kAlphaShuffle);
+}
+
+/**
+ * Finish four blended pixels: make them opaque, and keep the destination
+ * pixels where the blending weight was zero.
+ */
+static inline __m128i finishPixels(__m128i blendLo, __m128i blendHi, __m128i alphaLo, __m128i alphaHi, __m128i dst) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i opaque = _mm_set1_epi32((int)(0xFFu << (kAIndex * 8)));
+
+	const __m128i blended = _mm_or_si128(_mm_packus_epi16(blendLo, blendHi), opaque);
+	const __m128i keep = _mm_packs_epi16(_mm_cmpeq_epi16(alphaLo, zero), _mm_cmpeq_epi16(alphaHi, zero));
+
+	return _mm_or_si128(_mm_and_si128(keep, dst), _mm_andnot_si128(keep, blended));
+}
+
+static void blendRowSSE2(byte *out, const byte *in, uint32 width, int32 inStep) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i full = _mm_set1_epi16(255);
+	const uint32 blocks = width / 4;
+
+	for (uint32 i = 0; i < blocks; i++) {
+		const __m128i src = loadPixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		const __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		const __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+		const __m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+		const __m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+		const __m128i alphaLo = broadcastAlpha(srcLo);
+		const __m128i alphaHi = broadcastAlpha(srcHi);
+
+		// (in * a + out * (255 - a)) >> 8, which cannot exceed 16 bits
+		const __m128i blendLo = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(srcLo, alphaLo),
+		                                                     _mm_mullo_epi16(dstLo, _mm_sub_epi16(full, alphaLo))), 8);
+		const __m128i blendHi = _mm_srli_epi16(_mm_add_epi16(_mm_mullo_epi16(srcHi, alphaHi),
+		                                                     _mm_mullo_epi16(dstHi, _mm_sub_epi16(full, alphaHi))), 8);
+
+		_mm_storeu_si128((__m128i *)out, finishPixels(blendLo, blendHi, alphaLo, alphaHi, dst));
+
+		in += inStep * 4;
+		out += 16;
+	}
+
+	getScalarTransparentBlitKernels().blendRow(out, in, width % 4, inStep);
+}
+
+static void blendRowTintedSSE2(byte *out, const byte *in, uint32 width, int32 inStep, uint32 color) {
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i full = _mm_set1_epi16(255);
+	const __m128i ca = _mm_set1_epi16((color >> kAModShift) & 0xFF);
+
+	// The color modulation for each component, the alpha value is replaced
+	int16 mod[4];
+	mod[kAIndex] = 0;
+	mod[kRIndex] = (color >> kRModShift) & 0xFF;
+	mod[kGIndex] = (color >> kGModShift) & 0xFF;
+	mod[kBIndex] = (color >> kBModShift) & 0xFF;
+	const __m128i cmod = _mm_setr_epi16(mod[0], mod[1], mod[2], mod[3], mod[0], mod[1], mod[2], mod[3]);
+
+	const uint32 blocks = width / 4;
+
+	for (uint32 i = 0; i < blocks; i++) {
+		const __m128i src = loadPixels(in, inStep);
+		const __m128i dst = _mm_loadu_si128((const __m128i *)out);
+
+		const __m128i srcLo = _mm_unpacklo_epi8(src, zero);
+		const __m128i srcHi = _mm_unpackhi_epi8(src, zero);
+		const __m128i dstLo = _mm_unpacklo_epi8(dst, zero);
+		const __m128i dstHi = _mm_unpackhi_epi8(dst, zero);
+		const __m128i alphaLo = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(srcLo), ca), 8);
+		const __m128i alphaHi = _mm_srli_epi16(_mm_mullo_epi16(broadcastAlpha(srcHi), ca), 8);
+
+		// (out * (255 - a) >> 8) + (in * a * c >> 16)
+		const __m128i blendLo = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(dstLo, _mm_sub_epi16(full, alphaLo)), 8),
+		                                      _mm_mulhi_epu16(_mm_mullo_epi16(srcLo, alphaLo), cmod));
+		const __m128i blendHi = _mm_add_epi16(_mm_srli_epi16(_mm_mullo_epi16(dstHi, _mm_sub_epi16(full, alphaHi)), 8),
+		                                      _mm_mulhi_epu16(_mm_mullo_epi16(srcHi, alphaHi), cmod));
+
+		_mm_storeu_si128((__m128i *)out, finishPixels(blendLo, blendHi, alphaLo, alphaHi, dst));
+
+		in += inStep * 4;
+		out += 16;
+	}
+
+	getScalarTransparentBlitKernels().blendRowTinted(out, in, width % 4, inStep, color);
+}
+
+const TransparentBlitKernels &getSSE2TransparentBlitKernels() {
+	static const TransparentBlitKernels kernels = {
+		blendRowSSE2,
+		blendRowTintedSSE2
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
@@ -20,38 +20,21 @@
  */
 
 
-
 #include "common/algorithm.h"
 #include "common/endian.h"
 #include "common/util.h"
 #include "common/rect.h"
 #include "common/math.h"
+#include "common/cpu.h"
 #include "common/textconsole.h"
 #include "graphics/conversion.h"
 #include "graphics/primitives.h"
 #include "graphics/transparent_surface.h"
+#include "graphics/transparent_surface_intern.h"
 #include "graphics/transform_tools.h"
 
 namespace Graphics {
 
-static const int kBModShift = 8;//img->format.bShift;
-static const int kGModShift = 16;//img->format.gShift;
-static const int kRModShift = 24;//img->format.rShift;
-static const int kAModShift = 0;//img->format.aShift;
-
-#ifdef SCUMM_LITTLE_ENDIAN
-static const int kAIndex = 0;
-static const int kBIndex = 1;
-static const int kGIndex = 2;
-static const int kRIndex = 3;
-
-#else
-static const int kAIndex = 3;
-static const int kBIndex = 2;
-static const int kGIndex = 1;
-static const int kRIndex = 0;
-#endif
-
 void doBlitOpaqueFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep);
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color);
@@ -124,6 +107,68 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
 	}
 }
 
+static void blendRowScalar(byte *out, const byte *in, uint32 width, int32 inStep) {
+	for (uint32 j = 0; j < width; j++) {
+
+		if (in[kAIndex] != 0) {
+			out[kAIndex] = 255;
+			out[kRIndex] = ((in[kRIndex] * in[kAIndex]) + out[kRIndex] * (255 - in[kAIndex])) >> 8;
+			out[kGIndex] = ((in[kGIndex] * in[kAIndex]) + out[kGIndex] * (255 - in[kAIndex])) >> 8;
+			out[kBIndex] = ((in[kBIndex] * in[kAIndex]) + out[kBIndex] * (255 - in[kAIndex])) >> 8;
+		}
+
+		in += inStep;
+		out += 4;
+	}
+}
+
+static void blendRowTintedScalar(byte *out, const byte *in, uint32 width, int32 inStep, uint32 color) {
+	byte ca = (color >> kAModShift) & 0xFF;
+	byte cr = (color >> kRModShift) & 0xFF;
+	byte cg = (color >> kGModShift) & 0xFF;
+	byte cb = (color >> kBModShift) & 0xFF;
+
+	for (uint32 j = 0; j < width; j++) {
+
+		uint32 ina = in[kAIndex] * ca >> 8;
+
+		if (ina != 0) {
+			out[kAIndex] = 255;
+			out[kBIndex] = (out[kBIndex] * (255 - ina) >> 8);
+			out[kGIndex] = (out[kGIndex] * (255 - ina) >> 8);
+			out[kRIndex] = (out[kRIndex] * (255 - ina) >> 8);
+
+			out[kBIndex] = out[kBIndex] + (in[kBIndex] * ina * cb >> 16);
+			out[kGIndex] = out[kGIndex] + (in[kGIndex] * ina * cg >> 16);
+			out[kRIndex] = out[kRIndex] + (in[kRIndex] * ina * cr >> 16);
+		}
+
+		in += inStep;
+		out += 4;
+	}
+}
+
+const TransparentBlitKernels &getScalarTransparentBlitKernels() {
+	static const TransparentBlitKernels kernels = {
+		blendRowScalar,
+		blendRowTintedScalar
+	};
+	return kernels;
+}
+
+const TransparentBlitKernels &getTransparentBlitKernels() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return getSSE2TransparentBlitKernels();
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return getNEONTransparentBlitKernels();
+#endif
+
+	return getScalarTransparentBlitKernels();
+}
+
 /**
  * Optimized version of doBlit to be used with alpha blended blitting
  * @param ino a pointer to the input surface
@@ -136,60 +181,15 @@ void doBlitBinaryFast(byte *ino, byte *outo, uint32 width, uint32 height, uint32
  * @color colormod in 0xAARRGGBB format - 0xFFFFFFFF for no colormod
  */
 void doBlitAlphaBlend(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color) {
-	byte *in;
-	byte *out;
-
-	if (color == 0xffffffff) {
-
-		for (uint32 i = 0; i < height; i++) {
-			out = outo;
-			in = ino;
-			for (uint32 j = 0; j < width; j++) {
-
-				if (in[kAIndex] != 0) {
-					out[kAIndex] = 255;
-					out[kRIndex] = ((in[kRIndex] * in[kAIndex]) + out[kRIndex] * (255 - in[kAIndex])) >> 8;
-					out[kGIndex] = ((in[kGIndex] * in[kAIndex]) + out[kGIndex] * (255 - in[kAIndex])) >> 8;
-					out[kBIndex] = ((in[kBIndex] * in[kAIndex]) + out[kBIndex] * (255 - in[kAIndex])) >> 8;
-				}
-
-				in += inStep;
-				out += 4;
-			}
-			outo += pitch;
-			ino += inoStep;
-		}
-	} else {
+	const TransparentBlitKernels &kernels = getTransparentBlitKernels();
 
-		byte ca = (color >> kAModShift) & 0xFF;
-		byte cr = (color >> kRModShift) & 0xFF;
-		byte cg = (color >> kGModShift) & 0xFF;
-		byte cb = (color >> kBModShift) & 0xFF;
-
-		for (uint32 i = 0; i < height; i++) {
-			out = outo;
-			in = ino;
-			for (uint32 j = 0; j < width; j++) {
-
-				uint32 ina = in[kAIndex] * ca >> 8;
-
-				if (ina != 0) {
-					out[kAIndex] = 255;
-					out[kBIndex] = (out[kBIndex] * (255 - ina) >> 8);
-					out[kGIndex] = (out[kGIndex] * (255 - ina) >> 8);
-					out[kRIndex] = (out[kRIndex] * (255 - ina) >> 8);
-
-					out[kBIndex] = out[kBIndex] + (in[kBIndex] * ina * cb >> 16);
-					out[kGIndex] = out[kGIndex] + (in[kGIndex] * ina * cg >> 16);
-					out[kRIndex] = out[kRIndex] + (in[kRIndex] * ina * cr >> 16);
-				}
-
-				in += inStep;
-				out += 4;
-			}
-			outo += pitch;
-			ino += inoStep;
-		}
+	for (uint32 i = 0; i < height; i++) {
+		if (color == 0xffffffff)
+			kernels.blendRow(outo, ino, width, inStep);
+		else
+			kernels.blendRowTinted(outo, ino, width, inStep, color);
+		outo += pitch;
+		ino += inoStep;
 	}
 }
 
@@ -391,154 +391,35 @@ void doBlitMultiplyBlend(byte *ino, byte *outo, uint32 width, uint32 height, uin
 
 }
 
-Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, TSpriteBlendMode blendMode) {
-
-	Common::Rect retSize;
-	retSize.top = 0;
-	retSize.left = 0;
-	retSize.setWidth(0);
-	retSize.setHeight(0);
-	// Check if we need to draw anything at all
-	int ca = (color >> kAModShift) & 0xff;
-
-	if (ca == 0) {
-		return retSize;
-	}
-
-	// Create an encapsulating surface for the data
-	TransparentSurface srcImage(*this, false);
-	// TODO: Is the data really in the screen format?
-	if (format.bytesPerPixel != 4) {
-		warning("TransparentSurface can only blit 32bpp images, but got %d", format.bytesPerPixel * 8);
-		return retSize;
-	}
-
-	if (pPartRect) {
-
-		int xOffset = pPartRect->left;
-		int yOffset = pPartRect->top;
-
-		if (flipping & FLIP_V) {
-			yOffset = srcImage.h - pPartRect->bottom;
-		}
-
-		if (flipping & FLIP_H) {
-			xOffset = srcImage.w - pPartRect->right;
-		}
-
-		srcImage.pixels = getBasePtr(xOffset, yOffset);
-		srcImage.w = pPartRect->width();
-		srcImage.h = pPartRect->height();
-
-		debug(6, "Blit(%d, %d, %d, [%d, %d, %d, %d], %08x, %d, %d)", posX, posY, flipping,
-			  pPartRect->left,  pPartRect->top, pPartRect->width(), pPartRect->height(), color, width, height);
-	} else {
-
-		debug(6, "Blit(%d, %d, %d, [%d, %d, %d, %d], %08x, %d, %d)", posX, posY, flipping, 0, 0,
-			  srcImage.w, srcImage.h, color, width, height);
-	}
-
-	if (width == -1) {
-		width = srcImage.w;
-	}
-	if (height == -1) {
-		height = srcImage.h;
-	}
-
-#ifdef SCALING_TESTING
-	// Hardcode scaling to 66% to test scaling
-	width = width * 2 / 3;
-	height = height * 2 / 3;
-#endif
-
-	Graphics::Surface *img = nullptr;
-	Graphics::Surface *imgScaled = nullptr;
-	byte *savedPixels = nullptr;
-	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
+/**
+ * Blit using the routine for the given blend mode and alpha type.
+ */
+static void doBlit(byte *ino, byte *outo, uint32 width, uint32 height, uint32 pitch, int32 inStep, int32 inoStep, uint32 color, TSpriteBlendMode blendMode, AlphaType alphaMode) {
+	if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && alphaMode == ALPHA_OPAQUE) {
+		doBlitOpaqueFast(ino, outo, width, height, pitch, inStep, inoStep);
+	} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && alphaMode == ALPHA_BINARY) {
+		doBlitBinaryFast(ino, outo, width, height, pitch, inStep, inoStep);
 	} else {
-		img = &srcImage;
-	}
-
-	// Handle off-screen clipping
-	if (posY < 0) {
-		img->h = MAX(0, (int)img->h - -posY);
-		if (!(flipping & FLIP_V))
-			img->setPixels((byte *)img->getBasePtr(0, -posY));
-		posY = 0;
-	}
-
-	if (posX < 0) {
-		img->w = MAX(0, (int)img->w - -posX);
-		if (!(flipping & FLIP_H))
-			img->setPixels((byte *)img->getBasePtr(-posX, 0));
-		posX = 0;
-	}
-
-	if (img->w > target.w - posX) {
-		if (flipping & FLIP_H)
-			img->setPixels((byte *)img->getBasePtr(img->w - target.w + posX, 0));
-		img->w = CLIP((int)img->w, 0, (int)MAX((int)target.w - posX, 0));
-	}
-
-	if (img->h > target.h - posY) {
-		if (flipping & FLIP_V)
-			img->setPixels((byte *)img->getBasePtr(0, img->h - target.h + posY));
-		img->h = CLIP((int)img->h, 0, (int)MAX((int)target.h - posY, 0));
-	}
-
-	// Flip surface
-	if ((img->w > 0) && (img->h > 0)) {
-		int xp = 0, yp = 0;
-
-		int inStep = 4;
-		int inoStep = img->pitch;
-		if (flipping & FLIP_H) {
-			inStep = -inStep;
-			xp = img->w - 1;
-		}
-
-		if (flipping & FLIP_V) {
-			inoStep = -inoStep;
-			yp = img->h - 1;
-		}
-
-		byte *ino = (byte *)img->getBasePtr(xp, yp);
-		byte *outo = (byte *)target.getBasePtr(posX, posY);
-
-		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
+		if (blendMode == BLEND_ADDITIVE) {
+			doBlitAdditiveBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_SUBTRACTIVE) {
+			doBlitSubtractiveBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
+		} else if (blendMode == BLEND_MULTIPLY) {
+			doBlitMultiplyBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
 		} else {
-			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else {
-				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			}
+			assert(blendMode == BLEND_NORMAL);
+			doBlitAlphaBlend(ino, outo, width, height, pitch, inStep, inoStep, color);
 		}
-
-	}
-
-	retSize.setWidth(img->w);
-	retSize.setHeight(img->h);
-
-	if (imgScaled) {
-		imgScaled->setPixels(savedPixels);
-		imgScaled->free();
-		delete imgScaled;
 	}
+}
 
-	return retSize;
+Common::Rect TransparentSurface::blit(Graphics::Surface &target, int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, TSpriteBlendMode blendMode) {
+	return blitClip(target, Common::Rect(target.w, target.h), posX, posY, flipping, pPartRect, color, width, height, blendMode);
 }
 
+// The number of scaled pixels which are blitted at once
+static const int kScaleChunkSize = 256;
+
 Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rect clippingArea, int posX, int posY, int flipping, Common::Rect *pPartRect, uint color, int width, int height, TSpriteBlendMode blendMode) {
 	Common::Rect retSize;
 	retSize.top = 0;
@@ -598,90 +479,85 @@ Common::Rect TransparentSurface::blitClip(Graphics::Surface &target, Common::Rec
 	height = height * 2 / 3;
 #endif
 
-	Graphics::Surface *img = nullptr;
-	Graphics::Surface *imgScaled = nullptr;
-	byte *savedPixels = nullptr;
-	if ((width != srcImage.w) || (height != srcImage.h)) {
-		// Scale the image
-		img = imgScaled = srcImage.scale(width, height);
-		savedPixels = (byte *)img->getPixels();
-	} else {
-		img = &srcImage;
-	}
+	// The visible part of the scaled image. Scaled images are not created
+	// beforehand; instead, the visible pixels are scaled row by row as they
+	// are blitted.
+	int xOffset = 0, yOffset = 0;
+	int visibleW = width, visibleH = height;
 
 	// Handle off-screen clipping
 	if (posY < clippingArea.top) {
-		img->h = MAX(0, (int)img->h - (clippingArea.top - posY));
+		visibleH = MAX(0, visibleH - (clippingArea.top - posY));
 		if (!(flipping & FLIP_V))
-			img->setPixels((byte *)img->getBasePtr(0, clippingArea.top - posY));
+			yOffset += clippingArea.top - posY;
 		posY = clippingArea.top;
 	}
 
 	if (posX < clippingArea.left) {
-		img->w = MAX(0, (int)img->w - (clippingArea.left - posX));
+		visibleW = MAX(0, visibleW - (clippingArea.left - posX));
 		if (!(flipping & FLIP_H))
-			img->setPixels((byte *)img->getBasePtr(clippingArea.left - posX, 0));
+			xOffset += clippingArea.left - posX;
 		posX = clippingArea.left;
 	}
 
-	if (img->w > clippingArea.right - posX) {
+	if (visibleW > clippingArea.right - posX) {
 		if (flipping & FLIP_H)
-			img->setPixels((byte *)img->getBasePtr(img->w - clippingArea.right + posX, 0));
-		img->w = CLIP((int)img->w, 0, (int)MAX((int)clippingArea.right - posX, 0));
+			xOffset += visibleW - clippingArea.right + posX;
+		visibleW = CLIP(visibleW, 0, (int)MAX((int)clippingArea.right - posX, 0));
 	}
 
-	if (img->h > clippingArea.bottom - posY) {
+	if (visibleH > clippingArea.bottom - posY) {
 		if (flipping & FLIP_V)
-			img->setPixels((byte *)img->getBasePtr(0, img->h - clippingArea.bottom + posY));
-		img->h = CLIP((int)img->h, 0, (int)MAX((int)clippingArea.bottom - posY, 0));
+			yOffset += visibleH - clippingArea.bottom + posY;
+		visibleH = CLIP(visibleH, 0, (int)MAX((int)clippingArea.bottom - posY, 0));
 	}
 
 	// Flip surface
-	if ((img->w > 0) && (img->h > 0)) {
-		int xp = 0, yp = 0;
+	if ((visibleW > 0) && (visibleH > 0)) {
+		byte *outo = (byte *)target.getBasePtr(posX, posY);
 
-		int inStep = 4;
-		int inoStep = img->pitch;
-		if (flipping & FLIP_H) {
-			inStep = -inStep;
-			xp = img->w - 1;
-		}
+		if ((width == srcImage.w) && (height == srcImage.h)) {
+			int xp = xOffset, yp = yOffset;
 
-		if (flipping & FLIP_V) {
-			inoStep = -inoStep;
-			yp = img->h - 1;
-		}
+			int inStep = 4;
+			int inoStep = srcImage.pitch;
+			if (flipping & FLIP_H) {
+				inStep = -inStep;
+				xp += visibleW - 1;
+			}
 
-		byte *ino = (byte *)img->getBasePtr(xp, yp);
-		byte *outo = (byte *)target.getBasePtr(posX, posY);
+			if (flipping & FLIP_V) {
+				inoStep = -inoStep;
+				yp += visibleH - 1;
+			}
 
-		if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_OPAQUE) {
-			doBlitOpaqueFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
-		} else if (color == 0xFFFFFFFF && blendMode == BLEND_NORMAL && _alphaMode == ALPHA_BINARY) {
-			doBlitBinaryFast(ino, outo, img->w, img->h, target.pitch, inStep, inoStep);
+			byte *ino = (byte *)srcImage.getBasePtr(xp, yp);
+			doBlit(ino, outo, visibleW, visibleH, target.pitch, inStep, inoStep, color, blendMode, _alphaMode);
 		} else {
-			if (blendMode == BLEND_ADDITIVE) {
-				doBlitAdditiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_SUBTRACTIVE) {
-				doBlitSubtractiveBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else if (blendMode == BLEND_MULTIPLY) {
-				doBlitMultiplyBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
-			} else {
-				assert(blendMode == BLEND_NORMAL);
-				doBlitAlphaBlend(ino, outo, img->w, img->h, target.pitch, inStep, inoStep, color);
+			// Scale with the same nearest neighbour mapping as scale(), and
+			// store the pixels in blitting order, so that they need no flipping
+			uint32 buffer[kScaleChunkSize];
+
+			for (int y = 0; y < visibleH; y++) {
+				const int scaledY = yOffset + ((flipping & FLIP_V) ? visibleH - 1 - y : y);
+				const uint32 *srcRow = (const uint32 *)srcImage.getBasePtr(0, scaledY * srcImage.h / height);
+				byte *out = outo + y * target.pitch;
+
+				for (int x = 0; x < visibleW; x += kScaleChunkSize) {
+					const int count = MIN(visibleW - x, kScaleChunkSize);
+					for (int i = 0; i < count; i++) {
+						const int scaledX = xOffset + ((flipping & FLIP_H) ? visibleW - 1 - (x + i) : x + i);
+						buffer[i] = srcRow[scaledX * srcImage.w / width];
+					}
+
+					doBlit((byte *)buffer, out + x * 4, count, 1, target.pitch, 4, count * 4, color, blendMode, _alphaMode);
+				}
 			}
 		}
-
 	}
 
-	retSize.setWidth(img->w);
-	retSize.setHeight(img->h);
-
-	if (imgScaled) {
-		imgScaled->setPixels(savedPixels);
-		imgScaled->free();
-		delete imgScaled;
-	}
+	retSize.setWidth(visibleW);
+	retSize.setHeight(visibleH);
 
 	return retSize;
 }
@@ -0,0 +1,86 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_TRANSPARENT_SURFACE_INTERN_H
+#define GRAPHICS_TRANSPARENT_SURFACE_INTERN_H
+
+#include "common/scummsys.h"
+
+namespace Graphics {
+
+static const int kBModShift = 8;//img->format.bShift;
+static const int kGModShift = 16;//img->format.gShift;
+static const int kRModShift = 24;//img->format.rShift;
+static const int kAModShift = 0;//img->format.aShift;
+
+#ifdef SCUMM_LITTLE_ENDIAN
+static const int kAIndex = 0;
+static const int kBIndex = 1;
+static const int kGIndex = 2;
+static const int kRIndex = 3;
+
+#else
+static const int kAIndex = 3;
+static const int kBIndex = 2;
+static const int kGIndex = 1;
+static const int kRIndex = 0;
+#endif
+
+/**
+ * Optimized row blending routines used by TransparentSurface::blit() for
+ * alpha blended blits.
+ *
+ * The pixels are stored in the TransparentSurface format, with the byte
+ * positions given by kAIndex, kRIndex, kGIndex and kBIndex. The source
+ * pixels are inStep bytes apart, which is either 4, or -4 for horizontally
+ * flipped blits. All implementations produce the same output.
+ */
+struct TransparentBlitKernels {
+	/** Alpha blend a row of pixels onto the destination. */
+	void (*blendRow)(byte *out, const byte *in, uint32 width, int32 inStep);
+	/**
+	 * Alpha blend a row of pixels onto the destination, modulated by the
+	 * given color, as passed to TransparentSurface::blit().
+	 */
+	void (*blendRowTinted)(byte *out, const byte *in, uint32 width, int32 inStep, uint32 color);
+};
+
+/**
+ * Return the fastest blending routines supported by the host CPU.
+ */
+const TransparentBlitKernels &getTransparentBlitKernels();
+
+/**
+ * Return the portable C++ blending routines.
+ */
+const TransparentBlitKernels &getScalarTransparentBlitKernels();
+
+#ifdef SCUMMVM_SSE2
+const TransparentBlitKernels &getSSE2TransparentBlitKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const TransparentBlitKernels &getNEONTransparentBlitKernels();
+#endif
+
+} // End of namespace Graphics
+
+#endif
@@ -0,0 +1,151 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <arm_neon.h>
+
+namespace Graphics {
+
+/** Compute the truncated product of eight signed chroma values and a factor. */
+static inline int16x8_t chromaTerm(int16x8_t chroma, int16 factor) {
+	// vqdmulhq_s16() returns (2 * a * b) >> 16
+	const int16x8_t abs = vabsq_s16(chroma);
+	const int16x8_t product = vqdmulhq_s16(vshlq_n_s16(abs, 15 - kYUVFactorShift), vdupq_n_s16(factor));
+	return vbslq_s16(vcltq_s16(chroma, vdupq_n_s16(0)), vnegq_s16(product), product);
+}
+
+namespace {
+
+/** Chroma terms of eight chroma samples. */
+struct Chroma {
+	int16x8_t r, g, b;
+
+	Chroma(const byte *uSrc, const byte *vSrc) {
+		const int16x8_t bias = vdupq_n_s16(128);
+		const int16x8_t cr = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(vSrc))), bias);
+		const int16x8_t cb = vsubq_s16(vreinterpretq_s16_u16(vmovl_u8(vld1_u8(uSrc))), bias);
+
+		r = chromaTerm(cr, kYUVFactorCrR);
+		g = vnegq_s16(vaddq_s16(chromaTerm(cr, kYUVFactorCrG), chromaTerm(cb, kYUVFactorCbG)));
+		b = chromaTerm(cb, kYUVFactorCbB);
+	}
+};
+
+/** Pixel format dependent values, set up once per row. */
+struct Target {
+	int32x4_t rShift, gShift, bShift;
+	uint32x4_t alpha;
+	bool itu;
+
+	Target(const PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+		rShift = vdupq_n_s32(format.rShift);
+		gShift = vdupq_n_s32(format.gShift);
+		bShift = vdupq_n_s32(format.bShift);
+		alpha = vdupq_n_u32(format.ARGBToColor(255, 0, 0, 0));
+		itu = (scale == YUVToRGBManager::kScaleITU);
+	}
+
+	/** Compute eight color components from luminance values and chroma terms. */
+	inline uint16x8_t component(int16x8_t y, int16x8_t chroma) const {
+		const int16x8_t value = vaddq_s16(y, chroma);
+
+		if (!itu)
+			return vreinterpretq_u16_s16(vminq_s16(vmaxq_s16(value, vdupq_n_s16(0)), vdupq_n_s16(255)));
+
+		const int16x8_t clamped = vminq_s16(vmaxq_s16(value, vdupq_n_s16(16)), vdupq_n_s16(235));
+		const int16x8_t scaled = vshlq_n_s16(vsubq_s16(clamped, vdupq_n_s16(16)), 15 - kYUVFactorShift);
+		return vreinterpretq_u16_s16(vqdmulhq_s16(scaled, vdupq_n_s16(kYUVFactorITU)));
+	}
+
+	/** Convert and store eight pixels. */
+	inline void store(uint32 *dst, int16x8_t y, int16x8_t cr, int16x8_t cg, int16x8_t cb) const {
+		const uint16x8_t r = component(y, cr);
+		const uint16x8_t g = component(y, cg);
+		const uint16x8_t b = component(y, cb);
+
+		uint32x4_t lo = alpha;
+		lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(r)), rShift));
+		lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(g)), gShift));
+		lo = vorrq_u32(lo, vshlq_u32(vmovl_u16(vget_low_u16(b)), bShift));
+
+		uint32x4_t hi = alpha;
+		hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(r)), rShift));
+		hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(g)), gShift));
+		hi = vorrq_u32(hi, vshlq_u32(vmovl_u16(vget_high_u16(b)), bShift));
+
+		vst1q_u32(dst, lo);
+		vst1q_u32(dst + 4, hi);
+	}
+};
+
+} // End of anonymous namespace
+
+static inline int16x8_t widenLuminance(uint8x8_t y) {
+	return vreinterpretq_s16_u16(vmovl_u8(y));
+}
+
+static int convert444NEON(uint32 *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width,
+                          const PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+	const Target target(format, scale);
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const Chroma chroma(uSrc + x, vSrc + x);
+		target.store(dst + x, widenLuminance(vld1_u8(ySrc + x)), chroma.r, chroma.g, chroma.b);
+	}
+
+	return x;
+}
+
+static int convert420NEON(uint32 *dst0, uint32 *dst1, const byte *ySrc0, const byte *ySrc1, const byte *uSrc, const byte *vSrc, int width,
+                          const PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+	const Target target(format, scale);
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		// Each chroma sample is used for two horizontally adjacent pixels
+		const Chroma chroma(uSrc + x / 2, vSrc + x / 2);
+		const int16x8x2_t r = vzipq_s16(chroma.r, chroma.r);
+		const int16x8x2_t g = vzipq_s16(chroma.g, chroma.g);
+		const int16x8x2_t b = vzipq_s16(chroma.b, chroma.b);
+
+		const uint8x16_t y0 = vld1q_u8(ySrc0 + x);
+		target.store(dst0 + x, widenLuminance(vget_low_u8(y0)), r.val[0], g.val[0], b.val[0]);
+		target.store(dst0 + x + 8, widenLuminance(vget_high_u8(y0)), r.val[1], g.val[1], b.val[1]);
+
+		const uint8x16_t y1 = vld1q_u8(ySrc1 + x);
+		target.store(dst1 + x, widenLuminance(vget_low_u8(y1)), r.val[0], g.val[0], b.val[0]);
+		target.store(dst1 + x + 8, widenLuminance(vget_high_u8(y1)), r.val[1], g.val[1], b.val[1]);
+	}
+
+	return x;
+}
+
+const YUVToRGBKernels &getNEONYUVToRGBKernels() {
+	static const YUVToRGBKernels kernels = {
+		convert444NEON,
+		convert420NEON
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
@@ -0,0 +1,154 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include <emmintrin.h>
+
+namespace Graphics {
+
+/** Compute the truncated product of eight signed chroma values and a factor. */
+static inline __m128i chromaTerm(__m128i chroma, int16 factor) {
+	const __m128i sign = _mm_srai_epi16(chroma, 15);
+	const __m128i abs = _mm_sub_epi16(_mm_xor_si128(chroma, sign), sign);
+	const __m128i product = _mm_mulhi_epu16(_mm_slli_epi16(abs, 16 - kYUVFactorShift), _mm_set1_epi16(factor));
+	return _mm_sub_epi16(_mm_xor_si128(product, sign), sign);
+}
+
+namespace {
+
+/** Chroma terms of eight chroma samples. */
+struct Chroma {
+	__m128i r, g, b;
+
+	Chroma(const byte *uSrc, const byte *vSrc) {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i bias = _mm_set1_epi16(128);
+		const __m128i cr = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)vSrc), zero), bias);
+		const __m128i cb = _mm_sub_epi16(_mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)uSrc), zero), bias);
+
+		r = chromaTerm(cr, kYUVFactorCrR);
+		g = _mm_sub_epi16(_mm_sub_epi16(zero, chromaTerm(cr, kYUVFactorCrG)), chromaTerm(cb, kYUVFactorCbG));
+		b = chromaTerm(cb, kYUVFactorCbB);
+	}
+};
+
+/** Pixel format dependent values, set up once per row. */
+struct Target {
+	__m128i rShift, gShift, bShift, alpha;
+	bool itu;
+
+	Target(const PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+		rShift = _mm_cvtsi32_si128(format.rShift);
+		gShift = _mm_cvtsi32_si128(format.gShift);
+		bShift = _mm_cvtsi32_si128(format.bShift);
+		alpha = _mm_set1_epi32((int)format.ARGBToColor(255, 0, 0, 0));
+		itu = (scale == YUVToRGBManager::kScaleITU);
+	}
+
+	/** Compute eight color components from luminance values and chroma terms. */
+	inline __m128i component(__m128i y, __m128i chroma) const {
+		const __m128i value = _mm_add_epi16(y, chroma);
+
+		if (!itu)
+			return _mm_min_epi16(_mm_max_epi16(value, _mm_setzero_si128()), _mm_set1_epi16(255));
+
+		const __m128i clamped = _mm_min_epi16(_mm_max_epi16(value, _mm_set1_epi16(16)), _mm_set1_epi16(235));
+		const __m128i scaled = _mm_slli_epi16(_mm_sub_epi16(clamped, _mm_set1_epi16(16)), 16 - kYUVFactorShift);
+		return _mm_mulhi_epu16(scaled, _mm_set1_epi16(kYUVFactorITU));
+	}
+
+	/** Convert and store eight pixels. */
+	inline void store(uint32 *dst, __m128i y, __m128i cr, __m128i cg, __m128i cb) const {
+		const __m128i zero = _mm_setzero_si128();
+		const __m128i r = component(y, cr);
+		const __m128i g = component(y, cg);
+		const __m128i b = component(y, cb);
+
+		__m128i lo = alpha;
+		lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(r, zero), rShift));
+		lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(g, zero), gShift));
+		lo = _mm_or_si128(lo, _mm_sll_epi32(_mm_unpacklo_epi16(b, zero), bShift));
+
+		__m128i hi = alpha;
+		hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(r, zero), rShift));
+		hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(g, zero), gShift));
+		hi = _mm_or_si128(hi, _mm_sll_epi32(_mm_unpackhi_epi16(b, zero), bShift));
+
+		_mm_storeu_si128((__m128i *)dst, lo);
+		_mm_storeu_si128((__m128i *)(dst + 4), hi);
+	}
+};
+
+} // End of anonymous namespace
+
+static int convert444SSE2(uint32 *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width,
+                          const PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+	const Target target(format, scale);
+	const __m128i zero = _mm_setzero_si128();
+
+	int x = 0;
+	for (; x + 8 <= width; x += 8) {
+		const Chroma chroma(uSrc + x, vSrc + x);
+		const __m128i y = _mm_unpacklo_epi8(_mm_loadl_epi64((const __m128i *)(ySrc + x)), zero);
+		target.store(dst + x, y, chroma.r, chroma.g, chroma.b);
+	}
+
+	return x;
+}
+
+static int convert420SSE2(uint32 *dst0, uint32 *dst1, const byte *ySrc0, const byte *ySrc1, const byte *uSrc, const byte *vSrc, int width,
+                          const PixelFormat &format, YUVToRGBManager::LuminanceScale scale) {
+	const Target target(format, scale);
+	const __m128i zero = _mm_setzero_si128();
+
+	int x = 0;
+	for (; x + 16 <= width; x += 16) {
+		// Each chroma sample is used for two horizontally adjacent pixels
+		const Chroma chroma(uSrc + x / 2, vSrc + x / 2);
+		const __m128i rLo = _mm_unpacklo_epi16(chroma.r, chroma.r);
+		const __m128i rHi = _mm_unpackhi_epi16(chroma.r, chroma.r);
+		const __m128i gLo = _mm_unpacklo_epi16(chroma.g, chroma.g);
+		const __m128i gHi = _mm_unpackhi_epi16(chroma.g, chroma.g);
+		const __m128i bLo = _mm_unpacklo_epi16(chroma.b, chroma.b);
+		const __m128i bHi = _mm_unpackhi_epi16(chroma.b, chroma.b);
+
+		const __m128i y0 = _mm_loadu_si128((const __m128i *)(ySrc0 + x));
+		target.store(dst0 + x, _mm_unpacklo_epi8(y0, zero), rLo, gLo, bLo);
+		target.store(dst0 + x + 8, _mm_unpackhi_epi8(y0, zero), rHi, gHi, bHi);
+
+		const __m128i y1 = _mm_loadu_si128((const __m128i *)(ySrc1 + x));
+		target.store(dst1 + x, _mm_unpacklo_epi8(y1, zero), rLo, gLo, bLo);
+		target.store(dst1 + x + 8, _mm_unpackhi_epi8(y1, zero), rHi, gHi, bHi);
+	}
+
+	return x;
+}
+
+const YUVToRGBKernels &getSSE2YUVToRGBKernels() {
+	static const YUVToRGBKernels kernels = {
+		convert444SSE2,
+		convert420SSE2
+	};
+	return kernels;
+}
+
+} // End of namespace Graphics
@@ -82,8 +82,13 @@
 // BASIS, AND BROWN UNIVERSITY HAS NO OBLIGATION TO PROVIDE MAINTENANCE,
 // SUPPORT, UPDATES, ENHANCEMENTS, OR MODIFICATIONS.
 
+#include "graphics/conversion_intern.h"
 #include "graphics/surface.h"
 #include "graphics/yuv_to_rgb.h"
+#include "graphics/yuv_to_rgb_intern.h"
+
+#include "common/cpu.h"
+#include "common/threadpool.h"
 
 namespace Common {
 DECLARE_SINGLETON(Graphics::YUVToRGBManager);
@@ -91,6 +96,73 @@ DECLARE_SINGLETON(Graphics::YUVToRGBManager);
 
 namespace Graphics {
 
+enum {
+	/** Images are not split into bands smaller than this */
+	kMinBandHeight = 32
+};
+
+/** A horizontal band of an image, which can be converted on its own. */
+struct YUVToRGBBand {
+	byte *dstPtr;
+	const byte *ySrc;
+	const byte *uSrc;
+	const byte *vSrc;
+	const byte *aSrc;
+	int yHeight;
+};
+
+/** The parameters shared by all bands of an image. */
+struct YUVToRGBJob {
+	void (*convert)(const YUVToRGBJob &job, const YUVToRGBBand &band);
+	const YUVToRGBLookup *lookup;
+	int16 *colorTab;
+	const YUVToRGBKernels *kernels;
+	int dstPitch;
+	int yWidth;
+	int yPitch;
+	int uvPitch;
+};
+
+/**
+ * The rows of an image, as converted in bands by
+ * Common::ThreadPool::parallelFor(). The range counts rows of chroma
+ * samples, so that every band starts at a row with new chroma samples.
+ */
+struct YUVToRGBRows {
+	const YUVToRGBJob *job;
+	const YUVToRGBBand *image;
+	int chromaRows;
+
+	static void convert(void *data, uint begin, uint end) {
+		const YUVToRGBRows *rows = (const YUVToRGBRows *)data;
+		const YUVToRGBJob &job = *rows->job;
+		const YUVToRGBBand &image = *rows->image;
+		const int start = begin * rows->chromaRows;
+
+		YUVToRGBBand band;
+		band.dstPtr = image.dstPtr + start * job.dstPitch;
+		band.ySrc = image.ySrc + start * job.yPitch;
+		band.uSrc = image.uSrc + begin * job.uvPitch;
+		band.vSrc = image.vSrc + begin * job.uvPitch;
+		band.aSrc = image.aSrc ? image.aSrc + start * job.yPitch : nullptr;
+		band.yHeight = MIN<int>(end * rows->chromaRows, image.yHeight) - start;
+		job.convert(job, band);
+	}
+};
+
+const YUVToRGBKernels *getYUVToRGBKernels() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return &getSSE2YUVToRGBKernels();
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return &getNEONYUVToRGBKernels();
+#endif
+
+	return nullptr;
+}
+
 class YUVToRGBLookup {
 public:
 	YUVToRGBLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale, bool alphaMode = false);
@@ -192,6 +264,15 @@ YUVToRGBManager::~YUVToRGBManager() {
 	delete _lookup;
 }
 
+void YUVToRGBManager::convertBands(const YUVToRGBJob &job, const YUVToRGBBand &image, int chromaRows) {
+	if (image.yHeight <= 0)
+		return;
+
+	YUVToRGBRows rows = { &job, &image, chromaRows };
+	const uint chromaHeight = (image.yHeight + chromaRows - 1) / chromaRows;
+	ThreadPoolMan.parallelFor(0, chromaHeight, kMinBandHeight / chromaRows, YUVToRGBRows::convert, &rows);
+}
+
 const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, YUVToRGBManager::LuminanceScale scale, bool alphaMode) {
 	if (_lookup && _lookup->getFormat() == format && _lookup->getScale() == scale && _alphaMode == alphaMode)
 		return _lookup;
@@ -202,12 +283,26 @@ const YUVToRGBLookup *YUVToRGBManager::getLookup(Graphics::PixelFormat format, Y
 	return _lookup;
 }
 
+static void initJob(YUVToRGBJob &job, const Graphics::Surface *dst, const YUVToRGBLookup *lookup, int16 *colorTab, int yWidth, int yPitch, int uvPitch) {
+	job.convert = nullptr;
+	job.lookup = lookup;
+	job.colorTab = colorTab;
+	job.dstPitch = dst->pitch;
+	job.yWidth = yWidth;
+	job.yPitch = yPitch;
+	job.uvPitch = uvPitch;
+
+	// The vectorized code only handles 32-bit pixel formats with 8-bit
+	// components, which are the most common ones for video output
+	job.kernels = isByteAligned32(dst->format) ? getYUVToRGBKernels() : nullptr;
+}
+
 #define PUT_PIXEL(s, d) \
 	L = &rgbToPix[(s)]; \
 	*((PixelInt *)(d)) = (L[cr_r] | L[crb_g] | L[cb_b])
 
 template<typename PixelInt>
-void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const YUVToRGBKernels *kernels, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Keep the tables in pointers here to avoid a dereference on each pixel
 	const int16 *Cr_r_tab = colorTab;
 	const int16 *Cr_g_tab = Cr_r_tab + 256;
@@ -216,7 +311,18 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
 	for (int h = 0; h < yHeight; h++) {
-		for (int w = 0; w < yWidth; w++) {
+		int w = 0;
+
+		// Convert as much of the row as possible with the vectorized code
+		if (kernels) {
+			w = kernels->convert444((uint32 *)dstPtr, ySrc, uSrc, vSrc, yWidth, lookup->getFormat(), lookup->getScale());
+			ySrc += w;
+			uSrc += w;
+			vSrc += w;
+			dstPtr += w * sizeof(PixelInt);
+		}
+
+		for (; w < yWidth; w++) {
 			const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -237,23 +343,32 @@ void convertYUV444ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
+template<typename PixelInt>
+void convertBand444(const YUVToRGBJob &job, const YUVToRGBBand &band) {
+	convertYUV444ToRGB<PixelInt>(band.dstPtr, job.dstPitch, job.lookup, job.colorTab, job.kernels, band.ySrc, band.uSrc, band.vSrc, job.yWidth, band.yHeight, job.yPitch, job.uvPitch);
+}
+
 void YUVToRGBManager::convert444(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
 	assert(dst->format.bytesPerPixel == 2 || dst->format.bytesPerPixel == 4);
 	assert(ySrc && uSrc && vSrc);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBJob job;
+	initJob(job, dst, getLookup(dst->format, scale), _colorTab, yWidth, yPitch, uvPitch);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV444ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBand444<uint16>;
 	else
-		convertYUV444ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBand444<uint32>;
+
+	const YUVToRGBBand image = { (byte *)dst->getPixels(), ySrc, uSrc, vSrc, nullptr, yHeight };
+	convertBands(job, image, 1);
 }
 
 template<typename PixelInt>
-void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
+void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup, int16 *colorTab, const YUVToRGBKernels *kernels, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	int halfHeight = yHeight >> 1;
 	int halfWidth = yWidth >> 1;
 
@@ -265,7 +380,19 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	const uint32 *rgbToPix = lookup->getRGBToPix();
 
 	for (int h = 0; h < halfHeight; h++) {
-		for (int w = 0; w < halfWidth; w++) {
+		int w = 0;
+
+		// Convert as much of the rows as possible with the vectorized code
+		if (kernels) {
+			const int converted = kernels->convert420((uint32 *)dstPtr, (uint32 *)(dstPtr + dstPitch), ySrc, ySrc + yPitch, uSrc, vSrc, yWidth, lookup->getFormat(), lookup->getScale());
+			ySrc += converted;
+			dstPtr += converted * sizeof(PixelInt);
+			w = converted >> 1;
+			uSrc += w;
+			vSrc += w;
+		}
+
+		for (; w < halfWidth; w++) {
 			const uint32 *L;
 
 			int16 cr_r  = Cr_r_tab[*vSrc];
@@ -291,6 +418,11 @@ void convertYUV420ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 	}
 }
 
+template<typename PixelInt>
+void convertBand420(const YUVToRGBJob &job, const YUVToRGBBand &band) {
+	convertYUV420ToRGB<PixelInt>(band.dstPtr, job.dstPitch, job.lookup, job.colorTab, job.kernels, band.ySrc, band.uSrc, band.vSrc, job.yWidth, band.yHeight, job.yPitch, job.uvPitch);
+}
+
 void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -299,13 +431,17 @@ void YUVToRGBManager::convert420(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBJob job;
+	initJob(job, dst, getLookup(dst->format, scale), _colorTab, yWidth, yPitch, uvPitch);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV420ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBand420<uint16>;
 	else
-		convertYUV420ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBand420<uint32>;
+
+	const YUVToRGBBand image = { (byte *)dst->getPixels(), ySrc, uSrc, vSrc, nullptr, yHeight };
+	convertBands(job, image, 2);
 }
 
 #define PUT_PIXELA(s, a, d) \
@@ -355,6 +491,11 @@ void convertYUVA420ToRGBA(byte *dstPtr, int dstPitch, const YUVToRGBLookup *look
 	}
 }
 
+template<typename PixelInt>
+void convertBandA420(const YUVToRGBJob &job, const YUVToRGBBand &band) {
+	convertYUVA420ToRGBA<PixelInt>(band.dstPtr, job.dstPitch, job.lookup, job.colorTab, band.ySrc, band.uSrc, band.vSrc, band.aSrc, job.yWidth, band.yHeight, job.yPitch, job.uvPitch);
+}
+
 void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, const byte *aSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -363,13 +504,17 @@ void YUVToRGBManager::convert420Alpha(Graphics::Surface *dst, YUVToRGBManager::L
 	assert((yWidth & 1) == 0);
 	assert((yHeight & 1) == 0);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale, true);
+	YUVToRGBJob job;
+	initJob(job, dst, getLookup(dst->format, scale, true), _colorTab, yWidth, yPitch, uvPitch);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUVA420ToRGBA<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBandA420<uint16>;
 	else
-		convertYUVA420ToRGBA<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, aSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBandA420<uint32>;
+
+	const YUVToRGBBand image = { (byte *)dst->getPixels(), ySrc, uSrc, vSrc, aSrc, yHeight };
+	convertBands(job, image, 2);
 }
 
 #define READ_QUAD(ptr, prefix) \
@@ -440,6 +585,11 @@ void convertYUV410ToRGB(byte *dstPtr, int dstPitch, const YUVToRGBLookup *lookup
 #undef DO_INTERPOLATION
 #undef DO_YUV410_PIXEL
 
+template<typename PixelInt>
+void convertBand410(const YUVToRGBJob &job, const YUVToRGBBand &band) {
+	convertYUV410ToRGB<PixelInt>(band.dstPtr, job.dstPitch, job.lookup, job.colorTab, band.ySrc, band.uSrc, band.vSrc, job.yWidth, band.yHeight, job.yPitch, job.uvPitch);
+}
+
 void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::LuminanceScale scale, const byte *ySrc, const byte *uSrc, const byte *vSrc, int yWidth, int yHeight, int yPitch, int uvPitch) {
 	// Sanity checks
 	assert(dst && dst->getPixels());
@@ -448,13 +598,17 @@ void YUVToRGBManager::convert410(Graphics::Surface *dst, YUVToRGBManager::Lumina
 	assert((yWidth & 3) == 0);
 	assert((yHeight & 3) == 0);
 
-	const YUVToRGBLookup *lookup = getLookup(dst->format, scale);
+	YUVToRGBJob job;
+	initJob(job, dst, getLookup(dst->format, scale), _colorTab, yWidth, yPitch, uvPitch);
 
 	// Use a templated function to avoid an if check on every pixel
 	if (dst->format.bytesPerPixel == 2)
-		convertYUV410ToRGB<uint16>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBand410<uint16>;
 	else
-		convertYUV410ToRGB<uint32>((byte *)dst->getPixels(), dst->pitch, lookup, _colorTab, ySrc, uSrc, vSrc, yWidth, yHeight, yPitch, uvPitch);
+		job.convert = convertBand410<uint32>;
+
+	const YUVToRGBBand image = { (byte *)dst->getPixels(), ySrc, uSrc, vSrc, nullptr, yHeight };
+	convertBands(job, image, 4);
 }
 
 } // End of namespace Graphics
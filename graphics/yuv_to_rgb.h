@@ -44,6 +44,8 @@
 namespace Graphics {
 
 class YUVToRGBLookup;
+struct YUVToRGBBand;
+struct YUVToRGBJob;
 
 class YUVToRGBManager : public Common::Singleton<YUVToRGBManager> {
 public:
@@ -126,6 +128,7 @@ private:
 	~YUVToRGBManager();
 
 	const YUVToRGBLookup *getLookup(Graphics::PixelFormat format, LuminanceScale scale, bool alphaMode = false);
+	void convertBands(const YUVToRGBJob &job, const YUVToRGBBand &image, int chromaRows);
 
 	YUVToRGBLookup *_lookup;
 	int16 _colorTab[4 * 256]; // 2048 bytes
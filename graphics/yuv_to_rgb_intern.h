@@ -0,0 +1,80 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef GRAPHICS_YUV_TO_RGB_INTERN_H
+#define GRAPHICS_YUV_TO_RGB_INTERN_H
+
+#include "graphics/pixelformat.h"
+#include "graphics/yuv_to_rgb.h"
+
+namespace Graphics {
+
+/**
+ * Vectorized row conversion routines used by YUVToRGBManager.
+ *
+ * They handle 32-bit formats with byte-aligned 8-bit components (see
+ * isByteAligned32()) and produce the same output as the lookup tables.
+ * Each routine converts as many pixels from the start of the row as it can
+ * handle in whole blocks, and returns their number. The caller converts the
+ * remaining pixels.
+ */
+struct YUVToRGBKernels {
+	/** Convert one row of a YUV444 image. */
+	int (*convert444)(uint32 *dst, const byte *ySrc, const byte *uSrc, const byte *vSrc, int width,
+	                  const PixelFormat &format, YUVToRGBManager::LuminanceScale scale);
+	/** Convert two rows of a YUV420 image, which share one row of chroma samples. */
+	int (*convert420)(uint32 *dst0, uint32 *dst1, const byte *ySrc0, const byte *ySrc1, const byte *uSrc, const byte *vSrc, int width,
+	                  const PixelFormat &format, YUVToRGBManager::LuminanceScale scale);
+};
+
+/**
+ * Fixed point factors of the chroma terms used in the lookup tables.
+ *
+ * Multiplying the absolute chroma value by one of these and shifting the
+ * result right by kYUVFactorShift gives exactly the truncated products the
+ * tables are built with.
+ */
+enum {
+	kYUVFactorShift = 14,
+	kYUVFactorCrR = 22938, // 0.419 / 0.299
+	kYUVFactorCrG = 11684, // 0.299 / 0.419
+	kYUVFactorCbG = 5641,  // 0.114 / 0.331
+	kYUVFactorCbB = 29055, // 0.587 / 0.331
+	kYUVFactorITU = 19078  // 255 / 219, for luminance values in [0, 219]
+};
+
+/**
+ * Return the vectorized conversion routines supported by the host CPU, or
+ * nullptr if there are none.
+ */
+const YUVToRGBKernels *getYUVToRGBKernels();
+
+#ifdef SCUMMVM_SSE2
+const YUVToRGBKernels &getSSE2YUVToRGBKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const YUVToRGBKernels &getNEONYUVToRGBKernels();
+#endif
+
+} // End of namespace Graphics
+
+#endif
@@ -20,10 +20,15 @@
  */
 
 
+// Used to measure the CPU time of fast playbacks
+#define FORBIDDEN_SYMBOL_EXCEPTION_clock
+
 #include "gui/EventRecorder.h"
 
 #ifdef ENABLE_EVENTRECORDER
 
+#include <time.h>
+
 namespace Common {
 DECLARE_SINGLETON(GUI::EventRecorder);
 }
@@ -78,6 +83,11 @@ EventRecorder::EventRecorder() {
 	_screenshotPeriod = 0;
 	_playbackFile = nullptr;
 	_recordFile = nullptr;
+	_frameCount = 0;
+	_playbackStartMicros = 0;
+	_lastFrameMicros = 0;
+	_maxFrameMicros = 0;
+	_playbackStartClock = 0;
 }
 
 EventRecorder::~EventRecorder() {
@@ -89,6 +99,7 @@ void EventRecorder::deinit() {
 		return;
 	}
 	setFileHeader();
+	reportFrameTimes();
 	_needRedraw = false;
 	_initialized = false;
 	_recordMode = kPassthrough;
@@ -114,6 +125,35 @@ void EventRecorder::deinit() {
 	DebugMan.disableDebugChannel("EventRec");
 }
 
+void EventRecorder::readNextEvent() {
+	// Reading past the end of the recording quits right away
+	if (!_playbackFile->hasNextEvent())
+		reportFrameTimes();
+
+	_nextEvent = _playbackFile->getNextEvent();
+}
+
+void EventRecorder::countFrame() {
+	const uint64 now = g_system->getMicros();
+	_maxFrameMicros = MAX(_maxFrameMicros, now - _lastFrameMicros);
+	_lastFrameMicros = now;
+	_frameCount++;
+}
+
+void EventRecorder::reportFrameTimes() {
+	if (_frameCount == 0)
+		return;
+
+	const uint64 totalMicros = _lastFrameMicros - _playbackStartMicros;
+	const uint64 cpuMillis = (uint64)(clock() - (clock_t)_playbackStartClock) * 1000 / CLOCKS_PER_SEC;
+	debug("playback:action=report frames=%u replayed=%u total=%u cpu=%u average=%.3f max=%.3f",
+		_frameCount, _fakeTimer, (uint32)(totalMicros / 1000), (uint32)cpuMillis,
+		totalMicros / 1000.0 / _frameCount, _maxFrameMicros / 1000.0);
+
+	// Only once
+	_frameCount = 0;
+}
+
 void EventRecorder::updateFakeTimer(uint32 millis) {
 	uint32 millisDelay = millis - _lastMillis;
 	_lastMillis = millis;
@@ -161,7 +201,7 @@ void EventRecorder::processTimeAndDate(TimeDate &td, bool skipRecord) {
 			_recordFile->writeEvent(timeDateEvent);
 		}
 
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
 	}
 	if (_recordMode == kRecorderPlaybackPause)
 		td = _lastTimeDate;
@@ -218,7 +258,7 @@ void EventRecorder::processMillis(uint32 &millis, bool skipRecord) {
 			_recordFile->writeEvent(timerEvent);
 		}
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
 		_timerManager->handler();
 		_controlPanel->setReplayedTime(_fakeTimer);
 		_processingMillis = false;
@@ -260,7 +300,7 @@ void EventRecorder::processScreenUpdate() {
 		if (_nextEvent.recordedtype != Common::kRecorderEventTypeScreenUpdate) {
 			int numSkipped = 0;
 			while (true) {
-				_nextEvent = _playbackFile->getNextEvent();
+				readNextEvent();
 				numSkipped += 1;
 				if (_nextEvent.recordedtype == Common::kRecorderEventTypeScreenUpdate) {
 					warning("Skipped %d events to get to the next screen update at %d", numSkipped, _nextEvent.time);
@@ -268,10 +308,11 @@ void EventRecorder::processScreenUpdate() {
 				}
 			}
 		}
+		countFrame();
 		_processingMillis = true;
 		_fakeTimer = _nextEvent.time;
 		updateSubsystems();
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
 		if (_recordMode == kRecorderUpdate) {
 			// write event to the updated file and update screenshot if necessary
 			screenUpdateEvent.recordedtype = Common::kRecorderEventTypeScreenUpdate;
@@ -308,7 +349,7 @@ bool EventRecorder::pollEvent(Common::Event &ev) {
 	}
 
 	ev = _nextEvent;
-	_nextEvent = _playbackFile->getNextEvent();
+	readNextEvent();
 	switch (ev.type) {
 	case Common::EVENT_MOUSEMOVE:
 	case Common::EVENT_LBUTTONDOWN:
@@ -415,7 +456,13 @@ void EventRecorder::init(const Common::String &recordFileName, RecordMode mode)
 	}
 	if ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate)) {
 		applyPlaybackSettings();
-		_nextEvent = _playbackFile->getNextEvent();
+		readNextEvent();
+
+		_fastPlayback = ConfMan.getBool("fast_playback");
+		_frameCount = 0;
+		_playbackStartMicros = _lastFrameMicros = g_system->getMicros();
+		_maxFrameMicros = 0;
+		_playbackStartClock = clock();
 	}
 	if ((_recordMode == kRecorderRecord) || (_recordMode == kRecorderUpdate)) {
 		getConfig();
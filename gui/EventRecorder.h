@@ -187,6 +187,15 @@ public:
 	bool switchMode();
 	void switchFastMode();
 
+	/**
+	 * Whether the recording is played back as fast as possible. Then the
+	 * delays are skipped and the frames are not shown. The engine still
+	 * sees the recorded times, so the playback stays deterministic.
+	 */
+	bool isFastPlayback() const {
+		return _fastPlayback && ((_recordMode == kRecorderPlayback) || (_recordMode == kRecorderUpdate));
+	}
+
 private:
 	bool pollEvent(Common::Event &ev) override;
 	bool notifyEvent(const Common::Event &event) override;
@@ -244,11 +253,25 @@ private:
 	void checkRecordedMD5();
 	void deleteTemporarySave();
 	void updateFakeTimer(uint32 millis);
+
+	/** Read the next event of the recording being played back. */
+	void readNextEvent();
+	/** Account the time spent on the frame which ended with a screen update. */
+	void countFrame();
+	/** Print the time spent per frame since the playback started. */
+	void reportFrameTimes();
 	volatile RecordMode _recordMode;
 	Common::String _recordFileName;
 	bool _fastPlayback;
 	bool _needRedraw;
 	bool _processingMillis;
+
+	// Frame times of the playback, measured with getMicros()
+	uint32 _frameCount;
+	uint64 _playbackStartMicros;
+	uint64 _lastFrameMicros;
+	uint64 _maxFrameMicros;
+	uint64 _playbackStartClock;
 };
 
 } // End of namespace GUI
@@ -23,6 +23,8 @@
 #include "common/config-manager.h"
 #include "common/file.h"
 #include "common/fs.h"
+#include "common/md5.h"
+#include "common/memstream.h"
 #include "common/unzip.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -40,6 +42,7 @@
 #include "image/bmp.h"
 #include "image/png.h"
 
+#include "gui/gui-manager.h"
 #include "gui/widget.h"
 #include "gui/ThemeEngine.h"
 #include "gui/ThemeEval.h"
@@ -193,7 +196,7 @@ ThemeEngine::ThemeEngine(Common::String id, GraphicsMode mode) :
 	_system(nullptr), _vectorRenderer(nullptr),
 	_layerToDraw(kDrawLayerBackground), _bytesPerPixel(0),  _graphicsMode(kGfxDisabled),
 	_font(nullptr), _initOk(false), _themeOk(false), _enabled(false), _themeFiles(),
-	_cursor(nullptr), _scaleFactor(1.0f) {
+	_cursor(nullptr), _scaleFactor(1.0f), _drawDataCacheSize(0), _compiledSTXLoaded(false), _compiledSTXDirty(false) {
 
 	_baseWidth = 640;	// Default sane values
 	_baseHeight = 480;
@@ -467,6 +470,8 @@ void ThemeEngine::setGraphicsMode(GraphicsMode mode) {
 	// list. Clearing it avoids invalid overlay writes when the backend
 	// resizes the overlay.
 	_dirtyScreen.clear();
+
+	flushDrawDataCache();
 }
 
 void WidgetDrawData::calcBackgroundOffset() {
@@ -655,6 +660,18 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 	}
 
 	if (!scalablefile.empty()) {
+		const int renderWidth = width * _scaleFactor;
+		const int renderHeight = height * _scaleFactor;
+
+		// Reuse the raster from an earlier load of the theme
+		Graphics::SVGRasterCache &cache = g_gui.getSVGRasterCache();
+		const Common::String cacheName = _themeId + "/" + scalablefile;
+		surf = cache.get(cacheName, renderWidth, renderHeight);
+		if (surf) {
+			_bitmaps[filename] = surf;
+			return true;
+		}
+
 		Graphics::SVGBitmap *image = nullptr;
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, scalablefile);
@@ -668,8 +685,9 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 		}
 
 		if (image) {
-			_bitmaps[filename] = new Graphics::ManagedSurface(width * _scaleFactor, height * _scaleFactor, *image->getPixelFormat());
-			image->render(*_bitmaps[filename], width * _scaleFactor, height * _scaleFactor);
+			_bitmaps[filename] = new Graphics::ManagedSurface(renderWidth, renderHeight, *image->getPixelFormat());
+			image->render(*_bitmaps[filename], renderWidth, renderHeight);
+			cache.put(cacheName, *_bitmaps[filename]);
 
 			delete image;
 		} else {
@@ -685,6 +703,7 @@ bool ThemeEngine::addBitmap(const Common::String &filename, const Common::String
 		// Maybe it is PNG?
 #ifdef USE_PNG
 		Image::PNGDecoder decoder;
+		decoder.setOutputPixelFormat(_overlayFormat);
 		Common::ArchiveMemberList members;
 		_themeFiles.listMatchingMembers(members, filename);
 		for (Common::ArchiveMemberList::const_iterator i = members.begin(), end = members.end(); i != end; ++i) {
@@ -771,6 +790,9 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 		_themeOk = loadThemeXML(themeId);
 	}
 
+	// Store the STX files compiled while loading the theme
+	flushCompiledSTX();
+
 	if (!_themeOk) {
 		warning("Failed to load theme '%s'", themeId.c_str());
 		return;
@@ -786,6 +808,8 @@ void ThemeEngine::loadTheme(const Common::String &themeId) {
 }
 
 void ThemeEngine::unloadTheme() {
+	flushDrawDataCache();
+
 	if (!_themeOk)
 		return;
 
@@ -835,22 +859,11 @@ bool ThemeEngine::loadDefaultXML() {
 	for (int i = 0; i < ARRAYSIZE(defaultXML); i++)
 		strncat((char *)tmpXML, defaultXML[i], xmllen);
 
-	if (!_parser->loadBuffer(tmpXML, xmllen)) {
-		free(tmpXML);
-
-		return false;
-	}
-
 	_themeName = "ScummVM Classic Theme (Builtin Version)";
 	_themeId = "builtin";
 	_themeFile.clear();
 
-	bool result = _parser->parse();
-	_parser->close();
-
-	free(tmpXML);
-
-	return result;
+	return parseSTX("builtin", new Common::MemoryReadStream(tmpXML, xmllen, DisposeAfterUse::YES));
 #else
 	warning("The built-in theme is not enabled in the current build. Please load an external theme");
 	return false;
@@ -892,25 +905,172 @@ bool ThemeEngine::loadThemeXML(const Common::String &themeId) {
 	for (Common::ArchiveMemberList::iterator i = members.begin(); i != members.end(); ++i) {
 		assert((*i)->getName().hasSuffix(".stx"));
 
-		if (_parser->loadStream((*i)->createReadStream()) == false) {
+		Common::SeekableReadStream *stream = (*i)->createReadStream();
+		if (!stream) {
 			warning("Failed to load STX file '%s'", (*i)->getName().c_str());
-			_parser->close();
 			return false;
 		}
 
-		if (_parser->parse() == false) {
+		if (!parseSTX(themeId + ":" + (*i)->getName(), stream)) {
 			warning("Failed to parse STX file '%s'", (*i)->getName().c_str());
-			_parser->close();
 			return false;
 		}
-
-		_parser->close();
 	}
 
 	assert(!_themeName.empty());
 	return true;
 }
 
+#define COMPILEDSTX_FILENAME "scummvm-themecache.dat"
+#define COMPILEDSTX_VERSION 1
+
+bool ThemeEngine::parseSTX(const Common::String &key, Common::SeekableReadStream *stream) {
+	const uint32 size = stream->size();
+	byte *contents = (byte *)malloc(size);
+	stream->read(contents, size);
+	const bool readOk = !stream->err();
+	delete stream;
+
+	if (!readOk) {
+		free(contents);
+		return false;
+	}
+
+	Common::MemoryReadStream *xml = new Common::MemoryReadStream(contents, size, DisposeAfterUse::YES);
+	const Common::String checksum = Common::computeStreamMD5AsString(*xml);
+
+	if (!_compiledSTXLoaded)
+		loadCompiledSTX();
+
+	// Replay the callbacks recorded the last time the file was parsed,
+	// which is much faster than tokenizing the XML again
+	CompiledSTXMap::const_iterator compiled = _compiledSTX.find(key);
+	if (compiled != _compiledSTX.end() && compiled->_value.checksum == checksum) {
+		delete xml;
+
+		Common::MemoryReadStream compiledStream(compiled->_value.data.data(), compiled->_value.data.size());
+		if (_parser->parseCompiled(compiledStream))
+			return true;
+
+		// Do not use the broken data again
+		_compiledSTX.erase(key);
+		_compiledSTXDirty = true;
+		return false;
+	}
+
+	_parser->loadStream(xml);
+
+	Common::MemoryWriteStreamDynamic compiledStream(DisposeAfterUse::YES);
+	const bool result = _parser->parse(&compiledStream);
+	_parser->close();
+
+	if (result) {
+		CompiledSTX &entry = _compiledSTX[key];
+		entry.checksum = checksum;
+		entry.data = Common::Array<byte>(compiledStream.getData(), compiledStream.size());
+		_compiledSTXDirty = true;
+	}
+
+	return result;
+}
+
+Common::FSNode ThemeEngine::getCompiledSTXFile() const {
+	// The compiled files are stored next to the configuration file
+	Common::String configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = _system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return Common::FSNode();
+
+	Common::FSNode configNode(configFile);
+	Common::FSNode dir = configNode.getParent();
+	if (dir.getPath() == configNode.getPath() || !dir.isDirectory()) {
+		// Relative configuration file name, use the current directory
+		return Common::FSNode(COMPILEDSTX_FILENAME);
+	}
+
+	return dir.getChild(COMPILEDSTX_FILENAME);
+}
+
+static bool readCompiledSTXString(Common::SeekableReadStream &stream, Common::String &str) {
+	uint32 len = stream.readUint32LE();
+	if (stream.eos() || len > (uint32)(stream.size() - stream.pos()))
+		return false;
+
+	char *buf = new char[len];
+	stream.read(buf, len);
+	str = Common::String(buf, len);
+	delete[] buf;
+	return !stream.err();
+}
+
+void ThemeEngine::loadCompiledSTX() {
+	_compiledSTXLoaded = true;
+
+	Common::FSNode file = getCompiledSTXFile();
+	if (!file.exists())
+		return;
+
+	Common::SeekableReadStream *stream = file.createReadStream();
+	if (!stream)
+		return;
+
+	if (stream->readUint32BE() != MKTAG('S', 'T', 'X', 'C') || stream->readUint32LE() != COMPILEDSTX_VERSION) {
+		debug(3, "Ignoring compiled theme cache '%s' with unknown format", file.getPath().c_str());
+		delete stream;
+		return;
+	}
+
+	uint32 count = stream->readUint32LE();
+	for (uint32 i = 0; i < count; i++) {
+		Common::String key;
+		CompiledSTX entry;
+
+		if (!readCompiledSTXString(*stream, key) || !readCompiledSTXString(*stream, entry.checksum))
+			break;
+
+		uint32 size = stream->readUint32LE();
+		if (stream->eos() || size > (uint32)(stream->size() - stream->pos()))
+			break;
+
+		entry.data.resize(size);
+		stream->read(entry.data.data(), size);
+		_compiledSTX[key] = entry;
+	}
+
+	debug(3, "Loaded %u compiled STX files from '%s'", _compiledSTX.size(), file.getPath().c_str());
+	delete stream;
+}
+
+void ThemeEngine::flushCompiledSTX() {
+	if (!_compiledSTXDirty)
+		return;
+
+	Common::FSNode file = getCompiledSTXFile();
+	Common::WriteStream *stream = file.createWriteStream();
+	if (!stream) {
+		debug(3, "Could not write compiled theme cache '%s'", COMPILEDSTX_FILENAME);
+		return;
+	}
+
+	stream->writeUint32BE(MKTAG('S', 'T', 'X', 'C'));
+	stream->writeUint32LE(COMPILEDSTX_VERSION);
+	stream->writeUint32LE(_compiledSTX.size());
+	for (CompiledSTXMap::const_iterator i = _compiledSTX.begin(); i != _compiledSTX.end(); ++i) {
+		stream->writeUint32LE(i->_key.size());
+		stream->writeString(i->_key);
+		stream->writeUint32LE(i->_value.checksum.size());
+		stream->writeString(i->_value.checksum);
+		stream->writeUint32LE(i->_value.data.size());
+		stream->write(i->_value.data.data(), i->_value.data.size());
+	}
+
+	stream->finalize();
+	if (!stream->err())
+		_compiledSTXDirty = false;
+	delete stream;
+}
+
 
 
 /**********************************************************
@@ -944,17 +1104,143 @@ void ThemeEngine::drawDD(DrawData type, const Common::Rect &r, uint32 dynamic, b
 		return;
 	}
 
-	if (forceRestore || drawData->_layer == kDrawLayerBackground)
+	bool restore = forceRestore || drawData->_layer == kDrawLayerBackground;
+
+	if (drawData->_layer == _layerToDraw)
+		drawDDSteps(type, drawData, area, extendedRect, dynamic, restore);
+	else if (restore)
 		restoreBackground(extendedRect);
+}
+
+static uint64 hashSurfaceArea(const Graphics::ManagedSurface &surface, const Common::Rect &r) {
+	const uint rowBytes = r.width() * surface.format.bytesPerPixel;
+	uint64 hash = 0xCBF29CE484222325ULL;
+
+	for (int y = r.top; y < r.bottom; ++y) {
+		const byte *row = (const byte *)surface.getBasePtr(r.left, y);
+		uint x = 0;
+
+		for (; x + 4 <= rowBytes; x += 4)
+			hash = (hash ^ READ_UINT32(row + x)) * 0x100000001B3ULL;
+		for (; x < rowBytes; ++x)
+			hash = (hash ^ row[x]) * 0x100000001B3ULL;
+	}
+
+	return hash;
+}
+
+static bool compareSurfaceArea(const Graphics::ManagedSurface &surface, const Common::Rect &r, const Graphics::Surface &pixels) {
+	const uint rowBytes = r.width() * surface.format.bytesPerPixel;
 
-	if (drawData->_layer == _layerToDraw) {
-		Common::List<Graphics::DrawStep>::const_iterator step;
-		for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
-			_vectorRenderer->drawStep(area, _clip, *step, dynamic);
+	for (int y = 0; y < r.height(); ++y) {
+		if (memcmp(surface.getBasePtr(r.left, r.top + y), pixels.getBasePtr(0, y), rowBytes))
+			return false;
+	}
+
+	return true;
+}
+
+void ThemeEngine::drawDDSteps(DrawData type, const WidgetDrawData *drawData, const Common::Rect &area,
+	                          const Common::Rect &extendedRect, uint32 dynamic, bool restore) {
+	Graphics::ManagedSurface *target = _vectorRenderer->getActiveSurface();
+	Common::List<Graphics::DrawStep>::const_iterator step;
+
+	Common::Rect region = extendedRect;
+	region.clip(_screen.w, _screen.h);
+
+	// Keep the cache to a couple of screens, and do not let a single
+	// drawing such as a dialog background push out everything else.
+	const uint32 cacheBudget = 2 * _screen.pitch * _screen.h;
+	const uint32 regionSize = region.width() * region.height() * _screen.format.bytesPerPixel;
+	bool cacheable = !region.isEmpty() && !drawData->_steps.empty() && regionSize <= cacheBudget / 4;
+
+	DrawDataCacheKey key;
+	if (cacheable) {
+		// Colors not set by the first step may be used as left behind by
+		// whatever was drawn before.
+		const Graphics::DrawStep &first = drawData->_steps.front();
+		uint32 inherited = 0;
+		if (!first.fgColor.set)
+			inherited |= Graphics::VectorRenderer::kColorStateFg;
+		if (!first.bgColor.set)
+			inherited |= Graphics::VectorRenderer::kColorStateBg;
+		if (!first.bevelColor.set)
+			inherited |= Graphics::VectorRenderer::kColorStateBevel;
+		if (!first.gradColor1.set || !first.gradColor2.set)
+			inherited |= Graphics::VectorRenderer::kColorStateGradient;
+
+		// When restoring, the steps are drawn on top of the back buffer
+		// contents, whatever the active surface holds.
+		const Graphics::ManagedSurface &background = (restore && target != &_backBuffer) ? _backBuffer : *target;
+
+		key.type = type;
+		key.dynamic = dynamic;
+		key.colorState = _vectorRenderer->getColorStateHash(inherited);
+		key.background = hashSurfaceArea(background, region);
+		key.width = area.width();
+		key.height = area.height();
+		key.parity = (area.left & 1) | ((area.top & 1) << 1);
+		key.region = region;
+		key.region.translate(-area.left, -area.top);
+
+		DrawDataCacheMap::iterator cached = _drawDataCacheMap.find(key);
+		if (cached != _drawDataCacheMap.end()) {
+			DrawDataCacheList::iterator entry = cached->_value;
+			if (entry != _drawDataCache.begin()) {
+				_drawDataCache.push_front(*entry);
+				_drawDataCache.erase(entry);
+				entry = cached->_value = _drawDataCache.begin();
+			}
+
+			// Leave the renderer as drawing the steps would have
+			for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step)
+				_vectorRenderer->setupStep(area, _clip, *step, dynamic);
+
+			if (target == &_screen && compareSurfaceArea(*target, region, entry->pixels))
+				return;
+
+			target->copyRectToSurface(entry->pixels, region.left, region.top, Common::Rect(region.width(), region.height()));
+			addDirtyRect(region);
+			return;
 		}
+	}
+
+	if (restore)
+		restoreBackground(extendedRect);
 
-		addDirtyRect(extendedRect);
+	for (step = drawData->_steps.begin(); step != drawData->_steps.end(); ++step) {
+		_vectorRenderer->drawStep(area, _clip, *step, dynamic);
 	}
+
+	addDirtyRect(extendedRect);
+
+	if (!cacheable)
+		return;
+
+	while (_drawDataCacheSize + regionSize > cacheBudget && !_drawDataCache.empty()) {
+		DrawDataCacheEntry &last = _drawDataCache.back();
+		_drawDataCacheSize -= last.pixels.pitch * last.pixels.h;
+		_drawDataCacheMap.erase(last.key);
+		last.pixels.free();
+		_drawDataCache.pop_back();
+	}
+
+	DrawDataCacheEntry entry;
+	entry.key = key;
+	entry.pixels.create(region.width(), region.height(), target->format);
+	entry.pixels.copyRectToSurface(target->rawSurface(), 0, 0, region);
+	_drawDataCache.push_front(entry);
+	_drawDataCacheMap[key] = _drawDataCache.begin();
+	_drawDataCacheSize += entry.pixels.pitch * entry.pixels.h;
+}
+
+void ThemeEngine::flushDrawDataCache() {
+	for (DrawDataCacheList::iterator i = _drawDataCache.begin(); i != _drawDataCache.end(); ++i)
+		i->pixels.free();
+
+	_drawDataCache.clear();
+	_drawDataCacheMap.clear();
+	_drawDataCacheSize = 0;
 }
 
 void ThemeEngine::drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text,
@@ -1471,13 +1757,14 @@ void ThemeEngine::copyBackBufferToScreen() {
 	memcpy(_screen.getPixels(), _backBuffer.getPixels(), (size_t)(_screen.pitch * _screen.h));
 }
 
-void ThemeEngine::updateScreen() {
+bool ThemeEngine::updateScreen() {
 #ifdef LAYOUT_DEBUG_DIALOG
 	_vectorRenderer->fillSurface();
 	_themeEval->debugDraw(&_screen, _font);
 	_vectorRenderer->copyWholeFrame(_system);
+	return true;
 #else
-	updateDirtyScreen();
+	return updateDirtyScreen();
 #endif
 }
 
@@ -1509,9 +1796,9 @@ void ThemeEngine::addDirtyRect(Common::Rect r) {
 	_dirtyScreen.push_back(r);
 }
 
-void ThemeEngine::updateDirtyScreen() {
+bool ThemeEngine::updateDirtyScreen() {
 	if (_dirtyScreen.empty())
-		return;
+		return false;
 
 	Common::List<Common::Rect>::iterator i;
 	for (i = _dirtyScreen.begin(); i != _dirtyScreen.end(); ++i) {
@@ -1519,6 +1806,7 @@ void ThemeEngine::updateDirtyScreen() {
 	}
 
 	_dirtyScreen.clear();
+	return true;
 }
 
 void ThemeEngine::applyScreenShading(ShadingStyle style) {
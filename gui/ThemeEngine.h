@@ -36,7 +36,7 @@
 #include "graphics/pixelformat.h"
 
 
-#define SCUMMVM_THEME_VERSION_STR "SCUMMVM_STX0.9.3"
+#define SCUMMVM_THEME_VERSION_STR "SCUMMVM_STX0.9.8"
 
 class OSystem;
 
@@ -396,8 +396,10 @@ public:
 	/**
 	 * The updateScreen() method is called every frame.
 	 * It copies dirty rectangles in the Screen surface to the overlay.
+	 *
+	 * @return True if anything was copied to the overlay.
 	 */
-	void updateScreen();
+	bool updateScreen();
 
 	/**
 	 * Copy the entire backbuffer surface to the screen surface
@@ -669,6 +671,19 @@ protected:
 	 */
 	bool loadDefaultXML();
 
+	/**
+	 * Parses an STX file, or replays its compiled version if it was parsed
+	 * before with the same contents.
+	 *
+	 * @param key Identifies the file within all themes.
+	 * @param stream The contents of the file. Deleted by this function.
+	 */
+	bool parseSTX(const Common::String &key, Common::SeekableReadStream *stream);
+
+	Common::FSNode getCompiledSTXFile() const;
+	void loadCompiledSTX();
+	void flushCompiledSTX();
+
 	/**
 	 * Unloads the currently loaded theme so another one can
 	 * be loaded.
@@ -688,8 +703,10 @@ protected:
 	/**
 	 * Dirty Screen handling function.
 	 * Draws all the dirty rectangles in the list to the overlay.
+	 *
+	 * @return True if the list contained any rectangle.
 	 */
-	void updateDirtyScreen();
+	bool updateDirtyScreen();
 
 	/**
 	 * Draws a GUI element according to a DrawData descriptor.
@@ -700,6 +717,20 @@ protected:
 	 * These functions are called from all the Widget drawing methods.
 	 */
 	void drawDD(DrawData type, const Common::Rect &r, uint32 dynamic = 0, bool forceRestore = false);
+
+	/**
+	 * Draws the steps of a DrawData, or the pixels they produced the last
+	 * time they were drawn at the same size onto the same background.
+	 *
+	 * The cached region is the one reported as dirty, so drawing steps
+	 * are expected to stay within it. When the active surface already
+	 * holds the right pixels, nothing is marked as dirty.
+	 */
+	void drawDDSteps(DrawData type, const WidgetDrawData *drawData, const Common::Rect &area,
+	                 const Common::Rect &extendedRect, uint32 dynamic, bool restore);
+
+	/** Drops all cached DrawData renderings. */
+	void flushDrawDataCache();
 	void drawDDText(TextData type, TextColor color, const Common::Rect &r, const Common::U32String &text, bool restoreBg,
 	                bool elipsis, Graphics::TextAlign alignH = Graphics::kTextAlignLeft,
 	                TextAlignVertical alignV = kTextAlignVTop, int deltax = 0,
@@ -793,6 +824,46 @@ protected:
 	/** List of all the dirty screens that must be blitted to the overlay. */
 	Common::List<Common::Rect> _dirtyScreen;
 
+	/**
+	 * Identifies a rendered DrawData: what was drawn, where it was drawn
+	 * relative to the pixel grid, and what it was drawn on top of.
+	 */
+	struct DrawDataCacheKey {
+		DrawData type;
+		uint32 dynamic;
+		uint32 colorState;     ///< Hash of the renderer colors inherited by the steps
+		uint64 background;     ///< Hash of the pixels below, before drawing
+		int16 width, height;   ///< Size of the drawing area
+		byte parity;           ///< Parity of the area position, for dithering
+		Common::Rect region;   ///< Cached region, relative to the drawing area
+
+		bool operator==(const DrawDataCacheKey &other) const {
+			return type == other.type && dynamic == other.dynamic && colorState == other.colorState
+				&& background == other.background && width == other.width && height == other.height
+				&& parity == other.parity && region == other.region;
+		}
+	};
+
+	struct DrawDataCacheKeyHash {
+		uint operator()(const DrawDataCacheKey &key) const {
+			return (uint)(key.background ^ (key.background >> 32)) ^ ((uint)key.type << 24) ^ key.dynamic
+				^ ((uint)key.width << 16) ^ (uint)key.height;
+		}
+	};
+
+	struct DrawDataCacheEntry {
+		DrawDataCacheKey key;
+		Graphics::Surface pixels;
+	};
+
+	typedef Common::List<DrawDataCacheEntry> DrawDataCacheList;
+	typedef Common::HashMap<DrawDataCacheKey, DrawDataCacheList::iterator, DrawDataCacheKeyHash> DrawDataCacheMap;
+
+	/** Rendered DrawData, the most recently used first. */
+	DrawDataCacheList _drawDataCache;
+	DrawDataCacheMap _drawDataCacheMap;
+	uint32 _drawDataCacheSize;
+
 	bool _initOk;  ///< Class and renderer properly initialized
 	bool _themeOk; ///< Theme data successfully loaded.
 	bool _enabled; ///< Whether the Theme is currently shown on the overlay
@@ -817,6 +888,19 @@ protected:
 #endif
 
 	Common::Rect _clip;
+
+	/** An STX file in the compiled format of Common::XMLParser. */
+	struct CompiledSTX {
+		Common::String checksum; ///< MD5 of the STX file
+		Common::Array<byte> data;
+	};
+
+	typedef Common::HashMap<Common::String, CompiledSTX> CompiledSTXMap;
+
+	/** Compiled STX files of all themes, stored next to the configuration file. */
+	CompiledSTXMap _compiledSTX;
+	bool _compiledSTXLoaded;
+	bool _compiledSTXDirty;
 };
 
 } // End of namespace GUI.
@@ -214,6 +214,13 @@ void BrowserDialog::handleCommand(CommandSender *sender, uint32 cmd, uint32 data
 	}
 }
 
+Common::U32String BrowserDialog::getNodeName(void *arg, int idx) {
+	const Common::FSNode &node = ((BrowserDialog *)arg)->_nodeContent[idx];
+	if (node.isDirectory())
+		return node.getName() + "/";
+	return node.getName();
+}
+
 void BrowserDialog::updateListing() {
 	// Update the path display
 	_currentPath->setEditString(_node.getPath());
@@ -230,16 +237,11 @@ void BrowserDialog::updateListing() {
 	else
 		Common::sort(_nodeContent.begin(), _nodeContent.end());
 
-	// Populate the ListWidget
-	Common::U32StringArray list;
+	// Populate the ListWidget. The names are only fetched for the entries
+	// which are shown, which matters for directories with many files.
 	ListWidget::ColorList colors;
-	for (Common::FSList::iterator i = _nodeContent.begin(); i != _nodeContent.end(); ++i) {
-		if (i->isDirectory())
-			list.push_back(i->getName() + "/");
-		else
-			list.push_back(i->getName());
-
-		if (_isDirBrowser) {
+	if (_isDirBrowser) {
+		for (Common::FSList::iterator i = _nodeContent.begin(); i != _nodeContent.end(); ++i) {
 			if (i->isDirectory())
 				colors.push_back(ThemeEngine::kFontColorNormal);
 			else
@@ -247,10 +249,7 @@ void BrowserDialog::updateListing() {
 		}
 	}
 
-	if (_isDirBrowser)
-		_fileList->setList(list, &colors);
-	else
-		_fileList->setList(list);
+	_fileList->setItemSource(_nodeContent.size(), getNodeName, this, _isDirBrowser ? &colors : nullptr);
 	_fileList->scrollTo(0);
 
 	// Finally, redraw
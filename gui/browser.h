@@ -57,6 +57,8 @@ protected:
 	bool				_isDirBrowser;
 
 	void updateListing();
+
+	static Common::U32String getNodeName(void *arg, int idx);
 };
 
 } // End of namespace GUI
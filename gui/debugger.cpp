@@ -25,6 +25,8 @@
 #include "common/file.h"
 #include "common/debug.h"
 #include "common/debug-channels.h"
+#include "common/memtracker.h"
+#include "common/profiler.h"
 #include "common/system.h"
 
 #ifndef DISABLE_MD5
@@ -79,6 +81,10 @@ Debugger::Debugger() {
 	registerCmd("debugflag_list",		WRAP_METHOD(Debugger, cmdDebugFlagsList));
 	registerCmd("debugflag_enable",	WRAP_METHOD(Debugger, cmdDebugFlagEnable));
 	registerCmd("debugflag_disable",	WRAP_METHOD(Debugger, cmdDebugFlagDisable));
+	registerCmd("memory",			WRAP_METHOD(Debugger, cmdMemory));
+#ifdef USE_PROFILER
+	registerCmd("profiler",			WRAP_METHOD(Debugger, cmdProfiler));
+#endif
 }
 
 Debugger::~Debugger() {
@@ -814,6 +820,77 @@ bool Debugger::cmdDebugFlagDisable(int argc, const char **argv) {
 	return true;
 }
 
+bool Debugger::cmdMemory(int argc, const char **argv) {
+	if (argc == 3 && !strcmp(argv[1], "budget")) {
+		MemTracker.setBudget((size_t)MAX(atoi(argv[2]), 0) * 1024 * 1024);
+		MemTracker.checkBudget();
+	} else if (argc != 1) {
+		debugPrintf("Usage: %s [budget <megabytes>]\n", argv[0]);
+		debugPrintf("Lists the memory held by the caches, or sets the budget they share. 0 means no limit.\n");
+		return true;
+	}
+
+	static const char *const priorities[] = { "low", "normal", "high" };
+
+	const Common::Array<Common::MemoryTracker::Consumer> &consumers = MemTracker.getConsumers();
+	debugPrintf("%-32s %-8s %10s\n", "Cache", "Priority", "Size (KB)");
+	for (uint i = 0; i < consumers.size(); i++) {
+		const Common::MemoryTracker::Consumer &consumer = consumers[i];
+		debugPrintf("%-32s %-8s %10u\n", consumer.consumer->getMemoryConsumerName(), priorities[consumer.priority],
+		            (uint)(consumer.consumer->getMemoryUsage() / 1024));
+	}
+
+	debugPrintf("Total: %u KB\n", (uint)(MemTracker.getTotalUsage() / 1024));
+	if (MemTracker.getBudget())
+		debugPrintf("Budget: %u KB\n", (uint)(MemTracker.getBudget() / 1024));
+	else
+		debugPrintf("Budget: none\n");
+	return true;
+}
+
+#ifdef USE_PROFILER
+bool Debugger::cmdProfiler(int argc, const char **argv) {
+	Common::Profiler &profiler = Common::Profiler::instance();
+
+	if (argc == 2 && !strcmp(argv[1], "start")) {
+		profiler.start();
+		debugPrintf("Recording profiling markers\n");
+	} else if (argc == 2 && !strcmp(argv[1], "stop")) {
+		profiler.stop();
+		debugPrintf("Stopped recording profiling markers\n");
+	} else if (argc == 2 && !strcmp(argv[1], "stats")) {
+		const Common::Array<Common::Profiler::Summary> summaries = profiler.getSummaries();
+		if (summaries.empty()) {
+			debugPrintf("No profiling markers recorded\n");
+			return true;
+		}
+
+		debugPrintf("%-24s %8s %12s %10s %10s\n", "Marker", "Count", "Total (ms)", "Avg (us)", "Max (us)");
+		for (uint i = 0; i < summaries.size(); i++) {
+			const Common::Profiler::Summary &summary = summaries[i];
+			debugPrintf("%-24s %8u %12u %10u %10u\n", summary.name, summary.count,
+			            (uint)(summary.totalTime / 1000), (uint)(summary.totalTime / summary.count), summary.maxTime);
+		}
+	} else if (argc == 3 && !strcmp(argv[1], "dump")) {
+		Common::DumpFile file;
+		if (!file.open(argv[2])) {
+			debugPrintf("Can't open file %s\n", argv[2]);
+			return true;
+		}
+
+		if (profiler.writeChromeTrace(file) && file.flush())
+			debugPrintf("Wrote the profiling markers to %s\n", argv[2]);
+		else
+			debugPrintf("Failed to write the profiling markers to %s\n", argv[2]);
+	} else {
+		debugPrintf("Usage: %s start | stop | stats | dump <file>\n", argv[0]);
+		debugPrintf("The dump is in Chrome's trace format, to be opened with chrome://tracing\n");
+	}
+
+	return true;
+}
+#endif
+
 // Console handler
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 bool Debugger::debuggerInputCallback(GUI::ConsoleDialog *console, const char *input, void *refCon) {
@@ -273,6 +273,10 @@ protected:
 	bool cmdDebugFlagEnable(int argc, const char **argv);
 	bool cmdDebugFlagDisable(int argc, const char **argv);
 	bool cmdExecFile(int argc, const char **argv);
+	bool cmdMemory(int argc, const char **argv);
+#ifdef USE_PROFILER
+	bool cmdProfiler(int argc, const char **argv);
+#endif
 
 #ifndef USE_TEXT_CONSOLE_FOR_DEBUGGER
 private:
@@ -44,6 +44,9 @@ enum {
 	kReverbWidthChangedCmd		= 'rwic',
 	kReverbLevelChangedCmd		= 'rlec',
 
+	kPolyphonyChangedCmd		= 'mpoc',
+	kCpuCoresChangedCmd		= 'mccc',
+
 	kResetSettingsCmd		= 'rese'
 };
 
@@ -145,6 +148,28 @@ FluidSynthSettingsDialog::FluidSynthSettingsDialog()
 	_miscInterpolationPopUp->appendEntry(_("Fourth-order"), kInterpolation4thOrder);
 	_miscInterpolationPopUp->appendEntry(_("Seventh-order"), kInterpolation7thOrder);
 
+	_miscPolyphonyDesc = new StaticTextWidget(_tabWidget, "FluidSynthSettings_Misc.PolyphonyText", _("Polyphony:"), _("Maximum number of voices played at once. Fewer voices are faster, but notes may be cut off."));
+	_miscPolyphonySlider = new SliderWidget(_tabWidget, "FluidSynthSettings_Misc.PolyphonySlider", Common::U32String(), kPolyphonyChangedCmd);
+	// 16 - 1024, Default: 256
+	_miscPolyphonySlider->setMinValue(16);
+	_miscPolyphonySlider->setMaxValue(1024);
+	_miscPolyphonyLabel = new StaticTextWidget(_tabWidget, "FluidSynthSettings_Misc.PolyphonyLabel", Common::U32String("256"));
+
+	_miscCpuCoresDesc = new StaticTextWidget(_tabWidget, "FluidSynthSettings_Misc.CpuCoresText", _("CPU cores:"), _("Number of processor cores FluidSynth renders the voices on."));
+	_miscCpuCoresSlider = new SliderWidget(_tabWidget, "FluidSynthSettings_Misc.CpuCoresSlider", Common::U32String(), kCpuCoresChangedCmd);
+	// 1 - 16, Default: 1
+	_miscCpuCoresSlider->setMinValue(1);
+	_miscCpuCoresSlider->setMaxValue(16);
+	_miscCpuCoresLabel = new StaticTextWidget(_tabWidget, "FluidSynthSettings_Misc.CpuCoresLabel", Common::U32String("1"));
+
+	_miscRenderAheadPopUpDesc = new StaticTextWidget(_tabWidget, "FluidSynthSettings_Misc.RenderAheadText", _("Render ahead:"), _("Render the FluidSynth output ahead on a separate thread. Only used on platforms which support threads"));
+	_miscRenderAheadPopUp = new PopUpWidget(_tabWidget, "FluidSynthSettings_Misc.RenderAhead");
+
+	_miscRenderAheadPopUp->appendEntry(_("Off"), 0);
+	_miscRenderAheadPopUp->appendEntry(_("50 ms"), 50);
+	_miscRenderAheadPopUp->appendEntry(_("100 ms"), 100);
+	_miscRenderAheadPopUp->appendEntry(_("200 ms"), 200);
+
 	_tabWidget->setActiveTab(0);
 
 	new ButtonWidget(this, "FluidSynthSettings.ResetSettings", _("Reset"), _("Reset all FluidSynth settings to their default values."), kResetSettingsCmd);
@@ -213,6 +238,14 @@ void FluidSynthSettingsDialog::handleCommand(CommandSender *sender, uint32 cmd,
 		_reverbLevelLabel->setLabel(Common::String::format("%d", _reverbLevelSlider->getValue()));
 		_reverbLevelLabel->markAsDirty();
 		break;
+	case kPolyphonyChangedCmd:
+		_miscPolyphonyLabel->setLabel(Common::String::format("%d", _miscPolyphonySlider->getValue()));
+		_miscPolyphonyLabel->markAsDirty();
+		break;
+	case kCpuCoresChangedCmd:
+		_miscCpuCoresLabel->setLabel(Common::String::format("%d", _miscCpuCoresSlider->getValue()));
+		_miscCpuCoresLabel->markAsDirty();
+		break;
 	case kResetSettingsCmd: {
 		MessageDialog alert(_("Do you really want to reset all FluidSynth settings to their default values?"), _("Yes"), _("No"));
 		if (alert.runModal() == GUI::kMessageOK) {
@@ -301,6 +334,12 @@ void FluidSynthSettingsDialog::readSettings() {
 		_miscInterpolationPopUp->setSelectedTag(kInterpolation7thOrder);
 	}
 
+	_miscPolyphonySlider->setValue(ConfMan.getInt("fluidsynth_misc_polyphony", _domain));
+	_miscPolyphonyLabel->setLabel(Common::String::format("%d", _miscPolyphonySlider->getValue()));
+	_miscCpuCoresSlider->setValue(ConfMan.getInt("fluidsynth_misc_cpu_cores", _domain));
+	_miscCpuCoresLabel->setLabel(Common::String::format("%d", _miscCpuCoresSlider->getValue()));
+	_miscRenderAheadPopUp->setSelectedTag(ConfMan.getInt("fluidsynth_misc_render_ahead", _domain));
+
 	// This may trigger redrawing, so don't do it until all sliders have
 	// their proper values. Otherwise, the dialog may crash because of
 	// invalid slider values.
@@ -343,6 +382,10 @@ void FluidSynthSettingsDialog::writeSettings() {
 		ConfMan.removeKey("fluidsynth_misc_interpolation", _domain);
 	}
 
+	ConfMan.setInt("fluidsynth_misc_polyphony", _miscPolyphonySlider->getValue(), _domain);
+	ConfMan.setInt("fluidsynth_misc_cpu_cores", _miscCpuCoresSlider->getValue(), _domain);
+	ConfMan.setInt("fluidsynth_misc_render_ahead", _miscRenderAheadPopUp->getSelectedTag(), _domain);
+
 	// The main options dialog is responsible for writing the config file.
 	// That's why we don't actually flush the settings to the file here.
 }
@@ -362,6 +405,9 @@ void FluidSynthSettingsDialog::resetSettings() {
 	ConfMan.removeKey("fluidsynth_reverb_level", _domain);
 
 	ConfMan.removeKey("fluidsynth_misc_interpolation", _domain);
+	ConfMan.removeKey("fluidsynth_misc_polyphony", _domain);
+	ConfMan.removeKey("fluidsynth_misc_cpu_cores", _domain);
+	ConfMan.removeKey("fluidsynth_misc_render_ahead", _domain);
 }
 
 } // End of namespace GUI
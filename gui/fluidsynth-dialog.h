@@ -97,6 +97,17 @@ private:
 
 	StaticTextWidget *_miscInterpolationPopUpDesc;
 	PopUpWidget *_miscInterpolationPopUp;
+
+	StaticTextWidget *_miscPolyphonyDesc;
+	SliderWidget *_miscPolyphonySlider;
+	StaticTextWidget *_miscPolyphonyLabel;
+
+	StaticTextWidget *_miscCpuCoresDesc;
+	SliderWidget *_miscCpuCoresSlider;
+	StaticTextWidget *_miscCpuCoresLabel;
+
+	StaticTextWidget *_miscRenderAheadPopUpDesc;
+	PopUpWidget *_miscRenderAheadPopUp;
 };
 
 } // End of namespace GUI
@@ -31,6 +31,8 @@
 #include "common/unzip.h"
 #include "gui/EventRecorder.h"
 
+#include "base/version.h"
+
 #include "backends/keymapper/action.h"
 #include "backends/keymapper/keymap.h"
 #include "backends/keymapper/keymapper.h"
@@ -55,12 +57,20 @@ enum {
 	kDoubleClickDelay = 500, // milliseconds
 	kCursorAnimateDelay = 250,
 	kTooltipDelay = 1250,
-	kTooltipSameWidgetDelay = 7000
+	kTooltipSameWidgetDelay = 7000,
+	kIdleTimeout = 500,           // Time without any activity before runLoop() sleeps longer
+	kIdleFrameDuration = 50,      // Longest sleep of an idle runLoop() frame
+	kIdleScreenUpdateDelay = 100, // Screen update interval while idle, for overlays drawn by the backend
+	kIdleStatsInterval = 5000
+};
+
+enum {
+	kSVGRasterCacheSize = 8 * 1024 * 1024
 };
 
 // Constructor
 GuiManager::GuiManager() : _redrawStatus(kRedrawDisabled), _stateIsSaved(false),
-	_cursorAnimateCounter(0), _cursorAnimateTimer(0) {
+	_cursorAnimateCounter(0), _cursorAnimateTimer(0), _svgRasterCache(kSVGRasterCacheSize) {
 	_theme = nullptr;
 	_useStdCursor = false;
 
@@ -117,6 +127,8 @@ void GuiManager::initIconsSet() {
 	Common::Archive *dat;
 
 	_iconsSet.clear();
+	_iconsSetId.clear();
+	_svgRasterCache.clear();
 
 	if (ConfMan.hasKey("iconspath")) {
 		Common::FSDirectory *iconDir = new Common::FSDirectory(ConfMan.get("iconspath"));
@@ -132,6 +144,7 @@ void GuiManager::initIconsSet() {
 
 			if (dat) {
 				_iconsSet.add((*ic)->getName(), dat);
+				_iconsSetId += (*ic)->getName() + ";";
 			}
 		}
 
@@ -169,6 +182,8 @@ void GuiManager::initIconsSet() {
 	}
 
 	_iconsSet.add(fname, dat);
+	// The bundled icon pack changes with the ScummVM version
+	_iconsSetId += Common::String::format("%s:%s", fname, gScummVMVersion);
 
 	debug(2, "GUI: Loaded icon file: %s", fname);
 }
@@ -338,11 +353,11 @@ void GuiManager::redrawFull() {
 	_system->updateScreen();
 }
 
-void GuiManager::redraw() {
+bool GuiManager::redraw() {
 	ThemeEngine::ShadingStyle shading;
 
 	if (_dialogStack.empty())
-		return;
+		return false;
 
 	shading = (ThemeEngine::ShadingStyle)xmlEval()->getVar("Dialog." + _dialogStack.top()->_name + ".Shading", 0);
 
@@ -399,8 +414,9 @@ void GuiManager::redraw() {
 	_theme->drawToScreen();
 	_dialogStack.top()->drawWidgets();
 
-	_theme->updateScreen();
+	bool changed = _theme->updateScreen() || _redrawStatus != kRedrawDisabled;
 	_redrawStatus = kRedrawDisabled;
+	return changed;
 }
 
 Dialog *GuiManager::getTopDialog() const {
@@ -463,6 +479,8 @@ void GuiManager::runLoop() {
 
 	Common::EventManager *eventMan = _system->getEventManager();
 	const uint32 targetFrameDuration = 1000 / 60;
+	uint32 lastActivityTime = _system->getMillis(true);
+	uint32 lastScreenUpdateTime = lastActivityTime;
 
 	while (!_dialogStack.empty() && activeDialog == getTopDialog() && !eventMan->shouldQuit() && (!g_engine || !eventMan->shouldReturnToLauncher())) {
 		uint32 frameStartTime = _system->getMillis(true);
@@ -472,12 +490,20 @@ void GuiManager::runLoop() {
 
 		activeDialog->handleTickle();
 
+		// The animated cursor is drawn by the backend, so it needs a screen
+		// update even if the GUI itself did not change.
+		bool cursorChanged = false;
 		if (_useStdCursor)
-			animateCursor();
+			cursorChanged = animateCursor();
+
+		// Whether anything happened in this frame
+		bool active = false;
 
 		Common::Event event;
 
 		while (eventMan->pollEvent(event)) {
+			active = true;
+
 			// We will need to check whether the screen changed while polling
 			// for an event here. While we do send EVENT_SCREEN_CHANGED
 			// whenever this happens we still cannot be sure that we get such
@@ -547,25 +573,49 @@ void GuiManager::runLoop() {
 					tooltip->setup(activeDialog, wdg, _lastMousePosition.x, _lastMousePosition.y);
 					tooltip->runModal();
 					delete tooltip;
+					active = true;
 				}
 			}
 		}
 
-		redraw();
-
-		// Delay until the allocated frame time is elapsed to match the target frame rate.
-		// In case we have vsync enabled, we should rely on vsync to do take care about frame times.
-		// With vsync enabled, we currently have to force a frame time of 1ms since otherwise
-		// CPU usage will skyrocket on one thread as soon as no updateScreen(); calls happening.
-		if (g_system->getFeatureState(OSystem::kFeatureVSync)) {
-			_system->delayMillis(1);
+		if (redraw())
+			active = true;
+
+		uint32 frameEndTime = _system->getMillis(true);
+		if (active)
+			lastActivityTime = frameEndTime;
+
+		// Skip the screen update when nothing changed. Still update the screen
+		// from time to time, for OSD messages and other things the backend
+		// draws on top of the overlay.
+		bool screenDirty = active || cursorChanged || frameEndTime - lastScreenUpdateTime >= kIdleScreenUpdateDelay;
+
+		uint32 idleTime = 0;
+		if (frameEndTime - lastActivityTime >= kIdleTimeout) {
+			// When nothing happened for a while, sleep until the next tooltip or
+			// cursor animation is due. The sleep is bounded, so that dialogs
+			// which do work in handleTickle() still run and input is picked up
+			// quickly.
+			idleTime = getIdleDelay(frameEndTime);
+		} else if (screenDirty && g_system->getFeatureState(OSystem::kFeatureVSync)) {
+			// Delay until the allocated frame time is elapsed to match the target frame rate.
+			// In case we have vsync enabled, we should rely on vsync to do take care about frame times.
+			// With vsync enabled, we currently have to force a frame time of 1ms since otherwise
+			// CPU usage will skyrocket on one thread as soon as no updateScreen(); calls happening.
+			idleTime = 1;
 		} else {
-			uint32 actualFrameDuration = _system->getMillis(true) - frameStartTime;
-			if (actualFrameDuration < targetFrameDuration) {
-				_system->delayMillis(targetFrameDuration - actualFrameDuration);
-			}
+			uint32 actualFrameDuration = frameEndTime - frameStartTime;
+			if (actualFrameDuration < targetFrameDuration)
+				idleTime = targetFrameDuration - actualFrameDuration;
 		}
-		_system->updateScreen();
+
+		if (idleTime)
+			_system->delayMillis(idleTime);
+		if (screenDirty) {
+			_system->updateScreen();
+			lastScreenUpdateTime = _system->getMillis(true);
+		}
+		updateIdleStats(_system->getMillis(true), idleTime, screenDirty);
 	}
 
 	// WORKAROUND: When quitting we might not properly close the dialogs on
@@ -676,7 +726,7 @@ void GuiManager::setupCursor() {
 // SCUMM games, but the code no longer resembles what we have in cursor.cpp
 // very much. We could plug in a different cursor here if we like to.
 
-void GuiManager::animateCursor() {
+bool GuiManager::animateCursor() {
 	int time = _system->getMillis(true);
 	if (time > _cursorAnimateTimer + kCursorAnimateDelay) {
 		for (int i = 0; i < 15; i++) {
@@ -690,7 +740,47 @@ void GuiManager::animateCursor() {
 
 		_cursorAnimateTimer = time;
 		_cursorAnimateCounter = (_cursorAnimateCounter + 1) % 4;
+		return true;
 	}
+	return false;
+}
+
+uint32 GuiManager::getIdleDelay(uint32 time) const {
+	uint32 delay = kIdleFrameDuration;
+
+	// Wake up when the cursor animation is due
+	if (_useStdCursor) {
+		uint32 next = _cursorAnimateTimer + kCursorAnimateDelay + 1;
+		if (next > time)
+			delay = MIN<uint32>(delay, next - time);
+	}
+
+	// Wake up when the tooltip of the widget under the mouse is due
+	if (_lastTooltipShown.x != _lastMousePosition.x || _lastTooltipShown.y != _lastMousePosition.y) {
+		uint32 next = _lastMousePosition.time + kTooltipDelay + 1;
+		if (next > time)
+			delay = MIN<uint32>(delay, next - time);
+	}
+
+	return delay;
+}
+
+void GuiManager::updateIdleStats(uint32 time, uint32 idleTime, bool updatedScreen) {
+	_idleStats.idleTime += idleTime;
+	_idleStats.frames++;
+	if (updatedScreen)
+		_idleStats.screenUpdates++;
+
+	uint32 elapsed = time - _idleStats.start;
+	if (elapsed < kIdleStatsInterval)
+		return;
+
+	if (_idleStats.start)
+		debug(3, "GUI: %u%% idle, %u frames, %u screen updates in %u ms", MIN<uint32>(_idleStats.idleTime * 100 / elapsed, 100),
+		      _idleStats.frames, _idleStats.screenUpdates, elapsed);
+
+	_idleStats = IdleStats();
+	_idleStats.start = time;
 }
 
 bool GuiManager::checkScreenChange() {
@@ -28,6 +28,8 @@
 #include "common/str.h"
 #include "common/list.h"
 
+#include "graphics/svg.h"
+
 #include "gui/ThemeEngine.h"
 #include "gui/widget.h"
 
@@ -92,6 +94,11 @@ public:
 	ThemeEval *xmlEval() { return _theme->getEvaluator(); }
 
 	Common::SearchSet &getIconsSet() { return _iconsSet; }
+	/** Identifies the loaded icon packs, for caching data derived from them. */
+	const Common::String &getIconsSetId() const { return _iconsSetId; }
+
+	/** Rasters of the SVG images of the theme and the icon packs, shared between dialogs and theme reloads. */
+	Graphics::SVGRasterCache &getSVGRasterCache() { return _svgRasterCache; }
 
 	int16 getGUIWidth() const { return _baseWidth; }
 	int16 getGUIHeight() const { return _baseHeight; }
@@ -163,6 +170,9 @@ protected:
 	int			_topDialogRightPadding;
 
 	Common::SearchSet _iconsSet;
+	Common::String _iconsSetId;
+
+	Graphics::SVGRasterCache _svgRasterCache;
 
 	// position and time of last mouse click (used to detect double clicks)
 	struct MousePos {
@@ -184,6 +194,15 @@ protected:
 	int		_cursorAnimateTimer;
 	byte	_cursor[2048];
 
+	// time spent waiting in runLoop(), reported with debug level 3
+	struct IdleStats {
+		IdleStats() : start(0), idleTime(0), frames(0), screenUpdates(0) {}
+		uint32 start;         // Start of the current report period
+		uint32 idleTime;      // Time spent sleeping in this period
+		uint32 frames;        // Frames run in this period
+		uint32 screenUpdates; // Frames which updated the screen in this period
+	} _idleStats;
+
 	// delayed deletion of GuiObject
 	struct GuiObjectTrashItem {
 		GuiObject* object;
@@ -200,10 +219,13 @@ protected:
 	void openDialog(Dialog *dialog);
 	void closeTopDialog();
 
-	void redraw();
+	bool redraw();
 
 	void setupCursor();
-	void animateCursor();
+	bool animateCursor();
+
+	uint32 getIdleDelay(uint32 time) const;
+	void updateIdleStats(uint32 time, uint32 idleTime, bool updatedScreen);
 
 	Dialog *getTopDialog() const;
 
@@ -61,12 +61,24 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	_dirTotal(0),
 	_okButton(nullptr),
 	_dirProgressText(nullptr),
-	_gameProgressText(nullptr) {
+	_gameProgressText(nullptr),
+	_listedAhead(0),
+	_workersStarted(false),
+	_quitWorkers(false) {
 
 	Common::U32StringArray l;
 
+	// Listing directories is the slow part on network mounts, so let
+	// worker threads do it ahead of the scan when the backend allows
+	if (_jobSemaphore.isValid()) {
+		for (int i = 0; i < kListWorkerCount; i++) {
+			if (_workers[i].start(workerProc, this))
+				_workersStarted = true;
+		}
+	}
+
 	// The dir we start our scan at
-	_scanStack.push(startDir);
+	pushScanJob(startDir);
 
 	// Removed for now... Why would you put a title on mass add dialog called "Mass Add Dialog"?
 	// new StaticTextWidget(this, "massadddialog_caption", "Mass Add Dialog");
@@ -106,6 +118,79 @@ MassAddDialog::MassAddDialog(const Common::FSNode &startDir)
 	}
 }
 
+MassAddDialog::~MassAddDialog() {
+	stopWorkers();
+
+	while (!_scanStack.empty())
+		delete _scanStack.pop();
+}
+
+void MassAddDialog::pushScanJob(const Common::FSNode &dir) {
+	ScanJob *job = new ScanJob();
+	job->dir = dir;
+	job->state = ScanJob::kStatePending;
+	job->success = false;
+	_scanStack.push(job);
+
+	if (_workersStarted) {
+		Common::StackLock lock(_jobMutex);
+		_pendingJobs.push_back(job);
+		_jobSemaphore.post();
+	}
+}
+
+void MassAddDialog::stopWorkers() {
+	if (!_workersStarted)
+		return;
+
+	{
+		Common::StackLock lock(_jobMutex);
+		_quitWorkers = true;
+		_pendingJobs.clear();
+	}
+
+	for (int i = 0; i < kListWorkerCount; i++)
+		_jobSemaphore.post();
+	for (int i = 0; i < kListWorkerCount; i++)
+		_workers[i].join();
+
+	_workersStarted = false;
+}
+
+void MassAddDialog::workerProc(void *data) {
+	((MassAddDialog *)data)->runWorker();
+}
+
+void MassAddDialog::runWorker() {
+	for (;;) {
+		_jobSemaphore.wait();
+
+		ScanJob *job = nullptr;
+		{
+			Common::StackLock lock(_jobMutex);
+			if (_quitWorkers)
+				return;
+
+			if (!_pendingJobs.empty() && _listedAhead < kMaxListedAhead) {
+				job = _pendingJobs.back();
+				_pendingJobs.pop_back();
+				job->state = ScanJob::kStateListing;
+				_listedAhead++;
+			}
+		}
+
+		if (!job)
+			continue;
+
+		// The GUI thread leaves the job alone until it is marked as listed
+		bool success = job->dir.getChildren(job->files, Common::FSNode::kListAll);
+
+		Common::StackLock lock(_jobMutex);
+		job->success = success;
+		job->state = ScanJob::kStateListed;
+	}
+}
+
 struct GameTargetLess {
 	bool operator()(const DetectedGame &x, const DetectedGame &y) const {
 		return x.preferredTarget.compareToIgnoreCase(y.preferredTarget) < 0;
@@ -166,10 +251,36 @@ void MassAddDialog::handleTickle() {
 
 	// Perform a breadth-first scan of the filesystem.
 	while (!_scanStack.empty() && (g_system->getMillis() - t) < kMaxScanTime) {
-		Common::FSNode dir = _scanStack.pop();
+		ScanJob *job = _scanStack.top();
+		bool listHere = true;
+
+		if (_workersStarted) {
+			Common::StackLock lock(_jobMutex);
+			if (job->state == ScanJob::kStateListing) {
+				// A worker is busy with it, check again on the next tickle
+				break;
+			} else if (job->state == ScanJob::kStateListed) {
+				listHere = false;
+				_listedAhead--;
+				_jobSemaphore.post();
+			} else {
+				Common::Array<ScanJob *>::iterator i = Common::find(_pendingJobs.begin(), _pendingJobs.end(), job);
+				if (i != _pendingJobs.end())
+					_pendingJobs.erase(i);
+			}
+		}
 
-		Common::FSList files;
-		if (!dir.getChildren(files, Common::FSNode::kListAll)) {
+		_scanStack.pop();
+
+		if (listHere)
+			job->success = job->dir.getChildren(job->files, Common::FSNode::kListAll);
+
+		const Common::FSNode dir = job->dir;
+		const Common::FSList files = job->files;
+		bool success = job->success;
+		delete job;
+
+		if (!success) {
 			continue;
 		}
 
@@ -231,7 +342,7 @@ void MassAddDialog::handleTickle() {
 		// Recurse into all subdirs
 		for (Common::FSList::const_iterator file = files.begin(); file != files.end(); ++file) {
 			if (file->isDirectory()) {
-				_scanStack.push(*file);
+				pushScanJob(*file);
 
 				_dirTotal++;
 			}
@@ -250,6 +361,8 @@ void MassAddDialog::handleTickle() {
 	Common::U32String buf;
 
 	if (_scanStack.empty()) {
+		stopWorkers();
+
 		// Enable the OK button
 		_okButton->setEnabled(true);
 
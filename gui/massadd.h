@@ -26,8 +26,10 @@
 #include "gui/widgets/list.h"
 #include "common/fs.h"
 #include "common/hashmap.h"
+#include "common/mutex.h"
 #include "common/stack.h"
 #include "common/str.h"
+#include "common/thread.h"
 
 namespace GUI {
 
@@ -36,6 +38,7 @@ class StaticTextWidget;
 class MassAddDialog : public Dialog {
 public:
 	MassAddDialog(const Common::FSNode &startDir);
+	~MassAddDialog() override;
 
 	//void open();
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
@@ -48,9 +51,55 @@ public:
 	}
 
 private:
-	Common::Stack<Common::FSNode>  _scanStack;
+	enum {
+		/** Number of threads listing directories ahead of the detection. */
+		kListWorkerCount = 4,
+		/** Upper bound for directories listed but not yet scanned. */
+		kMaxListedAhead = 64
+	};
+
+	/**
+	 * A directory waiting to be scanned. Its contents are either listed by
+	 * one of the worker threads, or by the GUI thread when it gets to the
+	 * directory first.
+	 */
+	struct ScanJob {
+		enum State {
+			kStatePending,
+			kStateListing,
+			kStateListed
+		};
+
+		Common::FSNode dir;
+		Common::FSList files;
+		State state;
+		bool success;
+	};
+
+	/**
+	 * Directories in scanning order. Only the GUI thread uses this, so the
+	 * order, and thus the result, does not depend on the worker threads.
+	 */
+	Common::Stack<ScanJob *> _scanStack;
 	DetectedGames _games;
 
+	/**
+	 * Jobs not yet taken by a worker, guarded by _jobMutex. Workers take the
+	 * most recent one, which is also the next one to be scanned.
+	 */
+	Common::Array<ScanJob *> _pendingJobs;
+	Common::Mutex _jobMutex;
+	Common::Semaphore _jobSemaphore;
+	Common::Thread _workers[kListWorkerCount];
+	uint _listedAhead;
+	bool _workersStarted;
+	bool _quitWorkers;
+
+	void pushScanJob(const Common::FSNode &dir);
+	void stopWorkers();
+	void runWorker();
+	static void workerProc(void *data);
+
 	/**
 	 * Map each path occuring in the config file to the target(s) using that path.
 	 * Used to detect whether a potential new target is already present in the
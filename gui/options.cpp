@@ -44,11 +44,13 @@
 #include "common/updates.h"
 #include "common/util.h"
 #include "common/text-to-speech.h"
+#include "common/threadpool.h"
 
 #include "audio/mididrv.h"
 #include "audio/musicplugin.h"
 #include "audio/mixer.h"
 #include "audio/fmopl.h"
+#include "audio/softsynth/mt32.h"
 #include "widgets/scrollcontainer.h"
 #include "widgets/edittext.h"
 
@@ -112,6 +114,12 @@ enum {
 };
 #endif
 
+#ifdef USE_MT32EMU
+// The popup tags are the indices into these
+static const char *const mt32AnalogOutputModes[] = { "digital", "coarse", "accurate", "oversampled" };
+static const char *const mt32Resamplers[] = { "mixer", "fastest", "fast", "good", "best" };
+#endif
+
 #ifdef USE_CLOUD
 enum {
 	kStoragePopUpCmd = 'sPup',
@@ -189,6 +197,8 @@ void OptionsDialog::init() {
 	_scalerPopUp = nullptr;
 	_scalerPopUpDesc = nullptr;
 	_scaleFactorPopUp = nullptr;
+	_workerThreadsPopUpDesc = nullptr;
+	_workerThreadsPopUp = nullptr;
 	_fullscreenCheckbox = nullptr;
 	_filteringCheckbox = nullptr;
 	_aspectCheckbox = nullptr;
@@ -220,6 +230,13 @@ void OptionsDialog::init() {
 	_mt32DevicePopUp = nullptr;
 	_mt32DevicePopUpDesc = nullptr;
 	_enableGSCheckbox = nullptr;
+	_mt32PartialsPopUpDesc = nullptr;
+	_mt32PartialsPopUp = nullptr;
+	_mt32AnalogOutputPopUpDesc = nullptr;
+	_mt32AnalogOutputPopUp = nullptr;
+	_mt32ResamplerPopUpDesc = nullptr;
+	_mt32ResamplerPopUp = nullptr;
+	_mt32LoadText = nullptr;
 	_enableVolumeSettings = false;
 	_musicVolumeDesc = nullptr;
 	_musicVolumeSlider = nullptr;
@@ -367,12 +384,20 @@ void OptionsDialog::build() {
 				}
 
 			}
+
+			if (ConfMan.hasKey("worker_threads", _domain))
+				_workerThreadsPopUp->setSelectedTag(CLIP(ConfMan.getInt("worker_threads", _domain), 0, (int)Common::ThreadPool::kMaxThreads));
+			else
+				_workerThreadsPopUp->setSelected(0);
 		} else {
 			_scalerPopUpDesc->setVisible(false);
 			_scalerPopUp->setVisible(false);
 			_scalerPopUp->setEnabled(false);
 			_scaleFactorPopUp->setVisible(false);
 			_scaleFactorPopUp->setEnabled(false);
+			_workerThreadsPopUpDesc->setVisible(false);
+			_workerThreadsPopUp->setVisible(false);
+			_workerThreadsPopUp->setEnabled(false);
 		}
 
 		// Fullscreen setting
@@ -477,6 +502,28 @@ void OptionsDialog::build() {
 		_enableGSCheckbox->setState(ConfMan.getBool("enable_gs", _domain));
 	}
 
+#ifdef USE_MT32EMU
+	// MT-32 emulator options
+	if (_mt32PartialsPopUp) {
+		if (ConfMan.hasKey("mt32_partials", _domain))
+			_mt32PartialsPopUp->setSelectedTag(ConfMan.getInt("mt32_partials", _domain));
+		else
+			_mt32PartialsPopUp->setSelected(0);
+
+		_mt32AnalogOutputPopUp->setSelected(0);
+		for (uint i = 0; i < ARRAYSIZE(mt32AnalogOutputModes); i++) {
+			if (ConfMan.hasKey("mt32_analog_output", _domain) && ConfMan.get("mt32_analog_output", _domain) == mt32AnalogOutputModes[i])
+				_mt32AnalogOutputPopUp->setSelectedTag(i);
+		}
+
+		_mt32ResamplerPopUp->setSelected(0);
+		for (uint i = 0; i < ARRAYSIZE(mt32Resamplers); i++) {
+			if (ConfMan.hasKey("mt32_resampler", _domain) && ConfMan.get("mt32_resampler", _domain) == mt32Resamplers[i])
+				_mt32ResamplerPopUp->setSelectedTag(i);
+		}
+	}
+#endif
+
 	// Volume options
 	if (_musicVolumeSlider) {
 		int vol;
@@ -640,6 +687,13 @@ void OptionsDialog::apply() {
 					graphicsModeChanged = true;
 			}
 
+			// The shared thread pool is started again with the new count
+			// when the next game is started
+			if (_workerThreadsPopUp->getSelectedTag() != (uint32)-1)
+				ConfMan.setInt("worker_threads", _workerThreadsPopUp->getSelectedTag(), _domain);
+			else
+				ConfMan.removeKey("worker_threads", _domain);
+
 			if (_rendererTypePopUp->getSelectedTag() > 0) {
 				Graphics::RendererType selected = (Graphics::RendererType) _rendererTypePopUp->getSelectedTag();
 				ConfMan.set("renderer", Graphics::Renderer::getTypeCode(selected), _domain);
@@ -662,6 +716,7 @@ void OptionsDialog::apply() {
 			ConfMan.removeKey("stretch_mode", _domain);
 			ConfMan.removeKey("scaler", _domain);
 			ConfMan.removeKey("scale_factor", _domain);
+			ConfMan.removeKey("worker_threads", _domain);
 			ConfMan.removeKey("render_mode", _domain);
 			ConfMan.removeKey("renderer", _domain);
 			ConfMan.removeKey("antialiasing", _domain);
@@ -885,6 +940,26 @@ void OptionsDialog::apply() {
 		}
 	}
 
+#ifdef USE_MT32EMU
+	// MT-32 emulator options
+	if (_mt32PartialsPopUp) {
+		if (_enableMT32Settings && (int32)_mt32PartialsPopUp->getSelectedTag() > 0)
+			ConfMan.setInt("mt32_partials", _mt32PartialsPopUp->getSelectedTag(), _domain);
+		else
+			ConfMan.removeKey("mt32_partials", _domain);
+
+		if (_enableMT32Settings && (int32)_mt32AnalogOutputPopUp->getSelectedTag() >= 0)
+			ConfMan.set("mt32_analog_output", mt32AnalogOutputModes[_mt32AnalogOutputPopUp->getSelectedTag()], _domain);
+		else
+			ConfMan.removeKey("mt32_analog_output", _domain);
+
+		if (_enableMT32Settings && (int32)_mt32ResamplerPopUp->getSelectedTag() >= 0)
+			ConfMan.set("mt32_resampler", mt32Resamplers[_mt32ResamplerPopUp->getSelectedTag()], _domain);
+		else
+			ConfMan.removeKey("mt32_resampler", _domain);
+	}
+#endif
+
 	// Subtitle options
 	if (_subToggleGroup) {
 		if (_enableSubtitleSettings) {
@@ -1076,10 +1151,14 @@ void OptionsDialog::setGraphicSettingsState(bool enabled) {
 		_scalerPopUpDesc->setEnabled(enabled);
 		_scalerPopUp->setEnabled(enabled);
 		_scaleFactorPopUp->setEnabled(enabled);
+		_workerThreadsPopUpDesc->setEnabled(enabled);
+		_workerThreadsPopUp->setEnabled(enabled);
 	} else {
 		_scalerPopUpDesc->setEnabled(false);
 		_scalerPopUp->setEnabled(false);
 		_scaleFactorPopUp->setEnabled(false);
+		_workerThreadsPopUpDesc->setEnabled(false);
+		_workerThreadsPopUp->setEnabled(false);
 	}
 
 	if (g_system->hasFeature(OSystem::kFeatureFilteringMode))
@@ -1155,6 +1234,15 @@ void OptionsDialog::setMT32SettingsState(bool enabled) {
 
 	_mt32Checkbox->setEnabled(enabled);
 	_enableGSCheckbox->setEnabled(enabled);
+
+	if (_mt32PartialsPopUp) {
+		_mt32PartialsPopUpDesc->setEnabled(enabled);
+		_mt32PartialsPopUp->setEnabled(enabled);
+		_mt32AnalogOutputPopUpDesc->setEnabled(enabled);
+		_mt32AnalogOutputPopUp->setEnabled(enabled);
+		_mt32ResamplerPopUpDesc->setEnabled(enabled);
+		_mt32ResamplerPopUp->setEnabled(enabled);
+	}
 }
 
 void OptionsDialog::setVolumeSettingsState(bool enabled) {
@@ -1433,6 +1521,15 @@ void OptionsDialog::addGraphicControls(GuiObject *boss, const Common::String &pr
 	_scaleFactorPopUp = new PopUpWidget(boss, prefix + "grScaleFactorPopup");
 	updateScaleFactors(_scalerPopUp->getSelectedTag());
 
+	// The Worker threads popup
+	_workerThreadsPopUpDesc = new StaticTextWidget(boss, prefix + "grWorkerThreadsPopupDesc", _("Worker threads:"));
+	_workerThreadsPopUp = new PopUpWidget(boss, prefix + "grWorkerThreadsPopup", _("Number of threads scaling the screen, decoding videos and drawing games besides the main thread. Takes effect when a game is started"));
+
+	_workerThreadsPopUp->appendEntry(_("<default>"));
+	_workerThreadsPopUp->appendEntry(Common::U32String());
+	for (uint threads = 0; threads <= Common::ThreadPool::kMaxThreads; threads++)
+		_workerThreadsPopUp->appendEntry(Common::U32String::format("%d", threads), threads);
+
 	// Fullscreen checkbox
 	_fullscreenCheckbox = new CheckboxWidget(boss, prefix + "grFullscreenCheckbox", _("Fullscreen mode"), Common::U32String(), kFullscreenToggled);
 
@@ -1591,6 +1688,43 @@ void OptionsDialog::addMT32Controls(GuiObject *boss, const Common::String &prefi
 	// GS Extensions setting
 	_enableGSCheckbox = new CheckboxWidget(boss, prefix + "mcGSCheckbox", _("Roland GS device (enable MT-32 mappings)"), _("Check if you want to enable patch mappings to emulate an MT-32 on a Roland GS device"));
 
+#ifdef USE_MT32EMU
+	// MT-32 emulator settings
+	_mt32PartialsPopUpDesc = new StaticTextWidget(boss, prefix + "mcMt32PartialsPopupDesc", _("Emulator partials:"), _("Number of partials the MT-32 emulator can play at once. Fewer partials are faster, but notes may be cut off"));
+	_mt32PartialsPopUp = new PopUpWidget(boss, prefix + "mcMt32PartialsPopup");
+	_mt32PartialsPopUp->appendEntry(_("<default>"));
+	_mt32PartialsPopUp->appendEntry(Common::U32String());
+	for (uint partials = 8; partials <= 64; partials += (partials < 32 ? 8 : 16))
+		_mt32PartialsPopUp->appendEntry(Common::U32String::format("%d", partials), partials);
+
+	_mt32AnalogOutputPopUpDesc = new StaticTextWidget(boss, prefix + "mcMt32AnalogOutputPopupDesc", _("Emulator output:"), _("How the MT-32 emulator emulates the analog output circuit. The higher rates are slower"));
+	_mt32AnalogOutputPopUp = new PopUpWidget(boss, prefix + "mcMt32AnalogOutputPopup");
+	_mt32AnalogOutputPopUp->appendEntry(_("<default>"));
+	_mt32AnalogOutputPopUp->appendEntry(Common::U32String());
+	_mt32AnalogOutputPopUp->appendEntry(_("Digital only (32 kHz)"), 0);
+	_mt32AnalogOutputPopUp->appendEntry(_("Coarse (32 kHz)"), 1);
+	_mt32AnalogOutputPopUp->appendEntry(_("Accurate (48 kHz)"), 2);
+	_mt32AnalogOutputPopUp->appendEntry(_("Oversampled (96 kHz)"), 3);
+
+	_mt32ResamplerPopUpDesc = new StaticTextWidget(boss, prefix + "mcMt32ResamplerPopupDesc", _("Emulator resampling:"), _("Which resampler converts the MT-32 emulator output to the output rate"));
+	_mt32ResamplerPopUp = new PopUpWidget(boss, prefix + "mcMt32ResamplerPopup");
+	_mt32ResamplerPopUp->appendEntry(_("<default>"));
+	_mt32ResamplerPopUp->appendEntry(Common::U32String());
+	_mt32ResamplerPopUp->appendEntry(_("Mixer"), 0);
+	_mt32ResamplerPopUp->appendEntry(_("Emulator, fastest"), 1);
+	_mt32ResamplerPopUp->appendEntry(_("Emulator, fast"), 2);
+	_mt32ResamplerPopUp->appendEntry(_("Emulator, good"), 3);
+	_mt32ResamplerPopUp->appendEntry(_("Emulator, best"), 4);
+
+	const int load = MT32Emu::getEmulatorLoad();
+	Common::U32String loadText;
+	if (load >= 0)
+		loadText = Common::U32String::format(_("Emulator load when it last played: %d ms per second of music"), load);
+	else
+		loadText = _("Emulator load: not measured yet");
+	_mt32LoadText = new StaticTextWidget(boss, prefix + "mcMt32LoadText", loadText, _("Processor time the MT-32 emulator needed per second of music. Above 1000 ms, it cannot keep up"));
+#endif
+
 	const PluginList p = MusicMan.getPlugins();
 	// Make sure the null device is the first one in the list to avoid undesired
 	// auto detection for users who don't have a saved setting yet.
@@ -1811,10 +1945,14 @@ void OptionsDialog::setupGraphicsTab() {
 		_scalerPopUpDesc->setVisible(true);
 		_scalerPopUp->setVisible(true);
 		_scaleFactorPopUp->setVisible(true);
+		_workerThreadsPopUpDesc->setVisible(true);
+		_workerThreadsPopUp->setVisible(true);
 	} else {
 		_scalerPopUpDesc->setVisible(false);
 		_scalerPopUp->setVisible(false);
 		_scaleFactorPopUp->setVisible(false);
+		_workerThreadsPopUpDesc->setVisible(false);
+		_workerThreadsPopUp->setVisible(false);
 	}
 }
 
@@ -152,6 +152,8 @@ private:
 	PopUpWidget *_stretchPopUp;
 	StaticTextWidget *_scalerPopUpDesc;
 	PopUpWidget *_scalerPopUp, *_scaleFactorPopUp;
+	StaticTextWidget *_workerThreadsPopUpDesc;
+	PopUpWidget *_workerThreadsPopUp;
 	CheckboxWidget *_fullscreenCheckbox;
 	CheckboxWidget *_filteringCheckbox;
 	CheckboxWidget *_aspectCheckbox;
@@ -199,6 +201,13 @@ private:
 	bool _enableMT32Settings;
 	CheckboxWidget *_mt32Checkbox;
 	CheckboxWidget *_enableGSCheckbox;
+	StaticTextWidget *_mt32PartialsPopUpDesc;
+	PopUpWidget *_mt32PartialsPopUp;
+	StaticTextWidget *_mt32AnalogOutputPopUpDesc;
+	PopUpWidget *_mt32AnalogOutputPopUp;
+	StaticTextWidget *_mt32ResamplerPopUpDesc;
+	PopUpWidget *_mt32ResamplerPopUp;
+	StaticTextWidget *_mt32LoadText;
 
 	//
 	// Subtitle controls
@@ -20,8 +20,12 @@
  */
 
 #include "common/system.h"
+#include "common/algorithm.h"
+#include "common/config-manager.h"
 #include "common/file.h"
+#include "common/hash-str.h"
 #include "common/language.h"
+#include "common/memstream.h"
 #include "common/platform.h"
 #include "common/tokenizer.h"
 #include "common/translation.h"
@@ -314,6 +318,12 @@ Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int re
 #endif
 	} else if (name.hasSuffix(".svg")) {
 		if (g_gui.getIconsSet().hasFile(name)) {
+			// The icons are rasterized again each time the grid is opened
+			Graphics::SVGRasterCache &cache = g_gui.getSVGRasterCache();
+			surf = cache.get(name, renderWidth, renderHeight);
+			if (surf)
+				return surf;
+
 			Common::SeekableReadStream *stream = g_gui.getIconsSet().createReadStreamForMember(name);
 			Graphics::SVGBitmap *image = nullptr;
 			image = new Graphics::SVGBitmap(stream);
@@ -322,6 +332,7 @@ Graphics::ManagedSurface *loadSurfaceFromFile(const Common::String &name, int re
 
 			surf = new Graphics::ManagedSurface(renderWidth, renderHeight, *image->getPixelFormat());
 			image->render(*surf, renderWidth, renderHeight);
+			cache.put(name, *surf);
 			delete image;
 		} else {
 			debug(5, "GridWidget: Cannot read file '%s'", name.c_str());
@@ -374,12 +385,27 @@ GridWidget::GridWidget(GuiObject *boss, const Common::String &name)
 
 	_selectedEntry = nullptr;
 	_isGridInvalid = true;
+
+	_thumbnailUseCounter = 0;
+	_quitThumbnailWorker = false;
+	initThumbnailCache();
+
+	// Decode thumbnails in the background when the backend allows it, and
+	// pick up the results on tickles
+	if (_thumbnailSemaphore.isValid() && _thumbnailWorker.start(thumbnailWorkerProc, this)) {
+		setFlags(WIDGET_WANT_TICKLE);
+		((GUI::Dialog *)_boss)->setTickleWidget(this);
+	}
 }
 
 GridWidget::~GridWidget() {
+	stopThumbnailWorker();
+	if (((GUI::Dialog *)_boss)->getTickleWidget() == this)
+		((GUI::Dialog *)_boss)->unSetTickleWidget();
+
 	unloadSurfaces(_platformIcons);
 	unloadSurfaces(_languageIcons);
-	unloadSurfaces(_loadedSurfaces);
+	unloadThumbnails();
 	_gridItems.clear();
 	_dataEntryList.clear();
 	_sortedEntryList.clear();
@@ -397,7 +423,7 @@ void GridWidget::unloadSurfaces(Common::HashMap<T, const Graphics::ManagedSurfac
 const Graphics::ManagedSurface *GridWidget::filenameToSurface(const Common::String &name) {
 	if (name.empty())
 		return nullptr;
-	return _loadedSurfaces[name];
+	return _loadedSurfaces.getValOrDefault(name);
 }
 
 const Graphics::ManagedSurface *GridWidget::languageToSurface(Common::Language languageCode) {
@@ -570,30 +596,304 @@ void GridWidget::setGroupHeaderFormat(const Common::U32String &prefix, const Com
 }
 
 void GridWidget::reloadThumbnails() {
-	for (Common::Array<GridItemInfo *>::iterator iter = _visibleEntryList.begin(); iter != _visibleEntryList.end(); ++iter) {
-		GridItemInfo *entry = *iter;
-		if (entry->thumbPath.empty())
-			continue;
-
-		if (!_loadedSurfaces.contains(entry->thumbPath)) {
-			Common::String path = Common::String::format("icons/%s-%s.png", entry->engineid.c_str(), entry->gameid.c_str());
-			Graphics::ManagedSurface *surf = loadSurfaceFromFile(path);
-			if (!surf) {
-				path = Common::String::format("icons/%s.png", entry->engineid.c_str());
-				surf = loadSurfaceFromFile(path);
-			}
+	_thumbnailUseCounter++;
+	clearThumbnailQueue();
 
-			if (surf) {
-				const Graphics::ManagedSurface *scSurf(scaleGfx(surf, _thumbnailWidth, 512, true));
-				_loadedSurfaces[entry->thumbPath] = scSurf;
-				if (surf != scSurf) {
-					surf->free();
-					delete surf;
-				}
-			} else {
-				_loadedSurfaces[entry->thumbPath] = nullptr;
-			}
+	if (_sortedEntryList.empty())
+		return;
+
+	// Load the visible thumbnails first, then the ones of the rows around
+	// them, which are likely to be scrolled to next
+	const int ahead = kThumbnailRowsAhead * MAX(_itemsPerRow, 1);
+	const int first = MAX(_firstVisibleItem - ahead, 0);
+	const int last = MIN(_lastVisibleItem + ahead, (int)_sortedEntryList.size() - 1);
+
+	for (int i = _firstVisibleItem; i <= last; ++i)
+		queueThumbnail(&_sortedEntryList[i]);
+	for (int i = _firstVisibleItem - 1; i >= first; --i)
+		queueThumbnail(&_sortedEntryList[i]);
+
+	evictThumbnails(MAX<uint>(kMinLoadedThumbnails, 2 * (last - first + 1)));
+}
+
+void GridWidget::unloadThumbnails() {
+	clearThumbnailQueue();
+	unloadSurfaces(_loadedSurfaces);
+	_thumbnailLastUse.clear();
+}
+
+void GridWidget::initThumbnailCache() {
+	_thumbnailCacheStamp = Common::hashit(g_gui.getIconsSetId().c_str());
+
+	// Scaled thumbnails are stored next to the configuration file
+	Common::String configFile = ConfMan.getCustomConfigFileName();
+	if (configFile.empty())
+		configFile = g_system->getDefaultConfigFileName();
+	if (configFile.empty())
+		return;
+
+	Common::FSNode configNode(configFile);
+	Common::FSNode dir = configNode.getParent();
+	if (dir.getPath() == configNode.getPath() || !dir.isDirectory())
+		return;
+
+	dir = dir.getChild("iconcache");
+	if (!dir.exists())
+		dir.createDirectory();
+
+	if (dir.isDirectory() && dir.isWritable())
+		_thumbnailCacheDir = dir;
+}
+
+Common::FSNode GridWidget::getThumbnailCacheFile(const ThumbnailJob *job) const {
+	return _thumbnailCacheDir.getChild(Common::String::format("%s-%s-%d.thumb", job->engineid.c_str(), job->gameid.c_str(), job->width));
+}
+
+void GridWidget::queueThumbnail(GridItemInfo *entry) {
+	if (entry->thumbPath.empty())
+		return;
+
+	_thumbnailLastUse[entry->thumbPath] = _thumbnailUseCounter;
+
+	if (_loadedSurfaces.contains(entry->thumbPath) || _loadingThumbnails.contains(entry->thumbPath))
+		return;
+
+	ThumbnailJob *job = new ThumbnailJob();
+	job->state = ThumbnailJob::kStateLoadCached;
+	job->thumbPath = entry->thumbPath;
+	job->engineid = entry->engineid;
+	job->gameid = entry->gameid;
+	job->width = _thumbnailWidth;
+	job->source = nullptr;
+	job->surface = nullptr;
+	if (_thumbnailCacheDir.isDirectory())
+		job->cachePath = getThumbnailCacheFile(job).getPath();
+
+	_loadingThumbnails[job->thumbPath] = true;
+
+	if (_thumbnailWorker.isStarted()) {
+		Common::StackLock lock(_thumbnailMutex);
+		_thumbnailQueue.push_back(job);
+		_thumbnailSemaphore.post();
+	} else {
+		do {
+			processThumbnail(job);
+		} while (!finishThumbnail(job));
+	}
+}
+
+void GridWidget::clearThumbnailQueue() {
+	Common::StackLock lock(_thumbnailMutex);
+
+	for (uint i = 0; i < _thumbnailQueue.size(); ++i) {
+		_loadingThumbnails.erase(_thumbnailQueue[i]->thumbPath);
+		delete _thumbnailQueue[i]->source;
+		delete _thumbnailQueue[i];
+	}
+
+	_thumbnailQueue.clear();
+}
+
+void GridWidget::stopThumbnailWorker() {
+	if (!_thumbnailWorker.isStarted())
+		return;
+
+	{
+		Common::StackLock lock(_thumbnailMutex);
+		_quitThumbnailWorker = true;
+	}
+
+	_thumbnailSemaphore.post();
+	_thumbnailWorker.join();
+
+	clearThumbnailQueue();
+
+	for (uint i = 0; i < _returnedThumbnails.size(); ++i) {
+		ThumbnailJob *job = _returnedThumbnails[i];
+		delete job->source;
+		delete job->surface;
+		delete job;
+	}
+	_returnedThumbnails.clear();
+	_loadingThumbnails.clear();
+}
+
+void GridWidget::thumbnailWorkerProc(void *data) {
+	GridWidget *grid = (GridWidget *)data;
+
+	for (;;) {
+		grid->_thumbnailSemaphore.wait();
+
+		ThumbnailJob *job = nullptr;
+		{
+			Common::StackLock lock(grid->_thumbnailMutex);
+			if (grid->_quitThumbnailWorker)
+				return;
+
+			if (grid->_thumbnailQueue.empty())
+				continue;
+
+			job = grid->_thumbnailQueue.remove_at(0);
 		}
+
+		grid->processThumbnail(job);
+
+		Common::StackLock lock(grid->_thumbnailMutex);
+		grid->_returnedThumbnails.push_back(job);
+	}
+}
+
+#define THUMBNAIL_CACHE_TAG MKTAG('G', 'T', 'H', 'B')
+
+// Runs on the worker thread when there is one, so it must not touch the
+// icons set or the widget state.
+void GridWidget::processThumbnail(ThumbnailJob *job) {
+#ifdef USE_PNG
+	if (job->state == ThumbnailJob::kStateLoadCached) {
+		job->state = ThumbnailJob::kStateNeedSource;
+		if (job->cachePath.empty())
+			return;
+
+		Common::SeekableReadStream *stream = Common::FSNode(job->cachePath).createReadStream();
+		if (!stream)
+			return;
+
+		Image::PNGDecoder decoder;
+		if (stream->readUint32BE() == THUMBNAIL_CACHE_TAG && stream->readUint32LE() == _thumbnailCacheStamp
+		    && decoder.loadStream(*stream) && decoder.getSurface()) {
+			job->surface = new Graphics::ManagedSurface(decoder.getSurface());
+			job->state = ThumbnailJob::kStateDone;
+		}
+
+		delete stream;
+	} else if (job->state == ThumbnailJob::kStateDecode) {
+		job->state = ThumbnailJob::kStateDone;
+
+		Image::PNGDecoder decoder;
+		const Graphics::Surface *srcSurface = nullptr;
+		if (decoder.loadStream(*job->source))
+			srcSurface = decoder.getSurface();
+
+		delete job->source;
+		job->source = nullptr;
+
+		if (!srcSurface || srcSurface->format.bytesPerPixel == 1)
+			return;
+
+		Graphics::ManagedSurface *surf = new Graphics::ManagedSurface(srcSurface);
+		job->surface = scaleGfx(surf, job->width, 512, true);
+		if (job->surface != surf) {
+			surf->free();
+			delete surf;
+		}
+
+		if (job->cachePath.empty())
+			return;
+
+		Common::WriteStream *out = Common::FSNode(job->cachePath).createWriteStream();
+		if (out) {
+			out->writeUint32BE(THUMBNAIL_CACHE_TAG);
+			out->writeUint32LE(_thumbnailCacheStamp);
+			Image::writePNG(*out, job->surface->rawSurface());
+			out->finalize();
+			delete out;
+		}
+	}
+#else
+	job->state = ThumbnailJob::kStateDone;
+#endif
+}
+
+// Runs on the GUI thread. Returns false when the job needs to be processed again.
+bool GridWidget::finishThumbnail(ThumbnailJob *job) {
+	const bool wanted = _thumbnailLastUse.getValOrDefault(job->thumbPath) == _thumbnailUseCounter;
+
+	if (job->width != _thumbnailWidth) {
+		// The layout changed while loading, start over at the new size
+		delete job->source;
+		delete job->surface;
+		job->source = nullptr;
+		job->surface = nullptr;
+
+		if (wanted) {
+			job->state = ThumbnailJob::kStateLoadCached;
+			job->width = _thumbnailWidth;
+			if (_thumbnailCacheDir.isDirectory())
+				job->cachePath = getThumbnailCacheFile(job).getPath();
+			return false;
+		}
+
+		_loadingThumbnails.erase(job->thumbPath);
+		delete job;
+		return true;
+	}
+
+	if (job->state == ThumbnailJob::kStateNeedSource) {
+		// Nobody waits for this thumbnail anymore
+		if (!wanted) {
+			_loadingThumbnails.erase(job->thumbPath);
+			delete job;
+			return true;
+		}
+
+		Common::String path = Common::String::format("icons/%s-%s.png", job->engineid.c_str(), job->gameid.c_str());
+		if (!g_gui.getIconsSet().hasFile(path))
+			path = Common::String::format("icons/%s.png", job->engineid.c_str());
+
+		Common::SeekableReadStream *stream = g_gui.getIconsSet().createReadStreamForMember(path);
+		if (stream) {
+			// Copy the data, archive members may share their parent stream
+			job->source = stream->readStream(stream->size());
+			delete stream;
+
+			job->state = ThumbnailJob::kStateDecode;
+			return false;
+		}
+
+		debug(5, "GridWidget: Cannot read file '%s'", path.c_str());
+		job->state = ThumbnailJob::kStateDone;
+	}
+
+	_loadedSurfaces[job->thumbPath] = job->surface;
+
+	for (Common::Array<GridItemWidget *>::iterator i = _gridItems.begin(); i != _gridItems.end(); ++i) {
+		if ((*i)->getActiveEntry() && (*i)->getActiveEntry()->thumbPath == job->thumbPath)
+			(*i)->update();
+	}
+
+	_loadingThumbnails.erase(job->thumbPath);
+	delete job;
+	return true;
+}
+
+struct ThumbnailUse {
+	uint32 lastUse;
+	Common::String path;
+
+	bool operator<(const ThumbnailUse &other) const { return lastUse < other.lastUse; }
+};
+
+void GridWidget::evictThumbnails(uint maxCount) {
+	if (_loadedSurfaces.size() <= maxCount)
+		return;
+
+	// Drop the thumbnails not needed for the longest time, but never the
+	// ones around the visible rows
+	Common::Array<ThumbnailUse> uses;
+	for (Common::HashMap<Common::String, const Graphics::ManagedSurface *>::iterator i = _loadedSurfaces.begin(); i != _loadedSurfaces.end(); ++i) {
+		ThumbnailUse use;
+		use.lastUse = _thumbnailLastUse.getValOrDefault(i->_key);
+		use.path = i->_key;
+		if (use.lastUse != _thumbnailUseCounter)
+			uses.push_back(use);
+	}
+
+	Common::sort(uses.begin(), uses.end());
+
+	for (uint i = 0; i < uses.size() && _loadedSurfaces.size() > maxCount; ++i) {
+		delete _loadedSurfaces[uses[i].path];
+		_loadedSurfaces.erase(uses[i].path);
+		_thumbnailLastUse.erase(uses[i].path);
 	}
 }
 
@@ -715,6 +1015,24 @@ void GridWidget::handleMouseWheel(int x, int y, int direction) {
 	_scrollPos = _scrollBar->_currentPos;
 }
 
+void GridWidget::handleTickle() {
+	Common::Array<ThumbnailJob *> jobs;
+	{
+		Common::StackLock lock(_thumbnailMutex);
+		jobs = _returnedThumbnails;
+		_returnedThumbnails.clear();
+	}
+
+	for (uint i = 0; i < jobs.size(); ++i) {
+		if (!finishThumbnail(jobs[i])) {
+			// Decode it before the queued thumbnails, it was queued first
+			Common::StackLock lock(_thumbnailMutex);
+			_thumbnailQueue.insert_at(0, jobs[i]);
+			_thumbnailSemaphore.post();
+		}
+	}
+}
+
 void GridWidget::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 	// Work in progress
 	switch (cmd) {
@@ -824,7 +1142,7 @@ void GridWidget::reflowLayout() {
 	_thumbnailHeight = g_gui.xmlEval()->getVar("Globals.GridItemThumbnail.Height");
 	_thumbnailWidth = g_gui.xmlEval()->getVar("Globals.GridItemThumbnail.Width");
 	if ((oldThumbnailHeight != _thumbnailHeight) || (oldThumbnailWidth != _thumbnailWidth)) {
-		unloadSurfaces(_loadedSurfaces);
+		unloadThumbnails();
 		reloadThumbnails();
 		loadFlagIcons();
 	}
@@ -24,7 +24,10 @@
 
 #include "gui/dialog.h"
 #include "gui/widgets/scrollbar.h"
+#include "common/fs.h"
+#include "common/mutex.h"
 #include "common/str.h"
+#include "common/thread.h"
 
 #include "image/bmp.h"
 #include "image/png.h"
@@ -99,8 +102,54 @@ protected:
 	Common::HashMap<int, const Graphics::ManagedSurface *> _platformIcons;
 	Common::HashMap<int, const Graphics::ManagedSurface *> _languageIcons;
 
-	// Images are mapped by filename -> surface.
+	enum {
+		/** Rows above and below the visible ones whose thumbnails are loaded ahead. */
+		kThumbnailRowsAhead = 2,
+		/** Lower bound for the number of thumbnails kept in memory. */
+		kMinLoadedThumbnails = 128
+	};
+
+	/**
+	 * A thumbnail being loaded. The worker thread first looks for it in
+	 * the disk cache, then the GUI thread reads the icon from the icons
+	 * set, which is not thread-safe, and the worker decodes and scales it.
+	 */
+	struct ThumbnailJob {
+		enum State {
+			kStateLoadCached,
+			kStateNeedSource,
+			kStateDecode,
+			kStateDone
+		};
+
+		State state;
+		Common::String thumbPath;
+		Common::String engineid;
+		Common::String gameid;
+		Common::String cachePath;
+		int width;
+		Common::SeekableReadStream *source;
+		const Graphics::ManagedSurface *surface;
+	};
+
+	// Images are mapped by filename -> surface. Only the thumbnails around
+	// the visible rows are kept, see reloadThumbnails().
 	Common::HashMap<Common::String, const Graphics::ManagedSurface *> _loadedSurfaces;
+	Common::HashMap<Common::String, uint32> _thumbnailLastUse;
+	Common::HashMap<Common::String, bool> _loadingThumbnails;
+	uint32 _thumbnailUseCounter;
+
+	Common::FSNode _thumbnailCacheDir;
+	uint32 _thumbnailCacheStamp;
+
+	/** Jobs for the worker thread, in loading order. Guarded by _thumbnailMutex. */
+	Common::Array<ThumbnailJob *> _thumbnailQueue;
+	/** Jobs handed back to the GUI thread. Guarded by _thumbnailMutex. */
+	Common::Array<ThumbnailJob *> _returnedThumbnails;
+	Common::Mutex _thumbnailMutex;
+	Common::Semaphore _thumbnailSemaphore;
+	Common::Thread _thumbnailWorker;
+	bool _quitThumbnailWorker;
 
 	Common::Array<GridItemInfo>			_dataEntryList;
 	Common::Array<GridItemInfo>			_sortedEntryList;
@@ -183,6 +232,7 @@ public:
 	void toggleGroup(int groupID);
 
 	void reloadThumbnails();
+	void unloadThumbnails();
 	void loadFlagIcons();
 	void loadPlatformIcons();
 
@@ -201,6 +251,7 @@ public:
 
 	void handleMouseWheel(int x, int y, int direction) override;
 	void handleCommand(CommandSender *sender, uint32 cmd, uint32 data) override;
+	void handleTickle() override;
 
 	void reflowLayout() override;
 
@@ -209,6 +260,17 @@ public:
 	void scrollBarRecalc();
 
 	void setFilter(const Common::U32String &filter);
+
+protected:
+	void initThumbnailCache();
+	Common::FSNode getThumbnailCacheFile(const ThumbnailJob *job) const;
+	void queueThumbnail(GridItemInfo *entry);
+	void clearThumbnailQueue();
+	void stopThumbnailWorker();
+	void processThumbnail(ThumbnailJob *job);
+	bool finishThumbnail(ThumbnailJob *job);
+	void evictThumbnails(uint maxCount);
+	static void thumbnailWorkerProc(void *data);
 };
 
 /* GridItemWidget */
@@ -227,6 +289,7 @@ public:
 	void update();
 	void updateThumb();
 	void setActiveEntry(GridItemInfo &entry);
+	const GridItemInfo *getActiveEntry() const { return _activeEntry; }
 
 	void drawWidget() override;
 
@@ -48,6 +48,7 @@ void GroupedListWidget::setList(const Common::U32StringArray &list, const ColorL
 
 	// Copy everything
 	_dataList = list;
+	_dataListLower.clear();
 	_list = list;
 
 	_filter.clear();
@@ -443,6 +444,7 @@ void GroupedListWidget::setFilter(const Common::U32String &filter, bool redraw)
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	Common::U32String previousFilter = _filter;
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -451,31 +453,7 @@ void GroupedListWidget::setFilter(const Common::U32String &filter, bool redraw)
 	} else {
 		// Restrict the list to everything which contains all words in _filter
 		// as substrings, ignoring case.
-
-		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
-		int n = 0;
-
-		_list.clear();
-		_listIndex.clear();
-
-		for (Common::U32StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
-			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!_filterMatcher(_filterMatcherArg, n, tmp, tok.nextToken())) {
-					matches = false;
-					break;
-				}
-			}
-
-			if (matches) {
-				_list.push_back(*i);
-				_listIndex.push_back(n);
-			}
-		}
+		applyFilter(previousFilter);
 	}
 
 	_currentPos = 0;
@@ -68,6 +68,12 @@ ListWidget::ListWidget(Dialog *boss, const Common::String &name, const Common::U
 	_filterMatcher = ListWidgetDefaultMatcher;
 	_filterMatcherArg = nullptr;
 
+	_itemSource = nullptr;
+	_itemSourceArg = nullptr;
+	_itemSourceCount = 0;
+
+	_numberingWidth = 0;
+
 	_lastRead = -1;
 
 	_hlLeftPadding = _hlRightPadding = 0;
@@ -107,6 +113,12 @@ ListWidget::ListWidget(Dialog *boss, int x, int y, int w, int h, const Common::U
 	_filterMatcher = ListWidgetDefaultMatcher;
 	_filterMatcherArg = nullptr;
 
+	_itemSource = nullptr;
+	_itemSourceArg = nullptr;
+	_itemSourceCount = 0;
+
+	_numberingWidth = 0;
+
 	_lastRead = -1;
 
 	_hlLeftPadding = _hlRightPadding = 0;
@@ -146,7 +158,7 @@ void ListWidget::setSelected(int item) {
 		item = filteredItem;
 	}
 
-	assert(item >= -1 && item < (int)_list.size());
+	assert(item >= -1 && item < getListSize());
 
 	// We only have to do something if the widget is enabled and the selection actually changes
 	if (isEnabled() && _selectedItem != item) {
@@ -164,6 +176,14 @@ void ListWidget::setSelected(int item) {
 	}
 }
 
+const Common::U32String &ListWidget::getSelectedString() const {
+	if (!_itemSource)
+		return _list[_selectedItem];
+
+	_selectedSourceItem = getListItem(_selectedItem);
+	return _selectedSourceItem;
+}
+
 ThemeEngine::FontColor ListWidget::getSelectionColor() const {
 	if (_listColors.empty())
 		return ThemeEngine::kFontColorNormal;
@@ -180,7 +200,11 @@ void ListWidget::setList(const Common::U32StringArray &list, const ColorList *co
 
 	// Copy everything
 	_dataList = list;
+	_dataListLower.clear();
 	_list = list;
+	_itemSource = nullptr;
+	_itemSourceArg = nullptr;
+	_itemSourceCount = 0;
 	_filter.clear();
 	_listIndex.clear();
 	_listColors.clear();
@@ -201,7 +225,56 @@ void ListWidget::setList(const Common::U32StringArray &list, const ColorList *co
 	scrollBarRecalc();
 }
 
+void ListWidget::setItemSource(int count, ItemSource source, void *arg, const ColorList *colors) {
+	if (_editMode && _caretVisible)
+		drawCaret(true);
+
+	_dataList.clear();
+	_dataListLower.clear();
+	_list.clear();
+	_itemSource = source;
+	_itemSourceArg = arg;
+	_itemSourceCount = count;
+	_filter.clear();
+	_listIndex.clear();
+	_listColors.clear();
+
+	if (colors) {
+		_listColors = *colors;
+		assert((int)_listColors.size() == count);
+	}
+
+	if (_currentPos >= count)
+		_currentPos = count - 1;
+	if (_currentPos < 0)
+		_currentPos = 0;
+	_selectedItem = -1;
+	_editMode = false;
+	g_system->setFeatureState(OSystem::kFeatureVirtualKeyboard, false);
+	scrollBarRecalc();
+}
+
+int ListWidget::getListSize() const {
+	if (!_itemSource)
+		return _list.size();
+	return _filter.empty() ? _itemSourceCount : (int)_listIndex.size();
+}
+
+Common::U32String ListWidget::getListItem(int pos) const {
+	if (!_itemSource)
+		return _list[pos];
+	return getDataItem(_filter.empty() ? pos : _listIndex[pos]);
+}
+
+Common::U32String ListWidget::getDataItem(int idx) const {
+	if (!_itemSource)
+		return _dataList[idx];
+	return _itemSource(_itemSourceArg, idx);
+}
+
 void ListWidget::append(const Common::String &s, ThemeEngine::FontColor color) {
+	assert(!_itemSource);
+
 	if (_dataList.size() == _listColors.size()) {
 		// If the color list has the size of the data list, we append the color.
 		_listColors.push_back(color);
@@ -223,7 +296,7 @@ void ListWidget::append(const Common::String &s, ThemeEngine::FontColor color) {
 }
 
 void ListWidget::scrollTo(int item) {
-	int size = _list.size();
+	int size = getListSize();
 	if (item >= size)
 		item = size - 1;
 	if (item < 0)
@@ -237,7 +310,7 @@ void ListWidget::scrollTo(int item) {
 }
 
 void ListWidget::scrollBarRecalc() {
-	_scrollBar->_numEntries = _list.size();
+	_scrollBar->_numEntries = getListSize();
 	_scrollBar->_entriesPerPage = _entriesPerPage;
 	_scrollBar->_currentPos = _currentPos;
 	_scrollBar->recalc();
@@ -296,7 +369,7 @@ void ListWidget::handleMouseMoved(int x, int y, int button) {
 
 	if (item != -1) {
 		if(_lastRead != item) {
-			read(_list[item]);
+			read(getListItem(item));
 			_lastRead = item;
 		}
 	}
@@ -313,7 +386,7 @@ int ListWidget::findItem(int x, int y) const {
 	if (y < _topPadding) return -1;
 	int item = (y - _topPadding) / kLineHeight + _currentPos;
 	if (item >= _currentPos && item < _currentPos + _entriesPerPage &&
-		item < (int)_list.size())
+		item < getListSize())
 		return item;
 	else
 		return -1;
@@ -356,18 +429,17 @@ bool ListWidget::handleKeyDown(Common::KeyState state) {
 			// key is pressed); it could be much faster. Only of importance if we have
 			// quite big lists to deal with -- so for now we can live with this lazy
 			// implementation :-)
-			int newSelectedItem = 0;
 			int bestMatch = 0;
 			bool stop;
-			for (Common::U32StringArray::const_iterator i = _list.begin(); i != _list.end(); ++i) {
-				const int match = matchingCharsIgnoringCase(i->encode().c_str(), _quickSelectStr.c_str(), stop, _dictionarySelect);
+			const int size = getListSize();
+			for (int newSelectedItem = 0; newSelectedItem < size; ++newSelectedItem) {
+				const int match = matchingCharsIgnoringCase(getListItem(newSelectedItem).encode().c_str(), _quickSelectStr.c_str(), stop, _dictionarySelect);
 				if (match > bestMatch || stop) {
 					_selectedItem = newSelectedItem;
 					bestMatch = match;
 					if (stop)
 						break;
 				}
-				newSelectedItem++;
 			}
 
 			scrollToCurrent();
@@ -422,7 +494,7 @@ bool ListWidget::handleKeyDown(Common::KeyState state) {
 			}
 			// fall through
 		case Common::KEYCODE_END:
-			_selectedItem = _list.size() - 1;
+			_selectedItem = getListSize() - 1;
 			break;
 
 
@@ -433,7 +505,7 @@ bool ListWidget::handleKeyDown(Common::KeyState state) {
 			}
 			// fall through
 		case Common::KEYCODE_DOWN:
-			if (_selectedItem < (int)_list.size() - 1)
+			if (_selectedItem < getListSize() - 1)
 				_selectedItem++;
 			break;
 
@@ -445,8 +517,8 @@ bool ListWidget::handleKeyDown(Common::KeyState state) {
 			// fall through
 		case Common::KEYCODE_PAGEDOWN:
 			_selectedItem += _entriesPerPage - 1;
-			if (_selectedItem >= (int)_list.size() )
-				_selectedItem = _list.size() - 1;
+			if (_selectedItem >= getListSize())
+				_selectedItem = getListSize() - 1;
 			break;
 
 		case Common::KEYCODE_KP7:
@@ -543,24 +615,26 @@ void ListWidget::handleCommand(CommandSender *sender, uint32 cmd, uint32 data) {
 }
 
 void ListWidget::drawWidget() {
-	int i, pos, len = _list.size();
+	int i, pos, len = getListSize();
 	Common::U32String buffer;
 
 	// Draw a thin frame around the list.
 	g_gui.theme()->drawWidgetBackground(Common::Rect(_x, _y, _x + _w, _y + _h),
 	                                    ThemeEngine::kWidgetBackgroundBorder);
 
-	// Draw the list items
+	// Only the horizontal extent of the edit rect is used, which is the same for all items
+	const Common::Rect r(getEditRect());
+	const int fontHeight = g_gui.getFontHeight();
+
+	// Draw the list items. Only the text of the visible items is fetched.
 	for (i = 0, pos = _currentPos; i < _entriesPerPage && pos < len; i++, pos++) {
 		const int y = _y + _topPadding + kLineHeight * i;
-		const int fontHeight = g_gui.getFontHeight();
 		ThemeEngine::TextInversionState inverted = ThemeEngine::kTextInversionNone;
 
 		// Draw the selected item inverted, on a highlighted background.
 		if (_selectedItem == pos)
 			inverted = _inversion;
 
-		Common::Rect r(getEditRect());
 		int pad = _leftPadding;
 		int rtlPad = (_x + r.left + _leftPadding) - (_x + _hlLeftPadding);
 
@@ -598,7 +672,7 @@ void ListWidget::drawWidget() {
 			color = _editColor;
 			adjustOffset();
 		} else {
-			buffer = _list[pos];
+			buffer = getListItem(pos);
 		}
 		g_gui.theme()->drawText(r1, buffer, _state,
 								_drawAlign, inverted, pad, true, ThemeEngine::kFontStyleBold, color);
@@ -631,8 +705,13 @@ Common::Rect ListWidget::getEditRect() const {
 
 	if (_numberingMode != kListNumberingOff) {
 		// FIXME: Assumes that all digits have the same width.
-		Common::String temp = Common::String::format("%2d. ", (_list.size() - 1 + _numberingMode));
-		r.left += g_gui.getStringWidth(temp) + _leftPadding;
+		// The prefix is only measured again when the number of digits changes.
+		Common::String temp = Common::String::format("%2d. ", (getListSize() - 1 + _numberingMode));
+		if (temp.size() != _numberingPrefix.size()) {
+			_numberingPrefix = temp;
+			_numberingWidth = g_gui.getStringWidth(temp);
+		}
+		r.left += _numberingWidth + _leftPadding;
 		// Make sure we don't go farther than right
 		if (r.right < r.left) {
 			r.right = r.left;
@@ -643,10 +722,11 @@ Common::Rect ListWidget::getEditRect() const {
 }
 
 void ListWidget::checkBounds() {
-	if (_currentPos < 0 || _entriesPerPage > (int)_list.size())
+	const int size = getListSize();
+	if (_currentPos < 0 || _entriesPerPage > size)
 		_currentPos = 0;
-	else if (_currentPos + _entriesPerPage > (int)_list.size())
-		_currentPos = _list.size() - _entriesPerPage;
+	else if (_currentPos + _entriesPerPage > size)
+		_currentPos = size - _entriesPerPage;
 }
 
 void ListWidget::scrollToCurrent() {
@@ -665,8 +745,8 @@ void ListWidget::scrollToCurrent() {
 }
 
 void ListWidget::scrollToEnd() {
-	if (_currentPos + _entriesPerPage < (int)_list.size()) {
-		_currentPos = _list.size() - _entriesPerPage;
+	if (_currentPos + _entriesPerPage < getListSize()) {
+		_currentPos = getListSize() - _entriesPerPage;
 	} else {
 		return;
 	}
@@ -677,7 +757,7 @@ void ListWidget::scrollToEnd() {
 }
 
 void ListWidget::startEditMode() {
-	if (_editable && !_editMode && _selectedItem >= 0) {
+	if (_editable && !_itemSource && !_editMode && _selectedItem >= 0) {
 		_editMode = true;
 		setEditString(_list[_selectedItem]);
 		_caretPos = _editString.size();	// Force caret to the *end* of the selection.
@@ -725,6 +805,9 @@ void ListWidget::reflowLayout() {
 
 	_scrollBarWidth = g_gui.xmlEval()->getVar("Globals.Scrollbar.Width", 0);
 
+	// The font may have changed
+	_numberingPrefix.clear();
+
 	// HACK: Once we take padding into account, there are times where
 	// integer rounding leaves a big chunk of white space in the bottom
 	// of the list.
@@ -759,6 +842,7 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 	if (_filter == filt) // Filter was not changed
 		return;
 
+	Common::U32String previousFilter = _filter;
 	_filter = filt;
 
 	if (_filter.empty()) {
@@ -767,31 +851,7 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 		_listIndex.clear();
 	} else {
 		// Restrict the list to everything which matches all tokens in _filter, ignoring case.
-
-		Common::U32StringTokenizer tok(_filter);
-		Common::U32String tmp;
-		int n = 0;
-
-		_list.clear();
-		_listIndex.clear();
-
-		for (Common::U32StringArray::iterator i = _dataList.begin(); i != _dataList.end(); ++i, ++n) {
-			tmp = *i;
-			tmp.toLowercase();
-			bool matches = true;
-			tok.reset();
-			while (!tok.empty()) {
-				if (!_filterMatcher(_filterMatcherArg, n, tmp, tok.nextToken())) {
-					matches = false;
-					break;
-				}
-			}
-
-			if (matches) {
-				_list.push_back(*i);
-				_listIndex.push_back(n);
-			}
-		}
+		applyFilter(previousFilter);
 	}
 
 	_currentPos = 0;
@@ -814,4 +874,56 @@ void ListWidget::setFilter(const Common::U32String &filter, bool redraw) {
 	}
 }
 
+void ListWidget::applyFilter(const Common::U32String &previousFilter) {
+	const uint dataSize = _itemSource ? _itemSourceCount : _dataList.size();
+
+	// Typing one more character can only drop entries, unless the filter uses
+	// the launcher's '!' (invert), '=' (exact) or '~' (wildcard) operators.
+	// _listIndex is only reused if no entries were added since it was built.
+	bool narrowing = !previousFilter.empty() && _filter.size() > previousFilter.size() &&
+		_filter.substr(0, previousFilter.size()) == previousFilter &&
+		!_filter.contains('!') && !_filter.contains('=') && !_filter.contains('~') &&
+		_dataListLower.size() == dataSize;
+
+	// Lowercase the entries once rather than on every keystroke
+	for (uint i = _dataListLower.size(); i < dataSize; ++i) {
+		Common::U32String lower = getDataItem(i);
+		lower.toLowercase();
+		_dataListLower.push_back(lower);
+	}
+
+	Common::Array<int> candidates;
+	if (narrowing) {
+		candidates = _listIndex;
+		// Group headers of a GroupedListWidget have no entry to check
+		for (uint i = 0; i < candidates.size() && narrowing; ++i)
+			narrowing = candidates[i] >= 0;
+	}
+
+	Common::U32StringTokenizer tok(_filter);
+	uint count = narrowing ? candidates.size() : dataSize;
+
+	_list.clear();
+	_listIndex.clear();
+
+	for (uint i = 0; i < count; ++i) {
+		int n = narrowing ? candidates[i] : (int)i;
+		bool matches = true;
+		tok.reset();
+		while (!tok.empty()) {
+			if (!_filterMatcher(_filterMatcherArg, n, _dataListLower[n], tok.nextToken())) {
+				matches = false;
+				break;
+			}
+		}
+
+		if (matches) {
+			// With an item source, the text is fetched through _listIndex when drawn
+			if (!_itemSource)
+				_list.push_back(_dataList[n]);
+			_listIndex.push_back(n);
+		}
+	}
+}
+
 } // End of namespace GUI
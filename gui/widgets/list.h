@@ -51,9 +51,15 @@ public:
 	typedef Common::Array<ThemeEngine::FontColor> ColorList;
 
 	typedef bool (*FilterMatcher)(void *arg, int idx, const Common::U32String &item, Common::U32String token);
+	typedef Common::U32String (*ItemSource)(void *arg, int idx);
 protected:
 	Common::U32StringArray	_list;
 	Common::U32StringArray	_dataList;
+	Common::U32StringArray	_dataListLower;	///< Lowercase copy of _dataList, filled when filtering
+	ItemSource		_itemSource;	///< Provides the entries instead of _dataList, see setItemSource()
+	void			*_itemSourceArg;
+	int				_itemSourceCount;
+	mutable Common::U32String	_selectedSourceItem;	///< Returned by getSelectedString() with an item source
 	ColorList		_listColors;
 	Common::Array<int>	_listIndex;
 	bool			_editable;
@@ -89,6 +95,26 @@ protected:
 	FilterMatcher	_filterMatcher;
 	void			*_filterMatcherArg;
 
+	mutable Common::String	_numberingPrefix;	///< Widest number prefix measured by getEditRect()
+	mutable int		_numberingWidth;
+
+	/** Number of entries shown, once filtered. */
+	int getListSize() const;
+
+	/** Text of the shown entry at position @p pos. */
+	Common::U32String getListItem(int pos) const;
+
+	/** Text of the entry @p idx of the unfiltered list. */
+	Common::U32String getDataItem(int idx) const;
+
+	/**
+	 * Fill _list and _listIndex with the entries matching _filter.
+	 *
+	 * When _filter only adds characters to previousFilter, only the
+	 * entries which matched previousFilter are checked again.
+	 */
+	void applyFilter(const Common::U32String &previousFilter);
+
 public:
 	ListWidget(Dialog *boss, const Common::String &name, const Common::U32String &tooltip = Common::U32String(), uint32 cmd = 0);
 	ListWidget(Dialog *boss, int x, int y, int w, int h, const Common::U32String &tooltip = Common::U32String(), uint32 cmd = 0);
@@ -99,12 +125,21 @@ public:
 	void setList(const Common::U32StringArray &list, const ColorList *colors = nullptr);
 	const Common::U32StringArray &getList()	const			{ return _dataList; }
 
+	/**
+	 * Show @p count entries provided by @p source instead of a copied list.
+	 *
+	 * The text of an entry is only requested when it is drawn, read, quick
+	 * selected or filtered. getList() stays empty and the entries cannot be
+	 * edited in this mode. setList() switches back to a copied list.
+	 */
+	void setItemSource(int count, ItemSource source, void *arg, const ColorList *colors = nullptr);
+
 	void append(const Common::String &s, ThemeEngine::FontColor color = ThemeEngine::kFontColorNormal);
 
 	void setSelected(int item);
 	int getSelected() const						{ return (_filter.empty() || _selectedItem == -1) ? _selectedItem : _listIndex[_selectedItem]; }
 
-	const Common::U32String &getSelectedString() const	{ return _list[_selectedItem]; }
+	const Common::U32String &getSelectedString() const;
 	ThemeEngine::FontColor getSelectionColor() const;
 
 	void setNumberingMode(NumberingMode numberingMode)	{ _numberingMode = numberingMode; }
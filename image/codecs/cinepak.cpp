@@ -57,74 +57,48 @@ inline uint16 createDitherTableIndex(const byte *clipTable, byte y, int8 u, int8
 }
 
 /**
- * Put a raw pixel to the destination surface
- */
-template<typename PixelInt>
-inline void putPixelRaw(PixelInt *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = convertYUVToColor(clipTable, format, y, u, v);
-}
-
-/**
- * Specialized putPixelRaw for palettized 8bpp output
- */
-template<>
-inline void putPixelRaw(byte *dst, const byte *clipTable, const Graphics::PixelFormat &format, byte y, byte u, byte v) {
-	*dst = y;
-}
-
-/**
- * The default codebook converter: raw output.
+ * The default codebook converter: raw output, using the codebook entries
+ * which were converted to the output format when the codebook was loaded.
  */
 struct CodebookConverterRaw {
 	template<typename PixelInt>
 	static inline void decodeBlock1(byte codebookIndex, const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook = strip.v1_codebook[codebookIndex];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook.y[0], codebook.u, codebook.v);
-
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook.y[1], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook.y[2], codebook.u, codebook.v);
-
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook.y[3], codebook.u, codebook.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook.y[3], codebook.u, codebook.v);
+		const uint32 *colors = strip.v1_colors[codebookIndex];
+		PixelInt color = colors[0];
+		rows[0][0] = rows[0][1] = rows[1][0] = rows[1][1] = color;
+		color = colors[1];
+		rows[0][2] = rows[0][3] = rows[1][2] = rows[1][3] = color;
+		color = colors[2];
+		rows[2][0] = rows[2][1] = rows[3][0] = rows[3][1] = color;
+		color = colors[3];
+		rows[2][2] = rows[2][3] = rows[3][2] = rows[3][3] = color;
 	}
 
 	template<typename PixelInt>
 	static inline void decodeBlock4(const byte (&codebookIndex)[4], const CinepakStrip &strip, PixelInt *(&rows)[4], const byte *clipTable, const byte *colorMap, const Graphics::PixelFormat &format) {
-		const CinepakCodebook &codebook1 = strip.v4_codebook[codebookIndex[0]];
-		putPixelRaw(rows[0] + 0, clipTable, format, codebook1.y[0], codebook1.u, codebook1.v);
-		putPixelRaw(rows[0] + 1, clipTable, format, codebook1.y[1], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 0, clipTable, format, codebook1.y[2], codebook1.u, codebook1.v);
-		putPixelRaw(rows[1] + 1, clipTable, format, codebook1.y[3], codebook1.u, codebook1.v);
-
-		const CinepakCodebook &codebook2 = strip.v4_codebook[codebookIndex[1]];
-		putPixelRaw(rows[0] + 2, clipTable, format, codebook2.y[0], codebook2.u, codebook2.v);
-		putPixelRaw(rows[0] + 3, clipTable, format, codebook2.y[1], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 2, clipTable, format, codebook2.y[2], codebook2.u, codebook2.v);
-		putPixelRaw(rows[1] + 3, clipTable, format, codebook2.y[3], codebook2.u, codebook2.v);
-
-		const CinepakCodebook &codebook3 = strip.v4_codebook[codebookIndex[2]];
-		putPixelRaw(rows[2] + 0, clipTable, format, codebook3.y[0], codebook3.u, codebook3.v);
-		putPixelRaw(rows[2] + 1, clipTable, format, codebook3.y[1], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 0, clipTable, format, codebook3.y[2], codebook3.u, codebook3.v);
-		putPixelRaw(rows[3] + 1, clipTable, format, codebook3.y[3], codebook3.u, codebook3.v);
-
-		const CinepakCodebook &codebook4 = strip.v4_codebook[codebookIndex[3]];
-		putPixelRaw(rows[2] + 2, clipTable, format, codebook4.y[0], codebook4.u, codebook4.v);
-		putPixelRaw(rows[2] + 3, clipTable, format, codebook4.y[1], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 2, clipTable, format, codebook4.y[2], codebook4.u, codebook4.v);
-		putPixelRaw(rows[3] + 3, clipTable, format, codebook4.y[3], codebook4.u, codebook4.v);
+		const uint32 *colors = strip.v4_colors[codebookIndex[0]];
+		rows[0][0] = colors[0];
+		rows[0][1] = colors[1];
+		rows[1][0] = colors[2];
+		rows[1][1] = colors[3];
+
+		colors = strip.v4_colors[codebookIndex[1]];
+		rows[0][2] = colors[0];
+		rows[0][3] = colors[1];
+		rows[1][2] = colors[2];
+		rows[1][3] = colors[3];
+
+		colors = strip.v4_colors[codebookIndex[2]];
+		rows[2][0] = colors[0];
+		rows[2][1] = colors[1];
+		rows[3][0] = colors[2];
+		rows[3][1] = colors[3];
+
+		colors = strip.v4_colors[codebookIndex[3]];
+		rows[2][2] = colors[0];
+		rows[2][3] = colors[1];
+		rows[3][2] = colors[2];
+		rows[3][3] = colors[3];
 	}
 };
 
@@ -392,7 +366,7 @@ CinepakDecoder::~CinepakDecoder() {
 	delete[] _curFrame.strips;
 	delete[] _clipTableBuf;
 
-	delete[] _colorMap;
+	freeColorMap();
 	delete[] _ditherPalette;
 }
 
@@ -438,6 +412,9 @@ const Graphics::Surface *CinepakDecoder::decodeFrame(Common::SeekableReadStream
 				_curFrame.strips[i].v4_codebook[j] = _curFrame.strips[i - 1].v4_codebook[j];
 			}
 
+			memcpy(_curFrame.strips[i].v1_colors, _curFrame.strips[i - 1].v1_colors, sizeof(_curFrame.strips[i].v1_colors));
+			memcpy(_curFrame.strips[i].v4_colors, _curFrame.strips[i - 1].v4_colors, sizeof(_curFrame.strips[i].v4_colors));
+
 			// Copy the QuickTime dither tables
 			memcpy(_curFrame.strips[i].v1_dither, _curFrame.strips[i - 1].v1_dither, 256 * 4 * 4 * 4);
 			memcpy(_curFrame.strips[i].v4_dither, _curFrame.strips[i - 1].v4_dither, 256 * 4 * 4 * 4);
@@ -513,6 +490,8 @@ void CinepakDecoder::initializeCodebook(uint16 strip, byte codebookType) {
 
 		if (_ditherType == kDitherTypeQT)
 			ditherCodebookQT(strip, codebookType, i);
+		else if (!_ditherPalette)
+			convertCodebook(strip, codebookType, i);
 	}
 }
 
@@ -549,19 +528,35 @@ void CinepakDecoder::loadCodebook(Common::SeekableReadStream &stream, uint16 str
 				codebook[i].v = 0;
 			}
 
-			// Dither the codebook if we're dithering for QuickTime
+			// Dither the codebook if we're dithering for QuickTime,
+			// otherwise convert it to the output format
 			if (_ditherType == kDitherTypeQT)
 				ditherCodebookQT(strip, codebookType, i);
+			else if (!_ditherPalette)
+				convertCodebook(strip, codebookType, i);
 		}
 	}
 }
 
+void CinepakDecoder::convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex) {
+	const CinepakCodebook &codebook = (codebookType == 1) ? _curFrame.strips[strip].v1_codebook[codebookIndex] : _curFrame.strips[strip].v4_codebook[codebookIndex];
+	uint32 *colors = (codebookType == 1) ? _curFrame.strips[strip].v1_colors[codebookIndex] : _curFrame.strips[strip].v4_colors[codebookIndex];
+
+	for (int i = 0; i < 4; i++) {
+		// Palettized video stores palette indices in y
+		if (_pixelFormat.bytesPerPixel == 1)
+			colors[i] = codebook.y[i];
+		else
+			colors[i] = convertYUVToColor(_clipTable, _pixelFormat, codebook.y[i], codebook.u, codebook.v);
+	}
+}
+
 void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 codebookIndex) {
 	if (codebookType == 1) {
 		const CinepakCodebook &codebook = _curFrame.strips[strip].v1_codebook[codebookIndex];
 		byte *output = _curFrame.strips[strip].v1_dither + (codebookIndex << 2);
 
-		byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
+		const byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
 		output[0x000] = ditherEntry[0x0000];
 		output[0x001] = ditherEntry[0x4000];
 		output[0x400] = ditherEntry[0xC000];
@@ -588,7 +583,7 @@ void CinepakDecoder::ditherCodebookQT(uint16 strip, byte codebookType, uint16 co
 		const CinepakCodebook &codebook = _curFrame.strips[strip].v4_codebook[codebookIndex];
 		byte *output = _curFrame.strips[strip].v4_dither + (codebookIndex << 2);
 
-		byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
+		const byte *ditherEntry = _colorMap + createDitherTableIndex(_clipTable, codebook.y[0], codebook.u, codebook.v);
 		output[0x000] = ditherEntry[0x0000];
 		output[0x400] = ditherEntry[0x8000];
 		output[0x800] = ditherEntry[0x4000];
@@ -631,7 +626,7 @@ bool CinepakDecoder::canDither(DitherType type) const {
 void CinepakDecoder::setDither(DitherType type, const byte *palette) {
 	assert(canDither(type));
 
-	delete[] _colorMap;
+	freeColorMap();
 	delete[] _ditherPalette;
 
 	_ditherPalette = new byte[256 * 3];
@@ -642,17 +637,28 @@ void CinepakDecoder::setDither(DitherType type, const byte *palette) {
 	_ditherType = type;
 
 	if (type == kDitherTypeVFW) {
-		_colorMap = new byte[221];
+		byte *colorMap = new byte[221];
 
 		for (int i = 0; i < 221; i++)
-			_colorMap[i] = findNearestRGB(i);
+			colorMap[i] = findNearestRGB(i);
+
+		_colorMap = colorMap;
 	} else {
-		// Generate QuickTime dither table
+		// Get the QuickTime dither table
 		// 4 blocks of 0x4000 bytes (RGB554 lookup)
-		_colorMap = createQuickTimeDitherTable(palette, 256);
+		_colorMap = acquireQuickTimeDitherTable(palette, 256);
 	}
 }
 
+void CinepakDecoder::freeColorMap() {
+	if (_ditherType == kDitherTypeQT)
+		releaseQuickTimeDitherTable(_colorMap);
+	else
+		delete[] _colorMap;
+
+	_colorMap = nullptr;
+}
+
 byte CinepakDecoder::findNearestRGB(int index) const {
 	int r = s_defaultPalette[index * 3];
 	int g = s_defaultPalette[index * 3 + 1];
@@ -45,6 +45,7 @@ struct CinepakStrip {
 	uint16 length;
 	Common::Rect rect;
 	CinepakCodebook v1_codebook[256], v4_codebook[256];
+	uint32 v1_colors[256][4], v4_colors[256][4]; // The codebooks in the output format
 	byte v1_dither[256 * 4 * 4 * 4], v4_dither[256 * 4 * 4 * 4];
 };
 
@@ -90,10 +91,13 @@ private:
 
 	byte *_ditherPalette;
 	bool _dirtyPalette;
-	byte *_colorMap;
+	const byte *_colorMap;
 	DitherType _ditherType;
 
+	void freeColorMap();
+
 	void initializeCodebook(uint16 strip, byte codebookType);
+	void convertCodebook(uint16 strip, byte codebookType, uint16 codebookIndex);
 	void loadCodebook(Common::SeekableReadStream &stream, uint16 strip, byte codebookType, byte chunkID, uint32 chunkSize);
 	void decodeVectors(Common::SeekableReadStream &stream, uint16 strip, byte chunkID, uint32 chunkSize);
 
@@ -19,6 +19,7 @@
  *
  */
 
+#include "common/array.h"
 #include "common/list.h"
 #include "common/scummsys.h"
 
@@ -71,8 +72,93 @@ inline uint16 makeQuickTimeDitherColor(byte r, byte g, byte b) {
 	return ((r & 0xF8) << 6) | ((g & 0xF8) << 1) | (b >> 4);
 }
 
+/** The dither tables of the palettes used recently. */
+class QuickTimeDitherTableCache {
+public:
+	~QuickTimeDitherTableCache() {
+		for (uint i = 0; i < _entries.size(); i++)
+			delete[] _entries[i].table;
+	}
+
+	const byte *acquire(const byte *palette, uint colorCount) {
+		for (uint i = 0; i < _entries.size(); i++) {
+			Entry &entry = _entries[i];
+			if (entry.colorCount == colorCount && !memcmp(entry.palette, palette, colorCount * 3)) {
+				entry.refCount++;
+				entry.lastUse = ++_useCounter;
+				return entry.table;
+			}
+		}
+
+		Entry entry;
+		memcpy(entry.palette, palette, colorCount * 3);
+		entry.colorCount = colorCount;
+		entry.table = Codec::createQuickTimeDitherTable(palette, colorCount);
+		entry.refCount = 1;
+		entry.lastUse = ++_useCounter;
+		_entries.push_back(entry);
+		return entry.table;
+	}
+
+	void release(const byte *table) {
+		for (uint i = 0; i < _entries.size(); i++) {
+			if (_entries[i].table == table) {
+				assert(_entries[i].refCount > 0);
+				_entries[i].refCount--;
+				break;
+			}
+		}
+
+		// Drop the least recently used tables nobody uses anymore
+		for (;;) {
+			uint unused = 0;
+			int oldest = -1;
+			for (uint i = 0; i < _entries.size(); i++) {
+				if (_entries[i].refCount == 0) {
+					unused++;
+					if (oldest < 0 || _entries[i].lastUse < _entries[oldest].lastUse)
+						oldest = i;
+				}
+			}
+
+			if (unused <= kMaxUnusedTables)
+				break;
+
+			delete[] _entries[oldest].table;
+			_entries.remove_at(oldest);
+		}
+	}
+
+private:
+	/** How many tables (of 64 KB each) to keep when no codec uses them. */
+	static const uint kMaxUnusedTables = 2;
+
+	struct Entry {
+		byte palette[256 * 3];
+		uint colorCount;
+		byte *table;
+		uint refCount;
+		uint32 lastUse;
+	};
+
+	Common::Array<Entry> _entries;
+	uint32 _useCounter = 0;
+};
+
+QuickTimeDitherTableCache s_ditherTableCache;
+
 } // End of anonymous namespace
 
+const byte *Codec::acquireQuickTimeDitherTable(const byte *palette, uint colorCount) {
+	assert(colorCount <= 256);
+	return s_ditherTableCache.acquire(palette, colorCount);
+}
+
+void Codec::releaseQuickTimeDitherTable(const byte *table) {
+	if (table)
+		s_ditherTableCache.release(table);
+}
+
 byte *Codec::createQuickTimeDitherTable(const byte *palette, uint colorCount) {
 	byte *buf = new byte[0x10000]();
 
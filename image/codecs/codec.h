@@ -114,6 +114,18 @@ public:
 	 * Create a dither table, as used by QuickTime codecs.
 	 */
 	static byte *createQuickTimeDitherTable(const byte *palette, uint colorCount);
+
+	/**
+	 * Get the QuickTime dither table of a palette. Tables are shared between
+	 * all codecs using the same palette, and kept for a while after they are
+	 * released, so the videos of a game don't build the same table over and
+	 * over.
+	 *
+	 * The table must be given back with releaseQuickTimeDitherTable().
+	 * These functions are not thread-safe.
+	 */
+	static const byte *acquireQuickTimeDitherTable(const byte *palette, uint colorCount);
+	static void releaseQuickTimeDitherTable(const byte *table);
 };
 
 /**
@@ -31,6 +31,7 @@
 #include "common/algorithm.h"
 #include "common/rect.h"
 #include "common/textconsole.h"
+#include "common/threadpool.h"
 #include "common/util.h"
 
 namespace Image {
@@ -534,16 +535,26 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 	//{ START_TIMER;
 
 	if (isNonNullFrame()) {
+		// The headers have to be parsed in order, but the block data of
+		// the tiles can then be decoded independently
+		const bool deferBlocks = ThreadPoolMan.getThreadCount() > 0;
+		_tileJobs.clear();
+
 		_ctx._bufInvalid[_ctx._dstBuf] = 1;
 		for (int p = 0; p < 3; p++) {
 			for (int b = 0; b < _ctx._planes[p]._numBands; b++) {
-				result = decode_band(&_ctx._planes[p]._bands[b]);
+				result = decode_band(&_ctx._planes[p]._bands[b], deferBlocks);
 				if (result < 0) {
 					warning("Error while decoding band: %d, _plane: %d", b, p);
 					return result;
 				}
 			}
 		}
+		if (deferBlocks) {
+			result = decodeTileJobs();
+			if (result < 0)
+				return result;
+		}
 		_ctx._bufInvalid[_ctx._dstBuf] = 0;
 	} else {
 		if (_ctx._isScalable)
@@ -619,7 +630,7 @@ int IndeoDecoderBase::decodeIndeoFrame() {
 	return 0;
 }
 
-int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
+int IndeoDecoderBase::decode_band(IVIBandDesc *band, bool deferBlocks) {
 	band->_buf = band->_bufs[_ctx._dstBuf];
 	if (!band->_buf) {
 		warning("Band buffer points to no data!");
@@ -648,7 +659,12 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 
 	band->_rvMap = &_ctx._rvmapTabs[band->_rvmapSel];
 
-	// apply corrections to the selected rvmap table if present
+	// apply corrections to a copy of the selected rvmap table if present,
+	// so that the tables stay the same for the other bands
+	if (band->_numCorr) {
+		band->_rvMapCorr = *band->_rvMap;
+		band->_rvMap = &band->_rvMapCorr;
+	}
 	for (int i = 0; i < band->_numCorr; i++) {
 		int idx1 = band->_corr[i * 2];
 		int idx2 = band->_corr[i * 2 + 1];
@@ -689,6 +705,30 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 			if (result < 0)
 				break;
 
+			if (deferBlocks) {
+				// Continue where decodeBlocks() would have left off, which
+				// is the first byte boundary at or after the tile end
+				const uint32 tileEnd = pos + (tile->_dataSize << 3);
+				const uint32 nextPos = (tileEnd + 7) & ~7;
+				if (_ctx._gb->pos() > tileEnd || nextPos > _ctx._gb->size()) {
+					warning("Tile _dataSize mismatch!");
+					result = -1;
+					break;
+				}
+
+				TileJob job;
+				job._band = band;
+				job._tile = tile;
+				job._tileStart = pos;
+				job._blocksStart = _ctx._gb->pos();
+				job._result = 0;
+				_tileJobs.push_back(job);
+
+				_ctx._gb->skip(nextPos - _ctx._gb->pos());
+				pos = tileEnd;
+				continue;
+			}
+
 			result = decodeBlocks(_ctx._gb, band, tile);
 			if (result < 0) {
 				warning("Corrupted tile data encountered!");
@@ -705,24 +745,46 @@ int IndeoDecoderBase::decode_band(IVIBandDesc *band) {
 		}
 	}
 
-	// restore the selected rvmap table by applying its corrections in
-	// reverse order
-	for (int i = band->_numCorr - 1; i >= 0; i--) {
-		int idx1 = band->_corr[i * 2];
-		int idx2 = band->_corr[i * 2 + 1];
-		SWAP(band->_rvMap->_runtab[idx1], band->_rvMap->_runtab[idx2]);
-		SWAP(band->_rvMap->_valtab[idx1], band->_rvMap->_valtab[idx2]);
-		if (idx1 == band->_rvMap->_eobSym || idx2 == band->_rvMap->_eobSym)
-			band->_rvMap->_eobSym ^= idx1 ^ idx2;
-		if (idx1 == band->_rvMap->_escSym || idx2 == band->_rvMap->_escSym)
-			band->_rvMap->_escSym ^= idx1 ^ idx2;
-	}
-
 	_ctx._gb->align();
 
 	return result;
 }
 
+void IndeoDecoderBase::decodeTileJobRange(void *data, uint begin, uint end) {
+	IndeoDecoderBase *decoder = (IndeoDecoderBase *)data;
+
+	for (uint i = begin; i < end; i++) {
+		TileJob &job = decoder->_tileJobs[i];
+
+		// Each tile gets a reader of its own, starting at the byte
+		// holding the first bit of its block data
+		const uint32 startByte = job._blocksStart >> 3;
+		GetBits gb(decoder->_ctx._frameData + startByte, decoder->_ctx._frameSize - startByte);
+		gb.skip(job._blocksStart & 7);
+
+		job._result = decoder->decodeBlocks(&gb, job._band, job._tile);
+		if (job._result >= 0 && (((startByte << 3) + (uint32)gb.pos() - job._tileStart) >> 3) != (uint32)job._tile->_dataSize)
+			job._result = -2;
+	}
+}
+
+int IndeoDecoderBase::decodeTileJobs() {
+	ThreadPoolMan.parallelFor(0, _tileJobs.size(), 1, decodeTileJobRange, this);
+
+	for (uint i = 0; i < _tileJobs.size(); i++) {
+		const TileJob &job = _tileJobs[i];
+		if (job._result == -2) {
+			warning("Tile _dataSize mismatch!");
+			return -1;
+		} else if (job._result < 0) {
+			warning("Corrupted tile data encountered!");
+			return -1;
+		}
+	}
+
+	return 0;
+}
+
 void IndeoDecoderBase::recomposeHaar(const IVIPlaneDesc *_plane,
 		uint8 *dst, const int dstPitch) {
 
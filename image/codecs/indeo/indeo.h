@@ -20,6 +20,7 @@
  */
 
 #include "common/scummsys.h"
+#include "common/array.h"
 #include "graphics/surface.h"
 #include "image/codecs/codec.h"
 
@@ -229,6 +230,7 @@ struct IVIBandDesc {
 	uint8			_corr[61 * 2];	///< rvmap correction pairs
 	int				_rvmapSel;		///< rvmap table selector
 	RVMapDesc *		_rvMap;			///< ptr to the RLE table for this band
+	RVMapDesc		_rvMapCorr;		///< copy of the RLE table with the corrections applied
 	int				_numTiles;		///< number of tiles in this band
 	IVITile *		_tiles;			///< array of tile descriptors
 	InvTransformPtr *_invTransform;
@@ -434,13 +436,38 @@ private:
 
 class IndeoDecoderBase : public Codec {
 private:
+	/**
+	 *  A tile whose blocks are decoded after all band headers and
+	 *  macroblock infos of the frame were parsed.
+	 */
+	struct TileJob {
+		IVIBandDesc *	_band;
+		IVITile *		_tile;
+		uint32			_tileStart;		///< bit position of the tile in the frame data
+		uint32			_blocksStart;	///< bit position of the block data in the frame data
+		int				_result;
+	};
+
+	Common::Array<TileJob> _tileJobs;
+
 	/**
 	 *  Decode an Indeo 4 or 5 band.
 	 *
-	 *  @param[in,out]  band   ptr to the band descriptor
+	 *  @param[in,out]  band         ptr to the band descriptor
+	 *  @param[in]      deferBlocks  queue the block data of the tiles in
+	 *                               _tileJobs instead of decoding it
 	 *  @returns        result code: 0 = OK, -1 = error
 	 */
-	int decode_band(IVIBandDesc *band);
+	int decode_band(IVIBandDesc *band, bool deferBlocks);
+
+	/**
+	 *  Decode the block data of all queued tiles on the worker threads.
+	 *
+	 *  @returns	result code: 0 = OK, -1 = error
+	 */
+	int decodeTileJobs();
+
+	static void decodeTileJobRange(void *data, uint begin, uint end);
 
 	/**
 	 *  Haar wavelet recomposition filter for Indeo 4
@@ -0,0 +1,76 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "image/codecs/indeo/indeo_dsp_simd.h"
+
+#include <arm_neon.h>
+
+namespace Image {
+namespace Indeo {
+
+struct NEONOps {
+	typedef int32x4_t Vec32;
+	typedef int16x8_t Vec16;
+
+	static inline Vec32 load32(const int32 *p) { return vld1q_s32(p); }
+	static inline void store32(int32 *p, Vec32 v) { vst1q_s32(p, v); }
+	static inline Vec32 set32(int32 v) { return vdupq_n_s32(v); }
+	static inline Vec32 add32(Vec32 a, Vec32 b) { return vaddq_s32(a, b); }
+	static inline Vec32 sub32(Vec32 a, Vec32 b) { return vsubq_s32(a, b); }
+	static inline Vec32 and32(Vec32 a, Vec32 b) { return vandq_s32(a, b); }
+	template<int n> static inline Vec32 sra32(Vec32 v) { return vshrq_n_s32(v, n); }
+	template<int n> static inline Vec32 shl32(Vec32 v) { return vshlq_n_s32(v, n); }
+
+	/** All bits set in the lanes whose flag is non-zero. */
+	static inline Vec32 mask32(const uint8 *flags) {
+		const int32 f[4] = { flags[0], flags[1], flags[2], flags[3] };
+		return vreinterpretq_s32_u32(vtstq_s32(vld1q_s32(f), vdupq_n_s32(-1)));
+	}
+
+	static inline void transpose4(Vec32 &a, Vec32 &b, Vec32 &c, Vec32 &d) {
+		const int32x4x2_t ab = vtrnq_s32(a, b);
+		const int32x4x2_t cd = vtrnq_s32(c, d);
+
+		a = vcombine_s32(vget_low_s32(ab.val[0]), vget_low_s32(cd.val[0]));
+		b = vcombine_s32(vget_low_s32(ab.val[1]), vget_low_s32(cd.val[1]));
+		c = vcombine_s32(vget_high_s32(ab.val[0]), vget_high_s32(cd.val[0]));
+		d = vcombine_s32(vget_high_s32(ab.val[1]), vget_high_s32(cd.val[1]));
+	}
+
+	/** Store eight values, truncated to 16 bits like the scalar code does. */
+	static inline void storeNarrow(int16 *p, Vec32 lo, Vec32 hi) {
+		vst1q_s16(p, vcombine_s16(vmovn_s32(lo), vmovn_s32(hi)));
+	}
+
+	static inline Vec16 load16(const int16 *p) { return vld1q_s16(p); }
+	static inline void store16(int16 *p, Vec16 v) { vst1q_s16(p, v); }
+	static inline Vec16 set16(int16 v) { return vdupq_n_s16(v); }
+	static inline Vec16 add16(Vec16 a, Vec16 b) { return vaddq_s16(a, b); }
+	static inline Vec16 and16(Vec16 a, Vec16 b) { return vandq_s16(a, b); }
+	template<int n> static inline Vec16 sra16(Vec16 v) { return vshrq_n_s16(v, n); }
+};
+
+const IndeoDSPKernels &getNEONIndeoDSPKernels() {
+	return IndeoDSPSIMD<NEONOps>::getKernels();
+}
+
+} // End of namespace Indeo
+} // End of namespace Image
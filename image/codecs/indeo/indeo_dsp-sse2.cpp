@@ -0,0 +1,81 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "image/codecs/indeo/indeo_dsp_simd.h"
+
+#include <emmintrin.h>
+
+namespace Image {
+namespace Indeo {
+
+struct SSE2Ops {
+	typedef __m128i Vec32;
+	typedef __m128i Vec16;
+
+	static inline Vec32 load32(const int32 *p) { return _mm_loadu_si128((const __m128i *)p); }
+	static inline void store32(int32 *p, Vec32 v) { _mm_storeu_si128((__m128i *)p, v); }
+	static inline Vec32 set32(int32 v) { return _mm_set1_epi32(v); }
+	static inline Vec32 add32(Vec32 a, Vec32 b) { return _mm_add_epi32(a, b); }
+	static inline Vec32 sub32(Vec32 a, Vec32 b) { return _mm_sub_epi32(a, b); }
+	static inline Vec32 and32(Vec32 a, Vec32 b) { return _mm_and_si128(a, b); }
+	template<int n> static inline Vec32 sra32(Vec32 v) { return _mm_srai_epi32(v, n); }
+	template<int n> static inline Vec32 shl32(Vec32 v) { return _mm_slli_epi32(v, n); }
+
+	/** All bits set in the lanes whose flag is non-zero. */
+	static inline Vec32 mask32(const uint8 *flags) {
+		const __m128i f = _mm_set_epi32(flags[3], flags[2], flags[1], flags[0]);
+		return _mm_xor_si128(_mm_cmpeq_epi32(f, _mm_setzero_si128()), _mm_set1_epi32(-1));
+	}
+
+	static inline void transpose4(Vec32 &a, Vec32 &b, Vec32 &c, Vec32 &d) {
+		const __m128i ab0 = _mm_unpacklo_epi32(a, b);
+		const __m128i ab1 = _mm_unpackhi_epi32(a, b);
+		const __m128i cd0 = _mm_unpacklo_epi32(c, d);
+		const __m128i cd1 = _mm_unpackhi_epi32(c, d);
+
+		a = _mm_unpacklo_epi64(ab0, cd0);
+		b = _mm_unpackhi_epi64(ab0, cd0);
+		c = _mm_unpacklo_epi64(ab1, cd1);
+		d = _mm_unpackhi_epi64(ab1, cd1);
+	}
+
+	/** Store eight values, truncated to 16 bits like the scalar code does. */
+	static inline void storeNarrow(int16 *p, Vec32 lo, Vec32 hi) {
+		// Sign extend the low halves, so that the saturating pack keeps them
+		lo = _mm_srai_epi32(_mm_slli_epi32(lo, 16), 16);
+		hi = _mm_srai_epi32(_mm_slli_epi32(hi, 16), 16);
+		_mm_storeu_si128((__m128i *)p, _mm_packs_epi32(lo, hi));
+	}
+
+	static inline Vec16 load16(const int16 *p) { return _mm_loadu_si128((const __m128i *)p); }
+	static inline void store16(int16 *p, Vec16 v) { _mm_storeu_si128((__m128i *)p, v); }
+	static inline Vec16 set16(int16 v) { return _mm_set1_epi16(v); }
+	static inline Vec16 add16(Vec16 a, Vec16 b) { return _mm_add_epi16(a, b); }
+	static inline Vec16 and16(Vec16 a, Vec16 b) { return _mm_and_si128(a, b); }
+	template<int n> static inline Vec16 sra16(Vec16 v) { return _mm_srai_epi16(v, n); }
+};
+
+const IndeoDSPKernels &getSSE2IndeoDSPKernels() {
+	return IndeoDSPSIMD<SSE2Ops>::getKernels();
+}
+
+} // End of namespace Indeo
+} // End of namespace Image
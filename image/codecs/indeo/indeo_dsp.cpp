@@ -26,6 +26,9 @@
  */
 
 #include "image/codecs/indeo/indeo_dsp.h"
+#include "image/codecs/indeo/indeo_dsp_intern.h"
+
+#include "common/cpu.h"
 
 namespace Image {
 namespace Indeo {
@@ -70,7 +73,7 @@ namespace Indeo {
 	d3 = COMPENSATE(t2);\
 	d4 = COMPENSATE(t3); }
 
-void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
+static void inverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 							 const uint8 *flags) {
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
@@ -122,6 +125,11 @@ void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
 #undef  COMPENSATE
 }
 
+void IndeoDSP::ffIviInverseHaar8x8(const int32 *in, int16 *out, uint32 pitch,
+							 const uint8 *flags) {
+	getIndeoDSPKernels().inverseHaar8x8(in, out, pitch, flags);
+}
+
 void IndeoDSP::ffIviRowHaar8(const int32 *in, int16 *out, uint32 pitch,
 					  const uint8 *flags) {
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
@@ -320,7 +328,7 @@ void IndeoDSP::ffIviDcHaar2d(const int32 *in, int16 *out, uint32 pitch,
 	d3 = COMPENSATE(t3);\
 	d4 = COMPENSATE(t4);}
 
-void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+static void inverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
 	int32 tmp[64];
 	int t0, t1, t2, t3, t4, t5, t6, t7, t8;
 
@@ -357,6 +365,10 @@ void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, c
 #undef COMPENSATE
 }
 
+void IndeoDSP::ffIviInverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+	getIndeoDSPKernels().inverseSlant8x8(in, out, pitch, flags);
+}
+
 void IndeoDSP::ffIviInverseSlant4x4(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
 	int32 tmp[16];
 	int t0, t1, t2, t3, t4;
@@ -565,12 +577,13 @@ static void iviMc ## size ##x## size ## suffix(int16 *buf, \
 	default: \
 		break; \
 	} \
-} \
-\
+}
+
+#define IVI_MC_FUNC(size, suffix) \
 void IndeoDSP::ffIviMc ## size ##x## size ## suffix(int16 *buf, const int16 *refBuf, \
 											 uint32 pitch, int mcType) \
 { \
-	iviMc ## size ##x## size ## suffix(buf, pitch, refBuf, pitch, mcType); \
+	mc ## size ##x## size ## suffix(buf, pitch, refBuf, pitch, mcType); \
 }
 
 #define IVI_MC_AVG_TEMPLATE(size, suffix, OP) \
@@ -582,8 +595,8 @@ void IndeoDSP::ffIviMcAvg ## size ##x## size ## suffix(int16 *buf, \
 { \
 	int16 tmp[size * size]; \
 \
-	iviMc ## size ##x## size ## NoDelta(tmp, size, refBuf, pitch, mcType); \
-	iviMc ## size ##x## size ## Delta(tmp, size, refBuf2, pitch, mcType2); \
+	mc ## size ##x## size ## NoDelta(tmp, size, refBuf, pitch, mcType); \
+	mc ## size ##x## size ## Delta(tmp, size, refBuf2, pitch, mcType2); \
 	for (int i = 0; i < size; i++, buf += pitch) { \
 		for (int j = 0; j < size; j++) {\
 			OP(buf[j], tmp[i * size + j] >> 1); \
@@ -598,10 +611,54 @@ IVI_MC_TEMPLATE(8, NoDelta, OP_PUT)
 IVI_MC_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_TEMPLATE(4, Delta,   OP_ADD)
+
+static inline void mc8x8NoDelta(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	getIndeoDSPKernels().mc8x8NoDelta(buf, dpitch, refBuf, pitch, mcType);
+}
+
+static inline void mc8x8Delta(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	getIndeoDSPKernels().mc8x8Delta(buf, dpitch, refBuf, pitch, mcType);
+}
+
+static inline void mc4x4NoDelta(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	iviMc4x4NoDelta(buf, dpitch, refBuf, pitch, mcType);
+}
+
+static inline void mc4x4Delta(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+	iviMc4x4Delta(buf, dpitch, refBuf, pitch, mcType);
+}
+
+IVI_MC_FUNC(8, NoDelta)
+IVI_MC_FUNC(8, Delta)
+IVI_MC_FUNC(4, NoDelta)
+IVI_MC_FUNC(4, Delta)
 IVI_MC_AVG_TEMPLATE(8, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(8, Delta,   OP_ADD)
 IVI_MC_AVG_TEMPLATE(4, NoDelta, OP_PUT)
 IVI_MC_AVG_TEMPLATE(4, Delta,   OP_ADD)
 
+const IndeoDSPKernels &getScalarIndeoDSPKernels() {
+	static const IndeoDSPKernels kernels = {
+		inverseHaar8x8,
+		inverseSlant8x8,
+		iviMc8x8NoDelta,
+		iviMc8x8Delta
+	};
+	return kernels;
+}
+
+const IndeoDSPKernels &getIndeoDSPKernels() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return getSSE2IndeoDSPKernels();
+#endif
+#ifdef SCUMMVM_NEON
+	if (Common::hasCpuFeature(Common::kCpuFeatureNEON))
+		return getNEONIndeoDSPKernels();
+#endif
+
+	return getScalarIndeoDSPKernels();
+}
+
 } // End of namespace Indeo
 } // End of namespace Image
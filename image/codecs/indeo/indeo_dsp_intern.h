@@ -0,0 +1,70 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IMAGE_CODECS_INDEO_INDEO_DSP_INTERN_H
+#define IMAGE_CODECS_INDEO_INDEO_DSP_INTERN_H
+
+#include "common/scummsys.h"
+
+namespace Image {
+namespace Indeo {
+
+/**
+ * The hot 8x8 block routines of IndeoDSP, which have optimized
+ * implementations for some CPUs. All implementations produce exactly the
+ * same output as the portable ones.
+ */
+struct IndeoDSPKernels {
+	/** @see IndeoDSP::ffIviInverseHaar8x8 */
+	void (*inverseHaar8x8)(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	/** @see IndeoDSP::ffIviInverseSlant8x8 */
+	void (*inverseSlant8x8)(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags);
+	/**
+	 * Copy an 8x8 block from the reference buffer, interpolating as
+	 * requested by mcType. Unknown types leave the block untouched.
+	 */
+	void (*mc8x8NoDelta)(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType);
+	/** Same as mc8x8NoDelta, but add the block to the one in buf. */
+	void (*mc8x8Delta)(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType);
+};
+
+/**
+ * Return the fastest block routines supported by the host CPU.
+ */
+const IndeoDSPKernels &getIndeoDSPKernels();
+
+/**
+ * Return the portable C++ block routines.
+ */
+const IndeoDSPKernels &getScalarIndeoDSPKernels();
+
+#ifdef SCUMMVM_SSE2
+const IndeoDSPKernels &getSSE2IndeoDSPKernels();
+#endif
+
+#ifdef SCUMMVM_NEON
+const IndeoDSPKernels &getNEONIndeoDSPKernels();
+#endif
+
+} // End of namespace Indeo
+} // End of namespace Image
+
+#endif
@@ -0,0 +1,260 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef IMAGE_CODECS_INDEO_INDEO_DSP_SIMD_H
+#define IMAGE_CODECS_INDEO_INDEO_DSP_SIMD_H
+
+#include "image/codecs/indeo/indeo_dsp_intern.h"
+
+namespace Image {
+namespace Indeo {
+
+/**
+ * Vectorized versions of the IndeoDSP block routines, shared by all
+ * instruction sets.
+ *
+ * The Ops class supplies the primitive operations on vectors of four
+ * int32 (Vec32) and eight int16 (Vec16) values. The transforms work on
+ * four columns, or four rows, at a time, so the arithmetic is the same
+ * 32-bit arithmetic as in the scalar code.
+ */
+template<class Ops>
+struct IndeoDSPSIMD {
+	typedef typename Ops::Vec32 Vec32;
+	typedef typename Ops::Vec16 Vec16;
+
+	/** The butterfly of the inverse Haar transform. */
+	static inline void haarBfly(Vec32 s1, Vec32 s2, Vec32 &o1, Vec32 &o2) {
+		o2 = Ops::template sra32<1>(Ops::sub32(s1, s2));
+		o1 = Ops::template sra32<1>(Ops::add32(s1, s2));
+	}
+
+	/** The inverse 8-point Haar transform, without compensation. */
+	static inline void invHaar8(const Vec32 *s, Vec32 *d) {
+		Vec32 t1 = Ops::template shl32<1>(s[0]);
+		Vec32 t5 = Ops::template shl32<1>(s[1]);
+		Vec32 t2, t3, t4, t6, t7, t8;
+
+		haarBfly(t1, t5, t1, t5);
+		haarBfly(t1, s[2], t1, t3);
+		haarBfly(t5, s[3], t5, t7);
+		haarBfly(t1, s[4], t1, t2);
+		haarBfly(t3, s[5], t3, t4);
+		haarBfly(t5, s[6], t5, t6);
+		haarBfly(t7, s[7], t7, t8);
+
+		d[0] = t1; d[1] = t2; d[2] = t3; d[3] = t4;
+		d[4] = t5; d[5] = t6; d[6] = t7; d[7] = t8;
+	}
+
+	/** The butterfly of the inverse slant transform. */
+	static inline void slantBfly(Vec32 s1, Vec32 s2, Vec32 &o1, Vec32 &o2) {
+		o2 = Ops::sub32(s1, s2);
+		o1 = Ops::add32(s1, s2);
+	}
+
+	/** The reflection a,b = 1/2, 5/4 of the inverse slant transform. */
+	static inline void iReflect(Vec32 s1, Vec32 s2, Vec32 &o1, Vec32 &o2) {
+		const Vec32 two = Ops::set32(2);
+		const Vec32 s1x2 = Ops::add32(s1, s1);
+		const Vec32 s2x2 = Ops::add32(s2, s2);
+
+		o1 = Ops::add32(Ops::template sra32<2>(Ops::add32(Ops::add32(s1, s2x2), two)), s1);
+		o2 = Ops::sub32(Ops::template sra32<2>(Ops::add32(Ops::sub32(s1x2, s2), two)), s2);
+	}
+
+	/** The reflection a,b = 1/2, 7/8 of the inverse slant transform. */
+	static inline void slantPart4(Vec32 s1, Vec32 s2, Vec32 &o1, Vec32 &o2) {
+		const Vec32 four = Ops::set32(4);
+		const Vec32 s1x4 = Ops::template shl32<2>(s1);
+		const Vec32 s2x4 = Ops::template shl32<2>(s2);
+
+		o1 = Ops::add32(s2, Ops::template sra32<3>(Ops::add32(Ops::sub32(s1x4, s2), four)));
+		o2 = Ops::add32(s1, Ops::template sra32<3>(Ops::sub32(Ops::sub32(four, s1), s2x4)));
+	}
+
+	/** The inverse 8-point slant transform, without compensation. */
+	static inline void invSlant8(const Vec32 *s, Vec32 *d) {
+		Vec32 t1, t2, t3, t4, t5, t6, t7, t8;
+
+		slantPart4(s[1], s[3], t4, t5);
+
+		slantBfly(s[0], t5, t1, t5);
+		slantBfly(s[4], s[5], t2, t6);
+		slantBfly(s[7], s[6], t7, t3);
+		slantBfly(t4, s[2], t4, t8);
+
+		slantBfly(t1, t2, t1, t2);
+		iReflect(t4, t3, t4, t3);
+		slantBfly(t5, t6, t5, t6);
+		iReflect(t8, t7, t8, t7);
+		slantBfly(t1, t4, t1, t4);
+		slantBfly(t2, t3, t2, t3);
+		slantBfly(t5, t8, t5, t8);
+		slantBfly(t6, t7, t6, t7);
+
+		d[0] = t1; d[1] = t2; d[2] = t3; d[3] = t4;
+		d[4] = t5; d[5] = t6; d[6] = t7; d[7] = t8;
+	}
+
+	/**
+	 * Apply a transform to all columns of an 8x8 block, four columns at a
+	 * time. Columns whose flag is clear are set to zero.
+	 */
+	template<bool haar>
+	static inline void columnPass(const int32 *in, int32 *tmp, const uint8 *flags) {
+		for (int half = 0; half < 8; half += 4) {
+			Vec32 s[8], d[8];
+
+			for (int i = 0; i < 8; i++)
+				s[i] = Ops::load32(in + i * 8 + half);
+
+			if (haar) {
+				// pre-scaling of the first four columns
+				if (half == 0) {
+					for (int i = 0; i < 4; i++)
+						s[i] = Ops::template shl32<1>(s[i]);
+				}
+				invHaar8(s, d);
+			} else {
+				invSlant8(s, d);
+			}
+
+			const Vec32 mask = Ops::mask32(flags + half);
+			for (int i = 0; i < 8; i++)
+				Ops::store32(tmp + i * 8 + half, Ops::and32(d[i], mask));
+		}
+	}
+
+	/**
+	 * Apply a transform to all rows of an 8x8 block, four rows at a time,
+	 * by transposing them into columns and back.
+	 */
+	template<bool haar>
+	static inline void rowPass(const int32 *tmp, int16 *out, uint32 pitch) {
+		for (int row = 0; row < 8; row += 4, tmp += 32) {
+			Vec32 s[8], d[8];
+
+			for (int i = 0; i < 4; i++) {
+				s[i] = Ops::load32(tmp + i * 8);
+				s[i + 4] = Ops::load32(tmp + i * 8 + 4);
+			}
+			Ops::transpose4(s[0], s[1], s[2], s[3]);
+			Ops::transpose4(s[4], s[5], s[6], s[7]);
+
+			if (haar) {
+				invHaar8(s, d);
+			} else {
+				invSlant8(s, d);
+
+				// compensation
+				const Vec32 one = Ops::set32(1);
+				for (int i = 0; i < 8; i++)
+					d[i] = Ops::template sra32<1>(Ops::add32(d[i], one));
+			}
+
+			Ops::transpose4(d[0], d[1], d[2], d[3]);
+			Ops::transpose4(d[4], d[5], d[6], d[7]);
+
+			for (int i = 0; i < 4; i++, out += pitch)
+				Ops::storeNarrow(out, d[i], d[i + 4]);
+		}
+	}
+
+	static void inverseHaar8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+		int32 tmp[64];
+
+		columnPass<true>(in, tmp, flags);
+		rowPass<true>(tmp, out, pitch);
+	}
+
+	static void inverseSlant8x8(const int32 *in, int16 *out, uint32 pitch, const uint8 *flags) {
+		int32 tmp[64];
+
+		columnPass<false>(in, tmp, flags);
+		rowPass<false>(tmp, out, pitch);
+	}
+
+	/** floor((a + b) / 2) without overflowing 16 bits. */
+	static inline Vec16 avg2(Vec16 a, Vec16 b) {
+		const Vec16 lsb = Ops::and16(Ops::and16(a, b), Ops::set16(1));
+		return Ops::add16(Ops::add16(Ops::template sra16<1>(a), Ops::template sra16<1>(b)), lsb);
+	}
+
+	/** floor((a + b + c + d) / 4) without overflowing 16 bits. */
+	static inline Vec16 avg4(Vec16 a, Vec16 b, Vec16 c, Vec16 d) {
+		const Vec16 three = Ops::set16(3);
+		const Vec16 high = Ops::add16(Ops::add16(Ops::template sra16<2>(a), Ops::template sra16<2>(b)),
+		                              Ops::add16(Ops::template sra16<2>(c), Ops::template sra16<2>(d)));
+		const Vec16 low = Ops::add16(Ops::add16(Ops::and16(a, three), Ops::and16(b, three)),
+		                             Ops::add16(Ops::and16(c, three), Ops::and16(d, three)));
+		return Ops::add16(high, Ops::template sra16<2>(low));
+	}
+
+	template<bool delta>
+	static inline void mcStore(int16 *buf, Vec16 value) {
+		if (delta)
+			value = Ops::add16(Ops::load16(buf), value);
+		Ops::store16(buf, value);
+	}
+
+	template<bool delta>
+	static void mc8x8(int16 *buf, uint32 dpitch, const int16 *refBuf, uint32 pitch, int mcType) {
+		const int16 *wptr = refBuf + pitch;
+
+		switch (mcType) {
+		case 0: // fullpel (no interpolation)
+			for (int i = 0; i < 8; i++, buf += dpitch, refBuf += pitch)
+				mcStore<delta>(buf, Ops::load16(refBuf));
+			break;
+		case 1: // horizontal halfpel interpolation
+			for (int i = 0; i < 8; i++, buf += dpitch, refBuf += pitch)
+				mcStore<delta>(buf, avg2(Ops::load16(refBuf), Ops::load16(refBuf + 1)));
+			break;
+		case 2: // vertical halfpel interpolation
+			for (int i = 0; i < 8; i++, buf += dpitch, wptr += pitch, refBuf += pitch)
+				mcStore<delta>(buf, avg2(Ops::load16(refBuf), Ops::load16(wptr)));
+			break;
+		case 3: // vertical and horizontal halfpel interpolation
+			for (int i = 0; i < 8; i++, buf += dpitch, wptr += pitch, refBuf += pitch)
+				mcStore<delta>(buf, avg4(Ops::load16(refBuf), Ops::load16(refBuf + 1),
+				                         Ops::load16(wptr), Ops::load16(wptr + 1)));
+			break;
+		default:
+			break;
+		}
+	}
+
+	static const IndeoDSPKernels &getKernels() {
+		static const IndeoDSPKernels kernels = {
+			inverseHaar8x8,
+			inverseSlant8x8,
+			mc8x8<false>,
+			mc8x8<true>
+		};
+		return kernels;
+	}
+};
+
+} // End of namespace Indeo
+} // End of namespace Image
+
+#endif
@@ -19,8 +19,6 @@
  *
  */
 
-#ifdef USE_MPEG2
-
 #ifndef IMAGE_CODECS_MPEG_H
 #define IMAGE_CODECS_MPEG_H
 
@@ -41,11 +39,38 @@ struct Surface;
 namespace Image {
 
 /**
- * MPEG 1/2 video decoder.
+ * An MPEG 1/2 video decoder, which is fed the packets of an elementary
+ * stream.
+ *
+ * Implemented by MPEGDecoder, and by backends which can decode MPEG-2 in
+ * hardware (see OSystem::createHardwareMPEGDecoder()).
+ *
+ * Used by MPEGPSDecoder.
+ */
+class MPEGPacketDecoder {
+public:
+	virtual ~MPEGPacketDecoder() {}
+
+	/**
+	 * Decode a packet of the stream.
+	 *
+	 * @param packet      the packet data
+	 * @param framePeriod set to the duration of the decoded frame, in
+	 *                    27 MHz ticks, if a frame was completed
+	 * @param dst         the surface to convert a completed frame into
+	 * @return true if a frame was completed
+	 */
+	virtual bool decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst = 0) = 0;
+};
+
+#ifdef USE_MPEG2
+
+/**
+ * MPEG 1/2 video decoder, using libmpeg2.
  *
  * Used by BMP/AVI.
  */
-class MPEGDecoder : public Codec {
+class MPEGDecoder : public Codec, public MPEGPacketDecoder {
 public:
 	MPEGDecoder();
 	~MPEGDecoder();
@@ -70,8 +95,8 @@ private:
 	const mpeg2_info_t *_mpegInfo;
 };
 
+#endif // USE_MPEG2
+
 } // End of namespace Image
 
 #endif // IMAGE_CODECS_MPEG_H
-
-#endif // USE_MPEG2
@@ -47,7 +47,8 @@ namespace Image {
 JPEGDecoder::JPEGDecoder() :
 		_surface(),
 		_colorSpace(kColorSpaceRGB),
-		_requestedPixelFormat(getByteOrderRgbPixelFormat()) {
+		_requestedPixelFormat(getByteOrderRgbPixelFormat()),
+		_scaleDenominator(1) {
 }
 
 JPEGDecoder::~JPEGDecoder() {
@@ -271,6 +272,11 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		break;
 	}
 
+	// Let libjpeg reduce the size while computing the inverse DCT
+	assert(_scaleDenominator == 1 || _scaleDenominator == 2 || _scaleDenominator == 4 || _scaleDenominator == 8);
+	cinfo.scale_num = 1;
+	cinfo.scale_denom = _scaleDenominator;
+
 	// Actually start decompressing the image
 	jpeg_start_decompress(&cinfo);
 
@@ -295,18 +301,13 @@ bool JPEGDecoder::loadStream(Common::SeekableReadStream &stream) {
 		break;
 	}
 
-	// Allocate buffer for one scanline
-	JDIMENSION pitch = cinfo.output_width * _surface.format.bytesPerPixel;
-	assert(_surface.pitch >= (int)pitch);
-	JSAMPARRAY buffer = (*cinfo.mem->alloc_sarray)((j_common_ptr)&cinfo, JPOOL_IMAGE, pitch, 1);
+	assert(_surface.pitch >= (int)(cinfo.output_width * _surface.format.bytesPerPixel));
 
-	// Go through the image data scanline by scanline
+	// Go through the image data scanline by scanline, directly into the surface
 	while (cinfo.output_scanline < cinfo.output_height) {
-		byte *dst = (byte *)_surface.getBasePtr(0, cinfo.output_scanline);
-
-		jpeg_read_scanlines(&cinfo, buffer, 1);
+		JSAMPROW dst = (JSAMPROW)_surface.getBasePtr(0, cinfo.output_scanline);
 
-		memcpy(dst, buffer[0], pitch);
+		jpeg_read_scanlines(&cinfo, &dst, 1);
 	}
 
 	// We are done with decompressing, thus free all the data
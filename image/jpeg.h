@@ -101,10 +101,24 @@ public:
 	 */
 	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _requestedPixelFormat = format; }
 
+	/**
+	 * Request the image to be scaled down while decoding. This is done in
+	 * the DCT domain by libjpeg, which is a lot cheaper than decoding the
+	 * full image and scaling the result. Use this for thumbnails and
+	 * previews.
+	 *
+	 * The resulting surface is 1/denominator of the original size, rounded
+	 * up. The decoder defaults to 1.
+	 *
+	 * @param denominator The scale denominator, one of 1, 2, 4 or 8.
+	 */
+	void setScaleDenominator(uint denominator) { _scaleDenominator = denominator; }
+
 private:
 	Graphics::Surface _surface;
 	ColorSpace _colorSpace;
 	Graphics::PixelFormat _requestedPixelFormat;
+	uint _scaleDenominator;
 
 	Graphics::PixelFormat getByteOrderRgbPixelFormat() const;
 };
@@ -34,6 +34,18 @@ MODULE_OBJS := \
 	codecs/indeo/mem.o \
 	codecs/indeo/vlc.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	codecs/indeo/indeo_dsp-sse2.o
+
+$(MODULE)/codecs/indeo/indeo_dsp-sse2.o: CXXFLAGS += -msse2
+endif
+
+ifdef SCUMMVM_NEON
+MODULE_OBJS += \
+	codecs/indeo/indeo_dsp-neon.o
+endif
+
 ifdef USE_MPEG2
 MODULE_OBJS += \
 	codecs/mpeg.o
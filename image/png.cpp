@@ -30,6 +30,7 @@
 
 #include "image/png.h"
 
+#include "graphics/conversion.h"
 #include "graphics/pixelformat.h"
 #include "graphics/surface.h"
 
@@ -45,7 +46,8 @@ PNGDecoder::PNGDecoder() :
 		_paletteColorCount(0),
 		_skipSignature(false),
 		_keepTransparencyPaletted(false),
-		_transparentColor(-1) {
+		_transparentColor(-1),
+		_requestedPixelFormat() {
 }
 
 PNGDecoder::~PNGDecoder() {
@@ -98,6 +100,69 @@ void pngFlushStream(png_structp pngPtr) {
 	Common::WriteStream *stream = (Common::WriteStream *)writeIOptr;
 	stream->flush();
 }
+
+static int getByteIndex(uint8 shift, uint8 bytesPerPixel) {
+#ifdef SCUMM_BIG_ENDIAN
+	return bytesPerPixel - 1 - shift / 8;
+#else
+	return shift / 8;
+#endif
+}
+
+/**
+ * Registers the libpng transformations which produce the given pixel format
+ * from 8 bit RGB(A) data, if it is one of the byte orders libpng can output.
+ */
+static bool setupDirectOutput(png_structp pngPtr, const Graphics::PixelFormat &format, bool addFiller) {
+	if (format.bytesPerPixel < 3 || format.rLoss || format.gLoss || format.bLoss)
+		return false;
+	if ((format.rShift | format.gShift | format.bShift) & 7)
+		return false;
+
+	const int r = getByteIndex(format.rShift, format.bytesPerPixel);
+	const int g = getByteIndex(format.gShift, format.bytesPerPixel);
+	const int b = getByteIndex(format.bShift, format.bytesPerPixel);
+
+	if (format.bytesPerPixel == 3) {
+		if (format.aLoss != 8 || g != 1 || r + b != 2)
+			return false;
+		if (r == 2)
+			png_set_bgr(pngPtr);
+		png_set_strip_alpha(pngPtr);
+		return true;
+	}
+
+	// The alpha channel, or the filler, goes to the remaining byte
+	if (format.aLoss == 0 && (format.aShift & 7 || getByteIndex(format.aShift, 4) != 6 - r - g - b))
+		return false;
+	else if (format.aLoss != 0 && format.aLoss != 8)
+		return false;
+
+	bool bgr, alphaFirst;
+	if (r == 0 && g == 1 && b == 2) {
+		bgr = false;
+		alphaFirst = false;
+	} else if (r == 2 && g == 1 && b == 0) {
+		bgr = true;
+		alphaFirst = false;
+	} else if (r == 1 && g == 2 && b == 3) {
+		bgr = false;
+		alphaFirst = true;
+	} else if (r == 3 && g == 2 && b == 1) {
+		bgr = true;
+		alphaFirst = true;
+	} else {
+		return false;
+	}
+
+	if (bgr)
+		png_set_bgr(pngPtr);
+	if (alphaFirst)
+		png_set_swap_alpha(pngPtr);
+	if (addFiller)
+		png_set_filler(pngPtr, 0xff, alphaFirst ? PNG_FILLER_BEFORE : PNG_FILLER_AFTER);
+	return true;
+}
 #endif
 
 /*
@@ -145,6 +210,17 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	// We already verified the PNG-header
 	png_set_sig_bytes(pngPtr, 8);
 
+#ifdef PNG_SET_OPTION_SUPPORTED
+#ifdef PNG_ARM_NEON_API_SUPPORTED
+	// Use the NEON row filters when libpng leaves the choice to the application
+	png_set_option(pngPtr, PNG_ARM_NEON, PNG_OPTION_ON);
+#endif
+#ifdef PNG_SKIP_sRGB_CHECK_PROFILE
+	// The colour profile is ignored anyway, so do not spend time on validating it
+	png_set_option(pngPtr, PNG_SKIP_sRGB_CHECK_PROFILE, PNG_OPTION_ON);
+#endif
+#endif
+
 	// Read PNG header
 	png_read_info(pngPtr, infoPtr);
 
@@ -153,6 +229,8 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 	png_uint_32 w, h;
 	uint32 rgbaPalette[256];
 	bool hasRgbaPalette = false;
+	// The truecolor format libpng outputs, if it differs from the output surface
+	Graphics::PixelFormat rowFormat;
 
 	png_get_IHDR(pngPtr, infoPtr, &w, &h, &bitDepth, &colorType, &interlaceType, NULL, NULL);
 	width = w;
@@ -199,8 +277,14 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			}
 		}
 
-		_outputSurface->create(width, height,
-			hasRgbaPalette ? getByteOrderRgbaPixelFormat(true) : Graphics::PixelFormat::createFormatCLUT8());
+		Graphics::PixelFormat format = Graphics::PixelFormat::createFormatCLUT8();
+		if (hasRgbaPalette) {
+			if (_requestedPixelFormat.bytesPerPixel == 2 || _requestedPixelFormat.bytesPerPixel == 4)
+				format = _requestedPixelFormat;
+			else
+				format = getByteOrderRgbaPixelFormat(true);
+		}
+		_outputSurface->create(width, height, format);
 		png_set_packing(pngPtr);
 
 		if (hasRgbaPalette) {
@@ -224,10 +308,6 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			png_set_expand(pngPtr);
 		}
 
-		_outputSurface->create(width, height, getByteOrderRgbaPixelFormat(isAlpha));
-		if (!_outputSurface->getPixels()) {
-			error("Could not allocate memory for output image.");
-		}
 		if (bitDepth == 16)
 			png_set_strip_16(pngPtr);
 		if (bitDepth < 8)
@@ -236,8 +316,28 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 			colorType == PNG_COLOR_TYPE_GRAY_ALPHA)
 			png_set_gray_to_rgb(pngPtr);
 
-		if (colorType != PNG_COLOR_TYPE_RGB_ALPHA)
+		const bool addFiller = (colorType != PNG_COLOR_TYPE_RGB_ALPHA);
+		Graphics::PixelFormat format = getByteOrderRgbaPixelFormat(isAlpha);
+		bool directOutput = false;
+		if (_requestedPixelFormat.bytesPerPixel != 0 && _requestedPixelFormat != format) {
+			// Let libpng produce the requested byte order if possible,
+			// otherwise convert every row after decoding it. There is no
+			// conversion to other formats with 3 bytes per pixel.
+			if (setupDirectOutput(pngPtr, _requestedPixelFormat, addFiller)) {
+				format = _requestedPixelFormat;
+				directOutput = true;
+			} else if (_requestedPixelFormat.bytesPerPixel != 3) {
+				rowFormat = format;
+				format = _requestedPixelFormat;
+			}
+		}
+		if (addFiller && !directOutput)
 			png_set_filler(pngPtr, 0xff, PNG_FILLER_AFTER);
+
+		_outputSurface->create(width, height, format);
+		if (!_outputSurface->getPixels()) {
+			error("Could not allocate memory for output image.");
+		}
 	}
 
 	// After the transformations have been registered, the image data is read again.
@@ -255,14 +355,45 @@ bool PNGDecoder::loadStream(Common::SeekableReadStream &stream) {
 
 		for (int yp = 0; yp < height; ++yp) {
 			png_read_row(pngPtr, rowPtr, nullptr);
-			uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
 
-			for (int xp = 0; xp < width; ++xp)
-				destRowP[xp] = rgbaPalette[rowPtr[xp]];
+			if (_outputSurface->format.bytesPerPixel == 2) {
+				uint16 *destRowP = (uint16 *)_outputSurface->getBasePtr(0, yp);
+				for (int xp = 0; xp < width; ++xp)
+					destRowP[xp] = rgbaPalette[rowPtr[xp]];
+			} else {
+				uint32 *destRowP = (uint32 *)_outputSurface->getBasePtr(0, yp);
+				for (int xp = 0; xp < width; ++xp)
+					destRowP[xp] = rgbaPalette[rowPtr[xp]];
+			}
+		}
+
+		delete[] rowPtr;
+	} else if (rowFormat.bytesPerPixel != 0 && interlaceType == PNG_INTERLACE_NONE) {
+		// Convert each row while it is still in the cache
+		png_bytep rowPtr = new byte[width * rowFormat.bytesPerPixel];
+		for (int i = 0; i < height; i++) {
+			png_read_row(pngPtr, rowPtr, nullptr);
+			Graphics::crossBlit((byte *)_outputSurface->getBasePtr(0, i), rowPtr,
+				_outputSurface->pitch, width * rowFormat.bytesPerPixel, width, 1,
+				_outputSurface->format, rowFormat);
 		}
 
 		delete[] rowPtr;
-	} else  if (interlaceType == PNG_INTERLACE_NONE) {
+	} else if (rowFormat.bytesPerPixel != 0) {
+		// Interlaced images are only complete after the last pass
+		Graphics::Surface image;
+		image.create(width, height, rowFormat);
+
+		png_bytep *rowPtr = new png_bytep[height];
+		for (int i = 0; i < height; i++)
+			rowPtr[i] = (png_bytep)image.getBasePtr(0, i);
+		png_read_image(pngPtr, rowPtr);
+		delete[] rowPtr;
+
+		Graphics::crossBlit((byte *)_outputSurface->getPixels(), (const byte *)image.getPixels(),
+			_outputSurface->pitch, image.pitch, width, height, _outputSurface->format, rowFormat);
+		image.free();
+	} else if (interlaceType == PNG_INTERLACE_NONE) {
 		// PNGs without interlacing can simply be read row by row.
 		for (int i = 0; i < height; i++) {
 			png_read_row(pngPtr, (png_bytep)_outputSurface->getBasePtr(0, i), NULL);
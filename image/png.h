@@ -65,6 +65,17 @@ public:
 	int getTransparentColor() const { return _transparentColor; }
 	void setSkipSignature(bool skip) { _skipSignature = skip; }
 	void setKeepTransparencyPaletted(bool keep) { _keepTransparencyPaletted = keep; }
+
+	/**
+	 * Request the output pixel format for truecolor images. Formats with
+	 * 8 bits per channel in 4 bytes are produced by libpng directly, other
+	 * formats are converted row by row while decoding. This avoids a
+	 * subsequent conversion of the whole surface.
+	 *
+	 * Paletted images are still output as CLUT8 unless they need an RGBA
+	 * surface for their transparency.
+	 */
+	void setOutputPixelFormat(const Graphics::PixelFormat &format) { _requestedPixelFormat = format; }
 private:
 	Graphics::PixelFormat getByteOrderRgbaPixelFormat(bool isAlpha) const;
 
@@ -78,6 +89,9 @@ private:
 	bool _keepTransparencyPaletted;
 	int _transparentColor;
 
+	// The output format for truecolor images, or the byte order RGBA format if unset
+	Graphics::PixelFormat _requestedPixelFormat;
+
 	Graphics::Surface *_outputSurface;
 };
 
@@ -0,0 +1,144 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "math/matrix4_intern.h"
+
+#include <emmintrin.h>
+
+namespace Math {
+
+static void multiplySSE2(float *dst, const float *m1, const float *m2) {
+	const __m128 row0 = _mm_loadu_ps(m2);
+	const __m128 row1 = _mm_loadu_ps(m2 + 4);
+	const __m128 row2 = _mm_loadu_ps(m2 + 8);
+	const __m128 row3 = _mm_loadu_ps(m2 + 12);
+
+	for (int i = 0; i < 16; i += 4) {
+		__m128 r = _mm_mul_ps(_mm_set1_ps(m1[i + 0]), row0);
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1[i + 1]), row1));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1[i + 2]), row2));
+		r = _mm_add_ps(r, _mm_mul_ps(_mm_set1_ps(m1[i + 3]), row3));
+		_mm_storeu_ps(dst + i, r);
+	}
+}
+
+static void transformPointsSSE2(const float *m, const Vector3d *src, Vector3d *dst, uint count, bool translate) {
+	__m128 col0 = _mm_loadu_ps(m);
+	__m128 col1 = _mm_loadu_ps(m + 4);
+	__m128 col2 = _mm_loadu_ps(m + 8);
+	__m128 col3 = _mm_loadu_ps(m + 12);
+	_MM_TRANSPOSE4_PS(col0, col1, col2, col3);
+	if (!translate)
+		col3 = _mm_setzero_ps();
+
+	for (uint i = 0; i < count; i++) {
+		const float *s = src[i].getData();
+		__m128 r = _mm_mul_ps(col0, _mm_set1_ps(s[0]));
+		r = _mm_add_ps(r, _mm_mul_ps(col1, _mm_set1_ps(s[1])));
+		r = _mm_add_ps(r, _mm_mul_ps(col2, _mm_set1_ps(s[2])));
+		r = _mm_add_ps(r, col3);
+
+		// Only store three components, the next point may follow
+		float *d = dst[i].getData();
+		_mm_storel_pi((__m64 *)d, r);
+		_mm_store_ss(d + 2, _mm_movehl_ps(r, r));
+	}
+}
+
+/** Compute the 2x2 determinants of the columns (0, 1), (0, 2), (0, 3) and (1, 2) of two rows. */
+static inline __m128 determinants2x2Low(__m128 a, __m128 b) {
+	const __m128 a0 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(1, 0, 0, 0));
+	const __m128 a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 3, 2, 1));
+	const __m128 b0 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(1, 0, 0, 0));
+	const __m128 b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 3, 2, 1));
+	return _mm_sub_ps(_mm_mul_ps(a0, b1), _mm_mul_ps(b0, a1));
+}
+
+/** Compute the 2x2 determinants of the columns (1, 3) and (2, 3) of two rows, twice. */
+static inline __m128 determinants2x2High(__m128 a, __m128 b) {
+	const __m128 a0 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(2, 1, 2, 1));
+	const __m128 a1 = _mm_shuffle_ps(a, a, _MM_SHUFFLE(3, 3, 3, 3));
+	const __m128 b0 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(2, 1, 2, 1));
+	const __m128 b1 = _mm_shuffle_ps(b, b, _MM_SHUFFLE(3, 3, 3, 3));
+	return _mm_sub_ps(_mm_mul_ps(a0, b1), _mm_mul_ps(b0, a1));
+}
+
+static bool inverseSSE2(float *dst, const float *m) {
+	const __m128 row0 = _mm_loadu_ps(m);
+	const __m128 row1 = _mm_loadu_ps(m + 4);
+	const __m128 row2 = _mm_loadu_ps(m + 8);
+	const __m128 row3 = _mm_loadu_ps(m + 12);
+
+	// The same expansion as in the portable code: s0-s5 are the 2x2
+	// determinants of the upper two rows, c0-c5 those of the lower two
+	const __m128 sLow = determinants2x2Low(row0, row1);
+	const __m128 sHigh = determinants2x2High(row0, row1);
+	const __m128 cLow = determinants2x2Low(row2, row3);
+	const __m128 cHigh = determinants2x2High(row2, row3);
+
+	// (ck, ck, sk, sk)
+	const __m128 v0 = _mm_shuffle_ps(cLow, sLow, _MM_SHUFFLE(0, 0, 0, 0));
+	const __m128 v1 = _mm_shuffle_ps(cLow, sLow, _MM_SHUFFLE(1, 1, 1, 1));
+	const __m128 v2 = _mm_shuffle_ps(cLow, sLow, _MM_SHUFFLE(2, 2, 2, 2));
+	const __m128 v3 = _mm_shuffle_ps(cLow, sLow, _MM_SHUFFLE(3, 3, 3, 3));
+	const __m128 v4 = _mm_shuffle_ps(cHigh, sHigh, _MM_SHUFFLE(0, 0, 0, 0));
+	const __m128 v5 = _mm_shuffle_ps(cHigh, sHigh, _MM_SHUFFLE(1, 1, 1, 1));
+
+	// Column j of the matrix as (m1j, -m0j, m3j, -m2j)
+	__m128 p0 = row0, p1 = row1, p2 = row2, p3 = row3;
+	_MM_TRANSPOSE4_PS(p0, p1, p2, p3);
+	const __m128 sign = _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, (int)0x80000000, 0));
+	p0 = _mm_xor_ps(_mm_shuffle_ps(p0, p0, _MM_SHUFFLE(2, 3, 0, 1)), sign);
+	p1 = _mm_xor_ps(_mm_shuffle_ps(p1, p1, _MM_SHUFFLE(2, 3, 0, 1)), sign);
+	p2 = _mm_xor_ps(_mm_shuffle_ps(p2, p2, _MM_SHUFFLE(2, 3, 0, 1)), sign);
+	p3 = _mm_xor_ps(_mm_shuffle_ps(p3, p3, _MM_SHUFFLE(2, 3, 0, 1)), sign);
+
+	const __m128 inv0 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(p1, v5), _mm_mul_ps(p2, v4)), _mm_mul_ps(p3, v3));
+	const __m128 inv1 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(p2, v2), _mm_mul_ps(p0, v5)), _mm_mul_ps(p3, v1));
+	const __m128 inv2 = _mm_add_ps(_mm_sub_ps(_mm_mul_ps(p0, v4), _mm_mul_ps(p1, v2)), _mm_mul_ps(p3, v0));
+	const __m128 inv3 = _mm_sub_ps(_mm_sub_ps(_mm_mul_ps(p1, v1), _mm_mul_ps(p0, v3)), _mm_mul_ps(p2, v0));
+
+	// The dot product of the first row and the first column of the adjugate
+	const __m128 col0 = _mm_movelh_ps(_mm_unpacklo_ps(inv0, inv1), _mm_unpacklo_ps(inv2, inv3));
+	__m128 det = _mm_mul_ps(row0, col0);
+	det = _mm_add_ps(det, _mm_movehl_ps(det, det));
+	det = _mm_add_ss(det, _mm_shuffle_ps(det, det, _MM_SHUFFLE(1, 1, 1, 1)));
+	if (_mm_cvtss_f32(det) == 0)
+		return false;
+
+	const __m128 invDet = _mm_div_ps(_mm_set1_ps(1.0f), _mm_shuffle_ps(det, det, _MM_SHUFFLE(0, 0, 0, 0)));
+	_mm_storeu_ps(dst, _mm_mul_ps(inv0, invDet));
+	_mm_storeu_ps(dst + 4, _mm_mul_ps(inv1, invDet));
+	_mm_storeu_ps(dst + 8, _mm_mul_ps(inv2, invDet));
+	_mm_storeu_ps(dst + 12, _mm_mul_ps(inv3, invDet));
+	return true;
+}
+
+const Matrix4Kernels &getSSE2Matrix4Kernels() {
+	static const Matrix4Kernels kernels = {
+		multiplySSE2,
+		transformPointsSSE2,
+		inverseSSE2
+	};
+	return kernels;
+}
+
+} // End of namespace Math
@@ -20,11 +20,114 @@
  */
 
 #include "math/matrix4.h"
+#include "math/matrix4_intern.h"
 #include "math/vector4d.h"
 #include "math/squarematrix.h"
 
+#include "common/cpu.h"
+
 namespace Math {
 
+static inline void transformPoint(const float *m, const Vector3d &src, Vector3d &dst, bool translate) {
+	const float x = src.x();
+	const float y = src.y();
+	const float z = src.z();
+
+	if (translate) {
+		dst.set(m[0] * x + m[1] * y + m[2] * z + m[3],
+		        m[4] * x + m[5] * y + m[6] * z + m[7],
+		        m[8] * x + m[9] * y + m[10] * z + m[11]);
+	} else {
+		dst.set(m[0] * x + m[1] * y + m[2] * z,
+		        m[4] * x + m[5] * y + m[6] * z,
+		        m[8] * x + m[9] * y + m[10] * z);
+	}
+}
+
+static void multiplyScalar(float *dst, const float *m1, const float *m2) {
+	for (int i = 0; i < 16; i += 4) {
+		for (int j = 0; j < 4; ++j) {
+			dst[i + j] = (m1[i + 0] * m2[j + 0])
+				+ (m1[i + 1] * m2[j + 4])
+				+ (m1[i + 2] * m2[j + 8])
+				+ (m1[i + 3] * m2[j + 12]);
+		}
+	}
+}
+
+static void transformPointsScalar(const float *m, const Vector3d *src, Vector3d *dst, uint count, bool translate) {
+	for (uint i = 0; i < count; i++)
+		transformPoint(m, src[i], dst[i], translate);
+}
+
+static bool inverseScalar(float *dst, const float *m) {
+	// Expand the determinants along the upper and the lower two rows, which
+	// shares most of the products between the cofactors. See e.g. David
+	// Eberly's "The Laplace Expansion Theorem".
+	const float s0 = m[0] * m[5] - m[4] * m[1];
+	const float s1 = m[0] * m[6] - m[4] * m[2];
+	const float s2 = m[0] * m[7] - m[4] * m[3];
+	const float s3 = m[1] * m[6] - m[5] * m[2];
+	const float s4 = m[1] * m[7] - m[5] * m[3];
+	const float s5 = m[2] * m[7] - m[6] * m[3];
+
+	const float c0 = m[8] * m[13] - m[12] * m[9];
+	const float c1 = m[8] * m[14] - m[12] * m[10];
+	const float c2 = m[8] * m[15] - m[12] * m[11];
+	const float c3 = m[9] * m[14] - m[13] * m[10];
+	const float c4 = m[9] * m[15] - m[13] * m[11];
+	const float c5 = m[10] * m[15] - m[14] * m[11];
+
+	float inv[16];
+	inv[0] = m[5] * c5 - m[6] * c4 + m[7] * c3;
+	inv[1] = -m[1] * c5 + m[2] * c4 - m[3] * c3;
+	inv[2] = m[13] * s5 - m[14] * s4 + m[15] * s3;
+	inv[3] = -m[9] * s5 + m[10] * s4 - m[11] * s3;
+
+	inv[4] = -m[4] * c5 + m[6] * c2 - m[7] * c1;
+	inv[5] = m[0] * c5 - m[2] * c2 + m[3] * c1;
+	inv[6] = -m[12] * s5 + m[14] * s2 - m[15] * s1;
+	inv[7] = m[8] * s5 - m[10] * s2 + m[11] * s1;
+
+	inv[8] = m[4] * c4 - m[5] * c2 + m[7] * c0;
+	inv[9] = -m[0] * c4 + m[1] * c2 - m[3] * c0;
+	inv[10] = m[12] * s4 - m[13] * s2 + m[15] * s0;
+	inv[11] = -m[8] * s4 + m[9] * s2 - m[11] * s0;
+
+	inv[12] = -m[4] * c3 + m[5] * c1 - m[6] * c0;
+	inv[13] = m[0] * c3 - m[1] * c1 + m[2] * c0;
+	inv[14] = -m[12] * s3 + m[13] * s1 - m[14] * s0;
+	inv[15] = m[8] * s3 - m[9] * s1 + m[10] * s0;
+
+	const float det = m[0] * inv[0] + m[1] * inv[4] + m[2] * inv[8] + m[3] * inv[12];
+	if (det == 0)
+		return false;
+
+	const float invDet = 1.0f / det;
+	for (int i = 0; i < 16; i++)
+		dst[i] = inv[i] * invDet;
+
+	return true;
+}
+
+const Matrix4Kernels &getScalarMatrix4Kernels() {
+	static const Matrix4Kernels kernels = {
+		multiplyScalar,
+		transformPointsScalar,
+		inverseScalar
+	};
+	return kernels;
+}
+
+const Matrix4Kernels &getMatrix4Kernels() {
+#ifdef SCUMMVM_SSE2
+	if (Common::hasCpuFeature(Common::kCpuFeatureSSE2))
+		return getSSE2Matrix4Kernels();
+#endif
+
+	return getScalarMatrix4Kernels();
+}
+
 Matrix<4, 4>::Matrix() :
 	MatrixType<4, 4>(), Rotation3D<Matrix4>() {
 }
@@ -34,15 +137,21 @@ Matrix<4, 4>::Matrix(const MatrixBase<4, 4> &m) :
 }
 
 void Matrix<4, 4>::transform(Vector3d *v, bool trans) const {
-	Vector4d m;
-	m(0, 0) = v->x();
-	m(1, 0) = v->y();
-	m(2, 0) = v->z();
-	m(3, 0) = (trans ? 1.f : 0.f);
+	transformPoint(getData(), *v, *v, trans);
+}
+
+void Matrix<4, 4>::transformPoints(const Vector3d *src, Vector3d *dst, uint count, bool translate) const {
+	getMatrix4Kernels().transformPoints(getData(), src, dst, count, translate);
+}
 
-	m = *this * m;
+Matrix<4, 4> Matrix<4, 4>::operator*(const Matrix<4, 4> &m2) const {
+	Matrix<4, 4> result;
+	getMatrix4Kernels().multiply(result.getData(), getData(), m2.getData());
+	return result;
+}
 
-	v->set(m(0, 0), m(1, 0), m(2, 0));
+bool Matrix<4, 4>::inverse() {
+	return getMatrix4Kernels().inverse(getData(), getData());
 }
 
 Vector3d Matrix<4, 4>::getPosition() const {
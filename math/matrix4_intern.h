@@ -0,0 +1,67 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef MATH_MATRIX4_INTERN_H
+#define MATH_MATRIX4_INTERN_H
+
+#include "math/vector3d.h"
+
+namespace Math {
+
+/**
+ * Optimized routines used by Matrix4 for its products and its inverse.
+ *
+ * The matrices are passed as 16 floats in row-major order, like the data of
+ * a Matrix4. All implementations compute the same products as the portable
+ * code, up to rounding differences.
+ */
+struct Matrix4Kernels {
+	/** Store the product m1 * m2 in dst, which must not overlap m1 or m2. */
+	void (*multiply)(float *dst, const float *m1, const float *m2);
+	/**
+	 * Transform count points by m. The translation is only applied if
+	 * translate is true. src and dst may be the same array.
+	 */
+	void (*transformPoints)(const float *m, const Vector3d *src, Vector3d *dst, uint count, bool translate);
+	/**
+	 * Store the inverse of m in dst, which may be m itself. Return false
+	 * and leave dst untouched if m can't be inverted.
+	 */
+	bool (*inverse)(float *dst, const float *m);
+};
+
+/**
+ * Return the fastest routines supported by the host CPU.
+ */
+const Matrix4Kernels &getMatrix4Kernels();
+
+/**
+ * Return the portable C++ routines.
+ */
+const Matrix4Kernels &getScalarMatrix4Kernels();
+
+#ifdef SCUMMVM_SSE2
+const Matrix4Kernels &getSSE2Matrix4Kernels();
+#endif
+
+} // End of namespace Math
+
+#endif
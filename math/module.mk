@@ -17,5 +17,12 @@ MODULE_OBJS := \
 	vector3d.o \
 	vector4d.o
 
+ifdef SCUMMVM_SSE2
+MODULE_OBJS += \
+	matrix4-sse2.o
+
+$(MODULE)/matrix4-sse2.o: CXXFLAGS += -msse2
+endif
+
 # Include common rules
 include $(srcdir)/rules.mk
@@ -0,0 +1,246 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/adpcm_intern.h"
+
+#include "common/array.h"
+#include "common/endian.h"
+#include "common/memstream.h"
+#include "../test_random.h"
+
+class ADPCMTestSuite : public CxxTest::TestSuite
+{
+private:
+	struct IMAState {
+		int32 last;
+		int32 stepIndex;
+	};
+
+	struct MSState {
+		int16 coeff1, coeff2;
+		int16 delta;
+		int16 sample1, sample2;
+	};
+
+	// Straightforward per-nibble decoders, to check the block decoders against
+	static int16 decodeIMA(IMAState &s, byte code) {
+		int32 E = (2 * (code & 0x7) + 1) * Audio::Ima_ADPCMStream::_imaTable[s.stepIndex] / 8;
+		int32 diff = (code & 0x08) ? -E : E;
+		s.last = CLIP<int32>(s.last + diff, -32768, 32767);
+		s.stepIndex = CLIP<int32>(s.stepIndex + Audio::ADPCMStream::_stepAdjustTable[code], 0, 88);
+		return s.last;
+	}
+
+	static int16 decodeMS(MSState &s, byte code) {
+		static const int adaptationTable[] = {
+			230, 230, 230, 230, 307, 409, 512, 614,
+			768, 614, 512, 409, 307, 230, 230, 230
+		};
+
+		int32 predictor = (s.sample1 * s.coeff1 + s.sample2 * s.coeff2) / 256;
+		predictor += ((code & 0x08) ? (code - 0x10) : code) * s.delta;
+		predictor = CLIP<int32>(predictor, -32768, 32767);
+
+		s.sample2 = s.sample1;
+		s.sample1 = predictor;
+		s.delta = (adaptationTable[code] * s.delta) >> 8;
+		if (s.delta < 16)
+			s.delta = 16;
+		return predictor;
+	}
+
+	static byte *createData(uint32 size) {
+		byte *data = (byte *)malloc(size);
+		TestRandom rnd(0x12345678);
+		for (uint32 i = 0; i < size; i++)
+			data[i] = rnd.next();
+		return data;
+	}
+
+	// Decode the whole stream, with reads of the given size
+	static Common::Array<int16> readStream(Audio::RewindableAudioStream *stream, int chunkSize) {
+		Common::Array<int16> result;
+		int16 *buffer = new int16[chunkSize];
+
+		while (!stream->endOfData()) {
+			const int samples = stream->readBuffer(buffer, chunkSize);
+			if (samples <= 0)
+				break;
+			for (int i = 0; i < samples; i++)
+				result.push_back(buffer[i]);
+		}
+
+		delete[] buffer;
+		return result;
+	}
+
+	void checkStream(Audio::ADPCMType type, byte *data, uint32 size, int channels, uint32 blockAlign, int chunkSize, const Common::Array<int16> &expected) {
+		Common::SeekableReadStream *memStream = new Common::MemoryReadStream(data, size, DisposeAfterUse::YES);
+		Audio::RewindableAudioStream *stream = Audio::makeADPCMStream(memStream, DisposeAfterUse::YES, size, type, 22050, channels, blockAlign);
+
+		Common::Array<int16> decoded = readStream(stream, chunkSize);
+		TS_ASSERT_EQUALS(decoded.size(), expected.size());
+		TS_ASSERT(decoded == expected);
+
+		// Decoding again after rewinding gives the same result
+		TS_ASSERT(stream->rewind());
+		decoded = readStream(stream, chunkSize);
+		TS_ASSERT(decoded == expected);
+
+		delete stream;
+	}
+
+	void msImaTest(int channels) {
+		const uint32 blockAlign = 256;
+		const uint32 size = blockAlign * 3;
+		byte *data = createData(size);
+
+		Common::Array<int16> expected;
+		for (uint32 block = 0; block < size; block += blockAlign) {
+			IMAState state[2];
+			for (int i = 0; i < channels; i++) {
+				byte *header = data + block + i * 4;
+				header[2] %= 89;
+				header[3] = 0;
+				state[i].last = (int16)READ_LE_UINT16(header);
+				state[i].stepIndex = header[2];
+			}
+
+			int16 group[2][8];
+			for (uint32 pos = block + channels * 4; pos < block + blockAlign; pos += channels * 4) {
+				for (int i = 0; i < channels; i++) {
+					for (int j = 0; j < 4; j++) {
+						const byte code = data[pos + i * 4 + j];
+						group[i][j * 2] = decodeIMA(state[i], code & 0x0f);
+						group[i][j * 2 + 1] = decodeIMA(state[i], code >> 4);
+					}
+				}
+
+				for (int j = 0; j < 8; j++)
+					for (int i = 0; i < channels; i++)
+						expected.push_back(group[i][j]);
+			}
+		}
+
+		checkStream(Audio::kADPCMMSIma, data, size, channels, blockAlign, 6 * channels, expected);
+	}
+
+	void dviTest(int channels) {
+		const uint32 size = 1001;
+		byte *data = createData(size);
+
+		Common::Array<int16> expected;
+		IMAState state[2] = { { 0, 0 }, { 0, 0 } };
+		for (uint32 i = 0; i < size; i++) {
+			expected.push_back(decodeIMA(state[0], data[i] >> 4));
+			expected.push_back(decodeIMA(state[channels - 1], data[i] & 0x0f));
+		}
+
+		checkStream(Audio::kADPCMDVI, data, size, channels, 0, 7, expected);
+	}
+
+	void msTest(int channels) {
+		static const int coeff1[] = { 256, 512, 0, 192, 240, 460, 392 };
+		static const int coeff2[] = { 0, -256, 0, 64, 0, -208, -232 };
+
+		const uint32 blockAlign = 128;
+		const uint32 size = blockAlign * 3 + 50;
+		byte *data = createData(size);
+
+		Common::Array<int16> expected;
+		for (uint32 block = 0; block < size; block += blockAlign) {
+			const uint32 blockEnd = MIN(block + blockAlign, size);
+
+			MSState state[2];
+			byte *header = data + block;
+			for (int i = 0; i < channels; i++) {
+				header[i] %= 7;
+				state[i].coeff1 = coeff1[header[i]];
+				state[i].coeff2 = coeff2[header[i]];
+				header[channels + i * 2 + 1] &= 0x03;
+				state[i].delta = (int16)READ_LE_UINT16(header + channels + i * 2);
+				state[i].sample1 = (int16)READ_LE_UINT16(header + channels * 3 + i * 2);
+				state[i].sample2 = (int16)READ_LE_UINT16(header + channels * 5 + i * 2);
+			}
+
+			for (int i = 0; i < channels; i++)
+				expected.push_back(state[i].sample2);
+			for (int i = 0; i < channels; i++)
+				expected.push_back(state[i].sample1);
+
+			for (uint32 pos = block + channels * 7; pos < blockEnd; pos++) {
+				expected.push_back(decodeMS(state[0], data[pos] >> 4));
+				expected.push_back(decodeMS(state[channels - 1], data[pos] & 0x0f));
+			}
+		}
+
+		checkStream(Audio::kADPCMMS, data, size, channels, blockAlign, 5 * channels, expected);
+	}
+
+public:
+	void test_ms_ima_mono() {
+		msImaTest(1);
+	}
+
+	void test_ms_ima_stereo() {
+		msImaTest(2);
+	}
+
+	void test_dvi_mono() {
+		dviTest(1);
+	}
+
+	void test_dvi_stereo() {
+		dviTest(2);
+	}
+
+	void test_ms_mono() {
+		msTest(1);
+	}
+
+	void test_ms_stereo() {
+		msTest(2);
+	}
+
+	void test_dk3() {
+		// An odd number of bytes per block, so that every block ends with an
+		// alignment byte, and a truncated last block
+		const uint32 blockAlign = 101;
+		const uint32 size = blockAlign * 3 + 40;
+		byte *data = createData(size);
+
+		Common::Array<int16> expected;
+		for (uint32 block = 0; block < size; block += blockAlign) {
+			const uint32 blockEnd = MIN(block + blockAlign, size);
+
+			byte *header = data + block;
+			WRITE_LE_UINT16(header + 2, 22050);
+			header[14] %= 89;
+			header[15] %= 89;
+
+			IMAState sum = { (int16)READ_LE_UINT16(header + 10), header[14] };
+			IMAState diff = { (int16)READ_LE_UINT16(header + 12), header[15] };
+
+			const uint32 nibbles = (blockEnd - block - 16) * 2;
+			const byte *payload = header + 16;
+			for (uint32 n = 0; n + 3 <= nibbles; n += 3) {
+				const byte codes[3] = {
+					(byte)((payload[n / 2] >> ((n & 1) * 4)) & 0x0f),
+					(byte)((payload[(n + 1) / 2] >> (((n + 1) & 1) * 4)) & 0x0f),
+					(byte)((payload[(n + 2) / 2] >> (((n + 2) & 1) * 4)) & 0x0f)
+				};
+
+				decodeIMA(sum, codes[0]);
+				decodeIMA(diff, codes[1]);
+				expected.push_back(sum.last + diff.last);
+				expected.push_back(sum.last - diff.last);
+
+				decodeIMA(sum, codes[2]);
+				expected.push_back(sum.last + diff.last);
+				expected.push_back(sum.last - diff.last);
+			}
+		}
+
+		checkStream(Audio::kADPCMDK3, data, size, 2, blockAlign, 12, expected);
+	}
+};
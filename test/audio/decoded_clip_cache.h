@@ -0,0 +1,138 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/decoded_clip_cache.h"
+
+#include "helper.h"
+
+class DecodedClipCacheTestSuite : public CxxTest::TestSuite {
+	void checkStream(Audio::AudioStream *stream, const int16 *comp, int totalSamples) {
+		int16 buffer[1000];
+		int pos = 0;
+
+		while (!stream->endOfData()) {
+			const int len = stream->readBuffer(buffer, ARRAYSIZE(buffer));
+			TS_ASSERT_LESS_THAN_EQUALS(pos + len, totalSamples);
+			if (len <= 0 || pos + len > totalSamples)
+				break;
+
+			for (int i = 0; i < len; i++)
+				TS_ASSERT_EQUALS(buffer[i], comp[pos + i]);
+			pos += len;
+		}
+
+		TS_ASSERT_EQUALS(pos, totalSamples);
+	}
+
+public:
+	void test_store_and_find() {
+		const int rate = 11025;
+		int16 *comp;
+		Audio::DecodedClipCache cache;
+		const Audio::DecodedClipCache::Key key("sample.smp", 1234, 1);
+
+		TS_ASSERT(!cache.find(key));
+
+		Audio::RewindableAudioStream *stream = cache.store(key, createSineStream<int16>(rate, 1, &comp, false, true));
+		TS_ASSERT(stream->isStereo());
+		TS_ASSERT_EQUALS(stream->getRate(), rate);
+		TS_ASSERT_EQUALS(cache.getSize(), (uint32)(rate * 2 * sizeof(int16)));
+		checkStream(stream, comp, rate * 2);
+
+		// Rewinding and finding the clip again both play it from the start
+		TS_ASSERT(stream->rewind());
+		checkStream(stream, comp, rate * 2);
+		delete stream;
+
+		Audio::SeekableAudioStream *cached = cache.find(key);
+		TS_ASSERT(cached);
+		TS_ASSERT_EQUALS(cached->getLength().totalNumberOfFrames(), rate);
+		checkStream(cached, comp, rate * 2);
+		delete cached;
+
+		TS_ASSERT(!cache.find(Audio::DecodedClipCache::Key("sample.smp", 1234, 2)));
+		delete[] comp;
+	}
+
+	void test_too_long() {
+		const int rate = 11025;
+		int16 *comp;
+		Audio::DecodedClipCache cache(1024 * 1024, 1000);
+		const Audio::DecodedClipCache::Key key("sample.smp", 0);
+
+		// The clip is not cached, but the source stream is still usable
+		Audio::SeekableAudioStream *sine = createSineStream<int16>(rate, 1, &comp, false, false);
+		Audio::RewindableAudioStream *stream = cache.store(key, sine);
+		TS_ASSERT_EQUALS(stream, sine);
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		checkStream(stream, comp, rate);
+		TS_ASSERT(!cache.find(key));
+
+		delete stream;
+		delete[] comp;
+	}
+
+	void test_eviction() {
+		const int rate = 8000;
+		int16 *comp;
+		const uint32 clipSize = rate * sizeof(int16);
+		Audio::DecodedClipCache cache(clipSize * 2, clipSize);
+		const Audio::DecodedClipCache::Key key1("sample.smp", 1);
+		const Audio::DecodedClipCache::Key key2("sample.smp", 2);
+		const Audio::DecodedClipCache::Key key3("sample.smp", 3);
+
+		delete cache.store(key1, createSineStream<int16>(rate, 1, nullptr, false, false));
+		delete cache.store(key2, createSineStream<int16>(rate, 1, nullptr, false, false));
+
+		// Use the first clip, so that the second one is the oldest
+		delete cache.find(key1);
+		delete cache.store(key3, createSineStream<int16>(rate, 1, nullptr, false, false));
+		TS_ASSERT_EQUALS(cache.getSize(), clipSize * 2);
+
+		Audio::SeekableAudioStream *stream = cache.find(key1);
+		TS_ASSERT(stream);
+		delete stream;
+		TS_ASSERT(!cache.find(key2));
+
+		// Clips which are playing are not evicted, and stay valid after clearing
+		Audio::SeekableAudioStream *playing = cache.find(key3);
+		TS_ASSERT(playing);
+		delete cache.store(key2, createSineStream<int16>(rate, 1, &comp, false, false));
+		TS_ASSERT(!cache.find(key1));
+		cache.clear();
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+		TS_ASSERT(!cache.find(key3));
+		checkStream(playing, comp, rate);
+		delete playing;
+
+		delete[] comp;
+	}
+
+	void test_output_rate() {
+		const int rate = 11025;
+		Audio::DecodedClipCache cache;
+		const Audio::DecodedClipCache::Key key("sample.smp", 0);
+
+		cache.setOutputRate(rate * 2);
+
+		// The clip is stored at the output rate, and stays mono
+		Audio::RewindableAudioStream *stream = cache.store(key, createSineStream<int16>(rate, 1, nullptr, false, false));
+		TS_ASSERT_EQUALS(stream->getRate(), rate * 2);
+		TS_ASSERT(!stream->isStereo());
+		delete stream;
+
+		Audio::SeekableAudioStream *cached = cache.find(key);
+		TS_ASSERT(cached);
+		TS_ASSERT_EQUALS(cached->getRate(), rate * 2);
+
+		// The polyphase filter may drop the last few frames
+		const int frames = cached->getLength().totalNumberOfFrames();
+		TS_ASSERT_LESS_THAN_EQUALS(rate * 2 - 64, frames);
+		TS_ASSERT_LESS_THAN_EQUALS(frames, rate * 2);
+		delete cached;
+
+		// Changing the rate drops the clips resampled before
+		cache.setOutputRate(rate * 4);
+		TS_ASSERT(!cache.find(key));
+		TS_ASSERT_EQUALS(cache.getSize(), 0u);
+	}
+};
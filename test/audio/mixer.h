@@ -0,0 +1,77 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer_intern.h"
+
+#include "helper.h"
+
+class MixerTestSuite : public CxxTest::TestSuite {
+	static Audio::AudioStream *createConstantStream(int16 value) {
+		const int samples = 4096;
+		int16 *data = (int16 *)malloc(samples * sizeof(int16));
+		for (int i = 0; i < samples; i++)
+			WRITE_LE_UINT16(&data[i], value);
+		return Audio::makeRawStream((const byte *)data, samples * sizeof(int16), 22050, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN);
+	}
+
+	static int16 mixOverlapping(bool headroom) {
+		Audio::MixerImpl mixer(22050);
+		Audio::Mixer &base = mixer;
+		mixer.setReady(true);
+		mixer.setHeadroomMixing(headroom);
+
+		Audio::SoundHandle handle;
+		base.playStream(Audio::Mixer::kPlainSoundType, &handle, createConstantStream(20000));
+		base.playStream(Audio::Mixer::kPlainSoundType, &handle, createConstantStream(20000));
+		base.playStream(Audio::Mixer::kPlainSoundType, &handle, createConstantStream(-20000));
+
+		int16 buffer[512];
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 256);
+		for (int i = 1; i < ARRAYSIZE(buffer); i++)
+			TS_ASSERT_EQUALS(buffer[i], buffer[0]);
+		return buffer[0];
+	}
+
+public:
+	void test_channel_settings() {
+		Audio::MixerImpl mixer(22050);
+		Audio::Mixer &base = mixer;
+		mixer.setReady(true);
+
+		Audio::SoundHandle handle;
+		base.playStream(Audio::Mixer::kSFXSoundType, &handle, createSineStream<int16>(22050, 1, nullptr, false, false), -1, 200, 10);
+
+		TS_ASSERT(mixer.isSoundHandleActive(handle));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 200);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), 10);
+
+		// Changes are visible right away, even before the callback ran
+		mixer.setChannelVolume(handle, 100);
+		mixer.setChannelBalance(handle, -20);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+		TS_ASSERT_EQUALS(mixer.getChannelBalance(handle), -20);
+
+		int16 buffer[512];
+		TS_ASSERT_EQUALS(mixer.mixCallback((byte *)buffer, sizeof(buffer)), 256);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 100);
+
+		mixer.stopHandle(handle);
+		TS_ASSERT(!mixer.isSoundHandleActive(handle));
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+
+		// Requests for stopped sounds are ignored
+		mixer.setChannelVolume(handle, 50);
+		TS_ASSERT_EQUALS(mixer.getChannelVolume(handle), 0);
+		TS_ASSERT(!mixer.isSoundHandleActive(Audio::SoundHandle()));
+	}
+
+	void test_headroom_mixing() {
+		// Saturating after each channel clips the first two, so the
+		// third one pulls the sum far down
+		TS_ASSERT_LESS_THAN(mixOverlapping(false), 15000);
+
+		// The bus keeps the full sum, so the result is a single channel
+		const int16 single = mixOverlapping(true);
+		TS_ASSERT_LESS_THAN(19000, single);
+		TS_ASSERT_LESS_THAN_EQUALS(single, 20000);
+	}
+};
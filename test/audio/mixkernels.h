@@ -0,0 +1,105 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer.h"
+#include "audio/mixkernels.h"
+#include "../test_random.h"
+
+class MixKernelsTestSuite : public CxxTest::TestSuite {
+	enum {
+		kFrames = 67
+	};
+
+	int16 _src[kFrames * 2];
+	int16 _expected[kFrames * 2];
+	int16 _actual[kFrames * 2];
+
+	void fill(uint32 seed) {
+		TestRandom rnd(seed);
+		for (int i = 0; i < kFrames * 2; i++) {
+			_src[i] = (int16)rnd.next();
+			_expected[i] = _actual[i] = (int16)rnd.next();
+		}
+
+		// Make sure the extremes and saturation get exercised
+		_src[0] = -32768;
+		_src[1] = 32767;
+		_expected[2] = _actual[2] = 32767;
+		_expected[3] = _actual[3] = -32768;
+	}
+
+	void check(Audio::MixFunc ref, Audio::MixFunc func, uint frames) {
+		static const int volumes[] = { 0, 1, 127, 128, 255, Audio::Mixer::kMaxMixerVolume };
+
+		for (int l = 0; l < ARRAYSIZE(volumes); l++) {
+			for (int r = 0; r < ARRAYSIZE(volumes); r++) {
+				fill(l * 31 + r);
+				ref(_expected, _src, frames, volumes[l], volumes[r]);
+				func(_actual, _src, frames, volumes[l], volumes[r]);
+
+				for (int i = 0; i < kFrames * 2; i++)
+					TS_ASSERT_EQUALS(_expected[i], _actual[i]);
+			}
+		}
+	}
+
+public:
+	void test_scalar() {
+		const Audio::MixKernels &scalar = Audio::getScalarMixKernels();
+
+		int16 src[2] = { 1000, -1000 };
+		int16 dst[4] = { 32000, -32000, 0, 0 };
+
+		scalar.mixMono(dst, src, 2, 256, 128);
+		TS_ASSERT_EQUALS(dst[0], 32767);
+		TS_ASSERT_EQUALS(dst[1], -31500);
+		TS_ASSERT_EQUALS(dst[2], -1000);
+		TS_ASSERT_EQUALS(dst[3], -500);
+
+		dst[0] = dst[1] = 0;
+		scalar.mixStereoReverse(dst, src, 1, 256, 1);
+		TS_ASSERT_EQUALS(dst[0], -3);
+		TS_ASSERT_EQUALS(dst[1], 1000);
+	}
+
+	void test_matches_scalar() {
+		const Audio::MixKernels &scalar = Audio::getScalarMixKernels();
+		const Audio::MixKernels &kernels = Audio::getMixKernels();
+
+		for (uint frames = kFrames - 8; frames <= kFrames; frames++) {
+			check(scalar.mixMono, kernels.mixMono, frames);
+			check(scalar.mixStereo, kernels.mixStereo, frames);
+			check(scalar.mixStereoReverse, kernels.mixStereoReverse, frames);
+		}
+	}
+
+	void test_bus_matches_scalar() {
+		const Audio::MixKernels &scalar = Audio::getScalarMixKernels();
+		const Audio::MixKernels &kernels = Audio::getMixKernels();
+
+		for (uint count = kFrames * 2 - 8; count <= kFrames * 2; count++) {
+			fill(count);
+
+			// Start from a bus which already holds overflowing sums
+			int32 expectedBus[kFrames * 2], actualBus[kFrames * 2];
+			for (int i = 0; i < kFrames * 2; i++)
+				expectedBus[i] = actualBus[i] = _expected[i] * 3;
+
+			scalar.accumulate(expectedBus, _src, count);
+			kernels.accumulate(actualBus, _src, count);
+			for (int i = 0; i < kFrames * 2; i++)
+				TS_ASSERT_EQUALS(expectedBus[i], actualBus[i]);
+
+			scalar.pack(_expected, expectedBus, count);
+			kernels.pack(_actual, actualBus, count);
+			for (int i = 0; i < kFrames * 2; i++)
+				TS_ASSERT_EQUALS(_expected[i], _actual[i]);
+		}
+
+		int32 bus[3] = { 40000, -40000, 1234 };
+		int16 out[3];
+		scalar.pack(out, bus, 3);
+		TS_ASSERT_EQUALS(out[0], 32767);
+		TS_ASSERT_EQUALS(out[1], -32768);
+		TS_ASSERT_EQUALS(out[2], 1234);
+	}
+};
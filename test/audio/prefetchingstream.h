@@ -0,0 +1,64 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/prefetchingstream.h"
+
+#include "helper.h"
+
+class PrefetchingAudioStreamTestSuite : public CxxTest::TestSuite {
+	void checkStream(Audio::AudioStream *stream, const int16 *comp, int totalSamples, int readSize) {
+		int16 *buffer = new int16[readSize];
+		int pos = 0;
+
+		while (!stream->endOfData()) {
+			const int len = stream->readBuffer(buffer, readSize);
+			TS_ASSERT_LESS_THAN_EQUALS(pos + len, totalSamples);
+			if (pos + len > totalSamples)
+				break;
+
+			// Only the last read may come up short
+			if (pos + len < totalSamples)
+				TS_ASSERT_EQUALS(len, readSize);
+
+			for (int i = 0; i < len; i++)
+				TS_ASSERT_EQUALS(buffer[i], comp[pos + i]);
+			pos += len;
+		}
+
+		TS_ASSERT_EQUALS(pos, totalSamples);
+		delete[] buffer;
+	}
+
+public:
+	void test_read() {
+		const int rate = 11025;
+		int16 *comp;
+		Audio::SeekableAudioStream *sine = createSineStream<int16>(rate, 2, &comp, false, true);
+
+		// Use a buffer which is not a multiple of the chunk size
+		Audio::PrefetchingAudioStream *stream = new Audio::PrefetchingAudioStream(sine, DisposeAfterUse::YES, 300);
+		TS_ASSERT(stream->isStereo());
+		TS_ASSERT_EQUALS(stream->getRate(), rate);
+
+		checkStream(stream, comp, rate * 2 * 2, 1000);
+		TS_ASSERT(stream->endOfStream());
+
+		delete stream;
+		delete[] comp;
+	}
+
+	void test_rewind() {
+		const int rate = 11025;
+		int16 *comp;
+		Audio::SeekableAudioStream *sine = createSineStream<int16>(rate, 1, &comp, false, false);
+		Audio::PrefetchingAudioStream *stream = new Audio::PrefetchingAudioStream(sine, DisposeAfterUse::YES, 100);
+
+		int16 buffer[777];
+		stream->readBuffer(buffer, ARRAYSIZE(buffer));
+
+		TS_ASSERT(stream->rewind());
+		checkStream(stream, comp, rate, 4096);
+
+		delete stream;
+		delete[] comp;
+	}
+};
@@ -0,0 +1,93 @@
+#include <cxxtest/TestSuite.h>
+
+#include "audio/mixer.h"
+#include "audio/rate.h"
+
+#include "helper.h"
+
+class RateConverterTestSuite : public CxxTest::TestSuite {
+	Audio::SeekableAudioStream *createConstantStream(int16 value, int rate, int frames, bool stereo) {
+		const int samples = frames * (stereo ? 2 : 1);
+		int16 *data = (int16 *)malloc(samples * sizeof(int16));
+		for (int i = 0; i < samples; i++)
+			WRITE_LE_INT16(&data[i], value);
+
+		Common::SeekableReadStream *stream = new Common::MemoryReadStream((const byte *)data, samples * sizeof(int16), DisposeAfterUse::YES);
+		return Audio::makeRawStream(stream, rate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN | (stereo ? Audio::FLAG_STEREO : 0));
+	}
+
+	int convert(Audio::AudioStream *stream, Audio::RateConverter *converter, int16 *out, int frames) {
+		memset(out, 0, frames * 2 * sizeof(int16));
+
+		int total = 0;
+		while (total < frames) {
+			const int len = converter->flow(*stream, out + total * 2, MIN(frames - total, 1000), Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+			if (len <= 0)
+				break;
+			total += len;
+		}
+		return total;
+	}
+
+	void checkConstant(int inRate, int outRate, bool stereo) {
+		const int16 value = 10000;
+		const int outFrames = outRate;
+
+		Audio::SeekableAudioStream *stream = createConstantStream(value, inRate, inRate, stereo);
+		Audio::RateConverter *converter = Audio::makeRateConverter(inRate, outRate, stereo, false, Audio::kRateConverterPolyphase);
+		int16 *out = new int16[outFrames * 2];
+
+		const int len = convert(stream, converter, out, outFrames);
+
+		// The filter delays the signal by a few frames at most
+		TS_ASSERT_LESS_THAN_EQUALS(outFrames - 64, len);
+		TS_ASSERT_LESS_THAN_EQUALS(len, outFrames);
+
+		// Skip the filter warm-up, after which the signal should come
+		// through unchanged
+		for (int i = 64; i < len - 64; i++) {
+			TS_ASSERT_DELTA(out[i * 2 + 0], value, 4);
+			TS_ASSERT_DELTA(out[i * 2 + 1], value, 4);
+		}
+
+		delete[] out;
+		delete converter;
+		delete stream;
+	}
+
+public:
+	void test_quality_names() {
+		TS_ASSERT_EQUALS(Audio::parseRateConverterQuality("fast"), Audio::kRateConverterFast);
+		TS_ASSERT_EQUALS(Audio::parseRateConverterQuality("Linear"), Audio::kRateConverterLinear);
+		TS_ASSERT_EQUALS(Audio::parseRateConverterQuality("polyphase"), Audio::kRateConverterPolyphase);
+		TS_ASSERT_EQUALS(Audio::parseRateConverterQuality(""), Audio::kRateConverterFast);
+	}
+
+	void test_polyphase_upsample() {
+		checkConstant(11025, 48000, false);
+		checkConstant(22050, 44100, true);
+	}
+
+	void test_polyphase_downsample() {
+		checkConstant(44100, 22050, false);
+		checkConstant(48000, 11025, true);
+	}
+
+	void test_polyphase_sine() {
+		int16 *comp;
+		Audio::SeekableAudioStream *stream = createSineStream<int16>(22050, 1, &comp, false, false);
+		Audio::RateConverter *converter = Audio::makeRateConverter(22050, 44100, false, false, Audio::kRateConverterPolyphase);
+		int16 *out = new int16[44100 * 2];
+
+		const int len = convert(stream, converter, out, 44100);
+
+		// Every other output frame lines up with an input frame
+		for (int i = 64; i < len - 64; i += 2)
+			TS_ASSERT_DELTA(out[i * 2], comp[i / 2], 64);
+
+		delete[] out;
+		delete converter;
+		delete stream;
+		delete[] comp;
+	}
+};
@@ -0,0 +1,678 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+#include "test/test_random.h"
+
+#include "common/endian.h"
+#include "common/fft.h"
+#include "common/memstream.h"
+#include "common/rdft.h"
+
+#include "audio/audiostream.h"
+#include "audio/mixer.h"
+#include "audio/mixer_intern.h"
+#include "audio/rate.h"
+#include "audio/decoders/adpcm.h"
+#include "audio/decoders/raw.h"
+#include "audio/mods/paula.h"
+#include "audio/softsynth/opl/dbopl.h"
+#include "audio/softsynth/opl/mame.h"
+#include "audio/softsynth/opl/nuked.h"
+#include "audio/softsynth/sid.h"
+#include "audio/softsynth/fmtowns_pc98/towns_pc98_fmsynth.h"
+
+namespace Benchmark {
+
+namespace {
+
+struct RateBenchmark {
+	Common::Array<int16> input;
+	Common::Array<Audio::st_sample_t> output;
+	int inputRate;
+	int outputRate;
+	bool stereo;
+	Audio::RateConverterQuality quality;
+};
+
+void convertRate(void *data) {
+	RateBenchmark &benchmark = *(RateBenchmark *)data;
+
+	Audio::SeekableAudioStream *stream = Audio::makeRawStream((const byte *)benchmark.input.data(), benchmark.input.size() * 2,
+	                                                          benchmark.inputRate, Audio::FLAG_16BITS | Audio::FLAG_LITTLE_ENDIAN |
+	                                                          (benchmark.stereo ? Audio::FLAG_STEREO : 0), DisposeAfterUse::NO);
+	Audio::RateConverter *converter = Audio::makeRateConverter(benchmark.inputRate, benchmark.outputRate, benchmark.stereo, false, benchmark.quality);
+
+	// The converter mixes into the output, so it has to be cleared
+	memset(benchmark.output.data(), 0, benchmark.output.size() * sizeof(Audio::st_sample_t));
+	converter->flow(*stream, benchmark.output.data(), benchmark.output.size() / 2, Audio::Mixer::kMaxMixerVolume, Audio::Mixer::kMaxMixerVolume);
+
+	delete converter;
+	delete stream;
+}
+
+enum {
+	/** Number of transforms in each iteration of the FFT benchmarks */
+	kTransforms = 64
+};
+
+struct FFTBenchmark {
+	int bits;
+	Common::Array<Common::Complex> input;
+	Common::Array<Common::Complex> data;
+};
+
+/** Permute and transform the same input again and again, as the decoders do for each block. */
+void runFFT(void *data) {
+	FFTBenchmark &benchmark = *(FFTBenchmark *)data;
+
+	Common::FFT fft(benchmark.bits, false);
+	for (int i = 0; i < kTransforms; i++) {
+		memcpy(benchmark.data.data(), benchmark.input.data(), benchmark.input.size() * sizeof(Common::Complex));
+		fft.permute(benchmark.data.data());
+		fft.calc(benchmark.data.data());
+	}
+}
+
+struct RDFTBenchmark {
+	int bits;
+	Common::RDFT::TransformType type;
+	Common::Array<float> input;
+	Common::Array<float> data;
+};
+
+void runRDFT(void *data) {
+	RDFTBenchmark &benchmark = *(RDFTBenchmark *)data;
+
+	Common::RDFT rdft(benchmark.bits, benchmark.type);
+	for (int i = 0; i < kTransforms; i++) {
+		memcpy(benchmark.data.data(), benchmark.input.data(), benchmark.input.size() * sizeof(float));
+		rdft.calc(benchmark.data.data());
+	}
+}
+
+/** Only create transforms, as WMA and Bink audio do for each of their block sizes. */
+void createTransforms(void *data) {
+	const int bits = *(const int *)data;
+
+	for (int i = 0; i < kTransforms; i++) {
+		Common::RDFT rdft(bits, Common::RDFT::DFT_R2C);
+	}
+}
+
+struct ADPCMBenchmark {
+	Audio::ADPCMType type;
+	int channels;
+	uint32 blockAlign;
+	Common::Array<byte> input;
+	Common::Array<int16> output;
+};
+
+/** Decode the whole input in reads of the size of the output, and return the number of samples. */
+uint decodeADPCMStream(ADPCMBenchmark &benchmark) {
+	Common::SeekableReadStream *input = new Common::MemoryReadStream(benchmark.input.data(), benchmark.input.size());
+	Audio::SeekableAudioStream *stream = Audio::makeADPCMStream(input, DisposeAfterUse::YES, benchmark.input.size(), benchmark.type,
+	                                                            22050, benchmark.channels, benchmark.blockAlign);
+
+	uint samples = 0;
+	int read;
+	while ((read = stream->readBuffer(benchmark.output.data(), benchmark.output.size())) > 0)
+		samples += read;
+
+	delete stream;
+	return samples;
+}
+
+void decodeADPCM(void *data) {
+	decodeADPCMStream(*(ADPCMBenchmark *)data);
+}
+
+enum {
+	kOPLRate = 44100,
+	/** Number of samples between two events of the OPL sequence */
+	kOPLTickSamples = 2205,
+	kOPLTicks = 40
+};
+
+/** Common interface of the OPL emulator cores, without the OPL class and its mixer. */
+class OPLChip {
+public:
+	virtual ~OPLChip() {}
+	virtual void writeReg(int reg, int val) = 0;
+	virtual void generate(int16 *buffer, int samples) = 0;
+};
+
+class MAMEChip : public OPLChip {
+public:
+	MAMEChip() : _opl(OPL::MAME::makeAdLibOPL(kOPLRate)) {}
+	~MAMEChip() override { OPL::MAME::OPLDestroy(_opl); }
+
+	void writeReg(int reg, int val) override { OPL::MAME::OPLWriteReg(_opl, reg, val); }
+	void generate(int16 *buffer, int samples) override { OPL::MAME::YM3812UpdateOne(_opl, buffer, samples); }
+
+private:
+	OPL::MAME::FM_OPL *_opl;
+};
+
+#ifndef DISABLE_DOSBOX_OPL
+class DOSBoxChip : public OPLChip {
+public:
+	DOSBoxChip() {
+		OPL::DOSBox::DBOPL::InitTables();
+		_chip.Setup(kOPLRate);
+	}
+
+	void writeReg(int reg, int val) override { _chip.WriteReg(reg, val); }
+
+	void generate(int16 *buffer, int samples) override {
+		int32 tempBuffer[512];
+		while (samples > 0) {
+			const int readSamples = MIN<int>(samples, ARRAYSIZE(tempBuffer));
+			_chip.GenerateBlock2(readSamples, tempBuffer);
+			for (int i = 0; i < readSamples; i++)
+				buffer[i] = tempBuffer[i];
+			buffer += readSamples;
+			samples -= readSamples;
+		}
+	}
+
+private:
+	OPL::DOSBox::DBOPL::Chip _chip;
+};
+#endif
+
+#ifndef DISABLE_NUKED_OPL
+class NukedChip : public OPLChip {
+public:
+	NukedChip() { OPL::NUKED::OPL3_Reset(&_chip, kOPLRate); }
+
+	void writeReg(int reg, int val) override { OPL::NUKED::OPL3_WriteReg(&_chip, reg, val); }
+
+	void generate(int16 *buffer, int samples) override {
+		// Nuked always produces stereo samples
+		int16 stereo[1024];
+		while (samples > 0) {
+			const int readSamples = MIN<int>(samples, ARRAYSIZE(stereo) / 2);
+			OPL::NUKED::OPL3_GenerateStream(&_chip, stereo, readSamples);
+			for (int i = 0; i < readSamples; i++)
+				buffer[i] = stereo[i * 2];
+			buffer += readSamples;
+			samples -= readSamples;
+		}
+	}
+
+private:
+	OPL::NUKED::opl3_chip _chip;
+};
+#endif
+
+struct OPLBenchmark {
+	OPLChip *(*create)();
+	Common::Array<int16> output;
+};
+
+template<class T>
+OPLChip *createOPLChip() {
+	return new T();
+}
+
+/**
+ * Play a fixed sequence of notes on all nine melodic channels, with a mix
+ * of FM and additive instruments, feedback, waveforms, envelopes, tremolo
+ * and vibrato.
+ */
+void renderOPL(void *data) {
+	OPLBenchmark &benchmark = *(OPLBenchmark *)data;
+	static const int operatorOffsets[9] = { 0x00, 0x01, 0x02, 0x08, 0x09, 0x0a, 0x10, 0x11, 0x12 };
+	static const int frequencies[8] = { 0x157, 0x16b, 0x181, 0x198, 0x1b0, 0x1ca, 0x1e5, 0x202 };
+
+	OPLChip *chip = benchmark.create();
+	chip->writeReg(0x01, 0x20);
+	for (int channel = 0; channel < 9; channel++) {
+		for (int op = 0; op < 2; op++) {
+			const int offset = operatorOffsets[channel] + op * 3;
+			chip->writeReg(0x20 + offset, (channel % 4 == 3 ? 0xc0 : 0x00) | (channel & 1 ? 0x20 : 0x00) | (op ? 0x01 : 0x02 + channel % 3));
+			chip->writeReg(0x40 + offset, op ? 0x00 : 0x10 + channel * 2);
+			chip->writeReg(0x60 + offset, 0xf2 - channel * 0x10);
+			chip->writeReg(0x80 + offset, 0x57 + (channel & 3));
+			chip->writeReg(0xe0 + offset, (channel + op) & 3);
+		}
+		chip->writeReg(0xc0 + channel, ((channel % 7) << 1) | (channel % 3 == 2));
+	}
+	// Deep tremolo and vibrato
+	chip->writeReg(0xbd, 0xc0);
+
+	int16 *buffer = benchmark.output.data();
+	for (int tick = 0; tick < kOPLTicks; tick++) {
+		// Start a new note and release an older one
+		const int channel = tick % 9;
+		const int frequency = frequencies[(tick * 3) % 8];
+		chip->writeReg(0xb0 + channel, 0x00);
+		chip->writeReg(0xa0 + channel, frequency & 0xff);
+		chip->writeReg(0xb0 + channel, 0x20 | ((2 + tick % 3) << 2) | (frequency >> 8));
+		chip->writeReg(0xb0 + (tick + 5) % 9, 0x10);
+
+		chip->generate(buffer, kOPLTickSamples);
+		buffer += kOPLTickSamples;
+	}
+
+	delete chip;
+}
+
+#ifndef DISABLE_SID
+enum {
+	kSIDRate = 44100,
+	kSIDClock = 985248,
+	/** PAL frame of 312 lines of 63 cycles, when the players update the chip */
+	kSIDFrameCycles = 312 * 63,
+	kSIDFrames = 100
+};
+
+struct SIDBenchmark {
+	Resid::sampling_method method;
+	Common::Array<int16> output;
+};
+
+/**
+ * Play a sawtooth, a pulse with pulse width modulation and a ring modulated
+ * triangle through the filter, changing the notes every few frames.
+ */
+void renderSID(void *data) {
+	SIDBenchmark &benchmark = *(SIDBenchmark *)data;
+	static const int frequencies[8] = { 0x1125, 0x1339, 0x1597, 0x16e3, 0x19b1, 0x1cd6, 0x205e, 0x224b };
+	static const int waveforms[3] = { 0x20, 0x40, 0x14 };
+
+	Resid::SID sid;
+	sid.set_sampling_parameters(kSIDClock, benchmark.method, kSIDRate);
+	sid.enable_filter(true);
+	sid.reset();
+
+	for (int voice = 0; voice < 3; voice++) {
+		sid.write(voice * 7 + 5, 0x09);
+		sid.write(voice * 7 + 6, 0xa8);
+	}
+	sid.write(0x15, 0x00);
+	sid.write(0x17, 0xf3);
+	sid.write(0x18, 0x1f);
+
+	int16 *buffer = benchmark.output.data();
+	int samplesLeft = benchmark.output.size();
+	for (int frame = 0; frame < kSIDFrames; frame++) {
+		if (frame % 6 == 0) {
+			for (int voice = 0; voice < 3; voice++) {
+				const int frequency = frequencies[(frame / 6 + voice * 3) % 8] >> voice;
+				sid.write(voice * 7 + 4, waveforms[voice]);
+				sid.write(voice * 7 + 0, frequency & 0xff);
+				sid.write(voice * 7 + 1, frequency >> 8);
+				sid.write(voice * 7 + 4, waveforms[voice] | 0x01);
+			}
+		}
+
+		const int pulseWidth = 0x400 + (frame * 0x40) % 0x800;
+		sid.write(0x09, pulseWidth & 0xff);
+		sid.write(0x0a, pulseWidth >> 8);
+		sid.write(0x16, 0x20 + frame % 0x40);
+
+		Resid::cycle_count cycles = kSIDFrameCycles;
+		while (cycles > 0 && samplesLeft > 0) {
+			const int samples = sid.updateClock(cycles, buffer, samplesLeft);
+			buffer += samples;
+			samplesLeft -= samples;
+		}
+	}
+}
+#endif
+
+enum {
+	kTownsRate = 44100,
+	/** Number of samples between two events of the FM-Towns sequence */
+	kTownsTickSamples = 2205,
+	kTownsTicks = 40
+};
+
+/** The FM synth without a driver; the sequence is written between the renders. */
+class TownsFMSynth : public TownsPC98_FmSynth {
+public:
+	TownsFMSynth(Audio::Mixer *mixer) : TownsPC98_FmSynth(mixer, kTypeTowns) {}
+
+protected:
+	void timerCallbackA() override {}
+	void timerCallbackB() override {}
+};
+
+struct TownsFMBenchmark {
+	Common::Array<int16> output;
+};
+
+/**
+ * Play notes on all six channels, each with a different algorithm, and keep
+ * about half of them sounding. One operator uses the SSG type envelope.
+ */
+void renderTownsFM(void *data) {
+	TownsFMBenchmark &benchmark = *(TownsFMBenchmark *)data;
+	static const int frequencies[8] = { 0x269, 0x28e, 0x2b5, 0x2de, 0x30a, 0x338, 0x369, 0x39d };
+
+	// The synth registers itself with the mixer, which never mixes anything
+	Audio::MixerImpl mixer(kTownsRate);
+	mixer.setReady(true);
+	TownsFMSynth synth(&mixer);
+	synth.init();
+
+	for (int channel = 0; channel < 6; channel++) {
+		const uint8 part = channel / 3;
+		const uint8 c = channel % 3;
+		for (int op = 0; op < 4; op++) {
+			const uint8 reg = op * 4 + c;
+			synth.writeReg(part, 0x30 + reg, 0x01 + op);
+			synth.writeReg(part, 0x40 + reg, op == 3 ? 0x04 : 0x20 + op * 4);
+			synth.writeReg(part, 0x50 + reg, 0x5f);
+			synth.writeReg(part, 0x60 + reg, 0x08);
+			synth.writeReg(part, 0x70 + reg, 0x04);
+			synth.writeReg(part, 0x80 + reg, 0x37);
+		}
+		synth.writeReg(part, 0xb0 + c, 0x38 | (channel == 5 ? 7 : channel));
+		synth.writeReg(part, 0xb4 + c, 0xc0);
+	}
+	synth.writeReg(0, 0x94, 0x0a);
+
+	int16 *buffer = benchmark.output.data();
+	for (int tick = 0; tick < kTownsTicks; tick++) {
+		// Start a new note and release an older one
+		const int channel = tick % 6;
+		const uint8 keyChannel = (channel / 3) * 4 + channel % 3;
+		const int frequency = frequencies[(tick * 3) % 8] | ((3 + tick % 3) << 11);
+		synth.writeReg(0, 0x28, keyChannel);
+		synth.writeReg(channel / 3, 0xa4 + channel % 3, frequency >> 8);
+		synth.writeReg(channel / 3, 0xa0 + channel % 3, frequency & 0xff);
+		synth.writeReg(0, 0x28, 0xf0 | keyChannel);
+		const int released = (tick + 3) % 6;
+		synth.writeReg(0, 0x28, (released / 3) * 4 + released % 3);
+
+		synth.readBuffer(buffer, kTownsTickSamples * 2);
+		buffer += kTownsTickSamples * 2;
+	}
+}
+
+enum {
+	kPaulaRate = 44100,
+	/** Number of interrupts per second, as with a player on the vertical blank */
+	kPaulaInterruptFreq = 50,
+	kPaulaSampleLength = 256
+};
+
+/** Four looped voices, whose periods and volumes the interrupt changes. */
+class PaulaPlayer : public Audio::Paula {
+public:
+	PaulaPlayer(FilterMode filterMode) : Paula(true, kPaulaRate, kPaulaRate / kPaulaInterruptFreq, filterMode), _tick(0) {
+		for (int i = 0; i < kPaulaSampleLength; i++)
+			_sample[i] = (int8)((i * 7) & 0xff) / 2 + ((i & 16) ? 40 : -40);
+
+		for (int voice = 0; voice < NUM_VOICES; voice++) {
+			setChannelData(voice, _sample, _sample, kPaulaSampleLength, kPaulaSampleLength);
+			setChannelVolume(voice, 64);
+		}
+		interrupt();
+		startPaula();
+	}
+
+protected:
+	void interrupt() override {
+		static const int16 periods[8] = { 428, 404, 381, 360, 339, 320, 302, 285 };
+
+		for (int voice = 0; voice < NUM_VOICES; voice++) {
+			setChannelPeriod(voice, periods[(_tick / 3 + voice * 2) % 8] >> (voice & 1));
+			setChannelVolume(voice, 32 + (_tick + voice * 8) % 32);
+		}
+		_tick++;
+	}
+
+private:
+	int8 _sample[kPaulaSampleLength];
+	int _tick;
+};
+
+struct PaulaBenchmark {
+	Audio::Paula::FilterMode filterMode;
+	Common::Array<int16> output;
+};
+
+void renderPaula(void *data) {
+	PaulaBenchmark &benchmark = *(PaulaBenchmark *)data;
+
+	PaulaPlayer player(benchmark.filterMode);
+	player.readBuffer(benchmark.output.data(), benchmark.output.size());
+}
+
+} // End of anonymous namespace
+
+void runAudioBenchmarks(Runner &runner) {
+	static const struct {
+		Audio::RateConverterQuality quality;
+		const char *name;
+	} qualities[] = {
+		{ Audio::kRateConverterFast, "fast" },
+		{ Audio::kRateConverterLinear, "linear" },
+		{ Audio::kRateConverterPolyphase, "polyphase" }
+	};
+	static const int rates[][2] = {
+		{ 44100, 44100 },
+		{ 22050, 44100 },
+		{ 11025, 48000 },
+		{ 44100, 48000 },
+		{ 48000, 44100 }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(qualities); i++) {
+		for (int j = 0; j < ARRAYSIZE(rates); j++) {
+			for (int stereo = 0; stereo < 2; stereo++) {
+				const Common::String name = Common::String::format("audio/rate/%s/%d-%d/%s", qualities[i].name,
+				                                                   rates[j][0], rates[j][1], stereo ? "stereo" : "mono");
+				if (!runner.isSelected(name))
+					continue;
+
+				// Convert one second of a synthetic signal
+				RateBenchmark benchmark;
+				benchmark.inputRate = rates[j][0];
+				benchmark.outputRate = rates[j][1];
+				benchmark.stereo = stereo;
+				benchmark.quality = qualities[i].quality;
+				benchmark.input.resize(benchmark.inputRate * (stereo ? 2 : 1));
+				for (uint k = 0; k < benchmark.input.size(); k++)
+					benchmark.input[k] = TO_LE_16((uint16)(k * 7919));
+				benchmark.output.resize(benchmark.outputRate * 2);
+
+				runner.measure(name, benchmark.inputRate, "samples", convertRate, &benchmark);
+			}
+		}
+	}
+
+	static const struct {
+		Audio::ADPCMType type;
+		int channels;
+		const char *name;
+	} adpcmTypes[] = {
+		{ Audio::kADPCMMSIma, 1, "ms-ima/mono" },
+		{ Audio::kADPCMMSIma, 2, "ms-ima/stereo" },
+		{ Audio::kADPCMMS, 1, "ms/mono" },
+		{ Audio::kADPCMMS, 2, "ms/stereo" },
+		{ Audio::kADPCMDVI, 2, "dvi/stereo" },
+		{ Audio::kADPCMDK3, 2, "dk3/stereo" }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(adpcmTypes); i++) {
+		const Common::String name = Common::String::format("audio/adpcm/%s", adpcmTypes[i].name);
+		if (!runner.isSelected(name))
+			continue;
+
+		// 32 blocks of pseudo-random data, with headers the decoders accept
+		ADPCMBenchmark benchmark;
+		benchmark.type = adpcmTypes[i].type;
+		benchmark.channels = adpcmTypes[i].channels;
+		benchmark.blockAlign = adpcmTypes[i].type == Audio::kADPCMDVI ? 0 : 2048;
+		benchmark.input.resize(32 * 2048);
+		TestRandom rnd(0x12345678);
+		for (uint j = 0; j < benchmark.input.size(); j++)
+			benchmark.input[j] = rnd.next();
+
+		for (uint block = 0; benchmark.blockAlign && block < benchmark.input.size(); block += benchmark.blockAlign) {
+			byte *header = benchmark.input.data() + block;
+			for (int channel = 0; channel < benchmark.channels; channel++) {
+				if (benchmark.type == Audio::kADPCMMSIma) {
+					header[channel * 4 + 2] %= 89;
+					header[channel * 4 + 3] = 0;
+				} else if (benchmark.type == Audio::kADPCMMS) {
+					header[channel] %= 7;
+					header[benchmark.channels + channel * 2 + 1] &= 0x03;
+				}
+			}
+			if (benchmark.type == Audio::kADPCMDK3) {
+				WRITE_LE_UINT16(header + 2, 22050);
+				header[14] %= 89;
+				header[15] %= 89;
+			}
+		}
+
+		benchmark.output.resize(2048);
+		runner.measure(name, decodeADPCMStream(benchmark), "samples", decodeADPCM, &benchmark);
+	}
+
+	static const int fftBits[] = { 8, 10, 12 };
+
+	for (int i = 0; i < ARRAYSIZE(fftBits); i++) {
+		const Common::String name = Common::String::format("audio/fft/%d", 1 << fftBits[i]);
+		if (!runner.isSelected(name))
+			continue;
+
+		FFTBenchmark benchmark;
+		benchmark.bits = fftBits[i];
+		benchmark.input.resize(1 << fftBits[i]);
+		for (uint j = 0; j < benchmark.input.size(); j++) {
+			benchmark.input[j].re = (float)((j * 7919) % 2001) / 1000.0f - 1.0f;
+			benchmark.input[j].im = (float)((j * 104729) % 2001) / 1000.0f - 1.0f;
+		}
+		benchmark.data.resize(benchmark.input.size());
+		runner.measure(name, kTransforms * benchmark.input.size(), "samples", runFFT, &benchmark);
+	}
+
+	static const struct {
+		Common::RDFT::TransformType type;
+		const char *name;
+	} rdftTypes[] = {
+		{ Common::RDFT::DFT_R2C, "r2c" },
+		{ Common::RDFT::IDFT_C2R, "c2r" }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(rdftTypes); i++) {
+		for (int j = 0; j < ARRAYSIZE(fftBits); j++) {
+			const Common::String name = Common::String::format("audio/rdft/%s/%d", rdftTypes[i].name, 1 << fftBits[j]);
+			if (!runner.isSelected(name))
+				continue;
+
+			RDFTBenchmark benchmark;
+			benchmark.bits = fftBits[j];
+			benchmark.type = rdftTypes[i].type;
+			benchmark.input.resize(1 << fftBits[j]);
+			for (uint k = 0; k < benchmark.input.size(); k++)
+				benchmark.input[k] = (float)((k * 7919) % 2001) / 1000.0f - 1.0f;
+			benchmark.data.resize(benchmark.input.size());
+			runner.measure(name, kTransforms * benchmark.input.size(), "samples", runRDFT, &benchmark);
+		}
+	}
+
+	if (runner.isSelected("audio/rdft/create")) {
+		int bits = 11;
+		runner.measure("audio/rdft/create", kTransforms, "transforms", createTransforms, &bits);
+	}
+
+	static const struct {
+		OPLChip *(*create)();
+		const char *name;
+	} oplChips[] = {
+		{ createOPLChip<MAMEChip>, "mame" },
+#ifndef DISABLE_DOSBOX_OPL
+		{ createOPLChip<DOSBoxChip>, "dosbox" },
+#endif
+#ifndef DISABLE_NUKED_OPL
+		{ createOPLChip<NukedChip>, "nuked" }
+#endif
+	};
+
+	for (int i = 0; i < ARRAYSIZE(oplChips); i++) {
+		const Common::String name = Common::String::format("audio/opl/%s", oplChips[i].name);
+		if (!runner.isSelected(name))
+			continue;
+
+		OPLBenchmark benchmark;
+		benchmark.create = oplChips[i].create;
+		benchmark.output.resize(kOPLTicks * kOPLTickSamples);
+		runner.measure(name, benchmark.output.size(), "samples", renderOPL, &benchmark);
+	}
+
+#ifndef DISABLE_SID
+	static const struct {
+		Resid::sampling_method method;
+		const char *name;
+	} sidMethods[] = {
+		{ Resid::SAMPLE_FAST, "fast" },
+		{ Resid::SAMPLE_INTERPOLATE, "interpolate" }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(sidMethods); i++) {
+		const Common::String name = Common::String::format("audio/sid/%s", sidMethods[i].name);
+		if (!runner.isSelected(name))
+			continue;
+
+		// The samples of all frames, rounded up
+		SIDBenchmark benchmark;
+		benchmark.method = sidMethods[i].method;
+		benchmark.output.resize((int64)kSIDFrames * kSIDFrameCycles * kSIDRate / kSIDClock + 1);
+		runner.measure(name, benchmark.output.size(), "samples", renderSID, &benchmark);
+	}
+#endif
+
+	if (runner.isSelected("audio/towns/fm")) {
+		TownsFMBenchmark benchmark;
+		benchmark.output.resize(kTownsTicks * kTownsTickSamples * 2);
+		runner.measure("audio/towns/fm", kTownsTicks * kTownsTickSamples, "samples", renderTownsFM, &benchmark);
+	}
+
+	static const struct {
+		Audio::Paula::FilterMode mode;
+		const char *name;
+	} paulaFilters[] = {
+		{ Audio::Paula::kFilterModeNone, "none" },
+		{ Audio::Paula::kFilterModeA1200, "a1200" }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(paulaFilters); i++) {
+		const Common::String name = Common::String::format("audio/paula/%s", paulaFilters[i].name);
+		if (!runner.isSelected(name))
+			continue;
+
+		// One second of stereo output
+		PaulaBenchmark benchmark;
+		benchmark.filterMode = paulaFilters[i].mode;
+		benchmark.output.resize(kPaulaRate * 2);
+		runner.measure(name, kPaulaRate, "samples", renderPaula, &benchmark);
+	}
+}
+
+} // End of namespace Benchmark
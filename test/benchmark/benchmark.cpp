@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+// The results are written to stdout
+#define FORBIDDEN_SYMBOL_EXCEPTION_FILE
+#define FORBIDDEN_SYMBOL_EXCEPTION_stdout
+#define FORBIDDEN_SYMBOL_EXCEPTION_stderr
+#define FORBIDDEN_SYMBOL_EXCEPTION_fputs
+
+#include <stdio.h>
+
+#include "test/benchmark/benchmark.h"
+#include "test/null_osystem.h"
+
+#include "common/file.h"
+#include "common/system.h"
+
+namespace Benchmark {
+
+Runner::Runner(const Common::String &filter, uint minTime) : _filter(filter), _minTime((uint64)minTime * 1000) {
+}
+
+bool Runner::isSelected(const Common::String &name) const {
+	return _filter.empty() || name.contains(_filter);
+}
+
+void Runner::measure(const Common::String &name, uint64 units, const char *unit, BenchmarkProc proc, void *data) {
+	if (!isSelected(name))
+		return;
+
+	// Warm up the caches first
+	proc(data);
+
+	Result result;
+	result.name = name;
+	result.iterations = 0;
+	result.units = units;
+	result.unit = unit;
+
+	const uint64 start = g_system->getMicros();
+	do {
+		proc(data);
+		result.iterations++;
+		result.totalTime = g_system->getMicros() - start;
+	} while (result.totalTime < _minTime || result.iterations < 3);
+
+	_results.push_back(result);
+	fputs(Common::String::format("%-48s %10.3f us\n", name.c_str(), (double)result.totalTime / result.iterations).c_str(), stderr);
+}
+
+Common::String Runner::formatResults() const {
+	Common::String json = "{\n\t\"benchmarks\": [\n";
+	for (uint i = 0; i < _results.size(); i++) {
+		const Result &result = _results[i];
+		const double timePerIteration = (double)result.totalTime / result.iterations;
+		json += Common::String::format("\t\t{\"name\": \"%s\", \"iterations\": %u, \"us_per_iteration\": %.3f, \"%s\": %llu, \"%s_per_second\": %.0f}%s\n",
+		                               result.name.c_str(), result.iterations, timePerIteration,
+		                               result.unit, (unsigned long long)result.units,
+		                               result.unit, result.units * 1000000.0 / timePerIteration,
+		                               i + 1 < _results.size() ? "," : "");
+	}
+	json += "\t]\n}\n";
+	return json;
+}
+
+} // End of namespace Benchmark
+
+static void printUsage(const char *name) {
+	fputs(Common::String::format("Usage: %s [--filter=<text>] [--min-time=<ms>] [--output=<file>] [<image or video file>...]\n", name).c_str(), stderr);
+}
+
+int main(int argc, char *argv[]) {
+	Common::String filter;
+	Common::String output;
+	uint minTime = 200;
+	Common::StringArray files;
+
+	for (int i = 1; i < argc; i++) {
+		const Common::String arg(argv[i]);
+		if (arg.hasPrefix("--filter="))
+			filter = arg.substr(9);
+		else if (arg.hasPrefix("--min-time="))
+			minTime = atoi(arg.c_str() + 11);
+		else if (arg.hasPrefix("--output="))
+			output = arg.substr(9);
+		else if (arg.hasPrefix("--")) {
+			printUsage(argv[0]);
+			return 1;
+		} else
+			files.push_back(arg);
+	}
+
+	Common::install_null_g_system();
+
+	Benchmark::Runner runner(filter, minTime);
+	Benchmark::runAudioBenchmarks(runner);
+	Benchmark::runCompressionBenchmarks(runner);
+	Benchmark::runContainerBenchmarks(runner);
+	Benchmark::runScalerBenchmarks(runner);
+	Benchmark::runSerializerBenchmarks(runner);
+	Benchmark::runSurfaceBenchmarks(runner);
+	Benchmark::runImageBenchmarks(runner);
+	Benchmark::runFileBenchmarks(runner, files);
+
+	const Common::String results = runner.formatResults();
+	if (output.empty()) {
+		fputs(results.c_str(), stdout);
+	} else {
+		Common::DumpFile file;
+		if (!file.open(output)) {
+			fputs(Common::String::format("Can't open %s\n", output.c_str()).c_str(), stderr);
+			return 1;
+		}
+		file.writeString(results);
+	}
+
+	return 0;
+}
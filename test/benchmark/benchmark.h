@@ -0,0 +1,85 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef TEST_BENCHMARK_BENCHMARK_H
+#define TEST_BENCHMARK_BENCHMARK_H
+
+#include "common/array.h"
+#include "common/str.h"
+#include "common/str-array.h"
+
+namespace Benchmark {
+
+typedef void (*BenchmarkProc)(void *data);
+
+/**
+ * Times the benchmarks and collects their results.
+ */
+class Runner {
+public:
+	struct Result {
+		Common::String name;
+		uint iterations;
+		uint64 totalTime;   ///< in microseconds
+		uint64 units;       ///< units processed by each iteration
+		const char *unit;
+	};
+
+	Runner(const Common::String &filter, uint minTime);
+
+	/** Return whether the benchmark with the given name is to be run. */
+	bool isSelected(const Common::String &name) const;
+
+	/**
+	 * Call proc repeatedly, until it has been running for the minimum time,
+	 * and record how long each call took.
+	 *
+	 * @param units  The amount of work done by each call, for example the
+	 *               number of pixels or samples.
+	 * @param unit   The name of the units, in plural.
+	 */
+	void measure(const Common::String &name, uint64 units, const char *unit, BenchmarkProc proc, void *data);
+
+	const Common::Array<Result> &getResults() const { return _results; }
+
+	/** Return the results as JSON, for comparing them between builds. */
+	Common::String formatResults() const;
+
+private:
+	Common::String _filter;
+	uint64 _minTime;
+	Common::Array<Result> _results;
+};
+
+void runAudioBenchmarks(Runner &runner);
+void runCompressionBenchmarks(Runner &runner);
+void runContainerBenchmarks(Runner &runner);
+void runScalerBenchmarks(Runner &runner);
+void runSerializerBenchmarks(Runner &runner);
+void runSurfaceBenchmarks(Runner &runner);
+void runImageBenchmarks(Runner &runner);
+
+/** Decode the given image and video files, depending on their extensions. */
+void runFileBenchmarks(Runner &runner, const Common::StringArray &files);
+
+} // End of namespace Benchmark
+
+#endif
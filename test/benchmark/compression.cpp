@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "test/benchmark/benchmark.h"
+#include "test/test_random.h"
+
+#include "common/lzss.h"
+#include "common/memstream.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kSampleSize = 256 * 1024,
+	kLengthBits = 4,
+	kMinLength = 3,
+	kMaxLength = kMinLength + (1 << kLengthBits) - 1,
+	kWindowSize = 1 << (16 - kLengthBits)
+};
+
+struct LZSSBenchmark {
+	Common::Array<byte> packed;
+	Common::Array<byte> unpacked;
+};
+
+/**
+ * Compress the data greedily, looking for matches at the last position
+ * where the next three bytes were seen.
+ */
+void compressLZSS(const Common::Array<byte> &data, Common::Array<byte> &packed) {
+	Common::Array<int> lastPos(1 << 16, -kWindowSize);
+	uint pos = 0;
+
+	while (pos < data.size()) {
+		const uint flagPos = packed.size();
+		packed.push_back(0);
+
+		for (uint i = 0; i < 8 && pos < data.size(); i++) {
+			uint length = 0;
+			uint distance = 0;
+			if (pos + kMinLength <= data.size()) {
+				const uint hash = (data[pos] << 8 | data[pos + 1]) ^ (data[pos + 2] << 4);
+				const int match = lastPos[hash & 0xffff];
+				if ((int)pos - match < kWindowSize) {
+					while (length < kMaxLength && pos + length < data.size() && data[match + length] == data[pos + length])
+						length++;
+					distance = pos - match;
+				}
+				lastPos[hash & 0xffff] = pos;
+			}
+
+			if (length >= kMinLength) {
+				const uint16 reference = (distance << kLengthBits) | (length - kMinLength);
+				packed.push_back(reference & 0xff);
+				packed.push_back(reference >> 8);
+				pos += length;
+			} else {
+				packed[flagPos] |= 1 << i;
+				packed.push_back(data[pos++]);
+			}
+		}
+	}
+}
+
+void decompressLZSS(void *data) {
+	LZSSBenchmark &benchmark = *(LZSSBenchmark *)data;
+	Common::MemoryReadStream stream(benchmark.packed.data(), benchmark.packed.size());
+	const uint32 size = Common::decompressLZSS(&stream, benchmark.packed.size(), benchmark.unpacked.data(), benchmark.unpacked.size(), kLengthBits, kMinLength);
+	assert(size == benchmark.unpacked.size());
+	(void)size;
+}
+
+} // End of anonymous namespace
+
+void runCompressionBenchmarks(Runner &runner) {
+	if (!runner.isSelected("compression/lzss/decompress"))
+		return;
+
+	// Sample data resembling sprite sheets: runs of transparent pixels,
+	// repeated rows and some noise
+	Common::Array<byte> sample(kSampleSize);
+	TestRandom rnd(1);
+	for (uint i = 0; i < kSampleSize; i++) {
+		const uint noise = rnd.next() >> 28;
+		const uint x = i % 320;
+		const uint y = i / 320;
+		if (((x / 24) ^ (y / 16)) & 1)
+			sample[i] = 0;
+		else if ((y & 3) && i >= 320)
+			sample[i] = sample[i - 320];
+		else
+			sample[i] = (x + noise) & 0xff;
+	}
+
+	LZSSBenchmark benchmark;
+	compressLZSS(sample, benchmark.packed);
+	benchmark.unpacked.resize(kSampleSize);
+	runner.measure("compression/lzss/decompress", kSampleSize, "bytes", decompressLZSS, &benchmark);
+	assert(memcmp(benchmark.unpacked.data(), sample.data(), kSampleSize) == 0);
+}
+
+} // End of namespace Benchmark
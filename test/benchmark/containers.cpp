@@ -0,0 +1,136 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/arena.h"
+#include "common/hash-str.h"
+#include "common/hashmap.h"
+#include "common/list.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kEntryCount = 20000,
+	kInsertCount = 2000
+};
+
+/**
+ * An entry of a resource index, like the ones built when loading archives.
+ * The name does not fit in the internal storage of Common::String.
+ */
+struct IndexEntry {
+	Common::String name;
+	Common::Array<uint32> offsets;
+};
+
+IndexEntry makeEntry(uint i) {
+	IndexEntry entry;
+	entry.name = Common::String::format("Movies:Resources:cast%05u.dir", i);
+	for (uint j = 0; j < 4; j++)
+		entry.offsets.push_back(i * 4 + j);
+	return entry;
+}
+
+void buildStringArray(void *) {
+	Common::Array<Common::String> array;
+	for (uint i = 0; i < kEntryCount; i++)
+		array.push_back(Common::String::format("Movies:Resources:cast%05u.dir", i));
+	assert(array.size() == kEntryCount);
+}
+
+void buildEntryArray(void *) {
+	Common::Array<IndexEntry> array;
+	for (uint i = 0; i < kEntryCount; i++)
+		array.push_back(makeEntry(i));
+	assert(array.size() == kEntryCount);
+}
+
+void insertStringsAtFront(void *) {
+	Common::Array<Common::String> array;
+	for (uint i = 0; i < kInsertCount; i++)
+		array.insert_at(0, Common::String::format("Movies:Resources:cast%05u.dir", i));
+	assert(array.size() == kInsertCount);
+}
+
+void buildEntryList(void *) {
+	Common::List<IndexEntry> list;
+	for (uint i = 0; i < kEntryCount; i++)
+		list.push_back(makeEntry(i));
+	assert(list.size() == kEntryCount);
+}
+
+void buildEntryMap(void *) {
+	Common::HashMap<Common::String, IndexEntry, Common::IgnoreCase_Hash, Common::IgnoreCase_EqualTo> map;
+	for (uint i = 0; i < kEntryCount; i++)
+		map[Common::String::format("cast%05u", i)] = makeEntry(i);
+	assert(map.size() == kEntryCount);
+}
+
+void copyFreshStrings(void *) {
+	for (uint i = 0; i < kEntryCount; i++) {
+		// The first copy of a string is the one which sets up its sharing
+		Common::String str("Movies:Resources:cast00000.dir");
+		Common::String copy(str);
+		assert(copy.size() == str.size());
+	}
+}
+
+/** A draw call recorded for one frame, like the ones queued by TinyGL. */
+struct DrawCall {
+	int type;
+	float params[7];
+};
+
+void recordDrawCallsOnHeap(void *) {
+	Common::List<DrawCall *> queue;
+	for (uint i = 0; i < kEntryCount; i++)
+		queue.push_back(new DrawCall());
+	for (Common::List<DrawCall *>::iterator it = queue.begin(); it != queue.end(); ++it)
+		delete *it;
+}
+
+void recordDrawCallsInArena(void *param) {
+	Common::Arena &arena = *(Common::Arena *)param;
+	Common::ArenaScope frameScope(arena);
+	Common::List<DrawCall *, Common::ArenaAllocator> queue((Common::ArenaAllocator(arena)));
+	for (uint i = 0; i < kEntryCount; i++)
+		queue.push_back(new (arena.allocate(sizeof(DrawCall))) DrawCall());
+}
+
+} // End of anonymous namespace
+
+void runContainerBenchmarks(Runner &runner) {
+	runner.measure("containers/array/push_back_strings", kEntryCount, "elements", buildStringArray, nullptr);
+	runner.measure("containers/array/push_back_entries", kEntryCount, "elements", buildEntryArray, nullptr);
+	runner.measure("containers/array/insert_front_strings", kInsertCount, "elements", insertStringsAtFront, nullptr);
+	runner.measure("containers/string/copy_fresh", kEntryCount, "elements", copyFreshStrings, nullptr);
+	runner.measure("containers/list/push_back_entries", kEntryCount, "elements", buildEntryList, nullptr);
+	runner.measure("containers/hashmap/set_entries", kEntryCount, "elements", buildEntryMap, nullptr);
+
+	Common::Arena arena;
+	runner.measure("containers/list/record_draw_calls_heap", kEntryCount, "elements", recordDrawCallsOnHeap, nullptr);
+	runner.measure("containers/list/record_draw_calls_arena", kEntryCount, "elements", recordDrawCallsInArena, &arena);
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,182 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/file.h"
+#include "common/fs.h"
+#include "common/memstream.h"
+#include "common/textconsole.h"
+
+#include "image/bmp.h"
+#include "image/gif.h"
+#include "image/jpeg.h"
+#include "image/pcx.h"
+#include "image/png.h"
+#include "image/tga.h"
+
+#include "video/avi_decoder.h"
+#include "video/bink_decoder.h"
+#include "video/dxa_decoder.h"
+#include "video/flic_decoder.h"
+#include "video/qt_decoder.h"
+#include "video/smk_decoder.h"
+#include "video/theora_decoder.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	/** Number of frames decoded from each video. */
+	kMaxVideoFrames = 100
+};
+
+struct FileBenchmark {
+	Common::Array<byte> contents;
+	Image::ImageDecoder *imageDecoder;
+	Video::VideoDecoder *videoDecoder;
+	uint frameCount;
+};
+
+bool decodeImage(FileBenchmark &benchmark) {
+	Common::MemoryReadStream stream(benchmark.contents.data(), benchmark.contents.size());
+	const bool success = benchmark.imageDecoder->loadStream(stream);
+	benchmark.imageDecoder->destroy();
+	return success;
+}
+
+void decodeImage(void *data) {
+	decodeImage(*(FileBenchmark *)data);
+}
+
+uint decodeVideo(FileBenchmark &benchmark) {
+	Video::VideoDecoder *decoder = benchmark.videoDecoder;
+	if (!decoder->loadStream(new Common::MemoryReadStream(benchmark.contents.data(), benchmark.contents.size())))
+		return 0;
+
+	// The video is not started, and endOfVideo() is not used, because the
+	// null OSystem has no mixer for the audio tracks
+	const uint frameCount = MIN<uint>(decoder->getFrameCount(), kMaxVideoFrames);
+	uint frames = 0;
+	while (frames < frameCount && decoder->decodeNextFrame())
+		frames++;
+
+	decoder->close();
+	return frames;
+}
+
+void decodeVideo(void *data) {
+	decodeVideo(*(FileBenchmark *)data);
+}
+
+Image::ImageDecoder *createImageDecoder(const Common::String &extension) {
+	if (extension == "bmp")
+		return new Image::BitmapDecoder();
+	if (extension == "gif")
+		return new Image::GIFDecoder();
+	if (extension == "jpg" || extension == "jpeg")
+		return new Image::JPEGDecoder();
+	if (extension == "pcx")
+		return new Image::PCXDecoder();
+	if (extension == "png")
+		return new Image::PNGDecoder();
+	if (extension == "tga")
+		return new Image::TGADecoder();
+	return nullptr;
+}
+
+Video::VideoDecoder *createVideoDecoder(const Common::String &extension) {
+	if (extension == "avi")
+		return new Video::AVIDecoder();
+#ifdef USE_BINK
+	if (extension == "bik")
+		return new Video::BinkDecoder();
+#endif
+	if (extension == "dxa")
+		return new Video::DXADecoder();
+	if (extension == "fli" || extension == "flc")
+		return new Video::FlicDecoder();
+	if (extension == "mov")
+		return new Video::QuickTimeDecoder();
+#ifdef USE_THEORADEC
+	if (extension == "ogv")
+		return new Video::TheoraDecoder();
+#endif
+	if (extension == "smk")
+		return new Video::SmackerDecoder();
+	return nullptr;
+}
+
+} // End of anonymous namespace
+
+void runFileBenchmarks(Runner &runner, const Common::StringArray &files) {
+	for (uint i = 0; i < files.size(); i++) {
+		const Common::FSNode node(files[i]);
+		const Common::String fileName = node.getName();
+		Common::String extension = fileName.substr(fileName.findLastOf('.') + 1);
+		extension.toLowercase();
+
+		FileBenchmark benchmark;
+		benchmark.imageDecoder = createImageDecoder(extension);
+		benchmark.videoDecoder = createVideoDecoder(extension);
+		if (!benchmark.imageDecoder && !benchmark.videoDecoder) {
+			warning("No decoder for %s", fileName.c_str());
+			continue;
+		}
+
+		const Common::String name = Common::String::format("%s/%s/%s", benchmark.imageDecoder ? "image" : "video", extension.c_str(), fileName.c_str());
+		if (runner.isSelected(name)) {
+			// Benchmark the decoders, not the file system
+			Common::File file;
+			if (file.open(node)) {
+				benchmark.contents.resize(file.size());
+				file.read(benchmark.contents.data(), benchmark.contents.size());
+			}
+
+			if (benchmark.contents.empty()) {
+				warning("Can't read %s", files[i].c_str());
+			} else if (benchmark.imageDecoder) {
+				if (decodeImage(benchmark))
+					runner.measure(name, 1, "images", decodeImage, &benchmark);
+				else
+					warning("Can't decode %s", files[i].c_str());
+
+				if (extension == "jpg" || extension == "jpeg") {
+					// Thumbnails are decoded at a reduced size
+					((Image::JPEGDecoder *)benchmark.imageDecoder)->setScaleDenominator(8);
+					runner.measure(name + "/scale-8", 1, "images", decodeImage, &benchmark);
+				}
+			} else {
+				benchmark.frameCount = decodeVideo(benchmark);
+				if (benchmark.frameCount)
+					runner.measure(name, benchmark.frameCount, "frames", decodeVideo, &benchmark);
+				else
+					warning("Can't decode %s", files[i].c_str());
+			}
+		}
+
+		delete benchmark.imageDecoder;
+		delete benchmark.videoDecoder;
+	}
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,122 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/memstream.h"
+
+#include "graphics/surface.h"
+
+#include "image/bmp.h"
+#include "image/png.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kImageWidth = 640,
+	kImageHeight = 480
+};
+
+struct ImageBenchmark {
+	Graphics::Surface surface;
+	Common::MemoryWriteStreamDynamic encoded;
+	Image::ImageDecoder *decoder;
+	bool (*encode)(Common::WriteStream &out, const Graphics::Surface &input);
+
+	ImageBenchmark() : encoded(DisposeAfterUse::YES), decoder(nullptr), encode(nullptr) {}
+};
+
+void encodeImage(void *data) {
+	ImageBenchmark &benchmark = *(ImageBenchmark *)data;
+	Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+	benchmark.encode(out, benchmark.surface);
+}
+
+void decodeImage(void *data) {
+	ImageBenchmark &benchmark = *(ImageBenchmark *)data;
+	Common::MemoryReadStream in(benchmark.encoded.getData(), benchmark.encoded.size());
+	benchmark.decoder->loadStream(in);
+	benchmark.decoder->destroy();
+}
+
+bool writePNG(Common::WriteStream &out, const Graphics::Surface &input) {
+	return Image::writePNG(out, input);
+}
+
+void runCodecBenchmarks(Runner &runner, const char *name, ImageBenchmark &benchmark) {
+	const uint pixels = kImageWidth * kImageHeight;
+	runner.measure(Common::String::format("image/%s/encode", name), pixels, "pixels", encodeImage, &benchmark);
+
+	if (runner.isSelected(Common::String::format("image/%s/decode", name))) {
+		benchmark.encode(benchmark.encoded, benchmark.surface);
+		runner.measure(Common::String::format("image/%s/decode", name), pixels, "pixels", decodeImage, &benchmark);
+	}
+}
+
+} // End of anonymous namespace
+
+void runImageBenchmarks(Runner &runner) {
+	// There are no reference images in the tree, so a synthetic image is
+	// encoded first, and then decoded again
+	ImageBenchmark benchmark;
+	benchmark.surface.create(kImageWidth, kImageHeight, Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0));
+	for (int y = 0; y < kImageHeight; y++) {
+		byte *pixel = (byte *)benchmark.surface.getBasePtr(0, y);
+		for (int x = 0; x < kImageWidth; x++) {
+			const bool edge = ((x / 32) ^ (y / 32)) & 1;
+			*pixel++ = edge ? x : 0x40;
+			*pixel++ = edge ? y : 0x80;
+			*pixel++ = (x * y) >> 8;
+		}
+	}
+
+	Image::BitmapDecoder bmp;
+	benchmark.decoder = &bmp;
+	benchmark.encode = Image::writeBMP;
+	runCodecBenchmarks(runner, "bmp", benchmark);
+
+#ifdef USE_PNG
+	ImageBenchmark pngBenchmark;
+	pngBenchmark.surface.copyFrom(benchmark.surface);
+	Image::PNGDecoder png;
+	pngBenchmark.decoder = &png;
+	pngBenchmark.encode = writePNG;
+	runCodecBenchmarks(runner, "png", pngBenchmark);
+
+	// Decoding straight into the formats used for the overlay
+	const uint pixels = kImageWidth * kImageHeight;
+	if (runner.isSelected("image/png/decode-argb") || runner.isSelected("image/png/decode-rgb565")) {
+		if (pngBenchmark.encoded.size() == 0)
+			pngBenchmark.encode(pngBenchmark.encoded, pngBenchmark.surface);
+		png.setOutputPixelFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+		runner.measure("image/png/decode-argb", pixels, "pixels", decodeImage, &pngBenchmark);
+		png.setOutputPixelFormat(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		runner.measure("image/png/decode-rgb565", pixels, "pixels", decodeImage, &pngBenchmark);
+	}
+	pngBenchmark.surface.free();
+#endif
+
+	benchmark.surface.free();
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,161 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "base/plugins.h"
+#include "graphics/pixelformat.h"
+#include "graphics/scalerplugin.h"
+
+#define DECLARE_SCALER(ID) \
+	extern PluginObject *g_##ID##_getObject()
+
+DECLARE_SCALER(NORMAL);
+#ifdef USE_SCALERS
+#ifdef USE_HQ_SCALERS
+DECLARE_SCALER(HQ);
+#endif
+#ifdef USE_EDGE_SCALERS
+DECLARE_SCALER(EDGE);
+#endif
+DECLARE_SCALER(ADVMAME);
+DECLARE_SCALER(SAI);
+DECLARE_SCALER(SUPERSAI);
+DECLARE_SCALER(SUPEREAGLE);
+DECLARE_SCALER(PM);
+DECLARE_SCALER(DOTMATRIX);
+DECLARE_SCALER(TV);
+#endif
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kFrameWidth = 320,
+	kFrameHeight = 200
+};
+
+struct ScalerBenchmark {
+	Scaler *scaler;
+	const byte *src;
+	uint srcPitch;
+	byte *dst;
+	uint dstPitch;
+};
+
+void scaleFrame(void *data) {
+	ScalerBenchmark &benchmark = *(ScalerBenchmark *)data;
+	benchmark.scaler->scale(benchmark.src, benchmark.srcPitch, benchmark.dst, benchmark.dstPitch, kFrameWidth, kFrameHeight, 0, 0);
+}
+
+/** Fill the frame with flat areas, gradients and sharp edges, like a typical game screen. */
+void drawReferenceFrame(const Graphics::PixelFormat &format, byte *pixels, uint pitch, uint width, uint height) {
+	for (uint y = 0; y < height; y++) {
+		for (uint x = 0; x < width; x++) {
+			byte r, g, b;
+			if (((x / 16) ^ (y / 16)) & 1) {
+				r = x * 255 / width;
+				g = y * 255 / height;
+				b = 128;
+			} else {
+				r = g = b = ((x / 4 + y / 4) & 3) * 80;
+			}
+
+			const uint32 color = format.RGBToColor(r, g, b);
+			byte *pixel = pixels + y * pitch + x * format.bytesPerPixel;
+			if (format.bytesPerPixel == 2)
+				*(uint16 *)pixel = color;
+			else
+				*(uint32 *)pixel = color;
+		}
+	}
+}
+
+} // End of anonymous namespace
+
+void runScalerBenchmarks(Runner &runner) {
+	typedef PluginObject *(*GetObjectProc)();
+	static const GetObjectProc scalers[] = {
+		g_NORMAL_getObject,
+#ifdef USE_SCALERS
+#ifdef USE_HQ_SCALERS
+		g_HQ_getObject,
+#endif
+#ifdef USE_EDGE_SCALERS
+		g_EDGE_getObject,
+#endif
+		g_ADVMAME_getObject,
+		g_SAI_getObject,
+		g_SUPERSAI_getObject,
+		g_SUPEREAGLE_getObject,
+		g_PM_getObject,
+		g_DOTMATRIX_getObject,
+		g_TV_getObject
+#endif
+	};
+	static const struct {
+		Graphics::PixelFormat format;
+		const char *name;
+	} formats[] = {
+		{ Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), "rgb565" },
+		{ Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0), "rgba8888" }
+	};
+
+	for (int i = 0; i < ARRAYSIZE(scalers); i++) {
+		ScalerPluginObject *plugin = (ScalerPluginObject *)scalers[i]();
+
+		for (int j = 0; j < ARRAYSIZE(formats); j++) {
+			const Graphics::PixelFormat &format = formats[j].format;
+
+			// Scalers may read as far as extraPixels() outside of the frame
+			const uint padding = plugin->extraPixels();
+			const uint srcPitch = (kFrameWidth + 2 * padding) * format.bytesPerPixel;
+			Common::Array<byte> src(srcPitch * (kFrameHeight + 2 * padding));
+			drawReferenceFrame(format, src.data(), srcPitch, kFrameWidth + 2 * padding, kFrameHeight + 2 * padding);
+
+			const Common::Array<uint> &factors = plugin->getFactors();
+			for (uint k = 0; k < factors.size(); k++) {
+				const Common::String name = Common::String::format("scaler/%s/%s/%ux", plugin->getName(), formats[j].name, factors[k]);
+				if (!runner.isSelected(name))
+					continue;
+
+				Scaler *scaler = plugin->createInstance(format);
+				scaler->setFactor(factors[k]);
+
+				ScalerBenchmark benchmark;
+				benchmark.scaler = scaler;
+				benchmark.src = src.data() + padding * srcPitch + padding * format.bytesPerPixel;
+				benchmark.srcPitch = srcPitch;
+				benchmark.dstPitch = kFrameWidth * factors[k] * format.bytesPerPixel;
+				Common::Array<byte> dst(benchmark.dstPitch * kFrameHeight * factors[k]);
+				benchmark.dst = dst.data();
+
+				runner.measure(name, kFrameWidth * kFrameHeight, "pixels", scaleFrame, &benchmark);
+				delete scaler;
+			}
+		}
+
+		delete plugin;
+	}
+}
+
+} // End of namespace Benchmark
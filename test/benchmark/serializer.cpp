@@ -0,0 +1,98 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+
+#include "test/benchmark/benchmark.h"
+
+#include "common/memstream.h"
+#include "common/serializer.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kObjectCount = 4000,
+	kVariableCount = 64
+};
+
+/**
+ * A state shaped like the script objects saved by SCI: many objects, each
+ * with a block of 16-bit variables.
+ */
+struct SavedState {
+	Common::Array<uint16> variables;
+	Common::MemoryWriteStreamDynamic *saved;
+
+	SavedState() : variables(kObjectCount * kVariableCount), saved(nullptr) {}
+};
+
+void syncValues(Common::Serializer &s, SavedState &state) {
+	for (uint i = 0; i < kObjectCount; i++) {
+		uint16 *object = &state.variables[i * kVariableCount];
+		for (uint j = 0; j < kVariableCount; j++)
+			s.syncAsUint16LE(object[j]);
+	}
+}
+
+void syncArrays(Common::Serializer &s, SavedState &state) {
+	for (uint i = 0; i < kObjectCount; i++)
+		s.syncArrayAsUint16LE(&state.variables[i * kVariableCount], kVariableCount);
+}
+
+template<void (*SYNC)(Common::Serializer &, SavedState &)>
+void saveState(void *data) {
+	SavedState &state = *(SavedState *)data;
+	Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+	Common::Serializer s(nullptr, &out);
+	SYNC(s, state);
+	assert(out.size() == (int64)state.variables.size() * 2);
+}
+
+template<void (*SYNC)(Common::Serializer &, SavedState &)>
+void loadState(void *data) {
+	SavedState &state = *(SavedState *)data;
+	Common::MemoryReadStream in(state.saved->getData(), state.saved->size());
+	Common::Serializer s(&in, nullptr);
+	SYNC(s, state);
+	assert(in.pos() == in.size());
+}
+
+} // End of anonymous namespace
+
+void runSerializerBenchmarks(Runner &runner) {
+	SavedState state;
+	for (uint i = 0; i < state.variables.size(); i++)
+		state.variables[i] = i * 7;
+
+	Common::MemoryWriteStreamDynamic saved(DisposeAfterUse::YES);
+	Common::Serializer s(nullptr, &saved);
+	syncValues(s, state);
+	state.saved = &saved;
+
+	const uint64 bytes = state.variables.size() * 2;
+	runner.measure("serializer/save/values", bytes, "bytes", saveState<syncValues>, &state);
+	runner.measure("serializer/save/arrays", bytes, "bytes", saveState<syncArrays>, &state);
+	runner.measure("serializer/load/values", bytes, "bytes", loadState<syncValues>, &state);
+	runner.measure("serializer/load/arrays", bytes, "bytes", loadState<syncArrays>, &state);
+}
+
+} // End of namespace Benchmark
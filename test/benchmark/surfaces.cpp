@@ -0,0 +1,113 @@
+/* ScummVM - Graphic Adventure Engine
+ *
+ * ScummVM is the legal property of its developers, whose names
+ * are too numerous to list here. Please refer to the COPYRIGHT
+ * file distributed with this source distribution.
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 3 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "test/benchmark/benchmark.h"
+
+#include "graphics/managed_surface.h"
+#include "graphics/managed_surface_intern.h"
+
+namespace Benchmark {
+
+namespace {
+
+enum {
+	kFrameWidth = 320,
+	kFrameHeight = 200
+};
+
+struct SurfaceBenchmark {
+	Graphics::ManagedSurface src;
+	Graphics::ManagedSurface dest;
+	const Graphics::TransBlitKernels *kernels;
+	uint32 transColor;
+};
+
+void blitFrame(void *data) {
+	SurfaceBenchmark &benchmark = *(SurfaceBenchmark *)data;
+	benchmark.dest.blitFrom(benchmark.src);
+}
+
+void transBlitFrame(void *data) {
+	SurfaceBenchmark &benchmark = *(SurfaceBenchmark *)data;
+	benchmark.dest.transBlitFrom(benchmark.src, benchmark.transColor);
+}
+
+void transBlitRows(void *data) {
+	SurfaceBenchmark &benchmark = *(SurfaceBenchmark *)data;
+	const Graphics::ManagedSurface &src = benchmark.src;
+	Graphics::ManagedSurface &dest = benchmark.dest;
+	const uint32 colorMask = dest.format.ARGBToColor(0xff, 0xff, 0xff, 0xff);
+
+	for (int y = 0; y < kFrameHeight; y++) {
+		if (dest.format.bytesPerPixel == 1)
+			benchmark.kernels->transRow8((byte *)dest.getBasePtr(0, y), (const byte *)src.getBasePtr(0, y), kFrameWidth, benchmark.transColor);
+		else if (dest.format.bytesPerPixel == 2)
+			benchmark.kernels->transRow16((uint16 *)dest.getBasePtr(0, y), (const uint16 *)src.getBasePtr(0, y), kFrameWidth, benchmark.transColor, colorMask);
+		else
+			benchmark.kernels->transRow32((uint32 *)dest.getBasePtr(0, y), (const uint32 *)src.getBasePtr(0, y), kFrameWidth, benchmark.transColor, colorMask);
+	}
+}
+
+/** Draw a sprite sheet like frame, with transparent areas around opaque shapes. */
+void drawSpriteFrame(Graphics::ManagedSurface &surface, uint32 transColor) {
+	for (int y = 0; y < surface.h; y++) {
+		for (int x = 0; x < surface.w; x++) {
+			const int dx = x % 32 - 16, dy = y % 32 - 16;
+			uint32 color = transColor;
+			if (dx * dx + dy * dy < 14 * 14)
+				color = surface.format.bytesPerPixel == 1 ? 1 + (x + y) % 255 : surface.format.RGBToColor(x, y, 128);
+			surface.setPixel(x, y, color);
+		}
+	}
+}
+
+} // End of anonymous namespace
+
+void runSurfaceBenchmarks(Runner &runner) {
+	static const struct {
+		Graphics::PixelFormat format;
+		const char *name;
+	} formats[] = {
+		{ Graphics::PixelFormat::createFormatCLUT8(), "clut8" },
+		{ Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0), "rgb565" },
+		{ Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0), "xrgb8888" }
+	};
+	const uint pixels = kFrameWidth * kFrameHeight;
+
+	for (int i = 0; i < ARRAYSIZE(formats); i++) {
+		SurfaceBenchmark benchmark;
+		benchmark.src.create(kFrameWidth, kFrameHeight, formats[i].format);
+		benchmark.dest.create(kFrameWidth, kFrameHeight, formats[i].format);
+		benchmark.transColor = 0;
+		drawSpriteFrame(benchmark.src, benchmark.transColor);
+
+		runner.measure(Common::String::format("surface/%s/blit", formats[i].name), pixels, "pixels", blitFrame, &benchmark);
+		runner.measure(Common::String::format("surface/%s/transblit", formats[i].name), pixels, "pixels", transBlitFrame, &benchmark);
+
+		// The row routines on their own, to compare them with the portable ones
+		benchmark.kernels = &Graphics::getScalarTransBlitKernels();
+		runner.measure(Common::String::format("surface/%s/transrow/scalar", formats[i].name), pixels, "pixels", transBlitRows, &benchmark);
+		benchmark.kernels = &Graphics::getTransBlitKernels();
+		runner.measure(Common::String::format("surface/%s/transrow/native", formats[i].name), pixels, "pixels", transBlitRows, &benchmark);
+	}
+}
+
+} // End of namespace Benchmark
@@ -0,0 +1,111 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/arena.h"
+#include "common/array.h"
+#include "common/list.h"
+
+class ArenaTestSuite : public CxxTest::TestSuite {
+	struct Counted {
+		int *_destroyed;
+		int _value;
+
+		Counted(int *destroyed, int value) : _destroyed(destroyed), _value(value) {}
+		~Counted() { ++*_destroyed; }
+	};
+
+public:
+	void test_allocate() {
+		Common::Arena arena(256);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 0U);
+
+		byte *a = (byte *)arena.allocate(3);
+		byte *b = (byte *)arena.allocate(5);
+		TS_ASSERT_EQUALS((size_t)a % Common::Arena::kAlignment, 0U);
+		TS_ASSERT_EQUALS(b, a + Common::Arena::kAlignment);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 2 * Common::Arena::kAlignment);
+
+		// Allocations larger than the block size get a block of their own
+		byte *c = (byte *)arena.allocate(1024);
+		memset(c, 0xAB, 1024);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 256U + 1024U);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 256U + 1024U);
+
+		// After the reset, everything fits in the first block
+		a = (byte *)arena.allocate(256);
+		c = (byte *)arena.allocate(1024);
+		TS_ASSERT_EQUALS(c, a + 256);
+		TS_ASSERT_EQUALS(arena.getCapacity(), 256U + 1024U);
+	}
+
+	void test_rewind() {
+		Common::Arena arena(64);
+		void *a = arena.allocate(16);
+		const Common::Arena::Marker marker = arena.getMarker();
+		void *b = arena.allocate(48);
+		arena.allocate(200);
+		arena.allocate(16);
+
+		arena.rewind(marker);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 16U);
+		TS_ASSERT_EQUALS(arena.allocate(48), b);
+		TS_ASSERT_DIFFERS(a, b);
+	}
+
+	void test_scopes() {
+		Common::Arena arena(128);
+		int destroyed = 0;
+
+		Counted *object = arena.create<Counted>(&destroyed, 1);
+		{
+			Common::ArenaScope roomScope(arena);
+			arena.create<Counted>(&destroyed, 2);
+
+			for (int frame = 0; frame < 10; frame++) {
+				Common::ArenaScope frameScope(arena);
+				for (int i = 0; i < 20; i++)
+					arena.create<Counted>(&destroyed, i);
+			}
+			TS_ASSERT_EQUALS(destroyed, 10 * 20);
+		}
+		TS_ASSERT_EQUALS(destroyed, 10 * 20 + 1);
+		TS_ASSERT_EQUALS(object->_value, 1);
+
+		arena.reset();
+		TS_ASSERT_EQUALS(destroyed, 10 * 20 + 2);
+	}
+
+	void test_containers() {
+		Common::Arena arena(64);
+		const Common::Arena::Marker marker = arena.getMarker();
+
+		{
+			Common::Array<int, Common::ArenaAllocator> array((Common::ArenaAllocator(arena)));
+			Common::List<int, Common::ArenaAllocator> list((Common::ArenaAllocator(arena)));
+			for (int i = 0; i < 100; i++) {
+				array.push_back(i);
+				list.push_back(i);
+			}
+			TS_ASSERT(arena.getUsedSize() > 0);
+
+			Common::List<int, Common::ArenaAllocator> moved;
+			moved = Common::move(list);
+			moved.push_back(100);
+			TS_ASSERT(list.empty());
+
+			int expected = 0;
+			for (Common::List<int, Common::ArenaAllocator>::const_iterator it = moved.begin(); it != moved.end(); ++it)
+				TS_ASSERT_EQUALS(*it, expected++);
+			TS_ASSERT_EQUALS(expected, 101);
+
+			for (int i = 0; i < 100; i++)
+				TS_ASSERT_EQUALS(array[i], i);
+		}
+
+		arena.rewind(marker);
+		TS_ASSERT_EQUALS(arena.getUsedSize(), 0U);
+	}
+};
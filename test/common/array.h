@@ -418,6 +418,96 @@ class ArrayTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(array[1], 163);
 	}
 
+	class Movable {
+		int _value;
+		bool _copied;
+	public:
+		explicit Movable(int v) : _value(v), _copied(false) {}
+		Movable(int v, int w) : _value(v * w), _copied(false) {}
+		Movable(const Movable &other) : _value(other._value), _copied(true) {}
+		Movable(Movable &&other) : _value(other._value), _copied(other._copied) { other._value = -1; }
+		Movable &operator=(const Movable &other) { _value = other._value; _copied = true; return *this; }
+		Movable &operator=(Movable &&other) { _value = other._value; _copied = other._copied; other._value = -1; return *this; }
+		bool copied() const { return _copied; }
+		int value() const { return _value; }
+	};
+
+	void test_emplace_back() {
+		Common::Array<Movable> array;
+
+		// Growing the array must move the elements
+		for (int i = 0; i < 40; ++i) {
+			Movable &element = array.emplace_back(i, 2);
+			TS_ASSERT_EQUALS(element.value(), 2 * i);
+		}
+		array.push_back(Movable(80));
+
+		TS_ASSERT_EQUALS(array.size(), 41U);
+		for (uint i = 0; i < array.size(); ++i) {
+			TS_ASSERT_EQUALS(array[i].value(), (int)(2 * i));
+			TS_ASSERT(!array[i].copied());
+		}
+
+		// The arguments may refer to an element of the array itself
+		array.emplace_back(array[40]);
+		TS_ASSERT_EQUALS(array.size(), 42U);
+		TS_ASSERT_EQUALS(array[41].value(), 80);
+		TS_ASSERT(array[41].copied());
+		TS_ASSERT(!array[40].copied());
+	}
+
+	void test_emplace() {
+		Common::Array<Movable> array;
+		for (int i = 0; i < 8; ++i)
+			array.emplace_back(i);
+
+		// Without reallocation
+		array.reserve(16);
+		Common::Array<Movable>::iterator iter = array.emplace(array.begin() + 3, 100);
+		TS_ASSERT_EQUALS(iter, array.begin() + 3);
+		array.insert_at(0, Movable(200));
+		array.insert(array.end(), Movable(300));
+
+		// With reallocation
+		for (int i = 0; i < 6; ++i)
+			array.emplace(array.begin() + 1, 400 + i);
+
+		static const int expected[] = { 200, 405, 404, 403, 402, 401, 400, 0, 1, 2, 100, 3, 4, 5, 6, 7, 300 };
+		TS_ASSERT_EQUALS(array.size(), (uint)ARRAYSIZE(expected));
+		for (uint i = 0; i < array.size(); ++i) {
+			TS_ASSERT_EQUALS(array[i].value(), expected[i]);
+			TS_ASSERT(!array[i].copied());
+		}
+
+		// Inserting an element of the array in the middle
+		array.emplace(array.begin() + 1, array[2]);
+		TS_ASSERT_EQUALS(array[1].value(), 404);
+		TS_ASSERT(array[1].copied());
+		TS_ASSERT_EQUALS(array[2].value(), 405);
+		TS_ASSERT_EQUALS(array[3].value(), 404);
+
+		array.remove_at(0);
+		array.erase(array.begin());
+		TS_ASSERT_EQUALS(array[0].value(), 405);
+		TS_ASSERT(!array[0].copied());
+		TS_ASSERT(!array[1].copied());
+	}
+
+	void test_move_strings() {
+		Common::Array<Common::String> array;
+		Common::String str("This string does not fit in the internal storage");
+		const char *data = str.c_str();
+
+		array.push_back(Common::move(str));
+		TS_ASSERT(str.empty());
+		TS_ASSERT_EQUALS(array[0].c_str(), data);
+
+		for (int i = 0; i < 20; ++i)
+			array.push_back(Common::String::format("%d", i));
+		TS_ASSERT_EQUALS(array[0].c_str(), data);
+		TS_ASSERT_EQUALS(array[20], "19");
+	}
+
 };
 
 struct ListElement {
@@ -255,4 +255,34 @@ public:
 		tmpl_align_16<Common::MemoryReadStream, Common::BitStream16BELSB>();
 		tmpl_align_16<Common::BitStreamMemoryStream, Common::BitStreamMemory16BELSB>();
 	}
+
+private:
+	template<class BS, class MemoryBS>
+	void tmpl_read_ahead() {
+		byte contents[32];
+		for (int i = 0; i < ARRAYSIZE(contents); i++)
+			contents[i] = i * 37 + 11;
+
+		// Memory bit streams refill their bits 32 at a time, which must not
+		// change the values read
+		Common::MemoryReadStream ms(contents, sizeof(contents));
+		Common::BitStreamMemoryStream bms(contents, sizeof(contents));
+		BS bs(ms);
+		MemoryBS mbs(bms);
+
+		for (uint n = 1; mbs.pos() + n <= mbs.size(); n = n % 32 + 1) {
+			TS_ASSERT_EQUALS(mbs.peekBits(n), bs.peekBits(n));
+			TS_ASSERT_EQUALS(mbs.getBits(n), bs.getBits(n));
+			TS_ASSERT_EQUALS(mbs.pos(), bs.pos());
+		}
+		TS_ASSERT(!mbs.eos());
+	}
+public:
+	void test_read_ahead() {
+		tmpl_read_ahead<Common::BitStream8MSB, Common::BitStreamMemory8MSB>();
+		tmpl_read_ahead<Common::BitStream8LSB, Common::BitStreamMemory8LSB>();
+		tmpl_read_ahead<Common::BitStream16LELSB, Common::BitStreamMemory16LELSB>();
+		tmpl_read_ahead<Common::BitStream16BEMSB, Common::BitStreamMemory16BEMSB>();
+		tmpl_read_ahead<Common::BitStream16LEMSB, Common::BitStreamMemory16LEMSB>();
+	}
 };
@@ -0,0 +1,57 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/fft.h"
+
+class FFTTestSuite : public CxxTest::TestSuite {
+	// Compare the FFT against a straightforward DFT computed in double precision
+	void checkAgainstDFT(int bits, bool inverse) {
+		const int n = 1 << bits;
+		Common::Complex *data = new Common::Complex[n];
+		Common::Complex *input = new Common::Complex[n];
+
+		for (int i = 0; i < n; i++) {
+			input[i].re = (float)sin(i * 0.37) + ((i * 7) % 13) * 0.05f;
+			input[i].im = (float)cos(i * 1.21) - ((i * 5) % 11) * 0.03f;
+			data[i] = input[i];
+		}
+
+		Common::FFT fft(bits, inverse);
+		fft.permute(data);
+		fft.calc(data);
+
+		const double sign = inverse ? 1.0 : -1.0;
+		double maxError = 0.0;
+		for (int k = 0; k < n; k++) {
+			double re = 0.0, im = 0.0;
+			for (int i = 0; i < n; i++) {
+				const double angle = sign * 2.0 * M_PI * (double)((i * k) % n) / n;
+				re += input[i].re * cos(angle) - input[i].im * sin(angle);
+				im += input[i].re * sin(angle) + input[i].im * cos(angle);
+			}
+			maxError = MAX(maxError, fabs(re - data[k].re));
+			maxError = MAX(maxError, fabs(im - data[k].im));
+		}
+
+		// The error of a float FFT grows with the logarithm of its size
+		TS_ASSERT_LESS_THAN(maxError, 1e-5 * bits * sqrt((double)n));
+
+		delete[] input;
+		delete[] data;
+	}
+
+public:
+	void test_small_sizes() {
+		for (int bits = 2; bits <= 6; bits++) {
+			checkAgainstDFT(bits, false);
+			checkAgainstDFT(bits, true);
+		}
+	}
+
+	void test_large_sizes() {
+		// Sizes above 1024 use the variant of the passes which loads all
+		// inputs first
+		checkAgainstDFT(10, false);
+		checkAgainstDFT(12, true);
+	}
+
+};
@@ -230,5 +230,27 @@ class HashMapTestSuite : public CxxTest::TestSuite
 		TS_ASSERT(found == 16+8+4);
 }
 
+	void test_move() {
+		Common::HashMap<Common::String, Common::String> container;
+		Common::String key("This key does not fit in the internal storage");
+		Common::String value("This value does not fit in the internal storage");
+		const char *keyData = key.c_str();
+		const char *valueData = value.c_str();
+
+		container.setVal(Common::move(key), Common::move(value));
+		TS_ASSERT(key.empty());
+		TS_ASSERT(value.empty());
+		Common::HashMap<Common::String, Common::String>::iterator iter = container.begin();
+		TS_ASSERT_EQUALS(iter->_key.c_str(), keyData);
+		TS_ASSERT_EQUALS(iter->_value.c_str(), valueData);
+
+		// Growing the storage must keep the moved key
+		for (int i = 0; i < 100; ++i)
+			container[Common::String::format("%d", i)] = Common::String::format("%d", i * 2);
+		TS_ASSERT_EQUALS(container.size(), 101U);
+		TS_ASSERT_EQUALS(container["This key does not fit in the internal storage"].c_str(), valueData);
+		TS_ASSERT_EQUALS(container["99"], "198");
+	}
+
 	// TODO: Add test cases for iterators, find, ...
 };
@@ -94,4 +94,59 @@ class HuffmanTestSuite : public CxxTest::TestSuite {
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[5]);
 		TS_ASSERT_EQUALS(h.getSymbol(bs), expected[6]);
 	}
+
+private:
+	template<class BS>
+	void tmpl_long_codes() {
+		/*
+		 * Symbol k < 24 is coded as k one bits followed by a zero bit, and
+		 * symbol 24 as 24 one bits. This covers codes decoded through the
+		 * first and second level lookup tables, and codes which are too
+		 * long for either of them.
+		 */
+		const uint32 codeCount = 25;
+		uint8 lengths[codeCount];
+		uint32 codes[codeCount];
+		for (uint32 k = 0; k < codeCount; k++) {
+			lengths[k] = (k < codeCount - 1) ? k + 1 : k;
+			if (BS::isMSB2LSB())
+				codes[k] = (k < codeCount - 1) ? ((1 << k) - 1) << 1 : (1 << k) - 1;
+			else
+				codes[k] = (1 << k) - 1;
+		}
+
+		Common::Huffman<BS> h(0, codeCount, codes, lengths);
+
+		// Encode each symbol, then all of them backwards
+		uint32 expected[2 * codeCount];
+		for (uint32 k = 0; k < codeCount; k++) {
+			expected[k] = k;
+			expected[2 * codeCount - 1 - k] = k;
+		}
+
+		byte input[128];
+		memset(input, 0, sizeof(input));
+		uint32 bitPos = 0;
+		for (uint32 i = 0; i < ARRAYSIZE(expected); i++) {
+			for (uint32 b = 0; b < lengths[expected[i]]; b++, bitPos++) {
+				const uint32 bit = (expected[i] < codeCount - 1 && b == expected[i]) ? 0 : 1;
+				if (BS::isMSB2LSB())
+					input[bitPos / 8] |= bit << (7 - bitPos % 8);
+				else
+					input[bitPos / 8] |= bit << (bitPos % 8);
+			}
+		}
+
+		Common::BitStreamMemoryStream ms(input, sizeof(input));
+		BS bs(ms);
+
+		for (uint32 i = 0; i < ARRAYSIZE(expected); i++)
+			TS_ASSERT_EQUALS(h.getSymbol(bs), expected[i]);
+		TS_ASSERT_EQUALS(bs.pos(), bitPos);
+	}
+public:
+	void test_long_codes() {
+		tmpl_long_codes<Common::BitStreamMemory8MSB>();
+		tmpl_long_codes<Common::BitStreamMemory8LSB>();
+	}
 };
@@ -1,6 +1,7 @@
 #include <cxxtest/TestSuite.h>
 
 #include "common/list.h"
+#include "common/str.h"
 
 class ListTestSuite : public CxxTest::TestSuite
 {
@@ -272,4 +273,51 @@ class ListTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(container.front(), 99);
 		TS_ASSERT_EQUALS(container.back(),  99);
 	}
+
+	void test_emplace() {
+		Common::List<Common::String> container;
+		Common::List<Common::String>::iterator iter;
+
+		TS_ASSERT_EQUALS(container.emplace_back("bcd", 2), "bc");
+		TS_ASSERT_EQUALS(container.emplace_front("aaab", 3), "aaa");
+		iter = container.emplace(container.end(), "d");
+		TS_ASSERT_EQUALS(*iter, "d");
+
+		Common::String str("This string does not fit in the internal storage");
+		const char *data = str.c_str();
+		container.push_back(Common::move(str));
+		TS_ASSERT(str.empty());
+		TS_ASSERT_EQUALS(container.back().c_str(), data);
+
+		iter = container.begin();
+		TS_ASSERT_EQUALS(*iter++, "aaa");
+		TS_ASSERT_EQUALS(*iter++, "bc");
+		TS_ASSERT_EQUALS(*iter++, "d");
+		TS_ASSERT_EQUALS(iter->c_str(), data);
+	}
+
+	void test_move() {
+		Common::List<int> container;
+		container.push_back(17);
+		container.push_back(33);
+
+		Common::List<int> container2(Common::move(container));
+		TS_ASSERT(container.empty());
+		TS_ASSERT_EQUALS(container2.size(), 2U);
+		TS_ASSERT_EQUALS(container2.front(), 17);
+		TS_ASSERT_EQUALS(container2.back(), 33);
+
+		container.push_back(-1);
+		container = Common::move(container2);
+		TS_ASSERT(container2.empty());
+		TS_ASSERT_EQUALS(container.size(), 2U);
+		TS_ASSERT_EQUALS(container.front(), 17);
+		TS_ASSERT_EQUALS(container.back(), 33);
+
+		// Moving an empty list
+		container = Common::move(container2);
+		TS_ASSERT(container.empty());
+		container.push_back(42);
+		TS_ASSERT_EQUALS(container.front(), 42);
+	}
 };
@@ -0,0 +1,56 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/lzss.h"
+#include "common/memstream.h"
+
+class LZSSTestSuite : public CxxTest::TestSuite {
+	uint32 decompress(const byte *packed, uint32 packedSize, byte *dest, uint32 unpackedSize, uint lengthBits, uint minLength, uint distanceBias = 0) {
+		Common::MemoryReadStream stream(packed, packedSize);
+		return Common::decompressLZSS(&stream, packedSize, dest, unpackedSize, lengthBits, minLength, distanceBias);
+	}
+
+public:
+	void test_literals_and_matches() {
+		// 'a', 'b', 5 bytes from 2 back, 'c', 4 bytes from 1 back
+		const byte packed[] = { 0x0b, 'a', 'b', 0x22, 0x00, 'c', 0x11, 0x00 };
+		byte dest[12];
+
+		TS_ASSERT_EQUALS(decompress(packed, sizeof(packed), dest, sizeof(dest), 4, 3), 12u);
+		TS_ASSERT_EQUALS(memcmp(dest, "abababaccccc", 12), 0);
+	}
+
+	void test_before_start() {
+		// Bytes before the start of the output read as 0, and a distance of
+		// 0 refers back a whole window
+		const byte packed[] = {
+			0xfe, 0x00, 0x30, 'a', 'b', 'c', 'd', 'e', 'f', 'g',
+			0xff, 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o',
+			0x00, 0x01, 0x00
+		};
+		const byte expected[] = { 0, 0, 0, 'a', 'b', 'c', 'd', 'e', 'f', 'g', 'h', 'i', 'j', 'k', 'l', 'm', 'n', 'o', 0, 'a', 'b', 'c' };
+		byte dest[22];
+
+		TS_ASSERT_EQUALS(decompress(packed, sizeof(packed), dest, sizeof(dest), 12, 3), 22u);
+		TS_ASSERT_EQUALS(memcmp(dest, expected, sizeof(expected)), 0);
+	}
+
+	void test_distance_bias() {
+		// The distance is stored minus one
+		const byte packed[] = { 0x03, 'a', 'b', 0x12, 0x00 };
+		byte dest[6];
+
+		TS_ASSERT_EQUALS(decompress(packed, sizeof(packed), dest, sizeof(dest), 4, 2, 1), 6u);
+		TS_ASSERT_EQUALS(memcmp(dest, "ababab", 6), 0);
+	}
+
+	void test_invalid() {
+		const byte packed[] = { 0x0b, 'a', 'b', 0x22, 0x00, 'c', 0x11, 0x00 };
+		byte dest[12];
+
+		// Matches which do not fit are not written
+		TS_ASSERT_EQUALS(decompress(packed, sizeof(packed), dest, 10, 4, 3), 8u);
+
+		// The data ends early, in the middle of a reference
+		TS_ASSERT_EQUALS(decompress(packed, 7, dest, sizeof(dest), 4, 3), 8u);
+	}
+};
@@ -0,0 +1,80 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memtracker.h"
+
+class MemoryTrackerTestSuite : public CxxTest::TestSuite {
+	class TestConsumer : public Common::MemoryConsumer {
+	public:
+		TestConsumer(const char *name, size_t usage) : _name(name), _usage(usage), _shrinkCount(0) {}
+
+		const char *getMemoryConsumerName() const override { return _name; }
+		size_t getMemoryUsage() const override { return _usage; }
+
+		size_t shrinkMemoryUsage(size_t bytes) override {
+			const size_t freed = MIN(bytes, _usage);
+			_usage -= freed;
+			_shrinkCount++;
+			return freed;
+		}
+
+		const char *_name;
+		size_t _usage;
+		int _shrinkCount;
+	};
+
+public:
+	void test_order() {
+		TestConsumer normal("normal", 10), low("low", 20), high("high", 30), low2("low2", 40);
+		MemTracker.registerConsumer(&normal);
+		MemTracker.registerConsumer(&low, Common::MemoryTracker::kPriorityLow);
+		MemTracker.registerConsumer(&high, Common::MemoryTracker::kPriorityHigh);
+		MemTracker.registerConsumer(&low2, Common::MemoryTracker::kPriorityLow);
+
+		// Sorted by priority, in registration order within one
+		const Common::Array<Common::MemoryTracker::Consumer> &consumers = MemTracker.getConsumers();
+		TS_ASSERT_EQUALS(consumers.size(), 4u);
+		TS_ASSERT_EQUALS(consumers[0].consumer, &low);
+		TS_ASSERT_EQUALS(consumers[1].consumer, &low2);
+		TS_ASSERT_EQUALS(consumers[2].consumer, &normal);
+		TS_ASSERT_EQUALS(consumers[3].consumer, &high);
+		TS_ASSERT_EQUALS(MemTracker.getTotalUsage(), 100u);
+
+		MemTracker.unregisterConsumer(&low2);
+		MemTracker.unregisterConsumer(&normal);
+		TS_ASSERT_EQUALS(consumers.size(), 2u);
+		TS_ASSERT_EQUALS(MemTracker.getTotalUsage(), 50u);
+
+		MemTracker.unregisterConsumer(&low);
+		MemTracker.unregisterConsumer(&high);
+		TS_ASSERT(consumers.empty());
+	}
+
+	void test_budget() {
+		TestConsumer normal("normal", 100), low("low", 30), high("high", 100);
+		MemTracker.registerConsumer(&normal);
+		MemTracker.registerConsumer(&low, Common::MemoryTracker::kPriorityLow);
+		MemTracker.registerConsumer(&high, Common::MemoryTracker::kPriorityHigh);
+
+		// No budget
+		MemTracker.checkBudget();
+		TS_ASSERT_EQUALS(MemTracker.getTotalUsage(), 230u);
+
+		// Within the budget
+		MemTracker.setBudget(230);
+		MemTracker.checkBudget();
+		TS_ASSERT_EQUALS(low._shrinkCount, 0);
+
+		// The low priority cache is emptied first, then the normal one shrunk
+		MemTracker.setBudget(150);
+		MemTracker.checkBudget();
+		TS_ASSERT_EQUALS(low._usage, 0u);
+		TS_ASSERT_EQUALS(normal._usage, 50u);
+		TS_ASSERT_EQUALS(high._usage, 100u);
+		TS_ASSERT_EQUALS(high._shrinkCount, 0);
+
+		MemTracker.setBudget(0);
+		MemTracker.unregisterConsumer(&normal);
+		MemTracker.unregisterConsumer(&low);
+		MemTracker.unregisterConsumer(&high);
+	}
+};
@@ -0,0 +1,117 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/str-array.h"
+
+class SearchSetTestArchive : public Common::Archive {
+public:
+	Common::StringArray _files;
+	byte _id;
+	mutable int _lookups;
+
+	SearchSetTestArchive(byte id) : _id(id), _lookups(0) {}
+
+	bool hasFile(const Common::Path &path) const override {
+		_lookups++;
+		for (uint i = 0; i < _files.size(); i++) {
+			if (_files[i].equalsIgnoreCase(path.toString()))
+				return true;
+		}
+		return false;
+	}
+
+	int listMembers(Common::ArchiveMemberList &list) const override {
+		for (uint i = 0; i < _files.size(); i++)
+			list.push_back(Common::ArchiveMemberPtr(new Common::GenericArchiveMember(_files[i], this)));
+		return _files.size();
+	}
+
+	const Common::ArchiveMemberPtr getMember(const Common::Path &path) const override {
+		return Common::ArchiveMemberPtr(new Common::GenericArchiveMember(path.toString(), this));
+	}
+
+	Common::SeekableReadStream *createReadStreamForMember(const Common::Path &path) const override {
+		if (!hasFile(path))
+			return nullptr;
+		return new Common::MemoryReadStream(&_id, 1);
+	}
+};
+
+class SearchSetTestSuite : public CxxTest::TestSuite {
+public:
+	void test_index() {
+		Common::SearchSet set;
+		SearchSetTestArchive *high = new SearchSetTestArchive(1);
+		SearchSetTestArchive *low = new SearchSetTestArchive(2);
+		high->_files.push_back("a.dat");
+		low->_files.push_back("a.dat");
+		low->_files.push_back("b.dat");
+		set.add("low", low, 0);
+		set.add("high", high, 1);
+
+		// The first lookup searches the archives in order, the second one
+		// only asks the archive which provided the file
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT_EQUALS(high->_lookups, 1);
+		TS_ASSERT_EQUALS(low->_lookups, 1);
+		TS_ASSERT(set.hasFile("b.dat"));
+		TS_ASSERT_EQUALS(high->_lookups, 1);
+		TS_ASSERT_EQUALS(low->_lookups, 2);
+
+		// Lookups ignore case, and so does the index
+		TS_ASSERT(set.hasFile("B.DAT"));
+		TS_ASSERT_EQUALS(high->_lookups, 1);
+		TS_ASSERT_EQUALS(low->_lookups, 3);
+
+		// The archive with the highest priority still wins
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->readByte(), 1);
+		delete stream;
+
+		// Reordering the archives drops the index
+		set.setPriority("low", 2);
+		stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->readByte(), 2);
+		delete stream;
+		stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT_EQUALS(stream->readByte(), 2);
+		delete stream;
+
+		// Files which are gone are searched for again
+		low->_files.remove_at(0);
+		TS_ASSERT(set.hasFile("a.dat"));
+		set.remove("high");
+		TS_ASSERT(!set.hasFile("a.dat"));
+		TS_ASSERT(!set.getMember("a.dat"));
+	}
+
+	void test_index_nested() {
+		Common::SearchSet set;
+		Common::SearchSet *nested = new Common::SearchSet();
+		SearchSetTestArchive *low = new SearchSetTestArchive(1);
+		low->_files.push_back("a.dat");
+		set.add("nested", nested, 1);
+		set.add("low", low, 0);
+
+		Common::SeekableReadStream *stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT_EQUALS(stream->readByte(), 1);
+		delete stream;
+
+		// A file added to a nested set of higher priority takes over
+		SearchSetTestArchive *high = new SearchSetTestArchive(2);
+		high->_files.push_back("a.dat");
+		nested->add("high", high);
+		stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT_EQUALS(stream->readByte(), 2);
+		delete stream;
+
+		// And is dropped again along with the nested set
+		set.remove("nested");
+		stream = set.createReadStreamForMember("a.dat");
+		TS_ASSERT_EQUALS(stream->readByte(), 1);
+		delete stream;
+	}
+};
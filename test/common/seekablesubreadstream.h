@@ -70,4 +70,48 @@ class SeekableSubReadStreamTestSuite : public CxxTest::TestSuite {
 		b = ssrs.readByte();
 		TS_ASSERT_EQUALS(b, 1);
 	}
+
+	void test_shared_memory_parent() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::SharedPtr<Common::SeekableReadStream> parent(new Common::MemoryReadStream(contents, 10));
+
+		// Memory parents give plain views into their data
+		Common::SeekableReadStream *sub = Common::createSharedSubReadStream(parent, 2, 8);
+		Common::MemoryReadStream *view = dynamic_cast<Common::MemoryReadStream *>(sub);
+		TS_ASSERT(view != nullptr);
+		TS_ASSERT_EQUALS(view->getData(), contents + 2);
+		TS_ASSERT_EQUALS(sub->size(), 6);
+
+		// The view keeps the parent alive
+		parent.reset();
+		TS_ASSERT_EQUALS(sub->readByte(), 2);
+		delete sub;
+	}
+
+	void test_shared_parent() {
+		byte contents[10] = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+		Common::MemoryReadStream *ms = new Common::MemoryReadStream(contents, 10);
+		Common::SharedPtr<Common::SeekableReadStream> parent(new Common::SeekableSubReadStream(ms, 0, 10, DisposeAfterUse::YES));
+
+		Common::SeekableReadStream *a = Common::createSharedSubReadStream(parent, 1, 5);
+		Common::SeekableReadStream *b = Common::createSharedSubReadStream(parent, 5, 9);
+		parent.reset();
+
+		// Interleaved reads do not disturb each other
+		TS_ASSERT_EQUALS(a->readByte(), 1);
+		TS_ASSERT_EQUALS(b->readByte(), 5);
+		TS_ASSERT_EQUALS(a->readByte(), 2);
+		TS_ASSERT_EQUALS(b->readByte(), 6);
+
+		TS_ASSERT(b->seek(-1, SEEK_END));
+		TS_ASSERT_EQUALS(b->readByte(), 8);
+		TS_ASSERT(!b->eos());
+		b->readByte();
+		TS_ASSERT(b->eos());
+		TS_ASSERT(!b->seek(5));
+
+		TS_ASSERT_EQUALS(a->pos(), 2);
+		delete a;
+		delete b;
+	}
 };
@@ -1,5 +1,6 @@
 #include <cxxtest/TestSuite.h>
 
+#include "common/memstream.h"
 #include "common/serializer.h"
 #include "common/stream.h"
 
@@ -108,4 +109,41 @@ public:
 	void test_read_v2_as_v2() {
 		readVersioned_v2(_inStreamV2, 2);
 	}
+
+	void test_sync_array() {
+		// More values than fit in the conversion buffer at once
+		int32 values[700];
+		for (int i = 0; i < ARRAYSIZE(values); i++)
+			values[i] = i * 0x10203 - 0x100000;
+
+		Common::MemoryWriteStreamDynamic out(DisposeAfterUse::YES);
+		Common::Serializer saver(0, &out);
+		saver.syncArrayAsSint32BE(values, ARRAYSIZE(values));
+		saver.syncArrayAsUint16LE(values, 2);
+		saver.syncArrayAsByte(values, 2, Common::Serializer::Version(1));
+		TS_ASSERT_EQUALS(saver.bytesSynced(), 700u * 4 + 2 * 2);
+		TS_ASSERT_EQUALS(out.size(), 700 * 4 + 2 * 2);
+
+		// The array is stored like the values synced one by one
+		Common::MemoryReadStream in(out.getData(), out.size());
+		Common::Serializer single(&in, 0);
+		for (int i = 0; i < ARRAYSIZE(values); i++) {
+			int32 value = 0;
+			single.syncAsSint32BE(value);
+			TS_ASSERT_EQUALS(value, values[i]);
+		}
+
+		in.seek(0);
+		int32 loaded[700];
+		uint16 truncated[3];
+		Common::Serializer loader(&in, 0);
+		loader.syncArrayAsSint32BE(loaded, ARRAYSIZE(loaded));
+		TS_ASSERT_EQUALS(memcmp(loaded, values, sizeof(values)), 0);
+
+		// Values past the end of the data are read as zero
+		loader.syncArrayAsUint16LE(truncated, 3);
+		TS_ASSERT_EQUALS(truncated[0], (uint16)values[0]);
+		TS_ASSERT_EQUALS(truncated[1], (uint16)values[1]);
+		TS_ASSERT_EQUALS(truncated[2], 0);
+	}
 };
@@ -202,6 +202,41 @@ class StringTestSuite : public CxxTest::TestSuite
 		TS_ASSERT_EQUALS(foo10, "1234");
 	}
 
+	void test_move() {
+		// External storage is taken over
+		Common::String foo1("12345678901234567890123456789012");
+		const char *data = foo1.c_str();
+		Common::String foo2(Common::move(foo1));
+		TS_ASSERT(foo1.empty());
+		TS_ASSERT_EQUALS(foo2.c_str(), data);
+		TS_ASSERT_EQUALS(foo2, "12345678901234567890123456789012");
+
+		// Internal storage is copied
+		Common::String foo3("1234");
+		Common::String foo4(Common::move(foo3));
+		TS_ASSERT_EQUALS(foo4, "1234");
+
+		Common::String foo5("abcd");
+		foo5 = Common::move(foo2);
+		TS_ASSERT(foo2.empty());
+		TS_ASSERT_EQUALS(foo5.c_str(), data);
+		foo5 = Common::move(foo4);
+		TS_ASSERT_EQUALS(foo5, "1234");
+
+		// Shared storage stays shared with the copies
+		Common::String foo6("abcdefghijklmnopqrstuvwxyzabcdefghijkl");
+		Common::String foo7(foo6);
+		Common::String foo8(Common::move(foo6));
+		foo7.setChar('0', 0);
+		TS_ASSERT_EQUALS(foo8, "abcdefghijklmnopqrstuvwxyzabcdefghijkl");
+		TS_ASSERT_EQUALS(foo7, "0bcdefghijklmnopqrstuvwxyzabcdefghijkl");
+
+		Common::U32String foo9("12345678901234567890123456789012");
+		Common::U32String foo10(Common::move(foo9));
+		TS_ASSERT(foo9.empty());
+		TS_ASSERT_EQUALS(foo10, "12345678901234567890123456789012");
+	}
+
 	void test_hasPrefix() {
 		Common::String str("this/is/a/test, haha");
 		TS_ASSERT_EQUALS(str.hasPrefix(""), true);
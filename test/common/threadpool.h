@@ -0,0 +1,68 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/threadpool.h"
+
+class ThreadPoolTestSuite : public CxxTest::TestSuite {
+	static void increment(void *data) {
+		(*(int *)data)++;
+	}
+
+	static void fill(void *data, uint begin, uint end) {
+		int *values = (int *)data;
+		for (uint i = begin; i < end; i++)
+			values[i] += i;
+	}
+
+public:
+	void test_submit() {
+		Common::ThreadPool pool(4);
+
+		int counters[8] = {};
+		Common::Future futures[8];
+		for (int i = 0; i < 8; i++) {
+			TS_ASSERT(!futures[i].isDone());
+			pool.submit(futures[i], increment, &counters[i]);
+		}
+
+		for (int i = 0; i < 8; i++) {
+			futures[i].wait();
+			TS_ASSERT(futures[i].isDone());
+			TS_ASSERT_EQUALS(counters[i], 1);
+		}
+
+		// A future can be reused once its task is done
+		pool.submit(futures[0], increment, &counters[0]);
+		futures[0].wait();
+		futures[0].wait();
+		TS_ASSERT_EQUALS(counters[0], 2);
+	}
+
+	void test_parallel_for() {
+		Common::ThreadPool pool(3);
+
+		int values[1000] = {};
+		pool.parallelFor(10, 990, 7, fill, values);
+		for (uint i = 0; i < 1000; i++)
+			TS_ASSERT_EQUALS(values[i], (i >= 10 && i < 990) ? (int)i : 0);
+
+		// Empty ranges do nothing
+		pool.parallelFor(5, 5, 1, fill, values);
+		TS_ASSERT_EQUALS(values[5], 0);
+	}
+
+	void test_no_threads() {
+		// Without worker threads, the tasks run on the calling thread
+		Common::ThreadPool pool(0);
+		TS_ASSERT_EQUALS(pool.getThreadCount(), 0u);
+
+		int counter = 0;
+		Common::Future future;
+		pool.submit(future, increment, &counter);
+		TS_ASSERT(future.isDone());
+		TS_ASSERT_EQUALS(counter, 1);
+
+		int values[100] = {};
+		pool.parallelFor(0, 100, 1, fill, values);
+		TS_ASSERT_EQUALS(values[99], 99);
+	}
+};
@@ -0,0 +1,132 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/archive.h"
+#include "common/memstream.h"
+#include "common/unzip.h"
+#include "common/zlib.h"
+
+class UnzipTestSuite : public CxxTest::TestSuite {
+	enum {
+		// Big enough to be decompressed while it is read
+		kMemberSize = 600 * 1024
+	};
+
+	byte _data[kMemberSize];
+
+	/**
+	 * Build a ZIP archive holding _data as one deflated member. The deflate
+	 * data and the CRC are taken from a gzip stream.
+	 */
+	Common::SeekableReadStream *createArchive(uint32 crcXor) {
+		// The compressor owns the stream it writes to
+		Common::MemoryWriteStreamDynamic *gzip = new Common::MemoryWriteStreamDynamic(DisposeAfterUse::YES);
+		Common::WriteStream *compressor = Common::wrapCompressedWriteStream(gzip);
+		compressor->write(_data, kMemberSize);
+		compressor->finalize();
+
+		// Skip the 10 bytes of the gzip header, and the CRC and size at the end
+		const byte *deflated = gzip->getData() + 10;
+		const uint32 deflatedSize = gzip->size() - 18;
+		const uint32 crc = READ_LE_UINT32(gzip->getData() + gzip->size() - 8) ^ crcXor;
+		const char *name = "big.bin";
+
+		Common::MemoryWriteStreamDynamic zip(DisposeAfterUse::NO);
+		zip.writeUint32LE(0x04034b50);
+		zip.writeUint16LE(20);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(8);
+		zip.writeUint32LE(0);
+		zip.writeUint32LE(crc);
+		zip.writeUint32LE(deflatedSize);
+		zip.writeUint32LE(kMemberSize);
+		zip.writeUint16LE(strlen(name));
+		zip.writeUint16LE(0);
+		zip.write(name, strlen(name));
+		zip.write(deflated, deflatedSize);
+
+		const uint32 centralDirOffset = zip.pos();
+		zip.writeUint32LE(0x02014b50);
+		zip.writeUint16LE(20);
+		zip.writeUint16LE(20);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(8);
+		zip.writeUint32LE(0);
+		zip.writeUint32LE(crc);
+		zip.writeUint32LE(deflatedSize);
+		zip.writeUint32LE(kMemberSize);
+		zip.writeUint16LE(strlen(name));
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint32LE(0);
+		zip.writeUint32LE(0);
+		zip.write(name, strlen(name));
+
+		const uint32 centralDirSize = zip.pos() - centralDirOffset;
+		zip.writeUint32LE(0x06054b50);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(0);
+		zip.writeUint16LE(1);
+		zip.writeUint16LE(1);
+		zip.writeUint32LE(centralDirSize);
+		zip.writeUint32LE(centralDirOffset);
+		zip.writeUint16LE(0);
+
+		delete compressor;
+		return new Common::MemoryReadStream(zip.getData(), zip.size(), DisposeAfterUse::YES);
+	}
+
+public:
+	UnzipTestSuite() {
+		for (uint i = 0; i < kMemberSize; i++)
+			_data[i] = i % 251;
+	}
+
+	void test_streamed_member() {
+#ifdef USE_ZLIB
+		Common::Archive *archive = Common::makeZipArchive(createArchive(0));
+		TS_ASSERT(archive);
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("big.bin");
+		TS_ASSERT(stream);
+		TS_ASSERT_EQUALS(stream->size(), kMemberSize);
+
+		byte *buffer = new byte[kMemberSize];
+		TS_ASSERT_EQUALS(stream->read(buffer, kMemberSize), (uint32)kMemberSize);
+		TS_ASSERT_EQUALS(memcmp(buffer, _data, kMemberSize), 0);
+		TS_ASSERT(!stream->err());
+
+		// Seeking backwards switches to the data inflated in memory
+		TS_ASSERT(stream->seek(1000));
+		TS_ASSERT_EQUALS(stream->read(buffer, 1000), 1000u);
+		TS_ASSERT_EQUALS(memcmp(buffer, _data + 1000, 1000), 0);
+		TS_ASSERT(stream->seek(-10, SEEK_END));
+		TS_ASSERT_EQUALS(stream->readByte(), _data[kMemberSize - 10]);
+		TS_ASSERT(!stream->err());
+
+		delete[] buffer;
+		delete stream;
+		delete archive;
+#endif
+	}
+
+	void test_streamed_member_crc() {
+#ifdef USE_ZLIB
+		Common::Archive *archive = Common::makeZipArchive(createArchive(1));
+		TS_ASSERT(archive);
+		Common::SeekableReadStream *stream = archive->createReadStreamForMember("big.bin");
+		TS_ASSERT(stream);
+
+		// Skipping forward still covers all of the data with the CRC
+		TS_ASSERT(stream->seek(kMemberSize / 2));
+		TS_ASSERT(!stream->err());
+		byte *buffer = new byte[kMemberSize];
+		stream->read(buffer, kMemberSize);
+		TS_ASSERT(stream->err());
+
+		delete[] buffer;
+		delete stream;
+		delete archive;
+#endif
+	}
+};
@@ -0,0 +1,77 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/xmlparser.h"
+
+class CompiledTestXMLParser : public Common::XMLParser {
+public:
+	Common::String _log;
+
+protected:
+	CUSTOM_XML_PARSER(CompiledTestXMLParser) {
+		XML_KEY(layout)
+			XML_PROP(name, true)
+			XML_KEY(widget)
+				XML_PROP(name, true)
+				XML_PROP(size, false)
+			KEY_END()
+		KEY_END()
+	} PARSER_END()
+
+	bool parserCallback_layout(ParserNode *node) {
+		_log += "<" + node->values["name"];
+		node->ignore = node->values["name"] == "ignored";
+		return true;
+	}
+
+	bool parserCallback_widget(ParserNode *node) {
+		_log += " " + node->values["name"];
+		if (node->values.contains("size"))
+			_log += "=" + node->values["size"];
+		return true;
+	}
+
+	bool closedKeyCallback(ParserNode *node) override {
+		if (node->name == "layout")
+			_log += ">";
+		return true;
+	}
+
+	void cleanup() override {
+		_log.clear();
+	}
+};
+
+class XMLParserTestSuite : public CxxTest::TestSuite {
+public:
+	void test_compiled() {
+		static const char xml[] =
+			"<?xml version = '1.0'?>\n"
+			"<layout name = 'main'>\n"
+			"	<widget name = 'button' size = '10, 20'/>\n"
+			"	<!-- comment -->\n"
+			"	<widget name = \"list\"/>\n"
+			"</layout>\n"
+			"<layout name = 'ignored'>\n"
+			"	<widget name = 'hidden'/>\n"
+			"</layout>\n";
+
+		CompiledTestXMLParser parser;
+		Common::MemoryWriteStreamDynamic compiled(DisposeAfterUse::YES);
+		TS_ASSERT(parser.loadBuffer((const byte *)xml, sizeof(xml) - 1));
+		TS_ASSERT(parser.parse(&compiled));
+		parser.close();
+
+		const Common::String expected = "<main button=10, 20 list><ignored";
+		TS_ASSERT_EQUALS(parser._log, expected);
+
+		// Replaying the compiled keys runs the same callbacks
+		Common::MemoryReadStream compiledStream(compiled.getData(), compiled.size());
+		TS_ASSERT(parser.parseCompiled(compiledStream));
+		TS_ASSERT_EQUALS(parser._log, expected);
+
+		// Truncated data is rejected
+		Common::MemoryReadStream truncated(compiled.getData(), compiled.size() - 1);
+		TS_ASSERT(!parser.parseCompiled(truncated));
+	}
+};
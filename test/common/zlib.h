@@ -0,0 +1,36 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/zlib.h"
+
+class ZlibTestSuite : public CxxTest::TestSuite {
+	public:
+	void test_headerless_read() {
+#ifdef USE_ZLIB
+		// Raw deflate data of "ScummVM ScummVM ScummVM ScummVM!"
+		static const byte compressed[] = {
+			0x0b, 0x4e, 0x2e, 0xcd, 0xcd, 0x0d, 0xf3, 0x55,
+			0x08, 0xc6, 0x4e, 0x2b, 0x02, 0x00
+		};
+		const char *expected = "ScummVM ScummVM ScummVM ScummVM!";
+
+		Common::SeekableReadStream *s = Common::wrapHeaderlessCompressedReadStream(
+			new Common::MemoryReadStream(compressed, sizeof(compressed)), 32);
+		TS_ASSERT(s != nullptr);
+		TS_ASSERT_EQUALS(s->size(), 32);
+
+		char buffer[33] = { 0 };
+		TS_ASSERT_EQUALS(s->read(buffer, 8), 8u);
+		TS_ASSERT_EQUALS(s->pos(), 8);
+		TS_ASSERT_EQUALS(s->read(buffer + 8, 24), 24u);
+		TS_ASSERT_EQUALS(Common::String(buffer), expected);
+		TS_ASSERT(!s->err());
+
+		// Seeking backwards restarts the decompression
+		TS_ASSERT(s->seek(8, SEEK_SET));
+		TS_ASSERT_EQUALS(s->readByte(), 'S');
+
+		delete s;
+#endif
+	}
+};
@@ -127,4 +127,38 @@ class U8SortItemTestSuite : public CxxTest::TestSuite {
 		si1._fbigsq = false;
 	}
 
+	/* Items with the same bounding box and sorting flags sort alike */
+	void test_sorts_like() {
+		Ultima::Ultima8::SortItem si1(nullptr);
+		Ultima::Ultima8::SortItem si2(nullptr);
+
+		si1._xLeft = si2._xLeft = 0;
+		si1._x = si2._x = 128;
+		si1._yFar = si2._yFar = 0;
+		si1._y = si2._y = 128;
+		si1._z = si2._z = si1._zTop = si2._zTop = 16;
+		si1._flat = si2._flat = true;
+
+		// Screenspace coords and painting flags are not compared
+		si1._sxBot = 100;
+		si1._clipped = true;
+		si1._itemNum = 42;
+		TS_ASSERT(si1.sortsLike(si2));
+
+		si1._z = 8;
+		TS_ASSERT(!si1.sortsLike(si2));
+		si1._z = 16;
+
+		si1._frame = 1;
+		TS_ASSERT(!si1.sortsLike(si2));
+		si1._frame = 0;
+
+		si1._occl = true;
+		TS_ASSERT(!si1.sortsLike(si2));
+		si1._occl = false;
+
+		si2._sprite = true;
+		TS_ASSERT(!si1.sortsLike(si2));
+	}
+
 };
@@ -0,0 +1,110 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/conversion.h"
+#include "graphics/conversion_intern.h"
+#include "graphics/pixelformat.h"
+#include "../test_random.h"
+
+class ConversionTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 37,
+		kHeight = 3
+	};
+
+	static Graphics::PixelFormat format32(int index) {
+		switch (index) {
+		case 0:
+			// RGBA8888
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0);
+		case 1:
+			// ABGR8888
+			return Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24);
+		case 2:
+			// XRGB8888
+			return Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0);
+		default:
+			// BGRX8888
+			return Graphics::PixelFormat(4, 8, 8, 8, 0, 8, 16, 24, 0);
+		}
+	}
+
+	static uint32 convert(uint32 color, const Graphics::PixelFormat &dstFmt, const Graphics::PixelFormat &srcFmt) {
+		byte a, r, g, b;
+		srcFmt.colorToARGB(color, a, r, g, b);
+		return dstFmt.ARGBToColor(a, r, g, b);
+	}
+
+	static void checkKernels(const Graphics::CrossBlitKernels &kernels) {
+		const Graphics::PixelFormat format565 = Graphics::createPixelFormat<565>();
+		TestRandom rnd(1);
+
+		uint16 src16[kWidth];
+		uint32 src32[kWidth];
+		for (int i = 0; i < kWidth; i++) {
+			src16[i] = rnd.next();
+			src32[i] = rnd.next();
+		}
+
+		// Try all widths, to make sure the leftovers of each block are handled
+		for (uint w = 0; w <= kWidth; w++) {
+			for (int d = 0; d < 4; d++) {
+				const Graphics::PixelFormat dstFmt = format32(d);
+
+				uint32 dst32[kWidth];
+				kernels.convert565To32(dst32, src16, w, dstFmt);
+				for (uint i = 0; i < w; i++)
+					TS_ASSERT_EQUALS(dst32[i], convert(src16[i], dstFmt, format565));
+
+				uint16 dst16[kWidth];
+				kernels.convert32To565(dst16, src32, w, dstFmt);
+				for (uint i = 0; i < w; i++)
+					TS_ASSERT_EQUALS(dst16[i], convert(src32[i], format565, dstFmt));
+
+				for (int s = 0; s < 4; s++) {
+					const Graphics::PixelFormat srcFmt = format32(s);
+
+					kernels.convert32To32(dst32, src32, w, dstFmt, srcFmt);
+					for (uint i = 0; i < w; i++)
+						TS_ASSERT_EQUALS(dst32[i], convert(src32[i], dstFmt, srcFmt));
+				}
+			}
+		}
+	}
+
+public:
+	void test_byte_aligned() {
+		TS_ASSERT(Graphics::isByteAligned32(format32(0)));
+		TS_ASSERT(Graphics::isByteAligned32(format32(2)));
+		TS_ASSERT(!Graphics::isByteAligned32(Graphics::createPixelFormat<565>()));
+		TS_ASSERT(!Graphics::isByteAligned32(Graphics::PixelFormat(4, 10, 10, 10, 2, 22, 12, 2, 0)));
+	}
+
+	void test_scalar_kernels() {
+		checkKernels(Graphics::getScalarCrossBlitKernels());
+	}
+
+	void test_kernels() {
+		checkKernels(Graphics::getCrossBlitKernels());
+	}
+
+	void test_cross_blit_in_place() {
+		const Graphics::PixelFormat format565 = Graphics::createPixelFormat<565>();
+		const Graphics::PixelFormat dstFmt = format32(0);
+		const uint pitch = kWidth * 4;
+
+		uint32 buffer[kWidth * kHeight];
+		uint16 src[kWidth * kHeight];
+		TestRandom rnd(7);
+		for (int i = 0; i < kWidth * kHeight; i++)
+			src[i] = rnd.next();
+
+		// Store the 16-bit rows with the pitch of the 32-bit surface
+		for (int y = 0; y < kHeight; y++)
+			memcpy((byte *)buffer + y * pitch, src + y * kWidth, kWidth * 2);
+
+		TS_ASSERT(Graphics::crossBlit((byte *)buffer, (const byte *)buffer, pitch, pitch, kWidth, kHeight, dstFmt, format565));
+
+		for (int i = 0; i < kWidth * kHeight; i++)
+			TS_ASSERT_EQUALS(buffer[i], convert(src[i], dstFmt, format565));
+	}
+};
@@ -0,0 +1,113 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+#include "graphics/managed_surface_intern.h"
+#include "../test_random.h"
+
+class ManagedSurfaceTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 37
+	};
+
+	static void checkKernels(const Graphics::TransBlitKernels &kernels) {
+		const Graphics::TransBlitKernels &scalar = Graphics::getScalarTransBlitKernels();
+		TestRandom rnd(1);
+
+		// Use few distinct values, so that the transparent color is common
+		uint32 src[kWidth], dst[kWidth];
+		for (int i = 0; i < kWidth; i++) {
+			src[i] = (rnd.next() & 3) * 0x01010101 * 85;
+			dst[i] = rnd.next();
+		}
+
+		// Try all widths, to make sure the leftovers of each block are handled
+		for (uint w = 0; w <= kWidth; w++) {
+			byte expected8[kWidth], result8[kWidth];
+			memcpy(expected8, dst, sizeof(expected8));
+			memcpy(result8, dst, sizeof(result8));
+			scalar.transRow8(expected8, (const byte *)src, w, 85);
+			kernels.transRow8(result8, (const byte *)src, w, 85);
+			TS_ASSERT_EQUALS(memcmp(result8, expected8, sizeof(result8)), 0);
+
+			memcpy(expected8, dst, sizeof(expected8));
+			memcpy(result8, dst, sizeof(result8));
+			scalar.maskRow8(expected8, (const byte *)dst + 1, (const byte *)src, w, 0);
+			kernels.maskRow8(result8, (const byte *)dst + 1, (const byte *)src, w, 0);
+			TS_ASSERT_EQUALS(memcmp(result8, expected8, sizeof(result8)), 0);
+
+			uint16 expected16[kWidth], result16[kWidth];
+			memcpy(expected16, dst, sizeof(expected16));
+			memcpy(result16, dst, sizeof(result16));
+			scalar.transRow16(expected16, (const uint16 *)src, w, 0x5555, 0x7fff);
+			kernels.transRow16(result16, (const uint16 *)src, w, 0x5555, 0x7fff);
+			TS_ASSERT_EQUALS(memcmp(result16, expected16, sizeof(result16)), 0);
+
+			uint32 expected32[kWidth], result32[kWidth];
+			memcpy(expected32, dst, sizeof(expected32));
+			memcpy(result32, dst, sizeof(result32));
+			scalar.transRow32(expected32, src, w, 0xaaaaaaaa, 0x00ffffff);
+			kernels.transRow32(result32, src, w, 0xaaaaaaaa, 0x00ffffff);
+			TS_ASSERT_EQUALS(memcmp(result32, expected32, sizeof(result32)), 0);
+		}
+	}
+
+public:
+	void test_scalar_kernels() {
+		checkKernels(Graphics::getScalarTransBlitKernels());
+	}
+
+	void test_kernels() {
+		checkKernels(Graphics::getTransBlitKernels());
+	}
+
+	void test_trans_blit_clipped() {
+		Graphics::ManagedSurface src(23, 11);
+		Graphics::ManagedSurface dest(20, 16);
+		TestRandom rnd(5);
+
+		for (int y = 0; y < src.h; y++)
+			for (int x = 0; x < src.w; x++)
+				src.setPixel(x, y, rnd.next() & 3);
+		for (int y = 0; y < dest.h; y++)
+			for (int x = 0; x < dest.w; x++)
+				dest.setPixel(x, y, 10 + x + y);
+
+		const Common::Point destPos(-4, 9);
+		dest.transBlitFrom(src, destPos, 0);
+
+		for (int y = 0; y < dest.h; y++) {
+			for (int x = 0; x < dest.w; x++) {
+				const int srcX = x - destPos.x, srcY = y - destPos.y;
+				uint32 expected = 10 + x + y;
+				if (srcX >= 0 && srcX < src.w && srcY >= 0 && srcY < src.h && src.getPixel(srcX, srcY) != 0)
+					expected = src.getPixel(srcX, srcY);
+				TS_ASSERT_EQUALS(dest.getPixel(x, y), expected);
+			}
+		}
+	}
+
+	void test_blit_without_alpha() {
+		// RGB555 does not use the top bit, which must not be copied
+		const Graphics::PixelFormat format(2, 5, 5, 5, 0, 10, 5, 0, 0);
+		Graphics::ManagedSurface src(9, 4, format);
+		Graphics::ManagedSurface dest(8, 8, format);
+		TestRandom rnd(9);
+
+		for (int y = 0; y < src.h; y++)
+			for (int x = 0; x < src.w; x++)
+				src.setPixel(x, y, rnd.next() & 0xffff);
+		dest.clear(0x1234);
+
+		dest.blitFrom(src, Common::Point(2, -1));
+
+		for (int y = 0; y < dest.h; y++) {
+			for (int x = 0; x < dest.w; x++) {
+				const int srcX = x - 2, srcY = y + 1;
+				uint32 expected = 0x1234;
+				if (srcX >= 0 && srcX < src.w && srcY >= 0 && srcY < src.h)
+					expected = src.getPixel(srcX, srcY) & 0x7fff;
+				TS_ASSERT_EQUALS(dest.getPixel(x, y), expected);
+			}
+		}
+	}
+};
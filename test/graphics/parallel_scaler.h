@@ -0,0 +1,65 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/scalerplugin.h"
+#include "graphics/scaler/dotmatrix.h"
+#include "graphics/scaler/hq.h"
+#include "../test_random.h"
+
+class ParallelScalerTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 60,
+		kHeight = 100,
+		kPadding = 3,
+		kSrcPitch = (kWidth + 2 * kPadding) * 2,
+		kMaxFactor = 3,
+		kDstPitch = kWidth * kMaxFactor * 2
+	};
+
+	uint16 _src[(kHeight + 2 * kPadding) * (kWidth + 2 * kPadding)];
+	uint16 _expected[kHeight * kMaxFactor * kWidth * kMaxFactor];
+	uint16 _actual[kHeight * kMaxFactor * kWidth * kMaxFactor];
+
+	void fill() {
+		// Large flat areas with a few edges, so the scalers have something
+		// to interpolate
+		TestRandom rnd(7);
+		for (int i = 0; i < ARRAYSIZE(_src); i++) {
+			const uint16 color = rnd.next();
+			_src[i] = ((i / 5) % 3 == 0) ? color : 0xF800;
+		}
+	}
+
+	void checkScaler(Scaler &scaler, int x, int y, int w, int h) {
+		fill();
+		memset(_expected, 0, sizeof(_expected));
+		memset(_actual, 0, sizeof(_actual));
+
+		const uint8 *srcPtr = (const uint8 *)_src + (y + kPadding) * kSrcPitch + (x + kPadding) * 2;
+		scaler.scale(srcPtr, kSrcPitch, (uint8 *)_expected, kDstPitch, w, h, x, y);
+
+		ParallelScaler::scale(scaler, srcPtr, kSrcPitch, (uint8 *)_actual, kDstPitch, w, h, x, y);
+
+		TS_ASSERT_SAME_DATA(_expected, _actual, sizeof(_actual));
+	}
+
+public:
+	void test_dotmatrix() {
+		DotMatrixScaler scaler(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		scaler.setFactor(2);
+
+		// Start at an odd row, since the pattern depends on the row
+		checkScaler(scaler, 0, 0, kWidth, kHeight);
+		checkScaler(scaler, 3, 5, kWidth - 5, kHeight - 17);
+	}
+
+#ifdef USE_HQ_SCALERS
+	void test_hq() {
+		HQScaler scaler(Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0));
+		for (uint factor = 2; factor <= 3; factor++) {
+			scaler.setFactor(factor);
+			checkScaler(scaler, 0, 0, kWidth, kHeight);
+			checkScaler(scaler, 7, 9, kWidth - 10, kHeight - 21);
+		}
+	}
+#endif
+};
@@ -0,0 +1,77 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/screen.h"
+
+class ScreenTestSuite : public CxxTest::TestSuite {
+	class TestScreen : public Graphics::Screen {
+	public:
+		TestScreen() : Graphics::Screen(320, 200) {
+			clearDirtyRects();
+		}
+
+		const Common::List<Common::Rect> &mergedRects() {
+			mergeDirtyRects();
+			return _dirtyRects;
+		}
+
+		int coveredPixels(int x, int y) {
+			int count = 0;
+			for (Common::List<Common::Rect>::const_iterator i = _dirtyRects.begin(); i != _dirtyRects.end(); ++i) {
+				if (i->contains(x, y))
+					count++;
+			}
+			return count;
+		}
+	};
+
+public:
+	void test_merge_overlapping() {
+		TestScreen screen;
+		screen.addDirtyRect(Common::Rect(10, 10, 50, 50));
+		screen.addDirtyRect(Common::Rect(40, 40, 60, 60));
+
+		const Common::List<Common::Rect> &rects = screen.mergedRects();
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT(rects.front() == Common::Rect(10, 10, 60, 60));
+	}
+
+	void test_merge_nearby() {
+		TestScreen screen;
+		// Copying the gap between these is cheaper than two copies
+		screen.addDirtyRect(Common::Rect(10, 10, 20, 20));
+		screen.addDirtyRect(Common::Rect(22, 10, 30, 20));
+		// These are too far apart
+		screen.addDirtyRect(Common::Rect(0, 150, 10, 160));
+		screen.addDirtyRect(Common::Rect(300, 150, 310, 160));
+
+		const Common::List<Common::Rect> &rects = screen.mergedRects();
+		TS_ASSERT_EQUALS(rects.size(), 3u);
+		TS_ASSERT(rects.front() == Common::Rect(10, 10, 30, 20));
+	}
+
+	void test_full_screen() {
+		TestScreen screen;
+		screen.addDirtyRect(Common::Rect(0, 0, 320, 90));
+		screen.addDirtyRect(Common::Rect(0, 110, 320, 200));
+
+		const Common::List<Common::Rect> &rects = screen.mergedRects();
+		TS_ASSERT_EQUALS(rects.size(), 1u);
+		TS_ASSERT(rects.front() == Common::Rect(0, 0, 320, 200));
+	}
+
+	void test_many_rects() {
+		TestScreen screen;
+		// A dotted line of single pixels, too many to merge one by one
+		for (int x = 0; x < 300; x += 3)
+			screen.addDirtyRect(Common::Rect(x, 100, x + 1, 101));
+		screen.addDirtyRect(Common::Rect(5, 5, 6, 6));
+
+		const Common::List<Common::Rect> &rects = screen.mergedRects();
+		TS_ASSERT_LESS_THAN_EQUALS(rects.size(), 2u);
+
+		// Every dirty pixel is still copied, and only once
+		for (int x = 0; x < 300; x += 3)
+			TS_ASSERT_EQUALS(screen.coveredPixels(x, 100), 1);
+		TS_ASSERT_EQUALS(screen.coveredPixels(5, 5), 1);
+	}
+};
@@ -0,0 +1,74 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/managed_surface.h"
+#include "graphics/svg.h"
+
+class SVGRasterCacheTestSuite : public CxxTest::TestSuite {
+	static Graphics::ManagedSurface *createRaster(int w, int h, uint32 color) {
+		Graphics::ManagedSurface *surf = new Graphics::ManagedSurface(w, h, Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		surf->fillRect(Common::Rect(w, h), color);
+		return surf;
+	}
+
+	static bool hasRaster(Graphics::SVGRasterCache &cache, const char *name, int w, int h, uint32 color) {
+		Graphics::ManagedSurface *surf = cache.get(name, w, h);
+		if (!surf)
+			return false;
+
+		const bool result = surf->w == w && surf->h == h && surf->getPixel(w - 1, h - 1) == color;
+		delete surf;
+		return result;
+	}
+
+public:
+	void test_sizes() {
+		Graphics::SVGRasterCache cache(1024 * 1024);
+
+		Graphics::ManagedSurface *small = createRaster(8, 8, 1);
+		Graphics::ManagedSurface *large = createRaster(16, 16, 2);
+		cache.put("icon", *small);
+		cache.put("icon", *large);
+		delete small;
+		delete large;
+
+		// Each size is kept apart, and the caller gets a copy of its own
+		TS_ASSERT(hasRaster(cache, "icon", 8, 8, 1));
+		TS_ASSERT(hasRaster(cache, "icon", 16, 16, 2));
+		TS_ASSERT(hasRaster(cache, "icon", 16, 16, 2));
+		TS_ASSERT(!cache.get("icon", 8, 16));
+		TS_ASSERT(!cache.get("other", 8, 8));
+
+		cache.clear();
+		TS_ASSERT(!cache.get("icon", 8, 8));
+	}
+
+	void test_eviction() {
+		// Room for two 16x16 rasters
+		Graphics::SVGRasterCache cache(2 * 16 * 16 * 4);
+
+		Graphics::ManagedSurface *raster = createRaster(16, 16, 3);
+		cache.put("a", *raster);
+		cache.put("b", *raster);
+		TS_ASSERT(hasRaster(cache, "a", 16, 16, 3));
+
+		// "b" is the least recently used one
+		cache.put("c", *raster);
+		TS_ASSERT(hasRaster(cache, "a", 16, 16, 3));
+		TS_ASSERT(!cache.get("b", 16, 16));
+		TS_ASSERT(hasRaster(cache, "c", 16, 16, 3));
+
+		// Replacing a raster doesn't count it twice
+		cache.put("c", *raster);
+		TS_ASSERT(hasRaster(cache, "a", 16, 16, 3));
+		TS_ASSERT(hasRaster(cache, "c", 16, 16, 3));
+
+		// Rasters larger than the cache are not kept
+		Graphics::ManagedSurface *huge = createRaster(64, 64, 4);
+		cache.put("huge", *huge);
+		TS_ASSERT(!cache.get("huge", 64, 64));
+		TS_ASSERT(hasRaster(cache, "a", 16, 16, 3));
+
+		delete huge;
+		delete raster;
+	}
+};
@@ -0,0 +1,118 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/pixelformat.h"
+#include "../test_random.h"
+
+#ifdef USE_TINYGL
+#include "graphics/tinygl/tinygl.h"
+#include "graphics/tinygl/zgl.h"
+#endif
+
+class TinyGLTrianglesTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 157,
+		kHeight = 93,
+		kTextureSize = 32,
+		kTriangleCount = 24
+	};
+
+#ifdef USE_TINYGL
+	void drawTriangles(TestRandom &rnd) {
+		tglBegin(TGL_TRIANGLES);
+		for (int i = 0; i < 3 * kTriangleCount; i++) {
+			tglColor4f(rnd.nextFloat(0.0f, 1.0f), rnd.nextFloat(0.0f, 1.0f), rnd.nextFloat(0.0f, 1.0f), rnd.nextFloat(0.0f, 1.0f));
+			tglTexCoord2f(rnd.nextFloat(-1.0f, 2.0f), rnd.nextFloat(-1.0f, 2.0f));
+			tglVertex3f(rnd.nextFloat(-1.2f, 1.2f), rnd.nextFloat(-1.2f, 1.2f), rnd.nextFloat(-1.0f, 1.0f));
+		}
+		tglEnd();
+	}
+
+	void drawScene(const Graphics::PixelFormat &format, bool spanKernels, Common::Array<byte> &color, Common::Array<uint> &depth) {
+		TinyGL::createContext(kWidth, kHeight, format, kTextureSize, false, false);
+		TinyGL::FrameBuffer *fb = TinyGL::gl_get_context()->fb;
+		fb->enableSpanKernels(spanKernels);
+
+		TestRandom rnd(1);
+
+		byte texels[kTextureSize * kTextureSize * 4];
+		for (uint i = 0; i < sizeof(texels); i++)
+			texels[i] = rnd.nextFloat(0.0f, 1.0f) * 255;
+
+		TGLuint textures[2];
+		tglGenTextures(2, textures);
+		for (int i = 0; i < 2; i++) {
+			const TGLint filter = i ? TGL_LINEAR : TGL_NEAREST;
+			tglBindTexture(TGL_TEXTURE_2D, textures[i]);
+			tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MIN_FILTER, filter);
+			tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_MAG_FILTER, filter);
+			tglTexParameteri(TGL_TEXTURE_2D, TGL_TEXTURE_WRAP_S, i ? TGL_MIRRORED_REPEAT : TGL_REPEAT);
+			tglTexImage2D(TGL_TEXTURE_2D, 0, TGL_RGBA, kTextureSize, kTextureSize, 0, TGL_RGBA, TGL_UNSIGNED_BYTE, texels);
+		}
+
+		tglClearColor(0.25f, 0.5f, 0.75f, 1.0f);
+		tglClearDepth(1.0);
+		tglClear(TGL_COLOR_BUFFER_BIT | TGL_DEPTH_BUFFER_BIT);
+		tglEnable(TGL_DEPTH_TEST);
+
+		static const TGLenum depthFuncs[] = { TGL_LESS, TGL_LEQUAL, TGL_GREATER, TGL_GEQUAL, TGL_NOTEQUAL, TGL_ALWAYS };
+		for (int i = 0; i < ARRAYSIZE(depthFuncs); i++) {
+			tglDepthFunc(depthFuncs[i]);
+			tglDepthMask(i != 3);
+
+			// The scissor rectangle is only used internally, for the dirty rects
+			if (i == 4)
+				fb->setScissorRectangle(Common::Rect(13, 7, 131, 80));
+
+			tglEnable(TGL_TEXTURE_2D);
+			tglBindTexture(TGL_TEXTURE_2D, textures[i & 1]);
+			tglShadeModel(TGL_SMOOTH);
+			drawTriangles(rnd);
+			tglShadeModel(TGL_FLAT);
+			drawTriangles(rnd);
+			tglDisable(TGL_TEXTURE_2D);
+
+			tglColorMask(TGL_FALSE, TGL_FALSE, TGL_FALSE, TGL_FALSE);
+			drawTriangles(rnd);
+			tglColorMask(TGL_TRUE, TGL_TRUE, TGL_TRUE, TGL_TRUE);
+
+			// Without depth test, the rasterizer takes other paths
+			tglDisable(TGL_DEPTH_TEST);
+			tglEnable(TGL_TEXTURE_2D);
+			drawTriangles(rnd);
+			tglDisable(TGL_TEXTURE_2D);
+			tglEnable(TGL_DEPTH_TEST);
+		}
+		fb->resetScissorRectangle();
+
+		TinyGL::presentBuffer();
+		color = Common::Array<byte>(fb->getPixelBuffer(), kWidth * kHeight * format.bytesPerPixel);
+		depth = Common::Array<uint>(fb->getZBuffer(), kWidth * kHeight);
+
+		tglDeleteTextures(2, textures);
+		TinyGL::destroyContext();
+	}
+
+	void checkFormat(const Graphics::PixelFormat &format) {
+		Common::Array<byte> color, expectedColor;
+		Common::Array<uint> depth, expectedDepth;
+		drawScene(format, false, expectedColor, expectedDepth);
+		drawScene(format, true, color, depth);
+
+		TS_ASSERT(color == expectedColor);
+		TS_ASSERT(depth == expectedDepth);
+	}
+#endif
+
+public:
+	void test_rgba8888() {
+#ifdef USE_TINYGL
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+#endif
+	}
+
+	void test_rgb565() {
+#ifdef USE_TINYGL
+		checkFormat(Graphics::createPixelFormat<565>());
+#endif
+	}
+};
@@ -0,0 +1,116 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/transparent_surface.h"
+#include "graphics/transparent_surface_intern.h"
+#include "../test_random.h"
+
+class TransparentSurfaceTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 37
+	};
+
+	static void fillRandom(Graphics::Surface &surface, TestRandom &rnd) {
+		for (int y = 0; y < surface.h; y++) {
+			uint32 *row = (uint32 *)surface.getBasePtr(0, y);
+			for (int x = 0; x < surface.w; x++) {
+				row[x] = rnd.next();
+				// Make sure there are fully transparent and opaque pixels
+				if ((x % 5) == 1)
+					row[x] &= ~(0xFFu << (Graphics::kAIndex * 8));
+				else if ((x % 5) == 2)
+					row[x] |= 0xFFu << (Graphics::kAIndex * 8);
+			}
+		}
+	}
+
+	static void checkKernels(const Graphics::TransparentBlitKernels &kernels) {
+		const Graphics::TransparentBlitKernels &scalar = Graphics::getScalarTransparentBlitKernels();
+		const uint32 colors[] = { TS_ARGB(128, 255, 255, 255), TS_ARGB(255, 10, 200, 255), TS_ARGB(1, 255, 0, 255) };
+		TestRandom rnd(1);
+
+		uint32 src[kWidth], dst[kWidth];
+		for (int i = 0; i < kWidth; i++) {
+			src[i] = rnd.next();
+			dst[i] = rnd.next();
+			if ((i % 5) == 1)
+				src[i] &= ~(0xFFu << (Graphics::kAIndex * 8));
+		}
+
+		// Try all widths, to make sure the leftovers of each block are handled
+		for (uint w = 0; w <= kWidth; w++) {
+			for (int flip = 0; flip < 2; flip++) {
+				const byte *in = flip ? (const byte *)(src + kWidth - 1) : (const byte *)src;
+				const int32 inStep = flip ? -4 : 4;
+				uint32 expected[kWidth], result[kWidth];
+
+				memcpy(expected, dst, sizeof(dst));
+				memcpy(result, dst, sizeof(dst));
+				scalar.blendRow((byte *)expected, in, w, inStep);
+				kernels.blendRow((byte *)result, in, w, inStep);
+				for (uint i = 0; i < kWidth; i++)
+					TS_ASSERT_EQUALS(result[i], expected[i]);
+
+				for (uint c = 0; c < ARRAYSIZE(colors); c++) {
+					memcpy(expected, dst, sizeof(dst));
+					memcpy(result, dst, sizeof(dst));
+					scalar.blendRowTinted((byte *)expected, in, w, inStep, colors[c]);
+					kernels.blendRowTinted((byte *)result, in, w, inStep, colors[c]);
+					for (uint i = 0; i < kWidth; i++)
+						TS_ASSERT_EQUALS(result[i], expected[i]);
+				}
+			}
+		}
+	}
+
+public:
+	void test_scalar_kernels() {
+		checkKernels(Graphics::getScalarTransparentBlitKernels());
+	}
+
+	void test_kernels() {
+		checkKernels(Graphics::getTransparentBlitKernels());
+	}
+
+	void test_scaled_blit() {
+		const Graphics::PixelFormat format = Graphics::TransparentSurface::getSupportedPixelFormat();
+		TestRandom rnd(3);
+
+		Graphics::TransparentSurface source;
+		source.create(23, 17, format);
+		fillRandom(source, rnd);
+
+		Graphics::Surface background;
+		background.create(40, 30, format);
+		fillRandom(background, rnd);
+
+		Graphics::Surface expected, result;
+		const int positions[][2] = { { 5, 4 }, { -7, -3 }, { 30, 20 } };
+		const int sizes[][2] = { { 46, 34 }, { 12, 9 }, { 300, 5 } };
+
+		// Blitting while scaling matches blitting a scaled copy of the image
+		for (int p = 0; p < ARRAYSIZE(positions); p++) {
+			for (int s = 0; s < ARRAYSIZE(sizes); s++) {
+				for (int flipping = 0; flipping < 4; flipping++) {
+					Graphics::TransparentSurface *scaled = source.scale(sizes[s][0], sizes[s][1]);
+
+					expected.copyFrom(background);
+					result.copyFrom(background);
+					Common::Rect expectedRect = scaled->blit(expected, positions[p][0], positions[p][1], flipping, nullptr, TS_ARGB(200, 255, 128, 255));
+					Common::Rect resultRect = source.blit(result, positions[p][0], positions[p][1], flipping, nullptr, TS_ARGB(200, 255, 128, 255), sizes[s][0], sizes[s][1]);
+
+					TS_ASSERT_EQUALS(resultRect.width(), expectedRect.width());
+					TS_ASSERT_EQUALS(resultRect.height(), expectedRect.height());
+					TS_ASSERT_EQUALS(memcmp(result.getPixels(), expected.getPixels(), result.pitch * result.h), 0);
+
+					expected.free();
+					result.free();
+					scaled->free();
+					delete scaled;
+				}
+			}
+		}
+
+		background.free();
+		source.free();
+	}
+};
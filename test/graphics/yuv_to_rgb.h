@@ -0,0 +1,102 @@
+#include <cxxtest/TestSuite.h>
+
+#include "graphics/surface.h"
+#include "graphics/yuv_to_rgb.h"
+#include "../test_random.h"
+
+class YUVToRGBTestSuite : public CxxTest::TestSuite {
+	enum {
+		kWidth = 38,
+		kHeight = 70,
+		kPitch = 40
+	};
+
+	byte _y[kPitch * kHeight];
+	byte _u[kPitch * kHeight];
+	byte _v[kPitch * kHeight];
+
+	void fill() {
+		TestRandom rnd(3);
+		for (int i = 0; i < kPitch * kHeight; i++) {
+			const uint32 r = rnd.next();
+			_y[i] = r >> 24;
+			_u[i] = r >> 16;
+			_v[i] = r >> 8;
+		}
+
+		// Make sure the clipping gets exercised
+		_y[0] = 0;
+		_u[0] = 0;
+		_v[0] = 0;
+		_y[1] = 255;
+		_u[1] = 255;
+		_v[1] = 255;
+	}
+
+	static byte component(int value, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		if (scale == Graphics::YUVToRGBManager::kScaleFull)
+			return CLIP(value, 0, 255);
+
+		return (CLIP(value, 16, 235) - 16) * 255 / 219;
+	}
+
+	static uint32 reference(byte y, byte u, byte v, const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale) {
+		const int cr = v - 128;
+		const int cb = u - 128;
+
+		const byte r = component(y + (int16)((0.419 / 0.299) * cr), scale);
+		const byte g = component(y + (int16)(-(0.299 / 0.419) * cr) + (int16)(-(0.114 / 0.331) * cb), scale);
+		const byte b = component(y + (int16)((0.587 / 0.331) * cb), scale);
+		return format.ARGBToColor(255, r, g, b);
+	}
+
+	void check(const Graphics::PixelFormat &format, Graphics::YUVToRGBManager::LuminanceScale scale, bool is420) {
+		Graphics::Surface surface;
+		surface.create(kWidth, kHeight, format);
+
+		if (is420)
+			YUVToRGBMan.convert420(&surface, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+		else
+			YUVToRGBMan.convert444(&surface, scale, _y, _u, _v, kWidth, kHeight, kPitch, kPitch);
+
+		for (int y = 0; y < kHeight; y++) {
+			for (int x = 0; x < kWidth; x++) {
+				const int uv = is420 ? (y / 2) * kPitch + x / 2 : y * kPitch + x;
+				const uint32 expected = reference(_y[y * kPitch + x], _u[uv], _v[uv], format, scale);
+
+				if (format.bytesPerPixel == 2) {
+					TS_ASSERT_EQUALS(*(const uint16 *)surface.getBasePtr(x, y), expected);
+				} else {
+					TS_ASSERT_EQUALS(*(const uint32 *)surface.getBasePtr(x, y), expected);
+				}
+			}
+		}
+
+		surface.free();
+	}
+
+	void checkFormat(const Graphics::PixelFormat &format) {
+		fill();
+		check(format, Graphics::YUVToRGBManager::kScaleFull, false);
+		check(format, Graphics::YUVToRGBManager::kScaleITU, false);
+		check(format, Graphics::YUVToRGBManager::kScaleFull, true);
+		check(format, Graphics::YUVToRGBManager::kScaleITU, true);
+	}
+
+public:
+	void test_rgb565() {
+		checkFormat(Graphics::createPixelFormat<565>());
+	}
+
+	void test_argb8888() {
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24));
+	}
+
+	void test_xbgr8888() {
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 0, 0, 8, 16, 0));
+	}
+
+	void test_rgba8888() {
+		checkFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+	}
+};
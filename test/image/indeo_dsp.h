@@ -0,0 +1,93 @@
+#include <cxxtest/TestSuite.h>
+
+#include "image/codecs/indeo/indeo_dsp_intern.h"
+#include "../test_random.h"
+
+class IndeoDSPTestSuite : public CxxTest::TestSuite {
+	enum {
+		kBlocks = 64,
+		kPitch = 24
+	};
+
+	// Checksum of the output of the portable routines
+	static const uint32 kChecksum = 2170717519u;
+
+	static uint32 checksum(uint32 sum, const int16 *data, int count) {
+		for (int i = 0; i < count; i++)
+			sum = sum * 31 + (uint16)data[i];
+		return sum;
+	}
+
+	/** Run all routines on pseudo-random blocks and return a checksum of the output. */
+	static uint32 runKernels(const Image::Indeo::IndeoDSPKernels &kernels, const Image::Indeo::IndeoDSPKernels &reference) {
+		TestRandom rnd(1);
+		uint32 sum = 0;
+
+		for (int block = 0; block < kBlocks; block++) {
+			int32 in[64];
+			uint8 flags[8];
+			for (int i = 0; i < 64; i++) {
+				// Mostly small coefficients, with the occasional huge one
+				// to check that overflows wrap the same way
+				const uint32 r = rnd.next();
+				in[i] = (r & 0xF) ? (int32)(r >> 8) % 2048 : (int32)r;
+			}
+			for (int i = 0; i < 8; i++)
+				flags[i] = (block & 1) ? rnd.next() & 1 : 1;
+
+			int16 out[8 * kPitch], expected[8 * kPitch];
+			for (int transform = 0; transform < 2; transform++) {
+				for (int i = 0; i < 8 * kPitch; i++)
+					out[i] = expected[i] = (int16)i;
+
+				if (transform == 0) {
+					kernels.inverseHaar8x8(in, out, kPitch, flags);
+					reference.inverseHaar8x8(in, expected, kPitch, flags);
+				} else {
+					kernels.inverseSlant8x8(in, out, kPitch, flags);
+					reference.inverseSlant8x8(in, expected, kPitch, flags);
+				}
+
+				for (int i = 0; i < 8 * kPitch; i++)
+					TS_ASSERT_EQUALS(out[i], expected[i]);
+				sum = checksum(sum, out, 8 * kPitch);
+			}
+
+			int16 ref[kPitch * 10];
+			for (int i = 0; i < kPitch * 10; i++)
+				ref[i] = rnd.next();
+
+			for (int mcType = 0; mcType < 5; mcType++) {
+				for (int delta = 0; delta < 2; delta++) {
+					for (int i = 0; i < 8 * kPitch; i++)
+						out[i] = expected[i] = rnd.next();
+
+					const int16 *refBuf = ref + (block % 3);
+					if (delta) {
+						kernels.mc8x8Delta(out, kPitch, refBuf, kPitch, mcType);
+						reference.mc8x8Delta(expected, kPitch, refBuf, kPitch, mcType);
+					} else {
+						kernels.mc8x8NoDelta(out, kPitch, refBuf, kPitch, mcType);
+						reference.mc8x8NoDelta(expected, kPitch, refBuf, kPitch, mcType);
+					}
+
+					for (int i = 0; i < 8 * kPitch; i++)
+						TS_ASSERT_EQUALS(out[i], expected[i]);
+					sum = checksum(sum, out, 8 * kPitch);
+				}
+			}
+		}
+
+		return sum;
+	}
+
+public:
+	void test_scalar_kernels() {
+		const Image::Indeo::IndeoDSPKernels &scalar = Image::Indeo::getScalarIndeoDSPKernels();
+		TS_ASSERT_EQUALS(runKernels(scalar, scalar), kChecksum);
+	}
+
+	void test_kernels() {
+		TS_ASSERT_EQUALS(runKernels(Image::Indeo::getIndeoDSPKernels(), Image::Indeo::getScalarIndeoDSPKernels()), kChecksum);
+	}
+};
@@ -0,0 +1,85 @@
+#include <cxxtest/TestSuite.h>
+
+#if defined(HAVE_CONFIG_H)
+#include "config.h"
+#endif
+
+#include "common/memstream.h"
+#include "image/png.h"
+#include "graphics/surface.h"
+
+class PNGDecoderTestSuite : public CxxTest::TestSuite {
+public:
+	void test_output_pixel_format() {
+#ifdef USE_PNG
+		const Graphics::PixelFormat formats[] = {
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 0, 8, 16, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 16, 8, 0, 24),
+			Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0),
+			Graphics::PixelFormat(4, 8, 8, 8, 0, 16, 8, 0, 0),
+			Graphics::PixelFormat(2, 5, 6, 5, 0, 11, 5, 0, 0),
+			Graphics::PixelFormat(2, 4, 4, 4, 4, 12, 8, 4, 0),
+#ifdef SCUMM_BIG_ENDIAN
+			Graphics::PixelFormat(3, 8, 8, 8, 0, 0, 8, 16, 0)
+#else
+			Graphics::PixelFormat(3, 8, 8, 8, 0, 16, 8, 0, 0)
+#endif
+		};
+
+#ifdef SCUMM_BIG_ENDIAN
+		const Graphics::PixelFormat rgbFormat(3, 8, 8, 8, 0, 16, 8, 0, 0);
+#else
+		const Graphics::PixelFormat rgbFormat(3, 8, 8, 8, 0, 0, 8, 16, 0);
+#endif
+
+		for (int alpha = 0; alpha < 2; alpha++) {
+			// Without alpha, the image is stored as RGB
+			Graphics::Surface source;
+			source.create(7, 5, alpha ? Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0) : rgbFormat);
+			for (int y = 0; y < source.h; y++) {
+				byte *pixel = (byte *)source.getBasePtr(0, y);
+				for (int x = 0; x < source.w; x++) {
+					const uint32 color = source.format.ARGBToColor(x * 40, x * 30, y * 50, (x * y) * 7);
+					if (alpha)
+						WRITE_UINT32(pixel, color);
+					else
+						WRITE_UINT24(pixel, color);
+					pixel += source.format.bytesPerPixel;
+				}
+			}
+
+			Common::MemoryWriteStreamDynamic encoded(DisposeAfterUse::YES);
+			TS_ASSERT(Image::writePNG(encoded, source));
+
+			Image::PNGDecoder reference;
+			Common::MemoryReadStream referenceStream(encoded.getData(), encoded.size());
+			TS_ASSERT(reference.loadStream(referenceStream));
+
+			for (uint i = 0; i < ARRAYSIZE(formats); i++) {
+				Image::PNGDecoder decoder;
+				decoder.setOutputPixelFormat(formats[i]);
+				Common::MemoryReadStream stream(encoded.getData(), encoded.size());
+				TS_ASSERT(decoder.loadStream(stream));
+
+				const Graphics::Surface *surface = decoder.getSurface();
+				TS_ASSERT(surface->format == formats[i]);
+
+				Graphics::Surface *expected = reference.getSurface()->convertTo(formats[i]);
+				for (int y = 0; y < surface->h; y++) {
+					for (int x = 0; x < surface->w; x++) {
+						uint32 mask = 0xffffffff;
+						if (formats[i].aLoss == 8)
+							mask = formats[i].RGBToColor(0xff, 0xff, 0xff);
+						TS_ASSERT_EQUALS(surface->getPixel(x, y) & mask, expected->getPixel(x, y) & mask);
+					}
+				}
+				expected->free();
+				delete expected;
+			}
+
+			source.free();
+		}
+#endif
+	}
+};
@@ -0,0 +1,115 @@
+#include <cxxtest/TestSuite.h>
+
+#include "math/matrix4.h"
+#include "math/matrix4_intern.h"
+#include "../test_random.h"
+
+class Matrix4TestSuite : public CxxTest::TestSuite {
+	enum {
+		kPoints = 7
+	};
+
+	static void fill(float *values, uint count, TestRandom &rnd) {
+		for (uint i = 0; i < count; i++)
+			values[i] = rnd.nextFloat(-4.0f, 4.0f);
+	}
+
+	static bool near(float a, float b) {
+		return fabs(a - b) <= 0.001f * MAX(1.0f, fabs(b));
+	}
+
+	static void checkKernels(const Math::Matrix4Kernels &kernels) {
+		const Math::Matrix4Kernels &scalar = Math::getScalarMatrix4Kernels();
+		TestRandom rnd(1);
+
+		for (int n = 0; n < 20; n++) {
+			float m1[16], m2[16], expected[16], result[16];
+			fill(m1, 16, rnd);
+			fill(m2, 16, rnd);
+
+			scalar.multiply(expected, m1, m2);
+			kernels.multiply(result, m1, m2);
+			for (int i = 0; i < 16; i++)
+				TS_ASSERT(near(result[i], expected[i]));
+
+			TS_ASSERT(scalar.inverse(expected, m1));
+			TS_ASSERT(kernels.inverse(result, m1));
+			for (int i = 0; i < 16; i++)
+				TS_ASSERT(near(result[i], expected[i]));
+
+			// The inverse may be stored in place
+			TS_ASSERT(kernels.inverse(m1, m1));
+			TS_ASSERT_EQUALS(memcmp(m1, result, sizeof(result)), 0);
+
+			Math::Vector3d src[kPoints], expectedPoints[kPoints], resultPoints[kPoints];
+			for (int i = 0; i < kPoints; i++) {
+				src[i].set(rnd.nextFloat(-4.0f, 4.0f), rnd.nextFloat(-4.0f, 4.0f), rnd.nextFloat(-4.0f, 4.0f));
+				resultPoints[i] = src[i];
+			}
+
+			const bool translate = n & 1;
+			scalar.transformPoints(m2, src, expectedPoints, kPoints, translate);
+			kernels.transformPoints(m2, resultPoints, resultPoints, kPoints, translate);
+			for (int i = 0; i < kPoints; i++) {
+				for (int j = 0; j < 3; j++)
+					TS_ASSERT(near(resultPoints[i].getValue(j), expectedPoints[i].getValue(j)));
+			}
+		}
+
+		// Singular matrices are left alone
+		float singular[16], copy[16];
+		fill(singular, 12, rnd);
+		for (int i = 0; i < 4; i++)
+			singular[12 + i] = 0.0f;
+		memcpy(copy, singular, sizeof(copy));
+		TS_ASSERT(!kernels.inverse(singular, singular));
+		TS_ASSERT_EQUALS(memcmp(singular, copy, sizeof(copy)), 0);
+	}
+
+public:
+	void test_scalar_kernels() {
+		checkKernels(Math::getScalarMatrix4Kernels());
+	}
+
+	void test_kernels() {
+		checkKernels(Math::getMatrix4Kernels());
+	}
+
+	void test_inverse() {
+		TestRandom rnd(7);
+		Math::Matrix4 m;
+		fill(m.getData(), 16, rnd);
+
+		Math::Matrix4 inv(m);
+		TS_ASSERT(inv.inverse());
+
+		const Math::Matrix4 identity = m * inv;
+		for (int row = 0; row < 4; row++) {
+			for (int col = 0; col < 4; col++)
+				TS_ASSERT(fabs(identity.getValue(row, col) - (row == col ? 1.0f : 0.0f)) < 0.0001f);
+		}
+	}
+
+	void test_transform() {
+		Math::Matrix4 m(Math::Angle(30), Math::Angle(-45), Math::Angle(10), Math::EO_XYZ);
+		m.setPosition(Math::Vector3d(1, 2, 3));
+
+		Math::Vector3d points[3] = {
+			Math::Vector3d(1, 0, 0),
+			Math::Vector3d(0, 2, 0),
+			Math::Vector3d(-1, 5, 3)
+		};
+		Math::Vector3d transformed[3];
+		m.transformPoints(points, transformed, 3);
+
+		for (int i = 0; i < 3; i++) {
+			Math::Vector3d v(points[i]);
+			m.transform(&v, true);
+			TS_ASSERT(near(transformed[i].x(), v.x()) && near(transformed[i].y(), v.y()) && near(transformed[i].z(), v.z()));
+
+			Math::Vector4d v4(points[i].x(), points[i].y(), points[i].z(), 1.0f);
+			v4 = m * v4;
+			TS_ASSERT(near(v.x(), v4.x()) && near(v.y(), v4.y()) && near(v.z(), v4.z()));
+		}
+	}
+};
@@ -5,7 +5,7 @@
 #
 ######################################################################
 
-TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h
+TESTS        := $(srcdir)/test/common/*.h $(srcdir)/test/audio/*.h $(srcdir)/test/math/*.h $(srcdir)/test/image/*.h $(srcdir)/test/graphics/*.h $(srcdir)/test/video/*.h
 TEST_LIBS    :=
 
 ifdef POSIX
@@ -14,7 +14,9 @@ TEST_LIBS += test/null_osystem.o \
 	backends/fs/posix/posix-fs.o \
 	backends/fs/posix/posix-iostream.o \
 	backends/fs/abstract-fs.o \
+	backends/fs/mappedfilestream.o \
 	backends/fs/stdiostream.o \
+	backends/mixer/null/null-mixer.o \
 	backends/modular-backend.o
 endif
 
@@ -24,11 +26,12 @@ TEST_LIBS += test/null_osystem.o \
 	backends/fs/windows/windows-fs.o \
 	backends/fs/abstract-fs.o \
 	backends/fs/stdiostream.o \
+	backends/mixer/null/null-mixer.o \
 	backends/modular-backend.o \
 	backends/platform/sdl/win32/win32_wrapper.o
 endif
 
-TEST_LIBS +=	audio/libaudio.a math/libmath.a common/libcommon.a image/libimage.a graphics/libgraphics.a
+TEST_LIBS +=	video/libvideo.a audio/libaudio.a math/libmath.a common/libcommon.a image/libimage.a graphics/libgraphics.a
 
 ifeq ($(ENABLE_WINTERMUTE), STATIC_PLUGIN)
 	TESTS += $(srcdir)/test/engines/wintermute/*.h
@@ -64,6 +67,28 @@ endif
 #TEST_FLAGS   += --gui=X11Gui
 #TEST_LDFLAGS += -L/usr/X11R6/lib -lX11
 
+#
+# Benchmarks of the decoders, scalers, blitters and resamplers, based on the same
+# null OSystem. Use the 'benchmark' target to run them, and BENCHMARK_FLAGS
+# to pass options and image or video files to the runner.
+#
+BENCHMARK_OBJS := \
+	test/benchmark/benchmark.o \
+	test/benchmark/audio.o \
+	test/benchmark/compression.o \
+	test/benchmark/containers.o \
+	test/benchmark/files.o \
+	test/benchmark/image.o \
+	test/benchmark/scalers.o \
+	test/benchmark/serializer.o \
+	test/benchmark/surfaces.o
+
+benchmark: test/benchmark/runner
+	./test/benchmark/runner $(BENCHMARK_FLAGS)
+# The other libraries depend on libcommon too, so it is linked again last
+test/benchmark/runner: $(BENCHMARK_OBJS) $(TEST_LIBS)
+	+$(QUIET_LINK)$(LD) $(TEST_CXXFLAGS) -o $@ $(BENCHMARK_OBJS) $(TEST_LIBS) common/libcommon.a $(TEST_LDFLAGS)
+
 
 test: test/runner
 	./test/runner
@@ -76,6 +101,7 @@ test/runner.cpp: $(TESTS) $(srcdir)/test/module.mk
 clean: clean-test
 clean-test:
 	-$(RM) test/runner.cpp test/runner test/engine-data/encoding.dat
+	-$(RM) $(BENCHMARK_OBJS) test/benchmark/runner
 	-rmdir test/engine-data
 
 test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
@@ -84,4 +110,4 @@ test/engine-data/encoding.dat: $(srcdir)/dists/engine-data/encoding.dat
 
 copy-dat: test/engine-data/encoding.dat
 
-.PHONY: test clean-test copy-dat
+.PHONY: test benchmark clean-test copy-dat
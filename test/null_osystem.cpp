@@ -7,6 +7,23 @@ void Common::install_null_g_system() {
 	g_system = OSystem_NULL_create();
 }
 
+static Common::HardwareMPEGDecoderFactory hardwareMPEGDecoderFactory = nullptr;
+
+void Common::set_null_hardware_mpeg_decoder(HardwareMPEGDecoderFactory factory) {
+	hardwareMPEGDecoderFactory = factory;
+}
+
+bool OSystem_NULL::hasFeature(Feature f) {
+	if (f == kFeatureHardwareMPEG2)
+		return hardwareMPEGDecoderFactory != nullptr;
+
+	return ModularGraphicsBackend::hasFeature(f);
+}
+
+Image::MPEGPacketDecoder *OSystem_NULL::createHardwareMPEGDecoder(uint16 width, uint16 height) {
+	return hardwareMPEGDecoderFactory ? hardwareMPEGDecoderFactory(width, height) : nullptr;
+}
+
 bool BaseBackend::setScaler(const char *name, int factor) {
 	return false;
 }
@@ -1,8 +1,20 @@
 #ifndef TEST_NULL_OSYSTEM
 #define TEST_NULL_OSYSTEM 1
+namespace Image {
+class MPEGPacketDecoder;
+}
+
 namespace Common {
 #if defined(POSIX) || defined(WIN32)
 void install_null_g_system();
+
+/**
+ * Make the null OSystem report kFeatureHardwareMPEG2, and create its
+ * "hardware" MPEG decoders with the given function. Pass nullptr to
+ * remove the feature again.
+ */
+typedef Image::MPEGPacketDecoder *(*HardwareMPEGDecoderFactory)(int width, int height);
+void set_null_hardware_mpeg_decoder(HardwareMPEGDecoderFactory factory);
 #define NULL_OSYSTEM_IS_AVAILABLE 1
 #else
 #define NULL_OSYSTEM_IS_AVAILABLE 0
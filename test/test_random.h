@@ -0,0 +1,30 @@
+#ifndef TEST_TEST_RANDOM
+#define TEST_TEST_RANDOM 1
+
+#include "common/scummsys.h"
+
+/**
+ * Pseudo-random numbers for filling test data. The sequence only depends
+ * on the seed, so that failures can be reproduced, and unlike
+ * Common::RandomSource it needs no OSystem.
+ */
+class TestRandom {
+public:
+	TestRandom(uint32 seed) : _seed(seed) {}
+
+	/** Return 32 random bits. */
+	uint32 next() {
+		_seed = _seed * 1103515245 + 12345;
+		return (_seed >> 16) | (_seed << 16);
+	}
+
+	/** Return a random number in [min, max). */
+	float nextFloat(float min, float max) {
+		return min + (next() & 0xffffff) * (max - min) / 16777216.0f;
+	}
+
+private:
+	uint32 _seed;
+};
+
+#endif
@@ -0,0 +1,135 @@
+#include <cxxtest/TestSuite.h>
+
+#include "common/memstream.h"
+#include "common/system.h"
+#include "graphics/surface.h"
+#include "image/codecs/mpeg.h"
+#include "video/mpegps_decoder.h"
+#include "../null_osystem.h"
+
+#if NULL_OSYSTEM_IS_AVAILABLE
+
+/**
+ * Stands in for a backend's hardware decoder: every packet completes a
+ * frame, which is filled with the number of the packet.
+ */
+class TestHardwareMPEGDecoder : public Image::MPEGPacketDecoder {
+public:
+	TestHardwareMPEGDecoder(int width, int height) : _width(width), _height(height), _packets(0) {}
+
+	bool decodePacket(Common::SeekableReadStream &packet, uint32 &framePeriod, Graphics::Surface *dst) override {
+		_packets++;
+		framePeriod = 27000000 / 25;
+		if (dst)
+			dst->fillRect(Common::Rect(dst->w, dst->h), _packets);
+		return true;
+	}
+
+	int _width, _height;
+	int _packets;
+
+	static TestHardwareMPEGDecoder *_lastCreated;
+	static int _created;
+};
+
+TestHardwareMPEGDecoder *TestHardwareMPEGDecoder::_lastCreated = nullptr;
+int TestHardwareMPEGDecoder::_created = 0;
+
+class MPEGPSDecoderTestSuite : public CxxTest::TestSuite {
+	static Image::MPEGPacketDecoder *createDecoder(int width, int height) {
+		TestHardwareMPEGDecoder::_created++;
+		TestHardwareMPEGDecoder::_lastCreated = new TestHardwareMPEGDecoder(width, height);
+		return TestHardwareMPEGDecoder::_lastCreated;
+	}
+
+	static Image::MPEGPacketDecoder *refuseDecoder(int width, int height) {
+		TestHardwareMPEGDecoder::_created++;
+		return nullptr;
+	}
+
+	// A program stream with video packets only, the first one holding the
+	// sequence header of a 16x16 video
+	static Common::SeekableReadStream *createStream(int packets) {
+		static const byte sequenceHeader[] = { 0x00, 0x00, 0x01, 0xb3, 0x01, 0x00, 0x10, 0x00 };
+		static const byte picture[] = { 0x00, 0x00, 0x01, 0x00, 0x12, 0x34, 0x56, 0x78 };
+		const uint32 packetSize = 7 + sizeof(sequenceHeader);
+
+		byte *data = (byte *)malloc(packets * packetSize);
+		for (int i = 0; i < packets; i++) {
+			byte *packet = data + i * packetSize;
+			WRITE_BE_UINT32(packet, 0x1e0);
+			WRITE_BE_UINT16(packet + 4, 1 + sizeof(sequenceHeader));
+			packet[6] = 0x0f;
+			memcpy(packet + 7, i ? picture : sequenceHeader, sizeof(sequenceHeader));
+		}
+
+		return new Common::MemoryReadStream(data, packets * packetSize, DisposeAfterUse::YES);
+	}
+
+	void setUp() override {
+		Common::install_null_g_system();
+		TestHardwareMPEGDecoder::_lastCreated = nullptr;
+		TestHardwareMPEGDecoder::_created = 0;
+	}
+
+	void tearDown() override {
+		Common::set_null_hardware_mpeg_decoder(nullptr);
+	}
+
+public:
+	void test_hardware_decoding() {
+		Common::set_null_hardware_mpeg_decoder(createDecoder);
+
+		Video::MPEGPSDecoder decoder;
+		decoder.setDefaultHighColorFormat(Graphics::PixelFormat(4, 8, 8, 8, 8, 24, 16, 8, 0));
+		TS_ASSERT(decoder.loadStream(createStream(3)));
+		TS_ASSERT(decoder.isHardwareDecoding());
+		TS_ASSERT_EQUALS(TestHardwareMPEGDecoder::_created, 1);
+		TS_ASSERT(TestHardwareMPEGDecoder::_lastCreated);
+		if (!TestHardwareMPEGDecoder::_lastCreated)
+			return;
+		TS_ASSERT_EQUALS(TestHardwareMPEGDecoder::_lastCreated->_width, 16);
+		TS_ASSERT_EQUALS(TestHardwareMPEGDecoder::_lastCreated->_height, 16);
+
+		// The frames come from the hardware decoder
+		decoder.start();
+		for (uint32 i = 1; i <= 3; i++) {
+			const Graphics::Surface *frame = decoder.decodeNextFrame();
+			TS_ASSERT(frame);
+			if (!frame)
+				return;
+			TS_ASSERT_EQUALS(frame->w, 16);
+			TS_ASSERT_EQUALS(frame->h, 16);
+			TS_ASSERT_EQUALS(frame->getPixel(15, 15), i);
+		}
+		TS_ASSERT_EQUALS(TestHardwareMPEGDecoder::_lastCreated->_packets, 3);
+	}
+
+	void test_hardware_decoder_refused() {
+		// The backend can't decode this video, so it is decoded in software
+		Common::set_null_hardware_mpeg_decoder(refuseDecoder);
+
+		Video::MPEGPSDecoder decoder;
+		TS_ASSERT(decoder.loadStream(createStream(3)));
+		TS_ASSERT_EQUALS(TestHardwareMPEGDecoder::_created, 1);
+		TS_ASSERT(!decoder.isHardwareDecoding());
+	}
+
+	void test_hardware_decoding_disabled() {
+		Common::set_null_hardware_mpeg_decoder(createDecoder);
+
+		Video::MPEGPSDecoder decoder;
+		decoder.setHardwareDecoding(false);
+		TS_ASSERT(decoder.loadStream(createStream(3)));
+		TS_ASSERT_EQUALS(TestHardwareMPEGDecoder::_created, 0);
+		TS_ASSERT(!decoder.isHardwareDecoding());
+	}
+
+	void test_no_hardware_decoder() {
+		Video::MPEGPSDecoder decoder;
+		TS_ASSERT(decoder.loadStream(createStream(3)));
+		TS_ASSERT(!decoder.isHardwareDecoding());
+	}
+};
+
+#endif
@@ -101,6 +101,8 @@ protected:
 	void readNextPacket();
 	bool seekIntern(const Audio::Timestamp &time);
 	bool supportsAudioTrackSwitching() const { return true; }
+	// The transparency track is decoded on demand by decodeNextTransparency()
+	bool supportsDecodeAhead() const { return !_transparencyTrack.track; }
 	AudioTrack *getAudioTrack(int index);
 
 	/**
@@ -77,6 +77,7 @@ public:
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
+	bool supportsDecodeAhead() const { return true; }
 	AudioTrack *getAudioTrack(int index);
 	bool seekIntern(const Audio::Timestamp &time);
 	uint32 findKeyFrame(uint32 frame) const;
@@ -205,7 +205,7 @@ bool MPEGPSDecoder::addFirstVideoTrack() {
 	// Video stream
 	// Can be MPEG-1/2 or MPEG-4/h.264. We'll assume the former and
 	// I hope we never need the latter.
-	MPEGVideoTrack *track = new MPEGVideoTrack(packet, getDefaultHighColorFormat());
+	MPEGVideoTrack *track = new MPEGVideoTrack(packet, getDefaultHighColorFormat(), isHardwareDecodingAllowed());
 	addTrack(track);
 	_streamMap[startCode] = track;
 
@@ -584,7 +584,7 @@ void MPEGPSDecoder::MPEGPSDemuxer::parseProgramStreamMap(int length) {
 // Video track
 // --------------------------------------------------------------------------
 
-MPEGPSDecoder::MPEGVideoTrack::MPEGVideoTrack(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format) {
+MPEGPSDecoder::MPEGVideoTrack::MPEGVideoTrack(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format, bool allowHardwareDecoding) {
 	_surface = 0;
 	_endOfTrack = false;
 	_curFrame = -1;
@@ -593,15 +593,23 @@ MPEGPSDecoder::MPEGVideoTrack::MPEGVideoTrack(Common::SeekableReadStream *firstP
 
 	findDimensions(firstPacket, format);
 
+	// Prefer the platform's decoding hardware, and fall back to libmpeg2
+	_mpegDecoder = 0;
+	if (allowHardwareDecoding && g_system->hasFeature(OSystem::kFeatureHardwareMPEG2))
+		_mpegDecoder = g_system->createHardwareMPEGDecoder(_surface->w, _surface->h);
+
+	_hardwareDecoded = (_mpegDecoder != 0);
+	if (_hardwareDecoded)
+		debug(1, "MPEG video is decoded in hardware");
+
 #ifdef USE_MPEG2
-	_mpegDecoder = new Image::MPEGDecoder();
+	if (!_mpegDecoder)
+		_mpegDecoder = new Image::MPEGDecoder();
 #endif
 }
 
 MPEGPSDecoder::MPEGVideoTrack::~MPEGVideoTrack() {
-#ifdef USE_MPEG2
 	delete _mpegDecoder;
-#endif
 
 	if (_surface) {
 		_surface->free();
@@ -629,7 +637,11 @@ const Graphics::Surface *MPEGPSDecoder::MPEGVideoTrack::decodeNextFrame() {
 }
 
 bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packet, uint32 pts, uint32 dts) {
-#ifdef USE_MPEG2
+	if (!_mpegDecoder) {
+		delete packet;
+		return true;
+	}
+
 	if (pts != 0xFFFFFFFF) {
 		_framePts = pts;
 	}
@@ -652,15 +664,10 @@ bool MPEGPSDecoder::MPEGVideoTrack::sendPacket(Common::SeekableReadStream *packe
 
 		_framePts = 0xFFFFFFFF;
 	}
-#endif
 
 	delete packet;
 
-#ifdef USE_MPEG2
 	return foundFrame;
-#else
-	return true;
-#endif
 }
 
 void MPEGPSDecoder::MPEGVideoTrack::findDimensions(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format) {
@@ -40,7 +40,7 @@ struct PixelFormat;
 }
 
 namespace Image {
-class MPEGDecoder;
+class MPEGPacketDecoder;
 }
 
 namespace Video {
@@ -113,7 +113,7 @@ private:
 	// An MPEG 1/2 video track
 	class MPEGVideoTrack : public VideoTrack, public MPEGStream {
 	public:
-		MPEGVideoTrack(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format);
+		MPEGVideoTrack(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format, bool allowHardwareDecoding);
 		~MPEGVideoTrack();
 
 		bool endOfTrack() const { return _endOfTrack; }
@@ -123,6 +123,7 @@ private:
 		int getCurFrame() const { return _curFrame; }
 		uint32 getNextFrameStartTime() const { return _nextFrameStartTime.msecs(); }
 		const Graphics::Surface *decodeNextFrame();
+		bool isHardwareDecoded() const { return _hardwareDecoded; }
 
 		bool sendPacket(Common::SeekableReadStream *packet, uint32 pts, uint32 dts);
 		StreamType getStreamType() const { return kStreamTypeVideo; }
@@ -138,9 +139,8 @@ private:
 
 		void findDimensions(Common::SeekableReadStream *firstPacket, const Graphics::PixelFormat &format);
 
-#ifdef USE_MPEG2
-		Image::MPEGDecoder *_mpegDecoder;
-#endif
+		Image::MPEGPacketDecoder *_mpegDecoder;
+		bool _hardwareDecoded;
 	};
 
 #ifdef USE_MAD
@@ -89,7 +89,9 @@ const Graphics::Surface *QuickTimeDecoder::decodeNextFrame() {
 
 	// Update audio buffers too
 	// (needs to be done after we find the next track)
-	updateAudioBuffer();
+	// When decoding ahead, this is done by frameDecodedAhead() instead.
+	if (!isDecodeAheadActive())
+		updateAudioBuffer();
 
 	// We have to initialize the scaled surface
 	if (frame && (_scaleFactorX != 1 || _scaleFactorY != 1)) {
@@ -243,6 +245,11 @@ void QuickTimeDecoder::init() {
 	}
 }
 
+void QuickTimeDecoder::frameDecodedAhead() {
+	// The audio is read from the same file, so it has to be done here
+	updateAudioBuffer();
+}
+
 void QuickTimeDecoder::updateAudioBuffer() {
 	// Updates the audio buffers for all audio tracks
 	for (TrackListIterator it = getTrackListBegin(); it != getTrackListEnd(); it++)
@@ -297,6 +304,8 @@ QuickTimeDecoder::VideoTrackHandler::VideoTrackHandler(QuickTimeDecoder *decoder
 		checkEditListBounds();
 	}
 
+	buildFrameTables();
+
 	_curEdit = 0;
 	_curFrame = -1;
 	enterNewEditListEntry(true); // might set _curFrame
@@ -404,8 +413,29 @@ bool QuickTimeDecoder::VideoTrackHandler::seek(const Audio::Timestamp &requested
 		return true;
 	}
 
-	// Now we're in the edit and need to figure out what frame we need
+	// Now we're in the edit and need to figure out what frame we need. The
+	// frame times only increase, so the number of frames to skip is found by
+	// a binary search.
 	Audio::Timestamp time = requestedTime.convertToFramerate(_parent->timeScale);
+	const int32 lastFrame = (int32)_frameTimes.size() - 2;
+	if (_curFrame < lastFrame) {
+		uint32 minFrames = 0, maxFrames = lastFrame - _curFrame;
+		while (minFrames < maxFrames) {
+			const uint32 frames = (minFrames + maxFrames) / 2;
+			if (getRateAdjustedTime(getNextFrameStartTimeAfter(frames)) < (uint32)time.totalNumberOfFrames())
+				minFrames = frames + 1;
+			else
+				maxFrames = frames;
+		}
+
+		if (minFrames) {
+			_nextFrameStartTime = getNextFrameStartTimeAfter(minFrames);
+			_curFrame += minFrames;
+			_durationOverride = -1;
+		}
+	}
+
+	// This only goes on past the end of the media
 	while (getRateAdjustedFrameTime() < (uint32)time.totalNumberOfFrames()) {
 		_curFrame++;
 		if (_durationOverride >= 0) {
@@ -633,72 +663,103 @@ Common::Rational QuickTimeDecoder::VideoTrackHandler::getScaledHeight() const {
 }
 
 Common::SeekableReadStream *QuickTimeDecoder::VideoTrackHandler::getNextFramePacket(uint32 &descId) {
-	// First, we have to track down which chunk holds the sample and which sample in the chunk contains the frame we are looking for.
-	int32 totalSampleCount = 0;
-	int32 sampleInChunk = 0;
-	int32 actualChunk = -1;
-	uint32 sampleToChunkIndex = 0;
+	if (_curFrame < 0 || (uint32)_curFrame >= _framePositions.size())
+		error("Could not find data for frame %d", _curFrame);
 
-	for (uint32 i = 0; i < _parent->chunkCount; i++) {
-		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
-			sampleToChunkIndex++;
+	const FramePosition &position = _framePositions[_curFrame];
+	descId = position.descId;
 
-		totalSampleCount += _parent->sampleToChunk[sampleToChunkIndex - 1].count;
+	// Seek to the frame and read in its raw data
+	Common::SeekableReadStream *stream = _decoder->_fd;
+	stream->seek(position.offset);
 
-		if (totalSampleCount > _curFrame) {
-			actualChunk = i;
-			descId = _parent->sampleToChunk[sampleToChunkIndex - 1].id;
-			sampleInChunk = _parent->sampleToChunk[sampleToChunkIndex - 1].count - totalSampleCount + _curFrame;
-			break;
-		}
-	}
+	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, position.offset, position.size);
 
-	if (actualChunk < 0)
-		error("Could not find data for frame %d", _curFrame);
+	return stream->readStream(position.size);
+}
 
-	// Next seek to that frame
-	Common::SeekableReadStream *stream = _decoder->_fd;
-	stream->seek(_parent->chunkOffsets[actualChunk]);
+uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
+	if (_curFrame < 0 || (uint32)_curFrame + 1 >= _frameTimes.size()) {
+		// This should never occur
+		error("Cannot find duration for frame %d", _curFrame);
+	}
 
-	// Then, if the chunk holds more than one frame, seek to where the frame we want is located
-	for (int32 i = _curFrame - sampleInChunk; i < _curFrame; i++) {
-		if (_parent->sampleSize != 0)
-			stream->skip(_parent->sampleSize);
+	return _frameTimes[_curFrame + 1] - _frameTimes[_curFrame];
+}
+
+uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
+	// The key frames are sorted, so look for the last one up to the frame
+	uint32 minIndex = 0, maxIndex = _parent->keyframeCount;
+	while (minIndex < maxIndex) {
+		const uint32 index = (minIndex + maxIndex) / 2;
+		if (_parent->keyframes[index] <= frame)
+			minIndex = index + 1;
 		else
-			stream->skip(_parent->sampleSizes[i]);
+			maxIndex = index;
 	}
 
-	// Finally, read in the raw data for the frame
-	//debug("Frame Data[%d]: Offset = %d, Size = %d", _curFrame, stream->pos(), _parent->sampleSizes[_curFrame]);
-
-	if (_parent->sampleSize != 0)
-		return stream->readStream(_parent->sampleSize);
+	if (minIndex > 0)
+		return _parent->keyframes[minIndex - 1];
 
-	return stream->readStream(_parent->sampleSizes[_curFrame]);
+	// If none found, we'll assume the requested frame is a key frame
+	return frame;
 }
 
-uint32 QuickTimeDecoder::VideoTrackHandler::getCurFrameDuration() {
-	uint32 curFrameIndex = 0;
+void QuickTimeDecoder::VideoTrackHandler::buildFrameTables() {
+	// First, track down which chunk holds each frame. A frame can only be
+	// read if its size is known.
+	const uint32 frameLimit = _parent->sampleSize ? MAX(_parent->sampleCount, _parent->frameCount) : _parent->sampleCount;
+	uint32 sampleToChunkIndex = 0;
+
+	for (uint32 i = 0; i < _parent->chunkCount && _framePositions.size() < frameLimit; i++) {
+		if (sampleToChunkIndex < _parent->sampleToChunkCount && i >= _parent->sampleToChunk[sampleToChunkIndex].first)
+			sampleToChunkIndex++;
+
+		if (sampleToChunkIndex == 0)
+			continue;
+
+		// The frames of a chunk are stored one after another
+		const Common::QuickTimeParser::SampleToChunkEntry &entry = _parent->sampleToChunk[sampleToChunkIndex - 1];
+		uint32 offset = _parent->chunkOffsets[i];
+
+		for (uint32 j = 0; j < entry.count && _framePositions.size() < frameLimit; j++) {
+			FramePosition position;
+			position.offset = offset;
+			position.size = _parent->sampleSize ? _parent->sampleSize : _parent->sampleSizes[_framePositions.size()];
+			position.descId = entry.id;
+			_framePositions.push_back(position);
+
+			offset += position.size;
+		}
+	}
+
+	// Then add up the frame durations
+	_frameTimes.reserve(_parent->frameCount + 1);
+
+	uint32 time = 0;
 	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		curFrameIndex += _parent->timeToSample[i].count;
-		if ((uint32)_curFrame < curFrameIndex) {
-			// Ok, now we have what duration this frame has.
-			return _parent->timeToSample[i].duration;
+		for (int j = 0; j < _parent->timeToSample[i].count; j++) {
+			_frameTimes.push_back(time);
+			time += _parent->timeToSample[i].duration;
 		}
 	}
 
-	// This should never occur
-	error("Cannot find duration for frame %d", _curFrame);
-	return 0;
+	_frameTimes.push_back(time);
 }
 
-uint32 QuickTimeDecoder::VideoTrackHandler::findKeyFrame(uint32 frame) const {
-	for (int i = _parent->keyframeCount - 1; i >= 0; i--)
-		if (_parent->keyframes[i] <= frame)
-			return _parent->keyframes[i];
+uint32 QuickTimeDecoder::VideoTrackHandler::findFrameAtTime(uint32 mediaTime) const {
+	// Look for the last frame starting up to the time. If the time is past
+	// the end of the media, this is the frame count.
+	uint32 minFrame = 0, maxFrame = _frameTimes.size();
+	while (minFrame < maxFrame) {
+		const uint32 frame = (minFrame + maxFrame) / 2;
+		if (_frameTimes[frame] <= mediaTime)
+			minFrame = frame + 1;
+		else
+			maxFrame = frame;
+	}
 
-	// If none found, we'll assume the requested frame is a key frame
-	return frame;
+	return minFrame - 1;
 }
 
 bool QuickTimeDecoder::VideoTrackHandler::isEmptyEdit() const {
@@ -718,32 +779,17 @@ void QuickTimeDecoder::VideoTrackHandler::enterNewEditListEntry(bool bufferFrame
 	}
 
 	uint32 mediaTime = _parent->editList[_curEdit].mediaTime;
-	uint32 frameNum = 0;
-	uint32 totalDuration = 0;
 	_durationOverride = -1;
 
 	// Track down where the mediaTime is in the media
 	// This is basically time -> frame mapping
 	// Note that this code uses first frame = 0
-	for (int32 i = 0; i < _parent->timeToSampleCount; i++) {
-		uint32 duration = _parent->timeToSample[i].count * _parent->timeToSample[i].duration;
-
-		if (totalDuration + duration >= mediaTime) {
-			uint32 frameInc = (mediaTime - totalDuration) / _parent->timeToSample[i].duration;
-			frameNum += frameInc;
-			totalDuration += frameInc * _parent->timeToSample[i].duration;
+	uint32 frameNum = findFrameAtTime(mediaTime);
 
-			// If we didn't get to the exact media time, mark an override for
-			// the time.
-			if (totalDuration != mediaTime)
-				_durationOverride = totalDuration + _parent->timeToSample[i].duration - mediaTime;
-
-			break;
-		}
-
-		frameNum += _parent->timeToSample[i].count;
-		totalDuration += duration;
-	}
+	// If we didn't get to the exact media time, mark an override for
+	// the time.
+	if (frameNum + 1 < _frameTimes.size() && _frameTimes[frameNum] != mediaTime)
+		_durationOverride = _frameTimes[frameNum + 1] - mediaTime;
 
 	if (bufferFrames) {
 		// Track down the keyframe
@@ -806,7 +852,11 @@ const Graphics::Surface *QuickTimeDecoder::VideoTrackHandler::bufferNextFrame()
 uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime() const {
 	// Figure out what time the next frame is at taking the edit list rate into account,
 	// unless this is an empty edit, in which case the rate isn't applicable.
-	Common::Rational offsetFromEdit = Common::Rational(_nextFrameStartTime - getCurEditTimeOffset());
+	return getRateAdjustedTime(_nextFrameStartTime);
+}
+
+uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedTime(uint32 mediaTime) const {
+	Common::Rational offsetFromEdit = Common::Rational(mediaTime - getCurEditTimeOffset());
 	if (!isEmptyEdit()) {
 		offsetFromEdit /= _parent->editList[_curEdit].mediaRate;
 	}
@@ -818,6 +868,22 @@ uint32 QuickTimeDecoder::VideoTrackHandler::getRateAdjustedFrameTime() const {
 	return convertedTime + getCurEditTimeOffset();
 }
 
+uint32 QuickTimeDecoder::VideoTrackHandler::getNextFrameStartTimeAfter(uint32 frames) const {
+	// The time the next frame starts at after buffering the given number of
+	// frames, adding up their durations like decodeNextFrame() does
+	if (frames == 0)
+		return _nextFrameStartTime;
+
+	// The duration of the first frame may be overridden by a media seek
+	uint32 time = _nextFrameStartTime;
+	if (_durationOverride >= 0)
+		time += _durationOverride;
+	else
+		time += _frameTimes[_curFrame + 2] - _frameTimes[_curFrame + 1];
+
+	return time + _frameTimes[_curFrame + frames + 1] - _frameTimes[_curFrame + 2];
+}
+
 uint32 QuickTimeDecoder::VideoTrackHandler::getCurEditTimeOffset() const {
 	// Need to convert to the track scale
 
@@ -75,6 +75,10 @@ public:
 protected:
 	Common::QuickTimeParser::SampleDesc *readSampleDesc(Common::QuickTimeParser::Track *track, uint32 format, uint32 descSize);
 
+	// VideoDecoder API
+	bool supportsDecodeAhead() const { return true; }
+	void frameDecodedAhead();
+
 private:
 	void init();
 
@@ -161,6 +165,21 @@ private:
 		mutable bool _dirtyPalette;
 		bool _reversed;
 
+		// Where each frame is stored in the file, so that seeking does not
+		// have to go through the chunk tables
+		struct FramePosition {
+			uint32 offset;
+			uint32 size;
+			uint32 descId;
+		};
+		Common::Array<FramePosition> _framePositions;
+
+		// The media time each frame starts at, followed by the end of the media
+		Common::Array<uint32> _frameTimes;
+
+		void buildFrameTables();
+		uint32 findFrameAtTime(uint32 mediaTime) const;
+
 		// Forced dithering of frames
 		byte *_forcedDitherPalette;
 		byte *_ditherTable;
@@ -174,6 +193,8 @@ private:
 		void enterNewEditListEntry(bool bufferFrames);
 		const Graphics::Surface *bufferNextFrame();
 		uint32 getRateAdjustedFrameTime() const; // media time
+		uint32 getRateAdjustedTime(uint32 mediaTime) const; // media time
+		uint32 getNextFrameStartTimeAfter(uint32 frames) const; // media time
 		uint32 getCurEditTimeOffset() const;     // media time
 		uint32 getCurEditTrackDuration() const;  // media time
 		bool atLastEdit() const;
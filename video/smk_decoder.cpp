@@ -27,6 +27,7 @@
 
 #include "common/endian.h"
 #include "common/util.h"
+#include "common/memstream.h"
 #include "common/stream.h"
 #include "common/bitarray.h"
 #include "common/bitstream.h"
@@ -156,14 +157,20 @@ private:
 		SMK_NODE = 0x80000000
 	};
 
+	enum {
+		// Codes up to this length are decoded with a single table lookup,
+		// longer ones continue from the node at this depth
+		SMK_LOOKUP_BITS = 10
+	};
+
 	uint32 decodeTree(uint32 prefix, int length);
 
 	uint32  _treeSize;
 	uint32 *_tree;
 	uint32  _last[3];
 
-	uint32 _prefixtree[256];
-	byte _prefixlength[256];
+	uint32 _prefixtree[1 << SMK_LOOKUP_BITS];
+	byte _prefixlength[1 << SMK_LOOKUP_BITS];
 
 	/* Used during construction */
 	Common::BitStreamMemory8LSB &_bs;
@@ -182,7 +189,7 @@ BigHuffmanTree::BigHuffmanTree(Common::BitStreamMemory8LSB &bs, int allocSize)
 		return;
 	}
 
-	for (uint32 i = 0; i < 256; ++i)
+	for (uint32 i = 0; i < (1 << SMK_LOOKUP_BITS); ++i)
 		_prefixtree[i] = _prefixlength[i] = 0;
 
 	_loBytes = new SmallHuffmanTree(_bs);
@@ -229,8 +236,8 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 		_tree[_treeSize] = v;
 
-		if (length <= 8) {
-			for (int i = 0; i < 256; i += (1 << length)) {
+		if (length <= SMK_LOOKUP_BITS) {
+			for (int i = 0; i < (1 << SMK_LOOKUP_BITS); i += (1 << length)) {
 				_prefixtree[prefix | i] = _treeSize;
 				_prefixlength[prefix | i] = length;
 			}
@@ -249,9 +256,9 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 
 	uint32 t = _treeSize++;
 
-	if (length == 8) {
+	if (length == SMK_LOOKUP_BITS) {
 		_prefixtree[prefix] = t;
-		_prefixlength[prefix] = 8;
+		_prefixlength[prefix] = SMK_LOOKUP_BITS;
 	}
 
 	uint32 r1 = decodeTree(prefix, length + 1);
@@ -263,7 +270,7 @@ uint32 BigHuffmanTree::decodeTree(uint32 prefix, int length) {
 }
 
 uint32 BigHuffmanTree::getCode(Common::BitStreamMemory8LSB &bs) {
-	byte peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), 8));
+	uint32 peek = bs.peekBits(MIN<uint32>(bs.size() - bs.pos(), SMK_LOOKUP_BITS));
 	uint32 *p = &_tree[_prefixtree[peek]];
 	bs.skip(_prefixlength[peek]);
 
@@ -285,6 +292,7 @@ uint32 BigHuffmanTree::getCode(Common::BitStreamMemory8LSB &bs) {
 
 SmackerDecoder::SmackerDecoder() {
 	_fileStream = 0;
+	_memoryStream = 0;
 	_firstFrameStart = 0;
 	_frameTypes = 0;
 	_frameSizes = 0;
@@ -298,6 +306,8 @@ bool SmackerDecoder::loadStream(Common::SeekableReadStream *stream) {
 	close();
 
 	_fileStream = stream;
+	// Memory streams, like the ones of memory mapped files, are decoded in place
+	_memoryStream = dynamic_cast<Common::MemoryReadStream *>(stream);
 
 	// Read in the Smacker header
 	_header.signature = _fileStream->readUint32BE();
@@ -409,6 +419,8 @@ void SmackerDecoder::close() {
 
 	delete _fileStream;
 	_fileStream = 0;
+	_memoryStream = 0;
+	_chunkBuffer.clear();
 
 	delete[] _frameTypes;
 	_frameTypes = 0;
@@ -515,14 +527,10 @@ void SmackerDecoder::readNextPacket() {
 		error("Smacker actual frame size exceeds recorded frame size");
 
 	uint32 frameDataSize = frameSize - (_fileStream->pos() - startPos);
+	const byte *frameData = readChunk(frameDataSize);
 
-	byte *frameData = (byte *)malloc(frameDataSize + 1);
-	// Padding to keep the BigHuffmanTrees from reading past the data end
-	frameData[frameDataSize] = 0x00;
-
-	_fileStream->read(frameData, frameDataSize);
-
-	Common::BitStreamMemory8LSB bs(new Common::BitStreamMemoryStream(frameData, frameDataSize + 1, DisposeAfterUse::YES), DisposeAfterUse::YES);
+	// The padding keeps the BigHuffmanTrees from reading past the data end
+	Common::BitStreamMemory8LSB bs(new Common::BitStreamMemoryStream(frameData, frameDataSize + 1), DisposeAfterUse::YES);
 	videoTrack->decodeFrame(bs);
 
 	_fileStream->seek(startPos + frameSize);
@@ -536,23 +544,19 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 		// Get the audio track, which start at offset 1 (first track is video)
 		SmackerAudioTrack *audioTrack = (SmackerAudioTrack *)getTrack(track + 1);
 
-		// If it's track 0, play the audio data
-		byte *soundBuffer = (byte *)malloc(chunkSize + 1);
-		// Padding to keep the SmallHuffmanTrees from reading past the data end
-		soundBuffer[chunkSize] = 0x00;
-
-		_fileStream->read(soundBuffer, chunkSize);
-
 		if (_header.audioInfo[track].compression == kCompressionRDFT || _header.audioInfo[track].compression == kCompressionDCT) {
 			// TODO: Compressed audio (Bink RDFT/DCT encoded)
-			free(soundBuffer);
+			_fileStream->skip(chunkSize);
 			return;
 		} else if (_header.audioInfo[track].compression == kCompressionDPCM) {
-			// Compressed audio (Huffman DPCM encoded)
+			// Compressed audio (Huffman DPCM encoded). The padding keeps
+			// the SmallHuffmanTrees from reading past the data end.
+			const byte *soundBuffer = readChunk(chunkSize);
 			audioTrack->queueCompressedBuffer(soundBuffer, chunkSize + 1, unpackedSize);
-			free(soundBuffer);
 		} else {
-			// Uncompressed audio (PCM)
+			// Uncompressed audio (PCM), which is queued as is
+			byte *soundBuffer = (byte *)malloc(chunkSize);
+			_fileStream->read(soundBuffer, chunkSize);
 			audioTrack->queuePCM(soundBuffer, chunkSize);
 		}
 	} else {
@@ -561,6 +565,22 @@ void SmackerDecoder::handleAudioTrack(byte track, uint32 chunkSize, uint32 unpac
 	}
 }
 
+const byte *SmackerDecoder::readChunk(uint32 size) {
+	if (_memoryStream && _memoryStream->pos() + size < _memoryStream->size()) {
+		// The byte following the chunk serves as padding
+		const byte *data = _memoryStream->getData() + _memoryStream->pos();
+		_memoryStream->skip(size);
+		return data;
+	}
+
+	if (_chunkBuffer.size() < size + 1)
+		_chunkBuffer.resize(size + 1);
+
+	_fileStream->read(_chunkBuffer.data(), size);
+	_chunkBuffer[size] = 0x00;
+	return _chunkBuffer.data();
+}
+
 VideoDecoder::AudioTrack *SmackerDecoder::getAudioTrack(int index) {
 	// Smacker audio track indexes are relative to the first audio track
 	Track *track = getTrack(index + 1);
@@ -767,7 +787,7 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 	uint startPos = stream->pos();
 	uint32 len = 4 * stream->readByte();
 
-	byte *chunk = (byte *)malloc(len);
+	byte chunk[4 * 255];
 	stream->read(chunk, len);
 	byte *p = chunk;
 
@@ -810,7 +830,6 @@ void SmackerDecoder::SmackerVideoTrack::unpackPalette(Common::SeekableReadStream
 	}
 
 	stream->seek(startPos + len);
-	free(chunk);
 
 	_dirtyPalette = true;
 }
@@ -835,7 +854,7 @@ Audio::AudioStream *SmackerDecoder::SmackerAudioTrack::getAudioStream() const {
 	return _audioStream;
 }
 
-void SmackerDecoder::SmackerAudioTrack::queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize) {
+void SmackerDecoder::SmackerAudioTrack::queueCompressedBuffer(const byte *buffer, uint32 bufferSize, uint32 unpackedSize) {
 	Common::BitStreamMemory8LSB audioBS(new Common::BitStreamMemoryStream(buffer, bufferSize), DisposeAfterUse::YES);
 	bool dataPresent = audioBS.getBit();
 
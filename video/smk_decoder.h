@@ -22,6 +22,7 @@
 #ifndef VIDEO_SMK_PLAYER_H
 #define VIDEO_SMK_PLAYER_H
 
+#include "common/array.h"
 #include "common/bitarray.h"
 #include "common/bitstream.h"
 #include "common/rational.h"
@@ -36,6 +37,7 @@ class QueuingAudioStream;
 }
 
 namespace Common {
+class MemoryReadStream;
 class SeekableReadStream;
 }
 
@@ -77,6 +79,7 @@ public:
 protected:
 	void readNextPacket();
 	bool supportsAudioTrackSwitching() const { return true; }
+	bool supportsDecodeAhead() const { return true; }
 	AudioTrack *getAudioTrack(int index);
 
 	virtual void handleAudioTrack(byte track, uint32 chunkSize, uint32 unpackedSize);
@@ -176,7 +179,7 @@ private:
 		bool isRewindable() const { return true; }
 		bool rewind();
 
-		void queueCompressedBuffer(byte *buffer, uint32 bufferSize, uint32 unpackedSize);
+		void queueCompressedBuffer(const byte *buffer, uint32 bufferSize, uint32 unpackedSize);
 		void queuePCM(byte *buffer, uint32 bufferSize);
 
 	protected:
@@ -205,7 +208,17 @@ protected:
 	byte *_frameTypes;
 
 private:
+	/**
+	 * Read a chunk of the given size from the file. The returned data is
+	 * followed by at least one byte of padding, and stays valid until the
+	 * next call.
+	 */
+	const byte *readChunk(uint32 size);
+
 	uint32 _firstFrameStart;
+
+	Common::MemoryReadStream *_memoryStream; ///< _fileStream, if it can be read without copying
+	Common::Array<byte> _chunkBuffer;        ///< holds chunks which have to be copied
 };
 
 } // End of namespace Video
@@ -72,6 +72,7 @@ public:
 
 protected:
 	void readNextPacket();
+	bool supportsDecodeAhead() const { return true; }
 
 private:
 	class TheoraVideoTrack : public VideoTrack {
@@ -26,12 +26,344 @@
 
 #include "common/rational.h"
 #include "common/file.h"
+#include "common/mutex.h"
+#include "common/rect.h"
 #include "common/system.h"
+#include "common/textconsole.h"
+#include "common/thread.h"
 
 #include "graphics/palette.h"
+#include "graphics/surface.h"
 
 namespace Video {
 
+/**
+ * Decodes the frames of a video track on a worker thread, into a ring of
+ * surfaces.
+ *
+ * While the worker runs, only it accesses the stream and the tracks. The
+ * caller takes the decoded frames along with the state the track had
+ * after decoding them, which is what VideoDecoder reports for playback.
+ */
+class VideoDecoder::DecodeAheadQueue {
+public:
+	DecodeAheadQueue(VideoDecoder *decoder, VideoTrack *track);
+	~DecodeAheadQueue();
+
+	VideoTrack *getTrack() const { return _track; }
+
+	/**
+	 * Set the number of frames to keep ready, and start decoding them.
+	 *
+	 * With 0, no more frames are decoded, but the ones decoded already
+	 * are still returned by takeFrame().
+	 *
+	 * @return false if no worker thread could be started
+	 */
+	bool setFrameCount(uint frameCount);
+	uint getFrameCount() const { return _frameCount; }
+
+	/**
+	 * Get the state of the track at the last frame taken.
+	 *
+	 * @return false if the worker is stopped and no frames are queued, in
+	 *         which case the track's own state is the playback state
+	 */
+	bool getState(VideoTrackState &state) const;
+
+	/**
+	 * Take the next frame, waiting for the worker if needed. The worker is
+	 * restarted if it was stopped.
+	 *
+	 * @param surface  Set to the frame, which stays valid until the next call,
+	 *                 or to 0 if the track did not return a frame
+	 * @param palette  Set to the new palette, or to 0 if it did not change
+	 * @return false if no frame was decoded ahead, i.e. the caller has to
+	 *         decode it itself
+	 */
+	bool takeFrame(const Graphics::Surface *&surface, const byte *&palette);
+
+	/**
+	 * Stop the worker and keep the frames decoded so far. takeFrame()
+	 * restarts it.
+	 */
+	void stopWorker();
+
+	/**
+	 * Stop the worker and discard the frames decoded so far, so that the
+	 * tracks can be repositioned.
+	 */
+	void discardFrames();
+
+private:
+	struct Frame {
+		Frame() : hasSurface(false), dirtyPalette(false) {}
+
+		Graphics::Surface surface;
+		bool hasSurface;
+		bool dirtyPalette;
+		byte palette[256 * 3];
+		VideoTrackState state;
+	};
+
+	static void workerProc(void *data);
+	void work();
+
+	/** Decode one frame into the ring. Only the worker may call this. */
+	void decodeFrame();
+
+	bool startWorker();
+	VideoTrackState getTrackState() const;
+
+	VideoDecoder *_decoder;
+	VideoTrack *_track;
+
+	mutable Common::Mutex _mutex;
+	Common::Thread _thread;
+	Common::Semaphore _wake;
+	Common::Semaphore _frameReady;
+
+	// The following members are protected by _mutex. The ring holds one
+	// frame more than _frameCount, for the frame last taken by the caller.
+	Common::Array<Frame *> _frames;
+	uint _frameCount;
+	uint _readPos;
+	uint _fill;
+	VideoTrackState _state;
+	bool _trackEnded;
+	bool _quit;
+	bool _workerWaiting;
+	bool _callerWaiting;
+
+	// Palette of the frames taken
+	byte _palette[256 * 3];
+};
+
+VideoDecoder::DecodeAheadQueue::DecodeAheadQueue(VideoDecoder *decoder, VideoTrack *track)
+	: _decoder(decoder), _track(track), _frameCount(0), _readPos(0), _fill(0), _trackEnded(false),
+	  _quit(false), _workerWaiting(false), _callerWaiting(false) {
+	_state = getTrackState();
+	memset(_palette, 0, sizeof(_palette));
+}
+
+VideoDecoder::DecodeAheadQueue::~DecodeAheadQueue() {
+	stopWorker();
+
+	for (uint i = 0; i < _frames.size(); i++) {
+		_frames[i]->surface.free();
+		delete _frames[i];
+	}
+}
+
+bool VideoDecoder::DecodeAheadQueue::setFrameCount(uint frameCount) {
+	stopWorker();
+
+	// Grow the ring at the write position, so that the queued frames
+	// stay in order. It never shrinks, the worker just keeps fewer
+	// frames ready.
+	while (_frames.size() < frameCount + 1) {
+		const uint writePos = _frames.empty() ? 0 : (_readPos + _fill) % _frames.size();
+		_frames.insert_at(writePos, new Frame());
+
+		if (_readPos > writePos)
+			_readPos++;
+	}
+
+	_frameCount = frameCount;
+
+	if (_frameCount == 0)
+		return true;
+
+	return startWorker();
+}
+
+bool VideoDecoder::DecodeAheadQueue::getState(VideoTrackState &state) const {
+	Common::StackLock lock(_mutex);
+
+	if (!_thread.isStarted() && _fill == 0)
+		return false;
+
+	state = _state;
+	return true;
+}
+
+bool VideoDecoder::DecodeAheadQueue::takeFrame(const Graphics::Surface *&surface, const byte *&palette) {
+	if (!_thread.isStarted() && _frameCount != 0)
+		startWorker();
+
+	Frame *frame = 0;
+
+	while (!frame) {
+		{
+			Common::StackLock lock(_mutex);
+
+			if (_fill > 0) {
+				frame = _frames[_readPos];
+				_readPos = (_readPos + 1) % _frames.size();
+				_fill--;
+				_state = frame->state;
+
+				// Let the worker decode the next frame into the freed slot
+				if (_workerWaiting && !_trackEnded) {
+					_workerWaiting = false;
+					_wake.post();
+				}
+
+				break;
+			}
+
+			if (!_thread.isStarted() || _trackEnded)
+				return false;
+
+			_callerWaiting = true;
+		}
+
+		_frameReady.wait();
+	}
+
+	surface = frame->hasSurface ? &frame->surface : 0;
+	palette = 0;
+
+	if (frame->dirtyPalette) {
+		memcpy(_palette, frame->palette, sizeof(_palette));
+		palette = _palette;
+	}
+
+	return true;
+}
+
+void VideoDecoder::DecodeAheadQueue::workerProc(void *data) {
+	((DecodeAheadQueue *)data)->work();
+}
+
+void VideoDecoder::DecodeAheadQueue::work() {
+	while (true) {
+		bool wait = false;
+
+		{
+			Common::StackLock lock(_mutex);
+			if (_quit)
+				return;
+
+			if (_trackEnded || _fill >= _frameCount) {
+				_workerWaiting = true;
+				wait = true;
+			}
+		}
+
+		if (wait)
+			_wake.wait();
+		else
+			decodeFrame();
+	}
+}
+
+void VideoDecoder::DecodeAheadQueue::decodeFrame() {
+	Frame *frame;
+
+	{
+		Common::StackLock lock(_mutex);
+		frame = _frames[(_readPos + _fill) % _frames.size()];
+	}
+
+	// The same steps as VideoDecoder::decodeNextFrame(), but without
+	// holding the lock, so that the caller never waits for the decoder
+	// while frames are ready.
+	_decoder->readNextPacket();
+
+	const Graphics::Surface *surface = _track->decodeNextFrame();
+
+	frame->hasSurface = (surface != 0);
+	if (surface) {
+		if (frame->surface.w != surface->w || frame->surface.h != surface->h || frame->surface.format != surface->format) {
+			frame->surface.free();
+			frame->surface.create(surface->w, surface->h, surface->format);
+		}
+
+		frame->surface.copyRectToSurface(*surface, 0, 0, Common::Rect(surface->w, surface->h));
+	}
+
+	frame->dirtyPalette = _track->hasDirtyPalette();
+	if (frame->dirtyPalette)
+		memcpy(frame->palette, _track->getPalette(), sizeof(frame->palette));
+
+	frame->state = getTrackState();
+
+	_decoder->frameDecodedAhead();
+
+	Common::StackLock lock(_mutex);
+
+	_fill++;
+	_trackEnded = frame->state.endOfTrack;
+
+	if (_callerWaiting) {
+		_callerWaiting = false;
+		_frameReady.post();
+	}
+}
+
+bool VideoDecoder::DecodeAheadQueue::startWorker() {
+	if (!_wake.isValid() || !_frameReady.isValid()) {
+		_frameCount = 0;
+		return false;
+	}
+
+	// Decoding ahead cannot follow the position of a reversed track.
+	if (_track->isReversed())
+		return true;
+
+	// Nothing decoded ahead is left, so playback continues from the
+	// current position of the track.
+	if (_fill == 0)
+		_state = getTrackState();
+
+	_trackEnded = _track->endOfTrack();
+	_quit = false;
+	_workerWaiting = false;
+	_callerWaiting = false;
+
+	if (!_thread.start(workerProc, this)) {
+		warning("VideoDecoder: Could not start worker thread, decoding on demand");
+		_frameCount = 0;
+		return false;
+	}
+
+	return true;
+}
+
+void VideoDecoder::DecodeAheadQueue::stopWorker() {
+	if (!_thread.isStarted())
+		return;
+
+	{
+		Common::StackLock lock(_mutex);
+		_quit = true;
+	}
+	_wake.post();
+	_thread.join();
+
+	// Discard wake-ups nobody consumed
+	while (_wake.tryWait())
+		;
+	while (_frameReady.tryWait())
+		;
+}
+
+void VideoDecoder::DecodeAheadQueue::discardFrames() {
+	stopWorker();
+
+	_readPos = 0;
+	_fill = 0;
+}
+
+VideoDecoder::VideoTrackState VideoDecoder::DecodeAheadQueue::getTrackState() const {
+	VideoTrackState state;
+	state.curFrame = _track->getCurFrame();
+	state.nextFrameStartTime = _track->getNextFrameStartTime();
+	state.endOfTrack = _track->endOfTrack();
+	return state;
+}
+
 VideoDecoder::VideoDecoder() {
 	_startTime = 0;
 	_dirtyPalette = false;
@@ -48,6 +380,8 @@ VideoDecoder::VideoDecoder() {
 	_nextVideoTrack = 0;
 	_mainAudioTrack = 0;
 	_canSetDither = true;
+	_decodeAhead = 0;
+	_hardwareDecoding = true;
 
 	// Find the best format for output
 	_defaultHighColorFormat = g_system->getScreenFormat();
@@ -56,7 +390,15 @@ VideoDecoder::VideoDecoder() {
 		_defaultHighColorFormat = Graphics::PixelFormat(4, 8, 8, 8, 8, 8, 16, 24, 0);
 }
 
+VideoDecoder::~VideoDecoder() {
+	delete _decodeAhead;
+}
+
 void VideoDecoder::close() {
+	// Stop the worker before any track goes away
+	delete _decodeAhead;
+	_decodeAhead = 0;
+
 	if (isPlaying())
 		stop();
 
@@ -187,6 +529,21 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	_needsUpdate = false;
 	_canSetDither = false;
 
+	if (_decodeAhead) {
+		const Graphics::Surface *frame;
+		const byte *palette;
+
+		if (_decodeAhead->takeFrame(frame, palette)) {
+			if (palette) {
+				_palette = palette;
+				_dirtyPalette = true;
+			}
+
+			findNextVideoTrack();
+			return frame;
+		}
+	}
+
 	readNextPacket();
 
 	// If we have no next video track at this point, there shouldn't be
@@ -207,11 +564,26 @@ const Graphics::Surface *VideoDecoder::decodeNextFrame() {
 	return frame;
 }
 
+const Graphics::Surface *VideoDecoder::decodeNextFrameToScreen(int x, int y) {
+	const Graphics::Surface *frame = decodeNextFrame();
+
+	if (frame && !g_system->copyVideoFrameToScreen(*frame, x, y)) {
+		warning("Could not copy a %s video frame to the %s screen", frame->format.toString().c_str(), g_system->getScreenFormat().toString().c_str());
+		return 0;
+	}
+
+	return frame;
+}
+
 bool VideoDecoder::setReverse(bool reverse) {
 	// Can only reverse video-only videos
 	if (reverse && hasAudio())
 		return false;
 
+	// The tracks are not at the playback position while decoding ahead
+	if (reverse && isDecodeAheadActive())
+		return false;
+
 	// Attempt to make sure all the tracks are in the requested direction
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((VideoTrack *)*it)->isReversed() != reverse) {
@@ -236,7 +608,7 @@ int VideoDecoder::getCurFrame() const {
 
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
 		if ((*it)->getTrackType() == Track::kTrackTypeVideo)
-			frame += ((VideoTrack *)*it)->getCurFrame() + 1;
+			frame += getPlaybackCurFrame((const VideoTrack *)*it) + 1;
 
 	return frame;
 }
@@ -277,7 +649,7 @@ uint32 VideoDecoder::getTimeToNextFrame() const {
 		return 0;
 
 	uint32 currentTime = getTime();
-	uint32 nextFrameStartTime = _nextVideoTrack->getNextFrameStartTime();
+	uint32 nextFrameStartTime = getPlaybackNextFrameStartTime(_nextVideoTrack);
 
 	if (_nextVideoTrack->isReversed()) {
 		// For reversed videos, we need to handle the time difference the opposite way.
@@ -298,8 +670,17 @@ bool VideoDecoder::endOfVideo() const {
 	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++) {
 		const Track *track = *it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)track)->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		if (track->getTrackType() != Track::kTrackTypeVideo) {
+			if (!track->endOfTrack())
+				return false;
+
+			continue;
+		}
+
+		const VideoTrack *videoTrack = (const VideoTrack *)track;
+
+		bool videoEndTimeReached = _endTimeSet && getPlaybackNextFrameStartTime(videoTrack) >= (uint)_endTime.msecs();
+		bool endReached = isPlaybackAtEnd(videoTrack) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return false;
 	}
@@ -322,6 +703,10 @@ bool VideoDecoder::rewind() {
 	if (!isRewindable())
 		return false;
 
+	// Frames decoded ahead are from the old position
+	if (_decodeAhead)
+		_decodeAhead->discardFrames();
+
 	// Stop all tracks so they can be rewound
 	if (isPlaying())
 		stopAudio();
@@ -356,6 +741,10 @@ bool VideoDecoder::seek(const Audio::Timestamp &time) {
 	if (!isSeekable())
 		return false;
 
+	// Frames decoded ahead are from the old position
+	if (_decodeAhead)
+		_decodeAhead->discardFrames();
+
 	// Stop all tracks so they can be seeked
 	if (isPlaying())
 		stopAudio();
@@ -525,6 +914,84 @@ bool VideoDecoder::setDitheringPalette(const byte *palette) {
 	return result;
 }
 
+bool VideoDecoder::setDecodeAhead(uint frameCount) {
+	if (frameCount == 0) {
+		if (_decodeAhead)
+			_decodeAhead->setFrameCount(0);
+
+		return false;
+	}
+
+	if (!_decodeAhead) {
+		if (!supportsDecodeAhead() || !g_system->hasFeature(OSystem::kFeatureThreads))
+			return false;
+
+		VideoTrack *track = 0;
+
+		for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
+			if ((*it)->getTrackType() == Track::kTrackTypeVideo) {
+				// We only allow decoding ahead when one video track
+				// is present
+				if (track)
+					return false;
+
+				track = (VideoTrack *)*it;
+			}
+		}
+
+		if (!track || track->isReversed())
+			return false;
+
+		_decodeAhead = new DecodeAheadQueue(this, track);
+	}
+
+	// The worker may decode the first frame right away
+	_canSetDither = false;
+
+	return _decodeAhead->setFrameCount(frameCount);
+}
+
+bool VideoDecoder::isDecodingAhead() const {
+	return _decodeAhead && _decodeAhead->getFrameCount() != 0;
+}
+
+bool VideoDecoder::isHardwareDecoding() const {
+	for (TrackList::const_iterator it = _tracks.begin(); it != _tracks.end(); it++)
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && ((const VideoTrack *)*it)->isHardwareDecoded())
+			return true;
+
+	return false;
+}
+
+bool VideoDecoder::isDecodeAheadActive() const {
+	VideoTrackState state;
+	return _decodeAhead && _decodeAhead->getState(state);
+}
+
+int VideoDecoder::getPlaybackCurFrame(const VideoTrack *track) const {
+	VideoTrackState state;
+	if (_decodeAhead && _decodeAhead->getTrack() == track && _decodeAhead->getState(state))
+		return state.curFrame;
+
+	return track->getCurFrame();
+}
+
+uint32 VideoDecoder::getPlaybackNextFrameStartTime(const VideoTrack *track) const {
+	VideoTrackState state;
+	if (_decodeAhead && _decodeAhead->getTrack() == track && _decodeAhead->getState(state))
+		return state.nextFrameStartTime;
+
+	return track->getNextFrameStartTime();
+}
+
+bool VideoDecoder::isPlaybackAtEnd(const VideoTrack *track) const {
+	VideoTrackState state;
+	if (_decodeAhead && _decodeAhead->getTrack() == track && _decodeAhead->getState(state))
+		return state.endOfTrack;
+
+	return track->endOfTrack();
+}
+
 VideoDecoder::Track::Track() {
 	_paused = false;
 }
@@ -717,6 +1184,10 @@ bool VideoDecoder::StreamFileAudioTrack::loadFromFile(const Common::String &base
 }
 
 void VideoDecoder::addTrack(Track *track, bool isExternal) {
+	// The worker must not see the track list change
+	if (_decodeAhead)
+		_decodeAhead->stopWorker();
+
 	_tracks.push_back(track);
 
 	if (isExternal)
@@ -874,9 +1345,9 @@ VideoDecoder::VideoTrack *VideoDecoder::findNextVideoTrack() {
 	uint32 bestTime = 0xFFFFFFFF;
 
 	for (TrackList::iterator it = _tracks.begin(); it != _tracks.end(); it++) {
-		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !(*it)->endOfTrack()) {
+		if ((*it)->getTrackType() == Track::kTrackTypeVideo && !isPlaybackAtEnd((VideoTrack *)*it)) {
 			VideoTrack *track = (VideoTrack *)*it;
-			uint32 time = track->getNextFrameStartTime();
+			uint32 time = getPlaybackNextFrameStartTime(track);
 
 			if (time < bestTime) {
 				bestTime = time;
@@ -923,8 +1394,8 @@ bool VideoDecoder::hasFramesLeft() const {
 
 		const VideoTrack *track = (const VideoTrack *)*it;
 
-		bool videoEndTimeReached = _endTimeSet && track->getNextFrameStartTime() >= (uint)_endTime.msecs();
-		bool endReached = track->endOfTrack() || (isPlaying() && videoEndTimeReached);
+		bool videoEndTimeReached = _endTimeSet && getPlaybackNextFrameStartTime(track) >= (uint)_endTime.msecs();
+		bool endReached = isPlaybackAtEnd(track) || (isPlaying() && videoEndTimeReached);
 		if (!endReached)
 			return true;
 	}
@@ -52,7 +52,7 @@ namespace Video {
 class VideoDecoder {
 public:
 	VideoDecoder();
-	virtual ~VideoDecoder() {}
+	virtual ~VideoDecoder();
 
 	/////////////////////////////////////////
 	// Opening/Closing a Video
@@ -355,6 +355,21 @@ public:
 	 */
 	virtual const Graphics::Surface *decodeNextFrame();
 
+	/**
+	 * Decode the next frame and copy it to the screen at the given
+	 * position, converting it to the screen format.
+	 *
+	 * This replaces calling decodeNextFrame(), converting the frame and
+	 * passing it to OSystem::copyRectToScreen(), and lets the backend
+	 * convert the frame without an intermediate copy. The palette of
+	 * paletted videos is not set, see hasDirtyPalette().
+	 *
+	 * @return the decoded frame, or 0 if there was none or it could not
+	 *         be copied to the screen
+	 * @see OSystem::copyVideoFrameToScreen()
+	 */
+	const Graphics::Surface *decodeNextFrameToScreen(int x, int y);
+
 	/**
 	 * Set the default high color format for videos that convert from YUV.
 	 *
@@ -396,6 +411,52 @@ public:
 	 */
 	bool setDitheringPalette(const byte *palette);
 
+	/**
+	 * Decode frames ahead of playback on a worker thread.
+	 *
+	 * decodeNextFrame() then returns frames which were decoded already, so
+	 * that an expensive frame does not stall the caller. Up to frameCount
+	 * frames are kept ready, each one in a surface of its own.
+	 *
+	 * This only works if the video format supports it, the video has a
+	 * single video track and the backend supports threads. Seeking and
+	 * rewinding discard the frames decoded ahead. Reverse playback is not
+	 * possible while frames are decoded ahead.
+	 *
+	 * This should be called after loadStream() and setDitheringPalette().
+	 * Passing 0 switches back to decoding on demand, once the frames which
+	 * were decoded already have been returned. close() does so as well.
+	 *
+	 * @param frameCount The number of frames to decode ahead
+	 * @return true if frames are decoded ahead, false otherwise
+	 */
+	bool setDecodeAhead(uint frameCount);
+
+	/**
+	 * Returns if frames are decoded ahead of playback.
+	 * @see setDecodeAhead()
+	 */
+	bool isDecodingAhead() const;
+
+	/**
+	 * Allow or forbid decoding video on the platform's decoding hardware.
+	 *
+	 * Hardware decoding is allowed by default, and is used for the video
+	 * formats the backend can decode in hardware (see
+	 * OSystem::kFeatureHardwareMPEG2). Otherwise, the video is decoded in
+	 * software.
+	 *
+	 * This takes effect on the next loadStream().
+	 */
+	void setHardwareDecoding(bool enable) { _hardwareDecoding = enable; }
+
+	/**
+	 * Returns if a video track is decoded on the platform's decoding
+	 * hardware.
+	 * @see setHardwareDecoding()
+	 */
+	bool isHardwareDecoding() const;
+
 	/////////////////////////////////////////
 	// Audio Control
 	/////////////////////////////////////////
@@ -645,6 +706,11 @@ protected:
 		 * Activate dithering mode with a palette
 		 */
 		virtual void setDither(const byte *palette) {}
+
+		/**
+		 * Is the video track decoded on the platform's decoding hardware?
+		 */
+		virtual bool isHardwareDecoded() const { return false; }
 	};
 
 	/**
@@ -880,6 +946,12 @@ protected:
 	 */
 	Graphics::PixelFormat getDefaultHighColorFormat() const { return _defaultHighColorFormat; }
 
+	/**
+	 * May the video tracks created by loadStream() decode in hardware?
+	 * @see setHardwareDecoding()
+	 */
+	bool isHardwareDecodingAllowed() const { return _hardwareDecoding; }
+
 	/**
 	 * Set _nextVideoTrack to the video track with the lowest start time for the next frame.
 	 *
@@ -936,6 +1008,34 @@ protected:
 	 */
 	virtual AudioTrack *getAudioTrack(int index) { return 0; }
 
+	/**
+	 * Does this video format support decoding ahead of playback?
+	 *
+	 * Returning true implies that readNextPacket() and the video tracks'
+	 * decodeNextFrame() may be called from a worker thread, as long as
+	 * nothing else accesses the stream and the tracks meanwhile. An
+	 * override of decodeNextFrame() may then only post-process the frame
+	 * returned by VideoDecoder::decodeNextFrame().
+	 *
+	 * @see setDecodeAhead()
+	 */
+	virtual bool supportsDecodeAhead() const { return false; }
+
+	/**
+	 * Called on the worker thread after each frame decoded ahead of
+	 * playback, like readNextPacket(). The default implementation does
+	 * nothing.
+	 */
+	virtual void frameDecodedAhead() {}
+
+	/**
+	 * Returns if the tracks are ahead of playback, because a worker thread
+	 * is decoding frames or frames decoded ahead are still queued. The
+	 * stream and the tracks must then only be accessed from
+	 * readNextPacket() and frameDecodedAhead().
+	 */
+	bool isDecodeAheadActive() const;
+
 private:
 	// Tracks owned by this VideoDecoder
 	TrackList _tracks;
@@ -959,6 +1059,28 @@ private:
 	// Default PixelFormat settings
 	Graphics::PixelFormat _defaultHighColorFormat;
 
+	// Decoding ahead of playback
+	class DecodeAheadQueue;
+	DecodeAheadQueue *_decodeAhead;
+
+	// Decoding on the platform's hardware
+	bool _hardwareDecoding;
+
+	/**
+	 * State of a video track at the last frame returned by decodeNextFrame().
+	 */
+	struct VideoTrackState {
+		int curFrame;
+		uint32 nextFrameStartTime;
+		bool endOfTrack;
+	};
+
+	// Playback state of a video track, which trails the state of the track
+	// itself while frames are decoded ahead
+	int getPlaybackCurFrame(const VideoTrack *track) const;
+	uint32 getPlaybackNextFrameStartTime(const VideoTrack *track) const;
+	bool isPlaybackAtEnd(const VideoTrack *track) const;
+
 protected:
 	// Internal helper functions
 	void stopAudio();